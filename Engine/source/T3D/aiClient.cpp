@@ -80,7 +80,46 @@ AIClient::AIClient() {
  * Destructor
  */
 AIClient::~AIClient() {
-   // Blah
+   AISensing::removeSensor( this );
+}
+
+/**
+ * Turns sight and hearing through the AI sensing manager on or off
+ *
+ * @param sightRange Distance at which objects are seen, zero for none
+ * @param sightFov View cone angle in degrees
+ * @param hearingRange Distance at which noises are heard, zero for none
+ */
+void AIClient::setSensing( F32 sightRange, F32 sightFov, F32 hearingRange ) {
+   mSightRange = sightRange;
+   mSightFov = sightFov;
+   mHearingRange = hearingRange;
+
+   if( mSightRange > 0.0f || mHearingRange > 0.0f )
+      AISensing::addSensor( this );
+   else
+      AISensing::removeSensor( this );
+}
+
+/**
+ * Returns the controlled object, which the sensing manager looks through
+ */
+ShapeBase* AIClient::getSensorBody() {
+   return dynamic_cast<ShapeBase *>( getControlObject() );
+}
+
+void AIClient::onSightGained( SceneObject *target ) {
+   Con::executef( this, "onSightGained", target->getIdString() );
+}
+
+void AIClient::onSightLost( SceneObject *target ) {
+   Con::executef( this, "onSightLost", target->getIdString() );
+}
+
+void AIClient::onNoiseHeard( const Point3F &position, SceneObject *source ) {
+   char posString[128];
+   dSprintf( posString, sizeof( posString ), "%g %g %g", position.x, position.y, position.z );
+   Con::executef( this, "onNoiseHeard", posString, source ? source->getIdString() : "0" );
 }
 
 /**
@@ -424,6 +463,25 @@ DefineConsoleMethod( AIClient, setMoveSpeed, void, (F32 speed), , "ai.setMoveSpe
    ai->setMoveSpeed( speed );
 }
 
+/**
+ * Turns the AI's sight and hearing on or off
+ */
+DefineConsoleMethod( AIClient, setSensing, void, (F32 sightRange, F32 sightFov, F32 hearingRange), (90.0f, 0.0f),
+   "ai.setSensing( sightRange, [sightFov, hearingRange] );\n"
+   "Calls onSightGained, onSightLost and onNoiseHeard on this client as the controlled object sees and hears things.  "
+   "Pass zero ranges to stop." )
+{
+   object->setSensing( sightRange, sightFov, hearingRange );
+}
+
+/**
+ * Returns true if the object is in view of the bot's sensing
+ */
+DefineConsoleMethod( AIClient, canSee, bool, (SceneObject *obj),, "ai.canSee( obj );" )
+{
+   return AISensing::canSee( object, obj );
+}
+
 /**
  * Stops all AI movement, halt!
  */
@@ -29,11 +29,14 @@
 #ifndef _TVECTOR_H_
 #include "core/util/tVector.h"
 #endif
+#ifndef _AISENSING_H_
+#include "T3D/aiSensing.h"
+#endif
 
 class ShapeBase;
 class Player;
 
-class AIClient : public AIConnection {
+class AIClient : public AIConnection, public IAISensor {
 
 	typedef AIConnection Parent;
 
@@ -108,6 +111,13 @@ class AIClient : public AIConnection {
 		Point3F getAimLocation() const { return mAimLocation; }
 		void clearAim();
 
+		// ---Sensing
+		void setSensing( F32 sightRange, F32 sightFov, F32 hearingRange );
+		virtual ShapeBase* getSensorBody();
+		virtual void onSightGained( SceneObject *target );
+		virtual void onSightLost( SceneObject *target );
+		virtual void onNoiseHeard( const Point3F &position, SceneObject *source );
+
 		// ---Other
 		void missionCycleCleanup();
       void onAdd( const char *nameSpace );
@@ -32,6 +32,7 @@
 #include "math/mMatrix.h"
 #include "T3D/gameBase/moveManager.h"
 #include "console/engineAPI.h"
+#include "T3D/gameBase/simulationLOD.h"
 
 #include <cfloat>
 
@@ -39,6 +40,10 @@ static U32 sAIPlayerLoSMask = TerrainObjectType | StaticShapeObjectType | Static
 
 IMPLEMENT_CO_NETOBJECT_V1(AIPlayer);
 
+#ifdef TORQUE_NAVIGATION_ENABLED
+bool AIPlayer::smCrowdLOD = true;
+#endif
+
 ConsoleDocClass( AIPlayer,
    "@brief A Player object not controlled by conventional input, but by an AI engine.\n\n"
 
@@ -75,6 +80,18 @@ ConsoleDocClass( AIPlayer,
    "position to the center of the target's bounding box.  The LOS ray test only checks against interiors, "
    "statis shapes, and terrain.\n\n"
 
+   "void onSightGained(AIPlayer obj, SceneObject target) \n"
+   "Called when a player or vehicle comes into view, if sightRange is set.  Sight is checked by the "
+   "engine's AI sensing every senseInterval ticks; see $AI::sensingMaxRays and $AI::sensingCacheTime.\n\n"
+
+   "void onSightLost(AIPlayer obj, SceneObject target) \n"
+   "Called when an object which was in view leaves the view cone or range, gets blocked, or the "
+   "AIPlayer stops looking.\n\n"
+
+   "void onNoiseHeard(AIPlayer obj, Point3F position, SceneObject source) \n"
+   "Called when a noise made with addAINoise() is heard within hearingRange.  The source is 0 if "
+   "there is none.\n\n"
+
    "@tsexample\n"
    "// Create the demo player object\n"
    "%player = new AiPlayer()\n"
@@ -114,6 +131,10 @@ AIPlayer::AIPlayer()
    mJump = None;
    mNavSize = Regular;
    mLinkTypes = LinkData(AllFlags);
+   mAsyncPathing = false;
+   mUseCrowd = false;
+   mCrowdAgent = -1;
+   mCrowdKinematic = false;
 #endif
 
    mIsAiControlled = true;
@@ -155,6 +176,20 @@ void AIPlayer::initPersistFields()
 
       addField( "AttackRadius", TypeF32, Offset( mAttackRadius, AIPlayer ), 
          "@brief Distance considered in firing range for callback purposes.");
+
+      addField( "sightRange", TypeF32, Offset( mSightRange, AIPlayer ),
+         "@brief Distance at which players and vehicles are seen.\n\n"
+         "Enables the onSightGained and onSightLost callbacks.  Zero, the default, disables sight.\n");
+
+      addField( "sightFov", TypeF32, Offset( mSightFov, AIPlayer ),
+         "@brief Full angle in degrees of the view cone around the eye direction.  360 sees all around.\n");
+
+      addField( "hearingRange", TypeF32, Offset( mHearingRange, AIPlayer ),
+         "@brief Distance at which noises are heard.\n\n"
+         "Enables the onNoiseHeard callback.  Zero, the default, disables hearing.\n");
+
+      addField( "senseInterval", TypeS32, Offset( mSenseInterval, AIPlayer ),
+         "@brief Number of ticks between checks for what is in view.\n");
            
    endGroup( "AI" );
 
@@ -176,7 +211,20 @@ void AIPlayer::initPersistFields()
       addField("allowTeleport", TypeBool, Offset(mLinkTypes.teleport, AIPlayer),
          "Allow the character to use teleporters.");
 
+      addField("asyncPathing", TypeBool, Offset(mAsyncPathing, AIPlayer),
+         "Plan paths on worker threads.  setPathDestination() then only queues the "
+         "request, and onPathSuccess or onPathFailed is called once it has finished.");
+      addField("useCrowd", TypeBool, Offset(mUseCrowd, AIPlayer),
+         "Steer around other crowd characters on the same NavMesh instead of moving "
+         "straight at the next path node.");
+
    endGroup("Pathfinding");
+
+   Con::addVariable("$AIPlayer::crowdLOD", TypeBool, &smCrowdLOD,
+      "@brief Move AIPlayers using the crowd along the NavMesh without collision when they are "
+      "far from every client.\n\n"
+      "Uses the simulation LOD distances; see $Server::simulationLODReducedDistance.\n"
+      "@ingroup AI\n");
 #endif // TORQUE_NAVIGATION_ENABLED
 
    Parent::initPersistFields();
@@ -192,6 +240,9 @@ bool AIPlayer::onAdd()
    getEyeTransform(&eye);
    mLastLocation = eye.getPosition();
 
+   if (isServerObject())
+      AISensing::addSensor(this);
+
    return true;
 }
 
@@ -201,7 +252,9 @@ void AIPlayer::onRemove()
    clearPath();
    clearCover();
    clearFollow();
+   leaveCrowd();
 #endif
+   AISensing::removeSensor(this);
    Parent::onRemove();
 }
 
@@ -250,6 +303,11 @@ void AIPlayer::setMoveDestination( const Point3F &location, bool slowdown )
    mMoveState = ModeMove;
    mMoveSlowdown = slowdown;
    mMoveStuckTestCountdown = mMoveStuckTestDelay;
+
+#ifdef TORQUE_NAVIGATION_ENABLED
+   if(mCrowdAgent >= 0 && !mCrowdMesh.isNull())
+      mCrowdMesh->getCrowd()->setTarget(mCrowdAgent, location);
+#endif
 }
 
 /**
@@ -416,6 +474,8 @@ bool AIPlayer::getAIMove(Move *movePtr)
          }
       }
    }
+
+   updateCrowdAgent();
 #endif // TORQUE_NAVIGATION_ENABLED
 
    // Orient towards the aim point, aim object, or towards
@@ -504,6 +564,16 @@ bool AIPlayer::getAIMove(Move *movePtr)
       }
       else 
       {
+#ifdef TORQUE_NAVIGATION_ENABLED
+         // Let the crowd steer us around other characters.
+         Point3F crowdMove;
+         if (getCrowdMove(&crowdMove))
+         {
+            movePtr->x = crowdMove.x;
+            movePtr->y = crowdMove.y;
+         }
+         else
+#endif
          // Build move direction in world space
          if (mIsZero(xDiff))
             movePtr->y = (location.y > mMoveDestination.y) ? -1.0f : 1.0f;
@@ -652,6 +722,36 @@ void AIPlayer::updateMove(const Move* move)
    Parent::updateMove(move);
 }
 
+bool AIPlayer::isMovingWithoutCollision() const
+{
+#ifdef TORQUE_NAVIGATION_ENABLED
+   return mCrowdKinematic;
+#else
+   return false;
+#endif
+}
+
+bool AIPlayer::updatePos(const F32 travelTime)
+{
+#ifdef TORQUE_NAVIGATION_ENABLED
+   // Far from every client the crowd moves us along the navmesh.
+   Point3F pos;
+   if (mCrowdKinematic && !isMounted() && mCrowdMesh->getCrowd()->getPosition(mCrowdAgent, &pos))
+   {
+      PROFILE_SCOPE(AIPlayer_updatePosCrowd);
+
+      mVelocity = (pos - getPosition()) / travelTime;
+      setPosition(pos, mRot);
+      setMaskBits(MoveMask);
+      updateContainer();
+      checkMissionArea();
+      return true;
+   }
+#endif
+
+   return Parent::updatePos(travelTime);
+}
+
 void AIPlayer::setAiPose( S32 pose )  
 {  
    if (!getControllingClient() && isGhost())  
@@ -675,6 +775,23 @@ void AIPlayer::throwCallback( const char *name )
    Con::executef(getDataBlock(), name, getIdString());
 }
 
+void AIPlayer::onSightGained(SceneObject *target)
+{
+   Con::executef(getDataBlock(), "onSightGained", getIdString(), target->getIdString());
+}
+
+void AIPlayer::onSightLost(SceneObject *target)
+{
+   Con::executef(getDataBlock(), "onSightLost", getIdString(), target->getIdString());
+}
+
+void AIPlayer::onNoiseHeard(const Point3F &position, SceneObject *source)
+{
+   char posString[128];
+   dSprintf(posString, sizeof(posString), "%g %g %g", position.x, position.y, position.z);
+   Con::executef(getDataBlock(), "onNoiseHeard", getIdString(), posString, source ? source->getIdString() : "0");
+}
+
 /**
  * Called when we get within mMoveTolerance of our destination set using
  * setMoveDestination(). Only fires the script callback if we are at the end
@@ -733,7 +850,16 @@ void AIPlayer::clearPath()
 {
    // Only delete if we own the path.
    if(!mPathData.path.isNull() && mPathData.owned)
-      mPathData.path->deleteObject();
+   {
+      if(mPathData.path->mIsAsync)
+      {
+         // We may be inside the path's plan signal.
+         mPathData.path->getPlanSignal().remove(this, &AIPlayer::onPathPlanned);
+         mPathData.path->safeDeleteObject();
+      }
+      else
+         mPathData.path->deleteObject();
+   }
    // Reset path data.
    mPathData = PathData();
 }
@@ -807,6 +933,7 @@ bool AIPlayer::setPathDestination(const Point3F &pos)
    path->mAlwaysRender = true;
    path->mLinkTypes = mLinkTypes;
    path->mXray = true;
+   path->mIsAsync = mAsyncPathing;
    // Paths plan automatically upon being registered.
    if(!path->registerObject())
    {
@@ -814,6 +941,25 @@ bool AIPlayer::setPathDestination(const Point3F &pos)
       return false;
    }
 
+   if(path->mIsAsync)
+   {
+      if(!path->isPlanning())
+      {
+         throwCallback("onPathFailed");
+         path->deleteObject();
+         return false;
+      }
+      clearPath();
+      clearCover();
+      clearFollow();
+      // Wait for the path before moving; onPathPlanned() takes it from here.
+      stopMove();
+      mPathData.path = path;
+      mPathData.owned = true;
+      path->getPlanSignal().notify(this, &AIPlayer::onPathPlanned);
+      return true;
+   }
+
    if(path->success())
    {
       // Clear any current path we might have.
@@ -843,7 +989,7 @@ DefineEngineMethod(AIPlayer, setPathDestination, bool, (Point3F goal),,
    "@brief Tells the AI to find a path to the location provided\n\n"
 
    "@param goal Coordinates in world space representing location to move to.\n"
-   "@return True if a path was found.\n\n"
+   "@return True if a path was found, or if the request was queued when asyncPathing is set.\n\n"
 
    "@see getPathDestination()\n"
    "@see setMoveDestination()\n")
@@ -941,10 +1087,106 @@ void AIPlayer::repath()
    // Update from position and replan.
    mPathData.path->mFrom = getPosition();
    mPathData.path->plan();
+   // Asynchronous paths keep the old path until onPathPlanned().
+   if(mPathData.path->mIsAsync)
+      return;
    // Move to first node (skip start pos).
    moveToNode(1);
 }
 
+void AIPlayer::onPathPlanned(NavPath *path, bool success)
+{
+   if(path != mPathData.path)
+      return;
+
+   if(success)
+   {
+      // Skip node 0, which we are currently standing on.
+      mPathData.index = 0;
+      moveToNode(1);
+      throwCallback("onPathSuccess");
+   }
+   else
+   {
+      clearPath();
+      stopMove();
+      throwCallback("onPathFailed");
+   }
+}
+
+void AIPlayer::updateCrowdAgent()
+{
+   if(mUseCrowd && !getNavMesh())
+      updateNavMesh();
+
+   NavMesh *mesh = NULL;
+   if(mUseCrowd && mDamageState == Enabled && !isMounted())
+      mesh = getNavMesh();
+
+   if(mesh != mCrowdMesh)
+      leaveCrowd();
+
+   mCrowdKinematic = false;
+   if(!mesh)
+      return;
+
+   NavCrowd *crowd = mesh->getCrowd();
+
+   NavCrowd::AgentParams params;
+   params.radius = getMax(mObjBox.len_x(), mObjBox.len_y()) * 0.5f;
+   params.height = mObjBox.len_z();
+   params.maxSpeed = mMoveSpeed * mDataBlock->maxForwardSpeed;
+   params.maxAcceleration = mDataBlock->runForce / getMax(mMass, 0.001f);
+   params.includeFlags = mLinkTypes.getFlags();
+
+   if(mCrowdAgent < 0)
+   {
+      mCrowdMesh = mesh;
+      mCrowdAgent = crowd->addAgent(this, params);
+      mCrowdParams = params;
+      if(mMoveState != ModeStop)
+         crowd->setTarget(mCrowdAgent, mMoveDestination);
+   }
+   else if(params != mCrowdParams)
+   {
+      crowd->setAgentParams(mCrowdAgent, params);
+      mCrowdParams = params;
+   }
+
+   if(mMoveState == ModeStop)
+      crowd->clearTarget(mCrowdAgent);
+
+   // Nobody can see us cut corners, so skip our own movement code.
+   mCrowdKinematic = smCrowdLOD && mMoveState != ModeStop &&
+      SimulationLOD::getLevel(this) != SimulationLOD::Full;
+   crowd->setKinematic(mCrowdAgent, mCrowdKinematic);
+
+   crowd->update();
+}
+
+void AIPlayer::leaveCrowd()
+{
+   if(mCrowdAgent >= 0 && !mCrowdMesh.isNull())
+      mCrowdMesh->getCrowd()->removeAgent(mCrowdAgent);
+   mCrowdMesh = NULL;
+   mCrowdAgent = -1;
+   mCrowdKinematic = false;
+}
+
+bool AIPlayer::getCrowdMove(Point3F *move) const
+{
+   if(mCrowdAgent < 0 || mCrowdMesh.isNull() || mCrowdParams.maxSpeed <= 0.0f)
+      return false;
+
+   Point3F vel;
+   if(!mCrowdMesh->getCrowd()->getVelocity(mCrowdAgent, &vel))
+      return false;
+
+   move->set(vel.x, vel.y, 0.0f);
+   *move /= mCrowdParams.maxSpeed;
+   return true;
+}
+
 DefineEngineMethod(AIPlayer, repath, void, (),,
    "@brief Tells the AI to re-plan its path. Does nothing if the character "
    "has no path, or if it is following a mission path.\n\n")
@@ -1339,6 +1581,32 @@ DefineEngineMethod(AIPlayer, checkInLos, bool, (ShapeBase* obj,  bool useMuzzle,
    return object->checkInLos(obj, useMuzzle, checkEnabled);
 }
 
+DefineEngineMethod(AIPlayer, canSee, bool, (SceneObject* obj),,
+   "@brief Check whether an object is in view according to the engine's AI sensing.\n\n"
+   "Unlike checkInLos() this casts no ray but returns the result of the last sight check.  "
+   "Requires sightRange to be set.\n"
+   "@param obj Object to check.\n"
+   "@see onSightGained\n")
+{
+   return AISensing::canSee(object, obj);
+}
+
+DefineEngineMethod(AIPlayer, getVisibleObjects, const char*, (),,
+   "@brief Get the objects currently in view according to the engine's AI sensing.\n\n"
+   "@return A space separated list of object ids.\n")
+{
+   Vector<SceneObject*> objects;
+   AISensing::getVisibleObjects(object, objects);
+
+   const U32 bufSize = objects.size() * 12 + 1;
+   char *buf = Con::getReturnBuffer(bufSize);
+   buf[0] = 0;
+   U32 len = 0;
+   for (U32 i = 0; i < objects.size(); i++)
+      len += dSprintf(buf + len, bufSize - len, i ? " %d" : "%d", objects[i]->getId());
+   return buf;
+}
+
 bool AIPlayer::checkInFoV(GameBase* target, F32 camFov, bool _checkEnabled)
 {
    if (!isServerObject()) return false;
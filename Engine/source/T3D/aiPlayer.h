@@ -32,13 +32,17 @@
 #include "T3D/player.h"
 #endif
 
+#ifndef _AISENSING_H_
+#include "T3D/aiSensing.h"
+#endif
+
 #ifdef TORQUE_NAVIGATION_ENABLED
 #include "navigation/navPath.h"
 #include "navigation/navMesh.h"
 #include "navigation/coverPoint.h"
 #endif // TORQUE_NAVIGATION_ENABLED
 
-class AIPlayer : public Player {
+class AIPlayer : public Player, public IAISensor {
 
 	typedef Player Parent;
 
@@ -140,6 +144,42 @@ private:
    /// NavMesh we pathfind on.
    SimObjectPtr<NavMesh> mNavMesh;
 
+   /// Plan our paths on worker threads?
+   bool mAsyncPathing;
+
+   /// Called when an asynchronous plan of our path has finished.
+   void onPathPlanned(NavPath *path, bool success);
+
+   /// @name Crowd
+   /// @{
+
+   /// Steer with our NavMesh's crowd?
+   bool mUseCrowd;
+
+   /// NavMesh whose crowd we are an agent of.
+   SimObjectPtr<NavMesh> mCrowdMesh;
+
+   /// Our agent in the crowd, or -1.
+   S32 mCrowdAgent;
+
+   /// Parameters our agent was last given.
+   NavCrowd::AgentParams mCrowdParams;
+
+   /// Is the crowd moving us instead of our own physics this tick?
+   bool mCrowdKinematic;
+
+   /// Join, update or leave the crowd of our NavMesh and let it steer.
+   void updateCrowdAgent();
+
+   /// Leave the crowd we are in.
+   void leaveCrowd();
+
+   /// Get the move direction the crowd wants, scaled so that full speed is
+   /// length 1.
+   bool getCrowdMove(Point3F *move) const;
+
+   /// @}
+
    /// Move to the specified node in the current path.
    void moveToNode(S32 node);
 #endif // TORQUE_NAVIGATION_ENABLED
@@ -161,6 +201,8 @@ public:
 
    virtual bool getAIMove( Move *move );
    virtual void updateMove(const Move *move);
+   virtual bool updatePos(const F32 travelTime = TickSec);
+   virtual bool isMovingWithoutCollision() const;
    /// Clear out the current path.
    void clearPath();
    /// Stop searching for cover.
@@ -180,6 +222,12 @@ public:
    bool checkInFoV(GameBase* target = NULL, F32 camFov = 45.0f, bool _checkEnabled = false);
    F32 getTargetDistance(GameBase* target, bool _checkEnabled);
 
+   // IAISensor
+   virtual ShapeBase* getSensorBody() { return this; }
+   virtual void onSightGained(SceneObject *target);
+   virtual void onSightLost(SceneObject *target);
+   virtual void onNoiseHeard(const Point3F &position, SceneObject *source);
+
    // Movement sets/gets
    void setMoveSpeed( const F32 speed );
    F32 getMoveSpeed() const { return mMoveSpeed; }
@@ -228,6 +276,10 @@ public:
    /// Types of link we can use.
    LinkData mLinkTypes;
 
+   /// Move crowd agents that are not at full simulation LOD along the
+   /// navmesh instead of through the Player movement code.
+   static bool smCrowdLOD;
+
    /// @}
 #endif // TORQUE_NAVIGATION_ENABLED
    // New method, restartMove(), restores the AIPlayer to its normal move-state
@@ -0,0 +1,623 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "T3D/aiSensing.h"
+
+#include "T3D/shapeBase.h"
+#include "scene/sceneContainer.h"
+#include "scene/sceneTracker.h"
+#include "collision/collision.h"
+#include "console/consoleTypes.h"
+#include "console/engineAPI.h"
+#include "console/simObjectRef.h"
+#include "core/module.h"
+#include "platform/profiler.h"
+
+
+namespace AISensing
+{
+   U32 smMaxRaysPerTick = 128;
+   U32 smCacheTime = 500;
+   F32 smBucketSize = 32.0f;
+
+   /// Objects which can be seen.
+   static const U32 sStimulusTypeMask = PlayerObjectType | VehicleObjectType;
+
+   /// Objects which block sight.
+   static const U32 sSightBlockMask = TerrainObjectType | StaticShapeObjectType | StaticObjectType;
+
+   /// What a sensor knows about an object in its view.
+   struct Contact
+   {
+      SimObjectPtr< SceneObject > target;
+
+      /// Sim time at which the line of sight result expires.
+      SimTime expires;
+
+      /// Result of the last line of sight check.
+      bool visible;
+
+      /// A line of sight ray is queued for this contact.
+      bool pending;
+
+      /// Found by the current scan.
+      bool inView;
+   };
+
+   struct Sensor
+   {
+      IAISensor *sensor;
+
+      /// Stagger of the sight scans.
+      U32 phase;
+
+      Vector< Contact > contacts;
+
+      Contact* findContact( SceneObject *target )
+      {
+         for ( U32 i = 0; i < contacts.size(); i++ )
+            if ( contacts[i].target == target )
+               return &contacts[i];
+         return NULL;
+      }
+   };
+
+   struct Stimulus
+   {
+      SceneObject *object;
+      Point3F position;
+      U32 bucket;
+   };
+
+   struct PendingRay
+   {
+      Sensor *sensor;
+      SimObjectPtr< SceneObject > target;
+      Point3F start;
+      Point3F end;
+   };
+
+   struct Noise
+   {
+      Point3F position;
+      F32 radius;
+      SimObjectPtr< SceneObject > source;
+   };
+
+   struct Event
+   {
+      enum Type
+      {
+         SightGained,
+         SightLost,
+         NoiseHeard,
+      };
+
+      Type type;
+
+      /// Set to NULL if the sensor goes away before delivery.
+      IAISensor *sensor;
+
+      SimObjectPtr< SceneObject > object;
+      Point3F position;
+   };
+
+   static Vector< Sensor* > sSensors;
+
+   /// Stimuli sorted by bucket.  Rebuilt every tick.
+   static Vector< Stimulus > sBuckets;
+
+   /// Line of sight checks waiting for the ray budget in FIFO order.
+   static Vector< PendingRay > sRays;
+
+   static Vector< Noise > sNoises;
+   static Vector< Event > sEvents;
+
+   static U32 sTickCount = 0;
+   static U32 sNextPhase = 0;
+
+   static Vector< SceneContainer::RayQuery > sRayQueries;
+   static Vector< RayInfo > sRayInfos;
+
+
+   class StimulusLink : public SceneObjectLink
+   {
+   public:
+      typedef SceneObjectLink Parent;
+
+      StimulusLink( SceneTracker *tracker, SceneObject *object )
+         :  Parent( tracker, object ),
+            mIndex( 0 )
+      {
+      }
+
+      /// Index in StimulusTracker::mLinks.
+      U32 mIndex;
+   };
+
+   /// Keeps the list of server objects which can be seen.
+   class StimulusTracker : public SceneTracker
+   {
+   public:
+      typedef SceneTracker Parent;
+
+      Vector< StimulusLink* > mLinks;
+
+      StimulusTracker()
+         :  Parent( false, sStimulusTypeMask )
+      {
+      }
+
+      ~StimulusTracker()
+      {
+         for ( U32 i = 0; i < mLinks.size(); i++ )
+            delete mLinks[i];
+      }
+
+      virtual void registerObject( SceneObject *object )
+      {
+         if ( !_isTrackableObject( object ) || SceneObjectLink::getLinkForTracker( this, object ) )
+            return;
+         StimulusLink *link = new StimulusLink( this, object );
+         link->mIndex = mLinks.size();
+         mLinks.push_back( link );
+      }
+
+      virtual void unregisterObject( SceneObject *object )
+      {
+         StimulusLink *link = static_cast< StimulusLink* >( SceneObjectLink::getLinkForTracker( this, object ) );
+         if ( !link )
+            return;
+         mLinks.last()->mIndex = link->mIndex;
+         mLinks.erase_fast( link->mIndex );
+         delete link;
+      }
+
+      virtual void updateObject( SceneObjectLink *object )
+      {
+         // Positions are read when the buckets are rebuilt.
+      }
+   };
+
+   /// Exists while there are sensors.
+   static StimulusTracker *sTracker = NULL;
+}
+
+AFTER_MODULE_INIT( Sim )
+{
+   Con::addVariable( "$AI::sensingMaxRays", TypeS32, &AISensing::smMaxRaysPerTick,
+      "@brief Maximum number of line of sight rays AI sensing casts per tick.\n\n"
+      "Checks over the budget wait for the following ticks.  The default value is 128.\n"
+      "@ingroup AI" );
+
+   Con::addVariable( "$AI::sensingCacheTime", TypeS32, &AISensing::smCacheTime,
+      "@brief Milliseconds an AI sensing line of sight result is reused before it is checked again.\n\n"
+      "The default value is 500.\n"
+      "@ingroup AI" );
+
+   Con::addVariable( "$AI::sensingBucketSize", TypeF32, &AISensing::smBucketSize,
+      "@brief Size in meters of the spatial buckets AI sensing sorts visible objects into.\n\n"
+      "The default value is 32.\n"
+      "@ingroup AI" );
+}
+
+//-----------------------------------------------------------------------------
+
+namespace AISensing
+{
+   static inline S32 getBucketCoord( F32 value )
+   {
+      return (S32)mFloor( value / smBucketSize );
+   }
+
+   static inline U32 getBucketKey( S32 x, S32 y )
+   {
+      return ( (U32)x * 73856093U ) ^ ( (U32)y * 19349663U );
+   }
+
+   static S32 QSORT_CALLBACK compareStimuli( const Stimulus *a, const Stimulus *b )
+   {
+      if ( a->bucket != b->bucket )
+         return a->bucket < b->bucket ? -1 : 1;
+      return 0;
+   }
+
+   /// Return the index of the first stimulus in bucket @a key.
+   static U32 findBucket( U32 key )
+   {
+      U32 lo = 0;
+      U32 hi = sBuckets.size();
+      while ( lo < hi )
+      {
+         const U32 mid = ( lo + hi ) / 2;
+         if ( sBuckets[mid].bucket < key )
+            lo = mid + 1;
+         else
+            hi = mid;
+      }
+      return lo;
+   }
+
+   static void buildBuckets()
+   {
+      PROFILE_SCOPE( AISensing_buildBuckets );
+
+      smBucketSize = getMax( smBucketSize, 1.0f );
+
+      sBuckets.setSize( sTracker->mLinks.size() );
+      for ( U32 i = 0; i < sBuckets.size(); i++ )
+      {
+         Stimulus &stim = sBuckets[i];
+         stim.object = sTracker->mLinks[i]->getObject();
+         stim.position = stim.object->getBoxCenter();
+         stim.bucket = getBucketKey( getBucketCoord( stim.position.x ), getBucketCoord( stim.position.y ) );
+      }
+
+      sBuckets.sort( compareStimuli );
+   }
+
+   static void postEvent( Event::Type type, IAISensor *sensor, SceneObject *object, const Point3F &position = Point3F::Zero )
+   {
+      sEvents.increment();
+      Event &evt = sEvents.last();
+      evt.type = type;
+      evt.sensor = sensor;
+      evt.object = object;
+      evt.position = position;
+   }
+
+   /// Drop all contacts, losing sight of the visible ones.
+   static void clearContacts( Sensor *s )
+   {
+      for ( U32 i = 0; i < s->contacts.size(); i++ )
+      {
+         const Contact &c = s->contacts[i];
+         if ( c.visible && c.target )
+            postEvent( Event::SightLost, s->sensor, c.target );
+      }
+      s->contacts.clear();
+   }
+
+   static void considerStimulus( Sensor *s, const Stimulus &stim, ShapeBase *body,
+                                 const Point3F &eyePos, const VectorF &eyeDir,
+                                 F32 rangeSq, F32 cosHalfFov, SimTime now )
+   {
+      SceneObject *obj = stim.object;
+      if ( obj == body || obj == body->getObjectMount() || obj->getObjectMount() == body )
+         return;
+
+      const VectorF delta = stim.position - eyePos;
+      const F32 distSq = delta.lenSquared();
+      if ( distSq > rangeSq )
+         return;
+      if ( cosHalfFov > -1.0f && distSq > 0.0f && mDot( delta, eyeDir ) < cosHalfFov * mSqrt( distSq ) )
+         return;
+
+      Contact *c = s->findContact( obj );
+      if ( !c )
+      {
+         s->contacts.increment();
+         c = &s->contacts.last();
+         c->target = obj;
+         c->expires = 0;
+         c->visible = false;
+         c->pending = false;
+      }
+      else if ( c->inView )
+         return; // Found twice through colliding bucket keys.
+
+      c->inView = true;
+      if ( c->pending || now < c->expires )
+         return;
+
+      c->pending = true;
+      sRays.increment();
+      PendingRay &ray = sRays.last();
+      ray.sensor = s;
+      ray.target = obj;
+      ray.start = eyePos;
+      ray.end = stim.position;
+   }
+
+   static void scanSight( Sensor *s, SimTime now )
+   {
+      IAISensor *sensor = s->sensor;
+      ShapeBase *body = sensor->getSensorBody();
+      if ( !body || sensor->mSightRange <= 0.0f )
+      {
+         clearContacts( s );
+         return;
+      }
+
+      MatrixF eye;
+      body->getEyeTransform( &eye );
+      const Point3F eyePos = eye.getPosition();
+      VectorF eyeDir;
+      eye.getColumn( 1, &eyeDir );
+
+      const F32 range = sensor->mSightRange;
+      const F32 fov = mClampF( sensor->mSightFov, 0.0f, 360.0f );
+      const F32 cosHalfFov = fov >= 360.0f ? -1.0f : mCos( mDegToRad( fov * 0.5f ) );
+
+      for ( U32 i = 0; i < s->contacts.size(); i++ )
+         s->contacts[i].inView = false;
+
+      const S32 x0 = getBucketCoord( eyePos.x - range );
+      const S32 x1 = getBucketCoord( eyePos.x + range );
+      const S32 y0 = getBucketCoord( eyePos.y - range );
+      const S32 y1 = getBucketCoord( eyePos.y + range );
+
+      if ( (U32)( x1 - x0 + 1 ) * (U32)( y1 - y0 + 1 ) >= sBuckets.size() )
+      {
+         // Looking up the buckets would cost more than testing everything.
+         for ( U32 i = 0; i < sBuckets.size(); i++ )
+            considerStimulus( s, sBuckets[i], body, eyePos, eyeDir, range * range, cosHalfFov, now );
+      }
+      else
+      {
+         for ( S32 y = y0; y <= y1; y++ )
+         {
+            for ( S32 x = x0; x <= x1; x++ )
+            {
+               const U32 key = getBucketKey( x, y );
+               for ( U32 i = findBucket( key ); i < sBuckets.size() && sBuckets[i].bucket == key; i++ )
+                  considerStimulus( s, sBuckets[i], body, eyePos, eyeDir, range * range, cosHalfFov, now );
+            }
+         }
+      }
+
+      // Lose sight of whatever left the view cone or range.
+      for ( S32 i = s->contacts.size() - 1; i >= 0; i-- )
+      {
+         const Contact &c = s->contacts[i];
+         if ( c.inView && c.target )
+            continue;
+         if ( c.visible && c.target )
+            postEvent( Event::SightLost, s->sensor, c.target );
+         s->contacts.erase_fast( i );
+      }
+   }
+
+   static void hearNoises()
+   {
+      for ( U32 n = 0; n < sNoises.size(); n++ )
+      {
+         const Noise &noise = sNoises[n];
+         for ( U32 i = 0; i < sSensors.size(); i++ )
+         {
+            IAISensor *sensor = sSensors[i]->sensor;
+            if ( sensor->mHearingRange <= 0.0f )
+               continue;
+
+            ShapeBase *body = sensor->getSensorBody();
+            if ( !body || body == noise.source )
+               continue;
+
+            const F32 range = getMin( noise.radius, sensor->mHearingRange );
+            if ( ( body->getBoxCenter() - noise.position ).lenSquared() <= range * range )
+               postEvent( Event::NoiseHeard, sensor, noise.source, noise.position );
+         }
+      }
+      sNoises.clear();
+   }
+
+   static void castRays( SimTime now )
+   {
+      const U32 count = getMin( (U32)sRays.size(), smMaxRaysPerTick );
+      if ( !count )
+         return;
+
+      PROFILE_SCOPE( AISensing_castRays );
+
+      sRayQueries.setSize( count );
+      sRayInfos.setSize( count );
+      for ( U32 i = 0; i < count; i++ )
+      {
+         SceneContainer::RayQuery &query = sRayQueries[i];
+         query.start = sRays[i].start;
+         query.end = sRays[i].end;
+         query.mask = sSightBlockMask;
+         query.ignore = NULL;
+      }
+
+      gServerContainer.castRayBatch( sRayQueries.address(), count, sRayInfos.address() );
+
+      for ( U32 i = 0; i < count; i++ )
+      {
+         const PendingRay &ray = sRays[i];
+         if ( !ray.target )
+            continue;
+
+         Contact *c = ray.sensor->findContact( ray.target );
+         if ( !c || !c->pending )
+            continue;
+
+         const bool visible = !sRayInfos[i].object || sRayInfos[i].object == ray.target;
+         c->pending = false;
+         c->expires = now + smCacheTime;
+         if ( visible != c->visible )
+         {
+            c->visible = visible;
+            postEvent( visible ? Event::SightGained : Event::SightLost, ray.sensor->sensor, ray.target );
+         }
+      }
+
+      sRays.erase( 0, count );
+   }
+
+   static void deliverEvents()
+   {
+      // Callbacks may add or remove sensors, which clears their
+      // events, but only the next tick adds new events.
+      for ( U32 i = 0; i < sEvents.size(); i++ )
+      {
+         const Event &evt = sEvents[i];
+         if ( !evt.sensor )
+            continue;
+
+         switch ( evt.type )
+         {
+            case Event::SightGained:
+               if ( evt.object )
+                  evt.sensor->onSightGained( evt.object );
+               break;
+            case Event::SightLost:
+               if ( evt.object )
+                  evt.sensor->onSightLost( evt.object );
+               break;
+            case Event::NoiseHeard:
+               evt.sensor->onNoiseHeard( evt.position, evt.object );
+               break;
+         }
+      }
+      sEvents.clear();
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void AISensing::addSensor( IAISensor *sensor )
+{
+   if ( sensor->mSensorState )
+      return;
+
+   if ( !sTracker )
+   {
+      sTracker = new StimulusTracker();
+      sTracker->init();
+   }
+
+   Sensor *s = new Sensor;
+   s->sensor = sensor;
+   s->phase = sNextPhase++;
+   sensor->mSensorState = s;
+   sSensors.push_back( s );
+}
+
+//-----------------------------------------------------------------------------
+
+void AISensing::removeSensor( IAISensor *sensor )
+{
+   Sensor *s = sensor->mSensorState;
+   if ( !s )
+      return;
+
+   for ( S32 i = sRays.size() - 1; i >= 0; i-- )
+      if ( sRays[i].sensor == s )
+         sRays.erase( i );
+
+   for ( U32 i = 0; i < sEvents.size(); i++ )
+      if ( sEvents[i].sensor == sensor )
+         sEvents[i].sensor = NULL;
+
+   sSensors.remove( s );
+   sensor->mSensorState = NULL;
+   delete s;
+
+   if ( sSensors.empty() )
+   {
+      SAFE_DELETE( sTracker );
+      sBuckets.clear();
+      sNoises.clear();
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void AISensing::addNoise( const Point3F &position, F32 radius, SceneObject *source )
+{
+   if ( sSensors.empty() || radius <= 0.0f )
+      return;
+
+   sNoises.increment();
+   Noise &noise = sNoises.last();
+   noise.position = position;
+   noise.radius = radius;
+   noise.source = source;
+}
+
+//-----------------------------------------------------------------------------
+
+bool AISensing::canSee( IAISensor *sensor, SceneObject *target )
+{
+   if ( !sensor->mSensorState || !target )
+      return false;
+
+   const Contact *c = sensor->mSensorState->findContact( target );
+   return c && c->visible;
+}
+
+//-----------------------------------------------------------------------------
+
+void AISensing::getVisibleObjects( IAISensor *sensor, Vector< SceneObject* > &outObjects )
+{
+   if ( !sensor->mSensorState )
+      return;
+
+   const Vector< Contact > &contacts = sensor->mSensorState->contacts;
+   for ( U32 i = 0; i < contacts.size(); i++ )
+      if ( contacts[i].visible && contacts[i].target )
+         outObjects.push_back( contacts[i].target );
+}
+
+//-----------------------------------------------------------------------------
+
+void AISensing::processTick()
+{
+   if ( sSensors.empty() )
+      return;
+
+   PROFILE_SCOPE( AISensing_processTick );
+
+   sTickCount++;
+   const SimTime now = Sim::getCurrentTime();
+
+   buildBuckets();
+
+   for ( U32 i = 0; i < sSensors.size(); i++ )
+   {
+      Sensor *s = sSensors[i];
+      const U32 interval = getMax( s->sensor->mSenseInterval, 1U );
+      if ( ( sTickCount + s->phase ) % interval == 0 )
+         scanSight( s, now );
+   }
+
+   hearNoises();
+   castRays( now );
+   deliverEvents();
+}
+
+//-----------------------------------------------------------------------------
+
+DefineEngineFunction( addAINoise, void, ( Point3F position, F32 radius, SceneObject* source ), ( nullAsType<SceneObject*>() ),
+   "@brief Make a noise which AI within @a radius of @a position can hear.\n\n"
+   "Each AIPlayer or AIClient with a hearing range gets an onNoiseHeard callback at the end of the "
+   "tick if the noise is within both the radius and its hearing range.\n"
+   "@param position Where the noise is made.\n"
+   "@param radius Distance the noise carries.\n"
+   "@param source Object which made the noise, if any.  It does not hear itself.\n"
+   "@ingroup AI" )
+{
+   AISensing::addNoise( position, radius, source );
+}
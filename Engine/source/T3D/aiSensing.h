@@ -0,0 +1,138 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _AISENSING_H_
+#define _AISENSING_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _MPOINT3_H_
+#include "math/mPoint3.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+class SceneObject;
+class ShapeBase;
+
+namespace AISensing
+{
+   struct Sensor;
+}
+
+
+/// Interface for AI controllers which want to see and hear things through
+/// the AISensing manager.
+///
+/// The sensing parameters are read every time the sensor is processed, so
+/// they may be changed at any time.
+class IAISensor
+{
+public:
+
+   /// Maximum distance at which objects are seen.  Zero disables sight.
+   F32 mSightRange;
+
+   /// Full angle of the view cone in degrees.  360 sees all around.
+   F32 mSightFov;
+
+   /// Maximum distance at which noises are heard.  Zero disables hearing.
+   F32 mHearingRange;
+
+   /// Number of ticks between sight scans.
+   U32 mSenseInterval;
+
+   /// Internal state; owned by AISensing.
+   AISensing::Sensor *mSensorState;
+
+   IAISensor()
+      :  mSightRange( 0.0f ),
+         mSightFov( 90.0f ),
+         mHearingRange( 0.0f ),
+         mSenseInterval( 4 ),
+         mSensorState( NULL )
+   {
+   }
+
+   virtual ~IAISensor() {}
+
+   /// Return the object whose eye the sensor uses or NULL if it
+   /// has none at the moment.
+   virtual ShapeBase* getSensorBody() = 0;
+
+   /// Called when @a target comes into view.
+   virtual void onSightGained( SceneObject *target ) = 0;
+
+   /// Called when @a target, which was in view, is no longer.
+   virtual void onSightLost( SceneObject *target ) = 0;
+
+   /// Called when a noise made by @a source, which may be NULL,
+   /// is heard at @a position.
+   virtual void onNoiseHeard( const Point3F &position, SceneObject *source ) = 0;
+};
+
+
+/// Server side sight and hearing for AI controlled objects.
+///
+/// Players and vehicles are kept in spatial buckets which are rebuilt every
+/// tick.  Each sensor scans the buckets within its sight range every
+/// IAISensor::mSenseInterval ticks, staggered across sensors, and queues
+/// line of sight checks for the candidates in its field of view.  The checks
+/// are cast as one batch per tick up to a budget and their results are cached
+/// for a while, so the number of rays no longer grows with agents times targets.
+///
+/// Events are delivered at the end of the server tick.
+namespace AISensing
+{
+   /// Maximum number of line of sight rays cast per tick.
+   extern U32 smMaxRaysPerTick;
+
+   /// Milliseconds a line of sight result stays valid.
+   extern U32 smCacheTime;
+
+   /// Size of the spatial buckets in meters.
+   extern F32 smBucketSize;
+
+   /// Register a sensor.  Does nothing if it already is registered.
+   void addSensor( IAISensor *sensor );
+
+   /// Unregister a sensor and drop any of its pending events.
+   void removeSensor( IAISensor *sensor );
+
+   /// Make a noise heard by sensors within @a radius of @a position.
+   void addNoise( const Point3F &position, F32 radius, SceneObject *source = NULL );
+
+   /// Return true if @a target is currently in view of @a sensor.
+   bool canSee( IAISensor *sensor, SceneObject *target );
+
+   /// Get the objects currently in view of @a sensor.
+   void getVisibleObjects( IAISensor *sensor, Vector< SceneObject* > &outObjects );
+
+   /// Scan sensors, cast line of sight rays and deliver events.  Called
+   /// by the server process list at the end of every tick.
+   void processTick();
+}
+
+#endif // _AISENSING_H_
@@ -1028,14 +1028,14 @@ void Camera::writePacketData(GameConnection *connection, BitStream *bstream)
       if(writeMode == OrbitObjectMode)
       {
          bstream->writeFlag(mObservingClientObject);
-         bstream->writeInt(gIndex, NetConnection::GhostIdBitSize);
+         NetConnection::writeGhostIndex(bstream, gIndex);
       }
       if (writeMode == OrbitPointMode)
          bstream->writeCompressedPoint(writePos);
    }
    else if(writeMode == TrackObjectMode)
    {
-      bstream->writeInt(gIndex, NetConnection::GhostIdBitSize);
+      NetConnection::writeGhostIndex(bstream, gIndex);
    }
 
    if(bstream->writeFlag(mNewtonMode))
@@ -1089,7 +1089,7 @@ void Camera::readPacketData(GameConnection *connection, BitStream *bstream)
       if(mMode == OrbitObjectMode)
       {
          mObservingClientObject = bstream->readFlag();
-         S32 gIndex = bstream->readInt(NetConnection::GhostIdBitSize);
+         S32 gIndex = NetConnection::readGhostIndex(bstream);
          obj = static_cast<GameBase*>(connection->resolveGhost(gIndex));
       }
       if (mMode == OrbitPointMode)
@@ -1097,7 +1097,7 @@ void Camera::readPacketData(GameConnection *connection, BitStream *bstream)
    }
    else if (mMode == TrackObjectMode)
    {
-      S32 gIndex = bstream->readInt(NetConnection::GhostIdBitSize);
+      S32 gIndex = NetConnection::readGhostIndex(bstream);
       obj = static_cast<GameBase*>(connection->resolveGhost(gIndex));
    }
 
@@ -22,6 +22,7 @@
 
 #include "T3D/components/collision/collisionInterfaces.h"
 #include "scene/sceneObject.h"
+#include "collision/collisionStats.h"
 #include "T3D/entity.h"
 #include "console/engineAPI.h"
 #include "T3D/trigger.h"
@@ -233,6 +234,7 @@ bool CollisionInterface::checkEarlyOut(Point3F start, VectorF velocity, F32 time
             {
                // No need to separate out the physical zones here, we want those
                //  to cause a fallthrough as well...
+               CollisionStats::count( CollisionStats::ConvexPolyList, pConvex );
                pConvex->getPolyList(&eaPolyList);
             }
          }
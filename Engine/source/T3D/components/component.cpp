@@ -279,7 +279,7 @@ U32 Component::packUpdate(NetConnection *con, U32 mask, BitStream *stream)
          {
             stream->writeFlag(true);
             stream->writeFlag(true);
-            stream->writeInt(ghostIndex, NetConnection::GhostIdBitSize);
+            NetConnection::writeGhostIndex(stream, ghostIndex);
          }
       }
       else
@@ -319,7 +319,7 @@ void Component::unpackUpdate(NetConnection *con, BitStream *stream)
       if (stream->readFlag())
       {
          //we have an owner object, so fetch it
-         S32 gIndex = stream->readInt(NetConnection::GhostIdBitSize);
+         S32 gIndex = NetConnection::readGhostIndex(stream);
 
          Entity *e = dynamic_cast<Entity*>(con->resolveGhost(gIndex));
          if (e)
@@ -104,10 +104,10 @@ void MeshComponent::onComponentAdd()
    Parent::onComponentAdd();
 
    if (isClientObject())
-      mInterfaceData->mIsClient = true;
+      mInterfaceData->getSystemData().isClient = true;
 
   // if (mInterfaceData != nullptr)
-  //   mInterfaceData->mIsClient = isClientObject();
+  //   mInterfaceData->getSystemData().isClient = isClientObject();
 
    //get the default shape, if any
    updateShape();
@@ -259,7 +259,7 @@ void MeshComponent::updateShape()
 
          if (mInterfaceData)
          {
-            mInterfaceData->mBounds.set(min, max);
+            mInterfaceData->getSystemData().bounds.set(min, max);
             mInterfaceData->mScale = mOwner->getScale();
             mInterfaceData->mTransform = mOwner->getRenderTransform();
          }
@@ -276,7 +276,7 @@ void MeshComponent::updateShape()
       {
          if (mRenderMode == StaticBatch)
          {
-            mInterfaceData->mStatic = true;
+            mInterfaceData->getSystemData().isStatic = true;
 
             OptimizedPolyList geom;
             MatrixF transform = mInterfaceData->mTransform;
@@ -287,7 +287,7 @@ void MeshComponent::updateShape()
          }
          else
          {
-            mInterfaceData->mStatic = false;
+            mInterfaceData->getSystemData().isStatic = false;
          }
 
          MeshRenderSystem::rebuildBuffers();
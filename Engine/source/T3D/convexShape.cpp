@@ -68,22 +68,7 @@ Point3F ConvexShapeCollisionConvex::support( const VectorF &vec ) const
 	// perpendicular to it, but in that case maybe it doesn't matter which point we return
 	// anyway.
 
-	F32 bestDot = mDot( pointList[0], vec );
-
-	const Point3F *bestP = &pointList[0];
-
-	for ( S32 i = 1; i < pointList.size(); i++ )
-	{
-		F32 newD = mDot( pointList[i], vec );
-
-		if ( newD > bestDot )
-		{
-			bestDot = newD;
-			bestP = &pointList[i];
-		}
-	}
-
-	return *bestP;
+	return pointList[ MathUtils::findSupportPoint( vec, pointList.address(), pointList.size() ) ];
 }
 
 void ConvexShapeCollisionConvex::getFeatures( const MatrixF &mat, const VectorF &n, ConvexFeature *cf )
@@ -653,8 +638,11 @@ bool ConvexShape::buildPolyList( PolyListContext context, AbstractPolyList *plis
 
    const Vector< ConvexShape::Face > faceList = mGeometry.faces;
 
-   if(context == PLC_Navigation)
+   // Ray cast geometry also wants the material castRay() reports.
+   if(context == PLC_Navigation || context == PLC_RayCast)
    {
+      BaseMatInstance *matInst = context == PLC_RayCast ? mMaterialInst : NULL;
+
       for(S32 i = 0; i < faceList.size(); i++)
       {
          const ConvexShape::Face &face = faceList[i];
@@ -662,7 +650,7 @@ bool ConvexShape::buildPolyList( PolyListContext context, AbstractPolyList *plis
          S32 s = face.triangles.size();
          for(S32 j = 0; j < s; j++)
          {
-            plist->begin(0, s*i + j);
+            plist->begin(matInst, s*i + j);
 
             plist->plane(PlaneF(face.centroid, face.normal));
 
@@ -1065,6 +1053,10 @@ void ConvexShape::_updateGeometry( bool updateCollision )
    // Update bounding box.   
    updateBounds( false );
 
+   // Any baked ray cast geometry is out of date now.
+   if ( getContainer() )
+      getContainer()->releaseStaticCollision( this );
+
 	mVertexBuffer = NULL;
 	mPrimitiveBuffer = NULL;
 	mVertCount = 0;
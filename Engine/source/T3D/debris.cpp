@@ -44,8 +44,12 @@
 #include "gfx/gfxTransformSaver.h"
 #include "console/engineAPI.h"
 #include "lighting/lightQuery.h"
+#include "T3D/fx/fxObjectPool.h"
 
 
+/// Expired debris waiting to be reused.
+static FXObjectPool<Debris> sgDebrisPool;
+
 const U32 csmStaticCollisionMask = TerrainObjectType | StaticShapeObjectType | StaticObjectType;
 
 IMPLEMENT_CO_DATABLOCK_V1(DebrisData);
@@ -533,6 +537,7 @@ Debris::Debris()
    mInitialTrans.identity();
    mRadius = 0.2f;
    mStatic = false;
+   mRecycle = false;
 
    dMemset( mEmitterList, 0, sizeof( mEmitterList ) );
 
@@ -597,6 +602,39 @@ bool Debris::onNewDataBlock( GameBaseData *dptr, bool reload )
 
 }
 
+Debris* Debris::create( DebrisData *datablock )
+{
+   Debris *debris = sgDebrisPool.acquire( datablock );
+   if( !debris )
+   {
+      debris = new Debris;
+      debris->setDataBlock( datablock );
+      debris->mRecycle = true;
+   }
+
+   return debris;
+}
+
+bool Debris::spawn()
+{
+   if( !isProperlyAdded() )
+   {
+      if( registerObject() )
+         return true;
+
+      delete this;
+      return false;
+   }
+
+   if( !start() )
+   {
+      deleteObject();
+      return false;
+   }
+
+   return true;
+}
+
 bool Debris::onAdd()
 {
    if( !Parent::onAdd() )
@@ -610,17 +648,20 @@ bool Debris::onAdd()
       return false;
    }
 
+   return start();
+}
+
+bool Debris::start()
+{
    // create emitters
    for( S32 i=0; i<DebrisData::DDC_NUM_EMITTERS; i++ )
    {
       if( mDataBlock->emitterList[i] != NULL )
       {
-         ParticleEmitter * pEmitter = new ParticleEmitter;
-         pEmitter->onNewDataBlock(mDataBlock->emitterList[i]->cloneAndPerformSubstitutions(ss_object, ss_index), false);
-         if( !pEmitter->registerObject() )
+         ParticleEmitter * pEmitter = ParticleEmitter::create(mDataBlock->emitterList[i]->cloneAndPerformSubstitutions(ss_object, ss_index));
+         if( !pEmitter->spawn() )
          {
             Con::warnf( ConsoleLogEntry::General, "Could not register emitter for particle of class: %s", mDataBlock->getName() );
-            delete pEmitter;
             pEmitter = NULL;
          }
          mEmitterList[i] = pEmitter;
@@ -676,7 +717,8 @@ bool Debris::onAdd()
       mObjBox = Box3F(Point3F(-1, -1, -1), Point3F(1, 1, 1));
    }
 
-   if( mDataBlock->shape )
+   // Pooled debris still has the instance of its last launch.
+   if( mDataBlock->shape && !mShape )
    {
       mShape = new TSShapeInstance( mDataBlock->shape, true);
    }
@@ -732,14 +774,9 @@ bool Debris::onAdd()
 
 void Debris::onRemove()
 {
-   for( S32 i=0; i<DebrisData::DDC_NUM_EMITTERS; i++ )
-   {
-      if( mEmitterList[i] )
-      {
-         mEmitterList[i]->deleteWhenEmpty();
-         mEmitterList[i] = NULL;
-      }
-   }
+   sgDebrisPool.remove( this );
+
+   releaseEmitters();
 
    if( mPart )
    {
@@ -759,10 +796,48 @@ void Debris::onRemove()
    Parent::onRemove();
 }
 
+void Debris::releaseEmitters()
+{
+   for( S32 i=0; i<DebrisData::DDC_NUM_EMITTERS; i++ )
+   {
+      if( mEmitterList[i] )
+      {
+         mEmitterList[i]->deleteWhenEmpty();
+         mEmitterList[i] = NULL;
+      }
+   }
+}
+
+void Debris::expire()
+{
+   if( !mRecycle || mPart || !sgDebrisPool.release( this, mDataBlock ) )
+   {
+      deleteObject();
+      return;
+   }
+
+   // Go dormant and reset to the state of a new debris.  The shape
+   // instance is kept for the next launch with this datablock.
+   releaseEmitters();
+   removeFromScene();
+   removeFromProcessList();
+
+   mVelocity.set( 0.0f, 0.0f, 4.0f );
+   mSize = 2.0f;
+   mElapsedTime = 0.0f;
+   mXRotSpeed = 0.0f;
+   mZRotSpeed = 0.0f;
+   mInitialTrans.identity();
+   mRadius = 0.2f;
+   mStatic = false;
+   ss_object = 0;
+   ss_index = 0;
+}
+
 void Debris::processTick(const Move*)
 {
    if (mLifetime <= 0.0)
-      deleteObject();
+      expire();
 }
 
 void Debris::advanceTime( F32 dt )
@@ -896,17 +971,15 @@ void Debris::explode()
 
    Point3F explosionPos = getPosition();
 
-   Explosion* pExplosion = new Explosion;
+   Explosion* pExplosion = Explosion::create(mDataBlock->explosion->cloneAndPerformSubstitutions(ss_object, ss_index));
    pExplosion->setSubstitutionData(ss_object, ss_index);
-   pExplosion->onNewDataBlock(mDataBlock->explosion->cloneAndPerformSubstitutions(ss_object, ss_index), false);
 
    MatrixF trans( true );
    trans.setPosition( getPosition() );
 
    pExplosion->setTransform( trans );
    pExplosion->setInitialState( explosionPos, VectorF(0,0,1), 1);
-   if (!pExplosion->registerObject())
-      delete pExplosion;
+   pExplosion->spawn();
 }
 
 void Debris::computeNewState( Point3F &newPos, Point3F &newVel, F32 dt )
@@ -136,6 +136,9 @@ private:
    F32               mElasticity;
    F32               mFriction;
 
+   /// Set for debris from create() which is pooled when it expires.
+   bool              mRecycle;
+
    SimObjectPtr<ParticleEmitter> mEmitterList[ DebrisData::DDC_NUM_EMITTERS ];
 
    /// Bounce the debris - returns true if debris bounces.
@@ -158,6 +161,15 @@ protected:
    void           onRemove();
    void           updateEmitters( Point3F &pos, Point3F &vel, U32 ms );
 
+   /// Starts the debris, shared by onAdd() and spawn().
+   bool           start();
+
+   /// Returns the debris to the FX object pool or deletes it.
+   void           expire();
+
+   /// Lets the emitters die out once their particles are gone.
+   void           releaseEmitters();
+
 public:
 
    Debris();
@@ -167,6 +179,14 @@ public:
 
    bool   onNewDataBlock( GameBaseData *dptr, bool reload );
 
+   /// Returns a dormant pooled debris for @a datablock or a new,
+   /// unregistered one.  Debris given a part instance is never pooled.
+   static Debris* create( DebrisData *datablock );
+
+   /// Registers a debris from create(), or restarts it if it came from
+   /// the pool.  The debris is deleted if this fails.
+   bool   spawn();
+
    void  init( const Point3F &position, const Point3F &velocity );
    void  setLifetime( F32 lifetime ){ mLifetime = lifetime; }
    void  setPartInstance( TSPartInstance *part ){ mPart = part; }
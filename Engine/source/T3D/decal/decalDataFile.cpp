@@ -240,6 +240,7 @@ bool DecalDataFile::read( Stream &stream )
       inst->mIndices = NULL;
       inst->mVertCount = 0;
       inst->mIndxCount = 0;
+      inst->mSphere = NULL;
 
       data = allDatablocks[ dataIndex ];
 
@@ -276,6 +277,7 @@ DecalInstance* DecalDataFile::addDecal( const Point3F& pos, const Point3F& norma
    newDecal->mRenderPriority = 0;
    newDecal->mCustomTex = NULL;
    newDecal->mId = -1;
+   newDecal->mSphere = NULL;
 
    newDecal->mPosition = pos;
    newDecal->mNormal = normal;
@@ -350,6 +352,7 @@ void DecalDataFile::_addDecalToSpheres( DecalInstance* inst )
    mSphereWithLastInsertion = sphere;
 
    sphere->mItems.push_back( inst );
+   inst->mSphere = sphere;
 }
 
 //-----------------------------------------------------------------------------
@@ -378,6 +381,11 @@ bool DecalDataFile::_removeDecalFromSpheres( DecalInstance *inst )
       if( !items.remove( inst ) )
          continue;
 
+      inst->mSphere = NULL;
+      sphere->mItemsDirty = true;
+      if( sphere->mBatchedItems.contains( inst ) )
+         sphere->mBatchesDirty = true;
+
       // If the sphere is now empty, remove it.  Otherwise, update
       // it's bounds.
 
@@ -33,6 +33,7 @@
 
 struct DecalVertex;
 class SceneRenderState;
+class DecalSphere;
 
 /// DecalInstance represents a rendering decal in the scene.
 /// You should not allocate this yourself, add new decals to the scene
@@ -72,6 +73,9 @@ class DecalInstance
 
       GFXTexHandle *mCustomTex;
 
+      /// The DecalSphere this instance is binned in or NULL.
+      DecalSphere *mSphere;
+
       void getWorldMatrix( MatrixF *outMat, bool flip = false );
       
       Box3F getWorldBox() const
@@ -87,7 +91,7 @@ class DecalInstance
       /// Calculates the size of this decal onscreen in pixels, used for LOD.
       F32 calcPixelSize( U32 viewportHeight, const Point3F &cameraPos, F32 worldToScreenScaleY ) const;
    		
-	   DecalInstance() : mId(-1) {}   
+	   DecalInstance() : mId(-1), mSphere(NULL) {}   
 };
 
 #endif // _DECALINSTANCE_H_
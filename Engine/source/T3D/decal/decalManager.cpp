@@ -48,6 +48,7 @@
 #include "core/module.h"
 #include "T3D/decal/decalData.h"
 #include "console/engineAPI.h"
+#include "platform/threads/threadPool.h"
 
 
 extern bool gEditingMission;
@@ -81,6 +82,10 @@ bool      DecalManager::smDecalsOn = true;
 bool      DecalManager::smDebugRender = false;
 F32       DecalManager::smDecalLifeTimeScale = 1.0f;
 bool      DecalManager::smPoolBuffers = true;
+bool      DecalManager::smCacheSphereBatches = true;
+bool      DecalManager::smAsyncClipping = true;
+S32       DecalManager::smMaxClipsPerFrame = 16;
+S32       DecalManager::smGeometryBudget = 4096;
 const U32 DecalManager::smMaxVerts = 6000;
 const U32 DecalManager::smMaxIndices = 10000;
 
@@ -200,16 +205,100 @@ S32 QSORT_CALLBACK cmpDecalRenderOrder( const void *p1, const void *p2 )
 } // namespace {}
 
 // These numbers should be tweaked to get as many dynamically placed decals
-// as possible to allocate buffer arrays with the FreeListChunker.
+// as possible to allocate buffer arrays with the FreeListChunker.  A clipped
+// decal on terrain is usually a few dozen vertices at 48 bytes each.
 enum
 {
-   SIZE_CLASS_0 = 256,
-   SIZE_CLASS_1 = 512,
-   SIZE_CLASS_2 = 1024,
+   SIZE_CLASS_0 = 1024,
+   SIZE_CLASS_1 = 2048,
+   SIZE_CLASS_2 = 8192,
    
    NUM_SIZE_CLASSES = 3
 };
 
+
+/// Finishes the clipping of a decal on the thread pool.
+///
+/// Gathering the polys touches the scene and is done on the main
+/// thread before the item is queued.  Triangulation, normals and
+/// texture coordinates are worked out here and the result is handed
+/// to the DecalManager on the main thread.
+class DecalClipWorkItem : public ThreadWorkItem
+{
+public:
+
+   typedef ThreadWorkItem Parent;
+
+   DecalClipWorkItem( DecalInstance *decal )
+      :  mDecal( decal ),
+         mHalfSize( decal->mSize * 0.5f ),
+         mTexRect( decal->mDataBlock->texRect[decal->mTextureRectIdx] ),
+         mSkipVertexNormals( decal->mDataBlock->skipVertexNormals ),
+         mSucceeded( false ),
+         mCancelled( false )
+   {
+   }
+
+   /// Stops the clip if it has not completed yet.
+   void cancel() { mCancelled = true; }
+
+   // ThreadPool::WorkItem
+   virtual bool isCancellationRequested() { return mCancelled; }
+
+   /// The decal to hand the result to.  It is only touched on
+   /// the main thread.
+   DecalInstance *mDecal;
+
+   ClippedPolyList mClipper;
+   MatrixF mProjMat;
+   F32 mHalfSize;
+   RectF mTexRect;
+   bool mSkipVertexNormals;
+
+   Vector<DecalVertex> mVerts;
+   Vector<U16> mIndices;
+   bool mSucceeded;
+
+protected:
+
+   /// Hands the result to the DecalManager on the main thread.
+   class CompletionItem : public ThreadWorkItem
+   {
+   public:
+
+      CompletionItem( DecalClipWorkItem *item )
+         : mItem( item )
+      {
+      }
+
+   protected:
+
+      ThreadSafeRef< DecalClipWorkItem > mItem;
+
+      virtual void execute()
+      {
+         if ( !mItem->mCancelled && gDecalManager )
+            gDecalManager->_onClipDecalDone( mItem );
+      }
+   };
+
+   volatile bool mCancelled;
+
+   virtual void execute()
+   {
+      if ( cancellationPoint() )
+         return;
+
+      mSucceeded = DecalManager::_buildDecalGeometry(  mClipper, mProjMat, mHalfSize, mTexRect, 
+                                                       mSkipVertexNormals, &mVerts, &mIndices );
+
+      if ( cancellationPoint() )
+         return;
+
+      ThreadPool::queueWorkItemOnMainThread( new CompletionItem( this ) );
+   }
+};
+
 //-------------------------------------------------------------------------
 // DecalManager
 //-------------------------------------------------------------------------
@@ -226,6 +315,7 @@ DecalManager::DecalManager()
    mTypeMask |= EnvironmentObjectType;
 
    mDirty = false;
+   mBudgetedBytes = 0;
 
    mChunkers[0] = new FreeListChunkerUntyped( SIZE_CLASS_0 * sizeof( U8 ) );
    mChunkers[1] = new FreeListChunkerUntyped( SIZE_CLASS_1 * sizeof( U8 ) );
@@ -261,6 +351,27 @@ void DecalManager::consoleInit()
       "If false, will just clear them at the end of a frame.\n"
       "@ingroup Decals" );
 
+   Con::addVariable( "$Decals::cacheSphereBatches", TypeBool, &smCacheSphereBatches,
+      "If true, the geometry of clipped editor placed decals is kept in static "
+      "buffers per decal sphere and only the remaining decals are copied into "
+      "the dynamic buffers each frame.\n"
+      "@ingroup Decals" );
+
+   Con::addVariable( "$Decals::asyncClipping", TypeBool, &smAsyncClipping,
+      "If true, newly placed decals finish clipping their geometry on the "
+      "thread pool and appear once it is done.\n"
+      "@ingroup Decals" );
+
+   Con::addVariable( "$pref::Decals::maxClipsPerFrame", TypeS32, &smMaxClipsPerFrame,
+      "The number of dynamic decals which start clipping per frame when "
+      "$Decals::asyncClipping is enabled.  The rest wait for a later frame.\n"
+      "@ingroup Decals" );
+
+   Con::addVariable( "$pref::Decals::geometryBudget", TypeS32, &smGeometryBudget,
+      "The memory in kilobytes available for the geometry of dynamic decals. "
+      "New decals which do not fit are dropped.  Zero or less disables the limit.\n"
+      "@ingroup Decals" );
+
    Con::addVariable( "$Decals::debugRender", TypeBool, &smDebugRender,
       "If true, the decal spheres will be visualized when in the editor.\n\n"
       "@ingroup Decals" );
@@ -309,18 +420,65 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
 {
    PROFILE_SCOPE( DecalManager_clipDecal );
 
+   // A synchronous clip replaces any clip still in flight.
+   _cancelClipDecal( decal );
+
    // Free old verts and indices.
    _freeBuffers( decal );
+   _invalidateSphereBatches( decal );
+
+   MatrixF projMat;
+   _gatherDecalGeometry( decal, clipDepth, &projMat, &mClipper );
+
+   const F32 halfSize = decal->mSize * 0.5f;
+   const RectF &texRect = decal->mDataBlock->texRect[decal->mTextureRectIdx];
+
+   if ( !_buildDecalGeometry( mClipper, projMat, halfSize, texRect, decal->mDataBlock->skipVertexNormals, &mClipVerts, &mClipIndices ) )
+      return false;
+
+   if ( !_setDecalGeometry( decal, mClipVerts, mClipIndices ) )
+      return false;
+
+   if ( !edgeVerts )
+      return true;
+
+   Point3F tmpHullPt( 0, 0, 0 );
+   Vector<Point3F> tmpHullPts;
+
+   projMat.inverse();
+
+   for ( U32 i = 0; i < mClipper.mVertexList.size(); i++ )
+   {
+      const ClippedPolyList::Vertex &vert = mClipper.mVertexList[i];
+      tmpHullPt = vert.point;
+      projMat.mulP( tmpHullPt );
+      tmpHullPts.push_back( tmpHullPt );
+   }
+
+   edgeVerts->clear();
+   U32 verts = _generateConvexHull( tmpHullPts, edgeVerts );
+   edgeVerts->setSize( verts );
+
+   projMat.inverse();
+   for ( U32 i = 0; i < edgeVerts->size(); i++ )
+      projMat.mulP( (*edgeVerts)[i] );
+
+   return true;
+}
+
+void DecalManager::_gatherDecalGeometry( DecalInstance *decal, const Point2F *clipDepth, MatrixF *outProjMat, ClippedPolyList *clipper )
+{
+   PROFILE_SCOPE( DecalManager_gatherDecalGeometry );
 
    F32 halfSize = decal->mSize * 0.5f;
    
    // Ugly hack for ProjectedShadow!
    F32 halfSizeZ = clipDepth ? clipDepth->x : halfSize;
    F32 negHalfSize = clipDepth ? clipDepth->y : halfSize;
-   Point3F decalHalfSize( halfSize, halfSize, halfSize );
    Point3F decalHalfSizeZ( halfSizeZ, halfSizeZ, halfSizeZ );
 
-   MatrixF projMat( true );
+   MatrixF &projMat = *outProjMat;
+   projMat.identity();
    decal->getWorldMatrix( &projMat );
 
    const VectorF &crossVec = decal->mNormal;
@@ -330,39 +488,51 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
    projMat.getColumn( 0, &newRight );
    projMat.getColumn( 1, &newFwd );   
 
-   VectorF objRight( 1.0f, 0, 0 );
-   VectorF objFwd( 0, 1.0f, 0 );
-   VectorF objUp( 0, 0, 1.0f );
-
    // See above re: decalHalfSizeZ hack.
-   mClipper.clear();
-   mClipper.mPlaneList.setSize(6);
-   mClipper.mPlaneList[0].set( ( decalPos + ( -newRight * halfSize ) ), -newRight );
-   mClipper.mPlaneList[1].set( ( decalPos + ( -newFwd * halfSize ) ), -newFwd );
-   mClipper.mPlaneList[2].set( ( decalPos + ( -crossVec * decalHalfSizeZ ) ), -crossVec );
-   mClipper.mPlaneList[3].set( ( decalPos + ( newRight * halfSize ) ), newRight );
-   mClipper.mPlaneList[4].set( ( decalPos + ( newFwd * halfSize ) ), newFwd );
-   mClipper.mPlaneList[5].set( ( decalPos + ( crossVec * negHalfSize ) ), crossVec );
+   clipper->clear();
+   clipper->mPlaneList.setSize(6);
+   clipper->mPlaneList[0].set( ( decalPos + ( -newRight * halfSize ) ), -newRight );
+   clipper->mPlaneList[1].set( ( decalPos + ( -newFwd * halfSize ) ), -newFwd );
+   clipper->mPlaneList[2].set( ( decalPos + ( -crossVec * decalHalfSizeZ ) ), -crossVec );
+   clipper->mPlaneList[3].set( ( decalPos + ( newRight * halfSize ) ), newRight );
+   clipper->mPlaneList[4].set( ( decalPos + ( newFwd * halfSize ) ), newFwd );
+   clipper->mPlaneList[5].set( ( decalPos + ( crossVec * negHalfSize ) ), crossVec );
 
-   mClipper.mNormal = decal->mNormal;
+   clipper->mNormal = decal->mNormal;
 
    const DecalData *decalData = decal->mDataBlock;
 
-   mClipper.mNormalTolCosineRadians = mCos( mDegToRad( decalData->clippingAngle ) );
+   clipper->mNormalTolCosineRadians = mCos( mDegToRad( decalData->clippingAngle ) );
 
    Box3F box( -decalHalfSizeZ, decalHalfSizeZ );
 
    projMat.mul( box );
 
    PROFILE_START( DecalManager_clipDecal_buildPolyList );
-   getContainer()->buildPolyList( PLC_Decal, box, decalData->clippingMasks, &mClipper );   
+   getContainer()->buildPolyList( PLC_Decal, box, decalData->clippingMasks, clipper );   
    PROFILE_END();
 
-   mClipper.cullUnusedVerts();
-   mClipper.triangulate();
+#ifdef DECALMANAGER_DEBUG
+   mDebugPlanes.clear();
+   mDebugPlanes.merge( clipper->mPlaneList );
+#endif
+}
+
+bool DecalManager::_buildDecalGeometry(   ClippedPolyList &clipper,
+                                          const MatrixF &worldMat,
+                                          F32 halfSize,
+                                          const RectF &texRect,
+                                          bool skipVertexNormals,
+                                          Vector<DecalVertex> *outVerts,
+                                          Vector<U16> *outIndices )
+{
+   PROFILE_SCOPE( DecalManager_buildDecalGeometry );
+
+   clipper.cullUnusedVerts();
+   clipper.triangulate();
    
-   const U32 numVerts = mClipper.mVertexList.size();
-   const U32 numIndices = mClipper.mIndexList.size();
+   const U32 numVerts = clipper.mVertexList.size();
+   const U32 numIndices = clipper.mIndexList.size();
 
    if ( !numVerts || !numIndices )
       return false;
@@ -373,17 +543,14 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
         numIndices > smMaxIndices )
       return false;
 
-   if ( !decalData->skipVertexNormals )
-      mClipper.generateNormals();
-   
-#ifdef DECALMANAGER_DEBUG
-   mDebugPlanes.clear();
-   mDebugPlanes.merge( mClipper.mPlaneList );
-#endif
+   if ( !skipVertexNormals )
+      clipper.generateNormals();
+
+   Point3F decalHalfSize( halfSize, halfSize, halfSize );
+
+   VectorF objRight( 1.0f, 0, 0 );
+   VectorF objFwd( 0, 1.0f, 0 );
 
-   decal->mVertCount = numVerts;
-   decal->mIndxCount = numIndices;
-   
    Vector<Point3F> tmpPoints;
 
    tmpPoints.push_back(( objFwd * decalHalfSize ) + ( objRight * decalHalfSize ));
@@ -392,6 +559,7 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
    
    Point3F lowerLeft(( -objFwd * decalHalfSize ) + ( objRight * decalHalfSize ));
 
+   MatrixF projMat( worldMat );
    projMat.inverse();
 
    _generateWindingOrder( lowerLeft, &tmpPoints );
@@ -404,18 +572,15 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
    Point2F uv( 0, 0 );
    Point3F vecX(0.0f, 0.0f, 0.0f);
 
-   // Allocate memory for vert and index arrays
-   _allocBuffers( decal );  
+   outVerts->setSize( numVerts );
+   outIndices->setSize( numIndices );
 
-   // Mark this so that the color will be assigned on these verts the next
-   // time it renders, since we just threw away the previous verts.
-   decal->mLastAlpha = -1;
-   
    Point3F vertPoint( 0, 0, 0 );
 
-   for ( U32 i = 0; i < mClipper.mVertexList.size(); i++ )
+   for ( U32 i = 0; i < clipper.mVertexList.size(); i++ )
    {
-      const ClippedPolyList::Vertex &vert = mClipper.mVertexList[i];
+      const ClippedPolyList::Vertex &vert = clipper.mVertexList[i];
+      DecalVertex &outVert = (*outVerts)[i];
       vertPoint = vert.point;
 
       // Transform this point to
@@ -430,73 +595,88 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
       // Get our UV.
       uv = quadToSquare.transform( Point2F( vertPoint.x, vertPoint.y ) );
 
-      const RectF &rect = decal->mDataBlock->texRect[decal->mTextureRectIdx];
-
-      uv *= rect.extent;
-      uv += rect.point;      
+      uv *= texRect.extent;
+      uv += texRect.point;      
 
       // Set the world space vertex position.
-      decal->mVerts[i].point = vert.point;
+      outVert.point = vert.point;
       
-      decal->mVerts[i].texCoord.set( uv.x, uv.y );
+      outVert.texCoord.set( uv.x, uv.y );
       
-      if ( mClipper.mNormalList.empty() )
+      if ( clipper.mNormalList.empty() )
          continue;
 
-      decal->mVerts[i].normal = mClipper.mNormalList[i];
-      decal->mVerts[i].normal.normalize();
+      outVert.normal = clipper.mNormalList[i];
+      outVert.normal.normalize();
 
-      if( mFabs( decal->mVerts[i].normal.z ) > 0.8f ) 
-         mCross( decal->mVerts[i].normal, Point3F( 1.0f, 0.0f, 0.0f ), &vecX );
-      else if ( mFabs( decal->mVerts[i].normal.x ) > 0.8f )
-         mCross( decal->mVerts[i].normal, Point3F( 0.0f, 1.0f, 0.0f ), &vecX );
-      else if ( mFabs( decal->mVerts[i].normal.y ) > 0.8f )
-         mCross( decal->mVerts[i].normal, Point3F( 0.0f, 0.0f, 1.0f ), &vecX );
+      if( mFabs( outVert.normal.z ) > 0.8f ) 
+         mCross( outVert.normal, Point3F( 1.0f, 0.0f, 0.0f ), &vecX );
+      else if ( mFabs( outVert.normal.x ) > 0.8f )
+         mCross( outVert.normal, Point3F( 0.0f, 1.0f, 0.0f ), &vecX );
+      else if ( mFabs( outVert.normal.y ) > 0.8f )
+         mCross( outVert.normal, Point3F( 0.0f, 0.0f, 1.0f ), &vecX );
    
-      decal->mVerts[i].tangent = mCross( decal->mVerts[i].normal, vecX );
+      outVert.tangent = mCross( outVert.normal, vecX );
    }
 
    U32 curIdx = 0;
-   for ( U32 j = 0; j < mClipper.mPolyList.size(); j++ )
+   for ( U32 j = 0; j < clipper.mPolyList.size(); j++ )
    {
       // Write indices for each Poly
-      ClippedPolyList::Poly *poly = &mClipper.mPolyList[j];                  
+      ClippedPolyList::Poly *poly = &clipper.mPolyList[j];                  
 
       AssertFatal( poly->vertexCount == 3, "Got non-triangle poly!" );
 
-      decal->mIndices[curIdx] = mClipper.mIndexList[poly->vertexStart];         
+      (*outIndices)[curIdx] = clipper.mIndexList[poly->vertexStart];         
       curIdx++;
-      decal->mIndices[curIdx] = mClipper.mIndexList[poly->vertexStart + 1];            
+      (*outIndices)[curIdx] = clipper.mIndexList[poly->vertexStart + 1];            
       curIdx++;
-      decal->mIndices[curIdx] = mClipper.mIndexList[poly->vertexStart + 2];                
+      (*outIndices)[curIdx] = clipper.mIndexList[poly->vertexStart + 2];                
       curIdx++;
    } 
 
-   if ( !edgeVerts )
-      return true;
+   return true;
+}
 
-   Point3F tmpHullPt( 0, 0, 0 );
-   Vector<Point3F> tmpHullPts;
+bool DecalManager::_setDecalGeometry( DecalInstance *decal, const Vector<DecalVertex> &verts, const Vector<U16> &indices )
+{
+   _freeBuffers( decal );
+   _invalidateSphereBatches( decal );
 
-   for ( U32 i = 0; i < mClipper.mVertexList.size(); i++ )
-   {
-      const ClippedPolyList::Vertex &vert = mClipper.mVertexList[i];
-      tmpHullPt = vert.point;
-      projMat.mulP( tmpHullPt );
-      tmpHullPts.push_back( tmpHullPt );
-   }
+   // Dynamic decals beyond the memory budget are dropped.
+   const U32 bytes = sizeof( DecalVertex ) * verts.size() + sizeof( U16 ) * indices.size();
+   if (  smGeometryBudget > 0 &&
+         _isBudgeted( decal ) && 
+         mBudgetedBytes + bytes > (U32)smGeometryBudget * 1024 )
+      return false;
 
-   edgeVerts->clear();
-   U32 verts = _generateConvexHull( tmpHullPts, edgeVerts );
-   edgeVerts->setSize( verts );
+   decal->mVertCount = verts.size();
+   decal->mIndxCount = indices.size();
 
-   projMat.inverse();
-   for ( U32 i = 0; i < edgeVerts->size(); i++ )
-      projMat.mulP( (*edgeVerts)[i] );
+   // Allocate memory for vert and index arrays
+   _allocBuffers( decal );  
+
+   dMemcpy( decal->mVerts, verts.address(), sizeof( DecalVertex ) * verts.size() );
+   dMemcpy( decal->mIndices, indices.address(), sizeof( U16 ) * indices.size() );
+
+   // Mark this so that the color will be assigned on these verts the next
+   // time it renders, since we just threw away the previous verts.
+   decal->mLastAlpha = -1;
 
    return true;
 }
 
+void DecalManager::_invalidateSphereBatches( DecalInstance *decal )
+{
+   // The cached batches of the sphere hold a copy of the old geometry.
+   if ( decal->mSphere )
+   {
+      decal->mSphere->mItemsDirty = true;
+      if ( decal->mSphere->mBatchedItems.contains( decal ) )
+         decal->mSphere->mBatchesDirty = true;
+   }
+}
+
 DecalInstance* DecalManager::addDecal( const Point3F &pos,
                                        const Point3F &normal,
                                        F32 rotAroundNormal,
@@ -551,6 +731,7 @@ void DecalManager::removeDecal( DecalInstance *inst )
    
    // Release its geometry (if it has any).
 
+   _cancelClipDecal( inst );
    _freeBuffers( inst );
    
    // Remove it from the decal file.
@@ -576,6 +757,20 @@ void DecalManager::notifyDecalModified( DecalInstance *inst )
 
    if ( mData )
       mData->notifyDecalModified( inst );
+
+   if ( inst->mSphere && _isBatchable( inst ) )
+      inst->mSphere->mBatchesDirty = true;
+
+   // A clip in flight used the old placement, so start over.
+   for ( U32 i = 0; i < mPendingClips.size(); i++ )
+   {
+      if ( mPendingClips[i]->mDecal == inst )
+      {
+         _cancelClipDecal( inst );
+         inst->mFlags |= ClipDecal;
+         break;
+      }
+   }
 }
 
 DecalInstance* DecalManager::getClosestDecal( const Point3F &pos )
@@ -923,12 +1118,18 @@ void DecalManager::_allocBuffers( DecalInstance *inst )
    inst->mVerts = reinterpret_cast< DecalVertex* >( data );
    data = (U8*)data + sizeof( DecalVertex ) * inst->mVertCount;
    inst->mIndices = reinterpret_cast< U16* >( data );
+
+   if ( _isBudgeted( inst ) )
+      mBudgetedBytes += sizeof( DecalVertex ) * inst->mVertCount + sizeof( U16 ) * inst->mIndxCount;
 }
 
 void DecalManager::_freeBuffers( DecalInstance *inst )
 {
    if ( inst->mVerts != NULL )
    {
+      if ( _isBudgeted( inst ) )
+         mBudgetedBytes -= sizeof( DecalVertex ) * inst->mVertCount + sizeof( U16 ) * inst->mIndxCount;
+
       const S32 sizeClass = _getSizeClass( inst );
       
       if ( sizeClass == -1 )
@@ -988,6 +1189,248 @@ S32 DecalManager::_getSizeClass( DecalInstance *inst ) const
    return -1;
 }
 
+bool DecalManager::_isBudgeted( const DecalInstance *inst ) const
+{
+   // Editor decals must always render and custom decals are
+   // managed by their owner.
+   return !( inst->mFlags & ( SaveDecal | CustomDecal ) );
+}
+
+bool DecalManager::_queueClipDecal( DecalInstance *decal )
+{
+   _cancelClipDecal( decal );
+
+   ThreadSafeRef< DecalClipWorkItem > item( new DecalClipWorkItem( decal ) );
+   _gatherDecalGeometry( decal, NULL, &item->mProjMat, &item->mClipper );
+
+   // Nothing to clip against, so fail right away.
+   if ( item->mClipper.mPolyList.empty() )
+      return false;
+
+   mPendingClips.push_back( item );
+   ThreadPool::GLOBAL().queueWorkItem( item );
+
+   return true;
+}
+
+void DecalManager::_cancelClipDecal( DecalInstance *decal )
+{
+   for ( U32 i = 0; i < mPendingClips.size(); i++ )
+   {
+      if ( mPendingClips[i]->mDecal != decal )
+         continue;
+
+      mPendingClips[i]->cancel();
+      mPendingClips.erase_fast( i );
+      return;
+   }
+}
+
+void DecalManager::_cancelAllClips()
+{
+   for ( U32 i = 0; i < mPendingClips.size(); i++ )
+      mPendingClips[i]->cancel();
+
+   mPendingClips.clear();
+}
+
+void DecalManager::_onClipDecalDone( DecalClipWorkItem *item )
+{
+   // Only hand over the result if the clip is still the pending one.
+   bool found = false;
+   for ( U32 i = 0; i < mPendingClips.size(); i++ )
+   {
+      if ( mPendingClips[i] != item )
+         continue;
+
+      mPendingClips.erase_fast( i );
+      found = true;
+      break;
+   }
+
+   if ( !found )
+      return;
+
+   DecalInstance *decal = item->mDecal;
+
+   if ( item->mSucceeded && _setDecalGeometry( decal, item->mVerts, item->mIndices ) )
+      return;
+
+   // If the decal is one placed at run-time (not the editor)
+   // then we permanently delete the decal instance.  Editor
+   // decals try again the next time they are modified.
+   if ( !( decal->mFlags & SaveDecal ) )
+      removeDecal( decal );
+}
+
+bool DecalManager::_isBatchable( const DecalInstance *inst ) const
+{
+   // Only clipped editor decals which never fade over time.  Dynamic
+   // decals come and go too often to be worth a static buffer.
+   if ( ( inst->mFlags & ( PermanentDecal | SaveDecal ) ) != ( PermanentDecal | SaveDecal ) ||
+        inst->mFlags & ( ClipDecal | CustomDecal ) ||
+        inst->mCustomTex )
+      return false;
+
+   return   inst->mVerts && 
+            inst->mVertCount > 0 && inst->mVertCount <= smMaxVerts &&
+            inst->mIndxCount > 0 && inst->mIndxCount <= smMaxIndices;
+}
+
+void DecalManager::_updateSphereBatches( DecalSphere *sphere )
+{
+   PROFILE_SCOPE( DecalManager_UpdateSphereBatches );
+
+   Vector<DecalInstance*> batched;
+   sphere->mUnbatchedItems.clear();
+
+   for ( U32 i = 0; i < sphere->mItems.size(); i++ )
+   {
+      DecalInstance *inst = sphere->mItems[i];
+      if ( _isBatchable( inst ) )
+         batched.push_back( inst );
+      else
+         sphere->mUnbatchedItems.push_back( inst );
+   }
+
+   sphere->mItemsDirty = false;
+
+   dQsort( batched.address(), batched.size(), sizeof(DecalInstance*), cmpDecalRenderOrder );
+
+   // Adding or removing a dynamic decal does not touch the batches.
+   if (  !sphere->mBatchesDirty &&
+         batched.size() == sphere->mBatchedItems.size() &&
+         dMemcmp( batched.address(), sphere->mBatchedItems.address(), batched.size() * sizeof(DecalInstance*) ) == 0 )
+      return;
+
+   sphere->mBatchesDirty = false;
+   sphere->mBatchedItems = batched;
+   sphere->mBatches.clear();
+   sphere->mVB = NULL;
+   sphere->mPB = NULL;
+   sphere->mMinDecalSize = F32_MAX;
+   sphere->mMaxFadePixelSize = -1.0f;
+
+   if ( batched.empty() )
+      return;
+
+   // Split the decals into batches with the same rules as the
+   // dynamic path, remembering how many decals go into each.
+   Vector<U32> decalCounts;
+   Material *batchMat = NULL;
+   U32 vertCount = 0;
+   U32 indexCount = 0;
+
+   for ( U32 i = 0; i < batched.size(); i++ )
+   {
+      DecalInstance *inst = batched[i];
+      DecalData *data = inst->mDataBlock;
+      Material *mat = data->getMaterial();
+
+      DecalSphere::Batch *batch = sphere->mBatches.empty() ? NULL : &sphere->mBatches.last();
+      if (  batch == NULL ||
+            batch->vertCount + inst->mVertCount > smMaxVerts ||
+            batch->indexCount + inst->mIndxCount > smMaxIndices ||
+            batchMat != mat ||
+            batch->priority != inst->getRenderPriority() )
+      {
+         sphere->mBatches.increment();
+         batch = &sphere->mBatches.last();
+         batch->startVertex = vertCount;
+         batch->vertCount = 0;
+         batch->startIndex = indexCount;
+         batch->indexCount = 0;
+         batch->priority = inst->getRenderPriority();
+         batch->dataBlock = data;
+         batch->matInst = data->getMaterialInstance();
+         batchMat = mat;
+
+         decalCounts.push_back( 0 );
+      }
+
+      batch->vertCount += inst->mVertCount;
+      batch->indexCount += inst->mIndxCount;
+      decalCounts.last()++;
+
+      vertCount += inst->mVertCount;
+      indexCount += inst->mIndxCount;
+
+      // Decals with pixel size fading disabled are always opaque.
+      if ( data->fadeStartPixelSize >= 0.0f )
+      {
+         sphere->mMinDecalSize = getMin( sphere->mMinDecalSize, inst->mSize );
+         sphere->mMaxFadePixelSize = getMax( sphere->mMaxFadePixelSize, getMax( data->fadeStartPixelSize, data->fadeEndPixelSize ) );
+      }
+   }
+
+   // The cached copy is only drawn while every decal is fully
+   // opaque, so the alpha is baked in.
+   GFXVertexColor opaque;
+   opaque.set( 255, 255, 255, 255 );
+
+   sphere->mVB.set( GFX, vertCount, GFXBufferTypeStatic );
+   sphere->mPB.set( GFX, indexCount, 0, GFXBufferTypeStatic );
+
+   DecalVertex *vertPtr = sphere->mVB.lock();
+   U16 *indexPtr;
+   sphere->mPB.lock( &indexPtr );
+
+   U32 decal = 0;
+   for ( U32 i = 0; i < sphere->mBatches.size(); i++ )
+   {
+      U32 voffset = 0;
+
+      for ( U32 j = 0; j < decalCounts[i]; j++, decal++ )
+      {
+         const DecalInstance *inst = batched[decal];
+
+         dMemcpy( vertPtr, inst->mVerts, sizeof( DecalVertex ) * inst->mVertCount );
+         for ( U32 k = 0; k < inst->mVertCount; k++ )
+            vertPtr[k].color = opaque;
+
+         for ( U32 k = 0; k < inst->mIndxCount; k++ )
+            indexPtr[k] = inst->mIndices[k] + voffset;
+
+         vertPtr += inst->mVertCount;
+         indexPtr += inst->mIndxCount;
+         voffset += inst->mVertCount;
+      }
+   }
+
+   sphere->mPB.unlock();
+   sphere->mVB.unlock();
+}
+
+bool DecalManager::_canRenderSphereBatches( DecalSphere *sphere, SceneRenderState *state )
+{
+   if ( sphere->mBatches.empty() )
+      return false;
+
+   // A reloaded material invalidates the instances we hold.
+   for ( U32 i = 0; i < sphere->mBatches.size(); i++ )
+   {
+      const DecalSphere::Batch &batch = sphere->mBatches[i];
+      if ( batch.dataBlock->getMaterialInstance() != batch.matInst )
+      {
+         sphere->mBatchesDirty = true;
+         return false;
+      }
+   }
+
+   if ( sphere->mMaxFadePixelSize < 0.0f )
+      return true;
+
+   // Conservative version of DecalInstance::calcPixelSize, using the
+   // smallest decal at the far side of the sphere.  If that is still
+   // above every fade threshold nothing in the sphere fades.
+   const SphereF &worldSphere = sphere->mWorldSphere;
+   const F32 distance = ( state->getCameraPosition() - worldSphere.center ).len() + worldSphere.radius;
+   const F32 pixelScale = state->getViewport().extent.y / 300.0f;
+   const F32 pixelSize = sphere->mMinDecalSize / distance * state->getWorldToScreenScale().y * pixelScale;
+
+   return pixelSize >= sphere->mMaxFadePixelSize;
+}
+
 void DecalManager::prepRenderImage( SceneRenderState* state )
 {
    PROFILE_SCOPE( DecalManager_RenderDecals );
@@ -1007,7 +1450,8 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
    const Frustum& rootFrustum = state->getCameraFrustum();
 
    // Populate vector of decal instances to be rendered with all
-   // decals from visible decal spheres.
+   // decals from visible decal spheres.  Spheres with cached batches
+   // only contribute the decals which are not in those batches.
 
    SceneManager* sceneManager = state->getSceneManager();
    SceneZoneSpaceManager* zoneManager = sceneManager->getZoneManager();
@@ -1016,6 +1460,7 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
    const bool haveOnlyOutdoorZone = ( zoneManager->getNumActiveZones() == 1 );
    
    mDecalQueue.clear();
+   mBatchedSphereQueue.clear();
    for ( U32 i = 0; i < grid.size(); i++ )
    {
       DecalSphere* decalSphere = grid[i];
@@ -1047,6 +1492,19 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
       // could do an LOD step on it here and skip adding any of the
       // decals in the sphere.
 
+      if ( smCacheSphereBatches )
+      {
+         if ( decalSphere->mItemsDirty || decalSphere->mBatchesDirty )
+            _updateSphereBatches( decalSphere );
+
+         if ( _canRenderSphereBatches( decalSphere, state ) )
+         {
+            mBatchedSphereQueue.push_back( decalSphere );
+            mDecalQueue.merge( decalSphere->mUnbatchedItems );
+            continue;
+         }
+      }
+
       mDecalQueue.merge( decalSphere->mItems );
    }
 
@@ -1055,6 +1513,7 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
    PROFILE_START( DecalManager_RenderDecals_Update );
 
    const U32 &curSimTime = Sim::getCurrentTime();   
+   S32 clipsStarted = 0;
    F32 pixelSize;
    U32 delta, diff;
    DecalInstance *dinst;
@@ -1103,7 +1562,30 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
       }
 
       // Build clipped geometry for this decal if needed.
-      if ( dinst->mFlags & ClipDecal && !( dinst->mFlags & CustomDecal ) )
+      if ( dinst->mFlags & ClipDecal && !( dinst->mFlags & CustomDecal ) && smAsyncClipping )
+      {
+         // Gathering the polys reads the scene so it stays on this
+         // thread.  Limit how many dynamic decals start each frame so
+         // a burst of them is spread over several frames.  Until the
+         // clip completes the decal has no geometry and is skipped.
+         if ( ( dinst->mFlags & SaveDecal ) || clipsStarted < smMaxClipsPerFrame )
+         {
+            dinst->mFlags = dinst->mFlags & ~ClipDecal;
+            clipsStarted++;
+
+            if ( !_queueClipDecal( dinst ) )
+            {
+               mDecalQueue.erase_fast( i );
+               i--;
+
+               if ( !(dinst->mFlags & SaveDecal) )
+                  removeDecal( dinst );
+
+               continue;
+            }
+         }
+      }
+      else if ( dinst->mFlags & ClipDecal && !( dinst->mFlags & CustomDecal ) )
       {  
          // Turn off the flag so we don't continually try to clip
          // if it fails.
@@ -1179,7 +1661,7 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
 
    PROFILE_END();      
 
-   if ( mDecalQueue.empty() )
+   if ( mDecalQueue.empty() && mBatchedSphereQueue.empty() )
       return;
 
    // Sort queued decals...
@@ -1217,7 +1699,8 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
    // the deferred bin.
    baseRenderInst.sortDistSq = F32_MAX;
 
-   Vector<DecalBatch> batches;
+   Vector<DecalBatch> &batches = mBatches;
+   batches.clear();
    DecalBatch *currentBatch = NULL;
 
    // Loop through DecalQueue collecting them into render batches.
@@ -1439,7 +1922,55 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
       renderPass->addInst( ri );
    }
 
+   // Submit the cached batches of the spheres.  Their buffers are
+   // owned by the spheres, so there is nothing to copy.
+   for ( U32 i = 0; i < mBatchedSphereQueue.size(); i++ )
+   {
+      DecalSphere *sphere = mBatchedSphereQueue[i];
+
+      for ( U32 j = 0; j < sphere->mBatches.size(); j++ )
+      {
+         const DecalSphere::Batch &batch = sphere->mBatches[j];
+
+         if ( batch.matInst->isForwardLit() && !baseRenderInst.lights[0] )
+         {
+            LightQuery query;
+            query.init( rootFrustum.getPosition(),
+                        rootFrustum.getTransform().getForwardVector(),
+                        rootFrustum.getFarDist() );
+            query.getLights( baseRenderInst.lights, 8 );
+         }
+
+         MeshRenderInst *ri = renderPass->allocInst<MeshRenderInst>();
+         *ri = baseRenderInst;
+
+         ri->primBuff = &sphere->mPB;
+         ri->vertBuff = &sphere->mVB;
+
+         ri->matInst = batch.matInst;
+
+         // The indices are relative to the first vertex of the batch.
+         ri->prim = renderPass->allocPrim();
+         ri->prim->type = GFXTriangleList;
+         ri->prim->minIndex = 0;
+         ri->prim->startIndex = batch.startIndex;
+         ri->prim->numPrimitives = batch.indexCount / 3;
+         ri->prim->startVertex = batch.startVertex;
+         ri->prim->numVertices = batch.vertCount;
+
+         // Only editor decals are cached.
+         ri->defaultKey = (U32)batch.priority;
+         ri->defaultKey2 = 1;
+
+         renderPass->addInst( ri );
+      }
+   }
+
 #ifdef TORQUE_GATHER_METRICS
+   U32 cachedBatchCount = 0;
+   for ( U32 i = 0; i < mBatchedSphereQueue.size(); i++ )
+      cachedBatchCount += mBatchedSphereQueue[i]->mBatches.size();
+   Con::setIntVariable( "$Decal::CachedBatches", cachedBatchCount );
    Con::setIntVariable( "$Decal::Batches", batches.size() );
    Con::setIntVariable( "$Decal::Buffers", mPBs.size() + mPBPool.size() );
    Con::setIntVariable( "$Decal::DecalsRendered", mDecalQueue.size() );
@@ -1560,6 +2091,8 @@ bool DecalManager::loadDecals( const UTF8 *fileName )
 void DecalManager::clearData()
 {
    mClearDataSignal.trigger();
+
+   _cancelAllClips();
    
    // Free all geometry buffers.
    
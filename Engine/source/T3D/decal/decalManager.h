@@ -67,8 +67,15 @@
 //#define DECALMANAGER_DEBUG
 
 
+#ifndef _THREADPOOL_H_
+#include "platform/threads/threadPool.h"
+#endif
+
+
 struct ObjectRenderInst;
 class Material;
+class DecalSphere;
+class DecalClipWorkItem;
 
 
 enum DecalFlags 
@@ -97,8 +104,22 @@ class DecalManager : public SceneObject
       /// to avoid excessive memory allocations.
       ClippedPolyList mClipper;
 
+      /// The geometry built by synchronous clips, kept around for
+      /// the same reason.
+      Vector<DecalVertex> mClipVerts;
+      Vector<U16> mClipIndices;
+
+      /// Clips running on the thread pool.
+      Vector< ThreadSafeRef< DecalClipWorkItem > > mPendingClips;
+
+      /// Bytes of decal geometry counted against #smGeometryBudget.
+      U32 mBudgetedBytes;
+
       Vector<DecalInstance*> mDecalQueue;
 
+      /// Visible spheres whose cached batches are submitted this frame.
+      Vector<DecalSphere*> mBatchedSphereQueue;
+
       StringTableEntry mDataFileName;
       Resource<DecalDataFile> mData;
       
@@ -130,12 +151,19 @@ class DecalManager : public SceneObject
          bool dynamic;
       };
 
+      /// Batches built in prepRenderImage(), kept so they don't reallocate every frame.
+      Vector<DecalBatch> mBatches;
+
       /// Whether to render visualizations for debugging in the editor.
       static bool smDebugRender;
 
       static bool smDecalsOn;
       static F32 smDecalLifeTimeScale;   
       static bool smPoolBuffers;
+      static bool smCacheSphereBatches;
+      static bool smAsyncClipping;
+      static S32 smMaxClipsPerFrame;
+      static S32 smGeometryBudget;
       static const U32 smMaxVerts;
       static const U32 smMaxIndices;
 
@@ -159,7 +187,52 @@ class DecalManager : public SceneObject
       // Rendering
       void prepRenderImage( SceneRenderState *state );
       
-      void _generateWindingOrder( const Point3F &cornerPoint, Vector<Point3F> *sortPoints );
+      static void _generateWindingOrder( const Point3F &cornerPoint, Vector<Point3F> *sortPoints );
+
+      /// @name Clipping
+      ///
+      /// Clipping is split so that only the part which reads the scene
+      /// has to run on the main thread.
+      /// @{
+
+      /// Sets up the clip planes for the decal and gathers the scene
+      /// polys into the clipper.
+      void _gatherDecalGeometry( DecalInstance *decal, const Point2F *clipDepth, MatrixF *outProjMat, ClippedPolyList *clipper );
+
+      /// Triangulates the gathered polys and works out the final
+      /// vertices.  Only touches its arguments, so it is safe to call
+      /// from a worker thread.
+      static bool _buildDecalGeometry( ClippedPolyList &clipper,
+                                       const MatrixF &projMat,
+                                       F32 halfSize,
+                                       const RectF &texRect,
+                                       bool skipVertexNormals,
+                                       Vector<DecalVertex> *outVerts,
+                                       Vector<U16> *outIndices );
+
+      /// Replaces the geometry of the decal.  Returns false if it
+      /// does not fit into the geometry budget.
+      bool _setDecalGeometry( DecalInstance *decal, const Vector<DecalVertex> &verts, const Vector<U16> &indices );
+
+      /// Starts an asynchronous clip of the decal.  Returns false if
+      /// there was nothing to clip against.
+      bool _queueClipDecal( DecalInstance *decal );
+
+      /// Cancels the pending clip of the decal, if any.
+      void _cancelClipDecal( DecalInstance *decal );
+      void _cancelAllClips();
+
+      void _onClipDecalDone( DecalClipWorkItem *item );
+
+      /// Returns true if the geometry of the decal counts against
+      /// the geometry budget.
+      bool _isBudgeted( const DecalInstance *inst ) const;
+
+      /// Flags the cached batches of the sphere of the decal for
+      /// an update.
+      void _invalidateSphereBatches( DecalInstance *decal );
+
+      /// @}
 
       // Helpers for creating and deleting the vert and index arrays
       // held by DecalInstance.
@@ -171,6 +244,19 @@ class DecalManager : public SceneObject
       /// allocating vertex and index arrays.
       S32 _getSizeClass( DecalInstance *inst ) const;
 
+      /// Returns true if the decal can be kept in the static
+      /// buffers of its DecalSphere.
+      bool _isBatchable( const DecalInstance *inst ) const;
+
+      /// Splits the sphere items into batched and unbatched ones and
+      /// rebuilds the cached buffers if the batched geometry changed.
+      void _updateSphereBatches( DecalSphere *sphere );
+
+      /// Returns true if the cached batches of the sphere are valid
+      /// and every batched decal renders fully opaque from the
+      /// current camera.
+      bool _canRenderSphereBatches( DecalSphere *sphere, SceneRenderState *state );
+
       // Hide this from Doxygen
       /// @cond
       bool _handleGFXEvent(GFXDevice::GFXDeviceEventType event);
@@ -187,6 +273,8 @@ class DecalManager : public SceneObject
       virtual bool onSceneAdd();
       virtual void onSceneRemove();   public:
 
+      friend class DecalClipWorkItem;
+
    public:
 
       DecalManager();
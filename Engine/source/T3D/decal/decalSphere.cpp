@@ -59,6 +59,8 @@ bool DecalSphere::tryAddItem( DecalInstance* inst )
    // Otherwise, go with this sphere and add the item to it.
 
    mItems.push_back( inst );
+   inst->mSphere = this;
+   mItemsDirty = true;
 
    // Update the sphere bounds, if necessary.
 
@@ -31,9 +31,22 @@
 #include "math/mSphere.h"
 #endif
 
+#ifndef _GFXVERTEXBUFFER_H_
+#include "gfx/gfxVertexBuffer.h"
+#endif
+
+#ifndef _GFXPRIMITIVEBUFFER_H_
+#include "gfx/gfxPrimitiveBuffer.h"
+#endif
+
+#ifndef _DECALDATA_H_
+#include "T3D/decal/decalData.h"
+#endif
+
 
 class DecalInstance;
 class SceneZoneSpaceManager;
+class BaseMatInstance;
 
 
 /// A bounding sphere in world space and a list of DecalInstance(s)
@@ -46,15 +59,45 @@ class DecalSphere
       static F32 smDistanceTolerance;
       static F32 smRadiusTolerance;
 
+      /// A range of the cached buffers which is drawn with a
+      /// single material.
+      struct Batch
+      {
+         U32 startVertex;
+         U32 vertCount;
+         U32 startIndex;
+         U32 indexCount;
+         U8 priority;
+
+         /// The datablock of the first decal in the batch, used to
+         /// detect material reloads.
+         DecalData *dataBlock;
+         BaseMatInstance *matInst;
+      };
+
       DecalSphere()
+         : mItemsDirty( true ),
+           mBatchesDirty( true ),
+           mMinDecalSize( 0.0f ),
+           mMaxFadePixelSize( 0.0f )
       {
          VECTOR_SET_ASSOCIATION( mItems );
          VECTOR_SET_ASSOCIATION( mZones );
+         VECTOR_SET_ASSOCIATION( mBatchedItems );
+         VECTOR_SET_ASSOCIATION( mUnbatchedItems );
+         VECTOR_SET_ASSOCIATION( mBatches );
       }
       DecalSphere( const Point3F &position, F32 radius )
+         : mItemsDirty( true ),
+           mBatchesDirty( true ),
+           mMinDecalSize( 0.0f ),
+           mMaxFadePixelSize( 0.0f )
       {
          VECTOR_SET_ASSOCIATION( mItems );
          VECTOR_SET_ASSOCIATION( mZones );
+         VECTOR_SET_ASSOCIATION( mBatchedItems );
+         VECTOR_SET_ASSOCIATION( mUnbatchedItems );
+         VECTOR_SET_ASSOCIATION( mBatches );
 
          mWorldSphere.center = position;
          mWorldSphere.radius = radius;
@@ -78,6 +121,43 @@ class DecalSphere
 
       ///
       bool tryAddItem( DecalInstance* inst );
+
+      /// @name Cached Batches
+      ///
+      /// Clipped editor placed decals rarely change, so the DecalManager
+      /// keeps their geometry in static buffers per sphere and submits
+      /// whole spheres with a handful of draw calls.  Everything else
+      /// goes through the per-frame dynamic buffers.
+      /// @{
+
+      /// Set when an item is added or removed.  The split between
+      /// #mBatchedItems and #mUnbatchedItems is recomputed.
+      bool mItemsDirty;
+
+      /// Set when the geometry of a batched item changes.  The
+      /// buffers are rebuilt.
+      bool mBatchesDirty;
+
+      /// Items whose geometry lives in #mVB and #mPB.
+      Vector< DecalInstance* > mBatchedItems;
+
+      /// Items which must be rendered through the dynamic path.
+      Vector< DecalInstance* > mUnbatchedItems;
+
+      Vector< Batch > mBatches;
+
+      GFXVertexBufferHandle< DecalVertex > mVB;
+      GFXPrimitiveBufferHandle mPB;
+
+      /// The smallest batched decal, used for a conservative
+      /// pixel size test of the whole batch.
+      F32 mMinDecalSize;
+
+      /// The largest DecalData::fadeStartPixelSize or
+      /// DecalData::fadeEndPixelSize of the batched decals.
+      F32 mMaxFadePixelSize;
+
+      /// @}
 };
 
 #endif // !_DECALSPHERE_H_
\ No newline at end of file
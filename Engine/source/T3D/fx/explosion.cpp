@@ -56,6 +56,7 @@
 #include "console/engineAPI.h"
 
 #include "sfx/sfxProfile.h"
+#include "T3D/fx/fxObjectPool.h"
 
 IMPLEMENT_CONOBJECT(Explosion);
 
@@ -145,6 +146,9 @@ ConsoleDocClass( Explosion,
 
 MRandomLCG sgRandom(0xdeadbeef);
 
+/// Expired explosions waiting to be reused.
+static FXObjectPool<Explosion> sgExplosionPool;
+
 //WLE - Vince - The defaults are bad, the whole point of calling this function\
 //is to determine the explosion coverage on a object.  Why would you want them
 //To call this with a null for the ID?  In fact, it just returns a 1f if
@@ -914,6 +918,7 @@ Explosion::Explosion()
    mEndingMS = 1000;
    mActive = false;
    mCollideType = 0;
+   mRecycle = false;
 
    mInitialNormal.set( 0.0f, 0.0f, 1.0f );
    mRandAngle = sgRandom.randF( 0.0f, 1.0f ) * M_PI_F * 2.0f;
@@ -958,6 +963,39 @@ void Explosion::setInitialState(const Point3F& point, const Point3F& normal, con
    mFade            = fade;
 }
 
+Explosion* Explosion::create( ExplosionData *datablock )
+{
+   Explosion *explosion = sgExplosionPool.acquire( datablock );
+   if ( !explosion )
+   {
+      explosion = new Explosion;
+      explosion->setDataBlock( datablock );
+      explosion->mRecycle = true;
+   }
+
+   return explosion;
+}
+
+bool Explosion::spawn()
+{
+   if ( !isProperlyAdded() )
+   {
+      if ( registerObject() )
+         return true;
+
+      delete this;
+      return false;
+   }
+
+   if ( !start() )
+   {
+      deleteObject();
+      return false;
+   }
+
+   return true;
+}
+
 //--------------------------------------------------------------------------
 void Explosion::initPersistFields()
 {
@@ -981,6 +1019,11 @@ bool Explosion::onAdd()
       return false;
    }
 
+   return start();
+}
+
+bool Explosion::start()
+{
    mDelayMS = mDataBlock->delayMS + sgRandom.randI( -mDataBlock->delayVariance, mDataBlock->delayVariance );
    mEndingMS = mDataBlock->lifetimeMS + sgRandom.randI( -mDataBlock->lifetimeVariance, mDataBlock->lifetimeVariance );
 
@@ -1078,6 +1121,16 @@ bool Explosion::onAdd()
 }
 
 void Explosion::onRemove()
+{
+   sgExplosionPool.remove( this );
+
+   releaseEmitters();
+   removeFromScene();
+
+   Parent::onRemove();
+}
+
+void Explosion::releaseEmitters()
 {
    for( S32 i=0; i<ExplosionData::EC_NUM_EMITTERS; i++ )
    {
@@ -1093,10 +1146,39 @@ void Explosion::onRemove()
       mMainEmitter->deleteWhenEmpty();
       mMainEmitter = NULL;
    }
+}
+
+void Explosion::expire()
+{
+   if ( !mRecycle || !sgExplosionPool.release( this, mDataBlock ) )
+   {
+      deleteObject();
+      return;
+   }
 
+   // Go dormant and reset to the state of a new explosion.  The shape
+   // instance is kept for the next explosion with this datablock.
+   releaseEmitters();
    removeFromScene();
+   removeFromProcessList();
 
-   Parent::onRemove();
+   if ( soundProfile_clone )
+   {
+      delete soundProfile_clone;
+      soundProfile_clone = 0;
+   }
+
+   mActive = false;
+   mCurrMS = 0;
+   mDelayMS = 0;
+   mEndingMS = 1000;
+   mFade = 1;
+   mCollideType = 0;
+   mInitialNormal.set( 0.0f, 0.0f, 1.0f );
+   mRandAngle = sgRandom.randF( 0.0f, 1.0f ) * M_PI_F * 2.0f;
+   mObjScale.set( 1.0f, 1.0f, 1.0f );
+   ss_object = 0;
+   ss_index = 0;
 }
 
 
@@ -1233,7 +1315,7 @@ void Explosion::processTick(const Move*)
 
    if( mCurrMS >= mEndingMS )
    {
-         deleteObject();
+         expire();
          return;
    }
          
@@ -1319,18 +1401,13 @@ void Explosion::launchDebris( Point3F &axis )
 
       launchDir *= debrisVel;
 
-      Debris *debris = new Debris;
+      Debris *debris = Debris::create(mDataBlock->debrisList[0]->cloneAndPerformSubstitutions(ss_object, ss_index));
       debris->setSubstitutionData(ss_object, ss_index);
-      debris->setDataBlock(mDataBlock->debrisList[0]->cloneAndPerformSubstitutions(ss_object, ss_index));
       debris->setTransform( getTransform() );
       debris->init( pos, launchDir );
 
-      if( !debris->registerObject() )
-      {
+      if( !debris->spawn() )
          Con::warnf( ConsoleLogEntry::General, "Could not register debris for class: %s", mDataBlock->getName() );
-         delete debris;
-         debris = NULL;
-      }
    }
 }
 
@@ -1348,13 +1425,11 @@ void Explosion::spawnSubExplosions()
       if( mDataBlock->explosionList[i] )
       {
          MatrixF trans = getTransform();
-         Explosion* pExplosion = new Explosion;
+         Explosion* pExplosion = Explosion::create(mDataBlock->explosionList[i]->cloneAndPerformSubstitutions(ss_object, ss_index));
          pExplosion->setSubstitutionData(ss_object, ss_index);
-         pExplosion->setDataBlock(mDataBlock->explosionList[i]->cloneAndPerformSubstitutions(ss_object, ss_index));
          pExplosion->setTransform( trans );
          pExplosion->setInitialState( trans.getPosition(), mInitialNormal, 1);
-         if (!pExplosion->registerObject())
-            delete pExplosion;
+         pExplosion->spawn();
       }
    }
 }
@@ -1374,9 +1449,11 @@ bool Explosion::explode()
    spawnSubExplosions();
 
    if (bool(mDataBlock->explosionShape) && mDataBlock->explosionAnimation != -1) {
-      mExplosionInstance = new TSShapeInstance(mDataBlock->explosionShape, true);
-
-      mExplosionThread   = mExplosionInstance->addThread();
+      // Pooled explosions still have the instance of their last explosion.
+      if (!mExplosionInstance) {
+         mExplosionInstance = new TSShapeInstance(mDataBlock->explosionShape, true);
+         mExplosionThread   = mExplosionInstance->addThread();
+      }
       mExplosionInstance->setSequence(mExplosionThread, mDataBlock->explosionAnimation, 0);
       mExplosionInstance->setTimeScale(mExplosionThread, mDataBlock->playSpeed);
 
@@ -1398,10 +1475,12 @@ bool Explosion::explode()
    }
 
    if (mDataBlock->particleEmitter) {
-      mMainEmitter = new ParticleEmitter;
-      mMainEmitter->setDataBlock(mDataBlock->particleEmitter->cloneAndPerformSubstitutions(ss_object, ss_index));
-      mMainEmitter->registerObject();
+      ParticleEmitter * pEmitter = ParticleEmitter::create(mDataBlock->particleEmitter->cloneAndPerformSubstitutions(ss_object, ss_index));
+      if (pEmitter->spawn())
+         mMainEmitter = pEmitter;
+   }
 
+   if (mMainEmitter) {
       mMainEmitter->emitParticles(getPosition(), mInitialNormal, mDataBlock->particleRadius,
          Point3F::Zero, U32(mDataBlock->particleDensity * mFade));
    }
@@ -1410,12 +1489,11 @@ bool Explosion::explode()
    {
       if( mDataBlock->emitterList[i] != NULL )
       {
-         ParticleEmitter * pEmitter = new ParticleEmitter;
-         pEmitter->setDataBlock(mDataBlock->emitterList[i]->cloneAndPerformSubstitutions(ss_object, ss_index));
-         if( !pEmitter->registerObject() )
+         ParticleEmitter * pEmitter = ParticleEmitter::create(mDataBlock->emitterList[i]->cloneAndPerformSubstitutions(ss_object, ss_index));
+         if( !pEmitter->spawn() )
          {
             Con::warnf( ConsoleLogEntry::General, "Could not register emitter for particle of class: %s", mDataBlock->getName() );
-            SAFE_DELETE(pEmitter);
+            pEmitter = NULL;
          }
          mEmitterList[i] = pEmitter;
       }
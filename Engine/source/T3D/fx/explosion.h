@@ -167,11 +167,23 @@ class Explosion : public GameBase, public ISceneLight
    F32      mRandomVal;
    U32      mCollideType;
 
+   /// Set for explosions from create() which are pooled when they expire.
+   bool     mRecycle;
+
   protected:
    bool onAdd();
    void onRemove();
    bool explode();
 
+   /// Starts the explosion, shared by onAdd() and spawn().
+   bool start();
+
+   /// Returns the explosion to the FX object pool or deletes it.
+   void expire();
+
+   /// Lets the emitters die out once their particles are gone.
+   void releaseEmitters();
+
    void processTick(const Move *move);
    void advanceTime(F32 dt);
    void updateEmitters( F32 dt );
@@ -190,6 +202,14 @@ class Explosion : public GameBase, public ISceneLight
    ~Explosion();
    void setInitialState(const Point3F& point, const Point3F& normal, const F32 fade = 1.0);
 
+   /// Returns a dormant pooled explosion for @a datablock or a new,
+   /// unregistered one.
+   static Explosion* create( ExplosionData *datablock );
+
+   /// Registers an explosion from create(), or restarts it if it came from
+   /// the pool.  The explosion is deleted if this fails.
+   bool spawn();
+
    // ISceneLight
    virtual void submitLights( LightManager *lm, bool staticLighting );
    virtual LightInfo* getLight() { return mLight; }
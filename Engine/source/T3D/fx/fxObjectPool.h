@@ -0,0 +1,150 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _FXOBJECTPOOL_H_
+#define _FXOBJECTPOOL_H_
+
+#ifndef _SIMDATABLOCK_H_
+#include "console/simDatablock.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+
+/// Settings shared by all FXObjectPool instances.
+struct FXObjectPoolBase
+{
+   /// Maximum number of dormant objects kept for each datablock.
+   /// Zero disables pooling.
+   static U32 smMaxPerDataBlock;
+};
+
+/// Dormant client side effect objects keyed by their datablock.
+///
+/// Explosions, debris, splashes and the emitters they spawn live for a
+/// few seconds and are created in bursts.  Instead of being deleted when
+/// they expire they stay registered with the Sim, removed from the scene
+/// and the process list, and are handed back out the next time an effect
+/// with the same datablock is spawned.  This skips the registration and
+/// the allocation of their shape instances and particle stores.
+///
+/// Only objects made by the create() method of their class are pooled,
+/// and never those with temporary cloned datablocks.  Objects must call
+/// remove() from onRemove() in case they are deleted while dormant, which
+/// happens when their group is cleaned up.
+template< class T >
+class FXObjectPool : public FXObjectPoolBase
+{
+public:
+
+   ~FXObjectPool()
+   {
+      for ( U32 i = 0; i < mEntries.size(); i++ )
+         delete mEntries[i];
+   }
+
+   /// Returns a dormant object spawned with @a datablock or NULL.
+   T* acquire( SimDataBlock *datablock )
+   {
+      if ( !datablock || datablock->isTempClone() )
+         return NULL;
+
+      Entry *entry = _findEntry( datablock );
+      if ( !entry || entry->objects.empty() )
+         return NULL;
+
+      T *obj = entry->objects.last();
+      entry->objects.pop_back();
+      return obj;
+   }
+
+   /// Parks @a obj as a dormant object for @a datablock.  Returns false if
+   /// pooling is disabled or the datablock already has enough dormant
+   /// objects, in which case the caller should delete the object.
+   bool release( T *obj, SimDataBlock *datablock )
+   {
+      if ( !datablock || datablock->isTempClone() || smMaxPerDataBlock == 0 )
+         return false;
+
+      Entry *entry = _findEntry( datablock );
+      if ( !entry )
+      {
+         entry = new Entry;
+         entry->datablock = datablock;
+         mEntries.push_back( entry );
+      }
+      else if ( entry->objects.size() >= smMaxPerDataBlock )
+         return false;
+
+      entry->objects.push_back( obj );
+      return true;
+   }
+
+   /// Forgets @a obj if it is dormant.
+   void remove( T *obj )
+   {
+      for ( U32 i = 0; i < mEntries.size(); i++ )
+      {
+         if ( mEntries[i]->objects.remove( obj ) )
+            return;
+      }
+   }
+
+protected:
+
+   struct Entry
+   {
+      SimObjectPtr<SimDataBlock> datablock;
+      Vector<T*> objects;
+   };
+
+   Vector<Entry*> mEntries;
+
+   /// Returns the entry for @a datablock.  Entries of deleted datablocks
+   /// are dropped along with their dormant objects.
+   Entry* _findEntry( SimDataBlock *datablock )
+   {
+      Entry *found = NULL;
+      for ( U32 i = 0; i < mEntries.size(); )
+      {
+         Entry *entry = mEntries[i];
+         if ( entry->datablock.isNull() )
+         {
+            mEntries.erase_fast( i );
+            for ( U32 j = 0; j < entry->objects.size(); j++ )
+               entry->objects[j]->deleteObject();
+            delete entry;
+            continue;
+         }
+
+         if ( entry->datablock == datablock )
+            found = entry;
+         i++;
+      }
+
+      return found;
+   }
+};
+
+#endif // _FXOBJECTPOOL_H_
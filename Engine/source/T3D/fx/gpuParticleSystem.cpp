@@ -0,0 +1,347 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "T3D/fx/gpuParticleSystem.h"
+
+#include "T3D/fx/particle.h"
+#include "T3D/fx/particleEmitter.h"
+#include "afx/ce/afxParticleEmitter.h"
+#include "materials/shaderData.h"
+#include "gfx/gfxDevice.h"
+#include "core/util/tAlignedArray.h"
+#include "platform/profiler.h"
+
+
+GFXImplementVertexFormat( GPUParticleVertex )
+{
+   addElement( "TEXCOORD", GFXDeclType_Float4, 0 );
+   addElement( "TEXCOORD", GFXDeclType_Float4, 1 );
+   addElement( "TEXCOORD", GFXDeclType_Float4, 2 );
+}
+
+const char *GPUParticleSystem::smShaderDataName = "GPUParticlesShaderData";
+
+//-----------------------------------------------------------------------------
+
+void GPUParticleSystem::ShaderConsts::init( GFXShader *shader )
+{
+   mCamRightSC = shader->getShaderConstHandle( "$camRight" );
+   mCamUpSC = shader->getShaderConstHandle( "$camUp" );
+   mTimeSC = shader->getShaderConstHandle( "$time" );
+   mWindSC = shader->getShaderConstHandle( "$wind" );
+   mAmbientSC = shader->getShaderConstHandle( "$ambient" );
+   mTypeMotionSC = shader->getShaderConstHandle( "$typeMotion" );
+   mTypeTimesSC = shader->getShaderConstHandle( "$typeTimes" );
+   mTypeSizesSC = shader->getShaderConstHandle( "$typeSizes" );
+   mTypeColorsSC = shader->getShaderConstHandle( "$typeColors" );
+   mTypeTexCoordsSC = shader->getShaderConstHandle( "$typeTexCoords" );
+}
+
+//-----------------------------------------------------------------------------
+
+bool GPUParticleSystem::canSimulate( const ParticleEmitterData *data )
+{
+   if ( !data->gpuSimulation )
+      return false;
+
+   const char *reason = NULL;
+
+   if ( dynamic_cast< const afxParticleEmitterData* >( data ) )
+      reason = "AFX emitters place their particles themselves";
+   else if ( data->orientParticles || data->alignParticles )
+      reason = "oriented and aligned particles are not supported";
+   else if ( data->sortParticles )
+      reason = "particles cannot be sorted";
+   else if ( data->fade_color || data->fade_alpha || data->fade_size )
+      reason = "AFX fading is not supported";
+   else if ( data->particleDataBlocks.size() > MaxTypes )
+      reason = "too many particle types";
+   else
+   {
+      for ( U32 i = 0; i < data->particleDataBlocks.size() && !reason; i++ )
+      {
+         const ParticleData *part = data->particleDataBlocks[i];
+         if ( part->constrain_pos )
+            reason = "constrainPos particles are not supported";
+         else if ( part->animateTexture )
+            reason = "animated textures are not supported";
+      }
+   }
+
+#if defined(AFX_CAP_PARTICLE_POOLS)
+   if ( !reason && data->pool_datablock )
+      reason = "pooled particles are not supported";
+#endif
+
+   if ( !reason && !Sim::findObject( smShaderDataName ) )
+      reason = "the GPUParticlesShaderData ShaderData does not exist";
+
+   if ( reason )
+   {
+      Con::warnf( "ParticleEmitterData(%s) simulating on the CPU: %s.", data->getName(), reason );
+      return false;
+   }
+
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+GPUParticleSystem::GPUParticleSystem( U32 capacity )
+   :  mCapacity( getMax( capacity, 1U ) ),
+      mTail( 0 ),
+      mHead( 0 ),
+      mCount( 0 ),
+      mTimeMS( 0 ),
+      mMaxSize( 0.0f ),
+      mUploadSlot( 0 ),
+      mNumTypes( 0 )
+{
+   mDeathTime.setSize( mCapacity );
+   mBlockBounds.setSize( ( mCapacity + BlockSize - 1 ) / BlockSize );
+   for ( U32 i = 0; i < mBlockBounds.size(); i++ )
+      mBlockBounds[i] = Box3F::Invalid;
+
+   dMemset( mTypeMotion, 0, sizeof( mTypeMotion ) );
+   dMemset( mTypeTimes, 0, sizeof( mTypeTimes ) );
+   dMemset( mTypeSizes, 0, sizeof( mTypeSizes ) );
+   dMemset( mTypeColors, 0, sizeof( mTypeColors ) );
+   dMemset( mTypeTexCoords, 0, sizeof( mTypeTexCoords ) );
+}
+
+//-----------------------------------------------------------------------------
+
+void GPUParticleSystem::setTypes( const Vector< ParticleData* > &types, const LinearColorF *colors, const F32 *sizes )
+{
+   mNumTypes = getMin( (U32)types.size(), (U32)MaxTypes );
+   mMaxSize = 0.0f;
+
+   for ( U32 i = 0; i < mNumTypes; i++ )
+   {
+      const ParticleData *part = types[i];
+
+      mTypeMotion[i].set( part->dragCoefficient, part->constantAcceleration,
+                          part->windCoefficient, part->gravityCoefficient );
+
+      F32 *keyTimes = (F32*)&mTypeTimes[i * 2];
+      F32 *keySizes = (F32*)&mTypeSizes[i * 2];
+      for ( U32 k = 0; k < ParticleData::PDC_NUM_KEYS; k++ )
+      {
+         keyTimes[k] = part->times[k];
+         keySizes[k] = sizes ? sizes[k] : part->sizes[k] * part->sizeBias;
+         mMaxSize = getMax( mMaxSize, keySizes[k] );
+
+         const LinearColorF &color = colors ? colors[k] : part->colors[k];
+         mTypeColors[i * 8 + k].set( color.red, color.green, color.blue, color.alpha );
+      }
+
+      mTypeTexCoords[i * 2].set( part->texCoords[0].x, part->texCoords[0].y, part->texCoords[1].x, part->texCoords[1].y );
+      mTypeTexCoords[i * 2 + 1].set( part->texCoords[2].x, part->texCoords[2].y, part->texCoords[3].x, part->texCoords[3].y );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+Point3F GPUParticleSystem::evalPosition( const Point3F &pos, const VectorF &vel, U32 type, F32 t ) const
+{
+   const Point4F &motion = mTypeMotion[type];
+
+   VectorF acc = vel * motion.y - ParticleEmitter::mWindVelocity * motion.z;
+   acc.z -= 9.81f * motion.w;
+
+   const F32 drag = motion.x;
+   if ( drag > 0.0001f )
+   {
+      const F32 decay = ( 1.0f - mExp( -drag * t ) ) / drag;
+      return pos + ( vel - acc / drag ) * decay + acc * ( t / drag );
+   }
+
+   return pos + vel * t + acc * ( 0.5f * t * t );
+}
+
+//-----------------------------------------------------------------------------
+
+void GPUParticleSystem::spawn( const Particle &part, U32 type, U32 ageMS )
+{
+   // Replace the oldest particle if we're full.
+   if ( mCount == mCapacity )
+   {
+      mTail = ( mTail + 1 ) % mCapacity;
+      mCount--;
+   }
+
+   const U32 slot = mHead;
+   mHead = ( mHead + 1 ) % mCapacity;
+   mCount++;
+
+   const U32 lifetime = part.totalLifetime;
+   mDeathTime[slot] = mTimeMS + ( lifetime > ageMS ? lifetime - ageMS : 0 );
+
+   // Start over on the bounds of a block once none of its
+   // particles but the new one may be alive.
+   const U32 block = slot / BlockSize;
+   Box3F &bounds = mBlockBounds[block];
+   if ( slot % BlockSize == 0 && ( mCount == 1 || mTail / BlockSize != block ) )
+      bounds = Box3F::Invalid;
+
+   const F32 lifeSec = lifetime / 1000.0f;
+   bounds.extend( part.pos );
+   bounds.extend( evalPosition( part.pos, part.vel, type, lifeSec * 0.5f ) );
+   bounds.extend( evalPosition( part.pos, part.vel, type, lifeSec ) );
+
+   // Queue the vertices.  If more particles spawn between two uploads than
+   // fit they replace the oldest queued ones in place.
+   U32 offset = 0;
+   if ( mSpawned.empty() )
+      mUploadSlot = slot;
+   else
+      offset = ( slot + mCapacity - mUploadSlot ) % mCapacity;
+   if ( offset * 4 == mSpawned.size() )
+      mSpawned.increment( 4 );
+
+   const F32 spawnTime = ( (F32)mTimeMS - (F32)ageMS ) / 1000.0f;
+   GPUParticleVertex *verts = &mSpawned[offset * 4];
+   for ( U32 i = 0; i < 4; i++ )
+   {
+      verts[i].posTime.set( part.pos.x, part.pos.y, part.pos.z, spawnTime );
+      verts[i].velLife.set( part.vel.x, part.vel.y, part.vel.z, lifeSec );
+      verts[i].params.set( mDegToRad( part.spinSpeed ), part.orientDir.x, (F32)i, (F32)type );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void GPUParticleSystem::advanceTime( U32 ms )
+{
+   mTimeMS += ms;
+
+   // Lifetimes vary, so particles behind the oldest one may already be
+   // dead.  The vertex shader hides those until they are retired.
+   while ( mCount && mDeathTime[mTail] <= mTimeMS )
+   {
+      mTail = ( mTail + 1 ) % mCapacity;
+      mCount--;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+Box3F GPUParticleSystem::getBounds() const
+{
+   Box3F bounds = Box3F::Invalid;
+   if ( !mCount )
+      return bounds;
+
+   const U32 numBlocks = mBlockBounds.size();
+   const U32 lastSlot = ( mTail + mCount - 1 ) % mCapacity;
+   for ( U32 block = mTail / BlockSize; ; block = ( block + 1 ) % numBlocks )
+   {
+      bounds.intersect( mBlockBounds[block] );
+      if ( block == lastSlot / BlockSize )
+         break;
+   }
+
+   const F32 halfSize = mMaxSize * 0.5f;
+   bounds.minExtents -= Point3F( halfSize, halfSize, halfSize );
+   bounds.maxExtents += Point3F( halfSize, halfSize, halfSize );
+   return bounds;
+}
+
+//-----------------------------------------------------------------------------
+
+void GPUParticleSystem::uploadSpawned()
+{
+   if ( mSpawned.empty() )
+      return;
+
+   PROFILE_SCOPE( GPUParticleSystem_uploadSpawned );
+
+   if ( !mVertBuff.isValid() )
+   {
+      // Zeroed vertices have no lifetime so the shader hides them.
+      mVertBuff.set( GFX, mCapacity * 4, GFXBufferTypeStatic );
+      GPUParticleVertex *verts = mVertBuff.lock();
+      dMemset( verts, 0, mCapacity * 4 * sizeof( GPUParticleVertex ) );
+      mVertBuff.unlock();
+   }
+
+   const U32 numSlots = mSpawned.size() / 4;
+   const U32 firstSlots = getMin( numSlots, mCapacity - mUploadSlot );
+
+   GPUParticleVertex *verts = mVertBuff.lock( mUploadSlot * 4, ( mUploadSlot + firstSlots ) * 4 );
+   dMemcpy( verts, mSpawned.address(), firstSlots * 4 * sizeof( GPUParticleVertex ) );
+   mVertBuff.unlock();
+
+   if ( firstSlots < numSlots )
+   {
+      verts = mVertBuff.lock( 0, ( numSlots - firstSlots ) * 4 );
+      dMemcpy( verts, &mSpawned[firstSlots * 4], ( numSlots - firstSlots ) * 4 * sizeof( GPUParticleVertex ) );
+      mVertBuff.unlock();
+   }
+
+   mSpawned.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void GPUParticleSystem::setShaderConsts( GFXShaderConstBuffer *buffer, const ShaderConsts &consts,
+                                         const Point3F &camRight, const Point3F &camUp,
+                                         const LinearColorF &ambient, F32 ambientFactor ) const
+{
+   buffer->setSafe( consts.mCamRightSC, camRight );
+   buffer->setSafe( consts.mCamUpSC, camUp );
+   buffer->setSafe( consts.mTimeSC, mTimeMS / 1000.0f );
+   buffer->setSafe( consts.mWindSC, ParticleEmitter::mWindVelocity );
+   buffer->setSafe( consts.mAmbientSC, Point4F( ambient.red, ambient.green, ambient.blue, ambientFactor ) );
+
+   if ( consts.mTypeMotionSC->isValid() )
+   {
+      AlignedArray< Point4F > motion( MaxTypes, sizeof( Point4F ), (U8*)mTypeMotion, false );
+      AlignedArray< Point4F > times( MaxTypes * 2, sizeof( Point4F ), (U8*)mTypeTimes, false );
+      AlignedArray< Point4F > sizes( MaxTypes * 2, sizeof( Point4F ), (U8*)mTypeSizes, false );
+      AlignedArray< Point4F > colors( MaxTypes * 8, sizeof( Point4F ), (U8*)mTypeColors, false );
+      AlignedArray< Point4F > texCoords( MaxTypes * 2, sizeof( Point4F ), (U8*)mTypeTexCoords, false );
+
+      buffer->set( consts.mTypeMotionSC, motion );
+      buffer->setSafe( consts.mTypeTimesSC, times );
+      buffer->setSafe( consts.mTypeSizesSC, sizes );
+      buffer->setSafe( consts.mTypeColorsSC, colors );
+      buffer->setSafe( consts.mTypeTexCoordsSC, texCoords );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void GPUParticleSystem::draw()
+{
+   U32 slot = mTail;
+   U32 left = mCount;
+   while ( left )
+   {
+      const U32 count = getMin( getMin( left, mCapacity - slot ), (U32)ParticlesPerDraw );
+      GFX->drawIndexedPrimitive( GFXTriangleList, slot * 4, 0, count * 4, 0, count * 2 );
+      slot = ( slot + count ) % mCapacity;
+      left -= count;
+   }
+}
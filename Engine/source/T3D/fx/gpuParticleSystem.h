@@ -0,0 +1,210 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _GPUPARTICLESYSTEM_H_
+#define _GPUPARTICLESYSTEM_H_
+
+#ifndef _GFXVERTEXBUFFER_H_
+#include "gfx/gfxVertexBuffer.h"
+#endif
+#ifndef _GFXSHADER_H_
+#include "gfx/gfxShader.h"
+#endif
+#ifndef _MBOX_H_
+#include "math/mBox.h"
+#endif
+#ifndef _MPOINT4_H_
+#include "math/mPoint4.h"
+#endif
+
+class ParticleEmitterData;
+class ParticleData;
+struct Particle;
+
+
+/// Vertex of a GPU simulated particle.  The particle state at spawn time is
+/// written once to all four corners of its quad.
+GFXDeclareVertexFormat( GPUParticleVertex )
+{
+   /// Spawn position in world space and spawn time in seconds.
+   Point4F posTime;
+
+   /// Initial velocity and lifetime in seconds.
+   Point4F velLife;
+
+   /// Spin in radians per second, start angle in radians,
+   /// quad corner from 0 to 3 and particle type.
+   Point4F params;
+};
+
+
+/// Simulates the particles of one ParticleEmitter on the GPU.
+///
+/// GFX has neither compute shaders nor transform feedback, so the simulation
+/// is stateless: each particle is written once to a ring of vertices when it
+/// spawns, and the vertex shader evaluates its position, color, size and spin
+/// from its age every frame.  Particles therefore follow a closed form path
+/// under constant acceleration, drag, wind and gravity and cannot collide or
+/// be changed after they spawn.  The CPU only keeps the death time of each
+/// slot to retire the oldest particles and bounds per block of slots.
+///
+/// Rendering uses the "GPUParticlesShaderData" ShaderData.  Its vertex shader
+/// gets GPUParticleVertex as TEXCOORD0 to TEXCOORD2 and these constants:
+///
+///   - $modelViewProj: World to clip space.
+///   - $camRight, $camUp: Billboard axes in world space.
+///   - $time: Current time in seconds, the same clock as the spawn time.
+///   - $wind: Current wind velocity.
+///   - $ambient: Ambient light color with ParticleEmitterData::ambientFactor in w.
+///   - $typeMotion[MaxTypes]: Drag, constant acceleration, wind and gravity
+///     coefficients of each particle type.
+///   - $typeTimes[MaxTypes*2], $typeSizes[MaxTypes*2]: Eight keys each.
+///   - $typeColors[MaxTypes*8]: Eight color keys.
+///   - $typeTexCoords[MaxTypes*2]: The four texture coordinates.
+///
+/// With t the age and k the drag, the position is
+/// p + (v - a/k)(1 - e^-kt)/k + at/k, or p + vt + at^2/2 without drag, where
+/// a = v * constantAcceleration - wind * windCoefficient - 9.81 * gravityCoefficient
+/// on z, which matches the CPU integration in ParticleEmitter::update().
+/// Particles outside their lifetime must collapse to a point.  The pixel
+/// shader and its constants are the same as ParticlesShaderData's.
+class GPUParticleSystem
+{
+public:
+
+   enum Constants
+   {
+      /// Maximum number of ParticleData types per emitter.
+      MaxTypes = 4,
+
+      /// Particles per draw call which keeps the indices 16 bit.
+      ParticlesPerDraw = 16384,
+
+      /// Slots per bounding box block.
+      BlockSize = 256,
+   };
+
+   /// Shader constant handles of GPUParticlesShaderData.
+   struct ShaderConsts
+   {
+      GFXShaderConstHandle *mCamRightSC;
+      GFXShaderConstHandle *mCamUpSC;
+      GFXShaderConstHandle *mTimeSC;
+      GFXShaderConstHandle *mWindSC;
+      GFXShaderConstHandle *mAmbientSC;
+      GFXShaderConstHandle *mTypeMotionSC;
+      GFXShaderConstHandle *mTypeTimesSC;
+      GFXShaderConstHandle *mTypeSizesSC;
+      GFXShaderConstHandle *mTypeColorsSC;
+      GFXShaderConstHandle *mTypeTexCoordsSC;
+
+      void init( GFXShader *shader );
+   };
+
+   /// Name of the ShaderData the particles are rendered with.
+   static const char *smShaderDataName;
+
+   /// Return true if particles of @a data can be simulated on the GPU and
+   /// the shader exists.  Logs why not if it asked for GPU simulation.
+   static bool canSimulate( const ParticleEmitterData *data );
+
+   /// @param capacity Maximum live particles.  Spawning more replaces the oldest.
+   GPUParticleSystem( U32 capacity );
+
+   /// Set the color and size keys and motion of each particle type.
+   ///
+   /// @param colors If not NULL these colors override the ParticleData keys.
+   /// @param sizes If not NULL these sizes override the ParticleData keys.
+   void setTypes( const Vector< ParticleData* > &types, const LinearColorF *colors, const F32 *sizes );
+
+   /// Queue a particle for upload.
+   ///
+   /// @param part The initial particle state from ParticleEmitter::addParticle().
+   /// @param type Index of the particle's ParticleData.
+   /// @param ageMS Age of the particle at the current time.
+   void spawn( const Particle &part, U32 type, U32 ageMS );
+
+   /// Advance the clock and retire particles which died.
+   void advanceTime( U32 ms );
+
+   /// Number of particles which may still be alive.
+   U32 getCount() const { return mCount; }
+
+   /// Bounds of the particles which may still be alive.
+   Box3F getBounds() const;
+
+   /// Upload the particles spawned since the last call.
+   void uploadSpawned();
+
+   /// Set the simulation constants.  The shader and its
+   /// constant buffer must be set up by the caller.
+   void setShaderConsts( GFXShaderConstBuffer *buffer, const ShaderConsts &consts,
+                         const Point3F &camRight, const Point3F &camUp,
+                         const LinearColorF &ambient, F32 ambientFactor ) const;
+
+   GFXVertexBufferHandleBase* getVertexBuffer() { return &mVertBuff; }
+
+   /// Draw the particles which may still be alive.  The vertex buffer and
+   /// an index buffer of up to ParticlesPerDraw quads must be set.
+   void draw();
+
+protected:
+
+   /// Return the world position of a particle spawned with
+   /// @a pos and @a vel of @a type after @a t seconds.
+   Point3F evalPosition( const Point3F &pos, const VectorF &vel, U32 type, F32 t ) const;
+
+   U32 mCapacity;
+
+   /// Slot of the oldest and of the next particle.
+   U32 mTail;
+   U32 mHead;
+   U32 mCount;
+
+   /// Current time in milliseconds.
+   U32 mTimeMS;
+
+   /// Time at which the particle in each slot dies in milliseconds.
+   Vector< U32 > mDeathTime;
+
+   /// Bounds of the particles of each block of slots.
+   Vector< Box3F > mBlockBounds;
+
+   /// Largest particle size of any type.
+   F32 mMaxSize;
+
+   /// Vertices spawned since the last upload starting at slot mUploadSlot.
+   Vector< GPUParticleVertex > mSpawned;
+   U32 mUploadSlot;
+
+   GFXVertexBufferHandle< GPUParticleVertex > mVertBuff;
+
+   U32 mNumTypes;
+   Point4F mTypeMotion[ MaxTypes ];
+   Point4F mTypeTimes[ MaxTypes * 2 ];
+   Point4F mTypeSizes[ MaxTypes * 2 ];
+   Point4F mTypeColors[ MaxTypes * 8 ];
+   Point4F mTypeTexCoords[ MaxTypes * 2 ];
+};
+
+#endif // _GPUPARTICLESYSTEM_H_
@@ -49,6 +49,10 @@
 #include "materials/matInstance.h"
 #include "renderInstance/renderDeferredMgr.h"
 #include "console/engineAPI.h"
+#include "core/stream/fileStream.h"
+#include "core/util/hashFunction.h"
+#include "core/util/tDictionary.h"
+#include "math/mathIO.h"
 
 /// This is used for rendering ground cover billboards.
 GFXImplementVertexFormat( GCVertex )
@@ -103,6 +107,7 @@ class GroundCoverCell
 protected:
 
    friend class GroundCover;
+   friend class GroundCoverPlacementCache;
 
    struct Placement
    {
@@ -418,11 +423,276 @@ void GroundCoverCell::renderBillboards( SceneRenderState *state, BaseMatInstance
 }
 
 
+/// The placement of GroundCover cells by their world grid index.
+///
+/// The placement only depends on the GroundCover settings and the
+/// terrains it covers, which are identified by the cache hash.  When
+/// the hash changes the cached cells are stale and get thrown away.
+class GroundCoverPlacementCache
+{
+public:
+
+   typedef GroundCoverCell::Placement Placement;
+
+   GroundCoverPlacementCache()
+      :  mHash( 0 ),
+         mCellSize( 0.0f )
+   {
+   }
+
+   ~GroundCoverPlacementCache() { clear(); }
+
+   U32 getHash() const { return mHash; }
+
+   F32 getCellSize() const { return mCellSize; }
+
+   U32 size() const { return mEntries.size(); }
+
+   /// Empties the cache for the cells of a new placement hash.
+   void reset( U32 hash, F32 cellSize );
+
+   void clear();
+
+   bool contains( const Point2I &index ) const { return mEntries.find( index ) != mEntries.end(); }
+
+   /// Copies the cached placement of the cell at @a index into
+   /// @a cell or returns false if it isn't cached.
+   bool load( const Point2I &index, GroundCoverCell *cell ) const;
+
+   /// Caches the placement of the @a cell at @a index.
+   void store( const Point2I &index, const GroundCoverCell *cell );
+
+   /// Removes the cells which overlap the 2D @a area.
+   void erase( const RectF &area );
+
+   /// Reads the cells from the stream if it was written
+   /// with the same hash as this cache has.
+   bool read( Stream &stream );
+
+   bool write( Stream &stream ) const;
+
+protected:
+
+   enum { FILE_VERSION = 1 };
+
+   struct Entry
+   {
+      Box3F renderBounds;
+      Vector<Placement> billboards;
+      Vector<Placement> shapes;
+   };
+
+   typedef HashTable<Point2I,Entry*> EntryTable;
+
+   U32 mHash;
+
+   F32 mCellSize;
+
+   EntryTable mEntries;
+
+   /// Returns the entry for @a index creating it if needed.
+   Entry* _getEntry( const Point2I &index );
+
+   static bool _readPlacements( Stream &stream, Vector<Placement> *outPlacements );
+
+   static void _writePlacements( Stream &stream, const Vector<Placement> &placements );
+};
+
+void GroundCoverPlacementCache::reset( U32 hash, F32 cellSize )
+{
+   clear();
+   mHash = hash;
+   mCellSize = cellSize;
+}
+
+void GroundCoverPlacementCache::clear()
+{
+   EntryTable::Iterator iter = mEntries.begin();
+   for ( ; iter != mEntries.end(); ++iter )
+      delete iter->value;
+
+   mEntries.clear();
+}
+
+GroundCoverPlacementCache::Entry* GroundCoverPlacementCache::_getEntry( const Point2I &index )
+{
+   EntryTable::Iterator iter = mEntries.find( index );
+   if ( iter != mEntries.end() )
+      return iter->value;
+
+   Entry *entry = new Entry;
+   mEntries.insertUnique( index, entry );
+   return entry;
+}
+
+bool GroundCoverPlacementCache::load( const Point2I &index, GroundCoverCell *cell ) const
+{
+   EntryTable::ConstIterator iter = mEntries.find( index );
+   if ( iter == mEntries.end() )
+      return false;
+
+   const Entry *entry = iter->value;
+   cell->mBillboards = entry->billboards;
+   cell->mShapes = entry->shapes;
+   cell->mRenderBounds = entry->renderBounds;
+   cell->mBounds.minExtents.z = entry->renderBounds.minExtents.z;
+   cell->mBounds.maxExtents.z = entry->renderBounds.maxExtents.z;
+
+   return true;
+}
+
+void GroundCoverPlacementCache::store( const Point2I &index, const GroundCoverCell *cell )
+{
+   Entry *entry = _getEntry( index );
+   entry->billboards = cell->mBillboards;
+   entry->shapes = cell->mShapes;
+   entry->renderBounds = cell->mRenderBounds;
+}
+
+void GroundCoverPlacementCache::erase( const RectF &area )
+{
+   Vector<Point2I> indices;
+
+   EntryTable::Iterator iter = mEntries.begin();
+   for ( ; iter != mEntries.end(); ++iter )
+   {
+      const Point2I &index = iter->key;
+      const RectF rect( index.x * mCellSize, index.y * mCellSize, mCellSize, mCellSize );
+      if ( rect.overlaps( area ) )
+         indices.push_back( index );
+   }
+
+   for ( U32 i=0; i < indices.size(); i++ )
+   {
+      iter = mEntries.find( indices[i] );
+      delete iter->value;
+      mEntries.erase( iter );
+   }
+}
+
+bool GroundCoverPlacementCache::_readPlacements( Stream &stream, Vector<Placement> *outPlacements )
+{
+   U32 count = 0;
+   stream.read( &count );
+   if ( stream.getStatus() != Stream::Ok )
+      return false;
+
+   outPlacements->setSize( count );
+   for ( U32 i=0; i < count; i++ )
+   {
+      Placement &p = (*outPlacements)[i];
+
+      mathRead( stream, &p.point );
+      mathRead( stream, &p.normal );
+      mathRead( stream, &p.size );
+      stream.read( &p.rotation );
+      stream.read( &p.type );
+      stream.read( &p.windAmplitude );
+      mathRead( stream, &p.worldBox );
+      stream.read( &p.lmColor );
+
+      if ( p.type >= MAX_COVERTYPES )
+         return false;
+   }
+
+   return stream.getStatus() == Stream::Ok;
+}
+
+void GroundCoverPlacementCache::_writePlacements( Stream &stream, const Vector<Placement> &placements )
+{
+   stream.write( (U32)placements.size() );
+
+   for ( U32 i=0; i < placements.size(); i++ )
+   {
+      const Placement &p = placements[i];
+
+      mathWrite( stream, p.point );
+      mathWrite( stream, p.normal );
+      mathWrite( stream, p.size );
+      stream.write( p.rotation );
+      stream.write( p.type );
+      stream.write( p.windAmplitude );
+      mathWrite( stream, p.worldBox );
+      stream.write( p.lmColor );
+   }
+}
+
+bool GroundCoverPlacementCache::read( Stream &stream )
+{
+   char id[4] = { 0 };
+   stream.read( 4, id );
+   if ( dMemcmp( id, "GCPC", 4 ) != 0 )
+   {
+      Con::errorf( "GroundCoverPlacementCache::read() - This is not a ground cover placement file!" );
+      return false;
+   }
+
+   U8 version = 0;
+   stream.read( &version );
+   if ( version != (U8)FILE_VERSION )
+      return false;
+
+   // Cells placed with other settings or on other 
+   // terrains are of no use to us.
+   U32 hash = 0;
+   stream.read( &hash );
+   if ( hash != mHash )
+      return false;
+
+   U32 count = 0;
+   stream.read( &count );
+
+   Point2I index;
+   Box3F renderBounds;
+
+   for ( U32 i=0; i < count; i++ )
+   {
+      mathRead( stream, &index );
+      mathRead( stream, &renderBounds );
+
+      Entry *entry = _getEntry( index );
+      entry->renderBounds = renderBounds;
+
+      if (  !_readPlacements( stream, &entry->billboards ) ||
+            !_readPlacements( stream, &entry->shapes ) )
+      {
+         Con::errorf( "GroundCoverPlacementCache::read() - The placement file is corrupt!" );
+         clear();
+         return false;
+      }
+   }
+
+   return true;
+}
+
+bool GroundCoverPlacementCache::write( Stream &stream ) const
+{
+   stream.write( 4, "GCPC" );
+   stream.write( (U8)FILE_VERSION );
+   stream.write( mHash );
+   stream.write( (U32)mEntries.size() );
+
+   EntryTable::ConstIterator iter = mEntries.begin();
+   for ( ; iter != mEntries.end(); ++iter )
+   {
+      const Entry *entry = iter->value;
+
+      mathWrite( stream, iter->key );
+      mathWrite( stream, entry->renderBounds );
+      _writePlacements( stream, entry->billboards );
+      _writePlacements( stream, entry->shapes );
+   }
+
+   return stream.getStatus() == Stream::Ok;
+}
+
+
 U32 GroundCover::smStatRenderedCells = 0;
 U32 GroundCover::smStatRenderedBillboards = 0;
 U32 GroundCover::smStatRenderedBatches = 0;
 U32 GroundCover::smStatRenderedShapes = 0;
 F32 GroundCover::smDensityScale = 1.0f;
+S32 GroundCover::smMaxCachedCells = 4096;
 
 ConsoleDocClass( GroundCover,
    "@brief Covers the ground in a field of objects (IE: Grass, Flowers, etc)."
@@ -447,6 +717,9 @@ GroundCover::GroundCover()
    // ensure we warp on first render.
    mGridIndex.set( S32_MAX, S32_MAX );
 
+   mPlacementCacheFile = StringTable->EmptyString();
+   mPlacementCache = new GroundCoverPlacementCache();
+
    mMaxPlacement = 1000;
    mLastPlacementCount = 0;
 
@@ -522,6 +795,7 @@ GroundCover::GroundCover()
 GroundCover::~GroundCover()
 {
    SAFE_DELETE( mMatInst );
+   SAFE_DELETE( mPlacementCache );
 }
 
 IMPLEMENT_CO_NETOBJECT_V1(GroundCover);
@@ -542,6 +816,9 @@ void GroundCover::initPersistFields()
       addField( "seed",          TypeS32,          Offset( mRandomSeed, GroundCover ),          "This RNG seed is saved and sent to clients for generating the same cover." );
       addField( "maxElements",   TypeS32,          Offset( mMaxPlacement, GroundCover ),        "The maximum amount of cover elements to include in the grid at any one time." );
 
+      addField( "placementCacheFile", TypeFilename, Offset( mPlacementCacheFile, GroundCover ), "Optional file with the precomputed placement of the cells written by savePlacementCache().  It "
+         "is only used while the cover settings and terrains match the ones it was saved with." );
+
       addField( "maxBillboardTiltAngle", TypeF32,  Offset( mMaxBillboardTiltAngle, GroundCover ),"The maximum amout of degrees the billboard will tilt down to match the camera." );
       addField( "shapeCullRadius", TypeF32,        Offset( mShapeCullRadius, GroundCover ),     "This is the distance at which DTS elements are  completely culled out." );      
       addField( "shapesCastShadows", TypeBool,     Offset( mShapesCastShadows, GroundCover ),   "Whether DTS elements should cast shadows or not." );
@@ -614,6 +891,10 @@ void GroundCover::consoleInit()
    Con::addVariable( "$pref::GroundCover::densityScale", TypeF32, &smDensityScale, "A global LOD scalar which can reduce the overall density of placed GroundCover.\n" 
 	   "@ingroup Foliage\n");
 
+   Con::addVariable( "$pref::GroundCover::maxCachedCells", TypeS32, &smMaxCachedCells, "The maximum amount of cells whose placement is kept in memory for "
+      "reuse when they come back into view.  Cells loaded from the placement cache file are always kept.\n"
+	   "@ingroup Foliage\n");
+
    Con::addVariable( "$GroundCover::renderedCells", TypeS32, &smStatRenderedCells, "Stat for number of rendered cells.\n"
 	   "@ingroup Foliage\n");
    Con::addVariable( "$GroundCover::renderedBillboards", TypeS32, &smStatRenderedBillboards, "Stat for number of rendered billboards.\n"
@@ -745,6 +1026,8 @@ U32 GroundCover::packUpdate( NetConnection *connection, U32 mask, BitStream *str
       stream->writeFlag( mDebugNoBillboards );
       stream->writeFlag( mDebugNoShapes );
       stream->writeFlag( mDebugLockFrustum );
+
+      stream->writeString( mPlacementCacheFile );
    }
 
    return retMask;  
@@ -811,6 +1094,8 @@ void GroundCover::unpackUpdate( NetConnection *connection, BitStream *stream )
       mDebugNoShapes       = stream->readFlag();
       mDebugLockFrustum    = stream->readFlag();
 
+      mPlacementCacheFile  = stream->readSTString();
+
       // We have no way to easily know what changed, so by clearing
       // the cells we force a reinit and regeneration of the cells.
       // It's sloppy, but it works for now.
@@ -1021,15 +1306,131 @@ void GroundCover::_initialize( U32 cellCount, U32 cellPlacementCount )
    }
 }
 
+S32 GroundCover::_initGrid( F32 *outCellSize )
+{
+   mGridSize = getMax( mGridSize, (U32)2 );
+
+   // How many cells in the grid?
+   const U32 cells = mGridSize * mGridSize;
+
+   // Whats the max placement count for each cell considering 
+   // the grid size and quality scale LOD value.
+   const S32 placementCount = getMax( ( (F32)mMaxPlacement * smDensityScale ) / F32( mGridSize * mGridSize ), 0.0f );
+
+   // Calculate the normal cell size here.
+   *outCellSize = ( mRadius * 2.0f ) / (F32)(mGridSize - 1);
+
+   // If the cell grid isn't sized or the placement count
+   // changed (most likely because of quality lod) then we
+   // need to initialize the system again.
+   if ( mCellGrid.empty() || placementCount != mLastPlacementCount )
+   {
+      _initialize( cells, placementCount );
+      mLastPlacementCount = placementCount;
+
+      if ( placementCount > 0 )
+         _initPlacementCache( placementCount, *outCellSize );
+   }
+
+   return placementCount;
+}
+
+U32 GroundCover::_getPlacementHash( U32 cellPlacementCount, F32 cellSize )
+{
+   #define HASH_VALUE( value ) hash = Torque::hash( (const U8*)&(value), sizeof( value ), hash )
+   #define HASH_STRING( str ) if ( str ) hash = Torque::hash( (const U8*)(str), dStrlen( str ), hash )
+
+   U32 hash = 0;
+
+   HASH_VALUE( cellPlacementCount );
+   HASH_VALUE( cellSize );
+   HASH_VALUE( mRandomSeed );
+   HASH_VALUE( mZOffset );
+
+   // The normalized probability and aspect scales were
+   // already updated from the type settings.
+   for ( U32 i=0; i < MAX_COVERTYPES; i++ )
+   {
+      HASH_VALUE( mNormalizedProbability[i] );
+      HASH_VALUE( mBillboardAspectScales[i] );
+      HASH_VALUE( mSizeMin[i] );
+      HASH_VALUE( mSizeMax[i] );
+      HASH_VALUE( mSizeExponent[i] );
+      HASH_VALUE( mWindScale[i] );
+      HASH_VALUE( mMaxSlope[i] );
+      HASH_VALUE( mMinElevation[i] );
+      HASH_VALUE( mMaxElevation[i] );
+      HASH_VALUE( mInvertLayer[i] );
+      HASH_VALUE( mMinClumpCount[i] );
+      HASH_VALUE( mMaxClumpCount[i] );
+      HASH_VALUE( mClumpCountExponent[i] );
+      HASH_VALUE( mClumpRadius[i] );
+      HASH_STRING( mLayer[i] );
+      HASH_STRING( mShapeFilenames[i] );
+   }
+
+   // The terrains are identified by the checksum of
+   // their file and where they are placed.
+   const Vector<SceneObject*> terrainBlocks = getContainer()->getTerrains();
+   for ( U32 i=0; i < terrainBlocks.size(); i++ )
+   {
+      TerrainBlock *terrain = dynamic_cast< TerrainBlock* >( terrainBlocks[i] );
+      if ( !terrain )
+         continue;
+
+      const U32 crc = terrain->getCRC();
+      const MatrixF &xfm = terrain->getTransform();
+      const F32 squareSize = terrain->getSquareSize();
+      const U32 lightMapSize = terrain->getLightMapSize();
+
+      HASH_VALUE( crc );
+      HASH_VALUE( xfm );
+      HASH_VALUE( squareSize );
+      HASH_VALUE( lightMapSize );
+   }
+
+   #undef HASH_VALUE
+   #undef HASH_STRING
+
+   return hash;
+}
+
+void GroundCover::_initPlacementCache( U32 cellPlacementCount, F32 cellSize )
+{
+   const U32 hash = _getPlacementHash( cellPlacementCount, cellSize );
+   if ( hash == mPlacementCache->getHash() && cellSize == mPlacementCache->getCellSize() )
+      return;
+
+   mPlacementCache->reset( hash, cellSize );
+
+   if ( !mPlacementCacheFile || !mPlacementCacheFile[0] )
+      return;
+
+   FileStream stream;
+   if ( !stream.open( mPlacementCacheFile, Torque::FS::File::Read ) )
+      return;
+
+   if ( !mPlacementCache->read( stream ) )
+   {
+      Con::warnf( "GroundCover::_initPlacementCache() - The placement cache '%s' doesn't match the cover settings and terrain, call savePlacementCache() to update it.", mPlacementCacheFile );
+      return;
+   }
+
+   Con::printf( "GroundCover::_initPlacementCache() - Loaded %d cells from '%s'.", mPlacementCache->size(), mPlacementCacheFile );
+}
+
 GroundCoverCell* GroundCover::_generateCell( const Point2I& index, 
+                                             const Point2I& worldIndex,
                                              const Box3F& bounds, 
                                              U32 placementCount,
-                                             S32 randSeed )
+                                             S32 randSeed,
+                                             bool *outCached )
 {
    PROFILE_SCOPE(GroundCover_GenerateCell);
 
-   const Vector<SceneObject*> terrainBlocks = getContainer()->getTerrains();
-   if ( terrainBlocks.empty() )
+   *outCached = false;
+
+   if ( getContainer()->getTerrains().empty() )
       return NULL;
 
    // Grab a free cell or allocate a new one.
@@ -1049,6 +1450,28 @@ GroundCoverCell* GroundCover::_generateCell( const Point2I& index,
    cell->mIndex = index;
    cell->mBounds = bounds;
 
+   // Copy the placement from the cache if we have it.
+   if ( mPlacementCache->load( worldIndex, cell ) )
+   {
+      *outCached = true;
+      return cell;
+   }
+
+   _scatterCell( cell, placementCount, randSeed );
+
+   if ( (S32)mPlacementCache->size() < smMaxCachedCells )
+      mPlacementCache->store( worldIndex, cell );
+
+   return cell;
+}
+
+void GroundCover::_scatterCell( GroundCoverCell *cell, U32 placementCount, S32 randSeed )
+{
+   PROFILE_SCOPE(GroundCover_ScatterCell);
+
+   const Vector<SceneObject*> terrainBlocks = getContainer()->getTerrains();
+   const Box3F bounds = cell->mBounds;
+
    Point3F pos( 0, 0, 0 );
 
    Box3F renderBounds = bounds;
@@ -1324,8 +1747,6 @@ GroundCoverCell* GroundCover::_generateCell( const Point2I& index,
    cell->mRenderBounds = renderBounds;
    cell->mBounds.minExtents.z = renderBounds.minExtents.z;
    cell->mBounds.maxExtents.z = renderBounds.maxExtents.z;
-
-   return cell;
 }
 
 void GroundCover::onTerrainUpdated( U32 flags, TerrainBlock *tblock, const Point2I& min, const Point2I& max )
@@ -1337,6 +1758,7 @@ void GroundCover::onTerrainUpdated( U32 flags, TerrainBlock *tblock, const Point
    if ( flags & TerrainBlock::LightmapUpdate )
    {
       _freeCells();
+      mPlacementCache->clear();
       return;
    }
 
@@ -1355,6 +1777,9 @@ void GroundCover::onTerrainUpdated( U32 flags, TerrainBlock *tblock, const Point
       // TODO: I don't think this works right with tiling!
       Box3F dirty(   F32( min.x * size ) + pos.x, F32( min.y * size ) + pos.y, 0.0f,
                      F32( max.x * size ) + pos.x, F32( max.y * size ) + pos.y, 0.0f );
+
+      // The cached placement of these cells is stale too.
+      mPlacementCache->erase( RectF( dirty.minExtents.x, dirty.minExtents.y, dirty.len_x(), dirty.len_y() ) );
       
       // Now free any cells that overlap it!
       for ( S32 i = 0; i < mCellGrid.size(); i++ )
@@ -1379,23 +1804,8 @@ void GroundCover::_updateCoverGrid( const Frustum &culler )
 {
    PROFILE_SCOPE( GroundCover_UpdateCoverGrid );
    
-   mGridSize = getMax( mGridSize, (U32)2 );
-
-   // How many cells in the grid?
-   const U32 cells = mGridSize * mGridSize;
-
-   // Whats the max placement count for each cell considering 
-   // the grid size and quality scale LOD value.
-   const S32 placementCount = getMax( ( (F32)mMaxPlacement * smDensityScale ) / F32( mGridSize * mGridSize ), 0.0f );
-
-   // If the cell grid isn't sized or the placement count
-   // changed (most likely because of quality lod) then we
-   // need to initialize the system again.
-   if ( mCellGrid.empty() || placementCount != mLastPlacementCount )
-   {
-      _initialize( cells, placementCount );
-      mLastPlacementCount = placementCount;
-   }
+   F32 cellSize;
+   const S32 placementCount = _initGrid( &cellSize );
 
    // Without a count... we don't function at all.
    if ( placementCount == 0 )
@@ -1404,9 +1814,6 @@ void GroundCover::_updateCoverGrid( const Frustum &culler )
    // Clear the scratch grid.
    dMemset( mScratchGrid.address(), 0, mScratchGrid.memSize() );
 
-   // Calculate the normal cell size here.
-   const F32 cellSize = ( mRadius * 2.0f ) / (F32)(mGridSize - 1);
-
    // Figure out the root index of the new grid based on the camera position.
    Point2I index( (S32)mFloor( ( culler.getPosition().x - mRadius ) / cellSize  ),
                   (S32)mFloor( ( culler.getPosition().y - mRadius ) / cellSize ) );
@@ -1454,18 +1861,21 @@ void GroundCover::_updateCoverGrid( const Frustum &culler )
    // in generation is rarely noticeable in normal play.
    //
    // The only caveat is that we need to generate the entire visible
-   // grid when we warp.
+   // grid when we warp.  Cells found in the placement cache are cheap
+   // to copy and don't count against the limit.
    U32 cellsGenerated = 0;
+   bool cached;
    for ( S32 i = 0; i < mScratchGrid.size(); i++ )
    {
       GroundCoverCell* cell = mScratchGrid[ i ];
-      if ( !cell && ( cellsGenerated == 0 || didWarp ) )
-      {
-         // Get the index point of this new cell.
-         S32 y = i / mGridSize;
-         S32 x = i - ( y * mGridSize );
-         Point2I newIndex = index + Point2I( x, y );
 
+      // Get the index point of this cell.
+      S32 y = i / mGridSize;
+      S32 x = i - ( y * mGridSize );
+      Point2I newIndex = index + Point2I( x, y );
+
+      if ( !cell && ( cellsGenerated == 0 || didWarp || mPlacementCache->contains( newIndex ) ) )
+      {
          // What will be the world placement bounds for this cell.
          Box3F bounds;
          bounds.minExtents.set( newIndex.x * cellSize, newIndex.y * cellSize, terrainMinHeight );
@@ -1479,7 +1889,8 @@ void GroundCover::_updateCoverGrid( const Frustum &culler )
 
          // We need to allocate a new cell.
          //
-         // TODO: This is the expensive call and where we should optimize. In
+         // TODO: Unless the cell is in the placement cache this is
+         // the expensive call and where we should optimize. In
          // particular the next best optimization would be to take advantage of
          // multiple cores so that we can generate all the cells in one update.
          //
@@ -1495,12 +1906,14 @@ void GroundCover::_updateCoverGrid( const Frustum &culler )
          // 
 
          cell = _generateCell(   newIndex - index, 
+                                 newIndex,
                                  bounds, 
                                  placementCount, 
-                                 mRandomSeed + mAbs( newIndex.x ) + mAbs( newIndex.y ) );
+                                 mRandomSeed + mAbs( newIndex.x ) + mAbs( newIndex.y ),
+                                 &cached );
 
          // Increment our generation count.
-         if ( cell )
+         if ( cell && !cached )
             ++cellsGenerated;
       }
 
@@ -1511,6 +1924,84 @@ void GroundCover::_updateCoverGrid( const Frustum &culler )
    mGridIndex = index;
 }
 
+bool GroundCover::savePlacementCache()
+{
+   // The cells are only generated on the client.
+   if ( isServerObject() )
+   {
+      GroundCover *clientObj = getClientObject( this );
+      if ( !clientObj )
+      {
+         Con::errorf( "GroundCover::savePlacementCache() - There is no client object to generate the placement!" );
+         return false;
+      }
+
+      return clientObj->savePlacementCache();
+   }
+
+   if ( !mPlacementCacheFile || !mPlacementCacheFile[0] )
+   {
+      Con::errorf( "GroundCover::savePlacementCache() - The placementCacheFile isn't set!" );
+      return false;
+   }
+
+   F32 cellSize;
+   const S32 placementCount = _initGrid( &cellSize );
+   if ( placementCount == 0 )
+      return false;
+
+   // Get the terrain elevation range for setting the default cell bounds.
+   const F32   terrainMinHeight = -5000.0f, 
+               terrainMaxHeight = 5000.0f;
+
+   // Scatter all the cells over the terrains which 
+   // weren't generated or loaded already.
+   GroundCoverCell cell;
+
+   const Vector<SceneObject*> terrainBlocks = getContainer()->getTerrains();
+   for ( U32 i=0; i < terrainBlocks.size(); i++ )
+   {
+      const Box3F &terrBounds = terrainBlocks[i]->getWorldBox();
+
+      const Point2I start( (S32)mFloor( terrBounds.minExtents.x / cellSize ),
+                           (S32)mFloor( terrBounds.minExtents.y / cellSize ) );
+      const Point2I end(   (S32)mFloor( terrBounds.maxExtents.x / cellSize ),
+                           (S32)mFloor( terrBounds.maxExtents.y / cellSize ) );
+
+      for ( S32 y = start.y; y <= end.y; y++ )
+      {
+         for ( S32 x = start.x; x <= end.x; x++ )
+         {
+            const Point2I index( x, y );
+            if ( mPlacementCache->contains( index ) )
+               continue;
+
+            cell.mBounds.minExtents.set( x * cellSize, y * cellSize, terrainMinHeight );
+            cell.mBounds.maxExtents.set( cell.mBounds.minExtents.x + cellSize, cell.mBounds.minExtents.y + cellSize, terrainMaxHeight );
+
+            _scatterCell( &cell, placementCount, mRandomSeed + mAbs( x ) + mAbs( y ) );
+            mPlacementCache->store( index, &cell );
+         }
+      }
+   }
+
+   FileStream stream;
+   if ( !stream.open( mPlacementCacheFile, Torque::FS::File::Write ) )
+   {
+      Con::errorf( "GroundCover::savePlacementCache() - Failed opening '%s'!", mPlacementCacheFile );
+      return false;
+   }
+
+   if ( !mPlacementCache->write( stream ) )
+   {
+      Con::errorf( "GroundCover::savePlacementCache() - Failed writing '%s'!", mPlacementCacheFile );
+      return false;
+   }
+
+   Con::printf( "GroundCover::savePlacementCache() - Saved %d cells to '%s'.", mPlacementCache->size(), mPlacementCacheFile );
+   return true;
+}
+
 void GroundCover::prepRenderImage( SceneRenderState *state )
 {
    // Reset stats each time we hit the diffuse pass.
@@ -1706,3 +2197,12 @@ void GroundCover::_debugRender( ObjectRenderInst *ri, SceneRenderState *state, B
       drawer->drawCube( desc, cell->getRenderBounds().getExtents(), cell->getRenderBounds().getCenter(), ColorI( 0, 255, 0 ) );
    }
 }
+
+DefineEngineMethod( GroundCover, savePlacementCache, bool, (),,
+   "Scatters the cover over all the terrains and saves the placement of every cell to the placementCacheFile.\n"
+   "While the cover settings and terrains match the ones the file was saved with, the cells are loaded from "
+   "it instead of being scattered at runtime.\n"
+   "@return True if the file was saved.\n" )
+{
+   return object->savePlacementCache();
+}
@@ -47,6 +47,7 @@
 
 class TerrainBlock;
 class GroundCoverCell;
+class GroundCoverPlacementCache;
 class TSShapeInstance;
 class Material;
 class MaterialParameters;
@@ -151,6 +152,10 @@ public:
    /// Returns the current quality scale... see above.
    static F32 getQualityScale() { return smDensityScale; }
 
+   /// Scatters every cell over the terrains which isn't cached
+   /// yet and saves the placement cache to the placementCacheFile.
+   bool savePlacementCache();
+
 protected:      
 
    enum MaskBits 
@@ -213,6 +218,15 @@ protected:
    /// This is the index to the first grid cell.
    Point2I mGridIndex;
 
+   /// The optional file the cell placement is loaded
+   /// from and saved to by savePlacementCache().
+   StringTableEntry mPlacementCacheFile;
+
+   /// The placement of the cells generated so far or loaded
+   /// from mPlacementCacheFile, reused when a cell comes back
+   /// into view instead of scattering it again.
+   GroundCoverPlacementCache *mPlacementCache;
+
    /// The maximum amount of cover elements to include in
    /// the grid at any one time.  The actual amount may be
    /// less than this based on randomization.
@@ -256,6 +270,10 @@ protected:
    /// CPU performance.
    static F32 smDensityScale;   
 
+   /// The maximum amount of cells scattered at runtime which
+   /// are kept in the placement cache.
+   static S32 smMaxCachedCells;
+
    String mMaterialName;
    Material *mMaterial;
    BaseMatInstance *mMatInst;
@@ -364,6 +382,19 @@ protected:
    /// things need to be reinitialized to continue.
    void _initialize( U32 cellCount, U32 cellPlacementCount );
 
+   /// Initializes the system if the grid was freed or the
+   /// placement count changed and returns the placement 
+   /// count and size of each cell.
+   S32 _initGrid( F32 *outCellSize );
+
+   /// Returns a hash of everything the placement of
+   /// the cells depends on.
+   U32 _getPlacementHash( U32 cellPlacementCount, F32 cellSize );
+
+   /// Clears the placement cache if the placement hash changed
+   /// and loads mPlacementCacheFile if it matches the new hash.
+   void _initPlacementCache( U32 cellPlacementCount, F32 cellSize );
+
    /// Updates the cover grid by removing cells that
    /// have fallen outside of mRadius and adding new 
    /// ones that have come into view.
@@ -380,10 +411,17 @@ protected:
    void _recycleCell( GroundCoverCell* cell );
 
    /// Generates a new cell using the recycle list when possible.
+   /// The placement is copied from the cache when it has the cell
+   /// at @a worldIndex in which case @a outCached is set.
    GroundCoverCell* _generateCell(  const Point2I& index,
+                                    const Point2I& worldIndex,
                                     const Box3F& bounds, 
                                     U32 placementCount,
-                                    S32 randSeed );
+                                    S32 randSeed,
+                                    bool *outCached );
+
+   /// Scatters the cover elements over the bounds of the cell.
+   void _scatterCell( GroundCoverCell *cell, U32 placementCount, S32 randSeed );
 
    void _debugRender( ObjectRenderInst *ri, SceneRenderState *state, BaseMatInstance *overrideMat );
 };
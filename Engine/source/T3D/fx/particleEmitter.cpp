@@ -27,6 +27,7 @@
 
 #include "platform/platform.h"
 #include "T3D/fx/particleEmitter.h"
+#include "T3D/fx/gpuParticleSystem.h"
 
 #include "scene/sceneManager.h"
 #include "scene/sceneRenderState.h"
@@ -39,15 +40,37 @@
 #include "gfx/primBuilder.h"
 #include "gfx/gfxStringEnumTranslate.h"
 #include "renderInstance/renderPassManager.h"
+#include "renderInstance/renderParticleMgr.h"
 #include "T3D/gameBase/gameProcess.h"
 #include "lighting/lightInfo.h"
 #include "console/engineAPI.h"
+#include "platform/threads/jobSystem.h"
+#include "T3D/fx/fxObjectPool.h"
 
 #if defined(AFX_CAP_PARTICLE_POOLS) 
 #include "afx/util/afxParticlePool.h"
 #endif 
 
 Point3F ParticleEmitter::mWindVelocity( 0.0, 0.0, 0.0 );
+bool ParticleEmitter::smParallelUpdate = true;
+U32 ParticleEmitter::smParallelUpdateMinEmitters = 4;
+U32 ParticleEmitter::smBatchMaxParticles = 256;
+
+/// Emitters queued by prepAnimation() for the current render pass.
+/// Only touched on the main thread.
+static Vector<ParticleEmitter*> sgUpdateQueue( __FILE__, __LINE__ );
+
+/// Expired effect emitters waiting to be reused.
+static FXObjectPool<ParticleEmitter> sgEmitterPool;
+
+/// Render pass state shared by the vertex fill jobs.
+struct ParticleFillJobData
+{
+   ParticleEmitter **emitters;
+   Point3F camPos;
+   LinearColorF ambientColor;
+   MatrixF worldMat;
+};
 const F32 ParticleEmitter::AgedSpinToRadians = (1.0f/1000.0f) * (1.0f/360.0f) * M_PI_F * 2.0f;
 
 IMPLEMENT_CO_DATABLOCK_V1(ParticleEmitterData);
@@ -151,6 +174,8 @@ ParticleEmitterData::ParticleEmitterData()
    sortParticles = false;
    renderReflection = true;
    glow = false;
+   gpuSimulation = false;
+   gpuMaxParticles = 0;
    reverseOrder = false;
    textureName = 0;
    textureHandle = 0;
@@ -313,6 +338,16 @@ void ParticleEmitterData::initPersistFields()
       addField("glow", TYPEID< bool >(), Offset(glow, ParticleEmitterData),
          "If true, the particles are rendered to the glow buffer as well.");
 
+      addField( "gpuSimulation", TYPEID< bool >(), Offset(gpuSimulation, ParticleEmitterData),
+         "If true, the particles are simulated and rendered on the GPU. GPU particles follow "
+         "a fixed path from the moment they spawn and cannot be oriented, aligned, sorted, "
+         "constrained or animated. Emitters which use any of those simulate on the CPU." );
+
+      addField( "gpuMaxParticles", TYPEID< S32 >(), Offset(gpuMaxParticles, ParticleEmitterData),
+         "The maximum number of live particles of a GPU simulated emitter. Spawning more "
+         "replaces the oldest ones. If 0 it is derived from the ejection period and the "
+         "particle lifetimes." );
+
       //@}
 
    endGroup( "ParticleEmitterData" );
@@ -401,6 +436,8 @@ void ParticleEmitterData::packData(BitStream* stream)
    stream->writeFlag(highResOnly);
    stream->writeFlag(renderReflection);
    stream->writeFlag(glow);
+   if (stream->writeFlag(gpuSimulation))
+      stream->write(gpuMaxParticles);
    stream->writeInt( blendStyle, 4 );
 
    stream->writeFlag(ejectionInvert);
@@ -480,6 +517,11 @@ void ParticleEmitterData::unpackData(BitStream* stream)
    highResOnly = stream->readFlag();
    renderReflection = stream->readFlag();
    glow = stream->readFlag();
+   gpuSimulation = stream->readFlag();
+   if (gpuSimulation)
+      stream->read(&gpuMaxParticles);
+   else
+      gpuMaxParticles = 0;
    blendStyle = stream->readInt( 4 );
    ejectionInvert = stream->readFlag();
    fade_color = stream->readFlag();
@@ -736,6 +778,9 @@ bool ParticleEmitterData::preload(bool server, String &errorStr)
    
    if( !server )
    {
+      // Fall back to the CPU if the GPU can't simulate these particles.
+      gpuSimulation = GPUParticleSystem::canSimulate( this );
+
       allocPrimBuffer();
    }
 
@@ -770,11 +815,16 @@ void ParticleEmitterData::allocPrimBuffer( S32 overrideSize )
       partListInitSize = overrideSize;
    }
 
+   // GPU simulated emitters draw in chunks which share one index buffer
+   U32 numQuads = partListInitSize;
+   if( gpuSimulation )
+      numQuads = getMin( getGPUCapacity(), (U32)GPUParticleSystem::ParticlesPerDraw );
+
    // create index buffer based on that size
-   U32 indexListSize = partListInitSize * 6; // 6 indices per particle
+   U32 indexListSize = numQuads * 6; // 6 indices per particle
    U16 *indices = new U16[ indexListSize ];
 
-   for( U32 i=0; i<partListInitSize; i++ )
+   for( U32 i=0; i<numQuads; i++ )
    {
       // this index ordering should be optimal (hopefully) for the vertex cache
       U16 *idx = &indices[i*6];
@@ -846,6 +896,8 @@ ParticleEmitterData::ParticleEmitterData(const ParticleEmitterData& other, bool
    textureHandle = other.textureHandle; // -- TextureHandle loads using textureName
    highResOnly = other.highResOnly;
    renderReflection = other.renderReflection;
+   gpuSimulation = other.gpuSimulation;
+   gpuMaxParticles = other.gpuMaxParticles;
    fade_color = other.fade_color;
    fade_size = other.fade_size;
    fade_alpha = other.fade_alpha;
@@ -935,6 +987,7 @@ ParticleEmitter::ParticleEmitter()
 {
    mDeleteWhenEmpty  = false;
    mDeleteOnTick     = false;
+   mRecycle          = false;
 
    mInternalClock    = 0;
    mNextParticleTime = 0;
@@ -952,6 +1005,12 @@ ParticleEmitter::ParticleEmitter()
    n_parts = 0;
 
    mCurBuffSize = 0;
+   mGPUSystem = NULL;
+
+   mPendingUpdateMS = 0;
+   mUpdateQueued = false;
+   mVertsFilled = false;
+   mLockedVerts = NULL;
 
    mDead = false;
    mDataBlock = NULL;
@@ -970,6 +1029,31 @@ ParticleEmitter::ParticleEmitter()
 #endif 
 }
 
+//-----------------------------------------------------------------------------
+// consoleInit
+//-----------------------------------------------------------------------------
+void ParticleEmitter::consoleInit()
+{
+   Con::addVariable( "$Particles::parallelUpdate", TypeBool, &smParallelUpdate,
+      "@brief If true, the particles of visible emitters are simulated and their vertex "
+      "buffers filled in parallel before each render pass.\n"
+      "The default value is true.\n"
+      "@ingroup FX\n" );
+
+   Con::addVariable( "$Particles::parallelUpdateMinEmitters", TypeS32, &smParallelUpdateMinEmitters,
+      "@brief Minimum number of visible emitters before they are updated in parallel.\n"
+      "The default value is 4.\n"
+      "@ingroup FX\n" );
+
+   Con::addVariable( "$Particles::batchMaxParticles", TypeS32, &smBatchMaxParticles,
+      "@brief Emitters with up to this many particles share their vertex stream so emitters "
+      "with the same texture and blending are drawn together. 0 disables batching.\n"
+      "The default value is 256.\n"
+      "@ingroup FX\n" );
+
+   Parent::consoleInit();
+}
+
 //-----------------------------------------------------------------------------
 // destructor
 //-----------------------------------------------------------------------------
@@ -979,6 +1063,7 @@ ParticleEmitter::~ParticleEmitter()
    {
       delete [] part_store[i];
    }
+   SAFE_DELETE( mGPUSystem );
    if (db_temp_clone && mDataBlock && mDataBlock->isTempClone())
    {
      for (S32 i = 0; i < mDataBlock->particleDataBlocks.size(); i++)
@@ -1030,6 +1115,8 @@ bool ParticleEmitter::onAdd()
 //-----------------------------------------------------------------------------
 void ParticleEmitter::onRemove()
 {
+   sgEmitterPool.remove( this );
+
 #if defined(AFX_CAP_PARTICLE_POOLS) 
   if (pool)
   {
@@ -1038,6 +1125,8 @@ void ParticleEmitter::onRemove()
   }
 #endif
 
+   _removeFromUpdateQueue();
+
    removeFromScene();
    Parent::onRemove();
 }
@@ -1052,17 +1141,13 @@ bool ParticleEmitter::onNewDataBlock( GameBaseData *dptr, bool reload )
    if ( !mDataBlock || !Parent::onNewDataBlock( dptr, reload ) )
       return false;
 
-   mLifetimeMS = mDataBlock->lifetimeMS;
-   if( mDataBlock->lifetimeVarianceMS )
-   {
-      mLifetimeMS += S32( gRandGen.randI() % (2 * mDataBlock->lifetimeVarianceMS + 1)) - S32(mDataBlock->lifetimeVarianceMS );
-   }
+   _initLifetime();
 
    //   Allocate particle structures and init the freelist. Member part_store
    //   is a Vector so that we can allocate more particles if partListInitSize
    //   turns out to be too small. 
    //
-   if (mDataBlock->partListInitSize > 0)
+   if (mDataBlock->partListInitSize > 0 && !mDataBlock->gpuSimulation)
    {
       for( S32 i = 0; i < part_store.size(); i++ )
       {
@@ -1083,6 +1168,14 @@ bool ParticleEmitter::onNewDataBlock( GameBaseData *dptr, bool reload )
       part_list_head.next = NULL;
       n_parts = 0;
    }
+
+   SAFE_DELETE( mGPUSystem );
+   if (mDataBlock->gpuSimulation)
+   {
+      mGPUSystem = new GPUParticleSystem( mDataBlock->getGPUCapacity() );
+      updateGPUTypes();
+      n_parts = 0;
+   }
    if (mDataBlock->isTempClone())
    {
      db_temp_clone = true;
@@ -1093,6 +1186,84 @@ bool ParticleEmitter::onNewDataBlock( GameBaseData *dptr, bool reload )
    return true;
 }
 
+//-----------------------------------------------------------------------------
+// _initLifetime
+//-----------------------------------------------------------------------------
+void ParticleEmitter::_initLifetime()
+{
+   mLifetimeMS = mDataBlock->lifetimeMS;
+   if( mDataBlock->lifetimeVarianceMS )
+   {
+      mLifetimeMS += S32( gRandGen.randI() % (2 * mDataBlock->lifetimeVarianceMS + 1)) - S32(mDataBlock->lifetimeVarianceMS );
+   }
+}
+
+//-----------------------------------------------------------------------------
+// create
+//-----------------------------------------------------------------------------
+ParticleEmitter* ParticleEmitter::create( ParticleEmitterData *datablock )
+{
+   ParticleEmitter *emitter = sgEmitterPool.acquire( datablock );
+   if( !emitter )
+   {
+      emitter = new ParticleEmitter;
+      emitter->setDataBlock( datablock );
+      emitter->mRecycle = true;
+   }
+
+   return emitter;
+}
+
+//-----------------------------------------------------------------------------
+// spawn
+//-----------------------------------------------------------------------------
+bool ParticleEmitter::spawn()
+{
+   if( !isProperlyAdded() )
+   {
+      if( registerObject() )
+         return true;
+
+      delete this;
+      return false;
+   }
+
+   // Wake up a dormant emitter.  It has no particles left and is added
+   // back to the scene by its first emission.
+   mDead = false;
+   mDeleteWhenEmpty = false;
+   mDeleteOnTick = false;
+   mInternalClock = 0;
+   mNextParticleTime = 0;
+   mHasLastPosition = false;
+   mElapsedTimeMS = 0;
+   mPendingUpdateMS = 0;
+   fade_amt = 1.0f;
+   forced_bbox = false;
+   sort_priority = 0;
+   _initLifetime();
+
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+// _expire
+//-----------------------------------------------------------------------------
+void ParticleEmitter::_expire()
+{
+   mDead = true;
+
+   if( !mRecycle || !sgEmitterPool.release( this, mDataBlock ) )
+   {
+      deleteObject();
+      return;
+   }
+
+   _removeFromUpdateQueue();
+   removeFromScene();
+   removeFromProcessList();
+}
+
 //-----------------------------------------------------------------------------
 // getCollectiveColor
 //-----------------------------------------------------------------------------
@@ -1138,21 +1309,45 @@ void ParticleEmitter::prepRenderImage(SceneRenderState* state)
 
    PROFILE_SCOPE(ParticleEmitter_prepRenderImage);
 
+   // The first emitter of the pass updates all the queued ones.
+   if ( !sgUpdateQueue.empty() )
+      _updateQueued( state );
+
+   simulatePending();
+
+   const bool vertsFilled = mVertsFilled;
+   mVertsFilled = false;
+
    if (  mDead ||
          n_parts == 0 || 
-         part_list_head.next == NULL )
+         ( !mGPUSystem && part_list_head.next == NULL ) )
       return;
 
    RenderPassManager *renderManager = state->getRenderPass();
    const Point3F &camPos = state->getCameraPosition();
-   copyToVB( camPos, state->getAmbientLightColor() );
 
-   if (!mVertBuff.isValid())
+   GFXVertexBufferHandleBase *vertBuff = &mVertBuff;
+   const ParticleVertexType *batchVerts = NULL;
+   if (mGPUSystem)
+   {
+      mGPUSystem->uploadSpawned();
+      vertBuff = mGPUSystem->getVertexBuffer();
+   }
+   else
+   {
+      if (!vertsFilled)
+         copyToVB( camPos, state->getAmbientLightColor() );
+      if (useBatchVerts())
+         batchVerts = mBatchVerts.address();
+   }
+
+   if (!batchVerts && !vertBuff->isValid())
       return;
 
    ParticleRenderInst *ri = renderManager->allocInst<ParticleRenderInst>();
 
-   ri->vertBuff = &mVertBuff;
+   ri->vertBuff = vertBuff;
+   ri->batchVerts = batchVerts;
    ri->primBuff = &getDataBlock()->primBuff;
    ri->translucentSort = true;
    ri->type = RenderPassManager::RIT_Particle;
@@ -1177,9 +1372,14 @@ void ParticleEmitter::prepRenderImage(SceneRenderState* state)
 
    ri->glow = mDataBlock->glow;
 
+   ri->gpuSystem = mGPUSystem;
+   ri->ambientFactor = mDataBlock->ambientFactor;
+
    // use first particle's texture unless there is an emitter texture to override it
    if (mDataBlock->textureHandle)
      ri->diffuseTex = &*(mDataBlock->textureHandle);
+   else if (mGPUSystem)
+     ri->diffuseTex = &*(mDataBlock->particleDataBlocks[0]->textureHandle);
    else
      ri->diffuseTex = &*(part_list_head.next->dataBlock->textureHandle);
 
@@ -1201,6 +1401,7 @@ void ParticleEmitter::setSizes( F32 *sizeList )
    {
       sizes[i] = sizeList[i];
    }
+   updateGPUTypes();
 }
 
 //-----------------------------------------------------------------------------
@@ -1212,6 +1413,20 @@ void ParticleEmitter::setColors( LinearColorF *colorList )
    {
       colors[i] = colorList[i];
    }
+   updateGPUTypes();
+}
+
+//-----------------------------------------------------------------------------
+// updateGPUTypes
+//-----------------------------------------------------------------------------
+void ParticleEmitter::updateGPUTypes()
+{
+   if( !mGPUSystem )
+      return;
+
+   mGPUSystem->setTypes( mDataBlock->particleDataBlocks,
+                         mDataBlock->useEmitterColors ? colors : NULL,
+                         mDataBlock->useEmitterSizes ? sizes : NULL );
 }
 
 //-----------------------------------------------------------------------------
@@ -1236,8 +1451,7 @@ void ParticleEmitter::deleteWhenEmpty()
       {
          // We're already empty, so delete us now.
 
-         mDead = true;
-         deleteObject();
+         _expire();
       }
       else
          AssertFatal( getSceneManager() != NULL, "ParticleEmitter not on process list and won't get ticked to death" );
@@ -1371,7 +1585,7 @@ void ParticleEmitter::emitParticles(const Point3F& start,
       // NOTE: We are assuming that the just added particle is at the head of our
       //  list.  If that changes, so must this...
       U32 advanceMS = numMilliseconds - currTime;
-      if (mDataBlock->overrideAdvance == false && advanceMS != 0) 
+      if (mDataBlock->overrideAdvance == false && advanceMS != 0 && !mGPUSystem) 
       {
          Particle* last_part = part_list_head.next;
          if (advanceMS > last_part->totalLifetime) 
@@ -1505,6 +1719,17 @@ void ParticleEmitter::updateBBox()
    Point3F minPt(1e10,   1e10,  1e10);
    Point3F maxPt(-1e10, -1e10, -1e10);
 
+   if (mGPUSystem)
+   {
+      // The GPU system bounds the whole path of each particle
+      if (mGPUSystem->getCount() == 0)
+         return;
+
+      const Box3F bounds = mGPUSystem->getBounds();
+      minPt = bounds.minExtents;
+      maxPt = bounds.maxExtents;
+   }
+
    for (Particle* part = part_list_head.next; part != NULL; part = part->next)
    {
       Point3F particleSize(part->size * 0.5f, 0.0f, part->size * 0.5f);
@@ -1535,25 +1760,31 @@ void ParticleEmitter::updateBBox()
 void ParticleEmitter::addParticle(const Point3F& pos, const Point3F& axis, const Point3F& vel,
                                   const Point3F& axisx, const U32 age_offset)
 {
-   n_parts++;
-   if (n_parts > n_part_capacity || n_parts > mDataBlock->partListInitSize)
+   // GPU particles are only set up here and then handed to mGPUSystem
+   Particle gpuPart;
+   Particle* pNew = &gpuPart;
+   if (!mGPUSystem)
    {
-      // In an emergency we allocate additional particles in blocks of 16.
-      // This should happen rarely.
-      Particle* store_block = new Particle[16];
-      part_store.push_back(store_block);
-      n_part_capacity += 16;
-      for (S32 i = 0; i < 16; i++)
+      n_parts++;
+      if (n_parts > n_part_capacity || n_parts > mDataBlock->partListInitSize)
       {
-        store_block[i].next = part_freelist;
-        part_freelist = &store_block[i];
+         // In an emergency we allocate additional particles in blocks of 16.
+         // This should happen rarely.
+         Particle* store_block = new Particle[16];
+         part_store.push_back(store_block);
+         n_part_capacity += 16;
+         for (S32 i = 0; i < 16; i++)
+         {
+           store_block[i].next = part_freelist;
+           part_freelist = &store_block[i];
+         }
+         mDataBlock->allocPrimBuffer(n_part_capacity); // allocate larger primitive buffer or will crash 
       }
-      mDataBlock->allocPrimBuffer(n_part_capacity); // allocate larger primitive buffer or will crash 
+      pNew = part_freelist;
+      part_freelist = pNew->next;
+      pNew->next = part_list_head.next;
+      part_list_head.next = pNew;
    }
-   Particle* pNew = part_freelist;
-   part_freelist = pNew->next;
-   pNew->next = part_list_head.next;
-   part_list_head.next = pNew;
 
    // for earlier access to constrain_pos, the ParticleData datablock is chosen here instead
    // of later in the method.
@@ -1598,6 +1829,14 @@ void ParticleEmitter::addParticle(const Point3F& pos, const Point3F& axis, const
    pNew->currentAge = age_offset;
    pNew->t_last = 0.0f;
    mDataBlock->particleDataBlocks[dBlockIndex]->initializeParticle(pNew, vel);
+
+   if (mGPUSystem)
+   {
+      mGPUSystem->spawn( *pNew, dBlockIndex, age_offset );
+      n_parts = mGPUSystem->getCount();
+      return;
+   }
+
    updateKeyData( pNew );
 
 }
@@ -1609,10 +1848,7 @@ void ParticleEmitter::addParticle(const Point3F& pos, const Point3F& axis, const
 void ParticleEmitter::processTick(const Move*)
 {
    if( mDeleteOnTick == true )
-   {
-      mDead = true;
-      deleteObject();
-   }
+      _expire();
 }
 
 
@@ -1634,6 +1870,48 @@ void ParticleEmitter::advanceTime(F32 dt)
    U32 numMSToUpdate = (U32)(dt * 1000.0f);
    if( numMSToUpdate == 0 ) return;
 
+   if( mGPUSystem )
+   {
+      // The particles move on the GPU, we only retire them
+      mGPUSystem->advanceTime( numMSToUpdate );
+      n_parts = mGPUSystem->getCount();
+
+      if (n_parts < 1 && mDeleteWhenEmpty)
+      {
+         mDeleteOnTick = true;
+         return;
+      }
+
+      if( n_parts > 0 )
+         updateBBox();
+      return;
+   }
+
+   // Catch up if no render pass picked up the last deferred update.
+   simulatePending();
+
+   bool deferUpdate = smParallelUpdate;
+#if defined(AFX_CAP_PARTICLE_POOLS)
+   // Pooled emitters are rendered by their pool.
+   if (pool)
+      deferUpdate = false;
+#endif
+
+   if( deferUpdate )
+   {
+      // Visible emitters simulate in parallel in _updateQueued().
+      mPendingUpdateMS = numMSToUpdate;
+      return;
+   }
+
+   simulate( numMSToUpdate );
+}
+
+//-----------------------------------------------------------------------------
+// simulate
+//-----------------------------------------------------------------------------
+void ParticleEmitter::simulate( U32 numMSToUpdate )
+{
    // TODO: Prefetch
 
    // remove dead particles
@@ -1669,6 +1947,129 @@ void ParticleEmitter::advanceTime(F32 dt)
    }
 }
 
+//-----------------------------------------------------------------------------
+// simulatePending
+//-----------------------------------------------------------------------------
+void ParticleEmitter::simulatePending()
+{
+   if( mPendingUpdateMS == 0 )
+      return;
+
+   U32 ms = mPendingUpdateMS;
+   mPendingUpdateMS = 0;
+   simulate( ms );
+}
+
+//-----------------------------------------------------------------------------
+// prepAnimation
+//-----------------------------------------------------------------------------
+void ParticleEmitter::prepAnimation( SceneRenderState *state )
+{
+   // Queue the emitters prepRenderImage() fills a vertex buffer for.
+   if( !smParallelUpdate || mUpdateQueued || mDead || mGPUSystem )
+      return;
+
+#if defined(AFX_CAP_PARTICLE_POOLS)
+   if (pool)
+      return;
+#endif
+
+   if( state->isShadowPass() || ( state->isReflectPass() && !getDataBlock()->renderReflection ) )
+      return;
+
+   sgUpdateQueue.push_back( this );
+   mUpdateQueued = true;
+}
+
+//-----------------------------------------------------------------------------
+// Parallel update
+//-----------------------------------------------------------------------------
+void ParticleEmitter::_simulateQueuedJob( void *data, U32 start, U32 end )
+{
+   ParticleEmitter **emitters = reinterpret_cast<ParticleEmitter**>( data );
+   for( U32 i = start; i < end; i++ )
+      emitters[i]->simulatePending();
+}
+
+void ParticleEmitter::_fillQueuedJob( void *data, U32 start, U32 end )
+{
+   const ParticleFillJobData *fill = reinterpret_cast<const ParticleFillJobData*>( data );
+   for( U32 i = start; i < end; i++ )
+   {
+      ParticleEmitter *emitter = fill->emitters[i];
+      if( emitter->mLockedVerts )
+         emitter->fillVerts( fill->camPos, fill->ambientColor, fill->worldMat, emitter->mLockedVerts );
+   }
+}
+
+void ParticleEmitter::_updateQueued( SceneRenderState *state )
+{
+   PROFILE_SCOPE( ParticleEmitter_updateQueued );
+
+   const U32 count = sgUpdateQueue.size();
+   for( U32 i = 0; i < count; i++ )
+      sgUpdateQueue[i]->mUpdateQueued = false;
+
+   // Too few to be worth it, let each emitter update in prepRenderImage().
+   if( count < smParallelUpdateMinEmitters )
+   {
+      sgUpdateQueue.clear();
+      return;
+   }
+
+   JobSystem::GLOBAL().parallelFor( count, 1, &_simulateQueuedJob, sgUpdateQueue.address() );
+
+   // Vertex buffers can only be locked on the main thread.  These are
+   // dynamic buffers as the volatile pool allows only one lock at a time.
+   for( U32 i = 0; i < count; i++ )
+   {
+      ParticleEmitter *emitter = sgUpdateQueue[i];
+      if( emitter->mDead || emitter->n_parts == 0 || emitter->part_list_head.next == NULL )
+         continue;
+
+      if( emitter->useBatchVerts() )
+      {
+         emitter->mBatchVerts.setSize( emitter->n_parts * 4 );
+         emitter->mLockedVerts = emitter->mBatchVerts.address();
+         continue;
+      }
+
+      emitter->allocVB();
+      emitter->mLockedVerts = emitter->mVertBuff.lock();
+   }
+
+   ParticleFillJobData fill;
+   fill.emitters = sgUpdateQueue.address();
+   fill.camPos = state->getCameraPosition();
+   fill.ambientColor = state->getAmbientLightColor();
+   fill.worldMat = GFX->getWorldMatrix();
+   JobSystem::GLOBAL().parallelFor( count, 1, &_fillQueuedJob, &fill );
+
+   // Unlock in reverse as GL stages the locks on the frame allocator.
+   for( S32 i = count - 1; i >= 0; i-- )
+   {
+      ParticleEmitter *emitter = sgUpdateQueue[i];
+      if( !emitter->mLockedVerts )
+         continue;
+
+      if( !emitter->useBatchVerts() )
+         emitter->mVertBuff.unlock();
+      emitter->mLockedVerts = NULL;
+      emitter->mVertsFilled = true;
+   }
+
+   sgUpdateQueue.clear();
+}
+
+void ParticleEmitter::_removeFromUpdateQueue()
+{
+   if( !mUpdateQueued )
+      return;
+
+   sgUpdateQueue.remove( this );
+   mUpdateQueued = false;
+}
+
 //-----------------------------------------------------------------------------
 // Update key related particle data
 //-----------------------------------------------------------------------------
@@ -1794,18 +2195,64 @@ S32 QSORT_CALLBACK cmpSortParticles(const void* p1, const void* p2)
 
 void ParticleEmitter::copyToVB( const Point3F &camPos, const LinearColorF &ambientColor )
 {
-   static Vector<SortParticle> orderedVector(__FILE__, __LINE__);
-
    PROFILE_START(ParticleEmitter_copyToVB);
 
+   if( useBatchVerts() )
+   {
+      mBatchVerts.setSize( n_parts * 4 );
+      fillVerts( camPos, ambientColor, GFX->getWorldMatrix(), mBatchVerts.address() );
+   }
+   else
+   {
+      allocVB();
+
+      // write the vertices straight into the locked buffer
+      ParticleVertexType *verts = mVertBuff.lock();
+      fillVerts( camPos, ambientColor, GFX->getWorldMatrix(), verts );
+      mVertBuff.unlock();
+   }
+
+   PROFILE_END();
+}
+
+//-----------------------------------------------------------------------------
+// useBatchVerts
+//-----------------------------------------------------------------------------
+bool ParticleEmitter::useBatchVerts() const
+{
+   const U32 maxParticles = getMin( smBatchMaxParticles, RenderParticleMgr::MaxBatchParticles );
+   return !mGPUSystem && (U32)n_parts <= maxParticles;
+}
+
+//-----------------------------------------------------------------------------
+// Allocate the vertex buffer for the current particle count
+//-----------------------------------------------------------------------------
+void ParticleEmitter::allocVB()
+{
+   // create new VB if emitter size grows
+   if( !mVertBuff || n_parts > mCurBuffSize )
+   {
+      mCurBuffSize = n_parts;
+      mVertBuff.set( GFX, n_parts * 4, GFXBufferTypeDynamic );
+   }
+}
+
+//-----------------------------------------------------------------------------
+// Write the particle vertices
+//-----------------------------------------------------------------------------
+void ParticleEmitter::fillVerts( const Point3F &camPos, const LinearColorF &ambientColor,
+                                 const MatrixF &worldMat, ParticleVertexType *verts )
+{
+   // Not static as emitters may fill their vertices on several threads at once.
+   Vector<SortParticle> orderedVector(__FILE__, __LINE__);
+
    PROFILE_START(ParticleEmitter_copyToVB_Sort);
    // build sorted list of particles (far to near)
    if (mDataBlock->sortParticles)
    {
-     orderedVector.clear();
+     orderedVector.reserve( n_parts );
 
-     MatrixF modelview = GFX->getWorldMatrix();
-     Point3F viewvec; modelview.getRow(1, &viewvec);
+     Point3F viewvec; worldMat.getRow(1, &viewvec);
 
      // add each particle and a distance based sort key to orderedVector
      for (Particle* pp = part_list_head.next; pp != NULL; pp = pp->next)
@@ -1820,9 +2267,7 @@ void ParticleEmitter::copyToVB( const Point3F &camPos, const LinearColorF &ambie
    }
    PROFILE_END();
 
-   static Vector<ParticleVertexType> tempBuff(2048);
-   tempBuff.reserve( n_parts*4 + 64); // make sure tempBuff is big enough
-   ParticleVertexType *buffPtr = tempBuff.address(); // use direct pointer (faster)
+   ParticleVertexType *buffPtr = verts;
    
    if (mDataBlock->orientParticles)
    {
@@ -1916,7 +2361,7 @@ void ParticleEmitter::copyToVB( const Point3F &camPos, const LinearColorF &ambie
       basePoints[2] = Point3F( 1.0, 0.0, -1.0);
       basePoints[3] = Point3F( 1.0, 0.0,  1.0);
 
-      MatrixF camView = GFX->getWorldMatrix();
+      MatrixF camView = worldMat;
       camView.transpose();  // inverse - this gets the particles facing camera
 
       if (mDataBlock->reverseOrder)
@@ -1955,21 +2400,6 @@ void ParticleEmitter::copyToVB( const Point3F &camPos, const LinearColorF &ambie
 
       PROFILE_END();
    }
-
-   PROFILE_START(ParticleEmitter_copyToVB_LockCopy);
-   // create new VB if emitter size grows
-   if( !mVertBuff || n_parts > mCurBuffSize )
-   {
-      mCurBuffSize = n_parts;
-      mVertBuff.set( GFX, n_parts * 4, GFXBufferTypeDynamic );
-   }
-   // lock and copy tempBuff to video RAM
-   ParticleVertexType *verts = mVertBuff.lock();
-   dMemcpy( verts, tempBuff.address(), n_parts * 4 * sizeof(ParticleVertexType) );
-   mVertBuff.unlock();
-   PROFILE_END();
-
-   PROFILE_END();
 }
 
 //-----------------------------------------------------------------------------
@@ -1990,15 +2420,24 @@ void ParticleEmitter::setupBillboard( Particle *part,
    const F32 ambientLerp = mClampF( mDataBlock->ambientFactor, 0.0f, 1.0f );
    LinearColorF partCol = mLerp( part->color, ( part->color * ambientColor ), ambientLerp );
 
-   // fill four verts, use macro and unroll loop
-   #define fillVert(){ \
-      lVerts->point.x = cy * basePts->x - sy * basePts->z;  \
-      lVerts->point.y = 0.0f;                                \
-      lVerts->point.z = sy * basePts->x + cy * basePts->z;  \
-      camView.mulV( lVerts->point );                        \
-      lVerts->point *= width;                               \
-      lVerts->point += part->pos;                           \
-      lVerts->color = partCol.toColorI(); } \
+   const ColorI vertCol = partCol.toColorI();
+
+   // spin the base points and turn all four towards the camera in one batch
+   Point3F points[4];
+   for ( U32 i = 0; i < 4; i++ )
+      points[i].set( cy * basePts[i].x - sy * basePts[i].z,
+                     0.0f,
+                     sy * basePts[i].x + cy * basePts[i].z );
+   m_matF_x_vectorF_bulk( camView, &points[0].x, 4, sizeof( Point3F ), &points[0].x, sizeof( Point3F ) );
+
+   // fill four verts, use macro and unroll loop.  lVerts may point into a
+   // locked vertex buffer, so only write to it.
+   #define fillVert(i){ \
+      Point3F point = points[i];                            \
+      point *= width;                                       \
+      point += part->pos;                                   \
+      lVerts->point = point;                                \
+      lVerts->color = vertCol; } \
 
    // Here we deal with UVs for animated particle (billboard)
    if (part->dataBlock->animateTexture && !part->dataBlock->animTexFrames.empty())
@@ -2011,50 +2450,42 @@ void ParticleEmitter::setupBillboard( Particle *part,
      uv[2] = uv[1] + 1;
      uv[3] = uv[0] + 1;
 
-     fillVert();
+     fillVert(0);
      // Here and below, we copy UVs from particle datablock's current frame's UVs (billboard)
      lVerts->texCoord = part->dataBlock->animTexUVs[uv[0]];
      ++lVerts;
-     ++basePts;
 
-     fillVert();
+     fillVert(1);
      lVerts->texCoord = part->dataBlock->animTexUVs[uv[1]];
      ++lVerts;
-     ++basePts;
 
-     fillVert();
+     fillVert(2);
      lVerts->texCoord = part->dataBlock->animTexUVs[uv[2]];
      ++lVerts;
-     ++basePts;
 
-     fillVert();
+     fillVert(3);
      lVerts->texCoord = part->dataBlock->animTexUVs[uv[3]];
      ++lVerts;
-     ++basePts;
 
      return;
    }
 
-   fillVert();
+   fillVert(0);
    // Here and below, we copy UVs from particle datablock's texCoords (billboard)
    lVerts->texCoord = part->dataBlock->texCoords[0];
    ++lVerts;
-   ++basePts;
 
-   fillVert();
+   fillVert(1);
    lVerts->texCoord = part->dataBlock->texCoords[1];
    ++lVerts;
-   ++basePts;
 
-   fillVert();
+   fillVert(2);
    lVerts->texCoord = part->dataBlock->texCoords[2];
    ++lVerts;
-   ++basePts;
 
-   fillVert();
+   fillVert(3);
    lVerts->texCoord = part->dataBlock->texCoords[3];
    ++lVerts;
-   ++basePts;
 }
 
 //-----------------------------------------------------------------------------
@@ -44,6 +44,8 @@
 #include "T3D/fx/particle.h"
 #endif
 
+class GPUParticleSystem;
+
 class RenderPassManager;
 class ParticleData;
 
@@ -124,6 +126,11 @@ class ParticleEmitterData : public GameBaseData
    bool                  highResOnly;        ///< This particle system should not use the mixed-resolution particle rendering
    bool                  renderReflection;   ///< Enables this emitter to render into reflection passes.
    bool glow;                                ///< Renders this emitter into the glow buffer.
+   bool gpuSimulation;                       ///< Simulate and render the particles on the GPU if possible.
+   U32  gpuMaxParticles;                     ///< Live particle limit of GPU simulated emitters; 0 to derive it.
+
+   /// Live particle limit of GPU simulated emitters.
+   U32 getGPUCapacity() const { return gpuMaxParticles ? gpuMaxParticles : partListInitSize; }
 
    bool reload();
 public:
@@ -169,6 +176,20 @@ class ParticleEmitter : public GameBase
 
    static Point3F mWindVelocity;
    static void setWindVelocity( const Point3F &vel ){ mWindVelocity = vel; }
+
+   /// If true, the particles of visible emitters are simulated and their
+   /// vertex buffers filled in parallel jobs before each render pass.
+   static bool smParallelUpdate;
+
+   /// Minimum number of visible emitters for the parallel update.
+   static U32 smParallelUpdateMinEmitters;
+
+   /// Emitters with up to this many particles are drawn from a vertex
+   /// stream shared with other emitters, which lets the render manager
+   /// batch them.  Zero disables batching.
+   static U32 smBatchMaxParticles;
+
+   static void consoleInit();
    
    LinearColorF getCollectiveColor();
 
@@ -187,6 +208,15 @@ class ParticleEmitter : public GameBase
    /// is turned on, it will delete itself as soon as it's particle count drops to zero.
    void deleteWhenEmpty();
 
+   /// Returns a dormant pooled emitter for @a datablock or a new, unregistered
+   /// one.  Instead of deleting itself after deleteWhenEmpty() the emitter
+   /// goes back to the FX object pool.
+   static ParticleEmitter* create( ParticleEmitterData *datablock );
+
+   /// Registers an emitter from create(), or wakes it up if it came from
+   /// the pool.  The emitter is deleted if this fails.
+   bool spawn();
+
    /// @name Particle Emission
    /// Main interface for creating particles.  The emitter does _not_ track changes
    ///  in axis or velocity over the course of a single update, so this should be called
@@ -247,6 +277,9 @@ class ParticleEmitter : public GameBase
    /// Updates the bounding box for the particle system
    void updateBBox();
 
+   /// Passes the particle types and emitter keys to mGPUSystem.
+   void updateGPUTypes();
+
    /// @}
   protected:
    bool onAdd();
@@ -257,9 +290,42 @@ class ParticleEmitter : public GameBase
 
    // Rendering
   protected:
+   void prepAnimation( SceneRenderState *state );
    void prepRenderImage( SceneRenderState *state );
    void copyToVB( const Point3F &camPos, const LinearColorF &ambientColor );
 
+   /// Grows mVertBuff to hold n_parts particles.
+   void allocVB();
+
+   /// Returns true if the vertices go to mBatchVerts instead of mVertBuff.
+   bool useBatchVerts() const;
+
+   /// Writes the vertices of all particles to @a verts.  Only writes to
+   /// @a verts so it can point into a locked vertex buffer.
+   void fillVerts( const Point3F &camPos, const LinearColorF &ambientColor,
+                   const MatrixF &worldMat, ParticleVertexType *verts );
+
+   /// Ages the particles by @a ms, retires dead ones and moves the rest.
+   void simulate( U32 ms );
+
+   /// Runs the simulation advanceTime() deferred to the render batch.
+   void simulatePending();
+
+   /// Simulates the emitters queued by prepAnimation() and fills their
+   /// vertex buffers for @a state in parallel.
+   static void _updateQueued( SceneRenderState *state );
+
+   static void _simulateQueuedJob( void *data, U32 start, U32 end );
+   static void _fillQueuedJob( void *data, U32 start, U32 end );
+
+   void _removeFromUpdateQueue();
+
+   /// Deletes the emitter, or returns it to the FX object pool.
+   void _expire();
+
+   /// Picks the lifetime of the emitter from its datablock.
+   void _initLifetime();
+
    // PEngine interface
   private:
 
@@ -293,6 +359,9 @@ private:
    bool      mDeleteWhenEmpty;
    bool      mDeleteOnTick;
 
+   /// Set for emitters from create() which are pooled when they expire.
+   bool      mRecycle;
+
 protected: 
    S32       mLifetimeMS;
    S32       mElapsedTimeMS;
@@ -303,6 +372,10 @@ private:
 
    GFXVertexBufferHandle<ParticleVertexType> mVertBuff;
 
+   /// Simulates the particles instead of the list below
+   /// if ParticleEmitterData::gpuSimulation is set.
+   GPUParticleSystem *mGPUSystem;
+
 protected:
    //   These members are for implementing a link-list of the active emitter 
    //   particles. Member part_store contains blocks of particles that can be
@@ -317,6 +390,21 @@ protected:
 private:    
    S32       mCurBuffSize;
 
+   /// Milliseconds of simulation advanceTime() deferred to the render batch.
+   U32       mPendingUpdateMS;
+
+   /// Set while queued for _updateQueued().
+   bool      mUpdateQueued;
+
+   /// Set if _updateQueued() filled mVertBuff for the current pass.
+   bool      mVertsFilled;
+
+   /// Vertices of mVertBuff locked by _updateQueued().
+   ParticleVertexType *mLockedVerts;
+
+   /// Vertices of small emitters for RenderParticleMgr to batch.
+   Vector<ParticleVertexType> mBatchVerts;
+
   protected:
    F32 fade_amt;
    bool forced_bbox;
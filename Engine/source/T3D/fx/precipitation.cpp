@@ -49,6 +49,9 @@ static const U32 dropHitMask =
    StaticShapeObjectType;
 
 IMPLEMENT_CO_NETOBJECT_V1(Precipitation);
+
+F32 Precipitation::smCollisionCellSize = 2.0f;
+S32 Precipitation::smCollisionCellLifetime = 2000;
 IMPLEMENT_CO_DATABLOCK_V1(PrecipitationData);
 
 ConsoleDocClass( Precipitation,
@@ -417,6 +420,17 @@ void Precipitation::initPersistFields()
 
    endGroup("Collision");
 
+   Con::addVariable( "$Precipitation::collisionCellSize", TypeF32, &smCollisionCellSize,
+      "@brief Width in meters of the grid used to cache drop collision heights.\n\n"
+      "Drops in camera following precipitation look up the height of the "
+      "terrain, water and static shapes under them in this grid instead of "
+      "each casting a ray. Set to 0 to raycast every drop.\n"
+      "@ingroup Atmosphere" );
+
+   Con::addVariable( "$Precipitation::collisionCellLifetime", TypeS32, &smCollisionCellLifetime,
+      "Milliseconds before a cached drop collision height is sampled again.\n"
+      "@ingroup Atmosphere" );
+
    addGroup("Movement");
 
       addField( "followCam", TypeBool, Offset(mFollowCam, Precipitation),
@@ -1098,6 +1112,46 @@ void Precipitation::findDropCutoff(Raindrop *drop, const Box3F &box, const Vecto
       VectorF velocity = windVel / drop->mass - VectorF(0, 0, drop->velocity);
       velocity.normalize();
 
+      // Drops that follow the camera land on the cached static geometry
+      // heights; only players and vehicles still need a raycast.
+      if (mFollowCam && smCollisionCellSize > 0.0f && velocity.z < -0.1f)
+      {
+         drop->hitPos = Point3F(0,0,-1000);
+         drop->hitType = 0;
+
+         // Find the column the drop ends up in by sliding it down to the
+         // height under where it would land, refining the guess once.
+         Point3F landing = drop->position;
+         for (U32 i = 0; i < 2; i++)
+         {
+            const CollisionCell &cell = getCollisionCell(landing.x, landing.y, box);
+            if (cell.height == -F32_MAX)
+               break;
+
+            landing = drop->position + velocity * ((cell.height - drop->position.z) / velocity.z);
+            landing.z = cell.height;
+
+            drop->hitPos = landing;
+            drop->hitType = cell.hitType;
+         }
+
+         const U32 dynamicMask = mDropHitMask & ~dropHitMask;
+         if (dynamicMask)
+         {
+            RayInfo rInfo;
+            if (getContainer()->castRay(drop->position - 500.0f * velocity, drop->position + 100.0f * velocity, dynamicMask, &rInfo) &&
+                rInfo.point.z > drop->hitPos.z)
+            {
+               drop->hitPos = rInfo.point;
+               drop->hitType = rInfo.object->getTypeMask();
+            }
+         }
+
+         drop->valid = drop->position.z > drop->hitPos.z;
+         PROFILE_END();
+         return;
+      }
+
       Point3F end   = drop->position + 100 * velocity;
       Point3F start = drop->position - (mFollowCam ? 500.0f : 0.0f) * velocity;
 
@@ -1133,6 +1187,54 @@ void Precipitation::findDropCutoff(Raindrop *drop, const Box3F &box, const Vecto
    PROFILE_END();
 }
 
+const Precipitation::CollisionCell& Precipitation::getCollisionCell(F32 x, F32 y, const Box3F &box)
+{
+   const F32 cellSize = smCollisionCellSize;
+
+   // Size the cache to hold about twice the columns the box covers.
+   const U32 cellsWide = (U32)mCeil(box.len_x() / cellSize) + 1;
+   const U32 cellCount = mClamp(getNextPow2(2 * cellsWide * cellsWide), 1024, 65536);
+   if (mCollisionCells.size() != cellCount)
+   {
+      mCollisionCells.setSize(cellCount);
+      for (U32 i = 0; i < cellCount; i++)
+         mCollisionCells[i].x = S32_MIN;
+   }
+
+   const S32 cx = (S32)mFloor(x / cellSize);
+   const S32 cy = (S32)mFloor(y / cellSize);
+   const U32 currTime = Platform::getVirtualMilliseconds();
+
+   CollisionCell &cell = mCollisionCells[((U32)cx * 73856093u ^ (U32)cy * 19349663u) & (cellCount - 1)];
+   if (cell.x == cx && cell.y == cy && (S32)(currTime - cell.time) < smCollisionCellLifetime)
+      return cell;
+
+   PROFILE_SCOPE(PrecipSampleCollisionCell);
+
+   // Sample the middle of the column from well above the box to below it.
+   const F32 midX = (cx + 0.5f) * cellSize;
+   const F32 midY = (cy + 0.5f) * cellSize;
+
+   cell.x = cx;
+   cell.y = cy;
+   cell.time = currTime;
+
+   RayInfo rInfo;
+   if (getContainer()->castRay(Point3F(midX, midY, box.maxExtents.z + 500.0f),
+                               Point3F(midX, midY, box.minExtents.z - 100.0f), dropHitMask, &rInfo))
+   {
+      cell.height = rInfo.point.z;
+      cell.hitType = rInfo.object->getTypeMask();
+   }
+   else
+   {
+      cell.height = -F32_MAX;
+      cell.hitType = 0;
+   }
+
+   return cell;
+}
+
 void Precipitation::createSplash(Raindrop *drop)
 {
    if (!mDataBlock)
@@ -128,6 +128,25 @@ class Precipitation : public GameBase
 
    U32 mDropHitMask;             ///< Stores the current drop hit mask.
 
+   /// Height of the static geometry under one column of the collision
+   /// grid, so wrapping drops can find their cutoff without a raycast.
+   struct CollisionCell
+   {
+      S32 x, y;      ///< Grid coordinates; S32_MIN when the slot is empty.
+      F32 height;    ///< Top of the geometry, or -F32_MAX when nothing was hit.
+      U32 hitType;   ///< Type mask of the object that was hit.
+      U32 time;      ///< Virtual time the column was sampled.
+   };
+
+   /// Direct mapped cache of sampled columns; colliding cells evict each other.
+   Vector<CollisionCell> mCollisionCells;
+
+   /// Width of a collision grid cell in meters; 0 raycasts every drop.
+   static F32 smCollisionCellSize;
+
+   /// Milliseconds before a sampled column is cast again.
+   static S32 smCollisionCellLifetime;
+
    //console exposed variables
    bool mFollowCam;                 ///< Does the system follow the camera or stay where it's placed.
 
@@ -233,6 +252,7 @@ class Precipitation : public GameBase
    void spawnNewDrop(Raindrop *drop);         ///< Same as spawnDrop except also does z position
    
    void findDropCutoff(Raindrop *drop, const Box3F &box, const VectorF &windVel);   ///< Casts a ray to see if/when a drop will collide
+   const CollisionCell& getCollisionCell(F32 x, F32 y, const Box3F &box);           ///< Returns the sampled static geometry height under x/y
    void wrapDrop(Raindrop *drop, const Box3F &box, const U32 currTime, const VectorF &windVel);         ///< Wraps a drop within the specified box
    
    void createSplash(Raindrop *drop);        ///< Adds a drop to the splash list
@@ -39,12 +39,16 @@
 #include "sim/netConnection.h"
 #include "renderInstance/renderPassManager.h"
 #include "console/engineAPI.h"
+#include "T3D/fx/fxObjectPool.h"
 
 namespace
 {
 
 MRandomLCG sgRandom(0xdeadbeef);
 
+/// Expired splashes waiting to be reused.
+FXObjectPool<Splash> sgSplashPool;
+
 } // namespace {}
 
 //----------------------------------------------------------------------------
@@ -317,6 +321,7 @@ Splash::Splash()
    mTimeSinceLastRing = 0.0;
    mDead = false;
    mElapsedTime = 0.0;
+   mRecycle = false;
 
    mInitialNormal.set( 0.0, 0.0, 1.0 );
 
@@ -342,6 +347,45 @@ void Splash::setInitialState(const Point3F& point, const Point3F& normal, const
    mFog             = 0.0f;
 }
 
+//--------------------------------------------------------------------------
+// Create
+//--------------------------------------------------------------------------
+Splash* Splash::create( SplashData *datablock )
+{
+   Splash *splash = sgSplashPool.acquire( datablock );
+   if( !splash )
+   {
+      splash = new Splash;
+      splash->setDataBlock( datablock );
+      splash->mRecycle = true;
+   }
+
+   return splash;
+}
+
+//--------------------------------------------------------------------------
+// Spawn
+//--------------------------------------------------------------------------
+bool Splash::spawn()
+{
+   if( !isProperlyAdded() )
+   {
+      if( registerObject() )
+         return true;
+
+      delete this;
+      return false;
+   }
+
+   if( !start() )
+   {
+      deleteObject();
+      return false;
+   }
+
+   return true;
+}
+
 
 //--------------------------------------------------------------------------
 // OnAdd
@@ -360,6 +404,18 @@ bool Splash::onAdd()
       return false;
    }
 
+   return start();
+}
+
+//--------------------------------------------------------------------------
+// Start
+//--------------------------------------------------------------------------
+bool Splash::start()
+{
+   NetConnection* conn = NetConnection::getConnectionToServer();
+   if( !conn )
+      return false;
+
    mDelayMS = mDataBlock->delayMS + sgRandom.randI( -mDataBlock->delayVariance, mDataBlock->delayVariance );
    mEndingMS = mDataBlock->lifetimeMS + sgRandom.randI( -mDataBlock->lifetimeVariance, mDataBlock->lifetimeVariance );
 
@@ -371,12 +427,10 @@ bool Splash::onAdd()
    {
       if( mDataBlock->emitterList[i] != NULL )
       {
-         ParticleEmitter * pEmitter = new ParticleEmitter;
-         pEmitter->onNewDataBlock( mDataBlock->emitterList[i], false );
-         if( !pEmitter->registerObject() )
+         ParticleEmitter * pEmitter = ParticleEmitter::create( mDataBlock->emitterList[i] );
+         if( !pEmitter->spawn() )
          {
             Con::warnf( ConsoleLogEntry::General, "Could not register emitter for particle of class: %s", mDataBlock->getName() );
-            delete pEmitter;
             pEmitter = NULL;
          }
          mEmitterList[i] = pEmitter;
@@ -403,6 +457,22 @@ bool Splash::onAdd()
 // OnRemove
 //--------------------------------------------------------------------------
 void Splash::onRemove()
+{
+   sgSplashPool.remove( this );
+
+   releaseEmitters();
+
+   ringList.clear();
+
+   removeFromScene();
+
+   Parent::onRemove();
+}
+
+//--------------------------------------------------------------------------
+// Release emitters
+//--------------------------------------------------------------------------
+void Splash::releaseEmitters()
 {
    for( U32 i=0; i<SplashData::NUM_EMITTERS; i++ )
    {
@@ -412,12 +482,31 @@ void Splash::onRemove()
          mEmitterList[i] = NULL;
       }
    }
+}
+
+//--------------------------------------------------------------------------
+// Expire
+//--------------------------------------------------------------------------
+void Splash::expire()
+{
+   if( !mRecycle || !sgSplashPool.release( this, mDataBlock ) )
+   {
+      deleteObject();
+      return;
+   }
 
+   // Go dormant and reset to the state of a new splash.
+   releaseEmitters();
    ringList.clear();
-
    removeFromScene();
+   removeFromProcessList();
 
-   Parent::onRemove();
+   mCurrMS = 0;
+   mActive = false;
+   mRadius = 0.0;
+   mDead = false;
+   mElapsedTime = 0.0;
+   mInitialNormal.set( 0.0, 0.0, 1.0 );
 }
 
 
@@ -442,23 +531,13 @@ void Splash::processTick(const Move*)
 {
    mCurrMS += TickMs;
 
-   if( isServerObject() )
+   if( mCurrMS >= mEndingMS )
    {
-      if( mCurrMS >= mEndingMS )
-      {
-         mDead = true;
-         if( mCurrMS >= (mEndingMS + mDataBlock->ringLifetime * 1000) )
-         {
-            deleteObject();
-         }
-      }
-   }
-   else
-   {
-      if( mCurrMS >= mEndingMS )
-      {
-         mDead = true;
-      }
+      mDead = true;
+
+      // Expire once the last rings have faded out.
+      if( mCurrMS >= (mEndingMS + mDataBlock->ringLifetime * 1000) )
+         expire();
    }
 }
 
@@ -662,16 +741,14 @@ void Splash::spawnExplosion()
 {
    if( !mDataBlock->explosion ) return;
 
-   Explosion* pExplosion = new Explosion;
-   pExplosion->onNewDataBlock(mDataBlock->explosion, false);
+   Explosion* pExplosion = Explosion::create(mDataBlock->explosion);
 
    MatrixF trans = getTransform();
    trans.setPosition( getPosition() );
 
    pExplosion->setTransform( trans );
    pExplosion->setInitialState( trans.getPosition(), VectorF(0,0,1), 1);
-   if (!pExplosion->registerObject())
-      delete pExplosion;
+   pExplosion->spawn();
 }
 
 //--------------------------------------------------------------------------
@@ -157,6 +157,9 @@ private:
    bool        mDead;
    F32         mElapsedTime;
 
+   /// Set for splashes from create() which are pooled when they expire.
+   bool        mRecycle;
+
 protected:
    Point3F     mInitialPosition;
    Point3F     mInitialNormal;
@@ -179,11 +182,28 @@ protected:
    void        emitRings( F32 dt );
    void        spawnExplosion();
 
+   /// Starts the splash, shared by onAdd() and spawn().
+   bool        start();
+
+   /// Returns the splash to the FX object pool or deletes it.
+   void        expire();
+
+   /// Lets the emitters die out once their particles are gone.
+   void        releaseEmitters();
+
 public:
    Splash();
    ~Splash();
    void setInitialState(const Point3F& point, const Point3F& normal, const F32 fade = 1.0);
 
+   /// Returns a dormant pooled splash for @a datablock or a new,
+   /// unregistered one.
+   static Splash* create( SplashData *datablock );
+
+   /// Registers a splash from create(), or restarts it if it came from
+   /// the pool.  The splash is deleted if this fails.
+   bool spawn();
+
    U32  packUpdate  (NetConnection *conn, U32 mask, BitStream* stream);
    void unpackUpdate(NetConnection *conn,           BitStream* stream);
 
@@ -36,6 +36,8 @@
 #include "math/mathIO.h"
 #include "T3D/gameBase/moveManager.h"
 #include "T3D/gameBase/gameProcess.h"
+#include "T3D/gameBase/lagCompensation.h"
+#include "T3D/gameBase/transformHistory.h"
 
 #ifdef TORQUE_DEBUG_NET_MOVES
 #include "T3D/aiConnection.h"
@@ -239,6 +241,7 @@ ConsoleDocClass( GameBase,
 
 GameBase::GameBase()
 : mDataBlock( NULL ),  
+  mTransformHistory( NULL ),
   mControllingClient( NULL ),
   mCurrentWaterObject( NULL )
 {
@@ -262,6 +265,7 @@ GameBase::~GameBase()
    if (scope_registered)
       arcaneFX::unregisterScopedObject(this);
 #endif
+   delete mTransformHistory;
 }
 
 
@@ -305,11 +309,36 @@ void GameBase::onRemove()
    if ( mDataBlock )
       mDataBlock->mReloadSignal.remove( this, &GameBase::_onDatablockModified );
 
+   if ( mTransformHistory )
+   {
+      LagCompensation::removeObject( this );
+      SAFE_DELETE( mTransformHistory );
+   }
+
    Parent::onRemove();
 }
 
+TransformHistory* GameBase::getTransformHistory( bool create )
+{
+   if ( !mTransformHistory && create )
+      mTransformHistory = new TransformHistory;
+   return mTransformHistory;
+}
+
 bool GameBase::onNewDataBlock( GameBaseData *dptr, bool reload )
 {
+   // The client may have put off loading the datablock until
+   // something used it.
+   if ( dptr && dptr->isPreloadDeferred() )
+   {
+      String errorStr;
+      if ( !dptr->finishDeferredPreload( errorStr ) )
+      {
+         Con::errorf( "GameBase::onNewDataBlock - preload of datablock %s failed: %s", dptr->getName(), errorStr.c_str() );
+         return false;
+      }
+   }
+
    // EDITOR FEATURE: Remove us from old datablock's reload signal and
    // add us to the new one.
    if ( !reload )
@@ -51,6 +51,7 @@
 class NetConnection;
 class ProcessList;
 class GameBase;
+class TransformHistory;
 struct Move;
 
 //----------------------------------------------------------------------------
@@ -205,6 +206,10 @@ class GameBase : public SceneObject
    /// @}
 
    TickCache mTickCache;
+
+   /// Recent server transforms for lag compensation or NULL.
+   /// @see LagCompensation
+   TransformHistory* mTransformHistory;
    
    // Control interface
    GameConnection* mControllingClient;
@@ -249,7 +254,8 @@ public:
       TickLast          = BIT(Parent::MaxNetFlagBit+4), /// Tick this object after all others.
       NewGhost          = BIT(Parent::MaxNetFlagBit+5), /// This ghost was just added during the last update.
       HiFiPassive       = BIT(Parent::MaxNetFlagBit+6), /// Do not interact with other hifi passive objects.
-      MaxNetFlagBit     = Parent::MaxNetFlagBit+6
+      PredictionMatched = BIT(Parent::MaxNetFlagBit+7), /// Is set when the last ghost update on the client confirmed the predicted state, for hifi objects.
+      MaxNetFlagBit     = Parent::MaxNetFlagBit+7
    };
 
    /// @name Inherited Functionality.
@@ -334,6 +340,14 @@ public:
    /// @see NetNearbyAdded
    bool isNetNearbyAdded() const { return mNetFlags.test(NetNearbyAdded); }
 
+   /// Set or clear the PredictionMatched bit in our NetFlags.
+   /// @see PredictionMatched
+   void setPredictionMatched( bool b ) { if (b) mNetFlags.set(PredictionMatched); else mNetFlags.clear(PredictionMatched); }
+
+   /// Returns true if the PredictionMatched bit in our NetFlags is set.
+   /// @see PredictionMatched
+   bool isPredictionMatched() const { return mNetFlags.test(PredictionMatched); }
+
    /// Returns true if the HiFiPassive bit in our NetFlags is set.
    /// @see HiFiPassive
    bool isHifiPassive() const { return mNetFlags.test(HiFiPassive); }
@@ -351,6 +365,10 @@ public:
 
    /// Returns TickCache used under the hifi-net model.
    TickCache& getTickCache() { return mTickCache; }
+
+   /// Returns the transform history used for lag compensation, allocating
+   /// it if @a create is true.
+   TransformHistory* getTransformHistory( bool create = false );
    /// @}
 
    /// @name Network
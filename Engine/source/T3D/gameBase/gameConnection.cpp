@@ -74,6 +74,8 @@ const U32 GameConnection::MinRequiredProtocolVersion = 12;
 
 IMPLEMENT_CONOBJECT(GameConnection);
 S32 GameConnection::mLagThresholdMS = 0;
+U32 GameConnection::smDataBlockWindow = 64;
+bool GameConnection::smDeferDataBlockPreload = false;
 Signal<void(F32)> GameConnection::smFovUpdate;
 Signal<void()>    GameConnection::smPlayingDemo;
 
@@ -221,6 +223,7 @@ GameConnection::GameConnection()
 
    mDataBlockModifiedKey = 0;
    mMaxDataBlockModifiedKey = 0;
+   mDataBlockWindow = DataBlockQueueCount;
    mAuthInfo = NULL;
    mControlForceMismatch = false;
    mConnectArgc = 0;
@@ -1169,7 +1172,7 @@ void GameConnection::readPacket(BitStream *bstream)
       { 
          if (bstream->readFlag()) 
          { 
-            S32 gIndex = bstream->readInt(NetConnection::GhostIdBitSize);
+            S32 gIndex = NetConnection::readGhostIndex(bstream);
             setSelectedObj(static_cast<SceneObject*>(resolveGhost(gIndex)));
          }
          else
@@ -1220,7 +1223,7 @@ void GameConnection::readPacket(BitStream *bstream)
             if(mControlObject.isNull())
                callScript = true;
 
-            S32 gIndex = bstream->readInt(NetConnection::GhostIdBitSize);
+            S32 gIndex = NetConnection::readGhostIndex(bstream);
             GameBase* obj = dynamic_cast<GameBase*>(resolveGhost(gIndex));
             if (mControlObject != obj)
             {
@@ -1265,7 +1268,7 @@ void GameConnection::readPacket(BitStream *bstream)
          if (mCameraObject.isNull())
             callScript = true;
 
-         S32 gIndex = bstream->readInt(NetConnection::GhostIdBitSize);
+         S32 gIndex = NetConnection::readGhostIndex(bstream);
          GameBase* obj = dynamic_cast<GameBase*>(resolveGhost(gIndex));
          setCameraObject(obj);
          obj->readPacketData(this, bstream);
@@ -1437,7 +1440,7 @@ void GameConnection::writePacket(BitStream *bstream, PacketNotify *note)
             Con::printf("SEND OBJECT SELECTION");
             bstream->writeFlag(true);
             bstream->writeFlag(true);
-            bstream->writeInt(gidx, NetConnection::GhostIdBitSize);
+            NetConnection::writeGhostIndex(bstream, gidx);
             mChangedSelectedObj = false;
          }
          // not fully changed yet
@@ -1480,7 +1483,7 @@ void GameConnection::writePacket(BitStream *bstream, PacketNotify *note)
                Con::printf("packetDataChecksum disagree! (force)");
 #endif
 
-            bstream->writeInt(gIndex, NetConnection::GhostIdBitSize);
+            NetConnection::writeGhostIndex(bstream, gIndex);
 #ifdef TORQUE_NET_STATS
             U32 beginSize = bstream->getBitPosition();
 #endif
@@ -1509,7 +1512,7 @@ void GameConnection::writePacket(BitStream *bstream, PacketNotify *note)
          gIndex = getGhostIndex(mCameraObject);
          if (bstream->writeFlag(gIndex != -1))
          {
-            bstream->writeInt(gIndex, NetConnection::GhostIdBitSize);
+            NetConnection::writeGhostIndex(bstream, gIndex);
             mCameraObject->writePacketData(this, bstream);
          }
       }
@@ -1635,6 +1638,11 @@ void GameConnection::doneScopingScene()
    // objects not visible to the camera, but visible to sensors.
 }
 
+void GameConnection::prefetchDataBlock(SimDataBlock *db)
+{
+   postNetEvent(new DataBlockPrefetchEvent(db));
+}
+
 void GameConnection::preloadDataBlock(SimDataBlock *db)
 {
    mDataBlockLoadList.push_back(db);
@@ -1683,7 +1691,13 @@ void GameConnection::preloadNextDataBlock(bool hadNewFiles)
          return;
       }
       mFilesWereDownloaded = hadNewFiles;
-      if(!object->preload(false, mErrorBuffer))
+      if(smDeferDataBlockPreload && !isLocalConnection() && object->allowDeferredPreload())
+      {
+         // Loaded when the first object using it is added, or when
+         // the server asks for it with prefetchDataBlock().
+         object->deferPreload();
+      }
+      else if(!object->preload(false, mErrorBuffer))
       {
          mFilesWereDownloaded = false;
          // make sure there's an error message if necessary
@@ -1836,6 +1850,10 @@ DefineEngineMethod( GameConnection, transmitDataBlocks, void, (S32 sequence),,
     // Set the datablock sequence.
     object->setDataBlockSequence(sequence);
 
+    // The window has to stay the same for the whole transmission as each
+    // delivered event posts the one a window ahead of it.
+    object->setDataBlockWindow(GameConnection::smDataBlockWindow);
+
     // Store a pointer to the datablock group.
     SimDataBlockGroup* pGroup = Sim::getDataBlockGroup();
 
@@ -1856,14 +1874,27 @@ DefineEngineMethod( GameConnection, transmitDataBlocks, void, (S32 sequence),,
         U8 iBuffer[16384];
         BitStream mStream(iBuffer, 16384);
 
+        // The local client shares the server's datablock instances, so
+        // datablocks it already preloaded for an earlier mission and that
+        // haven't been modified since can be skipped just like for remote
+        // clients.  If the datablocks were deleted and the keys restarted,
+        // everything is new.
+        S32 iKey = object->getDataBlockModifiedKey();
+        if (iKey > SimDataBlock::getNextModifiedKey())
+            iKey = 0;
+        object->setMaxDataBlockModifiedKey(iKey);
+
         // Iterate through all the datablocks...
         for (U32 i = 0; i < iCount; i++)
         {
             // Get a pointer to the datablock in question...
             pDataBlock = (SimDataBlock*)(*pGroup)[i];
 
+            if (pDataBlock->getModifiedKey() <= iKey)
+                continue;
+
             // Set the client's new modified key.
-            object->setMaxDataBlockModifiedKey(pDataBlock->getModifiedKey());
+            object->setMaxDataBlockModifiedKey(getMax(object->getMaxDataBlockModifiedKey(), pDataBlock->getModifiedKey()));
 
             // Pack the datablock stream.
             mStream.setPosition(0);
@@ -1929,7 +1960,7 @@ DefineEngineMethod( GameConnection, transmitDataBlocks, void, (S32 sequence),,
         object->setMaxDataBlockModifiedKey(iKey);
 
         // Get the minimum number of datablocks...
-        const U32 iMax = getMin(i + DataBlockQueueCount, iCount);
+        const U32 iMax = getMin(i + object->getDataBlockWindow(), iCount);
 
         // Iterate through the remaining datablocks...
         for (;i < iMax; i++)
@@ -2070,6 +2101,26 @@ DefineEngineMethod( GameConnection, play2D, bool, (SFXProfile* profile),,
    return true;
 }
 
+DefineEngineMethod( GameConnection, prefetchDataBlock, bool, (SimDataBlock* dataBlock),,
+   "@brief Used on the server to have the client preload a datablock before an object using it comes into scope.\n\n"
+
+   "Only has an effect on clients with $pref::Net::deferDataBlockPreload enabled.\n\n"
+
+   "@param dataBlock The datablock to preload.\n"
+   "@return True if the request was sent.\n\n"
+
+   "@tsexample\n"
+   "// Load the vehicle the client is about to be put in.\n"
+   "%client.prefetchDataBlock(CheetahCar);\n"
+   "@endtsexample\n\n")
+{
+   if(!dataBlock || dataBlock->isClientOnly())
+      return false;
+
+   object->prefetchDataBlock(dataBlock);
+   return true;
+}
+
 DefineEngineMethod( GameConnection, play3D, bool, (SFXProfile* profile, TransformF location),,
    "@brief Used on the server to play a 3D sound that is not attached to any object.\n\n"
    
@@ -2241,6 +2292,26 @@ void GameConnection::consoleInit()
 
       "@ingroup Networking\n");
 
+   Con::addVariable("$Net::dataBlockWindow", TypeS32, &smDataBlockWindow,
+      "@brief Number of datablocks the server keeps in transit while transmitting datablocks to a client.\n\n"
+
+      "Larger windows take fewer round trips to send all datablocks, which shortens mission loading "
+      "over connections with a long round trip time.  Clamped to 1 - 96.  The default value is 64.\n\n"
+
+      "@see GameConnection::transmitDataBlocks()\n\n"
+
+      "@ingroup Networking\n");
+
+   Con::addVariable("$pref::Net::deferDataBlockPreload", TypeBool, &smDeferDataBlockPreload,
+      "@brief If true, the client only preloads shape datablocks when an object using them is added.\n\n"
+
+      "This shortens mission loading and saves memory on the client for datablocks which never come into "
+      "scope, at the cost of a hitch when one first does.  The server can hide that hitch with "
+      "GameConnection::prefetchDataBlock().  Files missing on the client are not downloaded for deferred "
+      "datablocks.  The default value is false.\n\n"
+
+      "@ingroup Networking\n");
+
    // Con::addVariable("specialFog", TypeBool, &SceneGraph::useSpecial);
 
 #ifdef AFX_CAP_DATABLOCK_CACHE 
@@ -47,7 +47,8 @@
 enum GameConnectionConstants
 {
    MaxClients = 126,
-   DataBlockQueueCount = 16
+   DataBlockQueueCount = 16,   ///< Default number of datablock events in transit.
+   MaxDataBlockQueueCount = 96 ///< Stays below the guaranteed event window.
 };
 
 class IDisplayDevice;
@@ -79,6 +80,7 @@ private:
    SimObjectPtr<GameBase> mControlObject;
    SimObjectPtr<GameBase> mCameraObject;
    U32 mDataBlockSequence;
+   U32 mDataBlockWindow;         ///< Datablock events kept in transit by the current transmission.
    char mDisconnectReason[256];
 
    U32  mMissionCRC;             // crc of the current mission file from the server
@@ -328,6 +330,24 @@ public:
    /// Set the datablock sequence number.
    void setDataBlockSequence(U32 seq) { mDataBlockSequence = seq; }
 
+   /// Return the number of datablock events kept in transit while
+   /// transmitting datablocks.
+   U32 getDataBlockWindow() const { return mDataBlockWindow; }
+   void setDataBlockWindow(U32 window) { mDataBlockWindow = mClampU(window, 1, MaxDataBlockQueueCount); }
+
+   /// Number of datablock events newly started transmissions keep in transit.
+   static U32 smDataBlockWindow;
+
+   /// If set, a client connected to a remote server puts off preload() of
+   /// datablocks which allow it until an object using them is added.
+   ///
+   /// @see SimDataBlock::allowDeferredPreload()
+   static bool smDeferDataBlockPreload;
+
+   /// Asks the client to finish the deferred preload of a datablock now,
+   /// ahead of the first object using it coming into scope.
+   void prefetchDataBlock(SimDataBlock *db);
+
    /// @}
 
    /// @name Fade control
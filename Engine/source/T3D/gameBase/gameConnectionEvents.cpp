@@ -50,6 +50,7 @@ IMPLEMENT_CO_CLIENTEVENT_V1(SimDataBlockEvent);
 IMPLEMENT_CO_CLIENTEVENT_V1(Sim2DAudioEvent);
 IMPLEMENT_CO_CLIENTEVENT_V1(Sim3DAudioEvent);
 IMPLEMENT_CO_CLIENTEVENT_V1(SetMissionCRCEvent);
+IMPLEMENT_CO_CLIENTEVENT_V1(DataBlockPrefetchEvent);
 
 ConsoleDocClass( SimDataBlockEvent,
 				"@brief Use by GameConnection to process incoming datablocks.\n\n"
@@ -66,6 +67,11 @@ ConsoleDocClass( Sim3DAudioEvent,
 				"Not intended for game development, internal use only, but does expose GameConnection::play3D.\n\n "
 				"@internal");
 
+ConsoleDocClass( DataBlockPrefetchEvent,
+				"@brief Use by GameConnection to have the client preload a deferred datablock.\n\n"
+				"Not intended for game development, internal use only, but does expose GameConnection::prefetchDataBlock.\n\n "
+				"@internal");
+
 ConsoleDocClass( SetMissionCRCEvent,
 				"@brief Use by GameConnection to send a 3D sound event over the network.\n\n"
 				"Not intended for game development, internal use only, but does expose GameConnection::setMissionCRC.\n\n "
@@ -123,7 +129,7 @@ void SimDataBlockEvent::notifyDelivered(NetConnection *conn, bool )
    if(gc->getDataBlockSequence() != mMissionSequence)
       return;
 
-   U32 nextIndex = mIndex + DataBlockQueueCount;
+   U32 nextIndex = mIndex + gc->getDataBlockWindow();
    SimDataBlockGroup *g = Sim::getDataBlockGroup();
 
    if(mIndex == g->size() - 1)
@@ -284,7 +290,10 @@ void SimDataBlockEvent::process(NetConnection *cptr)
          // This is an update to an existing datablock.  Preload
          // to finish this.
 
-         mObj->preload( false, errorBuffer );
+         // A datablock still waiting on its deferred preload picks
+         // up the changes when it is finally loaded.
+         if( !mObj->isPreloadDeferred() )
+            mObj->preload( false, errorBuffer );
          mObj = NULL;
       }
    }
@@ -323,6 +332,39 @@ void Sim2DAudioEvent::process(NetConnection *)
 
 //----------------------------------------------------------------------------
 
+DataBlockPrefetchEvent::DataBlockPrefetchEvent(SimDataBlock *dataBlock)
+{
+   mDataBlock = dataBlock;
+}
+
+void DataBlockPrefetchEvent::pack(NetConnection *, BitStream *bstream)
+{
+   bstream->writeInt( mDataBlock->getId() - DataBlockObjectIdFirst, DataBlockObjectIdBitSize);
+}
+
+void DataBlockPrefetchEvent::write(NetConnection *, BitStream *bstream)
+{
+   bstream->writeInt( mDataBlock->getId() - DataBlockObjectIdFirst, DataBlockObjectIdBitSize);
+}
+
+void DataBlockPrefetchEvent::unpack(NetConnection *, BitStream *bstream)
+{
+   SimObjectId id = bstream->readInt(DataBlockObjectIdBitSize) + DataBlockObjectIdFirst;
+   Sim::findObject(id, mDataBlock);
+}
+
+void DataBlockPrefetchEvent::process(NetConnection *)
+{
+   if (!mDataBlock)
+      return;
+
+   String errorStr;
+   if (!mDataBlock->finishDeferredPreload(errorStr))
+      Con::errorf("DataBlockPrefetchEvent - preload of datablock %s failed: %s", mDataBlock->getName(), errorStr.c_str());
+}
+
+//----------------------------------------------------------------------------
+
 static F32 SoundPosAccuracy = 0.5;
 static S32 SoundRotBits = 8;
 
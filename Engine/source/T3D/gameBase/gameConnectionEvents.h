@@ -134,6 +134,23 @@ class Sim3DAudioEvent: public NetEvent
 };
 
 
+/// Sent by GameConnection::prefetchDataBlock() to finish the deferred preload
+/// of a datablock on the client.
+class DataBlockPrefetchEvent : public NetEvent
+{
+  private:
+   SimDataBlock *mDataBlock;
+
+  public:
+   typedef NetEvent Parent;
+   DataBlockPrefetchEvent(SimDataBlock *dataBlock = NULL);
+   void pack(NetConnection *, BitStream *bstream);
+   void write(NetConnection *, BitStream *bstream);
+   void unpack(NetConnection *, BitStream *bstream);
+   void process(NetConnection *);
+   DECLARE_CONOBJECT(DataBlockPrefetchEvent);
+};
+
 //----------------------------------------------------------------------------
 // used to set the crc for the current mission (mission lighting)
 //----------------------------------------------------------------------------
@@ -27,6 +27,11 @@
 #include "T3D/gameBase/gameBase.h"
 #include "T3D/gameBase/gameConnection.h"
 #include "T3D/gameBase/moveList.h"
+#include "T3D/gameBase/lagCompensation.h"
+#include "T3D/gameBase/simulationLOD.h"
+#include "T3D/aiSensing.h"
+#include "collision/collisionStats.h"
+#include "scene/sceneContainer.h"
 
 //----------------------------------------------------------------------------
 
@@ -128,6 +133,13 @@ void ClientProcessList::onPreTickObject( ProcessObject *pobj )
    pobj->interpolateTick( 0.0f );
 }
 
+void ClientProcessList::advanceObjects()
+{
+   CollisionStats::beginTick( false );
+
+   Parent::advanceObjects();
+}
+
 
 //--------------------------------------------------------------------------
 // ServerProcessList
@@ -172,8 +184,26 @@ void ServerProcessList::advanceObjects()
    Con::printf("Advance server time...");
    #endif
 
+   // Let objects check scene queries they ran in ProcessObject::prepareTick()
+   // against what objects ticking before them changed.
+   if ( smParallelTick )
+      gServerContainer.beginChangeLog();
+
+   // Find the client cameras for the rigid body simulation LOD.
+   SimulationLOD::beginTick();
+
+   CollisionStats::beginTick( true );
+
    Parent::advanceObjects();
 
+   gServerContainer.endChangeLog();
+
+   // Batch the AI line of sight checks of this tick.
+   AISensing::processTick();
+
+   // mLastTick is the start of the tick that was just run.
+   LagCompensation::recordTick( mLastTick + TickMs );
+
    #ifdef TORQUE_DEBUG_NET_MOVES
    Con::printf("---------");
    #endif
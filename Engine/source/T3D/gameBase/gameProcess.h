@@ -58,6 +58,7 @@ protected:
    
    // ProcessList
    void onPreTickObject( ProcessObject *pobj );
+   void advanceObjects();
 
    /// Returns true if backlogged.
    bool doBacklogged( SimTime timeDelta );
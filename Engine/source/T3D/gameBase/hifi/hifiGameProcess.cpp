@@ -30,6 +30,7 @@
 #include "T3D/gameBase/hifi/hifiMoveList.h"
 #include "T3D/gameBase/gameConnection.h"
 #include "T3D/gameFunctions.h"
+#include "console/consoleTypes.h"
 
 
 MODULE_BEGIN( ProcessList )
@@ -48,6 +49,16 @@ MODULE_BEGIN( ProcessList )
 
 MODULE_END;
 
+AFTER_MODULE_INIT( Sim )
+{
+   Con::addVariable( "$Net::hifiCatchupBudget", TypeS32, &HifiClientProcessList::smCatchupBudget,
+      "@brief Most ticks a hifi object other than the control object is rolled back and replayed "
+      "by on the client when the server corrects it.\n\n"
+      "Objects that would need more are left at the corrected state and smoothed like regular ghosts "
+      "instead.  0 means no limit, which is the default.\n"
+      "@ingroup Networking" );
+}
+
 void HifiServerProcessList::init()
 {
    smServerProcessList = new HifiServerProcessList();
@@ -72,6 +83,8 @@ void HifiClientProcessList::shutdown()
 
 F32 gMaxHiFiVelSq = 100 * 100;
 
+U32 HifiClientProcessList::smCatchupBudget = 0;
+
 namespace
 {
    inline GameBase * GetGameBase(ProcessObject * obj)
@@ -264,8 +277,7 @@ void HifiClientProcessList::onTickObject(ProcessObject * pobj)
    {
       GameConnection * serverConnection = GameConnection::getConnectionToServer();
       TickCacheEntry * tce = obj->getTickCache().addCacheEntry();
-      BitStream bs( tce->packetData, TickCacheEntry::MaxPacketSize );
-      obj->writePacketData( serverConnection, &bs );
+      tce->store( obj, serverConnection );
 
       Point3F vel = obj->getVelocity();
       F32 velSq = mDot( vel, vel );
@@ -396,10 +408,12 @@ void HifiClientProcessList::clientCatchup(GameConnection * connection)
                         // better add obj2
                         obj2->getTickCache().beginCacheList();
                         TickCacheEntry * tce = obj2->getTickCache().incCacheList();
-                        BitStream bs(tce->packetData,TickCacheEntry::MaxPacketSize);
-                        obj2->readPacketData(connection,&bs);
+                        tce->restore(obj2,connection);
                         obj2->setGhostUpdated(true);
 
+                        // reset to exactly what we predicted for it
+                        obj2->setPredictionMatched(true);
+
                         // continue so we later add the neighbors too
                         continue;
                      }
@@ -421,7 +435,9 @@ void HifiClientProcessList::clientCatchup(GameConnection * connection)
    FrameAllocatorMarker mark;
 
    // build ordered list of client objects which need to be caught up
+   // -- note whether all of them were merely confirmed by the server
    GameBaseListNode list;
+   bool allMatched = !mForceHifiReset;
    for (pobj = mHead.mProcessLink.next; pobj != &mHead; pobj = pobj->mProcessLink.next)
    {
       GameBase *obj = getGameBase( pobj );
@@ -432,8 +448,19 @@ void HifiClientProcessList::clientCatchup(GameConnection * connection)
       if ( !obj )
          continue;
 
-      if (obj->isGhostUpdated() && (obj->getTypeMask() & GameBaseHiFiObjectType))
+      if (obj->isGhostUpdated() && (obj->getTypeMask() & GameBaseHiFiObjectType) &&
+          smCatchupBudget && mCatchup > smCatchupBudget && !mForceHifiReset &&
+          obj != connection->getControlObject() && !obj->isPredictionMatched())
       {
+         // over its rollback budget -- keep the corrected state without
+         // replaying and smooth towards it like a regular ghost
+         obj->computeNetSmooth(mLastDelta);
+      }
+      else if (obj->isGhostUpdated() && (obj->getTypeMask() & GameBaseHiFiObjectType))
+      {
+         if (!obj->isPredictionMatched())
+            allMatched = false;
+
          // construct process object and add it to the list
          // hold pointer to our object in mAfterObject
          GameBaseListNode * po = (GameBaseListNode*)FrameAllocator::alloc(sizeof(GameBaseListNode));
@@ -449,8 +476,7 @@ void HifiClientProcessList::clientCatchup(GameConnection * connection)
          // add all hifi objects
          obj->getTickCache().beginCacheList();
          TickCacheEntry * tce = obj->getTickCache().incCacheList();
-         BitStream bs(tce->packetData,TickCacheEntry::MaxPacketSize);
-         obj->readPacketData(connection,&bs);
+         tce->restore(obj,connection);
          obj->setGhostUpdated(true);
 
          // construct process object and add it to the list
@@ -467,6 +493,9 @@ void HifiClientProcessList::clientCatchup(GameConnection * connection)
          GameBaseListNode * po = (GameBaseListNode*)FrameAllocator::alloc(sizeof(GameBaseListNode));
          po->mObject = obj;
          po->linkBefore(&list);
+
+         // no snapshots to restore from, so this always needs a full replay
+         allMatched = false;
       }
       else if (obj->isGhostUpdated())
       {
@@ -477,6 +506,7 @@ void HifiClientProcessList::clientCatchup(GameConnection * connection)
       // clear out work flags
       obj->setNetNearbyAdded(false);
       obj->setGhostUpdated(false);
+      obj->setPredictionMatched(false);
    }
 
    // run through all the moves in the move list so we can play them with our control object
@@ -486,8 +516,28 @@ void HifiClientProcessList::clientCatchup(GameConnection * connection)
    connection->mMoveList->getMoves(&movePtr, &numMoves);
    AssertFatal(mCatchup<=numMoves,"doh");
 
+   // If the server confirmed every state we predicted, replaying all the moves
+   // would only get us back to where we were.  Restore the snapshots from the
+   // second to last tick instead and replay just the last one, which also gets
+   // the objects' interpolation state right again.
+   U32 firstTick = 0;
+   if (allMatched && mCatchup > 0)
+   {
+      firstTick = mCatchup-1;
+      for (GameBaseListNode * walk = list.mNext; walk != &list; walk = walk->mNext)
+      {
+         GameBase * obj = walk->mObject;
+         obj->getTickCache().beginCacheList();
+         TickCacheEntry * tce = NULL;
+         for (U32 m=0; m<=firstTick; m++)
+            tce = obj->getTickCache().incCacheList();
+         tce->restore(obj,connection);
+      }
+      movePtr += firstTick;
+   }
+
    // tick catchup time
-   for (U32 m=0; m<mCatchup; m++)
+   for (U32 m=firstTick; m<mCatchup; m++)
    {
       for (GameBaseListNode * walk = list.mNext; walk != &list; walk = walk->mNext)
       {
@@ -516,10 +566,7 @@ void HifiClientProcessList::clientCatchup(GameConnection * connection)
          }
 
          if (hifi)
-         {
-            BitStream bs(tce->packetData,TickCacheEntry::MaxPacketSize);
-            obj->writePacketData(connection,&bs);
-         }
+            tce->store(obj,connection);
       }
       if (connection->getControlObject() == NULL)
          movePtr++;
@@ -47,6 +47,10 @@ public:
    static void init();
    static void shutdown();
 
+   /// Most ticks a hifi object other than the control object gets rolled back
+   /// and replayed by when corrected.  0 for no limit.
+   static U32 smCatchupBudget;
+
 protected:
 
    // tick cache functions -- client only
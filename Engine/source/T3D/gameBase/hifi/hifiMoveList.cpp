@@ -134,10 +134,13 @@ void HifiMoveList::markControlDirty()
    GameBase *obj = mConnection->getControlObject();
    AssertFatal(obj,"ClientProcessList::markControlDirty: no control object");
    obj->setGhostUpdated(true);
+
+   // the server only sends control object state when it disagrees with us
+   obj->setPredictionMatched(false);
+
    obj->getTickCache().beginCacheList();
    TickCacheEntry * tce = obj->getTickCache().incCacheList();
-   BitStream bs(tce->packetData,TickCacheEntry::MaxPacketSize);
-   obj->writePacketData( mConnection, &bs );
+   tce->store(obj, mConnection);
 }
 
 void HifiMoveList::resetMoveList()
@@ -413,10 +416,7 @@ void HifiMoveList::ghostPreRead(NetObject * nobj, bool newGhost)
       // reset to old state because we are about to unpack (and then tick forward)
       TickCacheEntry * tce = obj->getTickCache().incCacheList(false);
       if (tce)
-      {
-         BitStream bs(tce->packetData,TickCacheEntry::MaxPacketSize);
-         obj->readPacketData(mConnection, &bs);
-      }
+         tce->restore(obj, mConnection);
    }
 }
 
@@ -435,9 +435,13 @@ void HifiMoveList::ghostReadExtra(NetObject * nobj, BitStream * bstream, bool ne
       // set next cache entry to start
       obj->getTickCache().beginCacheList();
 
-      // save state for future update
+      // the entry still holds the state we predicted for this tick and were
+      // reset to in ghostPreRead -- if the update left it unchanged, catchup
+      // does not need to replay our moves
       TickCacheEntry * tce = obj->getTickCache().incCacheList();
-      BitStream bs(tce->packetData,TickCacheEntry::MaxPacketSize);
-      obj->writePacketData(mConnection, &bs);
+      obj->setPredictionMatched(!newGhost && tce->matches(obj, mConnection));
+
+      // save state for future update
+      tce->store(obj, mConnection);
    }
 }
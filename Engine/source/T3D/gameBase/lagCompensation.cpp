@@ -0,0 +1,253 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "T3D/gameBase/lagCompensation.h"
+
+#include "T3D/gameBase/gameBase.h"
+#include "T3D/gameBase/gameConnection.h"
+#include "T3D/gameBase/gameProcess.h"
+#include "T3D/gameBase/transformHistory.h"
+#include "scene/sceneContainer.h"
+#include "collision/collision.h"
+#include "console/consoleTypes.h"
+#include "console/engineAPI.h"
+#include "core/module.h"
+#include "platform/profiler.h"
+
+
+namespace LagCompensation
+{
+   bool smEnabled = true;
+   U32 smTypeMask = PlayerObjectType | VehicleObjectType;
+   U32 smMaxRewind = 500;
+
+   /// Objects that have a transform history.
+   static Vector< GameBase* > sObjects;
+}
+
+AFTER_MODULE_INIT( Sim )
+{
+   Con::addVariable( "$Net::lagCompensation", TypeBool, &LagCompensation::smEnabled,
+      "@brief Whether server objects keep a short history of their transforms for lag compensated hit checks.\n\n"
+      "@see containerRayCastRewound()\n"
+      "@ingroup Networking" );
+
+   Con::addVariable( "$Net::lagCompensationTypeMask", TypeS32, &LagCompensation::smTypeMask,
+      "@brief Type mask of the objects that keep a transform history for lag compensation.\n\n"
+      "Defaults to players and vehicles.\n"
+      "@ingroup Networking" );
+
+   Con::addVariable( "$Net::lagCompensationMaxRewind", TypeS32, &LagCompensation::smMaxRewind,
+      "@brief Furthest back in milliseconds lag compensated hit checks may rewind.\n\n"
+      "Clients with a longer round trip time are compensated for this much only.  Transform "
+      "histories cover a little over one second.  The default value is 500.\n"
+      "@ingroup Networking" );
+}
+
+//-----------------------------------------------------------------------------
+
+void LagCompensation::recordTick( SimTime time )
+{
+   if ( !smEnabled )
+      return;
+
+   PROFILE_SCOPE( LagCompensation_recordTick );
+
+   Vector< SceneObject* > objects;
+   gServerContainer.findObjectList( smTypeMask, &objects );
+
+   for ( U32 i = 0; i < objects.size(); i++ )
+   {
+      GameBase *obj = dynamic_cast< GameBase* >( objects[ i ] );
+      if ( !obj || !obj->isServerObject() )
+         continue;
+
+      TransformHistory *history = obj->getTransformHistory();
+      if ( !history )
+      {
+         history = obj->getTransformHistory( true );
+         sObjects.push_back( obj );
+      }
+
+      history->record( time, obj->getTransform() );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void LagCompensation::removeObject( GameBase *obj )
+{
+   sObjects.remove( obj );
+}
+
+//-----------------------------------------------------------------------------
+
+SimTime LagCompensation::getViewTime( GameConnection *conn )
+{
+   // The client shows other objects interpolated a tick behind the last
+   // update it got, which was half a round trip old, and its move takes
+   // another half round trip to get here.
+
+   const SimTime now = ServerProcessList::get()->getLastTime();
+   const U32 rewind = getMin( U32( conn->getRoundTripTime() ) + TickMs, smMaxRewind );
+
+   return now > rewind ? now - rewind : 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void LagCompensation::getTransform( GameBase *obj, SimTime time, MatrixF *outMat )
+{
+   const TransformHistory *history = obj->getTransformHistory();
+   if ( !smEnabled || !history || !history->getTransform( time, outMat ) )
+      *outMat = obj->getTransform();
+}
+
+//-----------------------------------------------------------------------------
+
+bool LagCompensation::castRay( SceneContainer *container, SimTime time, const Point3F &start, const Point3F &end, U32 mask, RayInfo *info )
+{
+   PROFILE_SCOPE( LagCompensation_castRay );
+
+   // Everything that is not rewound goes through the container as usual.
+
+   const U32 rewoundMask = smEnabled ? mask & smTypeMask : 0;
+   bool hit = container->castRay( start, end, mask & ~rewoundMask, info );
+   if ( !rewoundMask )
+      return hit;
+
+   F32 currentT = hit ? info->t : 2.0f;
+
+   for ( U32 i = 0; i < sObjects.size(); i++ )
+   {
+      GameBase *obj = sObjects[ i ];
+      if ( !( obj->getTypeMask() & rewoundMask ) || !obj->isCollisionEnabled() || obj->getContainer() != container )
+         continue;
+
+      MatrixF mat;
+      getTransform( obj, time, &mat );
+
+      const Point3F &scale = obj->getScale();
+
+      Box3F worldBox = obj->getObjBox();
+      worldBox.scale( scale );
+      mat.mul( worldBox );
+      if ( !worldBox.collideLine( start, end ) )
+         continue;
+
+      MatrixF worldToObj = mat;
+      worldToObj.inverse();
+
+      Point3F xformedStart, xformedEnd;
+      worldToObj.mulP( start, &xformedStart );
+      worldToObj.mulP( end, &xformedEnd );
+      xformedStart.convolveInverse( scale );
+      xformedEnd.convolveInverse( scale );
+
+      RayInfo ri;
+      ri.generateTexCoord = info->generateTexCoord;
+      if ( !obj->castRay( xformedStart, xformedEnd, &ri ) || ri.t >= currentT )
+         continue;
+
+      // Bump the normal into worldspace with the rewound transform.
+      PlaneF fakePlane;
+      fakePlane.x = ri.normal.x;
+      fakePlane.y = ri.normal.y;
+      fakePlane.z = ri.normal.z;
+      fakePlane.d = 0;
+
+      PlaneF result;
+      mTransformPlane( mat, scale, fakePlane, &result );
+
+      *info = ri;
+      info->normal = result;
+      info->point.interpolate( start, end, ri.t );
+      info->distance = ( start - info->point ).len();
+      currentT = ri.t;
+      hit = true;
+   }
+
+   return hit;
+}
+
+//-----------------------------------------------------------------------------
+
+DefineEngineMethod( GameConnection, getLagCompensationTime, S32, (),,
+   "@brief On the server, return the time this client was seeing other objects at when it sent "
+   "the move being processed.\n\n"
+
+   "Pass this to containerRayCastRewound() to check hits against what the client saw.\n\n"
+
+   "@see $Net::lagCompensationMaxRewind\n")
+{
+   return LagCompensation::getViewTime( object );
+}
+
+DefineEngineFunction( containerRayCastRewound, const char*,
+   ( Point3F start, Point3F end, U32 mask, S32 time, SceneObject *pExempt ), ( nullAsType<SceneObject*>() ),
+   "@brief On the server, cast a ray from start to end with lag compensated objects rewound to the given time.\n\n"
+
+   "Works like containerRayCast() in the server container, except that objects matching "
+   "$Net::lagCompensationTypeMask are tested where they were at @a time.\n\n"
+
+   "@param start An XYZ vector containing the tail position of the ray.\n"
+   "@param end An XYZ vector containing the head position of the ray\n"
+   "@param mask A bitmask corresponding to the type of objects to check for\n"
+   "@param time Server time to rewind to, usually from GameConnection::getLagCompensationTime().\n"
+   "@param pExempt An optional ID for a single object that ignored for this raycast\n"
+
+   "@returns A string containing either null, if nothing was struck, or these fields:\n"
+   "<ul><li>The ID of the object that was struck.</li>"
+   "<li>The x, y, z position that it was struck.</li>"
+   "<li>The x, y, z of the normal of the face that was struck.</li>"
+   "<li>The distance between the start point and the position we hit.</li></ul>"
+
+   "@ingroup Game")
+{
+   if ( pExempt )
+      pExempt->disableCollision();
+
+   RayInfo rinfo;
+   S32 ret = 0;
+   if ( LagCompensation::castRay( &gServerContainer, SimTime( getMax( time, 0 ) ), start, end, mask, &rinfo ) )
+      ret = rinfo.object->getId();
+
+   if ( pExempt )
+      pExempt->enableCollision();
+
+   static const U32 bufSize = 256;
+   char *returnBuffer = Con::getReturnBuffer( bufSize );
+   if ( ret )
+   {
+      dSprintf( returnBuffer, bufSize, "%d %g %g %g %g %g %g %g",
+               ret, rinfo.point.x, rinfo.point.y, rinfo.point.z,
+               rinfo.normal.x, rinfo.normal.y, rinfo.normal.z, rinfo.distance );
+   }
+   else
+   {
+      returnBuffer[ 0 ] = '0';
+      returnBuffer[ 1 ] = '\0';
+   }
+
+   return returnBuffer;
+}
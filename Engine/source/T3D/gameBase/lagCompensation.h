@@ -0,0 +1,79 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _LAGCOMPENSATION_H_
+#define _LAGCOMPENSATION_H_
+
+#ifndef _MPOINT3_H_
+#include "math/mPoint3.h"
+#endif
+#ifndef _SIMBASE_H_
+#include "console/simBase.h"
+#endif
+
+class GameBase;
+class GameConnection;
+class SceneContainer;
+struct RayInfo;
+class MatrixF;
+
+
+/// Server side lag compensation for hit detection.
+///
+/// At the end of every server tick, each GameBase matching #smTypeMask
+/// records its transform in its TransformHistory.  Hit checks can then be
+/// run against where those objects were at the time a client saw them
+/// rather than where they are now: castRay() tests the ray against the
+/// rewound objects in their own object space and against everything else
+/// through the container as usual.  Objects are never actually moved.
+namespace LagCompensation
+{
+   /// Whether server objects record transform histories.
+   extern bool smEnabled;
+
+   /// Type mask of the objects that record transform histories.
+   extern U32 smTypeMask;
+
+   /// Furthest back in milliseconds a query may rewind.
+   extern U32 smMaxRewind;
+
+   /// Record the transforms of all objects in the server process list at
+   /// the end of the tick ending at @a time.
+   void recordTick( SimTime time );
+
+   /// Stop tracking @a obj.  Called when it is removed.
+   void removeObject( GameBase *obj );
+
+   /// Return the server time the client on @a conn was seeing when it
+   /// sent the move the server is processing now.
+   SimTime getViewTime( GameConnection *conn );
+
+   /// Return the transform @a obj had at @a time or its current transform
+   /// if it has no history.
+   void getTransform( GameBase *obj, SimTime time, MatrixF *outMat );
+
+   /// Cast a ray through @a container with all tracked objects rewound to
+   /// @a time.  Objects with collision disabled are skipped as usual.
+   bool castRay( SceneContainer *container, SimTime time, const Point3F &start, const Point3F &end, U32 mask, RayInfo *info );
+}
+
+#endif // _LAGCOMPENSATION_H_
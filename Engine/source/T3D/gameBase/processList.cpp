@@ -30,15 +30,41 @@
 
 #include "T3D/gameBase/gameBase.h"
 #include "platform/profiler.h"
+#include "platform/threads/jobSystem.h"
 #include "console/consoleTypes.h"
+#include "core/module.h"
 
 #include "T3D/components/coreInterfaces.h"
 #include "T3D/components/component.h"
+
+bool ProcessList::smParallelTick = false;
+U32 ProcessList::smParallelTickMinObjects = 256;
+
+/// Tag for marking the objects of the list currently being grouped into islands.
+static U32 sgIslandTag = 0;
+
+MODULE_BEGIN( ProcessList )
+
+   MODULE_INIT
+   {
+      Con::addVariable( "$ProcessList::parallelTick", TypeBool, &ProcessList::smParallelTick,
+         "If true, independent groups of objects that support it are ticked in parallel.\n"
+         "@ingroup GameBase\n" );
+
+      Con::addVariable( "$ProcessList::parallelTickMinObjects", TypeS32, &ProcessList::smParallelTickMinObjects,
+         "Minimum number of objects in a process list for parallel ticking to be used.\n"
+         "@ingroup GameBase\n" );
+   }
+
+MODULE_END;
+
 //----------------------------------------------------------------------------
 
 ProcessObject::ProcessObject()
  : mProcessTag( 0 ),   
    mOrderGUID( 0 ),
+   mIslandTag( 0 ),
+   mIslandIndex( 0 ),
    mProcessTick( false ),
    mIsGameBase( false )
 { 
@@ -267,12 +293,16 @@ void ProcessList::advanceObjects()
    ProcessObject list;
    list.plLinkBefore(mHead.mProcessLink.next);
    mHead.plUnlink();
+
+   const bool tickedParallel = smParallelTick && _tickIslandsParallel(list);
+
    for (ProcessObject * pobj = list.mProcessLink.next; pobj != &list; pobj = list.mProcessLink.next)
    {
       pobj->plUnlink();
       pobj->plLinkBefore(&mHead);
       
-      onTickObject(pobj);
+      if (!tickedParallel || !mTickParallel[pobj->mIslandIndex])
+         onTickObject(pobj);
    }
 
    for (U32 i = 0; i < UpdateInterface::all.size(); i++)
@@ -285,6 +315,175 @@ void ProcessList::advanceObjects()
    PROFILE_END();
 }
 
+//----------------------------------------------------------------------------
+
+U32 ProcessList::_findIsland( U32 index )
+{
+   while( mTickIslandParent[ index ] != index )
+   {
+      // Path halving.
+      mTickIslandParent[ index ] = mTickIslandParent[ mTickIslandParent[ index ] ];
+      index = mTickIslandParent[ index ];
+   }
+   return index;
+}
+
+bool ProcessList::_tickIslandsParallel( ProcessObject& list )
+{
+   PROFILE_SCOPE( ProcessList_TickIslandsParallel );
+
+   if( ++ sgIslandTag == 0 )
+      sgIslandTag ++;
+   const U32 tag = sgIslandTag;
+
+   mTickObjects.clear();
+   for( ProcessObject* pobj = list.mProcessLink.next; pobj != &list; pobj = pobj->mProcessLink.next )
+   {
+      pobj->mIslandTag = tag;
+      pobj->mIslandIndex = mTickObjects.size();
+      mTickObjects.push_back( pobj );
+   }
+
+   const U32 numObjects = mTickObjects.size();
+   if( numObjects < smParallelTickMinObjects )
+      return false;
+
+   // Nothing has moved yet, so let all objects do their read-only tick
+   // preparation at once.
+
+   JobSystem::GLOBAL().parallelFor( numObjects, 16, &_prepareTickJob, this );
+
+   // Union objects with the objects they process after and are mounted to.
+   // Links to objects outside of this list are dropped.
+
+   mTickIslandParent.setSize( numObjects );
+   for( U32 i = 0; i < numObjects; ++ i )
+      mTickIslandParent[ i ] = i;
+
+   for( U32 i = 0; i < numObjects; ++ i )
+   {
+      ProcessObject* pobj = mTickObjects[ i ];
+
+      ProcessObject* linked[ 2 ];
+      linked[ 0 ] = pobj->getAfterObject();
+      linked[ 1 ] = NULL;
+
+      GameBase* gameBase = getGameBase( pobj );
+      if( gameBase && gameBase->getObjectMount() )
+         linked[ 1 ] = dynamic_cast< GameBase* >( gameBase->getObjectMount() );
+
+      for( U32 n = 0; n < 2; ++ n )
+      {
+         if( !linked[ n ] || linked[ n ]->mIslandTag != tag )
+            continue;
+
+         const U32 a = _findIsland( i );
+         const U32 b = _findIsland( linked[ n ]->mIslandIndex );
+
+         // Keep the earliest object as the root so island order follows list order.
+         if( a < b )
+            mTickIslandParent[ b ] = a;
+         else if( b < a )
+            mTickIslandParent[ a ] = b;
+      }
+   }
+
+   // An island can only go parallel if all of its objects allow it.
+
+   mTickParallel.setSize( numObjects );
+   for( U32 i = 0; i < numObjects; ++ i )
+      mTickParallel[ i ] = true;
+
+   for( U32 i = 0; i < numObjects; ++ i )
+      if( !mTickObjects[ i ]->isParallelTickSafe() )
+         mTickParallel[ _findIsland( i ) ] = false;
+
+   for( U32 i = 0; i < numObjects; ++ i )
+      mTickParallel[ i ] = mTickParallel[ _findIsland( i ) ];
+
+   // Lay out the parallel islands.  Since every root is the first object of
+   // its island, islands come out ordered by their first object and objects
+   // within an island stay in list order.  That makes the outcome independent
+   // from how the islands get scheduled.
+
+   mTickIslandStart.clear();
+   mTickIslandObjects.clear();
+
+   Vector< U32 > islandOfRoot( __FILE__, __LINE__ );
+   islandOfRoot.setSize( numObjects );
+
+   Vector< U32 > islandSize( __FILE__, __LINE__ );
+
+   for( U32 i = 0; i < numObjects; ++ i )
+   {
+      if( !mTickParallel[ i ] )
+         continue;
+
+      const U32 root = _findIsland( i );
+      if( root == i )
+      {
+         islandOfRoot[ i ] = islandSize.size();
+         islandSize.push_back( 0 );
+      }
+      islandSize[ islandOfRoot[ root ] ] ++;
+   }
+
+   const U32 numIslands = islandSize.size();
+   if( !numIslands )
+      return false;
+
+   mTickIslandStart.setSize( numIslands + 1 );
+   U32 offset = 0;
+   for( U32 i = 0; i < numIslands; ++ i )
+   {
+      mTickIslandStart[ i ] = offset;
+      offset += islandSize[ i ];
+      islandSize[ i ] = mTickIslandStart[ i ];
+   }
+   mTickIslandStart[ numIslands ] = offset;
+
+   mTickIslandObjects.setSize( offset );
+   for( U32 i = 0; i < numObjects; ++ i )
+      if( mTickParallel[ i ] )
+         mTickIslandObjects[ islandSize[ islandOfRoot[ _findIsland( i ) ] ] ++ ] = mTickObjects[ i ];
+
+   JobSystem::GLOBAL().parallelFor( numIslands, 1, &_tickIslandJob, this );
+
+   return true;
+}
+
+void ProcessList::_prepareTickJob( void* data, U32 start, U32 end )
+{
+   ProcessList* list = reinterpret_cast< ProcessList* >( data );
+
+   const U32 mathState = Platform::getMathControlState();
+   Platform::setMathControlStateKnown();
+
+   for( U32 i = start; i < end; ++ i )
+      list->mTickObjects[ i ]->prepareTick();
+
+   Platform::setMathControlState( mathState );
+}
+
+void ProcessList::_tickIslandJob( void* data, U32 start, U32 end )
+{
+   ProcessList* list = reinterpret_cast< ProcessList* >( data );
+
+   // Ticks must run in the same FPU state on every thread or results
+   // (and thus move checksums) will differ.
+   const U32 mathState = Platform::getMathControlState();
+   Platform::setMathControlStateKnown();
+
+   for( U32 island = start; island < end; ++ island )
+   {
+      const U32 islandEnd = list->mTickIslandStart[ island + 1 ];
+      for( U32 i = list->mTickIslandStart[ island ]; i < islandEnd; ++ i )
+         list->onTickObject( list->mTickIslandObjects[ i ] );
+   }
+
+   Platform::setMathControlState( mathState );
+}
+
 ProcessObject* ProcessList::findNearestToEnd(Vector<ProcessObject*>& objs) const
 {
    if (objs.empty())
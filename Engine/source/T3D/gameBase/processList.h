@@ -115,6 +115,26 @@ public:
    /// This is only called for the control object on the client-side.
    virtual void preprocessMove( Move *move ) {}
 
+   /// Return true if processTick() of this object may run concurrently with
+   /// the ticks of other objects.
+   ///
+   /// When ProcessList::smParallelTick is enabled, objects are grouped into
+   /// islands of objects linked through processAfter() and mounting.  Islands
+   /// made up entirely of objects returning true here are ticked in parallel
+   /// on the JobSystem.  Such objects must only touch state of their own
+   /// island during their tick, so no script callbacks, object creation or
+   /// deletion, or container modification.
+   virtual bool isParallelTickSafe() const { return false; }
+
+   /// Called on the JobSystem for all objects of the list before they tick
+   /// when ProcessList::smParallelTick is enabled.
+   ///
+   /// Objects can use this to run expensive read-only work for their next
+   /// processTick() concurrently, like scene queries.  Nothing is modified
+   /// while this runs, but objects ticking earlier may change the scene, so
+   /// processTick() must validate the results before using them.
+   virtual void prepareTick() {}
+
 //protected:
 
    struct Link
@@ -133,6 +153,9 @@ public:
    U32 mOrderGUID;                        // UID for keeping order synced (e.g., across network or runs of sim)
    Link mProcessLink;                     // Ordered process queue
 
+   U32 mIslandTag;                        // Tag used while building tick islands
+   U32 mIslandIndex;                      // Index into ProcessList::mTickObjects
+
    bool mProcessTick;
 
    bool mIsGameBase;
@@ -169,11 +192,30 @@ public:
    /// Returns true if a tick was processed.
    virtual bool advanceTime( SimTime timeDelta );
 
+   /// If true, advanceObjects() runs ProcessObject::prepareTick() of all
+   /// objects and then ticks independent islands of objects that are
+   /// ProcessObject::isParallelTickSafe() on the JobSystem before ticking
+   /// the remaining objects serially in list order.
+   static bool smParallelTick;
+
+   /// Minimum number of objects in the list for parallel ticking to be used.
+   static U32 smParallelTickMinObjects;
+
 protected:
  
    void orderList();
    GameBase* getGameBase( ProcessObject *obj );
 
+   /// Prepare the ticks of the objects in @a list, then group them into
+   /// islands and tick the islands that allow it in parallel.
+   /// @return False if nothing was ticked in parallel.
+   bool _tickIslandsParallel( ProcessObject& list );
+
+   U32 _findIsland( U32 index );
+
+   static void _prepareTickJob( void* data, U32 start, U32 end );
+   static void _tickIslandJob( void* data, U32 start, U32 end );
+
    virtual void advanceObjects();
    virtual void onAdvanceObjects() { advanceObjects(); }
    virtual void onPreTickObject( ProcessObject* ) {}
@@ -193,6 +235,26 @@ protected:
 
    PreTickSignal mPreTick;
    PostTickSignal mPostTick;
+
+   /// @name Parallel Ticking
+   /// Scratch data of _tickIslandsParallel().
+   /// @{
+
+   Vector< ProcessObject* > mTickObjects;
+
+   /// Union-find parent of each entry in #mTickObjects.
+   Vector< U32 > mTickIslandParent;
+
+   /// Whether each entry in #mTickObjects was ticked in parallel.
+   Vector< bool > mTickParallel;
+
+   /// Objects of all parallel islands, grouped by island in list order.
+   Vector< ProcessObject* > mTickIslandObjects;
+
+   /// Start of each parallel island in #mTickIslandObjects plus an end marker.
+   Vector< U32 > mTickIslandStart;
+
+   /// @}
    // JTF: still needed?
 public:
    ProcessObject* findNearestToEnd(Vector<ProcessObject*>& objs) const;
@@ -0,0 +1,172 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "T3D/gameBase/simulationLOD.h"
+
+#include "T3D/gameBase/gameBase.h"
+#include "T3D/gameBase/gameConnection.h"
+#include "scene/sceneManager.h"
+#include "console/consoleTypes.h"
+#include "core/module.h"
+#include "platform/profiler.h"
+
+
+namespace SimulationLOD
+{
+   bool smEnabled = true;
+   F32 smReducedDistance = 150.0f;
+   U32 smReducedTickInterval = 4;
+   F32 smSuspendDistance = 0.0f;
+
+   struct View
+   {
+      Point3F position;
+      F32 suspendDistSq;
+   };
+
+   /// The client cameras gathered in beginTick().
+   static Vector< View > sViews;
+
+   /// Server ticks since startup used to stagger reduced rate objects.
+   static U32 sTickCount = 0;
+}
+
+AFTER_MODULE_INIT( Sim )
+{
+   Con::addVariable( "$Server::simulationLOD", TypeBool, &SimulationLOD::smEnabled,
+      "@brief Whether rigid bodies far from every client camera are simulated at a reduced rate or suspended on the server.\n\n"
+      "@ingroup Physics" );
+
+   Con::addVariable( "$Server::simulationLODReducedDistance", TypeF32, &SimulationLOD::smReducedDistance,
+      "@brief Distance from the closest client camera beyond which rigid bodies simulate at a reduced rate.\n\n"
+      "The default value is 150.\n"
+      "@ingroup Physics" );
+
+   Con::addVariable( "$Server::simulationLODReducedTickInterval", TypeS32, &SimulationLOD::smReducedTickInterval,
+      "@brief Number of ticks between simulation steps of rigid bodies at reduced rate.\n\n"
+      "The skipped time is simulated in a single larger step.  The default value is 4.\n"
+      "@ingroup Physics" );
+
+   Con::addVariable( "$Server::simulationLODSuspendDistance", TypeF32, &SimulationLOD::smSuspendDistance,
+      "@brief Distance from the closest client camera beyond which rigid bodies stop simulating.\n\n"
+      "If zero, which is the default, each client's visible ghost distance is used.\n"
+      "@ingroup Physics" );
+}
+
+//-----------------------------------------------------------------------------
+
+void SimulationLOD::beginTick()
+{
+   sViews.clear();
+   sTickCount++;
+
+   if ( !smEnabled )
+      return;
+
+   PROFILE_SCOPE( SimulationLOD_beginTick );
+
+   SimGroup *clients = Sim::getClientGroup();
+   for ( SimGroup::iterator itr = clients->begin(); itr != clients->end(); itr++ )
+   {
+      GameConnection *conn = dynamic_cast< GameConnection* >( *itr );
+      MatrixF cameraMat;
+      if ( !conn || !conn->getControlCameraTransform( 0.0f, &cameraMat ) )
+         continue;
+
+      // Use the same interest area as ghost scoping.
+      F32 suspendDist = smSuspendDistance;
+      if ( suspendDist <= 0.0f && ( suspendDist = conn->getVisibleGhostDistance() ) == 0.0f && gServerSceneGraph )
+         if ( ( suspendDist = gServerSceneGraph->getVisibleGhostDistance() ) == 0.0f )
+            suspendDist = gServerSceneGraph->getVisibleDistance();
+
+      sViews.increment();
+      View &view = sViews.last();
+      view.position = cameraMat.getPosition();
+      view.suspendDistSq = suspendDist * suspendDist;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+SimulationLOD::Level SimulationLOD::getLevel( GameBase *obj )
+{
+   Level level = Full;
+
+   if (  smEnabled && 
+         obj->isServerObject() && 
+         !sViews.empty() &&
+         !obj->getControllingClient() && 
+         obj->getMountedObjectCount() == 0 )
+   {
+      // Find the level of the closest view.
+      const F32 reducedDistSq = smReducedDistance * smReducedDistance;
+      const Box3F &worldBox = obj->getWorldBox();
+
+      level = Suspended;
+      for ( U32 i = 0; i < sViews.size() && level != Full; i++ )
+      {
+         const F32 distSq = worldBox.getSqDistanceToPoint( sViews[i].position );
+         if ( distSq <= reducedDistSq )
+            level = Full;
+         else if ( distSq <= sViews[i].suspendDistSq )
+            level = Reduced;
+      }
+   }
+
+   return level;
+}
+
+U32 SimulationLOD::update( GameBase *obj, State *state )
+{
+   const Level level = getLevel( obj );
+
+   state->level = level;
+
+   switch ( level )
+   {
+      case Reduced:
+      {
+         // Stagger the objects by id so that they
+         // don't all step in the same tick.
+         const U32 interval = getMax( smReducedTickInterval, (U32)1 );
+         if ( ( sTickCount + obj->getId() ) % interval != 0 )
+         {
+            state->skippedTicks++;
+            return 0;
+         }
+         break;
+      }
+
+      case Suspended:
+         state->skippedTicks = 0;
+         return 0;
+
+      default:
+         break;
+   }
+
+   const U32 ticks = state->skippedTicks + 1;
+   state->skippedTicks = 0;
+   return ticks;
+}
@@ -0,0 +1,107 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SIMULATIONLOD_H_
+#define _SIMULATIONLOD_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+class GameBase;
+
+
+/// Server side level of detail for rigid body simulation.
+///
+/// At the start of every server tick the camera positions of all clients
+/// are gathered.  RigidShape, Vehicle and PhysicsShape objects then ask
+/// update() how many ticks to simulate.  Objects close to a camera simulate
+/// every tick.  Objects further away than #smReducedDistance from every
+/// camera simulate only every #smReducedTickInterval ticks with a larger
+/// time step; clients already interpolate and predict between server
+/// updates.  Objects outside the interest area of every client are
+/// suspended: they do not simulate or run collision at all until a client
+/// gets close again.
+///
+/// Objects which are controlled by a client or have other objects mounted
+/// on them always simulate at full rate, as does everything when no
+/// clients are connected.
+namespace SimulationLOD
+{
+   enum Level
+   {
+      Full,
+      Reduced,
+      Suspended,
+   };
+
+   /// Per object simulation LOD state.
+   struct State
+   {
+      Level level;
+
+      /// Ticks skipped at reduced rate which have
+      /// not been simulated yet.
+      U32 skippedTicks;
+
+      State()
+         :  level( Full ),
+            skippedTicks( 0 )
+      {
+      }
+   };
+
+   /// Whether server objects use simulation LOD.
+   extern bool smEnabled;
+
+   /// Distance from the closest client camera beyond
+   /// which objects simulate at a reduced rate.
+   extern F32 smReducedDistance;
+
+   /// Number of ticks between simulation steps at reduced rate.
+   extern U32 smReducedTickInterval;
+
+   /// Distance from the closest client camera beyond which objects
+   /// are suspended.  If zero the visible ghost distance of each
+   /// client is used.
+   extern F32 smSuspendDistance;
+
+   /// Gather the client camera positions.  Called by the server
+   /// process list at the start of every tick.
+   void beginTick();
+
+   /// Return the level @a obj is at this tick without updating any
+   /// per object state.
+   ///
+   /// Client objects are always at full level.
+   Level getLevel( GameBase *obj );
+
+   /// Update the level of @a obj and return the number of ticks it should
+   /// simulate this tick.  This is 0 if it should not simulate at all, 1
+   /// normally or more to catch up on ticks skipped at reduced rate.
+   ///
+   /// Client objects always get 1.
+   U32 update( GameBase *obj, State *state );
+}
+
+#endif // _SIMULATIONLOD_H_
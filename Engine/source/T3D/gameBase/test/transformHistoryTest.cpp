@@ -0,0 +1,61 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "T3D/gameBase/transformHistory.h"
+
+TEST(TransformHistory, Interpolate)
+{
+   TransformHistory history;
+   MatrixF mat;
+   EXPECT_FALSE(history.getTransform(0, &mat))
+      << "Empty history should have no transform";
+
+   for (U32 i = 0; i < TransformHistory::NumEntries + 4; i++)
+   {
+      MatrixF step(true);
+      step.setPosition(Point3F(F32(i), 0.0f, 0.0f));
+      history.record(i * 32, step);
+   }
+
+   EXPECT_EQ(history.getNewestTime(), (TransformHistory::NumEntries + 3) * 32);
+   EXPECT_EQ(history.getOldestTime(), 4 * 32)
+      << "Oldest entries should have been dropped";
+
+   ASSERT_TRUE(history.getTransform(10 * 32 + 8, &mat));
+   EXPECT_FLOAT_EQ(mat.getPosition().x, 10.25f);
+
+   history.getTransform(0, &mat);
+   EXPECT_FLOAT_EQ(mat.getPosition().x, 4.0f)
+      << "Times before the history should clamp to the oldest entry";
+
+   history.getTransform(100000, &mat);
+   EXPECT_FLOAT_EQ(mat.getPosition().x, F32(TransformHistory::NumEntries + 3));
+
+   MatrixF reset(true);
+   history.record(0, reset);
+   EXPECT_EQ(history.getOldestTime(), 0)
+      << "Going back in time should start over";
+};
+
+#endif
@@ -72,6 +72,44 @@ Move * TickCacheEntry::allocateMove()
    return allocMove();
 }
 
+namespace
+{
+   // Write the packet data of obj into buffer and return its size in bytes.
+   // Unused bits of the last byte are cleared so snapshots compare bytewise.
+   U32 writeSnapshot(GameBase * obj, GameConnection * con, U8 * buffer)
+   {
+      BitStream bs(buffer,TickCacheEntry::MaxPacketSize);
+      obj->writePacketData(con,&bs);
+      U32 bits = bs.getBitPosition();
+      if (bits & 7)
+         buffer[bits>>3] &= (1<<(bits&7))-1;
+      return bs.getPosition();
+   }
+}
+
+void TickCacheEntry::store(GameBase * obj, GameConnection * con)
+{
+   packetSize = writeSnapshot(obj,con,packetData);
+}
+
+void TickCacheEntry::restore(GameBase * obj, GameConnection * con)
+{
+   BitStream bs(packetData,MaxPacketSize);
+   obj->readPacketData(con,&bs);
+}
+
+bool TickCacheEntry::matches(GameBase * obj, GameConnection * con)
+{
+   if (!packetSize)
+      return false;
+
+   // write current state into a scratch snapshot and compare the bytes --
+   // packet data is quantized the same way on both sides, so this compares
+   // states to within the precision they are networked with
+   U8 buffer[MaxPacketSize];
+   return writeSnapshot(obj,con,buffer) == packetSize && !dMemcmp(buffer,packetData,packetSize);
+}
+
 TickCacheEntry * TickCache::addCacheEntry()
 {
    // Add a new entry, creating head if needed
@@ -92,6 +130,7 @@ TickCacheEntry * TickCache::addCacheEntry()
    }
    mTickCacheHead->newest->next = NULL;
    mTickCacheHead->newest->move = NULL;
+   mTickCacheHead->newest->packetSize = 0;
    mTickCacheHead->numEntry++;
    return mTickCacheHead->newest;
 }
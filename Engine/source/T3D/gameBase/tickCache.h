@@ -28,6 +28,8 @@
 #endif
 
 struct Move;
+class GameBase;
+class GameConnection;
 
 struct TickCacheEntry
 {
@@ -37,8 +39,20 @@ struct TickCacheEntry
    TickCacheEntry * next;
    Move * move;
 
+   // Number of bytes of packetData written by the last store (0 if none)
+   U32 packetSize;
+
    // If you want to assign moves to tick cache for later playback, allocate them here
    Move * allocateMove();
+
+   // Snapshot the packet data of obj into this entry
+   void store(GameBase * obj, GameConnection * con);
+
+   // Reset obj to the state snapshotted in this entry
+   void restore(GameBase * obj, GameConnection * con);
+
+   // Return true if obj currently writes exactly the packet data snapshotted here
+   bool matches(GameBase * obj, GameConnection * con);
 };
 
 struct TickCacheHead;
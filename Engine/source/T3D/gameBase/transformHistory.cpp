@@ -0,0 +1,73 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "T3D/gameBase/transformHistory.h"
+
+
+void TransformHistory::record( SimTime time, const MatrixF &mat )
+{
+   // Start over if time went backwards.
+   if ( !isEmpty() && time <= getNewestTime() )
+      clear();
+
+   mNewest = ( mNewest + 1 ) % NumEntries;
+   if ( mCount < NumEntries )
+      mCount++;
+
+   Entry &entry = mEntries[ mNewest ];
+   entry.time = time;
+   entry.pos = mat.getPosition();
+   entry.rot.set( mat );
+}
+
+bool TransformHistory::getTransform( SimTime time, MatrixF *outMat ) const
+{
+   if ( isEmpty() )
+      return false;
+
+   // Find the newest entry not after the requested time.
+   U32 age = 0;
+   while ( age < mCount - 1 && _getEntry( age ).time > time )
+      age++;
+
+   const Entry &older = _getEntry( age );
+
+   if ( age == 0 || time <= older.time )
+   {
+      older.rot.setMatrix( outMat );
+      outMat->setPosition( older.pos );
+      return true;
+   }
+
+   const Entry &newer = _getEntry( age - 1 );
+   const F32 t = F32( time - older.time ) / F32( newer.time - older.time );
+
+   QuatF rot;
+   rot.interpolate( older.rot, newer.rot, t );
+   rot.setMatrix( outMat );
+
+   Point3F pos;
+   pos.interpolate( older.pos, newer.pos, t );
+   outMat->setPosition( pos );
+   return true;
+}
@@ -0,0 +1,96 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _TRANSFORMHISTORY_H_
+#define _TRANSFORMHISTORY_H_
+
+#ifndef _MMATRIX_H_
+#include "math/mMatrix.h"
+#endif
+#ifndef _MQUAT_H_
+#include "math/mQuat.h"
+#endif
+#ifndef _SIMBASE_H_
+#include "console/simBase.h"
+#endif
+
+
+/// A ring of the transforms a server object had at the end of its recent
+/// ticks, used to rewind it to the time a client saw it at.
+///
+/// @see LagCompensation
+class TransformHistory
+{
+public:
+
+   enum
+   {
+      /// Number of ticks kept; a little over one second.
+      NumEntries = 32,
+   };
+
+   TransformHistory() { clear(); }
+
+   /// Discard all entries.
+   void clear() { mCount = 0; mNewest = 0; }
+
+   /// Return true if there is nothing to rewind to.
+   bool isEmpty() const { return mCount == 0; }
+
+   /// Store @a mat as the transform at @a time, dropping the oldest entry
+   /// if the ring is full.  Times should increase; if they do not, the
+   /// older entries are discarded.
+   void record( SimTime time, const MatrixF &mat );
+
+   /// Return the time of the oldest entry.
+   SimTime getOldestTime() const { return _getEntry( mCount - 1 ).time; }
+
+   /// Return the time of the newest entry.
+   SimTime getNewestTime() const { return _getEntry( 0 ).time; }
+
+   /// Compute the transform at @a time, interpolating between the two
+   /// entries around it.  Times outside the ring are clamped to it.
+   /// @return False if the history is empty.
+   bool getTransform( SimTime time, MatrixF *outMat ) const;
+
+protected:
+
+   struct Entry
+   {
+      SimTime time;
+      Point3F pos;
+      QuatF rot;
+   };
+
+   Entry mEntries[ NumEntries ];
+
+   /// Number of valid entries.
+   U32 mCount;
+
+   /// Index of the newest entry.
+   U32 mNewest;
+
+   /// Return the entry @a age ticks older than the newest one.
+   const Entry& _getEntry( U32 age ) const { return mEntries[ ( mNewest + NumEntries - age ) % NumEntries ]; }
+};
+
+#endif // _TRANSFORMHISTORY_H_
@@ -24,7 +24,10 @@
 #include "T3D/gameFunctions.h"
 #include "T3D/gameBase/gameConnection.h"
 #include "T3D/camera.h"
+#include "T3D/tsStatic.h"
+#include "T3D/convexShape.h"
 #include "T3D/sfx/sfx3DWorld.h"
+#include "forest/forest.h"
 #include "console/consoleTypes.h"
 #include "gui/3d/guiTSControl.h"
 #include "core/util/journal/process.h"
@@ -164,6 +167,47 @@ DefineConsoleFunction( containerFindNext, const char*, (), , "()"
    return buff;
 }
 
+DefineEngineFunction( bakeLevelCollision, S32, ( bool useClientContainer ), ( false ),
+   "@brief Bake the ray cast geometry of all TSStatics, ConvexShapes and Forests into a single tree.\n\n"
+   "Ray casts against collision geometry, e.g. from projectiles, AI line of sight checks and players, then "
+   "test that tree once instead of each of these objects.  Call this once the mission has loaded.  Objects "
+   "that move or change afterwards are tested individually again.\n"
+   "@param useClientContainer Bake the client container instead of the server container.\n"
+   "@returns The number of triangles baked.\n"
+   "@see clearLevelCollision()\n"
+   "@ingroup Game")
+{
+   SceneContainer* container = useClientContainer ? &gClientContainer : &gServerContainer;
+
+   Vector< SceneObject* > objects;
+   container->findObjectList( StaticObjectType, &objects );
+
+   // Only take objects that never move by themselves.
+   for ( S32 i = objects.size() - 1; i >= 0; -- i )
+   {
+      SceneObject* object = objects[ i ];
+      if ( !dynamic_cast< TSStatic* >( object ) &&
+           !dynamic_cast< ConvexShape* >( object ) &&
+           !dynamic_cast< Forest* >( object ) )
+         objects.erase_fast( i );
+   }
+
+   const U32 numTriangles = container->bakeStaticCollision( objects );
+   Con::printf( "bakeLevelCollision - Baked %d triangles from %d objects", numTriangles, objects.size() );
+
+   return numTriangles;
+}
+
+DefineEngineFunction( clearLevelCollision, void, ( bool useClientContainer ), ( false ),
+   "@brief Drop the geometry baked by bakeLevelCollision().\n\n"
+   "@param useClientContainer Clear the client container instead of the server container.\n"
+   "@see bakeLevelCollision()\n"
+   "@ingroup Game")
+{
+   SceneContainer* container = useClientContainer ? &gClientContainer : &gServerContainer;
+   container->clearStaticCollision();
+}
+
 ConsoleFunctionGroupEnd( Containers );
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,564 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "T3D/irradianceVolume.h"
+
+#include "T3D/lightBase.h"
+#include "scene/sceneManager.h"
+#include "scene/sceneContainer.h"
+#include "lighting/lightInfo.h"
+#include "console/consoleTypes.h"
+#include "console/engineAPI.h"
+#include "core/stream/bitStream.h"
+#include "core/stream/fileStream.h"
+
+#include "math/mPolyhedron.impl.h"
+
+
+IMPLEMENT_CO_NETOBJECT_V1( IrradianceVolume );
+
+ConsoleDocClass( IrradianceVolume,
+   "@brief A box shaped grid of baked ambient light probes.\n\n"
+
+   "Each probe stores the light arriving from the six axis directions, baked from the sky "
+   "ambient visible from the probe and the unoccluded light of the level's lights.  While the "
+   "camera is inside the volume the interpolated probes replace the sun ambient of the scene, so "
+   "indoor areas can be lit without placing fill lights.  Lights with bakedOnly set are only used "
+   "by the bake and have no runtime cost.\n\n"
+
+   "Call bake() from the editor to bake the probes and save them to bakedFile.\n\n"
+
+   "@ingroup enviroMisc"
+);
+
+
+Vector<IrradianceVolume*> IrradianceVolume::smVolumes;
+
+/// Length of the rays testing the visibility of the sky
+/// and of directional lights.
+static const F32 smSkyRayLength = 1000.0f;
+
+/// Version of the baked probe files.
+static const U32 smFileVersion = 1;
+
+
+//-----------------------------------------------------------------------------
+
+IrradianceVolume::IrradianceVolume()
+   : mProbeSpacing( 4.0f ),
+     mSkyRays( 64 ),
+     mStrength( 1.0f ),
+     mBakeVersion( 0 ),
+     mGridSize( Point3I::Zero )
+{
+   VECTOR_SET_ASSOCIATION( mProbes );
+
+   mNetFlags.set( Ghostable | ScopeAlways );
+
+   mObjScale.set( 1.f, 1.f, 1.f );
+   mObjBox.set(
+      Point3F( -0.5f, -0.5f, -0.5f ),
+      Point3F( 0.5f, 0.5f, 0.5f )
+   );
+
+   mObjToWorld.identity();
+   mWorldToObj.identity();
+
+   resetWorldBox();
+}
+
+void IrradianceVolume::initPersistFields()
+{
+   addGroup( "Probes" );
+
+      addField( "probeSpacing", TypeF32, Offset( mProbeSpacing, IrradianceVolume ),
+         "The distance in meters between the probes of the grid." );
+
+      addField( "skyRays", TypeS32, Offset( mSkyRays, IrradianceVolume ),
+         "The number of rays cast from each probe to find how much of the sky it sees." );
+
+      addField( "strength", TypeF32, Offset( mStrength, IrradianceVolume ),
+         "Scales the baked ambient light." );
+
+      addField( "bakedFile", TypeStringFilename, Offset( mBakedFile, IrradianceVolume ),
+         "The file the baked probes are saved to and loaded from." );
+
+   endGroup( "Probes" );
+
+   Parent::initPersistFields();
+}
+
+void IrradianceVolume::consoleInit()
+{
+   // Disable rendering of irradiance volumes by default.
+   getStaticClassRep()->mIsRenderEnabled = false;
+
+   SceneManager::smAmbientLightQuery.bind( &IrradianceVolume::sampleAmbient );
+}
+
+//-----------------------------------------------------------------------------
+
+bool IrradianceVolume::onAdd()
+{
+   if( !Parent::onAdd() )
+      return false;
+
+   if ( isClientObject() )
+   {
+      smVolumes.push_back( this );
+      _loadProbes();
+   }
+
+   return true;
+}
+
+void IrradianceVolume::onRemove()
+{
+   if ( isClientObject() )
+      smVolumes.remove( this );
+
+   Parent::onRemove();
+}
+
+void IrradianceVolume::inspectPostApply()
+{
+   Parent::inspectPostApply();
+   setMaskBits( BakeMask );
+}
+
+//-----------------------------------------------------------------------------
+
+U32 IrradianceVolume::packUpdate( NetConnection *connection, U32 mask, BitStream *stream )
+{
+   U32 retMask = Parent::packUpdate( connection, mask, stream );
+
+   if ( stream->writeFlag( mask & ( InitialUpdateMask | BakeMask ) ) )
+   {
+      stream->write( mStrength );
+      stream->write( mBakedFile );
+      stream->write( mBakeVersion );
+   }
+
+   return retMask;
+}
+
+void IrradianceVolume::unpackUpdate( NetConnection *connection, BitStream *stream )
+{
+   Parent::unpackUpdate( connection, stream );
+
+   if ( stream->readFlag() ) // InitialUpdateMask | BakeMask
+   {
+      String bakedFile;
+      U32 bakeVersion;
+
+      stream->read( &mStrength );
+      stream->read( &bakedFile );
+      stream->read( &bakeVersion );
+
+      if ( bakedFile != mBakedFile || bakeVersion != mBakeVersion )
+      {
+         mBakedFile = bakedFile;
+         mBakeVersion = bakeVersion;
+
+         if ( isProperlyAdded() )
+            _loadProbes();
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+Point3I IrradianceVolume::_calcGridSize() const
+{
+   const Point3F &scale = getScale();
+   const F32 spacing = getMax( mProbeSpacing, 0.5f );
+
+   return Point3I(   mClamp( (S32)mCeil( scale.x / spacing ) + 1, 2, (S32)MaxProbesPerAxis ),
+                     mClamp( (S32)mCeil( scale.y / spacing ) + 1, 2, (S32)MaxProbesPerAxis ),
+                     mClamp( (S32)mCeil( scale.z / spacing ) + 1, 2, (S32)MaxProbesPerAxis ) );
+}
+
+Point3F IrradianceVolume::_getProbePosition( const Point3I &index ) const
+{
+   Point3F pos(   F32( index.x ) / F32( mGridSize.x - 1 ) - 0.5f,
+                  F32( index.y ) / F32( mGridSize.y - 1 ) - 0.5f,
+                  F32( index.z ) / F32( mGridSize.z - 1 ) - 0.5f );
+   pos.convolve( getScale() );
+
+   getTransform().mulP( pos );
+   return pos;
+}
+
+/// Adds light arriving from @a dir to the faces of an ambient cube
+/// facing it, weighted by the cosine to each face.
+static void _addToAmbientCube( IrradianceVolume::Probe *probe, const VectorF &dir, const LinearColorF &color )
+{
+   probe->faces[ dir.x >= 0.0f ? 0 : 1 ] += color * mFabs( dir.x );
+   probe->faces[ dir.y >= 0.0f ? 2 : 3 ] += color * mFabs( dir.y );
+   probe->faces[ dir.z >= 0.0f ? 4 : 5 ] += color * mFabs( dir.z );
+}
+
+bool IrradianceVolume::_bakeProbes()
+{
+   AssertFatal( isClientObject(), "IrradianceVolume::_bakeProbes - Probes are baked from the client scene!" );
+
+   // Gather the lights to bake.  Directional lights
+   // also provide the ambient light of the sky.
+   Vector<SceneObject*> objects;
+   gClientContainer.findObjectList( LightObjectType, &objects );
+
+   Vector<LightInfo*> lights;
+   LinearColorF skyAmbient( LinearColorF::BLACK );
+
+   for ( U32 i = 0; i < objects.size(); i++ )
+   {
+      if ( LightBase *lightBase = dynamic_cast<LightBase*>( objects[i] ) )
+      {
+         if ( lightBase->getLightEnabled() && lightBase->getLight() )
+            lights.push_back( lightBase->getLight() );
+      }
+      else if ( objects[i]->getTypeMask() & EnvironmentObjectType )
+      {
+         ISceneLight *sceneLight = dynamic_cast<ISceneLight*>( objects[i] );
+         LightInfo *light = sceneLight ? sceneLight->getLight() : NULL;
+         if ( light && light->getType() == LightInfo::Vector )
+         {
+            lights.push_back( light );
+            skyAmbient += light->getAmbient();
+         }
+      }
+   }
+
+   // Spread the sky rays evenly over the sphere.
+   const U32 numSkyRays = mClamp( mSkyRays, 0, 1024 );
+   Vector<VectorF> skyDirs( numSkyRays );
+   for ( U32 i = 0; i < numSkyRays; i++ )
+   {
+      const F32 z = 1.0f - ( 2.0f * i + 1.0f ) / F32( numSkyRays );
+      const F32 r = mSqrt( getMax( 1.0f - z * z, 0.0f ) );
+      const F32 phi = F32( i ) * 2.39996323f;
+      skyDirs.push_back( VectorF( mCos( phi ) * r, mSin( phi ) * r, z ) );
+   }
+
+   // An unoccluded sky should give every face the
+   // full ambient, so normalize by the cosine sum.
+   const LinearColorF skyRayColor = numSkyRays ? skyAmbient * ( 4.0f / F32( numSkyRays ) ) : skyAmbient;
+
+   mGridSize = _calcGridSize();
+   mProbes.setSize( mGridSize.x * mGridSize.y * mGridSize.z );
+
+   Vector<SceneContainer::RayQuery> rays;
+   Vector<LightInfo*> rayLights;
+   Vector<RayInfo> hits;
+
+   U32 index = 0;
+   for ( S32 z = 0; z < mGridSize.z; z++ )
+   {
+      for ( S32 y = 0; y < mGridSize.y; y++ )
+      {
+         for ( S32 x = 0; x < mGridSize.x; x++, index++ )
+         {
+            const Point3F pos = _getProbePosition( Point3I( x, y, z ) );
+
+            rays.clear();
+            rayLights.clear();
+
+            for ( U32 i = 0; i < skyDirs.size(); i++ )
+            {
+               rays.increment();
+               SceneContainer::RayQuery &ray = rays.last();
+               ray.start = pos;
+               ray.end = pos + skyDirs[i] * smSkyRayLength;
+               ray.mask = STATIC_COLLISION_TYPEMASK;
+               rayLights.push_back( NULL );
+            }
+
+            for ( U32 i = 0; i < lights.size(); i++ )
+            {
+               LightInfo *light = lights[i];
+
+               Point3F end;
+               if ( light->getType() == LightInfo::Vector )
+                  end = pos - light->getDirection() * smSkyRayLength;
+               else if ( ( light->getPosition() - pos ).len() < light->getRange().x )
+                  end = light->getPosition();
+               else
+                  continue;
+
+               rays.increment();
+               SceneContainer::RayQuery &ray = rays.last();
+               ray.start = pos;
+               ray.end = end;
+               ray.mask = STATIC_COLLISION_TYPEMASK;
+               rayLights.push_back( light );
+            }
+
+            hits.setSize( rays.size() );
+            for ( U32 i = 0; i < hits.size(); i++ )
+               hits[i] = RayInfo();
+
+            if ( !rays.empty() )
+               gClientContainer.castRayBatch( rays.address(), rays.size(), hits.address() );
+
+            Probe &probe = mProbes[index];
+            for ( U32 i = 0; i < NumCubeFaces; i++ )
+               probe.faces[i] = LinearColorF::BLACK;
+
+            for ( U32 i = 0; i < rays.size(); i++ )
+            {
+               if ( hits[i].object )
+                  continue;
+
+               VectorF dir = rays[i].end - rays[i].start;
+               const F32 dist = dir.len();
+               if ( dist <= 0.0f )
+                  continue;
+               dir /= dist;
+
+               LightInfo *light = rayLights[i];
+               if ( !light )
+               {
+                  _addToAmbientCube( &probe, dir, skyRayColor );
+                  continue;
+               }
+
+               LinearColorF color = light->getColor() * light->getBrightness();
+
+               if ( light->getType() != LightInfo::Vector )
+               {
+                  F32 atten = 1.0f - dist / light->getRange().x;
+                  atten *= atten;
+
+                  if ( light->getType() == LightInfo::Spot )
+                  {
+                     const F32 outerCos = mCos( mDegToRad( light->getOuterConeAngle() / 2.0f ) );
+                     const F32 innerCos = mCos( mDegToRad( getMin( light->getInnerConeAngle(), light->getOuterConeAngle() ) / 2.0f ) );
+                     const F32 cosAngle = mDot( light->getDirection(), -dir );
+                     atten *= mClampF( ( cosAngle - outerCos ) / getMax( innerCos - outerCos, 0.001f ), 0.0f, 1.0f );
+                  }
+
+                  color *= atten;
+               }
+
+               _addToAmbientCube( &probe, dir, color );
+            }
+         }
+      }
+   }
+
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool IrradianceVolume::_saveProbes() const
+{
+   if ( mBakedFile.isEmpty() )
+   {
+      Con::errorf( "IrradianceVolume::_saveProbes - No bakedFile has been set!" );
+      return false;
+   }
+
+   FileStream *stream = FileStream::createAndOpen( mBakedFile, Torque::FS::File::Write );
+   if ( !stream )
+   {
+      Con::errorf( "IrradianceVolume::_saveProbes - Unable to open '%s' for writing!", mBakedFile.c_str() );
+      return false;
+   }
+
+   stream->write( smFileVersion );
+   stream->write( mGridSize.x );
+   stream->write( mGridSize.y );
+   stream->write( mGridSize.z );
+
+   for ( U32 i = 0; i < mProbes.size(); i++ )
+   {
+      for ( U32 j = 0; j < NumCubeFaces; j++ )
+         stream->write( mProbes[i].faces[j] );
+   }
+
+   delete stream;
+   return true;
+}
+
+bool IrradianceVolume::_loadProbes()
+{
+   mProbes.clear();
+   mGridSize = Point3I::Zero;
+
+   if ( mBakedFile.isEmpty() )
+      return false;
+
+   FileStream *stream = FileStream::createAndOpen( mBakedFile, Torque::FS::File::Read );
+   if ( !stream )
+      return false;
+
+   U32 version = 0;
+   Point3I gridSize;
+   stream->read( &version );
+   stream->read( &gridSize.x );
+   stream->read( &gridSize.y );
+   stream->read( &gridSize.z );
+
+   if (  version != smFileVersion ||
+         gridSize.x < 2 || gridSize.x > MaxProbesPerAxis ||
+         gridSize.y < 2 || gridSize.y > MaxProbesPerAxis ||
+         gridSize.z < 2 || gridSize.z > MaxProbesPerAxis )
+   {
+      Con::warnf( "IrradianceVolume::_loadProbes - '%s' is not a valid probe file!", mBakedFile.c_str() );
+      delete stream;
+      return false;
+   }
+
+   mProbes.setSize( gridSize.x * gridSize.y * gridSize.z );
+   for ( U32 i = 0; i < mProbes.size(); i++ )
+   {
+      for ( U32 j = 0; j < NumCubeFaces; j++ )
+         stream->read( &mProbes[i].faces[j] );
+   }
+
+   const bool ok = stream->getStatus() == Stream::Ok || stream->getStatus() == Stream::EOS;
+   delete stream;
+
+   if ( !ok )
+   {
+      Con::warnf( "IrradianceVolume::_loadProbes - '%s' is truncated!", mBakedFile.c_str() );
+      mProbes.clear();
+      return false;
+   }
+
+   mGridSize = gridSize;
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void IrradianceVolume::_sampleProbes( const Point3F &position, Probe *outProbe )
+{
+   Point3F objPos;
+   getWorldTransform().mulP( position, &objPos );
+   objPos.convolveInverse( getScale() );
+
+   // Find the grid cell and the position within it.
+   const S32 size[3] = { mGridSize.x, mGridSize.y, mGridSize.z };
+   S32 cell[3];
+   F32 frac[3];
+   for ( U32 i = 0; i < 3; i++ )
+   {
+      const F32 coord = mClampF( ( objPos[i] + 0.5f ) * F32( size[i] - 1 ), 0.0f, F32( size[i] - 1 ) );
+      cell[i] = getMin( (S32)mFloor( coord ), size[i] - 2 );
+      frac[i] = coord - F32( cell[i] );
+   }
+
+   for ( U32 j = 0; j < NumCubeFaces; j++ )
+      outProbe->faces[j] = LinearColorF::BLACK;
+
+   // Blend the eight probes around the position.
+   for ( U32 corner = 0; corner < 8; corner++ )
+   {
+      const S32 x = cell[0] + ( corner & 1 );
+      const S32 y = cell[1] + ( ( corner >> 1 ) & 1 );
+      const S32 z = cell[2] + ( ( corner >> 2 ) & 1 );
+
+      const F32 weight = ( ( corner & 1 ) ? frac[0] : 1.0f - frac[0] ) *
+                         ( ( ( corner >> 1 ) & 1 ) ? frac[1] : 1.0f - frac[1] ) *
+                         ( ( ( corner >> 2 ) & 1 ) ? frac[2] : 1.0f - frac[2] );
+      if ( weight <= 0.0f )
+         continue;
+
+      const Probe &probe = mProbes[ x + y * size[0] + z * size[0] * size[1] ];
+      for ( U32 j = 0; j < NumCubeFaces; j++ )
+         outProbe->faces[j] += probe.faces[j] * weight;
+   }
+}
+
+bool IrradianceVolume::sampleAmbient( const Point3F &position, LinearColorF *outColor )
+{
+   for ( U32 i = 0; i < smVolumes.size(); i++ )
+   {
+      IrradianceVolume *volume = smVolumes[i];
+      if ( volume->mProbes.empty() || !volume->containsPoint( position ) )
+         continue;
+
+      Probe probe;
+      volume->_sampleProbes( position, &probe );
+
+      // The scene has a single ambient color, so
+      // use the average over all directions.
+      LinearColorF color( LinearColorF::BLACK );
+      for ( U32 j = 0; j < NumCubeFaces; j++ )
+         color += probe.faces[j];
+
+      color *= volume->mStrength / F32( NumCubeFaces );
+      color.alpha = 1.0f;
+
+      *outColor = color;
+      return true;
+   }
+
+   return false;
+}
+
+bool IrradianceVolume::bake()
+{
+   IrradianceVolume *volume = isServerObject() ? getClientObject( this ) : this;
+   if ( !volume )
+   {
+      Con::errorf( "IrradianceVolume::bake - There is no client scene to bake from!" );
+      return false;
+   }
+
+   if ( mBakedFile.isEmpty() )
+   {
+      Con::errorf( "IrradianceVolume::bake - No bakedFile has been set!" );
+      return false;
+   }
+
+   volume->mBakedFile = mBakedFile;
+   volume->mProbeSpacing = mProbeSpacing;
+   volume->mSkyRays = mSkyRays;
+
+   if ( !volume->_bakeProbes() || !volume->_saveProbes() )
+      return false;
+
+   // Have the other clients load the new probes.
+   if ( isServerObject() )
+   {
+      mBakeVersion++;
+      volume->mBakeVersion = mBakeVersion;
+      setMaskBits( BakeMask );
+   }
+
+   Con::printf( "IrradianceVolume::bake - Baked %d probes to '%s'.", volume->getProbeCount(), mBakedFile.c_str() );
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+DefineEngineMethod( IrradianceVolume, bake, bool, (),,
+   "Bakes the probes of the volume from the client scene and saves them to bakedFile.\n"
+   "@return True if the probes were baked and saved." )
+{
+   return object->bake();
+}
@@ -0,0 +1,144 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _IRRADIANCEVOLUME_H_
+#define _IRRADIANCEVOLUME_H_
+
+#ifndef _SCENEPOLYHEDRALSPACE_H_
+#include "scene/scenePolyhedralSpace.h"
+#endif
+
+
+/// A box shaped grid of baked ambient light probes.
+///
+/// Each probe stores an ambient cube, the irradiance arriving from the
+/// six axis directions, baked from the sky ambient visible from the probe
+/// and the unoccluded light of the level's lights.  Lights marked as
+/// LightBase::bakedOnly only contribute here so fill lights cost nothing
+/// at runtime.
+///
+/// The probes are saved to #mBakedFile and loaded by the clients.  While
+/// the camera is inside a volume, the probes interpolated at the camera
+/// position replace the sun ambient in the diffuse pass.
+class IrradianceVolume : public ScenePolyhedralSpace
+{
+   public:
+
+      typedef ScenePolyhedralSpace Parent;
+
+      enum Constants
+      {
+         /// Most probes along one axis of the grid.
+         MaxProbesPerAxis = 64,
+
+         /// Number of faces of an ambient cube.
+         NumCubeFaces = 6,
+      };
+
+      /// The ambient cube of a single probe in +X, -X, +Y, -Y, +Z, -Z order.
+      struct Probe
+      {
+         LinearColorF faces[NumCubeFaces];
+      };
+
+   protected:
+
+      enum MaskBits
+      {
+         BakeMask = Parent::NextFreeMask << 0,
+         NextFreeMask = Parent::NextFreeMask << 1
+      };
+
+      /// The distance between probes in meters.
+      F32 mProbeSpacing;
+
+      /// Number of sky visibility rays cast from each probe.
+      S32 mSkyRays;
+
+      /// Scales the baked light.
+      F32 mStrength;
+
+      /// The file the baked probes are stored in.
+      String mBakedFile;
+
+      /// Bumped on every bake so clients reload the file.
+      U32 mBakeVersion;
+
+      /// Number of probes along each axis of the loaded grid.
+      Point3I mGridSize;
+
+      /// The loaded probes in x, then y, then z order.
+      Vector<Probe> mProbes;
+
+      /// The client volumes with probes loaded.
+      static Vector<IrradianceVolume*> smVolumes;
+
+      /// Returns the grid size for the current scale and spacing.
+      Point3I _calcGridSize() const;
+
+      /// Returns the world space position of a probe.
+      Point3F _getProbePosition( const Point3I &index ) const;
+
+      /// Bakes the probes from the client scene.
+      bool _bakeProbes();
+
+      bool _saveProbes() const;
+      bool _loadProbes();
+
+      /// Interpolates the probes at a world space position.
+      void _sampleProbes( const Point3F &position, Probe *outProbe );
+
+   public:
+
+      IrradianceVolume();
+
+      // SimObject.
+      DECLARE_CONOBJECT( IrradianceVolume );
+      DECLARE_DESCRIPTION( "A grid of baked ambient light probes." );
+      DECLARE_CATEGORY( "3D Scene" );
+
+      virtual bool onAdd();
+      virtual void onRemove();
+      virtual void inspectPostApply();
+
+      static void consoleInit();
+      static void initPersistFields();
+
+      // NetObject.
+      virtual U32 packUpdate( NetConnection *connection, U32 mask, BitStream *stream );
+      virtual void unpackUpdate( NetConnection *connection, BitStream *stream );
+
+      /// Bakes the probes on the client ghost of this volume
+      /// and saves them to the baked file.
+      bool bake();
+
+      /// Returns the number of loaded probes.
+      U32 getProbeCount() const { return mProbes.size(); }
+
+      /// Returns the ambient light color at a point from the client
+      /// volumes containing it or false if there are none.
+      /// @see SceneManager::smAmbientLightQuery
+      static bool sampleAmbient( const Point3F &position, LinearColorF *outColor );
+};
+
+#endif // !_IRRADIANCEVOLUME_H_
@@ -31,6 +31,7 @@
 #include "collision/boxConvex.h"
 #include "collision/earlyOutPolyList.h"
 #include "collision/extrudedPolyList.h"
+#include "collision/collisionStats.h"
 #include "math/mPolyhedron.h"
 #include "math/mathIO.h"
 #include "lighting/lightInfo.h"
@@ -852,6 +853,7 @@ void Item::updatePos(const U32 /*mask*/, const F32 dt)
                Box3F convexBox = eopList->mConvex->getBoundingBox();
                if (testBox.isOverlapped(convexBox))
                {
+                  CollisionStats::count( CollisionStats::ConvexPolyList, eopList->mConvex );
                   eopList->mConvex->getPolyList(&sEarlyOutPolyList);
                   if (sEarlyOutPolyList.isEmpty() == false)
                      break;
@@ -882,6 +884,7 @@ void Item::updatePos(const U32 /*mask*/, const F32 dt)
                Box3F convexBox = pList->mConvex->getBoundingBox();
                if (testBox.isOverlapped(convexBox))
                {
+                  CollisionStats::count( CollisionStats::ConvexPolyList, pList->mConvex );
                   pList->mConvex->getPolyList(&sExtrudedPolyList);
                }
             }
@@ -1060,7 +1063,7 @@ U32 Item::packUpdate(NetConnection *connection, U32 mask, BitStream *stream)
    if (mask & ThrowSrcMask && mCollisionObject) {
       S32 gIndex = connection->getGhostIndex(mCollisionObject);
       if (stream->writeFlag(gIndex != -1))
-         stream->writeInt(gIndex,NetConnection::GhostIdBitSize);
+         NetConnection::writeGhostIndex(stream, gIndex);
    }
    else
       stream->writeFlag(false);
@@ -1100,7 +1103,7 @@ void Item::unpackUpdate(NetConnection *connection, BitStream *stream)
 
    // ThrowSrcMask && mCollisionObject
    if (stream->readFlag()) {
-      S32 gIndex = stream->readInt(NetConnection::GhostIdBitSize);
+      S32 gIndex = NetConnection::readGhostIndex(stream);
       setCollisionTimeout(static_cast<ShapeBase*>(connection->resolveGhost(gIndex)));
    }
 
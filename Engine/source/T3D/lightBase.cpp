@@ -62,6 +62,7 @@ ConsoleDocClass( LightBase,
 
 LightBase::LightBase()
    :  mIsEnabled( true ),
+      mBakedOnly( false ),
       mColor( LinearColorF::WHITE ),
       mBrightness( 1.0f ),
       mCastShadows( false ),
@@ -95,6 +96,7 @@ void LightBase::initPersistFields()
    addGroup( "Light" );
       
       addField( "isEnabled", TypeBool, Offset( mIsEnabled, LightBase ), "Enables/Disables the object rendering and functionality in the scene." );
+      addField( "bakedOnly", TypeBool, Offset( mBakedOnly, LightBase ), "If true the light is only baked into IrradianceVolumes and is not rendered at runtime." );
       addField( "color", TypeColorF, Offset( mColor, LightBase ), "Changes the base color hue of the light." );
       addField( "brightness", TypeF32, Offset( mBrightness, LightBase ), "Adjusts the lights power, 0 being off completely." );      
       addField( "castShadows", TypeBool, Offset( mCastShadows, LightBase ), "Enables/disabled shadow casts by this light." );
@@ -158,7 +160,7 @@ void LightBase::onRemove()
 
 void LightBase::submitLights( LightManager *lm, bool staticLighting )
 {
-   if ( !mIsEnabled || staticLighting )
+   if ( !mIsEnabled || mBakedOnly || staticLighting )
       return;
 
    if (  mAnimState.active && 
@@ -195,7 +197,7 @@ void LightBase::setTransform( const MatrixF &mat )
 
 void LightBase::prepRenderImage( SceneRenderState *state )
 {
-   if ( mIsEnabled && mFlareData )
+   if ( mIsEnabled && !mBakedOnly && mFlareData )
    {
       mFlareState.fullBrightness = mBrightness;
       mFlareState.scale = mFlareScale;
@@ -287,6 +289,7 @@ U32 LightBase::packUpdate( NetConnection *conn, U32 mask, BitStream *stream )
       stream->write( mBrightness );
 
       stream->writeFlag( mCastShadows );
+      stream->writeFlag( mBakedOnly );
       stream->write(mStaticRefreshFreq);
       stream->write(mDynamicRefreshFreq);
 
@@ -334,6 +337,7 @@ void LightBase::unpackUpdate( NetConnection *conn, BitStream *stream )
       stream->read( &mColor );
       stream->read( &mBrightness );      
       mCastShadows = stream->readFlag();
+      mBakedOnly = stream->readFlag();
       stream->read(&mStaticRefreshFreq);
       stream->read(&mDynamicRefreshFreq);
 
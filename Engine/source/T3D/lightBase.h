@@ -56,6 +56,10 @@ protected:
 
    bool mIsEnabled;
 
+   /// If true the light only contributes to baked
+   /// lighting like IrradianceVolumes.
+   bool mBakedOnly;
+
    LinearColorF mColor;
 
    F32 mBrightness;
@@ -133,6 +137,9 @@ public:
    void setLightEnabled( bool enabled );
    bool getLightEnabled() { return mIsEnabled; };
 
+   /// Returns true if the light is only used for baked lighting.
+   bool isBakedOnly() const { return mBakedOnly; }
+
    /// Animate the light.
    virtual void pauseAnimation( void );
    virtual void playAnimation( void );
@@ -293,27 +293,33 @@ bool LightFlareData::_testVisibility(const SceneRenderState *state, LightFlareSt
    // for one-shot initialization of LightFlareState
    if ( useOcclusionQuery )
    {
-      // Always treat light as onscreen if using HOQ
-      // it will be faded out if offscreen anyway.
-      onScreen = true;
-      needsRaycast = false;
-
       // Test the hardware queries for rendered pixels.
       U32 pixels = 0, fullPixels = 0;
       GFXOcclusionQuery::OcclusionQueryStatus status;
-      flareState->occlusionQuery.getLastStatus( false, &status, &pixels );      
-      flareState->fullPixelQuery.getLastStatus( false, NULL, &fullPixels );
-      
-      if ( status == GFXOcclusionQuery::NotOccluded && fullPixels != 0 )
-         *outOcclusionFade = mClampF( (F32)pixels / (F32)fullPixels, 0.0f, 1.0f );
+      flareState->occlusionQuery.getLastStatus( &status, &pixels );      
+      flareState->fullPixelQuery.getLastStatus( NULL, &fullPixels );
+
+      // Until the first result comes back, or if the device
+      // has no queries, fall back to the raycast.
+      if ( status != GFXOcclusionQuery::Unset )
+      {
+         // Always treat light as onscreen if using HOQ
+         // it will be faded out if offscreen anyway.
+         onScreen = true;
+         needsRaycast = false;
+
+         if ( status == GFXOcclusionQuery::NotOccluded && fullPixels != 0 )
+            *outOcclusionFade = mClampF( (F32)pixels / (F32)fullPixels, 0.0f, 1.0f );
+      }
 
-        if( !flareState->occlusionQuery.isWaiting() )
+      GFXOcclusionQuery *query = flareState->occlusionQuery.getQuery();
+        if( query )
         {
             // Setup the new queries.
             RenderPassManager *rpm = state->getRenderPass();
             OccluderRenderInst *ri = rpm->allocInst<OccluderRenderInst>();   
             ri->type = RenderPassManager::RIT_Occluder;
-            ri->query = flareState->occlusionQuery.getQuery();
+            ri->query = query;
             ri->query2 = flareState->fullPixelQuery.getQuery();
             ri->isSphere = true;
             ri->position = lightPos;
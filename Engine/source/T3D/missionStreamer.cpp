@@ -0,0 +1,500 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "T3D/missionStreamer.h"
+
+#include "console/consoleTypes.h"
+#include "console/engineAPI.h"
+#include "console/simSet.h"
+#include "core/stream/fileStream.h"
+#include "core/util/tDictionary.h"
+#include "math/mathIO.h"
+#include "persistence/taml/taml.h"
+#include "scene/sceneObject.h"
+#include "T3D/gameBase/gameConnection.h"
+#include "T3D/objectTypes.h"
+#include "platform/profiler.h"
+
+IMPLEMENT_CONOBJECT( MissionStreamer );
+
+ConsoleDocClass( MissionStreamer,
+   "@brief Streams the spatial chunks of a binary mission file in and out by distance.\n\n"
+
+   "Write the mission with writeStreamedMission(), then create a MissionStreamer on the "
+   "server and call load() in place of executing the mission file.  Chunks within "
+   "loadDistance of any client camera are loaded and those beyond unloadDistance of "
+   "every camera are deleted.  Clients receive the streamed objects through ghosting.\n\n"
+
+   "@tsexample\n"
+   "writeStreamedMission( MissionGroup, \"levels/big.mis.chunks\", 256 );\n\n"
+   "new MissionStreamer( TheStreamer )\n"
+   "{\n"
+   "   missionFile = \"levels/big.mis.chunks\";\n"
+   "   loadDistance = 500;\n"
+   "   unloadDistance = 600;\n"
+   "};\n"
+   "TheStreamer.load();\n"
+   "@endtsexample\n\n"
+
+   "@ingroup enviroMisc\n"
+);
+
+static const char *sMissionStreamerSignature = "TorqueMissionChunks";
+
+//-----------------------------------------------------------------------------
+
+MissionStreamer::MissionStreamer()
+   :  mMissionFile( StringTable->EmptyString() ),
+      mLoadDistance( 500.0f ),
+      mUnloadDistance( 600.0f ),
+      mMaxLoadsPerTick( 1 ),
+      mChunkSize( 0.0f )
+{
+   // Nothing to stream until load() succeeds.
+   setProcessTicks( false );
+}
+
+void MissionStreamer::initPersistFields()
+{
+   addGroup( "MissionStreamer" );
+
+      addField( "missionFile", TypeStringFilename, Offset( mMissionFile, MissionStreamer ),
+         "The chunked binary mission file written by writeStreamedMission()." );
+
+      addField( "loadDistance", TypeF32, Offset( mLoadDistance, MissionStreamer ),
+         "Chunks within this distance of a client camera are loaded." );
+
+      addField( "unloadDistance", TypeF32, Offset( mUnloadDistance, MissionStreamer ),
+         "Chunks beyond this distance from every client camera are unloaded.  "
+         "Should be larger than loadDistance to avoid thrashing at the boundary." );
+
+      addField( "maxLoadsPerTick", TypeS32, Offset( mMaxLoadsPerTick, MissionStreamer ),
+         "The maximum number of chunks loaded in a single tick." );
+
+   endGroup( "MissionStreamer" );
+
+   Parent::initPersistFields();
+}
+
+void MissionStreamer::onRemove()
+{
+   setProcessTicks( false );
+
+   Parent::onRemove();
+}
+
+//-----------------------------------------------------------------------------
+
+SimGroup* MissionStreamer::load()
+{
+   PROFILE_SCOPE( MissionStreamer_Load );
+
+   // Release anything from a previous load.
+   for ( U32 i = 0; i < mChunks.size(); i++ )
+      _unloadChunk( mChunks[i] );
+   mChunks.clear();
+   mMissionGroup = NULL;
+   setProcessTicks( false );
+
+   char path[1024];
+   Con::expandScriptFilename( path, sizeof( path ), mMissionFile );
+
+   FileStream stream;
+   if ( !stream.open( path, Torque::FS::File::Read ) )
+   {
+      Con::errorf( "MissionStreamer::load - Could not open '%s'.", path );
+      return NULL;
+   }
+
+   // Read the header.
+   char signature[256];
+   stream.readString( signature );
+   U32 version = 0;
+   stream.read( &version );
+   if ( dStrcmp( signature, sMissionStreamerSignature ) != 0 || version != FileVersion )
+   {
+      Con::errorf( "MissionStreamer::load - '%s' is not a chunked mission file.", path );
+      return NULL;
+   }
+
+   U32 chunkCount = 0;
+   stream.read( &mChunkSize );
+   stream.read( &chunkCount );
+
+   // Read the chunk index.
+   mChunks.setSize( chunkCount );
+   for ( U32 i = 0; i < chunkCount; i++ )
+   {
+      Chunk &chunk = mChunks[i];
+      stream.read( &chunk.x );
+      stream.read( &chunk.y );
+      mathRead( stream, &chunk.bounds );
+      stream.read( &chunk.offset );
+      stream.read( &chunk.size );
+   }
+
+   if ( stream.getStatus() != Stream::Ok )
+   {
+      Con::errorf( "MissionStreamer::load - The chunk index in '%s' is truncated.", path );
+      mChunks.clear();
+      return NULL;
+   }
+
+   // The resident mission group follows the index.
+   Taml taml;
+   taml.setFormatMode( Taml::BinaryFormat );
+   SimObject *resident = taml.readStream( stream );
+
+   SimGroup *missionGroup = dynamic_cast<SimGroup*>( resident );
+   if ( !missionGroup )
+   {
+      Con::errorf( "MissionStreamer::load - Could not read the mission group from '%s'.", path );
+      if ( resident )
+         resident->deleteObject();
+      mChunks.clear();
+      return NULL;
+   }
+
+   mMissionGroup = missionGroup;
+   setProcessTicks( true );
+
+   return missionGroup;
+}
+
+//-----------------------------------------------------------------------------
+
+bool MissionStreamer::_loadChunk( Chunk &chunk )
+{
+   PROFILE_SCOPE( MissionStreamer_LoadChunk );
+
+   char path[1024];
+   Con::expandScriptFilename( path, sizeof( path ), mMissionFile );
+
+   FileStream stream;
+   if ( !stream.open( path, Torque::FS::File::Read ) || !stream.setPosition( chunk.offset ) )
+      return false;
+
+   Taml taml;
+   taml.setFormatMode( Taml::BinaryFormat );
+   SimObject *object = taml.readStream( stream );
+
+   SimSet *set = dynamic_cast<SimSet*>( object );
+   if ( !set )
+   {
+      Con::errorf( "MissionStreamer::_loadChunk - Could not read chunk ( %d, %d ) from '%s'.", chunk.x, chunk.y, path );
+      if ( object )
+         object->deleteObject();
+      return false;
+   }
+
+   // Move the objects into a group owned by the mission.
+   SimGroup *group = new SimGroup;
+   group->registerObject();
+   group->setInternalName( StringTable->insert( String::ToString( "Chunk_%d_%d", chunk.x, chunk.y ) ) );
+
+   for ( SimSet::iterator itr = set->begin(); itr != set->end(); itr++ )
+      group->addObject( *itr );
+
+   set->deleteObject();
+
+   if ( mMissionGroup )
+      mMissionGroup->addObject( group );
+
+   chunk.group = group;
+
+   return true;
+}
+
+void MissionStreamer::_unloadChunk( Chunk &chunk )
+{
+   if ( chunk.group )
+      chunk.group->deleteObject();
+
+   chunk.group = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void MissionStreamer::_gatherFocusPoints( Vector<Point3F> &outPoints ) const
+{
+   SimGroup *clients = Sim::getClientGroup();
+   for ( SimGroup::iterator itr = clients->begin(); itr != clients->end(); itr++ )
+   {
+      GameConnection *connection = dynamic_cast<GameConnection*>( *itr );
+      if ( !connection )
+         continue;
+
+      GameBase *camera = connection->getCameraObject();
+      if ( camera )
+         outPoints.push_back( camera->getPosition() );
+   }
+}
+
+void MissionStreamer::processTick()
+{
+   Vector<Point3F> points;
+   _gatherFocusPoints( points );
+
+   update( points );
+}
+
+void MissionStreamer::update( const Vector<Point3F> &points )
+{
+   PROFILE_SCOPE( MissionStreamer_Update );
+
+   // Without any cameras keep whatever is loaded.
+   if ( points.empty() )
+      return;
+
+   const F32 loadDistSq = mSquared( mLoadDistance );
+   const F32 unloadDistSq = mSquared( getMax( mLoadDistance, mUnloadDistance ) );
+
+   S32 loads = 0;
+
+   for ( U32 i = 0; i < mChunks.size(); i++ )
+   {
+      Chunk &chunk = mChunks[i];
+
+      F32 minDistSq = F32_MAX;
+      for ( U32 j = 0; j < points.size(); j++ )
+         minDistSq = getMin( minDistSq, chunk.bounds.getSqDistanceToPoint( points[j] ) );
+
+      if ( chunk.group )
+      {
+         if ( minDistSq > unloadDistSq )
+            _unloadChunk( chunk );
+      }
+      else if ( minDistSq < loadDistSq && loads < mMaxLoadsPerTick )
+      {
+         _loadChunk( chunk );
+         loads++;
+      }
+   }
+}
+
+U32 MissionStreamer::getLoadedChunkCount() const
+{
+   U32 count = 0;
+   for ( U32 i = 0; i < mChunks.size(); i++ )
+   {
+      if ( mChunks[i].group )
+         count++;
+   }
+
+   return count;
+}
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+   struct ChunkedObject
+   {
+      SceneObject *object;
+      SimGroup *parent;
+   };
+
+   /// Finds the unnamed static objects which fit inside a chunk.
+   void _gatherChunkedObjects( SimGroup *group, F32 chunkSize, Vector<ChunkedObject> &outObjects )
+   {
+      for ( SimGroup::iterator itr = group->begin(); itr != group->end(); itr++ )
+      {
+         SimGroup *childGroup = dynamic_cast<SimGroup*>( *itr );
+         if ( childGroup )
+         {
+            _gatherChunkedObjects( childGroup, chunkSize, outObjects );
+            continue;
+         }
+
+         SceneObject *object = dynamic_cast<SceneObject*>( *itr );
+         if ( !object || object->getName() || object->isGlobalBounds() ||
+              !( object->getTypeMask() & StaticObjectType ) )
+            continue;
+
+         const Point3F extents = object->getWorldBox().getExtents();
+         if ( extents.x > chunkSize || extents.y > chunkSize )
+            continue;
+
+         ChunkedObject entry;
+         entry.object = object;
+         entry.parent = group;
+         outObjects.push_back( entry );
+      }
+   }
+
+   void _writeChunkIndex( Stream &stream, const Vector<MissionStreamer::Chunk> &chunks )
+   {
+      for ( U32 i = 0; i < chunks.size(); i++ )
+      {
+         const MissionStreamer::Chunk &chunk = chunks[i];
+         stream.write( chunk.x );
+         stream.write( chunk.y );
+         mathWrite( stream, chunk.bounds );
+         stream.write( chunk.offset );
+         stream.write( chunk.size );
+      }
+   }
+}
+
+bool MissionStreamer::writeMission( SimGroup *missionGroup, const char *fileName, F32 chunkSize )
+{
+   PROFILE_SCOPE( MissionStreamer_WriteMission );
+
+   if ( !missionGroup || chunkSize <= 0.0f )
+      return false;
+
+   Vector<ChunkedObject> objects;
+   _gatherChunkedObjects( missionGroup, chunkSize, objects );
+
+   // Bin the objects into chunks by the center of their bounds.
+   typedef HashMap<U64, U32> ChunkLookup;
+   ChunkLookup lookup;
+   Vector<Chunk> chunks;
+   Vector<U32> objectChunks( objects.size() );
+
+   for ( U32 i = 0; i < objects.size(); i++ )
+   {
+      const Box3F &worldBox = objects[i].object->getWorldBox();
+      const Point3F center = worldBox.getCenter();
+      const S32 x = (S32)mFloor( center.x / chunkSize );
+      const S32 y = (S32)mFloor( center.y / chunkSize );
+      const U64 key = ( U64( U32( x ) ) << 32 ) | U32( y );
+
+      ChunkLookup::iterator itr = lookup.find( key );
+      if ( itr == lookup.end() )
+      {
+         Chunk chunk;
+         chunk.x = x;
+         chunk.y = y;
+         chunk.bounds = worldBox;
+         chunk.offset = 0;
+         chunk.size = 0;
+
+         itr = lookup.insert( key, chunks.size() );
+         chunks.push_back( chunk );
+      }
+      else
+         chunks[ itr->value ].bounds.intersect( worldBox );
+
+      objectChunks.push_back( itr->value );
+   }
+
+   char path[1024];
+   Con::expandScriptFilename( path, sizeof( path ), fileName );
+
+   FileStream stream;
+   if ( !stream.open( path, Torque::FS::File::Write ) )
+   {
+      Con::errorf( "MissionStreamer::writeMission - Could not open '%s' for writing.", path );
+      return false;
+   }
+
+   // Take the chunked objects out of the mission so the resident
+   // group is written without them.
+   for ( U32 i = 0; i < objects.size(); i++ )
+      objects[i].parent->removeObject( objects[i].object );
+
+   stream.writeString( sMissionStreamerSignature );
+   stream.write( (U32)FileVersion );
+   stream.write( chunkSize );
+   stream.write( (U32)chunks.size() );
+
+   // Reserve the index, it is rewritten once the chunk offsets are known.
+   const U32 indexPosition = stream.getPosition();
+   _writeChunkIndex( stream, chunks );
+
+   Taml taml;
+   taml.setFormatMode( Taml::BinaryFormat );
+   taml.setBinaryCompression( true );
+
+   bool success = taml.writeStream( stream, missionGroup );
+
+   for ( U32 i = 0; i < chunks.size() && success; i++ )
+   {
+      SimSet *set = new SimSet;
+      set->registerObject();
+
+      for ( U32 j = 0; j < objects.size(); j++ )
+      {
+         if ( objectChunks[j] == i )
+            set->addObject( objects[j].object );
+      }
+
+      chunks[i].offset = stream.getPosition();
+      success = taml.writeStream( stream, set );
+      chunks[i].size = stream.getPosition() - chunks[i].offset;
+
+      set->deleteObject();
+   }
+
+   if ( success )
+   {
+      stream.setPosition( indexPosition );
+      _writeChunkIndex( stream, chunks );
+   }
+
+   stream.close();
+
+   // Put the chunked objects back.
+   for ( U32 i = 0; i < objects.size(); i++ )
+      objects[i].parent->addObject( objects[i].object );
+
+   if ( !success )
+      Con::errorf( "MissionStreamer::writeMission - Failed writing '%s'.", path );
+
+   return success;
+}
+
+//-----------------------------------------------------------------------------
+
+DefineEngineMethod( MissionStreamer, load, SimGroup*, (),,
+   "Reads the chunk index and the resident mission group and begins streaming.\n"
+   "@return The resident mission group or 0 on failure." )
+{
+   return object->load();
+}
+
+DefineEngineMethod( MissionStreamer, getChunkCount, S32, (),,
+   "Returns the number of chunks in the mission file." )
+{
+   return object->getChunkCount();
+}
+
+DefineEngineMethod( MissionStreamer, getLoadedChunkCount, S32, (),,
+   "Returns the number of chunks currently loaded." )
+{
+   return object->getLoadedChunkCount();
+}
+
+DefineEngineFunction( writeStreamedMission, bool, ( SimGroup *missionGroup, const char *fileName, F32 chunkSize ), ( 256.0f ),
+   "Writes a mission group to a chunked binary mission file for use with MissionStreamer.\n\n"
+   "Unnamed static objects which fit inside a chunk are split into chunks by position, "
+   "everything else is written to the resident mission group.\n"
+   "@param missionGroup The mission group to write.\n"
+   "@param fileName The file to write.\n"
+   "@param chunkSize The width and depth of a chunk in world units.\n"
+   "@return True if the file was written.\n"
+   "@ingroup enviroMisc" )
+{
+   return MissionStreamer::writeMission( missionGroup, fileName, chunkSize );
+}
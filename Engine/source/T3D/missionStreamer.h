@@ -0,0 +1,132 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _MISSIONSTREAMER_H_
+#define _MISSIONSTREAMER_H_
+
+#ifndef _SIMOBJECT_H_
+   #include "console/simObject.h"
+#endif
+#ifndef _ITICKABLE_H_
+   #include "core/iTickable.h"
+#endif
+#ifndef _MBOX_H_
+   #include "math/mBox.h"
+#endif
+#ifndef _TVECTOR_H_
+   #include "core/util/tVector.h"
+#endif
+
+class SimGroup;
+
+/// Loads a mission written by MissionStreamer::writeMission() and streams its
+/// spatial chunks in and out around the cameras of the connected clients.
+///
+/// The file holds the mission group, minus the chunked objects, followed by one
+/// binary Taml block per chunk and an index of chunk bounds and offsets.  Only
+/// static objects which fit inside a chunk are chunked; everything else stays
+/// resident so script lookups such as spawn groups keep working.  Clients see
+/// streamed objects through normal ghosting.
+class MissionStreamer : public SimObject, public ITickable
+{
+   typedef SimObject Parent;
+
+public:
+
+   enum Constants
+   {
+      FileVersion = 1,
+   };
+
+   /// An entry in the chunk index.
+   struct Chunk
+   {
+      S32 x;
+      S32 y;
+      Box3F bounds;
+      U32 offset;
+      U32 size;
+
+      /// The loaded chunk group, if any.
+      SimObjectPtr<SimGroup> group;
+   };
+
+protected:
+
+   /// The streamed mission file.
+   StringTableEntry mMissionFile;
+
+   /// Chunks are loaded within this distance of a camera.
+   F32 mLoadDistance;
+
+   /// Chunks are unloaded beyond this distance from every camera.
+   F32 mUnloadDistance;
+
+   /// The maximum number of chunks loaded in one tick.
+   S32 mMaxLoadsPerTick;
+
+   F32 mChunkSize;
+   Vector<Chunk> mChunks;
+
+   /// The resident mission group which chunk groups are added to.
+   SimObjectPtr<SimGroup> mMissionGroup;
+
+   bool _loadChunk( Chunk &chunk );
+   void _unloadChunk( Chunk &chunk );
+   void _gatherFocusPoints( Vector<Point3F> &outPoints ) const;
+
+   // ITickable
+   virtual void interpolateTick( F32 delta ) {}
+   virtual void processTick();
+   virtual void advanceTime( F32 timeDelta ) {}
+
+public:
+
+   MissionStreamer();
+
+   DECLARE_CONOBJECT( MissionStreamer );
+   DECLARE_CATEGORY( "Misc" );
+   DECLARE_DESCRIPTION( "Streams the chunks of a binary mission file by distance." );
+
+   static void initPersistFields();
+
+   // SimObject
+   virtual void onRemove();
+
+   /// Reads the index and the resident mission group.
+   /// @return The resident mission group or NULL on failure.
+   SimGroup* load();
+
+   /// Loads and unloads chunks around the given points.
+   void update( const Vector<Point3F> &points );
+
+   /// Returns the number of chunks currently loaded.
+   U32 getLoadedChunkCount() const;
+
+   U32 getChunkCount() const { return mChunks.size(); }
+
+   /// Writes the mission group to a chunked binary mission file.
+   static bool writeMission( SimGroup *missionGroup, const char *fileName, F32 chunkSize );
+};
+
+#endif // _MISSIONSTREAMER_H_
@@ -162,6 +162,8 @@ void BtBody::setMaterial(  F32 restitution,
 {
    AssertFatal( mActor, "BtBody::setMaterial - The actor is null!" );
 
+   mWorld->waitForStep();
+
    mActor->setRestitution( restitution );
 
    // TODO: Weird.. Bullet doesn't have seperate dynamic 
@@ -180,12 +182,18 @@ void BtBody::setMaterial(  F32 restitution,
 void BtBody::setSleepThreshold( F32 linear, F32 angular )
 {
    AssertFatal( mActor, "BtBody::setSleepThreshold - The actor is null!" );
+
+   mWorld->waitForStep();
+
    mActor->setSleepingThresholds( linear, angular );
 }
 
 void BtBody::setDamping( F32 linear, F32 angular )
 {
    AssertFatal( mActor, "BtBody::setDamping - The actor is null!" );
+
+   mWorld->waitForStep();
+
    mActor->setDamping( linear, angular );
 }
 
@@ -193,6 +201,8 @@ void BtBody::getState( PhysicsState *outState )
 {
    AssertFatal( isDynamic(), "BtBody::getState - This call is only for dynamics!" );
 
+   mWorld->waitForStep();
+
    // TODO: Fix this to do what we intended... to return
    // false so that the caller can early out of the state
    // hasn't changed since the last tick.
@@ -216,6 +226,9 @@ void BtBody::getState( PhysicsState *outState )
 Point3F BtBody::getCMassPosition() const
 {
    AssertFatal( mActor, "BtBody::getCMassPosition - The actor is null!" );
+
+   mWorld->waitForStep();
+
    return btCast<Point3F>( mActor->getCenterOfMassTransform().getOrigin() );
 }
 
@@ -224,6 +237,8 @@ void BtBody::setLinVelocity( const Point3F &vel )
    AssertFatal( mActor, "BtBody::setLinVelocity - The actor is null!" );
    AssertFatal( isDynamic(), "BtBody::setLinVelocity - This call is only for dynamics!" );
 
+   mWorld->waitForStep();
+
    mActor->setLinearVelocity( btCast<btVector3>( vel ) );
 }
 
@@ -232,6 +247,8 @@ void BtBody::setAngVelocity( const Point3F &vel )
    AssertFatal( mActor, "BtBody::setAngVelocity - The actor is null!" );
    AssertFatal( isDynamic(), "BtBody::setAngVelocity - This call is only for dynamics!" );
 
+   mWorld->waitForStep();
+
    mActor->setAngularVelocity( btCast<btVector3>( vel ) );
 }
 
@@ -240,6 +257,8 @@ Point3F BtBody::getLinVelocity() const
    AssertFatal( mActor, "BtBody::getLinVelocity - The actor is null!" );
    AssertFatal( isDynamic(), "BtBody::getLinVelocity - This call is only for dynamics!" );
 
+   mWorld->waitForStep();
+
    return btCast<Point3F>( mActor->getLinearVelocity() );
 }
 
@@ -248,6 +267,8 @@ Point3F BtBody::getAngVelocity() const
    AssertFatal( mActor, "BtBody::getAngVelocity - The actor is null!" );
    AssertFatal( isDynamic(), "BtBody::getAngVelocity - This call is only for dynamics!" );
 
+   mWorld->waitForStep();
+
    return btCast<Point3F>( mActor->getAngularVelocity() );
 }
 
@@ -256,6 +277,8 @@ void BtBody::setSleeping( bool sleeping )
    AssertFatal( mActor, "BtBody::setSleeping - The actor is null!" );
    AssertFatal( isDynamic(), "BtBody::setSleeping - This call is only for dynamics!" );
 
+   mWorld->waitForStep();
+
    if ( sleeping )
    {
       //mActor->setCollisionFlags( mActor->getCollisionFlags() | btCollisionObject::CF_KINEMATIC_OBJECT );
@@ -283,6 +306,8 @@ MatrixF& BtBody::getTransform( MatrixF *outMatrix )
 {
    AssertFatal( mActor, "BtBody::getTransform - The actor is null!" );
 
+   mWorld->waitForStep();
+
    if ( mInvCenterOfMass )
       outMatrix->mul( *mInvCenterOfMass, btCast<MatrixF>( mActor->getCenterOfMassTransform() ) );
    else
@@ -295,6 +320,8 @@ void BtBody::setTransform( const MatrixF &transform )
 {
    AssertFatal( mActor, "BtBody::setTransform - The actor is null!" );
 
+   mWorld->waitForStep();
+
    if ( mCenterOfMass )
    {
       MatrixF xfm;
@@ -320,6 +347,8 @@ void BtBody::applyCorrection( const MatrixF &transform )
    AssertFatal( mActor, "BtBody::applyCorrection - The actor is null!" );
    AssertFatal( isDynamic(), "BtBody::applyCorrection - This call is only for dynamics!" );
 
+   mWorld->waitForStep();
+
    if ( mCenterOfMass )
    {
       MatrixF xfm;
@@ -335,6 +364,8 @@ void BtBody::applyImpulse( const Point3F &origin, const Point3F &force )
    AssertFatal( mActor, "BtBody::applyImpulse - The actor is null!" );
    AssertFatal( isDynamic(), "BtBody::applyImpulse - This call is only for dynamics!" );
 
+   mWorld->waitForStep();
+
    // Convert the world position to local
    MatrixF trans = btCast<MatrixF>( mActor->getCenterOfMassTransform() );
    trans.inverse();
@@ -361,6 +392,8 @@ void BtBody::applyTorque( const Point3F &torque )
    AssertFatal(mActor, "BtBody::applyTorque - The actor is null!");
    AssertFatal(isDynamic(), "BtBody::applyTorque - This call is only for dynamics!");
 
+   mWorld->waitForStep();
+
    mActor->applyTorque( btCast<btVector3>(torque) );
 
    if (!mActor->isActive())
@@ -372,6 +405,8 @@ void BtBody::applyForce( const Point3F &force )
    AssertFatal(mActor, "BtBody::applyForce - The actor is null!");
    AssertFatal(isDynamic(), "BtBody::applyForce - This call is only for dynamics!");
 
+   mWorld->waitForStep();
+
    if (mCenterOfMass)
    {
       Point3F relForce(force);
@@ -387,6 +422,8 @@ void BtBody::applyForce( const Point3F &force )
 
 Box3F BtBody::getWorldBounds()
 {   
+   mWorld->waitForStep();
+
    btVector3 min, max;
    mActor->getAabb( min, max );
 
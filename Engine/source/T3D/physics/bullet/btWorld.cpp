@@ -41,7 +41,9 @@ BtWorld::BtWorld() :
    mTickCount( 0 ),
    mIsEnabled( false ),
    mEditorTimeScale( 1.0f ),
-   mDynamicsWorld( NULL )
+   mDynamicsWorld( NULL ),
+   mStepDone( 0 ),
+   mStepPending( false )
 {
 } 
 
@@ -87,6 +89,9 @@ bool BtWorld::initWorld( bool isServer, ProcessList *processList )
 
 void BtWorld::_destroy()
 {
+   // Never free the world under a running step.
+   waitForStep();
+
    // Release the tick processing signals.
    if ( mProcessList )
    {
@@ -123,8 +128,16 @@ void BtWorld::tickPhysics( U32 elapsedMs )
    // Convert it to seconds.
    const F32 elapsedSec = (F32)elapsedMs * 0.001f;
 
-   // Simulate
-   mDynamicsWorld->stepSimulation( elapsedSec * mEditorTimeScale, smPhysicsMaxSubSteps, smPhysicsStepTime);
+   // Simulate... when async the step runs on the thread pool
+   // while the next tick is processed and is collected in
+   // getPhysicsResults() or by the first access to the world.
+   if ( PhysicsPlugin::isAsyncSimulation() )
+   {
+      mStepPending = true;
+      ThreadPool::GLOBAL().queueWorkItem( new StepWorkItem( this, elapsedSec * mEditorTimeScale ) );
+   }
+   else
+      _stepSimulation( elapsedSec * mEditorTimeScale );
 
    mIsSimulating = true;
 
@@ -139,11 +152,37 @@ void BtWorld::getPhysicsResults()
    PROFILE_SCOPE(BtWorld_GetPhysicsResults);
 
    // Get results from scene.
-  // mScene->fetchResults( NX_RIGID_BODY_FINISHED, true );
+   waitForStep();
    mIsSimulating = false;
    mTickCount++;
 }
 
+void BtWorld::_stepSimulation( F32 elapsedSec )
+{
+   mDynamicsWorld->stepSimulation( elapsedSec, smPhysicsMaxSubSteps, smPhysicsStepTime );
+}
+
+void BtWorld::StepWorkItem::execute()
+{
+   // Match the fpu state of the main thread so
+   // the simulation stays deterministic.
+   Platform::setMathControlStateKnown();
+
+   mWorld->_stepSimulation( mElapsedSec );
+   mWorld->mStepDone.release();
+}
+
+void BtWorld::waitForStep()
+{
+   if ( !mStepPending )
+      return;
+
+   PROFILE_SCOPE(BtWorld_WaitForStep);
+
+   mStepDone.acquire();
+   mStepPending = false;
+}
+
 void BtWorld::setEnabled( bool enabled )
 {
    mIsEnabled = enabled;
@@ -159,6 +198,8 @@ void BtWorld::destroyWorld()
 
 bool BtWorld::castRay( const Point3F &startPnt, const Point3F &endPnt, RayInfo *ri, const Point3F &impulse )
 {
+   waitForStep();
+
    btCollisionWorld::ClosestRayResultCallback result( btCast<btVector3>( startPnt ), btCast<btVector3>( endPnt ) );
    mDynamicsWorld->rayTest( btCast<btVector3>( startPnt ), btCast<btVector3>( endPnt ), result );
 
@@ -203,6 +244,8 @@ PhysicsBody* BtWorld::castRay( const Point3F &start, const Point3F &end, U32 bod
    btVector3 startPt = btCast<btVector3>( start );
    btVector3 endPt = btCast<btVector3>( end );
 
+   waitForStep();
+
    btCollisionWorld::ClosestRayResultCallback result( startPt, endPt );
    mDynamicsWorld->rayTest( startPt, endPt, result );
 
@@ -253,6 +296,8 @@ void BtWorld::explosion( const Point3F &pos, F32 radius, F32 forceMagnitude )
 
 void BtWorld::onDebugDraw( const SceneRenderState *state )
 {
+   waitForStep();
+
    mDebugDraw.setCuller( &state->getCullingFrustum() );
 
    mDynamicsWorld->setDebugDrawer( &mDebugDraw );
@@ -267,6 +312,8 @@ void BtWorld::reset()
    if ( !mDynamicsWorld )
       return;
 
+   waitForStep();
+
     ///create a copy of the array, not a reference!
     btCollisionObjectArray copyArray = mDynamicsWorld->getCollisionObjectArray();
 
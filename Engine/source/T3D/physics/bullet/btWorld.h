@@ -35,6 +35,12 @@
 #ifndef _TVECTOR_H_
 #include "core/util/tVector.h"
 #endif
+#ifndef _THREADPOOL_H_
+#include "platform/threads/threadPool.h"
+#endif
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
 
 class ProcessList;
 class PhysicsBody;
@@ -64,6 +70,37 @@ protected:
 
    ProcessList *mProcessList;
 
+   /// The work item which steps the world on the
+   /// thread pool when async simulation is enabled.
+   class StepWorkItem : public ThreadPool::WorkItem
+   {
+   protected:
+
+      BtWorld *mWorld;
+
+      F32 mElapsedSec;
+
+      // WorkItem
+      virtual void execute();
+
+   public:
+
+      StepWorkItem( BtWorld *world, F32 elapsedSec )
+         :  mWorld( world ),
+            mElapsedSec( elapsedSec )
+      {
+      }
+   };
+
+   /// Released by the StepWorkItem when the step is done.
+   Semaphore mStepDone;
+
+   /// Is an async step queued or running?
+   bool mStepPending;
+
+   /// Steps the dynamics world.
+   void _stepSimulation( F32 elapsedSec );
+
    void _destroy();
 
 public:
@@ -81,7 +118,14 @@ public:
    virtual void reset();
    virtual bool isEnabled() const { return mIsEnabled; }
 
-   btDynamicsWorld* getDynamicsWorld() const { return mDynamicsWorld; }
+   /// Returns the dynamics world after waiting for any
+   /// pending async step to finish.
+   btDynamicsWorld* getDynamicsWorld() { waitForStep(); return mDynamicsWorld; }
+
+   /// Blocks until an async step started in tickPhysics() has
+   /// completed.  This must be called before touching any Bullet
+   /// object in this world outside of the tick processing.
+   void waitForStep();
 
    void tickPhysics( U32 elapsedMs );
    void getPhysicsResults();
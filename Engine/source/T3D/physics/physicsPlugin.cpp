@@ -40,6 +40,8 @@ PhysicsPlugin* PhysicsPlugin::smSingleton = NULL;
 PhysicsResetSignal PhysicsPlugin::smPhysicsResetSignal;
 bool PhysicsPlugin::smSinglePlayer = false;
 U32 PhysicsPlugin::smThreadCount = 2;
+bool PhysicsPlugin::smAsyncSimulation = true;
+bool PhysicsPlugin::smUseEngineThreads = true;
 
 
 String PhysicsPlugin::smServerWorldName( "server" );
@@ -55,6 +57,17 @@ AFTER_MODULE_INIT( Sim )
       "@brief Number of threads to use in a single pass of the physics engine.\n\n"
       "Defaults to 2 if not set.\n\n"
 	   "@ingroup Physics\n");
+   Con::addVariable( "$pref::Physics::asyncSimulation", TypeBool, &PhysicsPlugin::smAsyncSimulation, 
+      "@brief Run the physics world step on a worker thread while the next game tick is processed.\n\n"
+      "Results are always synchronized before any physics object is accessed, so this "
+      "only changes performance and not the simulation.  Defaults to true.\n\n"
+	   "@ingroup Physics\n");
+   Con::addVariable( "$pref::Physics::useEngineThreads", TypeBool, &PhysicsPlugin::smUseEngineThreads, 
+      "@brief Run the physics engine tasks on the engine thread pool instead of its own threads.\n\n"
+      "This avoids oversubscribing the cpu with two sets of worker threads.  Only used by "
+      "plugins which support it and takes effect the next time the plugin is initialized.  "
+      "Defaults to true.\n\n"
+	   "@ingroup Physics\n");
 }
 
 bool PhysicsPlugin::activate( const char *library )
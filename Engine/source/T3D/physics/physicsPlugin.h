@@ -92,6 +92,17 @@ public:
    static U32 smThreadCount;
    static U32 getThreadCount() { return smThreadCount; }
 
+   /// If true and supported by the plugin the world step is run
+   /// on a worker thread overlapping the next game tick.
+   static bool smAsyncSimulation;
+   static bool isAsyncSimulation() { return smAsyncSimulation; }
+
+   /// If true and supported by the plugin the physics tasks
+   /// are run on the engine thread pool instead of threads
+   /// owned by the physics SDK.
+   static bool smUseEngineThreads;
+   static bool useEngineThreads() { return smUseEngineThreads; }
+
    /// Returns the active physics plugin.
    /// @see PHYSICSPLUGIN
    static PhysicsPlugin* getSingleton() { return smSingleton; }
@@ -931,6 +931,21 @@ void PhysicsShape::processTick( const Move *move )
    if ( !mPhysicsRep->isDynamic() )
       return;
 
+   // On the server distant shapes are taken out of the physics world
+   // when outside the interest area of every client and otherwise only
+   // read back their state and update clients at reduced rate.
+   if ( isServerObject() )
+   {
+      const U32 lodTicks = SimulationLOD::update( this, &mSimLOD );
+
+      const bool suspended = mSimLOD.level == SimulationLOD::Suspended;
+      if ( suspended == mPhysicsRep->isSimulationEnabled() )
+         mPhysicsRep->setSimulationEnabled( !suspended );
+
+      if ( lodTicks == 0 )
+         return;
+   }
+
    // SINGLE PLAYER HACK!!!!
    if ( PHYSICSMGR->isSinglePlayer() && isClientObject() && getServerObject() )
    {          
@@ -1137,12 +1152,10 @@ void PhysicsShape::destroy()
 
    if ( db->explosion )
    {
-      Explosion *splod = new Explosion();
-      splod->setDataBlock( db->explosion );
+      Explosion *splod = Explosion::create( db->explosion );
       splod->setTransform( mat );
       splod->setInitialState( getPosition(), mat.getUpVector(), 1.0f );
-      if ( !splod->registerObject() )
-         delete splod;
+      splod->spawn();
    }   
 }
 
@@ -41,6 +41,9 @@
 #ifndef _SIMOBJECTREF_H_
    #include "console/simObjectRef.h"
 #endif
+#ifndef _SIMULATIONLOD_H_
+   #include "T3D/gameBase/simulationLOD.h"
+#endif
 
 class TSShapeInstance;
 class PhysicsBody;
@@ -173,6 +176,9 @@ protected:
    /// The previous and current render states.
    PhysicsState mRenderState[2];
 
+   /// Server side simulation level of detail.
+   SimulationLOD::State mSimLOD;
+
    /// True if the PhysicsShape has been destroyed ( gameplay ).
    bool mDestroyed;
 
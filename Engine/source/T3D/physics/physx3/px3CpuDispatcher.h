@@ -0,0 +1,67 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _PX3CPUDISPATCHER_H_
+#define _PX3CPUDISPATCHER_H_
+
+#ifndef _PHYSX3_H_
+#include "T3D/physics/physx3/px3.h"
+#endif
+#ifndef _THREADPOOL_H_
+#include "platform/threads/threadPool.h"
+#endif
+
+
+/// A PhysX cpu dispatcher which runs the simulation tasks
+/// on the engine thread pool instead of spinning up its own
+/// set of worker threads competing with the engine's.
+class Px3CpuDispatcher : public physx::PxCpuDispatcher
+{
+protected:
+
+   /// Runs a single PhysX task.
+   class TaskWorkItem : public ThreadPool::WorkItem
+   {
+   protected:
+
+      physx::PxBaseTask *mTask;
+
+      // WorkItem
+      virtual void execute();
+
+   public:
+
+      TaskWorkItem( physx::PxBaseTask *task )
+         : mTask( task )
+      {
+      }
+   };
+
+public:
+
+   // PxCpuDispatcher
+   virtual void submitTask( physx::PxBaseTask &task );
+   virtual physx::PxU32 getWorkerCount() const;
+};
+
+#endif // _PX3CPUDISPATCHER_H_
@@ -27,6 +27,7 @@
 #include "T3D/physics/physx3/px3Plugin.h"
 #include "T3D/physics/physx3/px3Casts.h"
 #include "T3D/physics/physx3/px3Stream.h"
+#include "T3D/physics/physx3/px3CpuDispatcher.h"
 #include "T3D/physics/physicsUserData.h"
 
 #include "console/engineAPI.h"
@@ -47,6 +48,7 @@ physx::PxCooking* Px3World::smCooking = NULL;
 physx::PxFoundation* Px3World::smFoundation = NULL;
 physx::PxProfileZoneManager* Px3World::smProfileZoneManager = NULL;
 physx::PxDefaultCpuDispatcher* Px3World::smCpuDispatcher=NULL;
+Px3CpuDispatcher* Px3World::smEngineCpuDispatcher=NULL;
 Px3ConsoleStream* Px3World::smErrorCallback = NULL;
 physx::PxVisualDebuggerConnection* Px3World::smPvdConnection=NULL;
 physx::PxDefaultAllocator Px3World::smMemoryAlloc;
@@ -88,7 +90,12 @@ bool Px3World::restartSDK( bool destroyOnly, Px3World *clientWorld, Px3World *se
       smCooking->release();
 
    if(smCpuDispatcher)
+   {
       smCpuDispatcher->release();
+      smCpuDispatcher = NULL;
+   }
+
+   SAFE_DELETE(smEngineCpuDispatcher);
 
    // Destroy the existing SDK.
    if ( gPhysics3SDK )
@@ -210,12 +217,24 @@ bool Px3World::initWorld( bool isServer, ProcessList *processList )
    sceneDesc.userData = this;
    if(!sceneDesc.cpuDispatcher)
    {
-      //Create shared cpu dispatcher
-      if(!smCpuDispatcher)
-         smCpuDispatcher = physx::PxDefaultCpuDispatcherCreate(PHYSICSMGR->getThreadCount());
- 
-      sceneDesc.cpuDispatcher = smCpuDispatcher;
-      Con::printf("PhysX3 using Cpu: %d workers", smCpuDispatcher->getWorkerCount());
+      //Create shared cpu dispatcher, either running the tasks
+      //on the engine thread pool or on threads owned by PhysX.
+      if(PhysicsPlugin::useEngineThreads())
+      {
+         if(!smEngineCpuDispatcher)
+            smEngineCpuDispatcher = new Px3CpuDispatcher;
+
+         sceneDesc.cpuDispatcher = smEngineCpuDispatcher;
+      }
+      else
+      {
+         if(!smCpuDispatcher)
+            smCpuDispatcher = physx::PxDefaultCpuDispatcherCreate(PHYSICSMGR->getThreadCount());
+
+         sceneDesc.cpuDispatcher = smCpuDispatcher;
+      }
+
+      Con::printf("PhysX3 using Cpu: %d workers", sceneDesc.cpuDispatcher->getWorkerCount());
    }
    
    sceneDesc.flags |= physx::PxSceneFlag::eENABLE_CCD;
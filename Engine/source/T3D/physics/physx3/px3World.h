@@ -37,6 +37,7 @@
 #endif
 
 class Px3ConsoleStream;
+class Px3CpuDispatcher;
 class Px3ContactReporter;
 class FixedStepper;
 
@@ -69,6 +70,7 @@ protected:
    static physx::PxCooking *smCooking;
    static physx::PxProfileZoneManager* smProfileZoneManager;
    static physx::PxDefaultCpuDispatcher* smCpuDispatcher;
+   static Px3CpuDispatcher* smEngineCpuDispatcher;
    static physx::PxVisualDebuggerConnection* smPvdConnection;
    F32 mAccumulator;
    bool _simulate(const F32 dt);
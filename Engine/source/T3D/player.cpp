@@ -39,6 +39,7 @@
 #include "collision/extrudedPolyList.h"
 #include "collision/clippedPolyList.h"
 #include "collision/earlyOutPolyList.h"
+#include "collision/collisionStats.h"
 #include "ts/tsShapeInstance.h"
 #include "sfx/sfxSystem.h"
 #include "sfx/sfxTrack.h"
@@ -1635,6 +1636,8 @@ Player::Player()
    mConvex.init(this);
    mWorkingQueryBox.minExtents.set(-1e9f, -1e9f, -1e9f);
    mWorkingQueryBox.maxExtents.set(-1e9f, -1e9f, -1e9f);
+   mPreparedQueryLogId = 0;
+   mPreparedQueryLogSize = 0;
 
    mWeaponBackFraction = 0.0f;
 
@@ -2152,7 +2155,7 @@ void Player::processTick(const Move* move)
       {
          if ( !mPhysicsRep )
          {
-            if ( isMounted() )
+            if ( isMounted() || isMovingWithoutCollision() )
             {
                // If we're mounted then do not perform any collision checks
                // and clear our previous working list.
@@ -4753,7 +4756,10 @@ bool Player::step(Point3F *pos,F32 *maxStep,F32 time)
       {
          Box3F convexBox = pConvex->getBoundingBox();
          if (box.isOverlapped(convexBox))
+         {
+            CollisionStats::count( CollisionStats::ConvexPolyList, pConvex );
             pConvex->getPolyList(&polyList);
+         }
       }
       pList = pList->wLink.mNext;
    }
@@ -4869,6 +4875,7 @@ Point3F Player::_move( const F32 travelTime, Collision *outCol )
                {
                   // No need to separate out the physical zones here, we want those
                   //  to cause a fallthrough as well...
+                  CollisionStats::count( CollisionStats::ConvexPolyList, pConvex );
                   pConvex->getPolyList(&eaPolyList);
                }
             }
@@ -4913,6 +4920,7 @@ Point3F Player::_move( const F32 travelTime, Collision *outCol )
             Box3F convexBox = pConvex->getBoundingBox();
             if (plistBox.isOverlapped(convexBox))
             {
+               CollisionStats::count( CollisionStats::ConvexPolyList, pConvex );
                if (pConvex->getObject()->getTypeMask() & PhysicalZoneObjectType)
                   pConvex->getPolyList(&sPhysZonePolyList);
                else
@@ -5302,7 +5310,10 @@ void Player::_findContact( SceneObject **contactObject,
       {
          Box3F convexBox = pConvex->getBoundingBox();
          if (plistBox.isOverlapped(convexBox))
+         {
+            CollisionStats::count( CollisionStats::ConvexPolyList, pConvex );
             pConvex->getPolyList(&polyList);
+         }
       }
       else
          outOverlapObjects->push_back( pConvex->getObject() );
@@ -6106,7 +6117,7 @@ void Player::buildConvex(const Box3F& box, Convex* convex)
 
 //----------------------------------------------------------------------------
 
-void Player::updateWorkingCollisionSet()
+bool Player::_getWorkingQueryBox( Box3F* outBox )
 {
    // First, we need to adjust our velocity for possible acceleration.  It is assumed
    // that we will never accelerate more than 20 m/s for gravity, plus 10 m/s for
@@ -6141,18 +6152,81 @@ void Player::updateWorkingCollisionSet()
       // Must update
       updateSet = true;
    }
-   // Actually perform the query, if necessary
    if (updateSet == true) {
       const Point3F  twolPoint( 2.0f * l, 2.0f * l, 2.0f * l );
-      mWorkingQueryBox = convexBox;
-      mWorkingQueryBox.minExtents -= twolPoint;
-      mWorkingQueryBox.maxExtents += twolPoint;
+      *outBox = convexBox;
+      outBox->minExtents -= twolPoint;
+      outBox->maxExtents += twolPoint;
+   }
 
-      disableCollision();
-      mConvex.updateWorkingList(mWorkingQueryBox,
-         isGhost() ? sClientCollisionContactMask : sServerCollisionContactMask);
-      enableCollision();
+   return updateSet;
+}
+
+void Player::updateWorkingCollisionSet()
+{
+   // Use up the prepared query, whether it fits or not.
+   const U32 preparedLogId = mPreparedQueryLogId;
+   mPreparedQueryLogId = 0;
+
+   // Actually perform the query, if necessary
+   Box3F queryBox;
+   if ( !_getWorkingQueryBox( &queryBox ) )
+      return;
+
+   mWorkingQueryBox = queryBox;
+
+   const U32 mask = isGhost() ? sClientCollisionContactMask : sServerCollisionContactMask;
+
+   // The prepared query can stand in for the real one if it covered the same
+   // bounds and nothing that ticked before us changed its outcome.
+   const bool usePrepared = preparedLogId &&
+      mPreparedQueryBox.minExtents == mWorkingQueryBox.minExtents &&
+      mPreparedQueryBox.maxExtents == mWorkingQueryBox.maxExtents &&
+      getContainer()->isQueryUnchanged( preparedLogId, mPreparedQueryLogSize, mWorkingQueryBox,
+                                        mask, mPreparedQueryList, this );
+
+   disableCollision();
+   if ( usePrepared )
+      mConvex.updateWorkingList(mWorkingQueryBox, mPreparedQueryList);
+   else
+      mConvex.updateWorkingList(mWorkingQueryBox, mask);
+   enableCollision();
+}
+
+void Player::prepareTick()
+{
+   mPreparedQueryLogId = 0;
+
+   // Mirror the conditions under which processTick() updates the working
+   // set on the server.  The container only tracks the changes needed to
+   // validate the query while the server process list is ticking.
+   if ( !isServerObject() || mPhysicsRep || isMounted() || !getContainer() )
+      return;
+
+   const U32 logId = getContainer()->getChangeLogId();
+   if ( !logId )
+      return;
+
+   Box3F queryBox;
+   if ( !_getWorkingQueryBox( &queryBox ) )
+      return;
+
+   mPreparedQueryList.clear();
+   getContainer()->findObjectList( queryBox, sServerCollisionContactMask, &mPreparedQueryList );
+
+   // The real query runs with our own collision disabled.
+   for ( U32 i = 0; i < mPreparedQueryList.size(); i++ )
+   {
+      if ( mPreparedQueryList[i] == this )
+      {
+         mPreparedQueryList.erase( i );
+         break;
+      }
    }
+
+   mPreparedQueryBox = queryBox;
+   mPreparedQueryLogSize = getContainer()->getChangeLogSize();
+   mPreparedQueryLogId = logId;
 }
 
 
@@ -6203,7 +6277,7 @@ void Player::writePacketData(GameConnection *connection, BitStream *stream)
    if (mControlObject) {
       S32 gIndex = connection->getGhostIndex(mControlObject);
       if (stream->writeFlag(gIndex != -1)) {
-         stream->writeInt(gIndex,NetConnection::GhostIdBitSize);
+         NetConnection::writeGhostIndex(stream, gIndex);
          mControlObject->writePacketData(connection, stream);
       }
    }
@@ -6273,7 +6347,7 @@ void Player::readPacketData(GameConnection *connection, BitStream *stream)
    delta.rot = rot;
 
    if (stream->readFlag()) {
-      S32 gIndex = stream->readInt(NetConnection::GhostIdBitSize);
+      S32 gIndex = NetConnection::readGhostIndex(stream);
       ShapeBase* obj = static_cast<ShapeBase*>(connection->resolveGhost(gIndex));
       setControlObject(obj);
       obj->readPacketData(connection, stream);
@@ -7225,12 +7299,10 @@ void Player::createSplash( Point3F &pos, F32 speed )
    {
       MatrixF trans = getTransform();
       trans.setPosition( pos );
-      Splash *splash = new Splash;
-      splash->onNewDataBlock( mDataBlock->splash, false );
+      Splash *splash = Splash::create( mDataBlock->splash );
       splash->setTransform( trans );
       splash->setInitialState( trans.getPosition(), Point3F( 0.0, 0.0, 1.0 ) );
-      if (!splash->registerObject())
-         delete splash;
+      splash->spawn();
    }
 }
 
@@ -580,6 +580,19 @@ protected:
    OrthoBoxConvex mConvex;
    Box3F          mWorkingQueryBox;
 
+   /// @name Prepared Working Set
+   /// Working set query run ahead of the tick by prepareTick().
+   /// @{
+   Box3F          mPreparedQueryBox;
+   Vector<SceneObject*> mPreparedQueryList;
+   U32            mPreparedQueryLogId;    ///< Container change log id of the query or 0 if there is none.
+   U32            mPreparedQueryLogSize;  ///< Container change log size at the time of the query.
+   /// @}
+
+   /// Return true if the working collision set needs to be rebuilt and
+   /// store the bounds to query in @a outBox.
+   bool _getWorkingQueryBox( Box3F* outBox );
+
    /// Standing / Crouched / Prone or Swimming   
    Pose getPose() const { return mPose; }
    virtual const char* getPoseName() const;
@@ -614,6 +627,10 @@ protected:
    void _handleCollision( const Collision &collision );
    virtual bool updatePos(const F32 travelTime = TickSec);
 
+   /// Return true if updatePos() moves the player without collision this
+   /// tick, so the working collision set does not need to be gathered.
+   virtual bool isMovingWithoutCollision() const { return false; }
+
    ///Update head animation
    void updateLookAnimation(F32 dT = 0.f);
 
@@ -769,6 +786,7 @@ public:
    
    //
    void updateWorkingCollisionSet();
+   virtual void prepareTick();
    virtual void processTick(const Move *move);
    void interpolateTick(F32 delta);
    void advanceTime(F32 dt);
@@ -782,6 +800,7 @@ public:
    void readPacketData (GameConnection *conn, BitStream *stream);
    U32  packUpdate  (NetConnection *conn, U32 mask, BitStream *stream);
    void unpackUpdate(NetConnection *conn,           BitStream *stream);
+   bool usesSnapshotDeltas() const { return true; }
 
    virtual void prepRenderImage( SceneRenderState* state );
    virtual void renderConvex( ObjectRenderInst *ri, SceneRenderState *state, BaseMatInstance *overrideMat );   
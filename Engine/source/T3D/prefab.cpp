@@ -38,6 +38,41 @@
 // while loading prefab files that contain other prefabs.
 static Vector<String> sPrefabFileStack;
 
+// Prefab files are usually placed many times in a level.  Rather than
+// executing the file again for each copy, a Prefab whose children are
+// plain static objects is remembered here so later ones clone them.
+struct PrefabFileSource
+{
+   SimObjectId prefabId;
+   Torque::Time modTime;
+};
+static Map<String,PrefabFileSource> sPrefabFileSources;
+
+/// Returns true if @a group only holds unnamed static scene objects, which
+/// are safe to clone in place of executing the prefab file.
+static bool _isSharableGroup( SimGroup *group )
+{
+   for ( SimGroup::iterator itr = group->begin(); itr != group->end(); itr++ )
+   {
+      SimObject *object = *itr;
+      if ( object->getName() && object->getName()[0] )
+         return false;
+
+      if ( object->getClassRep() == SimGroup::getStaticClassRep() )
+      {
+         if ( !_isSharableGroup( static_cast<SimGroup*>( object ) ) )
+            return false;
+         continue;
+      }
+
+      SceneObject *sceneObject = dynamic_cast<SceneObject*>( object );
+      if ( !sceneObject || !( sceneObject->getTypeMask() & StaticObjectType ) )
+         return false;
+   }
+
+   return true;
+}
+
 Map<SimObjectId,SimObjectId> Prefab::smChildToPrefabMap;
 
 IMPLEMENT_CO_NETOBJECT_V1(Prefab);
@@ -280,6 +315,8 @@ SimGroup* Prefab::explode()
    if ( !mChildGroup )
       return NULL;
 
+   _releaseSource();
+
    SimGroup *group = mChildGroup;
    Vector<SceneObject*> foundObjects;
 
@@ -306,6 +343,8 @@ void Prefab::_closeFile( bool removeFileNotify )
 {
    AssertFatal( isServerObject(), "Prefab-bad" );
 
+   _releaseSource();
+
    mChildMap.clear();
 
    if ( mChildGroup )
@@ -353,14 +392,26 @@ void Prefab::_loadFile( bool addFileNotify )
 
    sPrefabFileStack.push_back(mFilename);
 
-   String command = String::ToString( "exec( \"%s\" );", mFilename.c_str() );
-   Con::evaluate( command );
+   Torque::Time modTime;
+   Torque::FS::FileNodeRef fileNode = Torque::FS::GetFileNode( mFilename );
+   if ( fileNode )
+      modTime = fileNode->getModifiedTime();
+
+   // Cloning fills in mChildMap itself.
+   SimGroup *group = _cloneFromSource( modTime );
+   const bool cloned = group != NULL;
 
-   SimGroup *group;
-   if ( !Sim::findObject( Con::getVariable( "$ThisPrefab" ), group ) )
+   if ( !cloned )
    {
-      Con::errorf( "Prefab::_loadFile() - file %s did not create $ThisPrefab.", mFilename.c_str() );
-      return;
+      String command = String::ToString( "exec( \"%s\" );", mFilename.c_str() );
+      Con::evaluate( command );
+
+      if ( !Sim::findObject( Con::getVariable( "$ThisPrefab" ), group ) )
+      {
+         Con::errorf( "Prefab::_loadFile() - file %s did not create $ThisPrefab.", mFilename.c_str() );
+         sPrefabFileStack.pop_back();
+         return;
+      }
    }
 
    if ( addFileNotify )
@@ -378,7 +429,8 @@ void Prefab::_loadFile( bool addFileNotify )
       for ( S32 i = 0; i < foundObjects.size(); i++ )
       {
          SceneObject *child = foundObjects[i];
-         mChildMap.insert( child->getId(), Transform( child->getTransform(), child->getScale() ) );
+         if ( !cloned )
+            mChildMap.insert( child->getId(), Transform( child->getTransform(), child->getScale() ) );
          smChildToPrefabMap.insert( child->getId(), getId() );
 
          _updateChildTransform( child );
@@ -391,9 +443,69 @@ void Prefab::_loadFile( bool addFileNotify )
 
    sPrefabFileStack.pop_back();
 
+   // Scripts may customize the children in onLoad so only offer them
+   // for cloning when there is no such callback.
+   if ( !cloned && !isMethod( "onLoad" ) && _isSharableGroup( mChildGroup ) )
+   {
+      PrefabFileSource source;
+      source.prefabId = getId();
+      source.modTime = modTime;
+      sPrefabFileSources[ mFilename ] = source;
+   }
+
    onLoad_callback( mChildGroup );
 }
 
+SimGroup* Prefab::_cloneFromSource( const Torque::Time &modTime )
+{
+   Map<String,PrefabFileSource>::Iterator itr = sPrefabFileSources.find( mFilename );
+   if ( itr == sPrefabFileSources.end() )
+      return NULL;
+
+   Prefab *source;
+   if ( itr->value.modTime != modTime ||
+        !Sim::findObject( itr->value.prefabId, source ) ||
+        !source->mChildGroup )
+   {
+      sPrefabFileSources.erase( itr );
+      return NULL;
+   }
+
+   PROFILE_SCOPE( Prefab_cloneFromSource );
+
+   SimGroup *group = source->mChildGroup->deepClone();
+   if ( !group )
+      return NULL;
+
+   // The clones are in the same order as their originals so they can
+   // take over the transforms the originals had in the file.
+   Vector<SceneObject*> sourceObjects, foundObjects;
+   source->mChildGroup->findObjectByType( sourceObjects );
+   group->findObjectByType( foundObjects );
+
+   if ( sourceObjects.size() != foundObjects.size() )
+   {
+      group->deleteObject();
+      return NULL;
+   }
+
+   for ( S32 i = 0; i < foundObjects.size(); i++ )
+   {
+      ChildToMatMap::Iterator child = source->mChildMap.find( sourceObjects[i]->getId() );
+      AssertFatal( child != source->mChildMap.end(), "Prefab, mChildMap out of synch with mChildGroup." );
+      mChildMap.insert( foundObjects[i]->getId(), child->value );
+   }
+
+   return group;
+}
+
+void Prefab::_releaseSource()
+{
+   Map<String,PrefabFileSource>::Iterator itr = sPrefabFileSources.find( mFilename );
+   if ( itr != sPrefabFileSources.end() && itr->value.prefabId == getId() )
+      sPrefabFileSources.erase( itr );
+}
+
 void Prefab::_updateChildTransform( SceneObject* child )
 {
    ChildToMatMap::Iterator itr = mChildMap.find(child->getId());
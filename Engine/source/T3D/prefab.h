@@ -29,6 +29,9 @@
 #ifndef _PATH_H_
    #include "core/util/path.h"
 #endif
+#ifndef _TIMECLASS_H_
+   #include "core/util/timeClass.h"
+#endif
 #ifndef _UNDO_H_
    #include "util/undo.h"
 #endif
@@ -106,6 +109,13 @@ protected:
    void _updateChildren();
    void _onFileChanged( const Torque::Path &path );
 
+   /// Creates our children by cloning those of another Prefab which
+   /// loaded the same, unmodified file.  Returns NULL if there is none.
+   SimGroup* _cloneFromSource( const Torque::Time &modTime );
+
+   /// Stops other Prefab(s) from cloning our children.
+   void _releaseSource();
+
    static bool protectedSetFile( void *object, const char *index, const char *data );
 
    /// @name Callbacks
@@ -139,6 +139,187 @@ const U32 Projectile::csmDamageableMask = Projectile::csmDynamicCollisionMask;
 
 U32 Projectile::smProjectileWarpTicks = 5;
 
+bool Projectile::smBatchSweeps = true;
+
+
+//--------------------------------------------------------------------------
+
+/// Sweeps all projectiles of one process list through the container with
+/// a single batched ray cast at the start of every tick.
+class ProjectileManager
+{
+protected:
+
+   ProcessList *mProcessList;
+
+   Vector< Projectile* > mProjectiles;
+
+   /// Scratch space for the sweep.
+   Vector< SceneContainer::RayQuery > mQueries;
+   Vector< RayInfo > mResults;
+   Vector< Projectile* > mSwept;
+
+   void _onPreTick();
+
+public:
+
+   ProjectileManager() : mProcessList( NULL ) {}
+
+   void addProjectile( Projectile *projectile );
+   void removeProjectile( Projectile *projectile );
+
+   static ProjectileManager smClient;
+   static ProjectileManager smServer;
+};
+
+ProjectileManager ProjectileManager::smClient;
+ProjectileManager ProjectileManager::smServer;
+
+void ProjectileManager::addProjectile( Projectile *projectile )
+{
+   // The process lists live for the lifetime of
+   // the app, so we only hook up to it once.
+   if ( !mProcessList )
+   {
+      mProcessList = projectile->getProcessList();
+      mProcessList->preTickSignal().notify( this, &ProjectileManager::_onPreTick );
+   }
+
+   mProjectiles.push_back( projectile );
+}
+
+void ProjectileManager::removeProjectile( Projectile *projectile )
+{
+   mProjectiles.remove( projectile );
+}
+
+void ProjectileManager::_onPreTick()
+{
+   if ( !Projectile::smBatchSweeps || mProjectiles.empty() )
+      return;
+
+   PROFILE_SCOPE( ProjectileManager_onPreTick );
+
+   mQueries.clear();
+   mSwept.clear();
+
+   SceneContainer *container = NULL;
+   for ( U32 i = 0; i < mProjectiles.size(); i++ )
+   {
+      Projectile *projectile = mProjectiles[i];
+
+      mQueries.increment();
+      if ( !projectile->_prepareSweep( &mQueries.last() ) )
+      {
+         mQueries.decrement();
+         continue;
+      }
+
+      mSwept.push_back( projectile );
+      container = projectile->getContainer();
+   }
+
+   if ( mSwept.empty() )
+      return;
+
+   mResults.setSize( mSwept.size() );
+   for ( U32 i = 0; i < mResults.size(); i++ )
+      mResults[i] = RayInfo();
+
+   container->castRayBatch( mQueries.address(), mQueries.size(), mResults.address() );
+
+   for ( U32 i = 0; i < mSwept.size(); i++ )
+   {
+      Projectile::Sweep &sweep = mSwept[i]->mSweep;
+      sweep.valid = true;
+      sweep.hit = mResults[i].object != NULL;
+      sweep.info = mResults[i];
+      sweep.object = mResults[i].object;
+   }
+}
+
+//--------------------------------------------------------------------------
+
+/// Recycles the memory of Projectile instances.  Projectiles are only
+/// created and deleted on the main thread.  Subclasses have a different
+/// size and fall back to the default pool.
+class ProjectilePool : public IEngineObjectPool
+{
+protected:
+
+   /// Blocks ready for reuse linked through their first word.
+   void *mFreeList;
+
+   U32 mNumFree;
+
+   /// Blocks beyond this are returned to the default pool.
+   static const U32 smMaxFree = 512;
+
+public:
+
+   ProjectilePool()
+      :  mFreeList( NULL ),
+         mNumFree( 0 )
+   {
+   }
+
+   virtual ~ProjectilePool()
+   {
+      while ( mFreeList )
+      {
+         void *ptr = mFreeList;
+         mFreeList = *reinterpret_cast< void** >( ptr );
+         IEngineObjectPool::DEFAULT->freeObject( ptr );
+      }
+   }
+
+   // IEngineObjectPool
+   virtual void* allocateObject( U32 size TORQUE_TMM_ARGS_DECL )
+   {
+      if ( size != sizeof( Projectile ) )
+         return NULL;
+
+      if ( !mFreeList )
+         return IEngineObjectPool::DEFAULT->allocateObject( size TORQUE_TMM_ARGS );
+
+      void *ptr = mFreeList;
+      mFreeList = *reinterpret_cast< void** >( ptr );
+      mNumFree--;
+      return ptr;
+   }
+
+   virtual void freeObject( void *ptr )
+   {
+      if ( mNumFree >= smMaxFree )
+      {
+         IEngineObjectPool::DEFAULT->freeObject( ptr );
+         return;
+      }
+
+      *reinterpret_cast< void** >( ptr ) = mFreeList;
+      mFreeList = ptr;
+      mNumFree++;
+   }
+};
+
+static ProjectilePool sProjectilePool;
+
+#include "platform/tmm_off.h"
+
+#ifndef TORQUE_DISABLE_MEMORY_MANAGER
+void* Projectile::operator new( size_t size )
+{
+   return Parent::operator new( size, static_cast< IEngineObjectPool* >( &sProjectilePool ) );
+}
+#endif
+
+void* Projectile::operator new( size_t size TORQUE_TMM_ARGS_DECL )
+{
+   return Parent::operator new( size, static_cast< IEngineObjectPool* >( &sProjectilePool ) TORQUE_TMM_ARGS );
+}
+
+#include "platform/tmm_on.h"
+
 
 //--------------------------------------------------------------------------
 //
@@ -670,6 +851,12 @@ void Projectile::initPersistFields()
 
 
    Parent::initPersistFields();
+
+   Con::addVariable( "$Projectile::batchSweeps", TypeBool, &smBatchSweeps,
+      "@brief Sweep all projectiles through the scene with one batched ray cast per tick.\n\n"
+      "When disabled every projectile casts its own ray during its tick.  Projectiles in a "
+      "physics world always cast their own ray.\n\n"
+      "@ingroup GameObjects\n" );
 }
 
 bool Projectile::_setInitialPosition( void *object, const char *index, const char *data )
@@ -841,6 +1028,11 @@ bool Projectile::onAdd()
    if ( PHYSICSMGR )
       mPhysicsWorld = PHYSICSMGR->getWorld( isServerObject() ? "server" : "client" );
 
+   if ( isServerObject() )
+      ProjectileManager::smServer.addProjectile( this );
+   else
+      ProjectileManager::smClient.addProjectile( this );
+
    return true;
 }
 
@@ -861,6 +1053,11 @@ void Projectile::onRemove()
 
    SFX_DELETE( mSound );
 
+   if ( isServerObject() )
+      ProjectileManager::smServer.removeProjectile( this );
+   else
+      ProjectileManager::smClient.removeProjectile( this );
+
    removeFromScene();
    Parent::onRemove();
 }
@@ -966,15 +1163,10 @@ void Projectile::emitParticles(const Point3F& from, const Point3F& to, const Poi
          MatrixF trans = getTransform();
          trans.setPosition(rInfo.point);
 
-         Splash *splash = new Splash();
-         splash->onNewDataBlock(mDataBlock->splash, false);
+         Splash *splash = Splash::create(mDataBlock->splash);
          splash->setTransform(trans);
          splash->setInitialState(trans.getPosition(), Point3F(0.0, 0.0, 1.0));
-         if (!splash->registerObject())
-         {
-            delete splash;
-            splash = NULL;
-         }
+         splash->spawn();
 
          // create an emitter for the particles out of water and the particles in water
          if (mParticleEmitter)
@@ -994,15 +1186,10 @@ void Projectile::emitParticles(const Point3F& from, const Point3F& to, const Poi
          MatrixF trans = getTransform();
          trans.setPosition(rInfo.point);
 
-         Splash *splash = new Splash();
-         splash->onNewDataBlock(mDataBlock->splash,false);
+         Splash *splash = Splash::create(mDataBlock->splash);
          splash->setTransform(trans);
          splash->setInitialState(trans.getPosition(), Point3F(0.0, 0.0, 1.0));
-         if (!splash->registerObject())
-         {
-            delete splash;
-            splash = NULL;
-         }
+         splash->spawn();
 
          // create an emitter for the particles out of water and the particles in water
          if (mParticleEmitter)
@@ -1047,14 +1234,12 @@ void Projectile::explode( const Point3F &p, const Point3F &n, const U32 collideT
 
       if (mDataBlock->waterExplosion && pointInWater(p))
       {
-         pExplosion = new Explosion;
-         pExplosion->onNewDataBlock(mDataBlock->waterExplosion, false);
+         pExplosion = Explosion::create(mDataBlock->waterExplosion);
       }
       else
       if (mDataBlock->explosion)
       {
-         pExplosion = new Explosion;
-         pExplosion->onNewDataBlock(mDataBlock->explosion, false);
+         pExplosion = Explosion::create(mDataBlock->explosion);
       }
 
       if( pExplosion )
@@ -1064,11 +1249,10 @@ void Projectile::explode( const Point3F &p, const Point3F &n, const U32 collideT
          pExplosion->setTransform(xform);
          pExplosion->setInitialState(explodePos, n);
          pExplosion->setCollideType( collideType );
-         if (pExplosion->registerObject() == false)
+         if (pExplosion->spawn() == false)
          {
             Con::errorf(ConsoleLogEntry::General, "Projectile(%s)::explode: couldn't register explosion",
                         mDataBlock->getName() );
-            delete pExplosion;
             pExplosion = NULL;
          }
       }
@@ -1159,11 +1343,23 @@ void Projectile::simulate( F32 dt )
    // Raycast the abstract PhysicsWorld if a PhysicsPlugin exists.
    bool hit = false;
 
-   if ( mPhysicsWorld )
+   // Use the result of the batched sweep if it covered the exact
+   // same path and the object it hit is still around.
+   if (  mSweep.valid && 
+         mSweep.start == oldPosition && mSweep.end == newPosition &&
+         ( !mSweep.hit || mSweep.object.isValid() ) )
+   {
+      hit = mSweep.hit;
+      rInfo = mSweep.info;
+      rInfo.object = mSweep.object;
+   }
+   else if ( mPhysicsWorld )
       hit = mPhysicsWorld->castRay( oldPosition, newPosition, &rInfo, Point3F( newPosition - oldPosition) * mDataBlock->impactForce );            
    else 
       hit = getContainer()->castRay(oldPosition, newPosition, dynamicCollisionMask | staticCollisionMask, &rInfo);
 
+   mSweep.valid = false;
+
    if ( hit )
    {
       // make sure the client knows to bounce
@@ -1256,6 +1452,45 @@ void Projectile::simulate( F32 dt )
 }
 
 
+bool Projectile::_prepareSweep( SceneContainer::RayQuery *outQuery )
+{
+   mSweep.valid = false;
+
+   if ( mHasExploded || mPhysicsWorld || !getContainer() )
+      return false;
+
+   // The next tick deletes us.
+   if ( isServerObject() && mCurrTick + 1 >= mDataBlock->lifetime )
+      return false;
+
+   // simulate() ignores the source object for a while.  The batch can
+   // ignore one object per ray, so sources with mounted objects which
+   // also get their collision disabled take the single ray path.
+   SceneObject *ignore = NULL;
+   if ( mSourceObject.isValid() && ( ignoreSourceTimeout || mCurrTick + 1 <= SourceIdTimeoutTicks ) )
+   {
+      if ( mSourceObject->getMountList() )
+         return false;
+
+      ignore = mSourceObject;
+   }
+
+   // This must match the movement in simulate().
+   Point3F velocity = mCurrVelocity;
+   if ( mDataBlock->isBallistic )
+      velocity.z -= 9.81 * mDataBlock->gravityMod * TickSec;
+
+   mSweep.start = mCurrPosition;
+   mSweep.end = mCurrPosition + velocity * TickSec;
+
+   outQuery->start = mSweep.start;
+   outQuery->end = mSweep.end;
+   outQuery->mask = dynamicCollisionMask | staticCollisionMask;
+   outQuery->ignore = ignore;
+
+   return true;
+}
+
 void Projectile::advanceTime(F32 dt)
 {
    Parent::advanceTime(dt);
@@ -43,6 +43,11 @@
 #ifndef _LIGHTINFO_H_
 #include "lighting/lightInfo.h"
 #endif
+#ifndef _COLLISION_H_
+#include "collision/collision.h"
+#endif
+
+#include "platform/tmm_off.h"
 
 
 class ExplosionData;
@@ -161,6 +166,8 @@ class Projectile : public GameBase, public ISceneLight
 {
    typedef GameBase Parent;
 
+   friend class ProjectileManager;
+
    static bool _setInitialPosition( void* object, const char* index, const char* data );
    static bool _setInitialVelocity( void* object, const char* index, const char* data );
 
@@ -185,6 +192,14 @@ public:
 
    DECLARE_CONOBJECT(Projectile);
 
+   /// Projectiles are short lived and created in large numbers, so
+   /// their memory is recycled through a pool instead of the heap.
+   #ifndef TORQUE_DISABLE_MEMORY_MANAGER
+   void* operator new( size_t size );
+   #endif
+   void* operator new( size_t size TORQUE_TMM_ARGS_DECL );
+   void* operator new( size_t size, void* ptr ) { return ptr; }
+
    // SimObject
    bool onAdd();
    void onRemove();
@@ -237,8 +252,39 @@ protected:
    static const U32 csmDamageableMask;   
    static U32 smProjectileWarpTicks;
 
+   /// If true all projectiles of a process list are swept through the
+   /// container with one SceneContainer::castRayBatch() at the start of
+   /// each tick instead of a castRay() per projectile.
+   static bool smBatchSweeps;
+
    PhysicsWorld *mPhysicsWorld;
 
+   /// The result of the batched sweep for the coming tick.
+   struct Sweep
+   {
+      /// Set by the sweep and cleared once simulate() used it.
+      bool valid;
+
+      /// The path that was swept.
+      Point3F start;
+      Point3F end;
+
+      bool hit;
+      RayInfo info;
+
+      /// Tracks the hit object in case it goes away
+      /// before the projectile ticks.
+      SimObjectPtr< SceneObject > object;
+
+      Sweep() : valid( false ), hit( false ) {}
+   };
+
+   Sweep mSweep;
+
+   /// Fill in the ray this projectile will travel along in its next
+   /// tick.  Returns false if it can't be part of the batched sweep.
+   bool _prepareSweep( SceneContainer::RayQuery *outQuery );
+
    ProjectileData* mDataBlock;
 
    SimObjectPtr< ParticleEmitter > mParticleEmitter;
@@ -293,5 +339,7 @@ public:
    U32    staticCollisionMask;
 };
 
+#include "platform/tmm_on.h"
+
 #endif // _PROJECTILE_H_
 
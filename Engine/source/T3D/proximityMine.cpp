@@ -529,19 +529,17 @@ void ProximityMine::explode()
       // Client just plays the explosion effect at the right place
       if ( mDataBlock->explosion )
       {
-         Explosion *pExplosion = new Explosion;
-         pExplosion->onNewDataBlock( mDataBlock->explosion, false );
+         Explosion *pExplosion = Explosion::create( mDataBlock->explosion );
 
          MatrixF xform( true );
          xform.setPosition( explodePos );
          pExplosion->setTransform( xform );
          pExplosion->setInitialState( explodePos, normal );
          pExplosion->setCollideType( sTriggerCollisionMask );
-         if ( pExplosion->registerObject() == false )
+         if ( pExplosion->spawn() == false )
          {
             Con::errorf( ConsoleLogEntry::General, "ProximityMine(%s)::explode: couldn't register explosion",
                          mDataBlock->getName() );
-            delete pExplosion;
          }
       }
    }
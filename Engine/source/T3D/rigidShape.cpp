@@ -766,6 +766,12 @@ void RigidShape::processTick(const Move* move)
             move = &NullMove;
       }
 
+      // Distant shapes are simulated less often or
+      // not at all on the server.
+      const U32 lodTicks = SimulationLOD::update(this, &mSimLOD);
+      if (lodTicks == 0)
+         return;
+
       // Process input move
       updateMove(move);
 
@@ -773,22 +779,28 @@ void RigidShape::processTick(const Move* move)
       mDelta.posVec = mRigid.linPosition;
       mDelta.rot[0] = mRigid.angPosition;
 
-      // Update the physics based on the integration rate
+      // Update the physics based on the integration rate.  A shape
+      // at rest doesn't run collision until something wakes it up
+      // so it doesn't need the working collision set either.
+      const bool wasAtRest = mRigid.atRest;
       S32 count = mDataBlock->integration;
-      if (!mDisableMove)
+      if (!mDisableMove && !wasAtRest)
          updateWorkingCollisionSet(getCollisionMask());
       for (U32 i = 0; i < count; i++)
-         updatePos(TickSec / count);
+         updatePos(lodTicks * TickSec / count);
 
       // Wrap up interpolation info
       mDelta.pos     = mRigid.linPosition;
       mDelta.posVec -= mRigid.linPosition;
       mDelta.rot[1]  = mRigid.angPosition;
 
-      // Update container database
-      setPosition(mRigid.linPosition, mRigid.angPosition);
-      setMaskBits(PositionMask);
-      updateContainer();
+      // Update container database unless we were and still are at rest.
+      if (!wasAtRest || !mRigid.atRest)
+      {
+         setPosition(mRigid.linPosition, mRigid.angPosition);
+         setMaskBits(PositionMask);
+         updateContainer();
+      }
    }
 }
 
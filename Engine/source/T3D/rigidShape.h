@@ -31,6 +31,9 @@
 #ifndef _BOXCONVEX_H_
 #include "collision/boxConvex.h"
 #endif
+#ifndef _SIMULATIONLOD_H_
+#include "T3D/gameBase/simulationLOD.h"
+#endif
 
 class ParticleEmitter;
 class ParticleEmitterData;
@@ -197,6 +200,9 @@ class RigidShape: public ShapeBase
    ShapeBaseConvex mConvex;
    S32 restCount;
 
+   /// Server side simulation level of detail.
+   SimulationLOD::State mSimLOD;
+
    SimObjectPtr<ParticleEmitter> mDustEmitterList[RigidShapeData::VC_NUM_DUST_EMITTERS];
    SimObjectPtr<ParticleEmitter> mSplashEmitterList[RigidShapeData::VC_NUM_SPLASH_EMITTERS];
 
@@ -0,0 +1,148 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "T3D/sfx/sfxOcclusionManager.h"
+#include "sfx/sfxSource.h"
+#include "console/sim.h"
+#include "core/module.h"
+#include "platform/profiler.h"
+
+
+MODULE_BEGIN( SFXOcclusion )
+
+   MODULE_INIT_AFTER( SFX )
+   MODULE_SHUTDOWN_BEFORE( SFX )
+
+   MODULE_INIT
+   {
+      if( SFX )
+         gSFXOcclusionManager = new SFXOcclusionManager;
+
+      Con::addVariable( "SFX::occlusionRaysPerUpdate", TypeS32, &SFXOcclusionManager::smRaysPerUpdate,
+         "@brief Maximum number of rays cast per sound update to determine the occlusion of 3D sounds.\n\n"
+         "Sources are visited in round-robin order so with more audible sources than this, each source "
+         "has its occlusion refreshed every few updates.  A value of 0 disables occlusion.  The default "
+         "value is 32.\n"
+         "@ingroup SFX" );
+   }
+
+   MODULE_SHUTDOWN
+   {
+      if( gSFXOcclusionManager )
+         SAFE_DELETE( gSFXOcclusionManager );
+   }
+
+MODULE_END;
+
+
+SFXOcclusionManager* gSFXOcclusionManager;
+S32 SFXOcclusionManager::smRaysPerUpdate = 32;
+
+
+//-----------------------------------------------------------------------------
+
+SFXOcclusionManager::SFXOcclusionManager()
+   : mNextSource( 0 )
+{
+   VECTOR_SET_ASSOCIATION( mSources );
+   VECTOR_SET_ASSOCIATION( mQueries );
+   VECTOR_SET_ASSOCIATION( mResults );
+
+   SFX->addPlugin( this );
+}
+
+//-----------------------------------------------------------------------------
+
+SFXOcclusionManager::~SFXOcclusionManager()
+{
+   if( SFX )
+      SFX->removePlugin( this );
+}
+
+//-----------------------------------------------------------------------------
+
+void SFXOcclusionManager::update()
+{
+   PROFILE_SCOPE( SFXOcclusionManager_Update );
+
+   if( smRaysPerUpdate <= 0 || !SFX->hasDevice() )
+      return;
+
+   SimSet* sources = Sim::getSFXSourceSet();
+   if( !sources || sources->empty() )
+      return;
+
+   const Point3F listenerPos = SFX->getListener().getTransform().getPosition();
+   const U32 numSources = sources->size();
+   const U32 maxRays = getMin( U32( smRaysPerUpdate ), numSources );
+
+   mSources.clear();
+   mQueries.clear();
+
+   // Pick up where the last update left off.  Sources that can't be heard
+   // don't use up the budget; they'll be looked at again when they come
+   // back into range.
+
+   for( U32 i = 0; i < numSources && mSources.size() < maxRays; ++ i )
+   {
+      if( mNextSource >= numSources )
+         mNextSource = 0;
+
+      SFXSource* source = dynamic_cast< SFXSource* >( sources->at( mNextSource ++ ) );
+      if(   !source
+         || !source->is3d()
+         || !source->isPlaying()
+         || source->getDistToListener() > source->getMaxDistance() )
+         continue;
+
+      // Stop a little short of the source so that emitters placed
+      // right on a surface aren't occluded by it.
+
+      Point3F sourcePos = source->getTransform().getPosition();
+      VectorF dir = sourcePos - listenerPos;
+      const F32 dist = dir.len();
+      if( dist < 0.5f )
+      {
+         source->setOcclusion( 0.f );
+         continue;
+      }
+      dir /= dist;
+
+      mQueries.increment();
+      SceneContainer::RayQuery& query = mQueries.last();
+      query.start = listenerPos;
+      query.end = sourcePos - dir * 0.25f;
+      query.mask = TYPEMASK;
+
+      mSources.push_back( source );
+   }
+
+   if( mSources.empty() )
+      return;
+
+   mResults.setSize( mSources.size() );
+   gClientContainer.castRayBatch( mQueries.address(), mQueries.size(), mResults.address() );
+
+   for( U32 i = 0; i < mSources.size(); ++ i )
+      mSources[ i ]->setOcclusion( mResults[ i ].object ? 1.f : 0.f );
+}
@@ -0,0 +1,96 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SFXOCCLUSIONMANAGER_H_
+#define _SFXOCCLUSIONMANAGER_H_
+
+#ifndef _SFXSYSTEM_H_
+   #include "sfx/sfxSystem.h"
+#endif
+#ifndef _SCENECONTAINER_H_
+   #include "scene/sceneContainer.h"
+#endif
+#ifndef _COLLISION_H_
+   #include "collision/collision.h"
+#endif
+#ifndef _OBJECTTYPES_H_
+   #include "T3D/objectTypes.h"
+#endif
+
+
+/// Occlusion of 3D sounds by the scene geometry.
+///
+/// Every SFX update, the manager picks the next batch of playing, in-range 3D
+/// sources in round-robin order and casts rays from the listener to all of them
+/// in a single SceneContainer::castRayBatch() call.  The results are reported to
+/// the sources through SFXSource::setOcclusion() which eases the source volume
+/// towards the new value.  Sources not visited in an update keep their last
+/// result, so the cost per update is fixed by #smRaysPerUpdate regardless of the
+/// number of sources.
+class SFXOcclusionManager : public SFXSystemPlugin
+{
+   public:
+
+      typedef SFXSystemPlugin Parent;
+
+      enum
+      {
+         /// The scene object types that block sound.
+         TYPEMASK = TerrainObjectType
+                  | StaticShapeObjectType
+                  | InteriorLikeObjectType
+                  | TerrainLikeObjectType
+      };
+
+   protected:
+
+      /// Index into the SFX source set at which the next update starts.
+      U32 mNextSource;
+
+      /// Sources queried in the current update.
+      Vector< SFXSource* > mSources;
+
+      /// Rays cast in the current update; parallel to #mSources.
+      Vector< SceneContainer::RayQuery > mQueries;
+
+      /// Ray results of the current update; parallel to #mSources.
+      Vector< RayInfo > mResults;
+
+   public:
+
+      /// Maximum number of occlusion rays cast per SFX update.  Zero
+      /// disables occlusion.
+      static S32 smRaysPerUpdate;
+
+      SFXOcclusionManager();
+      virtual ~SFXOcclusionManager();
+
+      // SFXSystemPlugin.
+      virtual void update();
+};
+
+
+/// The singleton instance of SFXOcclusionManager, if there is one.
+extern SFXOcclusionManager* gSFXOcclusionManager;
+
+#endif // !_SFXOCCLUSIONMANAGER_H_
@@ -1950,15 +1950,13 @@ void ShapeBase::blowUp()
 
    if( pointInWater( (Point3F &)center ) && mDataBlock->underwaterExplosion )
    {
-      pExplosion = new Explosion;
-      pExplosion->onNewDataBlock(mDataBlock->underwaterExplosion, false);
+      pExplosion = Explosion::create(mDataBlock->underwaterExplosion);
    }
    else
    {
       if (mDataBlock->explosion)
       {
-         pExplosion = new Explosion;
-         pExplosion->onNewDataBlock(mDataBlock->explosion, false);
+         pExplosion = Explosion::create(mDataBlock->explosion);
       }
    }
 
@@ -1966,11 +1964,10 @@ void ShapeBase::blowUp()
    {
       pExplosion->setTransform(trans);
       pExplosion->setInitialState(center, damageDir);
-      if (pExplosion->registerObject() == false)
+      if (pExplosion->spawn() == false)
       {
          Con::errorf(ConsoleLogEntry::General, "ShapeBase(%s)::explode: couldn't register explosion",
                      mDataBlock->getName() );
-         delete pExplosion;
          pExplosion = NULL;
       }
    }
@@ -2590,6 +2587,69 @@ void ShapeBase::prepRenderImage( SceneRenderState *state )
    _prepRenderImage( state, true, true );
 }
 
+bool ShapeBase::_isForcedToHighestDetail()
+{
+   // We force all the shapes to use the highest detail
+   // if we're the control object or mounted.
+   GameConnection *con = GameConnection::getConnectionToServer();
+   ShapeBase *co = NULL;
+   if(con && ( (co = dynamic_cast<ShapeBase*>(con->getControlObject())) != NULL) )
+   {
+      if(co == this || co->getObjectMount() == this)
+         return true;
+   }
+   return false;
+}
+
+F32 ShapeBase::_getDetailDistance( SceneRenderState *state )
+{
+   Point3F cameraOffset = getWorldBox().getClosestPoint( state->getDiffuseCameraPosition() ) - state->getDiffuseCameraPosition();
+   F32 dist = cameraOffset.len();
+   if (dist < 0.01f)
+      dist = 0.01f;
+
+   F32 invScale = (1.0f/getMax(getMax(mObjScale.x,mObjScale.y),mObjScale.z));
+   return dist * invScale;
+}
+
+void ShapeBase::prepAnimation( SceneRenderState *state )
+{
+   // Select the same details _prepRenderImage() is about to
+   // and queue the shapes for the batched animation.
+
+   if ( !mShapeInstance || mCubeReflector.isRendering() )
+      return;
+
+   const bool forceHighestDetail = _isForcedToHighestDetail();
+   const F32 detailDist = _getDetailDistance( state );
+
+   if ( forceHighestDetail )
+      mShapeInstance->setCurrentDetail( 0 );
+   else
+      mShapeInstance->setDetailFromDistance( state, detailDist );
+
+   if ( mShapeInstance->getCurrentDetail() < 0 )
+      return;
+
+   mShapeInstance->queueAnimate();
+
+   for (U32 i = 0; i < MaxMountedImages; i++)
+   {
+      MountedImage& image = mMountedImageList[i];
+      U32 imageShapeIndex = getImageShapeIndex(image);
+      TSShapeInstance *imageShape = image.shapeInstance[imageShapeIndex];
+      if (!image.dataBlock || !imageShape)
+         continue;
+
+      if ( forceHighestDetail )
+         imageShape->setCurrentDetail( 0 );
+      else
+         imageShape->setDetailFromDistance( state, detailDist );
+
+      imageShape->queueAnimate();
+   }
+}
+
 void ShapeBase::_prepRenderImage(   SceneRenderState *state, 
                                     bool renderSelf, 
                                     bool renderMountedImages )
@@ -2616,35 +2676,19 @@ void ShapeBase::_prepRenderImage(   SceneRenderState *state,
    if ( mCubeReflector.isRendering() )
       return;
 
-   // We force all the shapes to use the highest detail
-   // if we're the control object or mounted.
-   bool forceHighestDetail = false;
-   {
-      GameConnection *con = GameConnection::getConnectionToServer();
-      ShapeBase *co = NULL;
-      if(con && ( (co = dynamic_cast<ShapeBase*>(con->getControlObject())) != NULL) )
-      {
-         if(co == this || co->getObjectMount() == this)
-            forceHighestDetail = true;
-      }
-   }
+   const bool forceHighestDetail = _isForcedToHighestDetail();
 
    mLastRenderFrame = sLastRenderFrame;
 
    // get shape detail...we might not even need to be drawn
-   Point3F cameraOffset = getWorldBox().getClosestPoint( state->getDiffuseCameraPosition() ) - state->getDiffuseCameraPosition();
-   F32 dist = cameraOffset.len();
-   if (dist < 0.01f)
-      dist = 0.01f;
-
-   F32 invScale = (1.0f/getMax(getMax(mObjScale.x,mObjScale.y),mObjScale.z));
+   const F32 detailDist = _getDetailDistance( state );
 
    if (mShapeInstance)
    {
       if ( forceHighestDetail )         
          mShapeInstance->setCurrentDetail( 0 );
       else
-         mShapeInstance->setDetailFromDistance( state, dist * invScale );
+         mShapeInstance->setDetailFromDistance( state, detailDist );
                               
       mShapeInstance->animate();
    }
@@ -2669,7 +2713,7 @@ void ShapeBase::_prepRenderImage(   SceneRenderState *state,
             if ( forceHighestDetail )
                image.shapeInstance[imageShapeIndex]->setCurrentDetail( 0 );
             else
-               image.shapeInstance[imageShapeIndex]->setDetailFromDistance( state, dist * invScale );
+               image.shapeInstance[imageShapeIndex]->setDetailFromDistance( state, detailDist );
 
             if (!mIsZero( (1.0f - mCloakLevel) * mFadeVal))
             {
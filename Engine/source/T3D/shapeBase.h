@@ -632,6 +632,11 @@ public:
    /// @}
 
    virtual bool preload(bool server, String &errorStr);
+
+   /// The shape, and everything else loaded by preload(), is only needed
+   /// once a ShapeBase using this datablock is added.
+   virtual bool allowDeferredPreload() const { return true; }
+
    void computeAccelerator(U32 i);
    S32  findMountPoint(U32 n);
 
@@ -1130,6 +1135,14 @@ protected:
                            bool renderSelf, 
                            bool renderMountedImages );
 
+   /// Returns true if the shape and its mounted images are always
+   /// rendered at the highest detail, which is the case for the
+   /// control object and the object it is mounted to.
+   bool _isForcedToHighestDetail();
+
+   /// Returns the scaled camera distance used for selecting details.
+   F32 _getDetailDistance( SceneRenderState *state );
+
    /// Renders the shape bounds as well as the 
    /// bounds of all mounted shape images.
    void _renderBoundingBox( ObjectRenderInst *ri, SceneRenderState *state, BaseMatInstance* );
@@ -1775,6 +1788,9 @@ public:
    /// @see SceneObject
    virtual void prepRenderImage( SceneRenderState* state );
 
+   /// @see SceneObject
+   virtual void prepAnimation( SceneRenderState* state );
+
    /// Used from ShapeBase::_prepRenderImage() to submit render 
    /// instances for the main shape or its mounted elements.
    virtual void prepBatchRender( SceneRenderState *state, S32 mountedImageIndex );
@@ -1,7 +1,20 @@
 #pragma once
 #include "console/engineAPI.h"
 
-template<typename T>
+/// Default for systems that keep no packed per-interface data.
+struct SystemNoData {};
+
+/// Registry of all interfaces of a system.
+///
+/// The interfaces are kept in a sparse set: every interface knows its slot
+/// in #all, so adding and removing is O(1).  Removing moves the last
+/// interface into the freed slot, so the order of #all is not stable.
+///
+/// Systems can keep the per-interface data they touch on every pass in
+/// @a Data.  It is stored by value in #data, packed in the same order as
+/// #all, so a system can sweep through it contiguously and only follow
+/// the pointer in #all for the interfaces that pass.
+template<typename T, typename Data = SystemNoData>
 class SystemInterface
 {
 public:
@@ -9,22 +22,36 @@ public:
    bool mIsServer;
 
    static Vector<T*> all;
+   static Vector<Data> data;
+
+protected:
+   /// Slot of this interface in #all and #data.
+   U32 mSystemIndex;
 
+public:
    SystemInterface()
    {
+      mSystemIndex = all.size();
       all.push_back((T*)this);
+      data.push_back(Data());
    }
 
    virtual ~SystemInterface()
    {
-      for (U32 i = 0; i < all.size(); i++)
+      const U32 last = all.size() - 1;
+      if (mSystemIndex != last)
       {
-         if (all[i] == (T*)this)
-         {
-            all.erase(i);
-            return;
-         }
+         all[mSystemIndex] = all[last];
+         data[mSystemIndex] = data[last];
+         static_cast<SystemInterface*>(all[mSystemIndex])->mSystemIndex = mSystemIndex;
       }
+      all.pop_back();
+      data.pop_back();
    }
+
+   /// Return this interface's packed data.
+   Data& getSystemData() { return data[mSystemIndex]; }
+   const Data& getSystemData() const { return data[mSystemIndex]; }
 };
-template<typename T> Vector<T*> SystemInterface<T>::all(0);
\ No newline at end of file
+template<typename T, typename Data> Vector<T*> SystemInterface<T, Data>::all(0);
+template<typename T, typename Data> Vector<Data> SystemInterface<T, Data>::data(0);
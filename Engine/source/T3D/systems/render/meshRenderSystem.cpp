@@ -5,9 +5,28 @@
 #include "renderInstance/renderPassManager.h"
 #include "materials/materialManager.h"
 #include "materials/baseMatInstance.h"
+#include "platform/threads/jobSystem.h"
 
 Vector<MeshRenderSystem::BufferMaterials> MeshRenderSystem::mBufferMaterials(0);
 Vector<MeshRenderSystem::BufferSet> MeshRenderSystem::mStaticBuffers(0);
+Vector<RenderInst*> MeshRenderSystem::mStaticInsts(0);
+Vector<U8> MeshRenderSystem::mVisible(0);
+
+/// Interfaces per culling job.  Culling one is only a handful of plane
+/// tests, so it takes a lot of them to be worth a job.
+static const U32 CullBatchSize = 256;
+
+void MeshRenderSystem::_cullJob(void* data, U32 start, U32 end)
+{
+   const CullJobData* job = (const CullJobData*)data;
+
+   for (U32 i = start; i < end; i++)
+   {
+      //Server side items exist for data, but we don't actually render them
+      const MeshRenderCullData& cullData = job->cullData[i];
+      job->visible[i] = cullData.isClient && !cullData.isStatic && !job->frustum->isCulled(cullData.bounds);
+   }
+}
 
 void MeshRenderSystem::render(SceneManager *sceneManager, SceneRenderState* state)
 {
@@ -18,36 +37,41 @@ void MeshRenderSystem::render(SceneManager *sceneManager, SceneRenderState* stat
    MatrixF camTransform = state->getCameraTransform();
 
    U32 count = MeshRenderSystemInterface::all.size();
-   for (U32 i = 0; i < count; i++)
+
+   // Set the query box for the container query.  Never
+   // make it larger than the frustum's AABB.  In the editor,
+   // always query the full frustum as that gives objects
+   // the opportunity to render editor visualizations even if
+   // they are otherwise not in view.
+   if (!state->getCullingFrustum().getBounds().isOverlapped(state->getRenderArea()))
    {
-      //Server side items exist for data, but we don't actually render them
-      bool isClient = MeshRenderSystemInterface::all[i]->mIsClient;
-      if (!MeshRenderSystemInterface::all[i]->mIsClient)
-         continue;
+      // This handles fringe cases like flying backwards into a zone where you
+      // end up pretty much standing on a zone border and looking directly into
+      // its "walls".  In that case the traversal area will be behind the frustum
+      // (remember that the camera isn't where visibility starts, it's the near
+      // distance).
 
-      bool isStatic = MeshRenderSystemInterface::all[i]->mStatic;
-      if (MeshRenderSystemInterface::all[i]->mStatic)
-         continue;
+      count = 0;
+   }
 
-      //First, do frustum culling
-      if (viewFrustum.isCulled(MeshRenderSystemInterface::all[i]->mBounds))
-         continue;
+   //First, do frustum culling.  This only reads the packed cull data, so
+   //it can run on the job system without touching the interfaces.
+   mVisible.setSize(count);
 
-      // Set the query box for the container query.  Never
-      // make it larger than the frustum's AABB.  In the editor,
-      // always query the full frustum as that gives objects
-      // the opportunity to render editor visualizations even if
-      // they are otherwise not in view.
-      if (!state->getCullingFrustum().getBounds().isOverlapped(state->getRenderArea()))
-      {
-         // This handles fringe cases like flying backwards into a zone where you
-         // end up pretty much standing on a zone border and looking directly into
-         // its "walls".  In that case the traversal area will be behind the frustum
-         // (remember that the camera isn't where visibility starts, it's the near
-         // distance).
+   CullJobData cullJob;
+   cullJob.frustum = &viewFrustum;
+   cullJob.cullData = MeshRenderSystemInterface::data.address();
+   cullJob.visible = mVisible.address();
+
+   if (count > CullBatchSize)
+      JobSystem::GLOBAL().parallelFor(count, CullBatchSize, &_cullJob, &cullJob);
+   else
+      _cullJob(&cullJob, 0, count);
 
+   for (U32 i = 0; i < count; i++)
+   {
+      if (!mVisible[i])
          continue;
-      }
 
       //We can then sort our objects by range since we have it already, so we can do occlusion culling be rendering front-to-back
 
@@ -56,88 +80,48 @@ void MeshRenderSystem::render(SceneManager *sceneManager, SceneRenderState* stat
    }
 
    //Static Batch rendering
-   if ( /*!mMaterialInst ||*/ !state)
+   if (mStaticInsts.empty())
       return;
 
    BaseMatInstance *matInst = MATMGR->getWarningMatInstance();
 
+   //If our material has transparency set on this will redirect it to proper render bin
+   const bool translucent = matInst->getMaterial()->isTranslucent();
+
    // Get a handy pointer to our RenderPassmanager
    RenderPassManager *renderPass = state->getRenderPass();
 
+   // The shared transforms belong to the pass, so they are refreshed along
+   // with the other per frame fields.  Passes are rendered one after the
+   // other so one set of instances can serve all of them.
+   const MatrixF *worldToCamera = renderPass->allocSharedXform(RenderPassManager::View);
+   const MatrixF *projection = renderPass->allocSharedXform(RenderPassManager::Projection);
+   const Point3F &cameraPos = state->getCameraPosition();
+
    for (U32 i = 0; i < mStaticBuffers.size(); i++)
    {
       for (U32 b = 0; b < mStaticBuffers[i].buffers.size(); b++)
       {
-         if (mStaticBuffers[i].buffers[b].vertData.empty())
+         BufferSet::Buffers &buffers = mStaticBuffers[i].buffers[b];
+         if (buffers.vertData.empty())
             continue;
 
-         MeshRenderInst *ri = renderPass->allocInst<MeshRenderInst>();
-
-         // Set our RenderInst as a standard mesh render
-         ri->type = RenderPassManager::RIT_Mesh;
-
-         //If our material has transparency set on this will redirect it to proper render bin
-         if (matInst->getMaterial()->isTranslucent())
-         {
-            ri->type = RenderPassManager::RIT_Translucent;
-            ri->translucentSort = true;
-         }
-
-         // Calculate our sorting point
-         if (state)
-         {
-            // Calculate our sort point manually.
-            const Box3F& rBox = Box3F(1000);// getRenderWorldBox();
-            ri->sortDistSq = rBox.getSqDistanceToPoint(state->getCameraPosition());
-         }
-         else
-            ri->sortDistSq = 0.0f;
-
-         // Set up our transforms
-         MatrixF objectToWorld = MatrixF::Identity;//getRenderTransform();
-                                                   //objectToWorld.scale(getScale());
-
-         ri->objectToWorld = renderPass->allocUniqueXform(objectToWorld);
-         ri->worldToCamera = renderPass->allocSharedXform(RenderPassManager::View);
-         ri->projection = renderPass->allocSharedXform(RenderPassManager::Projection);
-
-         // If our material needs lights then fill the RIs 
-         // light vector with the best lights.
-         /*if (matInst->isForwardLit())
-         {
-         LightQuery query;
-         query.init(getWorldSphere());
-         query.getLights(ri->lights, 8);
-         }*/
-
-         // Make sure we have an up-to-date backbuffer in case
-         // our Material would like to make use of it
-         // NOTICE: SFXBB is removed and refraction is disabled!
-         //ri->backBuffTex = GFX->getSfxBackBuffer();
+         MeshRenderInst *ri = &buffers.renderInst;
+         ri->type = translucent ? RenderPassManager::RIT_Translucent : RenderPassManager::RIT_Mesh;
+         ri->translucentSort = translucent;
+         ri->sortDistSq = buffers.bounds.getSqDistanceToPoint(cameraPos);
+         ri->worldToCamera = worldToCamera;
+         ri->projection = projection;
 
          // Set our Material
          ri->matInst = matInst;
 
-         // Set up our vertex buffer and primitive buffer
-         ri->vertBuff = &mStaticBuffers[i].buffers[b].vertexBuffer;
-         ri->primBuff = &mStaticBuffers[i].buffers[b].primitiveBuffer;
-
-         ri->prim = renderPass->allocPrim();
-         ri->prim->type = GFXTriangleList;
-         ri->prim->minIndex = 0;
-         ri->prim->startIndex = 0;
-         ri->prim->numPrimitives = mStaticBuffers[i].buffers[b].primData.size();
-         ri->prim->startVertex = 0;
-         ri->prim->numVertices = mStaticBuffers[i].buffers[b].vertData.size();
-
          // We sort by the material then vertex buffer
          ri->defaultKey = matInst->getStateHint();
-         ri->defaultKey2 = (uintptr_t)ri->vertBuff;
-
-                                                    // Submit our RenderInst to the RenderPassManager
-         state->getRenderPass()->addInst(ri);
       }
    }
+
+   renderPass->addInsts(mStaticInsts.address(), mStaticInsts.size());
 }
 
 void MeshRenderSystem::renderInterface(U32 interfaceIndex, SceneRenderState* state)
@@ -194,13 +178,15 @@ void MeshRenderSystem::rebuildBuffers()
    Box3F newBounds = Box3F::Zero;
 
    mStaticBuffers.clear();
+   mStaticInsts.clear();
 
    for (U32 i = 0; i < MeshRenderSystemInterface::all.size(); i++)
    {
       if (!MeshRenderSystemInterface::all[i]->mIsEnabled)
          continue;
 
-      if (!MeshRenderSystemInterface::all[i]->mIsClient || !MeshRenderSystemInterface::all[i]->mStatic)
+      const MeshRenderCullData& cullData = MeshRenderSystemInterface::data[i];
+      if (!cullData.isClient || !cullData.isStatic)
          continue;
 
       //TODO: Properly re-implement StaticElements to container owner interfaces and buffer sets
@@ -305,6 +291,7 @@ void MeshRenderSystem::rebuildBuffers()
                bufVert.texCoord = uvs[v];
 
                newBounds.extend(points[v]);
+               mStaticBuffers[bufferId].buffers.last().bounds.extend(points[v]);
 
                mStaticBuffers[bufferId].buffers.last().vertData.push_back(bufVert);
 
@@ -357,6 +344,30 @@ void MeshRenderSystem::rebuildBuffers()
          }
 
          buffers.primitiveBuffer.unlock();
+
+         // Set our RenderInst as a standard mesh render.  The material
+         // dependent fields are filled in by render().
+         MeshRenderInst *ri = &buffers.renderInst;
+         ri->clear();
+         ri->type = RenderPassManager::RIT_Mesh;
+
+         ri->objectToWorld = &MatrixF::Identity;
+
+         // Set up our vertex buffer and primitive buffer
+         ri->vertBuff = &buffers.vertexBuffer;
+         ri->primBuff = &buffers.primitiveBuffer;
+
+         ri->prim = &buffers.prim;
+         ri->prim->type = GFXTriangleList;
+         ri->prim->minIndex = 0;
+         ri->prim->startIndex = 0;
+         ri->prim->numPrimitives = buffers.primData.size() / 3;
+         ri->prim->startVertex = 0;
+         ri->prim->numVertices = buffers.vertData.size();
+
+         ri->defaultKey2 = (uintptr_t)ri->vertBuff;
+
+         mStaticInsts.push_back(ri);
       }
 
       mStaticBuffers[i].center /= mStaticBuffers[i].vertCount;
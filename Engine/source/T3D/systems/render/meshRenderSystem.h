@@ -15,19 +15,34 @@
 #ifndef _OPTIMIZEDPOLYLIST_H_
 #include "collision/optimizedPolyList.h"
 #endif
+#ifndef _RENDERPASSMANAGER_H_
+#include "renderInstance/renderPassManager.h"
+#endif
 
-class MeshRenderSystemInterface : public SystemInterface<MeshRenderSystemInterface>
+/// What MeshRenderSystem::render() looks at for every interface, packed
+/// contiguously in MeshRenderSystemInterface::data.
+struct MeshRenderCullData
+{
+   Box3F                   bounds;
+
+   /// Server side interfaces exist for data only and are never rendered.
+   bool                    isClient;
+
+   /// Rendered as part of the static batches.
+   bool                    isStatic;
+
+   MeshRenderCullData() : bounds(1), isClient(false), isStatic(false) {}
+};
+
+class MeshRenderSystemInterface : public SystemInterface<MeshRenderSystemInterface, MeshRenderCullData>
 {
 public:
    TSShapeInstance * mShapeInstance;
 
    MatrixF                 mTransform;
    Point3F                 mScale;
-   Box3F						   mBounds;
    SphereF                 mSphere;
 
-   bool                    mIsClient;
-
    struct matMap
    {
       //MaterialAsset* matAsset;
@@ -39,13 +54,10 @@ public:
    Vector<matMap>  mMaterials;
 
    //Static geometry stuff
-   bool                    mStatic;
-
    OptimizedPolyList       mGeometry;
 
-   MeshRenderSystemInterface() : SystemInterface(), mShapeInstance(nullptr), mTransform(MatrixF::Identity), mScale(Point3F::One), mIsClient(false), mStatic(false)
+   MeshRenderSystemInterface() : SystemInterface(), mShapeInstance(nullptr), mTransform(MatrixF::Identity), mScale(Point3F::One)
    {
-      mBounds = Box3F(1);
       mSphere = SphereF();
    }
 
@@ -108,6 +120,13 @@ protected:
          GFXVertexBufferHandle< GFXVertexPNTT > vertexBuffer;
          GFXPrimitiveBufferHandle            primitiveBuffer;
 
+         Box3F bounds;
+
+         //The render instance is built once by rebuildBuffers() and
+         //resubmitted every frame, only the per frame fields get updated
+         MeshRenderInst renderInst;
+         GFXPrimitive prim;
+
          Buffers()
          {
             vertStart = 0;
@@ -117,6 +136,8 @@ protected:
 
             vertexBuffer = NULL;
             primitiveBuffer = NULL;
+
+            bounds = Box3F::Invalid;
          }
       };
 
@@ -138,6 +159,22 @@ protected:
 
    static Vector<BufferSet> mStaticBuffers;
 
+   /// The render instances of all non-empty static buffers for submitting
+   /// them in bulk.
+   static Vector<RenderInst*> mStaticInsts;
+
+   /// Per interface result of the culling pass.  Reused across frames.
+   static Vector<U8> mVisible;
+
+   struct CullJobData
+   {
+      const Frustum* frustum;
+      const MeshRenderCullData* cullData;
+      U8* visible;
+   };
+
+   static void _cullJob(void* data, U32 start, U32 end);
+
 public:
    /*virtual void prepRenderImage(SceneRenderState *state);
 
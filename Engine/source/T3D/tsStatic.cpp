@@ -427,6 +427,9 @@ void TSStatic::prepCollision()
    mLOSDetails.clear();
    mConvexList->nukeList();
 
+   if ( getContainer() )
+      getContainer()->releaseStaticCollision( this );
+
    if ( mCollisionType == CollisionMesh || mCollisionType == VisibleMesh )
    {
       mShape->findColDetails( mCollisionType == VisibleMesh, &mCollisionDetails, &mLOSDetails );
@@ -599,6 +602,29 @@ void TSStatic::_updateShouldTick()
       setProcessTick( shouldTick );
 }
 
+void TSStatic::prepAnimation( SceneRenderState* state )
+{
+   if( !mShapeInstance || mCubeReflector.isRendering() )
+      return;
+
+   if ( mForceDetail == -1 )
+   {
+      Point3F cameraOffset;
+      getRenderTransform().getColumn(3,&cameraOffset);
+      cameraOffset -= state->getDiffuseCameraPosition();
+      F32 dist = cameraOffset.len();
+      if (dist < 0.01f)
+         dist = 0.01f;
+
+      F32 invScale = (1.0f/getMax(getMax(mObjScale.x,mObjScale.y),mObjScale.z));
+      mShapeInstance->setDetailFromDistance( state, dist * invScale );
+   }
+   else
+      mShapeInstance->setCurrentDetail( mForceDetail );
+
+   mShapeInstance->queueAnimate();
+}
+
 void TSStatic::prepRenderImage( SceneRenderState* state )
 {
    if( !mShapeInstance )
@@ -1044,6 +1070,20 @@ bool TSStatic::buildPolyList(PolyListContext context, AbstractPolyList* polyList
       S32 dl = mShapeInstance->getCurrentDetail();
       mShapeInstance->buildPolyListOpcode( dl, polyList, box );
    }
+   else if ( context == PLC_RayCast )
+   {
+      // Give back what castRay() tests against.  Animated
+      // collision can't be baked.
+      if ( mCollisionType == None || mAmbientThread )
+         return false;
+      else if ( mCollisionType == Bounds )
+         polyList->addBox( mObjBox );
+      else
+      {
+         for ( U32 i = 0; i < mLOSDetails.size(); i++ )
+            mShapeInstance->buildPolyListOpcode( mLOSDetails[i], polyList, box );
+      }
+   }
    else
    {
       // Figure out the mesh type we're looking for.
@@ -222,6 +222,7 @@ public:
    void setTransform( const MatrixF &mat );
    void onScaleChanged();
    void prepRenderImage( SceneRenderState *state );
+   void prepAnimation( SceneRenderState *state );
    void inspectPostApply();
    virtual void onMount( SceneObject *obj, S32 node );
    virtual void onUnmount( SceneObject *obj, S32 node );
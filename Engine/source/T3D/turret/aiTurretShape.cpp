@@ -21,7 +21,6 @@
 //-----------------------------------------------------------------------------
 
 #include "T3D/turret/aiTurretShape.h"
-
 #include "console/console.h"
 #include "console/consoleTypes.h"
 #include "console/engineAPI.h"
@@ -32,6 +31,7 @@
 #include "gfx/gfxDrawUtil.h"
 #include "ts/tsShapeInstance.h"
 #include "math/mRandom.h"
+#include "T3D/turret/turretTargetCache.h"
 
 static U32 sScanTypeMask =       PlayerObjectType     |
                                  VehicleObjectType;
@@ -733,7 +733,13 @@ void AITurretShape::_performScan()
       obj->disableCollision();
    }
 
-   gServerContainer.findObjects( mTransformedScanBox, sScanTypeMask, _scanCallback, (void*)this );
+   // All the turrets scanning this tick share one snapshot of the
+   // potential targets rather than each searching the container.
+   static Vector<ShapeBase*> targets;
+   targets.clear();
+   TurretTargetCache::get( sScanTypeMask )->findTargets( mTransformedScanBox, targets );
+   for ( U32 i = 0; i < targets.size(); i++ )
+      _scanCallback( targets[i], (void*)this );
 
    for ( SimSetIterator iter(&mIgnoreObjects); *iter; ++iter )
    {
@@ -0,0 +1,272 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "T3D/turret/turretTargetCache.h"
+
+#include "T3D/shapeBase.h"
+#include "T3D/gameBase/gameProcess.h"
+#include "scene/sceneContainer.h"
+#include "console/engineAPI.h"
+#include "core/module.h"
+#include "core/util/str.h"
+
+
+MODULE_BEGIN( TurretTargetCache )
+
+   MODULE_INIT_AFTER( Sim )
+   MODULE_SHUTDOWN_BEFORE( Sim )
+
+   MODULE_INIT
+   {
+      Con::addVariable( "$AITurret::targetBucketSize", TypeF32, &TurretTargetCache::smBucketSize,
+         "@brief The size in meters of the buckets potential turret targets are sorted into.\n\n"
+         "Smaller buckets mean fewer targets are tested by each scan, but more "
+         "buckets are walked.  The default value is 32.\n"
+         "@ingroup gameObjects" );
+   }
+
+   MODULE_SHUTDOWN
+   {
+      TurretTargetCache::destroyAll();
+   }
+
+MODULE_END;
+
+
+/// How far a target may have moved since the snapshot and still be found.
+static const F32 sMovePadding = 5.0f;
+
+F32 TurretTargetCache::smBucketSize = 32.0f;
+Vector<TurretTargetCache*> TurretTargetCache::smCaches;
+
+
+TurretTargetCache::TurretTargetCache( U32 typeMask )
+   :  mTypeMask( typeMask ),
+      mTick( 0 ),
+      mValid( false ),
+      mBounds( Box3F::Zero ),
+      mGridX( 1 ),
+      mGridY( 1 ),
+      mCellSize( 1.0f, 1.0f ),
+      mQueryMark( 0 )
+{
+}
+
+TurretTargetCache* TurretTargetCache::get( U32 typeMask )
+{
+   for ( U32 i = 0; i < smCaches.size(); i++ )
+   {
+      if ( smCaches[i]->mTypeMask == typeMask )
+         return smCaches[i];
+   }
+
+   TurretTargetCache *cache = new TurretTargetCache( typeMask );
+   smCaches.push_back( cache );
+   return cache;
+}
+
+void TurretTargetCache::destroyAll()
+{
+   for ( U32 i = 0; i < smCaches.size(); i++ )
+      delete smCaches[i];
+   smCaches.clear();
+}
+
+void TurretTargetCache::_gatherCallback( SceneObject *object, void *key )
+{
+   TurretTargetCache *cache = static_cast<TurretTargetCache*>( key );
+
+   ShapeBase *shape = dynamic_cast<ShapeBase*>( object );
+   if ( !shape || shape->isGlobalBounds() )
+      return;
+
+   cache->mEntries.increment();
+   Entry &entry = cache->mEntries.last();
+   entry.shape = shape;
+   entry.box = shape->getWorldBox();
+   entry.queryMark = 0;
+}
+
+void TurretTargetCache::_getCellRange( const Box3F &box, U32 &minX, U32 &maxX, U32 &minY, U32 &maxY ) const
+{
+   minX = (U32)mClampF( ( box.minExtents.x - mBounds.minExtents.x ) / mCellSize.x, 0.0f, mGridX - 1 );
+   maxX = (U32)mClampF( ( box.maxExtents.x - mBounds.minExtents.x ) / mCellSize.x, 0.0f, mGridX - 1 );
+   minY = (U32)mClampF( ( box.minExtents.y - mBounds.minExtents.y ) / mCellSize.y, 0.0f, mGridY - 1 );
+   maxY = (U32)mClampF( ( box.maxExtents.y - mBounds.minExtents.y ) / mCellSize.y, 0.0f, mGridY - 1 );
+}
+
+void TurretTargetCache::_update()
+{
+   ServerProcessList *processList = ServerProcessList::get();
+   const U32 tick = processList ? processList->getTotalTicks() : 0;
+   if ( mValid && tick == mTick )
+      return;
+
+   PROFILE_SCOPE( TurretTargetCache_update );
+
+   mTick = tick;
+   mValid = true;
+
+   mEntries.clear();
+   mCellEntries.clear();
+
+   gServerContainer.findObjects( mTypeMask, _gatherCallback, this );
+
+   if ( mEntries.empty() )
+   {
+      mGridX = mGridY = 1;
+      mCellStart.setSize( 2 );
+      mCellStart.fill( 0 );
+      return;
+   }
+
+   mBounds = Box3F::Invalid;
+   for ( U32 i = 0; i < mEntries.size(); i++ )
+      mBounds.intersect( mEntries[i].box );
+
+   // Keep the cells at least the bucket size so they still cover
+   // the bounds when the grid size is clamped.
+   const F32 bucketSize = getMax( smBucketSize, 1.0f );
+   mGridX = mClamp( (S32)mCeil( mBounds.len_x() / bucketSize ), 1, MaxGridSize );
+   mGridY = mClamp( (S32)mCeil( mBounds.len_y() / bucketSize ), 1, MaxGridSize );
+   mCellSize.set( getMax( mBounds.len_x() / mGridX, bucketSize ),
+                  getMax( mBounds.len_y() / mGridY, bucketSize ) );
+
+   // Count the entries in each cell, turn the counts into offsets
+   // and then fill in the cells.
+   const U32 numCells = mGridX * mGridY;
+   mCellStart.setSize( numCells + 1 );
+   mCellStart.fill( 0 );
+
+   U32 minX, maxX, minY, maxY;
+   for ( U32 i = 0; i < mEntries.size(); i++ )
+   {
+      _getCellRange( mEntries[i].box, minX, maxX, minY, maxY );
+      for ( U32 y = minY; y <= maxY; y++ )
+         for ( U32 x = minX; x <= maxX; x++ )
+            mCellStart[ y * mGridX + x + 1 ]++;
+   }
+
+   for ( U32 i = 0; i < numCells; i++ )
+      mCellStart[i+1] += mCellStart[i];
+
+   mCellEntries.setSize( mCellStart.last() );
+
+   Vector<U32> cursor( mCellStart );
+   for ( U32 i = 0; i < mEntries.size(); i++ )
+   {
+      _getCellRange( mEntries[i].box, minX, maxX, minY, maxY );
+      for ( U32 y = minY; y <= maxY; y++ )
+         for ( U32 x = minX; x <= maxX; x++ )
+            mCellEntries[ cursor[ y * mGridX + x ]++ ] = i;
+   }
+}
+
+void TurretTargetCache::findTargets( const Box3F &box, Vector<ShapeBase*> &outTargets )
+{
+   PROFILE_SCOPE( TurretTargetCache_findTargets );
+
+   _update();
+
+   if ( mEntries.empty() )
+      return;
+
+   // Targets are bucketed where they were when the snapshot was
+   // taken so look a little further out for ones that moved since.
+   Box3F searchBox( box );
+   searchBox.minExtents -= Point3F( sMovePadding, sMovePadding, 0.0f );
+   searchBox.maxExtents += Point3F( sMovePadding, sMovePadding, 0.0f );
+
+   U32 minX, maxX, minY, maxY;
+   _getCellRange( searchBox, minX, maxX, minY, maxY );
+
+   mQueryMark++;
+
+   for ( U32 y = minY; y <= maxY; y++ )
+   {
+      for ( U32 x = minX; x <= maxX; x++ )
+      {
+         const U32 cell = y * mGridX + x;
+         for ( U32 i = mCellStart[cell]; i < mCellStart[cell+1]; i++ )
+         {
+            Entry &entry = mEntries[ mCellEntries[i] ];
+            if ( entry.queryMark == mQueryMark )
+               continue;
+            entry.queryMark = mQueryMark;
+
+            ShapeBase *shape = entry.shape;
+            if ( !shape ||
+                 shape->getDamageState() != ShapeBase::Enabled ||
+                 !shape->isCollisionEnabled() )
+               continue;
+
+            if ( shape->getWorldBox().isOverlapped( box ) )
+               outTargets.push_back( shape );
+         }
+      }
+   }
+}
+
+void TurretTargetCache::findTargets( const Point3F &point, F32 radius, Vector<ShapeBase*> &outTargets )
+{
+   const U32 start = outTargets.size();
+
+   Box3F box( point, point );
+   box.minExtents -= Point3F( radius, radius, radius );
+   box.maxExtents += Point3F( radius, radius, radius );
+   findTargets( box, outTargets );
+
+   const F32 radiusSquared = radius * radius;
+   for ( U32 i = start; i < outTargets.size(); )
+   {
+      if ( ( outTargets[i]->getBoxCenter() - point ).lenSquared() > radiusSquared )
+         outTargets.erase_fast( i );
+      else
+         i++;
+   }
+}
+
+DefineEngineFunction( findTurretTargets, const char*, ( Point3F position, F32 radius, U32 typeMask ),,
+   "@brief Returns the enabled ShapeBase objects whose bounds center is within the radius.\n\n"
+   "This uses the same per tick target snapshot as AITurretShape scanning, so any number "
+   "of script sensors can search each tick without a container search of their own.  "
+   "Objects with collision disabled are not returned.\n\n"
+   "@param position The center of the search.\n"
+   "@param radius The search radius.\n"
+   "@param typeMask The object types to return.\n"
+   "@return A space separated list of object ids.\n"
+   "@ingroup gameObjects" )
+{
+   Vector<ShapeBase*> targets;
+   TurretTargetCache::get( typeMask )->findTargets( position, radius, targets );
+
+   StringBuilder str;
+   for ( U32 i = 0; i < targets.size(); i++ )
+   {
+      if ( i > 0 )
+         str.append( ' ' );
+      str.append( targets[i]->getIdString() );
+   }
+
+   return Con::getReturnBuffer( str );
+}
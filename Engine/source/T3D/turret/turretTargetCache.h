@@ -0,0 +1,118 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _TURRETTARGETCACHE_H_
+#define _TURRETTARGETCACHE_H_
+
+#ifndef _MBOX_H_
+   #include "math/mBox.h"
+#endif
+#ifndef _TVECTOR_H_
+   #include "core/util/tVector.h"
+#endif
+#ifndef _SIMOBJECT_H_
+   #include "console/simObject.h"
+#endif
+
+class SceneObject;
+class ShapeBase;
+
+
+/// A snapshot of the server's potential targets, bucketed on a 2D grid.
+///
+/// Scanning with a container query per turret per scan gets expensive once
+/// there are hundreds of turrets.  Instead the first scan in a server tick
+/// gathers every enabled target of the type mask once and buckets it, and
+/// every other scan in that tick only walks the buckets its box touches.
+///
+/// Targets are bucketed where they were when the snapshot was taken, but
+/// their current bounds, damage and collision state are checked when they
+/// are returned, so the results match a container query.
+class TurretTargetCache
+{
+public:
+
+   /// Returns the shared cache for targets of the given type mask.
+   static TurretTargetCache* get( U32 typeMask );
+
+   /// Deletes all the caches.
+   static void destroyAll();
+
+   /// Appends the enabled targets with collision enabled whose world box
+   /// overlaps the given box.
+   void findTargets( const Box3F &box, Vector<ShapeBase*> &outTargets );
+
+   /// Appends the enabled targets with collision enabled whose bounds center
+   /// is within the radius of the point.
+   void findTargets( const Point3F &point, F32 radius, Vector<ShapeBase*> &outTargets );
+
+   /// The size of a grid bucket in meters.
+   static F32 smBucketSize;
+
+protected:
+
+   enum
+   {
+      /// Limits the grid dimensions on very large levels.
+      MaxGridSize = 64,
+   };
+
+   struct Entry
+   {
+      SimObjectPtr<ShapeBase> shape;
+      Box3F box;
+      U32 queryMark;
+   };
+
+   TurretTargetCache( U32 typeMask );
+
+   /// Rebuilds the snapshot if it wasn't taken during this server tick.
+   void _update();
+
+   void _getCellRange( const Box3F &box, U32 &minX, U32 &maxX, U32 &minY, U32 &maxY ) const;
+
+   static void _gatherCallback( SceneObject *object, void *key );
+
+   U32 mTypeMask;
+
+   /// The server tick the snapshot was taken in.
+   U32 mTick;
+   bool mValid;
+
+   Vector<Entry> mEntries;
+
+   Box3F mBounds;
+   U32 mGridX;
+   U32 mGridY;
+   Point2F mCellSize;
+
+   /// Offsets into mCellEntries for each cell with an extra one at the end.
+   Vector<U32> mCellStart;
+   Vector<U32> mCellEntries;
+
+   /// Used to return targets spanning several cells only once.
+   U32 mQueryMark;
+
+   static Vector<TurretTargetCache*> smCaches;
+};
+
+#endif // _TURRETTARGETCACHE_H_
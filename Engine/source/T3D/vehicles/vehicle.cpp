@@ -893,6 +893,12 @@ void Vehicle::processTick(const Move* move)
             move = &NullMove;
       }
 
+      // Distant vehicles are simulated less often or
+      // not at all on the server.
+      const U32 lodTicks = SimulationLOD::update(this, &mSimLOD);
+      if (lodTicks == 0)
+         return;
+
       // Process input move
       updateMove(move);
 
@@ -901,26 +907,29 @@ void Vehicle::processTick(const Move* move)
       mDelta.rot[0] = mRigid.angPosition;
 
       // Update the physics based on the integration rate
+      const bool wasAtRest = mRigid.atRest;
       S32 count = mDataBlock->integration;
       --mWorkingQueryBoxCountDown;
       updateWorkingCollisionSet(getCollisionMask());
       for (U32 i = 0; i < count; i++)
-         updatePos(TickSec / count);
+         updatePos(lodTicks * TickSec / count);
 
       // Wrap up interpolation info
       mDelta.pos     = mRigid.linPosition;
       mDelta.posVec -= mRigid.linPosition;
       mDelta.rot[1]  = mRigid.angPosition;
 
-      // Update container database
-      setPosition(mRigid.linPosition, mRigid.angPosition);
-      setMaskBits(PositionMask);
-      updateContainer();
+      // Update container database unless we were and still are at rest.
+      if (!wasAtRest || !mRigid.atRest)
+      {
+         setPosition(mRigid.linPosition, mRigid.angPosition);
+         setMaskBits(PositionMask);
+         updateContainer();
 
-      //TODO: Only update when position has actually changed
-      //no need to check if mDataBlock->enablePhysicsRep is false as mPhysicsRep will be NULL if it is
-      if (mPhysicsRep)
-         mPhysicsRep->moveKinematicTo(getTransform());
+         //no need to check if mDataBlock->enablePhysicsRep is false as mPhysicsRep will be NULL if it is
+         if (mPhysicsRep)
+            mPhysicsRep->moveKinematicTo(getTransform());
+      }
    }
 }
 
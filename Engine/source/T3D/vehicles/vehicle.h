@@ -32,6 +32,9 @@
 #ifndef _BOXCONVEX_H_
 #include "collision/boxConvex.h"
 #endif
+#ifndef _SIMULATIONLOD_H_
+#include "T3D/gameBase/simulationLOD.h"
+#endif
 
 class ParticleEmitter;
 class ParticleEmitterData;
@@ -209,6 +212,9 @@ class Vehicle: public ShapeBase
    ShapeBaseConvex mConvex;
    S32 restCount;
 
+   /// Server side simulation level of detail.
+   SimulationLOD::State mSimLOD;
+
    SimObjectPtr<ParticleEmitter> mDustEmitterList[VehicleData::VC_NUM_DUST_EMITTERS];
    SimObjectPtr<ParticleEmitter> mDamageEmitterList[VehicleData::VC_NUM_DAMAGE_EMITTERS];
    SimObjectPtr<ParticleEmitter> mSplashEmitterList[VehicleData::VC_NUM_SPLASH_EMITTERS];
@@ -236,6 +242,7 @@ class Vehicle: public ShapeBase
    void readPacketData (GameConnection * conn, BitStream *stream);
    U32  packUpdate  (NetConnection *conn, U32 mask, BitStream *stream);
    void unpackUpdate(NetConnection *conn,           BitStream *stream);
+   bool usesSnapshotDeltas() const { return true; }
 
    void updateLiftoffDust( F32 dt );
    void updateDamageSmoke( F32 dt );
@@ -45,6 +45,11 @@
 #include "materials/materialDefinition.h"
 #include "materials/baseMatInstance.h"
 #include "lighting/lightQuery.h"
+#include "T3D/gameBase/processList.h"
+
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+#include <xmmintrin.h>
+#endif
 
 
 // Collision masks are used to determine what type of objects the
@@ -511,6 +516,116 @@ void WheeledVehicleData::unpackData(BitStream* stream)
 // Wheeled Vehicle Class
 //----------------------------------------------------------------------------
 
+/// Casts the wheel rays of all vehicles on a process list in one
+/// SceneContainer::castRayBatch() call right before the tick, so that
+/// large numbers of vehicles share container queries instead of issuing
+/// one ray cast per wheel each.
+class WheeledVehicleManager
+{
+protected:
+
+   ProcessList *mProcessList;
+
+   Vector< WheeledVehicle* > mVehicles;
+
+   /// Scratch space for the sweep.
+   Vector< SceneContainer::RayQuery > mQueries;
+   Vector< RayInfo > mResults;
+   Vector< WheeledVehicle* > mSwept;
+
+   void _onPreTick();
+
+public:
+
+   WheeledVehicleManager() : mProcessList( NULL ) {}
+
+   void addVehicle( WheeledVehicle *vehicle );
+   void removeVehicle( WheeledVehicle *vehicle );
+
+   static WheeledVehicleManager smClient;
+   static WheeledVehicleManager smServer;
+};
+
+WheeledVehicleManager WheeledVehicleManager::smClient;
+WheeledVehicleManager WheeledVehicleManager::smServer;
+
+void WheeledVehicleManager::addVehicle( WheeledVehicle *vehicle )
+{
+   // The process lists live for the lifetime of
+   // the app, so we only hook up to it once.
+   if ( !mProcessList )
+   {
+      mProcessList = vehicle->getProcessList();
+      mProcessList->preTickSignal().notify( this, &WheeledVehicleManager::_onPreTick );
+   }
+
+   mVehicles.push_back( vehicle );
+}
+
+void WheeledVehicleManager::removeVehicle( WheeledVehicle *vehicle )
+{
+   mVehicles.remove( vehicle );
+}
+
+void WheeledVehicleManager::_onPreTick()
+{
+   if ( !WheeledVehicle::smBatchWheelRays || mVehicles.empty() )
+      return;
+
+   PROFILE_SCOPE( WheeledVehicleManager_onPreTick );
+
+   mQueries.clear();
+   mSwept.clear();
+
+   SceneContainer *container = NULL;
+   for ( U32 i = 0; i < mVehicles.size(); i++ )
+   {
+      WheeledVehicle *vehicle = mVehicles[i];
+      vehicle->mWheelSweep.valid = false;
+
+      if ( !vehicle->_prepareWheelSweep( &mQueries ) )
+         continue;
+
+      mSwept.push_back( vehicle );
+      container = vehicle->getContainer();
+   }
+
+   if ( mQueries.empty() )
+      return;
+
+   mResults.setSize( mQueries.size() );
+   for ( U32 i = 0; i < mResults.size(); i++ )
+      mResults[i] = RayInfo();
+
+   container->castRayBatch( mQueries.address(), mQueries.size(), mResults.address() );
+
+   // Hand the results back in the order the rays were added.
+
+   U32 result = 0;
+   for ( U32 i = 0; i < mSwept.size(); i++ )
+   {
+      WheeledVehicle *vehicle = mSwept[i];
+
+      WheeledVehicle::WheelSweep &sweep = vehicle->mWheelSweep;
+      sweep.valid = true;
+      sweep.linPosition = vehicle->mRigid.linPosition;
+      sweep.angPosition = vehicle->mRigid.angPosition;
+
+      const WheeledVehicle::Wheel *wend = &vehicle->mWheel[vehicle->mDataBlock->wheelCount];
+      for ( const WheeledVehicle::Wheel *wheel = vehicle->mWheel; wheel < wend; wheel++ )
+      {
+         if ( !wheel->tire || !wheel->spring )
+            continue;
+
+         const U32 index = wheel - vehicle->mWheel;
+         const RayInfo &info = mResults[result++];
+         sweep.hit[index] = info.object != NULL;
+         sweep.info[index] = info;
+         sweep.object[index] = info.object;
+      }
+   }
+}
+
 //----------------------------------------------------------------------------
 
 IMPLEMENT_CO_NETOBJECT_V1(WheeledVehicle);
@@ -529,6 +644,7 @@ WheeledVehicle::WheeledVehicle()
    mSquealSound = NULL;
    mTailLightThread = 0;
    mSteeringThread = 0;
+   mWheelSweep.valid = false;
 
    for (S32 i = 0; i < WheeledVehicleData::MaxWheels; i++) {
       mWheel[i].springThread = 0;
@@ -546,9 +662,17 @@ WheeledVehicle::~WheeledVehicle()
 {
 }
 
+bool WheeledVehicle::smBatchWheelRays = true;
+
 void WheeledVehicle::initPersistFields()
 {
    Parent::initPersistFields();
+
+   Con::addVariable( "$WheeledVehicle::batchWheelRays", TypeBool, &smBatchWheelRays,
+      "@brief Cast the wheel rays of all wheeled vehicles in one batch per tick.\n\n"
+      "When disabled every vehicle casts one ray per wheel during its tick.  Vehicles "
+      "integrating more than once per tick still cast their own rays after the first step.\n\n"
+      "@ingroup Vehicles\n" );
 }
 
 
@@ -562,11 +686,22 @@ bool WheeledVehicle::onAdd()
    addToScene();
    if (isServerObject())
       scriptOnAdd();
+
+   if (isServerObject())
+      WheeledVehicleManager::smServer.addVehicle(this);
+   else
+      WheeledVehicleManager::smClient.addVehicle(this);
+
    return true;
 }
 
 void WheeledVehicle::onRemove()
 {
+   if (isServerObject())
+      WheeledVehicleManager::smServer.removeVehicle(this);
+   else
+      WheeledVehicleManager::smClient.removeVehicle(this);
+
    // Delete the wheel resources
    if (mDataBlock != NULL)  {
       Wheel* wend = &mWheel[mDataBlock->wheelCount];
@@ -593,6 +728,8 @@ void WheeledVehicle::onRemove()
 
 bool WheeledVehicle::onNewDataBlock(GameBaseData* dptr, bool reload)
 {
+   mWheelSweep.valid = false;
+
    // Delete any existing wheel resources if we're switching
    // datablocks.
    if (mDataBlock) 
@@ -724,6 +861,7 @@ void WheeledVehicle::setWheelTire(S32 wheel,WheeledVehicleTire* tire)
 {
    AssertFatal(wheel >= 0 && wheel < WheeledVehicleData::MaxWheels,"Wheel index out of bounds");
    mWheel[wheel].tire = tire;
+   mWheelSweep.valid = false;
    setMaskBits(WheelMask);
 }
 
@@ -731,6 +869,7 @@ void WheeledVehicle::setWheelSpring(S32 wheel,WheeledVehicleSpring* spring)
 {
    AssertFatal(wheel >= 0 && wheel < WheeledVehicleData::MaxWheels,"Wheel index out of bounds");
    mWheel[wheel].spring = spring;
+   mWheelSweep.valid = false;
    setMaskBits(WheelMask);
 }
 
@@ -841,6 +980,135 @@ void WheeledVehicle::advanceTime(F32 dt)
 }
 
 
+//----------------------------------------------------------------------------
+
+/// Tire model inputs and results for all wheels of a vehicle in SoA
+/// layout so that the model is evaluated for four wheels at once.
+struct TireLanes
+{
+   enum { MaxLanes = WheeledVehicleData::MaxWheels };
+
+   // Inputs
+   F32 xVelocity[MaxLanes];               ///< Lateral velocity at the contact
+   F32 yVelocity[MaxLanes];               ///< Longitudinal velocity at the contact
+   F32 wheelVelocity[MaxLanes];           ///< Angular velocity * tire radius
+   F32 absAngularVelocity[MaxLanes];
+   F32 maxForce[MaxLanes];                ///< Vertical load * friction
+   F32 lateralForce[MaxLanes];
+   F32 lateralDamping[MaxLanes];
+   F32 lateralRelaxation[MaxLanes];
+   F32 longitudinalForce[MaxLanes];
+   F32 longitudinalDamping[MaxLanes];
+   F32 longitudinalRelaxation[MaxLanes];
+
+   // Tire deformation, updated in place
+   F32 Dx[MaxLanes];
+   F32 Dy[MaxLanes];
+
+   // Results
+   F32 Fx[MaxLanes];
+   F32 Fy[MaxLanes];
+   F32 K[MaxLanes];                       ///< Friction scale
+   F32 slipping[MaxLanes];                ///< 1 if friction limited the forces, else 0
+
+   /// Zero the lanes from @a count up to the next multiple of four.
+   void pad(U32 count)
+   {
+      for (U32 i = count; i < ((count + 3) & ~3); i++)
+      {
+         xVelocity[i] = yVelocity[i] = wheelVelocity[i] = absAngularVelocity[i] = 0;
+         maxForce[i] = 0;
+         lateralForce[i] = lateralDamping[i] = lateralRelaxation[i] = 0;
+         longitudinalForce[i] = longitudinalDamping[i] = longitudinalRelaxation[i] = 0;
+         Dx[i] = Dy[i] = 0;
+      }
+   }
+};
+
+/// Evaluate the tire deformation forces of the first @a count lanes.
+static void evaluateTires(TireLanes& lanes, U32 count, F32 dt)
+{
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+
+   lanes.pad(count);
+
+   const __m128 dt4 = _mm_set1_ps(dt);
+   const __m128 one = _mm_set1_ps(1.0f);
+
+   for (U32 i = 0; i < count; i += 4)
+   {
+      const __m128 absAvel = _mm_loadu_ps(&lanes.absAngularVelocity[i]);
+      __m128 Dy = _mm_loadu_ps(&lanes.Dy[i]);
+      __m128 Dx = _mm_loadu_ps(&lanes.Dx[i]);
+
+      // Longitudinal tire deformation force
+      const __m128 ddy = _mm_sub_ps(
+         _mm_sub_ps(_mm_loadu_ps(&lanes.wheelVelocity[i]), _mm_loadu_ps(&lanes.yVelocity[i])),
+         _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&lanes.longitudinalRelaxation[i]), absAvel), Dy));
+      Dy = _mm_add_ps(Dy, _mm_mul_ps(ddy, dt4));
+      __m128 Fy = _mm_add_ps(
+         _mm_mul_ps(_mm_loadu_ps(&lanes.longitudinalForce[i]), Dy),
+         _mm_mul_ps(_mm_loadu_ps(&lanes.longitudinalDamping[i]), ddy));
+
+      // Lateral tire deformation force
+      const __m128 ddx = _mm_sub_ps(_mm_loadu_ps(&lanes.xVelocity[i]),
+         _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&lanes.lateralRelaxation[i]), absAvel), Dx));
+      Dx = _mm_add_ps(Dx, _mm_mul_ps(ddx, dt4));
+      __m128 Fx = _mm_sub_ps(_mm_setzero_ps(), _mm_add_ps(
+         _mm_mul_ps(_mm_loadu_ps(&lanes.lateralForce[i]), Dx),
+         _mm_mul_ps(_mm_loadu_ps(&lanes.lateralDamping[i]), ddx)));
+
+      // Scale the forces down to what friction allows.  Lanes
+      // within the limit keep a scale of one.
+      const __m128 maxForce = _mm_loadu_ps(&lanes.maxForce[i]);
+      const __m128 Fn = _mm_mul_ps(maxForce, maxForce);
+      const __m128 Fw = _mm_add_ps(_mm_mul_ps(Fx, Fx), _mm_mul_ps(Fy, Fy));
+      const __m128 slipping = _mm_cmpgt_ps(Fw, Fn);
+      const __m128 K = _mm_or_ps(_mm_and_ps(slipping, _mm_sqrt_ps(_mm_div_ps(Fn, Fw))),
+                                 _mm_andnot_ps(slipping, one));
+
+      _mm_storeu_ps(&lanes.Fx[i], _mm_mul_ps(Fx, K));
+      _mm_storeu_ps(&lanes.Fy[i], _mm_mul_ps(Fy, K));
+      _mm_storeu_ps(&lanes.Dx[i], _mm_mul_ps(Dx, K));
+      _mm_storeu_ps(&lanes.Dy[i], _mm_mul_ps(Dy, K));
+      _mm_storeu_ps(&lanes.K[i], K);
+      _mm_storeu_ps(&lanes.slipping[i], _mm_and_ps(slipping, one));
+   }
+
+#else
+
+   for (U32 i = 0; i < count; i++)
+   {
+      // Longitudinal tire deformation force
+      F32 ddy = (lanes.wheelVelocity[i] - lanes.yVelocity[i]) -
+         lanes.longitudinalRelaxation[i] * lanes.absAngularVelocity[i] * lanes.Dy[i];
+      lanes.Dy[i] += ddy * dt;
+      F32 Fy = lanes.longitudinalForce[i] * lanes.Dy[i] + lanes.longitudinalDamping[i] * ddy;
+
+      // Lateral tire deformation force
+      F32 ddx = lanes.xVelocity[i] -
+         lanes.lateralRelaxation[i] * lanes.absAngularVelocity[i] * lanes.Dx[i];
+      lanes.Dx[i] += ddx * dt;
+      F32 Fx = -(lanes.lateralForce[i] * lanes.Dx[i] + lanes.lateralDamping[i] * ddx);
+
+      // Scale the forces down to what friction allows
+      F32 Fn = lanes.maxForce[i] * lanes.maxForce[i];
+      F32 Fw = Fx * Fx + Fy * Fy;
+      bool slipping = Fw > Fn;
+      F32 K = slipping ? mSqrt(Fn / Fw) : 1.0f;
+
+      lanes.Fx[i] = Fx * K;
+      lanes.Fy[i] = Fy * K;
+      lanes.Dx[i] *= K;
+      lanes.Dy[i] *= K;
+      lanes.K[i] = K;
+      lanes.slipping[i] = slipping ? 1.0f : 0.0f;
+   }
+
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 /** Update the rigid body forces on the vehicle
    This method calculates the forces acting on the body, including gravity,
@@ -916,13 +1184,23 @@ void WheeledVehicle::updateForces(F32 dt)
    if (contactCount)
       verticalLoad /= contactCount;
 
-   // Sum up spring and wheel torque forces
+   // Sum up spring forces and gather the inputs of the tire model
+   // for all wheels in contact with the ground.  The tire model is
+   // then evaluated for all of them at once.
+   TireLanes lanes;
+   U32 laneCount = 0;
+   S32 wheelLane[WheeledVehicleData::MaxWheels];
+   Point3F laneTireX[TireLanes::MaxLanes], laneTireY[TireLanes::MaxLanes];
+   Point3F laneHubPos[TireLanes::MaxLanes];
+
    for (Wheel* wheel = mWheel; wheel < wend; wheel++)  
    {
+      const U32 index = wheel - mWheel;
+      wheelLane[index] = -1;
+
       if (!wheel->tire || !wheel->spring)
          continue;
 
-      F32 Fy = 0;
       if (wheel->surface.contact) 
       {
 
@@ -986,63 +1264,37 @@ void WheeledVehicle::updateForces(F32 dt)
          mRigid.getOriginVector(wheel->surface.pos,&wheelContact);
          mRigid.getVelocity(wheelContact, &wheelVelocity);
 
-         F32 xVelocity = mDot(tireX, wheelVelocity);
-         F32 yVelocity = mDot(tireY, wheelVelocity);
-
-         // Tires act as springs and generate lateral and longitudinal
-         // forces to move the vehicle. These distortion/spring forces
-         // are what convert wheel angular velocity into forces that
-         // act on the rigid body.
-
-         // Longitudinal tire deformation force
-         F32 ddy = (wheel->avel * wheel->tire->radius - yVelocity) -
-            wheel->tire->longitudinalRelaxation *
-            mFabs(wheel->avel) * wheel->Dy;
-         wheel->Dy += ddy * dt;
-         Fy = (wheel->tire->longitudinalForce * wheel->Dy +
-            wheel->tire->longitudinalDamping * ddy);
-
-         // Lateral tire deformation force
-         F32 ddx = xVelocity - wheel->tire->lateralRelaxation *
-            mFabs(wheel->avel) * wheel->Dx;
-         wheel->Dx += ddx * dt;
-         F32 Fx = -(wheel->tire->lateralForce * wheel->Dx +
-            wheel->tire->lateralDamping * ddx);
-
          // Vertical load on the tire
          verticalLoad = spring + damping + antiSway;
          if (verticalLoad < 0)
             verticalLoad = 0;
 
-         // Adjust tire forces based on friction
+         // Tires act as springs and generate lateral and longitudinal
+         // forces to move the vehicle. These distortion/spring forces
+         // are what convert wheel angular velocity into forces that
+         // act on the rigid body.
          F32 surfaceFriction = 1;
          F32 mu = surfaceFriction * (wheel->slipping ? wheel->tire->kineticFriction : wheel->tire->staticFriction);
-         F32 Fn = verticalLoad * mu; Fn *= Fn;
-         F32 Fw = Fx * Fx + Fy * Fy;
-         if (Fw > Fn) 
-         {
-            F32 K = mSqrt(Fn / Fw);
-            Fy *= K;
-            Fx *= K;
-            wheel->Dy *= K;
-            wheel->Dx *= K;
-            wheel->slip = 1 - K;
-            wheel->slipping = true;
-         }
-         else 
-         {
-            wheel->slipping = false;
-            wheel->slip = 0;
-         }
 
-         // Tire forces act through the tire direction vectors parallel
-         // to the surface and are applied at the wheel hub.
-         forceVector = (tireX * Fx) + (tireY * Fy);
-         pos -= bz * (wheel->spring->length * wheel->extension);
-         mRigid.getOriginVector(pos,&r);
-         mCross(r, forceVector, &t);
-         mRigid.torque += t;
-         mRigid.force += forceVector;
+         const U32 lane = laneCount++;
+         wheelLane[index] = lane;
+         lanes.xVelocity[lane] = mDot(tireX, wheelVelocity);
+         lanes.yVelocity[lane] = mDot(tireY, wheelVelocity);
+         lanes.wheelVelocity[lane] = wheel->avel * wheel->tire->radius;
+         lanes.absAngularVelocity[lane] = mFabs(wheel->avel);
+         lanes.maxForce[lane] = verticalLoad * mu;
+         lanes.lateralForce[lane] = wheel->tire->lateralForce;
+         lanes.lateralDamping[lane] = wheel->tire->lateralDamping;
+         lanes.lateralRelaxation[lane] = wheel->tire->lateralRelaxation;
+         lanes.longitudinalForce[lane] = wheel->tire->longitudinalForce;
+         lanes.longitudinalDamping[lane] = wheel->tire->longitudinalDamping;
+         lanes.longitudinalRelaxation[lane] = wheel->tire->longitudinalRelaxation;
+         lanes.Dx[lane] = wheel->Dx;
+         lanes.Dy[lane] = wheel->Dy;
+
+         laneTireX[lane] = tireX;
+         laneTireY[lane] = tireY;
+         laneHubPos[lane] = pos - bz * (wheel->spring->length * wheel->extension);
       }
       else 
       {
@@ -1056,6 +1308,35 @@ void WheeledVehicle::updateForces(F32 dt)
          wheel->Dx += (-wheel->tire->lateralRelaxation *
                        mFabs(wheel->avel) * wheel->Dx) * dt;
       }
+   }
+
+   evaluateTires(lanes, laneCount, dt);
+
+   // Sum up tire forces and wheel torque
+   for (Wheel* wheel = mWheel; wheel < wend; wheel++)  
+   {
+      if (!wheel->tire || !wheel->spring)
+         continue;
+
+      F32 Fy = 0;
+      const S32 lane = wheelLane[wheel - mWheel];
+      if (lane != -1) 
+      {
+         F32 Fx = lanes.Fx[lane];
+         Fy = lanes.Fy[lane];
+         wheel->Dx = lanes.Dx[lane];
+         wheel->Dy = lanes.Dy[lane];
+         wheel->slipping = lanes.slipping[lane] != 0;
+         wheel->slip = wheel->slipping ? 1 - lanes.K[lane] : 0;
+
+         // Tire forces act through the tire direction vectors parallel
+         // to the surface and are applied at the wheel hub.
+         Point3F r, t, forceVector = (laneTireX[lane] * Fx) + (laneTireY[lane] * Fy);
+         mRigid.getOriginVector(laneHubPos[lane],&r);
+         mCross(r, forceVector, &t);
+         mRigid.torque += t;
+         mRigid.force += forceVector;
+      }
 
       // Adjust the wheel's angular velocity based on engine torque
       // and tire deformation forces.
@@ -1136,7 +1417,18 @@ void WheeledVehicle::extendWheels(bool clientHack)
       currMatrix = getRenderTransform();
    else
       mRigid.getTransform(&currMatrix);
-   
+
+   // Use the contacts cast by the batched wheel pass if the
+   // vehicle is still where the rays were cast from.  They are
+   // only good for the first integration step.
+   WheelSweep* sweep = NULL;
+   if (!clientHack && mWheelSweep.valid)
+   {
+      if (mWheelSweep.linPosition == mRigid.linPosition &&
+          mWheelSweep.angPosition == mRigid.angPosition)
+         sweep = &mWheelSweep;
+      mWheelSweep.valid = false;
+   }
 
    // Does a single ray cast down for now... this will have to be
    // changed to something a little more complicated to avoid getting
@@ -1151,15 +1443,22 @@ void WheeledVehicle::extendWheels(bool clientHack)
          // The ray is cast from the spring mount point to the tip of
          // the tire.  If there is a collision the spring extension is
          // adjust to remove the tire radius.
-         Point3F sp,vec;
-         currMatrix.mulP(wheel->data->pos,&sp);
-         currMatrix.mulV(VectorF(0,0,-wheel->spring->length),&vec);
-         F32 ts = wheel->tire->radius / wheel->spring->length;
-         Point3F ep = sp + (vec * (1 + ts));
-         ts = ts / (1+ts);
+         Point3F sp,ep;
+         F32 ts;
+         _getWheelRay(wheel, currMatrix, &sp, &ep, &ts);
 
          RayInfo rInfo;
-         if (mContainer->castRay(sp, ep, sClientCollisionMask & ~PlayerObjectType, &rInfo)) 
+         bool hit;
+         const U32 index = wheel - mWheel;
+         if (sweep && (!sweep->hit[index] || !sweep->object[index].isNull()))
+         {
+            hit = sweep->hit[index];
+            rInfo = sweep->info[index];
+         }
+         else
+            hit = mContainer->castRay(sp, ep, sClientCollisionMask & ~PlayerObjectType, &rInfo);
+
+         if (hit) 
          {
             wheel->surface.contact  = true;
             wheel->extension = (rInfo.t < ts)? 0: (rInfo.t - ts) / (1 - ts);
@@ -1178,6 +1477,44 @@ void WheeledVehicle::extendWheels(bool clientHack)
    enableCollision();
 }
 
+void WheeledVehicle::_getWheelRay(const Wheel* wheel, const MatrixF& mat, Point3F* outStart, Point3F* outEnd, F32* outTireT) const
+{
+   Point3F vec;
+   mat.mulP(wheel->data->pos,outStart);
+   mat.mulV(VectorF(0,0,-wheel->spring->length),&vec);
+   F32 ts = wheel->tire->radius / wheel->spring->length;
+   *outEnd = *outStart + (vec * (1 + ts));
+   *outTireT = ts / (1+ts);
+}
+
+U32 WheeledVehicle::_prepareWheelSweep(Vector<SceneContainer::RayQuery>* queries)
+{
+   // Mounted vehicles don't simulate.
+   if (!mDataBlock || !mContainer || isMounted())
+      return 0;
+
+   MatrixF currMatrix;
+   mRigid.getTransform(&currMatrix);
+
+   U32 count = 0;
+   Wheel* wend = &mWheel[mDataBlock->wheelCount];
+   for (Wheel* wheel = mWheel; wheel < wend; wheel++) 
+   {
+      if (!wheel->tire || !wheel->spring)
+         continue;
+
+      F32 ts;
+      queries->increment();
+      SceneContainer::RayQuery& query = queries->last();
+      _getWheelRay(wheel, currMatrix, &query.start, &query.end, &ts);
+      query.mask = sClientCollisionMask & ~PlayerObjectType;
+      query.ignore = this;
+      count++;
+   }
+
+   return count;
+}
+
 
 //----------------------------------------------------------------------------
 /** Update wheel steering and suspension threads.
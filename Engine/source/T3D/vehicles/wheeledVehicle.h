@@ -31,6 +31,10 @@
 #include "collision/clippedPolyList.h"
 #endif
 
+#ifndef _COLLISION_H_
+#include "collision/collision.h"
+#endif
+
 class ParticleEmitter;
 class ParticleEmitterData;
 
@@ -202,6 +206,34 @@ class WheeledVehicle: public Vehicle
    Wheel mWheel[WheeledVehicleData::MaxWheels];
    TSThread* mSteeringThread;
 
+   friend class WheeledVehicleManager;
+
+   /// Wheel contacts cast ahead of the tick by WheeledVehicleManager
+   /// together with the wheels of all other vehicles.
+   struct WheelSweep
+   {
+      bool valid;
+
+      /// Rigid state the rays were cast from.  The contacts are only
+      /// used if the vehicle has not moved since.
+      Point3F linPosition;
+      QuatF angPosition;
+
+      bool hit[WheeledVehicleData::MaxWheels];
+      RayInfo info[WheeledVehicleData::MaxWheels];
+      SimObjectPtr<SceneObject> object[WheeledVehicleData::MaxWheels];
+   };
+   WheelSweep mWheelSweep;
+
+   /// Get the ray cast from the spring mount point of @a wheel to the tip of
+   /// its tire.  @a outTireT receives the position along the ray at which the
+   /// tire radius starts.
+   void _getWheelRay(const Wheel* wheel, const MatrixF& mat, Point3F* outStart, Point3F* outEnd, F32* outTireT) const;
+
+   /// Add the wheel rays for the coming tick to @a queries.
+   /// @return The number of rays added.
+   U32 _prepareWheelSweep(Vector<SceneContainer::RayQuery>* queries);
+
    //
    bool onNewDataBlock( GameBaseData *dptr, bool reload );
    void processTick(const Move *move);
@@ -223,6 +255,9 @@ public:
    DECLARE_CONOBJECT(WheeledVehicle);
    static void initPersistFields();
 
+   /// If true, the wheel rays of all vehicles are cast in one batch per tick.
+   static bool smBatchWheelRays;
+
    WheeledVehicle();
    ~WheeledVehicle();
 
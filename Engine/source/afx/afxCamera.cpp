@@ -933,7 +933,7 @@ void afxCamera::writePacketData(GameConnection *connection, BitStream *bstream)
     if(writeMode == OrbitObjectMode)
     {
       bstream->writeFlag(mObservingClientObject);                         // SND OBSERVING CLIENT OBJ
-      bstream->writeInt(gIndex, NetConnection::GhostIdBitSize);           // SND ORBIT OBJ
+      NetConnection::writeGhostIndex(bstream, gIndex);                    // SND ORBIT OBJ
     }
     if (writeMode == OrbitPointMode)
       bstream->writeCompressedPoint(writePos);                            // WRITE COMPRESSION POINT
@@ -979,7 +979,7 @@ void afxCamera::readPacketData(GameConnection *connection, BitStream *bstream)
     if(mode == OrbitObjectMode)
     {
       mObservingClientObject = bstream->readFlag();
-      S32 gIndex = bstream->readInt(NetConnection::GhostIdBitSize);
+      S32 gIndex = NetConnection::readGhostIndex(bstream);
       obj = static_cast<GameBase*>(connection->resolveGhost(gIndex));
     }
     if (mode == OrbitPointMode)
@@ -1123,6 +1123,106 @@ bool afxEffectWrapper::isDone()
 }
 
 
+//~~~~~~~~~~~~~~~~~~~~//~~~~~~~~~~~~~~~~~~~~//~~~~~~~~~~~~~~~~~~~~//~~~~~~~~~~~~~~~~~~~~~//
+// afxEffectWrapperPool
+//
+//  Every cast of a spell or effectron creates a wrapper for each of its effects
+//  and deletes it when the effect ends. This pool recycles the memory of the
+//  wrappers instead of going to the heap each time. The adapter classes have
+//  different sizes, so blocks are kept in free-lists by size class. Each block
+//  starts with a small header recording its size class. Wrappers are only
+//  created and deleted on the main thread.
+
+class afxEffectWrapperPool : public IEngineObjectPool
+{
+  enum
+  {
+    HEADER_SIZE = 16,
+    SIZE_GRANULE = 64,
+    NUM_SIZE_CLASSES = 32,   // wrappers up to 2K
+    MAX_FREE = 256           // per size class
+  };
+
+  void*   free_lists[NUM_SIZE_CLASSES];
+  U32     n_free[NUM_SIZE_CLASSES];
+
+public:
+  afxEffectWrapperPool()
+  {
+    dMemset(free_lists, 0, sizeof(free_lists));
+    dMemset(n_free, 0, sizeof(n_free));
+  }
+
+  virtual ~afxEffectWrapperPool()
+  {
+    for (S32 i = 0; i < NUM_SIZE_CLASSES; i++)
+    {
+      while (free_lists[i])
+      {
+        U8* ptr = (U8*) free_lists[i];
+        free_lists[i] = *reinterpret_cast<void**>(ptr);
+        IEngineObjectPool::DEFAULT->freeObject(ptr - HEADER_SIZE);
+      }
+    }
+  }
+
+  // IEngineObjectPool
+  virtual void* allocateObject(U32 size TORQUE_TMM_ARGS_DECL)
+  {
+    U32 size_class = (size + SIZE_GRANULE - 1)/SIZE_GRANULE - 1;
+    if (size_class >= NUM_SIZE_CLASSES)
+      return NULL;
+
+    U8* ptr = (U8*) free_lists[size_class];
+    if (ptr)
+    {
+      free_lists[size_class] = *reinterpret_cast<void**>(ptr);
+      n_free[size_class]--;
+      return ptr;
+    }
+
+    U8* block = (U8*) IEngineObjectPool::DEFAULT->allocateObject((size_class + 1)*SIZE_GRANULE + HEADER_SIZE TORQUE_TMM_ARGS);
+    if (!block)
+      return NULL;
+
+    *reinterpret_cast<U32*>(block) = size_class;
+    return block + HEADER_SIZE;
+  }
+
+  virtual void freeObject(void* obj)
+  {
+    U8* ptr = (U8*) obj;
+    U32 size_class = *reinterpret_cast<U32*>(ptr - HEADER_SIZE);
+    if (n_free[size_class] >= MAX_FREE)
+    {
+      IEngineObjectPool::DEFAULT->freeObject(ptr - HEADER_SIZE);
+      return;
+    }
+
+    *reinterpret_cast<void**>(ptr) = free_lists[size_class];
+    free_lists[size_class] = ptr;
+    n_free[size_class]++;
+  }
+};
+
+static afxEffectWrapperPool sWrapperPool;
+
+#include "platform/tmm_off.h"
+
+#ifndef TORQUE_DISABLE_MEMORY_MANAGER
+void* afxEffectWrapper::operator new(size_t size)
+{
+  return Parent::operator new(size, static_cast<IEngineObjectPool*>(&sWrapperPool));
+}
+#endif
+
+void* afxEffectWrapper::operator new(size_t size TORQUE_TMM_ARGS_DECL)
+{
+  return Parent::operator new(size, static_cast<IEngineObjectPool*>(&sWrapperPool) TORQUE_TMM_ARGS);
+}
+
+#include "platform/tmm_on.h"
+
 //~~~~~~~~~~~~~~~~~~~~//~~~~~~~~~~~~~~~~~~~~//~~~~~~~~~~~~~~~~~~~~//~~~~~~~~~~~~~~~~~~~~~//
 
 // static 
@@ -383,6 +383,14 @@ public:
 
   static afxEffectWrapper* ew_create(afxChoreographer*, afxEffectWrapperData*, afxConstraintMgr*, F32 time_factor, S32 group_index=0);
 
+  // Wrappers are created and deleted for every effect of every cast, so
+  // their memory is recycled through a pool instead of the heap.
+#ifndef TORQUE_DISABLE_MEMORY_MANAGER
+  void*             operator new(size_t size);
+#endif
+  void*             operator new(size_t size TORQUE_TMM_ARGS_DECL);
+  void*             operator new(size_t size, void* ptr) { return ptr; }
+
   DECLARE_CONOBJECT(afxEffectWrapper);
   DECLARE_CATEGORY("AFX");
 };
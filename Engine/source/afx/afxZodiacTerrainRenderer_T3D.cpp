@@ -286,7 +286,7 @@ void afxZodiacTerrainRenderer::render(SceneRenderState* state)
       GFXPrimitive cell_prim;
       GFXVertexBufferHandle<TerrVertex> cell_verts;
       GFXPrimitiveBufferHandle  primBuff;
-      elem.cell->getRenderPrimitive(&cell_prim, &cell_verts, &primBuff);
+      ((TerrCell*)elem.cell)->getRenderPrimitive(&cell_prim, &cell_verts, &primBuff);
 
       U32 n_nonskirt_tris = TerrCellSpy::getMinCellSize()*TerrCellSpy::getMinCellSize()*2;
 
@@ -96,9 +96,6 @@ bool afxEA_Debris::ea_start()
 
   do_runtime_substitutions();
 
-  debris = new Debris();
-  debris->onNewDataBlock(debris_data, false);
-
   return true;
 }
 
@@ -113,17 +110,26 @@ bool afxEA_Debris::ea_update(F32 dt)
     }
   }
 
-  if (!exploded && debris)
+  if (!exploded)
   {
     if (in_scope)
     {     
+      // debris used as a constraint object is followed until it is deleted,
+      // so only other debris can be a dormant one from the debris pool.
+      if (datablock->use_as_cons_obj)
+      {
+        debris = new Debris();
+        debris->onNewDataBlock(debris_data, false);
+      }
+      else
+        debris = Debris::create(debris_data);
+
       Point3F dir_vec(0,1,0);
       updated_xfm.mulV(dir_vec);
 
       debris->init(updated_pos, dir_vec);
-      if (!debris->registerObject())
+      if (!debris->spawn())
       {
-        delete debris;
         debris = 0;
         Con::errorf("afxEA_Debris::ea_update() -- effect failed to register.");
         return false;
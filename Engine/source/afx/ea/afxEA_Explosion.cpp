@@ -80,24 +80,23 @@ bool afxEA_Explosion::ea_start()
 
   do_runtime_substitutions();
 
-  explosion = new Explosion();
-  explosion->setSubstitutionData(choreographer, group_index);
-  explosion->setDataBlock(explosion_data);
-
   return true;
 }
 
 bool afxEA_Explosion::ea_update(F32 dt)
 {
-  if (!exploded && explosion)
+  if (!exploded)
   {
     if (in_scope)
     {
+      // the explosion is created here, once it is known to be needed, so it
+      // can be a dormant one from the explosion pool.
+      explosion = Explosion::create(explosion_data);
+      explosion->setSubstitutionData(choreographer, group_index);
       Point3F norm(0,0,1); updated_xfm.mulV(norm);
       explosion->setInitialState(updated_pos, norm);
-      if (!explosion->registerObject())
+      if (!explosion->spawn())
       {
-        delete explosion;
         explosion = 0;
         Con::errorf("afxEA_Explosion::ea_update() -- effect failed to register.");
         return false;
@@ -111,8 +111,17 @@ bool afxEA_ParticleEmitter::ea_start()
    }
    else
    {
-      emitter = new ParticleEmitter();
-      emitter->onNewDataBlock(emitter_data, false);
+      // plain emitters can be dormant ones from the emitter pool unless
+      // they join a particle-pool, which happens as they are registered.
+#if defined(AFX_CAP_PARTICLE_POOLS)
+      if (emitter_data->pool_datablock)
+      {
+         emitter = new ParticleEmitter();
+         emitter->onNewDataBlock(emitter_data, false);
+      }
+      else
+#endif
+         emitter = ParticleEmitter::create(emitter_data);
    }
 #endif
 
@@ -152,9 +161,8 @@ bool afxEA_ParticleEmitter::ea_start()
   }
 #endif
 
-  if (!emitter->registerObject())
+  if (!emitter->spawn())
   {
-    delete emitter;
     emitter = NULL;
     Con::errorf("afxEA_ParticleEmitter::ea_start() -- effect failed to register.");
     return false;
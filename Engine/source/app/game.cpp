@@ -292,3 +292,13 @@ bool serverProcess(U32 timeDelta)
    return ret;
 }
 
+U32 serverTimeToNextTick()
+{
+#ifndef TORQUE_TGB_ONLY
+   SimTime lastTime = ServerProcessList::get()->getLastTime();
+#else
+   SimTime lastTime = gt2dNetworkServerProcess.getLastTime();
+#endif
+   return TickMs - (lastTime % TickMs);
+}
+
@@ -34,4 +34,7 @@ bool clientProcess(U32 timeDelta);
 /// Processes the next cycle on the server.  This function will only have an effect when executed on the server.
 bool serverProcess(U32 timeDelta);
 
+/// Returns the milliseconds of process time left until the next server tick.
+U32 serverTimeToNextTick();
+
 #endif
@@ -55,9 +55,12 @@
 #include "sim/netStringTable.h"
 #include "sim/actionMap.h"
 #include "sim/netInterface.h"
+#include "sim/netConnection.h"
+#include "app/version.h"
 
 #include "util/sampler.h"
 #include "platform/threads/threadPool.h"
+#include "platform/threads/jobSystem.h"
 
 // For the TickMs define... fix this for T2D...
 #include "T3D/gameBase/processList.h"
@@ -78,6 +81,8 @@ DITTS( F32, gTimeScale, 1.0 );
 DITTS( U32, gTimeAdvance, 0 );
 DITTS( U32, gFrameSkip, 0 );
 
+static bool gSleepToNextTick = true;
+
 extern S32 sgBackgroundProcessSleepTime;
 extern S32 sgTimeManagerProcessInterval;
 
@@ -137,6 +142,175 @@ namespace engineAPI
 
 #endif
 
+//-----------------------------------------------------------------------------
+// Server tick statistics
+
+namespace {
+
+/// Cost of every server process pass that ticked, collected between
+/// startServerTickStats() and stopServerTickStats().
+struct ServerTickStats
+{
+   bool mActive;
+   String mReportFile;
+   PlatformTimer* mTimer;
+   U32 mStartSimTime;
+   Vector< F32 > mTickMs;
+   Vector< U32 > mTickAllocs;
+
+   ServerTickStats() : mActive( false ), mTimer( NULL ), mStartSimTime( 0 ) {}
+};
+
+ServerTickStats gServerTickStats;
+
+/// Total number of allocations made so far.  Only counted with memory tags.
+U32 getTotalAllocations()
+{
+   U32 total = 0;
+#ifdef TORQUE_MEMORY_TAGS
+   for ( U32 i = 0; i < Memory::getNumTags(); i++ )
+   {
+      Memory::TagStats stats;
+      Memory::getTagStats( i, stats );
+      total += stats.mTotalAllocs;
+   }
+#endif
+   return total;
+}
+
+S32 QSORT_CALLBACK compareTickTimes( const void* a, const void* b )
+{
+   const F32 fa = *( const F32* ) a;
+   const F32 fb = *( const F32* ) b;
+   return fa < fb ? -1 : ( fa > fb ? 1 : 0 );
+}
+
+void startServerTickStats( const char* reportFile )
+{
+   gServerTickStats.mActive = true;
+   gServerTickStats.mReportFile = reportFile;
+   if ( !gServerTickStats.mTimer )
+      gServerTickStats.mTimer = PlatformTimer::create();
+   gServerTickStats.mStartSimTime = Sim::getCurrentTime();
+   gServerTickStats.mTickMs.clear();
+   gServerTickStats.mTickAllocs.clear();
+
+   for ( NetConnection* conn = NetConnection::getConnectionList(); conn; conn = conn->getNext() )
+      conn->resetTrafficStats();
+}
+
+/// Print the collected statistics and write them to the report file as
+/// JSON if one was given.
+void stopServerTickStats()
+{
+   if ( !gServerTickStats.mActive )
+      return;
+   gServerTickStats.mActive = false;
+
+   Vector< F32 > times = gServerTickStats.mTickMs;
+   const U32 count = times.size();
+   F32 total = 0.0f;
+   for ( U32 i = 0; i < count; i++ )
+      total += times[ i ];
+   if ( count )
+      dQsort( times.address(), count, sizeof( F32 ), compareTickTimes );
+
+   #define TICK_PERCENTILE( p ) ( count ? times[ getMin( U32( count * p ), count - 1 ) ] : 0.0f )
+   const F32 mean = count ? total / count : 0.0f;
+   const F32 p50 = TICK_PERCENTILE( 0.5f );
+   const F32 p90 = TICK_PERCENTILE( 0.9f );
+   const F32 p99 = TICK_PERCENTILE( 0.99f );
+   const F32 maxMs = count ? times.last() : 0.0f;
+   #undef TICK_PERCENTILE
+
+   U32 totalAllocs = 0;
+   U32 maxAllocs = 0;
+   for ( U32 i = 0; i < gServerTickStats.mTickAllocs.size(); i++ )
+   {
+      totalAllocs += gServerTickStats.mTickAllocs[ i ];
+      maxAllocs = getMax( maxAllocs, gServerTickStats.mTickAllocs[ i ] );
+   }
+   const F32 meanAllocs = count ? F32( totalAllocs ) / count : 0.0f;
+   const F32 seconds = getMax( F32( Sim::getCurrentTime() - gServerTickStats.mStartSimTime ) / 1000.0f, 0.001f );
+
+   Con::printf( "Server ticks: %u, mean %.3f ms, p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms",
+      count, mean, p50, p90, p99, maxMs );
+#ifdef TORQUE_MEMORY_TAGS
+   Con::printf( "Allocations per tick: mean %.1f, max %u", meanAllocs, maxAllocs );
+#endif
+
+   String connections;
+   for ( NetConnection* conn = NetConnection::getConnectionList(); conn; conn = conn->getNext() )
+   {
+      if ( conn->isConnectionToServer() )
+         continue;
+
+      char address[ 256 ] = "local";
+      if ( conn->isNetworkConnection() )
+         Net::addressToString( conn->getNetAddress(), address );
+
+      const F32 upKbps = conn->getBytesReceived() * 8.0f / 1000.0f / seconds;
+      const F32 downKbps = conn->getBytesSent() * 8.0f / 1000.0f / seconds;
+      Con::printf( "   Connection %d (%s): sent %u bytes in %u packets (%.1f kbps), received %u bytes in %u packets (%.1f kbps)",
+         conn->getId(), address, conn->getBytesSent(), conn->getPacketsSent(), downKbps,
+         conn->getBytesReceived(), conn->getPacketsReceived(), upKbps );
+
+      if ( connections.isNotEmpty() )
+         connections += ",\n";
+      connections += String::ToString( "      { \"id\": %d, \"address\": \"%s\", \"bytesSent\": %u, \"packetsSent\": %u, "
+         "\"bytesReceived\": %u, \"packetsReceived\": %u }",
+         conn->getId(), address, conn->getBytesSent(), conn->getPacketsSent(),
+         conn->getBytesReceived(), conn->getPacketsReceived() );
+   }
+
+   if ( gServerTickStats.mReportFile.isEmpty() )
+      return;
+
+   FileStream* stream = FileStream::createAndOpen( gServerTickStats.mReportFile, Torque::FS::File::Write );
+   if ( !stream )
+   {
+      Con::errorf( "stopServerTickStats - Could not open '%s' for writing", gServerTickStats.mReportFile.c_str() );
+      return;
+   }
+
+   stream->writeText( String::ToString( "{\n   \"version\": \"%s\",\n   \"seconds\": %.3f,\n   \"ticks\": %u,\n"
+      "   \"tickMs\": { \"mean\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f },\n",
+      getVersionString(), seconds, count, mean, p50, p90, p99, maxMs ) );
+#ifdef TORQUE_MEMORY_TAGS
+   stream->writeText( String::ToString( "   \"allocsPerTick\": { \"mean\": %.2f, \"max\": %u },\n", meanAllocs, maxAllocs ) );
+#endif
+   stream->writeText( String::ToString( "   \"connections\": [\n%s\n   ]\n}\n", connections.c_str() ) );
+   delete stream;
+}
+
+}
+
+DefineEngineFunction( startServerTickStats, void, ( const char* reportFile ), ( "" ),
+   "@brief Start measuring the CPU time and allocations of every server tick and "
+   "the traffic of every client connection.\n\n"
+
+   "Combined with journals this benchmarks the server against recorded traffic: "
+   "record a dedicated server session with saveJournal(), then play it back with "
+   "playJournal() and $platform::journalRealTime set to false while collecting "
+   "statistics.  If collection is still running when the journal ends, the "
+   "statistics are reported on shutdown.\n\n"
+
+   "@param reportFile If given, the statistics are also written to this file as JSON.\n"
+   "@note Allocations are only counted in builds with TORQUE_MEMORY_TAGS.\n"
+   "@see stopServerTickStats()\n"
+   "@ingroup Platform\n")
+{
+   startServerTickStats( reportFile );
+}
+
+DefineEngineFunction( stopServerTickStats, void, (),,
+   "@brief Stop collecting server tick statistics and report them.\n\n"
+   "@see startServerTickStats()\n"
+   "@ingroup Platform\n")
+{
+   stopServerTickStats();
+}
+
 // Process a time event and update all sub-processes
 void processTimeEvent(S32 elapsedTime)
 {
@@ -166,6 +340,14 @@ void processTimeEvent(S32 elapsedTime)
          timeDelta = TickMs;
 
    bool tickPass;
+
+   const bool collectTickStats = gServerTickStats.mActive;
+   U32 allocsBefore = 0;
+   if ( collectTickStats )
+   {
+      allocsBefore = getTotalAllocations();
+      gServerTickStats.mTimer->reset();
+   }
    
    PROFILE_START(ServerProcess);
    tickPass = serverProcess(timeDelta);
@@ -179,6 +361,12 @@ void processTimeEvent(S32 elapsedTime)
    Con::setBoolVariable( "$pref::hasServerTicked", tickPass );
    PROFILE_END();
 
+   if ( collectTickStats && tickPass )
+   {
+      gServerTickStats.mTickMs.push_back( F32( gServerTickStats.mTimer->getElapsedUs() ) / 1000.0f );
+      gServerTickStats.mTickAllocs.push_back( getTotalAllocations() - allocsBefore );
+   }
+
    
    PROFILE_START(SimAdvanceTime);
    Sim::advanceTime(timeDelta);
@@ -266,6 +454,7 @@ void StandardMainLoop::init()
    Platform::initConsole();
    
    ThreadPool::GlobalThreadPool::createSingleton();
+   JobSystem::GlobalJobSystem::createSingleton();
 
    // Initialize modules.
    
@@ -288,6 +477,9 @@ void StandardMainLoop::init()
 	   "@ingroup platform");
    Con::addVariable("frameSkip", TypeS32, &ATTS(gFrameSkip), "Sets the number of frames to skip while rendering the scene.\n"
 	   "@ingroup platform");
+   Con::addVariable("$platform::sleepToNextTick", TypeBool, &gSleepToNextTick, "Without a window, sleep until the next server tick or scheduled event "
+      "is due instead of polling every $platform::timeManagerProcessInterval ms.\n"
+	   "@ingroup platform");
 
    Con::setVariable( "defaultGame", StringTable->insert("scripts") );
 
@@ -333,6 +525,11 @@ void StandardMainLoop::init()
 
 void StandardMainLoop::shutdown()
 {
+   // Report statistics left running for a journal replay
+   // while the connections are still around.
+   stopServerTickStats();
+   SAFE_DELETE( gServerTickStats.mTimer );
+
    // Stop the Input Event Manager
    INPUTMGR->stop();
 
@@ -349,6 +546,7 @@ void StandardMainLoop::shutdown()
    
    EngineModuleManager::shutdownSystem();
    
+   JobSystem::GlobalJobSystem::deleteSingleton();
    ThreadPool::GlobalThreadPool::deleteSingleton();
 
 #ifdef TORQUE_ENABLE_VFS
@@ -368,6 +566,7 @@ void StandardMainLoop::shutdown()
 
    _StringTable::destroy();
    FrameAllocator::destroy();
+   ThreadFrameAllocator::destroy();
    Net::shutdown();
    Sampler::destroy();
    
@@ -617,10 +816,20 @@ bool StandardMainLoop::doMainLoop()
       else
       {
          tm->setBackground(false);
+
+         // A dedicated server has nothing to do before the next tick or
+         // scheduled event, so don't wake up before then.
+         if(gSleepToNextTick && ATTS(gTimeScale) == 1.0f && !ATTS(gTimeAdvance))
+         {
+            U32 delay = getMin(serverTimeToNextTick(), Sim::getTimeToNextEvent());
+            tm->setNextEventDelay(getMax(delay, U32(tm->getForegroundThreshold())));
+         }
       }
       
+      PROFILE_FRAME_BEGIN();
       PROFILE_START(MainLoop);
       Sampler::beginFrame();
+      ThreadFrameAllocator::beginFrame();
 
       if(!Process::processEvents())
          keepRunning = false;
@@ -26,7 +26,9 @@
 #include "core/stream/fileStream.h"
 #include "console/simBase.h"
 #include "console/consoleInternal.h"
+#include "console/consoleTypes.h"
 #include "console/engineAPI.h"
+#include "core/stringTable.h"
 
 IMPLEMENT_CONOBJECT(HTTPObject);
 
@@ -38,6 +40,11 @@ ConsoleDocClass( HTTPObject,
    "with a server is different than TCPObject.  Rather than opening a connection, sending data, "
    "waiting to receive data, and then closing the connection, you issue a get() or post() and "
    "handle the response.  The connection is automatically created and destroyed for you.\n\n"
+
+   "With keepAlive set the connection isn't closed once the response is complete but kept around "
+   "for the next request to the same host, saving the connection setup.  onDisconnect() is still "
+   "called when the response is complete.  With bufferBody set the body arrives in a single "
+   "onBody() call instead of one onLine() call per line.\n\n"
    
    "@tsexample\n"
       "// In this example we'll retrieve the weather in Las Vegas using\n"
@@ -111,6 +118,12 @@ ConsoleDocClass( HTTPObject,
    "@ingroup Networking\n"
 );
 
+IMPLEMENT_CALLBACK(HTTPObject, onBody, void, (U32 status, const char* body), (status, body),
+   "@brief Called with the whole response body once it has been received when bufferBody is set.\n\n"
+   "@param status HTTP status code of the response.\n"
+   "@param body The response body.\n"
+   );
+
 //--------------------------------------
 
 HTTPObject::HTTPObject()
@@ -120,6 +133,12 @@ HTTPObject::HTTPObject()
    mQuery = 0;
    mPost = 0;
    mBufferSave = 0;
+   mContentType = 0;
+   mStatus = 0;
+   mParseState = ProcessingDone;
+   mKeepAlive = true;
+   mBufferBody = false;
+   mReusedConnection = false;
 }
 
 HTTPObject::~HTTPObject()
@@ -136,6 +155,18 @@ HTTPObject::~HTTPObject()
    dFree(mBufferSave);
 }
 
+void HTTPObject::initPersistFields()
+{
+   addField("keepAlive", TypeBool, Offset(mKeepAlive, HTTPObject),
+      "Keep the connection open once the response is complete and reuse it for the next request to the "
+      "same host from any HTTPObject.\n\n"
+      "@see $TCPObject::poolIdleTimeout");
+   addField("bufferBody", TypeBool, Offset(mBufferBody, HTTPObject),
+      "Collect the response body and deliver it in one onBody() call instead of calling onLine() for every line.");
+
+   Parent::initPersistFields();
+}
+
 //--------------------------------------
 //--------------------------------------
 void HTTPObject::get(const char *host, const char *path, const char *query)
@@ -160,7 +191,7 @@ void HTTPObject::get(const char *host, const char *path, const char *query)
       mQuery = NULL;
    mPost = NULL;
 
-   connect(host);
+   _openConnection();
 }
 
 void HTTPObject::post(const char *host, const char *path, const char *query, const char *post)
@@ -184,7 +215,26 @@ void HTTPObject::post(const char *host, const char *path, const char *query, con
    else
       mQuery = NULL;
    mPost = dStrdup(post);
-   connect(host);
+
+   _openConnection();
+}
+
+void HTTPObject::_openConnection()
+{
+   // Anything still in flight is superseded by the new request.
+   mParseState = ParsingStatusLine;
+
+   if(mKeepAlive && acquireFromPool(mHostName))
+   {
+      mReusedConnection = true;
+      onConnected();
+   }
+   else
+   {
+      mReusedConnection = false;
+      disconnect();
+      connect(mHostName);
+   }
 }
 
 static char getHex(char c)
@@ -267,24 +317,40 @@ void HTTPObject::onConnected()
    if(pt)
       *pt = 0;
 
+   const char *connection = mKeepAlive ? "keep-alive" : "close";
+   String request;
+
    //If we want to do a get request
    if(mPost == NULL)
    {
-      dSprintf(buffer, sizeof(buffer), "GET %s HTTP/1.1\r\nHost: %s\r\n\r\n", expPath, mHostName);
+      request = String::ToString("GET %s HTTP/1.1\r\nHost: %s\r\nConnection: %s\r\n\r\n", expPath, mHostName, connection);
    }
    //Else we want to do a post request
    else
    {
-      dSprintf(buffer, sizeof(buffer), "POST %s HTTP/1.1\r\nHost: %s\r\nContent-Type: application/x-www-form-urlencoded\r\nContent-Length: %i\r\n\r\n%s\r\n\r\n",
-         expPath, mHostName, dStrlen(mPost), mPost);
+      // Nothing may follow the body or it'd be taken for the next request
+      // on a kept alive connection.
+      request = String::ToString("POST %s HTTP/1.1\r\nHost: %s\r\nConnection: %s\r\nContent-Type: application/x-www-form-urlencoded\r\nContent-Length: %i\r\n\r\n",
+         expPath, mHostName, connection, dStrlen(mPost));
+      request += mPost;
    }
 
    if(pt)
       *pt = ':';
 
-   send((U8*)buffer, dStrlen(buffer));
    mParseState = ParsingStatusLine;
    mChunkedEncoding = false;
+   mHasContentLength = false;
+   mContentLength = 0;
+   mContentType = 0;
+   mStatus = 0;
+   mCloseAfterResponse = !mKeepAlive;
+   mBody.clear();
+   emptyBuffer();
+   dFree(mBufferSave);
+   mBufferSave = 0;
+
+   send((const U8*)request.c_str(), request.length());
 }
 
 void HTTPObject::onConnectFailed()
@@ -301,6 +367,28 @@ void HTTPObject::onConnectFailed()
 
 void HTTPObject::onDisconnect()
 {
+   // The server had already given up on the pooled connection when we
+   // sent the request, so try again on a fresh one.
+   if(mReusedConnection && mParseState == ParsingStatusLine && mHostName)
+   {
+      mReusedConnection = false;
+      forgetSocket();
+      connect(mHostName);
+      return;
+   }
+
+   // A body without a length or chunked encoding ends with the connection.
+   if(mBufferBody && mParseState == ProcessingBody)
+   {
+      forgetSocket();
+      mParseState = ProcessingDone;
+      _deliverBody();
+
+      // A new request issued from onBody() supersedes this one.
+      if(mParseState != ProcessingDone)
+         return;
+   }
+
    dFree(mHostName);
    dFree(mPath);
    dFree(mQuery);
@@ -310,24 +398,115 @@ void HTTPObject::onDisconnect()
    Parent::onDisconnect();
 }
 
+void HTTPObject::onEndReceive()
+{
+   Parent::onEndReceive();
+
+   if(mParseState != ProcessingDone || !mHostName)
+      return;
+
+   // Give up the connection before calling into script so a request made
+   // from the callbacks can reuse it right away.
+   if(mKeepAlive && !mCloseAfterResponse)
+      releaseToPool(mHostName);
+   else
+      disconnect();
+
+   _deliverBody();
+
+   // A new request issued from onBody() supersedes this one.
+   if(mParseState != ProcessingDone)
+      return;
+
+   onDisconnect();
+}
+
+void HTTPObject::_beginBody()
+{
+   if(mChunkedEncoding)
+      mParseState = ParsingChunkHeader;
+   else if(mHasContentLength)
+   {
+      mBytesRemaining = mContentLength;
+      mParseState = mBytesRemaining ? ProcessingBody : ProcessingDone;
+   }
+   else if(mStatus == 204 || mStatus == 304)
+      mParseState = ProcessingDone;
+   else
+   {
+      // No way to tell where the body ends but the server disconnecting.
+      mBytesRemaining = U32_MAX;
+      mCloseAfterResponse = true;
+      mParseState = ProcessingBody;
+   }
+}
+
+void HTTPObject::_deliverBody()
+{
+   if(!mBufferBody)
+      return;
+
+   mBody.push_back(0);
+   onBody_callback(mStatus, (const char*)mBody.address());
+   mBody.clear();
+}
+
+/// Return the value of header @\a name if that's what @\a line is.
+static const char *getHeaderValue(const UTF8 *line, const char *name)
+{
+   const U32 len = dStrlen(name);
+   if(dStrnicmp((const char*)line, name, len) || line[len] != ':')
+      return NULL;
+
+   const char *value = (const char*)line + len + 1;
+   while(*value == ' ' || *value == '\t')
+      value++;
+   return value;
+}
+
 bool HTTPObject::processLine(UTF8 *line)
 {
    if(mParseState == ParsingStatusLine)
    {
+      mVersion = 0;
+      mStatus = 0;
+      dSscanf((const char*)line, "HTTP/%f %u", &mVersion, &mStatus);
+
+      // HTTP/1.0 servers close the connection unless told otherwise.
+      if(mVersion < 1.05f)
+         mCloseAfterResponse = true;
+
       mParseState = ParsingHeader;
    }
    else if(mParseState == ParsingHeader)
    {
-      if(!dStricmp((char *) line, "transfer-encoding: chunked"))
-         mChunkedEncoding = true;
+      const char *value;
       if(line[0] == 0)
       {
-         if(mChunkedEncoding)
-            mParseState = ParsingChunkHeader;
-         else
-            mParseState = ProcessingBody;
+         _beginBody();
          return true;
       }
+      else if((value = getHeaderValue(line, "transfer-encoding")) != NULL)
+      {
+         if(dStristr(value, "chunked"))
+            mChunkedEncoding = true;
+      }
+      else if((value = getHeaderValue(line, "content-length")) != NULL)
+      {
+         mContentLength = dAtoi(value);
+         mHasContentLength = true;
+      }
+      else if((value = getHeaderValue(line, "content-type")) != NULL)
+      {
+         mContentType = StringTable->insert(value);
+      }
+      else if((value = getHeaderValue(line, "connection")) != NULL)
+      {
+         if(dStristr(value, "close"))
+            mCloseAfterResponse = true;
+         else if(dStristr(value, "keep-alive") && mKeepAlive)
+            mCloseAfterResponse = false;
+      }
    }
    else if(mParseState == ParsingChunkHeader)
    {
@@ -347,14 +526,25 @@ bool HTTPObject::processLine(UTF8 *line)
             mBufferSave = 0;
          }
          if(mChunkSize)
+         {
+            mBytesRemaining = mChunkSize;
             mParseState = ProcessingBody;
+         }
          else
          {
+            // Flush the last partial line of the body before the trailer.
             mParseState = ProcessingDone;
             finishLastLine();
+            mParseState = ParsingChunkTrailer;
          }
       }
    }
+   else if(mParseState == ParsingChunkTrailer)
+   {
+      // Trailer headers are of no interest, the empty line ends the response.
+      if(line[0] == 0)
+         mParseState = ProcessingDone;
+   }
    else
    {
       return Parent::processLine((UTF8*)line);
@@ -374,12 +564,24 @@ U32 HTTPObject::onReceive(U8 *buffer, U32 bufferLen)
 {
    if(mParseState == ProcessingBody)
    {
-      if(mChunkedEncoding && bufferLen >= mChunkSize)
+      U32 len = getMin(bufferLen, mBytesRemaining);
+      U32 ret;
+      if(mBufferBody)
+      {
+         mBody.merge(buffer, len);
+         ret = len;
+      }
+      else
+         ret = onDataReceive(buffer, len);
+
+      if(mBytesRemaining != U32_MAX)
+         mBytesRemaining -= ret;
+
+      if(mBytesRemaining == 0)
       {
-         U32 ret = onDataReceive(buffer, mChunkSize);
-         mChunkSize -= ret;
-         if(mChunkSize == 0)
+         if(mChunkedEncoding)
          {
+            // Keep a partial line aside while parsing the next chunk header.
             if(mBuffer)
             {
                mBufferSaveSize = mBufferSize;
@@ -389,14 +591,10 @@ U32 HTTPObject::onReceive(U8 *buffer, U32 bufferLen)
             }
             mParseState = ParsingChunkHeader;
          }
-         return ret;
-      }
-      else
-      {
-         U32 ret = onDataReceive(buffer, bufferLen);
-         mChunkSize -= ret;
-         return ret;
+         else
+            mParseState = ProcessingDone;
       }
+      return ret;
    }
    else if(mParseState != ProcessingDone)
    {
@@ -404,6 +602,10 @@ U32 HTTPObject::onReceive(U8 *buffer, U32 bufferLen)
       parseLine(buffer, &start, bufferLen);
       return start;
    }
+
+   // We don't pipeline requests, so anything past the response means the
+   // connection is in no state to be reused.
+   mCloseAfterResponse = true;
    return bufferLen;
 }
 
@@ -462,3 +664,10 @@ DefineEngineMethod( HTTPObject, post, void, ( const char* Address, const char* r
 {
    object->post(Address, requirstURI, query, post);
 }
+
+DefineEngineMethod( HTTPObject, getStatus, S32, (),,
+   "@brief Get the HTTP status code of the last response, e.g. 200.\n\n"
+   "@return The status code, or 0 if no response has been received yet.\n")
+{
+   return object->mStatus;
+}
@@ -39,12 +39,32 @@ protected:
       ParsingStatusLine,
       ParsingHeader,
       ParsingChunkHeader,
+      ParsingChunkTrailer,
       ProcessingBody,
       ProcessingDone,
    };
    ParseState mParseState;
    U32 mTotalBytes;
+
+   /// Bytes left in the current chunk or Content-Length, U32_MAX if the
+   /// body runs until the server disconnects.
    U32 mBytesRemaining;
+
+   bool mHasContentLength;
+
+   /// The server won't keep the connection open after this response.
+   bool mCloseAfterResponse;
+
+   /// The request went out over a pooled connection, so a disconnect
+   /// before any response arrived is retried on a fresh one.
+   bool mReusedConnection;
+
+   /// Body collected for onBody() when mBufferBody is set.
+   Vector<U8> mBody;
+
+   void _openConnection();
+   void _beginBody();
+   void _deliverBody();
  public:
    U32 mStatus;
    F32 mVersion;
@@ -58,6 +78,15 @@ protected:
    char *mPost;
    U8 *mBufferSave;
    U32 mBufferSaveSize;
+
+   /// Return the connection to a per-host pool once the response is
+   /// complete rather than closing it.
+   bool mKeepAlive;
+
+   /// Deliver the body in one onBody() call instead of line by line.
+   bool mBufferBody;
+
+   DECLARE_CALLBACK(void, onBody, (U32 status, const char* body));
 public:
    static void expandPath(char *dest, const char *path, U32 destSize);
    void get(const char *hostName, const char *urlName, const char *query);
@@ -65,6 +94,8 @@ public:
    HTTPObject();
    ~HTTPObject();
 
+   static void initPersistFields();
+
    //static HTTPObject *find(U32 tag);
 
    virtual U32 onDataReceive(U8 *buffer, U32 bufferLen);
@@ -72,6 +103,7 @@ public:
    virtual void onConnected();
    virtual void onConnectFailed();
    virtual void onDisconnect();
+   virtual void onEndReceive();
    bool processLine(UTF8 *line);
 
    DECLARE_CONOBJECT(HTTPObject);
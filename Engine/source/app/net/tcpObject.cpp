@@ -28,9 +28,25 @@
 #include "core/strings/stringUnit.h"
 #include "console/engineAPI.h"
 #include "core/stream/fileStream.h"
+#include "core/module.h"
 
 TCPObject *TCPObject::table[TCPObject::TableSize] = {0, };
 
+Vector<TCPObject::PooledSocket> TCPObject::smSocketPool;
+S32 TCPObject::smPoolIdleTimeout = 10000;
+S32 TCPObject::smPoolMaxPerKey = 4;
+
+AFTER_MODULE_INIT( Sim )
+{
+   Con::addVariable( "$TCPObject::poolIdleTimeout", TypeS32, &TCPObject::smPoolIdleTimeout,
+      "@brief Milliseconds an idle keep-alive connection is kept open for reuse by the next request to the same host.\n\n"
+      "@see HTTPObject::keepAlive\n"
+      "@ingroup Networking" );
+   Con::addVariable( "$TCPObject::poolMaxPerHost", TypeS32, &TCPObject::smPoolMaxPerKey,
+      "@brief Maximum number of idle keep-alive connections kept open per host.\n\n"
+      "@ingroup Networking" );
+}
+
 IMPLEMENT_CONOBJECT(TCPObject);
 
 ConsoleDocClass( TCPObject,
@@ -196,6 +212,102 @@ void TCPObject::removeFromTable()
    }
 }
 
+void TCPObject::forgetSocket()
+{
+   removeFromTable();
+   mTag = NetSocket::INVALID;
+}
+
+//--------------------------------------
+
+void TCPObject::_expireSocketPool()
+{
+   const U32 now = Platform::getRealMilliseconds();
+   for(S32 i = smSocketPool.size() - 1; i >= 0; i--)
+   {
+      if(now - smSocketPool[i].idleSince >= U32(smPoolIdleTimeout))
+      {
+         Net::closeConnectTo(smSocketPool[i].sock);
+         smSocketPool.erase(i);
+      }
+   }
+}
+
+void TCPObject::releaseToPool(const char *key)
+{
+   _expireSocketPool();
+
+   NetSocket sock = mTag;
+   forgetSocket();
+   mState = Disconnected;
+
+   if(sock == NetSocket::INVALID)
+      return;
+
+   S32 count = 0;
+   for(S32 i = 0; i < smSocketPool.size(); i++)
+      if(smSocketPool[i].key.equal(key, String::NoCase))
+         count++;
+
+   if(count >= smPoolMaxPerKey)
+   {
+      Net::closeConnectTo(sock);
+      return;
+   }
+
+   smSocketPool.increment();
+   PooledSocket &entry = smSocketPool.last();
+   entry.key = key;
+   entry.sock = sock;
+   entry.idleSince = Platform::getRealMilliseconds();
+}
+
+bool TCPObject::acquireFromPool(const char *key)
+{
+   _expireSocketPool();
+
+   // Take the most recently used one, it's the least likely to have
+   // been closed by the other end.
+   for(S32 i = smSocketPool.size() - 1; i >= 0; i--)
+   {
+      if(!smSocketPool[i].key.equal(key, String::NoCase))
+         continue;
+
+      NetSocket sock = smSocketPool[i].sock;
+      smSocketPool.erase(i);
+
+      disconnect();
+      addToTable(sock);
+      mState = Connected;
+      return true;
+   }
+
+   return false;
+}
+
+bool TCPObject::dropPooledSocket(NetSocket sock, bool close)
+{
+   for(S32 i = 0; i < smSocketPool.size(); i++)
+   {
+      if(smSocketPool[i].sock == sock)
+      {
+         if(close)
+            Net::closeConnectTo(sock);
+         smSocketPool.erase(i);
+         return true;
+      }
+   }
+
+   return false;
+}
+
+void TCPObject::flushSocketPool()
+{
+   for(S32 i = 0; i < smSocketPool.size(); i++)
+      Net::closeConnectTo(smSocketPool[i].sock);
+   smSocketPool.clear();
+}
+
 void processConnectedReceiveEvent(NetSocket sock, RawData incomingData);
 void processConnectedAcceptEvent(NetSocket listeningPort, NetSocket newConnection, NetAddress originatingAddress);
 void processConnectedNotifyEvent( NetSocket sock, U32 state );
@@ -230,6 +342,8 @@ TCPObject::~TCPObject()
 
    if(gTCPCount == 0)
    {
+      flushSocketPool();
+
       Net::getConnectionAcceptedEvent().remove(processConnectedAcceptEvent);
       Net::getConnectionReceiveEvent().remove(processConnectedReceiveEvent);
       Net::getConnectionNotifyEvent().remove(processConnectedNotifyEvent);
@@ -348,6 +462,8 @@ void TCPObject::onDNSResolved()
 
 void TCPObject::onDNSFailed()
 {
+   // The socket is closed by Net once we return.
+   forgetSocket();
    mState = Disconnected;
    onDNSFailed_callback();
 }
@@ -361,6 +477,8 @@ void TCPObject::onConnected()
 
 void TCPObject::onConnectFailed()
 {
+   // The socket is closed by Net once we return.
+   forgetSocket();
    mState = Disconnected;
    onConnectFailed_callback();
 }
@@ -399,10 +517,18 @@ void TCPObject::emptyBuffer()
 void TCPObject::onDisconnect()
 {
    finishLastLine();
+
+   // The socket is closed by Net once we return.
+   forgetSocket();
    mState = Disconnected;
    onDisconnect_callback();
 }
 
+void TCPObject::onEndReceive()
+{
+   onEndReceive_callback();
+}
+
 void TCPObject::listen(U16 port)
 {
    mState = Listening;
@@ -421,7 +547,7 @@ void TCPObject::disconnect()
    if( mTag != NetSocket::INVALID ) {
       Net::closeConnectTo(mTag);
    }
-   removeFromTable();
+   forgetSocket();
 }
 
 void TCPObject::send(const U8 *buffer, U32 len)
@@ -547,7 +673,9 @@ void processConnectedReceiveEvent(NetSocket sock, RawData incomingData)
    TCPObject *tcpo = TCPObject::find(sock);
    if(!tcpo)
    {
-      Con::printf("Got bad connected receive event.");
+      // Nothing should be sent on an idle connection, so don't keep it.
+      if(!TCPObject::dropPooledSocket(sock, true))
+         Con::printf("Got bad connected receive event.");
       return;
    }
 
@@ -583,7 +711,7 @@ void processConnectedReceiveEvent(NetSocket sock, RawData incomingData)
       }
    }
 
-   tcpo->onEndReceive_callback();
+   tcpo->onEndReceive();
 }
 
 void processConnectedAcceptEvent(NetSocket listeningPort, NetSocket newConnection, NetAddress originatingAddress)
@@ -599,7 +727,11 @@ void processConnectedNotifyEvent( NetSocket sock, U32 state )
 {
    TCPObject *tcpo = TCPObject::find(sock);
    if(!tcpo)
+   {
+      // The other end closed an idle pooled connection.
+      TCPObject::dropPooledSocket(sock, false);
       return;
+   }
 
    switch(state)
    {
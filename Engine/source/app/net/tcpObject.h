@@ -57,7 +57,26 @@ protected:
    U32 mBufferSize;
    U16 mPort;
 
+   /// An idle connection kept open for reuse.
+   struct PooledSocket
+   {
+      String key;
+      NetSocket sock;
+      U32 idleSince;
+   };
+
+   static Vector<PooledSocket> smSocketPool;
+
+   static void _expireSocketPool();
+
 public:
+
+   /// Milliseconds an idle pooled connection is kept open.
+   static S32 smPoolIdleTimeout;
+
+   /// Maximum number of idle connections pooled per key.
+   static S32 smPoolMaxPerKey;
+
    TCPObject();
    virtual ~TCPObject();
 
@@ -78,6 +97,7 @@ public:
    virtual void onConnectFailed();
    virtual void onConnectionRequest(const NetAddress *addr, U32 connectId);
    virtual void onDisconnect();
+   virtual void onEndReceive();
    void connect(const char *address);
    void listen(U16 port);
    void disconnect();
@@ -94,6 +114,26 @@ public:
    void addToTable(NetSocket newTag);
    void removeFromTable();
 
+   /// Stop tracking the socket without closing it, for when Net
+   /// closes it on its own.
+   void forgetSocket();
+
+   /// Hand the current connection to the pool of idle connections under
+   /// @a key instead of closing it.
+   void releaseToPool(const char *key);
+
+   /// Take over an idle pooled connection for @a key.
+   /// @return False if there was none.
+   bool acquireFromPool(const char *key);
+
+   /// Remove @a sock from the pool if it is in there, closing it if
+   /// @a close is set.
+   /// @return False if @a sock wasn't pooled.
+   static bool dropPooledSocket(NetSocket sock, bool close);
+
+   /// Close all pooled connections.
+   static void flushSocketPool();
+
    void setPort(U16 port) { mPort = port; }
 
    bool onAdd();
@@ -58,6 +58,14 @@
 #include "assets/autoloadAssets.h"
 #endif
 
+#ifndef _FILESTREAM_H_
+#include "core/stream/fileStream.h"
+#endif
+
+#ifndef _CRC_H_
+#include "core/crc.h"
+#endif
+
 #ifndef COMPONENTASSET_H
 #include "T3D/assets/ComponentAsset.h"
 #endif
@@ -93,7 +101,8 @@ AssetManager::AssetManager() :
     mEchoInfo( false ),
     mAcquiredReferenceCount( 0 ),
     mMaxLoadedPrivateAssetsCount( 0 ),
-    mIgnoreAutoUnload( true )
+    mIgnoreAutoUnload( true ),
+    mDeclaredAssetsCacheDirectory( "" )
 {
 }
 
@@ -132,6 +141,7 @@ void AssetManager::initPersistFields()
 
     addField( "EchoInfo", TypeBool, Offset(mEchoInfo, AssetManager), "Whether the asset manager echos extra information to the console or not." );
     addField( "IgnoreAutoUnload", TypeBool, Offset(mIgnoreAutoUnload, AssetManager), "Whether the asset manager should ignore unloading of auto-unload assets or not." );
+    addField( "DeclaredAssetsCacheDirectory", TypeString, Offset(mDeclaredAssetsCacheDirectory, AssetManager), "The directory to cache parsed asset declarations in so unchanged asset files are not parsed again.  Empty disables the cache." );
 }
 
 //-----------------------------------------------------------------------------
@@ -2397,6 +2407,164 @@ AssetManager::typeAssetDependsOnHash* AssetManager::getDependedOnAssets()
 }
 //-----------------------------------------------------------------------------
 
+/// Declared assets cache file version.
+static const U32 DeclaredAssetsCacheVersion = 1;
+
+/// The result of parsing a declared asset file and the stamp of the file it came from.
+struct DeclaredAssetCacheEntry
+{
+    DeclaredAssetCacheEntry() :
+        mModifiedTime( 0 ),
+        mFileSize( 0 ),
+        mVisited( false ),
+        mAssetType( StringTable->EmptyString() ),
+        mAssetName( StringTable->EmptyString() ),
+        mAssetDescription( StringTable->EmptyString() ),
+        mAssetCategory( StringTable->EmptyString() ),
+        mAssetAutoUnload( true ),
+        mAssetInternal( false )
+    {
+    }
+
+    U64                         mModifiedTime;
+    U64                         mFileSize;
+    bool                        mVisited;
+    StringTableEntry            mAssetType;
+    StringTableEntry            mAssetName;
+    StringTableEntry            mAssetDescription;
+    StringTableEntry            mAssetCategory;
+    bool                        mAssetAutoUnload;
+    bool                        mAssetInternal;
+    Vector<StringTableEntry>    mAssetDependencies;
+    Vector<StringTableEntry>    mAssetLooseFiles;
+};
+
+typedef HashMap<StringTableEntry, DeclaredAssetCacheEntry> typeDeclaredAssetCacheHash;
+
+//-----------------------------------------------------------------------------
+
+static StringTableEntry readDeclaredAssetsCacheString( Stream& stream )
+{
+    String value;
+    stream.read( &value );
+    return StringTable->insert( value.c_str() );
+}
+
+//-----------------------------------------------------------------------------
+
+static bool loadDeclaredAssetsCache( const char* pCacheFile, typeDeclaredAssetCacheHash& cache )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_LoadDeclaredAssetsCache);
+
+    // Finish if there's no cache yet.
+    if ( !Platform::isFile( pCacheFile ) )
+        return false;
+
+    FileStream stream;
+    if ( !stream.open( pCacheFile, Torque::FS::File::Read ) )
+        return false;
+
+    // Ignore caches written by other versions.
+    U32 version = 0;
+    stream.read( &version );
+    if ( version != DeclaredAssetsCacheVersion )
+        return false;
+
+    U32 entryCount = 0;
+    stream.read( &entryCount );
+
+    for ( U32 entryIndex = 0; entryIndex < entryCount && stream.getStatus() == Stream::Ok; ++entryIndex )
+    {
+        StringTableEntry assetFilePath = readDeclaredAssetsCacheString( stream );
+
+        DeclaredAssetCacheEntry& entry = cache[assetFilePath];
+        entry.mVisited = false;
+        stream.read( &entry.mModifiedTime );
+        stream.read( &entry.mFileSize );
+        entry.mAssetType = readDeclaredAssetsCacheString( stream );
+        entry.mAssetName = readDeclaredAssetsCacheString( stream );
+        entry.mAssetDescription = readDeclaredAssetsCacheString( stream );
+        entry.mAssetCategory = readDeclaredAssetsCacheString( stream );
+        stream.read( &entry.mAssetAutoUnload );
+        stream.read( &entry.mAssetInternal );
+
+        U32 count = 0;
+        stream.read( &count );
+        entry.mAssetDependencies.setSize( count );
+        for ( U32 index = 0; index < count; ++index )
+            entry.mAssetDependencies[index] = readDeclaredAssetsCacheString( stream );
+
+        stream.read( &count );
+        entry.mAssetLooseFiles.setSize( count );
+        for ( U32 index = 0; index < count; ++index )
+            entry.mAssetLooseFiles[index] = readDeclaredAssetsCacheString( stream );
+    }
+
+    // Discard a truncated cache entirely.
+    if ( stream.getStatus() != Stream::Ok && stream.getStatus() != Stream::EOS )
+    {
+        cache.clear();
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+static bool saveDeclaredAssetsCache( const char* pCacheFile, const typeDeclaredAssetCacheHash& cache )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_SaveDeclaredAssetsCache);
+
+    Platform::createPath( pCacheFile );
+
+    FileStream stream;
+    if ( !stream.open( pCacheFile, Torque::FS::File::Write ) )
+        return false;
+
+    // Only files found by this scan are kept so deleted files drop out.
+    U32 entryCount = 0;
+    for ( typeDeclaredAssetCacheHash::const_iterator entryItr = cache.begin(); entryItr != cache.end(); ++entryItr )
+    {
+        if ( entryItr->value.mVisited )
+            entryCount++;
+    }
+
+    stream.write( DeclaredAssetsCacheVersion );
+    stream.write( entryCount );
+
+    for ( typeDeclaredAssetCacheHash::const_iterator entryItr = cache.begin(); entryItr != cache.end(); ++entryItr )
+    {
+        const DeclaredAssetCacheEntry& entry = entryItr->value;
+        if ( !entry.mVisited )
+            continue;
+
+        stream.write( String( entryItr->key ) );
+        stream.write( entry.mModifiedTime );
+        stream.write( entry.mFileSize );
+        stream.write( String( entry.mAssetType ) );
+        stream.write( String( entry.mAssetName ) );
+        stream.write( String( entry.mAssetDescription ) );
+        stream.write( String( entry.mAssetCategory ) );
+        stream.write( entry.mAssetAutoUnload );
+        stream.write( entry.mAssetInternal );
+
+        stream.write( (U32)entry.mAssetDependencies.size() );
+        for ( U32 index = 0; index < (U32)entry.mAssetDependencies.size(); ++index )
+            stream.write( String( entry.mAssetDependencies[index] ) );
+
+        stream.write( (U32)entry.mAssetLooseFiles.size() );
+        for ( U32 index = 0; index < (U32)entry.mAssetLooseFiles.size(); ++index )
+            stream.write( String( entry.mAssetLooseFiles[index] ) );
+    }
+
+    return stream.getStatus() == Stream::Ok;
+}
+
+//-----------------------------------------------------------------------------
+
 bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension, const bool recurse, ModuleDefinition* pModuleDefinition )
 {
     // Debug Profiling.
@@ -2444,6 +2612,27 @@ bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension
 
     TamlAssetDeclaredVisitor assetDeclaredVisitor;
 
+    // Load the declared assets cache for this scan if caching is enabled.
+    typeDeclaredAssetCacheHash declaredAssetsCache;
+    char cacheFileBuffer[1024];
+    bool cacheDirty = false;
+    cacheFileBuffer[0] = 0;
+    if ( *mDeclaredAssetsCacheDirectory != 0 )
+    {
+        // Name the cache after the module and what was scanned.
+        char cachePathBuffer[1024];
+        Con::expandPath( cachePathBuffer, sizeof(cachePathBuffer), mDeclaredAssetsCacheDirectory );
+        char scanBuffer[1024];
+        dSprintf( scanBuffer, sizeof(scanBuffer), "%s|%s|%d", pathBuffer, pExtension, recurse );
+        dSprintf( cacheFileBuffer, sizeof(cacheFileBuffer), "%s/%s_%d_%08x.assetcache",
+            cachePathBuffer,
+            pModuleDefinition->getModuleId(),
+            pModuleDefinition->getVersionId(),
+            CRC::calculateCRC( scanBuffer, dStrlen(scanBuffer) ) );
+
+        loadDeclaredAssetsCache( cacheFileBuffer, declaredAssetsCache );
+    }
+
     // Iterate files.
     for ( Vector<Platform::FileInfo>::iterator fileItr = files.begin(); fileItr != files.end(); ++fileItr )
     {
@@ -2471,12 +2660,61 @@ bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension
         char assetFileBuffer[1024];
         dSprintf( assetFileBuffer, sizeof(assetFileBuffer), "%s/%s", fileInfo.pFullPath, fileInfo.pFileName );
 
-        // Parse the filename.
-        if ( !mTaml.parse( assetFileBuffer, assetDeclaredVisitor ) )
+        // Fetch the cached declaration if the file hasn't changed since it was parsed.
+        DeclaredAssetCacheEntry* pCacheEntry = NULL;
+        Torque::FS::FileNode::Attributes fileAttributes;
+        if ( cacheFileBuffer[0] != 0 && Torque::FS::GetFileAttributes( assetFileBuffer, &fileAttributes ) )
         {
-            // Warn.
-            Con::warnf( "Asset Manager: Failed to parse file containing asset declaration: '%s'.", assetFileBuffer );
-            continue;
+            pCacheEntry = &declaredAssetsCache[StringTable->insert( assetFileBuffer )];
+            pCacheEntry->mVisited = true;
+
+            if ( pCacheEntry->mModifiedTime != (U64)fileAttributes.mtime.getInternalRepresentation() || pCacheEntry->mFileSize != fileAttributes.size )
+            {
+                // Stale or new, so parse it below.
+                pCacheEntry->mModifiedTime = fileAttributes.mtime.getInternalRepresentation();
+                pCacheEntry->mFileSize = fileAttributes.size;
+                pCacheEntry->mAssetName = StringTable->EmptyString();
+            }
+            else if ( pCacheEntry->mAssetName != StringTable->EmptyString() )
+            {
+                // Restore the declaration as if it had been parsed.
+                AssetDefinition& cachedAssetDefinition = assetDeclaredVisitor.getAssetDefinition();
+                cachedAssetDefinition.mAssetBaseFilePath = StringTable->insert( assetFileBuffer );
+                cachedAssetDefinition.mAssetType = pCacheEntry->mAssetType;
+                cachedAssetDefinition.mAssetName = pCacheEntry->mAssetName;
+                cachedAssetDefinition.mAssetDescription = pCacheEntry->mAssetDescription;
+                cachedAssetDefinition.mAssetCategory = pCacheEntry->mAssetCategory;
+                cachedAssetDefinition.mAssetAutoUnload = pCacheEntry->mAssetAutoUnload;
+                cachedAssetDefinition.mAssetInternal = pCacheEntry->mAssetInternal;
+                assetDeclaredVisitor.getAssetDependencies() = pCacheEntry->mAssetDependencies;
+                assetDeclaredVisitor.getAssetLooseFiles() = pCacheEntry->mAssetLooseFiles;
+            }
+        }
+
+        // Parse the filename unless the cache had it.
+        if ( assetDeclaredVisitor.getAssetDefinition().mAssetName == StringTable->EmptyString() )
+        {
+            if ( !mTaml.parse( assetFileBuffer, assetDeclaredVisitor ) )
+            {
+                // Warn.
+                Con::warnf( "Asset Manager: Failed to parse file containing asset declaration: '%s'.", assetFileBuffer );
+                continue;
+            }
+
+            // Update the cache.
+            if ( pCacheEntry != NULL )
+            {
+                const AssetDefinition& parsedAssetDefinition = assetDeclaredVisitor.getAssetDefinition();
+                pCacheEntry->mAssetType = parsedAssetDefinition.mAssetType;
+                pCacheEntry->mAssetName = parsedAssetDefinition.mAssetName;
+                pCacheEntry->mAssetDescription = parsedAssetDefinition.mAssetDescription;
+                pCacheEntry->mAssetCategory = parsedAssetDefinition.mAssetCategory;
+                pCacheEntry->mAssetAutoUnload = parsedAssetDefinition.mAssetAutoUnload;
+                pCacheEntry->mAssetInternal = parsedAssetDefinition.mAssetInternal;
+                pCacheEntry->mAssetDependencies = assetDeclaredVisitor.getAssetDependencies();
+                pCacheEntry->mAssetLooseFiles = assetDeclaredVisitor.getAssetLooseFiles();
+                cacheDirty = true;
+            }
         }
 
         // Fetch asset definition.
@@ -2587,6 +2825,20 @@ bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension
         }
     }
 
+    // Write the cache back if anything was parsed or has gone away.
+    if ( cacheFileBuffer[0] != 0 )
+    {
+        U32 visitedCount = 0;
+        for ( typeDeclaredAssetCacheHash::iterator entryItr = declaredAssetsCache.begin(); entryItr != declaredAssetsCache.end(); ++entryItr )
+        {
+            if ( entryItr->value.mVisited )
+                visitedCount++;
+        }
+
+        if ( ( cacheDirty || visitedCount != (U32)declaredAssetsCache.size() ) && !saveDeclaredAssetsCache( cacheFileBuffer, declaredAssetsCache ) )
+            Con::warnf( "Asset Manager: Failed to write declared assets cache '%s'.", cacheFileBuffer );
+    }
+
     // Info.
     if ( mEchoInfo )
     {
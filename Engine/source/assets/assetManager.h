@@ -105,6 +105,7 @@ private:
     /// Miscellaneous.
     bool                                mEchoInfo;
     bool                                mIgnoreAutoUnload;
+    StringTableEntry                    mDeclaredAssetsCacheDirectory;
     U32                                 mLoadedInternalAssetsCount;
     U32                                 mLoadedExternalAssetsCount;
     U32                                 mLoadedPrivateAssetsCount;
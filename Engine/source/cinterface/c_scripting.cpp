@@ -26,6 +26,8 @@
 #include "console/consoleInternal.h"
 #include "core/util/tDictionary.h"
 #include "app/mainLoop.h"
+#include "console/simSet.h"
+#include "scene/sceneObject.h"
 
 // External scripting cinterface, suitable for import into any scripting system which support "C" interfaces (C#, Python, Lua, Java, etc)
 
@@ -201,6 +203,323 @@ extern "C" {
       }
    }
 
+   // BATCHED FIELD ACCESS
+
+   // These work on many objects and fields per call so hosts don't pay a
+   // transition per value.  Values are laid out object major, so the value
+   // of field f on object o is at index o * fieldCount + f.  Objects that
+   // don't exist get zeros.  fieldNames must be from stringTable coming in!
+
+   // Looks up the static field if its value can be read straight out of
+   // the object without going through the string conversion.
+   static const AbstractClassRep::Field* GetDirectField(SimObject* object, const char* fieldName, S32 type)
+   {
+      if (!object->canModStaticFields())
+         return NULL;
+
+      const AbstractClassRep::Field* field = object->findField(fieldName);
+      if (!field || field->type != type || field->elementCount != 1 ||
+          field->getDataFn != &defaultProtectedGetFn)
+         return NULL;
+
+      return field;
+   }
+
+   S32 script_simobjects_getfields_int(const U32* objectIds, S32 objectCount, const char** fieldNames, S32 fieldCount, S32* outValues)
+   {
+      S32 found = 0;
+      for (S32 i = 0; i < objectCount; i++)
+      {
+         S32* values = outValues + i * fieldCount;
+
+         SimObject *object = Sim::findObject( objectIds[i] );
+         if (!object)
+         {
+            dMemset(values, 0, sizeof(S32) * fieldCount);
+            continue;
+         }
+
+         for (S32 j = 0; j < fieldCount; j++)
+         {
+            const AbstractClassRep::Field* field = GetDirectField(object, fieldNames[j], TypeS32);
+            if (field)
+               values[j] = *(const S32*)((const U8*)object + field->offset);
+            else
+               values[j] = dAtoi(object->getDataField(fieldNames[j], ""));
+         }
+
+         found++;
+      }
+
+      return found;
+   }
+
+   S32 script_simobjects_getfields_float(const U32* objectIds, S32 objectCount, const char** fieldNames, S32 fieldCount, F32* outValues)
+   {
+      S32 found = 0;
+      for (S32 i = 0; i < objectCount; i++)
+      {
+         F32* values = outValues + i * fieldCount;
+
+         SimObject *object = Sim::findObject( objectIds[i] );
+         if (!object)
+         {
+            dMemset(values, 0, sizeof(F32) * fieldCount);
+            continue;
+         }
+
+         for (S32 j = 0; j < fieldCount; j++)
+         {
+            const AbstractClassRep::Field* field = GetDirectField(object, fieldNames[j], TypeF32);
+            if (field)
+               values[j] = *(const F32*)((const U8*)object + field->offset);
+            else
+               values[j] = dAtof(object->getDataField(fieldNames[j], ""));
+         }
+
+         found++;
+      }
+
+      return found;
+   }
+
+   S32 script_simobjects_getfields_bool(const U32* objectIds, S32 objectCount, const char** fieldNames, S32 fieldCount, bool* outValues)
+   {
+      S32 found = 0;
+      for (S32 i = 0; i < objectCount; i++)
+      {
+         bool* values = outValues + i * fieldCount;
+
+         SimObject *object = Sim::findObject( objectIds[i] );
+         if (!object)
+         {
+            dMemset(values, 0, sizeof(bool) * fieldCount);
+            continue;
+         }
+
+         for (S32 j = 0; j < fieldCount; j++)
+         {
+            const AbstractClassRep::Field* field = GetDirectField(object, fieldNames[j], TypeBool);
+            if (field)
+               values[j] = *(const bool*)((const U8*)object + field->offset);
+            else
+               values[j] = dAtob(object->getDataField(fieldNames[j], ""));
+         }
+
+         found++;
+      }
+
+      return found;
+   }
+
+   // Strings are packed one after the other into outBuffer with
+   // outOffsets giving where each one starts.  Returns the buffer size
+   // needed, so if it is larger than bufferSize call again with a bigger
+   // buffer.  Values that don't fit are returned as empty strings.
+   S32 script_simobjects_getfields_string(const U32* objectIds, S32 objectCount, const char** fieldNames, S32 fieldCount, char* outBuffer, S32 bufferSize, S32* outOffsets)
+   {
+      S32 size = 0;
+      for (S32 i = 0; i < objectCount; i++)
+      {
+         SimObject *object = Sim::findObject( objectIds[i] );
+
+         for (S32 j = 0; j < fieldCount; j++)
+         {
+            const char* value = object ? object->getDataField(fieldNames[j], "") : "";
+            const S32 length = dStrlen(value) + 1;
+
+            S32& offset = outOffsets[i * fieldCount + j];
+            if (size + length <= bufferSize)
+            {
+               dMemcpy(outBuffer + size, value, length);
+               offset = size;
+            }
+            else
+            {
+               // Point at a terminator if there is room for one.
+               offset = bufferSize > 0 ? bufferSize - 1 : 0;
+               if (bufferSize > 0)
+                  outBuffer[offset] = 0;
+            }
+
+            size += length;
+         }
+      }
+
+      return size;
+   }
+
+   // Setters go through setDataField() so protected fields and their
+   // notifications behave as if set from script.
+
+   S32 script_simobjects_setfields_int(const U32* objectIds, S32 objectCount, const char** fieldNames, S32 fieldCount, const S32* values)
+   {
+      S32 found = 0;
+      char buf[32];
+      for (S32 i = 0; i < objectCount; i++)
+      {
+         SimObject *object = Sim::findObject( objectIds[i] );
+         if (!object)
+            continue;
+
+         for (S32 j = 0; j < fieldCount; j++)
+         {
+            dSprintf(buf, sizeof(buf), "%d", values[i * fieldCount + j]);
+            object->setDataField(fieldNames[j], "", buf);
+         }
+
+         found++;
+      }
+
+      return found;
+   }
+
+   S32 script_simobjects_setfields_float(const U32* objectIds, S32 objectCount, const char** fieldNames, S32 fieldCount, const F32* values)
+   {
+      S32 found = 0;
+      char buf[64];
+      for (S32 i = 0; i < objectCount; i++)
+      {
+         SimObject *object = Sim::findObject( objectIds[i] );
+         if (!object)
+            continue;
+
+         for (S32 j = 0; j < fieldCount; j++)
+         {
+            dSprintf(buf, sizeof(buf), "%g", values[i * fieldCount + j]);
+            object->setDataField(fieldNames[j], "", buf);
+         }
+
+         found++;
+      }
+
+      return found;
+   }
+
+   S32 script_simobjects_setfields_bool(const U32* objectIds, S32 objectCount, const char** fieldNames, S32 fieldCount, const bool* values)
+   {
+      S32 found = 0;
+      for (S32 i = 0; i < objectCount; i++)
+      {
+         SimObject *object = Sim::findObject( objectIds[i] );
+         if (!object)
+            continue;
+
+         for (S32 j = 0; j < fieldCount; j++)
+            object->setDataField(fieldNames[j], "", values[i * fieldCount + j] ? "1" : "0");
+
+         found++;
+      }
+
+      return found;
+   }
+
+   S32 script_simobjects_setfields_string(const U32* objectIds, S32 objectCount, const char** fieldNames, S32 fieldCount, const char** values)
+   {
+      S32 found = 0;
+      for (S32 i = 0; i < objectCount; i++)
+      {
+         SimObject *object = Sim::findObject( objectIds[i] );
+         if (!object)
+            continue;
+
+         for (S32 j = 0; j < fieldCount; j++)
+            object->setDataField(fieldNames[j], "", values[i * fieldCount + j]);
+
+         found++;
+      }
+
+      return found;
+   }
+
+   // BULK OBJECT QUERIES
+
+   // These fill outIds with up to maxIds object ids and return the
+   // total number of matches, so if it is larger than maxIds call again
+   // with a bigger buffer.
+
+   // Finds the objects in a set of the given class or a subclass of it.
+   // A setId of 0 searches the root group.  An empty classname matches
+   // everything.
+   S32 script_simset_find_objects(U32 setId, const char* classname, bool recursive, U32* outIds, S32 maxIds)
+   {
+      SimSet* set = NULL;
+      if (setId)
+         Sim::findObject(setId, set);
+      else
+         set = Sim::getRootGroup();
+
+      if (!set)
+         return 0;
+
+      AbstractClassRep* classRep = NULL;
+      if (classname && classname[0])
+      {
+         classRep = AbstractClassRep::findClassRep(classname);
+         if (!classRep)
+            return 0;
+      }
+
+      S32 count = 0;
+      if (recursive)
+      {
+         for (SimSetIterator itr(set); *itr; ++itr)
+         {
+            if (classRep && !(*itr)->getClassRep()->isSubclassOf(classRep))
+               continue;
+
+            if (count < maxIds)
+               outIds[count] = (*itr)->getId();
+            count++;
+         }
+      }
+      else
+      {
+         for (SimSet::iterator itr = set->begin(); itr != set->end(); itr++)
+         {
+            if (classRep && !(*itr)->getClassRep()->isSubclassOf(classRep))
+               continue;
+
+            if (count < maxIds)
+               outIds[count] = (*itr)->getId();
+            count++;
+         }
+      }
+
+      return count;
+   }
+
+   struct ContainerQuery
+   {
+      U32* ids;
+      S32 maxIds;
+      S32 count;
+   };
+
+   static void ContainerQueryCallback(SceneObject* object, void* key)
+   {
+      ContainerQuery* query = (ContainerQuery*)key;
+      if (query->count < query->maxIds)
+         query->ids[query->count] = object->getId();
+      query->count++;
+   }
+
+   // Finds the objects of the type mask whose world box overlaps the box
+   // given as six floats: min x, y, z followed by max x, y, z.
+   S32 script_container_find_objects(bool server, const F32* box, U32 typeMask, U32* outIds, S32 maxIds)
+   {
+      ContainerQuery query;
+      query.ids = outIds;
+      query.maxIds = maxIds;
+      query.count = 0;
+
+      SceneContainer& container = server ? gServerContainer : gClientContainer;
+      container.findObjects(Box3F(Point3F(box[0], box[1], box[2]), Point3F(box[3], box[4], box[5])),
+         typeMask, ContainerQueryCallback, &query);
+
+      return query.count;
+   }
+
    const char* script_call_namespace_entry_string(Namespace::Entry* entry, S32 argc, const char** argv)
    {
       // maxArgs improper on a number of console function/methods
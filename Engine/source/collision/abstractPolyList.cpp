@@ -30,6 +30,32 @@ AbstractPolyList::~AbstractPolyList()
    mInterestNormalRegistered = false;
 }
 
+U32 AbstractPolyList::addPoints(const Point3F* points, U32 numPoints, U32 stride, const Point3F* normals, U32 normalStride)
+{
+   AssertFatal(numPoints > 0, "AbstractPolyList::addPoints - No points given!");
+
+   const U8* point = reinterpret_cast<const U8*>(points);
+   const U8* normal = reinterpret_cast<const U8*>(normals);
+
+   U32 base = 0;
+   for (U32 i = 0; i < numPoints; i++, point += stride)
+   {
+      U32 index;
+      if (normal)
+      {
+         index = addPointAndNormal(*reinterpret_cast<const Point3F*>(point), *reinterpret_cast<const Point3F*>(normal));
+         normal += normalStride;
+      }
+      else
+         index = addPoint(*reinterpret_cast<const Point3F*>(point));
+
+      if (i == 0)
+         base = index;
+   }
+
+   return base;
+}
+
 static U32 PolyFace[6][4] = {
    { 3, 2, 1, 0 },
    { 7, 4, 5, 6 },
@@ -162,6 +162,22 @@ public:
    /// that do not support them.
    virtual U32  addPointAndNormal(const Point3F& p, const Point3F& normal) { return addPoint( p ); }
 
+   /// Adds a batch of points, and optionally normals, to the poly list.
+   /// The points get consecutive ID numbers.
+   ///
+   /// Polylists that do per-point work, like clipping, can do it for the
+   /// whole batch at once.  Geometry sources should prefer this over
+   /// adding points one at a time.
+   ///
+   /// @param points First point.
+   /// @param numPoints Number of points.  Must not be zero.
+   /// @param stride Distance in bytes between consecutive points.
+   /// @param normals First normal or NULL.
+   /// @param normalStride Distance in bytes between consecutive normals.
+   /// @return ID number of the first point.
+   virtual U32  addPoints(const Point3F* points, U32 numPoints, U32 stride = sizeof( Point3F ),
+                          const Point3F* normals = NULL, U32 normalStride = sizeof( Point3F ) );
+
    /// Adds a plane to the poly list, and returns
    /// an ID number for that point.
    virtual U32  addPlane(const PlaneF& plane) = 0;
@@ -29,6 +29,10 @@
 
 #include "core/tAlgorithm.h"
 
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+#include <emmintrin.h>
+#endif
+
 bool ClippedPolyList::allowClipping = true;
 
 
@@ -111,6 +115,103 @@ U32 ClippedPolyList::addPointAndNormal(const Point3F& p, const Point3F& normal)
 }
 
 
+U32 ClippedPolyList::addPoints(const Point3F* points, U32 numPoints, U32 stride, const Point3F* normals, U32 normalStride)
+{
+   PROFILE_SCOPE( ClippedPolyList_AddPoints );
+
+   AssertFatal(numPoints > 0, "ClippedPolyList::addPoints - No points given!");
+
+   const U32 base = mVertexList.size();
+   mVertexList.setSize(base + numPoints);
+   mNormalList.setSize(base + numPoints);
+
+   // Transform the batch.
+
+   const U8* src = reinterpret_cast<const U8*>(points);
+   const U8* srcNormal = reinterpret_cast<const U8*>(normals);
+   for (U32 i = 0; i < numPoints; i++, src += stride)
+   {
+      const Point3F& p = *reinterpret_cast<const Point3F*>(src);
+      Vertex& v = mVertexList[base + i];
+      v.point.x = p.x * mScale.x;
+      v.point.y = p.y * mScale.y;
+      v.point.z = p.z * mScale.z;
+      mMatrix.mulP(v.point);
+      v.mask = 0;
+
+      VectorF& n = mNormalList[base + i];
+      if (srcNormal)
+      {
+         n = *reinterpret_cast<const Point3F*>(srcNormal);
+         srcNormal += normalStride;
+         if ( !n.isZero() )
+            mMatrix.mulV(n);
+      }
+      else
+         n = Point3F::Zero;
+   }
+
+   // Build the plane masks.
+
+   const U32 numPlanes = mPlaneList.size();
+   AssertFatal(numPlanes <= 32, "ClippedPolyList::addPoints - Too many planes for the vertex masks!");
+
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+
+   // Test each point against four planes at a time.  The planes are laid
+   // out as groups of four x, y, z and d values with unused lanes zeroed so
+   // that they never count as being in front.  The distance is summed in
+   // the same order as PlaneF::distToPlane() to get identical masks.
+
+   const U32 numGroups = (numPlanes + 3) / 4;
+
+   F32 planeData[8 * 16];
+   dMemset(planeData, 0, sizeof(F32) * 16 * numGroups);
+   for (U32 p = 0; p < numPlanes; p++)
+   {
+      F32* group = &planeData[(p / 4) * 16 + (p % 4)];
+      group[0] = mPlaneList[p].x;
+      group[4] = mPlaneList[p].y;
+      group[8] = mPlaneList[p].z;
+      group[12] = mPlaneList[p].d;
+   }
+
+   const __m128 zero = _mm_setzero_ps();
+   for (U32 i = 0; i < numPoints; i++)
+   {
+      Vertex& v = mVertexList[base + i];
+      const __m128 x = _mm_set1_ps(v.point.x);
+      const __m128 y = _mm_set1_ps(v.point.y);
+      const __m128 z = _mm_set1_ps(v.point.z);
+
+      U32 mask = 0;
+      for (U32 g = 0; g < numGroups; g++)
+      {
+         const F32* group = &planeData[g * 16];
+         const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_loadu_ps(group)),
+                                                  _mm_mul_ps(y, _mm_loadu_ps(group + 4))),
+                                       _mm_mul_ps(z, _mm_loadu_ps(group + 8)));
+         const __m128 dist = _mm_add_ps(dot, _mm_loadu_ps(group + 12));
+         mask |= U32(_mm_movemask_ps(_mm_cmpgt_ps(dist, zero))) << (g * 4);
+      }
+      v.mask = mask;
+   }
+
+#else
+
+   for (U32 i = 0; i < numPoints; i++)
+   {
+      Vertex& v = mVertexList[base + i];
+      for (U32 p = 0; p < numPlanes; p++)
+         if (mPlaneList[p].distToPlane(v.point) > 0)
+            v.mask |= 1 << p;
+   }
+
+#endif
+
+   return base;
+}
+
 U32 ClippedPolyList::addPlane(const PlaneF& plane)
 {
    mPolyPlaneList.increment();
@@ -120,6 +120,8 @@ public:
    bool isEmpty() const;
    U32 addPoint(const Point3F& p);
    U32 addPointAndNormal(const Point3F& p, const Point3F& normal);
+   U32 addPoints(const Point3F* points, U32 numPoints, U32 stride = sizeof( Point3F ),
+                 const Point3F* normals = NULL, U32 normalStride = sizeof( Point3F ));
    U32 addPlane(const PlaneF& plane);
    void begin(BaseMatInstance* material,U32 surfaceKey);
    void plane(U32 v1,U32 v2,U32 v3);
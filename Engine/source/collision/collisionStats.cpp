@@ -0,0 +1,427 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "collision/collisionStats.h"
+
+#include "collision/convex.h"
+#include "scene/sceneObject.h"
+#include "console/engineAPI.h"
+#include "console/consoleTypes.h"
+#include "core/module.h"
+#include "platform/profiler.h"
+#include "platform/threads/mutex.h"
+#include "platform/platformIntrinsics.h"
+
+
+namespace CollisionStats
+{
+   bool smEnabled = false;
+
+   enum
+   {
+      /// Number of classes work can be attributed to.  Work done
+      /// by further classes is only counted in the totals.
+      MaxClasses = 128,
+   };
+
+   struct Counters
+   {
+      /// Counts of the running tick.  Added to from any thread.
+      volatile U32 current[ 2 ][ NumCounters ];
+
+      /// Counts of the last complete tick.
+      U32 last[ 2 ][ NumCounters ];
+
+      /// Counts of all complete ticks since the last reset.
+      U64 total[ 2 ][ NumCounters ];
+   };
+
+   struct ClassCounters : public Counters
+   {
+      AbstractClassRep* classRep;
+   };
+
+   static const char* sCounterNames[ NumCounters ] =
+   {
+      "castRay",
+      "objectCastRay",
+      "polyListQuery",
+      "objectPolyList",
+      "workingListUpdate",
+      "convexBuild",
+      "convexPolyList",
+      "convexTest",
+      "gjkTest",
+      "gjkIteration",
+   };
+
+   /// Names of the profiler trace counter tracks indexed by [ server ][ counter ].
+   static const char* sTraceNames[ 2 ][ NumCounters ] =
+   {
+      {
+         "Client Collision: castRay",
+         "Client Collision: objectCastRay",
+         "Client Collision: polyListQuery",
+         "Client Collision: objectPolyList",
+         "Client Collision: workingListUpdate",
+         "Client Collision: convexBuild",
+         "Client Collision: convexPolyList",
+         "Client Collision: convexTest",
+         "Client Collision: gjkTest",
+         "Client Collision: gjkIteration",
+      },
+      {
+         "Server Collision: castRay",
+         "Server Collision: objectCastRay",
+         "Server Collision: polyListQuery",
+         "Server Collision: objectPolyList",
+         "Server Collision: workingListUpdate",
+         "Server Collision: convexBuild",
+         "Server Collision: convexPolyList",
+         "Server Collision: convexTest",
+         "Server Collision: gjkTest",
+         "Server Collision: gjkIteration",
+      },
+   };
+
+   static Counters sTotals;
+   static U32 sNumTicks[ 2 ];
+
+   /// Classes work has been attributed to.  Entries are only ever appended
+   /// and are complete before sNumClasses includes them so lookups don't
+   /// need to lock.
+   static ClassCounters sClasses[ MaxClasses ];
+   static volatile U32 sNumClasses = 0;
+   static Mutex sClassMutex;
+
+   static ClassCounters* _findClass( AbstractClassRep* classRep, bool create );
+   static void _rollOver( Counters& counters, bool server );
+}
+
+AFTER_MODULE_INIT( Sim )
+{
+   Con::addVariable( "$Collision::stats", TypeBool, &CollisionStats::smEnabled,
+      "@brief Whether the collision queries run each tick are counted.\n\n"
+      "Use collisionStatsDump() and getCollisionStat() to see which queries "
+      "run and which classes cause them.  The default value is false.\n"
+      "@ingroup Collision" );
+}
+
+//-----------------------------------------------------------------------------
+
+const char* CollisionStats::getCounterName( Counter counter )
+{
+   AssertFatal( counter < NumCounters, "CollisionStats::getCounterName - Invalid counter" );
+   return sCounterNames[ counter ];
+}
+
+CollisionStats::Counter CollisionStats::findCounter( const char* name )
+{
+   for ( U32 i = 0; i < NumCounters; ++ i )
+      if ( dStricmp( name, sCounterNames[ i ] ) == 0 )
+         return Counter( i );
+
+   return NumCounters;
+}
+
+//-----------------------------------------------------------------------------
+
+CollisionStats::ClassCounters* CollisionStats::_findClass( AbstractClassRep* classRep, bool create )
+{
+   U32 numClasses = dAtomicRead( sNumClasses );
+   for ( U32 i = 0; i < numClasses; ++ i )
+      if ( sClasses[ i ].classRep == classRep )
+         return &sClasses[ i ];
+
+   if ( !create )
+      return NULL;
+
+   MutexHandle lock;
+   lock.lock( &sClassMutex, true );
+
+   // Another thread may have added the class in the meantime.
+   numClasses = sNumClasses;
+   for ( U32 i = 0; i < numClasses; ++ i )
+      if ( sClasses[ i ].classRep == classRep )
+         return &sClasses[ i ];
+
+   if ( numClasses >= MaxClasses )
+      return NULL;
+
+   ClassCounters& entry = sClasses[ numClasses ];
+   dMemset( &entry, 0, sizeof( entry ) );
+   entry.classRep = classRep;
+
+   // Full barrier; publishes the entry to the other threads.
+   dFetchAndAdd( sNumClasses, 1 );
+
+   return &entry;
+}
+
+void CollisionStats::_count( Counter counter, bool server, AbstractClassRep* classRep, U32 amount )
+{
+   dFetchAndAdd( sTotals.current[ server ][ counter ], amount );
+
+   if ( classRep )
+   {
+      ClassCounters* entry = _findClass( classRep, true );
+      if ( entry )
+         dFetchAndAdd( entry->current[ server ][ counter ], amount );
+   }
+}
+
+void CollisionStats::_count( Counter counter, const SceneObject* object, U32 amount )
+{
+   if ( object )
+      _count( counter, object->isServerObject(), object->getClassRep(), amount );
+}
+
+void CollisionStats::_count( Counter counter, const Convex* convex, U32 amount )
+{
+   _count( counter, convex->getObject(), amount );
+}
+
+//-----------------------------------------------------------------------------
+
+void CollisionStats::_rollOver( Counters& counters, bool server )
+{
+   for ( U32 i = 0; i < NumCounters; ++ i )
+   {
+      // Subtract what we took instead of clearing the counter
+      // so that counts from other threads aren't lost.
+      const U32 value = dAtomicRead( counters.current[ server ][ i ] );
+      dFetchAndAdd( counters.current[ server ][ i ], U32( -S32( value ) ) );
+
+      counters.last[ server ][ i ] = value;
+      counters.total[ server ][ i ] += value;
+   }
+}
+
+void CollisionStats::beginTick( bool server )
+{
+   if ( !smEnabled )
+      return;
+
+   PROFILE_SCOPE( CollisionStats_BeginTick );
+
+   _rollOver( sTotals, server );
+
+   const U32 numClasses = dAtomicRead( sNumClasses );
+   for ( U32 i = 0; i < numClasses; ++ i )
+      _rollOver( sClasses[ i ], server );
+
+   sNumTicks[ server ] ++;
+
+   if ( ProfilerTrace::isCapturing() )
+   {
+      for ( U32 i = 0; i < NumCounters; ++ i )
+         ProfilerTrace::recordCounter( sTraceNames[ server ][ i ], sTotals.last[ server ][ i ] );
+   }
+}
+
+void CollisionStats::reset()
+{
+   MutexHandle lock;
+   lock.lock( &sClassMutex, true );
+
+   dMemset( &sTotals, 0, sizeof( sTotals ) );
+   dMemset( sNumTicks, 0, sizeof( sNumTicks ) );
+
+   const U32 numClasses = sNumClasses;
+   for ( U32 i = 0; i < numClasses; ++ i )
+   {
+      AbstractClassRep* classRep = sClasses[ i ].classRep;
+      dMemset( &sClasses[ i ], 0, sizeof( sClasses[ i ] ) );
+      sClasses[ i ].classRep = classRep;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+U32 CollisionStats::getLastTick( Counter counter, bool server, AbstractClassRep* classRep )
+{
+   AssertFatal( counter < NumCounters, "CollisionStats::getLastTick - Invalid counter" );
+
+   if ( !classRep )
+      return sTotals.last[ server ][ counter ];
+
+   ClassCounters* entry = _findClass( classRep, false );
+   return entry ? entry->last[ server ][ counter ] : 0;
+}
+
+U64 CollisionStats::getTotal( Counter counter, bool server, AbstractClassRep* classRep )
+{
+   AssertFatal( counter < NumCounters, "CollisionStats::getTotal - Invalid counter" );
+
+   if ( !classRep )
+      return sTotals.total[ server ][ counter ];
+
+   ClassCounters* entry = _findClass( classRep, false );
+   return entry ? entry->total[ server ][ counter ] : 0;
+}
+
+U32 CollisionStats::getNumTicks( bool server )
+{
+   return sNumTicks[ server ];
+}
+
+//-----------------------------------------------------------------------------
+
+void CollisionStats::dump( bool server, U32 maxClasses, Counter sortBy )
+{
+   const U32 numTicks = getMax( sNumTicks[ server ], U32( 1 ) );
+   const char* side = server ? "Server" : "Client";
+
+   if ( !smEnabled )
+      Con::warnf( "CollisionStats::dump - $Collision::stats is disabled" );
+
+   Con::printf( "%s collision stats over %d ticks:", side, sNumTicks[ server ] );
+   Con::printf( "   %-20s %10s %10s", "Counter", "Last tick", "Per tick" );
+
+   for ( U32 i = 0; i < NumCounters; ++ i )
+      Con::printf( "   %-20s %10d %10.1f", sCounterNames[ i ],
+         sTotals.last[ server ][ i ], F64( sTotals.total[ server ][ i ] ) / numTicks );
+
+   // Sort the classes by their work.
+
+   struct Entry
+   {
+      const ClassCounters* counters;
+      U64 work;
+   };
+
+   Vector< Entry > entries;
+   const U32 numClasses = dAtomicRead( sNumClasses );
+   for ( U32 i = 0; i < numClasses; ++ i )
+   {
+      Entry entry;
+      entry.counters = &sClasses[ i ];
+      entry.work = 0;
+
+      for ( U32 n = 0; n < NumCounters; ++ n )
+         if ( sortBy == NumCounters || sortBy == n )
+            entry.work += sClasses[ i ].total[ server ][ n ];
+
+      if ( entry.work )
+         entries.push_back( entry );
+   }
+
+   for ( U32 i = 1; i < entries.size(); ++ i )
+   {
+      const Entry entry = entries[ i ];
+      U32 n = i;
+      for ( ; n > 0 && entries[ n - 1 ].work < entry.work; -- n )
+         entries[ n ] = entries[ n - 1 ];
+      entries[ n ] = entry;
+   }
+
+   if ( entries.empty() )
+      return;
+
+   Con::printf( "   Classes by %s per tick:", sortBy == NumCounters ? "all queries" : sCounterNames[ sortBy ] );
+
+   char line[ 1024 ];
+   for ( U32 i = 0; i < getMin( U32( entries.size() ), maxClasses ); ++ i )
+   {
+      const ClassCounters* counters = entries[ i ].counters;
+
+      S32 length = dSprintf( line, sizeof( line ), "      %-24s", counters->classRep->getClassName() );
+      for ( U32 n = 0; n < NumCounters && length < S32( sizeof( line ) ); ++ n )
+      {
+         if ( counters->total[ server ][ n ] )
+            length += dSprintf( line + length, sizeof( line ) - length, " %s=%.1f",
+               sCounterNames[ n ], F64( counters->total[ server ][ n ] ) / numTicks );
+      }
+
+      Con::printf( "%s", line );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+DefineEngineFunction( collisionStatsDump, void, ( bool server, S32 maxClasses, const char* sortBy ), ( true, 10, "" ),
+   "@brief Print the collision queries counted while $Collision::stats is enabled.\n\n"
+   "Prints the counts of the last tick, the average per tick and the classes causing the most work.\n"
+   "@param server Print the server counts instead of the client counts.\n"
+   "@param maxClasses The number of classes to print.\n"
+   "@param sortBy The counter to sort classes by; castRay, objectCastRay, polyListQuery, objectPolyList, "
+   "workingListUpdate, convexBuild, convexPolyList, convexTest, gjkTest or gjkIteration.  If empty classes are sorted by "
+   "the sum of all counters.\n"
+   "@ingroup Collision" )
+{
+   CollisionStats::Counter counter = CollisionStats::NumCounters;
+   if ( sortBy && sortBy[ 0 ] )
+   {
+      counter = CollisionStats::findCounter( sortBy );
+      if ( counter == CollisionStats::NumCounters )
+      {
+         Con::errorf( "collisionStatsDump - Unknown counter '%s'", sortBy );
+         return;
+      }
+   }
+
+   CollisionStats::dump( server, getMax( maxClasses, 0 ), counter );
+}
+
+DefineEngineFunction( collisionStatsReset, void, (),,
+   "@brief Clear the collision query counters.\n\n"
+   "@ingroup Collision" )
+{
+   CollisionStats::reset();
+}
+
+DefineEngineFunction( getCollisionStat, F32, ( const char* counter, bool server, bool average, const char* className ), ( true, false, "" ),
+   "@brief Return a collision query count.\n\n"
+   "Counts are only taken while $Collision::stats is enabled.\n"
+   "@param counter castRay, objectCastRay, polyListQuery, objectPolyList, workingListUpdate, convexBuild, "
+   "convexPolyList, convexTest, gjkTest or gjkIteration.\n"
+   "@param server Return the server count instead of the client count.\n"
+   "@param average Return the average per tick instead of the count of the last tick.\n"
+   "@param className If not empty only count work attributed to this class.\n"
+   "@ingroup Collision" )
+{
+   const CollisionStats::Counter index = CollisionStats::findCounter( counter );
+   if ( index == CollisionStats::NumCounters )
+   {
+      Con::errorf( "getCollisionStat - Unknown counter '%s'", counter );
+      return 0.0f;
+   }
+
+   AbstractClassRep* classRep = NULL;
+   if ( className && className[ 0 ] )
+   {
+      classRep = AbstractClassRep::findClassRep( className );
+      if ( !classRep )
+      {
+         Con::errorf( "getCollisionStat - Unknown class '%s'", className );
+         return 0.0f;
+      }
+   }
+
+   if ( !average )
+      return CollisionStats::getLastTick( index, server, classRep );
+
+   const U32 numTicks = CollisionStats::getNumTicks( server );
+   return numTicks ? F32( F64( CollisionStats::getTotal( index, server, classRep ) ) / numTicks ) : 0.0f;
+}
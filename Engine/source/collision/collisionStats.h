@@ -0,0 +1,159 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _COLLISIONSTATS_H_
+#define _COLLISIONSTATS_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+class SceneObject;
+class Convex;
+class AbstractClassRep;
+
+
+/// Counters for the collision queries run each tick.
+///
+/// While #smEnabled is set, SceneContainer, Convex, GjkCollisionState and
+/// the objects colliding polylists against convexes count the queries they
+/// run and attribute them to the class of the object doing the work.  Server and client queries are counted
+/// separately and roll over at the start of each tick of their process
+/// list, so the values returned by getLastTick() are for the last
+/// complete tick.  Totals accumulate until reset().
+///
+/// When a profiler trace capture is running the per tick values are
+/// also recorded as counter tracks.
+///
+/// Counting is lock free and may happen on any thread.
+namespace CollisionStats
+{
+   enum Counter
+   {
+      /// Ray, box or ray batch queries against a container.
+      CastRay,
+
+      /// SceneObject::castRay(), castRayRendered() and collideBox() calls
+      /// made by the container; attributed to the object tested.
+      ObjectCastRay,
+
+      /// SceneContainer::buildPolyList() queries.
+      PolyListQuery,
+
+      /// SceneObject::buildPolyList() calls made by the container;
+      /// attributed to the object adding polys.
+      ObjectPolyList,
+
+      /// Convex::updateWorkingList() calls; attributed to
+      /// the object whose convex is updated.
+      WorkingListUpdate,
+
+      /// SceneObject::buildConvex() calls made while updating a working
+      /// list; attributed to the object adding convexes.
+      ConvexBuild,
+
+      /// Convex::getPolyList() calls made by objects colliding polylists
+      /// against their working list; attributed to the object adding polys.
+      ConvexPolyList,
+
+      /// Convex pairs tested for features in Convex::getCollisionInfo();
+      /// attributed to the object tested against.
+      ConvexTest,
+
+      /// GJK distance and intersection tests; attributed to
+      /// the object tested against.
+      GjkTest,
+
+      /// Iterations run by GJK tests; attributed to the
+      /// object tested against.
+      GjkIteration,
+
+      NumCounters
+   };
+
+   /// Whether collision queries are counted.
+   extern bool smEnabled;
+
+   /// Return the console name of @a counter.
+   const char* getCounterName( Counter counter );
+
+   /// Return the counter called @a name or NumCounters.
+   Counter findCounter( const char* name );
+
+   /// @name Counting
+   /// @{
+
+   void _count( Counter counter, bool server, AbstractClassRep* classRep, U32 amount );
+   void _count( Counter counter, const SceneObject* object, U32 amount );
+   void _count( Counter counter, const Convex* convex, U32 amount );
+
+   /// Count @a amount for @a counter without class attribution.
+   inline void count( Counter counter, bool server, U32 amount = 1 )
+   {
+      if ( smEnabled )
+         _count( counter, server, NULL, amount );
+   }
+
+   /// Count @a amount for @a counter attributed to the class of @a object.
+   inline void count( Counter counter, const SceneObject* object, U32 amount = 1 )
+   {
+      if ( smEnabled )
+         _count( counter, object, amount );
+   }
+
+   /// Count @a amount for @a counter attributed to the class
+   /// of the object owning @a convex.
+   inline void count( Counter counter, const Convex* convex, U32 amount = 1 )
+   {
+      if ( smEnabled )
+         _count( counter, convex, amount );
+   }
+
+   /// @}
+
+   /// End the current tick of the server or client.  Called by the
+   /// process lists at the start of every tick.
+   void beginTick( bool server );
+
+   /// Clear all counters.
+   void reset();
+
+   /// Return the count of the last complete tick.
+   /// @param classRep If not NULL only count work attributed to this class.
+   U32 getLastTick( Counter counter, bool server, AbstractClassRep* classRep = NULL );
+
+   /// Return the count accumulated since the last reset().
+   /// @param classRep If not NULL only count work attributed to this class.
+   U64 getTotal( Counter counter, bool server, AbstractClassRep* classRep = NULL );
+
+   /// Return the number of complete ticks since the last reset().
+   U32 getNumTicks( bool server );
+
+   /// Print the last tick, the per tick average and the classes
+   /// causing the most work to the console.
+   /// @param sortBy Sort classes by this counter or, if NumCounters, by
+   ///   the sum of all counters.
+   void dump( bool server, U32 maxClasses, Counter sortBy = NumCounters );
+}
+
+#endif // _COLLISIONSTATS_H_
@@ -29,6 +29,7 @@
 #include "scene/sceneObject.h"
 #include "collision/gjk.h"
 #include "collision/concretePolyList.h"
+#include "collision/collisionStats.h"
 #include "platform/profiler.h"
 
 //----------------------------------------------------------------------------
@@ -349,7 +350,7 @@ Convex::~Convex()
 
    // Delete collision states
    while (mList.mNext != &mList)
-      delete mList.mNext->mState;
+      mList.mNext->mState->release();
 
    // Free up working list
    while (mWorking.wLink.mNext != &mWorking)
@@ -459,9 +460,21 @@ void Convex::addToWorkingList(Convex* ptr)
 //----------------------------------------------------------------------------
 
 void Convex::updateWorkingList(const Box3F& box, const U32 colMask)
+{
+   // Special processing for the terrain and interiors...
+   AssertFatal(mObject->getContainer(), "Must be in a container!");
+
+   SimpleQueryList sql;
+   mObject->getContainer()->findObjects(box, colMask,SimpleQueryList::insertionCallback, &sql);
+   updateWorkingList(box, sql.mList);
+}
+
+void Convex::updateWorkingList(const Box3F& box, const Vector<SceneObject*>& objects)
 {
    PROFILE_SCOPE( Convex_UpdateWorkingList );
 
+   CollisionStats::count( CollisionStats::WorkingListUpdate, this );
+
    sTag++;
 
    // Clear objects off the working list that are no longer intersecting
@@ -474,13 +487,11 @@ void Convex::updateWorkingList(const Box3F& box, const U32 colMask)
       }
    }
 
-   // Special processing for the terrain and interiors...
-   AssertFatal(mObject->getContainer(), "Must be in a container!");
-
-   SimpleQueryList sql;
-   mObject->getContainer()->findObjects(box, colMask,SimpleQueryList::insertionCallback, &sql);
-   for (U32 i = 0; i < sql.mList.size(); i++)
-      sql.mList[i]->buildConvex(box, this);
+   for (U32 i = 0; i < objects.size(); i++)
+   {
+      CollisionStats::count( CollisionStats::ConvexBuild, objects[i] );
+      objects[i]->buildConvex(box, this);
+   }
 }
 
 void Convex::clearWorkingList()
@@ -525,7 +536,7 @@ void Convex::updateStateList(const MatrixF& mat, const Point3F& scale, const Poi
       if (!box1.isOverlapped(cv->getBoundingBox())) {
          CollisionState* cs = itr->mState;
          itr = itr->mPrev;
-         delete cs;
+         cs->release();
       }
    }
 
@@ -533,7 +544,7 @@ void Convex::updateStateList(const MatrixF& mat, const Point3F& scale, const Poi
    for (CollisionWorkingList* itr0 = mWorking.wLink.mNext; itr0 != &mWorking; itr0 = itr0->wLink.mNext) {
       Convex* cv = itr0->mConvex;
       if (cv->mTag != sTag && box1.isOverlapped(cv->getBoundingBox())) {
-         CollisionState* state = new GjkCollisionState;
+         CollisionState* state = GjkCollisionState::create();
          state->set(this,cv,mat,cv->getTransform());
          state->mLista->linkAfter(&mList);
          state->mListb->linkAfter(&cv->mList);
@@ -615,6 +626,8 @@ bool Convex::getCollisionInfo(const MatrixF& mat, const Point3F& scale, Collisio
 
       if (state->dist <= tol) 
       {
+         CollisionStats::count( CollisionStats::ConvexTest, state->b );
+
          fa.reset();
          fb.reset();
          VectorF v;
@@ -109,6 +109,10 @@ struct CollisionState
    //
    CollisionState();
    virtual ~CollisionState();
+
+   /// Destroy the state.  States may come from a pool, so they must be
+   /// released through here instead of being deleted.
+   virtual void release() { delete this; }
    virtual void swap();
    virtual void set(Convex* a,Convex* b,const MatrixF& a2w, const MatrixF& b2w);
    virtual F32 distance(const MatrixF& a2w, const MatrixF& b2w, const F32 dontCareDist,
@@ -243,6 +247,13 @@ public:
    /// @param  colMask  Mask of objects to check against.
    void updateWorkingList(const Box3F& box, const U32 colMask);
 
+   /// Updates the working collision list from the objects a container query
+   /// for @a box has already found.
+   ///
+   /// @param  box      Used as the bounding box.
+   /// @param  objects  Objects in the bounds, not including the object of this Convex.
+   void updateWorkingList(const Box3F& box, const Vector<SceneObject*>& objects);
+
    /// Clear out the working collision list of objects
    void clearWorkingList();
 
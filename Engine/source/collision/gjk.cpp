@@ -29,6 +29,7 @@
 #include "scene/sceneObject.h"
 #include "collision/convex.h"
 #include "collision/gjk.h"
+#include "collision/collisionStats.h"
 
 
 //----------------------------------------------------------------------------
@@ -41,6 +42,31 @@ static U32 sIteration = 15;       // Stuck in a loop?
 S32 num_iterations = 0;
 S32 num_irregularities = 0;
 
+/// Pool of GjkCollisionStates.  Only used from the thread running the
+/// collision code.
+static FreeListChunker< GjkCollisionState >& _getStatePool()
+{
+   static FreeListChunker< GjkCollisionState > sPool;
+   return sPool;
+}
+
+/// Counts a GJK test and its iterations when it returns.
+struct GjkTestStats
+{
+   const Convex* mConvex;
+
+   GjkTestStats( const Convex* convex ) : mConvex( convex ) {}
+
+   ~GjkTestStats()
+   {
+      if ( CollisionStats::smEnabled )
+      {
+         CollisionStats::count( CollisionStats::GjkTest, mConvex );
+         CollisionStats::count( CollisionStats::GjkIteration, mConvex, num_iterations );
+      }
+   }
+};
+
 
 //----------------------------------------------------------------------------
 
@@ -53,6 +79,17 @@ GjkCollisionState::~GjkCollisionState()
 {
 }
 
+GjkCollisionState* GjkCollisionState::create()
+{
+   return constructInPlace( _getStatePool().alloc() );
+}
+
+void GjkCollisionState::release()
+{
+   destructInPlace( this );
+   _getStatePool().free( this );
+}
+
 
 //----------------------------------------------------------------------------
 
@@ -273,6 +310,7 @@ void GjkCollisionState::getClosestPoints(Point3F& p1, Point3F& p2)
 
 bool GjkCollisionState::intersect(const MatrixF& a2w, const MatrixF& b2w)
 {
+   GjkTestStats stats( b );
    num_iterations = 0;
    MatrixF w2a,w2b;
 
@@ -322,6 +360,7 @@ bool GjkCollisionState::intersect(const MatrixF& a2w, const MatrixF& b2w)
 F32 GjkCollisionState::distance(const MatrixF& a2w, const MatrixF& b2w,
    const F32 dontCareDist, const MatrixF* _w2a, const MatrixF* _w2b)
 {
+   GjkTestStats stats( b );
    num_iterations = 0;
    MatrixF w2a,w2b;
 
@@ -69,6 +69,12 @@ struct GjkCollisionState: public CollisionState
    GjkCollisionState();
    ~GjkCollisionState();
 
+   /// Allocate a state from the pool.  States are created and released as
+   /// objects move in and out of each other's working lists every tick, so
+   /// they are recycled instead of going through the heap.
+   static GjkCollisionState* create();
+   void release();
+
    void set(Convex* a,Convex* b,const MatrixF& a2w, const MatrixF& b2w);
 
    void getCollisionInfo(const MatrixF& mat, Collision* info);
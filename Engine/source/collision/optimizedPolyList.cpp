@@ -26,6 +26,7 @@
 #include "collision/optimizedPolyList.h"
 #include "materials/baseMatInstance.h"
 #include "materials/materialDefinition.h"
+#include "core/util/tSmallVector.h"
 
 //----------------------------------------------------------------------------
 
@@ -410,7 +411,10 @@ Polyhedron OptimizedPolyList::toPolyhedron() const
       // Gather remapped indices according to the
       // current polygon type.
 
-      Vector< U32 > indexList;
+      // Polygons rarely have more than a handful of edges so keep
+      // these temporaries off the heap.
+
+      SmallVector< U32, 16 > indexList;
       switch( poly.type )
       {
          case TriangleFan:
@@ -419,7 +423,7 @@ Polyhedron OptimizedPolyList::toPolyhedron() const
             AssertFatal( false, "TriangleStrip conversion not implemented" );
          case TriangleList:
             {
-               Vector< Polyhedron::Edge > tempEdges;
+               SmallVector< Polyhedron::Edge, 16 > tempEdges;
 
                // Loop over the triangles and gather all unshared edges
                // in tempEdges.  These are the exterior edges of the polygon.
@@ -0,0 +1,505 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "collision/staticCollisionTree.h"
+
+#include "math/mMathFn.h"
+#include "platform/profiler.h"
+
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+#include <xmmintrin.h>
+#define STATICCOLLISIONTREE_SSE
+#endif
+
+
+/// Half the surface area of a box; the split cost only needs relative values.
+static inline F32 _getHalfArea( const Box3F& box )
+{
+   const Point3F extents = box.getExtents();
+   return extents.x * extents.y + extents.y * extents.z + extents.z * extents.x;
+}
+
+//-----------------------------------------------------------------------------
+
+StaticCollisionTree::StaticCollisionTree()
+   : mBounds( Box3F::Invalid )
+{
+   VECTOR_SET_ASSOCIATION( mTriangles );
+   VECTOR_SET_ASSOCIATION( mNodes );
+   VECTOR_SET_ASSOCIATION( mRefs );
+}
+
+//-----------------------------------------------------------------------------
+
+void StaticCollisionTree::clear()
+{
+   mTriangles.clear();
+   mNodes.clear();
+   mRefs.clear();
+   mBounds = Box3F::Invalid;
+}
+
+//-----------------------------------------------------------------------------
+
+void StaticCollisionTree::addTriangle( const Point3F& a, const Point3F& b, const Point3F& c, const Point3F& normal, U32 object, U32 material )
+{
+   AssertFatal( mNodes.empty(), "StaticCollisionTree::addTriangle - Tree has already been built!" );
+   AssertFatal( mTriangles.size() < MaxTriangles, "StaticCollisionTree::addTriangle - Too many triangles!" );
+
+   mTriangles.increment();
+   Triangle& tri = mTriangles.last();
+   tri.v0 = a;
+   tri.edge1 = b - a;
+   tri.edge2 = c - a;
+   tri.normal = normal;
+   tri.normal.normalizeSafe();
+   tri.object = object;
+   tri.material = material;
+}
+
+//-----------------------------------------------------------------------------
+
+void StaticCollisionTree::build()
+{
+   PROFILE_SCOPE( StaticCollisionTree_Build );
+
+   mNodes.clear();
+   mBounds = Box3F::Invalid;
+
+   if ( mTriangles.empty() )
+      return;
+
+   const U32 count = mTriangles.size();
+
+   mRefs.setSize( count );
+   for ( U32 i = 0; i < count; ++ i )
+   {
+      const Triangle& tri = mTriangles[ i ];
+      BuildRef& ref = mRefs[ i ];
+
+      ref.box = Box3F( tri.v0, tri.v0 );
+      ref.box.extend( tri.v0 + tri.edge1 );
+      ref.box.extend( tri.v0 + tri.edge2 );
+      ref.center = ref.box.getCenter();
+      ref.triangle = i;
+
+      mBounds.intersect( ref.box );
+   }
+
+   // The root must be a node so a tree with only a few triangles
+   // gets a single node with a leaf in its first slot.
+
+   if ( count <= MaxLeafSize )
+   {
+      mNodes.increment();
+      Node& node = mNodes.last();
+      dMemset( &node, 0, sizeof( Node ) );
+
+      node.minX[ 0 ] = mBounds.minExtents.x;
+      node.minY[ 0 ] = mBounds.minExtents.y;
+      node.minZ[ 0 ] = mBounds.minExtents.z;
+      node.maxX[ 0 ] = mBounds.maxExtents.x;
+      node.maxY[ 0 ] = mBounds.maxExtents.y;
+      node.maxZ[ 0 ] = mBounds.maxExtents.z;
+      node.child[ 0 ] = LeafFlag | ( count << LeafCountShift );
+      node.numChildren = 1;
+   }
+   else
+      _buildRange( 0, count, 0 );
+
+   // Store the triangles in leaf order so that every leaf
+   // references a contiguous range.
+
+   Vector< Triangle > sorted;
+   sorted.setSize( count );
+   for ( U32 i = 0; i < count; ++ i )
+      sorted[ i ] = mTriangles[ mRefs[ i ].triangle ];
+   mTriangles = sorted;
+
+   mRefs.clear();
+   mRefs.compact();
+}
+
+//-----------------------------------------------------------------------------
+
+Box3F StaticCollisionTree::_getRangeBounds( U32 begin, U32 end ) const
+{
+   Box3F bounds = Box3F::Invalid;
+   for ( U32 i = begin; i < end; ++ i )
+      bounds.intersect( mRefs[ i ].box );
+   return bounds;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 StaticCollisionTree::_buildRange( U32 begin, U32 end, U32 depth )
+{
+   const U32 count = end - begin;
+   if ( count <= MaxLeafSize )
+      return LeafFlag | ( count << LeafCountShift ) | begin;
+
+   // Split the range into up to four children by repeatedly
+   // splitting the child with the most triangles.
+
+   U32 bounds[ 5 ];
+   bounds[ 0 ] = begin;
+   bounds[ 1 ] = end;
+   U32 numChildren = 1;
+
+   while ( numChildren < 4 )
+   {
+      U32 largest = 0;
+      for ( U32 i = 1; i < numChildren; ++ i )
+         if ( bounds[ i + 1 ] - bounds[ i ] > bounds[ largest + 1 ] - bounds[ largest ] )
+            largest = i;
+
+      if ( bounds[ largest + 1 ] - bounds[ largest ] <= MaxLeafSize )
+         break;
+
+      const U32 mid = _splitRange( bounds[ largest ], bounds[ largest + 1 ], depth );
+
+      for ( U32 i = numChildren + 1; i > largest + 1; -- i )
+         bounds[ i ] = bounds[ i - 1 ];
+      bounds[ largest + 1 ] = mid;
+      numChildren ++;
+   }
+
+   const U32 nodeIndex = mNodes.size();
+   mNodes.increment();
+   dMemset( &mNodes.last(), 0, sizeof( Node ) );
+   mNodes.last().numChildren = numChildren;
+
+   for ( U32 i = 0; i < numChildren; ++ i )
+   {
+      const Box3F box = _getRangeBounds( bounds[ i ], bounds[ i + 1 ] );
+      const U32 child = _buildRange( bounds[ i ], bounds[ i + 1 ], depth + 1 );
+
+      // Recursion may have grown the node list.
+      Node& node = mNodes[ nodeIndex ];
+      node.minX[ i ] = box.minExtents.x;
+      node.minY[ i ] = box.minExtents.y;
+      node.minZ[ i ] = box.minExtents.z;
+      node.maxX[ i ] = box.maxExtents.x;
+      node.maxY[ i ] = box.maxExtents.y;
+      node.maxZ[ i ] = box.maxExtents.z;
+      node.child[ i ] = child;
+   }
+
+   return nodeIndex;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 StaticCollisionTree::_splitRange( U32 begin, U32 end, U32 depth )
+{
+   const U32 count = end - begin;
+   const U32 median = begin + count / 2;
+
+   if ( depth >= MaxSAHDepth )
+      return median;
+
+   // Bin the triangle centers along the longest axis of their bounds.
+
+   Box3F centerBounds = Box3F::Invalid;
+   for ( U32 i = begin; i < end; ++ i )
+      centerBounds.intersect( mRefs[ i ].center );
+
+   const Point3F extents = centerBounds.getExtents();
+   U32 axis = 0;
+   if ( extents.y > extents[ axis ] )
+      axis = 1;
+   if ( extents.z > extents[ axis ] )
+      axis = 2;
+
+   const F32 axisMin = centerBounds.minExtents[ axis ];
+   const F32 axisExtent = extents[ axis ];
+   if ( axisExtent <= 0.0f )
+      return median;
+
+   const F32 binScale = F32( NumSplitBins ) / axisExtent;
+
+   U32 binCounts[ NumSplitBins ];
+   Box3F binBounds[ NumSplitBins ];
+   for ( U32 i = 0; i < NumSplitBins; ++ i )
+   {
+      binCounts[ i ] = 0;
+      binBounds[ i ] = Box3F::Invalid;
+   }
+
+   for ( U32 i = begin; i < end; ++ i )
+   {
+      const U32 bin = getMin( U32( ( mRefs[ i ].center[ axis ] - axisMin ) * binScale ), U32( NumSplitBins - 1 ) );
+      binCounts[ bin ] ++;
+      binBounds[ bin ].intersect( mRefs[ i ].box );
+   }
+
+   // Sweep from the right to get the cost of everything after each split
+   // plane, then from the left to find the cheapest plane.
+
+   F32 rightCosts[ NumSplitBins ];
+   Box3F rightBounds = Box3F::Invalid;
+   U32 rightCount = 0;
+   for ( U32 i = NumSplitBins - 1; i > 0; -- i )
+   {
+      rightBounds.intersect( binBounds[ i ] );
+      rightCount += binCounts[ i ];
+      rightCosts[ i ] = rightCount ? _getHalfArea( rightBounds ) * F32( rightCount ) : 0.0f;
+   }
+
+   F32 bestCost = F32_MAX;
+   U32 bestSplit = 0;
+   Box3F leftBounds = Box3F::Invalid;
+   U32 leftCount = 0;
+   for ( U32 i = 0; i < NumSplitBins - 1; ++ i )
+   {
+      leftBounds.intersect( binBounds[ i ] );
+      leftCount += binCounts[ i ];
+      if ( !leftCount || leftCount == count )
+         continue;
+
+      const F32 cost = _getHalfArea( leftBounds ) * F32( leftCount ) + rightCosts[ i + 1 ];
+      if ( cost < bestCost )
+      {
+         bestCost = cost;
+         bestSplit = i;
+      }
+   }
+
+   if ( bestCost == F32_MAX )
+      return median;
+
+   // Partition the refs around the chosen plane.
+
+   U32 mid = begin;
+   for ( U32 i = begin; i < end; ++ i )
+   {
+      const U32 bin = getMin( U32( ( mRefs[ i ].center[ axis ] - axisMin ) * binScale ), U32( NumSplitBins - 1 ) );
+      if ( bin <= bestSplit )
+      {
+         const BuildRef temp = mRefs[ i ];
+         mRefs[ i ] = mRefs[ mid ];
+         mRefs[ mid ] = temp;
+         mid ++;
+      }
+   }
+
+   if ( mid == begin || mid == end )
+      return median;
+
+   return mid;
+}
+
+//-----------------------------------------------------------------------------
+
+bool StaticCollisionTree::castRay( const Point3F& start, const Point3F& end, F32 maxT, RayHit* outHit, HitFilter filter, void* userData ) const
+{
+   if ( mNodes.empty() )
+      return false;
+
+   PROFILE_SCOPE( StaticCollisionTree_CastRay );
+
+   const Point3F dir = end - start;
+
+   // Axes the ray does not move along get a large finite reciprocal so
+   // that the slab test still accepts or rejects them correctly.
+
+   const F32 BigValue = 1.0e30f;
+   Point3F invDir;
+   for ( U32 i = 0; i < 3; ++ i )
+      invDir[ i ] = mFabs( dir[ i ] ) > 1.0e-30f ? 1.0f / dir[ i ] : ( dir[ i ] < 0.0f ? -BigValue : BigValue );
+
+   struct StackEntry
+   {
+      U32 node;
+      F32 t;
+   };
+
+   StackEntry stack[ MaxDepth * 3 + 4 ];
+   U32 stackSize = 0;
+
+   stack[ stackSize ].node = 0;
+   stack[ stackSize ].t = 0.0f;
+   stackSize ++;
+
+   F32 bestT = maxT;
+   const Triangle* bestTri = NULL;
+
+#ifdef STATICCOLLISIONTREE_SSE
+   const __m128 originX = _mm_set1_ps( start.x );
+   const __m128 originY = _mm_set1_ps( start.y );
+   const __m128 originZ = _mm_set1_ps( start.z );
+   const __m128 invDirX = _mm_set1_ps( invDir.x );
+   const __m128 invDirY = _mm_set1_ps( invDir.y );
+   const __m128 invDirZ = _mm_set1_ps( invDir.z );
+   const __m128 zero = _mm_setzero_ps();
+#endif
+
+   while ( stackSize )
+   {
+      stackSize --;
+      if ( stack[ stackSize ].t >= bestT )
+         continue;
+
+      const Node& node = mNodes[ stack[ stackSize ].node ];
+
+      // Test the ray against all child boxes of the node.
+
+      F32 childT[ 4 ];
+      U32 hitMask;
+
+#ifdef STATICCOLLISIONTREE_SSE
+      {
+         const __m128 x0 = _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( node.minX ), originX ), invDirX );
+         const __m128 x1 = _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( node.maxX ), originX ), invDirX );
+         const __m128 y0 = _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( node.minY ), originY ), invDirY );
+         const __m128 y1 = _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( node.maxY ), originY ), invDirY );
+         const __m128 z0 = _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( node.minZ ), originZ ), invDirZ );
+         const __m128 z1 = _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( node.maxZ ), originZ ), invDirZ );
+
+         __m128 tNear = _mm_max_ps( _mm_min_ps( x0, x1 ), _mm_min_ps( y0, y1 ) );
+         tNear = _mm_max_ps( tNear, _mm_min_ps( z0, z1 ) );
+         tNear = _mm_max_ps( tNear, zero );
+
+         __m128 tFar = _mm_min_ps( _mm_max_ps( x0, x1 ), _mm_max_ps( y0, y1 ) );
+         tFar = _mm_min_ps( tFar, _mm_max_ps( z0, z1 ) );
+         tFar = _mm_min_ps( tFar, _mm_set1_ps( bestT ) );
+
+         hitMask = _mm_movemask_ps( _mm_cmple_ps( tNear, tFar ) );
+         _mm_storeu_ps( childT, tNear );
+      }
+#else
+      hitMask = 0;
+      for ( U32 i = 0; i < node.numChildren; ++ i )
+      {
+         const F32 x0 = ( node.minX[ i ] - start.x ) * invDir.x;
+         const F32 x1 = ( node.maxX[ i ] - start.x ) * invDir.x;
+         const F32 y0 = ( node.minY[ i ] - start.y ) * invDir.y;
+         const F32 y1 = ( node.maxY[ i ] - start.y ) * invDir.y;
+         const F32 z0 = ( node.minZ[ i ] - start.z ) * invDir.z;
+         const F32 z1 = ( node.maxZ[ i ] - start.z ) * invDir.z;
+
+         const F32 tNear = getMax( getMax( getMin( x0, x1 ), getMin( y0, y1 ) ), getMax( getMin( z0, z1 ), 0.0f ) );
+         const F32 tFar = getMin( getMin( getMax( x0, x1 ), getMax( y0, y1 ) ), getMin( getMax( z0, z1 ), bestT ) );
+
+         childT[ i ] = tNear;
+         if ( tNear <= tFar )
+            hitMask |= 1 << i;
+      }
+#endif
+
+      hitMask &= ( 1 << node.numChildren ) - 1;
+      if ( !hitMask )
+         continue;
+
+      // Visit leaves right away and push inner nodes far to near
+      // so that the nearest one is popped first.
+
+      U32 pending[ 4 ];
+      U32 numPending = 0;
+
+      for ( U32 i = 0; i < node.numChildren; ++ i )
+      {
+         if ( !( hitMask & ( 1 << i ) ) )
+            continue;
+
+         const U32 child = node.child[ i ];
+         if ( !( child & LeafFlag ) )
+         {
+            // Insertion sort by entry distance, nearest first.
+            U32 slot = numPending;
+            while ( slot > 0 && childT[ pending[ slot - 1 ] ] > childT[ i ] )
+            {
+               pending[ slot ] = pending[ slot - 1 ];
+               slot --;
+            }
+            pending[ slot ] = i;
+            numPending ++;
+            continue;
+         }
+
+         const U32 first = child & LeafFirstMask;
+         const U32 last = first + ( ( child & ~LeafFlag ) >> LeafCountShift );
+
+         for ( U32 j = first; j < last; ++ j )
+         {
+            const Triangle& tri = mTriangles[ j ];
+
+            // Triangles are one-sided.
+            if ( mDot( dir, tri.normal ) >= 0.0f )
+               continue;
+
+            const Point3F p = mCross( dir, tri.edge2 );
+            const F32 det = mDot( tri.edge1, p );
+            if ( mFabs( det ) < 1.0e-20f )
+               continue;
+
+            const F32 invDet = 1.0f / det;
+            const Point3F s = start - tri.v0;
+            const F32 u = mDot( s, p ) * invDet;
+            if ( u < 0.0f || u > 1.0f )
+               continue;
+
+            const Point3F q = mCross( s, tri.edge1 );
+            const F32 v = mDot( dir, q ) * invDet;
+            if ( v < 0.0f || u + v > 1.0f )
+               continue;
+
+            const F32 t = mDot( tri.edge2, q ) * invDet;
+            if ( t < 0.0f || t >= bestT )
+               continue;
+
+            if ( filter )
+            {
+               RayHit hit;
+               hit.t = t;
+               hit.normal = tri.normal;
+               hit.object = tri.object;
+               hit.material = tri.material;
+               if ( !filter( hit, userData ) )
+                  continue;
+            }
+
+            bestT = t;
+            bestTri = &tri;
+         }
+      }
+
+      for ( S32 i = numPending - 1; i >= 0; -- i )
+      {
+         AssertFatal( stackSize < MaxDepth * 3 + 4, "StaticCollisionTree::castRay - Stack overflow!" );
+         stack[ stackSize ].node = node.child[ pending[ i ] ];
+         stack[ stackSize ].t = childT[ pending[ i ] ];
+         stackSize ++;
+      }
+   }
+
+   if ( !bestTri )
+      return false;
+
+   outHit->t = bestT;
+   outHit->normal = bestTri->normal;
+   outHit->object = bestTri->object;
+   outHit->material = bestTri->material;
+   return true;
+}
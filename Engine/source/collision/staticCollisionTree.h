@@ -0,0 +1,191 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _STATICCOLLISIONTREE_H_
+#define _STATICCOLLISIONTREE_H_
+
+#ifndef _MPOINT3_H_
+#include "math/mPoint3.h"
+#endif
+#ifndef _MBOX_H_
+#include "math/mBox.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+
+/// A bounding volume hierarchy over a static triangle soup.
+///
+/// The tree is meant to hold the ray cast geometry of all static objects of a
+/// level in one place, so that a ray cast walks a single hierarchy instead of
+/// going from the container bins into every object's own tree.  Each triangle
+/// carries an object and a material index that the owner of the tree resolves.
+///
+/// Nodes have four children stored in SoA layout so that a ray is tested
+/// against all child boxes of a node at once.  Triangles are one-sided: only
+/// rays coming from the side the triangle normal points to hit it.
+///
+/// Usage is to add all triangles with addTriangle() and then call build().
+/// The tree is immutable after that; call clear() to start over.
+class StaticCollisionTree
+{
+   public:
+
+      enum
+      {
+         /// Maximum number of triangles in a leaf.
+         MaxLeafSize = 4,
+
+         /// Maximum number of triangles in a tree.
+         MaxTriangles = 1 << 24,
+      };
+
+      /// Result of castRay().
+      struct RayHit
+      {
+         /// Position of the hit along the ray with 0 at the start and 1 at the end.
+         F32 t;
+
+         /// World space normal of the triangle hit.
+         Point3F normal;
+
+         /// Object index passed to addTriangle().
+         U32 object;
+
+         /// Material index passed to addTriangle().
+         U32 material;
+      };
+
+      /// Called for every hit closer than the closest accepted hit so far.
+      /// Return false to ignore the hit.
+      typedef bool ( *HitFilter )( const RayHit& hit, void* userData );
+
+      StaticCollisionTree();
+
+      /// Remove all triangles and nodes.
+      void clear();
+
+      /// Add a triangle.  Must be called before build().
+      /// @param normal Front facing normal of the triangle.
+      void addTriangle( const Point3F& a, const Point3F& b, const Point3F& c, const Point3F& normal, U32 object, U32 material );
+
+      /// Build the hierarchy over the triangles added so far.
+      void build();
+
+      /// Return true if the tree holds no triangles.
+      bool isEmpty() const { return mTriangles.empty(); }
+
+      /// Return the number of triangles in the tree.
+      U32 getTriangleCount() const { return mTriangles.size(); }
+
+      /// Return the number of nodes in the tree.
+      U32 getNodeCount() const { return mNodes.size(); }
+
+      /// Return the bounds of all triangles in the tree.
+      const Box3F& getBounds() const { return mBounds; }
+
+      /// Find the closest front facing triangle along the segment from @a start
+      /// to @a end that is closer than @a maxT.
+      /// @param filter Optional filter to reject hits on certain objects.
+      /// @return True if a triangle was hit, in which case @a outHit is filled in.
+      bool castRay( const Point3F& start, const Point3F& end, F32 maxT, RayHit* outHit, HitFilter filter = NULL, void* userData = NULL ) const;
+
+   protected:
+
+      enum
+      {
+         /// Set on child references that point to a range of triangles.
+         LeafFlag = 0x80000000,
+
+         /// Bit position of the triangle count in a leaf reference.
+         LeafCountShift = 24,
+
+         /// Mask of the first triangle in a leaf reference.
+         LeafFirstMask = 0x00FFFFFF,
+
+         /// Number of bins used to evaluate split candidates.
+         NumSplitBins = 16,
+
+         /// Depth after which ranges are split in half instead of by surface
+         /// area so that degenerate input cannot deepen the tree any further.
+         MaxSAHDepth = 32,
+
+         /// Maximum depth of the hierarchy.  Bounds the traversal stack.
+         MaxDepth = 48,
+      };
+
+      struct Triangle
+      {
+         Point3F v0;
+         Point3F edge1;
+         Point3F edge2;
+         Point3F normal;
+         U32 object;
+         U32 material;
+      };
+
+      /// A node with up to four children.  Unused slots come last.
+      struct Node
+      {
+         F32 minX[ 4 ];
+         F32 minY[ 4 ];
+         F32 minZ[ 4 ];
+         F32 maxX[ 4 ];
+         F32 maxY[ 4 ];
+         F32 maxZ[ 4 ];
+
+         /// Either a node index or a leaf reference with #LeafFlag set.
+         U32 child[ 4 ];
+
+         /// Number of used slots.
+         U32 numChildren;
+      };
+
+      /// Triangle bounds used while building.
+      struct BuildRef
+      {
+         Box3F box;
+         Point3F center;
+         U32 triangle;
+      };
+
+      Vector< Triangle > mTriangles;
+      Vector< Node > mNodes;
+      Box3F mBounds;
+
+      /// Only valid during build().
+      Vector< BuildRef > mRefs;
+
+      /// Build the subtree for the refs in [begin,end) and return a reference to it.
+      U32 _buildRange( U32 begin, U32 end, U32 depth );
+
+      /// Partition the refs in [begin,end) and return the index of the first
+      /// ref of the second half.
+      U32 _splitRange( U32 begin, U32 end, U32 depth );
+
+      /// Return the bounds of the refs in [begin,end).
+      Box3F _getRangeBounds( U32 begin, U32 end ) const;
+};
+
+#endif // _STATICCOLLISIONTREE_H_
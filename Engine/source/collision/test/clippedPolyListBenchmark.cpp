@@ -0,0 +1,74 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/benchmark.h"
+#include "collision/clippedPolyList.h"
+#include "math/mRandom.h"
+
+BENCHMARK(ClippedPolyList, ClipToBox)
+{
+   // Clip a patch of ground triangles against a box like a
+   // decal projection does.
+   enum { GridSize = 16 };
+
+   ClippedPolyList polyList;
+   const Box3F box( Point3F( -3.0f, -3.0f, -1.0f ), Point3F( 3.0f, 3.0f, 1.0f ) );
+   polyList.mPlaneList.push_back( PlaneF( box.minExtents, VectorF( -1.0f, 0.0f, 0.0f ) ) );
+   polyList.mPlaneList.push_back( PlaneF( box.minExtents, VectorF( 0.0f, -1.0f, 0.0f ) ) );
+   polyList.mPlaneList.push_back( PlaneF( box.minExtents, VectorF( 0.0f, 0.0f, -1.0f ) ) );
+   polyList.mPlaneList.push_back( PlaneF( box.maxExtents, VectorF( 1.0f, 0.0f, 0.0f ) ) );
+   polyList.mPlaneList.push_back( PlaneF( box.maxExtents, VectorF( 0.0f, 1.0f, 0.0f ) ) );
+   polyList.mPlaneList.push_back( PlaneF( box.maxExtents, VectorF( 0.0f, 0.0f, 1.0f ) ) );
+   polyList.mNormal.set( 0.0f, 0.0f, 1.0f );
+   polyList.mNormalTolCosineRadians = 0.5f;
+
+   MRandomLCG random( 1 );
+   Vector< Point3F > points;
+   for( U32 y = 0; y <= GridSize; ++ y )
+      for( U32 x = 0; x <= GridSize; ++ x )
+         points.push_back( Point3F( x * 0.5f - 4.0f, y * 0.5f - 4.0f, random.randF( -0.5f, 0.5f ) ) );
+
+   while( state.keepRunning() )
+   {
+      polyList.clear();
+      for( U32 y = 0; y < GridSize; ++ y )
+         for( U32 x = 0; x < GridSize; ++ x )
+         {
+            const U32 i = y * ( GridSize + 1 ) + x;
+            const U32 quad[ 4 ] = { i, i + 1, i + GridSize + 2, i + GridSize + 1 };
+            for( U32 t = 0; t < 2; ++ t )
+            {
+               const U32 v0 = polyList.addPoint( points[ quad[ 0 ] ] );
+               const U32 v1 = polyList.addPoint( points[ quad[ t + 1 ] ] );
+               const U32 v2 = polyList.addPoint( points[ quad[ t + 2 ] ] );
+               polyList.begin( NULL, i );
+               polyList.vertex( v0 );
+               polyList.vertex( v1 );
+               polyList.vertex( v2 );
+               polyList.plane( v0, v1, v2 );
+               polyList.end();
+            }
+         }
+   }
+}
+
+#endif
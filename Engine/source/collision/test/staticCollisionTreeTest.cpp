@@ -0,0 +1,160 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "collision/staticCollisionTree.h"
+#include "math/mRandom.h"
+
+struct TestTriangle
+{
+   Point3F a, b, c, normal;
+};
+
+/// Closest front facing hit by testing every triangle.
+static S32 castRayBruteForce( const Vector< TestTriangle >& triangles, const Point3F& start, const Point3F& end, F32* outT )
+{
+   const Point3F dir = end - start;
+   S32 best = -1;
+   F32 bestT = 1.0f;
+
+   for ( U32 i = 0; i < triangles.size(); i++ )
+   {
+      const TestTriangle& tri = triangles[ i ];
+      if ( mDot( dir, tri.normal ) >= 0.0f )
+         continue;
+
+      const Point3F e1 = tri.b - tri.a;
+      const Point3F e2 = tri.c - tri.a;
+      const Point3F p = mCross( dir, e2 );
+      const F32 det = mDot( e1, p );
+      if ( mFabs( det ) < 1.0e-20f )
+         continue;
+
+      const Point3F s = start - tri.a;
+      const F32 u = mDot( s, p ) / det;
+      const Point3F q = mCross( s, e1 );
+      const F32 v = mDot( dir, q ) / det;
+      const F32 t = mDot( e2, q ) / det;
+      if ( u < 0.0f || v < 0.0f || u + v > 1.0f || t < 0.0f || t >= bestT )
+         continue;
+
+      best = i;
+      bestT = t;
+   }
+
+   *outT = bestT;
+   return best;
+}
+
+static bool rejectOddObjects( const StaticCollisionTree::RayHit& hit, void* )
+{
+   return ( hit.object & 1 ) == 0;
+}
+
+TEST(StaticCollisionTree, MatchesBruteForce)
+{
+   MRandomLCG random( 1234 );
+
+   Vector< TestTriangle > triangles;
+   StaticCollisionTree tree;
+
+   for ( U32 i = 0; i < 2000; i++ )
+   {
+      TestTriangle tri;
+      tri.a.set( random.randF( 0.0f, 200.0f ), random.randF( 0.0f, 200.0f ), random.randF( 0.0f, 20.0f ) );
+      tri.b = tri.a + Point3F( random.randF( -2.0f, 2.0f ), random.randF( -2.0f, 2.0f ), random.randF( -2.0f, 2.0f ) );
+      tri.c = tri.a + Point3F( random.randF( -2.0f, 2.0f ), random.randF( -2.0f, 2.0f ), random.randF( -2.0f, 2.0f ) );
+      tri.normal = mCross( tri.b - tri.a, tri.c - tri.a );
+      tri.normal.normalizeSafe();
+      if ( i & 1 )
+         tri.normal.neg();
+
+      triangles.push_back( tri );
+      tree.addTriangle( tri.a, tri.b, tri.c, tri.normal, i, i % 3 );
+   }
+
+   tree.build();
+   EXPECT_EQ( tree.getTriangleCount(), triangles.size() );
+   EXPECT_GT( tree.getNodeCount(), 1 );
+
+   U32 numHits = 0;
+   for ( U32 i = 0; i < 2000; i++ )
+   {
+      const Point3F start( random.randF( 0.0f, 200.0f ), random.randF( 0.0f, 200.0f ), random.randF( 0.0f, 20.0f ) );
+
+      // Mix axis aligned rays in to cover the zero direction case.
+      Point3F end;
+      if ( i % 3 == 0 )
+         end = start + Point3F( 0.0f, 0.0f, -20.0f );
+      else
+         end.set( random.randF( 0.0f, 200.0f ), random.randF( 0.0f, 200.0f ), random.randF( 0.0f, 20.0f ) );
+
+      F32 expectedT;
+      const S32 expected = castRayBruteForce( triangles, start, end, &expectedT );
+
+      StaticCollisionTree::RayHit hit;
+      const bool result = tree.castRay( start, end, 1.0f, &hit );
+
+      ASSERT_EQ( result, expected != -1 ) << "Ray " << i << " disagrees with brute force";
+      if ( result )
+      {
+         numHits ++;
+         EXPECT_NEAR( hit.t, expectedT, 1.0e-5f );
+         EXPECT_EQ( hit.material, hit.object % 3 );
+      }
+   }
+
+   EXPECT_GT( numHits, 0 ) << "Test rays should hit something";
+
+   // The filter must make the tree skip to the next closest hit.
+   for ( U32 i = 0; i < 200; i++ )
+   {
+      const Point3F start( random.randF( 0.0f, 200.0f ), random.randF( 0.0f, 200.0f ), 40.0f );
+      const Point3F end( start.x, start.y, -20.0f );
+
+      StaticCollisionTree::RayHit hit;
+      if ( tree.castRay( start, end, 1.0f, &hit, rejectOddObjects ) )
+         EXPECT_EQ( hit.object & 1, 0 );
+   }
+};
+
+TEST(StaticCollisionTree, OneSided)
+{
+   StaticCollisionTree tree;
+   tree.addTriangle( Point3F( -1, -1, 0 ), Point3F( 1, -1, 0 ), Point3F( 0, 1, 0 ), Point3F( 0, 0, 1 ), 7, 3 );
+   tree.build();
+
+   StaticCollisionTree::RayHit hit;
+   ASSERT_TRUE( tree.castRay( Point3F( 0, 0, 1 ), Point3F( 0, 0, -1 ), 1.0f, &hit ) );
+   EXPECT_FLOAT_EQ( hit.t, 0.5f );
+   EXPECT_EQ( hit.object, 7 );
+   EXPECT_EQ( hit.material, 3 );
+
+   EXPECT_FALSE( tree.castRay( Point3F( 0, 0, -1 ), Point3F( 0, 0, 1 ), 1.0f, &hit ) )
+      << "Back faces should not be hit";
+   EXPECT_FALSE( tree.castRay( Point3F( 0, 0, 1 ), Point3F( 0, 0, -1 ), 0.25f, &hit ) )
+      << "Hits beyond maxT should be ignored";
+};
+
+#endif
@@ -71,6 +71,23 @@ namespace Compiler
       return false;
    }
 
+   /// Emit OP_SETCURVAR(_CREATE) for @a varName or its slotted version if
+   /// @a varName is a local of the function being compiled.
+   inline void emitSetCurVar(CodeStream &codeStream, StringTableEntry varName, bool create)
+   {
+      if (isSlottedLocal(varName))
+      {
+         codeStream.emit(create ? OP_SETCURVAR_LOCAL_CREATE : OP_SETCURVAR_LOCAL);
+         codeStream.emitSTE(varName);
+         codeStream.emit(getLocalTable().lookup(varName));
+      }
+      else
+      {
+         codeStream.emit(create ? OP_SETCURVAR_CREATE : OP_SETCURVAR);
+         codeStream.emitSTE(varName);
+      }
+   }
+
    // Do not allow 'recursive' %this optimizations. It can lead to weird bytecode
    // generation since we can only optimize one expression at a time.
    static bool OnlyOneThisOptimization = false;
@@ -832,10 +849,7 @@ U32 VarNode::compile(CodeStream &codeStream, U32 ip, TypeReq type)
       }
    }
    else
-   {
-      codeStream.emit(OP_SETCURVAR);
-      codeStream.emitSTE(varName);
-   }
+      emitSetCurVar(codeStream, varName, false);
 
    switch (type)
    {
@@ -1134,10 +1148,8 @@ U32 AssignExprNode::compile(CodeStream &codeStream, U32 ip, TypeReq type)
          codeStream.emit(OP_TERMINATE_REWIND_STR);
    }
    else
-   {
-      codeStream.emit(OP_SETCURVAR_CREATE);
-      codeStream.emitSTE(varName);
-   }
+      emitSetCurVar(codeStream, varName, true);
+
    switch (subType)
    {
       case TypeReqString:
@@ -1267,15 +1279,20 @@ U32 AssignOpExprNode::compile(CodeStream &codeStream, U32 ip, TypeReq type)
    {
       precompileIdent(varName);
 
+      const bool slotted = isSlottedLocal(varName);
       if (op == opPLUSPLUS)
       {
-         codeStream.emit(OP_INC);
+         codeStream.emit(slotted ? OP_INC_LOCAL : OP_INC);
          codeStream.emitSTE(varName);
+         if (slotted)
+            codeStream.emit(getLocalTable().lookup(varName));
       }
       else if (op == opMINUSMINUS)
       {
-         codeStream.emit(OP_DEC);
+         codeStream.emit(slotted ? OP_DEC_LOCAL : OP_DEC);
          codeStream.emitSTE(varName);
+         if (slotted)
+            codeStream.emit(getLocalTable().lookup(varName));
       }
       else
       {
@@ -1310,10 +1327,7 @@ U32 AssignOpExprNode::compile(CodeStream &codeStream, U32 ip, TypeReq type)
       precompileIdent(varName);
 
       if (!arrayIndex || shortCircuit)
-      {
-         codeStream.emit(OP_SETCURVAR_CREATE);
-         codeStream.emitSTE(varName);
-      }
+         emitSetCurVar(codeStream, varName, true);
       else
       {
          // Ok, lets try to optimize %var[%someothervar] as this is
@@ -1895,10 +1909,14 @@ U32 FunctionDeclStmtNode::compileStmt(CodeStream &codeStream, U32 ip)
    setCurrentStringTable(&getFunctionStringTable());
    setCurrentFloatTable(&getFunctionFloatTable());
 
+   // The arguments take the first local slots; see CodeInterpreter::exec().
+   getLocalTable().reset();
+
    argc = 0;
    for (VarNode *walk = args; walk; walk = (VarNode *)((StmtNode*)walk)->getNext())
    {
       precompileIdent(walk->varName);
+      getLocalTable().add(walk->varName);
       argc++;
    }
 
@@ -1932,6 +1950,8 @@ U32 FunctionDeclStmtNode::compileStmt(CodeStream &codeStream, U32 ip)
    CodeBlock::smInFunction = false;
    codeStream.emit(OP_RETURN_VOID);
 
+   getLocalTable().reset();
+
    codeStream.patch(endIp, codeStream.tell());
 
    setCurrentStringTable(&getGlobalStringTable());
@@ -0,0 +1,236 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "console/asyncLogWriter.h"
+
+#include "console/console.h"
+#include "core/util/hashFunction.h"
+
+
+bool AsyncLogWriter::smEnabled = false;
+bool AsyncLogWriter::smJSON = false;
+S32 AsyncLogWriter::smRepeatLimit = 0;
+S32 AsyncLogWriter::smFlushInterval = 250;
+
+//-----------------------------------------------------------------------------
+
+AsyncLogWriter::AsyncLogWriter( const char *fileName, bool append )
+   : mOpen( false ),
+     mLines( Capacity ),
+     mWakeUp( 0 ),
+     mStopping( false ),
+     mUnsignalled( 0 ),
+     mDropped( 0 ),
+     mLastHash( 0 ),
+     mLastLength( 0 ),
+     mLastLevel( 0 ),
+     mRepeatCount( 0 )
+{
+   // The stream is only touched by the writer thread from here on.
+   mOpen = mStream.open( fileName, append ? Torque::FS::File::WriteAppend : Torque::FS::File::Write );
+   if( mOpen )
+      start();
+}
+
+//-----------------------------------------------------------------------------
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+   if( !mOpen )
+      return;
+
+   _pushRepeatNotice();
+
+   mStopping = true;
+   mWakeUp.release();
+   join();
+
+   mStream.close();
+}
+
+//-----------------------------------------------------------------------------
+
+void AsyncLogWriter::write( U32 level, const char *line )
+{
+   if( !mOpen )
+      return;
+
+   // Collapse runs of the same line.
+   if( smRepeatLimit > 0 )
+   {
+      const U32 length = dStrlen( line );
+      const U32 lineHash = Torque::hash( (const U8*)line, length, 0 );
+
+      if( lineHash == mLastHash && length == mLastLength )
+      {
+         mRepeatCount++;
+         if( mRepeatCount > smRepeatLimit )
+            return;
+      }
+      else
+      {
+         _pushRepeatNotice();
+
+         mLastHash = lineHash;
+         mLastLength = length;
+         mLastLevel = level;
+         mRepeatCount = 0;
+      }
+   }
+
+   _push( level, line );
+}
+
+//-----------------------------------------------------------------------------
+
+void AsyncLogWriter::_pushRepeatNotice()
+{
+   if( smRepeatLimit <= 0 || mRepeatCount <= smRepeatLimit )
+      return;
+
+   char buffer[ 128 ];
+   dSprintf( buffer, sizeof( buffer ), "[previous message repeated %d more times]", mRepeatCount - smRepeatLimit );
+   mRepeatCount = 0;
+
+   _push( mLastLevel, buffer );
+}
+
+//-----------------------------------------------------------------------------
+
+void AsyncLogWriter::_push( U32 level, const char *text )
+{
+   // Report lines lost to a full buffer before the next one that fits.
+   if( mDropped > 0 )
+   {
+      char buffer[ 128 ];
+      dSprintf( buffer, sizeof( buffer ), "[%d log lines dropped, the log buffer was full]", mDropped );
+
+      Line notice;
+      notice.mText = dStrdup( buffer );
+      notice.mLevel = ConsoleLogEntry::Warning;
+      notice.mTime = Platform::getRealMilliseconds();
+
+      if( mLines.tryPushBack( notice ) )
+         mDropped = 0;
+      else
+         dFree( notice.mText );
+   }
+
+   Line line;
+   line.mText = dStrdup( text );
+   line.mLevel = level;
+   line.mTime = Platform::getRealMilliseconds();
+
+   if( mDropped > 0 || !mLines.tryPushBack( line ) )
+   {
+      dFree( line.mText );
+      mDropped++;
+      mWakeUp.release();
+      return;
+   }
+
+   // Wake the writer for every batch, and straight away for errors so they
+   // reach the disk before a possible crash.
+   if( level == ConsoleLogEntry::Error || ++mUnsignalled >= BatchSize )
+   {
+      mUnsignalled = 0;
+      mWakeUp.release();
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void AsyncLogWriter::run( void *arg )
+{
+   _setName( "AsyncLogWriter" );
+
+   while( true )
+   {
+      mWakeUp.acquire( true, getMax( smFlushInterval, 1 ) );
+
+      bool wrote = false;
+      Line line;
+      while( mLines.tryPopFront( line ) )
+      {
+         _writeLine( line );
+         dFree( line.mText );
+         wrote = true;
+      }
+
+      // One flush per batch.
+      if( wrote )
+         mStream.flush();
+
+      if( mStopping && mLines.isEmpty() )
+         break;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void AsyncLogWriter::_writeLine( const Line &line )
+{
+   if( !smJSON )
+   {
+      mStream.write( dStrlen( line.mText ), line.mText );
+      mStream.write( 2, "\r\n" );
+      return;
+   }
+
+   const char *level = "normal";
+   if( line.mLevel == ConsoleLogEntry::Warning )
+      level = "warning";
+   else if( line.mLevel == ConsoleLogEntry::Error )
+      level = "error";
+
+   char buffer[ 256 ];
+   S32 length = dSprintf( buffer, sizeof( buffer ), "{\"time\":%u,\"level\":\"%s\",\"message\":\"", line.mTime, level );
+   mStream.write( length, buffer );
+
+   // Escape the message.
+   length = 0;
+   for( const char *c = line.mText; *c; c++ )
+   {
+      if( length > sizeof( buffer ) - 8 )
+      {
+         mStream.write( length, buffer );
+         length = 0;
+      }
+
+      const U8 ch = *c;
+      if( ch == '"' || ch == '\\' )
+      {
+         buffer[ length++ ] = '\\';
+         buffer[ length++ ] = ch;
+      }
+      else if( ch < 0x20 )
+         length += dSprintf( buffer + length, 8, "\\u%04x", ch );
+      else
+         buffer[ length++ ] = ch;
+   }
+
+   buffer[ length++ ] = '"';
+   buffer[ length++ ] = '}';
+   buffer[ length++ ] = '\n';
+   mStream.write( length, buffer );
+}
@@ -0,0 +1,141 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _ASYNCLOGWRITER_H_
+#define _ASYNCLOGWRITER_H_
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+   #include "platform/threads/thread.h"
+#endif
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+   #include "platform/threads/semaphore.h"
+#endif
+#ifndef _THREADSAFERINGBUFFER_H_
+   #include "platform/threads/threadSafeRingBuffer.h"
+#endif
+#ifndef _FILESTREAM_H_
+   #include "core/stream/fileStream.h"
+#endif
+
+
+/// @ingroup console_system Console System
+/// @{
+
+/// Writes console log lines to a file on a background thread.
+///
+/// Lines are copied into a lock-free ring buffer and written out in batches,
+/// with one flush per batch.  The writer thread wakes up when a batch has
+/// filled up, when an error is logged, or after $Con::asyncLogFlushInterval
+/// milliseconds.  If the buffer overflows, lines are dropped and a notice is
+/// written in their place rather than stalling the caller.
+///
+/// Runs of identical lines beyond $Con::logRepeatLimit are collapsed into a
+/// single "repeated" notice, and $Con::logJSON writes one JSON object per
+/// line for log shipping.
+class AsyncLogWriter : public Thread
+{
+   typedef Thread Parent;
+
+   public:
+
+      /// If true, the console log file and ConsoleLoggers write through
+      /// an AsyncLogWriter.
+      static bool smEnabled;
+
+      /// If true, lines are written as JSON objects.
+      static bool smJSON;
+
+      /// Number of identical consecutive lines written before the rest are
+      /// suppressed.  Zero disables suppression.
+      static S32 smRepeatLimit;
+
+      /// Maximum time in milliseconds a line waits before being written.
+      static S32 smFlushInterval;
+
+      /// Opens @a fileName and starts the writer thread.
+      AsyncLogWriter( const char *fileName, bool append );
+
+      /// Writes any pending lines and closes the file.
+      virtual ~AsyncLogWriter();
+
+      /// Returns true if the file was opened.
+      bool isOpen() const { return mOpen; }
+
+      /// Queues a line.
+      /// @param level  A ConsoleLogEntry::Level.
+      /// @param line   The text without a line terminator.
+      void write( U32 level, const char *line );
+
+      // Thread
+      virtual void run( void *arg );
+
+   protected:
+
+      enum
+      {
+         /// Lines the ring buffer holds.
+         Capacity = 8192,
+
+         /// Lines queued before the writer thread is woken up.
+         BatchSize = 256,
+      };
+
+      struct Line
+      {
+         Line() : mText( NULL ), mLevel( 0 ), mTime( 0 ) {}
+
+         char *mText;
+         U32 mLevel;
+         U32 mTime;
+      };
+
+      FileStream mStream;
+      bool mOpen;
+
+      ThreadSafeRingBuffer< Line > mLines;
+      Semaphore mWakeUp;
+      volatile bool mStopping;
+
+      /// @name Producer state
+      /// @{
+      U32 mUnsignalled;
+      U32 mDropped;
+      U32 mLastHash;
+      U32 mLastLength;
+      U32 mLastLevel;
+      U32 mRepeatCount;
+      /// @}
+
+      /// Queues a line, counting it as dropped if the buffer is full.
+      void _push( U32 level, const char *text );
+
+      /// Queues a notice for any lines suppressed as repeats.
+      void _pushRepeatNotice();
+
+      /// Formats and writes a line on the writer thread.
+      void _writeLine( const Line &line );
+};
+
+/// @}
+
+#endif // _ASYNCLOGWRITER_H_
@@ -23,12 +23,14 @@
 #include "console/console.h"
 #include "console/compiler.h"
 #include "console/codeBlock.h"
+#include "console/codeInterpreter.h"
 #include "console/telnetDebugger.h"
 #include "console/ast.h"
 #include "core/strings/unicode.h"
 #include "core/strings/stringFunctions.h"
 #include "core/stringTable.h"
 #include "core/stream/fileStream.h"
+#include "core/crc.h"
 
 using namespace Compiler;
 
@@ -341,6 +343,22 @@ void CodeBlock::calcBreakList()
       TelDebugger->addAllBreakpoints(this);
 }
 
+U32 CodeBlock::getSourceCRC(const char *script)
+{
+   return CRC::calculateCRC(script, dStrlen(script));
+}
+
+bool CodeBlock::readDSOHeader(Stream &st, U32 &version, U32 &sourceCRC)
+{
+   version = 0;
+   sourceCRC = 0;
+
+   if (!st.read(&version) || version != Con::DSOVersion)
+      return false;
+
+   return st.read(&sourceCRC);
+}
+
 bool CodeBlock::read(StringTableEntry fileName, Stream &st)
 {
    const StringTableEntry exePath = Platform::getMainDotCsDir();
@@ -511,6 +529,7 @@ bool CodeBlock::compile(const char *codeFileName, StringTableEntry fileName, con
    if (!st.open(codeFileName, Torque::FS::File::Write))
       return false;
    st.write(U32(Con::DSOVersion));
+   st.write(getSourceCRC(inScript));
 
    // Reset all our value tables...
    resetTables();
@@ -1045,6 +1064,80 @@ void CodeBlock::dumpInstructions(U32 startIp, bool upToReturn)
             break;
          }
 
+         case OP_SETCURVAR_LOCAL:
+         {
+            StringTableEntry var = CodeToSTE(code, ip);
+
+            Con::printf("%i: OP_SETCURVAR_LOCAL var=%s slot=%i", ip - 1, var, code[ip + 2]);
+            ip += 3;
+            break;
+         }
+
+         case OP_SETCURVAR_LOCAL_CREATE:
+         {
+            StringTableEntry var = CodeToSTE(code, ip);
+
+            Con::printf("%i: OP_SETCURVAR_LOCAL_CREATE var=%s slot=%i", ip - 1, var, code[ip + 2]);
+            ip += 3;
+            break;
+         }
+
+         case OP_INC_LOCAL:
+         {
+            Con::printf("%i: OP_INC_LOCAL varName=%s slot=%i", ip - 1, CodeToSTE(code, ip), code[ip + 2]);
+            ip += 3;
+            break;
+         }
+
+         case OP_DEC_LOCAL:
+         {
+            Con::printf("%i: OP_DEC_LOCAL varName=%s slot=%i", ip - 1, CodeToSTE(code, ip), code[ip + 2]);
+            ip += 3;
+            break;
+         }
+
+         case OP_LOADLOCAL_UINT:
+         {
+            Con::printf("%i: OP_LOADLOCAL_UINT varName=%s slot=%i", ip - 1, CodeToSTE(code, ip), code[ip + 2]);
+            ip += 4;
+            break;
+         }
+
+         case OP_LOADLOCAL_FLT:
+         {
+            Con::printf("%i: OP_LOADLOCAL_FLT varName=%s slot=%i", ip - 1, CodeToSTE(code, ip), code[ip + 2]);
+            ip += 4;
+            break;
+         }
+
+         case OP_LOADLOCAL_STR:
+         {
+            Con::printf("%i: OP_LOADLOCAL_STR varName=%s slot=%i", ip - 1, CodeToSTE(code, ip), code[ip + 2]);
+            ip += 4;
+            break;
+         }
+
+         case OP_SAVELOCAL_UINT:
+         {
+            Con::printf("%i: OP_SAVELOCAL_UINT varName=%s slot=%i", ip - 1, CodeToSTE(code, ip), code[ip + 2]);
+            ip += 4;
+            break;
+         }
+
+         case OP_SAVELOCAL_FLT:
+         {
+            Con::printf("%i: OP_SAVELOCAL_FLT varName=%s slot=%i", ip - 1, CodeToSTE(code, ip), code[ip + 2]);
+            ip += 4;
+            break;
+         }
+
+         case OP_SAVELOCAL_STR:
+         {
+            Con::printf("%i: OP_SAVELOCAL_STR varName=%s slot=%i", ip - 1, CodeToSTE(code, ip), code[ip + 2]);
+            ip += 4;
+            break;
+         }
+
          case OP_SETCURVAR_ARRAY:
          {
             Con::printf("%i: OP_SETCURVAR_ARRAY", ip - 1);
@@ -1330,7 +1423,7 @@ void CodeBlock::dumpInstructions(U32 startIp, bool upToReturn)
          {
             StringTableEntry fnNamespace = CodeToSTE(code, ip + 2);
             StringTableEntry fnName = CodeToSTE(code, ip);
-            U32 callType = code[ip + 2];
+            U32 callType = code[ip + 4] & CallSiteCache::CallTypeMask;
 
             Con::printf("%i: OP_CALLFUNC_RESOLVE name=%s nspace=%s callType=%s", ip - 1, fnName, fnNamespace,
                callType == FuncCallExprNode::FunctionCall ? "FunctionCall"
@@ -1344,7 +1437,7 @@ void CodeBlock::dumpInstructions(U32 startIp, bool upToReturn)
          {
             StringTableEntry fnNamespace = CodeToSTE(code, ip + 2);
             StringTableEntry fnName = CodeToSTE(code, ip);
-            U32 callType = code[ip + 4];
+            U32 callType = code[ip + 4] & CallSiteCache::CallTypeMask;
 
             Con::printf("%i: OP_CALLFUNC name=%s nspace=%s callType=%s", ip - 1, fnName, fnNamespace,
                callType == FuncCallExprNode::FunctionCall ? "FunctionCall"
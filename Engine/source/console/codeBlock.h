@@ -25,10 +25,12 @@
 
 #include "console/compiler.h"
 #include "console/consoleParser.h"
+#include "core/util/tVector.h"
 
 class Stream;
 class ConsoleValue;
 class ConsoleValueRef;
+struct CallSiteCache;
 
 /// Core TorqueScript code management class.
 ///
@@ -85,6 +87,10 @@ public:
    U32 *breakList;
    CodeBlock *nextFile;
 
+   /// Lookup caches for the OP_CALLFUNC sites in #code.  A call site is
+   /// assigned a slot the first time it runs; see CodeInterpreter::op_callfunc().
+   Vector<CallSiteCache> callSiteCaches;
+
    void addToCodeList();
    void removeFromCodeList();
    void calcBreakList();
@@ -109,12 +115,22 @@ public:
    /// 
    String getFunctionArgs(U32 offset);
 
+   /// Reads a compiled block from @a st, which must be positioned right
+   /// after the DSO header (see readDSOHeader()).
    bool read(StringTableEntry fileName, Stream &st);
    bool compile(const char *dsoName, StringTableEntry fileName, const char *script, bool overrideNoDso = false);
 
    void incRefCount();
    void decRefCount();
 
+   /// Returns the checksum of a script's source that compile() stores in
+   /// the DSO header.
+   static U32 getSourceCRC(const char *script);
+
+   /// Reads the header written by compile() from the start of a DSO.
+   /// Returns false if the DSO was written by a different DSOVersion.
+   static bool readDSOHeader(Stream &st, U32 &version, U32 &sourceCRC);
+
    /// Compiles and executes a block of script storing the compiled code in this
    /// CodeBlock. If there is no filename breakpoints will not be generated and 
    /// the CodeBlock will not be added to the linked list of loaded CodeBlocks. 
@@ -37,6 +37,7 @@
 #include "core/strings/stringUnit.h"
 #include "console/console.h"
 #include "console/consoleInternal.h"
+#include "console/scriptProfiler.h"
 
 //#define TORQUE_VALIDATE_STACK
 
@@ -277,6 +278,16 @@ void CodeInterpreter::init()
    gOpCodeArray[OP_DEC] = &CodeInterpreter::op_dec;
    gOpCodeArray[OP_SETCURVAR] = &CodeInterpreter::op_setcurvar;
    gOpCodeArray[OP_SETCURVAR_CREATE] = &CodeInterpreter::op_setcurvar_create;
+   gOpCodeArray[OP_SETCURVAR_LOCAL] = &CodeInterpreter::op_setcurvar_local;
+   gOpCodeArray[OP_SETCURVAR_LOCAL_CREATE] = &CodeInterpreter::op_setcurvar_local_create;
+   gOpCodeArray[OP_INC_LOCAL] = &CodeInterpreter::op_inc_local;
+   gOpCodeArray[OP_DEC_LOCAL] = &CodeInterpreter::op_dec_local;
+   gOpCodeArray[OP_LOADLOCAL_UINT] = &CodeInterpreter::op_loadlocal_uint;
+   gOpCodeArray[OP_LOADLOCAL_FLT] = &CodeInterpreter::op_loadlocal_flt;
+   gOpCodeArray[OP_LOADLOCAL_STR] = &CodeInterpreter::op_loadlocal_str;
+   gOpCodeArray[OP_SAVELOCAL_UINT] = &CodeInterpreter::op_savelocal_uint;
+   gOpCodeArray[OP_SAVELOCAL_FLT] = &CodeInterpreter::op_savelocal_flt;
+   gOpCodeArray[OP_SAVELOCAL_STR] = &CodeInterpreter::op_savelocal_str;
    gOpCodeArray[OP_SETCURVAR_ARRAY] = &CodeInterpreter::op_setcurvar_array;
    gOpCodeArray[OP_SETCURVAR_ARRAY_VARLOOKUP] = &CodeInterpreter::op_setcurvar_array_varlookup;
    gOpCodeArray[OP_SETCURVAR_ARRAY_CREATE] = &CodeInterpreter::op_setcurvar_array_create;
@@ -365,6 +376,7 @@ ConsoleValueRef CodeInterpreter::exec(U32 ip,
    mCodeBlock->incRefCount();
 
    mPopFrame = false;
+   mProfilerSession = 0;
 
 #ifdef TORQUE_VALIDATE_STACK
    U32 stackStart = STR.mStartStackSize;
@@ -412,6 +424,9 @@ exitLabel:
    if (telDebuggerOn && setFrame < 0)
       TelDebugger->popStackFrame();
 
+   if (mProfilerSession)
+      ScriptProfiler::exitFunction(mProfilerSession);
+
    if (mPopFrame)
       gEvalState.popFrame();
 
@@ -502,6 +517,9 @@ void CodeInterpreter::parseArgs(U32 &ip)
       gEvalState.pushFrame(mThisFunctionName, mExec.thisNamespace);
       mPopFrame = true;
 
+      if (ScriptProfiler::isRunning())
+         mProfilerSession = ScriptProfiler::enterFunction(mExec.thisNamespace, mThisFunctionName, mExec.packageName);
+
       StringTableEntry thisPointer = StringTable->insert("%this");
 
       for (S32 i = 0; i < wantedArgc; i++)
@@ -509,6 +527,9 @@ void CodeInterpreter::parseArgs(U32 &ip)
          StringTableEntry var = Compiler::CodeToSTE(code, ip + (2 + 6 + 1) + (i * 2));
          gEvalState.setCurVarNameCreate(var);
 
+         // The compiler gives the arguments the first local slots.
+         gEvalState.getCurrentFrame().setLocalSlot(i, gEvalState.currentVariable);
+
          ConsoleValueRef ref = mExec.argv[i + 1];
 
          switch (ref.getType())
@@ -1520,6 +1541,140 @@ OPCodeReturn CodeInterpreter::op_setcurvar_create(U32 &ip)
    return OPCodeReturn::success;
 }
 
+void CodeInterpreter::setCurLocalVar(U32 &ip, bool create)
+{
+   StringTableEntry var = CodeToSTE(mCodeBlock->code, ip);
+   U32 slot = mCodeBlock->code[ip + 2];
+   ip += 3;
+
+   // See OP_SETCURVAR
+   mPrevField = NULL;
+   mPrevObject = NULL;
+   mCurObject = NULL;
+
+   if (create)
+      gEvalState.setCurLocalVarCreate(var, slot);
+   else
+      gEvalState.setCurLocalVar(var, slot);
+
+   // See OP_SETCURVAR for why we do this.
+   mCurFNDocBlock = NULL;
+   mCurNSDocBlock = NULL;
+}
+
+OPCodeReturn CodeInterpreter::op_setcurvar_local(U32 &ip)
+{
+   const U32 opIp = ip - 1;
+   setCurLocalVar(ip, false);
+
+   // Fuse with a following load so the next run of this code dispatches
+   // once instead of twice.  Leave breakpoints alone.
+   U32 *code = mCodeBlock->code;
+   if (code[opIp] == OP_SETCURVAR_LOCAL)
+   {
+      switch (code[ip])
+      {
+         case OP_LOADVAR_UINT: code[opIp] = OP_LOADLOCAL_UINT; break;
+         case OP_LOADVAR_FLT:  code[opIp] = OP_LOADLOCAL_FLT; break;
+         case OP_LOADVAR_STR:  code[opIp] = OP_LOADLOCAL_STR; break;
+      }
+   }
+
+   return OPCodeReturn::success;
+}
+
+OPCodeReturn CodeInterpreter::op_setcurvar_local_create(U32 &ip)
+{
+   const U32 opIp = ip - 1;
+   setCurLocalVar(ip, true);
+
+   // Same as above for stores.
+   U32 *code = mCodeBlock->code;
+   if (code[opIp] == OP_SETCURVAR_LOCAL_CREATE)
+   {
+      switch (code[ip])
+      {
+         case OP_SAVEVAR_UINT: code[opIp] = OP_SAVELOCAL_UINT; break;
+         case OP_SAVEVAR_FLT:  code[opIp] = OP_SAVELOCAL_FLT; break;
+         case OP_SAVEVAR_STR:  code[opIp] = OP_SAVELOCAL_STR; break;
+      }
+   }
+
+   return OPCodeReturn::success;
+}
+
+OPCodeReturn CodeInterpreter::op_loadlocal_uint(U32 &ip)
+{
+   // OP_SETCURVAR_LOCAL + OP_LOADVAR_UINT; skip the unfused load.
+   setCurLocalVar(ip, false);
+   ip++;
+   return op_loadvar_uint(ip);
+}
+
+OPCodeReturn CodeInterpreter::op_loadlocal_flt(U32 &ip)
+{
+   setCurLocalVar(ip, false);
+   ip++;
+   return op_loadvar_flt(ip);
+}
+
+OPCodeReturn CodeInterpreter::op_loadlocal_str(U32 &ip)
+{
+   setCurLocalVar(ip, false);
+   ip++;
+   return op_loadvar_str(ip);
+}
+
+OPCodeReturn CodeInterpreter::op_savelocal_uint(U32 &ip)
+{
+   // OP_SETCURVAR_LOCAL_CREATE + OP_SAVEVAR_UINT; skip the unfused save.
+   setCurLocalVar(ip, true);
+   ip++;
+   return op_savevar_uint(ip);
+}
+
+OPCodeReturn CodeInterpreter::op_savelocal_flt(U32 &ip)
+{
+   setCurLocalVar(ip, true);
+   ip++;
+   return op_savevar_flt(ip);
+}
+
+OPCodeReturn CodeInterpreter::op_savelocal_str(U32 &ip)
+{
+   setCurLocalVar(ip, true);
+   ip++;
+   return op_savevar_str(ip);
+}
+
+OPCodeReturn CodeInterpreter::op_inc_local(U32 &ip)
+{
+   // Same as OP_INC with the variable going through its frame slot.
+   setCurLocalVar(ip, true);
+
+   F64 val = gEvalState.getFloatVariable() + 1.0;
+   gEvalState.setFloatVariable(val);
+
+   floatStack[_FLT + 1] = val;
+   _FLT++;
+
+   return OPCodeReturn::success;
+}
+
+OPCodeReturn CodeInterpreter::op_dec_local(U32 &ip)
+{
+   // Same as OP_DEC with the variable going through its frame slot.
+   setCurLocalVar(ip, true);
+
+   F64 val = gEvalState.getFloatVariable() - 1.0;
+   gEvalState.setFloatVariable(val);
+
+   floatStack[_FLT + 1] = val;
+   _FLT++;
+
+   return OPCodeReturn::success;
+}
+
 OPCodeReturn CodeInterpreter::op_setcurvar_array(U32 &ip)
 {
    StringTableEntry var = STR.getSTValue();
@@ -2026,7 +2181,7 @@ OPCodeReturn CodeInterpreter::op_callfunc_resolve(U32 &ip)
    StringTableEntry fnName = CodeToSTE(mCodeBlock->code, ip);
 
    // Try to look it up.
-   mNSEntry = Namespace::find(fnNamespace)->lookup(fnName);
+   mNSEntry = lookupCallSite(ip, NULL, fnName);
    if (!mNSEntry)
    {
       ip += 5;
@@ -2045,6 +2200,44 @@ OPCodeReturn CodeInterpreter::op_callfunc_resolve(U32 &ip)
    return ret;
 }
 
+Namespace::Entry* CodeInterpreter::lookupCallSite(U32 ip, Namespace *ns, StringTableEntry fnName)
+{
+   U32 *code = mCodeBlock->code;
+   Vector<CallSiteCache> &caches = mCodeBlock->callSiteCaches;
+
+   U32 slot = code[ip + 4] >> CallSiteCache::SlotShift;
+   if (slot)
+   {
+      const CallSiteCache &cache = caches[slot - 1];
+      if (cache.mNamespace == ns && cache.mSequence == Namespace::mCacheSequence)
+         return cache.mEntry;
+   }
+
+   Namespace *lookupNs = ns ? ns : Namespace::find(CodeToSTE(code, ip + 2));
+   Namespace::Entry *entry = lookupNs->lookup(fnName);
+
+   // Don't cache failed lookups; the function may be defined later on
+   // without anything changing the sequence.
+   if (!entry)
+      return NULL;
+
+   // Assign the call site a cache by patching its index into the call
+   // type word.
+   if (!slot)
+   {
+      caches.increment();
+      slot = caches.size();
+      code[ip + 4] |= slot << CallSiteCache::SlotShift;
+   }
+
+   CallSiteCache &cache = caches[slot - 1];
+   cache.mNamespace = ns;
+   cache.mSequence = Namespace::mCacheSequence;
+   cache.mEntry = entry;
+
+   return entry;
+}
+
 OPCodeReturn CodeInterpreter::op_callfunc(U32 &ip)
 {
    // This routingId is set when we query the object as to whether
@@ -2064,7 +2257,8 @@ OPCodeReturn CodeInterpreter::op_callfunc(U32 &ip)
       gEvalState.getCurrentFrame().ip = ip - 1;
    }
 
-   U32 callType = code[ip + 4];
+   const U32 callSiteIp = ip;
+   U32 callType = code[ip + 4] & CallSiteCache::CallTypeMask;
 
    ip += 5;
    CSTK.getArgcArgv(fnName, &mCallArgc, &mCallArgv);
@@ -2075,12 +2269,15 @@ OPCodeReturn CodeInterpreter::op_callfunc(U32 &ip)
    if (callType == FuncCallExprNode::FunctionCall)
    {
       if (!mNSEntry)
-         mNSEntry = Namespace::global()->lookup(fnName);
+         mNSEntry = lookupCallSite(callSiteIp, NULL, fnName);
    }
    else if (callType == FuncCallExprNode::MethodCall)
    {
       mSaveObject = gEvalState.thisObject;
-      gEvalState.thisObject = Sim::findObject((const char*)mCallArgv[1]);
+      if (mCallArgv[1].isInt())
+         gEvalState.thisObject = Sim::findObject(SimObjectId(mCallArgv[1].getIntValue()));
+      else
+         gEvalState.thisObject = Sim::findObject((const char*)mCallArgv[1]);
       if (!gEvalState.thisObject)
       {
          // Go back to the previous saved object.
@@ -2103,7 +2300,7 @@ OPCodeReturn CodeInterpreter::op_callfunc(U32 &ip)
 
       ns = gEvalState.thisObject->getNamespace();
       if (ns)
-         mNSEntry = ns->lookup(fnName);
+         mNSEntry = lookupCallSite(callSiteIp, ns, fnName);
       else
          mNSEntry = NULL;
    }
@@ -2113,7 +2310,7 @@ OPCodeReturn CodeInterpreter::op_callfunc(U32 &ip)
       {
          ns = mExec.thisNamespace->mParent;
          if (ns)
-            mNSEntry = ns->lookup(fnName);
+            mNSEntry = lookupCallSite(callSiteIp, ns, fnName);
          else
             mNSEntry = NULL;
       }
@@ -2154,6 +2351,8 @@ OPCodeReturn CodeInterpreter::op_callfunc(U32 &ip)
       return OPCodeReturn::success;
    }
 
+   mNSEntry->mCallCount++;
+
    // ConsoleFunctionType is for any function defined by script.
    // Any 'callback' type is an engine function that is exposed to script.
    if (mNSEntry->mType == Namespace::Entry::ConsoleFunctionType)
@@ -2341,6 +2540,8 @@ OPCodeReturn CodeInterpreter::op_callfunc_pointer(U32 &ip)
       return OPCodeReturn::success;
    }
 
+   mNSEntry->mCallCount++;
+
    // ConsoleFunctionType is for any function defined by script.
    // Any 'callback' type is an engine function that is exposed to script.
    if (mNSEntry->mType == Namespace::Entry::ConsoleFunctionType)
@@ -2537,6 +2738,8 @@ OPCodeReturn CodeInterpreter::op_callfunc_this(U32 &ip)
       return OPCodeReturn::success;
    }
 
+   mNSEntry->mCallCount++;
+
    // ConsoleFunctionType is for any function defined by script.
    // Any 'callback' type is an engine function that is exposed to script.
    if (mNSEntry->mType == Namespace::Entry::ConsoleFunctionType)
@@ -63,6 +63,33 @@ struct IterStackRecord
    } mData;
 };
 
+/// Cached namespace lookup of an OP_CALLFUNC/OP_CALLFUNC_RESOLVE site.
+///
+/// Namespace::mCacheSequence changes whenever functions are added, packages
+/// are activated or deactivated or classes are linked, so an entry stays
+/// valid as long as its sequence matches and the call is made in the same
+/// namespace as the last time.  Method calls thus hit the cache as long as
+/// a call site keeps seeing objects of the same class.
+struct CallSiteCache
+{
+   enum
+   {
+      /// Bits of the call type word holding the FuncCallExprNode call type.
+      /// The remaining bits hold the index of the site's cache plus one.
+      CallTypeMask = 0xFF,
+      SlotShift = 8,
+   };
+
+   /// Namespace the lookup was done in or NULL for the namespace named by
+   /// the call site.
+   Namespace *mNamespace;
+
+   /// Value of Namespace::mCacheSequence at lookup time.
+   U32 mSequence;
+
+   Namespace::Entry *mEntry;
+};
+
 enum OPCodeReturn
 {
    exitCode = -1,
@@ -136,6 +163,16 @@ private:
    OPCodeReturn op_dec(U32 &ip);
    OPCodeReturn op_setcurvar(U32 &ip);
    OPCodeReturn op_setcurvar_create(U32 &ip);
+   OPCodeReturn op_setcurvar_local(U32 &ip);
+   OPCodeReturn op_setcurvar_local_create(U32 &ip);
+   OPCodeReturn op_inc_local(U32 &ip);
+   OPCodeReturn op_dec_local(U32 &ip);
+   OPCodeReturn op_loadlocal_uint(U32 &ip);
+   OPCodeReturn op_loadlocal_flt(U32 &ip);
+   OPCodeReturn op_loadlocal_str(U32 &ip);
+   OPCodeReturn op_savelocal_uint(U32 &ip);
+   OPCodeReturn op_savelocal_flt(U32 &ip);
+   OPCodeReturn op_savelocal_str(U32 &ip);
    OPCodeReturn op_setcurvar_array(U32 &ip);
    OPCodeReturn op_setcurvar_array_varlookup(U32 &ip);
    OPCodeReturn op_setcurvar_array_create(U32 &ip);
@@ -206,6 +243,13 @@ private:
    /// @}
 
 private:
+   /// Look up @a fnName for the call site at @a ip through the site's cache.
+   /// @param ns Namespace to look in or NULL for the one named by the call site.
+   Namespace::Entry* lookupCallSite(U32 ip, Namespace *ns, StringTableEntry fnName);
+
+   /// Make the local at @a ip the current variable and step over its operands.
+   void setCurLocalVar(U32 &ip, bool create);
+
    CodeBlock *mCodeBlock;
 
    /// Group exec arguments.
@@ -226,6 +270,9 @@ private:
    StringTableEntry mThisFunctionName;
    bool mPopFrame;
 
+   /// ScriptProfiler session this call was recorded in or 0.
+   U32 mProfilerSession;
+
    // Add local object creation stack [7/9/2007 Black]
    static const U32 objectCreationStackSize = 32;
    U32 mObjectCreationStackIndex;
@@ -201,6 +201,35 @@ void ExprEvalState::setCurVarNameCreate(StringTableEntry name)
    }
 }
 
+void ExprEvalState::setCurLocalVar(StringTableEntry name, U32 slot)
+{
+   AssertFatal(getStackDepth() > 0, "ExprEvalState::setCurLocalVar - Not in a function!");
+
+   Dictionary& frame = getCurrentFrame();
+   currentVariable = frame.getLocalSlot(slot);
+   if (currentVariable)
+      return;
+
+   currentVariable = frame.lookup(name);
+   if (currentVariable)
+      frame.setLocalSlot(slot, currentVariable);
+   else if (gWarnUndefinedScriptVariables)
+      Con::warnf(ConsoleLogEntry::Script, "Variable referenced before assignment: %s", name);
+}
+
+void ExprEvalState::setCurLocalVarCreate(StringTableEntry name, U32 slot)
+{
+   AssertFatal(getStackDepth() > 0, "ExprEvalState::setCurLocalVarCreate - Not in a function!");
+
+   Dictionary& frame = getCurrentFrame();
+   currentVariable = frame.getLocalSlot(slot);
+   if (currentVariable)
+      return;
+
+   currentVariable = frame.add(name);
+   frame.setLocalSlot(slot, currentVariable);
+}
+
 //------------------------------------------------------------
 
 S32 ExprEvalState::getIntVariable()
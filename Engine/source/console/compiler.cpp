@@ -60,6 +60,7 @@ namespace Compiler
    CompilerFloatTable  *gCurrentFloatTable, gGlobalFloatTable, gFunctionFloatTable;
    DataChunker          gConsoleAllocator;
    CompilerIdentTable   gIdentTable;
+   CompilerLocalTable   gLocalTable;
 
    //------------------------------------------------------------
 
@@ -102,6 +103,13 @@ namespace Compiler
 
    CompilerIdentTable &getIdentTable() { return gIdentTable; }
 
+   CompilerLocalTable &getLocalTable() { return gLocalTable; }
+
+   bool isSlottedLocal(StringTableEntry varName)
+   {
+      return CodeBlock::smInFunction && varName[0] != '$';
+   }
+
    void precompileIdent(StringTableEntry ident)
    {
       if (ident)
@@ -117,6 +125,7 @@ namespace Compiler
       getFunctionFloatTable().reset();
       getFunctionStringTable().reset();
       getIdentTable().reset();
+      getLocalTable().reset();
    }
 
    void *consoleAlloc(U32 size) { return gConsoleAllocator.alloc(size); }
@@ -245,6 +254,31 @@ void CompilerFloatTable::write(Stream &st)
 
 //------------------------------------------------------------
 
+U32 CompilerLocalTable::add(StringTableEntry name)
+{
+   // Duplicate names keep their first slot but still use up a new one so
+   // argument i always ends up in slot i.
+   slots.insert(std::make_pair(name, count));
+   return count++;
+}
+
+U32 CompilerLocalTable::lookup(StringTableEntry name)
+{
+   auto pos = slots.find(name);
+   if (pos != slots.end())
+      return pos->second;
+
+   return add(name);
+}
+
+void CompilerLocalTable::reset()
+{
+   slots.clear();
+   count = 0;
+}
+
+//------------------------------------------------------------
+
 void CompilerIdentTable::reset()
 {
    list = NULL;
@@ -178,6 +178,22 @@ namespace Compiler
       OP_ITER,             ///< Enter foreach loop.
       OP_ITER_END,         ///< End foreach loop.
 
+      OP_SETCURVAR_LOCAL,        ///< OP_SETCURVAR for a local with a frame slot.
+      OP_SETCURVAR_LOCAL_CREATE, ///< OP_SETCURVAR_CREATE for a local with a frame slot.
+      OP_INC_LOCAL,              ///< OP_INC for a local with a frame slot.
+      OP_DEC_LOCAL,              ///< OP_DEC for a local with a frame slot.
+
+      // Fused instructions.  These are never emitted by the compiler; the
+      // interpreter patches them over OP_SETCURVAR_LOCAL(_CREATE) when it
+      // runs into one directly followed by a load or save.  The load or save
+      // instruction is left in place so the pair can still run unfused.
+      OP_LOADLOCAL_UINT,
+      OP_LOADLOCAL_FLT,
+      OP_LOADLOCAL_STR,
+      OP_SAVELOCAL_UINT,
+      OP_SAVELOCAL_FLT,
+      OP_SAVELOCAL_STR,
+
       OP_INVALID,   // 90
 
       MAX_OP_CODELEN ///< The amount of op codes.
@@ -252,6 +268,29 @@ namespace Compiler
 
    //------------------------------------------------------------
 
+   /// Numbers the local variables of the function being compiled.
+   ///
+   /// Instructions accessing a local inside a function body carry the slot
+   /// of the variable in addition to its name so the VM can cache the
+   /// variable's dictionary entry in the call frame (see
+   /// Dictionary::getLocalSlot()).  The arguments of a function always get
+   /// the first slots in declaration order.
+   struct CompilerLocalTable
+   {
+      U32 count;
+      std::unordered_map<StringTableEntry, U32> slots;
+
+      /// Return a new slot for @a name.
+      U32 add(StringTableEntry name);
+
+      /// Return the slot of @a name, adding it if necessary.
+      U32 lookup(StringTableEntry name);
+
+      void reset();
+   };
+
+   //------------------------------------------------------------
+
    inline StringTableEntry CodeToSTE(U32 *code, U32 ip)
    {
 #ifdef TORQUE_CPU_X64
@@ -280,6 +319,12 @@ namespace Compiler
 
    CompilerIdentTable &getIdentTable();
 
+   CompilerLocalTable &getLocalTable();
+
+   /// Return true if accesses to @a varName should use a frame slot.  This is
+   /// the case for locals referenced in a function body.
+   bool isSlottedLocal(StringTableEntry varName);
+
    void precompileIdent(StringTableEntry ident);
 
    /// Helper function to reset the float, string, and ident tables to a base
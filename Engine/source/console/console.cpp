@@ -40,6 +40,7 @@
 #include <stdarg.h>
 #include "platform/threads/mutex.h"
 #include "core/util/journal/journal.h"
+#include "console/asyncLogWriter.h"
 
 extern StringStack STR;
 extern ConsoleValueStack CSTK;
@@ -245,6 +246,7 @@ static bool consoleLogLocked;
 static bool logBufferEnabled=true;
 static S32 printLevel = 10;
 static FileStream consoleLogFile;
+static AsyncLogWriter *asyncConsoleLogFile = NULL;
 static const char *defLogFileName = "console.log";
 static S32 consoleLogMode = 0;
 static bool active = false;
@@ -333,6 +335,15 @@ void init()
    setVariable("Con::prompt", "% ");
    addVariable("Con::logBufferEnabled", TypeBool, &logBufferEnabled, "If true, the log buffer will be enabled.\n"
       "@ingroup Console\n");
+   addVariable("Con::asyncLog", TypeBool, &AsyncLogWriter::smEnabled, "If true, log files are written in batches on a background thread.  "
+      "Takes effect the next time the console log file or a ConsoleLogger is opened.  Log mode 1 always writes synchronously.\n"
+      "@ingroup Console\n");
+   addVariable("Con::asyncLogFlushInterval", TypeS32, &AsyncLogWriter::smFlushInterval, "The longest time in milliseconds an asynchronously logged line waits before being written.\n"
+      "@ingroup Console\n");
+   addVariable("Con::logRepeatLimit", TypeS32, &AsyncLogWriter::smRepeatLimit, "Number of identical consecutive lines written to an asynchronous log before the rest are collapsed into one notice.  0 disables this.\n"
+      "@ingroup Console\n");
+   addVariable("Con::logJSON", TypeBool, &AsyncLogWriter::smJSON, "If true, asynchronous logs are written as one JSON object per line.\n"
+      "@ingroup Console\n");
    addVariable("Con::printLevel", TypeS32, &printLevel, 
       "@brief This is deprecated.\n\n"
       "It is no longer in use and does nothing.\n"      
@@ -386,6 +397,7 @@ void shutdown()
 
    smConsoleInput.remove(postConsoleInput);
 
+   SAFE_DELETE(asyncConsoleLogFile);
    consoleLogFile.close();
    Namespace::shutdown();
    AbstractClassRep::shutdown();
@@ -534,7 +546,19 @@ U32 tabComplete(char* inputBuffer, U32 cursorPos, U32 maxResultLength, bool forw
 }
 
 //------------------------------------------------------------------------------
-static void log(const char *string)
+static void writeLogLine(U32 level, const char *string)
+{
+   if (asyncConsoleLogFile)
+   {
+      asyncConsoleLogFile->write(level, string);
+      return;
+   }
+
+   consoleLogFile.write(dStrlen(string), string);
+   consoleLogFile.write(2, "\r\n");
+}
+
+static void log(U32 level, const char *string)
 {
    // Bail if we ain't logging.
    if (!consoleLogMode) 
@@ -549,9 +573,10 @@ static void log(const char *string)
    }
 
    // Write to the log if its status is hunky-dory.
-   if ((consoleLogFile.getStatus() == Stream::Ok) || (consoleLogFile.getStatus() == Stream::EOS)) 
+   if (asyncConsoleLogFile || (consoleLogFile.getStatus() == Stream::Ok) || (consoleLogFile.getStatus() == Stream::EOS)) 
    {
-      consoleLogFile.setPosition(consoleLogFile.getStreamSize());
+      if (!asyncConsoleLogFile)
+         consoleLogFile.setPosition(consoleLogFile.getStreamSize());
       // If this is the first write...
       if (newLogFile) 
       {
@@ -559,14 +584,14 @@ static void log(const char *string)
          Platform::LocalTime lt;
          Platform::getLocalTime(lt);
          char buffer[128];
-         dSprintf(buffer, sizeof(buffer), "//-------------------------- %d/%d/%d -- %02d:%02d:%02d -----\r\n",
+         dSprintf(buffer, sizeof(buffer), "//-------------------------- %d/%d/%d -- %02d:%02d:%02d -----",
                lt.month + 1,
                lt.monthday,
                lt.year + 1900,
                lt.hour,
                lt.min,
                lt.sec);
-         consoleLogFile.write(dStrlen(buffer), buffer);
+         writeLogLine(ConsoleLogEntry::Normal, buffer);
          newLogFile = false;
          if (consoleLogMode & 0x4) 
          {
@@ -576,16 +601,12 @@ static void log(const char *string)
             ConsoleLogEntry *log;
             getLockLog(log, size);
             for (line = 0; line < size; line++) 
-            {
-               consoleLogFile.write(dStrlen(log[line].mString), log[line].mString);
-               consoleLogFile.write(2, "\r\n");
-            }
+               writeLogLine(log[line].mLevel, log[line].mString);
             unlockLog();
          }
       }
       // Now write what we came here to write.
-      consoleLogFile.write(dStrlen(string), string);
-      consoleLogFile.write(2, "\r\n");
+      writeLogLine(level, string);
    }
 
    if ((consoleLogMode & 0x3) == 1) 
@@ -639,7 +660,7 @@ static void _printf(ConsoleLogEntry::Level level, ConsoleLogEntry::Type type, co
          if(eofPos)
             *eofPos = 0;
 
-         log(pos);
+         log(level, pos);
          if(logBufferEnabled && !consoleLogLocked)
          {
             ConsoleLogEntry entry;
@@ -1257,7 +1278,8 @@ bool executeFile(const char* fileName, bool noCalls, bool journalScript)
 
    char nameBuffer[512];
    char* script = NULL;
-   U32 version;
+   U32 scriptSize = 0;
+   U32 version, sourceCRC;
 
    Stream *compiledStream = NULL;
    Torque::Time scriptModifiedTime, dsoModifiedTime;
@@ -1313,19 +1335,34 @@ bool executeFile(const char* fileName, bool noCalls, bool journalScript)
    // If we had a DSO, let's check to see if we should be reading from it.
    //MGT: fixed bug with dsos not getting recompiled correctly
    //Note: Using Nathan Martin's version from the forums since its easier to read and understand
-   if (compiled && dsoFile != NULL && (scriptFile == NULL || (dsoModifiedTime >= scriptModifiedTime)))
+   //
+   // A DSO that is older than its script is not necessarily stale: copying
+   // or checking out a tree touches every script.  In that case compare the
+   // checksum of the source stored in the DSO instead of recompiling.
+   if (compiled && dsoFile != NULL)
    { //MGT: end
       compiledStream = FileStream::createAndOpen(nameBuffer, Torque::FS::File::Read);
       if (compiledStream)
       {
          // Check the version!
-         compiledStream->read(&version);
-         if (version != Con::DSOVersion)
+         if (!CodeBlock::readDSOHeader(*compiledStream, version, sourceCRC))
          {
             Con::warnf("exec: Found an old DSO (%s, ver %d < %d), ignoring.", nameBuffer, version, Con::DSOVersion);
             delete compiledStream;
             compiledStream = NULL;
          }
+         else if (scriptFile != NULL && dsoModifiedTime < scriptModifiedTime)
+         {
+            void *data = NULL;
+            Torque::FS::ReadFile(scriptFileName, data, scriptSize, true);
+            script = (char *)data;
+
+            if (script == NULL || CodeBlock::getSourceCRC(script) != sourceCRC)
+            {
+               delete compiledStream;
+               compiledStream = NULL;
+            }
+         }
       }
    }
 
@@ -1338,9 +1375,11 @@ bool executeFile(const char* fileName, bool noCalls, bool journalScript)
       // If we have source but no compiled version, then we need to compile
       // (and journal as we do so, if that's required).
 
-      void *data;
-      U32 dataSize = 0;
-      Torque::FS::ReadFile(scriptFileName, data, dataSize, true);
+      // The source may already have been read to validate the DSO.
+      void *data = script;
+      U32 dataSize = scriptSize;
+      if (data == NULL)
+         Torque::FS::ReadFile(scriptFileName, data, dataSize, true);
 
       if (journal && Journal::IsRecording())
          Journal::Write(bool(data != NULL));
@@ -1384,7 +1423,7 @@ bool executeFile(const char* fileName, bool noCalls, bool journalScript)
          compiledStream = FileStream::createAndOpen(nameBuffer, Torque::FS::File::Read);
          if (compiledStream)
          {
-            compiledStream->read(&version);
+            CodeBlock::readDSOHeader(*compiledStream, version, sourceCRC);
          }
          else
          {
@@ -1672,6 +1711,7 @@ void setLogMode(S32 newMode)
       }
       if ((consoleLogMode & 0x3) == 2) {
          // Changing away from mode 2, must close logfile.
+         SAFE_DELETE(asyncConsoleLogFile);
          consoleLogFile.close();
       }
       else if ((newMode & 0x3) == 2) {
@@ -1681,7 +1721,14 @@ void setLogMode(S32 newMode)
          Platform::debugBreak();
 #endif
          // Starting mode 2, must open logfile.
-         consoleLogFile.open(defLogFileName, Torque::FS::File::Write);
+         if (AsyncLogWriter::smEnabled)
+         {
+            asyncConsoleLogFile = new AsyncLogWriter(defLogFileName, false);
+            if (!asyncConsoleLogFile->isOpen())
+               SAFE_DELETE(asyncConsoleLogFile);
+         }
+         if (!asyncConsoleLogFile)
+            consoleLogFile.open(defLogFileName, Torque::FS::File::Write);
       }
       consoleLogMode = newMode;
    }
@@ -376,7 +376,9 @@ namespace Con
       /// 10/14/14 - jamesu - 47->48 Added opcodes to reduce reliance on strings in function calls
       /// 10/07/17 - JTH - 48->49 Added opcode for function pointers and revamp of interpreter 
       ///                         from switch to function calls.
-      DSOVersion = 49,
+      /// 10/14/26 - 49->50 Added opcodes addressing function locals by frame slot
+      /// 10/14/26 - 50->51 Added the CRC of the script source to the header
+      DSOVersion = 51,
 
       MaxLineLength = 512,  ///< Maximum length of a line of console input.
       MaxDataTypes = 256    ///< Maximum number of registered data types.
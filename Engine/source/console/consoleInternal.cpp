@@ -33,6 +33,7 @@
 #include "core/stream/fileStream.h"
 #include "console/compiler.h"
 #include "console/engineAPI.h"
+#include "platform/platformMemory.h"
 
 //#define DEBUG_SPEW
 
@@ -372,6 +373,18 @@ void Dictionary::remove(Dictionary::Entry *ent)
    hashTable->count--;
 }
 
+void Dictionary::setLocalSlot(U32 slot, Entry* entry)
+{
+   if (slot >= localSlots.size())
+   {
+      const U32 oldSize = localSlots.size();
+      localSlots.setSize(slot + 1);
+      dMemset(localSlots.address() + oldSize, 0, (slot + 1 - oldSize) * sizeof(Entry*));
+   }
+
+   localSlots[slot] = entry;
+}
+
 Dictionary::Dictionary()
    : hashTable(NULL),
 #pragma warning( disable : 4355 )
@@ -416,6 +429,8 @@ Dictionary::~Dictionary()
 
 void Dictionary::reset()
 {
+   localSlots.clear();
+
    if (hashTable && hashTable->owner != this)
    {
       hashTable = NULL;
@@ -561,6 +576,8 @@ void ConsoleValue::setStringValue(const char * value)
       // may as well pad to the next cache line
       U32 newLen = ((stringLen + 1) + 15) & ~15;
 
+      MEMORY_TAG_SCOPE( ScriptStrings );
+
       if (bufferLen == 0)
          sval = (char *)dMalloc(newLen);
       else if (newLen > bufferLen)
@@ -927,6 +944,7 @@ Namespace::Entry::Entry()
    mUsage = NULL;
    mHeader = NULL;
    mNamespace = NULL;
+   mCallCount = 0;
 }
 
 void Namespace::Entry::clear()
@@ -1406,6 +1424,8 @@ ConsoleValueRef Namespace::Entry::execute(S32 argc, ConsoleValueRef *argv, ExprE
 {
    STR.clearFunctionOffset();
 
+   mCallCount++;
+
    if (mType == ConsoleFunctionType)
    {
       if (mFunctionOffset)
@@ -1947,6 +1967,44 @@ void Namespace::relinkPackages()
       activatePackage(mActivePackages[i]);
 }
 
+static S32 QSORT_CALLBACK compareEntryCallCounts(const void* a, const void* b)
+{
+   const Namespace::Entry* entryA = *(const Namespace::Entry**)a;
+   const Namespace::Entry* entryB = *(const Namespace::Entry**)b;
+
+   if (entryA->mCallCount != entryB->mCallCount)
+      return (entryA->mCallCount > entryB->mCallCount ? -1 : 1);
+   return 0;
+}
+
+void Namespace::dumpCallCounts(U32 maxEntries, bool reset)
+{
+   Vector<Entry*> entries;
+   for (Namespace *walk = mNamespaceList; walk; walk = walk->mNext)
+      for (Entry *ent = walk->mEntryList; ent; ent = ent->mNext)
+         if (ent->mCallCount)
+            entries.push_back(ent);
+
+   if (!entries.empty())
+      dQsort(entries.address(), entries.size(), sizeof(Entry*), compareEntryCallCounts);
+
+   Con::printf("Calls      Function");
+   for (U32 i = 0; i < entries.size() && i < maxEntries; i++)
+   {
+      Entry *ent = entries[i];
+      const char *nsName = ent->mNamespace->mName;
+      Con::printf("%-10u %s%s%s%s%s", ent->mCallCount,
+         ent->mPackage ? ent->mPackage : "", ent->mPackage ? ":" : "",
+         nsName ? nsName : "", nsName ? "::" : "", ent->mFunctionName);
+   }
+
+   if (reset)
+   {
+      for (U32 i = 0; i < entries.size(); i++)
+         entries[i]->mCallCount = 0;
+   }
+}
+
 
 DefineEngineFunction(isPackage, bool, (String identifier), ,
    "@brief Returns true if the identifier is the name of a declared package.\n\n"
@@ -2006,3 +2064,13 @@ DefineEngineFunction(getPackageList, const char*, (), ,
 
    return returnBuffer;
 }
+
+DefineEngineFunction(dumpFunctionCallCounts, void, (S32 count, bool reset), (20, false),
+   "@brief Prints the functions that have been called most often.\n\n"
+   "Use this to find the script functions worth optimizing or moving into the engine.\n"
+   "@param count Number of functions to print.\n"
+   "@param reset If true, all call counts are set back to zero afterwards.\n"
+   "@ingroup Debugging\n")
+{
+   Namespace::dumpCallCounts(getMax(count, 0), reset);
+}
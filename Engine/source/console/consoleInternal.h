@@ -134,6 +134,10 @@ public:
       /// @note 0 for functions read from legacy DSOs that have no line number information.
       U32 mFunctionLineNumber;
 
+      /// Number of times the function has been called.  Used to find the hot
+      /// spots of script code; see Namespace::dumpCallCounts().
+      U32 mCallCount;
+
       union CallbackUnion {
          StringCallback mStringCallbackFunc;
          IntCallback mIntCallbackFunc;
@@ -264,6 +268,10 @@ public:
    static void deactivatePackageStack(StringTableEntry name);
    static void dumpClasses(bool dumpScript = true, bool dumpEngine = true);
    static void dumpFunctions(bool dumpScript = true, bool dumpEngine = true);
+
+   /// Print the @a maxEntries most often called functions.
+   /// @param reset If true, set all call counts back to zero afterwards.
+   static void dumpCallCounts(U32 maxEntries, bool reset = false);
    static void printNamespaceEntries(Namespace * g, bool dumpScript = true, bool dumpEngine = true);
    static void unlinkPackages();
    static void relinkPackages();
@@ -420,6 +428,13 @@ public:
    CodeBlock *code;
    U32 ip;
 
+   /// Entries of the function's locals indexed by the slots the compiler
+   /// assigned them (see Compiler::CompilerLocalTable).  Entries are never
+   /// moved or freed until the frame is reset, so the instructions of a
+   /// function body only need to go through the hash table the first time
+   /// they touch a local.
+   Vector< Entry* > localSlots;
+
    Dictionary();
    ~Dictionary();
 
@@ -429,6 +444,14 @@ public:
    void remove(Entry *);
    void reset();
 
+   /// Return the entry cached in local slot @a slot or NULL.
+   Entry* getLocalSlot(U32 slot) const
+   {
+      return (slot < localSlots.size() ? localSlots[slot] : NULL);
+   }
+
+   void setLocalSlot(U32 slot, Entry* entry);
+
    void exportVariables(const char *varString, const char *fileName, bool append);
    void exportVariables(const char *varString, Vector<String> *names, Vector<String> *values);
    void deleteVariables(const char *varString);
@@ -504,6 +527,11 @@ public:
    void setCurVarName(StringTableEntry name);
    void setCurVarNameCreate(StringTableEntry name);
 
+   /// Versions of setCurVarName() and setCurVarNameCreate() for locals of
+   /// the current function that go through the frame's local slot cache.
+   void setCurLocalVar(StringTableEntry name, U32 slot);
+   void setCurLocalVarCreate(StringTableEntry name, U32 slot);
+
    S32 getIntVariable();
    F64 getFloatVariable();
    const char *getStringVariable();
@@ -22,6 +22,7 @@
 #include "console/consoleLogger.h"
 #include "console/consoleTypes.h"
 #include "console/engineAPI.h"
+#include "console/asyncLogWriter.h"
 
 Vector<ConsoleLogger *> ConsoleLogger::mActiveLoggers;
 bool ConsoleLogger::smInitialized = false;
@@ -41,6 +42,7 @@ ConsoleLogger::ConsoleLogger()
    mFilename = NULL;
    mLogging = false;
    mAppend = false;
+   mAsyncWriter = NULL;
 
    mLevel = ConsoleLogEntry::Normal;
 }
@@ -50,6 +52,7 @@ ConsoleLogger::ConsoleLogger()
 ConsoleLogger::ConsoleLogger( const char *fileName, bool append )
 {
    mLogging = false;
+   mAsyncWriter = NULL;
 
    mLevel = ConsoleLogEntry::Normal;
    mFilename = StringTable->insert( fileName );
@@ -144,8 +147,16 @@ bool ConsoleLogger::attach()
    if( mLogging )
       return false;
 
-   // Open the filestream
-   mStream.open( mFilename, ( mAppend ? Torque::FS::File::WriteAppend : Torque::FS::File::Write ) );
+   // Open the filestream, or hand the file to a background writer
+   if( AsyncLogWriter::smEnabled )
+   {
+      mAsyncWriter = new AsyncLogWriter( mFilename, mAppend );
+      if( !mAsyncWriter->isOpen() )
+         SAFE_DELETE( mAsyncWriter );
+   }
+
+   if( !mAsyncWriter )
+      mStream.open( mFilename, ( mAppend ? Torque::FS::File::WriteAppend : Torque::FS::File::Write ) );
 
    // Add this to list of active loggers
    mActiveLoggers.push_back( this );
@@ -172,6 +183,7 @@ bool ConsoleLogger::detach()
       return false;
 
    // Close filestream
+   SAFE_DELETE( mAsyncWriter );
    mStream.close();
 
    // Remove this object from the list of active loggers
@@ -202,13 +214,13 @@ void ConsoleLogger::logCallback( U32 level, const char *consoleLine )
 
       // If the log level is within the log threshhold, log it
       if( curr->mLevel <= level )
-         curr->log( consoleLine );
+         curr->log( level, consoleLine );
    }
 }
 
 //-----------------------------------------------------------------------------
 
-void ConsoleLogger::log( const char *consoleLine )
+void ConsoleLogger::log( U32 level, const char *consoleLine )
 {
    // Check to see if this is intalized before using it
    if( !smInitialized ) 
@@ -220,7 +232,10 @@ void ConsoleLogger::log( const char *consoleLine )
       }
    }
 
-   mStream.writeLine( (U8 *)consoleLine );
+   if( mAsyncWriter )
+      mAsyncWriter->write( level, consoleLine );
+   else
+      mStream.writeLine( (U8 *)consoleLine );
 }
 
 //-----------------------------------------------------------------------------
@@ -33,6 +33,8 @@
    #include "core/stream/fileStream.h"
 #endif
 
+class AsyncLogWriter;
+
 
 /// @ingroup console_system Console System
 /// @{
@@ -50,6 +52,7 @@ class ConsoleLogger : public SimObject
    
       bool mLogging;                   ///< True if it is currently consuming and logging
       FileStream mStream;              ///< File stream this object writes to
+      AsyncLogWriter *mAsyncWriter;    ///< Background writer used instead of mStream when $Con::asyncLog is set
       static bool smInitialized;                ///< This is for use with the default constructor
       bool mAppend;                    ///< If false, it will clear the file before logging to it.
       StringTableEntry mFilename;      ///< The file name to log to.
@@ -58,8 +61,9 @@ class ConsoleLogger : public SimObject
       static Vector<ConsoleLogger *> mActiveLoggers;
 
       /// The log function called by the consumer callback
+      /// @param   level         Log level of the line
       /// @param   consoleLine   Line of text to log
-      void log( const char *consoleLine );
+      void log( U32 level, const char *consoleLine );
 
       /// Utility function, sets up the object (for script interface) returns true if successful
       bool init();
@@ -24,6 +24,9 @@
 // Arcane-FX for MIT Licensed Open Source version of Torque 3D from GarageGames
 // Copyright (C) 2015 Faust Logic, Inc.
 //~~~~~~~~~~~~~~~~~~~~//~~~~~~~~~~~~~~~~~~~~//~~~~~~~~~~~~~~~~~~~~//~~~~~~~~~~~~~~~~~~~~~//
+
+#include <unordered_map>
+
 #include "platform/platform.h"
 #include "console/consoleObject.h"
 
@@ -36,6 +39,8 @@
 #include "console/simObject.h"
 #include "console/engineTypes.h"
 #include "console/engineAPI.h"
+#include "platform/platformMemory.h"
+#include "platform/threads/mutex.h"
 
 #include "sim/netObject.h"
 
@@ -95,25 +100,73 @@ void AbstractClassRep::init()
    }
 }
 
+void AbstractClassRep::_buildFieldIndex() const
+{
+   // Keep the table at most half full.
+   U32 size = 8;
+   while (size < mFieldList.size() * 2)
+      size <<= 1;
+
+   mFieldIndex.setSize(size);
+   for (U32 i = 0; i < size; i++)
+      mFieldIndex[i] = -1;
+
+   const U32 mask = size - 1;
+   for (U32 i = 0; i < mFieldList.size(); i++)
+   {
+      StringTableEntry name = mFieldList[i].pFieldname;
+      U32 slot = _getFieldHash(name) & mask;
+
+      // Keep the first field of a name like the old linear search did.
+      while (mFieldIndex[slot] != -1 && mFieldList[mFieldIndex[slot]].pFieldname != name)
+         slot = (slot + 1) & mask;
+      if (mFieldIndex[slot] == -1)
+         mFieldIndex[slot] = i;
+   }
+
+   mFieldIndexCount = mFieldList.size();
+}
+
 const AbstractClassRep::Field *AbstractClassRep::findField(StringTableEntry name) const
 {
-   for(U32 i = 0; i < mFieldList.size(); i++)
-      if(mFieldList[i].pFieldname == name)
-         return &mFieldList[i];
+   // Field lists are set up once at class registration, so this normally
+   // only happens once per class.
+   if (mFieldIndexCount != mFieldList.size() || mFieldIndex.empty())
+      _buildFieldIndex();
+
+   const U32 mask = mFieldIndex.size() - 1;
+   for (U32 slot = _getFieldHash(name) & mask; mFieldIndex[slot] != -1; slot = (slot + 1) & mask)
+      if (mFieldList[mFieldIndex[slot]].pFieldname == name)
+         return &mFieldList[mFieldIndex[slot]];
 
    return NULL;
 }
 
+/// Class reps by their class name string table entry.  Filled in by
+/// initialize(); function local so registration during static
+/// initialization doesn't depend on construction order.
+static std::unordered_map<StringTableEntry, AbstractClassRep*>& getClassRepsByName()
+{
+   static std::unordered_map<StringTableEntry, AbstractClassRep*> sClassRepsByName;
+   return sClassRepsByName;
+}
+
 AbstractClassRep* AbstractClassRep::findClassRep(const char* in_pClassName)
 {
    AssertFatal(initialized,
       "AbstractClassRep::findClassRep() - Tried to find an AbstractClassRep before AbstractClassRep::initialize().");
 
-   for (AbstractClassRep *walk = classLinkList; walk; walk = walk->nextClass)
-      if (!dStricmp(walk->getClassName(), in_pClassName))
-         return walk;
+   // Class names are case insensitive string table entries, so if the
+   // name isn't in the string table, there is no such class.
+   StringTableEntry className = StringTable->lookup(in_pClassName);
+   if (!className)
+      return NULL;
 
-   return NULL;
+   std::unordered_map<StringTableEntry, AbstractClassRep*>::const_iterator itr = getClassRepsByName().find(className);
+   if (itr == getClassRepsByName().end())
+      return NULL;
+
+   return itr->second;
 }
 
 AbstractClassRep* AbstractClassRep::findClassRep( U32 groupId, U32 typeId, U32 classId )
@@ -147,11 +200,17 @@ void AbstractClassRep::registerClassRep(AbstractClassRep* in_pRep)
 
    in_pRep->nextClass = classLinkList;
    classLinkList = in_pRep;
+
+   // Classes registered at runtime.
+   if (initialized)
+      getClassRepsByName()[in_pRep->mClassName] = in_pRep;
 }
 
 //--------------------------------------
 void AbstractClassRep::removeClassRep(AbstractClassRep* in_pRep)
 {
+   getClassRepsByName().erase(in_pRep->mClassName);
+
    for( AbstractClassRep *walk = classLinkList; walk; walk = walk->nextClass )
    {
       // This is the case that will most likely get hit.
@@ -174,7 +233,10 @@ ConsoleObject* AbstractClassRep::create(const char* in_pClassName)
 
    const AbstractClassRep *rep = AbstractClassRep::findClassRep(in_pClassName);
    if(rep)
+   {
+      MEMORY_TAG_SCOPE( SimObjects );
       return rep->create();
+   }
 
    AssertWarn(0, avar("Couldn't find class rep for dynamic class: %s", in_pClassName));
    return NULL;
@@ -187,11 +249,93 @@ ConsoleObject* AbstractClassRep::create(const U32 groupId, const U32 typeId, con
    if( !classRep )
       return NULL;
 
+   MEMORY_TAG_SCOPE( SimObjects );
    return classRep->create();
 }
 
 //--------------------------------------
 
+// Objects may be created and deleted on other threads, and uncontended
+// locking is cheap next to constructing an object, so all pools share this.
+static Mutex sgObjectPoolMutex;
+
+ConsoleObjectPool::ConsoleObjectPool()
+   :  mObjectSize( 0 ),
+      mFreeList( NULL ),
+      mNumObjects( 0 ),
+      mNumSlabBytes( 0 )
+{
+}
+
+ConsoleObjectPool::~ConsoleObjectPool()
+{
+   // Objects leaked past shutdown keep their memory.
+   if ( mNumObjects )
+      return;
+
+   for ( U32 i = 0; i < mSlabs.size(); i++ )
+      dFree( mSlabs[ i ] );
+}
+
+void* ConsoleObjectPool::allocateObject( U32 size TORQUE_TMM_ARGS_DECL )
+{
+   const U32 objectSize = ( size + 15 ) & ~15;
+   if ( objectSize > MaxObjectSize )
+      return NULL;
+
+   MutexHandle mutex;
+   mutex.lock( &sgObjectPoolMutex, true );
+
+   if ( !mObjectSize )
+      mObjectSize = objectSize;
+   else if ( objectSize != mObjectSize )
+      return NULL;
+
+   if ( !mFreeList )
+   {
+      const U32 numObjects = SlabSize / mObjectSize;
+
+      #ifdef TORQUE_DISABLE_MEMORY_MANAGER
+         U8* slab = ( U8* ) dMalloc( numObjects * mObjectSize );
+      #else
+         U8* slab = ( U8* ) dMalloc_r( numObjects * mObjectSize TORQUE_TMM_ARGS );
+      #endif
+      if ( !slab )
+         return NULL;
+
+      mSlabs.push_back( slab );
+      mNumSlabBytes += numObjects * mObjectSize;
+
+      // Thread the new objects onto the free list in address order.
+      for ( S32 i = numObjects - 1; i >= 0; i-- )
+      {
+         void* ptr = slab + i * mObjectSize;
+         *reinterpret_cast< void** >( ptr ) = mFreeList;
+         mFreeList = ptr;
+      }
+   }
+
+   void* ptr = mFreeList;
+   mFreeList = *reinterpret_cast< void** >( ptr );
+   mNumObjects++;
+
+   return ptr;
+}
+
+void ConsoleObjectPool::freeObject( void* ptr )
+{
+   MutexHandle mutex;
+   mutex.lock( &sgObjectPoolMutex, true );
+
+   AssertFatal( mNumObjects, "ConsoleObjectPool::freeObject - Pool has no objects allocated!" );
+
+   *reinterpret_cast< void** >( ptr ) = mFreeList;
+   mFreeList = ptr;
+   mNumObjects--;
+}
+
+//--------------------------------------
+
 static S32 QSORT_CALLBACK ACRCompare(const void *aptr, const void *bptr)
 {
    const AbstractClassRep *a = *((const AbstractClassRep **) aptr);
@@ -212,6 +356,8 @@ void AbstractClassRep::initialize()
    // Initialize namespace references...
    for (walk = classLinkList; walk; walk = walk->nextClass)
    {
+      getClassRepsByName()[walk->mClassName] = walk;
+
       walk->mNamespace = Con::lookupNamespace(StringTable->insert(walk->getClassName()));
       walk->mNamespace->mUsage = walk->getDocString();
       walk->mNamespace->mClassRep = walk;
@@ -232,6 +378,10 @@ void AbstractClassRep::initialize()
 
       // And of course delete it every round.
       sg_tempFieldList.clear();
+
+      // Build the lookup index up front rather than on first use, which
+      // might be on another thread.
+      walk->_buildFieldIndex();
    }
 
    // Calculate counts and bit sizes for the various NetClasses.
@@ -291,6 +441,8 @@ void AbstractClassRep::shutdown()
          if( classTable[ group ][ type ] )
             SAFE_DELETE_ARRAY( classTable[ group ][ type ] );
 
+   getClassRepsByName().clear();
+
    initialized = false;
 }
 
@@ -899,7 +1051,11 @@ DefineEngineFunction( dumpNetStats, void, (),,
    "@brief Dumps network statistics for each class to the console.\n\n"
 
    "The returned <i>avg</i>, <i>min</i> and <i>max</i> values are in bits sent per update.  "
-   "The <i>num</i> value is the total number of events collected.\n"
+   "The <i>num</i> value is the total number of events collected.  The bits sent in ghost "
+   "updates are also broken down by the kind of BitStream write (flags, ints, floats, "
+   "compressed points, vectors, rotations, strings and raw data) that produced them, which "
+   "shows which encodings are worth tightening for each class.  All statistics are reset "
+   "after dumping.\n"
 
    "@note This method only works when TORQUE_NET_STATS is defined in torqueConfig.h.\n"
    "@ingroup Networking\n" )
@@ -953,12 +1109,70 @@ DefineEngineFunction( dumpNetStats, void, (),,
                   i+24,rep->mDirtyMaskFrequency[i+24],avg24);
             }
          }
+
+         if (rep->mNetStatPack.total)
+         {
+            Con::printf("   packUpdate bits by kind of write:");
+            for (S32 i=0; i<BitStream::NetStatCategoryCount; i++)
+               if (rep->mNetStatCategoryBits[i])
+                  Con::printf("      %-10s %8i (%5.1f%%)", BitStream::getNetStatCategoryName(i),
+                     rep->mNetStatCategoryBits[i],
+                     100.0f * F32(rep->mNetStatCategoryBits[i]) / F32(rep->mNetStatPack.total));
+         }
       }
       rep->resetNetStats();
    }
 #endif
 }
 
+static S32 QSORT_CALLBACK ACRPoolBytesCompare(const void *aptr, const void *bptr)
+{
+   const AbstractClassRep *a = *((const AbstractClassRep **) aptr);
+   const AbstractClassRep *b = *((const AbstractClassRep **) bptr);
+
+   return S32( b->getObjectPool()->getNumSlabBytes() ) - S32( a->getObjectPool()->getNumSlabBytes() );
+}
+
+DefineEngineFunction( dumpClassMemoryUsage, void, (),,
+   "@brief Dumps the memory held by the object pool of each class to the console.\n\n"
+
+   "Objects created from script or over the network are allocated from a pool per "
+   "class.  For every class that has pooled objects, this prints the size of an "
+   "instance, the number of live instances, the bytes those take up and the bytes "
+   "held by the pool, sorted by the latter.\n"
+
+   "@note Objects created with new from C++ do not come from the pools and are not counted.\n"
+   "@ingroup Debugging\n" )
+{
+   Vector< AbstractClassRep* > classes;
+   for ( AbstractClassRep* rep = AbstractClassRep::getClassList(); rep; rep = rep->getNextClass() )
+   {
+      if ( rep->getObjectPool()->getNumSlabBytes() )
+         classes.push_back( rep );
+   }
+
+   if ( !classes.empty() )
+      dQsort( classes.address(), classes.size(), sizeof( AbstractClassRep* ), ACRPoolBytesCompare );
+
+   U32 totalLiveBytes = 0;
+   U32 totalSlabBytes = 0;
+
+   Con::printf( "%-32s %8s %10s %12s %12s", "Class", "Sizeof", "Objects", "Live KB", "Pool KB" );
+   for ( U32 i = 0; i < classes.size(); i++ )
+   {
+      const ConsoleObjectPool* pool = classes[ i ]->getObjectPool();
+      const U32 liveBytes = pool->getNumObjects() * classes[ i ]->getSizeof();
+
+      Con::printf( "%-32s %8d %10d %12d %12d", classes[ i ]->getClassName(), classes[ i ]->getSizeof(),
+         pool->getNumObjects(), liveBytes / 1024, pool->getNumSlabBytes() / 1024 );
+
+      totalLiveBytes += liveBytes;
+      totalSlabBytes += pool->getNumSlabBytes();
+   }
+
+   Con::printf( "%-32s %8s %10s %12d %12d", "Total", "", "", totalLiveBytes / 1024, totalSlabBytes / 1024 );
+}
+
 DefineEngineFunction( sizeof, S32, ( const char *objectOrClass ),,
             "@brief Determines the memory consumption of a class or object.\n\n"
             "@param objectOrClass The object or class being measured.\n"
@@ -54,6 +54,9 @@
 #ifndef TINYXML_INCLUDED
    #include "tinyxml.h"
 #endif
+#if defined( TORQUE_NET_STATS ) && !defined( _BITSTREAM_H_ )
+   #include "core/stream/bitStream.h"
+#endif
 
 /// @file
 /// Legacy console object system.
@@ -199,6 +202,53 @@ DECLARE_SCOPE( ConsoleAPI );
 ///        bit allocations for network ID fields.
 ///
 /// @nosubgrouping
+/// Pool that the instances of a single class are allocated from when they
+/// are created through AbstractClassRep::create().
+///
+/// Objects are carved out of larger slabs so that the many instances of a
+/// class that a mission loads sit next to each other instead of being
+/// scattered over the heap.  Memory of deleted objects is kept for the
+/// next instance of the class.
+class ConsoleObjectPool : public IEngineObjectPool
+{
+   public:
+
+      enum
+      {
+         /// Objects larger than this are left to the default pool.
+         MaxObjectSize = 4096,
+
+         /// Size of a slab of objects in bytes.
+         SlabSize = 32 * 1024,
+      };
+
+      ConsoleObjectPool();
+      virtual ~ConsoleObjectPool();
+
+      /// Return the number of objects currently allocated from the pool.
+      U32 getNumObjects() const { return mNumObjects; }
+
+      /// Return the number of bytes held in slabs, used or not.
+      U32 getNumSlabBytes() const { return mNumSlabBytes; }
+
+      // IEngineObjectPool
+      virtual void* allocateObject( U32 size TORQUE_TMM_ARGS_DECL );
+      virtual void freeObject( void* ptr );
+
+   protected:
+
+      /// Size of the objects in the pool rounded up to 16 bytes.
+      U32 mObjectSize;
+
+      /// Linked list of unused objects threaded through their memory.
+      void* mFreeList;
+
+      U32 mNumObjects;
+      U32 mNumSlabBytes;
+
+      Vector< void* > mSlabs;
+};
+
 class AbstractClassRep : public ConsoleBaseType
 {
    friend class ConsoleObject;
@@ -220,7 +270,9 @@ public:
       : Parent( sizeof( void* ), conIdPtr, typeName )
    {
       VECTOR_SET_ASSOCIATION( mFieldList );
+      VECTOR_SET_ASSOCIATION( mFieldIndex );
 
+      mFieldIndexCount = 0;
       parentClass  = NULL;
       mIsRenderEnabled = true;
       mIsSelectionEnabled = true;
@@ -277,6 +329,9 @@ public:
    U32 mDirtyMaskFrequency[32];
    U32 mDirtyMaskTotal[32];
 
+   /// Bits of packUpdate() output by BitStream::NetStatCategory.
+   U32 mNetStatCategoryBits[BitStream::NetStatCategoryCount];
+
    void resetNetStats()
    {
       mNetStatPack.reset();
@@ -289,6 +344,9 @@ public:
          mDirtyMaskFrequency[i] = 0;
          mDirtyMaskTotal[i] = 0;
       }
+
+      for(S32 i=0; i<BitStream::NetStatCategoryCount; i++)
+         mNetStatCategoryBits[i] = 0;
    }
 
    void updateNetStatPack(U32 dirtyMask, U32 length)
@@ -337,6 +395,9 @@ public:
    /// Return the size of instances of this class in bytes.
    S32 getSizeof() const { return mClassSizeof; }
 
+   /// Return the pool that instances made by create() are allocated from.
+   ConsoleObjectPool* getObjectPool() const { return &mObjectPool; }
+
    /// Return the next class in the global class list link chain.
    AbstractClassRep* getNextClass() const { return nextClass; }
 
@@ -399,6 +460,8 @@ protected:
    AbstractClassRep * parentClass;
    Namespace *        mNamespace;
 
+   mutable ConsoleObjectPool mObjectPool;
+
    /// @}
 
 public:
@@ -530,6 +593,25 @@ public:
 
    const Field* findField( StringTableEntry fieldName ) const;
 
+protected:
+
+   /// Open-addressed hash over #mFieldList used by findField().  Holds
+   /// indices into the list or -1 for empty slots.
+   mutable Vector< S32 > mFieldIndex;
+
+   /// Size of #mFieldList when #mFieldIndex was built.
+   mutable U32 mFieldIndexCount;
+
+   void _buildFieldIndex() const;
+
+   static U32 _getFieldHash( StringTableEntry fieldName )
+   {
+      U32 hash = U32( uintptr_t( fieldName ) >> 2 ) * 2654435761u;
+      return hash ^ ( hash >> 16 );
+   }
+
+public:
+
    /// @}
 
    /// @name Console Type Interface
@@ -709,8 +791,16 @@ public:
     {
     }
  
+   #include "platform/tmm_off.h"
+
    /// Wrap constructor.
-   ConsoleObject* create() const { return new T; }
+   ConsoleObject* create() const
+   {
+      void* ptr = EngineObject::operator new( sizeof( T ), static_cast< IEngineObjectPool* >( this->getObjectPool() ) TORQUE_TMM_LOC );
+      return new ( ptr ) T;
+   }
+
+   #include "platform/tmm_on.h"
 };
 
 template< typename T > EnginePropertyTable ConcreteAbstractClassRep< T >::_smPropertyTable(0, NULL);
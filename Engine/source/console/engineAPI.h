@@ -276,6 +276,67 @@ struct EngineUnmarshallData< U8 >
    }
 };
 template<>
+struct EngineUnmarshallData< S16 >
+{
+   S16 operator()( ConsoleValueRef &ref ) const
+   {
+      return (S16)((S32)ref);
+   }
+
+   S16 operator()( const char* str ) const
+   {
+      return dAtoi( str );
+   }
+};
+template<>
+struct EngineUnmarshallData< U16 >
+{
+   U16 operator()( ConsoleValueRef &ref ) const
+   {
+      return (U16)((S32)ref);
+   }
+
+   U16 operator()( const char* str ) const
+   {
+      return dAtoui( str );
+   }
+};
+template<>
+struct EngineUnmarshallData< F64 >
+{
+   F64 operator()( ConsoleValueRef &ref ) const
+   {
+      // Strings are parsed again as the value cached with them is only an F32.
+      if( ref.isInt() || ref.isFloat() )
+         return (F32)ref;
+      return dAtod( ref.getStringValue() );
+   }
+
+   F64 operator()( const char* str ) const
+   {
+      return dAtod( str );
+   }
+};
+template<>
+struct EngineUnmarshallData< bool >
+{
+   bool operator()( ConsoleValueRef &ref ) const
+   {
+      // Same result as dAtob() on the string form without going through
+      // the console type system or formatting numbers.
+      if( ref.isInt() )
+         return ( ref.getIntValue() != 0 );
+      else if( ref.isFloat() )
+         return ( ref.getFloatValue() != 0.0f );
+      return dAtob( ref.getStringValue() );
+   }
+
+   bool operator()( const char* str ) const
+   {
+      return dAtob( str );
+   }
+};
+template<>
 struct EngineUnmarshallData< const char* >
 {
    const char* operator()( ConsoleValueRef &ref ) const
@@ -293,6 +354,9 @@ struct EngineUnmarshallData< T* >
 {
    T* operator()( ConsoleValueRef &ref ) const
    {
+      // Object IDs passed as numbers don't need a round-trip through a string.
+      if( ref.isInt() )
+         return dynamic_cast< T* >( Sim::findObject( SimObjectId( ref.getIntValue() ) ) );
       return dynamic_cast< T* >( Sim::findObject( ref.getStringValue() ) );
    }
 
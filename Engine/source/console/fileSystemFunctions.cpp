@@ -579,6 +579,8 @@ DefineEngineFunction(fileDelete, bool, ( const char* path ),,
    Con::expandScriptFilename( fileName, sizeof( fileName ), path );
    Platform::makeFullPathName(fileName, sandboxFileName, sizeof(sandboxFileName));
 
+   // The file is deleted behind the volume system's back.
+   Torque::FS::ClearAttributeCache();
    return dFileDelete(sandboxFileName);
 }
 
@@ -798,6 +800,7 @@ DefineEngineFunction( pathCopy, bool, ( const char* fromFile, const char* toFile
    Platform::makeFullPathName( fromFile, qualifiedFromFile, sizeof( qualifiedFromFile ) );
    Platform::makeFullPathName( toFile, qualifiedToFile, sizeof( qualifiedToFile ) );
 
+   Torque::FS::ClearAttributeCache();
    return dPathCopy( qualifiedFromFile, qualifiedToFile, noOverwrite );
 }
 
@@ -842,6 +845,7 @@ DefineEngineFunction( createPath, bool, ( const char* path ),,
 
    Con::expandScriptFilename( pathName, sizeof( pathName ), path );
 
+   Torque::FS::ClearAttributeCache();
    return Platform::createPath( pathName );
 }
 
@@ -56,6 +56,10 @@ PersistenceManager::PersistenceManager()
    mCurrentObject = NULL;
    mCurrentFile = NULL;
 
+   mCacheFileData = true;
+   mCachedFile = NULL;
+   mCachedSize = 0;
+
    VECTOR_SET_ASSOCIATION(mLineBuffer);
 
    mLineBuffer.reserve(2048);
@@ -64,6 +68,18 @@ PersistenceManager::PersistenceManager()
 PersistenceManager::~PersistenceManager()
 {
    mDirtyObjects.clear();
+
+   clearCachedFileData();
+}
+
+void PersistenceManager::initPersistFields()
+{
+   addField( "cacheFileData", TypeBool, Offset( mCacheFileData, PersistenceManager ),
+      "Keep the parsed contents of the last file saved so the next save to it only "
+      "has to update the dirty objects instead of reading and parsing it again.  "
+      "The cache is dropped if the file changes on disk." );
+
+   Parent::initPersistFields();
 }
 
 bool PersistenceManager::onAdd()
@@ -152,6 +168,75 @@ void PersistenceManager::clearFileData()
    mParser.clear();
 }
 
+void PersistenceManager::cacheFileData()
+{
+   clearCachedFileData();
+
+   Torque::FS::FileNode::Attributes attribs;
+   if ( !mCurrentFile || !Torque::FS::GetFileAttributes( mCurrentFile, &attribs ) )
+      return;
+
+   mCachedFile = mCurrentFile;
+   mCurrentFile = NULL;
+   mCachedModTime = attribs.mtime;
+   mCachedSize = attribs.size;
+
+   // Take over the buffers so clearFileData() leaves them alone
+   mCachedLineBuffer = mLineBuffer;
+   mLineBuffer.clear();
+   mCachedObjectBuffer = mObjectBuffer;
+   mObjectBuffer.clear();
+}
+
+bool PersistenceManager::restoreCachedFileData(const char* fileName)
+{
+   if ( !mCachedFile || dStricmp( mCachedFile, fileName ) != 0 )
+      return false;
+
+   // Only trust the cache if nobody changed the file since we saved it
+   Torque::FS::FileNode::Attributes attribs;
+   if ( !Torque::FS::GetFileAttributes( fileName, &attribs ) ||
+        attribs.mtime != mCachedModTime ||
+        attribs.size != mCachedSize )
+   {
+      clearCachedFileData();
+      return false;
+   }
+
+   clearFileData();
+
+   mCurrentFile = mCachedFile;
+   mCachedFile = NULL;
+
+   mLineBuffer = mCachedLineBuffer;
+   mCachedLineBuffer.clear();
+   mObjectBuffer = mCachedObjectBuffer;
+   mCachedObjectBuffer.clear();
+
+   // Start out like a freshly parsed file
+   for ( U32 i = 0; i < mObjectBuffer.size(); i++ )
+      mObjectBuffer[i]->updated = false;
+
+   return true;
+}
+
+void PersistenceManager::clearCachedFileData()
+{
+   if ( mCachedFile )
+   {
+      dFree( mCachedFile );
+      mCachedFile = NULL;
+   }
+
+   for ( U32 i = 0; i < mCachedLineBuffer.size(); i++ )
+      dFree( mCachedLineBuffer[i] );
+   mCachedLineBuffer.clear();
+
+   for ( U32 i = 0; i < mCachedObjectBuffer.size(); i++ )
+      deleteObject( mCachedObjectBuffer[i] );
+   mCachedObjectBuffer.clear();
+}
+
 void PersistenceManager::clearAll()
 {
    // Clear the file data in case it hasn't cleared yet
@@ -193,14 +278,16 @@ bool PersistenceManager::readFile(const char* fileName)
    // The file is good so read it in
    mCurrentFile = dStrdup(fileName);
 
+   // Lines are always replaced as a whole so only
+   // allocate what each of them actually needs
+   U8 buffer[2048];
    while(stream.getStatus() != Stream::EOS)
    {
-      U8* buffer = ( U8* ) dMalloc( 2048 );
-      dMemset(buffer, 0, 2048);
+      dMemset(buffer, 0, sizeof(buffer));
 
-      stream.readLine(buffer, 2048);
+      stream.readLine(buffer, sizeof(buffer));
 
-      mLineBuffer.push_back((const char*)buffer);
+      mLineBuffer.push_back(dStrdup((const char*)buffer));
    }
 
    // Because of the way that writeLine() works we need to
@@ -567,6 +654,10 @@ void PersistenceManager::parseObject()
 
 bool PersistenceManager::parseFile(const char* fileName)
 {
+   // Reuse what we had when we last saved the file
+   if (mCacheFileData && restoreCachedFileData(fileName))
+      return true;
+
    // Read the file into the line buffer
    if (!readFile(fileName))
       return false;
@@ -1755,7 +1846,10 @@ bool PersistenceManager::saveDirtyFile()
    //   }
    //}
 
-   // Clear our file data
+   // Keep our file data for the next save or clear it
+   if (mCacheFileData)
+      cacheFileData();
+
    clearFileData();
 
    return true;
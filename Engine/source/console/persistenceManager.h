@@ -35,6 +35,10 @@
 #include "core/tokenizer.h"
 #endif
 
+#ifndef _TIMECLASS_H_
+#include "core/util/timeClass.h"
+#endif
+
 class PersistenceManager : public SimObject
 {
 public:
@@ -183,6 +187,18 @@ protected:
    // Name of the currently open file
    const char*             mCurrentFile;
 
+   // Keep the parsed data of the last file saved so that the
+   // next save to it only has to update the dirty objects
+   bool                    mCacheFileData;
+
+   // The parsed data of the last file saved along with its
+   // modified time and size so we know if it changed on disk
+   const char*             mCachedFile;
+   Vector<const char*>     mCachedLineBuffer;
+   Vector<ParsedObject*>   mCachedObjectBuffer;
+   Torque::Time            mCachedModTime;
+   U64                     mCachedSize;
+
    // Sort by filename
    static S32 QSORT_CALLBACK compareFiles(const void* a, const void* b);
 
@@ -199,6 +215,14 @@ protected:
    // currently loaded file
    void clearFileData();
 
+   // Moves the data of the file just saved into the cache
+   void cacheFileData();
+   // Makes the cached data current if it is for this file
+   // and the file wasn't changed since we saved it
+   bool restoreCachedFileData(const char* fileName);
+   // Deletes the cached file data
+   void clearCachedFileData();
+
    // Updates the changed values of a dirty object
    // Also handles a new object
    void updateObject(SimObject* object, ParsedObject* parentObject = NULL);
@@ -283,6 +307,8 @@ public:
    bool onAdd();
    void onRemove();
 
+   static void initPersistFields();
+
    // Adds an object to the dirty list
    // Optionally changes the object's filename
    bool setDirty(SimObject* object, const char* fileName = NULL);
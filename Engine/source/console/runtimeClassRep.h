@@ -128,6 +128,8 @@ public:
       // And of course delete it every round.
       sg_tempFieldList.clear();
 
+      _buildFieldIndex();
+
       smConRegistered = true;
    }
 
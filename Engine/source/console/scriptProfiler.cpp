@@ -0,0 +1,412 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "console/scriptProfiler.h"
+
+#include "console/consoleInternal.h"
+#include "console/engineAPI.h"
+#include "core/stream/fileStream.h"
+
+#if defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 )
+   #ifdef TORQUE_COMPILER_VISUALC
+      #include <intrin.h>
+   #else
+      #include <x86intrin.h>
+   #endif
+#endif
+
+
+bool ScriptProfiler::smRunning = false;
+U32 ScriptProfiler::smSession = 0;
+Vector< ScriptProfiler::Node > ScriptProfiler::smNodes;
+Vector< ScriptProfiler::Frame > ScriptProfiler::smStack;
+U64 ScriptProfiler::smRunStartTime = 0;
+U32 ScriptProfiler::smRunStartMs = 0;
+U64 ScriptProfiler::smCapturedTicks = 0;
+U32 ScriptProfiler::smCapturedMs = 0;
+
+
+//-----------------------------------------------------------------------------
+
+U64 ScriptProfiler::getTimestamp()
+{
+#if defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 )
+   return __rdtsc();
+#else
+   return U64( Platform::getRealMilliseconds() ) * 1000;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+F64 ScriptProfiler::_getTicksPerUs()
+{
+   // Calibrate timestamps against the wall clock over the capture.
+
+   U64 ticks = smCapturedTicks;
+   U32 ms = smCapturedMs;
+   if( smRunning )
+   {
+      ticks += getTimestamp() - smRunStartTime;
+      ms += Platform::getRealMilliseconds() - smRunStartMs;
+   }
+
+   if( !ticks || !ms )
+      return 1.0;
+
+   return F64( ticks ) / ( F64( ms ) * 1000.0 );
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::enable( bool enable )
+{
+   if( enable == smRunning )
+      return;
+
+   if( enable )
+   {
+      if( smNodes.empty() )
+         reset();
+
+      smRunStartTime = getTimestamp();
+      smRunStartMs = Platform::getRealMilliseconds();
+      smRunning = true;
+   }
+   else
+   {
+      _closeFrames();
+
+      smCapturedTicks += getTimestamp() - smRunStartTime;
+      smCapturedMs += Platform::getRealMilliseconds() - smRunStartMs;
+      smRunning = false;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::reset()
+{
+   smStack.clear();
+   smSession = getMax( smSession + 1, 1U );
+
+   smNodes.setSize( 1 );
+   Node& root = smNodes[ 0 ];
+   root.mNamespace = NULL;
+   root.mFunction = NULL;
+   root.mPackage = NULL;
+   root.mParent = -1;
+   root.mFirstChild = -1;
+   root.mNextSibling = -1;
+   root.mCallCount = 0;
+   root.mInclusiveTicks = 0;
+   root.mChildTicks = 0;
+
+   smCapturedTicks = 0;
+   smCapturedMs = 0;
+   smRunStartTime = getTimestamp();
+   smRunStartMs = Platform::getRealMilliseconds();
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::_closeFrames()
+{
+   const U64 now = getTimestamp();
+   while( !smStack.empty() )
+   {
+      const Frame& frame = smStack.last();
+      const U64 elapsed = now - frame.mStartTime;
+
+      Node& node = smNodes[ frame.mNode ];
+      node.mInclusiveTicks += elapsed;
+      smNodes[ node.mParent ].mChildTicks += elapsed;
+
+      smStack.pop_back();
+   }
+
+   smSession = getMax( smSession + 1, 1U );
+}
+
+//-----------------------------------------------------------------------------
+
+S32 ScriptProfiler::_findChild( S32 parent, Namespace* ns, StringTableEntry function, StringTableEntry package )
+{
+   StringTableEntry nsName = ( ns ? ns->mName : NULL );
+
+   S32 prev = -1;
+   for( S32 i = smNodes[ parent ].mFirstChild; i != -1; i = smNodes[ i ].mNextSibling )
+   {
+      const Node& node = smNodes[ i ];
+      if( node.mFunction == function && node.mNamespace == nsName && node.mPackage == package )
+      {
+         // Move the child to the front so hot calls are found first.
+         if( prev != -1 )
+         {
+            smNodes[ prev ].mNextSibling = node.mNextSibling;
+            smNodes[ i ].mNextSibling = smNodes[ parent ].mFirstChild;
+            smNodes[ parent ].mFirstChild = i;
+         }
+         return i;
+      }
+      prev = i;
+   }
+
+   Node node;
+   node.mNamespace = nsName;
+   node.mFunction = function;
+   node.mPackage = package;
+   node.mParent = parent;
+   node.mFirstChild = -1;
+   node.mNextSibling = smNodes[ parent ].mFirstChild;
+   node.mCallCount = 0;
+   node.mInclusiveTicks = 0;
+   node.mChildTicks = 0;
+
+   // Growing the vector invalidates references, so only index from here.
+   smNodes.push_back( node );
+   const S32 index = smNodes.size() - 1;
+   smNodes[ parent ].mFirstChild = index;
+
+   return index;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 ScriptProfiler::enterFunction( Namespace* ns, StringTableEntry function, StringTableEntry package )
+{
+   if( !smRunning )
+      return 0;
+
+   const S32 parent = ( smStack.empty() ? 0 : smStack.last().mNode );
+   const S32 index = _findChild( parent, ns, function, package );
+   smNodes[ index ].mCallCount ++;
+
+   Frame frame;
+   frame.mNode = index;
+   frame.mStartTime = getTimestamp();
+   smStack.push_back( frame );
+
+   return smSession;
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::exitFunction( U32 session )
+{
+   if( session != smSession || smStack.empty() )
+      return;
+
+   const Frame& frame = smStack.last();
+   const U64 elapsed = getTimestamp() - frame.mStartTime;
+
+   Node& node = smNodes[ frame.mNode ];
+   node.mInclusiveTicks += elapsed;
+   smNodes[ node.mParent ].mChildTicks += elapsed;
+
+   smStack.pop_back();
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::getFunctionStats( Vector< FunctionStats >& outStats )
+{
+   outStats.clear();
+
+   const F64 ticksPerUs = _getTicksPerUs();
+
+   for( U32 i = 1; i < smNodes.size(); ++ i )
+   {
+      const Node& node = smNodes[ i ];
+
+      FunctionStats* stats = NULL;
+      for( U32 n = 0; n < outStats.size(); ++ n )
+         if( outStats[ n ].mFunction == node.mFunction &&
+             outStats[ n ].mNamespace == node.mNamespace &&
+             outStats[ n ].mPackage == node.mPackage )
+         {
+            stats = &outStats[ n ];
+            break;
+         }
+
+      if( !stats )
+      {
+         outStats.increment();
+         stats = &outStats.last();
+         stats->mNamespace = node.mNamespace;
+         stats->mFunction = node.mFunction;
+         stats->mPackage = node.mPackage;
+         stats->mCallCount = 0;
+         stats->mInclusiveUs = 0.0;
+         stats->mExclusiveUs = 0.0;
+      }
+
+      stats->mCallCount += node.mCallCount;
+      stats->mExclusiveUs += F64( node.mInclusiveTicks - node.mChildTicks ) / ticksPerUs;
+
+      // Don't count time of recursive calls twice.
+      bool isRecursive = false;
+      for( S32 parent = node.mParent; parent > 0; parent = smNodes[ parent ].mParent )
+         if( smNodes[ parent ].isSameFunction( node ) )
+         {
+            isRecursive = true;
+            break;
+         }
+
+      if( !isRecursive )
+         stats->mInclusiveUs += F64( node.mInclusiveTicks ) / ticksPerUs;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+static S32 QSORT_CALLBACK _compareExclusiveTime( const ScriptProfiler::FunctionStats* a, const ScriptProfiler::FunctionStats* b )
+{
+   if( a->mExclusiveUs == b->mExclusiveUs )
+      return 0;
+   return ( a->mExclusiveUs > b->mExclusiveUs ? -1 : 1 );
+}
+
+void ScriptProfiler::_writeName( char* buffer, U32 bufferSize, StringTableEntry ns, StringTableEntry function, StringTableEntry package )
+{
+   dSprintf( buffer, bufferSize, "%s%s%s%s%s%s",
+      package ? "[" : "", package ? package : "", package ? "]" : "",
+      ns ? ns : "", ns ? "::" : "", function ? function : "" );
+}
+
+void ScriptProfiler::dump( U32 maxEntries )
+{
+   Vector< FunctionStats > stats;
+   getFunctionStats( stats );
+   stats.sort( _compareExclusiveTime );
+
+   U32 ms = smCapturedMs;
+   if( smRunning )
+      ms += Platform::getRealMilliseconds() - smRunStartMs;
+
+   Con::printf( "Script profile over %.2f seconds:", F32( ms ) / 1000.0f );
+   Con::printf( "  Excl ms    Incl ms      Calls  Function" );
+
+   for( U32 i = 0; i < stats.size() && i < maxEntries; ++ i )
+   {
+      const FunctionStats& entry = stats[ i ];
+
+      char name[ 256 ];
+      _writeName( name, sizeof( name ), entry.mNamespace, entry.mFunction, entry.mPackage );
+
+      Con::printf( "%9.3f  %9.3f  %9u  %s",
+         entry.mExclusiveUs / 1000.0, entry.mInclusiveUs / 1000.0, entry.mCallCount, name );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+bool ScriptProfiler::dumpToFile( const char* fileName )
+{
+   if( smNodes.size() <= 1 )
+   {
+      Con::errorf( "ScriptProfiler::dumpToFile - Nothing has been recorded" );
+      return false;
+   }
+
+   FileStream stream;
+   if( !stream.open( fileName, Torque::FS::File::Write ) )
+   {
+      Con::errorf( "ScriptProfiler::dumpToFile - Could not open '%s' for writing", fileName );
+      return false;
+   }
+
+   const F64 ticksPerUs = _getTicksPerUs();
+
+   Vector< S32 > path;
+   char name[ 256 ];
+
+   for( U32 i = 1; i < smNodes.size(); ++ i )
+   {
+      const Node& node = smNodes[ i ];
+      const U64 exclusiveUs = U64( F64( node.mInclusiveTicks - node.mChildTicks ) / ticksPerUs );
+      if( !exclusiveUs )
+         continue;
+
+      path.clear();
+      for( S32 n = i; n > 0; n = smNodes[ n ].mParent )
+         path.push_back( n );
+
+      // Root first, separated by semicolons.
+      for( S32 n = path.size() - 1; n >= 0; -- n )
+      {
+         const Node& pathNode = smNodes[ path[ n ] ];
+         _writeName( name, sizeof( name ), pathNode.mNamespace, pathNode.mFunction, pathNode.mPackage );
+         stream.write( dStrlen( name ), name );
+         if( n > 0 )
+            stream.write( U8( ';' ) );
+      }
+
+      dSprintf( name, sizeof( name ), " %llu\n", exclusiveUs );
+      stream.write( dStrlen( name ), name );
+   }
+
+   stream.close();
+   return true;
+}
+
+//=============================================================================
+//    Console Functions.
+//=============================================================================
+// MARK: ---- Console Functions ----
+
+DefineEngineFunction( scriptProfilerEnable, void, ( bool enable ),,
+            "@brief Start or stop recording the time spent in script functions.\n\n"
+            "Recorded data is kept when stopping; enabling again adds to it.\n"
+            "@see scriptProfilerDump\n"
+            "@see scriptProfilerReset\n"
+            "@ingroup Debugging" )
+{
+   ScriptProfiler::enable( enable );
+}
+
+DefineEngineFunction( scriptProfilerReset, void, (),,
+            "@brief Discard all data recorded by the script profiler.\n\n"
+            "@ingroup Debugging" )
+{
+   ScriptProfiler::reset();
+}
+
+DefineEngineFunction( scriptProfilerDump, void, ( S32 maxEntries ), ( 50 ),
+            "@brief Print the script functions with the most time spent in their own code.\n\n"
+            "@param maxEntries Number of functions to print.\n"
+            "@ingroup Debugging" )
+{
+   ScriptProfiler::dump( getMax( maxEntries, 0 ) );
+}
+
+DefineEngineFunction( scriptProfilerDumpToFile, bool, ( const char* fileName ),,
+            "@brief Write the recorded script call stacks to a file in collapsed stack format.\n\n"
+            "Each line holds one call chain and the microseconds spent in its last function. "
+            "The file can be turned into a flame graph with tools like flamegraph.pl or speedscope.\n"
+            "@param fileName File to write.\n"
+            "@return False if nothing has been recorded or the file could not be written.\n"
+            "@ingroup Debugging" )
+{
+   return ScriptProfiler::dumpToFile( fileName );
+}
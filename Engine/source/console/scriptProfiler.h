@@ -0,0 +1,170 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCRIPTPROFILER_H_
+#define _SCRIPTPROFILER_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+class Namespace;
+
+
+/// Instrumenting profiler for TorqueScript functions.
+///
+/// While running, every script function call is recorded in a call tree
+/// keyed by the chain of functions leading up to it.  This gives exact call
+/// counts plus inclusive and exclusive times per function, and the tree can
+/// be written out as collapsed stacks for flame graph tools:
+///
+/// @code
+/// scriptProfilerEnable( true );
+/// // ... play for a while ...
+/// scriptProfilerEnable( false );
+/// scriptProfilerDump();
+/// scriptProfilerDumpToFile( "script.folded" ); // flamegraph.pl script.folded > script.svg
+/// @endcode
+///
+/// Time spent in engine functions called from script is attributed to the
+/// calling script function.  Unlike the engine profiler, this is available
+/// in all builds so it can be switched on for a live server.  Only the main
+/// thread runs script, so there is no locking.
+class ScriptProfiler
+{
+   public:
+
+      /// Totals for one function over the whole capture.
+      struct FunctionStats
+      {
+         StringTableEntry mNamespace;
+         StringTableEntry mFunction;
+         StringTableEntry mPackage;
+
+         U32 mCallCount;
+
+         /// Time in the function including its callees in microseconds.
+         /// Recursive calls are only counted once.
+         F64 mInclusiveUs;
+
+         /// Time in the function's own code in microseconds.
+         F64 mExclusiveUs;
+      };
+
+   protected:
+
+      struct Node
+      {
+         StringTableEntry mNamespace;
+         StringTableEntry mFunction;
+         StringTableEntry mPackage;
+
+         S32 mParent;
+         S32 mFirstChild;
+         S32 mNextSibling;
+
+         U32 mCallCount;
+         U64 mInclusiveTicks;
+         U64 mChildTicks;
+
+         bool isSameFunction( const Node& node ) const
+         {
+            return ( mNamespace == node.mNamespace && mFunction == node.mFunction && mPackage == node.mPackage );
+         }
+      };
+
+      struct Frame
+      {
+         S32 mNode;
+         U64 mStartTime;
+      };
+
+      static bool smRunning;
+
+      /// Incremented whenever the frames in #smStack are thrown away so that
+      /// calls entered before don't pop frames that aren't theirs.
+      static U32 smSession;
+
+      /// Call tree.  Node 0 is the root all top-level calls hang off.
+      static Vector< Node > smNodes;
+
+      static Vector< Frame > smStack;
+
+      /// Timestamp at which the current run was started.
+      static U64 smRunStartTime;
+      static U32 smRunStartMs;
+
+      /// Timestamp ticks and milliseconds of all previous runs.
+      static U64 smCapturedTicks;
+      static U32 smCapturedMs;
+
+      static S32 _findChild( S32 parent, Namespace* ns, StringTableEntry function, StringTableEntry package );
+
+      /// Pop all open frames, crediting them with the time up to now.
+      static void _closeFrames();
+
+      /// Return the number of timestamp ticks per microsecond.
+      static F64 _getTicksPerUs();
+
+      /// Format a function name as "[package]namespace::function".
+      static void _writeName( char* buffer, U32 bufferSize, StringTableEntry ns, StringTableEntry function, StringTableEntry package );
+
+   public:
+
+      /// Return true if calls are being recorded.
+      static bool isRunning() { return smRunning; }
+
+      /// Start or stop recording.  Stopping keeps the data around and
+      /// starting again adds to it.
+      static void enable( bool enable );
+
+      /// Discard all recorded data.
+      static void reset();
+
+      /// Record entering a script function.
+      /// @return Value to pass to exitFunction() or 0 if not recording.
+      static U32 enterFunction( Namespace* ns, StringTableEntry function, StringTableEntry package );
+
+      /// Record leaving the function entered by the enterFunction() call that
+      /// returned @a session.
+      static void exitFunction( U32 session );
+
+      /// Fill @a outStats with the totals of all recorded functions.
+      static void getFunctionStats( Vector< FunctionStats >& outStats );
+
+      /// Print the @a maxEntries functions with the most exclusive time to
+      /// the console.
+      static void dump( U32 maxEntries );
+
+      /// Write the call tree to @a fileName as collapsed stacks, one line per
+      /// call chain with its exclusive time in microseconds.
+      static bool dumpToFile( const char* fileName );
+
+      /// Return a high-resolution CPU timestamp.
+      static U64 getTimestamp();
+};
+
+#endif // !_SCRIPTPROFILER_H_
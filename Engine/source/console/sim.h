@@ -156,6 +156,10 @@ namespace Sim
    SimTime getCurrentTime();
    SimTime getTargetTime();
 
+   /// Return the time until the next queued event is due, zero if it is
+   /// overdue or U32_MAX if nothing is queued.
+   SimTime getTimeToNextEvent();
+
    /// a target time of 0 on an event means current event
    U32 postEvent(SimObject*, SimEvent*, SimTime targetTime);
 
@@ -55,6 +55,7 @@ ConsoleDocClass( SimDataBlock,
 
 SimDataBlock::SimDataBlock()
 {
+   mPreloadDeferred = false;
    setModDynamicFields(true);
    setModStaticFields(true);
 }
@@ -82,6 +83,7 @@ void SimDataBlock::SubstitutionStatement::replaceValue(const char* value)
 SimDataBlock::SimDataBlock(const SimDataBlock& other, bool temp_clone) : SimObject(other, temp_clone)
 {
    modifiedKey = other.modifiedKey;
+   mPreloadDeferred = false;
 }
 
 // a destructor is added to SimDataBlock so that we can delete any substitutions.
@@ -351,7 +353,9 @@ void SimDataBlock::assignId()
 
 void SimDataBlock::onStaticModified(const char* slotName, const char* newValue)
 {
-   modifiedKey = sNextModifiedKey++;
+   // Take a new key so connections that already have this datablock
+   // see it as modified.
+   modifiedKey = ++sNextModifiedKey;
 }
 
 //-----------------------------------------------------------------------------
@@ -396,6 +400,17 @@ bool SimDataBlock::preload(bool, String&)
    return true;
 }
 
+bool SimDataBlock::finishDeferredPreload(String &errorStr)
+{
+   if (!mPreloadDeferred)
+      return true;
+
+   PROFILE_SCOPE(SimDataBlock_finishDeferredPreload);
+
+   mPreloadDeferred = false;
+   return preload(false, errorStr);
+}
+
 //-----------------------------------------------------------------------------
 
 void SimDataBlock::write(Stream &stream, U32 tabStop, U32 flags)
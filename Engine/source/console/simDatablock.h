@@ -118,6 +118,9 @@ public:
 protected:
    S32  modifiedKey;
 
+   /// Set while the client preload() has been put off.
+   bool mPreloadDeferred;
+
 public:
    static SimObjectId sNextObjectId;
    static S32         sNextModifiedKey;
@@ -137,6 +140,27 @@ public:
    /// Get the modified key for this particular datablock.
    S32 getModifiedKey() const { return modifiedKey; }
 
+   /// Returns true if the client may put off preload() until the first
+   /// object using this datablock is added.
+   ///
+   /// Only datablocks whose client preload() just loads their own resources,
+   /// and which no other datablock depends on at preload time, should allow
+   /// this.
+   ///
+   /// @see GameConnection::smDeferDataBlockPreload
+   virtual bool allowDeferredPreload() const { return false; }
+
+   /// Returns true if the client preload() of this datablock was put off.
+   bool isPreloadDeferred() const { return mPreloadDeferred; }
+
+   /// Marks the client preload() of this datablock as put off.
+   void deferPreload() { mPreloadDeferred = true; }
+
+   /// Runs the client preload() if it was put off, otherwise does nothing.
+   ///
+   /// @returns False and sets errorStr if the preload failed.
+   bool finishDeferredPreload(String &errorStr);
+
    bool onAdd();
    virtual void onStaticModified(const char* slotName, const char*newValue = NULL);
    //void setLastError(const char*);
@@ -0,0 +1,225 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "console/simEventQueue.h"
+
+
+//-----------------------------------------------------------------------------
+
+SimEventQueue::SimEventQueue()
+{
+   VECTOR_SET_ASSOCIATION( mHeap );
+   VECTOR_SET_ASSOCIATION( mBuckets );
+}
+
+//-----------------------------------------------------------------------------
+
+void SimEventQueue::_siftUp( U32 index )
+{
+   SimEvent* event = mHeap[ index ];
+   while( index > 0 )
+   {
+      const U32 parent = ( index - 1 ) >> 1;
+      if( !_isBefore( event, mHeap[ parent ] ) )
+         break;
+
+      _setHeap( index, mHeap[ parent ] );
+      index = parent;
+   }
+   _setHeap( index, event );
+}
+
+//-----------------------------------------------------------------------------
+
+void SimEventQueue::_siftDown( U32 index )
+{
+   const U32 count = mHeap.size();
+   SimEvent* event = mHeap[ index ];
+
+   while( true )
+   {
+      U32 child = index * 2 + 1;
+      if( child >= count )
+         break;
+
+      if( child + 1 < count && _isBefore( mHeap[ child + 1 ], mHeap[ child ] ) )
+         child ++;
+
+      if( !_isBefore( mHeap[ child ], event ) )
+         break;
+
+      _setHeap( index, mHeap[ child ] );
+      index = child;
+   }
+   _setHeap( index, event );
+}
+
+//-----------------------------------------------------------------------------
+
+void SimEventQueue::_removeFromHeap( U32 index )
+{
+   AssertFatal( index < mHeap.size(), "SimEventQueue::_removeFromHeap - Invalid index" );
+
+   SimEvent* last = mHeap.last();
+   mHeap.decrement();
+
+   if( index == mHeap.size() )
+      return;
+
+   // Move the last event into the hole and restore the heap in whichever
+   // direction it is out of order.
+   _setHeap( index, last );
+   if( index > 0 && _isBefore( last, mHeap[ ( index - 1 ) >> 1 ] ) )
+      _siftUp( index );
+   else
+      _siftDown( index );
+}
+
+//-----------------------------------------------------------------------------
+
+void SimEventQueue::_unlink( SimEvent* event )
+{
+   SimEvent** walk = _getBucket( event->sequenceCount );
+   while( *walk != event )
+   {
+      AssertFatal( *walk, "SimEventQueue::_unlink - Event not in queue" );
+      walk = &( *walk )->nextEvent;
+   }
+   *walk = event->nextEvent;
+   event->nextEvent = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void SimEventQueue::_growBuckets()
+{
+   const U32 newSize = getMax( mBuckets.size() * 2, 64 );
+   mBuckets.setSize( newSize );
+   for( U32 i = 0; i < newSize; ++ i )
+      mBuckets[ i ] = NULL;
+
+   for( U32 i = 0; i < mHeap.size(); ++ i )
+   {
+      SimEvent* event = mHeap[ i ];
+      SimEvent** bucket = _getBucket( event->sequenceCount );
+      event->nextEvent = *bucket;
+      *bucket = event;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void SimEventQueue::push( SimEvent* event )
+{
+   mHeap.push_back( event );
+   _siftUp( mHeap.size() - 1 );
+
+   if( mHeap.size() > mBuckets.size() )
+      _growBuckets();
+   else
+   {
+      SimEvent** bucket = _getBucket( event->sequenceCount );
+      event->nextEvent = *bucket;
+      *bucket = event;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+SimEvent* SimEventQueue::pop()
+{
+   AssertFatal( !mHeap.empty(), "SimEventQueue::pop - Queue is empty" );
+
+   SimEvent* event = mHeap.first();
+   _removeFromHeap( 0 );
+   _unlink( event );
+
+   return event;
+}
+
+//-----------------------------------------------------------------------------
+
+SimEvent* SimEventQueue::find( U32 sequenceCount )
+{
+   if( mBuckets.empty() )
+      return NULL;
+
+   for( SimEvent* walk = *_getBucket( sequenceCount ); walk; walk = walk->nextEvent )
+      if( walk->sequenceCount == sequenceCount )
+         return walk;
+
+   return NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void SimEventQueue::remove( SimEvent* event )
+{
+   AssertFatal( event->queueIndex < mHeap.size() && mHeap[ event->queueIndex ] == event,
+      "SimEventQueue::remove - Event not in queue" );
+
+   _removeFromHeap( event->queueIndex );
+   _unlink( event );
+}
+
+//-----------------------------------------------------------------------------
+
+void SimEventQueue::deleteEventsFor( SimObject* object )
+{
+   // Compact the heap in place and rebuild it rather than removing the
+   // events one by one.
+
+   U32 count = 0;
+   bool removed = false;
+   for( U32 i = 0; i < mHeap.size(); ++ i )
+   {
+      SimEvent* event = mHeap[ i ];
+      if( event->destObject == object )
+      {
+         _unlink( event );
+         delete event;
+         removed = true;
+      }
+      else
+         _setHeap( count ++, event );
+   }
+
+   if( !removed )
+      return;
+
+   mHeap.setSize( count );
+   for( S32 i = S32( count / 2 ) - 1; i >= 0; -- i )
+      _siftDown( i );
+}
+
+//-----------------------------------------------------------------------------
+
+void SimEventQueue::deleteAll()
+{
+   for( U32 i = 0; i < mHeap.size(); ++ i )
+      delete mHeap[ i ];
+
+   mHeap.clear();
+   for( U32 i = 0; i < mBuckets.size(); ++ i )
+      mBuckets[ i ] = NULL;
+}
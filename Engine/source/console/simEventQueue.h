@@ -0,0 +1,113 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SIMEVENTQUEUE_H_
+#define _SIMEVENTQUEUE_H_
+
+#ifndef _SIMEVENTS_H_
+#include "console/simEvents.h"
+#endif
+
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+
+/// Pending SimEvents ordered by the time they are due.
+///
+/// Events are kept in a binary min-heap on (time, sequenceCount), so
+/// events due at the same time come out in the order they were posted,
+/// just as with the sorted list this replaces.  A hash over the sequence
+/// counts, chained through SimEvent::nextEvent, finds events for
+/// cancellation and queries without a scan.  Push, pop and removal are
+/// O(log n); lookups are O(1).
+///
+/// The queue does not lock; Sim serializes access to it.
+class SimEventQueue
+{
+   protected:
+
+      /// Heap of pending events.  SimEvent::queueIndex is the position
+      /// of an event in here.
+      Vector< SimEvent* > mHeap;
+
+      /// Lookup buckets, indexed by sequenceCount.  The number of buckets
+      /// is zero or a power of two.
+      Vector< SimEvent* > mBuckets;
+
+      static bool _isBefore( const SimEvent* a, const SimEvent* b )
+      {
+         if( a->time != b->time )
+            return ( a->time < b->time );
+         return ( S32( a->sequenceCount - b->sequenceCount ) < 0 );
+      }
+
+      SimEvent** _getBucket( U32 sequenceCount )
+      {
+         return &mBuckets[ sequenceCount & ( mBuckets.size() - 1 ) ];
+      }
+
+      void _setHeap( U32 index, SimEvent* event )
+      {
+         mHeap[ index ] = event;
+         event->queueIndex = index;
+      }
+
+      void _siftUp( U32 index );
+      void _siftDown( U32 index );
+
+      /// Take the event at heap position @a index out of the heap.
+      void _removeFromHeap( U32 index );
+
+      void _unlink( SimEvent* event );
+      void _growBuckets();
+
+   public:
+
+      SimEventQueue();
+
+      bool isEmpty() const { return mHeap.empty(); }
+      U32 size() const { return mHeap.size(); }
+
+      /// Return the event due next or NULL if the queue is empty.
+      SimEvent* getNext() const { return ( mHeap.empty() ? NULL : mHeap.first() ); }
+
+      /// Add @a event, which must have its time and sequenceCount set.
+      void push( SimEvent* event );
+
+      /// Remove and return the event due next.  The queue must not be empty.
+      SimEvent* pop();
+
+      /// Return the pending event with @a sequenceCount or NULL.
+      SimEvent* find( U32 sequenceCount );
+
+      /// Remove @a event from the queue without deleting it.
+      void remove( SimEvent* event );
+
+      /// Remove and delete all events posted to @a object.
+      void deleteEventsFor( SimObject* object );
+
+      /// Remove and delete all events.
+      void deleteAll();
+};
+
+#endif // !_SIMEVENTQUEUE_H_
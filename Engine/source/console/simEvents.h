@@ -55,7 +55,8 @@ class ConsoleValue;
 class SimEvent
 {
 public:
-   SimEvent *nextEvent;     ///< Linked list details - pointer to next item in the list.
+   SimEvent *nextEvent;     ///< Next event in the same SimEventQueue lookup bucket.
+   U32 queueIndex;          ///< Position in the SimEventQueue heap.
    SimTime startTime;       ///< When the event was posted.
    SimTime time;            ///< When the event is scheduled to occur.
    U32 sequenceCount;       ///< Unique ID. These are assigned sequentially based on order
@@ -38,16 +38,64 @@ static Chunker<SimFieldDictionary::Entry> fieldChunker;
 
 U32 SimFieldDictionary::getHashValue(StringTableEntry slotName)
 {
-   return HashPointer(slotName) % HashTableSize;
+   // Mix the bits down since the table index only uses the low ones.
+   U32 hash = HashPointer(slotName) * 2654435761u;
+   return hash ^ (hash >> 16);
 }
 
-U32 SimFieldDictionary::getHashValue(const String& fieldName)
+U32 SimFieldDictionary::findIndex(StringTableEntry slotName) const
 {
-   return getHashValue(StringTable->insert(fieldName));
+   AssertFatal(mTableSize, "SimFieldDictionary::findIndex - Empty table");
+
+   const U32 mask = mTableSize - 1;
+   U32 index = getHashValue(slotName) & mask;
+   while (mTable[index] && mTable[index]->slotName != slotName)
+      index = (index + 1) & mask;
+
+   return index;
+}
+
+void SimFieldDictionary::resizeTable(U32 newSize)
+{
+   Entry **oldTable = mTable;
+   const U32 oldSize = mTableSize;
+
+   mTable = (Entry **) dMalloc(newSize * sizeof(Entry *));
+   mTableSize = newSize;
+   dMemset(mTable, 0, newSize * sizeof(Entry *));
+
+   for (U32 i = 0; i < oldSize; i++)
+      if (oldTable[i])
+         mTable[findIndex(oldTable[i]->slotName)] = oldTable[i];
+
+   if (oldTable)
+      dFree(oldTable);
+}
+
+void SimFieldDictionary::removeIndex(U32 index)
+{
+   // Shift back entries that probed past the slot being freed so that
+   // lookups never run into a hole before reaching them.
+   const U32 mask = mTableSize - 1;
+   mTable[index] = NULL;
+
+   for (U32 next = (index + 1) & mask; mTable[next]; next = (next + 1) & mask)
+   {
+      const U32 home = getHashValue(mTable[next]->slotName) & mask;
+      if (((next - home) & mask) >= ((next - index) & mask))
+      {
+         mTable[index] = mTable[next];
+         mTable[next] = NULL;
+         index = next;
+      }
+   }
 }
 
-SimFieldDictionary::Entry *SimFieldDictionary::addEntry(U32 bucket, StringTableEntry slotName, ConsoleBaseType* type, char* value)
+SimFieldDictionary::Entry *SimFieldDictionary::addEntry(StringTableEntry slotName, ConsoleBaseType* type, char* value)
 {
+   if ((mNumFields + 1) * 2 > mTableSize)
+      resizeTable(mTableSize ? mTableSize * 2 : 4);
+
    Entry* ret;
    if (smFreeList)
    {
@@ -57,12 +105,12 @@ SimFieldDictionary::Entry *SimFieldDictionary::addEntry(U32 bucket, StringTableE
    else
       ret = fieldChunker.alloc();
 
-   ret->next = mHashTable[bucket];
+   ret->next = NULL;
    ret->slotName = slotName;
    ret->type = type;
    ret->value = value;
 
-   mHashTable[bucket] = ret;
+   mTable[findIndex(slotName)] = ret;
    mNumFields++;
    mVersion++;
 
@@ -78,27 +126,29 @@ void SimFieldDictionary::freeEntry(SimFieldDictionary::Entry *ent)
 }
 
 SimFieldDictionary::SimFieldDictionary()
-   : mNumFields(0),
+   : mTable(NULL),
+   mTableSize(0),
+   mNumFields(0),
    mVersion(0)
 {
-   dMemset(mHashTable, 0, sizeof(mHashTable));
 }
 
 SimFieldDictionary::~SimFieldDictionary()
 {
-   for (U32 i = 0; i < HashTableSize; i++)
+   for (U32 i = 0; i < mTableSize; i++)
    {
-      for (Entry *walk = mHashTable[i]; walk;)
-      {
-         Entry *temp = walk;
-         walk = temp->next;
+      Entry *temp = mTable[i];
+      if (!temp)
+         continue;
 
-         if (temp->value)
-            dFree(temp->value);
-         freeEntry(temp);
-      }
+      if (temp->value)
+         dFree(temp->value);
+      freeEntry(temp);
    }
 
+   if (mTable)
+      dFree(mTable);
+
    AssertFatal(mNumFields == 0, "Incorrect count on field dictionary");
 }
 
@@ -117,70 +167,49 @@ void SimFieldDictionary::setFieldType(StringTableEntry slotName, const U32 typeI
 void SimFieldDictionary::setFieldType(StringTableEntry slotName, ConsoleBaseType *type)
 {
    // If the field exists on the object, set the type
-   U32 bucket = getHashValue(slotName);
-
-   for (Entry *walk = mHashTable[bucket]; walk; walk = walk->next)
+   Entry *field = findEntry(slotName);
+   if (field)
    {
-      if (walk->slotName == slotName)
-      {
-         // Found and type assigned, let's bail
-         walk->type = type;
-         return;
-      }
+      // Found and type assigned, let's bail
+      field->type = type;
+      return;
    }
 
    // Otherwise create the field, and set the type. Assign a null value.
-   addEntry(bucket, slotName, type);
+   addEntry(slotName, type);
 }
 
 U32 SimFieldDictionary::getFieldType(StringTableEntry slotName) const
 {
-   U32 bucket = getHashValue(slotName);
-
-   for (Entry *walk = mHashTable[bucket]; walk; walk = walk->next)
-      if (walk->slotName == slotName)
-         return walk->type ? walk->type->getTypeID() : TypeString;
+   Entry *field = findEntry(slotName);
+   if (field)
+      return field->type ? field->type->getTypeID() : TypeString;
 
    return TypeString;
 }
 
 SimFieldDictionary::Entry  *SimFieldDictionary::findDynamicField(const String &fieldName) const
 {
-   U32 bucket = getHashValue(fieldName);
-
-   for (Entry *walk = mHashTable[bucket]; walk; walk = walk->next)
-   {
-      if (fieldName.equal(walk->slotName, String::NoCase))
-         return walk;
-   }
+   // Slot names are case insensitive string table entries, so a lookup
+   // (which doesn't grow the string table) finds the one we would store.
+   StringTableEntry slotName = StringTable->lookup(fieldName);
+   if (!slotName)
+      return NULL;
 
-   return NULL;
+   return findEntry(slotName);
 }
 
 SimFieldDictionary::Entry *SimFieldDictionary::findDynamicField(StringTableEntry fieldName) const
 {
-   U32 bucket = getHashValue(fieldName);
-
-   for (Entry *walk = mHashTable[bucket]; walk; walk = walk->next)
-   {
-      if (walk->slotName == fieldName)
-      {
-         return walk;
-      }
-   }
-
-   return NULL;
+   return findEntry(fieldName);
 }
 
 
 void SimFieldDictionary::setFieldValue(StringTableEntry slotName, const char *value)
 {
-   U32 bucket = getHashValue(slotName);
-   Entry **walk = &mHashTable[bucket];
-   while (*walk && (*walk)->slotName != slotName)
-      walk = &((*walk)->next);
+   const U32 index = mTableSize ? findIndex(slotName) : 0;
+   Entry *field = mTableSize ? mTable[index] : NULL;
 
-   Entry *field = *walk;
    if (!value || !*value)
    {
       if (field)
@@ -190,7 +219,7 @@ void SimFieldDictionary::setFieldValue(StringTableEntry slotName, const char *va
          if (field->value)
             dFree(field->value);
 
-         *walk = field->next;
+         removeIndex(index);
          freeEntry(field);
       }
    }
@@ -204,28 +233,24 @@ void SimFieldDictionary::setFieldValue(StringTableEntry slotName, const char *va
          field->value = dStrdup(value);
       }
       else
-         addEntry(bucket, slotName, 0, dStrdup(value));
+         addEntry(slotName, 0, dStrdup(value));
    }
 }
 
 const char *SimFieldDictionary::getFieldValue(StringTableEntry slotName)
 {
-   U32 bucket = getHashValue(slotName);
-
-   for (Entry *walk = mHashTable[bucket]; walk; walk = walk->next)
-      if (walk->slotName == slotName)
-         return walk->value;
-
-   return NULL;
+   Entry *field = findEntry(slotName);
+   return field ? field->value : NULL;
 }
 
 void SimFieldDictionary::assignFrom(SimFieldDictionary *dict)
 {
    mVersion++;
 
-   for (U32 i = 0; i < HashTableSize; i++)
+   for (U32 i = 0; i < dict->mTableSize; i++)
    {
-      for (Entry *walk = dict->mHashTable[i]; walk; walk = walk->next)
+      Entry *walk = dict->mTable[i];
+      if (walk)
       {
          setFieldValue(walk->slotName, walk->value);
          setFieldType(walk->slotName, walk->type);
@@ -245,9 +270,10 @@ void SimFieldDictionary::writeFields(SimObject *obj, Stream &stream, U32 tabStop
    const AbstractClassRep::FieldList &list = obj->getFieldList();
    Vector<Entry *> flist(__FILE__, __LINE__);
 
-   for (U32 i = 0; i < HashTableSize; i++)
+   for (U32 i = 0; i < mTableSize; i++)
    {
-      for (Entry *walk = mHashTable[i]; walk; walk = walk->next)
+      Entry *walk = mTable[i];
+      if (walk)
       {
          // make sure we haven't written this out yet:
          U32 i;
@@ -293,9 +319,10 @@ void SimFieldDictionary::printFields(SimObject *obj)
    char expandedBuffer[4096];
    Vector<Entry *> flist(__FILE__, __LINE__);
 
-   for (U32 i = 0; i < HashTableSize; i++)
+   for (U32 i = 0; i < mTableSize; i++)
    {
-      for (Entry *walk = mHashTable[i]; walk; walk = walk->next)
+      Entry *walk = mTable[i];
+      if (walk)
       {
          // make sure we haven't written this out yet:
          U32 i;
@@ -353,11 +380,20 @@ SimFieldDictionary::Entry* SimFieldDictionaryIterator::operator++()
    if (!mDictionary)
       return(mEntry);
 
-   if (mEntry)
-      mEntry = mEntry->next;
+   // If the current entry got removed, removeIndex() may have moved the
+   // next one into its slot, so look at that again.
+   S32 index = mHashIndex;
+   if (index < 0 || (index < S32(mDictionary->mTableSize) && mDictionary->mTable[index] == mEntry))
+      index++;
 
-   while (!mEntry && (mHashIndex < (SimFieldDictionary::HashTableSize - 1)))
-      mEntry = mDictionary->mHashTable[++mHashIndex];
+   mEntry = NULL;
+   while (!mEntry && index < S32(mDictionary->mTableSize))
+   {
+      mEntry = mDictionary->mTable[index];
+      if (!mEntry)
+         index++;
+   }
+   mHashIndex = index;
 
    return(mEntry);
 }
@@ -384,16 +420,10 @@ void SimFieldDictionary::setFieldValue(StringTableEntry slotName, const char *va
    if (!value || !*value)
       return;
 
-   U32 bucket = getHashValue(slotName);
-   Entry **walk = &mHashTable[bucket];
-   while (*walk && (*walk)->slotName != slotName)
-      walk = &((*walk)->next);
-
-   Entry *field = *walk;
-   if (field)
+   if (findEntry(slotName))
       return;
 
-   addEntry(bucket, slotName, type, dStrdup(value));
+   addEntry(slotName, type, dStrdup(value));
 }
 // A variation of the stock SimFieldDictionary::assignFrom(), this method adds <no_replace>
 // and <filter> arguments. When true, <no_replace> prohibits the replacement of fields that already
@@ -412,14 +442,14 @@ void SimFieldDictionary::assignFrom(SimFieldDictionary *dict, const char* filter
 
    if (filter_len == 0)
    {
-      for (U32 i = 0; i < HashTableSize; i++)
-         for (Entry *walk = dict->mHashTable[i]; walk; walk = walk->next)
+      for (U32 i = 0; i < dict->mTableSize; i++)
+         if (Entry *walk = dict->mTable[i])
             setFieldValue(walk->slotName, walk->value, walk->type, no_replace);
    }
    else
    {
-      for (U32 i = 0; i < HashTableSize; i++)
-         for (Entry *walk = dict->mHashTable[i]; walk; walk = walk->next)
+      for (U32 i = 0; i < dict->mTableSize; i++)
+         if (Entry *walk = dict->mTable[i])
             if (dStrncmp(walk->slotName, filter, filter_len) == 0)
                setFieldValue(walk->slotName, walk->value, walk->type, no_replace);
    }
@@ -51,23 +51,39 @@ public:
 
       StringTableEntry slotName;
       char *value;
-      Entry *next;
+      Entry *next;   ///< Next entry on the free list.
       ConsoleBaseType *type;
    };
-   enum
-   {
-      HashTableSize = 19
-   };
-   Entry *mHashTable[HashTableSize];
 
 private:
    static Entry   *smFreeList;
 
+   /// Open-addressed hash table of the fields using linear probing.  It is
+   /// only allocated once the first field is added, its size is always a
+   /// power of two and it is kept at most half full.  Entries themselves are
+   /// allocated separately so pointers to them stay valid until the field
+   /// is removed.
+   Entry **mTable;
+   U32   mTableSize;
+
    void           freeEntry(Entry *entry);
-   Entry*         addEntry(U32 bucket, StringTableEntry slotName, ConsoleBaseType* type, char* value = 0);
+   Entry*         addEntry(StringTableEntry slotName, ConsoleBaseType* type, char* value = 0);
+
+   /// Remove the entry at @a index from the table without freeing it.
+   void           removeIndex(U32 index);
+
+   /// Return the table index holding @a slotName or the empty slot it
+   /// would go into.  The table must not be empty.
+   U32            findIndex(StringTableEntry slotName) const;
+
+   Entry*         findEntry(StringTableEntry slotName) const
+   {
+      return mTableSize ? mTable[findIndex(slotName)] : NULL;
+   }
+
+   void           resizeTable(U32 newSize);
 
    static U32     getHashValue(StringTableEntry slotName);
-   static U32     getHashValue(const String& fieldName);
 
    U32   mNumFields;
 
@@ -99,6 +115,9 @@ public:
    void assignFrom(SimFieldDictionary *dict, const char* filter, bool no_replace);
 };
 
+/// Iterates over the fields of a SimFieldDictionary in no particular order.
+/// The current field may be removed while iterating, but no other changes
+/// may be made to the dictionary.
 class SimFieldDictionaryIterator
 {
    SimFieldDictionary *          mDictionary;
@@ -24,6 +24,7 @@
 #include "platform/threads/mutex.h"
 #include "console/simBase.h"
 #include "console/simPersistID.h"
+#include "console/simEventQueue.h"
 #include "core/stringTable.h"
 #include "console/console.h"
 #include "core/stream/fileStream.h"
@@ -58,7 +59,7 @@ SimTime gCurrentTime;
 SimTime gTargetTime;
 
 void *gEventQueueMutex;
-SimEvent *gEventQueue;
+SimEventQueue gEventQueue;
 U32 gEventSequence;
 
 //---------------------------------------------------------------------------
@@ -69,7 +70,6 @@ static void initEventQueue()
    gCurrentTime = 0;
    gTargetTime = 0;
    gEventSequence = 1;
-   gEventQueue = NULL;
    gEventQueueMutex = Mutex::createMutex();
 }
 
@@ -77,13 +77,7 @@ static void shutdownEventQueue()
 {
    // Delete all pending events
    Mutex::lockMutex(gEventQueueMutex);
-   SimEvent *walk = gEventQueue;
-   while(walk)
-   {
-      SimEvent *temp = walk->nextEvent;
-      delete walk;
-      walk = temp;
-   }
+   gEventQueue.deleteAll();
    Mutex::unlockMutex(gEventQueueMutex);
    Mutex::destroyMutex(gEventQueueMutex);
 }
@@ -115,19 +109,11 @@ U32 postEvent(SimObject *destObject, SimEvent* event,U32 time)
       return InvalidEventId;
    }
    event->sequenceCount = gEventSequence++;
-   SimEvent **walk = &gEventQueue;
-   SimEvent *current;
-   
-   while((current = *walk) != NULL && (current->time < event->time))
-      walk = &(current->nextEvent);
-   
-   // [tom, 6/24/2005] This ensures that SimEvents are dispatched in the same order that they are posted.
-   // This is needed to ensure Con::threadSafeExecute() executes script code in the correct order.
-   while((current = *walk) != NULL && (current->time == event->time))
-      walk = &(current->nextEvent);
-   
-   event->nextEvent = current;
-   *walk = event;
+
+   // [tom, 6/24/2005] Events due at the same time must be dispatched in the same order
+   // that they are posted.  This is needed to ensure Con::threadSafeExecute() executes
+   // script code in the correct order.  The queue orders on the sequence count for that.
+   gEventQueue.push(event);
 
    U32 seqCount = event->sequenceCount;
 
@@ -143,20 +129,11 @@ void cancelEvent(U32 eventSequence)
 {
    Mutex::lockMutex(gEventQueueMutex);
 
-   SimEvent **walk = &gEventQueue;
-   SimEvent *current;
-   
-   while((current = *walk) != NULL)
+   SimEvent *event = gEventQueue.find(eventSequence);
+   if(event)
    {
-      if(current->sequenceCount == eventSequence)
-      {
-         *walk = current->nextEvent;
-         delete current;
-         Mutex::unlockMutex(gEventQueueMutex);
-         return;
-      }
-      else
-         walk = &(current->nextEvent);
+      gEventQueue.remove(event);
+      delete event;
    }
 
    Mutex::unlockMutex(gEventQueueMutex);
@@ -165,20 +142,7 @@ void cancelEvent(U32 eventSequence)
 void cancelPendingEvents(SimObject *obj)
 {
    Mutex::lockMutex(gEventQueueMutex);
-
-   SimEvent **walk = &gEventQueue;
-   SimEvent *current;
-   
-   while((current = *walk) != NULL)
-   {
-      if(current->destObject == obj)
-      {
-         *walk = current->nextEvent;
-         delete current;
-      }
-      else
-         walk = &(current->nextEvent);
-   }
+   gEventQueue.deleteEventsFor(obj);
    Mutex::unlockMutex(gEventQueueMutex);
 }
 
@@ -188,47 +152,38 @@ void cancelPendingEvents(SimObject *obj)
 bool isEventPending(U32 eventSequence)
 {
    Mutex::lockMutex(gEventQueueMutex);
-
-   for(SimEvent *walk = gEventQueue; walk; walk = walk->nextEvent)
-      if(walk->sequenceCount == eventSequence)
-      {
-         Mutex::unlockMutex(gEventQueueMutex);
-         return true;
-      }
+   const bool pending = (gEventQueue.find(eventSequence) != NULL);
    Mutex::unlockMutex(gEventQueueMutex);
-   return false;
+   return pending;
 }
 
 U32 getEventTimeLeft(U32 eventSequence)
 {
    Mutex::lockMutex(gEventQueueMutex);
 
-   for(SimEvent *walk = gEventQueue; walk; walk = walk->nextEvent)
-      if(walk->sequenceCount == eventSequence)
-      {
-         SimTime t = walk->time - getCurrentTime();
-         Mutex::unlockMutex(gEventQueueMutex);
-         return t;
-      }
+   SimTime t = 0;
+   SimEvent *event = gEventQueue.find(eventSequence);
+   if(event)
+      t = event->time - getCurrentTime();
 
    Mutex::unlockMutex(gEventQueueMutex);
 
-   return 0;   
+   return t;
 }
 
 U32 getScheduleDuration(U32 eventSequence)
 {
-   for(SimEvent *walk = gEventQueue; walk; walk = walk->nextEvent)
-      if(walk->sequenceCount == eventSequence)
-         return (walk->time-walk->startTime);
+   SimEvent *event = gEventQueue.find(eventSequence);
+   if(event)
+      return (event->time-event->startTime);
    return 0;
 }
 
 U32 getTimeSinceStart(U32 eventSequence)
 {
-   for(SimEvent *walk = gEventQueue; walk; walk = walk->nextEvent)
-      if(walk->sequenceCount == eventSequence)
-         return (getCurrentTime()-walk->startTime);
+   SimEvent *event = gEventQueue.find(eventSequence);
+   if(event)
+      return (getCurrentTime()-event->startTime);
    return 0;
 }
 
@@ -243,10 +198,9 @@ void advanceToTime(SimTime targetTime)
    Mutex::lockMutex(gEventQueueMutex);
 
    gTargetTime = targetTime;
-   while(gEventQueue && gEventQueue->time <= targetTime)
+   while(!gEventQueue.isEmpty() && gEventQueue.getNext()->time <= targetTime)
    {
-      SimEvent *event = gEventQueue;
-      gEventQueue = gEventQueue->nextEvent;
+      SimEvent *event = gEventQueue.pop();
       AssertFatal(event->time >= gCurrentTime,
          "Sim::advanceToTime() - Event time is less than current time.");
       gCurrentTime = event->time;
@@ -276,6 +230,23 @@ U32 getTargetTime()
    return dAtomicRead( gTargetTime );
 }
 
+U32 getTimeToNextEvent()
+{
+   Mutex::lockMutex(gEventQueueMutex);
+
+   SimTime t = U32_MAX;
+   if(!gEventQueue.isEmpty())
+   {
+      const SimTime next = gEventQueue.getNext()->time;
+      const SimTime current = getCurrentTime();
+      t = next > current ? next - current : 0;
+   }
+
+   Mutex::unlockMutex(gEventQueueMutex);
+
+   return t;
+}
+
 //---------------------------------------------------------------------------
 //---------------------------------------------------------------------------
 
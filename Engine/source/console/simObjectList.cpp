@@ -31,9 +31,70 @@
 
 String SimObjectList::smSortScriptCallbackFn;
 
+void SimObjectList::_indexInsert(SimObject* obj)
+{
+   if (mIndexed)
+   {
+      // Count the entries so stray duplicates don't unindex an object
+      // that is still in the list.
+      mIndex.findOrInsert(obj)->value++;
+   }
+   else if (size() > IndexThreshold)
+   {
+      mIndexed = true;
+      for (iterator itr = begin(); itr != end(); itr++)
+         mIndex.findOrInsert(*itr)->value++;
+   }
+}
+
+void SimObjectList::_indexErase(SimObject* obj)
+{
+   if (!mIndexed)
+      return;
+
+   // Go back to scanning once the list has shrunk well below the threshold.
+   if (size() <= IndexThreshold / 2)
+   {
+      mIndex.clear();
+      mIndexed = false;
+      return;
+   }
+
+   HashTable<SimObject*, U32>::Iterator itr = mIndex.find(obj);
+   if (itr != mIndex.end() && --itr->value == 0)
+      mIndex.erase(itr);
+}
+
+SimObjectList::iterator SimObjectList::_find(SimObject* obj)
+{
+   for (iterator itr = end(); itr != begin(); )
+   {
+      --itr;
+      if (*itr == obj)
+         return itr;
+   }
+
+   return end();
+}
+
+bool SimObjectList::contains(SimObject* obj) const
+{
+   if (mIndexed)
+      return mIndex.find(obj) != mIndex.end();
+
+   return Parent::contains(obj);
+}
+
+void SimObjectList::clear()
+{
+   Parent::clear();
+   mIndex.clear();
+   mIndexed = false;
+}
+
 bool SimObjectList::pushBack(SimObject* obj)
 {
-   if (find(begin(),end(),obj) == end())
+   if (!contains(obj))
    {
       push_back(obj);
       return true;
@@ -44,19 +105,18 @@ bool SimObjectList::pushBack(SimObject* obj)
 
 bool SimObjectList::pushBackForce(SimObject* obj)
 {
-   iterator itr = find(begin(),end(),obj);
+   iterator itr = _find(obj);
    if (itr == end())
    {
       push_back(obj);
       return true;
    }
-   else
+   else if (itr != end() - 1)
    {
-      // Move to the back...
-      //
-      SimObject* pBack = *itr;
-      removeStable(pBack);
-      push_back(pBack);
+      // Move to the back; the object stays in the list so the index
+      // doesn't change.
+      Parent::erase(itr);
+      Parent::push_back(obj);
    }
    
    return false;
@@ -64,7 +124,7 @@ bool SimObjectList::pushBackForce(SimObject* obj)
 
 bool SimObjectList::pushFront(SimObject* obj)
 {
-   if (find(begin(),end(),obj) == end())
+   if (!contains(obj))
    {
       push_front(obj);
       return true;
@@ -75,19 +135,15 @@ bool SimObjectList::pushFront(SimObject* obj)
 
 bool SimObjectList::remove(SimObject* obj)
 {
-   iterator ptr = find(begin(),end(),obj);
-   if (ptr != end())
-   {
-      erase(ptr);
-      return true;
-   }
-   
-   return false;
+   return removeStable(obj);
 }
 
 bool SimObjectList::removeStable(SimObject* obj)
 {
-   iterator ptr = find(begin(),end(),obj);
+   if (mIndexed && !contains(obj))
+      return false;
+
+   iterator ptr = _find(obj);
    if (ptr != end())
    {
       erase(ptr);
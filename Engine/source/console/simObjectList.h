@@ -32,6 +32,9 @@
 #ifndef _TORQUE_STRING_H_
 #include "core/util/str.h"
 #endif
+#ifndef _TDICTIONARY_H_
+#include "core/util/tDictionary.h"
+#endif
 
 // Forward Refs
 class SimObject;
@@ -39,8 +42,33 @@ class SimObject;
 /// A vector of SimObjects.
 ///
 /// As this inherits from VectorPtr, it has the full range of vector methods.
+///
+/// Once a list grows past IndexThreshold objects it also keeps a hash of its
+/// members so that adding objects and testing for them does not scan the
+/// list.  The vector methods that add or remove objects are shadowed to keep
+/// that hash in sync, so always modify the list through a SimObjectList.
 class SimObjectList : public VectorPtr<SimObject*>
 {
+   typedef VectorPtr<SimObject*> Parent;
+
+   enum
+   {
+      /// Size above which the list keeps #mIndex.
+      IndexThreshold = 64
+   };
+
+   /// Members of the list while #mIndexed is set.
+   HashTable<SimObject*, U32> mIndex;
+
+   bool mIndexed;
+
+   void _indexInsert( SimObject* obj );
+   void _indexErase( SimObject* obj );
+
+   /// Find @a obj searching from the back, where objects are most
+   /// likely to be removed from.
+   iterator _find( SimObject* obj );
+
    /// The script callback function for the active sort.
    /// @see scriptSort
    static String smSortScriptCallbackFn;
@@ -55,6 +83,24 @@ class SimObjectList : public VectorPtr<SimObject*>
    
 public:
 
+   SimObjectList() : mIndexed( false ) {}
+
+   /// Return true if @a obj is in the list.
+   bool contains( SimObject* obj ) const;
+
+   /// @name Vector Modifiers
+   /// Shadow the vector methods to keep the index in sync.
+   /// @{
+
+   void push_back( SimObject* obj ) { Parent::push_back( obj ); _indexInsert( obj ); }
+   void push_front( SimObject* obj ) { Parent::push_front( obj ); _indexInsert( obj ); }
+   void insert( iterator itr, SimObject* obj ) { Parent::insert( itr, obj ); _indexInsert( obj ); }
+   void pop_back() { _indexErase( last() ); Parent::pop_back(); }
+   void erase( iterator itr ) { _indexErase( *itr ); Parent::erase( itr ); }
+   void clear();
+
+   /// @}
+
    bool pushBack(SimObject*);       ///< Add the SimObject* to the end of the list, unless it's already in the list.
    bool pushBackForce(SimObject*);  ///< Add the SimObject* to the end of the list, moving it there if it's already present in the list.
    bool pushFront(SimObject*);      ///< Add the SimObject* to the start of the list.
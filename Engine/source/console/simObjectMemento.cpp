@@ -26,10 +26,13 @@
 #include "console/simObject.h"
 #include "console/simDatablock.h"
 #include "core/stream/memStream.h"
+#include "zlib/zlib.h"
 
 
 SimObjectMemento::SimObjectMemento()
    : mState( NULL ),
+      mStateSize( 0 ),
+      mStoredSize( 0 ),
       mIsDatablock( false )
 {
 }
@@ -43,6 +46,8 @@ void SimObjectMemento::save( SimObject *object )
 {
    // Cleanup any existing state data.
    dFree( mState );
+   mState = NULL;
+   mStateSize = mStoredSize = 0;
    mObjectName = String::EmptyString;
 
    // Use a stream to save the state.
@@ -68,9 +73,45 @@ void SimObjectMemento::save( SimObject *object )
    object->write( stream, 0, writeFlags );
    stream.write( (UTF8)0 );
 
+   mStateSize = stream.getPosition();
+   mObjectName = object->getName();
+
+   // Keep the state compressed if that saves anything.
+   if ( mStateSize >= MinCompressSize )
+   {
+      uLongf packedSize = compressBound( mStateSize );
+      U8 *packed = (U8*)dMalloc( packedSize );
+      if ( compress2( packed, &packedSize, (const U8*)stream.getBuffer(), mStateSize, Z_BEST_SPEED ) == Z_OK &&
+           packedSize < mStateSize )
+      {
+         mState = (UTF8*)dRealloc( packed, packedSize );
+         mStoredSize = packedSize;
+         return;
+      }
+
+      dFree( packed );
+   }
+
    // Steal the data away from the stream.
    mState = (UTF8*)stream.takeBuffer();
-   mObjectName = object->getName();
+   mStoredSize = mStateSize;
+}
+
+UTF8* SimObjectMemento::_unpackState() const
+{
+   if ( mStoredSize == mStateSize )
+      return mState;
+
+   UTF8 *state = (UTF8*)dMalloc( mStateSize );
+   uLongf unpackedSize = mStateSize;
+   if ( uncompress( (U8*)state, &unpackedSize, (const U8*)mState, mStoredSize ) != Z_OK ||
+        unpackedSize != mStateSize )
+   {
+      dFree( state );
+      return NULL;
+   }
+
+   return state;
 }
 
 SimObject *SimObjectMemento::restore() const
@@ -79,6 +120,10 @@ SimObject *SimObjectMemento::restore() const
    if ( !mState )
       return NULL;
 
+   UTF8 *state = _unpackState();
+   if ( !state )
+      return NULL;
+
    // TODO: We could potentially make this faster by
    // caching the CodeBlock generated from the string
 
@@ -95,19 +140,17 @@ SimObject *SimObjectMemento::restore() const
 
       // Read the object.
 
-      const UTF8* result = Con::evaluate( mState );
+      const UTF8* result = Con::evaluate( state );
 
       // Restore the redefine behavior.
 
       Con::setVariable( "$Con::redefineBehavior", oldRedefineBehavior );
 
-      if ( !result || !result[ 0 ] )
-         return NULL;
-
       // Look up the object.
 
-      U32 objectId = dAtoi( result );
-      object = Sim::findObject( objectId );
+      object = NULL;
+      if ( result && result[ 0 ] )
+         object = Sim::findObject( dAtoi( result ) );
    }
    else
    {
@@ -123,33 +166,39 @@ SimObject *SimObjectMemento::restore() const
 
       char* tempBuffer;
       if( !Sim::findObject( objectName ) )
-         tempBuffer = mState;
+         tempBuffer = state;
       else
       {
          String uniqueName = Sim::getUniqueName( objectName );
          U32 uniqueNameLen = uniqueName.length();
 
-         char* pLeftParen = dStrchr( mState, '(' );
+         char* pLeftParen = dStrchr( state, '(' );
          if( pLeftParen == NULL )
+         {
+            if( state != mState )
+               dFree( state );
             return NULL;
-         U32 numCharsToLeftParen = pLeftParen - mState;
+         }
+         U32 numCharsToLeftParen = pLeftParen - state;
 
-         tempBuffer = ( char* ) dMalloc( dStrlen( mState ) + uniqueNameLen + 1 );
-         dMemcpy( tempBuffer, mState, numCharsToLeftParen );
+         tempBuffer = ( char* ) dMalloc( dStrlen( state ) + uniqueNameLen + 1 );
+         dMemcpy( tempBuffer, state, numCharsToLeftParen );
          dMemcpy( &tempBuffer[ numCharsToLeftParen ], uniqueName, uniqueNameLen );
-         dStrcpy( &tempBuffer[ numCharsToLeftParen + uniqueNameLen ], &mState[ numCharsToLeftParen ] );
+         dStrcpy( &tempBuffer[ numCharsToLeftParen + uniqueNameLen ], &state[ numCharsToLeftParen ] );
       }
 
       Con::evaluate( tempBuffer );
 
-      if( tempBuffer != mState )
+      if( tempBuffer != state )
          dFree( tempBuffer );
 
-      if( objectName == String::EmptyString )
-         return NULL;
-
-      object = Sim::findObject( objectName );
+      object = NULL;
+      if( objectName != String::EmptyString )
+         object = Sim::findObject( objectName );
    }
 
+   if ( state != mState )
+      dFree( state );
+
    return object;
 }
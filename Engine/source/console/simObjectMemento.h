@@ -33,17 +33,37 @@
 ///
 /// The success of restoring the object completely depends
 /// on the results from SimObject::write().
+///
+/// Larger states are kept zlib compressed as the script text
+/// for big groups quickly adds up in the editor undo history.
 class SimObjectMemento
 {
 protected:
 
-   /// The captured object state.
+   enum
+   {
+      /// States smaller than this are not worth compressing.
+      MinCompressSize = 512,
+   };
+
+   /// The captured object state which is compressed
+   /// if mStoredSize is smaller than mStateSize.
    UTF8 *mState;
 
+   /// The size of the state text including the terminator.
+   U32 mStateSize;
+
+   /// The number of bytes in mState.
+   U32 mStoredSize;
+
    /// The captured object's name.
    String mObjectName;
    bool mIsDatablock;
 
+   /// Returns the state text which the caller must dFree()
+   /// if it isn't mState or NULL if it couldn't be unpacked.
+   UTF8* _unpackState() const;
+
 public:
 
    SimObjectMemento();
@@ -52,6 +72,9 @@ public:
    /// Returns true if we have recorded state.
    bool hasState() const { return mState; }
 
+   /// Returns the number of bytes used for the recorded state.
+   U32 getMemoryUsage() const { return mStoredSize; }
+
    ///
    void save( SimObject *object );
 
@@ -429,14 +429,8 @@ void SimSet::deleteAllObjects()
 
 SimObject* SimSet::findObject( SimObject* object )
 {
-   bool found = false;
    lock();
-   for( SimSet::iterator iter = begin(); iter != end(); ++ iter )
-      if( *iter == object )
-      {
-         found = true;
-         break;
-      }
+   const bool found = objectList.contains( object );
    unlock();
    
    if( found )
@@ -1085,7 +1079,7 @@ DefineEngineMethod( SimSet, isMember, bool, ( SimObject* obj ),,
    if( !obj )
       return false;
 
-   return ( object->find( object->begin(), object->end(), obj ) != object->end() );
+   return ( object->findObject( obj ) != NULL );
 }
 
 //-----------------------------------------------------------------------------
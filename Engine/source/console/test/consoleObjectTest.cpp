@@ -0,0 +1,78 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "console/simObject.h"
+#include "console/simSet.h"
+
+TEST(AbstractClassRep, FindClassRep)
+{
+   EXPECT_EQ(AbstractClassRep::findClassRep("SimObject"), SimObject::getStaticClassRep());
+   EXPECT_EQ(AbstractClassRep::findClassRep("SIMSET"), SimSet::getStaticClassRep())
+      << "Class names should be case insensitive";
+   EXPECT_TRUE(AbstractClassRep::findClassRep("NoSuchClassAnywhere123") == NULL);
+   EXPECT_TRUE(AbstractClassRep::findClassRep("") == NULL);
+}
+
+TEST(AbstractClassRep, FindField)
+{
+   AbstractClassRep* rep = SimSet::getStaticClassRep();
+   const AbstractClassRep::FieldList& fields = rep->mFieldList;
+   ASSERT_FALSE(fields.empty());
+
+   // Every field should be found at its place in the list (or at the first
+   // field of the same name).
+   for (U32 i = 0; i < fields.size(); i++)
+   {
+      const AbstractClassRep::Field* field = rep->findField(fields[i].pFieldname);
+      ASSERT_TRUE(field != NULL);
+      EXPECT_EQ(field->pFieldname, fields[i].pFieldname);
+      EXPECT_LE(field, &fields[i]);
+   }
+
+   EXPECT_TRUE(rep->findField(StringTable->insert("noSuchFieldAnywhere123")) == NULL);
+}
+
+TEST(AbstractClassRep, CreateUsesObjectPool)
+{
+   AbstractClassRep* rep = SimObject::getStaticClassRep();
+   ConsoleObjectPool* pool = rep->getObjectPool();
+   const U32 numObjects = pool->getNumObjects();
+
+   SimObject* object = static_cast<SimObject*>(rep->create());
+   ASSERT_TRUE(object != NULL);
+   EXPECT_EQ(object->getEngineObjectPool(), static_cast<IEngineObjectPool*>(pool));
+   EXPECT_EQ(pool->getNumObjects(), numObjects + 1);
+   EXPECT_GE(pool->getNumSlabBytes(), (U32)sizeof(SimObject));
+
+   void* memory = object;
+   delete object;
+   EXPECT_EQ(pool->getNumObjects(), numObjects);
+
+   // The memory of the deleted object is handed out next.
+   object = static_cast<SimObject*>(rep->create());
+   EXPECT_EQ(static_cast<void*>(object), memory);
+   delete object;
+}
+
+#endif
@@ -7,6 +7,9 @@
 #include "console/engineAPI.h"
 #include "math/mMath.h"
 #include "console/stringStack.h"
+#include "console/consoleInternal.h"
+#include "console/compiler.h"
+#include "core/stream/memStream.h"
 
 TEST(Con, executef)
 {
@@ -284,4 +287,98 @@ TEST(Con, evaluate)
 
 }
 
+TEST(Con, callSiteCache)
+{
+	Con::evaluate("if (isObject(TestCallSiteObjA)) {\r\nTestCallSiteObjA.delete();\r\n}\r\nif (isObject(TestCallSiteObjB)) {\r\nTestCallSiteObjB.delete();\r\n}\r\nfunction testCallSiteValue() { return 1; }\r\nfunction TestCallSiteA::value(%this) { return \"a\"; }\r\nfunction TestCallSiteB::value(%this) { return \"b\"; }\r\nfunction testCallSiteCall(%obj) { return testCallSiteValue() @ %obj.value(); }\r\nnew ScriptObject(TestCallSiteObjA) { class = TestCallSiteA; };\r\nnew ScriptObject(TestCallSiteObjB) { class = TestCallSiteB; };\r\n", false, "testCallSiteCache");
+
+	const char *returnValue = Con::executef("testCallSiteCall", "TestCallSiteObjA");
+	EXPECT_TRUE(dStricmp(returnValue, "1a") == 0) <<
+		"First call should resolve both call sites";
+
+	returnValue = Con::executef("testCallSiteCall", "TestCallSiteObjB");
+	EXPECT_TRUE(dStricmp(returnValue, "1b") == 0) <<
+		"Method call site should follow the object's namespace";
+
+	returnValue = Con::executef("testCallSiteCall", "TestCallSiteObjA");
+	EXPECT_TRUE(dStricmp(returnValue, "1a") == 0) <<
+		"Method call site should switch back to the first namespace";
+
+	Con::evaluate("function testCallSiteValue() { return 2; }\r\npackage TestCallSitePackage { function TestCallSiteA::value(%this) { return \"p\"; } };\r\n", false, "testCallSiteCache");
+
+	returnValue = Con::executef("testCallSiteCall", "TestCallSiteObjA");
+	EXPECT_TRUE(dStricmp(returnValue, "2a") == 0) <<
+		"Redefining a function should invalidate cached call sites";
+
+	Con::evaluate("activatePackage(TestCallSitePackage);", false, "testCallSiteCache");
+	returnValue = Con::executef("testCallSiteCall", "TestCallSiteObjA");
+	EXPECT_TRUE(dStricmp(returnValue, "2p") == 0) <<
+		"Activating a package should invalidate cached call sites";
+
+	Con::evaluate("deactivatePackage(TestCallSitePackage);", false, "testCallSiteCache");
+	returnValue = Con::executef("testCallSiteCall", "TestCallSiteObjA");
+	EXPECT_TRUE(dStricmp(returnValue, "2a") == 0) <<
+		"Deactivating a package should invalidate cached call sites";
+}
+
+TEST(Con, localSlots)
+{
+	Con::evaluate("function testLocalSlotsLoop(%n) { %sum = 0; for (%i = 0; %i < %n; %i++) %sum += %i; return %sum; }\r\nfunction testLocalSlotsRecurse(%n) { %local = %n; if (%n > 0) testLocalSlotsRecurse(%n - 1); return %local; }\r\nfunction testLocalSlotsEval(%a) { eval(\"%b = %a + 1;\"); return %b; }\r\nfunction testLocalSlotsArgs(%a, %a, %c) { return %a @ %c; }\r\n", false, "testLocalSlots");
+
+	const char *returnValue = Con::executef("testLocalSlotsLoop", 10);
+	EXPECT_TRUE(dStricmp(returnValue, "45") == 0) <<
+		"Locals should keep their values across loop iterations";
+
+	returnValue = Con::executef("testLocalSlotsRecurse", 3);
+	EXPECT_TRUE(dStricmp(returnValue, "3") == 0) <<
+		"Each call frame should have its own locals";
+
+	returnValue = Con::executef("testLocalSlotsEval", 4);
+	EXPECT_TRUE(dStricmp(returnValue, "5") == 0) <<
+		"Locals created by eval should be visible to the function";
+
+	returnValue = Con::executef("testLocalSlotsArgs", "x", "y", "z");
+	EXPECT_TRUE(dStricmp(returnValue, "yz") == 0) <<
+		"Arguments should work with duplicate names";
+}
+
+TEST(Con, fusedLocals)
+{
+	Con::evaluate("function testFusedLocalsInner(%x) { %y = %x * 2; %s = \"v\" @ %y; return %s; }\r\nfunction testFusedLocals(%n) { %out = \"\"; for (%i = 0; %i < %n; %i++) %out = %out @ testFusedLocalsInner(%i); return %out; }\r\n", false, "testFusedLocals");
+
+	// The first run fuses the local loads and stores in place, later runs
+	// execute the fused instructions.
+	for (U32 i = 0; i < 3; i++)
+	{
+		const char *returnValue = Con::executef("testFusedLocals", 3);
+		EXPECT_TRUE(dStricmp(returnValue, "v0v2v4") == 0) <<
+			"Fused local loads and stores should behave like the unfused ones";
+	}
+
+	Namespace::Entry *entry = Namespace::global()->lookup(StringTable->insert("testFusedLocalsInner"));
+	ASSERT_TRUE(entry != NULL);
+	EXPECT_EQ(entry->mCallCount, 9U) <<
+		"Script to script calls should be counted";
+}
+
+TEST(Con, DSOHeader)
+{
+	U8 buffer[16];
+	MemStream stream(sizeof(buffer), buffer);
+	stream.write(U32(Con::DSOVersion));
+	stream.write(CodeBlock::getSourceCRC("echo(1);"));
+
+	U32 version, sourceCRC;
+	stream.setPosition(0);
+	ASSERT_TRUE(CodeBlock::readDSOHeader(stream, version, sourceCRC));
+	EXPECT_EQ(sourceCRC, CodeBlock::getSourceCRC("echo(1);"));
+	EXPECT_NE(sourceCRC, CodeBlock::getSourceCRC("echo(2);")) <<
+		"Changed sources should not match the DSO";
+
+	stream.setPosition(0);
+	stream.write(U32(Con::DSOVersion - 1));
+	stream.setPosition(0);
+	EXPECT_FALSE(CodeBlock::readDSOHeader(stream, version, sourceCRC)) <<
+		"DSOs of other versions should be rejected";
+}
+
 #endif
\ No newline at end of file
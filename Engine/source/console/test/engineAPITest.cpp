@@ -147,4 +147,74 @@ TEST(EngineAPI, _EngineConsoleExecCallbackHelper)
 		"All values should be printed in the correct order";
 }
 
+TEST(EngineAPI, EngineUnMarshallDataTyped)
+{
+	SimObject *foo = new SimObject();
+	foo->registerObject();
+
+	ConsoleValue value;
+	ConsoleValueRef ref;
+	value.init();
+	ref.value = &value;
+
+	value.setIntValue(U32(foo->getId()));
+	EXPECT_TRUE(EngineUnmarshallData<SimObject*>()(ref) == foo)
+		<< "Unmarshalling foo's numeric id should return foo";
+
+	value.setIntValue(U32(0));
+	EXPECT_FALSE(EngineUnmarshallData<bool>()(ref))
+		<< "Integer 0 should be false";
+	value.setFloatValue(0.5f);
+	EXPECT_TRUE(EngineUnmarshallData<bool>()(ref))
+		<< "Float 0.5 should be true";
+	value.setStringValue("true");
+	EXPECT_TRUE(EngineUnmarshallData<bool>()(ref))
+		<< "String true should be true";
+	value.setStringValue("0");
+	EXPECT_FALSE(EngineUnmarshallData<bool>()(ref))
+		<< "String 0 should be false";
+
+	value.setStringValue("1.0000001");
+	EXPECT_EQ(EngineUnmarshallData<F64>()(ref), 1.0000001)
+		<< "F64 strings should keep their precision";
+	value.setFloatValue(2.5f);
+	EXPECT_EQ(EngineUnmarshallData<F64>()(ref), 2.5)
+		<< "F64 should be taken from floats directly";
+
+	value.setIntValue(U32(70000));
+	EXPECT_EQ(EngineUnmarshallData<U16>()(ref), U16(70000))
+		<< "U16 should be truncated like the native cast";
+
+	value.cleanup();
+	foo->deleteObject();
+}
+
+DefineEngineFunction( testEngineAPICallOverhead, S32, ( S32 a, bool b, F32 c, SimObject* obj ),,
+   "@internal Used by the EngineAPI.CallOverhead unit test." )
+{
+   return a + ( b ? 1 : 0 ) + S32( c ) + ( obj ? 1 : 0 );
+}
+
+TEST(EngineAPI, CallOverhead)
+{
+	SimObject *testObject = new SimObject();
+	testObject->registerObject();
+
+	const U32 numCalls = 100000;
+
+	Con::evaluate("function testEngineAPICallOverheadLoop(%count, %obj) { %sum = 0; for (%i = 0; %i < %count; %i++) %sum += testEngineAPICallOverhead(1, true, 2.0, %obj); return %sum; }", false, "testCallOverhead");
+
+	const U32 start = Platform::getRealMilliseconds();
+	const char *returnValue = Con::executef("testEngineAPICallOverheadLoop", numCalls, testObject);
+	const U32 elapsed = Platform::getRealMilliseconds() - start;
+
+	EXPECT_EQ(dAtoi(returnValue), S32(numCalls * 5))
+		<< "All arguments should be unmarshalled correctly";
+
+	Con::printf("EngineAPI: %i calls with S32, bool, F32 and SimObject* arguments in %ims (%.3fus per call)",
+		numCalls, elapsed, F32(elapsed) * 1000.0f / F32(numCalls));
+
+	testObject->deleteObject();
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "console/engineAPI.h"
+#include "console/scriptProfiler.h"
+
+static const ScriptProfiler::FunctionStats* findStats(const Vector<ScriptProfiler::FunctionStats>& stats, const char* function)
+{
+   for (U32 i = 0; i < stats.size(); i++)
+      if (stats[i].mFunction && dStricmp(stats[i].mFunction, function) == 0)
+         return &stats[i];
+   return NULL;
+}
+
+TEST(ScriptProfiler, CallCounts)
+{
+   Con::evaluate("function testProfilerLeaf(%n) { return %n + 1; }\r\n"
+                 "function testProfilerRecurse(%n) { if (%n > 0) return testProfilerRecurse(%n - 1); return testProfilerLeaf(%n); }\r\n"
+                 "function testProfilerRoot() { for (%i = 0; %i < 5; %i++) testProfilerLeaf(%i); return testProfilerRecurse(3); }\r\n",
+                 false, "scriptProfilerTest");
+
+   ScriptProfiler::reset();
+   ScriptProfiler::enable(true);
+   Con::executef("testProfilerRoot");
+   ScriptProfiler::enable(false);
+
+   // Calls made while stopped don't count.
+   Con::executef("testProfilerRoot");
+
+   Vector<ScriptProfiler::FunctionStats> stats;
+   ScriptProfiler::getFunctionStats(stats);
+
+   const ScriptProfiler::FunctionStats* root = findStats(stats, "testProfilerRoot");
+   const ScriptProfiler::FunctionStats* leaf = findStats(stats, "testProfilerLeaf");
+   const ScriptProfiler::FunctionStats* recurse = findStats(stats, "testProfilerRecurse");
+   ASSERT_TRUE(root != NULL && leaf != NULL && recurse != NULL);
+
+   EXPECT_EQ(root->mCallCount, 1U);
+   EXPECT_EQ(leaf->mCallCount, 6U) << "Calls from different callers should add up";
+   EXPECT_EQ(recurse->mCallCount, 4U);
+
+   EXPECT_GE(root->mInclusiveUs, recurse->mInclusiveUs)
+      << "Recursive calls should only be counted once";
+   EXPECT_GE(root->mInclusiveUs, root->mExclusiveUs);
+
+   ScriptProfiler::reset();
+   ScriptProfiler::getFunctionStats(stats);
+   EXPECT_TRUE(stats.empty());
+}
+
+#endif
@@ -0,0 +1,106 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "console/simEventQueue.h"
+#include "math/mRandom.h"
+
+namespace
+{
+   struct TestEvent : public SimEvent
+   {
+      TestEvent(SimTime eventTime, U32 sequence, SimObject* object = NULL)
+      {
+         time = eventTime;
+         sequenceCount = sequence;
+         destObject = object;
+      }
+
+      virtual void process(SimObject*) {}
+   };
+}
+
+TEST(SimEventQueue, Order)
+{
+   SimEventQueue queue;
+   MRandomLCG random(1234);
+
+   // Lots of events at few distinct times so ties are common.
+   const U32 numEvents = 1000;
+   for (U32 i = 1; i <= numEvents; i++)
+      queue.push(new TestEvent(random.randI(0, 20), i));
+   EXPECT_EQ(queue.size(), numEvents);
+
+   // Cancel some of them.
+   for (U32 i = 3; i <= numEvents; i += 7)
+   {
+      SimEvent* event = queue.find(i);
+      ASSERT_TRUE(event != NULL);
+      queue.remove(event);
+      delete event;
+      EXPECT_TRUE(queue.find(i) == NULL);
+   }
+
+   SimTime lastTime = 0;
+   U32 lastSequence = 0;
+   while (!queue.isEmpty())
+   {
+      SimEvent* event = queue.pop();
+      EXPECT_GE(event->time, lastTime) << "Events should come out in time order";
+      if (event->time == lastTime)
+         EXPECT_GT(event->sequenceCount, lastSequence)
+            << "Events due at the same time should come out in posting order";
+      EXPECT_NE(event->sequenceCount % 7, 3U) << "Cancelled events should be gone";
+
+      lastTime = event->time;
+      lastSequence = event->sequenceCount;
+      delete event;
+   }
+}
+
+TEST(SimEventQueue, DeleteEventsFor)
+{
+   SimEventQueue queue;
+   SimObject* a = reinterpret_cast<SimObject*>(0x10);
+   SimObject* b = reinterpret_cast<SimObject*>(0x20);
+
+   for (U32 i = 1; i <= 100; i++)
+      queue.push(new TestEvent(100 - i, i, (i & 1) ? a : b));
+
+   queue.deleteEventsFor(a);
+   EXPECT_EQ(queue.size(), 50U);
+   EXPECT_TRUE(queue.find(1) == NULL);
+   EXPECT_TRUE(queue.find(2) != NULL);
+
+   SimTime lastTime = 0;
+   while (!queue.isEmpty())
+   {
+      SimEvent* event = queue.pop();
+      EXPECT_EQ(event->destObject, b);
+      EXPECT_GE(event->time, lastTime) << "The heap should be intact after removing events";
+      lastTime = event->time;
+      delete event;
+   }
+}
+
+#endif
@@ -0,0 +1,97 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "console/simFieldDictionary.h"
+#include "console/consoleTypes.h"
+
+TEST(SimFieldDictionary, AddRemove)
+{
+   SimFieldDictionary dict;
+   EXPECT_EQ(dict.getFieldValue(StringTable->insert("noSuchField")), (const char*)NULL)
+      << "Empty dictionaries should have no fields";
+
+   const U32 numFields = 100;
+   StringTableEntry names[numFields];
+   char buffer[32];
+   for (U32 i = 0; i < numFields; i++)
+   {
+      dSprintf(buffer, sizeof(buffer), "testField%u", i);
+      names[i] = StringTable->insert(buffer);
+      dSprintf(buffer, sizeof(buffer), "%u", i);
+      dict.setFieldValue(names[i], buffer);
+   }
+   EXPECT_EQ(dict.getNumFields(), numFields);
+
+   SimFieldDictionary::Entry* entry = dict.findDynamicField(names[50]);
+   ASSERT_TRUE(entry != NULL);
+
+   // Remove every other field.
+   for (U32 i = 0; i < numFields; i += 2)
+      dict.setFieldValue(names[i], "");
+   EXPECT_EQ(dict.getNumFields(), numFields / 2);
+
+   for (U32 i = 0; i < numFields; i++)
+   {
+      const char* value = dict.getFieldValue(names[i]);
+      if (i & 1)
+      {
+         ASSERT_TRUE(value != NULL);
+         EXPECT_EQ(dAtoi(value), S32(i)) << "Fields should survive removing others";
+      }
+      else
+         EXPECT_EQ(value, (const char*)NULL);
+   }
+
+   entry = dict.findDynamicField(String("TESTFIELD51"));
+   ASSERT_TRUE(entry != NULL);
+   EXPECT_EQ(entry->slotName, names[51]) << "String lookups should ignore case";
+
+   dict.setFieldType(names[51], TypeS32);
+   EXPECT_EQ(dict.getFieldType(names[51]), (U32)TypeS32);
+   EXPECT_EQ(dict.getFieldType(names[50]), (U32)TypeString);
+}
+
+TEST(SimFieldDictionary, Iterate)
+{
+   SimFieldDictionary dict;
+   char buffer[32];
+   for (U32 i = 0; i < 37; i++)
+   {
+      dSprintf(buffer, sizeof(buffer), "iterField%u", i);
+      dict.setFieldValue(StringTable->insert(buffer), "1");
+   }
+
+   // Removing the current field while iterating must not skip any others.
+   U32 numVisited = 0;
+   for (SimFieldDictionaryIterator itr(&dict); *itr; ++itr)
+   {
+      numVisited++;
+      dict.setFieldValue((*itr)->slotName, "");
+   }
+
+   EXPECT_EQ(numVisited, 37U);
+   EXPECT_EQ(dict.getNumFields(), 0U);
+}
+
+#endif
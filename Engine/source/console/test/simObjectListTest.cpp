@@ -0,0 +1,102 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "console/simObject.h"
+#include "console/simObjectList.h"
+
+FIXTURE(SimObjectList)
+{
+protected:
+   Vector<SimObject*> mObjects;
+
+   void SetUp()
+   {
+      // Enough objects for the list to index its members.
+      for (U32 i = 0; i < 200; i++)
+         mObjects.push_back(new SimObject());
+   }
+
+   void TearDown()
+   {
+      for (U32 i = 0; i < mObjects.size(); i++)
+         delete mObjects[i];
+      mObjects.clear();
+   }
+};
+
+TEST_FIX(SimObjectList, AddRemoveKeepsOrder)
+{
+   SimObjectList list;
+   for (U32 i = 0; i < mObjects.size(); i++)
+      EXPECT_TRUE(list.pushBack(mObjects[i]));
+
+   // Duplicates are rejected whether or not the list is indexed.
+   EXPECT_FALSE(list.pushBack(mObjects[0]));
+   EXPECT_FALSE(list.pushBack(mObjects[150]));
+   EXPECT_EQ(list.size(), mObjects.size());
+
+   // Remove every other object from the middle.
+   for (U32 i = 50; i < 150; i += 2)
+      EXPECT_TRUE(list.remove(mObjects[i]));
+   EXPECT_FALSE(list.remove(mObjects[50]));
+
+   U32 index = 0;
+   for (U32 i = 0; i < mObjects.size(); i++)
+   {
+      const bool removed = i >= 50 && i < 150 && (i % 2) == 0;
+      EXPECT_EQ(list.contains(mObjects[i]), !removed);
+      if (!removed)
+         EXPECT_EQ(list[index++], mObjects[i]);
+   }
+   EXPECT_EQ(index, list.size());
+
+   // Moving an object to the back keeps it a member.
+   EXPECT_FALSE(list.pushBackForce(mObjects[0]));
+   EXPECT_EQ(list.last(), mObjects[0]);
+   EXPECT_TRUE(list.contains(mObjects[0]));
+}
+
+TEST_FIX(SimObjectList, ShrinkBelowThreshold)
+{
+   SimObjectList list;
+   for (U32 i = 0; i < mObjects.size(); i++)
+      list.push_back(mObjects[i]);
+
+   while (list.size() > 1)
+      list.pop_back();
+
+   EXPECT_TRUE(list.contains(mObjects[0]));
+   EXPECT_FALSE(list.contains(mObjects[1]));
+   EXPECT_FALSE(list.contains(mObjects[199]));
+
+   // Growing again indexes the list again.
+   for (U32 i = 1; i < mObjects.size(); i++)
+      EXPECT_TRUE(list.pushBack(mObjects[i]));
+   EXPECT_FALSE(list.pushBack(mObjects[199]));
+
+   list.clear();
+   EXPECT_FALSE(list.contains(mObjects[0]));
+}
+
+#endif
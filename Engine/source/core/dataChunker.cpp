@@ -23,6 +23,21 @@
 #include "platform/platform.h"
 #include "core/dataChunker.h"
 
+#ifdef TORQUE_SIZECLASS_ALLOCATOR
+#  include "core/sizeClassAllocator.h"
+#endif
+
+
+// Blocks all come in the same few sizes so route them through the
+// size-class allocator where available to keep them from fragmenting the heap.
+#ifdef TORQUE_SIZECLASS_ALLOCATOR
+#  define CHUNKER_ALLOC( size ) SizeClassAllocator::alloc( size, SizeClassAllocator::TagChunker )
+#  define CHUNKER_FREE( ptr ) SizeClassAllocator::free( ptr )
+#else
+#  define CHUNKER_ALLOC( size ) dMalloc( size )
+#  define CHUNKER_FREE( ptr ) dFree( ptr )
+#endif
+
 
 //----------------------------------------------------------------------------
 
@@ -30,6 +45,7 @@ DataChunker::DataChunker(S32 size)
 {
    mChunkSize          = size;
    mCurBlock           = NULL;
+   mFreeBlocks         = NULL;
 }
 
 DataChunker::~DataChunker()
@@ -41,9 +57,10 @@ void *DataChunker::alloc(S32 size)
 {
    if (size > mChunkSize)
    {
-      DataBlock * temp = (DataBlock*)dMalloc(DataChunker::PaddDBSize + size);
+      DataBlock * temp = (DataBlock*)CHUNKER_ALLOC(DataChunker::PaddDBSize + size);
       AssertFatal(temp, "Malloc failed");
       constructInPlace(temp);
+      temp->size = size;
       if (mCurBlock)
       {
          temp->next = mCurBlock->next;
@@ -59,10 +76,20 @@ void *DataChunker::alloc(S32 size)
 
    if(!mCurBlock || size + mCurBlock->curIndex > mChunkSize)
    {
-      const U32 paddDBSize = (sizeof(DataBlock) + 3) & ~3;
-      DataBlock *temp = (DataBlock*)dMalloc(paddDBSize+ mChunkSize);
-      AssertFatal(temp, "Malloc failed");
-      constructInPlace(temp);
+      DataBlock *temp = mFreeBlocks;
+      if (temp)
+      {
+         mFreeBlocks = temp->next;
+         temp->curIndex = 0;
+      }
+      else
+      {
+         const U32 paddDBSize = (sizeof(DataBlock) + 3) & ~3;
+         temp = (DataBlock*)CHUNKER_ALLOC(paddDBSize+ mChunkSize);
+         AssertFatal(temp, "Malloc failed");
+         constructInPlace(temp);
+         temp->size = mChunkSize;
+      }
       temp->next = mCurBlock;
       mCurBlock = temp;
    }
@@ -75,6 +102,7 @@ void *DataChunker::alloc(S32 size)
 DataChunker::DataBlock::DataBlock()
 {
    curIndex = 0;
+   size = 0;
    next = NULL;
 }
 
@@ -84,15 +112,22 @@ DataChunker::DataBlock::~DataBlock()
 
 void DataChunker::freeBlocks(bool keepOne)
 {
+   while(mFreeBlocks)
+   {
+      DataBlock *temp = mFreeBlocks->next;
+      CHUNKER_FREE(mFreeBlocks);
+      mFreeBlocks = temp;
+   }
+
    while(mCurBlock && mCurBlock->next)
    {
       DataBlock *temp = mCurBlock->next;
-      dFree(mCurBlock);
+      CHUNKER_FREE(mCurBlock);
       mCurBlock = temp;
    }
    if (!keepOne)
    {
-      if (mCurBlock) dFree(mCurBlock);
+      if (mCurBlock) CHUNKER_FREE(mCurBlock);
       mCurBlock = NULL;
    }
    else if (mCurBlock)
@@ -101,3 +136,20 @@ void DataChunker::freeBlocks(bool keepOne)
       mCurBlock->next = NULL;
    }
 }
+
+void DataChunker::resetBlocks()
+{
+   while(mCurBlock)
+   {
+      DataBlock *temp = mCurBlock->next;
+      if (mCurBlock->size > mChunkSize)
+         CHUNKER_FREE(mCurBlock);
+      else
+      {
+         mCurBlock->curIndex = 0;
+         mCurBlock->next = mFreeBlocks;
+         mFreeBlocks = mCurBlock;
+      }
+      mCurBlock = temp;
+   }
+}
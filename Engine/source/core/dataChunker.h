@@ -53,6 +53,7 @@ public:
    {
       DataBlock* next;        ///< linked list pointer to the next DataBlock for this chunker
       S32 curIndex;           ///< current allocation point within this DataBlock
+      S32 size;               ///< bytes of data space in this DataBlock
       DataBlock();
       ~DataBlock();
       inline U8 *getData();
@@ -77,6 +78,15 @@ public:
    /// This invalidates all pointers returned from alloc().
    void freeBlocks(bool keepOne = false);
 
+   /// Rewind all memory blocks so they can be handed out again.
+   ///
+   /// Unlike freeBlocks() the blocks stay allocated and are reused by the
+   /// following allocations, which makes this the cheap way to recycle a
+   /// chunker that is refilled every frame.  Oversized blocks are released.
+   ///
+   /// This invalidates all pointers returned from alloc().
+   void resetBlocks();
+
    /// Initialize using blocks of a given size.
    ///
    /// One new block is allocated at constructor-time.
@@ -92,6 +102,10 @@ public:
       DataBlock *temp = d.mCurBlock;
       d.mCurBlock = mCurBlock;
       mCurBlock = temp;
+
+      temp = d.mFreeBlocks;
+      d.mFreeBlocks = mFreeBlocks;
+      mFreeBlocks = temp;
    }
    
 public:
@@ -109,7 +123,7 @@ public:
    
    void setChunkSize(U32 size)
    {
-      AssertFatal(mCurBlock == NULL, "Cant resize now");
+      AssertFatal(mCurBlock == NULL && mFreeBlocks == NULL, "Cant resize now");
       mChunkSize = size;
    }
 
@@ -119,6 +133,7 @@ public:
    DataBlock*  mCurBlock;    ///< current page we're allocating data from.  If the
                               ///< data size request is greater than the memory space currently
                               ///< available in the current page, a new page will be allocated.
+   DataBlock*  mFreeBlocks;  ///< pages rewound by resetBlocks() waiting to be reused.
    S32         mChunkSize;    ///< The size allocated for each page in the DataChunker
 };
 
@@ -137,6 +152,9 @@ public:
    Chunker(S32 size = DataChunker::ChunkSize) : DataChunker(size) {};
    T* alloc()  { return reinterpret_cast<T*>(DataChunker::alloc(S32(sizeof(T)))); }
    void clear()  { freeBlocks(); }
+
+   /// Recycle all elements while keeping the memory, see DataChunker::resetBlocks().
+   void reset()  { resetBlocks(); }
 };
 
 //----------------------------------------------------------------------------
@@ -152,7 +170,15 @@ public:
    /// Use like so:  MyType* t = chunker.alloc<MyType>();
    template<typename T>
    T* alloc()  { return reinterpret_cast<T*>(DataChunker::alloc(S32(sizeof(T)))); }
+
+   /// Allocate uninitialized space for @a count elements of type T.
+   template<typename T>
+   T* allocArray(U32 count)  { return reinterpret_cast<T*>(DataChunker::alloc(S32(sizeof(T) * count))); }
+
    void clear()  { freeBlocks(true); }
+
+   /// Recycle all elements while keeping the memory, see DataChunker::resetBlocks().
+   void reset()  { resetBlocks(); }
 };
 
 //----------------------------------------------------------------------------
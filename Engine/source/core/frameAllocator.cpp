@@ -22,6 +22,9 @@
 
 #include "core/frameAllocator.h"
 #include "console/console.h"
+#include "console/engineAPI.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/mutex.h"
 
 U8*   FrameAllocator::smBuffer = NULL;
 U32   FrameAllocator::smWaterMark = 0;
@@ -35,3 +38,119 @@ ConsoleFunction(getMaxFrameAllocation, S32, 1,1, "getMaxFrameAllocation();")
    return FrameAllocator::getMaxFrameAllocation();
 }
 #endif
+
+//-----------------------------------------------------------------------------
+//    ThreadFrameAllocator.
+//-----------------------------------------------------------------------------
+
+ThreadStorage ThreadFrameAllocator::smThreadArena;
+U32 ThreadFrameAllocator::smArenaSize = TORQUE_THREAD_FRAME_SIZE;
+U32 ThreadFrameAllocator::smFrame = 0;
+
+/// List of all arenas.  Only touched when threads register their arena,
+/// so a plain mutex is fine.
+static ThreadFrameAllocator::Arena* sgArenas = NULL;
+static Mutex sgArenaMutex;
+
+//-----------------------------------------------------------------------------
+
+void ThreadFrameAllocator::init( const U32 arenaSize )
+{
+   AssertFatal( sgArenas == NULL, "ThreadFrameAllocator::init - Arenas already in use" );
+   smArenaSize = arenaSize;
+}
+
+//-----------------------------------------------------------------------------
+
+void ThreadFrameAllocator::destroy()
+{
+   MutexHandle lock;
+   lock.lock( &sgArenaMutex, true );
+
+   while( sgArenas )
+   {
+      Arena* arena = sgArenas;
+      sgArenas = arena->next;
+
+      delete [] arena->buffer;
+      delete arena;
+   }
+
+   // Only clears the slot of the calling thread.  Other threads must not
+   // touch the allocator anymore.
+   smThreadArena.set( NULL );
+}
+
+//-----------------------------------------------------------------------------
+
+ThreadFrameAllocator::Arena* ThreadFrameAllocator::_createArena()
+{
+   Arena* arena = new Arena;
+   arena->buffer = new U8[ smArenaSize ];
+   arena->size = smArenaSize;
+   arena->waterMark = 0;
+   arena->frame = smFrame;
+   arena->framePeak = 0;
+   arena->lastFramePeak = 0;
+   arena->maxPeak = 0;
+   arena->threadId = ThreadManager::getCurrentThreadId();
+
+   smThreadArena.set( arena );
+
+   MutexHandle lock;
+   lock.lock( &sgArenaMutex, true );
+
+   arena->next = sgArenas;
+   sgArenas = arena;
+
+   return arena;
+}
+
+//-----------------------------------------------------------------------------
+
+void ThreadFrameAllocator::beginFrame()
+{
+   // Arenas reset themselves when their thread next touches them.  Fold
+   // the peaks into the lifetime maximum here so stats stay meaningful for
+   // threads that were idle.
+
+   MutexHandle lock;
+   lock.lock( &sgArenaMutex, true );
+
+   for( Arena* arena = sgArenas; arena != NULL; arena = arena->next )
+      arena->maxPeak = getMax( arena->maxPeak, arena->framePeak );
+
+   smFrame ++;
+}
+
+//-----------------------------------------------------------------------------
+
+void ThreadFrameAllocator::dumpArenas()
+{
+   MutexHandle lock;
+   lock.lock( &sgArenaMutex, true );
+
+   Con::printf( "ThreadFrameAllocator arenas (%i bytes each):", smArenaSize );
+
+   U32 numArenas = 0;
+   for( Arena* arena = sgArenas; arena != NULL; arena = arena->next )
+   {
+      Con::printf( "   thread %u: last frame %u, max %u bytes (%.1f%%)",
+         arena->threadId,
+         arena->lastFramePeak,
+         getMax( arena->maxPeak, arena->framePeak ),
+         F32( getMax( arena->maxPeak, arena->framePeak ) ) * 100.0f / F32( arena->size ) );
+      numArenas ++;
+   }
+
+   Con::printf( "%i arenas", numArenas );
+}
+
+//-----------------------------------------------------------------------------
+
+DefineEngineFunction( dumpThreadFrameAllocators, void, (),,
+   "Print the high-water marks of the per-thread frame allocator arenas to the console.\n"
+   "@ingroup Debugging" )
+{
+   ThreadFrameAllocator::dumpArenas();
+}
@@ -26,6 +26,9 @@
 #ifndef _PLATFORM_H_
 #include "platform/platform.h"
 #endif
+#ifndef _PLATFORMTLS_H_
+#include "platform/platformTLS.h"
+#endif
 
 /// This #define is used by the FrameAllocator to align starting addresses to
 /// be byte aligned to this value. This is important on the 360 and possibly
@@ -181,6 +184,184 @@ public:
    }
 };
 
+/// Default size of each thread's ThreadFrameAllocator arena.  Can be
+/// overridden in torqueConfig.h.
+#ifndef TORQUE_THREAD_FRAME_SIZE
+   #define TORQUE_THREAD_FRAME_SIZE 1 << 20
+#endif
+
+/// Per-thread variant of the FrameAllocator.
+///
+/// FrameAllocator uses a single global watermark and thus must only be used
+/// from the main thread.  ThreadFrameAllocator gives every thread that uses it
+/// its own arena, so code running on worker threads (e.g. JobSystem jobs) can
+/// grab scratch memory without taking locks or going to the heap.
+///
+/// Arenas are created lazily on the first allocation from a thread.  They are
+/// reset by their owning thread on first use after the main loop calls
+/// beginFrame(), so every frame starts out with empty arenas.  Any memory
+/// obtained from the allocator must thus not be held across frames.
+///
+/// Usage follows the FrameAllocator; prefer ThreadFrameAllocatorMarker to
+/// restore the watermark automatically:
+///
+/// @code
+///   ThreadFrameAllocatorMarker mem;
+///   F32* temp = mem.alloc< F32 >( numVerts * 3 );
+/// @endcode
+class ThreadFrameAllocator
+{
+  public:
+
+   /// Arena of a single thread.
+   struct Arena
+   {
+      U8* buffer;
+      U32 size;
+      U32 waterMark;
+
+      /// Frame for which the arena was last reset.
+      U32 frame;
+
+      /// Peak watermark in the current frame.
+      U32 framePeak;
+
+      /// Peak watermark in the last completed frame.
+      U32 lastFramePeak;
+
+      /// Peak watermark over the lifetime of the arena.
+      U32 maxPeak;
+
+      /// ID of the owning thread.
+      U32 threadId;
+
+      /// Next arena in the list of all arenas.
+      Arena* next;
+   };
+
+  protected:
+
+   static ThreadStorage smThreadArena;
+   static U32 smArenaSize;
+   static U32 smFrame;
+
+   /// Create and register the arena for the current thread.
+   static Arena* _createArena();
+
+   /// Return the current thread's arena, resetting it if a new frame has begun.
+   inline static Arena* _getArena();
+
+  public:
+
+   /// Set the size of the arenas.  Must be called before any thread has
+   /// allocated from the allocator.
+   static void init( const U32 arenaSize );
+
+   /// Release all arenas.  No other thread must be using the allocator.
+   static void destroy();
+
+   /// Start a new frame.  Called by the main loop; all threads must have
+   /// released their allocations by then.
+   static void beginFrame();
+
+   inline static void* alloc( const U32 allocSize );
+
+   inline static void setWaterMark( const U32 waterMark );
+   inline static U32  getWaterMark();
+
+   /// Return the size of each thread's arena.
+   static U32 getArenaSize() { return smArenaSize; }
+
+   /// Return the peak watermark of the current thread in the current frame.
+   inline static U32 getHighWaterMark();
+
+   /// Print the watermarks of all arenas to the console.
+   static void dumpArenas();
+};
+
+ThreadFrameAllocator::Arena* ThreadFrameAllocator::_getArena()
+{
+   Arena* arena = reinterpret_cast< Arena* >( smThreadArena.get() );
+   if( !arena )
+      arena = _createArena();
+
+   if( arena->frame != smFrame )
+   {
+      AssertFatal( arena->waterMark == 0,
+         "ThreadFrameAllocator - Allocation held across frames; someone didn't reset the water mark!" );
+
+      arena->lastFramePeak = arena->framePeak;
+      arena->framePeak = 0;
+      arena->waterMark = 0;
+      arena->frame = smFrame;
+   }
+
+   return arena;
+}
+
+void* ThreadFrameAllocator::alloc( const U32 allocSize )
+{
+   Arena* arena = _getArena();
+
+   U32 waterMark = ( arena->waterMark + ( FRAMEALLOCATOR_BYTE_ALIGNMENT - 1 ) ) & (~( FRAMEALLOCATOR_BYTE_ALIGNMENT - 1 ));
+   AssertFatal( waterMark + allocSize <= arena->size, "ThreadFrameAllocator - Alloc too large, increase TORQUE_THREAD_FRAME_SIZE!" );
+
+   U8* p = &arena->buffer[ waterMark ];
+   arena->waterMark = waterMark + allocSize;
+
+   if( arena->waterMark > arena->framePeak )
+      arena->framePeak = arena->waterMark;
+
+   return p;
+}
+
+void ThreadFrameAllocator::setWaterMark( const U32 waterMark )
+{
+   Arena* arena = _getArena();
+   AssertFatal( waterMark <= arena->waterMark, "ThreadFrameAllocator - Invalid waterMark" );
+   arena->waterMark = waterMark;
+}
+
+U32 ThreadFrameAllocator::getWaterMark()
+{
+   return _getArena()->waterMark;
+}
+
+U32 ThreadFrameAllocator::getHighWaterMark()
+{
+   return _getArena()->framePeak;
+}
+
+/// Helper class to deal with ThreadFrameAllocator usage.
+///
+/// Works the same as FrameAllocatorMarker but on the current thread's arena.
+class ThreadFrameAllocatorMarker
+{
+   U32 mMarker;
+
+public:
+   ThreadFrameAllocatorMarker()
+   {
+      mMarker = ThreadFrameAllocator::getWaterMark();
+   }
+
+   ~ThreadFrameAllocatorMarker()
+   {
+      ThreadFrameAllocator::setWaterMark(mMarker);
+   }
+
+   void* alloc(const U32 allocSize) const
+   {
+      return ThreadFrameAllocator::alloc(allocSize);
+   }
+
+   template<typename T>
+   T* alloc(const U32 numElements) const
+   {
+      return reinterpret_cast<T *>(ThreadFrameAllocator::alloc(numElements * sizeof(T)));
+   }
+};
+
 /// Class for temporary variables that you want to allocate easily using
 /// the FrameAllocator. For example:
 /// @code
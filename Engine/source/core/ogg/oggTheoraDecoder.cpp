@@ -27,6 +27,10 @@
 #include "math/mMathFn.h"
 #include "console/console.h"
 
+#if defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 )
+   #include <emmintrin.h>
+#endif
+
 
 //#define DEBUG_SPEW
 
@@ -39,7 +43,7 @@
 // For the SSE2 code, the data must be 16 byte aligned.
 //
 // The clamping table is only used by the generic transcoder.  The SSE2 transcoder
-// uses instructions to implicitly clamp out-of-range values.
+// uses saturating packs to implicitly clamp out-of-range values.
 
 dALIGN( static S32 sRGBY[ 256 ][ 4 ] );
 dALIGN( static S32 sRGBCb[ 256 ][ 4 ] );
@@ -84,7 +88,7 @@ static void initLookupTables()
 
 static inline S32 sampleG( U8* pCb, U8* pCr )
 {
-   return sRGBCr[ *pCr ][ 1 ] + sRGBCr[ *pCb ][ 1 ];
+   return sRGBCr[ *pCr ][ 1 ] + sRGBCb[ *pCb ][ 1 ];
 }
 
 //=============================================================================
@@ -285,13 +289,15 @@ U32 OggTheoraDecoder::read( OggTheoraFrame** buffer, U32 num )
       
       // Transcode the packet.
       
-      #if ( defined( TORQUE_COMPILER_GCC ) || defined( TORQUE_COMPILER_VISUALC ) ) && (defined( TORQUE_CPU_X86 ) )      
+      #if defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 )
       if(      ( mTranscoder == TRANSCODER_Auto || mTranscoder == TRANSCODER_SSE2420RGBA ) &&
                getDecoderPixelFormat() == PIXEL_FORMAT_420 &&
                Platform::SystemInfo.processor.properties & CPU_PROP_SSE2 &&
                mPacketFormat.mFormat == GFXFormatR8G8B8A8 &&
-               mTheoraInfo.pic_x == 0 &&
-               mTheoraInfo.pic_y == 0 )
+               width % 2 == 0 &&
+               height % 2 == 0 &&
+               mTheoraInfo.pic_x % 2 == 0 &&
+               mTheoraInfo.pic_y % 2 == 0 )
       {
          _transcode420toRGBA_SSE2( ycbcr, ( U8* ) packet->data, width, height, mPacketFormat.mPitch );
       }
@@ -419,276 +425,61 @@ void OggTheoraDecoder::_transcode( th_ycbcr_buffer ycbcr, U8* buffer, const U32
 }
 
 //-----------------------------------------------------------------------------
-#if defined( TORQUE_CPU_X86 )
+#if defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 )
 void OggTheoraDecoder::_transcode420toRGBA_SSE2( th_ycbcr_buffer ycbcr, U8* buffer, U32 width, U32 height, U32 pitch )
 {
    AssertFatal( width % 2 == 0, "OggTheoraDecoder::_transcode420toRGBA_SSE2() - width must be multiple of 2" );
    AssertFatal( height % 2 == 0, "OggTheoraDecoder::_transcode420toRGBA_SSE2() - height must be multiple of 2" );
-      
-   unsigned char* ydata = ycbcr[ 0 ].data;
-   unsigned char* udata = ycbcr[ 1 ].data;
-   unsigned char* vdata = ycbcr[ 2 ].data;
-   
-   S32* ycoeff = ( S32* ) sRGBY;
-   S32* ucoeff = ( S32* ) sRGBCb;
-   S32* vcoeff = ( S32* ) sRGBCr;
-      
-   // At the end of a line loop, we need to jump over the padding resulting from the difference
-   // between pitch and width plus jump a whole scanline as we always operate two scanlines
-   // at a time.
-   const U32 stride = pitch - width * 4 + pitch;
-   
-   // Same thing for the Y channel.
-   const U32 ystrideDelta = ycbcr[ 0 ].stride - width + ycbcr[ 0 ].stride;
+
+   const __m128i* ycoeff = ( const __m128i* ) sRGBY;
+   const __m128i* ucoeff = ( const __m128i* ) sRGBCb;
+   const __m128i* vcoeff = ( const __m128i* ) sRGBCr;
+
+   const U32 pictOffsetY = _getPictureOffset( ycbcr, 0 );
+   const U32 pictOffsetU = _getPictureOffset( ycbcr, 1 );
+   const U32 pictOffsetV = _getPictureOffset( ycbcr, 2 );
+
    const U32 ypitch = ycbcr[ 0 ].stride;
-   
-   // U and V only jump a single scanline so we only need to advance by the padding on the
-   // right.  Both planes are half-size.
-   const U32 ustrideDelta = ycbcr[ 1 ].stride - width / 2;
-   const U32 vstrideDelta = ycbcr[ 2 ].stride - width / 2;
-         
-   #if defined( TORQUE_COMPILER_VISUALC ) && defined( TORQUE_CPU_X86 )
 
-   __asm
+   // Each iteration converts a 2x2 block of pixels sharing the same Cb and Cr sample.
+
+   for( U32 y = 0; y < height; y += 2 )
    {
-         mov ecx,height
+      U8* dst0 = buffer + y * pitch;
+      U8* dst1 = dst0 + pitch;
 
-      hloop:
+      const U8* pY = _getPixelPtr( ycbcr, 0, pictOffsetY, 0, y );
+      const U8* pU = _getPixelPtr( ycbcr, 1, pictOffsetU, 0, y );
+      const U8* pV = _getPixelPtr( ycbcr, 2, pictOffsetV, 0, y );
 
-         push ecx
-         mov ecx,width
+      for( U32 x = 0; x < width; x += 2 )
+      {
+         // Accumulate coefficients for U and V.
 
-      wloop:
+         const __m128i uv = _mm_add_epi32( _mm_load_si128( &ucoeff[ *pU ] ), _mm_load_si128( &vcoeff[ *pV ] ) );
 
-         push ecx
-         xor eax,eax
-         
-         // Load and accumulate coefficients for U and V in XMM0.
-         
-         mov esi,udata
-         mov ebx,ucoeff
-         mov edx,ydata
-         mov al,[esi]
-         xor ecx,ecx
-         mov edi,vdata
-         shl eax,4
-         movdqa xmm0,[ebx+eax]
-
-         mov ebx,vcoeff
-         mov cl,[edi]
-         mov esi,ycoeff
-         shl ecx,4
-         paddd xmm0,[ebx+ecx]
-         xor eax,eax
-         xor ebx,ebx
-         
-         // Load coefficients for Y of the four pixels into XMM1-XMM4.
-         
-         mov ecx,ypitch
-         mov al,[edx]
-         mov bl,[edx+1]
-         shl eax,4
-         shl ebx,4
-         movdqa xmm1,[esi+eax]
-         movdqa xmm2,[esi+ebx]
-         xor eax,eax
-         xor ebx,ebx
-         
-         mov al,[edx+ecx]
-         mov bl,[edx+ecx+1]
-         shl eax,4
-         shl ebx,4
-         movdqa xmm3,[esi+eax]
-         movdqa xmm4,[esi+ebx]
-
-         mov edi,buffer
-         mov ecx,pitch
-         
-         // Add Cb and Cr on top of Y.
-         
-         paddd xmm1,xmm0
-         paddd xmm2,xmm0
-         paddd xmm3,xmm0
-         paddd xmm4,xmm0
-                  
-         // Pack pixels together.  We need to pack twice per pixel
-         // to go from 32bits via 16bits to 8bits.
-         //
-         // Right now we're simply packing two garbage pixels for the
-         // second packing operation.  An alternative would be to pack the
-         // four pixels into one XMM register and then do a packed shuffle
-         // to split out the lower two pixels before the move.
-         
-         packssdw xmm1,xmm2
-         packssdw xmm3,xmm4
-         packuswb xmm1,xmm6
-         packuswb xmm3,xmm7
-         
-         // Store pixels.
-   
-         movq qword ptr [edi],xmm1
-         movq qword ptr [edi+ecx],xmm3
-         
-         // Loop width.
-         
-         pop ecx
+         // Add Cb and Cr on top of Y of the four pixels.
 
-         add ydata,2
-         inc udata
-         inc vdata
-         add buffer,8
+         const __m128i p00 = _mm_add_epi32( _mm_load_si128( &ycoeff[ pY[ 0 ] ] ), uv );
+         const __m128i p01 = _mm_add_epi32( _mm_load_si128( &ycoeff[ pY[ 1 ] ] ), uv );
+         const __m128i p10 = _mm_add_epi32( _mm_load_si128( &ycoeff[ pY[ ypitch ] ] ), uv );
+         const __m128i p11 = _mm_add_epi32( _mm_load_si128( &ycoeff[ pY[ ypitch + 1 ] ] ), uv );
 
-         sub ecx,2
-         jnz wloop
-         
-         // Loop height.
-     
-         pop ecx
-
-         mov ebx,stride
-         mov eax,ystrideDelta
-         mov edi,ustrideDelta
-         mov esi,vstrideDelta
-
-         add buffer,ebx
-         add ydata,eax
-         add udata,edi
-         add vdata,esi
-  
-         sub ecx,2
-         jnz hloop
-   };
-   
-   #elif defined( TORQUE_COMPILER_GCC ) && defined( TORQUE_CPU_X86 ) 
+         // Pack down from 32bits via 16bits to 8bits, clamping on the way.
+         // The upper scanline ends up in the low and the lower scanline in
+         // the high quadword.
 
-   asm(  "pushal\n"                                // Save all general-purpose registers.
-         
-         "movl %0,%%ecx\n"                         // Load height into ECX.
-         
-      ".hloop_sse:\n"
-      
-         "pushl %%ecx\n"                           // Save counter.
-         "movl %1,%%ecx\n"                         // Load width into ECX.
-         
-      ".wloop_sse:\n"
-      
-         "pushl %%ecx\n"                           // Save counter.
-         "xorl %%eax,%%eax\n"                      // Zero out eax for later use.
-         
-         // Load and accumulate coefficients for U and V in XMM0.
-         
-         "movl %3,%%esi\n"                         // Load U pointer into ESI.
-         "movl %8,%%ebx\n"                         // Load U coefficient table into EBX.
-         "movl %2,%%edx\n"                         // Load Y pointer into EDX.
-         "movb (%%esi),%%al\n"                     // Load U into AL.
-         "xorl %%ecx,%%ecx\n"                      // Clear ECX.
-         "movl %4,%%edi\n"                         // Load V pointer into EDI.
-         "shll $4,%%eax\n"                         // Multiply EAX by 16 to index into table.
-         "movdqa (%%ebx,%%eax),%%xmm0\n"           // Load Cb coefficient into XMM0.
-         
-         "movl %9,%%ebx\n"                         // Load V coefficients table into EBX.
-         "movb (%%edi),%%cl\n"                     // Load V into CL.
-         "movl %7,%%esi\n"                         // Load Y coefficients table into ESI.
-         "shll $4,%%ecx\n"                         // Multiply ECX by 16 to index into table.
-         "paddd (%%ebx,%%ecx),%%xmm0\n"            // Add Cr coefficient to Cb coefficient.
-         "xorl %%eax,%%eax\n"                      // Clear EAX.
-         "xorl %%ebx,%%ebx\n"                      // Clear EBX.
-         
-         // Load coefficients for Y of the four pixels into XMM1-XMM4.
-         
-         "movl %14,%%ecx\n"                        // Load Y pitch into ECX (needed later for lower two pixels).
-         "movb (%%edx),%%al\n"                     // Load upper-left pixel Y into AL.
-         "movb 1(%%edx),%%bl\n"                    // Load upper-right pixel Y into BL.
-         "shll $4,%%eax\n"                         // Multiply EAX by 16 to index into table.
-         "shll $4,%%ebx\n"                         // Multiply EBX by 16 to index into table.
-         "movdqa (%%esi,%%eax),%%xmm1\n"           // Load coefficient for upper-left pixel Y into XMM1.
-         "movdqa (%%esi,%%ebx),%%xmm2\n"           // Load coefficient for upper-right pixel Y into XMM2.
-         "xorl %%eax,%%eax\n"                      // Clear EAX.
-         "xorl %%ebx,%%ebx\n"                      // Clear EBX.
-         
-         "movb (%%edx,%%ecx),%%al\n"               // Load lower-left pixel Y into AL.
-         "movb 1(%%edx,%%ecx),%%bl\n"              // Load lower-right pixel Y into AL.
-         "shll $4,%%eax\n"                         // Multiply EAX by 16 to index into table.
-         "shll $4,%%ebx\n"                         // Multiply EBX by 16 to index into table.
-         "movdqa (%%esi,%%eax),%%xmm3\n"           // Load coefficient for lower-left pixel Y into XMM3.
-         "movdqa (%%esi,%%ebx),%%xmm4\n"           // Load coefficient for lower-right pixel Y into XMM4.
-         
-         "movl %5,%%edi\n"                         // Load buffer pointer into EDI (for later use).
-         "movl %6,%%ecx\n"                         // Load pitch into ECX (for later use).
-         
-         // Add Cb and Cr on top of Y.
-         
-         "paddd %%xmm0,%%xmm1\n"                   // Add chroma channels to upper-left pixel.
-         "paddd %%xmm0,%%xmm2\n"                   // Add chroma channels to upper-right pixel.
-         "paddd %%xmm0,%%xmm3\n"                   // Add chroma channels to lower-left pixel.
-         "paddd %%xmm0,%%xmm4\n"                   // Add chroma channels to lower-right pixel.
-                  
-         // Pack pixels together.  We need to pack twice per pixel
-         // to go from 32bits via 16bits to 8bits.
-         //
-         // Right now we're simply packing two garbage pixels for the
-         // second packing operation.  An alternative would be to pack the
-         // four pixels into one XMM register and then do a packed shuffle
-         // to split out the lower two pixels before the move.
-         
-         "packssdw %%xmm2,%%xmm1\n"                // Pack 32bit channels together into 16bit channels on upper two pixels.
-         "packssdw %%xmm4,%%xmm3\n"                // Pack 32bit channels together into 16bit channels on lower two pixels.
-         "packuswb %%xmm6,%%xmm1\n"                // Pack 16bit channels together into 8bit channels on upper two pixels (plus two garbage pixels).
-         "packuswb %%xmm7,%%xmm3\n"                // Pack 16bit channels together into 8bit channels on lower two pixels (plus two garbage pixels).
-         
-         // Store pixels.
-         
-         "movq %%xmm1,(%%edi)\n"                    // Store upper two pixels.
-         "movq %%xmm3,(%%edi,%%ecx)\n"              // Store lower two pixels.
-         
-         // Loop width.
-         
-         "popl %%ecx\n"                            // Restore width counter.
-         
-         "addl $2,%2\n"                            // Bump Y pointer by two pixels (1 bpp).
-         "incl %3\n"                               // Bump U pointer by one pixel (1 bpp).
-         "incl %4\n"                               // Bump V pointer by one pixel (1 bpp).
-         "addl $8,%5\n"                            // Bump buffer pointer by two pixels (4 bpp).
+         const __m128i pixels = _mm_packus_epi16( _mm_packs_epi32( p00, p01 ), _mm_packs_epi32( p10, p11 ) );
 
-         "subl $2,%%ecx\n"
-         "jnz .wloop_sse\n"
-         
-         // Loop height.
-         
-         "popl %%ecx\n"                            // Restore height counter.
+         _mm_storel_epi64( ( __m128i* ) dst0, pixels );
+         _mm_storel_epi64( ( __m128i* ) dst1, _mm_srli_si128( pixels, 8 ) );
 
-         "movl %10,%%ebx\n"                        // Load buffer stride into EBX.
-         "movl %11,%%eax\n"                        // Load Y stride delta into EAX.
-         "movl %12,%%edi\n"                        // Load U stride delta into EDI.
-         "movl %13,%%esi\n"                        // Load V stride delta into ESI.
-         
-         "addl %%ebx,%5\n"                         // Bump buffer pointer by stride delta.
-         "addl %%eax,%2\n"                         // Bump Y pointer by stride delta.
-         "addl %%edi,%3\n"                         // Bump U pointer by stride delta.
-         "addl %%esi,%4\n"                         // Bump V pointer by stride delta.
-         
-         "subl $2,%%ecx\n"
-         "jnz .hloop_sse\n"
-         
-         "popal\n"
-      :
-      : "m" ( height ),                                        // 0
-        "m" ( width ),                                         // 1
-        "m" ( ydata ),                                         // 2
-        "m" ( udata ),                                         // 3
-        "m" ( vdata ),                                         // 4
-        "m" ( buffer ),                                        // 5
-        "m" ( pitch ),                                         // 6
-        "m" ( ycoeff ),                                        // 7
-        "m" ( ucoeff ),                                        // 8
-        "m" ( vcoeff ),                                        // 9
-        "m" ( stride ),                                        // 10
-        "m" ( ystrideDelta ),                                  // 11
-        "m" ( ustrideDelta ),                                  // 12
-        "m" ( vstrideDelta ),                                  // 13
-        "m" ( ypitch )                                         // 14
-   );
-   
-   #endif
+         pY += 2;
+         ++ pU;
+         ++ pV;
+         dst0 += 8;
+         dst1 += 8;
+      }
+   }
 }
-#endif
\ No newline at end of file
+#endif
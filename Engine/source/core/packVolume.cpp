@@ -0,0 +1,749 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "core/packVolume.h"
+
+#include "core/crc.h"
+#include "core/util/endian.h"
+#include "core/util/fourcc.h"
+#include "core/util/hashFunction.h"
+#include "core/util/noncopyable.h"
+#include "console/console.h"
+#include "console/engineAPI.h"
+
+#include "zlib.h"
+
+
+namespace Torque
+{
+namespace FS
+{
+
+namespace
+{
+   const U32 sPackMagic = MakeFourCC( 'T', 'P', 'A', 'K' );
+   const String sPackExt( "tpk" );
+
+   struct PackHeader
+   {
+      U32 magic;
+      U32 version;
+      U32 numEntries;
+      U32 indexOffset;
+      U32 namesOffset;
+      U32 namesSize;
+      U32 reserved[2];
+   };
+
+   /// Converts a struct made of U32s between little endian and the host.
+   template< class T >
+   inline void _swapFields( T &fields )
+   {
+      U32 *values = reinterpret_cast< U32* >( &fields );
+      for ( U32 i=0; i < sizeof( T ) / sizeof( U32 ); i++ )
+         values[i] = convertLEndianToHost( values[i] );
+   }
+
+   /// Returns the path of @a path relative to its root without a leading slash.
+   String _getPackName( const Path &path )
+   {
+      String name = path.getFullPathWithoutRoot();
+      while ( name.isNotEmpty() && name[0] == '/' )
+         name = name.substr( 1 );
+      while ( name.isNotEmpty() && name[ name.length() - 1 ] == '/' )
+         name = name.substr( 0, name.length() - 1 );
+      return name;
+   }
+
+   /// Splits @a name at its last slash.
+   void _splitName( const String &name, String &outDir, String &outLeaf )
+   {
+      const String::SizeType slash = name.find( '/', 0, String::Right );
+      if ( slash == String::NPos )
+      {
+         outDir = String::EmptyString;
+         outLeaf = name;
+      }
+      else
+      {
+         outDir = name.substr( 0, slash );
+         outLeaf = name.substr( slash + 1 );
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+// PackFile class (Internal)
+//-----------------------------------------------------------------------------
+
+class PackFile : public File, public Noncopyable
+{
+public:
+
+   PackFile( PackFileSystem *fs, U32 index, const Path &path )
+      :  mFileSystemRef( fs ),
+         mFileSystem( fs ),
+         mEntry( fs->mEntries[index] ),
+         mPath( path ),
+         mPosition( 0 ),
+         mStatus( Closed ),
+         mBlock( -1 )
+   {
+   }
+
+   virtual ~PackFile()
+   {
+      close();
+   }
+
+   virtual Path getName() const { return mPath; }
+   virtual NodeStatus getStatus() const { return mStatus; }
+
+   virtual bool getAttributes( Attributes *attr )
+   {
+      if ( !attr )
+         return false;
+
+      attr->flags = FileNode::File | FileNode::ReadOnly;
+      if ( mEntry.flags & PackFileSystem::EntryCompressed )
+         attr->flags |= FileNode::Compressed;
+      attr->name = mPath.getFullPath();
+      attr->mtime = mFileSystem->mModTime;
+      attr->atime = mFileSystem->mModTime;
+      attr->size = mEntry.size;
+
+      return true;
+   }
+
+   virtual U32 getPosition() { return mPosition; }
+
+   virtual U32 setPosition( U32 pos, SeekMode mode )
+   {
+      if ( mStatus != Open && mStatus != EndOfFile )
+         return 0;
+
+      switch ( mode )
+      {
+         case Begin:    mPosition = pos; break;
+         case Current:  mPosition += pos; break;
+         case End:      mPosition = mEntry.size - getMin( pos, mEntry.size ); break;
+      }
+
+      mPosition = getMin( mPosition, mEntry.size );
+      mStatus = ( mPosition < mEntry.size ? Open : EndOfFile );
+      return mPosition;
+   }
+
+   virtual bool open( AccessMode mode )
+   {
+      if ( mode != Read )
+      {
+         Con::errorf( "PackFileSystem: Write access denied for file %s", mPath.getFullPath().c_str() );
+         return false;
+      }
+
+      mPosition = 0;
+      mStatus = ( mEntry.size ? Open : EndOfFile );
+      return true;
+   }
+
+   virtual bool close()
+   {
+      unmap();
+      mBlockData.clear();
+      mCompressed.clear();
+      mBlock = -1;
+      mStatus = Closed;
+      return true;
+   }
+
+   virtual U32 read( void *dst, U32 size )
+   {
+      if ( mStatus != Open && mStatus != EndOfFile )
+         return 0;
+
+      size = getMin( size, mEntry.size - mPosition );
+
+      U32 done = 0;
+      if ( !( mEntry.flags & PackFileSystem::EntryCompressed ) )
+      {
+         if ( size && mFileSystem->_read( mEntry.dataOffset + mPosition, dst, size ) )
+            done = size;
+      }
+      else
+      {
+         while ( done < size )
+         {
+            const U32 pos = mPosition + done;
+            const U32 block = pos / PackFileSystem::BlockSize;
+            if ( block != mBlock && !_loadBlock( block ) )
+               break;
+
+            const U32 offset = pos - block * PackFileSystem::BlockSize;
+            const U32 count = getMin( size - done, mBlockData.size() - offset );
+            dMemcpy( ( U8* ) dst + done, mBlockData.address() + offset, count );
+            done += count;
+         }
+      }
+
+      mPosition += done;
+      if ( mStatus == Open && mPosition >= mEntry.size )
+         mStatus = EndOfFile;
+
+      return done;
+   }
+
+   virtual U32 write( const void *src, U32 size ) { return 0; }
+
+   virtual U8* map( U32 &outSize )
+   {
+      outSize = 0;
+
+      // Only stored files can be mapped.  Every file gets a private
+      // mapping of its own, since users may change the memory.
+      if ( mStatus == Closed || ( mEntry.flags & PackFileSystem::EntryCompressed ) || !mEntry.size )
+         return NULL;
+
+      if ( mMapFile == NULL )
+      {
+         mMapFile = OpenFile( mFileSystem->mPackFilename, File::Read );
+         if ( mMapFile == NULL )
+            return NULL;
+      }
+
+      U32 mappedSize;
+      U8 *mapped = mMapFile->map( mappedSize );
+      if ( !mapped || mappedSize < mEntry.dataOffset + mEntry.size )
+      {
+         mMapFile = NULL;
+         return NULL;
+      }
+
+      outSize = mEntry.size;
+      return mapped + mEntry.dataOffset;
+   }
+
+   virtual void unmap()
+   {
+      if ( mMapFile != NULL )
+      {
+         mMapFile->unmap();
+         mMapFile = NULL;
+      }
+   }
+
+protected:
+
+   virtual U32 calculateChecksum() { return mEntry.checksum; }
+
+   /// Inflates @a block into #mBlockData.
+   bool _loadBlock( U32 block )
+   {
+      U32 range[2];
+      if ( !mFileSystem->_read( mEntry.dataOffset + block * sizeof( U32 ), range, sizeof( range ) ) )
+         return false;
+
+      range[0] = convertLEndianToHost( range[0] );
+      range[1] = convertLEndianToHost( range[1] );
+      if ( range[1] < range[0] || range[1] > mEntry.storedSize )
+      {
+         mStatus = UnknownError;
+         return false;
+      }
+
+      const U32 compressedSize = range[1] - range[0];
+      mCompressed.setSize( compressedSize );
+      if ( !mFileSystem->_read( mEntry.dataOffset + range[0], mCompressed.address(), compressedSize ) )
+         return false;
+
+      uLongf size = getMin( ( U32 ) PackFileSystem::BlockSize, mEntry.size - block * PackFileSystem::BlockSize );
+      mBlockData.setSize( size );
+
+      if (  uncompress( mBlockData.address(), &size, mCompressed.address(), compressedSize ) != Z_OK ||
+            size != mBlockData.size() )
+      {
+         Con::errorf( "PackFileSystem: Corrupt block in %s", mPath.getFullPath().c_str() );
+         mStatus = UnknownError;
+         return false;
+      }
+
+      mBlock = block;
+      return true;
+   }
+
+   /// Keeps the pack alive while the file is.
+   FileSystemRef mFileSystemRef;
+   PackFileSystem *mFileSystem;
+
+   PackFileSystem::Entry mEntry;
+   Path mPath;
+   U32 mPosition;
+   NodeStatus mStatus;
+
+   /// The pack opened for map().
+   FileRef mMapFile;
+
+   /// Index of the block in #mBlockData.
+   U32 mBlock;
+   Vector<U8> mBlockData;
+   Vector<U8> mCompressed;
+};
+
+//-----------------------------------------------------------------------------
+// PackDirectory class (Internal)
+//-----------------------------------------------------------------------------
+
+class PackDirectory : public Directory, public Noncopyable
+{
+public:
+
+   PackDirectory( PackFileSystem *fs, const PackFileSystem::DirData *dir, const Path &path )
+      :  mFileSystemRef( fs ),
+         mFileSystem( fs ),
+         mDir( dir ),
+         mPath( path ),
+         mIndex( 0 )
+   {
+   }
+
+   virtual Path getName() const { return mPath; }
+   virtual NodeStatus getStatus() const { return FileNode::Open; }
+
+   virtual bool getAttributes( Attributes *attr )
+   {
+      if ( !attr )
+         return false;
+
+      attr->flags = FileNode::Directory | FileNode::ReadOnly;
+      attr->name = mPath.getFullPath();
+      attr->mtime = mFileSystem->mModTime;
+      attr->atime = mFileSystem->mModTime;
+      attr->size = 0;
+
+      return true;
+   }
+
+   virtual bool open()
+   {
+      mIndex = 0;
+      return true;
+   }
+
+   virtual bool close()
+   {
+      mIndex = 0;
+      return true;
+   }
+
+   virtual bool read( Attributes *attr )
+   {
+      if ( !attr )
+         return false;
+
+      const U32 numDirs = mDir->dirs.size();
+      if ( mIndex >= numDirs + mDir->files.size() )
+         return false;
+
+      attr->mtime = mFileSystem->mModTime;
+      attr->atime = mFileSystem->mModTime;
+
+      if ( mIndex < numDirs )
+      {
+         attr->flags = FileNode::Directory | FileNode::ReadOnly;
+         attr->name = mDir->dirs[ mIndex ];
+         attr->size = 0;
+      }
+      else
+      {
+         const PackFileSystem::Entry &entry = mFileSystem->mEntries[ mDir->files[ mIndex - numDirs ] ];
+
+         String dir;
+         _splitName( mFileSystem->_getName( entry ), dir, attr->name );
+         attr->flags = FileNode::File | FileNode::ReadOnly;
+         if ( entry.flags & PackFileSystem::EntryCompressed )
+            attr->flags |= FileNode::Compressed;
+         attr->size = entry.size;
+      }
+
+      mIndex++;
+      return true;
+   }
+
+private:
+
+   virtual U32 calculateChecksum() { return 0; }
+
+   FileSystemRef mFileSystemRef;
+   PackFileSystem *mFileSystem;
+   const PackFileSystem::DirData *mDir;
+   Path mPath;
+   U32 mIndex;
+};
+
+//-----------------------------------------------------------------------------
+// PackFileSystem
+//-----------------------------------------------------------------------------
+
+PackFileSystem::PackFileSystem( const String &packFilename )
+   :  mPackFilename( packFilename ),
+      mMapped( NULL )
+{
+   mReadOnly = true;
+
+   // Open the pack right away, so the file system it lives
+   // on may be unmounted without affecting this one.
+   _init();
+}
+
+PackFileSystem::~PackFileSystem()
+{
+   if ( mPackFile != NULL )
+   {
+      mPackFile->unmap();
+      mPackFile->close();
+   }
+}
+
+U32 PackFileSystem::hashName( const String &name )
+{
+   const String lower = String::ToLower( name );
+   return hash( ( const U8* ) lower.c_str(), lower.length(), 0 );
+}
+
+void PackFileSystem::_init()
+{
+   mPackFile = OpenFile( mPackFilename, File::Read );
+   if ( mPackFile == NULL )
+   {
+      Con::errorf( "PackFileSystem: Failed to open pack %s", mPackFilename.c_str() );
+      return;
+   }
+
+   U32 mappedSize = 0;
+   mMapped = mPackFile->map( mappedSize );
+
+   PackHeader header;
+   bool valid = mPackFile->read( &header, sizeof( header ) ) == sizeof( header );
+   _swapFields( header );
+
+   valid = valid && header.magic == sPackMagic && header.version == Version;
+   valid = valid && ( !mMapped || (  header.indexOffset + header.numEntries * sizeof( Entry ) <= mappedSize &&
+                                     header.namesOffset + header.namesSize <= mappedSize ) );
+
+   if ( valid )
+   {
+      mEntries.setSize( header.numEntries );
+      mNames.setSize( header.namesSize + 1 );
+      valid =  _read( header.indexOffset, mEntries.address(), header.numEntries * sizeof( Entry ) ) &&
+               _read( header.namesOffset, mNames.address(), header.namesSize );
+      mNames.last() = 0;
+   }
+
+   const U32 packSize = ( U32 ) mPackFile->getSize();
+   for ( U32 i=0; valid && i < mEntries.size(); i++ )
+   {
+      const Entry &entry = mEntries[i];
+      _swapFields( mEntries[i] );
+      valid =  entry.nameOffset < header.namesSize &&
+               entry.dataOffset <= packSize && entry.storedSize <= packSize - entry.dataOffset;
+   }
+
+   if ( !valid )
+   {
+      Con::errorf( "PackFileSystem: %s is not a valid pack", mPackFilename.c_str() );
+      mEntries.clear();
+      mNames.clear();
+      if ( mMapped )
+         mPackFile->unmap();
+      mMapped = NULL;
+      mPackFile = NULL;
+      return;
+   }
+
+   mModTime = mPackFile->getModifiedTime();
+
+   _buildDirectories();
+}
+
+void PackFileSystem::_buildDirectories()
+{
+   mDirectories.insertUnique( String::EmptyString, DirData() );
+
+   String dir, leaf;
+   for ( U32 i=0; i < mEntries.size(); i++ )
+   {
+      _splitName( _getName( mEntries[i] ), dir, leaf );
+
+      // Add all directories up the path which are not there yet.
+      String childDir = dir;
+      String key = String::ToLower( childDir );
+      HashTable<String,DirData>::Iterator iter = mDirectories.find( key );
+      if ( iter == mDirectories.end() )
+      {
+         iter = mDirectories.insertUnique( key, DirData() );
+
+         String parent, child;
+         while ( childDir.isNotEmpty() )
+         {
+            _splitName( childDir, parent, child );
+
+            const String parentKey = String::ToLower( parent );
+            HashTable<String,DirData>::Iterator parentIter = mDirectories.find( parentKey );
+            const bool isNew = ( parentIter == mDirectories.end() );
+            if ( isNew )
+               parentIter = mDirectories.insertUnique( parentKey, DirData() );
+
+            parentIter->value.dirs.push_back( child );
+            if ( !isNew )
+               break;
+
+            childDir = parent;
+         }
+      }
+
+      iter->value.files.push_back( i );
+   }
+}
+
+S32 PackFileSystem::_findEntry( const String &name ) const
+{
+   const U32 nameHash = hashName( name );
+
+   // Find the first entry with the hash.
+   S32 lo = 0;
+   S32 hi = mEntries.size();
+   while ( lo < hi )
+   {
+      const S32 mid = ( lo + hi ) / 2;
+      if ( mEntries[mid].nameHash < nameHash )
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+
+   for ( ; lo < mEntries.size() && mEntries[lo].nameHash == nameHash; lo++ )
+   {
+      if ( dStricmp( _getName( mEntries[lo] ), name.c_str() ) == 0 )
+         return lo;
+   }
+
+   return -1;
+}
+
+bool PackFileSystem::_read( U32 offset, void *dst, U32 size )
+{
+   if ( mMapped )
+   {
+      dMemcpy( dst, mMapped + offset, size );
+      return true;
+   }
+
+   MutexHandle lock;
+   lock.lock( &mReadMutex, true );
+
+   return   mPackFile->setPosition( offset, File::Begin ) == offset &&
+            mPackFile->read( dst, size ) == size;
+}
+
+FileNodeRef PackFileSystem::resolve( const Path &path )
+{
+   if ( mPackFile == NULL )
+      return NULL;
+
+   const String name = _getPackName( path );
+
+   const S32 index = _findEntry( name );
+   if ( index != -1 )
+      return new PackFile( this, index, path );
+
+   HashTable<String,DirData>::Iterator iter = mDirectories.find( String::ToLower( name ) );
+   if ( iter != mDirectories.end() )
+      return new PackDirectory( this, &iter->value, path );
+
+   return NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+   S32 QSORT_CALLBACK _compareEntries( const void *a, const void *b )
+   {
+      const U32 hashA = ( ( const PackFileSystem::Entry* ) a )->nameHash;
+      const U32 hashB = ( ( const PackFileSystem::Entry* ) b )->nameHash;
+      return ( hashA < hashB ? -1 : ( hashA > hashB ? 1 : 0 ) );
+   }
+
+   /// Deflates @a data in blocks with the block table in front.
+   void _compressBlocks( const U8 *data, U32 size, Vector<U8> &outStored )
+   {
+      const U32 numBlocks = ( size + PackFileSystem::BlockSize - 1 ) / PackFileSystem::BlockSize;
+      const U32 tableSize = ( numBlocks + 1 ) * sizeof( U32 );
+
+      outStored.setSize( tableSize + compressBound( size ) + numBlocks * 16 );
+
+      U32 pos = tableSize;
+      for ( U32 i=0; i < numBlocks; i++ )
+      {
+         const U32 offset = i * PackFileSystem::BlockSize;
+         const U32 blockSize = getMin( ( U32 ) PackFileSystem::BlockSize, size - offset );
+
+         uLongf compressedSize = outStored.size() - pos;
+         compress2( outStored.address() + pos, &compressedSize, data + offset, blockSize, Z_BEST_COMPRESSION );
+
+         ( ( U32* ) outStored.address() )[i] = convertHostToLEndian( pos );
+         pos += compressedSize;
+      }
+
+      ( ( U32* ) outStored.address() )[numBlocks] = convertHostToLEndian( pos );
+      outStored.setSize( pos );
+   }
+
+   bool _writePadding( File *file, U32 &pos )
+   {
+      static const U8 sZeros[ PackFileSystem::DataAlignment ] = { 0 };
+      const U32 padding = ( PackFileSystem::DataAlignment - pos % PackFileSystem::DataAlignment ) % PackFileSystem::DataAlignment;
+      pos += padding;
+      return file->write( sZeros, padding ) == padding;
+   }
+}
+
+bool PackFileSystem::write( const Path &packFile, const Path &dir, bool compress )
+{
+   Vector<String> files;
+   FindByPattern( dir, "*", true, files );
+
+   FileRef out = OpenFile( packFile, File::Write );
+   if ( out == NULL )
+   {
+      Con::errorf( "PackFileSystem::write - Failed to create %s", packFile.getFullPath().c_str() );
+      return false;
+   }
+
+   PackHeader header;
+   dMemset( &header, 0, sizeof( header ) );
+   bool ok = out->write( &header, sizeof( header ) ) == sizeof( header );
+   U32 pos = sizeof( header );
+
+   Vector<Entry> entries;
+   Vector<char> names;
+   Vector<U8> stored;
+
+   for ( U32 i=0; ok && i < files.size(); i++ )
+   {
+      const Path path( files[i] );
+      if ( sPackExt.equal( path.getExtension(), String::NoCase ) )
+         continue;
+
+      void *data;
+      U32 size;
+      if ( !ReadFile( path, data, size ) )
+      {
+         Con::warnf( "PackFileSystem::write - Failed to read %s", files[i].c_str() );
+         continue;
+      }
+
+      const String name = _getPackName( path );
+
+      Entry entry;
+      dMemset( &entry, 0, sizeof( entry ) );
+      entry.nameHash = hashName( name );
+      entry.nameOffset = names.size();
+      entry.size = size;
+      entry.checksum = CRC::calculateCRC( data, size );
+
+      names.merge( name.c_str(), name.length() + 1 );
+
+      const U8 *contents = ( const U8* ) data;
+      entry.storedSize = size;
+
+      // Only keep the compressed version if it saves something.
+      if ( compress && size )
+      {
+         _compressBlocks( ( const U8* ) data, size, stored );
+         if ( stored.size() < size - size / 16 )
+         {
+            contents = stored.address();
+            entry.storedSize = stored.size();
+            entry.flags |= EntryCompressed;
+         }
+      }
+
+      ok = _writePadding( out, pos );
+      entry.dataOffset = pos;
+      ok = ok && out->write( contents, entry.storedSize ) == entry.storedSize;
+      pos += entry.storedSize;
+
+      delete [] ( char* ) data;
+
+      entries.push_back( entry );
+   }
+
+   header.magic = sPackMagic;
+   header.version = Version;
+   header.numEntries = entries.size();
+
+   header.namesOffset = pos;
+   header.namesSize = names.size();
+   ok = ok && out->write( names.address(), names.size() ) == names.size();
+   pos += names.size();
+
+   ok = ok && _writePadding( out, pos );
+   header.indexOffset = pos;
+
+   if ( entries.size() )
+      dQsort( entries.address(), entries.size(), sizeof( Entry ), _compareEntries );
+   for ( U32 i=0; i < entries.size(); i++ )
+      _swapFields( entries[i] );
+   ok = ok && out->write( entries.address(), entries.size() * sizeof( Entry ) ) == entries.size() * sizeof( Entry );
+
+   _swapFields( header );
+   ok = ok && out->setPosition( 0, File::Begin ) == 0;
+   ok = ok && out->write( &header, sizeof( header ) ) == sizeof( header );
+   out->close();
+
+   if ( !ok )
+   {
+      Con::errorf( "PackFileSystem::write - Failed to write %s", packFile.getFullPath().c_str() );
+      return false;
+   }
+
+   Con::printf( "PackFileSystem::write - Wrote %d files to %s", entries.size(), packFile.getFullPath().c_str() );
+   return true;
+}
+
+} // namespace FS
+} // namespace Torque
+
+DefineEngineFunction( buildPackFile, bool, ( const char *packFile, const char *directory, bool compress ), ( true ),
+   "@brief Packs all files under a directory into a Torque pack (.tpk) file.\n\n"
+   "The files are stored with their paths relative to the root of the directory.  Packs found "
+   "next to the game's asset directory are mounted on startup like zips.\n"
+   "@param packFile The pack file to create.\n"
+   "@param directory The directory to pack.\n"
+   "@param compress Deflate the files which get smaller for it.\n"
+   "@return True if the pack was written.\n"
+   "@ingroup FileSystem\n" )
+{
+   return Torque::FS::PackFileSystem::write( packFile, directory, compress );
+}
@@ -0,0 +1,193 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _CORE_PACKVOLUME_H_
+#define _CORE_PACKVOLUME_H_
+
+#ifndef _VOLUME_H_
+#include "core/volume.h"
+#endif
+#ifndef _TDICTIONARY_H_
+#include "core/util/tDictionary.h"
+#endif
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
+
+namespace Torque
+{
+namespace FS
+{
+
+/// A read only file system over a Torque pack (.tpk) file.
+///
+/// A pack is a single file holding many others, laid out so that finding
+/// and opening a file costs no more than a binary search:
+///
+/// - A fixed size header pointing at the index and the name table.
+/// - The file contents, each starting at a multiple of DataAlignment.
+///   Files are either stored as they are or split into BlockSize blocks
+///   which are deflated on their own, preceded by a table of the block
+///   offsets, so compressed files can still be read at random positions.
+/// - The name table of all file paths relative to the mount root.
+/// - The index with one Entry per file, sorted by the hash of the lower
+///   case path, along with the size and CRC of the contents.
+///
+/// Packs are built with write() or the buildPackFile() console function
+/// and are mounted like zips, see Platform::FS::MountPacks().
+///
+/// Unlike ZipFileSystem, nothing is parsed past the index on mount, and
+/// files opened from a pack share no stream state.  The pack is mapped
+/// into memory once and every file reads from that mapping on its own,
+/// so any number of threads can read from the same pack at once.  If the
+/// pack can't be mapped, reads go through a lock instead.
+class PackFileSystem : public FileSystem
+{
+public:
+
+   enum Constants
+   {
+      Version = 1,
+
+      /// Size of the blocks compressed files are split into.
+      BlockSize = 64 * 1024,
+
+      /// Alignment of the file contents in the pack.
+      DataAlignment = 16,
+   };
+
+   enum EntryFlags
+   {
+      /// The contents are deflated in blocks.
+      EntryCompressed = BIT( 0 ),
+   };
+
+   /// A file in the index as it is stored in the pack.
+   struct Entry
+   {
+      /// hashName() of the path.
+      U32 nameHash;
+
+      /// Offset of the path in the name table.
+      U32 nameOffset;
+
+      /// Offset of the contents in the pack.
+      U32 dataOffset;
+
+      /// Size of the contents in bytes.
+      U32 size;
+
+      /// Bytes the contents take up in the pack.
+      U32 storedSize;
+
+      /// CRC of the contents.
+      U32 checksum;
+
+      /// EntryFlags.
+      U32 flags;
+
+      U32 reserved;
+   };
+
+   PackFileSystem( const String &packFilename );
+   virtual ~PackFileSystem();
+
+   String getTypeStr() const { return "Pack"; }
+
+   FileNodeRef resolve( const Path &path );
+
+   // Packs are read only.
+   FileNodeRef create( const Path &path, FileNode::Mode ) { return 0; }
+   bool remove( const Path &path ) { return false; }
+   bool rename( const Path &a, const Path &b ) { return false; }
+
+   Path mapTo( const Path &path ) { return path; }
+   Path mapFrom( const Path &path ) { return path; }
+
+   /// Returns true if the pack was opened.
+   bool isValid() const { return mPackFile != NULL; }
+
+   /// Returns the number of files in the pack.
+   U32 getEntryCount() const { return mEntries.size(); }
+
+   /// Writes all files under @a dir into a new pack at @a packFile.  The
+   /// files are stored with their paths relative to the root of @a dir,
+   /// so mounting the pack at that root makes them appear where they
+   /// were.  Other packs under @a dir are left out.
+   ///
+   /// @param compress Deflate the files which get smaller for it.
+   static bool write( const Path &packFile, const Path &dir, bool compress );
+
+   /// Returns the hash the index is sorted by for @a name.
+   static U32 hashName( const String &name );
+
+protected:
+
+   friend class PackFile;
+   friend class PackDirectory;
+
+   /// The files and subdirectories of a directory.
+   struct DirData
+   {
+      Vector<String> dirs;
+      Vector<U32> files;
+   };
+
+   String mPackFilename;
+
+   /// The open pack.
+   FileRef mPackFile;
+
+   /// The mapped pack or NULL if it could not be mapped.
+   U8 *mMapped;
+
+   /// Guards reads from #mPackFile if the pack is not mapped.
+   Mutex mReadMutex;
+
+   /// Modification time of the pack, which the files report as theirs.
+   Time mModTime;
+
+   /// The index sorted by Entry::nameHash.
+   Vector<Entry> mEntries;
+
+   Vector<char> mNames;
+
+   /// The directories by lower case path.
+   HashTable<String,DirData> mDirectories;
+
+   void _init();
+   void _buildDirectories();
+
+   const char* _getName( const Entry &entry ) const { return mNames.address() + entry.nameOffset; }
+
+   /// Returns the index of the file at @a name or -1.
+   S32 _findEntry( const String &name ) const;
+
+   /// Reads @a size bytes at @a offset of the pack.
+   bool _read( U32 offset, void *dst, U32 size );
+};
+
+} // namespace FS
+} // namespace Torque
+
+#endif // _CORE_PACKVOLUME_H_
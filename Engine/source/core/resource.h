@@ -107,6 +107,9 @@ public:
       return mResourceHeader->getChecksum();
    }
 
+   /// Returns true if the resource has been created.
+   bool  isLoaded() const { return mResourceHeader->getResource() != NULL; }
+
 protected:
 
    typedef void ( *NotifyUnloadFn )( const Torque::Path& path, void* resource );
@@ -251,6 +254,8 @@ public:
    }
 
 private:
+   template< class > friend class ResourceLoadRequest;
+
    T        *getResource() { return (T*)mResourceHeader->getResource(); }
    const T  *getResource() const { return (T*)mResourceHeader->getResource(); }
 
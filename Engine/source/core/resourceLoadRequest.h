@@ -0,0 +1,228 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _RESOURCELOADREQUEST_H_
+#define _RESOURCELOADREQUEST_H_
+
+#ifndef _RESOURCEMANAGER_H_
+#include "core/resourceManager.h"
+#endif
+#ifndef _THREADPOOL_H_
+#include "platform/threads/threadPool.h"
+#endif
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+
+/// A resource loaded on a worker thread by ResourceManager::loadAsync().
+///
+/// The resource is created with the same load signal and create() function
+/// as a synchronous load, only on a ThreadPool worker, and is then handed
+/// to the ResourceManager on the main thread from
+/// ThreadPool::processMainThreadWorkItems().  Once that happened the
+/// request is done, getResource() holds the result and the completed
+/// signal fires.  If the resource got loaded synchronously in the meantime,
+/// that copy is used and the one from the worker is dropped.
+///
+/// Queued requests are taken by the pool in order of their priority, which
+/// may be changed while the request waits, for example as the camera moves
+/// relative to the object needing the resource.  Cancelled requests are
+/// dropped from the queue and never complete.
+///
+/// Since the create() functions of some types, TSShape among them, work
+/// with static state, loads of the same type are done one after the other.
+/// Loads of different types run in parallel.
+template< class T >
+class ResourceLoadRequest : public ThreadWorkItem
+{
+public:
+
+   typedef ThreadWorkItem Parent;
+
+   typedef Signal< void( Resource< T >& ) > CompletedSignal;
+
+   ResourceLoadRequest( const Torque::Path &path, F32 priority )
+      :  mPath( path.getFullPath().c_str() ),
+         mPriority( priority ),
+         mCancelled( false ),
+         mDone( false ),
+         mLoaded( NULL )
+   {
+   }
+
+   virtual ~ResourceLoadRequest()
+   {
+      delete mLoaded;
+   }
+
+   /// Returns the path of the resource.
+   Torque::Path getPath() const { return Torque::Path( mPath ); }
+
+   /// Sets the priority of the load.  Higher priorities are loaded first.
+   void setPriority( F32 priority ) { mPriority = priority; }
+
+   /// Stops the load if it has not completed yet.
+   void cancel() { mCancelled = true; }
+
+   bool isCancelled() const { return mCancelled; }
+
+   /// Returns true once the load completed on the main thread,
+   /// even if it failed.
+   bool isDone() const { return mDone; }
+
+   /// Returns the resource once isDone() or a NULL resource if
+   /// it failed to load.
+   Resource< T >& getResource() { return mResource; }
+
+   /// Fired on the main thread when the load completes with the
+   /// resource or a NULL resource if it failed to load.
+   CompletedSignal& getCompletedSignal() { return mCompletedSignal; }
+
+   // ThreadPool::WorkItem
+   virtual F32 getPriority() { return mPriority; }
+   virtual bool isCancellationRequested() { return mCancelled; }
+
+protected:
+
+   friend class ResourceManager;
+
+   /// Hands the resource to the ResourceManager on the main thread.
+   class CompletionItem : public ThreadWorkItem
+   {
+   public:
+
+      CompletionItem( ResourceLoadRequest< T > *request )
+         : mRequest( request )
+      {
+      }
+
+      virtual F32 getPriority() { return mRequest->getPriority(); }
+
+   protected:
+
+      ThreadSafeRef< ResourceLoadRequest< T > > mRequest;
+
+      virtual void execute() { mRequest->_complete(); }
+   };
+
+   /// The full path of the file.  This is a copy of its own so that the
+   /// worker does not share string data with the main thread.
+   String mPath;
+
+   volatile F32 mPriority;
+   volatile bool mCancelled;
+   bool mDone;
+
+   /// The resource created on the worker until it is handed over.
+   T *mLoaded;
+
+   Resource< T > mResource;
+
+   CompletedSignal mCompletedSignal;
+
+   /// Serializes the worker loads of type T.
+   static Mutex& _getTypeMutex()
+   {
+      static Mutex sMutex;
+      return sMutex;
+   }
+
+   virtual void execute()
+   {
+      if ( cancellationPoint() )
+         return;
+
+      MutexHandle lock;
+      lock.lock( &_getTypeMutex(), true );
+
+      if ( cancellationPoint() )
+         return;
+
+      const Torque::Path path( mPath );
+      void *resource = NULL;
+
+      // Give the load signal a chance first, just like
+      // a synchronous load in ResourceBase::assign().
+      if ( Resource< T >::getLoadSignal().trigger( path, &resource ) || !resource )
+      {
+         Resource< T > creator;
+         resource = creator.create( path );
+      }
+
+      mLoaded = ( T* ) resource;
+      lock.unlock();
+
+      ThreadPool::queueWorkItemOnMainThread( new CompletionItem( this ) );
+   }
+
+   void _complete()
+   {
+      if ( !mCancelled )
+      {
+         ResourceBase base = ResourceManager::get().load( Torque::Path( mPath ) );
+         if ( base.isLoaded() )
+            mResource = base;
+         else if ( mLoaded )
+         {
+            mResource.setResource( base, mLoaded );
+            mLoaded = NULL;
+         }
+         else
+            Con::warnf( "Failed to create resource: [%s]", mPath.c_str() );
+      }
+
+      delete mLoaded;
+      mLoaded = NULL;
+
+      if ( mCancelled )
+         return;
+
+      mDone = true;
+      mCompletedSignal.trigger( mResource );
+   }
+};
+
+template< class T >
+ThreadSafeRef< ResourceLoadRequest< T > > ResourceManager::loadAsync( const Torque::Path &path, F32 priority )
+{
+   ThreadSafeRef< ResourceLoadRequest< T > > request( new ResourceLoadRequest< T >( path, priority ) );
+
+   // Create the lock before any worker can race for it.
+   ResourceLoadRequest< T >::_getTypeMutex();
+
+   // Resources which are already there complete right away,
+   // but still from the main thread queue so the caller has
+   // the chance to hook up to the completed signal.
+   ResourceBase existing = find( path );
+   if ( existing.isLoaded() )
+      ThreadPool::queueWorkItemOnMainThread( new typename ResourceLoadRequest< T >::CompletionItem( request.ptr() ) );
+   else
+      ThreadPool::GLOBAL().queueWorkItem( request );
+
+   return request;
+}
+
+#endif // _RESOURCELOADREQUEST_H_
@@ -31,6 +31,9 @@
 #include "core/util/tDictionary.h"
 #endif
 
+template< class T > class ResourceLoadRequest;
+template< class T > class ThreadSafeRef;
+
 class ResourceManager
 {
 public:
@@ -40,6 +43,17 @@ public:
    ResourceBase load(const Torque::Path &path);
    ResourceBase find(const Torque::Path &path);
 
+   /// Starts loading the resource at @a path on a worker thread and
+   /// returns the request to wait on, reprioritize or cancel.  Higher
+   /// priorities are loaded first.
+   ///
+   /// Defined in core/resourceLoadRequest.h, which has to be included
+   /// to use it.
+   ///
+   /// @see ResourceLoadRequest
+   template< class T >
+   ThreadSafeRef< ResourceLoadRequest< T > > loadAsync( const Torque::Path &path, F32 priority = 1.0f );
+
    ResourceBase startResourceList( ResourceBase::Signature inSignature = U32_MAX );
    ResourceBase nextResource();
 
@@ -0,0 +1,479 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "core/sizeClassAllocator.h"
+
+#include "console/console.h"
+#include "console/engineAPI.h"
+#include "platform/platformTLS.h"
+#include "platform/threads/mutex.h"
+
+
+namespace {
+
+enum
+{
+   /// 8 classes in 16 byte steps up to 128 bytes followed by four classes
+   /// per power of two up to MaxSmallSize.
+   NumSizeClasses = 8 + 4 * 8,
+
+   /// Class index of blocks that were allocated directly with dMalloc.
+   LargeClass = 0xFFFF,
+
+   /// Upper bound on the number of blocks moved between a thread cache
+   /// and a central free list at a time.
+   MaxBatchSize = 32,
+};
+
+/// Header in front of every block.  Keeps the returned pointers aligned.
+struct BlockHeader
+{
+   U64 mSize;
+   U16 mClass;
+   U16 mTag;
+   U32 mPad;
+};
+
+/// Link of a free block.  Overlays the block header.
+struct FreeBlock
+{
+   FreeBlock* mNext;
+};
+
+/// Blocks of one size class shared by all threads.
+struct CentralList
+{
+   Mutex mMutex;
+   FreeBlock* mFreeBlocks;
+   U32 mNumFree;
+   U32 mNumSpans;
+};
+
+/// Free blocks and statistics owned by a single thread.
+struct ThreadCache
+{
+   FreeBlock* mFreeBlocks[ NumSizeClasses ];
+   U32 mNumFree[ NumSizeClasses ];
+   SizeClassAllocator::TagStats mStats[ SizeClassAllocator::NumTags ];
+   ThreadCache* mNext;
+};
+
+struct AllocatorState
+{
+   /// Size of the blocks in each class excluding the header.
+   U32 mClassSize[ NumSizeClasses ];
+
+   /// Number of blocks to move between thread caches and central lists.
+   U32 mClassBatch[ NumSizeClasses ];
+
+   /// Size class for each request size in Alignment steps.
+   U8 mClassLookup[ SizeClassAllocator::MaxSmallSize / SizeClassAllocator::Alignment + 1 ];
+
+   CentralList mCentral[ NumSizeClasses ];
+
+   ThreadStorage mThreadCache;
+
+   /// List of all thread caches.  Only needed for statistics and
+   /// registration so a plain mutex is fine.
+   Mutex mCacheMutex;
+   ThreadCache* mCaches;
+
+   AllocatorState();
+};
+
+AllocatorState::AllocatorState()
+   : mCaches( NULL )
+{
+   U32 numClasses = 0;
+   for( U32 size = 16; size <= 128; size += 16 )
+      mClassSize[ numClasses ++ ] = size;
+   for( U32 base = 128; base < SizeClassAllocator::MaxSmallSize; base *= 2 )
+      for( U32 step = 1; step <= 4; ++ step )
+         mClassSize[ numClasses ++ ] = base + base / 4 * step;
+
+   AssertFatal( numClasses == NumSizeClasses, "SizeClassAllocator - Size class table mismatch" );
+
+   U32 sizeClass = 0;
+   for( U32 i = 0; i < ( sizeof( mClassLookup ) / sizeof( mClassLookup[ 0 ] ) ); ++ i )
+   {
+      while( mClassSize[ sizeClass ] < i * SizeClassAllocator::Alignment )
+         sizeClass ++;
+      mClassLookup[ i ] = sizeClass;
+   }
+
+   for( U32 i = 0; i < NumSizeClasses; ++ i )
+   {
+      const U32 stride = mClassSize[ i ] + sizeof( BlockHeader );
+      mClassBatch[ i ] = getMax( getMin( U32( SizeClassAllocator::SpanSize / 4 / stride ), U32( MaxBatchSize ) ), U32( 2 ) );
+
+      mCentral[ i ].mFreeBlocks = NULL;
+      mCentral[ i ].mNumFree = 0;
+      mCentral[ i ].mNumSpans = 0;
+   }
+}
+
+/// Return the allocator state, creating it on first use.
+///
+/// The state is deliberately never destroyed as global Vectors and chunkers
+/// may still release their memory during static destruction.
+AllocatorState& _getState()
+{
+   static AllocatorState* sState = new AllocatorState;
+   return *sState;
+}
+
+/// Return the size class for a request of @a size bytes.
+inline U32 _getSizeClass( AllocatorState& state, dsize_t size )
+{
+   return state.mClassLookup[ ( size + SizeClassAllocator::Alignment - 1 ) / SizeClassAllocator::Alignment ];
+}
+
+/// Return the calling thread's cache, creating it on first use.
+ThreadCache* _getThreadCache( AllocatorState& state )
+{
+   ThreadCache* cache = reinterpret_cast< ThreadCache* >( state.mThreadCache.get() );
+   if( cache )
+      return cache;
+
+   cache = reinterpret_cast< ThreadCache* >( dMalloc( sizeof( ThreadCache ) ) );
+   AssertFatal( cache, "SizeClassAllocator - Failed to allocate thread cache" );
+   dMemset( cache, 0, sizeof( ThreadCache ) );
+
+   {
+      MutexHandle lock;
+      lock.lock( &state.mCacheMutex, true );
+
+      cache->mNext = state.mCaches;
+      state.mCaches = cache;
+   }
+
+   state.mThreadCache.set( cache );
+   return cache;
+}
+
+/// Move a batch of blocks of @a sizeClass from the central list to @a cache,
+/// carving up a new span if the central list has run dry.
+void _refillCache( AllocatorState& state, ThreadCache* cache, U32 sizeClass )
+{
+   CentralList& central = state.mCentral[ sizeClass ];
+   const U32 batch = state.mClassBatch[ sizeClass ];
+
+   MutexHandle lock;
+   lock.lock( &central.mMutex, true );
+
+   if( !central.mFreeBlocks )
+   {
+      const U32 stride = state.mClassSize[ sizeClass ] + sizeof( BlockHeader );
+      const U32 numBlocks = getMax( U32( SizeClassAllocator::SpanSize / stride ), U32( 8 ) );
+
+      // Spans are never released.  Their blocks only ever get reused for
+      // requests of the same class, which is what keeps the heap from
+      // fragmenting.
+      U8* span = reinterpret_cast< U8* >( dMalloc( numBlocks * stride ) );
+      AssertFatal( span, "SizeClassAllocator - Failed to allocate span" );
+
+      for( U32 i = 0; i < numBlocks; ++ i )
+      {
+         FreeBlock* block = reinterpret_cast< FreeBlock* >( span + ( numBlocks - i - 1 ) * stride );
+         block->mNext = central.mFreeBlocks;
+         central.mFreeBlocks = block;
+      }
+
+      central.mNumFree += numBlocks;
+      central.mNumSpans ++;
+   }
+
+   for( U32 i = 0; i < batch && central.mFreeBlocks; ++ i )
+   {
+      FreeBlock* block = central.mFreeBlocks;
+      central.mFreeBlocks = block->mNext;
+      central.mNumFree --;
+
+      block->mNext = cache->mFreeBlocks[ sizeClass ];
+      cache->mFreeBlocks[ sizeClass ] = block;
+      cache->mNumFree[ sizeClass ] ++;
+   }
+}
+
+/// Move up to @a count blocks of @a sizeClass from @a cache to the central list.
+void _releaseCache( AllocatorState& state, ThreadCache* cache, U32 sizeClass, U32 count )
+{
+   CentralList& central = state.mCentral[ sizeClass ];
+
+   MutexHandle lock;
+   lock.lock( &central.mMutex, true );
+
+   for( U32 i = 0; i < count && cache->mFreeBlocks[ sizeClass ]; ++ i )
+   {
+      FreeBlock* block = cache->mFreeBlocks[ sizeClass ];
+      cache->mFreeBlocks[ sizeClass ] = block->mNext;
+      cache->mNumFree[ sizeClass ] --;
+
+      block->mNext = central.mFreeBlocks;
+      central.mFreeBlocks = block;
+      central.mNumFree ++;
+   }
+}
+
+const char* sgTagNames[ SizeClassAllocator::NumTags ] =
+{
+   "General",
+   "Vector",
+   "Chunker",
+   "Scene",
+   "Render",
+   "Network",
+   "Script",
+   "Sound",
+   "Physics",
+};
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+void* SizeClassAllocator::alloc( dsize_t size, Tag tag )
+{
+   AllocatorState& state = _getState();
+   ThreadCache* cache = _getThreadCache( state );
+
+   BlockHeader* header;
+   if( size > MaxSmallSize )
+   {
+      header = reinterpret_cast< BlockHeader* >( dMalloc( sizeof( BlockHeader ) + size ) );
+      AssertFatal( header, "SizeClassAllocator::alloc - Allocation failed" );
+      header->mClass = LargeClass;
+   }
+   else
+   {
+      const U32 sizeClass = _getSizeClass( state, size );
+      if( !cache->mFreeBlocks[ sizeClass ] )
+         _refillCache( state, cache, sizeClass );
+
+      FreeBlock* block = cache->mFreeBlocks[ sizeClass ];
+      cache->mFreeBlocks[ sizeClass ] = block->mNext;
+      cache->mNumFree[ sizeClass ] --;
+
+      header = reinterpret_cast< BlockHeader* >( block );
+      header->mClass = sizeClass;
+   }
+
+   header->mSize = size;
+   header->mTag = tag;
+
+   TagStats& stats = cache->mStats[ tag ];
+   stats.numAllocs ++;
+   stats.numBytes += size;
+   stats.totalAllocs ++;
+
+   return header + 1;
+}
+
+//-----------------------------------------------------------------------------
+
+void SizeClassAllocator::free( void* ptr )
+{
+   if( !ptr )
+      return;
+
+   AllocatorState& state = _getState();
+   ThreadCache* cache = _getThreadCache( state );
+
+   BlockHeader* header = reinterpret_cast< BlockHeader* >( ptr ) - 1;
+   AssertFatal( header->mTag < NumTags && ( header->mClass < NumSizeClasses || header->mClass == LargeClass ),
+      "SizeClassAllocator::free - Block was not allocated by SizeClassAllocator or has been corrupted" );
+
+   // Blocks freed on another thread than they were allocated on simply
+   // get moved over in the statistics.
+   TagStats& stats = cache->mStats[ header->mTag ];
+   stats.numAllocs --;
+   stats.numBytes -= header->mSize;
+
+   const U32 sizeClass = header->mClass;
+   if( sizeClass == LargeClass )
+   {
+      dFree( header );
+      return;
+   }
+
+   FreeBlock* block = reinterpret_cast< FreeBlock* >( header );
+   block->mNext = cache->mFreeBlocks[ sizeClass ];
+   cache->mFreeBlocks[ sizeClass ] = block;
+   cache->mNumFree[ sizeClass ] ++;
+
+   // Keep no more than two batches around so blocks flow back to other
+   // threads when this one frees more than it allocates.
+   const U32 batch = state.mClassBatch[ sizeClass ];
+   if( cache->mNumFree[ sizeClass ] > batch * 2 )
+      _releaseCache( state, cache, sizeClass, batch );
+}
+
+//-----------------------------------------------------------------------------
+
+void* SizeClassAllocator::realloc( void* ptr, dsize_t size, Tag tag )
+{
+   if( !ptr )
+      return alloc( size, tag );
+
+   if( !size )
+   {
+      free( ptr );
+      return NULL;
+   }
+
+   BlockHeader* header = reinterpret_cast< BlockHeader* >( ptr ) - 1;
+   const Tag blockTag = Tag( header->mTag );
+
+   // Stay in place if the block is already of the right class.
+
+   if( header->mClass != LargeClass && size <= MaxSmallSize )
+   {
+      AllocatorState& state = _getState();
+      if( _getSizeClass( state, size ) == header->mClass )
+      {
+         ThreadCache* cache = _getThreadCache( state );
+         cache->mStats[ blockTag ].numBytes += S64( size ) - S64( header->mSize );
+         header->mSize = size;
+         return ptr;
+      }
+   }
+
+   const dsize_t oldSize = dsize_t( header->mSize );
+
+   void* newPtr = alloc( size, blockTag );
+   dMemcpy( newPtr, ptr, size < oldSize ? size : oldSize );
+   free( ptr );
+
+   return newPtr;
+}
+
+//-----------------------------------------------------------------------------
+
+dsize_t SizeClassAllocator::getAllocSize( const void* ptr )
+{
+   return dsize_t( ( reinterpret_cast< const BlockHeader* >( ptr ) - 1 )->mSize );
+}
+
+//-----------------------------------------------------------------------------
+
+dsize_t SizeClassAllocator::getSizeClassSize( dsize_t size )
+{
+   if( size > MaxSmallSize )
+      return 0;
+
+   AllocatorState& state = _getState();
+   return state.mClassSize[ _getSizeClass( state, size ) ];
+}
+
+//-----------------------------------------------------------------------------
+
+void SizeClassAllocator::flushThreadCache()
+{
+   AllocatorState& state = _getState();
+   ThreadCache* cache = reinterpret_cast< ThreadCache* >( state.mThreadCache.get() );
+   if( !cache )
+      return;
+
+   // The cache itself and its statistics stay registered.
+   for( U32 i = 0; i < NumSizeClasses; ++ i )
+      if( cache->mNumFree[ i ] )
+         _releaseCache( state, cache, i, cache->mNumFree[ i ] );
+}
+
+//-----------------------------------------------------------------------------
+
+void SizeClassAllocator::getTagStats( Tag tag, TagStats& outStats )
+{
+   AllocatorState& state = _getState();
+
+   outStats.numAllocs = 0;
+   outStats.numBytes = 0;
+   outStats.totalAllocs = 0;
+
+   MutexHandle lock;
+   lock.lock( &state.mCacheMutex, true );
+
+   for( ThreadCache* cache = state.mCaches; cache != NULL; cache = cache->mNext )
+   {
+      outStats.numAllocs += cache->mStats[ tag ].numAllocs;
+      outStats.numBytes += cache->mStats[ tag ].numBytes;
+      outStats.totalAllocs += cache->mStats[ tag ].totalAllocs;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+const char* SizeClassAllocator::getTagName( Tag tag )
+{
+   AssertFatal( tag < NumTags, "SizeClassAllocator::getTagName - Invalid tag" );
+   return sgTagNames[ tag ];
+}
+
+//-----------------------------------------------------------------------------
+
+void SizeClassAllocator::dumpStats()
+{
+   AllocatorState& state = _getState();
+
+   Con::printf( "SizeClassAllocator tags:" );
+   Con::printf( "   %-10s %12s %12s %14s", "Tag", "Allocs", "KBytes", "Total Allocs" );
+   for( U32 i = 0; i < NumTags; ++ i )
+   {
+      TagStats stats;
+      getTagStats( Tag( i ), stats );
+      Con::printf( "   %-10s %12lld %12lld %14lld", sgTagNames[ i ],
+         ( long long ) stats.numAllocs, ( long long ) ( stats.numBytes / 1024 ), ( long long ) stats.totalAllocs );
+   }
+
+   Con::printf( "SizeClassAllocator size classes:" );
+   Con::printf( "   %8s %8s %10s %12s", "Size", "Spans", "KReserved", "Free Central" );
+
+   U64 totalReserved = 0;
+   for( U32 i = 0; i < NumSizeClasses; ++ i )
+   {
+      CentralList& central = state.mCentral[ i ];
+
+      MutexHandle lock;
+      lock.lock( &central.mMutex, true );
+
+      if( !central.mNumSpans )
+         continue;
+
+      const U32 stride = state.mClassSize[ i ] + sizeof( BlockHeader );
+      const U32 numBlocks = getMax( U32( SpanSize / stride ), U32( 8 ) );
+      const U64 reserved = U64( central.mNumSpans ) * numBlocks * stride;
+      totalReserved += reserved;
+
+      Con::printf( "   %8d %8d %10d %12d", state.mClassSize[ i ], central.mNumSpans,
+         U32( reserved / 1024 ), central.mNumFree );
+   }
+
+   Con::printf( "   Total reserved in spans: %d KB", U32( totalReserved / 1024 ) );
+}
+
+DefineEngineFunction( dumpSizeClassAllocator, void, (),,
+   "@brief Print allocation statistics of the size-class allocator per subsystem tag and size class.\n\n"
+   "@ingroup Debugging" )
+{
+   SizeClassAllocator::dumpStats();
+}
@@ -0,0 +1,131 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SIZECLASSALLOCATOR_H_
+#define _SIZECLASSALLOCATOR_H_
+
+#ifndef _PLATFORM_H_
+#  include "platform/platform.h"
+#endif
+
+
+/// Engine-wide, thread-caching size-class allocator.
+///
+/// Small requests are rounded up to one of a fixed set of size classes and
+/// served from spans that only ever hold blocks of that class.  Long-running
+/// processes that keep allocating and freeing blocks of varying sizes thus
+/// cannot end up with the heap riddled by holes that no request fits into.
+///
+/// Each thread keeps a small cache of free blocks per size class so most
+/// allocations and frees touch no lock at all.  Threads exchange blocks with
+/// a per-class central free list in batches.  Requests larger than
+/// MaxSmallSize go straight to dMalloc.
+///
+/// Every allocation is tagged with the subsystem it belongs to, and the
+/// allocator keeps live byte and allocation counts per tag (see dumpStats()).
+///
+/// When TORQUE_SIZECLASS_ALLOCATOR is defined, DataChunker blocks (and with
+/// them ClassChunker, FreeListChunker and friends) and Vector storage are
+/// allocated from here.  Other code can use the allocator directly
+/// regardless of the define.
+///
+/// @note Memory returned by alloc() must be freed with free() and never
+///   with dFree() (and vice versa).
+class SizeClassAllocator
+{
+   public:
+
+      /// Subsystem tags for allocation statistics.
+      enum Tag
+      {
+         TagGeneral,
+         TagVector,
+         TagChunker,
+         TagScene,
+         TagRender,
+         TagNetwork,
+         TagScript,
+         TagSound,
+         TagPhysics,
+
+         NumTags
+      };
+
+      enum
+      {
+         /// Alignment of all returned blocks.
+         Alignment = 16,
+
+         /// Largest request that is served from a size class.
+         MaxSmallSize = 32768,
+
+         /// Minimum size of the spans that blocks are carved from.
+         SpanSize = 65536,
+      };
+
+      /// Allocation statistics of a single tag.
+      struct TagStats
+      {
+         /// Number of live allocations.
+         S64 numAllocs;
+
+         /// Number of bytes requested by live allocations.
+         S64 numBytes;
+
+         /// Total number of allocations made so far.
+         S64 totalAllocs;
+      };
+
+      /// Allocate @a size bytes aligned to #Alignment.
+      static void* alloc( dsize_t size, Tag tag = TagGeneral );
+
+      /// Resize the block at @a ptr, which may be NULL, to @a size bytes.
+      /// The block keeps its tag if it already has one.
+      static void* realloc( void* ptr, dsize_t size, Tag tag = TagGeneral );
+
+      /// Free a block returned by alloc() or realloc().  NULL is ignored.
+      static void free( void* ptr );
+
+      /// Return the number of bytes requested for the block at @a ptr.
+      static dsize_t getAllocSize( const void* ptr );
+
+      /// Return the size class that a request of @a size bytes is rounded
+      /// up to or 0 if it is too large to be served from a size class.
+      static dsize_t getSizeClassSize( dsize_t size );
+
+      /// Hand all blocks cached by the calling thread back to the central
+      /// free lists.  Threads that are about to exit should call this so
+      /// that their cached blocks can be reused by others.
+      static void flushThreadCache();
+
+      /// Sum up the statistics of @a tag over all threads.
+      /// @note Only a snapshot when other threads are allocating.
+      static void getTagStats( Tag tag, TagStats& outStats );
+
+      /// Return the name of @a tag.
+      static const char* getTagName( Tag tag );
+
+      /// Print per-tag and per-size-class statistics to the console.
+      static void dumpStats();
+};
+
+#endif // _SIZECLASSALLOCATOR_H_
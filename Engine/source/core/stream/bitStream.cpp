@@ -47,6 +47,21 @@ void BitStream::setStringBuffer(char buffer[256])
 //   stringBuffer = buffer;
 }
 
+#ifdef TORQUE_NET_STATS
+
+const char* BitStream::getNetStatCategoryName( U32 category )
+{
+   static const char *sNames[ NetStatCategoryCount ] =
+   {
+      "flags", "ints", "floats", "points", "vectors", "rotations", "strings", "raw"
+   };
+
+   AssertFatal( category < NetStatCategoryCount, "BitStream::getNetStatCategoryName - Invalid category" );
+   return sNames[ category ];
+}
+
+#endif
+
 BitStream *BitStream::getPacketStream(U32 writeSize)
 {
    if(!writeSize)
@@ -225,6 +240,7 @@ S32 BitStream::readClassId(U32 classType, U32 classGroup)
 
 void BitStream::writeBits(S32 bitCount, const void *bitPtr)
 {
+   BITSTREAM_NET_STAT(NetStatRaw);
    if(!bitCount)
       return;
 
@@ -264,6 +280,7 @@ bool BitStream::testBit(S32 bitCount)
 
 bool BitStream::writeFlag(bool val)
 {
+   BITSTREAM_NET_STAT(NetStatFlags);
    if(bitNum + 1 > maxWriteBitNum)
    {
       error = true;
@@ -318,6 +335,7 @@ bool BitStream::_read(U32 size, void *dataPtr)
 
 bool BitStream::_write(U32 size, const void *dataPtr)
 {
+   BITSTREAM_NET_STAT(NetStatRaw);
    writeBits(size << 3, dataPtr);
    return true;
 }
@@ -336,6 +354,7 @@ S32 BitStream::readInt(S32 bitCount)
 
 void BitStream::writeInt(S32 val, S32 bitCount)
 {
+   BITSTREAM_NET_STAT(NetStatInts);
    AssertFatal((bitCount == 32) || ((val >> bitCount) == 0), avar("BitStream::writeInt: value out of range: %i/%i (%i bits)", val, 1 << bitCount, bitCount));
 
    val = convertHostToLEndian(val);
@@ -344,6 +363,7 @@ void BitStream::writeInt(S32 val, S32 bitCount)
 
 void BitStream::writeFloat(F32 f, S32 bitCount)
 {
+   BITSTREAM_NET_STAT(NetStatFloats);
    writeInt((S32)(f * ((1 << bitCount) - 1)), bitCount);
 }
 
@@ -354,6 +374,7 @@ F32 BitStream::readFloat(S32 bitCount)
 
 void BitStream::writeSignedFloat(F32 f, S32 bitCount)
 {
+   BITSTREAM_NET_STAT(NetStatFloats);
    writeInt((S32)(((f + 1) * .5) * ((1 << bitCount) - 1)), bitCount);
 }
 
@@ -364,6 +385,7 @@ F32 BitStream::readSignedFloat(S32 bitCount)
 
 void BitStream::writeSignedInt(S32 value, S32 bitCount)
 {
+   BITSTREAM_NET_STAT(NetStatInts);
    if(writeFlag(value < 0))
       writeInt(-value, bitCount - 1);
    else
@@ -380,6 +402,7 @@ S32 BitStream::readSignedInt(S32 bitCount)
 
 void BitStream::writeNormalVector(const Point3F& vec, S32 bitCount)
 {
+   BITSTREAM_NET_STAT(NetStatVectors);
    F32 phi   = mAtan2(vec.x, vec.y) / M_PI;
    F32 theta = mAtan2(vec.z, mSqrt(vec.x*vec.x + vec.y*vec.y)) / (M_PI/2.0);
 
@@ -412,6 +435,7 @@ Point3F BitStream::dumbDownNormal(const Point3F& vec, S32 bitCount)
 
 void BitStream::writeVector( Point3F vec, F32 maxMag, S32 magBits, S32 normalBits )
 {
+   BITSTREAM_NET_STAT(NetStatVectors);
    F32 mag = vec.len();
 
    // If its zero length then we're done.
@@ -452,6 +476,7 @@ void BitStream::readVector( Point3F *outVec, F32 maxMag, S32 magBits, S32 normal
 
 void BitStream::writeAffineTransform(const MatrixF& matrix)
 {
+   BITSTREAM_NET_STAT(NetStatRotations);
 //   AssertFatal(matrix.isAffine() == true,
 //               "BitStream::writeAffineTransform: Error, must write only affine transforms!");
 
@@ -488,6 +513,7 @@ void BitStream::readAffineTransform(MatrixF* matrix)
 
 void BitStream::writeQuat( const QuatF& quat, U32 bitCount )
 {
+   BITSTREAM_NET_STAT(NetStatRotations);
    writeSignedFloat( quat.x, bitCount );
    writeSignedFloat( quat.y, bitCount );
    writeSignedFloat( quat.z, bitCount );
@@ -549,6 +575,7 @@ static U32 gBitCounts[4] = {
 
 void BitStream::writeCompressedPoint(const Point3F& p,F32 scale)
 {
+   BITSTREAM_NET_STAT(NetStatPoints);
    // Same # of bits for all axis
    Point3F vec;
    F32 invScale = 1 / scale;
@@ -679,6 +706,7 @@ void BitStream::readString(char buf[256])
 
 void BitStream::writeString(const char *string, S32 maxLen)
 {
+   BITSTREAM_NET_STAT(NetStatStrings);
    if(!string)
       string = "";
    if(stringBuffer)
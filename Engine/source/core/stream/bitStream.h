@@ -64,6 +64,56 @@ protected:
 
    friend class HuffmanProcessor;
 public:
+#ifdef TORQUE_NET_STATS
+   /// Kinds of writes net stats break the bits of a stream down into.
+   enum NetStatCategory
+   {
+      NetStatFlags,
+      NetStatInts,
+      NetStatFloats,
+      NetStatPoints,
+      NetStatVectors,
+      NetStatRotations,
+      NetStatStrings,
+      NetStatRaw,        ///< writeBits() and full precision Stream::write() calls.
+      NetStatCategoryCount
+   };
+
+   static const char* getNetStatCategoryName( U32 category );
+
+   /// Add the bits of each subsequent write to @a bits[ category ] or stop
+   /// counting if @a bits is NULL.  Writes made from within another write
+   /// method are counted towards the outermost one.
+   void setNetStatCategoryBits( U32 *bits ) { mNetStatBits = bits; mNetStatDepth = 0; }
+   U32* getNetStatCategoryBits() const { return mNetStatBits; }
+
+protected:
+   U32 *mNetStatBits;
+   U32 mNetStatDepth;
+
+   /// Counts the bits written during its lifetime if it is the outermost scope.
+   class NetStatScope
+   {
+      BitStream *mStream;
+      U32 mCategory;
+      S32 mStart;
+
+   public:
+      NetStatScope( BitStream *stream, U32 category )
+         : mStream( stream->mNetStatBits ? stream : NULL ), mCategory( category ), mStart( 0 )
+      {
+         if( mStream && mStream->mNetStatDepth++ == 0 )
+            mStart = mStream->bitNum;
+      }
+      ~NetStatScope()
+      {
+         if( mStream && --mStream->mNetStatDepth == 0 )
+            mStream->mNetStatBits[ mCategory ] += mStream->bitNum - mStart;
+      }
+   };
+
+public:
+#endif
    static BitStream *getPacketStream(U32 writeSize = 0);
    static void sendPacketStream(const NetAddress *addr);
 
@@ -88,7 +138,15 @@ public:
    S32 getBitPosition() const { return getCurPos(); }
    void clearStringBuffer();
 
-   BitStream(void *bufPtr, S32 bufSize, S32 maxWriteSize = -1) { setBuffer(bufPtr, bufSize,maxWriteSize); stringBuffer = NULL; }
+   BitStream(void *bufPtr, S32 bufSize, S32 maxWriteSize = -1)
+   {
+      setBuffer(bufPtr, bufSize,maxWriteSize);
+      stringBuffer = NULL;
+#ifdef TORQUE_NET_STATS
+      mNetStatBits = NULL;
+      mNetStatDepth = 0;
+#endif
+   }
    void clear();
 
    void setStringBuffer(char buffer[256]);
@@ -174,6 +232,7 @@ public:
 
    void clearCompressionPoint();
    void setCompressionPoint(const Point3F& p);
+   const Point3F& getCompressionPoint() const { return mCompressPoint; }
 
    // Matching calls to these compression methods must, of course,
    // have matching scale values.
@@ -314,6 +373,12 @@ public:
    }
 };
 
+#ifdef TORQUE_NET_STATS
+#  define BITSTREAM_NET_STAT( category ) NetStatScope netStatScope( this, BitStream::category )
+#else
+#  define BITSTREAM_NET_STAT( category )
+#endif
+
 //------------------------------------------------------------------------------
 //-------------------------------------- INLINES
 //
@@ -346,6 +411,7 @@ inline void BitStream::writeRangedU32(U32 value, U32 rangeStart, U32 rangeEnd)
 {
    AssertFatal(value >= rangeStart && value <= rangeEnd, "Out of bounds value!");
    AssertFatal(rangeEnd >= rangeStart, "error, end of range less than start");
+   BITSTREAM_NET_STAT(NetStatInts);
 
    U32 rangeSize = rangeEnd - rangeStart + 1;
    U32 rangeBits = getBinLog2(getNextPow2(rangeSize));
@@ -377,6 +443,7 @@ inline S32 BitStream::readRangedS32( S32 min, S32 max )
 
 inline void BitStream::writeRangedF32( F32 value, F32 min, F32 max, U32 numBits )
 {
+   BITSTREAM_NET_STAT(NetStatFloats);
    value = ( mClampF( value, min, max ) - min ) / ( max - min );
    writeInt( (S32)mFloor(value * F32( (1 << numBits) - 1 )), numBits );
 }
@@ -62,6 +62,9 @@ public:
    bool flush();
    FileStream* clone() const;
 
+   /// Returns the file being streamed or NULL if the stream is closed.
+   Torque::FS::FileRef getFile() const { return mFile; }
+
 protected:
    // more mandatory methods from Stream base class...
    virtual bool _read(const U32 i_numBytes, void *o_pBuffer);
@@ -23,6 +23,7 @@
 #include "core/strings/stringFunctions.h"
 #include "core/stringTable.h"
 #include "platform/profiler.h"
+#include "platform/platformMemory.h"
 
 _StringTable *_gStringTable = NULL;
 const U32 _StringTable::csm_stInitSize = 29;
@@ -82,19 +83,26 @@ U32 _StringTable::hashStringn(const char* str, S32 len)
 //--------------------------------------
 _StringTable::_StringTable()
 {
-   buckets = (Node **) dMalloc(csm_stInitSize * sizeof(Node *));
-   for(U32 i = 0; i < csm_stInitSize; i++) {
-      buckets[i] = 0;
-   }
+   if (sgInitTable)
+      initTolowerTable();
 
-   numBuckets = csm_stInitSize;
-   itemCount = 0;
+   for(U32 n = 0; n < NumStripes; n++) {
+      Stripe &stripe = mStripes[n];
+      stripe.buckets = (Node **) dMalloc(csm_stInitSize * sizeof(Node *));
+      for(U32 i = 0; i < csm_stInitSize; i++) {
+         stripe.buckets[i] = 0;
+      }
+
+      stripe.numBuckets = csm_stInitSize;
+      stripe.itemCount = 0;
+   }
 }
 
 //--------------------------------------
 _StringTable::~_StringTable()
 {
-   dFree(buckets);
+   for(U32 n = 0; n < NumStripes; n++)
+      dFree(mStripes[n].buckets);
 }
 
 
@@ -130,9 +138,14 @@ StringTableEntry _StringTable::insert(const char* _val, const bool caseSens)
       val = "";
    //-
 
-   Node **walk, *temp;
    U32 key = hashString(val);
-   walk = &buckets[key % numBuckets];
+   Stripe &stripe = getStripe(key);
+
+   MutexHandle lock;
+   lock.lock(&stripe.mutex, true);
+
+   Node **walk, *temp;
+   walk = &stripe.buckets[key % stripe.numBuckets];
    while((temp = *walk) != NULL)   {
       if(caseSens && !dStrcmp(temp->val, val))
          return temp->val;
@@ -142,15 +155,17 @@ StringTableEntry _StringTable::insert(const char* _val, const bool caseSens)
    }
    char *ret = 0;
    if(!*walk) {
-      *walk = (Node *) mempool.alloc(sizeof(Node));
+      MEMORY_TAG_SCOPE( ScriptStrings );
+
+      *walk = (Node *) stripe.mempool.alloc(sizeof(Node));
       (*walk)->next = 0;
-      (*walk)->val = (char *) mempool.alloc(dStrlen(val) + 1);
+      (*walk)->val = (char *) stripe.mempool.alloc(dStrlen(val) + 1);
       dStrcpy((*walk)->val, val);
       ret = (*walk)->val;
-      itemCount ++;
+      stripe.itemCount ++;
    }
-   if(itemCount > 2 * numBuckets) {
-      resize(4 * numBuckets - 1);
+   if(stripe.itemCount > 2 * stripe.numBuckets) {
+      stripe.resize(4 * stripe.numBuckets - 1);
    }
    return ret;
 }
@@ -170,9 +185,14 @@ StringTableEntry _StringTable::lookup(const char* val, const bool  caseSens)
 {
    PROFILE_SCOPE(StringTableLookup);
 
-   Node **walk, *temp;
    U32 key = hashString(val);
-   walk = &buckets[key % numBuckets];
+   Stripe &stripe = getStripe(key);
+
+   MutexHandle lock;
+   lock.lock(&stripe.mutex, true);
+
+   Node **walk, *temp;
+   walk = &stripe.buckets[key % stripe.numBuckets];
    while((temp = *walk) != NULL)   {
       if(caseSens && !dStrcmp(temp->val, val))
             return temp->val;
@@ -188,9 +208,14 @@ StringTableEntry _StringTable::lookupn(const char* val, S32 len, const bool  cas
 {
    PROFILE_SCOPE(StringTableLookupN);
 
-   Node **walk, *temp;
    U32 key = hashStringn(val, len);
-   walk = &buckets[key % numBuckets];
+   Stripe &stripe = getStripe(key);
+
+   MutexHandle lock;
+   lock.lock(&stripe.mutex, true);
+
+   Node **walk, *temp;
+   walk = &stripe.buckets[key % stripe.numBuckets];
    while((temp = *walk) != NULL) {
       if(caseSens && !dStrncmp(temp->val, val, len) && temp->val[len] == 0)
          return temp->val;
@@ -203,6 +228,20 @@ StringTableEntry _StringTable::lookupn(const char* val, S32 len, const bool  cas
 
 //--------------------------------------
 void _StringTable::resize(const U32 _newSize)
+{
+   const U32 stripeSize = _newSize / NumStripes;
+
+   for(U32 n = 0; n < NumStripes; n++) {
+      Stripe &stripe = mStripes[n];
+
+      MutexHandle lock;
+      lock.lock(&stripe.mutex, true);
+      stripe.resize(stripeSize);
+   }
+}
+
+//--------------------------------------
+void _StringTable::Stripe::resize(const U32 _newSize)
 {
    /// avoid a possible 0 division
    const U32 newSize = _newSize ? _newSize : 1;
@@ -240,4 +279,3 @@ void _StringTable::resize(const U32 _newSize)
       buckets[key % newSize] = temp;
    }
 }
-
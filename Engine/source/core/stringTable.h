@@ -29,6 +29,9 @@
 #ifndef _DATACHUNKER_H_
 #include "core/dataChunker.h"
 #endif
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
 
 
 //--------------------------------------
@@ -70,6 +73,12 @@
 ///  The scripting engine and the resource manager are the primary users of the
 ///  StringTable.
 ///
+/// The table may be used from any thread.  It is split into a number of
+/// stripes, each an independent hash table with its own lock, so threads
+/// interning different strings rarely contend.  Since a string and all its
+/// case variants hash to the same stripe, every string still maps to exactly
+/// one pointer.
+///
 /// @note Be aware that the StringTable NEVER DEALLOCATES memory, so be careful when you
 ///       add strings to it. If you carelessly add many strings, you will end up wasting
 ///       space.
@@ -86,10 +95,31 @@ private:
       Node *next;
    };
 
-   Node**      buckets;
-   U32         numBuckets;
-   U32         itemCount;
-   DataChunker mempool;
+   enum
+   {
+      /// Number of independently locked hash tables.  Must be a power of two.
+      NumStripes = 16,
+      StripeShift = 28, ///< 32 - log2( NumStripes )
+   };
+
+   struct Stripe
+   {
+      Node**      buckets;
+      U32         numBuckets;
+      U32         itemCount;
+      DataChunker mempool;
+      Mutex       mutex;
+
+      void resize(const U32 newSize);
+   };
+
+   Stripe mStripes[NumStripes];
+
+   /// Return the stripe strings with hash @a key go into.
+   Stripe& getStripe(U32 key)
+   {
+      return mStripes[(key * 2654435761u) >> StripeShift];
+   }
 
    StringTableEntry _EmptyString;
 
@@ -147,6 +177,8 @@ private:
    /// is called automatically by the StringTable when the table is
    /// full past a certain threshhold.
    ///
+   /// @note Every stripe gets an equal part of @a newSize.
+   ///
    /// @param newSize   Number of new items to allocate space for.
    void             resize(const U32 newSize);
 
@@ -163,6 +195,8 @@ private:
 
 extern _StringTable *_gStringTable;
 
+/// The table is created on first use, which has to happen on the main
+/// thread (it does, during static initialization).
 inline _StringTable* _getStringTable()
 {
    if(_gStringTable == NULL)
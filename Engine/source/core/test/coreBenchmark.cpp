@@ -0,0 +1,108 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/benchmark.h"
+#include "core/stream/bitStream.h"
+#include "core/stringTable.h"
+#include "core/strings/stringFunctions.h"
+#include "math/mQuat.h"
+
+BENCHMARK(BitStream, PackMove)
+{
+   // Roughly what a player move update writes.
+   U8 buffer[ 256 ];
+   BitStream stream( buffer, sizeof( buffer ) );
+   const Point3F position( 1024.5f, -37.25f, 120.0f );
+   const Point3F velocity( 0.3f, -0.8f, 0.1f );
+   const QuatF rotation( 0.1f, 0.2f, 0.3f, 0.9f );
+
+   while( state.keepRunning() )
+   {
+      stream.setPosition( 0 );
+      stream.writeFlag( true );
+      stream.writeInt( 12, 6 );
+      stream.writeCompressedPoint( position );
+      stream.writeVector( velocity, 100.0f, 16, 10 );
+      stream.writeQuat( rotation );
+      stream.writeRangedU32( 3, 0, 7 );
+      stream.writeSignedFloat( 0.5f, 8 );
+   }
+}
+
+BENCHMARK(BitStream, UnpackMove)
+{
+   U8 buffer[ 256 ];
+   BitStream stream( buffer, sizeof( buffer ) );
+   stream.writeFlag( true );
+   stream.writeInt( 12, 6 );
+   stream.writeCompressedPoint( Point3F( 1024.5f, -37.25f, 120.0f ) );
+   stream.writeVector( Point3F( 0.3f, -0.8f, 0.1f ), 100.0f, 16, 10 );
+   stream.writeQuat( QuatF( 0.1f, 0.2f, 0.3f, 0.9f ) );
+
+   Point3F position, velocity;
+   QuatF rotation;
+   while( state.keepRunning() )
+   {
+      stream.setPosition( 0 );
+      stream.readFlag();
+      stream.readInt( 6 );
+      stream.readCompressedPoint( &position );
+      stream.readVector( &velocity, 100.0f, 16, 10 );
+      stream.readQuat( &rotation );
+   }
+   BenchmarkState::keep( position );
+}
+
+BENCHMARK(StringTable, InsertExisting)
+{
+   // Looking up names that are already interned is by far the
+   // common case in script and datablock code.
+   enum { NumNames = 256 };
+   char names[ NumNames ][ 32 ];
+   for( U32 i = 0; i < NumNames; ++ i )
+   {
+      dSprintf( names[ i ], sizeof( names[ i ] ), "benchmarkName%u", i );
+      StringTable->insert( names[ i ] );
+   }
+
+   U32 index = 0;
+   while( state.keepRunning() )
+   {
+      StringTableEntry entry = StringTable->insert( names[ index ] );
+      BenchmarkState::keep( entry );
+      index = ( index + 1 ) % NumNames;
+   }
+}
+
+BENCHMARK(StringTable, InsertNew)
+{
+   char name[ 32 ];
+   static U32 sCounter = 0;
+   while( state.keepRunning() )
+   {
+      dSprintf( name, sizeof( name ), "benchmarkNewName%u", sCounter ++ );
+      StringTableEntry entry = StringTable->insert( name );
+      BenchmarkState::keep( entry );
+   }
+}
+
+#endif
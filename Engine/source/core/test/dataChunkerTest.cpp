@@ -0,0 +1,55 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "core/dataChunker.h"
+
+TEST(DataChunker, ResetReusesBlocks)
+{
+   DataChunker chunker(256);
+
+   // Fill a few blocks and one oversized allocation.
+   chunker.alloc(200);
+   chunker.alloc(200);
+   chunker.alloc(200);
+   chunker.alloc(1024);
+   const U32 usedBlocks = chunker.countUsedBlocks();
+   EXPECT_EQ(usedBlocks, 4);
+
+   chunker.resetBlocks();
+   EXPECT_EQ(chunker.countUsedBlocks(), 0);
+
+   // The recycled blocks come back in place of new ones.
+   chunker.alloc(200);
+   chunker.alloc(200);
+   chunker.alloc(200);
+   EXPECT_EQ(chunker.countUsedBlocks(), 3);
+   EXPECT_TRUE(chunker.mFreeBlocks == NULL) << "Blocks should be reused before allocating new ones";
+
+   chunker.freeBlocks();
+   EXPECT_EQ(chunker.countUsedBlocks(), 0);
+   EXPECT_TRUE(chunker.mFreeBlocks == NULL);
+}
+
+#endif
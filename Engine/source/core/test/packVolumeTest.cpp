@@ -0,0 +1,120 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "core/packVolume.h"
+
+using namespace Torque;
+using namespace Torque::FS;
+
+static bool writeTestFile(const String &path, const void *data, U32 size)
+{
+   FileRef file = OpenFile(path, File::Write);
+   return file != NULL && file->write(data, size) == size;
+}
+
+TEST(PackFileSystem, WriteAndRead)
+{
+   const String dir = String::ToString("%s/packTest", Platform::getCurrentDirectory());
+   const String packPath = dir + ".tpk";
+   ASSERT_TRUE(Platform::createPath(dir + "/sub/"));
+
+   const char small[] = "Hello pack";
+   Vector<U8> large;
+   large.setSize(PackFileSystem::BlockSize * 3 + 123);
+   for (U32 i = 0; i < large.size(); i++)
+      large[i] = U8((i / 64) % 7);
+
+   ASSERT_TRUE(writeTestFile(dir + "/a.txt", small, sizeof(small)));
+   ASSERT_TRUE(writeTestFile(dir + "/sub/B.bin", large.address(), large.size()));
+   ASSERT_TRUE(PackFileSystem::write(packPath, dir, true));
+
+   {
+      FileSystemRef fs = new PackFileSystem(packPath);
+      PackFileSystem *pack = static_cast<PackFileSystem*>(fs.getPointer());
+      ASSERT_TRUE(pack->isValid());
+      EXPECT_EQ(pack->getEntryCount(), 2);
+
+      // Small files are stored and can be mapped.
+      FileRef file = dynamic_cast<File*>(pack->resolve(dir + "/a.txt").getPointer());
+      ASSERT_TRUE(file != NULL);
+      ASSERT_TRUE(file->open(File::Read));
+      char buffer[sizeof(small)];
+      EXPECT_EQ(file->read(buffer, sizeof(buffer)), sizeof(buffer));
+      EXPECT_STREQ(buffer, small);
+
+      U32 mappedSize;
+      U8 *mapped = file->map(mappedSize);
+      if (mapped)
+      {
+         EXPECT_EQ(mappedSize, sizeof(small));
+         EXPECT_EQ(dMemcmp(mapped, small, sizeof(small)), 0);
+         file->unmap();
+      }
+
+      // Lookups ignore case.  Compressed files can be read from anywhere.
+      file = dynamic_cast<File*>(pack->resolve(dir + "/SUB/b.BIN").getPointer());
+      ASSERT_TRUE(file != NULL);
+      ASSERT_TRUE(file->open(File::Read));
+
+      FileNode::Attributes attr;
+      ASSERT_TRUE(file->getAttributes(&attr));
+      EXPECT_EQ(attr.size, large.size());
+      EXPECT_TRUE(attr.flags & FileNode::Compressed)
+         << "Repetitive data should be compressed";
+      EXPECT_TRUE(file->map(mappedSize) == NULL)
+         << "Compressed files can't be mapped";
+
+      Vector<U8> readBack;
+      readBack.setSize(PackFileSystem::BlockSize);
+      const U32 offset = PackFileSystem::BlockSize * 2 + 1000;
+      EXPECT_EQ(file->setPosition(offset, File::Begin), offset);
+      EXPECT_EQ(file->read(readBack.address(), readBack.size()), large.size() - offset)
+         << "Reads should stop at the end of the file";
+      EXPECT_EQ(dMemcmp(readBack.address(), large.address() + offset, large.size() - offset), 0);
+      EXPECT_EQ(file->getStatus(), FileNode::EndOfFile);
+
+      file->setPosition(0, File::Begin);
+      EXPECT_EQ(file->read(readBack.address(), 100), 100);
+      EXPECT_EQ(dMemcmp(readBack.address(), large.address(), 100), 0);
+
+      // Directories list their subdirectories and files.
+      DirectoryRef subDir = dynamic_cast<Directory*>(pack->resolve(dir + "/sub").getPointer());
+      ASSERT_TRUE(subDir != NULL);
+      ASSERT_TRUE(subDir->open());
+      ASSERT_TRUE(subDir->read(&attr));
+      EXPECT_STREQ(attr.name.c_str(), "B.bin");
+      EXPECT_FALSE(subDir->read(&attr));
+
+      EXPECT_TRUE(pack->resolve(dir + "/missing.txt") == NULL);
+   }
+
+   dFileDelete(packPath);
+   dFileDelete(dir + "/a.txt");
+   dFileDelete(dir + "/sub/B.bin");
+   Platform::deleteDirectory(dir + "/sub");
+   Platform::deleteDirectory(dir);
+};
+
+#endif
@@ -0,0 +1,107 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "core/resourceLoadRequest.h"
+#include "core/util/fourcc.h"
+
+namespace
+{
+   struct AsyncTestResource
+   {
+      U32 value;
+   };
+
+   U32 gCompletedCount = 0;
+
+   void onCompleted( Resource< AsyncTestResource >& resource )
+   {
+      if ( resource != NULL )
+         gCompletedCount++;
+   }
+
+   void finishLoads()
+   {
+      ThreadPool::GLOBAL().waitForAllItems();
+      for ( U32 i = 0; i < 100; i++ )
+         ThreadPool::processMainThreadWorkItems();
+   }
+}
+
+template<> void* Resource< AsyncTestResource >::create( const Torque::Path &path )
+{
+   AsyncTestResource *resource = new AsyncTestResource;
+   resource->value = 42;
+   return resource;
+}
+
+template<> ResourceBase::Signature Resource< AsyncTestResource >::signature()
+{
+   return MakeFourCC( 'a', 't', 's', 't' );
+}
+
+TEST(ResourceLoadRequest, Load)
+{
+   const Torque::Path path( "test/asyncLoad.tst" );
+   gCompletedCount = 0;
+
+   ThreadSafeRef< ResourceLoadRequest< AsyncTestResource > > request =
+      ResourceManager::get().loadAsync< AsyncTestResource >( path );
+   request->getCompletedSignal().notify( &onCompleted );
+
+   finishLoads();
+
+   ASSERT_TRUE(request->isDone());
+   ASSERT_TRUE(request->getResource() != NULL);
+   EXPECT_EQ(request->getResource()->value, 42);
+   EXPECT_EQ(gCompletedCount, 1);
+   EXPECT_TRUE(ResourceManager::get().find( path ).isLoaded())
+      << "The resource should have been handed to the manager";
+
+   // Loading it again should complete with the same resource.
+   ThreadSafeRef< ResourceLoadRequest< AsyncTestResource > > again =
+      ResourceManager::get().loadAsync< AsyncTestResource >( path );
+   again->getCompletedSignal().notify( &onCompleted );
+   EXPECT_FALSE(again->isDone()) << "Completion should wait for the main thread queue";
+
+   finishLoads();
+
+   ASSERT_TRUE(again->isDone());
+   EXPECT_EQ((AsyncTestResource*)again->getResource(), (AsyncTestResource*)request->getResource());
+   EXPECT_EQ(gCompletedCount, 2);
+};
+
+TEST(ResourceLoadRequest, Cancel)
+{
+   ThreadSafeRef< ResourceLoadRequest< AsyncTestResource > > request =
+      ResourceManager::get().loadAsync< AsyncTestResource >( Torque::Path( "test/asyncCancel.tst" ) );
+   request->cancel();
+
+   finishLoads();
+
+   EXPECT_FALSE(request->isDone()) << "Cancelled loads must never complete";
+   EXPECT_TRUE(request->getResource() == NULL);
+};
+
+#endif
@@ -0,0 +1,178 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "core/sizeClassAllocator.h"
+#include "platform/threads/thread.h"
+#include "core/util/tVector.h"
+
+FIXTURE(SizeClassAllocator)
+{
+public:
+   // Allocates and frees blocks of varying sizes, half of them handed
+   // over from a vector filled by another thread.
+   class WorkerThread : public Thread
+   {
+   public:
+      Vector<void*>& mInbox;
+      WorkerThread(Vector<void*>& inbox) : mInbox(inbox) {}
+
+      virtual void run(void*)
+      {
+         Vector<void*> blocks;
+         for (U32 i = 0; i < 4096; i++)
+         {
+            const dsize_t size = 1 + (i * 37) % 4000;
+            U8* ptr = (U8*)SizeClassAllocator::alloc(size, SizeClassAllocator::TagScene);
+            dMemset(ptr, 0xAB, size);
+            blocks.push_back(ptr);
+         }
+
+         for (U32 i = 0; i < mInbox.size(); i++)
+            SizeClassAllocator::free(mInbox[i]);
+         for (U32 i = 0; i < blocks.size(); i++)
+            SizeClassAllocator::free(blocks[i]);
+
+         SizeClassAllocator::flushThreadCache();
+      }
+   };
+};
+
+TEST_FIX(SizeClassAllocator, AllocFree)
+{
+   const dsize_t sizes[] = { 0, 1, 16, 17, 100, 129, 1000, 4097, 16384, 32768, 32769, 100000 };
+   void* ptrs[ sizeof(sizes) / sizeof(sizes[0]) ];
+
+   for (U32 i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+   {
+      ptrs[i] = SizeClassAllocator::alloc(sizes[i]);
+      ASSERT_TRUE(ptrs[i] != NULL);
+      EXPECT_EQ(uintptr_t(ptrs[i]) % SizeClassAllocator::Alignment, 0)
+         << "Blocks should be aligned";
+      EXPECT_EQ(SizeClassAllocator::getAllocSize(ptrs[i]), sizes[i]);
+      dMemset(ptrs[i], 0xCD, sizes[i]);
+   }
+
+   for (U32 i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+      SizeClassAllocator::free(ptrs[i]);
+
+   SizeClassAllocator::free(NULL);
+};
+
+TEST_FIX(SizeClassAllocator, SizeClasses)
+{
+   EXPECT_EQ(SizeClassAllocator::getSizeClassSize(1), 16);
+   EXPECT_EQ(SizeClassAllocator::getSizeClassSize(16), 16);
+   EXPECT_EQ(SizeClassAllocator::getSizeClassSize(17), 32);
+   EXPECT_EQ(SizeClassAllocator::getSizeClassSize(129), 160);
+   EXPECT_EQ(SizeClassAllocator::getSizeClassSize(16384), 16384);
+   EXPECT_EQ(SizeClassAllocator::getSizeClassSize(SizeClassAllocator::MaxSmallSize), SizeClassAllocator::MaxSmallSize);
+   EXPECT_EQ(SizeClassAllocator::getSizeClassSize(SizeClassAllocator::MaxSmallSize + 1), 0)
+      << "Large requests should not have a size class";
+
+   // Freed blocks get reused for the same class.
+   void* a = SizeClassAllocator::alloc(200);
+   SizeClassAllocator::free(a);
+   void* b = SizeClassAllocator::alloc(220);
+   EXPECT_EQ(a, b);
+   SizeClassAllocator::free(b);
+};
+
+TEST_FIX(SizeClassAllocator, Realloc)
+{
+   U8* ptr = (U8*)SizeClassAllocator::realloc(NULL, 10);
+   for (U32 i = 0; i < 10; i++)
+      ptr[i] = i;
+
+   // Same class; stays in place.
+   EXPECT_EQ(SizeClassAllocator::realloc(ptr, 14), ptr);
+
+   ptr = (U8*)SizeClassAllocator::realloc(ptr, 50000);
+   for (U32 i = 0; i < 10; i++)
+      EXPECT_EQ(ptr[i], i) << "Contents should survive growing";
+
+   ptr = (U8*)SizeClassAllocator::realloc(ptr, 5);
+   for (U32 i = 0; i < 5; i++)
+      EXPECT_EQ(ptr[i], i) << "Contents should survive shrinking";
+
+   EXPECT_TRUE(SizeClassAllocator::realloc(ptr, 0) == NULL);
+};
+
+TEST_FIX(SizeClassAllocator, TagStats)
+{
+   SizeClassAllocator::TagStats before, after;
+   SizeClassAllocator::getTagStats(SizeClassAllocator::TagPhysics, before);
+
+   void* a = SizeClassAllocator::alloc(100, SizeClassAllocator::TagPhysics);
+   void* b = SizeClassAllocator::alloc(40000, SizeClassAllocator::TagPhysics);
+
+   SizeClassAllocator::getTagStats(SizeClassAllocator::TagPhysics, after);
+   EXPECT_EQ(after.numAllocs - before.numAllocs, 2);
+   EXPECT_EQ(after.numBytes - before.numBytes, 40100);
+   EXPECT_EQ(after.totalAllocs - before.totalAllocs, 2);
+
+   a = SizeClassAllocator::realloc(a, 120);
+   SizeClassAllocator::getTagStats(SizeClassAllocator::TagPhysics, after);
+   EXPECT_EQ(after.numBytes - before.numBytes, 40120)
+      << "Realloc should keep the tag";
+
+   SizeClassAllocator::free(a);
+   SizeClassAllocator::free(b);
+
+   SizeClassAllocator::getTagStats(SizeClassAllocator::TagPhysics, after);
+   EXPECT_EQ(after.numAllocs, before.numAllocs);
+   EXPECT_EQ(after.numBytes, before.numBytes);
+};
+
+TEST_FIX(SizeClassAllocator, MultiThreaded)
+{
+   enum { NumThreads = 4 };
+
+   SizeClassAllocator::TagStats before, after;
+   SizeClassAllocator::getTagStats(SizeClassAllocator::TagScene, before);
+
+   // Blocks allocated here get freed on the worker threads.
+   Vector<void*> inboxes[NumThreads];
+   for (U32 i = 0; i < NumThreads; i++)
+      for (U32 n = 0; n < 1024; n++)
+         inboxes[i].push_back(SizeClassAllocator::alloc(8 + n % 600, SizeClassAllocator::TagScene));
+
+   WorkerThread* threads[NumThreads];
+   for (U32 i = 0; i < NumThreads; i++)
+   {
+      threads[i] = new WorkerThread(inboxes[i]);
+      threads[i]->start();
+   }
+
+   for (U32 i = 0; i < NumThreads; i++)
+   {
+      threads[i]->join();
+      delete threads[i];
+   }
+
+   SizeClassAllocator::getTagStats(SizeClassAllocator::TagScene, after);
+   EXPECT_EQ(after.numAllocs, before.numAllocs);
+   EXPECT_EQ(after.numBytes, before.numBytes);
+};
+
+#endif
@@ -0,0 +1,103 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "core/stringTable.h"
+#include "core/strings/stringFunctions.h"
+#include "platform/threads/thread.h"
+
+TEST(StringTableEntry, Insert)
+{
+   StringTableEntry a = StringTable->insert("stringTableTestName");
+   EXPECT_EQ(a, StringTable->insert("STRINGTABLETESTNAME"))
+      << "Case insensitive inserts should return the same entry";
+   EXPECT_EQ(a, StringTable->lookup("StringTableTestName"));
+   EXPECT_EQ(a, StringTable->lookupn("stringTableTestNameXYZ", 19));
+
+   StringTableEntry b = StringTable->insert("StringTableTestName", true);
+   EXPECT_NE(a, b) << "Case sensitive inserts should keep their own entry";
+   EXPECT_EQ(a, StringTable->lookup("StringTableTestName"))
+      << "Case insensitive lookups should still find the first entry";
+
+   EXPECT_EQ(StringTable->EmptyString(), StringTable->insert(NULL));
+}
+
+TEST(StringTableEntry, Threads)
+{
+   enum
+   {
+      NumThreads = 4,
+      NumStrings = 2000,
+   };
+
+   struct thread
+   {
+      U32 offset;
+      StringTableEntry entries[NumStrings];
+
+      // Every thread interns the same names, each starting at a
+      // different offset to make inserts race.
+      static void body(void* arg)
+      {
+         thread* self = reinterpret_cast<thread*>(arg);
+         char name[64];
+         for (U32 i = 0; i < NumStrings; i++)
+         {
+            const U32 index = (i + self->offset) % NumStrings;
+            dSprintf(name, sizeof(name), "stringTableThreadTest%u", index);
+            self->entries[index] = StringTable->insert(name);
+         }
+      }
+   };
+
+   thread* data = new thread[NumThreads];
+
+   Thread* threads[NumThreads];
+   for (U32 i = 0; i < NumThreads; i++)
+   {
+      data[i].offset = i * (NumStrings / NumThreads);
+      threads[i] = new Thread(&thread::body, &data[i]);
+      threads[i]->start();
+   }
+   for (U32 i = 0; i < NumThreads; i++)
+   {
+      threads[i]->join();
+      delete threads[i];
+   }
+
+   char name[64];
+   for (U32 i = 0; i < NumStrings; i++)
+   {
+      dSprintf(name, sizeof(name), "stringTableThreadTest%u", i);
+      StringTableEntry entry = StringTable->lookup(name);
+      ASSERT_TRUE(entry != NULL);
+      EXPECT_STREQ(entry, name);
+      for (U32 t = 0; t < NumThreads; t++)
+         ASSERT_EQ(entry, data[t].entries[i])
+            << "All threads should get the same entry for a string";
+   }
+
+   delete [] data;
+}
+
+#endif
@@ -0,0 +1,96 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "core/volume.h"
+
+using namespace Torque;
+using namespace Torque::FS;
+
+static bool writeTestFile(const String &path)
+{
+   const char data[] = "cached";
+   FileRef file = OpenFile(path, File::Write);
+   return file != NULL && file->write(data, sizeof(data)) == sizeof(data);
+}
+
+TEST(VolumeAttributeCache, ChangesThroughVolumeSystem)
+{
+   const String dir = String::ToString("%s/volumeCacheTest", Platform::getCurrentDirectory());
+   const String a = dir + "/a.txt";
+   const String b = dir + "/b.txt";
+   ASSERT_TRUE(Platform::createPath(dir + "/"));
+   InvalidateDirectory(dir);
+
+   // Missing files are cached too, creating one has to drop them.
+   EXPECT_FALSE(IsFile(a));
+   ASSERT_TRUE(writeTestFile(a));
+   EXPECT_TRUE(IsFile(a));
+
+   FileNode::Attributes attr;
+   ASSERT_TRUE(GetFileAttributes(a, &attr));
+   EXPECT_EQ(attr.size, 7);
+
+   Vector<String> found;
+   EXPECT_EQ(FindByPattern(dir + "/", "*.txt", false, found), 1);
+
+   EXPECT_TRUE(Rename(a, b));
+   EXPECT_FALSE(IsFile(a));
+   EXPECT_TRUE(IsFile(b));
+
+   found.clear();
+   EXPECT_EQ(FindByPattern(dir + "/", "*.txt", false, found), 1);
+   ASSERT_EQ(found.size(), 1);
+   EXPECT_TRUE(found[0].equal(b));
+
+   EXPECT_TRUE(Remove(b));
+   EXPECT_FALSE(IsFile(b));
+
+   found.clear();
+   EXPECT_EQ(FindByPattern(dir + "/", "*.txt", false, found), 0);
+
+   Platform::deleteDirectory(dir);
+};
+
+TEST(VolumeAttributeCache, ChangesBehindItsBack)
+{
+   const String dir = String::ToString("%s/volumeCacheTest", Platform::getCurrentDirectory());
+   const String a = dir + "/a.txt";
+   ASSERT_TRUE(Platform::createPath(dir + "/"));
+
+   ASSERT_TRUE(writeTestFile(a));
+   EXPECT_TRUE(IsFile(a));
+
+   // Deleting the file without the volume system isn't noticed until
+   // the directory is invalidated or the entry expires.
+   dFileDelete(a);
+   EXPECT_TRUE(IsFile(a));
+
+   InvalidateDirectory(dir);
+   EXPECT_FALSE(IsFile(a));
+
+   Platform::deleteDirectory(dir);
+};
+
+#endif
@@ -22,6 +22,56 @@
 
 #include "core/util/swizzle.h"
 
+#if defined( TORQUE_CPU_X64 ) || defined( __SSE2__ )
+#include <emmintrin.h>
+#define SWAPRB_SSE2
+#endif
+
+void SwapRBSwizzle::ToBuffer( void *destination, const void *source, const dsize_t size ) const
+{
+   AssertFatal( size % 4 == 0, "Bad buffer size for swizzle, see docs." );
+   if (!destination || !source) return;
+
+   U8 *dest = reinterpret_cast<U8 *>( destination );
+   const U8 *src = reinterpret_cast<const U8 *>( source );
+   dsize_t pixels = size >> 2;
+
+#ifdef SWAPRB_SSE2
+   // Rotating the red and blue bytes of a pixel by 16 bits swaps them.
+   const __m128i rbMask = _mm_set1_epi32( 0x00FF00FF );
+   for( ; pixels >= 4; pixels -= 4 )
+   {
+      const __m128i p = _mm_loadu_si128( reinterpret_cast<const __m128i *>( src ) );
+      const __m128i rb = _mm_and_si128( p, rbMask );
+      const __m128i ga = _mm_andnot_si128( rbMask, p );
+      const __m128i br = _mm_or_si128( _mm_slli_epi32( rb, 16 ), _mm_srli_epi32( rb, 16 ) );
+      _mm_storeu_si128( reinterpret_cast<__m128i *>( dest ), _mm_or_si128( br, ga ) );
+
+      src += 16;
+      dest += 16;
+   }
+#endif
+
+   for( ; pixels > 0; pixels-- )
+   {
+      // Read the whole pixel first so this works in place.
+      const U8 r = src[0];
+      const U8 g = src[1];
+      const U8 b = src[2];
+      const U8 a = src[3];
+
+      dest[0] = b;
+      dest[1] = g;
+      dest[2] = r;
+      dest[3] = a;
+
+      src += 4;
+      dest += 4;
+   }
+}
+
+//------------------------------------------------------------------------------
+
 namespace Swizzles
 {
    dsize_t _bgra[] = { 2, 1, 0, 3 };
@@ -31,7 +81,7 @@ namespace Swizzles
    dsize_t _rgba[] = { 0, 1, 2, 3 };
    dsize_t _abgr[] = { 3, 2, 1, 0 };
 
-   Swizzle<U8, 4> bgra( _bgra );
+   SwapRBSwizzle bgra( _bgra );
    Swizzle<U8, 3> bgr( _bgr );
    Swizzle<U8, 3> rgb( _rgb );
    Swizzle<U8, 4> argb( _argb );
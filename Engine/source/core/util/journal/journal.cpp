@@ -24,24 +24,149 @@
 #include "core/util/journal/journal.h"
 
 #include "core/stream/fileStream.h"
+#include "core/stream/memStream.h"
 #include "core/util/safeDelete.h"
 #include "console/console.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/semaphore.h"
+#include "platform/threads/threadSafeRingBuffer.h"
+#include "zlib/zlib.h"
 #include <stdlib.h>
 
 //-----------------------------------------------------------------------------
 
+/// Marks a block journal.  Older journals start with their event count
+/// instead.
+static const U32 JournalBlockMagic = 0x314b4c42; // 'BLK1'
+
+/// Block journals are laid out as the magic followed by any number of
+///
+///   U32 eventCount, U32 size, U32 packedSize, U8 packed[ packedSize ]
+///
+/// where packed is the zlib compressed event data of the block.
+class JournalWriter : public Thread
+{
+public:
+   struct Block
+   {
+      U8 *data;
+      U32 size;
+      U32 count;
+
+      Block() : data( NULL ), size( 0 ), count( 0 ) {}
+   };
+
+   enum
+   {
+      /// Blocks that can be waiting to be written before recording
+      /// has to wait for the writer.
+      QueueSize = 64,
+   };
+
+protected:
+   FileStream *mStream;
+   ThreadSafeSPSCRingBuffer< Block > mBlocks;
+
+   /// Counts the queued blocks.
+   Semaphore mQueued;
+
+   /// Set by the writer when writing fails.  Read once the thread is done.
+   bool mFailed;
+
+   void _writeBlock( const Block& block );
+
+public:
+   JournalWriter( FileStream *stream )
+      : mStream( stream ),
+        mBlocks( QueueSize ),
+        mQueued( 0 ),
+        mFailed( false )
+   {
+      _setName( "JournalWriter" );
+   }
+
+   ~JournalWriter()
+   {
+      delete mStream;
+   }
+
+   /// Queue a block and take ownership of its data.  Main thread only.
+   void submit( const Block& block )
+   {
+      mBlocks.pushBack( block );
+      mQueued.release();
+   }
+
+   /// Write out everything queued and wait for the thread to exit.
+   /// @return False if any block failed to be written.
+   bool finish()
+   {
+      stop();
+      mQueued.release();
+      join();
+      return !mFailed;
+   }
+
+   virtual void run( void *arg = 0 );
+};
+
+void JournalWriter::_writeBlock( const Block& block )
+{
+   uLongf packedSize = compressBound( block.size );
+   U8 *packed = ( U8* ) dMalloc( packedSize );
+
+   bool ok = compress2( packed, &packedSize, block.data, block.size, Z_BEST_SPEED ) == Z_OK;
+   if( ok )
+      ok = mStream->write( block.count ) &&
+           mStream->write( block.size ) &&
+           mStream->write( U32( packedSize ) ) &&
+           mStream->write( U32( packedSize ), packed );
+
+   // Push the block to disk so it survives the process dying.
+   if( ok )
+      ok = mStream->flush();
+
+   if( !ok )
+      mFailed = true;
+
+   dFree( packed );
+   dFree( block.data );
+}
+
+void JournalWriter::run( void *arg )
+{
+   while( true )
+   {
+      mQueued.acquire();
+
+      Block block;
+      if( mBlocks.tryPopFront( block ) )
+         _writeBlock( block );
+      else if( checkForStop() )
+         break;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
 Journal::FuncDecl* Journal::_FunctionList;
 Stream *Journal::mFile;
+Stream *Journal::mBlockFile;
+JournalWriter *Journal::mWriter;
 Journal::Mode Journal::_State = Journal::StopState;
 U32 Journal::_Count;
+U32 Journal::_BlockStart;
 bool Journal::_Dispatching = false;
 
+U32 Journal::smBlockSize = 64 * 1024;
+U32 Journal::smBlockTime = 1000;
+
 Journal Journal::smInstance;
 
 //-----------------------------------------------------------------------------
 Journal::~Journal()
 {
-   if( mFile )
+   if( mFile || mBlockFile )
       Stop();
 }
 
@@ -92,15 +217,79 @@ void Journal::_start()
 void Journal::_finish()
 {
    if (_State == PlayState)
-      --_Count;
+   {
+      // Move on to the next block once this one is used up.
+      if (!--_Count && mBlockFile)
+         _readBlock();
+   }
    else {
-      U32 pos = mFile->getPosition();
-      mFile->setPosition(0);
-      mFile->write(++_Count);
-      mFile->setPosition(pos);
+      ++_Count;
+      if (mFile->getPosition() >= smBlockSize ||
+          Platform::getRealMilliseconds() - _BlockStart >= smBlockTime)
+      {
+         _submitBlock();
+         _beginBlock();
+      }
    }
 }
 
+void Journal::_beginBlock()
+{
+   _Count = 0;
+   _BlockStart = Platform::getRealMilliseconds();
+   mFile = new MemStream(smBlockSize + smBlockSize / 4);
+}
+
+void Journal::_submitBlock()
+{
+   MemStream *stream = (MemStream*)mFile;
+   mFile = NULL;
+
+   if (_Count)
+   {
+      JournalWriter::Block block;
+      block.size = stream->getPosition();
+      block.count = _Count;
+      block.data = (U8*)stream->takeBuffer();
+      mWriter->submit(block);
+   }
+
+   delete stream;
+}
+
+bool Journal::_readBlock()
+{
+   SAFE_DELETE(mFile);
+   _Count = 0;
+
+   U32 size, packedSize;
+   if (!mBlockFile->read(&_Count) || !_Count ||
+       !mBlockFile->read(&size) || !mBlockFile->read(&packedSize))
+   {
+      // Clean end of the journal, or one cut short while being recorded.
+      _Count = 0;
+      return false;
+   }
+
+   U8 *packed = (U8*)dMalloc(packedSize);
+   MemStream *stream = new MemStream(size, NULL, true, false);
+
+   uLongf unpackedSize = size;
+   if (!mBlockFile->read(packedSize, packed) ||
+       uncompress((U8*)stream->getBuffer(), &unpackedSize, packed, packedSize) != Z_OK ||
+       unpackedSize != size)
+   {
+      Con::errorf("Journal: Truncated or corrupt block, stopping playback here");
+      delete stream;
+      _Count = 0;
+   }
+   else
+      mFile = stream;
+
+   dFree(packed);
+   return _Count != 0;
+}
+
 void Journal::Record(const char * file)
 {
    if (_State == DisabledState)
@@ -115,16 +304,19 @@ void Journal::Record(const char * file)
 
    if (_State == StopState)
    {
-      _Count = 0;
-      mFile = new FileStream();
+      FileStream *stream = new FileStream();
 
-      if( ((FileStream*)mFile)->open(file, Torque::FS::File::Write) )
+      if( stream->open(file, Torque::FS::File::Write) && stream->write(JournalBlockMagic) )
       {
-         mFile->write(_Count);
+         mWriter = new JournalWriter(stream);
+         mWriter->start();
+
+         _beginBlock();
          _State = RecordState;
       }
       else
       {
+         delete stream;
          AssertWarn(false,"Journal: Could not create journal file");
          Con::errorf("Journal: Could not create journal file '%s'", file);
       }
@@ -150,6 +342,12 @@ void Journal::Play(const char * file)
       if( ((FileStream*)mFile)->open(file, Torque::FS::File::Read) )
       {
          mFile->read(&_Count);
+         if (_Count == JournalBlockMagic)
+         {
+            mBlockFile = mFile;
+            mFile = NULL;
+            _readBlock();
+         }
          _State = PlayState;
       }
       else
@@ -162,15 +360,30 @@ void Journal::Play(const char * file)
 
 void Journal::Stop()
 {
-   AssertFatal(mFile, "Journal::Stop - no file stream open!");
+   AssertFatal(mFile || mBlockFile, "Journal::Stop - no file stream open!");
+
+   if (mWriter)
+   {
+      _submitBlock();
+      if (!mWriter->finish())
+         Con::errorf("Journal: Failed writing the journal file, it is incomplete");
+      SAFE_DELETE( mWriter );
+   }
 
    SAFE_DELETE( mFile );
+   SAFE_DELETE( mBlockFile );
    _State = StopState;
 }
 
 bool Journal::PlayNext()
 {
    if (_State == PlayState) {
+      if (!_Count) {
+         // Nothing was recorded.
+         Stop();
+         return false;
+      }
+
       _start();
       Id id;
 
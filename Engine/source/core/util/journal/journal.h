@@ -43,6 +43,13 @@
 ///
 /// For the journals to play back correctly, journal events cannot
 /// be triggered during the processing of another event.
+///
+/// Recorded events are buffered in memory and written in compressed
+/// blocks from a background thread, so recording costs little more than
+/// the memory copies.  Every block can be decompressed on its own, so a
+/// journal cut short by a crash plays back up to its last full block.
+class JournalWriter;
+
 class Journal 
 {
    Journal() {}
@@ -367,8 +374,21 @@ class Journal
       return _IdPool;
    }
 
+   /// Events in the current block, or the whole file for journals
+   /// written before blocks were introduced.
    static U32 _Count;
    static Stream *mFile;
+
+   /// The journal file itself while playing a block journal, mFile
+   /// only holds the current block then.
+   static Stream *mBlockFile;
+
+   /// Compresses and writes finished blocks while recording.
+   static JournalWriter *mWriter;
+
+   /// Real time the block being recorded was started.
+   static U32 _BlockStart;
+
    static enum Mode {
       StopState, PlayState, RecordState, DisabledState
    } _State;
@@ -377,10 +397,21 @@ class Journal
    static Functor* _create(Id id);
    static void _start();
    static void _finish();
+   static void _beginBlock();
+   static void _submitBlock();
+   static bool _readBlock();
    static Id _getFunctionId(VoidPtr ptr,VoidMethod method);
    static void _removeFunctionId(VoidPtr ptr,VoidMethod method);
 
 public:
+   /// Recorded events are collected into blocks of roughly this many bytes
+   /// before they are compressed and written out by a background thread.
+   static U32 smBlockSize;
+
+   /// Longest time in ms events are held back before their block is
+   /// written, which bounds what is lost if the process dies.
+   static U32 smBlockTime;
+
    static void Record(const char * file);
    static void Play(const char * file);
    static bool PlayNext();
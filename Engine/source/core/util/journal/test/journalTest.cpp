@@ -127,6 +127,42 @@ TEST_FIX(Journal, BasicAPI)
       << "Should encounter last journaled value (18).";
 }
 
+TEST_FIX(Journal, Blocks)
+{
+   receiver rec;
+   rec.lastTriggerValue = 0;
+
+   JournaledSignal<void(U16)> testEvent;
+   testEvent.notify(&rec, &receiver::trigger);
+
+   // Tiny blocks so the events span many of them.
+   const U32 oldBlockSize = Journal::smBlockSize;
+   Journal::smBlockSize = 16;
+
+   Journal::Record("test.jrn");
+   ASSERT_TRUE(Journal::IsRecording());
+
+   for (U16 i = 1; i <= 100; i++)
+      testEvent.trigger(i);
+
+   Journal::Stop();
+   Journal::smBlockSize = oldBlockSize;
+
+   rec.lastTriggerValue = 0;
+   Journal::Play("test.jrn");
+
+   U32 events = 1;
+   while (Journal::PlayNext())
+   {
+      EXPECT_EQ(rec.lastTriggerValue, events) << "Events played back out of order.";
+      events++;
+   }
+
+   EXPECT_EQ(events, 100) << "Should play back every event.";
+   EXPECT_EQ(rec.lastTriggerValue, 100)
+      << "Should encounter last journaled value (100).";
+}
+
 TEST_FIX(Journal, DynamicSignals)
 {
    multiReceiver rec;
@@ -89,11 +89,29 @@ public:
    }
 };
 
+// RGBA <-> BGRA swizzle
+//
+// Swaps the first and third byte of every four.  This is the swizzle D3D
+// texture uploads go through, so rather than moving single bytes it works on
+// whole pixels, four at a time with SSE2 where available.
+class SwapRBSwizzle : public Swizzle<U8, 4>
+{
+public:
+   SwapRBSwizzle( const dsize_t *map ) : Swizzle<U8, 4>( map ) {};
+
+   virtual void InPlace( void *memory, const dsize_t size ) const
+   {
+      ToBuffer( memory, memory, size );
+   }
+
+   virtual void ToBuffer( void *destination, const void *source, const dsize_t size ) const;
+};
+
 //------------------------------------------------------------------------------
 // Common Swizzles 
 namespace Swizzles
 {
-   extern Swizzle<U8, 4> bgra;
+   extern SwapRBSwizzle bgra;
    extern Swizzle<U8, 4> argb;
    extern Swizzle<U8, 4> rgba;
    extern Swizzle<U8, 4> abgr;
@@ -0,0 +1,515 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _TOPENHASHTABLE_H_
+#define _TOPENHASHTABLE_H_
+
+#ifndef _TDICTIONARY_H_
+#include "core/util/tDictionary.h"
+#endif
+
+
+/// An open addressing hash table.
+///
+/// Unlike HashTable, which chains nodes off a bucket array, all pairs live
+/// in one flat array and collisions are resolved by linear probing.  This
+/// keeps lookups within a few cache lines and avoids a node per entry.  Keys
+/// are unique.  The table can be used as the sequence of a Map:
+///
+/// @code
+/// Map< String, Foo*, OpenHashTable< String, Foo* > > map;
+/// @endcode
+///
+/// Hashing and key comparison use DictHash::hash() and KeyCmp::equals() just
+/// like HashTable.
+///
+/// @note Inserting may move the pairs, so don't hold on to iterators or
+///   pointers to values across inserts.  Erasing moves later entries of the
+///   same probe run back, so restart iteration after erasing.
+/// @ingroup UtilContainers
+template<typename Key, typename Value >
+class OpenHashTable
+{
+public:
+   struct Pair
+   {
+      Key  key;
+      Value value;
+      Pair() {}
+      Pair(Key k,Value v)
+         :  key(k),
+            value(v)
+      {}
+   };
+
+private:
+   enum
+   {
+      /// Smallest table allocated.
+      MinTableSize = 16,
+   };
+
+   U32* mHashes;                       ///< Hash of each slot's key, 0 for empty slots
+   Pair* mPairs;                       ///< Slot storage
+   U32 mTableSize;                     ///< Number of slots, always a power of two
+   U32 mShift;                         ///< 32 - log2( mTableSize )
+   U32 mSize;                          ///< Number of keys in the table
+
+   /// Hash for @a key.  Never returns 0 as that marks empty slots.
+   static U32 _hash(const Key& key) { return DictHash::hash(key) | 1; }
+
+   /// Slot a key with the given hash would like to live in.  The hash is
+   /// scrambled so keys like pointers and packed colors, which differ only
+   /// in some bits, still spread over the table.
+   U32 _home(U32 hash) const { return ( hash * 2654435769U ) >> mShift; }
+
+   U32 _next(U32 index) const;
+   U32 _findSlot(const Key& key, U32 hash) const;
+   U32 _insert(const Key& key, const Value& value, U32 hash);
+   void _eraseSlot(U32 index);
+   void _resize(U32 size);
+   void _destroy();
+
+public:
+   // Iterator support
+   template<typename U, typename M>
+   class _Iterator {
+      friend class OpenHashTable;
+      M* mHashTable;
+      U32 mIndex;
+   public:
+      typedef U  ValueType;
+      typedef U* Pointer;
+      typedef U& Reference;
+
+      _Iterator()
+      {
+         mHashTable = 0;
+         mIndex = 0;
+      }
+
+      _Iterator(M* table,U32 index)
+      {
+         mHashTable = table;
+         mIndex = index;
+      }
+
+      _Iterator& operator++()
+      {
+         mIndex = mHashTable->_next(mIndex + 1);
+         return *this;
+      }
+
+      _Iterator operator++(int)
+      {
+         _Iterator itr(*this);
+         ++(*this);
+         return itr;
+      }
+
+      bool operator==(const _Iterator& b) const
+      {
+         return mHashTable == b.mHashTable && mIndex == b.mIndex;
+      }
+
+      bool operator!=(const _Iterator& b) const
+      {
+         return !(*this == b);
+      }
+
+      U* operator->() const
+      {
+         return &mHashTable->mPairs[mIndex];
+      }
+
+      U& operator*() const
+      {
+         return mHashTable->mPairs[mIndex];
+      }
+   };
+
+   // Types
+   typedef Pair        ValueType;
+   typedef Pair&       Reference;
+   typedef const Pair& ConstReference;
+
+   typedef _Iterator<Pair,OpenHashTable>  Iterator;
+   typedef _Iterator<const Pair,const OpenHashTable>  ConstIterator;
+   typedef S32         DifferenceType;
+   typedef U32         SizeType;
+
+   // Initialization
+   OpenHashTable();
+   ~OpenHashTable();
+   OpenHashTable(const OpenHashTable& p);
+
+   // Management
+   U32  size() const;                  ///< Return the number of elements
+   U32  tableSize() const;             ///< Return the number of slots
+   void clear();                       ///< Empty the table
+   void resize(U32 size);
+   bool isEmpty() const;               ///< Returns true if the table is empty
+
+   // Insert & erase elements
+   Iterator insertUnique(const Key& key, const Value&);
+   void erase(Iterator);               ///< Erase the given entry
+   void erase(const Key& key);         ///< Erase the key from the table
+   void erase(const Key & key, const Value & value); ///< Erase entry for this key-value pair
+
+   // Lookup
+   Iterator findOrInsert(const Key& key);
+   Iterator find(const Key&);          ///< Find the entry for the given key
+   ConstIterator find(const Key&) const;    ///< Find the entry for the given key
+   bool find(const Key & key, Value & value); ///< Find the entry for the given key
+   S32 count(const Key&) const;              ///< Count the number of matching keys in the table
+
+   // Forward Iterator access
+   Iterator       begin();             ///< Iterator to first element
+   ConstIterator begin() const;        ///< Iterator to first element
+   Iterator       end();               ///< Iterator to last element + 1
+   ConstIterator end() const;          ///< Iterator to last element + 1
+
+   void operator=(const OpenHashTable& p);
+};
+
+template<typename Key, typename Value> OpenHashTable<Key,Value>::OpenHashTable()
+{
+   mHashes = NULL;
+   mPairs = NULL;
+   mTableSize = 0;
+   mShift = 32;
+   mSize = 0;
+}
+
+template<typename Key, typename Value> OpenHashTable<Key,Value>::OpenHashTable(const OpenHashTable& p)
+{
+   mHashes = NULL;
+   mPairs = NULL;
+   mTableSize = 0;
+   mShift = 32;
+   mSize = 0;
+   *this = p;
+}
+
+template<typename Key, typename Value> OpenHashTable<Key,Value>::~OpenHashTable()
+{
+   _destroy();
+}
+
+//-----------------------------------------------------------------------------
+
+template<typename Key, typename Value>
+inline U32 OpenHashTable<Key,Value>::_next(U32 index) const
+{
+   for (; index < mTableSize; index++)
+      if (mHashes[index])
+         return index;
+   return mTableSize;
+}
+
+/// Return the slot holding @a key or mTableSize if it isn't in the table.
+template<typename Key, typename Value>
+U32 OpenHashTable<Key,Value>::_findSlot(const Key& key, U32 hash) const
+{
+   if (!mSize)
+      return mTableSize;
+
+   const U32 mask = mTableSize - 1;
+   for (U32 index = _home(hash); mHashes[index]; index = (index + 1) & mask)
+      if (mHashes[index] == hash && KeyCmp::equals<Key>( mPairs[index].key, key ))
+         return index;
+
+   return mTableSize;
+}
+
+/// Put a key known not to be in the table into the first free slot of its
+/// probe run.  Grows the table to keep it at most three quarters full.
+template<typename Key, typename Value>
+U32 OpenHashTable<Key,Value>::_insert(const Key& key, const Value& value, U32 hash)
+{
+   if ((mSize + 1) * 4 > mTableSize * 3)
+      _resize(mSize + 1);
+
+   const U32 mask = mTableSize - 1;
+   U32 index = _home(hash);
+   while (mHashes[index])
+      index = (index + 1) & mask;
+
+   constructInPlace(&mPairs[index], Pair(key, value));
+   mHashes[index] = hash;
+   mSize++;
+   return index;
+}
+
+/// Empty a slot and shift the rest of its probe run back so that lookups
+/// never stop early on a hole.  This avoids tombstones.
+template<typename Key, typename Value>
+void OpenHashTable<Key,Value>::_eraseSlot(U32 index)
+{
+   const U32 mask = mTableSize - 1;
+
+   destructInPlace(&mPairs[index]);
+   mHashes[index] = 0;
+   mSize--;
+
+   for (U32 next = (index + 1) & mask; mHashes[next]; next = (next + 1) & mask)
+   {
+      // Entries may move back as long as that doesn't put them in
+      // front of their home slot.
+      const U32 home = _home(mHashes[next]);
+      if (((next - home) & mask) < ((next - index) & mask))
+         continue;
+
+      constructInPlace(&mPairs[index], (const Pair*) &mPairs[next]);
+      destructInPlace(&mPairs[next]);
+      mHashes[index] = mHashes[next];
+      mHashes[next] = 0;
+      index = next;
+   }
+}
+
+template<typename Key, typename Value>
+void OpenHashTable<Key,Value>::_resize(U32 size)
+{
+   if (size < mSize)
+      size = mSize;
+
+   U32 tableSize = MinTableSize;
+   U32 shift = 32 - 4;
+   while (size * 4 > tableSize * 3)
+   {
+      tableSize <<= 1;
+      shift--;
+   }
+
+   if (tableSize == mTableSize)
+      return;
+
+   U32* oldHashes = mHashes;
+   Pair* oldPairs = mPairs;
+   const U32 oldSize = mTableSize;
+
+   mHashes = (U32*) dMalloc(tableSize * sizeof(U32));
+   mPairs = (Pair*) dMalloc(tableSize * sizeof(Pair));
+   dMemset(mHashes, 0, tableSize * sizeof(U32));
+   mTableSize = tableSize;
+   mShift = shift;
+
+   const U32 mask = mTableSize - 1;
+   for (U32 i = 0; i < oldSize; i++)
+   {
+      if (!oldHashes[i])
+         continue;
+
+      U32 index = _home(oldHashes[i]);
+      while (mHashes[index])
+         index = (index + 1) & mask;
+
+      constructInPlace(&mPairs[index], (const Pair*) &oldPairs[i]);
+      destructInPlace(&oldPairs[i]);
+      mHashes[index] = oldHashes[i];
+   }
+
+   dFree(oldHashes);
+   dFree(oldPairs);
+}
+
+template<typename Key, typename Value>
+void OpenHashTable<Key,Value>::_destroy()
+{
+   for (U32 i = 0; i < mTableSize; i++)
+      if (mHashes[i])
+         destructInPlace(&mPairs[i]);
+
+   dFree(mHashes);
+   dFree(mPairs);
+   mHashes = NULL;
+   mPairs = NULL;
+   mTableSize = 0;
+   mShift = 32;
+   mSize = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// management
+
+template<typename Key, typename Value>
+inline U32 OpenHashTable<Key,Value>::size() const
+{
+   return mSize;
+}
+
+template<typename Key, typename Value>
+inline U32 OpenHashTable<Key,Value>::tableSize() const
+{
+   return mTableSize;
+}
+
+template<typename Key, typename Value>
+inline void OpenHashTable<Key,Value>::clear()
+{
+   _destroy();
+}
+
+/// Resize the table for an estimated number of elements.
+/// Used to avoid rehashing while inserting when the number of elements is
+/// known in advance.  The table never shrinks below its current contents.
+template<typename Key, typename Value>
+inline void OpenHashTable<Key,Value>::resize(U32 size)
+{
+   _resize(size);
+}
+
+template<typename Key, typename Value>
+inline bool OpenHashTable<Key,Value>::isEmpty() const
+{
+   return mSize == 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// add & remove elements
+
+/// Insert the key value pair but don't insert duplicates.
+/// If the key already exists in the table the function will fail and end()
+/// is returned.
+template<typename Key, typename Value>
+typename OpenHashTable<Key,Value>::Iterator OpenHashTable<Key,Value>::insertUnique(const Key& key, const Value& x)
+{
+   const U32 hash = _hash(key);
+   if (_findSlot(key, hash) != mTableSize)
+      return end();
+   return Iterator(this, _insert(key, x, hash));
+}
+
+template<typename Key, typename Value>
+void OpenHashTable<Key,Value>::erase(const Key& key)
+{
+   const U32 index = _findSlot(key, _hash(key));
+   if (index != mTableSize)
+      _eraseSlot(index);
+}
+
+template<typename Key, typename Value>
+void OpenHashTable<Key,Value>::erase(Iterator node)
+{
+   if (node.mIndex < mTableSize && mHashes[node.mIndex])
+      _eraseSlot(node.mIndex);
+}
+
+template<typename Key, typename Value>
+void OpenHashTable<Key,Value>::erase(const Key & key, const Value & value)
+{
+   const U32 index = _findSlot(key, _hash(key));
+   if (index != mTableSize && mPairs[index].value == value)
+      _eraseSlot(index);
+}
+
+//-----------------------------------------------------------------------------
+
+/// Find the key, or insert a one if it doesn't exist.
+template<typename Key, typename Value>
+typename OpenHashTable<Key,Value>::Iterator OpenHashTable<Key,Value>::findOrInsert(const Key& key)
+{
+   const U32 hash = _hash(key);
+   U32 index = _findSlot(key, hash);
+   if (index == mTableSize)
+      index = _insert(key, Value(), hash);
+   return Iterator(this, index);
+}
+
+template<typename Key, typename Value>
+typename OpenHashTable<Key,Value>::Iterator OpenHashTable<Key,Value>::find(const Key& key)
+{
+   return Iterator(this, _findSlot(key, _hash(key)));
+}
+
+template<typename Key, typename Value>
+typename OpenHashTable<Key,Value>::ConstIterator OpenHashTable<Key,Value>::find(const Key& key) const
+{
+   return ConstIterator(this, _findSlot(key, _hash(key)));
+}
+
+template<typename Key, typename Value>
+bool OpenHashTable<Key,Value>::find(const Key & key, Value & value)
+{
+   const U32 index = _findSlot(key, _hash(key));
+   if (index == mTableSize)
+      return false;
+   value = mPairs[index].value;
+   return true;
+}
+
+template<typename Key, typename Value>
+S32 OpenHashTable<Key,Value>::count(const Key& key) const
+{
+   return _findSlot(key, _hash(key)) != mTableSize ? 1 : 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Iterator access
+
+template<typename Key, typename Value>
+inline typename OpenHashTable<Key,Value>::Iterator OpenHashTable<Key,Value>::begin()
+{
+   return Iterator(this,_next(0));
+}
+
+template<typename Key, typename Value>
+inline typename OpenHashTable<Key,Value>::ConstIterator OpenHashTable<Key,Value>::begin() const
+{
+   return ConstIterator(this,_next(0));
+}
+
+template<typename Key, typename Value>
+inline typename OpenHashTable<Key,Value>::Iterator OpenHashTable<Key,Value>::end()
+{
+   return Iterator(this,mTableSize);
+}
+
+template<typename Key, typename Value>
+inline typename OpenHashTable<Key,Value>::ConstIterator OpenHashTable<Key,Value>::end() const
+{
+   return ConstIterator(this,mTableSize);
+}
+
+
+//-----------------------------------------------------------------------------
+// operators
+
+template<typename Key, typename Value>
+void OpenHashTable<Key,Value>::operator=(const OpenHashTable& p)
+{
+   if (&p == this)
+      return;
+
+   _destroy();
+   _resize(p.mSize);
+
+   for (U32 i = 0; i < p.mTableSize; i++)
+      if (p.mHashes[i])
+         _insert(p.mPairs[i].key, p.mPairs[i].value, p.mHashes[i]);
+}
+
+#endif // _TOPENHASHTABLE_H_
@@ -0,0 +1,210 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _TSMALLVECTOR_H_
+#define _TSMALLVECTOR_H_
+
+#ifndef _PLATFORM_H_
+   #include "platform/platform.h"
+#endif
+
+
+/// A dynamic array that keeps its first @a N elements inside itself and
+/// only allocates from the heap when it grows beyond that.
+///
+/// Use it for temporaries that are usually small, like the per-query and
+/// per-polygon lists in collision code, where a Vector would allocate on
+/// the first push_back.  It implements the commonly used part of the
+/// Vector interface.
+///
+/// @note The inline storage is aligned for pointers and doubles only, so
+///   don't use this for types that need stricter alignment.
+template< typename T, U32 N >
+class SmallVector
+{
+   protected:
+
+      U32 mElementCount;
+      U32 mArraySize;
+      T* mArray;
+
+      union
+      {
+         U8 mBytes[ N * sizeof( T ) ];
+         F64 mAlignF64;
+         void* mAlignPtr;
+      } mInline;
+
+      T* _getInline() { return reinterpret_cast< T* >( mInline.mBytes ); }
+
+      /// Move the elements to a heap array with room for @a count elements.
+      void _grow( U32 count );
+
+   private:
+
+      SmallVector( const SmallVector& );
+      SmallVector& operator =( const SmallVector& );
+
+   public:
+
+      typedef T* iterator;
+      typedef const T* const_iterator;
+
+      SmallVector()
+         : mElementCount( 0 ), mArraySize( N ), mArray( _getInline() ) {}
+
+      ~SmallVector()
+      {
+         clear();
+         if( mArray != _getInline() )
+            dFree( mArray );
+      }
+
+      U32 size() const { return mElementCount; }
+      bool empty() const { return ( mElementCount == 0 ); }
+      U32 capacity() const { return mArraySize; }
+
+      /// Return true if the elements are stored on the heap.
+      bool isOnHeap() const { return mArray != reinterpret_cast< const T* >( mInline.mBytes ); }
+
+      T* address() { return mArray; }
+      const T* address() const { return mArray; }
+
+      iterator begin() { return mArray; }
+      iterator end() { return mArray + mElementCount; }
+      const_iterator begin() const { return mArray; }
+      const_iterator end() const { return mArray + mElementCount; }
+
+      T& first()
+      {
+         AssertFatal( !empty(), "SmallVector::first - Vector is empty" );
+         return mArray[ 0 ];
+      }
+      const T& first() const
+      {
+         AssertFatal( !empty(), "SmallVector::first - Vector is empty" );
+         return mArray[ 0 ];
+      }
+      T& last()
+      {
+         AssertFatal( !empty(), "SmallVector::last - Vector is empty" );
+         return mArray[ mElementCount - 1 ];
+      }
+      const T& last() const
+      {
+         AssertFatal( !empty(), "SmallVector::last - Vector is empty" );
+         return mArray[ mElementCount - 1 ];
+      }
+
+      T& operator []( U32 index )
+      {
+         AssertFatal( index < mElementCount, "SmallVector::operator[] - Index out of range" );
+         return mArray[ index ];
+      }
+      const T& operator []( U32 index ) const
+      {
+         AssertFatal( index < mElementCount, "SmallVector::operator[] - Index out of range" );
+         return mArray[ index ];
+      }
+
+      /// Make sure there is room for @a count elements without allocating.
+      void reserve( U32 count )
+      {
+         if( count > mArraySize )
+            _grow( count );
+      }
+
+      void push_back( const T& value )
+      {
+         if( mElementCount == mArraySize )
+            _grow( mArraySize * 2 );
+         constructInPlace( &mArray[ mElementCount ], &value );
+         mElementCount ++;
+      }
+
+      void pop_back()
+      {
+         AssertFatal( !empty(), "SmallVector::pop_back - Vector is empty" );
+         mElementCount --;
+         destructInPlace( &mArray[ mElementCount ] );
+      }
+
+      /// Set the number of elements, default constructing new ones.
+      void setSize( U32 count )
+      {
+         reserve( count );
+         while( mElementCount < count )
+            constructInPlace( &mArray[ mElementCount ++ ] );
+         while( mElementCount > count )
+            destructInPlace( &mArray[ -- mElementCount ] );
+      }
+
+      /// Remove the element at @a index, keeping the order of the rest.
+      void erase( U32 index )
+      {
+         AssertFatal( index < mElementCount, "SmallVector::erase - Index out of range" );
+         for( U32 i = index + 1; i < mElementCount; ++ i )
+            mArray[ i - 1 ] = mArray[ i ];
+         pop_back();
+      }
+
+      /// Remove the element at @a index by moving the last element into its place.
+      void erase_fast( U32 index )
+      {
+         AssertFatal( index < mElementCount, "SmallVector::erase_fast - Index out of range" );
+         if( index != mElementCount - 1 )
+            mArray[ index ] = mArray[ mElementCount - 1 ];
+         pop_back();
+      }
+
+      void fill( const T& value )
+      {
+         for( U32 i = 0; i < mElementCount; ++ i )
+            mArray[ i ] = value;
+      }
+
+      /// Destruct all elements.  Heap memory is kept for reuse.
+      void clear()
+      {
+         while( mElementCount )
+            destructInPlace( &mArray[ -- mElementCount ] );
+      }
+};
+
+template< typename T, U32 N >
+void SmallVector< T, N >::_grow( U32 count )
+{
+   T* newArray = ( T* ) dMalloc( count * sizeof( T ) );
+   for( U32 i = 0; i < mElementCount; ++ i )
+   {
+      constructInPlace( &newArray[ i ], ( const T* ) &mArray[ i ] );
+      destructInPlace( &mArray[ i ] );
+   }
+
+   if( mArray != _getInline() )
+      dFree( mArray );
+
+   mArray = newArray;
+   mArraySize = count;
+}
+
+#endif // !_TSMALLVECTOR_H_
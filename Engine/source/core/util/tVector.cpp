@@ -25,6 +25,10 @@
 
 #include "platform/profiler.h"
 
+#ifdef TORQUE_VECTOR_SIZECLASS_ALLOCATOR
+#  include "core/sizeClassAllocator.h"
+#endif
+
 
 #ifdef TORQUE_DEBUG_GUARD
 
@@ -79,8 +83,12 @@ bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 el
       if (newCount % VectorBlockSize)
          blocks++;
       S32 mem_size = blocks * VectorBlockSize * elemSize;
+#ifdef TORQUE_VECTOR_SIZECLASS_ALLOCATOR
+      *arrayPtr = SizeClassAllocator::realloc(*arrayPtr, mem_size, SizeClassAllocator::TagVector);
+#else
       *arrayPtr = *arrayPtr ? dRealloc(*arrayPtr,mem_size) :
          dMalloc(mem_size);
+#endif
 
       *aCount = newCount;
       *aSize = blocks * VectorBlockSize;
@@ -89,7 +97,7 @@ bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 el
 
    if (*arrayPtr) 
    {
-      dFree(*arrayPtr);
+      VectorFree(*arrayPtr);
       *arrayPtr = 0;
    }
 
@@ -98,4 +106,13 @@ bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 el
    return true;
 }
 
+#ifdef TORQUE_VECTOR_SIZECLASS_ALLOCATOR
+
+void VectorFree(void *arrayPtr)
+{
+   SizeClassAllocator::free(arrayPtr);
+}
+
+#endif
+
 #endif
@@ -43,6 +43,15 @@ extern bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount,
 extern bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize);
 #endif
 
+/// Vector storage is served by the size-class allocator if enabled.  The
+/// debug guard needs to see every allocation so it takes precedence.
+#if defined(TORQUE_SIZECLASS_ALLOCATOR) && !defined(TORQUE_DEBUG_GUARD)
+#  define TORQUE_VECTOR_SIZECLASS_ALLOCATOR
+extern void VectorFree(void *arrayPtr);
+#else
+#  define VectorFree(arrayPtr) dFree(arrayPtr)
+#endif
+
 /// Use the following macro to bind a vector to a particular line
 ///  of the owning class for memory tracking purposes
 #ifdef TORQUE_DEBUG_GUARD
@@ -191,7 +200,7 @@ class Vector
 template<class T> inline Vector<T>::~Vector()
 {
    clear();
-   dFree(mArray);
+   VectorFree(mArray);
 }
 
 template<class T> inline Vector<T>::Vector(const U32 initialSize)
@@ -126,4 +126,25 @@ TEST(Swizzle, Swizzle)
    }
 };
 
+TEST(Swizzle, SwapRB)
+{
+   // An odd pixel count to cover the tail of the vectorized loop.
+   const U32 numBytes = 37 * 4;
+   U8 source[ numBytes ], expected[ numBytes ], result[ numBytes ];
+   for( U32 i = 0; i < numBytes; i++ )
+      source[i] = U8( gRandGen.randI() );
+
+   dsize_t bgraSwzl[] = { 2, 1, 0, 3 };
+   Swizzle<U8,4> bgraSwizzle( bgraSwzl );
+   bgraSwizzle.ToBuffer( expected, source, numBytes );
+
+   Swizzles::bgra.ToBuffer( result, source, numBytes );
+   EXPECT_EQ( dMemcmp( result, expected, numBytes ), 0 )
+      << "Swizzles::bgra does not match the generic swizzle";
+
+   Swizzles::bgra.InPlace( result, numBytes );
+   EXPECT_EQ( dMemcmp( result, source, numBytes ), 0 )
+      << "Swizzles::bgra in place reverse test failed";
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "core/util/tOpenHashTable.h"
+
+TEST(OpenHashTable, InsertFindErase)
+{
+   typedef Map< U32, U32, OpenHashTable< U32, U32 > > TestMap;
+   TestMap map;
+   EXPECT_TRUE( map.isEmpty() );
+
+   for( U32 i = 0; i < 1000; ++ i )
+      map[ i * 16 ] = i;
+   EXPECT_EQ( map.size(), 1000 );
+
+   // Duplicates are rejected.
+   EXPECT_TRUE( map.insert( 16, 5 ) == map.end() );
+
+   // Erase every other key, which moves probe runs around.
+   for( U32 i = 0; i < 1000; i += 2 )
+      map.erase( i * 16 );
+   EXPECT_EQ( map.size(), 500 );
+
+   for( U32 i = 0; i < 1000; ++ i )
+   {
+      U32 value;
+      const bool found = map.tryGetValue( i * 16, value );
+      EXPECT_EQ( found, ( i & 1 ) != 0 );
+      if( found )
+         EXPECT_EQ( value, i );
+   }
+
+   U32 count = 0;
+   for( TestMap::Iterator iter = map.begin(); iter != map.end(); ++ iter )
+      count ++;
+   EXPECT_EQ( count, 500 );
+
+   TestMap copy( map );
+   EXPECT_EQ( copy.size(), 500 );
+   EXPECT_TRUE( copy.contains( 16 ) );
+
+   map.clear();
+   EXPECT_TRUE( map.isEmpty() );
+   EXPECT_FALSE( map.contains( 16 ) );
+};
+
+TEST(OpenHashTable, StringKeysIgnoreCase)
+{
+   OpenHashTable< String, S32 > table;
+   table.insertUnique( "Art/Foo.png", 1 );
+   table.insertUnique( "art/bar.png", 2 );
+
+   EXPECT_TRUE( table.find( "ART/FOO.PNG" ) != table.end() );
+   EXPECT_EQ( table.find( "art/foo.png" )->value, 1 );
+   EXPECT_EQ( table.count( "Art/Bar.png" ), 1 );
+
+   table.erase( "ART/BAR.PNG", 3 );
+   EXPECT_EQ( table.size(), 2 );
+   table.erase( "ART/BAR.PNG", 2 );
+   EXPECT_EQ( table.size(), 1 );
+};
+
+#endif
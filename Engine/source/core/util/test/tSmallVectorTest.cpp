@@ -0,0 +1,93 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "core/util/tSmallVector.h"
+
+TEST(SmallVector, GrowsFromInlineToHeap)
+{
+   SmallVector< U32, 4 > vector;
+   EXPECT_TRUE( vector.empty() );
+   EXPECT_FALSE( vector.isOnHeap() );
+
+   for( U32 i = 0; i < 4; ++ i )
+      vector.push_back( i );
+   EXPECT_FALSE( vector.isOnHeap() );
+
+   for( U32 i = 4; i < 20; ++ i )
+      vector.push_back( i );
+   EXPECT_TRUE( vector.isOnHeap() );
+   EXPECT_EQ( vector.size(), 20 );
+
+   for( U32 i = 0; i < 20; ++ i )
+      EXPECT_EQ( vector[ i ], i );
+};
+
+TEST(SmallVector, Erase)
+{
+   SmallVector< U32, 8 > vector;
+   for( U32 i = 0; i < 5; ++ i )
+      vector.push_back( i );
+
+   vector.erase( 1 );
+   EXPECT_EQ( vector.size(), 4 );
+   EXPECT_EQ( vector[ 0 ], 0 );
+   EXPECT_EQ( vector[ 1 ], 2 );
+   EXPECT_EQ( vector.last(), 4 );
+
+   vector.erase_fast( 0 );
+   EXPECT_EQ( vector.size(), 3 );
+   EXPECT_EQ( vector.first(), 4 );
+};
+
+namespace {
+
+struct Counted
+{
+   static S32 smAlive;
+   Counted() { smAlive ++; }
+   Counted( const Counted& ) { smAlive ++; }
+   ~Counted() { smAlive --; }
+};
+
+S32 Counted::smAlive = 0;
+
+}
+
+TEST(SmallVector, ConstructsAndDestructs)
+{
+   {
+      SmallVector< Counted, 2 > vector;
+      vector.setSize( 3 );
+      EXPECT_EQ( Counted::smAlive, 3 );
+
+      vector.pop_back();
+      EXPECT_EQ( Counted::smAlive, 2 );
+
+      vector.push_back( Counted() );
+      EXPECT_EQ( Counted::smAlive, 3 );
+   }
+   EXPECT_EQ( Counted::smAlive, 0 );
+};
+
+#endif
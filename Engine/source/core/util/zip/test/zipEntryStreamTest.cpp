@@ -0,0 +1,96 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "core/util/zip/zipArchive.h"
+
+using namespace Zip;
+
+static U8 getTestByte(U32 file, U32 i)
+{
+   return U8((i / (file + 3)) % 11 + file * 16);
+}
+
+TEST(ZipArchive, InterleavedReads)
+{
+   const char *zipName = "zipEntryStreamTest.zip";
+   const char *names[] = { "a.bin", "dir/b.bin" };
+   const U32 size = 200000;
+
+   Vector<U8> data;
+   data.setSize(size);
+
+   {
+      ZipArchive zip;
+      ASSERT_TRUE(zip.openArchive(zipName, ZipArchive::Write));
+      for (U32 file = 0; file < 2; file++)
+      {
+         for (U32 i = 0; i < size; i++)
+            data[i] = getTestByte(file, i);
+
+         Stream *stream = zip.openFile(names[file], ZipArchive::Write);
+         ASSERT_TRUE(stream != NULL);
+         EXPECT_TRUE(stream->write(size, data.address()));
+         zip.closeFile(stream);
+      }
+      zip.closeArchive();
+   }
+
+   ZipArchive zip;
+   ASSERT_TRUE(zip.openArchive(zipName, ZipArchive::Read));
+
+   Stream *streams[2];
+   for (U32 file = 0; file < 2; file++)
+   {
+      streams[file] = zip.openFile(names[file], ZipArchive::Read);
+      ASSERT_TRUE(streams[file] != NULL);
+   }
+
+   // Reading one file must not move the other's position in the zip.
+   const U32 chunk = 1000;
+   bool match = true;
+   for (U32 pos = 0; pos < size && match; pos += chunk)
+   {
+      for (U32 file = 0; file < 2; file++)
+      {
+         const U32 count = getMin(chunk, size - pos);
+         match = match && streams[file]->read(count, data.address());
+         for (U32 i = 0; i < count && match; i++)
+            match = data[i] == getTestByte(file, pos + i);
+      }
+   }
+   EXPECT_TRUE(match) << "Interleaved reads returned the wrong data";
+
+   EXPECT_TRUE(streams[1]->setPosition(0));
+   EXPECT_TRUE(streams[1]->read(chunk, data.address()));
+   EXPECT_EQ(data[chunk - 1], getTestByte(1, chunk - 1));
+
+   for (U32 file = 0; file < 2; file++)
+      zip.closeFile(streams[file]);
+   zip.closeArchive();
+
+   dFileDelete(zipName);
+};
+
+#endif
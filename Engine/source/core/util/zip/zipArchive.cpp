@@ -34,6 +34,7 @@
 
 #include "core/util/zip/compressor.h"
 #include "core/util/zip/zipTempStream.h"
+#include "core/util/zip/zipEntryStream.h"
 #include "core/util/zip/zipStatFilter.h"
 
 #ifdef TORQUE_ZIP_AES
@@ -57,7 +58,9 @@ ZipArchive::ZipArchive() :
    mDiskStream(NULL),
    mMode(Read),
    mRoot(NULL),
-   mFilename(NULL)
+   mFilename(NULL),
+   mMappedData(NULL),
+   mMappedSize(0)
 {
 }
 
@@ -613,7 +616,11 @@ bool ZipArchive::openArchive(Stream *stream, AccessMode mode /* = Read */)
    {
       bool ret = readCentralDirectory();
       if(mode == Read)
+      {
+         if(ret)
+            mapArchive();
          return ret;
+      }
 
       return true;
    }
@@ -642,6 +649,14 @@ void ZipArchive::closeArchive()
    }
    mTempFiles.clear();
 
+   if(mMappedFile != NULL)
+   {
+      mMappedFile->unmap();
+      mMappedFile = NULL;
+   }
+   mMappedData = NULL;
+   mMappedSize = 0;
+
    // Close the zip file stream and clean up
    if(mDiskStream)
    {
@@ -717,6 +732,14 @@ void ZipArchive::closeFile(Stream *stream)
       delete currentStream;
    }
 
+   // Streams of files read from the zip itself are ours
+   ZipEntryStream *entryStream = dynamic_cast<ZipEntryStream *>(stream);
+   if(entryStream)
+   {
+      delete entryStream;
+      return;
+   }
+
    ZipTempStream *tempStream = dynamic_cast<ZipTempStream *>(stream);
    if(tempStream && (tempStream->getCentralDir()->mInternalFlags & CDFileOpen))
    {
@@ -737,6 +760,7 @@ Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
       return NULL;
 
    Stream *stream = mStream;
+   ZipEntryStream *entryStream = NULL;
 
    if(fileCD->mInternalFlags & CDFileDirty)
    {
@@ -767,21 +791,38 @@ Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
    }
    else
    {
-      // Read from the zip file directly
-      if(! mStream->setPosition(fileCD->mLocalHeadOffset))
+      // Read from the zip file directly, through a stream of our own so
+      // other open files don't move our position in the zip file.
+      const U32 zipSize = mStream->getStreamSize();
+      if(fileCD->mLocalHeadOffset >= zipSize)
       {
          if(isVerbose())
             Con::errorf("ZipArchive::openFile - %s: Could not locate local header for file %s", mFilename ? mFilename : "<no filename>", fileCD->mFilename.c_str());
          return NULL;
       }
 
+      entryStream = new ZipEntryStream(this, fileCD->mLocalHeadOffset, zipSize - fileCD->mLocalHeadOffset);
+
       FileHeader fh;
-      if(! fh.read(mStream))
+      if(! fh.read(entryStream))
       {
          if(isVerbose())
             Con::errorf("ZipArchive::openFile - %s: Could not read local header for file %s", mFilename ? mFilename : "<no filename>", fileCD->mFilename.c_str());
+         delete entryStream;
          return NULL;
       }
+
+      const U32 dataStart = entryStream->getArchivePosition();
+      if(fileCD->mCompressedSize > zipSize - dataStart)
+      {
+         if(isVerbose())
+            Con::errorf("ZipArchive::openFile - %s: File %s is truncated", mFilename ? mFilename : "<no filename>", fileCD->mFilename.c_str());
+         delete entryStream;
+         return NULL;
+      }
+
+      entryStream->setRange(dataStart, fileCD->mCompressedSize);
+      stream = entryStream;
    }
 
    Stream *attachTo = stream;
@@ -803,6 +844,7 @@ Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
          if(! cryptStream->attachStream(stream))
          {
             delete cryptStream;
+            delete entryStream;
             return NULL;
          }
 
@@ -815,12 +857,82 @@ Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
    {
       if(isVerbose())
          Con::errorf("ZipArchive::openFile - %s: Unsupported compression method (%d) for file %s", mFilename ? mFilename : "<no filename>", fileCD->mCompressMethod, fileCD->mFilename.c_str());
+      if(attachTo != stream)
+         closeFile(attachTo);
+      else
+         delete entryStream;
       return NULL;
    }
 
    return comp->createReadStream(fileCD, attachTo);
 }
 
+U8 *ZipArchive::mapFileForRead(const CentralDir *fileCD, U32 &outSize)
+{
+   outSize = 0;
+
+   if(mMode != Read || (fileCD->mInternalFlags & (CDFileDeleted | CDFileDirty)) != 0)
+      return NULL;
+
+   if(fileCD->mCompressMethod != Stored || (fileCD->mFlags & Encrypted))
+      return NULL;
+
+   if(mMappedData == NULL)
+      return NULL;
+
+   // The data follows the local header, whose extra field may differ
+   // in size from the one in the central directory.
+   const U32 localHeaderSize = 30;
+   const U32 localHeaderSignature = 0x04034b50;
+   const U32 offset = fileCD->mLocalHeadOffset;
+   if(offset > mMappedSize || mMappedSize - offset < localHeaderSize)
+      return NULL;
+
+   const U8 *header = mMappedData + offset;
+   const U32 signature = header[0] | (header[1] << 8) | (header[2] << 16) | (header[3] << 24);
+   if(signature != localHeaderSignature)
+      return NULL;
+
+   const U32 nameLength = header[26] | (header[27] << 8);
+   const U32 extraLength = header[28] | (header[29] << 8);
+   const U32 dataOffset = offset + localHeaderSize + nameLength + extraLength;
+   if(dataOffset > mMappedSize || mMappedSize - dataOffset < fileCD->mUncompressedSize)
+      return NULL;
+
+   outSize = fileCD->mUncompressedSize;
+   return mMappedData + dataOffset;
+}
+
+void ZipArchive::mapArchive()
+{
+   FileStream *fileStream = dynamic_cast<FileStream *>(mStream);
+   if(fileStream == NULL || fileStream->getFile() == NULL)
+      return;
+
+   mMappedData = fileStream->getFile()->map(mMappedSize);
+   if(mMappedData != NULL)
+      mMappedFile = fileStream->getFile();
+   else
+      mMappedSize = 0;
+}
+
+bool ZipArchive::readData(U32 offset, U32 size, void *buffer)
+{
+   if(mMappedData != NULL)
+   {
+      if(offset > mMappedSize || mMappedSize - offset < size)
+         return false;
+
+      dMemcpy(buffer, mMappedData + offset, size);
+      return true;
+   }
+
+   MutexHandle lock;
+   lock.lock(&mStreamMutex, true);
+
+   return mStream->setPosition(offset) && mStream->read(size, buffer);
+}
+
 //-----------------------------------------------------------------------------
 
 bool ZipArchive::addFile(const char *filename, const char *pathInZip, bool replace /* = true */)
@@ -30,6 +30,8 @@
 #include "core/util/tDictionary.h"
 #include "core/util/timeClass.h"
 
+#include "platform/threads/mutex.h"
+
 #ifndef _ZIPARCHIVE_H_
 #define _ZIPARCHIVE_H_
 
@@ -316,6 +318,16 @@ protected:
 
    Vector<ZipTempStream *> mTempFiles;
 
+   /// The zip file, mapped when it is opened for reading, or NULL.
+   Torque::FS::FileRef mMappedFile;
+   U8 *mMappedData;
+   U32 mMappedSize;
+
+   /// Guards seeking and reading mStream in readData().
+   Mutex mStreamMutex;
+
+   void mapArchive();
+
    bool readCentralDirectory();
 
    void insertEntry(ZipEntry *ze);
@@ -496,6 +508,38 @@ public:
    /// @see ZipArchive::openFile(const char *, AccessMode), ZipArchive::closeFile()
    //-----------------------------------------------------------------------------
    Stream *openFileForRead(const CentralDir *fileCD);
+
+   //-----------------------------------------------------------------------------
+   /// @brief Map a file within the zip file into memory
+   ///
+   /// Only files that are stored without compression or encryption can be
+   /// mapped and only if the zip file itself is opened from a FileStream.
+   /// The mapping is copy-on-write and stays valid until the zip file
+   /// is closed.
+   ///
+   /// @param fileCD Pointer to central directory of the file to map
+   /// @param outSize Receives the size of the file
+   /// @return Pointer to the file data or NULL if it can't be mapped
+   /// @see Torque::FS::File::map()
+   //-----------------------------------------------------------------------------
+   U8 *mapFileForRead(const CentralDir *fileCD, U32 &outSize);
+
+   //-----------------------------------------------------------------------------
+   /// @brief Read raw data from the zip file
+   ///
+   /// This is what the streams returned by openFileForRead() read through. It
+   /// does not touch the position of any open file and is safe to call from
+   /// several threads at once.
+   ///
+   /// @param offset Offset in the zip file to read from
+   /// @param size Number of bytes to read
+   /// @param buffer Buffer to read the data into
+   /// @return true if all bytes were read, false otherwise
+   //-----------------------------------------------------------------------------
+   bool readData(U32 offset, U32 size, void *buffer);
+
+   /// Return the mapped zip file or NULL if it's not mapped.
+   const U8 *getMappedData(U32 &outSize) const   { outSize = mMappedSize; return mMappedData; }
    // @}
 
    /// @name Archiver Style File Access Methods
@@ -0,0 +1,99 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "core/util/zip/zipEntryStream.h"
+
+#include "core/util/zip/zipArchive.h"
+
+namespace Zip
+{
+
+ZipEntryStream::ZipEntryStream(ZipArchive *archive, U32 start, U32 size)
+ : mArchive(archive),
+   mLastBytesRead(0)
+{
+   AssertFatal(archive != NULL, "ZipEntryStream - NULL archive");
+   setRange(start, size);
+}
+
+void ZipEntryStream::setRange(U32 start, U32 size)
+{
+   mStart = start;
+   mSize = size;
+   mPosition = 0;
+   setStatus(mSize ? Ok : EOS);
+}
+
+const U8 *ZipEntryStream::getMappedData() const
+{
+   U32 mappedSize;
+   const U8 *mapped = mArchive->getMappedData(mappedSize);
+   if(mapped == NULL || mStart + mSize > mappedSize)
+      return NULL;
+
+   return mapped + mStart;
+}
+
+bool ZipEntryStream::hasCapability(const Capability cap) const
+{
+   return cap == StreamRead || cap == StreamPosition;
+}
+
+bool ZipEntryStream::setPosition(const U32 newPosition)
+{
+   if(newPosition > mSize)
+      return false;
+
+   mPosition = newPosition;
+   setStatus(mPosition < mSize ? Ok : EOS);
+   return true;
+}
+
+bool ZipEntryStream::_read(const U32 numBytes, void *buffer)
+{
+   mLastBytesRead = 0;
+   if(numBytes == 0)
+      return true;
+
+   const U32 size = getMin(numBytes, mSize - mPosition);
+   if(size && ! mArchive->readData(mStart + mPosition, size, buffer))
+   {
+      setStatus(IOError);
+      return false;
+   }
+
+   mPosition += size;
+   mLastBytesRead = size;
+   setStatus(mPosition < mSize ? Ok : EOS);
+
+   return size == numBytes;
+}
+
+bool ZipEntryStream::_write(const U32, const void *)
+{
+   AssertFatal(false, "ZipEntryStream - Cannot write to a read only stream");
+   setStatus(IllegalCall);
+   return false;
+}
+
+} // end namespace Zip
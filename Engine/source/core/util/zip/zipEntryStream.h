@@ -0,0 +1,88 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _ZIPENTRYSTREAM_H_
+#define _ZIPENTRYSTREAM_H_
+
+#ifndef _STREAM_H_
+#include "core/stream/stream.h"
+#endif
+
+namespace Zip
+{
+
+/// @addtogroup zipint_group
+/// @ingroup zip_group
+// @{
+
+class ZipArchive;
+
+/// A read only stream over a range of a zip file.
+///
+/// Every file opened for reading from a ZipArchive gets its own ZipEntryStream
+/// with its own position, so files opened at the same time, possibly from
+/// different threads, don't move each other's read position in the zip file.
+/// Reads go through ZipArchive::readData(), which copies from the mapped zip
+/// file when it could be mapped and locks the shared stream otherwise.
+class ZipEntryStream : public Stream, public IStreamByteCount
+{
+   typedef Stream Parent;
+
+protected:
+   ZipArchive *mArchive;
+   U32 mStart;
+   U32 mSize;
+   U32 mPosition;
+   U32 mLastBytesRead;
+
+public:
+   ZipEntryStream(ZipArchive *archive, U32 start, U32 size);
+
+   /// Restrict the stream to @a size bytes at @a start in the zip file and
+   /// seek to the beginning.
+   void setRange(U32 start, U32 size);
+
+   /// Return the offset of the current position in the zip file.
+   U32 getArchivePosition() const         { return mStart + mPosition; }
+
+   /// Return the data of the stream in the mapped zip file or NULL if the zip
+   /// file is not mapped.
+   const U8 *getMappedData() const;
+
+   virtual U32 getLastBytesRead()         { return mLastBytesRead; }
+   virtual U32 getLastBytesWritten()      { return 0; }
+
+   virtual bool hasCapability(const Capability cap) const;
+   virtual U32 getPosition() const        { return mPosition; }
+   virtual bool setPosition(const U32 newPosition);
+   virtual U32 getStreamSize()            { return mSize; }
+
+protected:
+   virtual bool _read(const U32 numBytes, void *buffer);
+   virtual bool _write(const U32 numBytes, const void *buffer);
+};
+
+// @}
+
+} // end namespace Zip
+
+#endif // _ZIPENTRYSTREAM_H_
@@ -22,10 +22,11 @@
 
 #include "zlib.h"
 #include "core/util/zip/zipSubStream.h"
+#include "core/util/zip/zipEntryStream.h"
 
 
 const U32 ZipSubRStream::csm_streamCaps      = U32(Stream::StreamRead) | U32(Stream::StreamPosition);
-const U32 ZipSubRStream::csm_inputBufferSize = 4096;
+const U32 ZipSubRStream::csm_inputBufferSize = 32 * 1024;
 
 const U32 ZipSubWStream::csm_streamCaps      = U32(Stream::StreamWrite);
 const U32 ZipSubWStream::csm_bufferSize      = (2048 * 1024);
@@ -40,6 +41,7 @@ ZipSubRStream::ZipSubRStream()
    m_EOS(false),
    m_pZipStream(NULL),
    m_pInputBuffer(NULL),
+   m_inputMapped(false),
    m_originalSlavePosition(0),
    m_lastBytesRead(0)
 {
@@ -66,16 +68,34 @@ bool ZipSubRStream::attachStream(Stream* io_pSlaveStream)
 
    // Initialize zipStream state...
    m_pZipStream   = new z_stream_s;
-   m_pInputBuffer = new U8[csm_inputBufferSize];
 
    m_pZipStream->zalloc = Z_NULL;
    m_pZipStream->zfree  = Z_NULL;
    m_pZipStream->opaque = Z_NULL;
 
-   U32 buffSize = fillBuffer(csm_inputBufferSize);
+   // If the file is in a mapped zip, inflate straight from the mapping
+   // rather than copying the input through our buffer.
+   Zip::ZipEntryStream *entryStream = dynamic_cast<Zip::ZipEntryStream*>(io_pSlaveStream);
+   const U8 *mapped = entryStream ? entryStream->getMappedData() : NULL;
+   m_inputMapped = (mapped != NULL);
 
-   m_pZipStream->next_in  = m_pInputBuffer;
-   m_pZipStream->avail_in = buffSize;
+   if (m_inputMapped)
+   {
+      const U32 position = entryStream->getPosition();
+      const U32 size = entryStream->getStreamSize();
+      entryStream->setPosition(size);
+
+      m_pZipStream->next_in  = (Bytef*)(mapped + position);
+      m_pZipStream->avail_in = size - position;
+   }
+   else
+   {
+      m_pInputBuffer = new U8[csm_inputBufferSize];
+      U32 buffSize = fillBuffer(csm_inputBufferSize);
+
+      m_pZipStream->next_in  = m_pInputBuffer;
+      m_pZipStream->avail_in = buffSize;
+   }
    m_pZipStream->total_in = 0;
    inflateInit2(m_pZipStream, -MAX_WBITS);
 
@@ -98,6 +118,7 @@ void ZipSubRStream::detachStream()
    }
 
    m_pStream          = NULL;
+   m_inputMapped      = false;
    m_originalSlavePosition = 0;
    m_uncompressedSize = 0;
    m_currentPosition  = 0;
@@ -158,7 +179,8 @@ bool ZipSubRStream::_read(const U32 in_numBytes, void *out_pBuffer)
          // check if there is more output pending
          inflate(m_pZipStream, Z_SYNC_FLUSH);
 
-         if(m_pZipStream->total_out != in_numBytes)
+         // Mapped input is all there from the start.
+         if(m_pZipStream->total_out != in_numBytes && !m_inputMapped)
          {
             // Need to provide more input bytes for the stream to read...
             U32 buffSize = fillBuffer(csm_inputBufferSize);
@@ -42,6 +42,7 @@ class ZipSubRStream : public FilterStream, public IStreamByteCount
    bool     m_EOS;
    z_stream_s*  m_pZipStream;
    U8*          m_pInputBuffer;
+   bool         m_inputMapped;    // Inflating straight from a mapped zip, see ZipEntryStream
    U32          m_originalSlavePosition;
    U32 m_lastBytesRead;
 
@@ -146,6 +146,16 @@ public:
          return 0;
    }
 
+   virtual U8* map(U32 &outSize)
+   {
+      // The archive owns the mapping, so there is nothing to unmap.
+      outSize = 0;
+      if (!mZipStream || mArchive == NULL)
+         return NULL;
+
+      return mArchive->mapFileForRead(&mZipEntry->mCD, outSize);
+   }
+
    protected:
       virtual U32    calculateChecksum()
       {
@@ -447,26 +457,29 @@ FileNodeRef ZipFileSystem::resolve(const Path& path)
 
 void ZipFileSystem::_init()
 {
-   if (mInitted)
-      return;
-   mInitted = true;
+   // Files may be resolved from several threads at once.
+   MutexHandle lock;
+   lock.lock(&mInitMutex, true);
 
-   if (!mZipArchive.isNull())
-      return;
-   if (mZipArchiveStream->getStatus() != Stream::Ok)
+   if (mInitted)
       return;
 
-   mZipArchive = new ZipArchive();
-   if (!mZipArchive->openArchive(mZipArchiveStream, ZipArchive::Read))
+   if (mZipArchive.isNull() && mZipArchiveStream->getStatus() == Stream::Ok)
    {
-      Con::errorf("ZipFileSystem: failed to open zip archive %s", mZipFilename.c_str());
-      return;
+      StrongRefPtr<ZipArchive> archive = new ZipArchive();
+      if (archive->openArchive(mZipArchiveStream, ZipArchive::Read))
+      {
+         // tell the archive that it owns the zipStream now
+         archive->setDiskStream(mZipArchiveStream);
+         // and null it out because we don't own it anymore
+         mZipArchiveStream = NULL;
+         mZipArchive = archive;
+      }
+      else
+         Con::errorf("ZipFileSystem: failed to open zip archive %s", mZipFilename.c_str());
    }
 
-   // tell the archive that it owns the zipStream now
-   mZipArchive->setDiskStream(mZipArchiveStream);
-   // and null it out because we don't own it anymore
-   mZipArchiveStream = NULL;
+   mInitted = true;
 
    // for debugging
    //mZipArchive->dumpCentralDirectory();
@@ -58,6 +58,8 @@ public:
 private:
    void _init();
 
+   /// Guards _init(), the archive is read only afterwards.
+   Mutex mInitMutex;
    bool mInitted;
    bool mZipNameIsDir;
    String mZipFilename;
@@ -27,7 +27,9 @@
 #include "core/strings/findMatch.h"
 #include "core/util/journal/process.h"
 #include "core/util/safeDelete.h"
+#include "core/module.h"
 #include "console/console.h"
+#include "console/consoleTypes.h"
 
 
 namespace Torque
@@ -199,6 +201,8 @@ String FileSystemChangeNotifier::cleanPath(const Path& dir)
 
 void FileSystemChangeNotifier::internalNotifyDirChanged( const Path &dir )
 {
+   InvalidateDirectory( dir );
+
    DirMap::Iterator itr = mDirMap.find( dir );
    if ( itr == mDirMap.end() )
       return;
@@ -451,6 +455,188 @@ Path FileSystemRedirect::mapFrom(const Path& path)
 
 //-----------------------------------------------------------------------------
 
+U32 MountSystem::smAttributeCacheTime = 2000;
+
+AFTER_MODULE_INIT( Sim )
+{
+   Con::addVariable( "$FS::attributeCacheTime", TypeS32, &MountSystem::smAttributeCacheTime,
+      "@brief Number of milliseconds file attributes, missing files and directory listings stay cached.\n\n"
+      "Directories changed through the volume system or reported by the file change notifications "
+      "are dropped from the cache right away.  Other changes show up once the entries expire.  "
+      "Zero disables the cache.  The default value is 2000.\n"
+      "@ingroup FileSystem" );
+}
+
+void MountSystem::_getCacheKey(const Path& path, String &outDir, String &outName)
+{
+   String key = path.getFullPath();
+   if (key.length() > 1 && key[key.length() - 1] == '/')
+      key = key.substr(0, key.length() - 1);
+
+   String::SizeType slash = key.find('/', 0, String::Right);
+   if (slash == String::NPos)
+   {
+      outDir = String::EmptyString;
+      outName = key;
+   }
+   else
+   {
+      outDir = key.substr(0, slash);
+      outName = key.substr(slash + 1);
+   }
+}
+
+bool MountSystem::_getCachedNode(const Path& path, CachedNode &outNode)
+{
+   if (!smAttributeCacheTime)
+      return false;
+
+   String dir, name;
+   _getCacheKey(path, dir, name);
+
+   MutexHandle mutex;
+   mutex.lock(&mAttributeCacheMutex, true);
+
+   AttributeCache::Iterator itr = mAttributeCache.find(dir);
+   if (itr == mAttributeCache.end())
+      return false;
+
+   HashTable<String, CachedNode>::Iterator node = itr->value->nodes.find(name);
+   if (node == itr->value->nodes.end())
+      return false;
+
+   if (Platform::getRealMilliseconds() - node->value.time >= smAttributeCacheTime)
+   {
+      itr->value->nodes.erase(node);
+      return false;
+   }
+
+   outNode = node->value;
+   return true;
+}
+
+void MountSystem::_cacheNode(const Path& path, bool exists, const FileNode::Attributes &attr)
+{
+   if (!smAttributeCacheTime)
+      return;
+
+   String dir, name;
+   _getCacheKey(path, dir, name);
+
+   MutexHandle mutex;
+   mutex.lock(&mAttributeCacheMutex, true);
+
+   AttributeCache::Iterator itr = mAttributeCache.findOrInsert(dir);
+   if (!itr->value)
+      itr->value = new CachedDirectory;
+
+   CachedNode &node = itr->value->nodes.findOrInsert(name)->value;
+   node.time = Platform::getRealMilliseconds();
+   node.exists = exists;
+   node.attr = attr;
+}
+
+bool MountSystem::_getCachedListing(const Path& dir, FileSystem *fs, Vector<FileNode::Attributes> &outEntries)
+{
+   if (!smAttributeCacheTime)
+      return false;
+
+   String parent, name;
+   _getCacheKey(dir, parent, name);
+   String key = Path::Join(parent, '/', name);
+
+   MutexHandle mutex;
+   mutex.lock(&mAttributeCacheMutex, true);
+
+   AttributeCache::Iterator itr = mAttributeCache.find(key);
+   if (itr == mAttributeCache.end())
+      return false;
+
+   Vector<CachedListing> &listings = itr->value->listings;
+   for (U32 i = 0; i < listings.size(); i++)
+   {
+      if (listings[i].fs != fs)
+         continue;
+
+      if (Platform::getRealMilliseconds() - listings[i].time >= smAttributeCacheTime)
+      {
+         listings.erase_fast(i);
+         return false;
+      }
+
+      outEntries = listings[i].entries;
+      return true;
+   }
+
+   return false;
+}
+
+void MountSystem::_cacheListing(const Path& dir, FileSystem *fs, const Vector<FileNode::Attributes> &entries)
+{
+   if (!smAttributeCacheTime)
+      return;
+
+   String parent, name;
+   _getCacheKey(dir, parent, name);
+   String key = Path::Join(parent, '/', name);
+
+   MutexHandle mutex;
+   mutex.lock(&mAttributeCacheMutex, true);
+
+   AttributeCache::Iterator itr = mAttributeCache.findOrInsert(key);
+   if (!itr->value)
+      itr->value = new CachedDirectory;
+
+   Vector<CachedListing> &listings = itr->value->listings;
+   U32 i = 0;
+   while (i < listings.size() && listings[i].fs != fs)
+      i++;
+   if (i == listings.size())
+      listings.increment();
+
+   listings[i].time = Platform::getRealMilliseconds();
+   listings[i].fs = fs;
+   listings[i].entries = entries;
+}
+
+void MountSystem::_eraseCachedDirectory(const String &key)
+{
+   AttributeCache::Iterator itr = mAttributeCache.find(key);
+   if (itr == mAttributeCache.end())
+      return;
+
+   delete itr->value;
+   mAttributeCache.erase(itr);
+}
+
+void MountSystem::_invalidatePath(const Path& path)
+{
+   String parent, name;
+   _getCacheKey(path, parent, name);
+
+   MutexHandle mutex;
+   mutex.lock(&mAttributeCacheMutex, true);
+
+   // The directory the path is in, and its contents if it is a directory.
+   _eraseCachedDirectory(parent);
+   _eraseCachedDirectory(Path::Join(parent, '/', name));
+}
+
+void MountSystem::invalidateDirectory(const Path& dir)
+{
+   _invalidatePath(_normalize(dir));
+}
+
+void MountSystem::clearAttributeCache()
+{
+   MutexHandle mutex;
+   mutex.lock(&mAttributeCacheMutex, true);
+
+   for (AttributeCache::Iterator itr = mAttributeCache.begin(); itr != mAttributeCache.end(); ++itr)
+      delete itr->value;
+   mAttributeCache.clear();
+}
+
 void MountSystem::_log(const String& msg)
 {
    String newMsg = "MountSystem: " + msg;
@@ -511,6 +697,8 @@ FileRef MountSystem::createFile(const Path& path)
       return NULL;
    }
 
+   _invalidatePath(np);
+
    if (fs != NULL)
       return static_cast<File*>(fs->create(np,FileNode::File).getPointer());
    return NULL;
@@ -528,6 +716,8 @@ DirectoryRef MountSystem::createDirectory(const Path& path, FileSystemRef fs)
       return NULL;
    }
 
+   _invalidatePath(np);
+
    if (fs != NULL)
       return static_cast<Directory*>(fs->create(np,FileNode::Directory).getPointer());
    return NULL;
@@ -535,6 +725,10 @@ DirectoryRef MountSystem::createDirectory(const Path& path, FileSystemRef fs)
 
 FileRef MountSystem::openFile(const Path& path,File::AccessMode mode)
 {
+   // Writing changes the size and modified time.
+   if (mode != File::Read)
+      _invalidatePath(_normalize(path));
+
    FileNodeRef node = getFileNode(path);
    if (node != NULL)
    {
@@ -588,6 +782,7 @@ bool MountSystem::remove(const Path& path)
       _log(String::ToString("Cannot remove path %s, filesystem is read-only", path.getFullPath().c_str()));
       return false;
    }
+   _invalidatePath(np);
    if (fs != NULL)
       return fs->remove(np);
    return false;
@@ -613,6 +808,9 @@ bool MountSystem::rename(const Path& from,const Path& to)
       return false;
    }
 
+   _invalidatePath(pa);
+   _invalidatePath(pb);
+
    return fsa->rename(pa,pb);
 }
 
@@ -623,6 +821,7 @@ bool MountSystem::mount(String root,FileSystemRef fs)
    mount.path = "/";
    mount.fileSystem = fs;
    mMountList.push_back(mount);
+   clearAttributeCache();
    return true;
 }
 
@@ -639,6 +838,7 @@ FileSystemRef MountSystem::unmount(String root)
    while (!_removeMountFromList(root).isNull())
       ;
    
+   clearAttributeCache();
    return first;
 }
 
@@ -659,6 +859,8 @@ bool MountSystem::unmount(FileSystemRef fs)
          unmounted = true;
       }
    }
+   if (unmounted)
+      clearAttributeCache();
    return unmounted;
 }
 
@@ -683,24 +885,48 @@ FileSystemRef MountSystem::getFileSystem(const Path& path)
 
 bool MountSystem::getFileAttributes(const Path& path,FileNode::Attributes* attr)
 {
-   FileNodeRef file = getFileNode(path);
+   Path np = _normalize(path);
+
+   CachedNode cached;
+   if (_getCachedNode(np, cached))
+   {
+      if (cached.exists)
+         *attr = cached.attr;
+      return cached.exists;
+   }
+
+   FileNodeRef file = getFileNode(np);
 
    if (file != NULL)
    {
       bool result = file->getAttributes(attr);
+      if (result)
+         _cacheNode(np, true, *attr);
       return result;
    }
 
+   _cacheNode(np, false, FileNode::Attributes());
    return false;
 }
 
 FileNodeRef MountSystem::getFileNode(const Path& path)
 {
    Path np = _normalize(path);
+
+   // Only missing files are answered from the cache, callers
+   // need the node itself otherwise.
+   CachedNode cached;
+   if (_getCachedNode(np, cached) && !cached.exists)
+      return NULL;
+
    FileSystemRef fs = _getFileSystemFromList(np);
+   FileNodeRef node;
    if (fs != NULL)
-      return fs->resolve(np);
-   return NULL;
+      node = fs->resolve(np);
+
+   if (node == NULL)
+      _cacheNode(np, false, FileNode::Attributes());
+   return node;
 }
 
 bool  MountSystem::mapFSPath( const String &inRoot, const Path &inPath, Path &outPath )
@@ -723,20 +949,38 @@ S32 MountSystem::findByPattern( const Path &inBasePath, const String &inFilePatt
    if (mFindByPatternOverrideFS.isNull() && !inBasePath.isDirectory() )
       return -1;
 
-   DirectoryRef   dir = NULL;
-   if (mFindByPatternOverrideFS.isNull())
-      // open directory using standard mount system search
-      dir = openDirectory( inBasePath );
-   else
+   // Relative paths depend on the cwd, only cache absolute ones.
+   FileSystem *listingFS = mFindByPatternOverrideFS.getPointer();
+   bool cacheListing = inBasePath.isAbsolute();
+   Path listingPath = _normalize(inBasePath);
+
+   Vector<FileNode::Attributes> entries;
+   if (!cacheListing || !_getCachedListing(listingPath, listingFS, entries))
    {
-      // use specified filesystem to open directory
-      FileNodeRef fNode = mFindByPatternOverrideFS->resolve(inBasePath);
-      if (fNode && (dir = dynamic_cast<Directory*>(fNode.getPointer())) != NULL)
-         dir->open();
-   }
+      DirectoryRef   dir = NULL;
+      if (mFindByPatternOverrideFS.isNull())
+         // open directory using standard mount system search
+         dir = openDirectory( inBasePath );
+      else
+      {
+         // use specified filesystem to open directory
+         FileNodeRef fNode = mFindByPatternOverrideFS->resolve(inBasePath);
+         if (fNode && (dir = dynamic_cast<Directory*>(fNode.getPointer())) != NULL)
+            dir->open();
+      }
 
-   if ( dir == NULL )
-      return -1;
+      if ( dir == NULL )
+         return -1;
+
+      FileNode::Attributes  attrs;
+      while ( dir->read( &attrs ) )
+         entries.push_back( attrs );
+
+      dir->close();
+
+      if (cacheListing)
+         _cacheListing(listingPath, listingFS, entries);
+   }
 
    if (includeDirs)
    {
@@ -744,12 +988,12 @@ S32 MountSystem::findByPattern( const Path &inBasePath, const String &inFilePatt
       outList.push_back(String("DIR:") + inBasePath.getPath());
    }
 
-   FileNode::Attributes  attrs;
-
    Vector<String>    recurseDirs;
 
-   while ( dir->read( &attrs ) )
+   for ( U32 i = 0; i < entries.size(); i++ )
    {
+      const FileNode::Attributes &attrs = entries[i];
+
       // skip hidden files
       if ( attrs.name.c_str()[0] == '.' )
          continue;
@@ -776,8 +1020,6 @@ S32 MountSystem::findByPattern( const Path &inBasePath, const String &inFilePatt
       }
    }
 
-   dir->close();
-
    for ( S32 i = 0; i < recurseDirs.size(); i++ )
       findByPattern( recurseDirs[i], inFilePattern, true, outList, includeDirs, multiMatch );
 
@@ -1070,6 +1312,16 @@ S32 FindByPattern( const Path &inBasePath, const String &inFilePattern, bool inR
    return sgMountSystem.findByPattern(inBasePath, inFilePattern, inRecursive, outList, false, multiMatch);
 }
 
+void InvalidateDirectory(const Path &dir)
+{
+   sgMountSystem.invalidateDirectory(dir);
+}
+
+void ClearAttributeCache()
+{
+   sgMountSystem.clearAttributeCache();
+}
+
 bool IsFile(const Path &path)
 {
    return sgMountSystem.isFile(path);
@@ -51,6 +51,10 @@
 #include "core/util/timeClass.h"
 #endif
 
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
 namespace Torque
 {
 namespace FS
@@ -180,6 +184,17 @@ public:
 
    virtual U32 read(void* dst, U32 size) = 0;
    virtual U32 write(const void* src, U32 size) = 0;
+
+   /// Map the contents of the file, which must be open for reading, into
+   /// memory.  The pages are copy-on-write, so changes to the memory never
+   /// reach the file.  The mapping stays valid until unmap() or close().
+   /// @param outSize Receives the number of bytes mapped.
+   /// @return The contents or NULL if the file can't be mapped, in which
+   ///   case it has to be read.
+   virtual U8* map(U32 &outSize) { outSize = 0; return NULL; }
+
+   /// Release the mapping made by map().
+   virtual void unmap() {}
 };
 
 typedef WeakRefPtr<File> FilePtr;
@@ -331,7 +346,7 @@ typedef StrongRefPtr<FileSystem>  FileSystemRef;
 class MountSystem
 {
 public:
-   virtual ~MountSystem() {}
+   virtual ~MountSystem() { clearAttributeCache(); }
 
    FileRef createFile(const Path& path);
    DirectoryRef createDirectory(const Path& path, FileSystemRef fs = NULL);
@@ -373,6 +388,25 @@ public:
    void  startFileChangeNotifications();
    void  stopFileChangeNotifications();
 
+   /// @name Attribute Cache
+   /// File attributes, missing files and directory listings are cached so
+   /// that looking up the same paths again doesn't go to the file systems.
+   /// A directory's entries are dropped when it is changed through the mount
+   /// system or reported by a change notifier.  Changes made behind the mount
+   /// system's back are picked up once the entries expire.
+   /// @{
+
+   /// Drops everything cached for the given directory.
+   void invalidateDirectory(const Path& dir);
+
+   /// Drops everything cached.
+   void clearAttributeCache();
+
+   /// Number of milliseconds cached entries stay valid.  Zero disables the cache.
+   static U32 smAttributeCacheTime;
+
+   /// @}
+
 protected:
    virtual void _log(const String& msg);
 
@@ -390,9 +424,48 @@ protected:
 
    Path _normalize(const Path& path);
 
+   struct CachedNode
+   {
+      U32 time;                     ///< When the attributes were read
+      bool exists;                  ///< False if the path didn't exist
+      FileNode::Attributes attr;
+   };
+
+   struct CachedListing
+   {
+      U32 time;                     ///< When the directory was read
+      FileSystem *fs;               ///< File system the directory was read from
+      Vector<FileNode::Attributes> entries;
+   };
+
+   struct CachedDirectory
+   {
+      HashTable<String, CachedNode> nodes;   ///< Keyed by name within the directory
+      Vector<CachedListing> listings;
+   };
+
+   typedef HashTable<String, CachedDirectory*> AttributeCache;
+
+   /// Splits a normalized path into the key of the directory it is in and
+   /// its name within that directory.
+   static void _getCacheKey(const Path& path, String &outDir, String &outName);
+
+   bool _getCachedNode(const Path& path, CachedNode &outNode);
+   void _cacheNode(const Path& path, bool exists, const FileNode::Attributes &attr);
+   bool _getCachedListing(const Path& dir, FileSystem *fs, Vector<FileNode::Attributes> &outEntries);
+   void _cacheListing(const Path& dir, FileSystem *fs, const Vector<FileNode::Attributes> &entries);
+
+   /// Drops the cached entries of a normalized path, and those of the
+   /// directory it names if it is one.
+   void _invalidatePath(const Path& path);
+   void _eraseCachedDirectory(const String &key);
+
    Vector<MountFS>   mMountList;
    Path        mCWD;
    FileSystemRef mFindByPatternOverrideFS;
+
+   AttributeCache mAttributeCache;
+   Mutex mAttributeCacheMutex;
 };
 
 ///@name File System Access
@@ -546,6 +619,15 @@ DirectoryRef CreateDirectory(const Path &file);
 ///@ingroup VolumeSystem
 bool CreatePath(const Path &path);
 
+/// Drop the cached attributes and listings of a directory.
+///@ingroup VolumeSystem
+void InvalidateDirectory(const Path &dir);
+
+/// Drop all cached attributes and listings.  Call this after changing
+/// files without going through the volume system.
+///@ingroup VolumeSystem
+void ClearAttributeCache();
+
 bool IsReadOnly(const Path &path);
 bool IsDirectory(const Path &path);
 bool IsFile(const Path &path);
@@ -69,6 +69,8 @@ BasicClouds::BasicClouds()
    mTexDirectionSC = 0;
    mTexOffsetSC = 0;
 
+   mGenerateVB = true;
+
    mLayerEnabled[0] = true;
    mLayerEnabled[1] = true;
    mLayerEnabled[2] = true;
@@ -116,8 +118,8 @@ bool BasicClouds::onAdd()
 
    if ( isClientObject() )
    {
-      _initTexture();
-      _initBuffers();
+      // The textures and buffers are created on the first render.
+      mGenerateVB = true;
 
       // Find ShaderData
       ShaderData *shaderData;
@@ -250,8 +252,7 @@ void BasicClouds::unpackUpdate( NetConnection *conn, BitStream *stream )
    if ( isProperlyAdded() )
    {
       // We could check if the height or texture have actually changed.
-      _initBuffers();
-      _initTexture();
+      mGenerateVB = true;
    }
 }
 
@@ -276,6 +277,13 @@ void BasicClouds::prepRenderImage( SceneRenderState *state )
    if ( !isEnabled )
       return;
 
+   if ( mGenerateVB )
+   {
+      _initBuffers();
+      _initTexture();
+      mGenerateVB = false;
+   }
+
    // This should be sufficient for most objects that don't manage zones, and
    // don't need to return a specialized RenderImage...
    ObjectRenderInst *ri = state->getRenderPass()->allocInst< ObjectRenderInst >();
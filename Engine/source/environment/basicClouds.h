@@ -108,6 +108,10 @@ protected:
    GFXVertexBufferHandle<GFXVertexPT> mVB[TEX_COUNT];
    GFXPrimitiveBufferHandle mPB;    
 
+   /// Set when the textures and buffers have to be (re)created, which
+   /// is deferred until the clouds are first rendered.
+   bool mGenerateVB;
+
    // Fields...
 
    bool mLayerEnabled[TEX_COUNT];
@@ -73,7 +73,9 @@ U32 CloudLayer::smVertCount = smVertStride * smVertStride;
 U32 CloudLayer::smTriangleCount = smStrideMinusOne * smStrideMinusOne * 2;
 
 CloudLayer::CloudLayer()
-: mLastTime( 0 ),
+: mInitTexture( true ),
+  mGenerateVB( true ),
+  mLastTime( 0 ),
   mBaseColor( 0.9f, 0.9f, 0.9f, 1.0f ),
   mExposure( 1.0f ),
   mCoverage( 0.5f ),
@@ -128,8 +130,9 @@ bool CloudLayer::onAdd()
 
    if ( isClientObject() )
    {
-      _initTexture();
-      _initBuffers();
+      // The texture and buffers are created on the first render.
+      mInitTexture = true;
+      mGenerateVB = true;
 
       // Find ShaderData
       ShaderData *shaderData;
@@ -284,9 +287,9 @@ void CloudLayer::unpackUpdate( NetConnection *conn, BitStream *stream )
    if ( isProperlyAdded() )
    {
       if ( ( oldTextureName != mTextureName ) || ( ( oldCoverage == 0.0f ) != ( mCoverage == 0.0f ) ) )
-         _initTexture();
+         mInitTexture = true;
       if ( oldHeight != mHeight )
-         _initBuffers();
+         mGenerateVB = true;
    }
 }
 
@@ -301,6 +304,18 @@ void CloudLayer::prepRenderImage( SceneRenderState *state )
    if ( mCoverage <= 0.0f )
       return;
 
+   if ( mInitTexture )
+   {
+      _initTexture();
+      mInitTexture = false;
+   }
+
+   if ( mGenerateVB )
+   {
+      _initBuffers();
+      mGenerateVB = false;
+   }
+
    if ( state->isDiffusePass() )
    {
       // Scroll textures...
@@ -115,6 +115,11 @@ protected:
    GFXVertexBufferHandle<GFXCloudVertex> mVB;
    GFXPrimitiveBufferHandle mPB;
 
+   /// Set when the texture or the buffers have to be (re)created, which
+   /// is deferred until the layer is first rendered.
+   bool mInitTexture;
+   bool mGenerateVB;
+
    Point2F mTexOffset[3];
    U32 mLastTime;
 
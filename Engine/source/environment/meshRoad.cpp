@@ -820,7 +820,7 @@ SimSet* MeshRoad::getServerSet()
 
 void MeshRoad::prepRenderImage( SceneRenderState* state )
 {
-   if ( mNodes.size() <= 1 )
+   if ( mNodes.size() <= 1 || mSegments.empty() )
       return;
 
    RenderPassManager *renderPass = state->getRenderPass();
@@ -839,9 +839,31 @@ void MeshRoad::prepRenderImage( SceneRenderState* state )
       coreRI.worldToCamera = renderPass->allocSharedXform(RenderPassManager::View);
       coreRI.projection = renderPass->allocSharedXform(RenderPassManager::Projection);
       coreRI.type = RenderPassManager::RIT_Mesh;      
+
+      // Cull the segments individually and draw each run of visible
+      // segments with one primitive per surface.  When the whole road
+      // is in view this is a single run covering all of it.
+      const Frustum &frustum = state->getCullingFrustum();
+      const S32 lastSegment = mSegments.size() - 1;
+      mVisibleRuns.clear();
+      for ( S32 i = 0; i <= lastSegment; i++ )
+      {
+         if ( frustum.isCulled( mSegments[i].getWorldBounds() ) )
+            continue;
+
+         if ( !mVisibleRuns.empty() && mVisibleRuns.last().y == i - 1 )
+            mVisibleRuns.last().y = i;
+         else
+            mVisibleRuns.push_back( Point2I( i, i ) );
+      }
+
+      // Vertices per slice of the top surface, taken from the buffer
+      // so it matches even if the subdivisions changed since.
+      const U32 topRowStride = mVertCount[Top] / mSlices.size();
+      const U32 topTrisPerSegment = ( topRowStride - 1 ) * 2;
 		
       BaseMatInstance *matInst;
-      for ( U32 i = 0; i < SurfaceCount; i++ )
+      for ( U32 i = 0; i < SurfaceCount && !mVisibleRuns.empty(); i++ )
       {             
          matInst = state->getOverrideMaterial( mMatInst[i] );   
          if ( !matInst )
@@ -855,30 +877,87 @@ void MeshRoad::prepRenderImage( SceneRenderState* state )
 	         query.getLights( coreRI.lights, 8 );
          }
 
-         MeshRenderInst *ri = renderPass->allocInst<MeshRenderInst>();
-         *ri = coreRI;
+         // Vertices per slice and triangles per segment of this surface.
+         U32 rowStride, trisPerSegment;
+         if ( i == Top )
+         {
+            rowStride = topRowStride;
+            trisPerSegment = topTrisPerSegment;
+         }
+         else if ( i == Bottom )
+         {
+            rowStride = 2;
+            trisPerSegment = 2;
+         }
+         else
+         {
+            rowStride = 4;
+            trisPerSegment = 4;
+         }
+
+         bool drewCaps = false;
+
+         for ( U32 j = 0; j < mVisibleRuns.size(); j++ )
+         {
+            const Point2I &run = mVisibleRuns[j];
+            const U32 segmentCount = run.y - run.x + 1;
+
+            MeshRenderInst *ri = renderPass->allocInst<MeshRenderInst>();
+            *ri = coreRI;
+
+            // Set the correct material for rendering.
+            ri->matInst = matInst;
+            ri->vertBuff = &mVB[i];
+            ri->primBuff = &mPB[i];
+
+            ri->prim = renderPass->allocPrim();
+            ri->prim->type = GFXTriangleList;
+            ri->prim->minIndex = run.x * rowStride;
+            ri->prim->startIndex = run.x * trisPerSegment * 3;
+            ri->prim->numPrimitives = segmentCount * trisPerSegment;
+            ri->prim->startVertex = 0;
+            ri->prim->numVertices = ( segmentCount + 1 ) * rowStride;
+
+            // The end caps of the sides follow the last segment in the
+            // index buffer, but they use the vertices of both ends.
+            if ( i == Side && run.y == lastSegment )
+            {
+               ri->prim->numPrimitives += 4;
+               ri->prim->minIndex = 0;
+               ri->prim->numVertices = mVertCount[i];
+               drewCaps = true;
+            }
+
+            // We sort by the material then vertex buffer.
+            ri->defaultKey = matInst->getStateHint();
+            ri->defaultKey2 = (uintptr_t)ri->vertBuff; // Not 64bit safe!
+
+            renderPass->addInst( ri );  
+         }
 
-         // Currently rendering whole road, fix to cull and batch
-         // per segment.
+         // The front cap is visible but the back end isn't.
+         if ( i == Side && !drewCaps && !mVisibleRuns.empty() && mVisibleRuns.first().x == 0 )
+         {
+            MeshRenderInst *ri = renderPass->allocInst<MeshRenderInst>();
+            *ri = coreRI;
 
-         // Set the correct material for rendering.
-         ri->matInst = matInst;
-         ri->vertBuff = &mVB[i];
-         ri->primBuff = &mPB[i];
+            ri->matInst = matInst;
+            ri->vertBuff = &mVB[i];
+            ri->primBuff = &mPB[i];
 
-         ri->prim = renderPass->allocPrim();
-         ri->prim->type = GFXTriangleList;
-         ri->prim->minIndex = 0;
-         ri->prim->startIndex = 0;
-         ri->prim->numPrimitives = mTriangleCount[i];
-         ri->prim->startVertex = 0;
-         ri->prim->numVertices = mVertCount[i];
+            ri->prim = renderPass->allocPrim();
+            ri->prim->type = GFXTriangleList;
+            ri->prim->minIndex = 0;
+            ri->prim->startIndex = mSegments.size() * trisPerSegment * 3;
+            ri->prim->numPrimitives = 4;
+            ri->prim->startVertex = 0;
+            ri->prim->numVertices = mVertCount[i];
 
-         // We sort by the material then vertex buffer.
-         ri->defaultKey = matInst->getStateHint();
-         ri->defaultKey2 = (uintptr_t)ri->vertBuff; // Not 64bit safe!
+            ri->defaultKey = matInst->getStateHint();
+            ri->defaultKey2 = (uintptr_t)ri->vertBuff; // Not 64bit safe!
 
-         renderPass->addInst( ri );  
+            renderPass->addInst( ri );  
+         }
       }
    }
 
@@ -536,6 +536,10 @@ protected:
    MeshRoadNodeVector mNodes;
    MeshRoadSegmentVector mSegments;
    MeshRoadBatchVector mBatches;
+
+   /// Runs of segments inside the view, as first and last segment
+   /// index, found in prepRenderImage().
+   Vector<Point2I> mVisibleRuns;
    
    static GFXStateBlockRef smWireframeSB;
 
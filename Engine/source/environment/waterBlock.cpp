@@ -390,7 +390,7 @@ SceneData WaterBlock::setupSceneGraphInfo( SceneRenderState *state )
 
    // misc
    sgData.backBuffTex = REFLECTMGR->getRefractTex();
-   sgData.reflectTex = mPlaneReflector.reflectTex;
+   sgData.reflectTex = _getReflectTex();
    sgData.wireframe = GFXDevice::getWireframe() || smWireframe;
 
    return sgData;
@@ -429,13 +429,8 @@ void WaterBlock::setShaderParams( SceneRenderState *state, BaseMatInstance *mat,
       
    // By default we need to show a true reflection is fullReflect is enabled and
    // we are above water.
-   F32 reflect = mPlaneReflector.isEnabled() && !isUnderwater( state->getCameraPosition() );
-   
-   // If we were occluded the last frame a query was fetched ( not necessarily last frame )
-   // and we weren't updated last frame... we don't have a valid texture to show
-   // so use the cubemap / fake reflection color this frame.
-   if ( mPlaneReflector.lastUpdateMs != REFLECTMGR->getLastUpdateMs() && mPlaneReflector.isOccluded() )
-      reflect = false;
+   // Otherwise fall back to the cubemap / fake reflection color.
+   F32 reflect = _hasValidReflectTex( state );
 
    Point4F reflectParams( mWaterPos.z, 0.0f, 1000.0f, !reflect );   
    matParams->setSafe( paramHandles.mReflectParamsSC, reflectParams );
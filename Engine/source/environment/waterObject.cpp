@@ -40,6 +40,7 @@
 #include "gfx/gfxOcclusionQuery.h"
 #include "gfx/gfxTextureManager.h"
 #include "gfx/sim/cubemapData.h"
+#include "materials/matTextureTarget.h"
 #include "math/util/matrixSet.h"
 #include "sfx/sfxAmbience.h"
 #include "T3D/sfx/sfx3DWorld.h"
@@ -138,6 +139,7 @@ void WaterMatParams::init( BaseMatInstance* matInst )
 
 bool WaterObject::smWireframe = false;
 bool WaterObject::smDisableTrueReflections = false;
+bool WaterObject::smScreenSpaceReflections = false;
 
 //-------------------------------------------------------------------------
 // WaterObject Class
@@ -253,6 +255,7 @@ WaterObject::WaterObject()
    mWaterPlane.set( mWaterPos, Point3F(0,0,1) );
 
    mGenerateVB = true;
+   mInitTextures = true;
 
    mMatrixSet = reinterpret_cast<MatrixSet *>(dMalloc_aligned(sizeof(MatrixSet), 16));
    constructInPlace(mMatrixSet);
@@ -399,6 +402,12 @@ void WaterObject::consoleInit()
    Con::addVariable( "$pref::Water::disableTrueReflections", TypeBool, &WaterObject::smDisableTrueReflections, 
       "Force all water objects to use static cubemap reflections.\n"
 	  "@ingroup Water");     
+
+   Con::addVariable( "$pref::Water::screenSpaceReflections", TypeBool, &WaterObject::smScreenSpaceReflections, 
+      "Makes water objects with fullReflect use the \"ssrReflection\" screen space "
+      "reflection target instead of rendering the scene a second time.  Falls back "
+      "to the cubemap when the target is not available.\n"
+      "@ingroup Water");     
 }
 
 void WaterObject::inspectPostApply()
@@ -428,7 +437,7 @@ bool WaterObject::_setFullReflect( void *object, const char *index, const char *
    {
       bool isEnabled = water->mPlaneReflector.isEnabled();
 
-      bool enable = water->mFullReflect && !smDisableTrueReflections;
+      bool enable = water->_usePlanarReflection();
 
       if ( enable && !isEnabled )
          water->mPlaneReflector.registerReflector( water, &water->mReflectorDesc );
@@ -571,7 +580,7 @@ void WaterObject::unpackUpdate( NetConnection * conn, BitStream *stream )
          mReflectorDesc.useOcclusionQuery = stream->readFlag();
          mReflectorDesc.texSize = stream->readInt( 32 );
 
-         if ( isProperlyAdded() && !mPlaneReflector.isEnabled() && !smDisableTrueReflections )
+         if ( isProperlyAdded() && !mPlaneReflector.isEnabled() && _usePlanarReflection() )
             mPlaneReflector.registerReflector( this, &mReflectorDesc );
       }
       else
@@ -662,8 +671,7 @@ void WaterObject::unpackUpdate( NetConnection * conn, BitStream *stream )
       stream->read( &mFoamTexName );
       stream->read( &mCubemapName );
 
-      if ( isProperlyAdded() )
-         initTextures();
+      mInitTextures = true;
    }
    
    // Sound environment.
@@ -690,6 +698,12 @@ void WaterObject::prepRenderImage( SceneRenderState *state )
    if( !state->isDiffusePass() )
       return;
 
+   if ( mInitTextures )
+   {
+      initTextures();
+      mInitTextures = false;
+   }
+
    // Setup scene transforms
    mMatrixSet->setSceneView(GFX->getWorldMatrix());
    mMatrixSet->setSceneProjection(GFX->getProjectionMatrix());
@@ -858,6 +872,7 @@ bool WaterObject::onAdd()
 
    Con::NotifyDelegate clbk( this, &WaterObject::_onDisableTrueRelfections );   
    Con::addVariableNotify( "$pref::Water::disableTrueReflections", clbk );
+   Con::addVariableNotify( "$pref::Water::screenSpaceReflections", clbk );
 
    if ( isClientObject() )
    {
@@ -872,9 +887,10 @@ bool WaterObject::onAdd()
       desc.cullMode = GFXCullNone;
       mUnderwaterSB = GFX->createStateBlock( desc );
 
-      initTextures();
+      // The textures are loaded on the first render.
+      mInitTextures = true;
       
-      if ( mFullReflect && !smDisableTrueReflections )
+      if ( _usePlanarReflection() )
          mPlaneReflector.registerReflector( this, &mReflectorDesc );
    }
 
@@ -885,6 +901,7 @@ void WaterObject::onRemove()
 {
    Con::NotifyDelegate clbk( this, &WaterObject::_onDisableTrueRelfections ); 
    Con::removeVariableNotify( "$pref::Water::disableTrueReflections", clbk );
+   Con::removeVariableNotify( "$pref::Water::screenSpaceReflections", clbk );
 
    if ( isClientObject() )
    {
@@ -906,7 +923,7 @@ void WaterObject::_onDisableTrueRelfections()
    {
       bool isEnabled = mPlaneReflector.isEnabled();
 
-      bool enable = mFullReflect && !smDisableTrueReflections;
+      bool enable = _usePlanarReflection();
 
       if ( enable && !isEnabled )
          mPlaneReflector.registerReflector( this, &mReflectorDesc );
@@ -915,6 +932,39 @@ void WaterObject::_onDisableTrueRelfections()
    }
 }
 
+GFXTextureObject* WaterObject::_getReflectTex() const
+{
+   if ( mPlaneReflector.isEnabled() )
+      return mPlaneReflector.reflectTex;
+
+   // The screen space reflection is rendered by a post effect
+   // using the deferred targets, which Basic Lighting lacks.
+   if (  !mFullReflect || 
+         smDisableTrueReflections || 
+         !smScreenSpaceReflections || 
+         mBasicLighting )
+      return NULL;
+
+   // It is stored per screen pixel which is the same
+   // way the planar reflection texture is sampled.
+   NamedTexTarget *target = NamedTexTarget::find( "ssrReflection" );
+   return target ? target->getTexture() : NULL;
+}
+
+bool WaterObject::_hasValidReflectTex( const SceneRenderState *state )
+{
+   if ( isUnderwater( state->getCameraPosition() ) )
+      return false;
+
+   if ( !mPlaneReflector.isEnabled() )
+      return _getReflectTex() != NULL;
+
+   // If we were occluded the last frame a query was fetched ( not necessarily last frame )
+   // and we weren't updated last frame... we don't have a valid texture to show
+   // so use the cubemap / fake reflection color this frame.
+   return !( mPlaneReflector.lastUpdateMs != REFLECTMGR->getLastUpdateMs() && mPlaneReflector.isOccluded() );
+}
+
 void WaterObject::setShaderParams( SceneRenderState *state, BaseMatInstance *mat, const WaterMatParams &paramHandles )
 {
    MaterialParameters* matParams = mat->getMaterialParameters();
@@ -924,7 +974,10 @@ void WaterObject::setShaderParams( SceneRenderState *state, BaseMatInstance *mat
    // set vertex shader constants
    //-----------------------------------   
    
-   Point2F reflectTexSize( mPlaneReflector.reflectTex.getWidth(), mPlaneReflector.reflectTex.getHeight() );
+   GFXTextureObject *reflectTex = _getReflectTex();
+   Point2F reflectTexSize( Point2F::Zero );
+   if ( reflectTex )
+      reflectTexSize.set( reflectTex->getWidth(), reflectTex->getHeight() );
    matParams->setSafe( paramHandles.mReflectTexSizeSC, reflectTexSize );
 
    static AlignedArray<Point2F> mConstArray( MAX_WAVES, sizeof( Point4F ) );   
@@ -200,6 +200,18 @@ protected:
    /// Callback used internally when smDisableTrueReflections changes.
    void _onDisableTrueRelfections();
 
+   /// Returns true if fullReflect should render the scene
+   /// through the PlaneReflector.
+   bool _usePlanarReflection() const { return mFullReflect && !smDisableTrueReflections && !smScreenSpaceReflections; }
+
+   /// Returns the planar or screen space reflection texture
+   /// or NULL if the cubemap should be used.
+   GFXTextureObject* _getReflectTex() const;
+
+   /// Returns true if the reflection texture has valid
+   /// contents to show from this camera.
+   bool _hasValidReflectTex( const SceneRenderState *state );
+
 protected:
 
    static bool _setFullReflect( void *object, const char *index, const char *data );
@@ -299,11 +311,18 @@ protected:
    /// Force all water objects to use static cubemap reflections
    static bool smDisableTrueReflections;
 
+   /// Makes fullReflect water use the screen space reflection
+   /// target instead of rendering the scene a second time.
+   static bool smScreenSpaceReflections;
+
    // Rendering   
    bool mBasicLighting;
    //U32 mRenderUpdateCount;
    //U32 mReflectUpdateCount;
    bool mGenerateVB;
+   /// Set when the textures have to be (re)loaded, which is
+   /// deferred until the water is first rendered.
+   bool mInitTextures;
    String mSurfMatName[NumMatTypes];
    BaseMatInstance* mMatInstances[NumMatTypes];
    WaterMatParams mMatParamHandles[NumMatTypes];   
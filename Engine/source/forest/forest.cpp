@@ -55,6 +55,7 @@ ForestCreatedSignal Forest::smDestroyedSignal;
 bool Forest::smForceImposters = false;
 bool Forest::smDisableImposters = false;
 bool Forest::smDrawCells = false;
+bool Forest::smUseInstancing = true;
 bool Forest::smDrawBounds = false;
 
 
@@ -135,6 +136,16 @@ void Forest::consoleInit()
       "A debugging aid which renders the forest bounds.\n"
       "@ingroup Forest\n" );
 
+   Con::addVariable("$pref::Forest::useInstancing", TypeBool, &Forest::smUseInstancing,
+      "Draws the meshes of all forest items of the same shape and detail level as hardware "
+      "instanced batches, with the wind deformation of each item passed per instance.\n"
+      "@ingroup Forest\n" );
+
+   Con::addVariable("$pref::Forest::backgroundBuild", TypeBool, &ForestCell::smBackgroundBuild,
+      "Builds the render batches and collision of forest cells on worker threads.  Until a "
+      "build is done the cell keeps rendering its old batches.\n"
+      "@ingroup Forest\n" );
+
    // The canvas signal lets us know to clear the rendering stats.
    GuiCanvas::getGuiCanvasFrameSignal().notify( &Forest::_clearStats );
 }
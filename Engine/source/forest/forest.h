@@ -108,12 +108,21 @@ protected:
    /// Set when rezoning of forest cells is required.
    bool mZoningDirty;
 
+   /// Scratch stacks for walking the cells in prepRenderImage(),
+   /// kept around so they don't reallocate every frame.
+   Vector<ForestCell*> mCellStack;
+   Vector<U32> mPlaneMaskStack;
+
    /// Debug helpers.
    static bool smForceImposters;
    static bool smDisableImposters;
    static bool smDrawCells;
    static bool smDrawBounds;
 
+   /// If true the meshes of all forest items are hardware
+   /// instanced no matter their vertex count.
+   static bool smUseInstancing;
+
    ///
    bool mRegen;
 
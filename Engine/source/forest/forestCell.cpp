@@ -26,6 +26,7 @@
 #include "forest/forest.h"
 #include "forest/forestCellBatch.h"
 #include "forest/forestCollision.h"
+#include "forest/ts/tsForestItemData.h"
 #include "T3D/physics/physicsPlugin.h"
 #include "T3D/physics/physicsBody.h"
 #include "T3D/physics/physicsCollision.h"
@@ -35,10 +36,240 @@
 #include "math/util/frustum.h"
 
 
+bool ForestCell::smBackgroundBuild = true;
+
+
+/// Builds the collision shape for the collidable @a items.
+static PhysicsCollision* _buildCollisionShape( const Vector<ForestItem> &items )
+{
+   // We must pass a sphere to buildPolyList but it is not used.
+   const static SphereF dummySphere( Point3F::Zero, 0 );       
+
+   // Step thru them and build collision data.
+   ForestItemVector::const_iterator itemItr = items.begin();
+   ConcretePolyList polyList;
+   for ( ; itemItr != items.end(); itemItr++ )
+   {
+      const ForestItem &item = *itemItr;
+      const ForestItemData *itemData = item.getData();
+      
+      // If not collidable don't need to build anything.
+      if ( !itemData->mCollidable )
+         continue;
+
+      // TODO: When we add breakable tree support this is where
+      // we would need to store their collision data seperately.
+
+      item.buildPolyList( &polyList, item.getWorldBox(), dummySphere );
+
+      // TODO: Need to support multiple collision shapes
+      // for really big forests at some point in the future.
+   }
+
+   if ( polyList.isEmpty() )
+      return NULL;
+
+   PhysicsCollision *colShape = PHYSICSMGR->createCollision();
+   if ( !colShape->addTriangleMesh( polyList.mVertexList.address(),
+                                    polyList.mVertexList.size(),
+                                    polyList.mIndexList.address(),
+                                    polyList.mIndexList.size() / 3,
+                                    MatrixF::Identity ) )
+   {
+      SAFE_DELETE( colShape );
+   }
+
+   return colShape;
+}
+
+
+/// A build for a ForestCell which runs on the thread pool and
+/// then hands the result to the cell on the main thread.
+///
+/// The cell cancels the build when its items change or it is
+/// deleted, in which case the result is never handed over.
+class ForestCellBuildItem : public ThreadWorkItem
+{
+public:
+
+   typedef ThreadWorkItem Parent;
+
+   ForestCellBuildItem( ForestCell *cell )
+      :  mCell( cell ),
+         mCancelled( false )
+   {
+   }
+
+   /// Stops the build if it has not completed yet.
+   void cancel() { mCancelled = true; }
+
+   // ThreadPool::WorkItem
+   virtual bool isCancellationRequested() { return mCancelled; }
+
+protected:
+
+   /// Hands the result to the cell on the main thread.
+   class CompletionItem : public ThreadWorkItem
+   {
+   public:
+
+      CompletionItem( ForestCellBuildItem *item )
+         : mItem( item )
+      {
+      }
+
+   protected:
+
+      ThreadSafeRef< ForestCellBuildItem > mItem;
+
+      virtual void execute()
+      {
+         if ( !mItem->mCancelled )
+            mItem->_complete();
+      }
+   };
+
+   /// The cell to hand the result to.  It is only 
+   /// touched on the main thread.
+   ForestCell *mCell;
+
+   volatile bool mCancelled;
+
+   /// Does the work on the worker thread.
+   virtual void _build() = 0;
+
+   /// Hands the result to the cell on the main thread.
+   virtual void _complete() = 0;
+
+   virtual void execute()
+   {
+      if ( cancellationPoint() )
+         return;
+
+      _build();
+
+      if ( cancellationPoint() )
+         return;
+
+      ThreadPool::queueWorkItemOnMainThread( new CompletionItem( this ) );
+   }
+};
+
+
+/// Fills the batches allocated by the cell.
+class ForestCellBatchBuild : public ForestCellBuildItem
+{
+public:
+
+   typedef ForestCellBuildItem Parent;
+
+   ForestCellBatchBuild( ForestCell *cell, Vector<ForestCellBatch*> &batches )
+      :  Parent( cell ),
+         mBatches( batches )
+   {
+      batches.clear();
+   }
+
+   virtual ~ForestCellBatchBuild()
+   {
+      for ( U32 i=0; i < mBatches.size(); i++ )
+         delete mBatches[i];
+   }
+
+protected:
+
+   /// The batches until they are handed to the cell.
+   Vector<ForestCellBatch*> mBatches;
+
+   virtual void _build()
+   {
+      for ( U32 i=0; i < mBatches.size(); i++ )
+      {
+         if ( cancellationPoint() )
+            return;
+
+         mBatches[i]->prepare();
+      }
+   }
+
+   virtual void _complete()
+   {
+      mCell->_onBatchesBuilt( mBatches );
+   }
+};
+
+
+/// Builds the collision shape of a leaf cell which is 
+/// shared by the client and server PhysicsBody.
+class ForestCellCollisionBuild : public ForestCellBuildItem
+{
+public:
+
+   typedef ForestCellBuildItem Parent;
+
+   ForestCellCollisionBuild( ForestCell *cell )
+      : Parent( cell )
+   {
+      mForests[0] = mForests[1] = NULL;
+
+      // Copy the collidable items so that the worker doesn't
+      // share them with the main thread.
+      const Vector<ForestItem> &items = cell->getItems();
+      for ( U32 i=0; i < items.size(); i++ )
+      {
+         const ForestItem &item = items[i];
+         if ( !item.getData()->mCollidable )
+            continue;
+
+         // The shape instance is created on first use, so
+         // make sure that doesn't happen on the worker.
+         static_cast<TSForestItemData*>( item.getData() )->getShapeInstance();
+
+         mItems.push_back( item );
+      }
+   }
+
+   /// Requests a PhysicsBody for @a forest once the shape is built.
+   void addForest( Forest *forest ) { mForests[ forest->isServerObject() ] = forest; }
+
+   /// Drops the request of @a forest.
+   void removeForest( Forest *forest ) { mForests[ forest->isServerObject() ] = NULL; }
+
+   /// Returns true if anyone still wants the shape.
+   bool hasForests() const { return mForests[0] || mForests[1]; }
+
+protected:
+
+   Vector<ForestItem> mItems;
+
+   /// The client and server forests waiting for the shape.
+   Forest *mForests[2];
+
+   StrongRefPtr<PhysicsCollision> mColShape;
+
+   virtual void _build()
+   {
+      mColShape = _buildCollisionShape( mItems );
+   }
+
+   virtual void _complete()
+   {
+      mCell->mCollisionBuild = NULL;
+
+      for ( U32 i=0; i < 2; i++ )
+      {
+         if ( mForests[i] )
+            mCell->_onCollisionBuilt( mForests[i], mColShape );
+      }
+   }
+};
+
+
 ForestCell::ForestCell( const RectF &rect ) :
    mRect( rect ),
    mBounds( Box3F::Invalid ),
    mIsDirty( false ),
+   mBatchesDirty( true ),
    mLargestItem( ForestItem::Invalid ),
    mIsInteriorOnly( false )
 {
@@ -55,12 +286,25 @@ ForestCell::~ForestCell()
 
    freeBatches();
 
-   SAFE_DELETE( mPhysicsRep[0] );
-   SAFE_DELETE( mPhysicsRep[1] );
+   _freePhysicsReps();
+}
+
+void ForestCell::_invalidateBatches()
+{
+   mBatchesDirty = true;
+
+   // Any build in flight is out of date now.
+   if ( mBatchBuild )
+   {
+      mBatchBuild->cancel();
+      mBatchBuild = NULL;
+   }
 }
 
 void ForestCell::freeBatches()
 {
+   _invalidateBatches();
+
    for ( U32 i=0; i < mBatches.size(); i++ )
       SAFE_DELETE( mBatches[i] );
 
@@ -68,11 +312,60 @@ void ForestCell::freeBatches()
 }
 
 void ForestCell::buildBatches()
+{
+   freeBatches();
+   _allocateBatches( &mBatches );
+   mBatchesDirty = false;
+}
+
+void ForestCell::updateBatches()
+{
+   if ( !mBatchesDirty || mBatchBuild )
+      return;
+
+   if ( !smBackgroundBuild )
+   {
+      buildBatches();
+      return;
+   }
+
+   PROFILE_SCOPE( ForestCell_updateBatches );
+
+   Vector<ForestCellBatch*> batches;
+   _allocateBatches( &batches );
+   mBatchesDirty = false;
+
+   if ( batches.empty() )
+   {
+      _onBatchesBuilt( batches );
+      return;
+   }
+
+   // The current batches keep rendering until
+   // the new ones are handed over.
+   mBatchBuild = new ForestCellBatchBuild( this, batches );
+   ThreadPool::GLOBAL().queueWorkItem( mBatchBuild );
+}
+
+void ForestCell::_onBatchesBuilt( Vector<ForestCellBatch*> &batches )
+{
+   mBatchBuild = NULL;
+
+   for ( U32 i=0; i < mBatches.size(); i++ )
+      delete mBatches[i];
+
+   mBatches = batches;
+   batches.clear();
+}
+
+void ForestCell::_allocateBatches( Vector<ForestCellBatch*> *outBatches ) const
 {
    // Gather items for batches.
    Vector<ForestItem> items;
    getItems( &items );
 
+   Vector<ForestCellBatch*> &batches = *outBatches;
+
    // Ask the item to batch itself.
    Vector<ForestItem>::const_iterator item = items.begin();
    bool batched = false;
@@ -81,9 +374,9 @@ void ForestCell::buildBatches()
       // Loop thru the batches till someone 
       // takes this guy off our hands.
       batched = false;
-      for ( S32 i=0; i < mBatches.size(); i++ )
+      for ( S32 i=0; i < batches.size(); i++ )
       {
-         if ( mBatches[i]->add( *item ) )
+         if ( batches[i]->add( *item ) )
          {
             batched = true;
             break;
@@ -98,12 +391,12 @@ void ForestCell::buildBatches()
       if ( batch )
       {
          batch->add( *item );
-         mBatches.push_back( batch );
+         batches.push_back( batch );
       }
    }
 }
 
-S32 ForestCell::renderBatches( SceneRenderState *state, Frustum *culler )
+S32 ForestCell::renderBatches( SceneRenderState *state, const Frustum *culler, U32 planeMask )
 {
    PROFILE_SCOPE( ForestCell_renderBatches );
 
@@ -115,7 +408,7 @@ S32 ForestCell::renderBatches( SceneRenderState *state, Frustum *culler )
    for ( S32 i=0; i < mBatches.size(); i++ )
    {
       // Is this batch entirely culled?
-      if ( culler && culler->isCulled( mBatches[i]->getWorldBox() ) )
+      if ( culler && culler->testPlanes( mBatches[i]->getWorldBox(), planeMask ) == -1 )
          continue;
 
       if( state->getCullingState().isOccludedWithExtraPlanesCull( mBatches[i]->getWorldBox() ) )
@@ -128,7 +421,7 @@ S32 ForestCell::renderBatches( SceneRenderState *state, Frustum *culler )
    return renderedItems;
 }
 
-S32 ForestCell::render( TSRenderState *rdata, const Frustum *culler )
+S32 ForestCell::render( TSRenderState *rdata, const Frustum *culler, U32 planeMask )
 {
    PROFILE_SCOPE( ForestCell_render );
 
@@ -144,7 +437,7 @@ S32 ForestCell::render( TSRenderState *rdata, const Frustum *culler )
    for ( ; item != mItems.end(); item++ )
    {
       // Do we need to cull individual items?
-      if ( culler && culler->isCulled( item->getWorldBox() ) )
+      if ( culler && culler->testPlanes( item->getWorldBox(), planeMask ) == -1 )
          continue;
 
       if ( item->getData()->render( rdata, *item ) )
@@ -267,12 +560,10 @@ const ForestItem& ForestCell::insertItem( ForestItemKey key,
    mIsDirty = true;
 
    // PhysicsBody is now invalid and must be rebuilt later.
-   SAFE_DELETE( mPhysicsRep[0] );
-   SAFE_DELETE( mPhysicsRep[1] );
+   _freePhysicsReps();
 
-   // Destroy batches so we recreate it on
-   // the next next render.
-   freeBatches();
+   // Rebuild the batches on the next render.
+   _invalidateBatches();
 
    // Ok... do we need to split this cell?
    if ( isLeaf() && mItems.size() > MaxItems )
@@ -395,12 +686,10 @@ bool ForestCell::removeItem( ForestItemKey key, const Point3F &keyPos, bool dele
    mIsDirty = true;
 
    // PhysicsBody is now invalid and must be rebuilt later.
-   SAFE_DELETE( mPhysicsRep[0] );
-   SAFE_DELETE( mPhysicsRep[1] );
+   _freePhysicsReps();
 
-   // Destroy batches so we recreate it on
-   // the next next render.
-   freeBatches();
+   // Rebuild the batches on the next render.
+   _invalidateBatches();
 
    return true;
 }
@@ -429,6 +718,18 @@ void ForestCell::getItems( Vector<ForestItem> *outItems ) const
    }
 }
 
+void ForestCell::_freePhysicsReps()
+{
+   SAFE_DELETE( mPhysicsRep[0] );
+   SAFE_DELETE( mPhysicsRep[1] );
+
+   if ( mCollisionBuild )
+   {
+      mCollisionBuild->cancel();
+      mCollisionBuild = NULL;
+   }
+}
+
 void ForestCell::buildPhysicsRep( Forest *forest )
 {   
    AssertFatal( isLeaf(), "ForestCell::buildPhysicsRep() - This shouldn't be called on non-leaf cells!" );
@@ -451,48 +752,35 @@ void ForestCell::buildPhysicsRep( Forest *forest )
    {      
       colShape = mPhysicsRep[ 1 ]->getColShape();
    }
-   else
+   else if ( smBackgroundBuild )
    {
-      // We must pass a sphere to buildPolyList but it is not used.
-      const static SphereF dummySphere( Point3F::Zero, 0 );       
-
-      // Step thru them and build collision data.
-      ForestItemVector::iterator itemItr = mItems.begin();
-      ConcretePolyList polyList;
-      for ( ; itemItr != mItems.end(); itemItr++ )
+      // Join the build in flight so that the client and 
+      // server share the shape, else start a new one.
+      if ( !mCollisionBuild )
       {
-         const ForestItem &item = *itemItr;
-         const ForestItemData *itemData = item.getData();
-         
-         // If not collidable don't need to build anything.
-         if ( !itemData->mCollidable )
-            continue;
-
-         // TODO: When we add breakable tree support this is where
-         // we would need to store their collision data seperately.
-
-         item.buildPolyList( &polyList, item.getWorldBox(), dummySphere );
-
-         // TODO: Need to support multiple collision shapes
-         // for really big forests at some point in the future.
+         mCollisionBuild = new ForestCellCollisionBuild( this );
+         mCollisionBuild->addForest( forest );
+         ThreadPool::GLOBAL().queueWorkItem( mCollisionBuild );
       }
+      else
+         mCollisionBuild->addForest( forest );
 
-      if ( !polyList.isEmpty() )
-      {
-         colShape = PHYSICSMGR->createCollision();
-         if ( !colShape->addTriangleMesh( polyList.mVertexList.address(),
-                                          polyList.mVertexList.size(),
-                                          polyList.mIndexList.address(),
-                                          polyList.mIndexList.size() / 3,
-                                          MatrixF::Identity ) )
-         {
-            SAFE_DELETE( colShape );
-         }
-      }
+      return;
    }
+   else
+      colShape = _buildCollisionShape( mItems );
+
+   _onCollisionBuilt( forest, colShape );
+}
 
+void ForestCell::_onCollisionBuilt( Forest *forest, PhysicsCollision *colShape )
+{
    // We might not have any trees.
-   if ( !colShape )
+   if ( !colShape || !PHYSICSMGR )
+      return;
+
+   bool isServer = forest->isServerObject();
+   if ( mPhysicsRep[ isServer ] )
       return;
 
    PhysicsWorld *world = PHYSICSMGR->getWorld( isServer ? "server" : "client" );
@@ -505,4 +793,16 @@ void ForestCell::clearPhysicsRep( Forest *forest )
    bool isServer = forest->isServerObject();
 
    SAFE_DELETE( mPhysicsRep[ isServer ] );
-}
\ No newline at end of file
+
+   // Drop out of the build in flight and stop it
+   // if nobody else is waiting on it.
+   if ( mCollisionBuild )
+   {
+      mCollisionBuild->removeForest( forest );
+      if ( !mCollisionBuild->hasForests() )
+      {
+         mCollisionBuild->cancel();
+         mCollisionBuild = NULL;
+      }
+   }
+}
@@ -32,12 +32,18 @@
 #ifndef _BITVECTOR_H_
 #include "core/bitVector.h"
 #endif
+#ifndef _THREADPOOL_H_
+#include "platform/threads/threadPool.h"
+#endif
 
 class ForestCellBatch;
 class SceneRenderState;
 class Frustum;
 class IForestCellCollision;
 class PhysicsBody;
+class PhysicsCollision;
+class ForestCellBatchBuild;
+class ForestCellCollisionBuild;
 //class ForestRayInfo;
 
 
@@ -45,6 +51,8 @@ class PhysicsBody;
 class ForestCell
 {
    friend class Forest;
+   friend class ForestCellBatchBuild;
+   friend class ForestCellCollisionBuild;
 
 protected:
 
@@ -67,6 +75,16 @@ protected:
    /// associated with this cell.
    Vector<ForestCellBatch*> mBatches;
 
+   /// Set when the batches don't match the items anymore.  The
+   /// old batches are still rendered until the new ones are built.
+   bool mBatchesDirty;
+
+   /// The batches being built on a worker thread.
+   ThreadSafeRef<ForestCellBatchBuild> mBatchBuild;
+
+   /// The collision shape being built on a worker thread.
+   ThreadSafeRef<ForestCellCollisionBuild> mCollisionBuild;
+
    /// The largest item in this cell.
    ForestItem mLargestItem;
    
@@ -114,6 +132,25 @@ protected:
 
    void _updateBounds();
 
+   /// Marks the batches for a rebuild but keeps them 
+   /// for rendering until the new ones are ready.
+   void _invalidateBatches();
+
+   /// Frees the physics reps and stops their pending build.
+   void _freePhysicsReps();
+
+   /// Groups the items of this cell and all its 
+   /// sub-cells into new batches.
+   void _allocateBatches( Vector<ForestCellBatch*> *outBatches ) const;
+
+   /// Replaces the current batches with the @a batches 
+   /// built on a worker thread.
+   void _onBatchesBuilt( Vector<ForestCellBatch*> &batches );
+
+   /// Creates the PhysicsBody for @a forest from the 
+   /// shape built on a worker thread.
+   void _onCollisionBuilt( Forest *forest, PhysicsCollision *colShape );
+
    ///
    void _updateZoning( const SceneZoneSpaceManager *zoneManager );
 
@@ -123,6 +160,10 @@ public:
    /// cell before we repartition it.
    static const U32 MaxItems = 200;
 
+   /// If true the batches and collision of cells are built
+   /// on the thread pool instead of stalling the frame.
+   static bool smBackgroundBuild;
+
    ForestCell( const RectF &rect );
    virtual ~ForestCell();
 
@@ -156,14 +197,26 @@ public:
 
    bool hasBatches() const { return !mBatches.empty(); }
 
+   /// Returns true if the batches are out of date.
+   bool areBatchesDirty() const { return mBatchesDirty; }
+
+   /// Builds the batches right away.
    void buildBatches();
 
-   void freeBatches();
+   /// Builds the batches if they are out of date.  With
+   /// smBackgroundBuild enabled this only starts the build
+   /// and the current batches remain until it's done.
+   void updateBatches();
 
-   S32 renderBatches( SceneRenderState *state, Frustum *culler );
+   void freeBatches();
 
+   /// Renders the batches of the cell testing their bounds against
+   /// the @a planeMask planes of @a culler if it isn't NULL.
+   S32 renderBatches( SceneRenderState *state, const Frustum *culler, U32 planeMask );
 
-   S32 render( TSRenderState *rdata, const Frustum *culler );
+   /// Renders the items of the cell testing their bounds against
+   /// the @a planeMask planes of @a culler if it isn't NULL.
+   S32 render( TSRenderState *rdata, const Frustum *culler, U32 planeMask );
 
 
    /// The find function does a binary search thru the sorted
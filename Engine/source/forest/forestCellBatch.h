@@ -43,6 +43,12 @@ protected:
    Box3F mBounds;
 
    virtual bool _prepBatch( const ForestItem &item ) = 0;
+
+   /// Does the work of a rebuild which doesn't touch the
+   /// device so that it can run on a worker thread.
+   /// @see prepare
+   virtual void _prepareBatch() {}
+
    virtual void _rebuildBatch() = 0;
    virtual void _render( const SceneRenderState *state ) = 0;
 
@@ -54,6 +60,10 @@ public:
    bool add( const ForestItem &item );
    S32 getItemCount() const { return mItems.size(); }
 
+   /// Prepares the rebuild of a batch that isn't rendered
+   /// yet.  It is safe to call this from a worker thread.
+   void prepare() { _prepareBatch(); }
+
    void render( SceneRenderState *state );
    const Box3F& getWorldBox() const { return mBounds; }
 };
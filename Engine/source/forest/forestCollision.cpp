@@ -267,6 +267,9 @@ bool Forest::buildPolyList( PolyListContext context, AbstractPolyList* polyList,
    if ( context == PLC_Decal )
       return false;
 
+   // Ray casts test against the LOS details.
+   const bool losDetails = ( context == PLC_RayCast );
+
    // Get all ForestItem(s) within the box.
    Vector<ForestItem> trees;
    if ( mData->getItems( box, &trees ) == 0 )
@@ -277,12 +280,12 @@ bool Forest::buildPolyList( PolyListContext context, AbstractPolyList* polyList,
    bool gotPoly = false;
 
    for ( U32 i = 0; i < trees.size(); i++ )
-      gotPoly |= trees[i].buildPolyList( polyList, box, sphere );
+      gotPoly |= trees[i].buildPolyList( polyList, box, sphere, losDetails );
 
    return gotPoly;
 }
 
-bool ForestItem::buildPolyList( AbstractPolyList* polyList, const Box3F &box, const SphereF &sphere ) const
+bool ForestItem::buildPolyList( AbstractPolyList* polyList, const Box3F &box, const SphereF &sphere, bool losDetails ) const
 {
    TSForestItemData *data = (TSForestItemData*)mDataBlock;
    
@@ -293,7 +296,7 @@ bool ForestItem::buildPolyList( AbstractPolyList* polyList, const Box3F &box, co
 
    TSShapeInstance *si = data->getShapeInstance();
 
-   const Vector<S32> &details = data->getCollisionDetails();
+   const Vector<S32> &details = losDetails ? data->getLOSDetails() : data->getCollisionDetails();
    S32 detail;
    for  (U32 i = 0; i < details.size(); i++ ) 
    {
@@ -340,6 +343,9 @@ void Forest::updateCollision()
    if ( !mData )
       return;
 
+   if ( getContainer() )
+      getContainer()->releaseStaticCollision( this );
+
    mData->buildPhysicsRep( this );
 
    // Make the assumption that if collision needs
@@ -244,7 +244,9 @@ public:
    
       bool castRay( const Point3F &start, const Point3F &end, RayInfo *outInfo, bool rendered ) const;         
 
-      bool buildPolyList( AbstractPolyList *polyList, const Box3F &box, const SphereF &sphere ) const;
+      /// @param losDetails Use the LOS details castRay() tests against
+      ///   instead of the collision details.
+      bool buildPolyList( AbstractPolyList *polyList, const Box3F &box, const SphereF &sphere, bool losDetails = false ) const;
 
       //ForestConvex* buildConvex( const Box3F &box, Convex *convex ) const;
 
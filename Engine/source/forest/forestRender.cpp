@@ -106,6 +106,11 @@ void Forest::prepRenderImage( SceneRenderState *state )
    // its alot cheaper than the bounds sort.
    rdata.setOriginSort( true );
 
+   // Forest meshes are usually too big for the instancing
+   // vertex limit, but there are so many of them that
+   // drawing them in instanced batches is still a win.
+   rdata.setForceInstancing( smUseInstancing );
+
    // We may have some forward lit materials in
    // the forest, so pass down a LightQuery for it.
    LightQuery lightQuery;
@@ -136,9 +141,19 @@ void Forest::prepRenderImage( SceneRenderState *state )
    
    // First get all the top level cells which 
    // intersect the frustum.
-   Vector<ForestCell*> cellStack;
+   Vector<ForestCell*> &cellStack = mCellStack;
+   cellStack.clear();
    mData->getCells( culler, &cellStack );
 
+   // The frustum planes each cell on the stack still has to
+   // be tested against.  A cell entirely on the inside of a
+   // plane has all its children and items inside of it too,
+   // so the plane can be skipped for everything below it.
+   Vector<U32> &planeMaskStack = mPlaneMaskStack;
+   planeMaskStack.setSize( cellStack.size() );
+   for ( U32 i=0; i < planeMaskStack.size(); i++ )
+      planeMaskStack[i] = Frustum::PlaneMaskAll;
+
    // Get the culling zone state.
    const BitVector &zoneState = state->getCullingState().getZoneVisibilityFlags();
 
@@ -149,6 +164,9 @@ void Forest::prepRenderImage( SceneRenderState *state )
       cell = cellStack.last();
       cellStack.pop_back();
 
+      const U32 planeMask = planeMaskStack.last();
+      planeMaskStack.pop_back();
+
       const Box3F &cellBounds = cell->getBounds();
 
       // If the cell is empty or its bounds is outside the frustum
@@ -157,7 +175,7 @@ void Forest::prepRenderImage( SceneRenderState *state )
          continue;
 
       // Can we cull this cell entirely?
-      clipMask = culler.testPlanes( cellBounds, Frustum::PlaneMaskAll );
+      clipMask = planeMask != 0 ? culler.testPlanes( cellBounds, planeMask ) : 0;
       if ( clipMask == -1 )
          continue;
 
@@ -207,9 +225,8 @@ void Forest::prepRenderImage( SceneRenderState *state )
          ++smCellsBatched;
 
          // Ok... everything in this cell should be batched.  First
-         // create the batches if we don't have any.
-         if ( !cell->hasBatches() )
-            cell->buildBatches();
+         // update the batches if the items changed.
+         cell->updateBatches();
 
          //if ( drawCells )
             //mCellRenderFlag[ cellIter - theCells.begin() ] = 1;
@@ -218,7 +235,7 @@ void Forest::prepRenderImage( SceneRenderState *state )
 
          // Now render the batches... we pass the culler if the
          // cell wasn't fully visible so that each batch can be culled.
-         smCellItemsBatched += cell->renderBatches( state, clipMask != 0 ? &culler : NULL );
+         smCellItemsBatched += cell->renderBatches( state, clipMask != 0 ? &culler : NULL, clipMask );
          continue;
       }
 
@@ -226,6 +243,8 @@ void Forest::prepRenderImage( SceneRenderState *state )
       if ( !cell->isLeaf() )
       {
          cell->getChildren( &cellStack );
+         while ( planeMaskStack.size() < cellStack.size() )
+            planeMaskStack.push_back( clipMask );
          continue;
       }
 
@@ -244,7 +263,7 @@ void Forest::prepRenderImage( SceneRenderState *state )
       lightQuery.init( cellBounds );
 
       // This cell is visible... have it render its items.
-      smCellItemsRendered += cell->render( &rdata, clipMask != 0 ? &culler : NULL );
+      smCellItemsRendered += cell->render( &rdata, clipMask != 0 ? &culler : NULL, clipMask );
    }
 
    // Keep track of the average items per cell.
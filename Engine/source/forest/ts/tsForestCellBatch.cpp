@@ -44,49 +44,39 @@ bool TSForestCellBatch::_prepBatch( const ForestItem &item )
    if ( !data )
       return false;
 
-   // TODO: Eventually we should atlas multiple details into
-   // a single combined texture map.  Till then we have to
-   // do one batch per-detail type.
+   TSLastDetail *detail = data->getLastDetail();
+   if ( detail == mDetail )
+      return true;
 
-   // If the detail type doesn't match then 
-   // we need to start a new batch.
-   if ( data->getLastDetail() != mDetail )
-      return false;
-
-   return true;
+   // Details packed into the same imposter atlas page
+   // share their material and can go into one batch.
+   //
+   // If the material doesn't match then we need
+   // to start a new batch.
+   return   detail &&
+            detail->getMatInstance() &&
+            detail->getMatInstance() == mDetail->getMatInstance();
 }
 
-void TSForestCellBatch::_rebuildBatch()
+void TSForestCellBatch::_prepareBatch()
 {
-   // Clean up first.
-   mVB = NULL;
-   if ( mItems.empty() )
+   mVerts.setSize( mItems.size() * 6 );
+   if ( mVerts.empty() )
       return;
 
-   // How big do we need to make this?
-   U32 verts = mItems.size() * 6;
-   mVB.set( GFX, verts, GFXBufferTypeStatic );
-   if ( !mVB.isValid() )
-   {
-      // If we failed it is probably because we requested
-      // a size bigger than a VB can be.  Warn the user.
-      AssertWarn( false, "TSForestCellBatch::_rebuildBatch: Batch too big... try reducing the forest cell size!" );
-      return;
-   }
-
-   // Fill this puppy!
-   ImposterState *vertPtr = mVB.lock();
-   if(!vertPtr) return;
+   ImposterState *vertPtr = mVerts.address();
 
    Vector<ForestItem>::const_iterator item = mItems.begin();
 
-   const F32 radius = mDetail->getRadius();
    ImposterState state;
 
    for ( ; item != mItems.end(); item++ )
    {
+      const TSLastDetail *detail = static_cast<TSForestItemData*>( item->getData() )->getLastDetail();
+
       item->getWorldBox().getCenter( &state.center );
-      state.halfSize = radius * item->getScale();
+      state.halfSize = detail->getRadius() * item->getScale();
+      state.atlasRect = detail->getAtlasRect();
       state.alpha = 1.0f;
       item->getTransform().getColumn( 2, &state.upVec );
       item->getTransform().getColumn( 0, &state.rightVec );
@@ -115,8 +105,42 @@ void TSForestCellBatch::_rebuildBatch()
       vertPtr->corner = 0;
       ++vertPtr;
    }
+}
+
+void TSForestCellBatch::_rebuildBatch()
+{
+   // Clean up first.
+   mVB = NULL;
+   if ( mItems.empty() )
+      return;
+
+   // The vertices are usually prepared on a worker
+   // thread, but do it now if they weren't.
+   if ( mVerts.size() != mItems.size() * 6 )
+      _prepareBatch();
+
+   // How big do we need to make this?
+   U32 verts = mVerts.size();
+   mVB.set( GFX, verts, GFXBufferTypeStatic );
+   if ( !mVB.isValid() )
+   {
+      // If we failed it is probably because we requested
+      // a size bigger than a VB can be.  Warn the user.
+      AssertWarn( false, "TSForestCellBatch::_rebuildBatch: Batch too big... try reducing the forest cell size!" );
+      return;
+   }
+
+   // Fill this puppy!
+   ImposterState *vertPtr = mVB.lock();
+   if(!vertPtr) return;
+
+   dMemcpy( vertPtr, mVerts.address(), mVerts.memSize() );
 
    mVB.unlock();
+
+   // We don't need the copy anymore.
+   mVerts.clear();
+   mVerts.compact();
 }
 
 void TSForestCellBatch::_render( const SceneRenderState *state )
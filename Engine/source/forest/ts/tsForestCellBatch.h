@@ -51,8 +51,13 @@ protected:
 
    TSLastDetail *mDetail;
 
+   /// The vertices filled in by _prepareBatch() waiting
+   /// to be copied into the vertex buffer.
+   Vector<ImposterState> mVerts;
+
    // ForestCellBatch
    virtual bool _prepBatch( const ForestItem &item );
+   virtual void _prepareBatch();
    virtual void _rebuildBatch();
    virtual void _render( const SceneRenderState *state );
 
@@ -30,12 +30,14 @@
 #include "gfx/D3D11/gfxD3D11EnumTranslate.h"
 #include "gfx/D3D11/gfxD3D11QueryFence.h"
 #include "gfx/D3D11/gfxD3D11OcclusionQuery.h"
+#include "gfx/D3D11/gfxD3D11TimerQuery.h"
 #include "gfx/D3D11/gfxD3D11Shader.h"
 #include "gfx/D3D11/gfxD3D11Target.h"
 #include "platformWin32/platformWin32.h"
 #include "windowManager/win32/win32Window.h"
 #include "windowManager/platformWindow.h"
 #include "gfx/D3D11/screenshotD3D11.h"
+#include "gfx/D3D11/videoFrameGrabberD3D11.h"
 #include "materials/shaderData.h"
 #include "shaderGen/shaderGen.h"
 
@@ -93,6 +95,7 @@ GFXD3D11Device::GFXD3D11Device(U32 index)
    mD3DDevice1 = NULL;
    mD3DDeviceContext1 = NULL;
    mUserAnnotation = NULL;
+   mVideoFrameGrabber = NULL;
    mVolatileVB = NULL;
 
    mCurrentPB = NULL;
@@ -142,6 +145,13 @@ GFXD3D11Device::~GFXD3D11Device()
    // Release our refcount on the current stateblock object
    mCurrentStateBlock = NULL;
 
+   // The frame grabber still needs the context to release its textures.
+   // Video capture shuts down before us, but may still be around if we
+   // are just being recreated.
+   if (ManagedSingleton<VideoCapture>::instanceOrNull())
+      VIDCAP->setFrameGrabber(NULL);
+   SAFE_DELETE(mVideoFrameGrabber);
+
    releaseDefaultPoolResources();
 
    mD3DDeviceContext->ClearState();
@@ -629,6 +639,9 @@ void GFXD3D11Device::init(const GFXVideoMode &mode, PlatformWindow *window)
 
    gScreenShot = new ScreenShotD3D11;
 
+   mVideoFrameGrabber = new VideoFrameGrabberD3D11();
+   VIDCAP->setFrameGrabber(mVideoFrameGrabber);
+
    mInitialized = true;
    deviceInited();
 }
@@ -880,11 +893,28 @@ void GFXD3D11Device::setupGenericShaders(GenericShaderType type)
       mModelViewProjSC[GSTexture] = mGenericShader[GSTexture]->getShaderConstHandle("$modelView");
       Sim::getRootGroup()->addObject(shaderData);
 
+      shaderData = new ShaderData();
+      shaderData->setField("DXVertexShaderFile", ShaderGen::smCommonShaderPath + String("/fixedFunction/addColorTextureV.hlsl"));
+      shaderData->setField("DXPixelShaderFile", ShaderGen::smCommonShaderPath + String("/fixedFunction/distanceFieldP.hlsl"));
+      shaderData->setField("pixVersion", shaderModel);
+      shaderData->registerObject();
+      mGenericShader[GSDistanceField] = shaderData->getShader();
+      if (mGenericShader[GSDistanceField])
+      {
+         mGenericShaderBuffer[GSDistanceField] = mGenericShader[GSDistanceField]->allocConstBuffer();
+         mModelViewProjSC[GSDistanceField] = mGenericShader[GSDistanceField]->getShaderConstHandle("$modelView");
+      }
+      Sim::getRootGroup()->addObject(shaderData);
+
       //Force an update
       mViewportDirty = true;
       _updateRenderTargets();
    }
 
+   // Without the distance field shader text still draws, only with soft edges.
+   if (type == GSDistanceField && mGenericShader[GSDistanceField] == NULL)
+      type = GSAddColorTexture;
+
    MatrixF tempMatrix =  mProjectionMatrix * mViewMatrix * mWorldMatrix[mWorldStackSize];  
    mGenericShaderBuffer[type]->setSafe(mModelViewProjSC[type], tempMatrix);
 
@@ -1065,7 +1095,7 @@ void GFXD3D11Device::reacquireDefaultPoolResources()
       mDynamicPB = new GFXD3D11PrimitiveBuffer(this, 0, 0, GFXBufferTypeDynamic);
 
    D3D11_BUFFER_DESC desc;
-   desc.ByteWidth = sizeof(U16) * MAX_DYNAMIC_INDICES;
+   desc.ByteWidth = sizeof(U16) * VolatilePBPoolIndices;
    desc.Usage = D3D11_USAGE_DYNAMIC;
    desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
    desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
@@ -1117,13 +1147,14 @@ GFXD3D11VertexBuffer * GFXD3D11Device::createVBPool( const GFXVertexFormat *vert
    newBuff->mBufferType = GFXBufferTypeVolatile;
    newBuff->mVertexFormat.copy( *vertexFormat );
    newBuff->mVertexSize = vertSize;
+   newBuff->mPoolVerts = getMax( U32(MAX_DYNAMIC_VERTS), U32(VolatileVBPoolBytes / vertSize) );
    newBuff->mDevice = this;
 
    // Requesting it will allocate it.
    vertexFormat->getDecl(); 
 
    D3D11_BUFFER_DESC desc;
-   desc.ByteWidth = vertSize * MAX_DYNAMIC_VERTS;
+   desc.ByteWidth = vertSize * newBuff->mPoolVerts;
    desc.Usage = D3D11_USAGE_DYNAMIC;
    desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
    desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
@@ -1830,6 +1861,13 @@ GFXOcclusionQuery* GFXD3D11Device::createOcclusionQuery()
    return query;
 }
 
+GFXTimerQuery* GFXD3D11Device::createTimerQuery()
+{
+   GFXTimerQuery *query = new GFXD3D11TimerQuery( this );
+   query->registerResourceWithDevice(this);
+   return query;
+}
+
 GFXCubemap * GFXD3D11Device::createCubemap()
 {
    GFXD3D11Cubemap* cube = new GFXD3D11Cubemap();
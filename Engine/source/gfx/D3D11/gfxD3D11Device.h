@@ -45,6 +45,7 @@
 
 class PlatformWindow;
 class GFXD3D11ShaderConstBuffer;
+class VideoFrameGrabberD3D11;
 class OculusVRHMDDevice;
 class D3D11OculusTexture;
 
@@ -97,6 +98,17 @@ protected:
    MatrixF mTempMatrix;    ///< Temporary matrix, no assurances on value at all
    RectI mClipRect;
 
+   enum
+   {
+      /// Minimum size in bytes of the ring that the volatile vertex buffers
+      /// of one vertex format are appended to.  The rings are only discarded
+      /// when they wrap, so larger rings mean fewer buffer renames.
+      VolatileVBPoolBytes = 1024 * 1024,
+
+      /// Number of indices in the ring volatile primitive buffers are appended to.
+      VolatilePBPoolIndices = MAX_DYNAMIC_INDICES * 8,
+   };
+
    typedef StrongRefPtr<GFXD3D11VertexBuffer> RPGDVB;
    Vector<RPGDVB> mVolatileVBList;
 
@@ -134,6 +146,8 @@ protected:
    ID3D11DeviceContext1* mD3DDeviceContext1;
    ID3DUserDefinedAnnotation* mUserAnnotation;
 
+   VideoFrameGrabberD3D11* mVideoFrameGrabber;
+
    GFXShaderRef mGenericShader[GS_COUNT];
    GFXShaderConstBufferRef mGenericShaderBuffer[GS_COUNT];
    GFXShaderConstHandle *mModelViewProjSC[GS_COUNT];
@@ -312,6 +326,7 @@ public:
    GFXFence *createFence();
 
    GFXOcclusionQuery* createOcclusionQuery();   
+   GFXTimerQuery* createTimerQuery();
 
    // Default multisample parameters
    DXGI_SAMPLE_DESC getMultisampleType() const { return mMultisampleDesc; }
@@ -35,6 +35,7 @@ void GFXD3D11PrimitiveBuffer::lock(U32 indexStart, U32 indexEnd, void **indexPtr
 	AssertFatal(!mLocked, "GFXD3D11PrimitiveBuffer::lock - Can't lock a primitive buffer more than once!");
 
 	mLocked = true;
+	mDevice->getDeviceStatistics()->mBufferLocks++;
 	D3D11_MAP flags = D3D11_MAP_WRITE_DISCARD;
 
 	switch(mBufferType)
@@ -56,7 +57,7 @@ void GFXD3D11PrimitiveBuffer::lock(U32 indexStart, U32 indexEnd, void **indexPtr
 		AssertFatal( mVolatileBuffer, "GFXD3D11PrimitiveBuffer::lock - No dynamic primitive buffer was available!");
 
 		// We created the pool when we requested this volatile buffer, so assume it exists...
-		if(mVolatileBuffer->mIndexCount + indexEnd > MAX_DYNAMIC_INDICES) 
+		if(mVolatileBuffer->mIndexCount + indexEnd > GFXD3D11Device::VolatilePBPoolIndices) 
 		{
 			flags = D3D11_MAP_WRITE_DISCARD;
 			mVolatileStart = indexStart  = 0;
@@ -25,10 +25,55 @@
 #include "core/frameAllocator.h"
 #include "core/stream/fileStream.h"
 #include "core/util/safeDelete.h"
+#include "core/util/hashFunction.h"
 #include "console/console.h"
 
 extern bool gDisassembleAllShaders;
 
+/// Directory compiled shader bytecode is cached in.
+static const char *sgBinaryCachePath = "shadergen:/binaries/";
+
+/// Returns the cache file for the bytecode of @a preprocessed.
+///
+/// The key covers the fully preprocessed source, so changes to included
+/// files and macros hit a different entry, plus everything else the
+/// compiler output depends on.
+static String _getBinaryCacheFile( ID3DBlob *preprocessed, const String &target, U32 flags )
+{
+   U64 key = Torque::hash64( (const U8*)target.c_str(), target.length(), U64( flags ) ^ ( U64( D3D_COMPILER_VERSION ) << 32 ) );
+   key = Torque::hash64( (const U8*)preprocessed->GetBufferPointer(), preprocessed->GetBufferSize(), key );
+
+   return String::ToString( "%s%08x%08x.cso", sgBinaryCachePath, U32( key >> 32 ), U32( key ) );
+}
+
+/// Returns the cached bytecode in @a file or NULL if there is none.
+static ID3DBlob* _loadCachedBinary( const String &file )
+{
+   FileStream s;
+   if ( !Torque::FS::IsFile( file ) || !s.open( file, Torque::FS::File::Read ) )
+      return NULL;
+
+   const U32 size = s.getStreamSize();
+   ID3DBlob *code = NULL;
+   if ( !size || FAILED( D3DCreateBlob( size, &code ) ) )
+      return NULL;
+
+   if ( !s.read( size, code->GetBufferPointer() ) )
+   {
+      SAFE_RELEASE( code );
+      return NULL;
+   }
+
+   return code;
+}
+
+static void _saveCachedBinary( const String &file, ID3DBlob *code )
+{
+   FileStream s;
+   if ( s.open( file, Torque::FS::File::Write ) )
+      s.write( code->GetBufferSize(), code->GetBufferPointer() );
+}
+
 #pragma comment(lib, "d3dcompiler.lib")
 
 gfxD3DIncludeRef GFXD3D11Shader::smD3DInclude = NULL;
@@ -234,15 +279,14 @@ bool GFXD3D11ConstBufferLayout::setMatrix(const ParamDesc& pd, const GFXShaderCo
       const U8* endData = currSourcePointer + size;
       while (currSourcePointer < endData)
       {
+         // Unchanged rows stay clean.  Skinned meshes set their whole bone
+         // palette every draw, but it mostly matches what the buffer already
+         // holds (later passes or other primitives of the same mesh).
          if (dMemcmp(currDestPointer, currSourcePointer, csize) != 0)
          {
             dMemcpy(currDestPointer, currSourcePointer, csize);            
             ret = true;
          }
-         else if (pd.constType == GFXSCT_Float4x3)
-         {
-            ret = true;
-         }
 
          currDestPointer += csize;
          currSourcePointer += sizeof(MatrixF);
@@ -527,28 +571,29 @@ void GFXD3D11ShaderConstBuffer::set(GFXShaderConstHandle* handle, const MatrixF*
    AssertFatal(!h->isSampler(), "Handle is sampler constant!" );
    AssertFatal(h->mShader == mShader, "Mismatched shaders!"); 
 
-   static Vector<MatrixF> transposed;
-   if (arraySize > transposed.size())
-      transposed.setSize(arraySize);
+   // TODO: Maybe support this in the future?
+   if (h->mInstancingConstant) 
+      return;
 
-   if (matrixType == GFXSCT_Float4x3)
-   {
-      dMemcpy(transposed.address(), mat, arraySize * sizeof(MatrixF));
-   }
-   else
+   // 4x3 arrays (bone palettes) go in as they are, only
+   // the others need to be transposed first.
+   const MatrixF *data = mat;
+   static Vector<MatrixF> transposed;
+   if (matrixType != GFXSCT_Float4x3)
    {
+      if (arraySize > transposed.size())
+         transposed.setSize(arraySize);
+
       for (U32 i = 0; i < arraySize; i++)
          mat[i].transposeTo(transposed[i]);
-   }
 
-   // TODO: Maybe support this in the future?
-   if (h->mInstancingConstant) 
-      return;
+      data = transposed.address();
+   }
 
    if (h->mVertexConstant) 
-      mVertexConstBuffer->set(h->mVertexHandle, transposed.begin(), arraySize, matrixType);
+      mVertexConstBuffer->set(h->mVertexHandle, data, arraySize, matrixType);
    if (h->mPixelConstant) 
-      mPixelConstBuffer->set(h->mPixelHandle, transposed.begin(), arraySize, matrixType);
+      mPixelConstBuffer->set(h->mPixelHandle, data, arraySize, matrixType);
 }
 
 const String GFXD3D11ShaderConstBuffer::describeSelf() const
@@ -593,80 +638,32 @@ void GFXD3D11ShaderConstBuffer::activate( GFXD3D11ShaderConstBuffer *prevShaderB
    // Alot of the calls here are inlined... be careful 
    // what you change.
 
-   // If the buffer has changed we need to compare it
-   // with the new buffer to see if we can skip copying
-   // equal buffer content.
+   // Each buffer uploads into its own D3D constant buffers, which keep
+   // what was last uploaded from it.  So only the changes since then have
+   // to be copied, even if another buffer was active in between; switching
+   // buffers only needs them to be bound again.
    //
-   // If the buffer hasn't changed then we only will
-   // be copying the changes that have occured since
-   // the last activate call.
-   if ( prevShaderBuffer != this )
+   // Buffers that were just created have no content yet.
+   if ( mWasLost )
    {
-      // If the previous buffer is dirty, than we can't compare 
-      // against it, because it hasn't sent its contents to the
-      // card yet and must be copied.
-      if ( prevShaderBuffer && !prevShaderBuffer->isDirty() )
-      {
-         PROFILE_SCOPE(GFXD3D11ShaderConstBuffer_activate_dirty_check_1);
-         // If the buffer content is equal then we set the dirty
-         // flag to false knowing the current state of the card matches
-         // the new buffer.
-         //
-         // If the content is not equal we set the dirty flag to
-         // true which causes the full content of the buffer to be
-         // copied to the card.
-         //
-         mVertexConstBuffer->setDirty( !prevShaderBuffer->mVertexConstBuffer->isEqual( mVertexConstBuffer ) );
-         mPixelConstBuffer->setDirty( !prevShaderBuffer->mPixelConstBuffer->isEqual( mPixelConstBuffer ) ); 
-      } 
-      else
-      {
-         // This happens rarely... but it can happen.
-         // We copy the entire dirty state to the card.
-         PROFILE_SCOPE(GFXD3D11ShaderConstBuffer_activate_dirty_check_2);
-
-         mVertexConstBuffer->setDirty( true );
-         mPixelConstBuffer->setDirty( true );
-      }      
+      mVertexConstBuffer->setDirty( true );
+      mPixelConstBuffer->setDirty( true );
    }
 
-   D3D11_MAPPED_SUBRESOURCE pConstData;
-   ZeroMemory(&pConstData, sizeof(D3D11_MAPPED_SUBRESOURCE));
-   
-   const U8* buf;
-   U32 nbBuffers = 0;
-   if(mVertexConstBuffer->isDirty())
-   {
-      const Vector<ConstSubBufferDesc> &subBuffers = mVertexConstBufferLayout->getSubBufferDesc();
-      // TODO: This is not very effecient updating the whole lot, re-implement the dirty system to work with multiple constant buffers.
-      // TODO: Implement DX 11.1 UpdateSubresource1 which supports updating ranges with constant buffers
-      buf = mVertexConstBuffer->getEntireBuffer();
-      for (U32 i = 0; i < subBuffers.size(); ++i)
-      {
-         const ConstSubBufferDesc &desc = subBuffers[i];
-         mDeviceContext->UpdateSubresource(mConstantBuffersV[i], 0, NULL, buf + desc.start, desc.size, 0);
-         nbBuffers++;
-      }
+   const bool bind = mWasLost || prevShaderBuffer != this;
 
-      mDeviceContext->VSSetConstantBuffers(0, nbBuffers, mConstantBuffersV);
+   if ( mVertexConstBuffer->isDirty() || bind )
+   {
+      const U32 nbBuffers = _updateBuffers( mVertexConstBuffer, mVertexConstBufferLayout, mConstantBuffersV );
+      if ( bind )
+         mDeviceContext->VSSetConstantBuffers(0, nbBuffers, mConstantBuffersV);
    }
 
-   nbBuffers = 0;
-
-   if(mPixelConstBuffer->isDirty())    
+   if ( mPixelConstBuffer->isDirty() || bind )
    {
-      const Vector<ConstSubBufferDesc> &subBuffers = mPixelConstBufferLayout->getSubBufferDesc();
-      // TODO: This is not very effecient updating the whole lot, re-implement the dirty system to work with multiple constant buffers.
-      // TODO: Implement DX 11.1 UpdateSubresource1 which supports updating ranges with constant buffers
-      buf = mPixelConstBuffer->getEntireBuffer();
-      for (U32 i = 0; i < subBuffers.size(); ++i)
-      {
-         const ConstSubBufferDesc &desc = subBuffers[i];
-         mDeviceContext->UpdateSubresource(mConstantBuffersP[i], 0, NULL, buf + desc.start, desc.size, 0);
-         nbBuffers++;
-      }
-
-      mDeviceContext->PSSetConstantBuffers(0, nbBuffers, mConstantBuffersP);
+      const U32 nbBuffers = _updateBuffers( mPixelConstBuffer, mPixelConstBufferLayout, mConstantBuffersP );
+      if ( bind )
+         mDeviceContext->PSSetConstantBuffers(0, nbBuffers, mConstantBuffersP);
    }
 
    #ifdef TORQUE_DEBUG
@@ -682,6 +679,31 @@ void GFXD3D11ShaderConstBuffer::activate( GFXD3D11ShaderConstBuffer *prevShaderB
    mWasLost = false;
 }
 
+U32 GFXD3D11ShaderConstBuffer::_updateBuffers( GenericConstBuffer *constBuffer, GFXD3D11ConstBufferLayout *layout, ID3D11Buffer **d3dBuffers )
+{
+   const Vector<ConstSubBufferDesc> &subBuffers = layout->getSubBufferDesc();
+   if ( !constBuffer->isDirty() )
+      return subBuffers.size();
+
+   U32 dirtyStart, dirtySize;
+   constBuffer->getDirtyBuffer( &dirtyStart, &dirtySize );
+   const U32 dirtyEnd = dirtyStart + dirtySize;
+
+   // TODO: Implement DX 11.1 UpdateSubresource1 which supports updating ranges with constant buffers
+   const U8 *buf = constBuffer->getEntireBuffer();
+   for (U32 i = 0; i < subBuffers.size(); ++i)
+   {
+      const ConstSubBufferDesc &desc = subBuffers[i];
+      if ( desc.start >= dirtyEnd || desc.start + desc.size <= dirtyStart )
+         continue;
+
+      mDeviceContext->UpdateSubresource(d3dBuffers[i], 0, NULL, buf + desc.start, desc.size, 0);
+      GFX->getDeviceStatistics()->mShaderConstUploads++;
+   }
+
+   return subBuffers.size();
+}
+
 void GFXD3D11ShaderConstBuffer::onShaderReload( GFXD3D11Shader *shader )
 {
    AssertFatal( shader == mShader, "GFXD3D11ShaderConstBuffer::onShaderReload is hosed!" );
@@ -896,8 +918,33 @@ bool GFXD3D11Shader::_compileShader( const Torque::Path &filePath,
       s.read(bufSize, buffer);
       buffer[bufSize] = 0;
 
-      res = D3DCompile(buffer, bufSize, realPath.getFullPath().c_str(), defines, smD3DInclude, "main", target, flags, 0, &code, &errorBuff);
-      
+      // Look up the bytecode in the binary cache first.  Preprocessing is
+      // cheap compared to compiling and tells us what would be compiled.
+      String cacheFile;
+      if ( Con::getBoolVariable( "$pref::Shaders::useBinaryCache", true ) )
+      {
+         PROFILE_SCOPE( GFXD3D11Shader_BinaryCacheLookup );
+
+         ID3DBlob *preprocessed = NULL;
+         if ( SUCCEEDED( D3DPreprocess( buffer, bufSize, realPath.getFullPath().c_str(), defines, smD3DInclude, &preprocessed, NULL ) ) )
+         {
+            cacheFile = _getBinaryCacheFile( preprocessed, target, flags );
+            code = _loadCachedBinary( cacheFile );
+            if ( code )
+               res = S_OK;
+         }
+
+         SAFE_RELEASE( preprocessed );
+         smD3DInclude->setPath(filePath.getRootAndPath());
+      }
+
+      if ( !code )
+      {
+         res = D3DCompile(buffer, bufSize, realPath.getFullPath().c_str(), defines, smD3DInclude, "main", target, flags, 0, &code, &errorBuff);
+
+         if ( SUCCEEDED( res ) && code && cacheFile.isNotEmpty() )
+            _saveCachedBinary( cacheFile, code );
+      }
    }
 
    // Is it a precompiled obj shader?
@@ -351,6 +351,11 @@ protected:
 
    void _createBuffers();
 
+   /// Uploads the sub buffers of @a constBuffer that overlap its dirty
+   /// range to @a d3dBuffers and clears the dirty state.
+   /// @return The number of sub buffers in @a layout.
+   U32 _updateBuffers( GenericConstBuffer *constBuffer, GFXD3D11ConstBufferLayout *layout, ID3D11Buffer **d3dBuffers );
+
    template<class T>
    inline void SET_CONSTANT(GFXShaderConstHandle* handle,
       const T& fv,
@@ -232,7 +232,9 @@ void GFXD3D11StateBlock::activate(GFXD3D11StateBlock* oldState)
       D3D11DEVICECONTEXT->OMSetBlendState(mBlendState, blendFactor, 0xFFFFFFFF);
    }
 
-   if (!oldState || (mDepthStencilState != oldState->mDepthStencilState))
+   // D3D11 hands back the same object for equal descs, so a different
+   // stencil ref alone still has to be set.
+   if (!oldState || (mDepthStencilState != oldState->mDepthStencilState) || (mDesc.stencilRef != oldState->mDesc.stencilRef))
       D3D11DEVICECONTEXT->OMSetDepthStencilState(mDepthStencilState, mDesc.stencilRef);
 
    if (!oldState || (mRasterizerState != oldState->mRasterizerState))
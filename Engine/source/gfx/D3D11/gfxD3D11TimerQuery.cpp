@@ -0,0 +1,152 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "gfx/D3D11/gfxD3D11Device.h"
+#include "gfx/D3D11/gfxD3D11TimerQuery.h"
+
+GFXD3D11TimerQuery::GFXD3D11TimerQuery(GFXDevice *device)
+ : GFXTimerQuery(device),
+   mDisjointQuery(NULL),
+   mStartQuery(NULL),
+   mEndQuery(NULL),
+   mIssued(false)
+{
+}
+
+GFXD3D11TimerQuery::~GFXD3D11TimerQuery()
+{
+   _releaseQueries();
+}
+
+bool GFXD3D11TimerQuery::_createQueries()
+{
+   if (mDisjointQuery)
+      return true;
+
+   D3D11_QUERY_DESC queryDesc;
+   queryDesc.MiscFlags = 0;
+
+   queryDesc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+   HRESULT hRes = D3D11DEVICE->CreateQuery(&queryDesc, &mDisjointQuery);
+   AssertISV(hRes != E_OUTOFMEMORY, "GFXD3D11TimerQuery::_createQueries - Out of memory");
+
+   queryDesc.Query = D3D11_QUERY_TIMESTAMP;
+   if (SUCCEEDED(hRes))
+      hRes = D3D11DEVICE->CreateQuery(&queryDesc, &mStartQuery);
+   if (SUCCEEDED(hRes))
+      hRes = D3D11DEVICE->CreateQuery(&queryDesc, &mEndQuery);
+
+   if (FAILED(hRes))
+   {
+      _releaseQueries();
+      return false;
+   }
+
+   return true;
+}
+
+void GFXD3D11TimerQuery::_releaseQueries()
+{
+   SAFE_RELEASE(mDisjointQuery);
+   SAFE_RELEASE(mStartQuery);
+   SAFE_RELEASE(mEndQuery);
+   mIssued = false;
+}
+
+void GFXD3D11TimerQuery::begin()
+{
+   if (!_createQueries())
+      return;
+
+   D3D11DEVICECONTEXT->Begin(mDisjointQuery);
+   D3D11DEVICECONTEXT->End(mStartQuery);
+}
+
+void GFXD3D11TimerQuery::end()
+{
+   if (!mDisjointQuery)
+      return;
+
+   D3D11DEVICECONTEXT->End(mEndQuery);
+   D3D11DEVICECONTEXT->End(mDisjointQuery);
+   mIssued = true;
+}
+
+GFXD3D11TimerQuery::TimerQueryStatus GFXD3D11TimerQuery::getStatus(bool block, U64 *outNanoseconds)
+{
+   PROFILE_SCOPE(GFXD3D11TimerQuery_getStatus);
+
+   if (!mDisjointQuery || !mIssued)
+      return Unset;
+
+   HRESULT hRes;
+   D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint;
+
+   if (block)
+   {
+      while ((hRes = D3D11DEVICECONTEXT->GetData(mDisjointQuery, &disjoint, sizeof(disjoint), 0)) == S_FALSE);
+   }
+   else
+   {
+      hRes = D3D11DEVICECONTEXT->GetData(mDisjointQuery, &disjoint, sizeof(disjoint), 0);
+   }
+
+   if (hRes == S_FALSE)
+      return Waiting;
+
+   mIssued = false;
+
+   if (hRes != S_OK)
+      return Error;
+
+   // The timestamps are junk if the clock changed in between.
+   if (disjoint.Disjoint || !disjoint.Frequency)
+      return Error;
+
+   // The disjoint query completes after the timestamps so these are ready.
+   U64 startTime = 0;
+   U64 endTime = 0;
+   if (D3D11DEVICECONTEXT->GetData(mStartQuery, &startTime, sizeof(U64), 0) != S_OK ||
+       D3D11DEVICECONTEXT->GetData(mEndQuery, &endTime, sizeof(U64), 0) != S_OK)
+      return Error;
+
+   if (outNanoseconds)
+      *outNanoseconds = U64(F64(endTime - startTime) * 1000000000.0 / F64(disjoint.Frequency));
+
+   return Ready;
+}
+
+void GFXD3D11TimerQuery::zombify()
+{
+   _releaseQueries();
+}
+
+void GFXD3D11TimerQuery::resurrect()
+{
+   // Created on next begin().
+}
+
+const String GFXD3D11TimerQuery::describeSelf() const
+{
+   // We've got nothing
+   return String();
+}
@@ -39,6 +39,8 @@ void GFXD3D11VertexBuffer::lock(U32 vertexStart, U32 vertexEnd, void **vertexPtr
 {
    PROFILE_SCOPE(GFXD3D11VertexBuffer_lock);
 
+   mDevice->getDeviceStatistics()->mBufferLocks++;
+
    AssertFatal(lockedVertexStart == 0 && lockedVertexEnd == 0, "Cannot lock a buffer more than once!");
 
    D3D11_MAP flags = D3D11_MAP_WRITE_DISCARD;
@@ -66,7 +68,7 @@ void GFXD3D11VertexBuffer::lock(U32 vertexStart, U32 vertexEnd, void **vertexPtr
       AssertFatal(mVolatileBuffer->lockedVertexStart == 0 && mVolatileBuffer->lockedVertexEnd == 0, "Got more than one lock on the volatile pool.");
 
       // We created the pool when we requested this volatile buffer, so assume it exists...
-      if( mVolatileBuffer->mNumVerts + vertexEnd > MAX_DYNAMIC_VERTS ) 
+      if( mVolatileBuffer->mNumVerts + vertexEnd > mVolatileBuffer->mPoolVerts ) 
       {
          flags = D3D11_MAP_WRITE_DISCARD;
          mVolatileStart = vertexStart  = 0;
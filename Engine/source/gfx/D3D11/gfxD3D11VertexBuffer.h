@@ -41,6 +41,9 @@ public:
    bool mIsFirstLock;
    bool mClearAtFrameEnd;
 
+   /// Number of vertices in the ring if this is a volatile vertex pool.
+   U32 mPoolVerts;
+
    GFXD3D11VertexBuffer();
    GFXD3D11VertexBuffer( GFXDevice *device, 
                         U32 numVerts, 
@@ -68,6 +71,7 @@ inline GFXD3D11VertexBuffer::GFXD3D11VertexBuffer() : GFXVertexBuffer(0,0,0,0,(G
    mIsFirstLock = true;
    lockedVertexEnd = lockedVertexStart = 0;
    mClearAtFrameEnd = false;
+   mPoolVerts = 0;
 
 #ifdef TORQUE_DEBUG
    mDebugGuardBuffer = NULL;
@@ -85,6 +89,7 @@ inline GFXD3D11VertexBuffer::GFXD3D11VertexBuffer(   GFXDevice *device,
    vb = NULL;
    mIsFirstLock = true;
    mClearAtFrameEnd = false;
+   mPoolVerts = 0;
    lockedVertexEnd = lockedVertexStart = 0;
    mLockedBuffer = NULL;
 #ifdef TORQUE_DEBUG
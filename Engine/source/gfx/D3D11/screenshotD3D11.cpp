@@ -42,8 +42,6 @@ GBitmap* ScreenShotD3D11::_captureBackBuffer()
 
    U32 width = desc.Width;
    U32 height = desc.Height;
-   // pixel data
-   U8 *pData = new U8[width * height * 4];
 
    D3D11DEVICECONTEXT->CopyResource(pNewTexture, backBuf);
    D3D11_MAPPED_SUBRESOURCE Resource;
@@ -52,43 +50,30 @@ GBitmap* ScreenShotD3D11::_captureBackBuffer()
    if (FAILED(hr))
    {
       //cleanup
-      SAFE_DELETE_ARRAY(pData);
       SAFE_RELEASE(pNewTexture);
       return NULL;
    }
 
-   const U32 pitch = width << 2;
-   const U8* pSource = (U8*)Resource.pData;
-   U32 totalPitch = 0;
-   for (U32 i = 0; i < height; ++i)
-   {
-      dMemcpy(pData, pSource, width * 4);
-      pSource += Resource.RowPitch;
-      pData += pitch;
-      totalPitch += pitch;
-   }
-
-   D3D11DEVICECONTEXT->Unmap(pNewTexture, 0);  
-   pData -= totalPitch;
    GBitmap *gb = new GBitmap(width, height);
 
-   //Set GBitmap data and convert from bgr to rgb
-   ColorI c;
-   for (S32 i = 0; i<height; i++)
+   //Copy straight out of the mapped texture and convert from bgr to rgb
+   U8 *pDest = gb->getWritableBits();
+   for (U32 i = 0; i < height; i++)
    {
-      const U8 *a = pData + i * width * 4;
-      for (S32 j = 0; j<width; j++)
+      const U8 *a = (const U8*)Resource.pData + i * Resource.RowPitch;
+      for (U32 j = 0; j < width; j++)
       {
-         c.blue = *(a++);
-         c.green = *(a++);
-         c.red = *(a++);
-         a++; // Ignore alpha.
-         gb->setColor(j, i, c);
+         pDest[0] = a[2];
+         pDest[1] = a[1];
+         pDest[2] = a[0];
+         pDest += 3;
+         a += 4; // Ignore alpha.
       }
    }
 
+   D3D11DEVICECONTEXT->Unmap(pNewTexture, 0);
+
    //cleanup
-   SAFE_DELETE_ARRAY(pData);
    SAFE_RELEASE(pNewTexture);
    
 
@@ -0,0 +1,215 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2016 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+#ifndef _SCREENSHOTD3D11_H_
+
+#include "platform/platform.h"
+#include "gfx/D3D11/videoFrameGrabberD3D11.h"
+#include "gfx/D3D11/gfxD3D11Device.h"
+#include "gfx/bitmap/gBitmap.h"
+
+VideoFrameGrabberD3D11::VideoFrameGrabberD3D11()
+   : mHead(0),
+     mCount(0),
+     mWidth(0),
+     mHeight(0),
+     mLastBitmap(NULL),
+     mLastBitmapUsed(false)
+{
+   for (U32 i = 0; i < RingSize; i++)
+   {
+      mRing[i].texture = NULL;
+      mRing[i].requested = 0;
+   }
+}
+
+VideoFrameGrabberD3D11::~VideoFrameGrabberD3D11()
+{
+   releaseTextures();
+
+   if (!mLastBitmapUsed)
+      delete mLastBitmap;
+}
+
+void VideoFrameGrabberD3D11::captureBackBuffer()
+{
+   ID3D11Texture2D* backBuf = D3D11->getBackBufferTexture();
+   D3D11_TEXTURE2D_DESC desc;
+   backBuf->GetDesc(&desc);
+
+   // (Re)create the ring to match the back buffer.
+   if (desc.Width != mWidth || desc.Height != mHeight)
+   {
+      releaseTextures();
+
+      desc.BindFlags = 0;
+      desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+      desc.Usage = D3D11_USAGE_STAGING;
+      desc.MiscFlags = 0;
+
+      for (U32 i = 0; i < RingSize; i++)
+      {
+         HRESULT hr = D3D11DEVICE->CreateTexture2D(&desc, NULL, &mRing[i].texture);
+         if (FAILED(hr))
+         {
+            releaseTextures();
+            return;
+         }
+      }
+
+      mWidth = desc.Width;
+      mHeight = desc.Height;
+   }
+
+   U32 slot;
+   const U32 latest = (mHead + mCount - 1) % RingSize;
+   if (mCount && mRing[latest].requested == 0)
+   {
+      // Nobody asked for a bitmap of the last capture, replace it.
+      slot = latest;
+   }
+   else
+   {
+      // Only stall when the GPU is a whole ring behind.
+      if (mCount == RingSize)
+         _readback(true);
+
+      slot = (mHead + mCount) % RingSize;
+      mCount++;
+   }
+
+   mRing[slot].requested = 0;
+   D3D11DEVICECONTEXT->CopyResource(mRing[slot].texture, backBuf);
+}
+
+void VideoFrameGrabberD3D11::makeBitmap()
+{
+   if (mCount)
+   {
+      mRing[(mHead + mCount - 1) % RingSize].requested++;
+   }
+   else if (mLastBitmap)
+   {
+      pushNewBitmap(mLastBitmap);
+      mLastBitmapUsed = true;
+   }
+}
+
+void VideoFrameGrabberD3D11::poll(bool wait)
+{
+   while (mCount)
+   {
+      // Only the latest capture can be without requests.  Keep it
+      // around in case one comes in, unless we are flushing.
+      if (mRing[mHead].requested == 0)
+      {
+         if (!wait)
+            break;
+
+         mHead = (mHead + 1) % RingSize;
+         mCount--;
+         continue;
+      }
+
+      if (!_readback(wait))
+         break;
+   }
+}
+
+bool VideoFrameGrabberD3D11::_readback(bool wait)
+{
+   Readback& readback = mRing[mHead];
+
+   D3D11_MAPPED_SUBRESOURCE resource;
+   HRESULT hr = D3D11DEVICECONTEXT->Map(readback.texture, 0, D3D11_MAP_READ, wait ? 0 : D3D11_MAP_FLAG_DO_NOT_WAIT, &resource);
+   if (hr == DXGI_ERROR_WAS_STILL_DRAWING)
+      return false;
+
+   if (SUCCEEDED(hr))
+   {
+      GBitmap* bitmap = _makeBitmap((const U8*)resource.pData, resource.RowPitch);
+      D3D11DEVICECONTEXT->Unmap(readback.texture, 0);
+
+      if (!mLastBitmapUsed)
+         delete mLastBitmap;
+
+      mLastBitmap = bitmap;
+      mLastBitmapUsed = readback.requested > 0;
+
+      // Repeated frames share the bitmap.
+      for (U32 i = 0; i < readback.requested; i++)
+         pushNewBitmap(bitmap);
+   }
+
+   readback.requested = 0;
+   mHead = (mHead + 1) % RingSize;
+   mCount--;
+   return true;
+}
+
+GBitmap* VideoFrameGrabberD3D11::_makeBitmap(const U8* data, U32 pitch)
+{
+   const U32 width = mResolution.x;
+   const U32 height = mResolution.y;
+
+   GBitmap* bitmap = new GBitmap(width, height);
+   U8* dst = bitmap->getWritableBits();
+
+   // Point sample the back buffer if it doesn't match the output
+   // resolution and swizzle BGRA to RGB on the way.
+   Vector<U32> srcOffsets(width);
+   srcOffsets.setSize(width);
+   for (U32 x = 0; x < width; x++)
+      srcOffsets[x] = ((x * mWidth) / width) * 4;
+
+   for (U32 y = 0; y < height; y++)
+   {
+      const U8* srcRow = data + ((y * mHeight) / height) * pitch;
+      for (U32 x = 0; x < width; x++)
+      {
+         const U8* src = srcRow + srcOffsets[x];
+         dst[0] = src[2];
+         dst[1] = src[1];
+         dst[2] = src[0];
+         dst += 3;
+      }
+   }
+
+   return bitmap;
+}
+
+void VideoFrameGrabberD3D11::releaseTextures()
+{
+   // Read back what was asked for before the textures go away.
+   if (mRing[0].texture)
+      poll(true);
+
+   for (U32 i = 0; i < RingSize; i++)
+   {
+      SAFE_RELEASE(mRing[i].texture);
+      mRing[i].requested = 0;
+   }
+
+   mHead = 0;
+   mCount = 0;
+   mWidth = 0;
+   mHeight = 0;
+}
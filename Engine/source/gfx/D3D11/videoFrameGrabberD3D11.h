@@ -0,0 +1,94 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2016 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+#ifndef _SCREENSHOTD3D11_H_
+#ifndef _VIDEOFRAMEGRABBERD3D11_H_
+#define _VIDEOFRAMEGRABBERD3D11_H_
+
+#ifndef _VIDEOCAPTURE_H_
+#include "gfx/video/videoCapture.h"
+#endif
+
+struct ID3D11Texture2D;
+
+/// Grabs video frames from the D3D11 back buffer without stalling the GPU.
+///
+/// Each captured frame is copied into one of a ring of staging textures.
+/// The copies are only mapped once the GPU has finished them, which is
+/// usually a frame or two later, so the CPU never waits on the GPU unless
+/// it gets a whole ring ahead.
+class VideoFrameGrabberD3D11 : public VideoFrameGrabber
+{
+public:
+   enum
+   {
+      /// Number of captures that can be in flight on the GPU.
+      RingSize = 3,
+   };
+
+protected:
+   struct Readback
+   {
+      ID3D11Texture2D* texture;
+
+      /// Number of bitmaps requested from this capture.
+      U32 requested;
+   };
+
+   Readback mRing[RingSize];
+
+   /// Oldest capture still in flight.
+   U32 mHead;
+
+   /// Number of captures in flight.
+   U32 mCount;
+
+   /// Size of the staging textures.
+   U32 mWidth;
+   U32 mHeight;
+
+   /// Bitmap of the last capture that was read back.  Repeated frames
+   /// after the ring drained reuse it.
+   GBitmap* mLastBitmap;
+
+   /// True if mLastBitmap was handed out and is now owned by VideoCapture.
+   bool mLastBitmapUsed;
+
+   /// Read back the oldest capture in flight.
+   /// @param wait If false, give up if the GPU hasn't finished the copy yet.
+   /// @return True if the capture was read back.
+   bool _readback( bool wait );
+
+   /// Convert the mapped BGRA back buffer copy to an RGB bitmap of our
+   /// output resolution.
+   GBitmap* _makeBitmap( const U8* data, U32 pitch );
+
+   virtual void captureBackBuffer();
+   virtual void makeBitmap();
+   virtual void poll( bool wait );
+   virtual void releaseTextures();
+
+public:
+   VideoFrameGrabberD3D11();
+   ~VideoFrameGrabberD3D11();
+};
+
+#endif // _VIDEOFRAMEGRABBERD3D11_H_
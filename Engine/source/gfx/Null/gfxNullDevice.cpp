@@ -110,8 +110,10 @@ protected:
             retTex->registerResourceWithDevice( GFX );
          }
 
+         // There is no surface to back, so don't allocate any memory for
+         // the texels.  Profiles that keep their bitmap still get a copy
+         // of the source in GFXTextureManager::_createTexture().
          SAFE_DELETE( retTex->mBitmap );
-         retTex->mBitmap = new GBitmap(width, height);
          return retTex;
       };
 
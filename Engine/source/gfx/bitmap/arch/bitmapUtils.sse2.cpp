@@ -0,0 +1,103 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "gfx/bitmap/bitmapUtils.h"
+
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+#include "gfx/bitmap/arch/bitmapUtils.arch.h"
+#include <emmintrin.h>
+
+void bitmapExtrudeRGBA_SSE2(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
+{
+   // A single column is not worth the setup.
+   if (srcWidth == 1)
+   {
+      bitmapExtrudeRGBA_c(srcMip, mip, srcHeight, srcWidth);
+      return;
+   }
+
+   const U8 *src = (const U8 *) srcMip;
+   U8 *dst = (U8 *) mip;
+   U32 stride = srcHeight != 1 ? (srcWidth) * 4 : 0;
+
+   U32 width  = srcWidth  >> 1;
+   U32 height = srcHeight >> 1;
+   if (height == 0) height = 1;
+
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i round = _mm_set1_epi16(2);
+
+   for(U32 y = 0; y < height; y++)
+   {
+      const U8 *row0 = src;
+      const U8 *row1 = src + stride;
+
+      // Four destination pixels from eight source pixels of both rows.
+      U32 x = 0;
+      for(; x + 4 <= width; x += 4)
+      {
+         const __m128i a0 = _mm_loadu_si128((const __m128i *) row0);
+         const __m128i a1 = _mm_loadu_si128((const __m128i *) (row0 + 16));
+         const __m128i b0 = _mm_loadu_si128((const __m128i *) row1);
+         const __m128i b1 = _mm_loadu_si128((const __m128i *) (row1 + 16));
+
+         // Sum the rows, two pixels per register.
+         const __m128i s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+         const __m128i s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+         const __m128i s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+         const __m128i s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+         // Add the neighbouring pixels; the low halves hold the results.
+         const __m128i h0 = _mm_add_epi16(s0, _mm_srli_si128(s0, 8));
+         const __m128i h1 = _mm_add_epi16(s1, _mm_srli_si128(s1, 8));
+         const __m128i h2 = _mm_add_epi16(s2, _mm_srli_si128(s2, 8));
+         const __m128i h3 = _mm_add_epi16(s3, _mm_srli_si128(s3, 8));
+
+         __m128i lo = _mm_unpacklo_epi64(h0, h1);
+         __m128i hi = _mm_unpacklo_epi64(h2, h3);
+         lo = _mm_srli_epi16(_mm_add_epi16(lo, round), 2);
+         hi = _mm_srli_epi16(_mm_add_epi16(hi, round), 2);
+
+         _mm_storeu_si128((__m128i *) dst, _mm_packus_epi16(lo, hi));
+
+         row0 += 32;
+         row1 += 32;
+         dst += 16;
+      }
+
+      for(; x < width; x++)
+      {
+         for(U32 c = 0; c < 4; c++)
+            *dst++ = (U32(row0[c]) + U32(row0[c+4]) + U32(row1[c]) + U32(row1[c+4]) + 2) >> 2;
+
+         row0 += 8;
+         row1 += 8;
+      }
+
+      src += stride + width * 8;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+#endif // TORQUE_CPU_X86
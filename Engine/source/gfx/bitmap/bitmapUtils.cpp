@@ -23,6 +23,9 @@
 #include "gfx/bitmap/bitmapUtils.h"
 
 #include "platform/platform.h"
+#include "gfx/bitmap/arch/bitmapUtils.arch.h"
+#include "core/module.h"
+#include "math/mMathFn.h"
 
 
 void bitmapExtrude5551_c(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
@@ -174,9 +177,96 @@ void bitmapExtrudeRGBA_c(const void *srcMip, void *mip, U32 srcHeight, U32 srcWi
    }
 }
 
+//--------------------------------------------------------------------------
+// sRGB encoded images have to be averaged in linear space or the mips come
+// out too dark.  The channels are decoded to 16 bit linear values through a
+// table and the averages are encoded again through a table indexed by the
+// top 12 bits.  Alpha stays linear.
+
+namespace
+{
+   struct SRGBTables
+   {
+      U16 toLinear[ 256 ];
+      U8 fromLinear[ 4096 ];
+
+      SRGBTables()
+      {
+         for ( U32 i = 0; i < 256; i++ )
+         {
+            const F32 c = F32( i ) / 255.0f;
+            const F32 l = c <= 0.04045f ? c / 12.92f : mPow( ( c + 0.055f ) / 1.055f, 2.4f );
+            toLinear[ i ] = U16( mClampF( l, 0.0f, 1.0f ) * 65535.0f + 0.5f );
+         }
+
+         for ( U32 i = 0; i < 4096; i++ )
+         {
+            const F32 l = ( F32( i ) + 0.5f ) / 4096.0f;
+            const F32 c = l <= 0.0031308f ? l * 12.92f : 1.055f * mPow( l, 1.0f / 2.4f ) - 0.055f;
+            fromLinear[ i ] = U8( mClampF( c, 0.0f, 1.0f ) * 255.0f + 0.5f );
+         }
+      }
+   };
+
+   const SRGBTables &getSRGBTables()
+   {
+      static SRGBTables sTables;
+      return sTables;
+   }
+
+   template< U32 bpp, U32 colorChannels >
+   void bitmapExtrudeSRGB( const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth )
+   {
+      const SRGBTables &tables = getSRGBTables();
+
+      const U8 *src = (const U8 *) srcMip;
+      U8 *dst = (U8 *) mip;
+      U32 stride = srcHeight != 1 ? srcWidth * bpp : 0;
+
+      // Step to the next pixel on the row, or stay put on single columns.
+      const U32 next = srcWidth != 1 ? bpp : 0;
+
+      U32 width  = srcWidth  >> 1;
+      U32 height = srcHeight >> 1;
+      if (width  == 0) width  = 1;
+      if (height == 0) height = 1;
+
+      for(U32 y = 0; y < height; y++)
+      {
+         for(U32 x = 0; x < width; x++)
+         {
+            for(U32 c = 0; c < colorChannels; c++)
+            {
+               const U32 sum = U32( tables.toLinear[ src[c] ] ) + tables.toLinear[ src[c+next] ] +
+                               tables.toLinear[ src[c+stride] ] + tables.toLinear[ src[c+stride+next] ];
+               *dst++ = tables.fromLinear[ ( ( sum + 2 ) >> 2 ) >> 4 ];
+            }
+
+            for(U32 c = colorChannels; c < bpp; c++)
+               *dst++ = (U32(src[c]) + U32(src[c+next]) + U32(src[c+stride]) + U32(src[c+stride+next]) + 2) >> 2;
+
+            src += srcWidth != 1 ? bpp * 2 : bpp;
+         }
+         src += stride;   // skip
+      }
+   }
+}
+
+void bitmapExtrudeRGB_sRGB_c(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
+{
+   bitmapExtrudeSRGB< 3, 3 >( srcMip, mip, srcHeight, srcWidth );
+}
+
+void bitmapExtrudeRGBA_sRGB_c(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
+{
+   bitmapExtrudeSRGB< 4, 3 >( srcMip, mip, srcHeight, srcWidth );
+}
+
 void (*bitmapExtrude5551)(const void *srcMip, void *mip, U32 height, U32 width) = bitmapExtrude5551_c;
 void (*bitmapExtrudeRGB)(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth) = bitmapExtrudeRGB_c;
 void (*bitmapExtrudeRGBA)(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth) = bitmapExtrudeRGBA_c;
+void (*bitmapExtrudeRGB_sRGB)(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth) = bitmapExtrudeRGB_sRGB_c;
+void (*bitmapExtrudeRGBA_sRGB)(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth) = bitmapExtrudeRGBA_sRGB_c;
 
 
 //--------------------------------------------------------------------------
@@ -231,11 +321,16 @@ void bitmapConvertRGB_to_RGBX_c( U8 **src, U32 pixels )
 {
    const U8 *oldBits = *src;
    U8 *newBits = new U8[pixels * 4];
-   dMemset( newBits, 0xFF, pixels * 4 ); // This is done to set alpha values -patw
 
-   // Copy the bits over to the new memory
+   // Copy the bits over to the new memory and set the alpha values.  Plain
+   // byte copies rather than a dMemcpy per pixel so this can vectorize.
    for( U32 i = 0; i < pixels; i++ )
-      dMemcpy( &newBits[i * 4], &oldBits[i * 3], sizeof(U8) * 3 );
+   {
+      newBits[i * 4 + 0] = oldBits[i * 3 + 0];
+      newBits[i * 4 + 1] = oldBits[i * 3 + 1];
+      newBits[i * 4 + 2] = oldBits[i * 3 + 2];
+      newBits[i * 4 + 3] = 0xFF;
+   }
 
    // Now hose the old bits
    delete [] *src;
@@ -253,7 +348,11 @@ void bitmapConvertRGBX_to_RGB_c( U8 **src, U32 pixels )
 
    // Copy the bits over to the new memory
    for( U32 i = 0; i < pixels; i++ )
-      dMemcpy( &newBits[i * 3], &oldBits[i * 4], sizeof(U8) * 3 );
+   {
+      newBits[i * 3 + 0] = oldBits[i * 4 + 0];
+      newBits[i * 3 + 1] = oldBits[i * 4 + 1];
+      newBits[i * 3 + 2] = oldBits[i * 4 + 2];
+   }
 
    // Now hose the old bits
    delete [] *src;
@@ -269,12 +368,14 @@ void bitmapConvertA8_to_RGBA_c( U8 **src, U32 pixels )
    const U8 *oldBits = *src;
    U8 *newBits = new U8[pixels * 4];
 
-   // Zero new bits
-   dMemset( newBits, 0, pixels * 4 );
-
-   // Copy Alpha values
+   // Copy Alpha values and zero the colors
    for( U32 i = 0; i < pixels; i++ )      
+   {
+      newBits[i * 4 + 0] = 0;
+      newBits[i * 4 + 1] = 0;
+      newBits[i * 4 + 2] = 0;
       newBits[i * 4 + 3] = oldBits[i];
+   }
 
    // Now hose the old bits
    delete [] *src;
@@ -282,3 +383,22 @@ void bitmapConvertA8_to_RGBA_c( U8 **src, U32 pixels )
 }
 
 void (*bitmapConvertA8_to_RGBA)( U8 **src, U32 pixels ) = bitmapConvertA8_to_RGBA_c;
+
+//------------------------------------------------------------------------------
+// Initializer.
+//------------------------------------------------------------------------------
+
+MODULE_BEGIN( BitmapUtils )
+
+   MODULE_INIT
+   {
+      // Find the best implementation for the current CPU
+      if(Platform::SystemInfo.processor.properties & CPU_PROP_SSE2)
+      {
+         #if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 )) 
+            bitmapExtrudeRGBA = bitmapExtrudeRGBA_SSE2;
+         #endif
+      }
+   }
+
+MODULE_END;
@@ -30,6 +30,12 @@
 extern void (*bitmapExtrude5551)(const void *srcMip, void *mip, U32 height, U32 width);
 extern void (*bitmapExtrudeRGB)(const void *srcMip, void *mip, U32 height, U32 width);
 extern void (*bitmapExtrudeRGBA)(const void *srcMip, void *mip, U32 height, U32 width);
+
+/// Versions of bitmapExtrudeRGB and bitmapExtrudeRGBA for sRGB encoded
+/// images that average the colors in linear space.
+extern void (*bitmapExtrudeRGB_sRGB)(const void *srcMip, void *mip, U32 height, U32 width);
+extern void (*bitmapExtrudeRGBA_sRGB)(const void *srcMip, void *mip, U32 height, U32 width);
+
 extern void (*bitmapConvertRGB_to_5551)(U8 *src, U32 pixels);
 extern void (*bitmapConvertRGB_to_1555)(U8 *src, U32 pixels);
 extern void (*bitmapConvertRGB_to_RGBX)( U8 **src, U32 pixels );
@@ -37,5 +43,6 @@ extern void (*bitmapConvertRGBX_to_RGB)( U8 **src, U32 pixels );
 extern void (*bitmapConvertA8_to_RGBA)( U8 **src, U32 pixels );
 
 void bitmapExtrudeRGB_c(const void *srcMip, void *mip, U32 height, U32 width);
+void bitmapExtrudeRGBA_c(const void *srcMip, void *mip, U32 height, U32 width);
 
 #endif //_BITMAPUTILS_H_
@@ -30,13 +30,19 @@
 #include "console/console.h"
 #include "core/resourceManager.h"
 #include "core/stream/fileStream.h"
+#include "core/stream/memStream.h"
+#include "core/util/safeDelete.h"
 #include "gfx/bitmap/gBitmap.h"
 #include "console/engineAPI.h"
+#include "platform/platformMemory.h"
 
 #include <squish.h>
 
 S32 DDSFile::smActiveCopies = 0;
 U32 DDSFile::smDropMipCount = 0;
+bool DDSFile::smMapFiles = true;
+
+static const U32 sCookedMagic = MakeFourCC( 'T', '3', 'D', 'C' );
 
 DDSFile::DDSFile( const DDSFile &dds )
    :  mFlags( dds.mFlags ),
@@ -50,7 +56,10 @@ DDSFile::DDSFile( const DDSFile &dds )
       mFourCC( dds.mFourCC ),
       mCacheString( dds.mCacheString ),
       mSourcePath( dds.mSourcePath ),
-      mHasTransparency( dds.mHasTransparency )
+      mHasTransparency( dds.mHasTransparency ),
+      mCookedCRC( dds.mCookedCRC ),
+      mCookedFlags( dds.mCookedFlags ),
+      mMappedData( NULL )
 {
    VECTOR_SET_ASSOCIATION( mSurfaces );
    smActiveCopies++;
@@ -80,6 +89,7 @@ void DDSFile::clear()
    mFlags = 0;
    mHeight = mWidth = mDepth = mPitchOrLinearSize = mMipMapCount = 0;
    mFormat = GFXFormatR8G8B8;
+   mCookedCRC = mCookedFlags = 0;
 }
 
 U32 DDSFile::getSurfacePitch( U32 mipLevel ) const
@@ -243,6 +253,16 @@ bool DDSFile::readHeader(Stream &s)
    mDepth = header.depth;
    mFourCC = header.ddspf.fourCC;
 
+   // Files written by the texture cooker tag themselves in the
+   // reserved fields which other tools leave alone or zeroed.
+   if ( header.reserved1[0] == sCookedMagic )
+   {
+      mCookedCRC = header.reserved1[1];
+      mCookedFlags = header.reserved1[2];
+   }
+   else
+      mCookedCRC = mCookedFlags = 0;
+
    //process dx10 header
    if (hasDx10Header)
    {
@@ -479,6 +499,13 @@ bool DDSFile::writeHeader( Stream &s )
    memset(header.reserved1, 0, sizeof(header.reserved1));
    memset(header.reserved2, 0, sizeof(header.reserved2));
 
+   if (mCookedCRC)
+   {
+      header.reserved1[0] = sCookedMagic;
+      header.reserved1[1] = mCookedCRC;
+      header.reserved1[2] = mCookedFlags;
+   }
+
    //check our header is ok
    if (!dds::validateHeader(header))
       return false;
@@ -558,6 +585,13 @@ void DDSFile::SurfaceData::readNextMip(DDSFile *dds, Stream &s, U32 height, U32
    // If we're skipping this mip then seek forward.
    if ( skip )
       s.setPosition( s.getPosition() + size );
+   else if ( dds->mMappedData )
+   {
+      // Point into the mapped file rather than copying the mip.
+      mMips.push_back( dds->mMappedData + s.getPosition() );
+      mOwnsMips = false;
+      s.setPosition( s.getPosition() + size );
+   }
    else
    {
       mMips.push_back(new U8[size]);
@@ -581,29 +615,7 @@ template<> void *Resource<DDSFile>::create( const Torque::Path &path )
    Con::printf( "Resource<DDSFile>::create - [%s]", path.getFullPath().c_str() );
 #endif
 
-   FileStream stream;
-
-   stream.open( path.getFullPath(), Torque::FS::File::Read );
-
-   if ( stream.getStatus() != Stream::Ok )
-      return NULL;
-
-   DDSFile *retDDS = new DDSFile;
-
-   if( !retDDS->read( stream, DDSFile::smDropMipCount ) )
-   {
-      delete retDDS;
-      return NULL;
-   }
-   else
-   {
-      // Set source file name
-      retDDS->mSourcePath = path;
-      retDDS->mCacheString = Torque::Path::Join( path.getRoot(), ':', path.getPath() );
-      retDDS->mCacheString = Torque::Path::Join( retDDS->mCacheString, '/', path.getFileName() );
-   }
-
-   return retDDS;
+   return DDSFile::loadUncached( path, DDSFile::smDropMipCount );
 }
 
 template<> ResourceBase::Signature  Resource<DDSFile>::signature()
@@ -626,6 +638,127 @@ Resource<DDSFile> DDSFile::load( const Torque::Path &path, U32 dropMipCount )
    return ret;
 }
 
+bool DDSFile::_readUncached(  Stream &stream,
+                              U32 &inOutDropMipCount,
+                              U32 maxSize,
+                              U32 &outFileWidth,
+                              U32 &outFileHeight,
+                              U32 &outFileMips )
+{
+   // Peek at the header to see what we're going to drop.
+   if ( !readHeader( stream ) )
+      return false;
+
+   const U32 headerSize = stream.getPosition();
+   if ( !stream.setPosition( 0 ) )
+      return false;
+
+   outFileWidth = mWidth;
+   outFileHeight = mHeight;
+   outFileMips = getMax( mMipMapCount, U32(1) );
+
+   // The mips will point into a mapping, so make sure they all fit.
+   if ( mMappedData )
+   {
+      U32 dataSize = 0;
+      for ( U32 i=0; i < mMipMapCount; i++ )
+         dataSize += getSurfaceSize( i );
+
+      if ( mFlags.test( CubeMapFlag ) )
+      {
+         U32 faces = 0;
+         for ( U32 i=0; i < Cubemap_Surface_Count; i++ )
+            faces += mFlags.test( CubeMap_PosX_Flag + ( i << 1 ) ) ? 1 : 0;
+         dataSize *= faces;
+      }
+
+      if ( stream.getStreamSize() < headerSize || stream.getStreamSize() - headerSize < dataSize )
+         return false;
+   }
+
+   if ( maxSize )
+   {
+      while (  ( getWidth( inOutDropMipCount ) > maxSize || getHeight( inOutDropMipCount ) > maxSize ) &&
+               inOutDropMipCount + 1 < outFileMips )
+         inOutDropMipCount++;
+   }
+
+   inOutDropMipCount = getMin( inOutDropMipCount, outFileMips - 1 );
+
+   return read( stream, inOutDropMipCount );
+}
+
+DDSFile* DDSFile::loadUncached(  const Torque::Path &path, 
+                                 U32 dropMipCount, 
+                                 U32 maxSize,
+                                 U32 *outDroppedMips,
+                                 U32 *outFileWidth,
+                                 U32 *outFileHeight,
+                                 U32 *outFileMips )
+{
+   MEMORY_TAG_SCOPE( Textures );
+
+   U32 fileWidth, fileHeight, fileMips;
+   DDSFile *retDDS = NULL;
+
+   // Map the file if we can, so the mips are handed to the texture
+   // upload straight from the file instead of being copied first.
+   if ( smMapFiles )
+   {
+      Torque::FS::FileRef file = Torque::FS::OpenFile( path, Torque::FS::File::Read );
+
+      U32 mappedSize = 0;
+      U8 *mappedData = file != NULL ? file->map( mappedSize ) : NULL;
+      if ( mappedData )
+      {
+         MemStream stream( mappedSize, mappedData, true, false );
+
+         retDDS = new DDSFile;
+         retDDS->mMappedFile = file;
+         retDDS->mMappedData = mappedData;
+
+         U32 droppedMips = dropMipCount;
+         if ( retDDS->_readUncached( stream, droppedMips, maxSize, fileWidth, fileHeight, fileMips ) )
+            dropMipCount = droppedMips;
+         else
+            SAFE_DELETE( retDDS );
+      }
+   }
+
+   if ( !retDDS )
+   {
+      FileStream stream;
+
+      stream.open( path.getFullPath(), Torque::FS::File::Read );
+
+      if ( stream.getStatus() != Stream::Ok )
+         return NULL;
+
+      retDDS = new DDSFile;
+      if ( !retDDS->_readUncached( stream, dropMipCount, maxSize, fileWidth, fileHeight, fileMips ) )
+      {
+         delete retDDS;
+         return NULL;
+      }
+   }
+
+   // Set source file name
+   retDDS->mSourcePath = path;
+   retDDS->mCacheString = Torque::Path::Join( path.getRoot(), ':', path.getPath() );
+   retDDS->mCacheString = Torque::Path::Join( retDDS->mCacheString, '/', path.getFileName() );
+
+   if ( outDroppedMips )
+      *outDroppedMips = dropMipCount;
+   if ( outFileWidth )
+      *outFileWidth = fileWidth;
+   if ( outFileHeight )
+      *outFileHeight = fileHeight;
+   if ( outFileMips )
+      *outFileMips = fileMips;
+
+   return retDDS;
+}
+
 //------------------------------------------------------------------------------
 
 DDSFile *DDSFile::createDDSFileFromGBitmap( const GBitmap *gbmp )
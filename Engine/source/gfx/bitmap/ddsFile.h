@@ -35,6 +35,9 @@
 #ifndef __RESOURCE_H__
 #include "core/resource.h"
 #endif
+#ifndef _VOLUME_H_
+#include "core/volume.h"
+#endif
 
 class Stream;
 class GBitmap;
@@ -96,13 +99,30 @@ struct DDSFile
 
    bool        mHasTransparency;
 
+   /// CRC of the source image if this file was written by TextureCooker
+   /// or 0 otherwise.  Kept in the reserved fields of the header.
+   U32         mCookedCRC;
+
+   /// The TextureCooker flags stored along with #mCookedCRC.
+   U32         mCookedFlags;
+
+   /// If the file was mapped into memory, the mips point into this
+   /// mapping which is kept open for the lifetime of the DDSFile.
+   Torque::FS::FileRef mMappedFile;
+   U8          *mMappedData;
+
    // This is ugly... but it allows us to pass the number of
    // mips to drop into the ResourceManager loading process.
    static U32 smDropMipCount;
 
+   /// If true loadUncached() maps files into memory when the file
+   /// system supports it instead of reading them into the heap.
+   static bool smMapFiles;
+
    struct SurfaceData
    {
       SurfaceData()
+         : mOwnsMips( true )
       {
          VECTOR_SET_ASSOCIATION( mMips );
       }
@@ -110,12 +130,18 @@ struct DDSFile
       ~SurfaceData()
       {
          // Free our mips!
-         for(S32 i=0; i<mMips.size(); i++)
-            delete[] mMips[i];
+         if ( mOwnsMips )
+         {
+            for(S32 i=0; i<mMips.size(); i++)
+               delete[] mMips[i];
+         }
       }
 
       Vector<U8*> mMips;
 
+      /// False if the mips point into DDSFile::mMappedData.
+      bool mOwnsMips;
+
       void dumpImage(DDSFile *dds, U32 mip, const char *file);
       
       /// Helper for reading a mip level.
@@ -136,6 +162,14 @@ struct DDSFile
    /// Called from read() to read in the DDS header.
    bool readHeader(Stream &s);
 
+   /// Reads the file for loadUncached() dropping mips as needed.
+   bool _readUncached(  Stream &stream,
+                        U32 &inOutDropMipCount,
+                        U32 maxSize,
+                        U32 &outFileWidth,
+                        U32 &outFileHeight,
+                        U32 &outFileMips );
+
    /// Writes this DDS file to the stream.
    bool write(Stream &s);
 
@@ -173,6 +207,27 @@ struct DDSFile
 
    static Resource<DDSFile> load( const Torque::Path &path, U32 dropMipCount );
 
+   /// Reads a DDS file bypassing the ResourceManager, so that the same file
+   /// can be read at different mip levels.  This is safe to call from worker
+   /// threads.
+   ///
+   /// @param dropMipCount    The number of top mips to skip.
+   /// @param maxSize         If not zero, more mips are skipped until neither
+   ///                        side of the top mip exceeds this size.
+   /// @param outDroppedMips  If not NULL, set to the number of mips skipped.
+   /// @param outFileWidth    If not NULL, set to the width of the file's top mip.
+   /// @param outFileHeight   If not NULL, set to the height of the file's top mip.
+   /// @param outFileMips     If not NULL, set to the number of mips in the file.
+   ///
+   /// @return The new DDSFile, which the caller owns, or NULL on failure.
+   static DDSFile* loadUncached( const Torque::Path &path, 
+                                 U32 dropMipCount, 
+                                 U32 maxSize = 0,
+                                 U32 *outDroppedMips = NULL,
+                                 U32 *outFileWidth = NULL,
+                                 U32 *outFileHeight = NULL,
+                                 U32 *outFileMips = NULL );
+
    // For debugging fun!
    static S32 smActiveCopies;
 
@@ -182,6 +237,9 @@ struct DDSFile
       smActiveCopies++;
 
       mHasTransparency = false;
+      mCookedCRC = 0;
+      mCookedFlags = 0;
+      mMappedData = NULL;
    }
 
    DDSFile( const DDSFile &dds );
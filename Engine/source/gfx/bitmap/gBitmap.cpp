@@ -31,6 +31,7 @@
 #include "math/mRect.h"
 #include "console/console.h"
 #include "platform/profiler.h"
+#include "platform/platformMemory.h"
 #include "console/engineAPI.h"
 
 using namespace Torque;
@@ -419,8 +420,10 @@ void GBitmap::allocateBitmapWithMips(const U32 in_width, const U32 in_height, co
 }
 
 //--------------------------------------------------------------------------
-void GBitmap::extrudeMipLevels(bool clearBorders)
+void GBitmap::extrudeMipLevels(bool clearBorders, bool sRGB)
 {
+   PROFILE_SCOPE(GBitmap_extrudeMipLevels);
+
    if(mNumMipLevels == 1)
       allocateBitmap(getWidth(), getHeight(), true, getFormat());
 
@@ -435,16 +438,18 @@ void GBitmap::extrudeMipLevels(bool clearBorders)
 
       case GFXFormatR8G8B8:
       {
+         void (*extrude)(const void *, void *, U32, U32) = sRGB ? bitmapExtrudeRGB_sRGB : bitmapExtrudeRGB;
          for(U32 i = 1; i < mNumMipLevels; i++)
-            bitmapExtrudeRGB(getBits(i - 1), getWritableBits(i), getHeight(i-1), getWidth(i-1));
+            extrude(getBits(i - 1), getWritableBits(i), getHeight(i-1), getWidth(i-1));
          break;
       }
 
       case GFXFormatR8G8B8A8:
       case GFXFormatR8G8B8X8:
       {
+         void (*extrude)(const void *, void *, U32, U32) = sRGB ? bitmapExtrudeRGBA_sRGB : bitmapExtrudeRGBA;
          for(U32 i = 1; i < mNumMipLevels; i++)
-            bitmapExtrudeRGBA(getBits(i - 1), getWritableBits(i), getHeight(i-1), getWidth(i-1));
+            extrude(getBits(i - 1), getWritableBits(i), getHeight(i-1), getWidth(i-1));
          break;
       }
       
@@ -1202,18 +1207,26 @@ bool  GBitmap::writeBitmap( const String &bmType, Stream &ioStream, U32 compress
 template<> void *Resource<GBitmap>::create(const Torque::Path &path)
 {
    PROFILE_SCOPE( ResourceGBitmap_create );
+   MEMORY_TAG_SCOPE( Textures );
 
 #ifdef TORQUE_DEBUG_RES_MANAGER
    Con::printf( "Resource<GBitmap>::create - [%s]", path.getFullPath().c_str() );
 #endif
 
+   return GBitmap::loadUncached( path );
+}
+
+GBitmap* GBitmap::loadUncached(const Torque::Path &path)
+{
+   PROFILE_SCOPE( GBitmap_loadUncached );
+
    FileStream  stream;
 
    stream.open( path.getFullPath(), Torque::FS::File::Read );
 
    if ( stream.getStatus() != Stream::Ok )
    {
-      Con::errorf( "Resource<GBitmap>::create - failed to open '%s'", path.getFullPath().c_str() );
+      Con::errorf( "GBitmap::loadUncached - failed to open '%s'", path.getFullPath().c_str() );
       return NULL;
    }
 
@@ -1221,7 +1234,7 @@ template<> void *Resource<GBitmap>::create(const Torque::Path &path)
    const String extension = path.getExtension();
    if( !bmp->readBitmap( extension, stream ) )
    {
-      Con::errorf( "Resource<GBitmap>::create - error reading '%s'", path.getFullPath().c_str() );
+      Con::errorf( "GBitmap::loadUncached - error reading '%s'", path.getFullPath().c_str() );
       delete bmp;
       bmp = NULL;
    }
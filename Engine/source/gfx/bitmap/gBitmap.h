@@ -109,6 +109,12 @@ public:
    ///
    static Resource<GBitmap> load(const Torque::Path &path);
 
+   /// Reads the image file at @a path into a new bitmap without going
+   /// through the ResourceManager, so this may be called on any thread.
+   ///
+   /// @return The new bitmap, which the caller owns, or NULL on failure.
+   static GBitmap* loadUncached(const Torque::Path &path);
+
 protected:
 
    static Resource<GBitmap> _load(const Torque::Path &path);
@@ -156,7 +162,9 @@ public:
       const U32  in_numMips,
       const GFXFormat in_format = GFXFormatR8G8B8);
 
-   void extrudeMipLevels(bool clearBorders = false);
+   /// Generate the mip chain with a box filter.  If @a sRGB is true the colors
+   /// are treated as sRGB encoded and averaged in linear space.
+   void extrudeMipLevels(bool clearBorders = false, bool sRGB = false);
    void chopTopMips(U32 mipsToChop);
    void extrudeMipLevelsDetail();
 
@@ -159,9 +159,11 @@ namespace ImageUtil
             for (U32 currentMip = 0; currentMip < mipCount; currentMip++)
             {
                const U32 dataIndex = cubeFace * mipCount + currentMip;
-               delete[] pSrcSurface->mMips[currentMip];
+               if (pSrcSurface->mOwnsMips)
+                  delete[] pSrcSurface->mMips[currentMip];
                pSrcSurface->mMips[currentMip] = dstDataStore[dataIndex];
             }
+            pSrcSurface->mOwnsMips = true;
          }
       }
       else
@@ -30,6 +30,11 @@
 static bool sReadJPG(Stream &stream, GBitmap *bitmap);
 static bool sWriteJPG(GBitmap *bitmap, Stream &stream, U32 compressionLevel);
 
+static S32 jpegReadDataFn(void *client_data, U8 *data, S32 length);
+static S32 jpegWriteDataFn(void *client_data, U8 *data, S32 length);
+static S32 jpegFlushDataFn(void *);
+static S32 jpegErrorFn(void *client_data);
+
 static struct _privateRegisterJPG
 {
    _privateRegisterJPG()
@@ -44,6 +49,13 @@ static struct _privateRegisterJPG
       reg.writeFunc = sWriteJPG;
 
       GBitmap::sRegisterFormat( reg );
+
+      // The I/O hooks are globals, so set them once here rather than
+      // for every file, which lets images be decoded on several threads.
+      JFREAD  = jpegReadDataFn;
+      JFWRITE = jpegWriteDataFn;
+      JFFLUSH = jpegFlushDataFn;
+      JFERROR = jpegErrorFn;
    }
 } sStaticRegisterJPG;
 
@@ -98,8 +110,6 @@ static S32 jpegErrorFn(void *client_data)
 static bool sReadJPG(Stream &stream, GBitmap *bitmap)
 {
    PROFILE_SCOPE(sReadJPG);
-   JFREAD  = jpegReadDataFn;
-   JFERROR = jpegErrorFn;
 
    jpeg_decompress_struct cinfo;
    jpeg_error_mgr jerr;
@@ -191,9 +201,6 @@ static bool sWriteJPG(GBitmap *bitmap, Stream &stream, U32 compressionLevel)
 
    // Bind our own stream writing, error, and memory flush functions
    // to the jpeg library interface
-   JFWRITE = jpegWriteDataFn;
-   JFFLUSH = jpegFlushDataFn;
-   JFERROR = jpegErrorFn;
 
    // Allocate and initialize our jpeg compression structure and error manager
    jpeg_compress_struct cinfo;
@@ -149,7 +149,8 @@ static bool sReadPNG(Stream &stream, GBitmap *bitmap)
       return false;
    }
 
-   U32 prevWaterMark = FrameAllocator::getWaterMark();
+   // All memory comes from the real allocator rather than the
+   // FrameAllocator, so this may run on any thread.
    png_structp png_ptr = png_create_read_struct_2(PNG_LIBPNG_VER_STRING,
       NULL,
       pngFatalErrorFn,
@@ -160,7 +161,6 @@ static bool sReadPNG(Stream &stream, GBitmap *bitmap)
 
    if (png_ptr == NULL) 
    {
-      FrameAllocator::setWaterMark(prevWaterMark);
       return false;
    }
 
@@ -171,7 +171,6 @@ static bool sReadPNG(Stream &stream, GBitmap *bitmap)
          (png_infopp)NULL,
          (png_infopp)NULL);
 
-      FrameAllocator::setWaterMark(prevWaterMark);
       return false;
    }
 
@@ -182,7 +181,6 @@ static bool sReadPNG(Stream &stream, GBitmap *bitmap)
          &info_ptr,
          (png_infopp)NULL);
 
-      FrameAllocator::setWaterMark(prevWaterMark);
       return false;
    }
 
@@ -314,8 +312,6 @@ static bool sReadPNG(Stream &stream, GBitmap *bitmap)
    // Check this bitmap for transparency
    bitmap->checkForTransparency();
 
-   FrameAllocator::setWaterMark(prevWaterMark);
-
    return true;
 }
 
@@ -0,0 +1,77 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "gfx/bitmap/bitmapUtils.h"
+#include "math/mRandom.h"
+
+TEST(BitmapUtils, ExtrudeRGBAImplementations)
+{
+   // The installed version may be a SIMD one, the C version is the baseline.
+   const U32 sizes[][2] = { { 64, 32 }, { 16, 16 }, { 8, 1 }, { 1, 8 }, { 4, 4 }, { 2, 2 } };
+
+   U8 src[ 64 * 32 * 4 ], mipC[ 32 * 16 * 4 ], mip[ 32 * 16 * 4 ];
+   for (U32 i = 0; i < sizeof(src); i++)
+      src[i] = U8(gRandGen.randI());
+
+   for (U32 i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+   {
+      const U32 width = sizes[i][0];
+      const U32 height = sizes[i][1];
+      const U32 mipBytes = getMax(width >> 1, U32(1)) * getMax(height >> 1, U32(1)) * 4;
+
+      bitmapExtrudeRGBA_c(src, mipC, height, width);
+      bitmapExtrudeRGBA(src, mip, height, width);
+
+      EXPECT_EQ(dMemcmp(mip, mipC, mipBytes), 0)
+         << "Mip of " << width << "x" << height << " differs from the C version";
+   }
+};
+
+TEST(BitmapUtils, ExtrudeSRGB)
+{
+   // Black and white texels should average to middle gray in linear space,
+   // which is a lot brighter than 128 in sRGB.
+   U8 src[ 2 * 2 * 4 ] = { 0, 0, 0, 0,  255, 255, 255, 255,
+                           255, 255, 255, 255,  0, 0, 0, 0 };
+   U8 mip[ 4 ];
+
+   bitmapExtrudeRGBA_sRGB(src, mip, 2, 2);
+   for (U32 c = 0; c < 3; c++)
+      EXPECT_NEAR(mip[c], 188, 1) << "Colors should be averaged in linear space";
+   EXPECT_NEAR(mip[3], 128, 1) << "Alpha should be averaged as is";
+
+   // Uniform colors must not drift.
+   for (U32 i = 0; i < 256; i++)
+   {
+      U8 flat[ 2 * 2 * 3 ];
+      dMemset(flat, i, sizeof(flat));
+
+      U8 flatMip[ 3 ];
+      bitmapExtrudeRGB_sRGB(flat, flatMip, 2, 2);
+      EXPECT_NEAR(flatMip[0], i, 1);
+   }
+};
+
+#endif
@@ -0,0 +1,281 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "gfx/bitmap/textureCooker.h"
+
+#include "gfx/bitmap/ddsFile.h"
+#include "gfx/bitmap/gBitmap.h"
+#include "gfx/bitmap/imageUtils.h"
+#include "gfx/gfxTextureProfile.h"
+#include "gfx/gfxStringEnumTranslate.h"
+#include "core/stream/fileStream.h"
+#include "core/crc.h"
+#include "core/volume.h"
+#include "core/module.h"
+#include "console/consoleTypes.h"
+#include "console/engineAPI.h"
+#include "platform/profiler.h"
+
+
+bool TextureCooker::smUseCooked = true;
+bool TextureCooker::smCookOnLoad = false;
+S32 TextureCooker::smQuality = ImageUtil::MediumQuality;
+
+
+AFTER_MODULE_INIT( GFX )
+{
+   Con::addVariable( "$pref::Video::useCookedTextures", TypeBool, &TextureCooker::smUseCooked,
+      "If true, textures are loaded from block compressed DDS files made by cookTexture() "
+      "when those are up to date with their source images.\n"
+      "@ingroup GFX\n" );
+
+   Con::addVariable( "$pref::Video::cookTexturesOnLoad", TypeBool, &TextureCooker::smCookOnLoad,
+      "If true, images without an up to date cooked file are cooked when they are first "
+      "loaded, so the next run can use the cooked file.\n"
+      "@ingroup GFX\n" );
+
+   Con::addVariable( "$pref::Video::textureCookQuality", TypeS32, &TextureCooker::smQuality,
+      "The block compression quality of cooked textures: 0 is fastest, 2 is best.\n"
+      "@ingroup GFX\n" );
+}
+
+bool TextureCooker::canUseCooked( GFXTextureProfile *profile )
+{
+   if ( !smUseCooked || !profile )
+      return false;
+
+   // Cooked files are always compressed and mipped, so leave out
+   // everything that is expected to look exactly like its source
+   // or asks for a specific format.
+   const GFXTextureProfile::Types type = profile->getType();
+   return   ( type == GFXTextureProfile::DiffuseMap || type == GFXTextureProfile::NormalMap ) &&
+            profile->getCompression() == GFXTextureProfile::NONE &&
+            profile->canDownscale() &&
+            !profile->noMip() &&
+            !profile->isDynamic() &&
+            !profile->isRenderTarget() &&
+            !profile->doStoreBitmap();
+}
+
+Torque::Path TextureCooker::getCookedPath( const Torque::Path &sourcePath )
+{
+   Torque::Path cookedPath( sourcePath );
+   cookedPath.setFileName( sourcePath.getFullFileName() );
+   cookedPath.setExtension( "dds" );
+   return cookedPath;
+}
+
+U32 TextureCooker::getSourceCRC( const Torque::Path &sourcePath )
+{
+   FileStream stream;
+   if ( !stream.open( sourcePath, Torque::FS::File::Read ) )
+      return 0;
+
+   // Zero means "not cooked" in the DDS header.
+   const U32 crc = CRC::calculateCRCStream( &stream );
+   return crc ? crc : 1;
+}
+
+bool TextureCooker::_isCurrent( const DDSFile &dds, U32 crc, bool normalMap )
+{
+   const U32 flags = normalMap ? NormalMap : 0;
+   return crc && dds.mCookedCRC == crc && dds.mCookedFlags == flags;
+}
+
+DDSFile* TextureCooker::loadCooked( const Torque::Path &sourcePath, bool normalMap, U32 dropMipCount )
+{
+   PROFILE_SCOPE( TextureCooker_loadCooked );
+
+   const Torque::Path cookedPath = getCookedPath( sourcePath );
+   if ( !Torque::FS::IsFile( cookedPath ) )
+      return NULL;
+
+   FileStream stream;
+   if ( !stream.open( cookedPath, Torque::FS::File::Read ) )
+      return NULL;
+
+   // Check the header before reading any pixels.
+   DDSFile *dds = new DDSFile;
+   if (  !dds->readHeader( stream ) ||
+         !_isCurrent( *dds, getSourceCRC( sourcePath ), normalMap ) ||
+         !stream.setPosition( 0 ) ||
+         !dds->read( stream, dropMipCount ) )
+   {
+      delete dds;
+      return NULL;
+   }
+
+   dds->mSourcePath = cookedPath;
+   return dds;
+}
+
+bool TextureCooker::cook( const Torque::Path &sourcePath, bool normalMap, bool force )
+{
+   PROFILE_SCOPE( TextureCooker_cook );
+
+   const U32 crc = getSourceCRC( sourcePath );
+   if ( !crc )
+   {
+      Con::errorf( "TextureCooker::cook - Unable to read '%s'.", sourcePath.getFullPath().c_str() );
+      return false;
+   }
+
+   const Torque::Path cookedPath = getCookedPath( sourcePath );
+   if ( !force && Torque::FS::IsFile( cookedPath ) )
+   {
+      FileStream stream;
+      DDSFile header;
+      if (  stream.open( cookedPath, Torque::FS::File::Read ) &&
+            header.readHeader( stream ) &&
+            _isCurrent( header, crc, normalMap ) )
+         return true;
+   }
+
+   Resource<GBitmap> source = GBitmap::load( sourcePath );
+   if ( source == NULL )
+   {
+      Con::errorf( "TextureCooker::cook - Unable to load '%s'.", sourcePath.getFullPath().c_str() );
+      return false;
+   }
+
+   if ( source->getFormat() != GFXFormatR8G8B8 && source->getFormat() != GFXFormatR8G8B8A8 )
+   {
+      Con::warnf( "TextureCooker::cook - '%s' has unsupported format %s.", 
+         sourcePath.getFullPath().c_str(), GFXStringTextureFormat[source->getFormat()] );
+      return false;
+   }
+
+   // The bitmap is shared through the resource cache so work on a copy.
+   GBitmap bitmap( *source );
+   const bool hasAlpha = bitmap.checkForTransparency();
+
+   GFXFormat format;
+   if ( normalMap )
+   {
+      // BC5 only keeps two channels which would lose the
+      // specular some normal maps keep in their alpha.
+      if ( hasAlpha )
+      {
+         Con::warnf( "TextureCooker::cook - Normal map '%s' has alpha and is left uncooked.", sourcePath.getFullPath().c_str() );
+         return false;
+      }
+
+      format = GFXFormatBC5;
+   }
+   else
+      format = hasAlpha ? GFXFormatBC3 : GFXFormatBC1;
+
+   // Same rule as for textures mipped at load time.
+   if ( bitmap.getNumMipLevels() == 1 && isPow2( bitmap.getWidth() ) && isPow2( bitmap.getHeight() ) )
+      bitmap.extrudeMipLevels();
+
+   DDSFile *dds = DDSFile::createDDSFileFromGBitmap( &bitmap );
+   const ImageUtil::CompressQuality quality = (ImageUtil::CompressQuality)mClamp( smQuality, ImageUtil::LowQuality, ImageUtil::HighQuality );
+   if ( !dds || !ImageUtil::ddsCompress( dds, format, quality ) )
+   {
+      Con::errorf( "TextureCooker::cook - Unable to compress '%s'.", sourcePath.getFullPath().c_str() );
+      SAFE_DELETE( dds );
+      return false;
+   }
+
+   dds->mPitchOrLinearSize = dds->getSurfaceSize( 0 );
+   dds->mCookedCRC = crc;
+   dds->mCookedFlags = normalMap ? NormalMap : 0;
+
+   FileStream stream;
+   bool success = stream.open( cookedPath, Torque::FS::File::Write ) && dds->write( stream );
+   stream.close();
+   delete dds;
+
+   if ( !success )
+   {
+      Con::errorf( "TextureCooker::cook - Unable to write '%s'.", cookedPath.getFullPath().c_str() );
+
+      // Don't leave a partial file behind.
+      Torque::FS::Remove( cookedPath );
+      return false;
+   }
+
+   return true;
+}
+
+DefineEngineFunction( cookTexture, bool, ( const char *path, bool normalMap, bool force ), ( false, false ),
+   "Converts an image to a block compressed DDS file with mips next to it, which is then loaded "
+   "in its place while the image is unchanged.\n"
+   "@param path The image file including its extension.\n"
+   "@param normalMap Cook the image for use as a normal map.\n"
+   "@param force Cook the image even if the cooked file is up to date.\n"
+   "@return True if the cooked file is up to date.\n"
+   "@see $pref::Video::useCookedTextures\n"
+   "@ingroup GFX\n" )
+{
+   return TextureCooker::cook( Torque::Path( path ), normalMap, force );
+}
+
+DefineEngineFunction( cookTextures, S32, ( const char *path, bool recursive, const char *normalMapSuffixes, bool force ), ( true, "_n _nrm _normal", false ),
+   "Cooks all images in a directory, see cookTexture().\n"
+   "@param path The directory to search.\n"
+   "@param recursive Search the subdirectories as well.\n"
+   "@param normalMapSuffixes Space separated endings of the file names of normal maps.\n"
+   "@param force Cook the images even if their cooked files are up to date.\n"
+   "@return The number of images with up to date cooked files.\n"
+   "@ingroup GFX\n" )
+{
+   Torque::Path basePath( path );
+   if ( basePath.isRelative() )
+      basePath = Torque::Path::Join( Torque::FS::GetCwd(), '/', basePath );
+
+   if ( !Torque::FS::IsDirectory( basePath ) )
+   {
+      Con::errorf( "cookTextures - '%s' is not a directory.", path );
+      return 0;
+   }
+
+   Vector<String> suffixes;
+   String::ToLower( normalMapSuffixes ).split( " ", suffixes );
+
+   Vector<String> files;
+   for ( U32 i=0; i < GBitmap::sRegistrations.size(); i++ )
+   {
+      const Vector<String> &extensions = GBitmap::sRegistrations[i].extensions;
+      for ( U32 j=0; j < extensions.size(); j++ )
+         Torque::FS::FindByPattern( basePath, "*." + extensions[j], recursive, files );
+   }
+
+   S32 cooked = 0;
+   for ( U32 i=0; i < files.size(); i++ )
+   {
+      const Torque::Path sourcePath( files[i] );
+      const String fileName = String::ToLower( sourcePath.getFileName() );
+
+      bool normalMap = false;
+      for ( U32 j=0; j < suffixes.size() && !normalMap; j++ )
+         normalMap = suffixes[j].isNotEmpty() && fileName.endsWith( suffixes[j] );
+
+      if ( TextureCooker::cook( sourcePath, normalMap, force ) )
+         cooked++;
+   }
+
+   Con::printf( "cookTextures - %d of %d images cooked.", cooked, files.size() );
+   return cooked;
+}
@@ -0,0 +1,91 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _TEXTURECOOKER_H_
+#define _TEXTURECOOKER_H_
+
+#ifndef _PATH_H_
+#include "core/util/path.h"
+#endif
+
+struct DDSFile;
+class GFXTextureProfile;
+
+
+/// Converts source images into block compressed DDS files with a full mip
+/// chain ahead of time, so that loading them needs neither decoding nor
+/// runtime compression.
+///
+/// The cooked file of "art/rock.png" is "art/rock.png.dds".  It carries the
+/// CRC of the source file in its header (see DDSFile::mCookedCRC), so a
+/// cooked file whose source was edited since is ignored rather than used.
+/// Color images are cooked to BC1 or, if they have transparency, to BC3.
+/// Normal maps are cooked to BC5 unless their alpha channel holds data.
+///
+/// GFXTextureManager::createTexture() prefers a current cooked file over
+/// the source image for static textures.  The console functions
+/// cookTexture() and cookTextures() cook files by hand or in batches.
+class TextureCooker
+{
+public:
+
+   enum Flags
+   {
+      /// The file holds a normal map for GFXTextureProfile::NormalMap.
+      NormalMap = BIT(0),
+   };
+
+   /// Use cooked files when available.
+   static bool smUseCooked;
+
+   /// Cook images the first time they are loaded if they have no
+   /// current cooked file.
+   static bool smCookOnLoad;
+
+   /// The ImageUtil::CompressQuality to cook with.
+   static S32 smQuality;
+
+   /// Returns true if textures with @a profile may be loaded from cooked files.
+   static bool canUseCooked( GFXTextureProfile *profile );
+
+   /// Returns the path of the cooked file for @a sourcePath.
+   static Torque::Path getCookedPath( const Torque::Path &sourcePath );
+
+   /// Returns the CRC of the contents of @a sourcePath or 0 if it can't be read.
+   static U32 getSourceCRC( const Torque::Path &sourcePath );
+
+   /// Loads the cooked file of @a sourcePath dropping @a dropMipCount top mips.
+   /// @return The file or NULL if there is none or it is out of date.
+   static DDSFile* loadCooked( const Torque::Path &sourcePath, bool normalMap, U32 dropMipCount );
+
+   /// Writes the cooked file of @a sourcePath.
+   /// @param force Cook even if the cooked file is current.
+   /// @return False if the image could not be cooked.
+   static bool cook( const Torque::Path &sourcePath, bool normalMap, bool force = false );
+
+protected:
+
+   /// Returns true if @a dds was cooked from the source with @a crc.
+   static bool _isCurrent( const DDSFile &dds, U32 crc, bool normalMap );
+};
+
+#endif // _TEXTURECOOKER_H_
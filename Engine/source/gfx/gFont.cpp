@@ -23,6 +23,7 @@
 #include "platform/platform.h"
 #include "gfx/gFont.h"
 
+#include "core/module.h"
 #include "core/resourceManager.h"
 #include "core/stream/fileStream.h"
 #include "core/strings/unicode.h"
@@ -76,6 +77,16 @@ static S32 QSORT_CALLBACK GlyphMapCompare(const void *a, const void *b)
 
 const U32 GFont::csm_fileVersion = 3;
 
+bool GFont::smDistanceFieldFonts = false;
+
+AFTER_MODULE_INIT( Sim )
+{
+   Con::addVariable( "$GUI::distanceFieldFonts", TypeBool, &GFont::smDistanceFieldFonts,
+      "If true, fonts are drawn scaled from one distance field atlas per face instead of "
+      "from glyphs rasterized for every size.  Fonts created before this is set are not affected.\n"
+      "@ingroup Font\n" );
+}
+
 String GFont::getFontCacheFilename(const String &faceName, U32 size)
 {
    return String::ToString("%s/%s %d (%s).uft",
@@ -118,6 +129,14 @@ Resource<GFont> GFont::create(const String &faceName, U32 size, const char *cach
 {
    if( !cacheDirectory )
       cacheDirectory = Con::getVariable( "$GUI::fontCacheDirectory" );
+
+   if( smDistanceFieldFonts )
+   {
+      // Fall back to a bitmap font if the face has no atlas and can't make one.
+      Resource<GFont> ret = createDistanceField(faceName, size, cacheDirectory, charset);
+      if (ret != NULL)
+         return ret;
+   }
       
    const Torque::Path   path( String::ToString("%s/%s %d (%s).uft",
       cacheDirectory, faceName.c_str(), size, getCharSetName(charset)) );
@@ -191,6 +210,40 @@ Resource<GFont> GFont::create(const String &faceName, U32 size, const char *cach
    return ret;
 }
 
+Resource<GFont> GFont::createDistanceField(const String &faceName, U32 size, const char *cacheDirectory, U32 charset)
+{
+   Resource<GFont> ret;
+
+   // The resource is never written; the glyphs are kept in the atlas.
+   const Torque::Path   path( String::ToString("%s/%s %d (%s).sdf",
+      cacheDirectory, faceName.c_str(), size, getCharSetName(charset)) );
+
+   ret = ResourceManager::get().find(path);
+   if (ret != NULL)
+      return ret;
+
+   GFontDistanceField *atlas = GFontDistanceField::find(faceName, charset, cacheDirectory);
+   if (atlas == NULL)
+      return ret;
+
+   GFont *font = new GFont;
+   font->mDistanceField = atlas;
+   font->mDistanceFieldScale = F32(size) / GFontDistanceField::FieldSize;
+   font->mGFTFile = path;
+   font->mFaceName = faceName;
+   font->mSize = size;
+   font->mCharSet = charset;
+
+   font->mHeight   = mRound(atlas->getHeight() * font->mDistanceFieldScale);
+   font->mBaseline = mRound(atlas->getBaseline() * font->mDistanceFieldScale);
+   font->mAscent   = font->mBaseline;
+   font->mDescent  = font->mHeight - font->mBaseline;
+
+   ret.setResource(ResourceManager::get().load(path), font);
+
+   return ret;
+}
+
 //-------------------------------------------------------------------------
 
 GFont::GFont()
@@ -204,6 +257,7 @@ GFont::GFont()
    mCurX = mCurY = mCurSheet = -1;
 
    mPlatformFont = NULL;
+   mDistanceFieldScale = 1.0f;
    mSize = 0;
    mCharSet = 0;
    mNeedSave = false;
@@ -265,6 +319,9 @@ void GFont::dumpInfo() const
    else
       Con::printf("      - No mapped codepoints.");
    Con::printf("      - Platform font is %s.", (mPlatformFont ? "present" : "not present") );
+
+   if(mDistanceField)
+      Con::printf("      - Drawn from the '%s' distance field atlas.", mDistanceField->getFontFaceName().c_str());
 }
 
 //-----------------------------------------------------------------------------
@@ -276,6 +333,35 @@ bool GFont::loadCharInfo(const UTF16 ch)
     if(mRemapTable[ch] != -1)
         return true;    // Not really an error
 
+    if(mDistanceField)
+    {
+        const GFontDistanceField::Glyph *glyph = mDistanceField->getGlyph(ch);
+        if(!glyph)
+            return false;
+
+        // Scale the atlas metrics to our size, minus the spread around the
+        // field so layout matches a bitmap font of the same face.
+        const F32 scale = mDistanceFieldScale;
+        const S32 spread = glyph->width ? GFontDistanceField::Spread : 0;
+
+        PlatformFont::CharInfo ci;
+        ci.bitmapIndex = -1; // The sheets belong to the atlas.
+        ci.xOffset = 0;
+        ci.yOffset = 0;
+        ci.width = getMax(0, mRound((glyph->width - 2 * spread) * scale));
+        ci.height = getMax(0, mRound((glyph->height - 2 * spread) * scale));
+        ci.xOrigin = mRound((glyph->xOrigin + spread) * scale);
+        ci.yOrigin = mRound((glyph->yOrigin - spread) * scale);
+        ci.xIncrement = mRound(glyph->xIncrement * scale);
+        ci.bitmapData = NULL;
+
+        Mutex::lockMutex(mMutex);
+        mCharInfoList.push_back(ci);
+        mRemapTable[ch] = mCharInfoList.size() - 1;
+        Mutex::unlockMutex(mMutex);
+        return true;
+    }
+
     if(mPlatformFont && mPlatformFont->isValidChar(ch))
     {
         Mutex::lockMutex(mMutex); // the CharInfo returned by mPlatformFont is static data, must protect from changes.
@@ -742,6 +828,12 @@ bool GFont::read(Stream& io_rStream)
 
 bool GFont::write(Stream& stream)
 {
+    if(mDistanceField)
+    {
+        Con::errorf("GFont::write - '%s' %d is a distance field font, its glyphs are saved with the atlas.", mFaceName.c_str(), mSize);
+        return false;
+    }
+
     // Handle versioning
     stream.write(csm_fileVersion);
 
@@ -823,6 +915,12 @@ bool GFont::write(Stream& stream)
 
 void GFont::exportStrip(const char *fileName, U32 padding, U32 kerning)
 {
+   if(mDistanceField)
+   {
+      Con::errorf("GFont::exportStrip - distance field fonts have no bitmap strip.");
+      return;
+   }
+
    // Figure dimensions of our strip by iterating over all the char infos.
    U32 totalHeight = 0;
    U32 totalWidth = 0;
@@ -887,6 +985,12 @@ void  GFont::setPlatformFont(PlatformFont *inPlatformFont)
 
 void GFont::importStrip(const char *fileName, U32 padding, U32 kerning)
 {
+   if(mDistanceField)
+   {
+      Con::errorf("GFont::importStrip - distance field fonts have no bitmap strip.");
+      return;
+   }
+
    // Wipe our texture sheets, and reload bitmap data from the specified file.
    // Also deal with kerning.
    // Also, we may have to load RGBA instead of RGB.
@@ -1119,6 +1223,16 @@ DefineEngineFunction( writeFontCache, void, (),,
 
    while( theFont != NULL )
    {
+      if( theFont->isDistanceField() )
+      {
+         GFontDistanceField *atlas = theFont->getDistanceField();
+         if( atlas->save() )
+            Con::printf("      o Writing '%s' to disk...", atlas->getPath().getFullPath().c_str());
+
+         theFont = ResourceManager::get().nextResource();
+         continue;
+      }
+
       const String   fileName( theFont.getPath() );
 
       FileStream stream;
@@ -39,6 +39,9 @@
 #ifndef _GFXTEXTUREHANDLE_H_
 #include "gfx/gfxTextureHandle.h"
 #endif
+#ifndef _GFONTDISTANCEFIELD_H_
+#include "gfx/gFontDistanceField.h"
+#endif
 
 
 GFX_DeclareTextureProfile(GFXFontTextureProfile);
@@ -58,7 +61,21 @@ public:
    
    static Resource<GFont> create(const String &faceName, U32 size, const char *cacheDirectory = 0, U32 charset = TGE_ANSI_CHARSET);
 
-   GFXTexHandle getTextureHandle(S32 index) const { return mTextureSheets[index]; }
+   /// If true, create() makes fonts that draw from the distance field atlas
+   /// of their face instead of rasterizing glyphs for every size.
+   static bool smDistanceFieldFonts;
+
+   GFXTexHandle getTextureHandle(S32 index) const
+   {
+      return mDistanceField ? mDistanceField->getTextureHandle(index) : mTextureSheets[index];
+   }
+
+   /// Is this font drawn from a distance field atlas?
+   bool isDistanceField() const { return mDistanceField != NULL; }
+   GFontDistanceField* getDistanceField() const { return mDistanceField; }
+
+   /// Screen pixels per atlas field pixel at this font's size.
+   F32 getDistanceFieldScale() const { return mDistanceFieldScale; }
 
    const PlatformFont::CharInfo& getCharInfo(const UTF16 in_charIndex);
    static const PlatformFont::CharInfo& getDefaultCharInfo();
@@ -102,6 +119,9 @@ public:
    /// chars!
    const bool hasPlatformFont() const
    {
+      if(mDistanceField)
+         return mDistanceField->hasPlatformFont();
+
       return mPlatformFont != NULL;
    }
 
@@ -109,6 +129,9 @@ public:
    /// are treated as having 0 for RGB).
    bool isAlphaOnly() const
    {
+      if(mDistanceField)
+         return true;
+
       return mTextureSheets[0]->getBitmap()->getFormat() == GFXFormatA8;
    }
 
@@ -126,6 +149,8 @@ public:
    static GFont* load( const Torque::Path& path );
 
 protected:
+   static Resource<GFont> createDistanceField(const String &faceName, U32 size, const char *cacheDirectory, U32 charset);
+
    bool loadCharInfo(const UTF16 ch);
    void addBitmap(PlatformFont::CharInfo &charInfo);
    void addSheet(void);
@@ -139,6 +164,10 @@ private:
    PlatformFont *mPlatformFont;
    Vector<GFXTexHandle>mTextureSheets;
 
+   /// Shared atlas of the face, for distance field fonts.
+   StrongRefPtr<GFontDistanceField> mDistanceField;
+   F32 mDistanceFieldScale;
+
    S32 mCurX;
    S32 mCurY;
    S32 mCurSheet;
@@ -185,6 +214,9 @@ inline bool GFont::isValidChar(const UTF16 in_charIndex) const
    if(mRemapTable[in_charIndex] != -1)
       return true;
 
+   if(mDistanceField)
+      return mDistanceField->isValidChar(in_charIndex);
+
    if(mPlatformFont)
       return mPlatformFont->isValidChar(in_charIndex);
 
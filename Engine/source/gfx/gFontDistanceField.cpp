@@ -0,0 +1,536 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "gfx/gFontDistanceField.h"
+
+#include "gfx/gFont.h"
+#include "gfx/util/distanceField.h"
+#include "core/module.h"
+#include "core/stream/fileStream.h"
+#include "core/util/safeDelete.h"
+#include "console/console.h"
+#include "console/engineAPI.h"
+
+
+bool GFontDistanceField::smAsyncGeneration = true;
+
+const U32 GFontDistanceField::csm_fileVersion = 1;
+
+Vector<GFontDistanceField*> GFontDistanceField::smAtlases;
+
+
+AFTER_MODULE_INIT( Sim )
+{
+   Con::addVariable( "$GUI::distanceFieldAsyncGlyphs", TypeBool, &GFontDistanceField::smAsyncGeneration,
+      "If true, distance field glyphs for CJK characters are generated on the thread pool. "
+      "Their metrics are available at once but they are not drawn until they are ready.\n"
+      "@ingroup Font\n" );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Turns the supersampled rasterization of one glyph into its field.
+struct GFontDistanceField::GlyphWorkItem : public ThreadPool::WorkItem
+{
+   UTF16 mChar;
+   S32 mSourceWidth;
+   S32 mSourceHeight;
+   S32 mTargetWidth;
+   S32 mTargetHeight;
+   U8 *mSource;
+   U8 *mField;
+
+   GlyphWorkItem( UTF16 ch, U8 *source, S32 targetWidth, S32 targetHeight )
+      : mChar( ch ),
+        mSourceWidth( targetWidth * RasterScale ),
+        mSourceHeight( targetHeight * RasterScale ),
+        mTargetWidth( targetWidth ),
+        mTargetHeight( targetHeight ),
+        mSource( source ),
+        mField( new U8[ targetWidth * targetHeight ] )
+   {
+   }
+
+   ~GlyphWorkItem()
+   {
+      SAFE_DELETE_ARRAY( mSource );
+      SAFE_DELETE_ARRAY( mField );
+   }
+
+protected:
+   virtual void execute()
+   {
+      GFXUtil::DistanceField::makeDistanceField( mSource, mSourceWidth, mSourceHeight,
+         mField, mTargetWidth, mTargetHeight, F32( Spread * RasterScale ) );
+   }
+};
+
+//-----------------------------------------------------------------------------
+
+GFontDistanceField::GFontDistanceField()
+{
+   VECTOR_SET_ASSOCIATION(mGlyphList);
+   VECTOR_SET_ASSOCIATION(mTextureSheets);
+   VECTOR_SET_ASSOCIATION(mPendingItems);
+
+   for (U32 i = 0; i < (sizeof(mRemapTable) / sizeof(S32)); i++)
+      mRemapTable[i] = -1;
+
+   mCurX = mCurY = mCurRowHeight = 0;
+   mCurSheet = -1;
+
+   mPlatformFont = NULL;
+   mCharSet = 0;
+   mHeight = 0.0f;
+   mBaseline = 0.0f;
+   mNeedSave = false;
+}
+
+GFontDistanceField::~GFontDistanceField()
+{
+   if(mNeedSave)
+      save();
+
+   for(S32 i = 0; i < smAtlases.size(); i++)
+   {
+      if(smAtlases[i] == this)
+      {
+         smAtlases.erase_fast(i);
+         break;
+      }
+   }
+
+   // Work items own their buffers, so any still running simply finish and
+   // release themselves.
+   mPendingItems.clear();
+
+   for(S32 i = 0; i < mTextureSheets.size(); i++)
+      mTextureSheets[i] = NULL;
+
+   SAFE_DELETE(mPlatformFont);
+}
+
+GFontDistanceField* GFontDistanceField::find(const String &faceName, U32 charset, const char *cacheDirectory)
+{
+   for(S32 i = 0; i < smAtlases.size(); i++)
+   {
+      if(smAtlases[i]->mCharSet == charset && smAtlases[i]->mFaceName.equal(faceName, String::NoCase))
+         return smAtlases[i];
+   }
+
+   if( !cacheDirectory )
+      cacheDirectory = Con::getVariable( "$GUI::fontCacheDirectory" );
+
+   const Torque::Path path( String::ToString("%s/%s (%s).sdf",
+      cacheDirectory, faceName.c_str(), getCharSetName(charset)) );
+
+   GFontDistanceField *atlas = NULL;
+
+   // A prebuilt atlas works without the platform font, it just can't grow.
+   if(Platform::isFile(path.getFullPath().c_str()))
+   {
+      FileStream stream;
+      stream.open(path, Torque::FS::File::Read);
+
+      if(stream.getStatus() == Stream::Ok)
+      {
+         atlas = new GFontDistanceField;
+         if(!atlas->read(stream))
+         {
+            Con::errorf("GFontDistanceField::find - error reading '%s'", path.getFullPath().c_str());
+            SAFE_DELETE(atlas);
+         }
+      }
+   }
+
+   PlatformFont *platFont = createPlatformFont(faceName, FieldSize * RasterScale, charset);
+
+   if(atlas == NULL)
+   {
+      if(platFont == NULL)
+         return NULL;
+
+      atlas = new GFontDistanceField;
+      atlas->mFaceName = faceName;
+      atlas->mCharSet = charset;
+      atlas->mHeight = F32(platFont->getFontHeight()) / RasterScale;
+      atlas->mBaseline = F32(platFont->getFontBaseLine()) / RasterScale;
+   }
+
+   atlas->mPlatformFont = platFont;
+   atlas->mPath = path;
+
+   smAtlases.push_back(atlas);
+   return atlas;
+}
+
+void GFontDistanceField::dumpInfo() const
+{
+   Con::printf("   '%s' distance field atlas", mFaceName.c_str());
+   Con::printf("      - %d texture sheets, %d glyphs, %d pending.", mTextureSheets.size(), mGlyphList.size(), mPendingItems.size());
+   Con::printf("      - Platform font is %s.", (mPlatformFont ? "present" : "not present") );
+}
+
+//-----------------------------------------------------------------------------
+
+bool GFontDistanceField::isValidChar(const UTF16 ch) const
+{
+   if(mRemapTable[ch] != -1)
+      return true;
+
+   if(mPlatformFont)
+      return mPlatformFont->isValidChar(ch);
+
+   return false;
+}
+
+bool GFontDistanceField::_isDeferredChar(const UTF16 ch)
+{
+   // CJK radicals through unified ideographs, Hangul syllables and the
+   // compatibility ideographs; these faces have far too many glyphs to
+   // generate inline on first use.
+   return (ch >= 0x2E80 && ch <= 0x9FFF) ||
+          (ch >= 0xAC00 && ch <= 0xD7AF) ||
+          (ch >= 0xF900 && ch <= 0xFAFF);
+}
+
+const GFontDistanceField::Glyph* GFontDistanceField::getGlyph(const UTF16 ch)
+{
+   PROFILE_SCOPE(GFontDistanceField_getGlyph);
+
+   if(mRemapTable[ch] == -1)
+   {
+      if(!mPlatformFont || !mPlatformFont->isValidChar(ch))
+         return NULL;
+
+      _generateGlyph(ch, smAsyncGeneration && _isDeferredChar(ch));
+   }
+
+   return &mGlyphList[mRemapTable[ch]];
+}
+
+void GFontDistanceField::_generateGlyph(const UTF16 ch, bool async)
+{
+   // The CharInfo returned by the platform font is static data, copy what
+   // we need out of it before anything else rasterizes.
+   const PlatformFont::CharInfo &ci = mPlatformFont->getCharInfo(ch);
+
+   Glyph glyph;
+   glyph.bitmapIndex = -1;
+   glyph.xOffset = glyph.yOffset = 0;
+   glyph.width = glyph.height = 0;
+   glyph.xOrigin = F32(ci.xOrigin) / RasterScale;
+   glyph.yOrigin = F32(ci.yOrigin) / RasterScale;
+   glyph.xIncrement = F32(ci.xIncrement) / RasterScale;
+   glyph.pending = false;
+
+   mNeedSave = true;
+
+   if(!ci.bitmapData || !ci.width || !ci.height)
+   {
+      mGlyphList.push_back(glyph);
+      mRemapTable[ch] = mGlyphList.size() - 1;
+      return;
+   }
+
+   // Pad the source by the spread and round it up to whole field pixels.
+   const S32 pad = Spread * RasterScale;
+   const S32 targetWidth = (ci.width + 2 * pad + RasterScale - 1) / RasterScale;
+   const S32 targetHeight = (ci.height + 2 * pad + RasterScale - 1) / RasterScale;
+   const S32 sourceWidth = targetWidth * RasterScale;
+   const S32 sourceHeight = targetHeight * RasterScale;
+
+   U8 *source = new U8[sourceWidth * sourceHeight];
+   dMemset(source, 0, sourceWidth * sourceHeight);
+   for(S32 y = 0; y < ci.height; y++)
+      dMemcpy(source + (y + pad) * sourceWidth + pad, ci.bitmapData + y * ci.width, ci.width);
+
+   glyph.width = targetWidth;
+   glyph.height = targetHeight;
+   glyph.xOrigin = F32(ci.xOrigin - pad) / RasterScale;
+   glyph.yOrigin = F32(ci.yOrigin + pad) / RasterScale;
+
+   GlyphWorkItem *item = new GlyphWorkItem(ch, source, targetWidth, targetHeight);
+
+   if(async)
+   {
+      glyph.pending = true;
+      mGlyphList.push_back(glyph);
+      mRemapTable[ch] = mGlyphList.size() - 1;
+
+      mPendingItems.push_back(item);
+      ThreadPool::GLOBAL().queueWorkItem(item);
+      return;
+   }
+
+   // Run it right here; the reference releases the item when we're done.
+   ThreadSafeRef<GlyphWorkItem> ref(item);
+   item->process();
+
+   _packGlyph(glyph, item->mField);
+   mGlyphList.push_back(glyph);
+   mRemapTable[ch] = mGlyphList.size() - 1;
+}
+
+void GFontDistanceField::processPending()
+{
+   for(S32 i = 0; i < mPendingItems.size(); )
+   {
+      GlyphWorkItem *item = mPendingItems[i];
+      if(!item->hasExecuted())
+      {
+         i++;
+         continue;
+      }
+
+      Glyph &glyph = mGlyphList[mRemapTable[item->mChar]];
+      glyph.pending = false;
+      _packGlyph(glyph, item->mField);
+
+      mPendingItems.erase_fast(i);
+   }
+}
+
+void GFontDistanceField::_packGlyph(Glyph &glyph, const U8 *field)
+{
+   // Leave a texel between glyphs so bilinear filtering doesn't bleed.
+   const S32 width = glyph.width + 1;
+   const S32 height = glyph.height + 1;
+
+   if(mCurSheet == -1)
+      _addSheet();
+
+   if(mCurX + width > TextureSheetSize)
+   {
+      mCurX = 0;
+      mCurY += mCurRowHeight;
+      mCurRowHeight = 0;
+   }
+
+   if(mCurY + height > TextureSheetSize)
+      _addSheet();
+
+   glyph.bitmapIndex = mCurSheet;
+   glyph.xOffset = mCurX;
+   glyph.yOffset = mCurY;
+
+   mCurX += width;
+   mCurRowHeight = getMax(mCurRowHeight, height);
+
+   GBitmap *bmp = mTextureSheets[mCurSheet].getBitmap();
+   for(S32 y = 0; y < glyph.height; y++)
+      dMemcpy(bmp->getAddress(glyph.xOffset, glyph.yOffset + y), field + y * glyph.width, glyph.width);
+
+   mTextureSheets[mCurSheet].refresh();
+   mNeedSave = true;
+}
+
+void GFontDistanceField::_addSheet()
+{
+   GBitmap *bitmap = new GBitmap(TextureSheetSize, TextureSheetSize, false, GFXFormatA8);
+
+   // Zero is as far outside a glyph as the field goes.
+   dMemset(bitmap->getWritableBits(), 0, sizeof(U8) * TextureSheetSize * TextureSheetSize);
+
+   GFXTexHandle handle = GFXTexHandle( bitmap, &GFXFontTextureProfile, true, avar("%s() - (line %d)", __FUNCTION__, __LINE__) );
+   mTextureSheets.push_back(handle);
+
+   mCurX = 0;
+   mCurY = 0;
+   mCurRowHeight = 0;
+   mCurSheet = mTextureSheets.size() - 1;
+}
+
+//-----------------------------------------------------------------------------
+
+bool GFontDistanceField::read(Stream& io_rStream)
+{
+   U32 version;
+   io_rStream.read(&version);
+   if(version != csm_fileVersion)
+      return false;
+
+   char buf[256];
+   io_rStream.readString(buf);
+   mFaceName = buf;
+
+   io_rStream.read(&mCharSet);
+   io_rStream.read(&mHeight);
+   io_rStream.read(&mBaseline);
+
+   U32 size = 0;
+   io_rStream.read(&size);
+   mGlyphList.setSize(size);
+   for(U32 i = 0; i < size; i++)
+   {
+      U16 ch;
+      io_rStream.read(&ch);
+
+      Glyph &glyph = mGlyphList[i];
+      io_rStream.read(&glyph.bitmapIndex);
+      io_rStream.read(&glyph.xOffset);
+      io_rStream.read(&glyph.yOffset);
+      io_rStream.read(&glyph.width);
+      io_rStream.read(&glyph.height);
+      io_rStream.read(&glyph.xOrigin);
+      io_rStream.read(&glyph.yOrigin);
+      io_rStream.read(&glyph.xIncrement);
+      glyph.pending = false;
+
+      mRemapTable[ch] = i;
+   }
+
+   U32 numSheets = 0;
+   io_rStream.read(&numSheets);
+
+   for(U32 i = 0; i < numSheets; i++)
+   {
+      GBitmap *bmp = new GBitmap;
+      if(!bmp->readBitmap("png", io_rStream))
+      {
+         delete bmp;
+         return false;
+      }
+      GFXTexHandle handle = GFXTexHandle(bmp, &GFXFontTextureProfile, true, avar("%s() - Read Distance Field Sheet for %s (line %d)", __FUNCTION__, mFaceName.c_str(), __LINE__));
+      mTextureSheets.push_back(handle);
+   }
+
+   io_rStream.read(&mCurX);
+   io_rStream.read(&mCurY);
+   io_rStream.read(&mCurRowHeight);
+   io_rStream.read(&mCurSheet);
+
+   return (io_rStream.getStatus() == Stream::Ok);
+}
+
+bool GFontDistanceField::write(Stream& stream)
+{
+   stream.write(csm_fileVersion);
+
+   stream.write(mFaceName);
+   stream.write(mCharSet);
+   stream.write(mHeight);
+   stream.write(mBaseline);
+
+   // Glyphs still being generated are left out; they'll be regenerated the
+   // next time they are used.
+   U32 size = 0;
+   for(U32 i = 0; i < 65536; i++)
+   {
+      if(mRemapTable[i] != -1 && !mGlyphList[mRemapTable[i]].pending)
+         size++;
+   }
+
+   stream.write(size);
+   for(U32 i = 0; i < 65536; i++)
+   {
+      if(mRemapTable[i] == -1 || mGlyphList[mRemapTable[i]].pending)
+         continue;
+
+      const Glyph &glyph = mGlyphList[mRemapTable[i]];
+      stream.write(U16(i));
+      stream.write(glyph.bitmapIndex);
+      stream.write(glyph.xOffset);
+      stream.write(glyph.yOffset);
+      stream.write(glyph.width);
+      stream.write(glyph.height);
+      stream.write(glyph.xOrigin);
+      stream.write(glyph.yOrigin);
+      stream.write(glyph.xIncrement);
+   }
+
+   stream.write(U32(mTextureSheets.size()));
+   for(S32 i = 0; i < mTextureSheets.size(); i++)
+      mTextureSheets[i].getBitmap()->writeBitmap("png", stream);
+
+   stream.write(mCurX);
+   stream.write(mCurY);
+   stream.write(mCurRowHeight);
+   stream.write(mCurSheet);
+
+   return (stream.getStatus() == Stream::Ok);
+}
+
+bool GFontDistanceField::save()
+{
+   FileStream stream;
+   stream.open(mPath, Torque::FS::File::Write);
+
+   if(stream.getStatus() != Stream::Ok || !write(stream))
+   {
+      Con::errorf("GFontDistanceField::save - could not write '%s'", mPath.getFullPath().c_str());
+      return false;
+   }
+
+   mNeedSave = false;
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+DefineEngineFunction( populateDistanceFieldFontRange, void, ( const char *faceName, U32 rangeStart, U32 rangeEnd ),,
+   "Generate the distance field atlas of a font face for the Unicode code points in "
+   "the specified range and write it to the font cache directory.  Shipping the "
+   "resulting .sdf file avoids generating glyphs at runtime.\n"
+   "@param faceName The name of the font face.\n"
+   "@param rangeStart The start Unicode point.\n"
+   "@param rangeEnd The end Unicode point.\n"
+   "@note We only support BMP-0, so code points range from 0 to 65535.\n"
+   "@ingroup Font\n" )
+{
+   StrongRefPtr<GFontDistanceField> atlas = GFontDistanceField::find(faceName, TGE_ANSI_CHARSET);
+
+   if(atlas == NULL)
+   {
+      Con::errorf("populateDistanceFieldFontRange - could not load font '%s'", faceName);
+      return;
+   }
+
+   if(rangeStart > rangeEnd || rangeEnd > 0xFFFF)
+   {
+      Con::errorf("populateDistanceFieldFontRange - invalid range");
+      return;
+   }
+
+   if(!atlas->hasPlatformFont())
+   {
+      Con::errorf("populateDistanceFieldFontRange - font '%s' has no platform font. Cannot generate more characters.", faceName);
+      return;
+   }
+
+   // Prebuilding doesn't need to keep the frame rate up.
+   const bool async = GFontDistanceField::smAsyncGeneration;
+   GFontDistanceField::smAsyncGeneration = false;
+
+   for(U32 i = rangeStart; i <= rangeEnd; i++)
+   {
+      if(i && atlas->isValidChar(i))
+         atlas->getGlyph(i);
+   }
+
+   GFontDistanceField::smAsyncGeneration = async;
+
+   if(atlas->save())
+      Con::printf("populateDistanceFieldFontRange - wrote '%s'", atlas->getPath().getFullPath().c_str());
+}
@@ -0,0 +1,159 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _GFONTDISTANCEFIELD_H_
+#define _GFONTDISTANCEFIELD_H_
+
+#ifndef _REFBASE_H_
+#include "core/util/refBase.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+#ifndef _PATH_H_
+#include "core/util/path.h"
+#endif
+#ifndef _PLATFORMFONT_H_
+#include "platform/platformFont.h"
+#endif
+#ifndef _GFXTEXTUREHANDLE_H_
+#include "gfx/gfxTextureHandle.h"
+#endif
+#ifndef _THREADPOOL_H_
+#include "platform/threads/threadPool.h"
+#endif
+
+class Stream;
+
+/// A signed distance field glyph atlas shared by every size of a font face.
+///
+/// Glyphs are rasterized once at RasterScale times the field size and reduced
+/// with GFXUtil::DistanceField, so all GFonts of the same face and charset
+/// draw from one set of sheets and scale them at render time.  Atlases are
+/// written next to the bitmap font cache and can be prebuilt offline with
+/// populateDistanceFieldFontRange().
+class GFontDistanceField : public StrongRefBase
+{
+public:
+   enum Constants
+   {
+      FieldSize = 32,         ///< Font size the field is stored at.
+      RasterScale = 4,        ///< Supersampling of the source rasterization.
+      Spread = 4,             ///< Distance encoded around each edge, in field pixels.
+      TextureSheetSize = 512,
+   };
+
+   /// Placement and metrics of a glyph, in field pixels.  The box includes
+   /// the spread on every side.
+   struct Glyph
+   {
+      S16 bitmapIndex;        ///< Sheet index, -1 if blank or still pending.
+      U16 xOffset;
+      U16 yOffset;
+      U16 width;
+      U16 height;
+      F32 xOrigin;
+      F32 yOrigin;
+      F32 xIncrement;
+      bool pending;           ///< Field is still being generated.
+   };
+
+   /// Generate CJK glyph fields on the thread pool instead of inline.
+   static bool smAsyncGeneration;
+
+   ~GFontDistanceField();
+
+   /// Return the atlas for a face, loading it from the cache directory or
+   /// creating it from the platform font.  Returns NULL if neither works.
+   static GFontDistanceField* find(const String &faceName, U32 charset, const char *cacheDirectory = 0);
+
+   /// Return the glyph for a character, generating it if needed, or NULL
+   /// if the face has no such character.  The pointer is only valid until
+   /// the next glyph is added.
+   const Glyph* getGlyph(const UTF16 ch);
+
+   bool isValidChar(const UTF16 ch) const;
+
+   /// Pack glyphs whose fields have finished generating on the thread pool.
+   void processPending();
+
+   GFXTexHandle getTextureHandle(S32 index) const { return mTextureSheets[index]; }
+
+   F32 getHeight() const   { return mHeight; }
+   F32 getBaseline() const { return mBaseline; }
+
+   const String& getFontFaceName() const { return mFaceName; }
+   U32 getFontCharSet() const { return mCharSet; }
+   const Torque::Path& getPath() const { return mPath; }
+   bool hasPlatformFont() const { return mPlatformFont != NULL; }
+
+   /// Dump information about this atlas to the console.
+   void dumpInfo() const;
+
+   bool read(Stream& io_rStream);
+   bool write(Stream& io_rStream);
+
+   /// Write the atlas to its cache file.
+   bool save();
+
+protected:
+   struct GlyphWorkItem;
+
+   GFontDistanceField();
+
+   void _generateGlyph(const UTF16 ch, bool async);
+   void _packGlyph(Glyph &glyph, const U8 *field);
+   void _addSheet();
+
+   static bool _isDeferredChar(const UTF16 ch);
+
+private:
+   static const U32 csm_fileVersion;
+
+   /// All live atlases, one per face and charset.
+   static Vector<GFontDistanceField*> smAtlases;
+
+   PlatformFont *mPlatformFont;
+   Vector<GFXTexHandle> mTextureSheets;
+
+   S32 mCurX;
+   S32 mCurY;
+   S32 mCurRowHeight;
+   S32 mCurSheet;
+
+   bool mNeedSave;
+   Torque::Path mPath;
+   String mFaceName;
+   U32 mCharSet;
+
+   F32 mHeight;
+   F32 mBaseline;
+
+   Vector<Glyph> mGlyphList;
+   Vector<ThreadSafeRef<GlyphWorkItem> > mPendingItems;
+
+   /// Index remapping, as in GFont.
+   S32 mRemapTable[65536];
+};
+
+#endif // _GFONTDISTANCEFIELD_H_
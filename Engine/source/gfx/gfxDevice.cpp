@@ -35,12 +35,16 @@
 #include "gfx/screenshot.h"
 #include "gfx/gfxStringEnumTranslate.h"
 #include "gfx/gfxTextureManager.h"
+#include "gfx/gfxTimerQuery.h"
+#include "gfx/gfxOcclusionQuery.h"
+#include "gfx/gfxGPUTimings.h"
 
 #include "core/frameAllocator.h"
 #include "core/stream/fileStream.h"
 #include "core/strings/unicode.h"
 #include "core/util/journal/process.h"
 #include "core/util/safeDelete.h"
+#include "platform/profiler.h"
 #include "math/util/frustum.h"
 #include "console/consoleTypes.h"
 #include "console/engineAPI.h"
@@ -71,6 +75,11 @@ void GFXDevice::initConsole()
       "them to return only the visibile state.\n"
       "@ingroup GFX\n" );
 
+   Con::addVariable( "$gfx::gpuTimings", TypeBool, &GFXGPUTimings::smEnabled,
+      "Enables GPU timer queries around render bins, shadow maps, post effects "
+      "and the GUI.  Read the results with getGPUTimings().\n"
+      "@ingroup GFX\n" );
+
    Con::addVariable( "$pref::Video::disableVerticalSync", TypeBool, &smDisableVSync,
       "Disables vertical sync on the active device.\n"
       "@note The video mode must be reset for the change to take affect.\n"
@@ -181,6 +190,18 @@ GFXDevice::GFXDevice()
    // Initialize our drawing utility.
    mDrawer = NULL;
    mFrameTime = PlatformTimer::create();
+
+   for ( U32 i=0; i < GPUTraceQueryCount; i++ )
+   {
+      mGPUTraceQueries[i] = NULL;
+      mGPUTraceStartTimes[i] = 0;
+   }
+   mGPUTraceIndex = 0;
+   mGPUTraceActive = false;
+   mTrackSceneGPUTime = false;
+   mSceneGPUMs = 0.0f;
+   mGPUTimings = new GFXGPUTimings( this );
+
    // Add a few system wide shader macros.
    GFXShader::addGlobalMacro( "TORQUE", "1" );
    GFXShader::addGlobalMacro( "TORQUE_VERSION", String::ToString(getVersionNumber()) );
@@ -244,6 +265,30 @@ void GFXDevice::preDestroy()
 {
    // Delete draw util
    SAFE_DELETE( mDrawer );
+
+   for ( U32 i=0; i < GPUTraceQueryCount; i++ )
+      SAFE_DELETE( mGPUTraceQueries[i] );
+   mGPUTimings->releaseQueries();
+
+   for ( U32 i=0; i < mFreeOcclusionQueries.size(); i++ )
+      delete mFreeOcclusionQueries[i];
+   mFreeOcclusionQueries.clear();
+}
+
+GFXOcclusionQuery* GFXDevice::allocOcclusionQuery()
+{
+   if ( mFreeOcclusionQueries.empty() )
+      return createOcclusionQuery();
+
+   GFXOcclusionQuery *query = mFreeOcclusionQueries.last();
+   mFreeOcclusionQueries.pop_back();
+   return query;
+}
+
+void GFXDevice::freeOcclusionQuery( GFXOcclusionQuery *query )
+{
+   if ( query )
+      mFreeOcclusionQueries.push_back( query );
 }
 
 GFXDevice::~GFXDevice()
@@ -277,6 +322,7 @@ GFXDevice::~GFXDevice()
 
    SAFE_DELETE( mTextureManager );
    SAFE_DELETE( mFrameTime );
+   SAFE_DELETE( mGPUTimings );
 
    // Clear out our state block references
    mCurrentStateBlocks.clear();
@@ -306,12 +352,23 @@ GFXStateBlockRef GFXDevice::createStateBlock(const GFXStateBlockDesc& desc)
    PROFILE_SCOPE( GFXDevice_CreateStateBlock );
 
    U32 hashValue = desc.getHashValue();
-   if (mCurrentStateBlocks[hashValue])
-      return mCurrentStateBlocks[hashValue];
+   StateBlockMap::Iterator iter = mCurrentStateBlocks.find(hashValue);
+   if (iter != mCurrentStateBlocks.end())
+   {
+      if (iter->value->getDesc() == desc)
+         return iter->value;
+
+      // Two different descriptions with the same hash, the block
+      // can't be shared so give this one its own uncached block.
+      AssertWarn(false, "GFXDevice::createStateBlock - State block hash collision!");
+      GFXStateBlockRef result = createStateBlockInternal(desc);
+      result->registerResourceWithDevice(this);
+      return result;
+   }
 
    GFXStateBlockRef result = createStateBlockInternal(desc);
    result->registerResourceWithDevice(this);   
-   mCurrentStateBlocks[hashValue] = result;
+   mCurrentStateBlocks.insert(hashValue, result);
    return result;
 }
 
@@ -505,6 +562,7 @@ void GFXDevice::updateStates(bool forceSetAll /*=false*/)
    if (mStateBlockDirty)
    {
       setStateBlockInternal(mNewStateBlock, false);
+      mDeviceStatistics.mStateBlockChanges++;
       mCurrentStateBlock = mNewStateBlock;
       mStateBlockDirty = false;
    }
@@ -519,6 +577,7 @@ void GFXDevice::updateStates(bool forceSetAll /*=false*/)
          if(!mTextureDirty[i])
             continue;
          mTextureDirty[i] = false;
+         mDeviceStatistics.mTextureBinds++;
 
          switch (mTexType[i])
          {
@@ -811,10 +870,22 @@ inline bool GFXDevice::beginScene()
 
    mDeviceStatistics.clear();
 
+   // Swap in textures which finished streaming.
+   mTextureManager->updateStreaming();
+
+   // Upload atlas pages which got new textures.
+   mTextureManager->updateAtlases();
+
    // Send the start of frame signal.
    getDeviceEventSignal().trigger( GFXDevice::deStartOfFrame );
    mFrameTime->reset();
-   return beginSceneInternal();
+
+   if ( !beginSceneInternal() )
+      return false;
+
+   _beginGPUTrace();
+   mGPUTimings->beginFrame();
+   return true;
 }
 
 inline void GFXDevice::endScene()
@@ -824,10 +895,85 @@ inline void GFXDevice::endScene()
    // End frame signal
    getDeviceEventSignal().trigger( GFXDevice::deEndOfFrame );
 
+   mGPUTimings->endFrame();
+   _endGPUTrace();
    endSceneInternal();
    mDeviceStatistics.exportToConsole();
 }
 
+void GFXDevice::_beginGPUTrace()
+{
+   mGPUTraceActive = false;
+
+   // Timer queries can't nest, so leave the GPU to the per zone timings
+   // and total up the zones of the last frame they read back instead.
+   if ( GFXGPUTimings::smEnabled )
+   {
+      const Vector<GFXGPUTimings::Result> &results = mGPUTimings->getResults();
+      if ( results.empty() )
+         return;
+
+      mSceneGPUMs = 0.0f;
+      for ( U32 i=0; i < results.size(); i++ )
+         mSceneGPUMs += results[i].ms;
+
+      return;
+   }
+
+   bool capturing = false;
+#ifdef TORQUE_ENABLE_PROFILER
+   capturing = ProfilerTrace::isCapturing();
+#endif
+
+   if ( !capturing && !mTrackSceneGPUTime )
+      return;
+
+   GFXTimerQuery*& query = mGPUTraceQueries[mGPUTraceIndex];
+   if ( !query )
+   {
+      query = createTimerQuery();
+      if ( !query )
+         return;
+   }
+
+   // Hand in the result from the last time around.  If the GPU is lagging
+   // behind that far, skip timing this scene rather than stalling.
+   U64 duration;
+   switch ( query->getStatus( false, &duration ) )
+   {
+      case GFXTimerQuery::Waiting:
+         return;
+      case GFXTimerQuery::Ready:
+         mSceneGPUMs = F32( duration ) / 1000000.0f;
+#ifdef TORQUE_ENABLE_PROFILER
+         if ( capturing && mGPUTraceStartTimes[mGPUTraceIndex] != 0 )
+            ProfilerTrace::recordGPUZone( "GFXDevice_Scene", mGPUTraceStartTimes[mGPUTraceIndex], duration );
+#endif
+         break;
+      default:
+         break;
+   }
+
+   mGPUTraceStartTimes[mGPUTraceIndex] = 0;
+#ifdef TORQUE_ENABLE_PROFILER
+   if ( capturing )
+      mGPUTraceStartTimes[mGPUTraceIndex] = ProfilerTrace::getTimestamp();
+#endif
+
+   query->begin();
+   mGPUTraceActive = true;
+}
+
+void GFXDevice::_endGPUTrace()
+{
+   if ( !mGPUTraceActive )
+      return;
+
+   mGPUTraceQueries[mGPUTraceIndex]->end();
+   mGPUTraceIndex = ( mGPUTraceIndex + 1 ) % GPUTraceQueryCount;
+   mGPUTraceActive = false;
+}
+
 inline void GFXDevice::beginField()
 {
    AssertFatal( mCanCurrentlyRender == true, "GFXDevice::beginField() - The scene has not yet begun!" );
@@ -64,6 +64,8 @@ class GFXCardProfiler;
 class GFXDrawUtil;
 class GFXFence;
 class GFXOcclusionQuery;
+class GFXTimerQuery;
+class GFXGPUTimings;
 class GFXPrimitiveBuffer;
 class GFXShader;
 class GFXStateBlock;
@@ -455,8 +457,21 @@ public:
 
    /// Returns the current GFXDeviceStatistics, stats are cleared every ::beginScene call.
    GFXDeviceStatistics* getDeviceStatistics() { return &mDeviceStatistics; }
+
+   /// Returns the per zone GPU timings, see GFXGPUTimings::smEnabled.
+   GFXGPUTimings* getGPUTimings() { return mGPUTimings; }
+
+   /// Enables timing of whole scenes on the GPU outside
+   /// of profiler trace captures.
+   void setTrackSceneGPUTime( bool track ) { mTrackSceneGPUTime = track; }
+
+   /// Returns the GPU time in milliseconds of the newest scene that has been
+   /// read back or zero if none has.  The result lags a few frames behind.
+   /// @see setTrackSceneGPUTime
+   F32 getSceneGPUMs() const { return mSceneGPUMs; }
 protected:
    GFXDeviceStatistics mDeviceStatistics;
+   GFXGPUTimings *mGPUTimings;
 
    /// This is a helper method for describeResourcesToFile.  It walks through the
    /// GFXResource list and sorts it by item type, putting the resources into the proper vector.
@@ -834,6 +849,38 @@ public:
    virtual void endField();
    PlatformTimer *mFrameTime;
 
+protected:
+
+   /// @name GPU Trace
+   /// Timer queries bracketing each scene while a ProfilerTrace capture
+   /// is running or the scene GPU time is tracked.  Results are read back
+   /// when the slot comes around again.
+   /// @{
+
+   /// Occlusion queries released to the pool.
+   /// @see allocOcclusionQuery
+   Vector<GFXOcclusionQuery*> mFreeOcclusionQueries;
+
+   enum { GPUTraceQueryCount = 4 };
+
+   GFXTimerQuery* mGPUTraceQueries[ GPUTraceQueryCount ];
+   U64 mGPUTraceStartTimes[ GPUTraceQueryCount ];
+   U32 mGPUTraceIndex;
+   bool mGPUTraceActive;
+
+   /// Is the scene GPU time wanted outside of trace captures.
+   bool mTrackSceneGPUTime;
+
+   /// The GPU time of the last scene read back in milliseconds.
+   F32 mSceneGPUMs;
+
+   void _beginGPUTrace();
+   void _endGPUTrace();
+
+   /// @}
+
+public:
+
    virtual GFXTexHandle & getFrontBuffer(){ return mFrontBuffer[mCurrentFrontBufferIdx]; }
 
    void setPrimitiveBuffer( GFXPrimitiveBuffer *buffer );
@@ -921,6 +968,18 @@ public:
    /// Returns a hardware occlusion query object or NULL
    /// if this device does not support them.   
    virtual GFXOcclusionQuery* createOcclusionQuery() { return NULL; }
+
+   /// Returns an occlusion query from the pool, creating one if the pool is
+   /// empty, or NULL if this device does not support them.
+   /// @see freeOcclusionQuery
+   GFXOcclusionQuery* allocOcclusionQuery();
+
+   /// Returns a query from allocOcclusionQuery() to the pool.
+   void freeOcclusionQuery( GFXOcclusionQuery *query );
+
+   /// Returns a GPU timer query object or NULL if this
+   /// device does not support them.
+   virtual GFXTimerQuery* createTimerQuery() { return NULL; }
    
    /// @name Light Settings
    /// NONE of these should be overridden by API implementations
@@ -1081,6 +1140,7 @@ public:
       GSModColorTexture,
       GSAddColorTexture,
       GSTargetRestore,
+      GSDistanceField,     ///< Alpha from a distance field texture, for GFont atlases.
       GS_COUNT
    };
 
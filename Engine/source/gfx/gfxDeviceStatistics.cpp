@@ -36,6 +36,10 @@ void GFXDeviceStatistics::setPrefix(const String& prefix)
    vnPolyCount = prefix + "polyCount";
    vnDrawCalls = prefix + "drawCalls";
    vnRenderTargetChanges = prefix + "renderTargetChanges";
+   vnStateBlockChanges = prefix + "stateBlockChanges";
+   vnTextureBinds = prefix + "textureBinds";
+   vnShaderConstUploads = prefix + "shaderConstUploads";
+   vnBufferLocks = prefix + "bufferLocks";
 }
 
 /// Clear stats
@@ -44,6 +48,10 @@ void GFXDeviceStatistics::clear()
    mPolyCount = 0;
    mDrawCalls = 0;
    mRenderTargetChanges = 0;
+   mStateBlockChanges = 0;
+   mTextureBinds = 0;
+   mShaderConstUploads = 0;
+   mBufferLocks = 0;
 }
 
 /// Copy from source (should just be a memcpy, but that may change later) used in 
@@ -54,6 +62,10 @@ void GFXDeviceStatistics::start(GFXDeviceStatistics * source)
    mPolyCount = source->mPolyCount;
    mDrawCalls = source->mDrawCalls;
    mRenderTargetChanges = source->mRenderTargetChanges;
+   mStateBlockChanges = source->mStateBlockChanges;
+   mTextureBinds = source->mTextureBinds;
+   mShaderConstUploads = source->mShaderConstUploads;
+   mBufferLocks = source->mBufferLocks;
 }
 
 /// Used with start to get a subset of stats on a device.  Basically will do
@@ -63,6 +75,10 @@ void GFXDeviceStatistics::end(GFXDeviceStatistics * source)
    mPolyCount = source->mPolyCount - mPolyCount;
    mDrawCalls = source->mDrawCalls - mDrawCalls;
    mRenderTargetChanges = source->mRenderTargetChanges - mRenderTargetChanges;   
+   mStateBlockChanges = source->mStateBlockChanges - mStateBlockChanges;
+   mTextureBinds = source->mTextureBinds - mTextureBinds;
+   mShaderConstUploads = source->mShaderConstUploads - mShaderConstUploads;
+   mBufferLocks = source->mBufferLocks - mBufferLocks;
 }
 
 /// Exports the stats to the console
@@ -71,4 +87,8 @@ void GFXDeviceStatistics::exportToConsole()
    Con::setIntVariable(vnPolyCount, mPolyCount);
    Con::setIntVariable(vnDrawCalls, mDrawCalls);
    Con::setIntVariable(vnRenderTargetChanges, mRenderTargetChanges);
+   Con::setIntVariable(vnStateBlockChanges, mStateBlockChanges);
+   Con::setIntVariable(vnTextureBinds, mTextureBinds);
+   Con::setIntVariable(vnShaderConstUploads, mShaderConstUploads);
+   Con::setIntVariable(vnBufferLocks, mBufferLocks);
 }
\ No newline at end of file
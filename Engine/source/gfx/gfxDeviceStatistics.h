@@ -34,6 +34,14 @@ public:
    S32 mPolyCount;
    S32 mDrawCalls;
    S32 mRenderTargetChanges;
+   S32 mStateBlockChanges;
+   S32 mTextureBinds;
+
+   /// Number of constant buffer or uniform uploads; what counts as one
+   /// upload depends on the device.
+   S32 mShaderConstUploads;
+
+   S32 mBufferLocks;
 
    GFXDeviceStatistics();
 
@@ -57,6 +65,10 @@ private:
    String vnPolyCount;
    String vnDrawCalls;
    String vnRenderTargetChanges;
+   String vnStateBlockChanges;
+   String vnTextureBinds;
+   String vnShaderConstUploads;
+   String vnBufferLocks;
 };
 
 #endif
\ No newline at end of file
@@ -53,6 +53,11 @@ FontRenderBatcher::FontRenderBatcher() : mStorage(8096)
 
       f.setColorWrites(true, true, true, false); // NOTE: comment this out if alpha write is needed
       mFontSB = GFX->createStateBlock(f);
+
+      // Distance fields are scaled, so they need filtering to keep edges smooth.
+      f.samplers[0].magFilter = GFXTextureFilterLinear;
+      f.samplers[0].minFilter = GFXTextureFilterLinear;
+      mDistanceFieldSB = GFX->createStateBlock(f);
    }
 }
 
@@ -61,7 +66,10 @@ void FontRenderBatcher::render( F32 rot, const Point2F &offset )
    if( mLength == 0 )
       return;
 
-   GFX->setStateBlock(mFontSB);
+   const bool distanceField = mFont->isDistanceField();
+   const F32 fieldScale = mFont->getDistanceFieldScale();
+
+   GFX->setStateBlock(distanceField ? mDistanceFieldSB : mFontSB);
    for(U32 i = 0; i < GFX->getNumSamplers(); i++)
       GFX->setTexture(i, NULL);
 
@@ -92,25 +100,54 @@ void FontRenderBatcher::render( F32 rot, const Point2F &offset )
       {
          // Get some general info to proceed with...
          const CharMarker &m = mSheets[i]->charIndex[j];
-         const PlatformFont::CharInfo &ci = mFont->getCharInfo( m.c );
 
-         // Where are we drawing it?
-         F32 drawY = offset.y + mFont->getBaseline() - ci.yOrigin * TEXT_MAG;
-         F32 drawX = offset.x + m.x + ci.xOrigin;
+         // Where are we drawing it, and from where?  Distance field glyphs
+         // come from the face's atlas and are scaled to the font size.
+         F32 drawX, drawY, drawWidth, drawHeight;
+         U32 srcX, srcY, srcWidth, srcHeight;
+
+         if(distanceField)
+         {
+            const GFontDistanceField::Glyph *glyph = mFont->getDistanceField()->getGlyph( m.c );
+
+            drawX = offset.x + m.x + glyph->xOrigin * fieldScale;
+            drawY = offset.y + mFont->getBaseline() - glyph->yOrigin * fieldScale;
+            drawWidth = glyph->width * fieldScale;
+            drawHeight = glyph->height * fieldScale;
+
+            srcX = glyph->xOffset;
+            srcY = glyph->yOffset;
+            srcWidth = glyph->width;
+            srcHeight = glyph->height;
+         }
+         else
+         {
+            const PlatformFont::CharInfo &ci = mFont->getCharInfo( m.c );
+
+            drawX = offset.x + m.x + ci.xOrigin;
+            drawY = offset.y + mFont->getBaseline() - ci.yOrigin * TEXT_MAG;
+            drawWidth = ci.width * TEXT_MAG;
+            drawHeight = ci.height * TEXT_MAG;
+
+            srcX = ci.xOffset;
+            srcY = ci.yOffset;
+            srcWidth = ci.width;
+            srcHeight = ci.height;
+         }
 
          // Figure some values.
          const F32 texWidth = (F32)tex->getWidth();
          const F32 texHeight = (F32)tex->getHeight();
-         const F32 texLeft   = (F32)(ci.xOffset)             / texWidth;
-         const F32 texRight  = (F32)(ci.xOffset + ci.width)  / texWidth;
-         const F32 texTop    = (F32)(ci.yOffset)             / texHeight;
-         const F32 texBottom = (F32)(ci.yOffset + ci.height) / texHeight;
+         const F32 texLeft   = (F32)(srcX)             / texWidth;
+         const F32 texRight  = (F32)(srcX + srcWidth)  / texWidth;
+         const F32 texTop    = (F32)(srcY)             / texHeight;
+         const F32 texBottom = (F32)(srcY + srcHeight) / texHeight;
 
          const F32 fillConventionOffset = GFX->getFillConventionOffset();
          const F32 screenLeft   = drawX - fillConventionOffset;
-         const F32 screenRight  = drawX - fillConventionOffset + ci.width * TEXT_MAG;
+         const F32 screenRight  = drawX - fillConventionOffset + drawWidth;
          const F32 screenTop    = drawY - fillConventionOffset;
-         const F32 screenBottom = drawY - fillConventionOffset + ci.height * TEXT_MAG;
+         const F32 screenBottom = drawY - fillConventionOffset + drawHeight;
 
          // Build our vertices. We NEVER read back from the buffer, that's
          // incredibly slow, so for rotation do it into tmp. This code is
@@ -178,7 +215,7 @@ void FontRenderBatcher::render( F32 rot, const Point2F &offset )
    AssertFatal(currentPt <= mLength * 6, "FontRenderBatcher::render - too many verts for length of string!");
 
    GFX->setVertexBuffer(verts);
-   GFX->setupGenericShaders( GFXDevice::GSAddColorTexture );
+   GFX->setupGenericShaders( distanceField ? GFXDevice::GSDistanceField : GFXDevice::GSAddColorTexture );
 
    // Now do an optimal render!
    for( S32 i = 0; i < mSheets.size(); i++ )
@@ -197,9 +234,13 @@ void FontRenderBatcher::render( F32 rot, const Point2F &offset )
 void FontRenderBatcher::queueChar( UTF16 c, S32 &currentX, GFXVertexColor &currentColor )
 {
    const PlatformFont::CharInfo &ci = mFont->getCharInfo( c );
-   U32 sidx = ci.bitmapIndex;
+   S32 sidx = ci.bitmapIndex;
+
+   // Glyphs still being generated take up their space but aren't drawn yet.
+   if( mFont->isDistanceField() )
+      sidx = mFont->getDistanceField()->getGlyph( c )->bitmapIndex;
 
-   if( ci.width != 0 && ci.height != 0 )
+   if( ci.width != 0 && ci.height != 0 && sidx >= 0 )
    {
       SheetMarker &sm = getSheetMarker(sidx);
 
@@ -246,4 +287,7 @@ void FontRenderBatcher::init( GFont *font, U32 n )
 
    mFont = font;
    mLength = n;
+
+   if( mFont->isDistanceField() )
+      mFont->getDistanceField()->processPending();
 }
\ No newline at end of file
@@ -51,6 +51,7 @@ class FontRenderBatcher
    GFont *mFont;
    U32 mLength;
    GFXStateBlockRef mFontSB;
+   GFXStateBlockRef mDistanceFieldSB;
 
    SheetMarker &getSheetMarker(U32 sheetID);
 
@@ -0,0 +1,247 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "gfx/gfxGPUTimings.h"
+
+#include "gfx/gfxTimerQuery.h"
+#include "console/engineAPI.h"
+
+
+bool GFXGPUTimings::smEnabled = false;
+
+
+GFXGPUTimings::GFXGPUTimings( GFXDevice *device )
+   : mDevice( device ),
+     mFrameIndex( 0 ),
+     mFrameActive( false ),
+     mDepth( 0 ),
+     mSegmentOpen( false )
+{
+   for ( U32 i=0; i < FrameCount; i++ )
+   {
+      mFrames[i].numUsed = 0;
+      mFrames[i].numRead = 0;
+   }
+}
+
+GFXGPUTimings::~GFXGPUTimings()
+{
+   releaseQueries();
+}
+
+void GFXGPUTimings::releaseQueries()
+{
+   for ( U32 i=0; i < FrameCount; i++ )
+   {
+      Frame &frame = mFrames[i];
+      for ( U32 j=0; j < frame.segments.size(); j++ )
+         SAFE_DELETE( frame.segments[j].query );
+
+      frame.segments.clear();
+      frame.numUsed = 0;
+      frame.numRead = 0;
+   }
+
+   mPending.clear();
+   mFrameActive = false;
+   mSegmentOpen = false;
+   mDepth = 0;
+}
+
+void GFXGPUTimings::beginFrame()
+{
+   mFrameActive = false;
+   mSegmentOpen = false;
+   mDepth = 0;
+
+   if ( !smEnabled )
+   {
+      mResults.clear();
+      return;
+   }
+
+   PROFILE_SCOPE( GFXGPUTimings_beginFrame );
+
+   // Read back whatever finished since we last looked.  Results are
+   // consumed when read, so remember how far we got.
+   Frame &frame = mFrames[mFrameIndex];
+   while ( frame.numRead < frame.numUsed )
+   {
+      const Segment &segment = frame.segments[frame.numRead];
+
+      U64 nanoseconds = 0;
+      GFXTimerQuery::TimerQueryStatus status = GFXTimerQuery::Unset;
+      if ( segment.query )
+         status = segment.query->getStatus( false, &nanoseconds );
+
+      if ( status == GFXTimerQuery::Waiting )
+         return;
+
+      if ( status == GFXTimerQuery::Ready )
+         _addResult( segment, nanoseconds );
+      else if ( segment.first )
+         _addResult( segment, 0 );
+
+      frame.numRead++;
+   }
+
+   if ( frame.numUsed )
+   {
+      mResults = mPending;
+      mPending.clear();
+   }
+
+   frame.numUsed = 0;
+   frame.numRead = 0;
+   mFrameActive = true;
+}
+
+void GFXGPUTimings::endFrame()
+{
+   if ( !mFrameActive )
+      return;
+
+   if ( mSegmentOpen )
+      _endSegment();
+
+   mDepth = 0;
+   mFrameActive = false;
+   mFrameIndex = ( mFrameIndex + 1 ) % FrameCount;
+}
+
+void GFXGPUTimings::begin( StringTableEntry name )
+{
+   if ( !mFrameActive )
+      return;
+
+   if ( mDepth < MaxDepth )
+   {
+      if ( mSegmentOpen )
+         _endSegment();
+
+      mStack[mDepth] = name;
+      _beginSegment( name, true );
+   }
+
+   mDepth++;
+}
+
+void GFXGPUTimings::end()
+{
+   // Zones entered before the frame started are not tracked.
+   if ( !mFrameActive || mDepth == 0 )
+      return;
+
+   mDepth--;
+   if ( mDepth >= MaxDepth )
+      return;
+
+   if ( mSegmentOpen )
+      _endSegment();
+
+   if ( mDepth > 0 )
+      _beginSegment( mStack[mDepth-1], false );
+}
+
+void GFXGPUTimings::_beginSegment( StringTableEntry name, bool first )
+{
+   Frame &frame = mFrames[mFrameIndex];
+   if ( frame.numUsed >= MaxSegments )
+      return;
+
+   if ( frame.numUsed == frame.segments.size() )
+   {
+      Segment segment;
+      segment.query = mDevice->createTimerQuery();
+      frame.segments.push_back( segment );
+   }
+
+   Segment &segment = frame.segments[frame.numUsed++];
+   segment.name = name;
+   segment.first = first;
+
+   if ( segment.query )
+      segment.query->begin();
+
+   mSegmentOpen = true;
+}
+
+void GFXGPUTimings::_endSegment()
+{
+   Frame &frame = mFrames[mFrameIndex];
+   GFXTimerQuery *query = frame.segments[frame.numUsed-1].query;
+   if ( query )
+      query->end();
+
+   mSegmentOpen = false;
+}
+
+void GFXGPUTimings::_addResult( const Segment &segment, U64 nanoseconds )
+{
+   Result *result = NULL;
+   for ( U32 i=0; i < mPending.size(); i++ )
+   {
+      if ( mPending[i].name == segment.name )
+      {
+         result = &mPending[i];
+         break;
+      }
+   }
+
+   if ( !result )
+   {
+      mPending.increment();
+      result = &mPending.last();
+      result->name = segment.name;
+      result->ms = 0.0f;
+      result->count = 0;
+   }
+
+   result->ms += F32( F64( nanoseconds ) / 1000000.0 );
+   if ( segment.first )
+      result->count++;
+}
+
+//-----------------------------------------------------------------------------
+
+DefineEngineFunction( getGPUTimings, String, (),,
+   "Returns the GPU time spent in each render bin, shadow map pass, post effect "
+   "and the GUI during a recent frame.\n"
+   "Timings are only taken while $gfx::gpuTimings is true and the frame they are "
+   "from lags a few frames behind.\n"
+   "@return One line per zone of the form \"name\\tmilliseconds\\tcount\", where "
+   "count is the number of times the zone was entered.  Time spent in nested zones "
+   "is not included in their parents.\n"
+   "@ingroup GFX\n" )
+{
+   if ( !GFXDevice::devicePresent() )
+      return String();
+
+   const Vector<GFXGPUTimings::Result> &results = GFX->getGPUTimings()->getResults();
+
+   String str;
+   for ( U32 i=0; i < results.size(); i++ )
+      str += String::ToString( "%s\t%.3f\t%d\n", results[i].name, results[i].ms, results[i].count );
+
+   return str;
+}
@@ -0,0 +1,195 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _GFXGPUTIMINGS_H_
+#define _GFXGPUTIMINGS_H_
+
+#ifndef _GFXDEVICE_H_
+#include "gfx/gfxDevice.h"
+#endif
+
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+#ifndef _STRINGTABLE_H_
+#include "core/stringTable.h"
+#endif
+
+
+class GFXTimerQuery;
+
+
+/// Measures the GPU time spent in named zones of a frame, such as render
+/// bins, shadow maps, post effects and the GUI.
+///
+/// Timer queries cannot be nested, so each zone is split into segments: when
+/// a zone begins inside another one, the outer zone's segment ends and a new
+/// one starts again once the inner zone is done.  The times reported for a
+/// zone therefore exclude the time of the zones nested in it.
+///
+/// Queries are kept in a ring of frames and only read back once the ring
+/// wraps around.  If the GPU lags further behind than that, the frame is not
+/// timed rather than stalling on the results.
+///
+/// Timings are only taken while #smEnabled is set ($gfx::gpuTimings) and
+/// replace the scene wide GPU zone of the profiler trace while they are.
+///
+/// @see GFXGPUTimingScope
+class GFXGPUTimings
+{
+public:
+
+   enum Constants
+   {
+      /// Number of frames whose queries can be in flight.
+      FrameCount = 4,
+
+      /// Deepest zone nesting that is timed.  Deeper zones are folded into
+      /// their parents.
+      MaxDepth = 8,
+
+      /// Most segments timed in a frame.
+      MaxSegments = 256,
+   };
+
+   struct Result
+   {
+      StringTableEntry name;
+
+      /// GPU time in milliseconds.
+      F32 ms;
+
+      /// Number of times the zone was entered.
+      U32 count;
+   };
+
+   static bool smEnabled;
+
+protected:
+
+   struct Segment
+   {
+      StringTableEntry name;
+      GFXTimerQuery *query;
+
+      /// True for the first segment of a zone.
+      bool first;
+   };
+
+   struct Frame
+   {
+      Vector<Segment> segments;
+
+      /// Number of segments issued this time around.
+      U32 numUsed;
+
+      /// Number of issued segments already read back.
+      U32 numRead;
+   };
+
+   GFXDevice *mDevice;
+
+   Frame mFrames[FrameCount];
+   U32 mFrameIndex;
+
+   /// Whether the current frame is being timed.
+   bool mFrameActive;
+
+   /// Names of the open zones.
+   StringTableEntry mStack[MaxDepth];
+
+   /// Number of open zones, which may exceed MaxDepth.
+   U32 mDepth;
+
+   /// Whether a segment is running.
+   bool mSegmentOpen;
+
+   /// Results of the frame being read back.
+   Vector<Result> mPending;
+
+   /// Results of the last frame read back.
+   Vector<Result> mResults;
+
+   void _beginSegment( StringTableEntry name, bool first );
+   void _endSegment();
+   void _addResult( const Segment &segment, U64 nanoseconds );
+
+public:
+
+   GFXGPUTimings( GFXDevice *device );
+   ~GFXGPUTimings();
+
+   /// Called by GFXDevice::beginScene.  Reads back the oldest frame in the
+   /// ring and starts timing if its queries are done.
+   void beginFrame();
+
+   /// Called by GFXDevice::endScene.  Closes all open zones.
+   void endFrame();
+
+   /// Whether the current frame is being timed.
+   bool isActive() const { return mFrameActive; }
+
+   /// Enter a zone.  @a name must be a StringTable entry.
+   void begin( StringTableEntry name );
+
+   /// Leave the zone entered last.
+   void end();
+
+   /// Returns the zones of the newest frame that has been read back in the
+   /// order they were first entered.
+   const Vector<Result>& getResults() const { return mResults; }
+
+   /// Deletes all queries.
+   void releaseQueries();
+};
+
+
+/// Times the rest of the current scope as a GFXGPUTimings zone on the
+/// active device.
+class GFXGPUTimingScope
+{
+   bool mActive;
+
+public:
+
+   GFXGPUTimingScope( const char *name )
+      : mActive( GFXGPUTimings::smEnabled && GFXDevice::devicePresent() && GFX->getGPUTimings()->isActive() )
+   {
+      if ( mActive )
+         GFX->getGPUTimings()->begin( StringTable->insert( name ) );
+   }
+
+   ~GFXGPUTimingScope()
+   {
+      if ( mActive )
+         GFX->getGPUTimings()->end();
+   }
+};
+
+/// Times the rest of the current scope as a GPU timing zone.
+///
+/// @param name   The name of the zone.
+///
+#define GFXGPUTIMING_SCOPE( name ) GFXGPUTimingScope gfxGPUTimingScopeObj( name )
+
+#endif // _GFXGPUTIMINGS_H_
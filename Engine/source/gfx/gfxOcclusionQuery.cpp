@@ -41,3 +41,102 @@ String GFXOcclusionQuery::statusToString( OcclusionQueryStatus status )
 
    return outStr;
 }
+
+//-----------------------------------------------------------------------------
+
+GFXOcclusionQueryHandle::GFXOcclusionQueryHandle()
+   :  mNumPending( 0 ),
+      mNextSerial( 1 ),
+      mLastSerial( 0 ),
+      mLastStatus( GFXOcclusionQuery::Unset ),
+      mLastData( 0 )
+{
+   dMemset( mSlots, 0, sizeof( mSlots ) );
+}
+
+GFXOcclusionQueryHandle::~GFXOcclusionQueryHandle()
+{
+   for ( U32 i = 0; i < MaxQueriesInFlight; i++ )
+   {
+      if ( !mSlots[i].query )
+         continue;
+
+      if ( GFXDevice::devicePresent() )
+         GFX->freeOcclusionQuery( mSlots[i].query );
+      else
+         delete mSlots[i].query;
+   }
+}
+
+void GFXOcclusionQueryHandle::getLastStatus( GFXOcclusionQuery::OcclusionQueryStatus *statusPtr, U32 *data )
+{
+   for ( U32 i = 0; mNumPending > 0 && i < MaxQueriesInFlight; i++ )
+   {
+      Slot &slot = mSlots[i];
+      if ( !slot.pending )
+         continue;
+
+      U32 pixels = 0;
+      GFXOcclusionQuery::OcclusionQueryStatus status = slot.query->getStatus( false, &pixels );
+
+      if ( status == GFXOcclusionQuery::Waiting && ++slot.polls < MaxPendingPolls )
+         continue;
+
+      slot.pending = false;
+      mNumPending--;
+
+      // Results can come back out of order, keep the newest.
+      if (  ( status == GFXOcclusionQuery::Occluded || status == GFXOcclusionQuery::NotOccluded ) &&
+            slot.serial > mLastSerial )
+      {
+         mLastSerial = slot.serial;
+         mLastStatus = status;
+         mLastData = pixels;
+      }
+   }
+
+   if ( statusPtr )
+      *statusPtr = mLastStatus;
+   if ( data )
+      *data = mLastData;
+}
+
+GFXOcclusionQuery* GFXOcclusionQueryHandle::getQuery()
+{
+   if ( isWaiting() )
+      return NULL;
+
+   for ( U32 i = 0; i < MaxQueriesInFlight; i++ )
+   {
+      Slot &slot = mSlots[i];
+      if ( slot.pending )
+         continue;
+
+      if ( !slot.query )
+      {
+         slot.query = GFX->allocOcclusionQuery();
+         if ( !slot.query )
+            return NULL;
+      }
+
+      slot.serial = mNextSerial++;
+      slot.polls = 0;
+      slot.pending = true;
+      mNumPending++;
+
+      return slot.query;
+   }
+
+   return NULL;
+}
+
+void GFXOcclusionQueryHandle::clearLastStatus()
+{
+   for ( U32 i = 0; i < MaxQueriesInFlight; i++ )
+      mSlots[i].pending = false;
+
+   mNumPending = 0;
+   mLastSerial = mNextSerial - 1;
+   mLastStatus = GFXOcclusionQuery::Unset;
+   mLastData = 0;
+}
@@ -82,71 +82,87 @@ public:
    virtual const String describeSelf() const = 0;
 };
 
-/// Handle for GFXOcclusionQuery than store last valid state
+/// Handle to a ring of occlusion queries which never waits on the GPU.
+///
+/// A new query can be issued while the results of earlier ones are still on
+/// their way, up to MaxQueriesInFlight of them, so visibility can be tested
+/// every frame without stalling.  getLastStatus() returns the newest result
+/// which has come back, typically a frame or two old.
+///
+/// The queries come from the pool of the device and go back to it when the
+/// handle is destroyed.
+///
+/// @see GFXDevice::allocOcclusionQuery
 class GFXOcclusionQueryHandle
 {
 public:
 
-    GFXOcclusionQueryHandle() 
-        : mLastStatus(GFXOcclusionQuery::Unset), mLastData(0), mWaiting(false) , mQuery(NULL)
-    {}
-
-    ~GFXOcclusionQueryHandle()
-    {
-        SAFE_DELETE(mQuery);
-    }
-
-    bool getLastStatus( bool block, GFXOcclusionQuery::OcclusionQueryStatus *statusPtr = NULL, U32 *data = NULL );
-    GFXOcclusionQuery* getQuery() const { return mQuery; }
-
-    void clearLastStatus()
-    {
-        mLastStatus = GFXOcclusionQuery::Unset;
-        mLastData = 0;
-        mWaiting = false;
+   enum Constants
+   {
+      /// Queries which can be waiting on the GPU at the same time.
+      MaxQueriesInFlight = 3,
+
+      /// Polls after which a query that hasn't come back is given up on,
+      /// as happens when it was never rendered.
+      MaxPendingPolls = 16,
+   };
+
+   GFXOcclusionQueryHandle();
+   ~GFXOcclusionQueryHandle();
+
+   /// Reads back the queries which have finished and returns the newest result.
+   ///
+   /// The status is Unset until the first result comes back or if the device
+   /// has no occlusion queries.  Callers should fall back to treating the
+   /// object as visible, or to another test, in that case.
+   ///
+   /// @param statusPtr  The newest status.
+   /// @param data       The number of pixels rendered for the newest status.
+   void getLastStatus( GFXOcclusionQuery::OcclusionQueryStatus *statusPtr = NULL, U32 *data = NULL );
+
+   /// Returns a query to render this frame or NULL if all of them are in
+   /// flight or the device has no occlusion queries.
+   ///
+   /// Each call takes another query from the ring, so only call this once
+   /// the query is certain to be rendered.
+   GFXOcclusionQuery* getQuery();
+
+   /// Returns true if no query can be issued until an earlier one comes back.
+   bool isWaiting() const { return mNumPending >= MaxQueriesInFlight; }
+
+   /// Forgets the last result and gives up on the queries in flight.
+   void clearLastStatus();
 
-        if( !mQuery )
-            return;
+protected:
 
-        mQuery->begin();
-        mQuery->end();
-    }
+   struct Slot
+   {
+      GFXOcclusionQuery *query;
 
-    bool isWaiting() const { return mWaiting; }
-protected:
-    GFXOcclusionQuery::OcclusionQueryStatus mLastStatus;
-    U32 mLastData;
-    bool mWaiting;
-    GFXOcclusionQuery *mQuery;
-};
+      /// Order in which the query was issued.
+      U32 serial;
 
-inline bool GFXOcclusionQueryHandle::getLastStatus( bool block, GFXOcclusionQuery::OcclusionQueryStatus *statusPtr, U32 *data )
-{
-    if( !mQuery )
-        mQuery = GFX->createOcclusionQuery();
+      /// Times the query was polled without coming back.
+      U32 polls;
 
-    GFXOcclusionQuery::OcclusionQueryStatus status = mQuery->getStatus( block, data );
+      bool pending;
+   };
 
-    if( status == GFXOcclusionQuery::Waiting )
-    {
-        mWaiting = true;
-        if( statusPtr )
-            *statusPtr = mLastStatus;
-        if( data )
-            *data = mLastData;
+   Slot mSlots[MaxQueriesInFlight];
+   U32 mNumPending;
 
-        return true;
-    }
+   /// Serial of the next issued query and of the last result.
+   U32 mNextSerial;
+   U32 mLastSerial;
 
-    if( statusPtr )
-        *statusPtr = status;
+   GFXOcclusionQuery::OcclusionQueryStatus mLastStatus;
+   U32 mLastData;
 
-    mWaiting = false;
-    mLastStatus = status;
-    mLastData = *data;
+private:
 
-    return true;
-}
+   GFXOcclusionQueryHandle( const GFXOcclusionQueryHandle& );
+   GFXOcclusionQueryHandle& operator=( const GFXOcclusionQueryHandle& );
+};
 
 
 #endif // _GFXOCCLUSIONQUERY_H_
\ No newline at end of file
@@ -99,12 +99,48 @@ GFXStateBlockDesc::GFXStateBlockDesc()
    textureFactor.set( 255, 255, 255, 255 );
 }
 
+/// Every member of GFXStateBlockDesc, used by the hash and the comparison
+/// so they can't get out of sync.  Hashing the struct as raw memory would
+/// include the padding after the bools, which isn't initialized, and let
+/// equal descriptions end up in different state blocks.
+#define GFX_STATEBLOCKDESC_FIELDS( FIELD ) \
+   FIELD( blendDefined ) FIELD( blendEnable ) FIELD( blendSrc ) FIELD( blendDest ) FIELD( blendOp ) \
+   FIELD( separateAlphaBlendDefined ) FIELD( separateAlphaBlendEnable ) FIELD( separateAlphaBlendSrc ) \
+   FIELD( separateAlphaBlendDest ) FIELD( separateAlphaBlendOp ) \
+   FIELD( alphaDefined ) FIELD( alphaTestEnable ) FIELD( alphaTestRef ) FIELD( alphaTestFunc ) \
+   FIELD( colorWriteDefined ) FIELD( colorWriteRed ) FIELD( colorWriteBlue ) FIELD( colorWriteGreen ) FIELD( colorWriteAlpha ) \
+   FIELD( cullDefined ) FIELD( cullMode ) \
+   FIELD( zDefined ) FIELD( zEnable ) FIELD( zWriteEnable ) FIELD( zFunc ) FIELD( zBias ) FIELD( zSlopeBias ) \
+   FIELD( stencilDefined ) FIELD( stencilEnable ) FIELD( stencilFailOp ) FIELD( stencilZFailOp ) FIELD( stencilPassOp ) \
+   FIELD( stencilFunc ) FIELD( stencilRef ) FIELD( stencilMask ) FIELD( stencilWriteMask ) \
+   FIELD( ffLighting ) FIELD( vertexColorEnable ) FIELD( fillMode ) \
+   FIELD( samplersDefined ) FIELD( samplers ) FIELD( textureFactor )
+
 // This method just needs to return a unique value based on its contents.
 U32 GFXStateBlockDesc::getHashValue() const
 {   
-   return CRC::calculateCRC(this, sizeof(GFXStateBlockDesc));
+   U32 crc = CRC::INITIAL_CRC_VALUE;
+
+   #define HASH_FIELD( f ) crc = CRC::calculateCRC( &f, sizeof( f ), crc );
+   GFX_STATEBLOCKDESC_FIELDS( HASH_FIELD )
+   #undef HASH_FIELD
+
+   return crc;
+}
+
+bool GFXStateBlockDesc::operator==( const GFXStateBlockDesc &desc ) const
+{
+   // GFXSamplerStateDesc and ColorI have no padding, so the
+   // array and the color can be compared as memory.
+   #define COMPARE_FIELD( f ) if ( dMemcmp( &f, &desc.f, sizeof( f ) ) != 0 ) return false;
+   GFX_STATEBLOCKDESC_FIELDS( COMPARE_FIELD )
+   #undef COMPARE_FIELD
+
+   return true;
 }
 
+#undef GFX_STATEBLOCKDESC_FIELDS
+
 /// Adds data from desc to this description, uses *defined parameters in desc to figure out
 /// what blocks of state to actually copy from desc.
 void GFXStateBlockDesc::addDesc(const GFXStateBlockDesc& desc)
@@ -170,6 +170,11 @@ struct GFXStateBlockDesc
    /// Returns the hash value of this state description
    U32 getHashValue() const;
 
+   /// Compares the states field by field, so padding bytes between
+   /// the members never make two equal descriptions differ.
+   bool operator==( const GFXStateBlockDesc &desc ) const;
+   bool operator!=( const GFXStateBlockDesc &desc ) const { return !( *this == desc ); }
+
    /// Adds data from desc to this description, uses *defined parameters in desc to figure out
    /// what blocks of state to actually copy from desc.
    void addDesc( const GFXStateBlockDesc& desc );
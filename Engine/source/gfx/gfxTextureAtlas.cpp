@@ -0,0 +1,215 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "gfx/gfxTextureAtlas.h"
+
+#include "gfx/gfxDevice.h"
+#include "gfx/gfxTextureManager.h"
+#include "gfx/bitmap/gBitmap.h"
+#include "core/util/safeDelete.h"
+#include "platform/profiler.h"
+
+
+GFXAtlasAllocator::GFXAtlasAllocator( U32 pageSize )
+   : mPageSize( pageSize )
+{
+   AssertFatal( isPow2( pageSize ) && getBinLog2( pageSize ) < MaxLevels,
+      "GFXAtlasAllocator - Bad page size!" );
+
+   reset();
+}
+
+void GFXAtlasAllocator::reset()
+{
+   for ( U32 i=0; i < MaxLevels; i++ )
+      mFree[i].clear();
+
+   mFree[0].push_back( Point2I( 0, 0 ) );
+}
+
+bool GFXAtlasAllocator::allocate( U32 size, Point2I *outPos )
+{
+   AssertFatal( isPow2( size ) && size <= mPageSize, "GFXAtlasAllocator::allocate - Bad block size!" );
+
+   const U32 level = getBinLog2( mPageSize ) - getBinLog2( size );
+
+   // Find the smallest free block which fits.
+   S32 found = level;
+   while ( found >= 0 && mFree[found].empty() )
+      found--;
+
+   if ( found < 0 )
+      return false;
+
+   // Split it down to the requested size keeping the
+   // first quarter and freeing the other three.
+   Point2I pos = mFree[found].last();
+   mFree[found].pop_back();
+
+   for ( U32 i = found + 1; i <= level; i++ )
+   {
+      const S32 half = mPageSize >> i;
+      mFree[i].push_back( Point2I( pos.x + half, pos.y + half ) );
+      mFree[i].push_back( Point2I( pos.x, pos.y + half ) );
+      mFree[i].push_back( Point2I( pos.x + half, pos.y ) );
+   }
+
+   *outPos = pos;
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+GFXTextureAtlas::GFXTextureAtlas( GFXTextureProfile *profile, U32 pageSize )
+   :  mProfile( profile ),
+      mPageSize( pageSize )
+{
+   AssertFatal( isPow2( pageSize ), "GFXTextureAtlas - The page size must be a power of two!" );
+}
+
+GFXTextureAtlas::~GFXTextureAtlas()
+{
+   for ( U32 i=0; i < mPages.size(); i++ )
+   {
+      SAFE_DELETE( mPages[i]->bitmap );
+      delete mPages[i];
+   }
+}
+
+GFXTextureObject* GFXTextureAtlas::find( const String &key, GFXAtlasEntry *outEntry ) const
+{
+   EntryMap::ConstIterator iter = mEntries.find( key );
+   if ( iter == mEntries.end() )
+      return NULL;
+
+   *outEntry = iter->value.entry;
+   return mPages[ iter->value.page ]->texture;
+}
+
+bool GFXTextureAtlas::canAdd( const GBitmap *bmp ) const
+{
+   const U32 size = bmp->getWidth();
+
+   if ( size != bmp->getHeight() || !isPow2( size ) || size > mPageSize / 2 )
+      return false;
+
+   switch ( bmp->getFormat() )
+   {
+      case GFXFormatR8G8B8:
+      case GFXFormatR8G8B8A8:
+      case GFXFormatR8G8B8X8:
+         return true;
+
+      default:
+         return false;
+   }
+}
+
+GFXTextureObject* GFXTextureAtlas::add( const String &key, const GBitmap *bmp, GFXAtlasEntry *outEntry )
+{
+   AssertFatal( mEntries.find( key ) == mEntries.end(), "GFXTextureAtlas::add - The texture is already in the atlas!" );
+
+   if ( !canAdd( bmp ) )
+      return NULL;
+
+   PROFILE_SCOPE( GFXTextureAtlas_add );
+
+   const U32 size = bmp->getWidth();
+
+   // Find a page with room for it.
+   U32 pageIdx = 0;
+   Point2I pos;
+   for ( ; pageIdx < mPages.size(); pageIdx++ )
+   {
+      if ( mPages[pageIdx]->allocator.allocate( size, &pos ) )
+         break;
+   }
+
+   if ( pageIdx == mPages.size() )
+   {
+      Page *page = new Page( mPageSize );
+      page->bitmap = new GBitmap( mPageSize, mPageSize, true, GFXFormatR8G8B8A8 );
+      dMemset( page->bitmap->getWritableBits(), 0, page->bitmap->getByteSize() );
+      page->allocator.allocate( size, &pos );
+      mPages.push_back( page );
+   }
+
+   Page *page = mPages[pageIdx];
+   _copyToPage( page, bmp, pos );
+
+   // New pages are uploaded right away, so there is a
+   // texture to return.  Others wait for update().
+   if ( page->texture.isNull() )
+   {
+      page->texture.set( page->bitmap, mProfile, false, avar( "%s() - page (line %d)", __FUNCTION__, __LINE__ ) );
+      page->dirty = false;
+   }
+   else
+      page->dirty = true;
+
+   Entry &entry = mEntries.findOrInsert( key )->value;
+   entry.page = pageIdx;
+   entry.entry.cell.set( pos.x / size, pos.y / size );
+   entry.entry.size = size;
+   entry.entry.pageSize = mPageSize;
+
+   *outEntry = entry.entry;
+   return page->texture;
+}
+
+void GFXTextureAtlas::_copyToPage( Page *page, const GBitmap *bmp, const Point2I &pos )
+{
+   const U32 size = bmp->getWidth();
+
+   // Build the mips of the entry on its own from the top
+   // level, so they never mix in texels of other entries.
+   GBitmap entry( size, size, false, bmp->getFormat() );
+   dMemcpy( entry.getWritableBits(), bmp->getBits(), size * size * bmp->getBytesPerPixel() );
+   entry.setFormat( GFXFormatR8G8B8A8 );
+   entry.extrudeMipLevels( false, mProfile->isSRGB() );
+
+   GBitmap *pageBmp = page->bitmap;
+   for ( U32 mip=0; mip < entry.getNumMipLevels(); mip++ )
+   {
+      const U32 mipSize = getMax( size >> mip, (U32)1 );
+      for ( U32 y=0; y < mipSize; y++ )
+         dMemcpy( pageBmp->getAddress( pos.x >> mip, ( pos.y >> mip ) + y, mip ),
+                  entry.getAddress( 0, y, mip ),
+                  mipSize * 4 );
+   }
+}
+
+void GFXTextureAtlas::update()
+{
+   for ( U32 i=0; i < mPages.size(); i++ )
+   {
+      Page *page = mPages[i];
+      if ( !page->dirty )
+         continue;
+
+      PROFILE_SCOPE( GFXTextureAtlas_update );
+
+      TEXMGR->_loadTexture( page->texture, page->bitmap );
+      page->dirty = false;
+   }
+}
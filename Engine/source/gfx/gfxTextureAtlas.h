@@ -0,0 +1,207 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _GFXTEXTUREATLAS_H_
+#define _GFXTEXTUREATLAS_H_
+
+#ifndef _GFXTEXTUREHANDLE_H_
+#include "gfx/gfxTextureHandle.h"
+#endif
+#ifndef _MPOINT4_H_
+#include "math/mPoint4.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+#ifndef _TDICTIONARY_H_
+#include "core/util/tDictionary.h"
+#endif
+
+
+class GBitmap;
+class GFXTextureProfile;
+
+
+/// The block of a GFXTextureAtlas page a texture was packed into.
+///
+/// Blocks are power of two squares aligned to their own size, which makes
+/// them look like one cell of a regular grid over the page.  The shader
+/// side of MFT_DiffuseMapAtlas, which was written for such grids (see
+/// Material::cellLayout), can then remap UVs into the block and pick the
+/// right mip of the page for it.
+struct GFXAtlasEntry
+{
+   /// Position of the block in units of #size.
+   Point2I cell;
+
+   /// Edge length of the block in pixels or zero if the texture
+   /// is not atlased.
+   U32 size;
+
+   /// Edge length of the page in pixels.
+   U32 pageSize;
+
+   GFXAtlasEntry()
+      :  cell( 0, 0 ),
+         size( 0 ),
+         pageSize( 0 )
+   {
+   }
+
+   bool isValid() const { return size != 0; }
+
+   /// Returns the value of the diffuseAtlasParams shader constant for
+   /// the entry.
+   Point4F getAtlasParams() const
+   {
+      const F32 scale = F32( size ) / F32( pageSize );
+      return Point4F( scale, scale, F32( size ), F32( getBinLog2( size ) ) );
+   }
+
+   /// Returns the value of the diffuseAtlasTileParams shader constant for
+   /// the entry.
+   Point4F getTileParams() const
+   {
+      return Point4F( F32( cell.x ), F32( cell.y ), 0.0f, 0.0f );
+   }
+};
+
+
+/// Hands out power of two squares of a square page aligned to their own
+/// size by splitting larger free blocks in four as needed.
+class GFXAtlasAllocator
+{
+public:
+
+   enum
+   {
+      MaxLevels = 16,
+   };
+
+   GFXAtlasAllocator( U32 pageSize );
+
+   /// Reserves a block with an edge length of @a size, which must be a
+   /// power of two no larger than the page.
+   ///
+   /// @return False if there is no free block that large.
+   bool allocate( U32 size, Point2I *outPos );
+
+   /// Frees all blocks.
+   void reset();
+
+   U32 getPageSize() const { return mPageSize; }
+
+protected:
+
+   U32 mPageSize;
+
+   /// The free blocks by level.  Blocks of level n have an
+   /// edge length of mPageSize >> n.
+   Vector<Point2I> mFree[MaxLevels];
+};
+
+
+/// Packs small square textures of one profile into a few large pages, so
+/// that materials using them all bind the same texture.
+///
+/// Every page keeps a full mip chain in system memory.  The mips of an
+/// entry are generated on its own and copied into the page mips at the
+/// matching offsets, so filtering of an entry never picks up texels of
+/// its neighbours as long as the mip is clamped to the size of the entry
+/// like MFT_DiffuseMapAtlas does.  Changed pages are uploaded once per
+/// frame in update().
+///
+/// Entries stay in the atlas until it is destroyed along with the
+/// texture manager.
+///
+/// @see GFXTextureManager::createAtlasTexture
+class GFXTextureAtlas
+{
+public:
+
+   GFXTextureAtlas( GFXTextureProfile *profile, U32 pageSize );
+   ~GFXTextureAtlas();
+
+   GFXTextureProfile* getProfile() const { return mProfile; }
+
+   /// Returns the page and entry of the texture added as @a key or
+   /// NULL if there is none.
+   GFXTextureObject* find( const String &key, GFXAtlasEntry *outEntry ) const;
+
+   /// Copies @a bmp into a free block of a page.  The bitmap must be
+   /// square, a power of two and no larger than half a page.
+   ///
+   /// @return The page texture or NULL if the bitmap cannot be atlased.
+   GFXTextureObject* add( const String &key, const GBitmap *bmp, GFXAtlasEntry *outEntry );
+
+   /// Returns true if @a bmp can be added to the atlas.
+   bool canAdd( const GBitmap *bmp ) const;
+
+   /// Uploads all pages changed since the last call.
+   void update();
+
+   U32 getPageCount() const { return mPages.size(); }
+
+   U32 getEntryCount() const { return mEntries.size(); }
+
+protected:
+
+   struct Page
+   {
+      GFXAtlasAllocator allocator;
+
+      /// The page contents with all mips.
+      GBitmap *bitmap;
+
+      GFXTexHandle texture;
+
+      /// True if the bitmap changed since the last upload.
+      bool dirty;
+
+      Page( U32 pageSize )
+         :  allocator( pageSize ),
+            bitmap( NULL ),
+            dirty( false )
+      {
+      }
+   };
+
+   struct Entry
+   {
+      U32 page;
+      GFXAtlasEntry entry;
+   };
+
+   GFXTextureProfile *mProfile;
+
+   U32 mPageSize;
+
+   Vector<Page*> mPages;
+
+   typedef HashTable<String,Entry> EntryMap;
+   EntryMap mEntries;
+
+   /// Copies the mips of @a bmp into the block of @a page at @a pos.
+   void _copyToPage( Page *page, const GBitmap *bmp, const Point2I &pos );
+};
+
+#endif // _GFXTEXTUREATLAS_H_
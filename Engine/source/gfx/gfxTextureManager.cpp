@@ -22,18 +22,22 @@
 
 #include "platform/platform.h"
 #include "gfx/gfxTextureManager.h"
+#include "gfx/gfxTextureAtlas.h"
 
 #include "gfx/gfxDevice.h"
 #include "gfx/gfxCardProfile.h"
 #include "gfx/gfxStringEnumTranslate.h"
 #include "gfx/bitmap/imageUtils.h"
+#include "gfx/bitmap/textureCooker.h"
 #include "core/strings/stringFunctions.h"
 #include "core/util/safeDelete.h"
 #include "core/resourceManager.h"
 #include "core/volume.h"
 #include "core/util/dxt5nmSwizzle.h"
 #include "console/consoleTypes.h"
+#include "platform/platformMemory.h"
 #include "console/engineAPI.h"
+#include "platform/threads/threadPool.h"
 
 using namespace Torque;
 
@@ -42,6 +46,15 @@ using namespace Torque;
 
 S32 GFXTextureManager::smTextureReductionLevel = 0;
 
+bool GFXTextureManager::smTextureStreaming = false;
+U32 GFXTextureManager::smStreamingBaseSize = 128;
+U32 GFXTextureManager::smStreamingBudget = 512;
+U32 GFXTextureManager::smStreamingKeepTime = 10000;
+F32 GFXTextureManager::smStreamingWorldSize = 4.0f;
+
+U32 GFXTextureManager::smAtlasPageSize = 1024;
+U32 GFXTextureManager::smAtlasMaxSize = 256;
+
 String GFXTextureManager::smMissingTexturePath(Con::getVariable("$Core::MissingTexturePath"));
 String GFXTextureManager::smUnavailableTexturePath(Con::getVariable("$Core::UnAvailableTexturePath"));
 String GFXTextureManager::smWarningTexturePath(Con::getVariable("$Core::WarningTexturePath"));
@@ -58,6 +71,52 @@ void GFXTextureManager::init()
       "as not allowing down scaling.\n"
       "@ingroup GFX\n" );
 
+   Con::addVariable( "$pref::Video::textureStreaming", TypeBool, &smTextureStreaming,
+      "If true, material textures stored as DDS files are loaded with their "
+      "top mips left out, which are then streamed in on worker threads as "
+      "they get close enough to need them.\n"
+      "@note Only affects textures loaded after the change.\n"
+      "@ingroup GFX\n" );
+
+   Con::addVariable( "$pref::Video::textureStreamingBaseSize", TypeS32, &smStreamingBaseSize,
+      "The largest size of the top mip which streamed textures are loaded "
+      "with up front.\n"
+      "@ingroup GFX\n" );
+
+   Con::addVariable( "$pref::Video::textureStreamingBudget", TypeS32, &smStreamingBudget,
+      "The video memory in megabytes which streamed textures may use.  When "
+      "exceeded, mips of the textures used least recently are dropped.  Zero "
+      "for no limit.\n"
+      "@ingroup GFX\n" );
+
+   Con::addVariable( "$pref::Video::textureStreamingKeepTime", TypeS32, &smStreamingKeepTime,
+      "The milliseconds after which streamed mips of textures that are no "
+      "longer rendered are dropped.\n"
+      "@ingroup GFX\n" );
+
+   Con::addVariable( "$pref::Video::textureStreamingWorldSize", TypeF32, &smStreamingWorldSize,
+      "The world units a streamed texture is assumed to repeat over when "
+      "estimating how many of its mips are visible on an object.  Larger "
+      "values load more detail.\n"
+      "@ingroup GFX\n" );
+
+   Con::addVariable( "$pref::Video::textureAtlasPageSize", TypeS32, &smAtlasPageSize,
+      "The edge length in pixels of the pages small textures with an atlas "
+      "profile are packed into.  Rounded up to a power of two.\n"
+      "@note Only affects atlases created after the change.\n"
+      "@ingroup GFX\n" );
+
+   Con::addVariable( "$pref::Video::textureAtlasMaxSize", TypeS32, &smAtlasMaxSize,
+      "The largest edge length in pixels of textures with an atlas profile "
+      "which are packed into atlas pages.  Larger textures are loaded on "
+      "their own.  Zero disables atlasing.\n"
+      "@ingroup GFX\n" );
+
+   Con::addVariable( "$pref::Video::mapDDSFiles", TypeBool, &DDSFile::smMapFiles,
+      "If true DDS files are mapped into memory and their mips are uploaded "
+      "straight from the mapping instead of being read into the heap first.\n"
+      "@ingroup GFX\n" );
+
    Con::addVariable( "$pref::Video::missingTexturePath", TypeRealString, &smMissingTexturePath,
       "The file path of the texture to display when the requested texture is missing.\n"
       "@ingroup GFX\n" );
@@ -77,18 +136,13 @@ GFXTextureManager::GFXTextureManager()
    mListHead = mListTail = NULL;
    mTextureManagerState = GFXTextureManager::Living;
 
-   // Set up the hash table
-   mHashCount = 1023;
-   mHashTable = new GFXTextureObject *[mHashCount];
-   for(U32 i = 0; i < mHashCount; i++)
-      mHashTable[i] = NULL;
+   mStreamingMemory = 0;
+   mLastStreamUpdate = 0;
 }
 
 GFXTextureManager::~GFXTextureManager()
 {
-   if( mHashTable )
-      SAFE_DELETE_ARRAY( mHashTable );
-
+   mTextureTable.clear();
    mCubemapTable.clear();
 }
 
@@ -117,6 +171,12 @@ void GFXTextureManager::kill()
 {
    AssertFatal( mTextureManagerState != GFXTextureManager::Dead, "Texture Manager already killed!" );
 
+   // Drop the atlas pages first so they go
+   // away with the rest of the cache.
+   for ( U32 i=0; i < mAtlases.size(); i++ )
+      delete mAtlases[i];
+   mAtlases.clear();
+
    // Release everything in the cache we can
    // so we don't leak any textures.
    cleanupCache();
@@ -134,6 +194,12 @@ void GFXTextureManager::kill()
 
    mCubemapTable.clear();
 
+   mStreamLoads.clear();
+   mStreamingTextures.clear();
+   mStreamingMemory = 0;
+
+   mPreloadedBitmaps.clear();
+
    mTextureManagerState = GFXTextureManager::Dead;
 }
 
@@ -294,6 +360,7 @@ GFXTextureObject *GFXTextureManager::_createTexture(  GBitmap *bmp,
                                                       GFXTextureObject *inObj )
 {
    PROFILE_SCOPE( GFXTextureManager_CreateTexture_Bitmap );
+   MEMORY_TAG_SCOPE( Textures );
    
    #ifdef DEBUG_SPEW
    Platform::outputDebugString( "[GFXTextureManager] _createTexture (GBitmap) '%s'",
@@ -319,7 +386,7 @@ GFXTextureObject *GFXTextureManager::_createTexture(  GBitmap *bmp,
       // We downscale the bitmap on the CPU... this is the reason
       // you should be using DDS which already has good looking mips.
       GBitmap *padBmp = bmp;
-      padBmp->extrudeMipLevels();
+      padBmp->extrudeMipLevels( false, profile->isSRGB() );
       scalePower = getMin( scalePower, padBmp->getNumMipLevels() - 1 );
 
       realWidth  = getMax( (U32)1, padBmp->getWidth() >> scalePower );
@@ -370,7 +437,7 @@ GFXTextureObject *GFXTextureManager::_createTexture(  GBitmap *bmp,
    {
       // NOTE: This should really be done by extruding mips INTO a DDS file instead
       // of modifying the gbitmap
-      realBmp->extrudeMipLevels(false); 
+      realBmp->extrudeMipLevels( false, profile->isSRGB() );
    }
 
    // If _validateTexParams kicked back a different format, than there needs to be
@@ -520,6 +587,7 @@ GFXTextureObject *GFXTextureManager::_createTexture(  DDSFile *dds,
                                                       GFXTextureObject *inObj )
 {
    PROFILE_SCOPE( GFXTextureManager_CreateTexture_DDS );
+   MEMORY_TAG_SCOPE( Textures );
 
    const char *fileName = dds->getTextureCacheString();
    if( !fileName )
@@ -641,6 +709,22 @@ GFXTextureObject *GFXTextureManager::createTexture( const Torque::Path &path, GF
    if( retTexObj )
       return retTexObj;
 
+   // Nothing ever samples a texture without a device, so don't pay for
+   // reading and decoding the image.  Callers still get a valid, named
+   // texture so they behave the same as with a real device.
+   if ( !GFXDevice::devicePresent() )
+   {
+      retTexObj = _createTextureObject( 1, 1, 0, GFXFormatR8G8B8A8, profile, 1 );
+      if ( retTexObj )
+      {
+         retTexObj->mTextureLookupName = pathNoExt;
+         retTexObj->mBitmapSize.set( 1, 1, 0 );
+         _linkTexture( retTexObj );
+      }
+
+      return retTexObj;
+   }
+
    const U32 scalePower = getTextureDownscalePower( profile );
 
    // If this is a valid file (has an extension) than load it
@@ -657,13 +741,19 @@ GFXTextureObject *GFXTextureManager::createTexture( const Torque::Path &path, GF
             retTexObj = createTexture( dds, profile, false );
          }
       }
-      else // Let GBitmap take care of it
+      else
       {
-         bitmap = GBitmap::load( correctPath );
-         if( bitmap != NULL )
+         retTexObj = _createCookedTexture( correctPath, pathNoExt, profile, scalePower );
+         if( retTexObj )
+            realPath = correctPath;
+         else // Let GBitmap take care of it
          {
-            realPath = bitmap.getPath();
-            retTexObj = createTexture( bitmap, pathNoExt, profile, false );
+            bitmap = GBitmap::load( correctPath );
+            if( bitmap != NULL )
+            {
+               realPath = bitmap.getPath();
+               retTexObj = createTexture( bitmap, pathNoExt, profile, false );
+            }
          }
       }      
    }
@@ -694,6 +784,16 @@ GFXTextureObject *GFXTextureManager::createTexture( const Torque::Path &path, GF
       // load.
    }
 
+   // Look for a cooked file of an image with this name
+   // before decoding the image itself.
+   Path sourcePath;
+   if( retTexObj == NULL && TextureCooker::canUseCooked( profile ) && GBitmap::sFindFile( correctPath, &sourcePath ) )
+   {
+      retTexObj = _createCookedTexture( sourcePath, pathNoExt, profile, scalePower );
+      if( retTexObj )
+         realPath = sourcePath;
+   }
+
    // If we still don't have a texture object yet, feed the correctPath to GBitmap and
    // it will try a bunch of extensions
    if( retTexObj == NULL )
@@ -710,6 +810,10 @@ GFXTextureObject *GFXTextureManager::createTexture( const Torque::Path &path, GF
 
    if ( retTexObj )
    {
+      // Cook the image for next time if asked to.
+      if (  bitmap != NULL && TextureCooker::smCookOnLoad && TextureCooker::canUseCooked( profile ) )
+         TextureCooker::cook( realPath, profile->getType() == GFXTextureProfile::NormalMap );
+
       // Store the path for later use.
       retTexObj->mPath = realPath;
 
@@ -935,7 +1039,7 @@ GBitmap *GFXTextureManager::loadUncompressedTexture(const Torque::Path &path, GF
                   isPow2(retBitmap->getHeight()) &&
                   profile->canDownscale())
                {
-                  retBitmap->extrudeMipLevels();
+                  retBitmap->extrudeMipLevels( false, profile->isSRGB() );
                   retBitmap->chopTopMips(scalePower);
                }
             }
@@ -992,7 +1096,7 @@ GBitmap *GFXTextureManager::loadUncompressedTexture(const Torque::Path &path, GF
             isPow2(retBitmap->getHeight()) &&
             profile->canDownscale())
          {
-            retBitmap->extrudeMipLevels();
+            retBitmap->extrudeMipLevels( false, profile->isSRGB() );
             retBitmap->chopTopMips(scalePower);
          }
       }
@@ -1204,9 +1308,8 @@ void GFXTextureManager::hashInsert( GFXTextureObject *object )
    if ( object->mTextureLookupName.isEmpty() )
       return;
       
-   U32 key = object->mTextureLookupName.getHashCaseInsensitive() % mHashCount;
-   object->mHashNext = mHashTable[key];
-   mHashTable[key] = object;
+   // The newest texture for a name is the one handed out by hashFind().
+   mTextureTable.findOrInsert( object->mTextureLookupName )->value = object;
 }
 
 void GFXTextureManager::hashRemove( GFXTextureObject *object )
@@ -1214,17 +1317,7 @@ void GFXTextureManager::hashRemove( GFXTextureObject *object )
    if ( object->mTextureLookupName.isEmpty() )
       return;
 
-   U32 key = object->mTextureLookupName.getHashCaseInsensitive() % mHashCount;
-   GFXTextureObject **walk = &mHashTable[key];
-   while(*walk)
-   {
-      if(*walk == object)
-      {
-         *walk = object->mHashNext;
-         break;
-      }
-      walk = &((*walk)->mHashNext);
-   }
+   mTextureTable.erase( object->mTextureLookupName, object );
 }
 
 GFXTextureObject* GFXTextureManager::hashFind( const String &name )
@@ -1232,15 +1325,11 @@ GFXTextureObject* GFXTextureManager::hashFind( const String &name )
    if ( name.isEmpty() )
       return NULL;
 
-   U32 key = name.getHashCaseInsensitive() % mHashCount;
-   GFXTextureObject *walk = mHashTable[key];
-   for(; walk; walk = walk->mHashNext)
-   {
-      if( walk->mTextureLookupName.equal( name, String::NoCase ) )
-         break;
-   }
+   TextureTable::Iterator iter = mTextureTable.find( name );
+   if ( iter == mTextureTable.end() )
+      return NULL;
 
-   return walk;
+   return iter->value;
 }
 
 void GFXTextureManager::freeTexture(GFXTextureObject *texture, bool zombify)
@@ -1291,6 +1380,9 @@ void GFXTextureManager::deleteTexture( GFXTextureObject *texture )
 
    hashRemove( texture );
 
+   if ( texture->isStreaming() )
+      _removeStreamingTexture( texture );
+
    // If we have a path for the texture then
    // remove change notifications for it.
    Path texPath = texture->getPath();
@@ -1453,7 +1545,7 @@ void GFXTextureManager::_onFileChanged( const Torque::Path &path )
 
    Con::errorf( "[GFXTextureManager::_onFileChanged] : File changed [%s]", path.getFullPath().c_str() );
 
-   const U32 scalePower = getTextureDownscalePower( obj->mProfile );
+   const U32 scalePower = obj->isStreaming() ? obj->mStreamDroppedMips : getTextureDownscalePower( obj->mProfile );
 
    if ( sDDSExt.equal( path.getExtension(), String::NoCase) )
    {
@@ -1478,7 +1570,7 @@ void GFXTextureManager::reloadTextures()
       const Torque::Path path( tex->mPath );
       if ( !path.isEmpty() )
       {
-         const U32 scalePower = getTextureDownscalePower( tex->mProfile );
+         const U32 scalePower = tex->isStreaming() ? tex->mStreamDroppedMips : getTextureDownscalePower( tex->mProfile );
 
          if ( sDDSExt.equal( path.getExtension(), String::NoCase ) )
          {
@@ -1498,6 +1590,597 @@ void GFXTextureManager::reloadTextures()
    }
 }
 
+GFXTextureObject *GFXTextureManager::_createCookedTexture(  const Torque::Path &sourcePath,
+                                                            const String &pathNoExt,
+                                                            GFXTextureProfile *profile,
+                                                            U32 scalePower )
+{
+   if ( !TextureCooker::canUseCooked( profile ) )
+      return NULL;
+
+   DDSFile *dds = TextureCooker::loadCooked( sourcePath, profile->getType() == GFXTextureProfile::NormalMap, scalePower );
+   if ( !dds )
+      return NULL;
+
+   // Cache it under the name of the source.
+   dds->mCacheString = pathNoExt;
+
+   GFXTextureObject *retTexObj = _createTexture( dds, profile, false, NULL );
+   delete dds;
+
+   return retTexObj;
+}
+
+//-----------------------------------------------------------------------------
+// Texture Streaming
+//-----------------------------------------------------------------------------
+
+/// Reads the mips of a streamed texture on a worker thread.
+class GFXTextureStreamItem : public ThreadWorkItem
+{
+public:
+
+   /// The full path of the file.  This is a copy of its own so that the
+   /// worker does not share string data with the main thread.
+   String mPath;
+
+   /// The number of top mips to leave out.
+   U32 mDroppedMips;
+
+   /// The file read or NULL if it failed.
+   DDSFile *mDDS;
+
+   GFXTextureStreamItem( const Torque::Path &path, U32 droppedMips )
+      :  mPath( path.getFullPath().c_str() ),
+         mDroppedMips( droppedMips ),
+         mDDS( NULL )
+   {
+   }
+
+   virtual ~GFXTextureStreamItem()
+   {
+      SAFE_DELETE( mDDS );
+   }
+
+protected:
+
+   virtual void execute()
+   {
+      mDDS = DDSFile::loadUncached( Torque::Path( mPath ), mDroppedMips );
+   }
+};
+
+GFXTextureObject *GFXTextureManager::createStreamingTexture( const Torque::Path &path, GFXTextureProfile *profile )
+{
+   if ( !smTextureStreaming || !profile->canDownscale() || profile->doStoreBitmap() )
+      return createTexture( path, profile );
+
+   PROFILE_SCOPE( GFXTextureManager_createStreamingTexture );
+
+   Torque::Path correctPath = validatePath(path);
+
+   // Check the cache first...
+   String pathNoExt = Torque::Path::Join( correctPath.getRoot(), ':', correctPath.getPath() );
+   pathNoExt = Torque::Path::Join( pathNoExt, '/', correctPath.getFileName() );
+
+   GFXTextureObject *retTexObj = _lookupTexture( pathNoExt, profile );
+   if( retTexObj )
+      return retTexObj;
+
+   // Only DDS files come with mips to stream, so look for one the
+   // same way createTexture() does and leave anything else to it.
+   Torque::Path ddsPath;
+   if( Torque::FS::IsFile( correctPath ) )
+   {
+      if( sDDSExt.equal( correctPath.getExtension(), String::NoCase ) )
+         ddsPath = correctPath;
+   }
+   else
+   {
+      Torque::Path tryDDSPath = pathNoExt;
+      if( tryDDSPath.getExtension().isNotEmpty() )
+         tryDDSPath.setFileName( tryDDSPath.getFullFileName() );
+      tryDDSPath.setExtension( sDDSExt );
+
+      if( Torque::FS::IsFile( tryDDSPath ) )
+         ddsPath = tryDDSPath;
+   }
+
+   if ( ddsPath.isEmpty() )
+      return createTexture( path, profile );
+
+   const U32 scalePower = getTextureDownscalePower( profile );
+
+   U32 droppedMips, fileWidth, fileHeight, fileMips;
+   DDSFile *dds = DDSFile::loadUncached( ddsPath, scalePower, smStreamingBaseSize, 
+                                         &droppedMips, &fileWidth, &fileHeight, &fileMips );
+
+   // Let the regular path deal with cubemaps and report errors.
+   if ( !dds || dds->isCubemap() )
+   {
+      SAFE_DELETE( dds );
+      return createTexture( path, profile );
+   }
+
+   retTexObj = _createTexture( dds, profile, false, NULL );
+   delete dds;
+
+   if ( !retTexObj )
+      return NULL;
+
+   retTexObj->mPath = ddsPath;
+   FS::AddChangeNotification( retTexObj->getPath(), this, &GFXTextureManager::_onFileChanged );
+
+   // Small textures are loaded completely.
+   const U32 minDroppedMips = getMin( scalePower, fileMips - 1 );
+   if ( droppedMips > minDroppedMips )
+   {
+      retTexObj->mStreaming = true;
+      retTexObj->mStreamFileWidth = fileWidth;
+      retTexObj->mStreamFileHeight = fileHeight;
+      retTexObj->mStreamFileMips = fileMips;
+      retTexObj->mStreamDroppedMips = droppedMips;
+      retTexObj->mStreamMinDroppedMips = minDroppedMips;
+      retTexObj->mStreamMaxDroppedMips = droppedMips;
+      retTexObj->mStreamLastDemandTime = Platform::getRealMilliseconds();
+
+      mStreamingTextures.push_back( retTexObj );
+      mStreamingMemory += _getStreamingSize( retTexObj, droppedMips );
+   }
+
+   return retTexObj;
+}
+
+U32 GFXTextureManager::_getStreamingSize( const GFXTextureObject *texture, U32 droppedMips )
+{
+   const U32 width = getMax( U32(1), texture->mStreamFileWidth >> droppedMips );
+   const U32 height = getMax( U32(1), texture->mStreamFileHeight >> droppedMips );
+   const U32 numMips = texture->mStreamFileMips - droppedMips;
+
+   if ( ImageUtil::isCompressedFormat( texture->mFormat ) )
+      return DDSFile::getSizeInBytes( texture->mFormat, height, width, numMips );
+
+   const U32 bytesPerPixel = GFXFormat_getByteSize( texture->mFormat );
+
+   U32 bytes = 0;
+   for ( U32 m=0; m < numMips; m++ )
+      bytes += getMax( U32(1), width >> m ) * getMax( U32(1), height >> m ) * bytesPerPixel;
+
+   return bytes;
+}
+
+U32 GFXTextureManager::_getStreamingDroppedMips( const GFXTextureObject *texture, U32 pixels )
+{
+   const U32 fileSize = getMax( texture->mStreamFileWidth, texture->mStreamFileHeight );
+
+   U32 droppedMips = texture->mStreamMinDroppedMips;
+   while (  droppedMips < texture->mStreamMaxDroppedMips &&
+            ( fileSize >> ( droppedMips + 1 ) ) >= pixels )
+      droppedMips++;
+
+   return droppedMips;
+}
+
+void GFXTextureManager::updateStreaming()
+{
+   if ( mStreamingTextures.empty() && mStreamLoads.empty() )
+      return;
+
+   // Don't recreate textures while the device is away.
+   if ( mTextureManagerState != GFXTextureManager::Living )
+      return;
+
+   PROFILE_SCOPE( GFXTextureManager_UpdateStreaming );
+
+   for ( U32 i=0; i < mStreamLoads.size(); )
+   {
+      if ( !mStreamLoads[i].item->hasExecuted() )
+      {
+         i++;
+         continue;
+      }
+
+      _applyStreamLoad( mStreamLoads[i] );
+      mStreamLoads.erase_fast( i );
+   }
+
+   const U32 now = Platform::getRealMilliseconds();
+   if ( now - mLastStreamUpdate < StreamUpdateInterval )
+      return;
+
+   mLastStreamUpdate = now;
+   _updateStreamingTargets();
+}
+
+namespace
+{
+   struct StreamTarget
+   {
+      GFXTextureObject *texture;
+
+      /// Dropped mips the texture has or will have once its load is done.
+      U32 current;
+
+      /// Dropped mips the texture should have.
+      U32 target;
+
+      /// Dropped mips the texture needs for its demand.
+      U32 needed;
+   };
+
+   // Textures that went unused the longest come first.
+   S32 QSORT_CALLBACK _compareStreamLastDemand( const void *a, const void *b )
+   {
+      const StreamTarget *ta = (const StreamTarget*)a;
+      const StreamTarget *tb = (const StreamTarget*)b;
+      return S32( ta->texture->mStreamLastDemandTime - tb->texture->mStreamLastDemandTime );
+   }
+
+   // Drops come first as they free memory, then the largest upgrades.
+   S32 QSORT_CALLBACK _compareStreamPriority( const void *a, const void *b )
+   {
+      const StreamTarget *ta = (const StreamTarget*)a;
+      const StreamTarget *tb = (const StreamTarget*)b;
+
+      const bool dropA = ta->target > ta->current;
+      const bool dropB = tb->target > tb->current;
+      if ( dropA != dropB )
+         return dropA ? -1 : 1;
+
+      const S32 gainA = mAbs( S32( ta->target ) - S32( ta->current ) );
+      const S32 gainB = mAbs( S32( tb->target ) - S32( tb->current ) );
+      return gainB - gainA;
+   }
+}
+
+void GFXTextureManager::_updateStreamingTargets()
+{
+   const U32 now = Platform::getRealMilliseconds();
+
+   Vector<StreamTarget> targets;
+   targets.setSize( mStreamingTextures.size() );
+
+   U64 total = 0;
+   mStreamingMemory = 0;
+
+   for ( U32 i=0; i < mStreamingTextures.size(); i++ )
+   {
+      GFXTextureObject *tex = mStreamingTextures[i];
+      StreamTarget &target = targets[i];
+
+      target.texture = tex;
+      target.current = tex->mStreamPendingDroppedMips != -1 ? tex->mStreamPendingDroppedMips : tex->mStreamDroppedMips;
+
+      if ( tex->mStreamDemand )
+      {
+         target.needed = _getStreamingDroppedMips( tex, tex->mStreamDemand );
+         tex->mStreamLastDemandTime = now;
+         tex->mStreamDemand = 0;
+
+         // Only load more here; mips which are no longer needed are
+         // only dropped when running out of budget to avoid thrashing.
+         target.target = getMin( target.needed, target.current );
+      }
+      else if ( now - tex->mStreamLastDemandTime > smStreamingKeepTime )
+      {
+         target.needed = tex->mStreamMaxDroppedMips;
+         target.target = target.needed;
+      }
+      else
+      {
+         target.needed = target.current;
+         target.target = target.current;
+      }
+
+      total += _getStreamingSize( tex, target.target );
+      mStreamingMemory += _getStreamingSize( tex, tex->mStreamDroppedMips );
+   }
+
+   // When over budget drop what isn't needed first and then
+   // take mips away from the textures used least recently.
+   const U64 budget = U64( smStreamingBudget ) * 1024 * 1024;
+   if ( budget && total > budget )
+   {
+      for ( U32 i=0; i < targets.size() && total > budget; i++ )
+      {
+         StreamTarget &target = targets[i];
+         if ( target.target >= target.needed )
+            continue;
+
+         total -= _getStreamingSize( target.texture, target.target );
+         target.target = target.needed;
+         total += _getStreamingSize( target.texture, target.target );
+      }
+
+      dQsort( targets.address(), targets.size(), sizeof( StreamTarget ), _compareStreamLastDemand );
+
+      bool dropped = true;
+      while ( total > budget && dropped )
+      {
+         dropped = false;
+         for ( U32 i=0; i < targets.size() && total > budget; i++ )
+         {
+            StreamTarget &target = targets[i];
+            if ( target.target >= target.texture->mStreamMaxDroppedMips )
+               continue;
+
+            total -= _getStreamingSize( target.texture, target.target );
+            target.target++;
+            total += _getStreamingSize( target.texture, target.target );
+            dropped = true;
+         }
+      }
+   }
+
+   if ( mStreamLoads.size() >= StreamMaxLoads )
+      return;
+
+   dQsort( targets.address(), targets.size(), sizeof( StreamTarget ), _compareStreamPriority );
+
+   for ( U32 i=0; i < targets.size() && mStreamLoads.size() < StreamMaxLoads; i++ )
+   {
+      const StreamTarget &target = targets[i];
+      if ( target.target == target.current )
+         break;
+
+      if ( target.texture->mStreamPendingDroppedMips == -1 )
+         _queueStreamLoad( target.texture, target.target );
+   }
+}
+
+void GFXTextureManager::_queueStreamLoad( GFXTextureObject *texture, U32 droppedMips )
+{
+   StreamLoad load;
+   load.item = new GFXTextureStreamItem( texture->getPath(), droppedMips );
+   load.texture = texture;
+   mStreamLoads.push_back( load );
+
+   texture->mStreamPendingDroppedMips = droppedMips;
+
+   ThreadPool::GLOBAL().queueWorkItem( load.item );
+}
+
+void GFXTextureManager::_applyStreamLoad( const StreamLoad &load )
+{
+   GFXTextureObject *tex = load.texture;
+   if ( !tex )
+      return;
+
+   PROFILE_SCOPE( GFXTextureManager_ApplyStreamLoad );
+
+   tex->mStreamPendingDroppedMips = -1;
+
+   DDSFile *dds = load.item->mDDS;
+   if ( !dds || dds->isCubemap() || !_createTexture( dds, tex->mProfile, false, tex ) )
+   {
+      // Stop asking for more than we have.
+      Con::errorf( "GFXTextureManager - failed to stream mips for '%s'", tex->getPath().c_str() );
+      tex->mStreamMinDroppedMips = getMax( tex->mStreamMinDroppedMips, tex->mStreamDroppedMips );
+      tex->mStreamMaxDroppedMips = getMax( tex->mStreamMaxDroppedMips, tex->mStreamDroppedMips );
+      return;
+   }
+
+   mStreamingMemory -= _getStreamingSize( tex, tex->mStreamDroppedMips );
+   tex->mStreamDroppedMips = load.item->mDroppedMips;
+   mStreamingMemory += _getStreamingSize( tex, tex->mStreamDroppedMips );
+}
+
+void GFXTextureManager::_removeStreamingTexture( GFXTextureObject *texture )
+{
+   mStreamingTextures.remove( texture );
+   mStreamingMemory -= getMin( mStreamingMemory, _getStreamingSize( texture, texture->mStreamDroppedMips ) );
+
+   // The loads will finish on their own.
+   for ( U32 i=0; i < mStreamLoads.size(); i++ )
+   {
+      if ( mStreamLoads[i].texture == texture )
+         mStreamLoads[i].texture = NULL;
+   }
+
+   texture->mStreaming = false;
+   texture->mStreamPendingDroppedMips = -1;
+}
+
+//-----------------------------------------------------------------------------
+// Bitmap Preloading
+//-----------------------------------------------------------------------------
+
+/// Decodes an image file on a worker thread for preloadBitmaps().
+class GFXBitmapDecodeItem : public ThreadWorkItem
+{
+public:
+
+   /// The full path of the file.  This is a copy of its own so that the
+   /// worker does not share string data with the main thread.
+   String mPath;
+
+   /// The decoded bitmap or NULL if it failed.
+   GBitmap *mBitmap;
+
+   GFXBitmapDecodeItem( const Torque::Path &path )
+      :  mPath( path.getFullPath().c_str() ),
+         mBitmap( NULL )
+   {
+   }
+
+   virtual ~GFXBitmapDecodeItem()
+   {
+      SAFE_DELETE( mBitmap );
+   }
+
+protected:
+
+   virtual void execute()
+   {
+      mBitmap = GBitmap::loadUncached( Torque::Path( mPath ) );
+   }
+};
+
+U32 GFXTextureManager::preloadBitmaps( const Vector<String> &paths )
+{
+   PROFILE_SCOPE( GFXTextureManager_preloadBitmaps );
+
+   releasePreloadedBitmaps();
+
+   const U32 startTime = Platform::getRealMilliseconds();
+
+   // Find the files on this thread, the same way createTexture() will,
+   // and queue a decode for each.
+   Vector< ThreadSafeRef< GFXBitmapDecodeItem > > items;
+   HashTable<String, bool> queued;
+
+   for ( U32 i=0; i < paths.size(); i++ )
+   {
+      if ( paths[i].isEmpty() )
+         continue;
+
+      const Torque::Path path = validatePath( paths[i] );
+
+      Torque::Path filePath;
+      if ( Torque::FS::IsFile( path ) )
+         filePath = path;
+      else
+      {
+         // A DDS with the same name is used over any image.
+         Torque::Path ddsPath( path );
+         ddsPath.setExtension( "dds" );
+         if ( Torque::FS::IsFile( ddsPath ) || !GBitmap::sFindFile( path, &filePath ) )
+            continue;
+      }
+
+      // DDS files need no decoding and cooked files replace
+      // the images they were cooked from.
+      if ( filePath.getExtension().equal( "dds", String::NoCase ) ||
+           ( TextureCooker::smUseCooked && Torque::FS::IsFile( TextureCooker::getCookedPath( filePath ) ) ) )
+         continue;
+
+      const String fullPath = filePath.getFullPath();
+      if ( queued.find( fullPath ) != queued.end() )
+         continue;
+      queued.insertUnique( fullPath, true );
+
+      ThreadSafeRef< GFXBitmapDecodeItem > item( new GFXBitmapDecodeItem( filePath ) );
+      ThreadPool::GLOBAL().queueWorkItem( item );
+      items.push_back( item );
+   }
+
+   // Hand the bitmaps to the ResourceManager in order as they finish.
+   U32 numDecoded = 0;
+   for ( U32 i=0; i < items.size(); i++ )
+   {
+      GFXBitmapDecodeItem *item = items[i];
+      while ( !item->hasExecuted() )
+         Platform::sleep( 1 );
+
+      if ( !item->mBitmap )
+         continue;
+
+      Resource<GBitmap> bitmap;
+      bitmap.setResource( ResourceManager::get().load( Torque::Path( item->mPath ) ), item->mBitmap );
+
+      // If the bitmap was already loaded our copy wasn't taken.
+      if ( (GBitmap*)bitmap == item->mBitmap )
+      {
+         item->mBitmap = NULL;
+         numDecoded++;
+      }
+
+      if ( bitmap != NULL )
+         mPreloadedBitmaps.push_back( bitmap );
+   }
+
+   Con::printf( "GFXTextureManager::preloadBitmaps - Decoded %d of %d images in %dms.",
+      numDecoded, paths.size(), Platform::getRealMilliseconds() - startTime );
+
+   return numDecoded;
+}
+
+void GFXTextureManager::releasePreloadedBitmaps()
+{
+   mPreloadedBitmaps.clear();
+}
+
+GFXTextureObject *GFXTextureManager::createAtlasTexture( const Torque::Path &path, GFXTextureProfile *profile, GFXAtlasEntry *outEntry )
+{
+   AssertFatal( profile->isAtlas(), "GFXTextureManager::createAtlasTexture - The profile is not an atlas profile!" );
+
+   *outEntry = GFXAtlasEntry();
+
+   if ( smAtlasMaxSize == 0 )
+      return createTexture( path, profile );
+
+   PROFILE_SCOPE( GFXTextureManager_createAtlasTexture );
+
+   Torque::Path correctPath = validatePath(path);
+
+   String pathNoExt = Torque::Path::Join( correctPath.getRoot(), ':', correctPath.getPath() );
+   pathNoExt = Torque::Path::Join( pathNoExt, '/', correctPath.getFileName() );
+
+   GFXTextureAtlas *atlas = NULL;
+   for ( U32 i=0; i < mAtlases.size() && !atlas; i++ )
+   {
+      if ( mAtlases[i]->getProfile() == profile )
+         atlas = mAtlases[i];
+   }
+
+   if ( !atlas )
+   {
+      atlas = new GFXTextureAtlas( profile, getNextPow2( getMax( smAtlasPageSize, (U32)64 ) ) );
+      mAtlases.push_back( atlas );
+   }
+
+   GFXTextureObject *page = atlas->find( pathNoExt, outEntry );
+   if ( page )
+      return page;
+
+   // DDS files are already compressed and have their
+   // mips, so those are always loaded on their own.
+   Torque::Path ddsPath = pathNoExt;
+   if ( ddsPath.getExtension().isNotEmpty() )
+      ddsPath.setFileName( ddsPath.getFullFileName() );
+   ddsPath.setExtension( sDDSExt );
+
+   if (  sDDSExt.equal( correctPath.getExtension(), String::NoCase ) ||
+         ( !Torque::FS::IsFile( correctPath ) && Torque::FS::IsFile( ddsPath ) ) )
+      return createTexture( path, profile );
+
+   Resource<GBitmap> bitmap = GBitmap::load( correctPath );
+   if ( bitmap == NULL )
+      return NULL;
+
+   // The bitmap stays in the resource cache while we hold it.
+   if ( bitmap->getWidth() > smAtlasMaxSize || !atlas->canAdd( bitmap ) )
+      return createTexture( path, profile );
+
+   page = atlas->add( pathNoExt, bitmap, outEntry );
+
+   // Textures created while rendering are used right away.
+   if ( GFX->canCurrentlyRender() )
+      atlas->update();
+
+   return page;
+}
+
+void GFXTextureManager::updateAtlases()
+{
+   if ( mTextureManagerState != GFXTextureManager::Living )
+      return;
+
+   for ( U32 i=0; i < mAtlases.size(); i++ )
+      mAtlases[i]->update();
+}
+
+DefineEngineFunction( getTextureStreamingMemory, S32, (),,
+   "Returns the estimated video memory in bytes used by streamed textures.\n"
+   "@see $pref::Video::textureStreaming\n"
+   "@ingroup GFX\n" )
+{
+   if ( !GFX || !TEXMGR )
+      return 0;
+
+   return TEXMGR->getStreamingMemory();
+}
+
 DefineEngineFunction( flushTextureCache, void, (),,
    "Releases all textures and resurrects the texture manager.\n"
    "@ingroup GFX\n" )
@@ -1528,3 +2211,14 @@ DefineEngineFunction( reloadTextures, void, (),,
 
    TEXMGR->reloadTextures();
 }
+
+DefineEngineFunction( releasePreloadedTextures, void, (),,
+   "Drops the decoded images held since the last preloadMaterialTextures() "
+   "call.  Call this once a level has finished loading.\n"
+   "@ingroup GFX\n" )
+{
+   if ( !GFX || !TEXMGR )
+      return;
+
+   TEXMGR->releasePreloadedBitmaps();
+}
@@ -35,12 +35,15 @@
 #ifndef _RESOURCEMANAGER_H_
 #include "core/resourceManager.h"
 #endif
-#ifndef _TDICTIONARY_H_
-#include "core/util/tDictionary.h"
+#ifndef _TOPENHASHTABLE_H_
+#include "core/util/tOpenHashTable.h"
 #endif
 #ifndef _TSIGNAL_H_
 #include "core/util/tSignal.h"
 #endif
+#ifndef _THREADSAFEREFCOUNT_H_
+#include "platform/threads/threadSafeRefCount.h"
+#endif
 
 
 namespace Torque
@@ -49,10 +52,16 @@ namespace Torque
 }
 
 class GFXCubemap;
+class GFXTextureStreamItem;
+class GFXTextureAtlas;
+struct GFXAtlasEntry;
 
 
 class GFXTextureManager 
 {   
+   friend class GFXTextureAtlas;
+   friend class TSImposterAtlas;
+
 public:
    enum
    {
@@ -105,6 +114,41 @@ public:
    virtual GFXTextureObject *createTexture(  const Torque::Path &path,
       GFXTextureProfile *profile );
 
+   /// Like createTexture() from a path, but if texture streaming is enabled
+   /// and the file is a DDS, only the mips up to $pref::Video::textureStreamingBaseSize
+   /// are loaded right away.  Higher mips are loaded on worker threads once
+   /// GFXTextureObject::requestStreamingSize() asks for them and are dropped
+   /// again when the texture goes unused or the streaming budget is exceeded.
+   ///
+   /// Textures with profiles that cannot be downscaled or that keep their
+   /// bitmap are never streamed.
+   GFXTextureObject *createStreamingTexture( const Torque::Path &path,
+      GFXTextureProfile *profile );
+
+   /// Like createTexture() from a path, but for profiles with the
+   /// GFXTextureProfile::Atlas flag.  Square power of two images no larger
+   /// than $pref::Video::textureAtlasMaxSize are packed into a page of the
+   /// GFXTextureAtlas of the profile, which is returned along with where
+   /// the image went in @a outEntry.  All other images are loaded as
+   /// regular textures and @a outEntry is left invalid.
+   GFXTextureObject *createAtlasTexture( const Torque::Path &path,
+      GFXTextureProfile *profile,
+      GFXAtlasEntry *outEntry );
+
+   /// Decodes the images at @a paths concurrently on the ThreadPool and puts
+   /// them into the ResourceManager, so that creating textures from them
+   /// later only has to upload.  DDS files, images with a current cooked file
+   /// and images already loaded are skipped.
+   ///
+   /// The decoded bitmaps are held until releasePreloadedBitmaps().
+   ///
+   /// @return The number of images decoded.
+   U32 preloadBitmaps( const Vector<String> &paths );
+
+   /// Drops the bitmaps held by preloadBitmaps().  Textures created from
+   /// them stay loaded.
+   void releasePreloadedBitmaps();
+
    virtual GFXTextureObject *createTexture(  U32 width,
       U32 height,
       void *pixels,
@@ -183,6 +227,20 @@ public:
 
    /// @}
 
+   /// Applies finished streaming loads and decides which textures to load
+   /// at which mip level next.  Called once per frame by the device.
+   void updateStreaming();
+
+   /// Uploads the atlas pages changed since the last frame.  Called once
+   /// per frame by the device.
+   void updateAtlases();
+
+   /// Returns the estimated video memory in bytes used by streamed textures.
+   U32 getStreamingMemory() const { return mStreamingMemory; }
+
+   /// Returns the world units a streamed texture is assumed to repeat over.
+   static F32 getStreamingWorldSize() { return smStreamingWorldSize; }
+
    /// Load a cubemap from a texture file.
    GFXCubemap* createCubemap( const Torque::Path &path );
 
@@ -200,6 +258,42 @@ protected:
    /// 
    static S32 smTextureReductionLevel;
 
+   /// @name Texture Streaming
+   /// @{
+
+   /// Enables createStreamingTexture().
+   ///
+   /// Exposed to script via $pref::Video::textureStreaming.
+   static bool smTextureStreaming;
+
+   /// Largest size of the top mip that streamed textures are created with.
+   static U32 smStreamingBaseSize;
+
+   /// Video memory in megabytes streamed textures may use in total or
+   /// zero for no limit.
+   static U32 smStreamingBudget;
+
+   /// Milliseconds after which textures without demand are dropped back
+   /// to their base mips.
+   static U32 smStreamingKeepTime;
+
+   /// World units a streamed texture is assumed to repeat over when
+   /// materials estimate its size on screen.
+   static F32 smStreamingWorldSize;
+
+   /// @}
+
+   /// Edge length of the pages of texture atlases.
+   ///
+   /// Exposed to script via $pref::Video::textureAtlasPageSize.
+   static U32 smAtlasPageSize;
+
+   /// Largest edge length of images createAtlasTexture() packs into
+   /// atlases or zero to disable atlasing.
+   ///
+   /// Exposed to script via $pref::Video::textureAtlasMaxSize.
+   static U32 smAtlasMaxSize;
+
    /// File path to the missing texture
    static String smMissingTexturePath;
 
@@ -213,15 +307,16 @@ protected:
    GFXTextureObject *mListHead;
    GFXTextureObject *mListTail;
 
-   // We have a hash table for fast texture lookups
-   GFXTextureObject **mHashTable;
-   U32                mHashCount;
+   // We have a hash table for fast texture lookups.  It grows with
+   // the number of textures and is keyed case insensitively.
+   typedef OpenHashTable<String,GFXTextureObject*> TextureTable;
+   TextureTable mTextureTable;
    GFXTextureObject *hashFind( const String &name );
    void              hashInsert(GFXTextureObject *object);
    void              hashRemove(GFXTextureObject *object);
 
    // The cache of loaded cubemap textures.
-   typedef HashTable<String,GFXCubemap*> CubemapTable;
+   typedef OpenHashTable<String,GFXCubemap*> CubemapTable;
    CubemapTable mCubemapTable;
 
    /// The textures waiting to be deleted.
@@ -241,6 +336,41 @@ protected:
    /// All the allocated texture pool textures.
    TexturePoolMap mTexturePool;
 
+   enum
+   {
+      /// Most streaming loads in flight at once.
+      StreamMaxLoads = 4,
+
+      /// Milliseconds between streaming decisions.
+      StreamUpdateInterval = 100,
+   };
+
+   struct StreamLoad
+   {
+      ThreadSafeRef< GFXTextureStreamItem > item;
+
+      /// The texture to load into or NULL if it has been deleted.
+      GFXTextureObject *texture;
+   };
+
+   /// All textures with streamed mips.
+   Vector<GFXTextureObject*> mStreamingTextures;
+
+   /// The loads in flight.
+   Vector<StreamLoad> mStreamLoads;
+
+   /// Estimated video memory used by #mStreamingTextures.
+   U32 mStreamingMemory;
+
+   /// Platform::getRealMilliseconds() of the last streaming decision.
+   U32 mLastStreamUpdate;
+
+   /// The bitmaps decoded by preloadBitmaps().
+   Vector< Resource<GBitmap> > mPreloadedBitmaps;
+
+   /// The atlases of all profiles createAtlasTexture() was used with.
+   Vector<GFXTextureAtlas*> mAtlases;
+
    //-----------------------------------------------------------------------
    // Protected methods
    //-----------------------------------------------------------------------
@@ -266,6 +396,14 @@ protected:
                                        bool deleteDDS,
                                        GFXTextureObject *inObj );
 
+   /// Creates the texture for the image at @a sourcePath from its cooked
+   /// file if there is an up to date one.
+   /// @see TextureCooker
+   GFXTextureObject *_createCookedTexture(   const Torque::Path &sourcePath,
+                                             const String &pathNoExt,
+                                             GFXTextureProfile *profile,
+                                             U32 scalePower );
+
    /// Frees the API handles to the texture, for D3D this is a release call
    ///
    /// @note freeTexture MUST NOT DELETE THE TEXTURE OBJECT
@@ -350,6 +488,31 @@ protected:
 
    void _onFileChanged( const Torque::Path &path );
 
+   /// @name Texture Streaming
+   /// @{
+
+   /// Returns the video memory @a texture takes with @a droppedMips top
+   /// mips of its file dropped.
+   static U32 _getStreamingSize( const GFXTextureObject *texture, U32 droppedMips );
+
+   /// Returns the number of top mips @a texture may drop and still cover
+   /// @a pixels on screen.
+   static U32 _getStreamingDroppedMips( const GFXTextureObject *texture, U32 pixels );
+
+   /// Picks the mip level for each streamed texture and queues the loads.
+   void _updateStreamingTargets();
+
+   /// Queues a load of @a texture with @a droppedMips top mips dropped.
+   void _queueStreamLoad( GFXTextureObject *texture, U32 droppedMips );
+
+   /// Uploads the mips of a finished load.
+   void _applyStreamLoad( const StreamLoad &load );
+
+   /// Removes @a texture from streaming and forgets its loads in flight.
+   void _removeStreamingTexture( GFXTextureObject *texture );
+
+   /// @}
+
    /// The texture event signal type.
    typedef Signal<void(GFXTexCallbackCode code)> EventSignal;
 
@@ -77,7 +77,7 @@ DefineEngineFunction( dumpTextureObjects, void, (),,
 //-----------------------------------------------------------------------------
 GFXTextureObject::GFXTextureObject(GFXDevice *aDevice, GFXTextureProfile *aProfile) 
 {
-   mHashNext = mNext = mPrev = NULL;
+   mNext = mPrev = NULL;
 
    mDevice = aDevice;
    mProfile = aProfile;
@@ -99,6 +99,17 @@ GFXTextureObject::GFXTextureObject(GFXDevice *aDevice, GFXTextureProfile *aProfi
 
    mHasTransparency = false;
 
+   mStreaming = false;
+   mStreamFileWidth = 0;
+   mStreamFileHeight = 0;
+   mStreamFileMips = 0;
+   mStreamDroppedMips = 0;
+   mStreamMinDroppedMips = 0;
+   mStreamMaxDroppedMips = 0;
+   mStreamPendingDroppedMips = -1;
+   mStreamDemand = 0;
+   mStreamLastDemandTime = 0;
+
 #if defined(TORQUE_DEBUG)
    // Active object tracking.
    smActiveTOCount++;
@@ -103,10 +103,6 @@ public:
    /// @see GFXTextureManager::mListHead
    GFXTextureObject *mPrev;
 
-   /// The siblings in the cache hash table.
-   /// @see GFXTextureManager::mHashTable
-   GFXTextureObject *mHashNext;
-
    /// This is the file name or other unique string used 
    /// to hash this texture object.
    String mTextureLookupName;
@@ -135,6 +131,45 @@ public:
    GFXTextureProfile *mProfile;
    GFXFormat          mFormat;
 
+   /// @name Streaming
+   /// State of textures created with GFXTextureManager::createStreamingTexture
+   /// whose top mips are loaded on demand.
+   /// @{
+
+   /// True if the top mips of this texture are streamed.
+   bool mStreaming;
+
+   /// Size of the top mip in the texture file.
+   U32 mStreamFileWidth;
+   U32 mStreamFileHeight;
+
+   /// Number of mips in the texture file.
+   U32 mStreamFileMips;
+
+   /// Number of top mips of the file which are not resident.
+   U32 mStreamDroppedMips;
+
+   /// Fewest top mips of the file that may be dropped, as given by
+   /// the texture reduction level.
+   U32 mStreamMinDroppedMips;
+
+   /// Most top mips of the file that may be dropped, which is what is
+   /// loaded up front.
+   U32 mStreamMaxDroppedMips;
+
+   /// Number of dropped mips a load in flight will leave or -1 if there
+   /// is no load in flight.
+   S32 mStreamPendingDroppedMips;
+
+   /// Largest on-screen size in pixels requested since the last streaming
+   /// update.
+   U32 mStreamDemand;
+
+   /// Platform::getRealMilliseconds() when the texture last had demand.
+   U32 mStreamLastDemandTime;
+
+   /// @}
+
 
    GFXTextureObject(GFXDevice * aDevice, GFXTextureProfile *profile);
    virtual ~GFXTextureObject();
@@ -151,6 +186,18 @@ public:
    U32 getBitmapDepth() const { return mBitmapSize.z; }
    GFXFormat getFormat() const { return mFormat; }
 
+   /// Returns true if the top mips of this texture are streamed.
+   bool isStreaming() const { return mStreaming; }
+
+   /// Tell the streaming system that this texture is about to cover @a pixels
+   /// pixels on the screen, so the mips needed for that get loaded.  Does
+   /// nothing for textures that are not streamed.
+   void requestStreamingSize( U32 pixels )
+   {
+      if ( pixels > mStreamDemand )
+         mStreamDemand = pixels;
+   }
+
    /// Returns true if this texture is a render target.
    bool isRenderTarget() const { return mProfile->isRenderTarget(); }
 
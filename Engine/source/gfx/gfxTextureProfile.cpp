@@ -47,6 +47,10 @@ GFX_ImplementTextureProfile(GFXStaticTextureSRGBProfile,
                             GFXTextureProfile::DiffuseMap,
                             GFXTextureProfile::Static | GFXTextureProfile::SRGB,
                             GFXTextureProfile::NONE);
+GFX_ImplementTextureProfile(GFXStaticTextureSRGBAtlasProfile,
+                            GFXTextureProfile::DiffuseMap,
+                            GFXTextureProfile::PreserveSize | GFXTextureProfile::Static | GFXTextureProfile::SRGB | GFXTextureProfile::Atlas,
+                            GFXTextureProfile::NONE);
 GFX_ImplementTextureProfile(GFXTexturePersistentProfile,
                             GFXTextureProfile::DiffuseMap,
                             GFXTextureProfile::PreserveSize | GFXTextureProfile::Static | GFXTextureProfile::KeepBitmap,
@@ -104,7 +104,14 @@ public:
       NoDiscard = BIT(11),
 
       
-      NoModify = BIT(11)
+      NoModify = BIT(11),
+
+      /// Pack small square textures of this type into shared atlas
+      /// pages rather than giving each its own texture.
+      ///
+      /// @see GFXTextureManager::createAtlasTexture
+      /// @see GFXTextureAtlas
+      Atlas = BIT(12),
 
    };
 
@@ -172,6 +179,7 @@ public:
    inline bool isPooled() const { return testFlag(Pooled); }
    inline bool canDiscard() const { return !testFlag(NoDiscard); }
    inline bool isSRGB() const { return testFlag(SRGB); }
+   inline bool isAtlas() const { return testFlag(Atlas); }
    //compare profile flags for equality
    inline bool compareFlags(const GFXTextureProfile& in_Cmp) const{ return (mProfile == in_Cmp.mProfile); }
 private:
@@ -180,7 +188,7 @@ private:
    enum Constants
    {
       TypeBits = 2,
-      FlagBits = 12,
+      FlagBits = 13,
       CompressionBits = 3,
    };
 
@@ -215,6 +223,8 @@ GFX_DeclareTextureProfile(GFXRenderTargetSRGBProfile);
 // Standard static diffuse textures
 GFX_DeclareTextureProfile(GFXStaticTextureProfile);
 GFX_DeclareTextureProfile(GFXStaticTextureSRGBProfile);
+// Small static diffuse textures packed into atlas pages
+GFX_DeclareTextureProfile(GFXStaticTextureSRGBAtlasProfile);
 // Standard static diffuse textures that are persistent in memory
 GFX_DeclareTextureProfile(GFXTexturePersistentProfile);
 GFX_DeclareTextureProfile(GFXTexturePersistentSRGBProfile);
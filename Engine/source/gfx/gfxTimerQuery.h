@@ -0,0 +1,78 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _GFXTIMERQUERY_H_
+#define _GFXTIMERQUERY_H_
+
+#ifndef _GFXDEVICE_H_
+#include "gfx/gfxDevice.h"
+#endif
+
+
+/// A query measuring the GPU time taken by the commands issued between
+/// begin() and end().
+///
+/// Like occlusion queries, results only become available once the GPU has
+/// caught up, so poll them a frame or more later to avoid stalling.
+///
+/// @see GFXDevice::createTimerQuery
+class GFXTimerQuery : public GFXResource
+{
+protected:
+
+   GFXDevice *mDevice;
+
+   GFXTimerQuery( GFXDevice *device )
+      : mDevice( device )
+   {
+   }
+
+public:
+
+   enum TimerQueryStatus
+   {
+      Unset,         ///< Query has not been issued.
+      Waiting,       ///< Result is not available yet.
+      Error,         ///< Query failed or timing was unreliable.
+      Ready          ///< Result is available.
+   };
+
+   virtual ~GFXTimerQuery() {}
+
+   /// Start timing.  Timer queries must not be nested.
+   virtual void begin() = 0;
+
+   /// Stop timing.
+   virtual void end() = 0;
+
+   /// Returns the status of the last submitted query.
+   /// @param block If true CPU will block until the query finishes.
+   /// @param outNanoseconds GPU time taken, valid only if Ready is returned.
+   virtual TimerQueryStatus getStatus( bool block, U64 *outNanoseconds ) = 0;
+
+   // GFXResource
+   virtual void zombify() = 0;
+   virtual void resurrect() = 0;
+   virtual const String describeSelf() const = 0;
+};
+
+#endif // _GFXTIMERQUERY_H_
@@ -70,6 +70,12 @@ void GFXGLCardProfiler::setupCardCapabilities()
    // Check for vertex attrib binding
    setCapability("GL_ARB_vertex_attrib_binding", gglHasExtension(ARB_vertex_attrib_binding));    
 
+   // Check for direct state access
+   setCapability("GL_ARB_direct_state_access", gglHasExtension(ARB_direct_state_access));
+
+   // Check for binding multiple texture units at once
+   setCapability("GL_ARB_multi_bind", gglHasExtension(ARB_multi_bind));
+
 }
 
 bool GFXGLCardProfiler::_queryCardCap(const String& query, U32& foundResult)
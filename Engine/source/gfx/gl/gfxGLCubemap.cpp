@@ -51,6 +51,7 @@ GFXGLCubemap::GFXGLCubemap() :
 
 GFXGLCubemap::~GFXGLCubemap()
 {
+   static_cast<GFXGLDevice*>(getOwningDevice())->getOpenglCache()->setCacheDeletedTex(mCubemap);
    glDeleteTextures(1, &mCubemap);
    GFXTextureManager::removeEventDelegate( this, &GFXGLCubemap::_onTextureEvent );
 }
@@ -224,6 +225,7 @@ void GFXGLCubemap::initDynamic(U32 texSize, GFXFormat faceFormat)
 
 void GFXGLCubemap::zombify()
 {
+   static_cast<GFXGLDevice*>(getOwningDevice())->getOpenglCache()->setCacheDeletedTex(mCubemap);
    glDeleteTextures(1, &mCubemap);
    mCubemap = 0;
 }
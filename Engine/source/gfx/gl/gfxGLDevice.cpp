@@ -42,6 +42,7 @@
 #include "gfx/primBuilder.h"
 #include "console/console.h"
 #include "gfx/gl/gfxGLOcclusionQuery.h"
+#include "gfx/gl/gfxGLTimerQuery.h"
 #include "materials/shaderData.h"
 #include "gfx/gl/gfxGLStateCache.h"
 #include "gfx/gl/gfxGLVertexAttribLocation.h"
@@ -137,6 +138,8 @@ void GFXGLDevice::initGLState()
    mCapabilities.samplerObjects = mCardProfiler->queryProfile("GL_ARB_sampler_objects");
    mCapabilities.copyImage = mCardProfiler->queryProfile("GL_ARB_copy_image");
    mCapabilities.vertexAttributeBinding = mCardProfiler->queryProfile("GL_ARB_vertex_attrib_binding");
+   mCapabilities.directStateAccess = mCardProfiler->queryProfile("GL_ARB_direct_state_access");
+   mCapabilities.multiBind = mCardProfiler->queryProfile("GL_ARB_multi_bind");
 
    String vendorStr = (const char*)glGetString( GL_VENDOR );
    if( vendorStr.find("NVIDIA", 0, String::NoCase | String::Left) != String::NPos)
@@ -232,7 +235,12 @@ GFXGLDevice::GFXGLDevice(U32 adapterIndex) :
    gScreenShot = new ScreenShot();
 
    for(U32 i = 0; i < TEXTURE_STAGE_COUNT; i++)
+   {
       mActiveTextureType[i] = GL_ZERO;
+      mPendingTextures[i] = 0;
+   }
+   mPendingTextureFirst = TEXTURE_STAGE_COUNT;
+   mPendingTextureLast = 0;
 
    mNumVertexStream = 2;
 
@@ -548,6 +556,8 @@ inline void GFXGLDevice::preDrawPrimitive()
    {
       updateStates();
    }
+
+   _flushTextureBinds();
    
    if(mCurrentShaderConstBuffer)
       setShaderConstBufferInternal(mCurrentShaderConstBuffer);
@@ -616,7 +626,8 @@ void GFXGLDevice::drawIndexedPrimitive(   GFXPrimitiveType primType,
 
 void GFXGLDevice::setPB(GFXGLPrimitiveBuffer* pb)
 {
-   if(mCurrentPB)
+   // A new buffer gets bound right away, so only unbind when clearing.
+   if(mCurrentPB && !pb)
       mCurrentPB->finish();
    mCurrentPB = pb;
 }
@@ -642,13 +653,21 @@ void GFXGLDevice::setTextureInternal(U32 textureUnit, const GFXTextureObject*tex
    if (tex)
    {
       mActiveTextureType[textureUnit] = tex->getBinding();
-      tex->bind(textureUnit);
+      if (_useMultiBind())
+         _queueTextureBind(textureUnit, tex->getHandle());
+      else
+         tex->bind(textureUnit);
    } 
    else if(mActiveTextureType[textureUnit] != GL_ZERO)
    {
-      glActiveTexture(GL_TEXTURE0 + textureUnit);
-      glBindTexture(mActiveTextureType[textureUnit], 0);
-      getOpenglCache()->setCacheBindedTex(textureUnit, mActiveTextureType[textureUnit], 0);
+      if (_useMultiBind())
+         _queueTextureBind(textureUnit, 0);
+      else
+      {
+         glActiveTexture(GL_TEXTURE0 + textureUnit);
+         glBindTexture(mActiveTextureType[textureUnit], 0);
+         getOpenglCache()->setCacheBindedTex(textureUnit, mActiveTextureType[textureUnit], 0);
+      }
       mActiveTextureType[textureUnit] = GL_ZERO;
    }
 }
@@ -658,17 +677,54 @@ void GFXGLDevice::setCubemapInternal(U32 textureUnit, const GFXGLCubemap* textur
    if(texture)
    {
       mActiveTextureType[textureUnit] = GL_TEXTURE_CUBE_MAP;
-      texture->bind(textureUnit);
+      if (_useMultiBind())
+         _queueTextureBind(textureUnit, const_cast<GFXGLCubemap*>(texture)->getHandle());
+      else
+         texture->bind(textureUnit);
    }
    else if(mActiveTextureType[textureUnit] != GL_ZERO)
    {
-      glActiveTexture(GL_TEXTURE0 + textureUnit);
-      glBindTexture(mActiveTextureType[textureUnit], 0);
-      getOpenglCache()->setCacheBindedTex(textureUnit, mActiveTextureType[textureUnit], 0);
+      if (_useMultiBind())
+         _queueTextureBind(textureUnit, 0);
+      else
+      {
+         glActiveTexture(GL_TEXTURE0 + textureUnit);
+         glBindTexture(mActiveTextureType[textureUnit], 0);
+         getOpenglCache()->setCacheBindedTex(textureUnit, mActiveTextureType[textureUnit], 0);
+      }
       mActiveTextureType[textureUnit] = GL_ZERO;
    }
 }
 
+void GFXGLDevice::_queueTextureBind(U32 textureUnit, GLuint handle)
+{
+   mPendingTextures[textureUnit] = handle;
+   mPendingTextureFirst = getMin(mPendingTextureFirst, textureUnit);
+   mPendingTextureLast = getMax(mPendingTextureLast, textureUnit);
+}
+
+void GFXGLDevice::_flushTextureBinds()
+{
+   if (mPendingTextureFirst > mPendingTextureLast)
+      return;
+
+   // Units inside the range which did not change are rebound to the
+   // texture they already have, which is still cheaper than one call per unit.
+   const U32 count = mPendingTextureLast - mPendingTextureFirst + 1;
+   glBindTextures(mPendingTextureFirst, count, &mPendingTextures[mPendingTextureFirst]);
+
+   for (U32 i = mPendingTextureFirst; i <= mPendingTextureLast; i++)
+   {
+      if (mPendingTextures[i])
+         getOpenglCache()->setCacheBindedTexUnit(i, mActiveTextureType[i], mPendingTextures[i]);
+      else
+         getOpenglCache()->setCacheUnbindedTexUnit(i);
+   }
+
+   mPendingTextureFirst = TEXTURE_STAGE_COUNT;
+   mPendingTextureLast = 0;
+}
+
 void GFXGLDevice::setMatrix( GFXMatrixType mtype, const MatrixF &mat )
 {
    // ONLY NEEDED ON FFP
@@ -773,6 +829,17 @@ GFXOcclusionQuery* GFXGLDevice::createOcclusionQuery()
    return query;
 }
 
+GFXTimerQuery* GFXGLDevice::createTimerQuery()
+{
+   // We only ask for a 3.2 context; timer queries are core since 3.3.
+   if( !gglHasExtension(ARB_timer_query) )
+      return NULL;
+
+   GFXTimerQuery *query = new GFXGLTimerQuery( this );
+   query->registerResourceWithDevice(this);
+   return query;
+}
+
 void GFXGLDevice::setupGenericShaders( GenericShaderType type ) 
 {
    AssertFatal(type != GSTargetRestore, "");
@@ -823,8 +890,26 @@ void GFXGLDevice::setupGenericShaders( GenericShaderType type )
       mGenericShaderBuffer[GSTexture] = mGenericShader[GSTexture]->allocConstBuffer();
       mModelViewProjSC[GSTexture] = mGenericShader[GSTexture]->getShaderConstHandle( "$modelView" );
       Sim::getRootGroup()->addObject(shaderData);
+
+      shaderData = new ShaderData();
+      shaderData->setField("OGLVertexShaderFile", ShaderGen::smCommonShaderPath + String("/fixedFunction/gl/addColorTextureV.glsl"));
+      shaderData->setField("OGLPixelShaderFile", ShaderGen::smCommonShaderPath + String("/fixedFunction/gl/distanceFieldP.glsl"));
+      shaderData->setSamplerName("$diffuseMap", 0);
+      shaderData->setField("pixVersion", "2.0");
+      shaderData->registerObject();
+      mGenericShader[GSDistanceField] = shaderData->getShader();
+      if( mGenericShader[GSDistanceField] )
+      {
+         mGenericShaderBuffer[GSDistanceField] = mGenericShader[GSDistanceField]->allocConstBuffer();
+         mModelViewProjSC[GSDistanceField] = mGenericShader[GSDistanceField]->getShaderConstHandle( "$modelView" );
+      }
+      Sim::getRootGroup()->addObject(shaderData);
    }
 
+   // Without the distance field shader text still draws, only with soft edges.
+   if( type == GSDistanceField && mGenericShader[GSDistanceField] == NULL )
+      type = GSAddColorTexture;
+
    MatrixF tempMatrix =  mProjectionMatrix * mViewMatrix * mWorldMatrix[mWorldStackSize];  
    mGenericShaderBuffer[type]->setSafe(mModelViewProjSC[type], tempMatrix);
 
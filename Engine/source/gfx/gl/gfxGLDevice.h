@@ -54,6 +54,8 @@ public:
       bool samplerObjects;
       bool copyImage;
       bool vertexAttributeBinding;
+      bool directStateAccess;
+      bool multiBind;
    };
    GLCapabilities mCapabilities;
 
@@ -140,6 +142,7 @@ public:
    GFXFence *createFence();
    
    GFXOcclusionQuery* createOcclusionQuery();
+   GFXTimerQuery* createTimerQuery();
 
    GFXGLStateBlockRef getCurrentStateBlock() { return mCurrentGLStateBlock; }
    
@@ -169,6 +172,16 @@ protected:
    virtual void setTextureInternal(U32 textureUnit, const GFXTextureObject*texture);
    virtual void setCubemapInternal(U32 cubemap, const GFXGLCubemap* texture);
 
+   /// Returns true if texture units are bound in one glBindTextures() call
+   /// right before drawing instead of one at a time.
+   bool _useMultiBind() const { return mCapabilities.multiBind && mCapabilities.samplerObjects; }
+
+   /// Sets the texture to bind to the unit with the next _flushTextureBinds().
+   void _queueTextureBind(U32 textureUnit, GLuint handle);
+
+   /// Binds the queued textures.
+   void _flushTextureBinds();
+
    virtual void setLightInternal(U32 lightStage, const GFXLightInfo light, bool lightEnable);
    virtual void setLightMaterialInternal(const GFXLightMaterial mat);
    virtual void setGlobalAmbientInternal(LinearColorF color);
@@ -246,6 +259,12 @@ private:
    GFXGLStateBlockRef mCurrentGLStateBlock;
    
    GLenum mActiveTextureType[TEXTURE_STAGE_COUNT];
+
+   /// Textures for each unit when using multi-bind, and the range
+   /// of units changed since the last flush.
+   GLuint mPendingTextures[TEXTURE_STAGE_COUNT];
+   U32 mPendingTextureFirst;
+   U32 mPendingTextureLast;
    
    Vector< StrongRefPtr<GFXGLVertexBuffer> > mVolatileVBs; ///< Pool of existing volatile VBs so we can reuse previously created ones
    Vector< StrongRefPtr<GFXGLPrimitiveBuffer> > mVolatilePBs; ///< Pool of existing volatile PBs so we can reuse previously created ones
@@ -47,6 +47,13 @@ GFXGLPrimitiveBuffer::GFXGLPrimitiveBuffer(GFXDevice *device, U32 indexCount, U3
    }
 
    // Generate a buffer and allocate the needed memory
+   if( GFXGL->mCapabilities.directStateAccess )
+   {
+      glCreateBuffers(1, &mBuffer);
+      glNamedBufferData(mBuffer, indexCount * sizeof(U16), NULL, GFXGLBufferType[bufferType]);
+      return;
+   }
+
    glGenBuffers(1, &mBuffer);
    
    PRESERVE_INDEX_BUFFER();
@@ -58,7 +65,10 @@ GFXGLPrimitiveBuffer::~GFXGLPrimitiveBuffer()
 {
 	// This is heavy handed, but it frees the buffer memory
    if( mBufferType != GFXBufferTypeVolatile )
+   {
+      GFXGL->getOpenglCache()->setCacheDeletedBuffer(mBuffer);
 	   glDeleteBuffers(1, &mBuffer);
+   }
    
    if( mZombieCache )
       delete [] mZombieCache;
@@ -66,6 +76,8 @@ GFXGLPrimitiveBuffer::~GFXGLPrimitiveBuffer()
 
 void GFXGLPrimitiveBuffer::lock(U32 indexStart, U32 indexEnd, void **indexPtr)
 {
+   mDevice->getDeviceStatistics()->mBufferLocks++;
+
    if( mBufferType == GFXBufferTypeVolatile )
    {
       AssertFatal(indexStart == 0, "");
@@ -95,16 +107,26 @@ void GFXGLPrimitiveBuffer::unlock()
       U32 offset = lockedIndexStart * sizeof(U16);
       U32 length = (lockedIndexEnd - lockedIndexStart) * sizeof(U16);
    
-      // Preserve previous binding
-      PRESERVE_INDEX_BUFFER();
+      if( GFXGL->mCapabilities.directStateAccess )
+      {
+         if( !lockedIndexStart && lockedIndexEnd == mIndexCount)
+            glNamedBufferData(mBuffer, mIndexCount * sizeof(U16), NULL, GFXGLBufferType[mBufferType]); // orphan the buffer
+
+         glNamedBufferSubData(mBuffer, offset, length, mFrameAllocator.getlockedPtr() + offset );
+      }
+      else
+      {
+         // Preserve previous binding
+         PRESERVE_INDEX_BUFFER();
    
-      // Bind ourselves
-      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBuffer);
+         // Bind ourselves
+         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBuffer);
 
-      if( !lockedIndexStart && lockedIndexEnd == mIndexCount)
-         glBufferData(GL_ELEMENT_ARRAY_BUFFER, mIndexCount * sizeof(U16), NULL, GFXGLBufferType[mBufferType]); // orphan the buffer
+         if( !lockedIndexStart && lockedIndexEnd == mIndexCount)
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, mIndexCount * sizeof(U16), NULL, GFXGLBufferType[mBufferType]); // orphan the buffer
 
-      glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, length, mFrameAllocator.getlockedPtr() + offset );
+         glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, length, mFrameAllocator.getlockedPtr() + offset );
+      }
    
       mFrameAllocator.unlock();
    }
@@ -118,6 +140,11 @@ void GFXGLPrimitiveBuffer::prepare()
 	// Bind
    GFXGLDevice* glDevice = static_cast<GFXGLDevice*>(mDevice);
    glDevice->setPB(this);
+
+   // Volatile buffers all share one GL buffer.
+   if(glDevice->getOpenglCache()->getCacheBinded(GL_ELEMENT_ARRAY_BUFFER) == mBuffer)
+      return;
+
    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBuffer);
    glDevice->getOpenglCache()->setCacheBinded(GL_ELEMENT_ARRAY_BUFFER, mBuffer);
 }
@@ -140,9 +167,15 @@ void GFXGLPrimitiveBuffer::zombify()
       return;
       
    mZombieCache = new U8[mIndexCount * sizeof(U16)];
-   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBuffer);
-   glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, mIndexCount * sizeof(U16), mZombieCache);
-   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+   if( GFXGL->mCapabilities.directStateAccess )
+      glGetNamedBufferSubData(mBuffer, 0, mIndexCount * sizeof(U16), mZombieCache);
+   else
+   {
+      PRESERVE_INDEX_BUFFER();
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBuffer);
+      glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, mIndexCount * sizeof(U16), mZombieCache);
+   }
+   GFXGL->getOpenglCache()->setCacheDeletedBuffer(mBuffer);
    glDeleteBuffers(1, &mBuffer);
    mBuffer = 0;
 }
@@ -152,10 +185,18 @@ void GFXGLPrimitiveBuffer::resurrect()
    if(!mZombieCache)
       return;
    
-   glGenBuffers(1, &mBuffer);
-   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBuffer);
-   glBufferData(GL_ELEMENT_ARRAY_BUFFER, mIndexCount * sizeof(U16), mZombieCache, GFXGLBufferType[mBufferType]);
-   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+   if( GFXGL->mCapabilities.directStateAccess )
+   {
+      glCreateBuffers(1, &mBuffer);
+      glNamedBufferData(mBuffer, mIndexCount * sizeof(U16), mZombieCache, GFXGLBufferType[mBufferType]);
+   }
+   else
+   {
+      glGenBuffers(1, &mBuffer);
+      PRESERVE_INDEX_BUFFER();
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBuffer);
+      glBufferData(GL_ELEMENT_ARRAY_BUFFER, mIndexCount * sizeof(U16), mZombieCache, GFXGLBufferType[mBufferType]);
+   }
    
    delete[] mZombieCache;
    mZombieCache = NULL;
@@ -814,6 +814,7 @@ void GFXGLShader::setConstantsFromBuffer(GFXGLShaderConstBuffer* buffer)
          
       // Copy new value into our const buffer and set in GL.
       dMemcpy(mConstBuffer + handle->mOffset, buffer->mBuffer + handle->mOffset, handle->getSize());
+      GFX->getDeviceStatistics()->mShaderConstUploads++;
       switch(handle->mDesc.constType)
       {
          case GFXSCT_Float:
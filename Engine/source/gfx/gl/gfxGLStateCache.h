@@ -4,6 +4,8 @@
 
 /// GFXGLStateCache store OpenGL state to avoid performance penalities of glGet* calls
 /// GL_TEXTURE_1D/2D/3D, GL_FRAMEBUFFER, GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER
+/// and the vertex buffer bound to each stream.  It is also used to skip binds
+/// of objects that are already bound.
 class GFXGLStateCache
 {
 public:
@@ -17,6 +19,23 @@ public:
       mVertexAttribActive = 0;
    }
 
+   /// Matches GFXDevice::VERTEX_STREAM_COUNT.
+   enum { VertexStreamCount = 4 };
+
+   /// A vertex buffer bound with glBindVertexBuffer.
+   class VertexStream
+   {
+   public:
+      VertexStream() : mBuffer(0), mOffset(0), mStride(0), mDivisor(0)
+      {
+
+      }
+      GLuint mBuffer;
+      GLintptr mOffset;
+      GLsizei mStride;
+      GLuint mDivisor;
+   };
+
    class TextureUnit
    {
    public:
@@ -31,26 +50,97 @@ public:
    void setCacheBindedTex(U32 texUnit, GLenum biding, GLuint handle)
    { 
       mActiveTexture = texUnit;
+      setCacheBindedTexUnit(texUnit, biding, handle);
+   }
+
+   /// after glBindTextureUnit / glBindTextures, which leave the active texture alone
+   void setCacheBindedTexUnit(U32 texUnit, GLenum biding, GLuint handle)
+   { 
       switch (biding)
       {
       case GL_TEXTURE_2D:
-         mTextureUnits[mActiveTexture].mTexture2D = handle;
+         mTextureUnits[texUnit].mTexture2D = handle;
          break;
       case GL_TEXTURE_3D:
-         mTextureUnits[mActiveTexture].mTexture3D = handle;
+         mTextureUnits[texUnit].mTexture3D = handle;
          break;
       case GL_TEXTURE_1D:
-         mTextureUnits[mActiveTexture].mTexture1D = handle;
+         mTextureUnits[texUnit].mTexture1D = handle;
          break;
       case GL_TEXTURE_CUBE_MAP:
-         mTextureUnits[mActiveTexture].mTextureCube = handle;
+         mTextureUnits[texUnit].mTextureCube = handle;
          break;
       default:
-         AssertFatal(0, avar("GFXGLStateCache::setCacheBindedTex - binding (%x) not supported.", biding) );
+         AssertFatal(0, avar("GFXGLStateCache::setCacheBindedTexUnit - binding (%x) not supported.", biding) );
          return;
       }
    }
 
+   GLuint getCacheBindedTex(U32 texUnit, GLenum biding) const
+   {
+      switch (biding)
+      {
+      case GL_TEXTURE_2D:
+         return mTextureUnits[texUnit].mTexture2D;
+      case GL_TEXTURE_3D:
+         return mTextureUnits[texUnit].mTexture3D;
+      case GL_TEXTURE_1D:
+         return mTextureUnits[texUnit].mTexture1D;
+      case GL_TEXTURE_CUBE_MAP:
+         return mTextureUnits[texUnit].mTextureCube;
+      default:
+         AssertFatal(0, avar("GFXGLStateCache::getCacheBindedTex - binding (%x) not supported.", biding) );
+         return 0;
+      }
+   }
+
+   /// after glBindTextures with a zero texture, which unbinds every target of the unit
+   void setCacheUnbindedTexUnit(U32 texUnit)
+   {
+      mTextureUnits[texUnit] = TextureUnit();
+   }
+
+   /// after glDeleteTextures, which unbinds the texture from all units.  The
+   /// name may be reused by the next texture so it must not stay in the cache.
+   void setCacheDeletedTex(GLuint handle)
+   {
+      for (U32 i = 0; i < TEXTURE_STAGE_COUNT; i++)
+      {
+         TextureUnit &unit = mTextureUnits[i];
+         if (unit.mTexture1D == handle) unit.mTexture1D = 0;
+         if (unit.mTexture2D == handle) unit.mTexture2D = 0;
+         if (unit.mTexture3D == handle) unit.mTexture3D = 0;
+         if (unit.mTextureCube == handle) unit.mTextureCube = 0;
+      }
+   }
+
+   /// after glBindVertexBuffer / glVertexBindingDivisor, returns false if
+   /// the stream already had this binding
+   bool setCacheVertexStream(U32 stream, GLuint buffer, GLintptr offset, GLsizei stride, GLuint divisor)
+   {
+      VertexStream &vs = mVertexStreams[stream];
+      if (vs.mBuffer == buffer && vs.mOffset == offset && vs.mStride == stride && vs.mDivisor == divisor)
+         return false;
+
+      vs.mBuffer = buffer;
+      vs.mOffset = offset;
+      vs.mStride = stride;
+      vs.mDivisor = divisor;
+      return true;
+   }
+
+   /// after glDeleteBuffers, which unbinds the buffer everywhere
+   void setCacheDeletedBuffer(GLuint handle)
+   {
+      if (mBindedVBO == handle) mBindedVBO = 0;
+      if (mBindedIBO == handle) mBindedIBO = 0;
+      for (U32 i = 0; i < VertexStreamCount; i++)
+      {
+         if (mVertexStreams[i].mBuffer == handle)
+            mVertexStreams[i] = VertexStream();
+      }
+   }
+
    /// after opengl object binded
    void setCacheBinded(GLenum biding, GLuint handle) 
    { 
@@ -126,6 +216,7 @@ public:
 protected:   
    GLuint mActiveTexture, mBindedVBO, mBindedIBO, mBindedFBO_W, mBindedFBO_R;
    TextureUnit mTextureUnits[TEXTURE_STAGE_COUNT];
+   VertexStream mVertexStreams[VertexStreamCount];
    U32 mVertexAttribActive;
 };
 
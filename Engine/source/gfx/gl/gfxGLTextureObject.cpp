@@ -49,6 +49,7 @@ GFXGLTextureObject::GFXGLTextureObject(GFXDevice * aDevice, GFXTextureProfile *p
 
 GFXGLTextureObject::~GFXGLTextureObject() 
 { 
+   mGLDevice->getOpenglCache()->setCacheDeletedTex(mHandle);
    glDeleteTextures(1, &mHandle);
    glDeleteBuffers(1, &mBuffer);
    delete[] mZombieCache;
@@ -99,20 +100,36 @@ void GFXGLTextureObject::unlock(U32 mipLevel)
    // I know this is in unlock, but in GL we actually do our submission in unlock.
    PROFILE_SCOPE(GFXGLTextureObject_lockRT);
 
-   PRESERVE_TEXTURE(mBinding);
-   glBindTexture(mBinding, mHandle);
    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, mBuffer);
    glBufferData(GL_PIXEL_UNPACK_BUFFER, (mLockedRectRect.extent.x + 1) * (mLockedRectRect.extent.y + 1) * mBytesPerTexel, mFrameAllocatorPtr, GL_STREAM_DRAW);
    S32 z = getDepth();
-   if (mBinding == GL_TEXTURE_3D)
-      glTexSubImage3D(mBinding, mipLevel, mLockedRectRect.point.x, mLockedRectRect.point.y, z,
-      mLockedRectRect.extent.x, mLockedRectRect.extent.y, z, GFXGLTextureFormat[mFormat], GFXGLTextureType[mFormat], NULL);
-   else if(mBinding == GL_TEXTURE_2D)
-	   glTexSubImage2D(mBinding, mipLevel, mLockedRectRect.point.x, mLockedRectRect.point.y, 
-		  mLockedRectRect.extent.x, mLockedRectRect.extent.y, GFXGLTextureFormat[mFormat], GFXGLTextureType[mFormat], NULL);
-   else if(mBinding == GL_TEXTURE_1D)
-		glTexSubImage1D(mBinding, mipLevel, (mLockedRectRect.point.x > 1 ? mLockedRectRect.point.x : mLockedRectRect.point.y), 
-		  (mLockedRectRect.extent.x > 1 ? mLockedRectRect.extent.x : mLockedRectRect.extent.y), GFXGLTextureFormat[mFormat], GFXGLTextureType[mFormat], NULL);
+   if (mGLDevice->mCapabilities.directStateAccess)
+   {
+      // Update the texture without disturbing the texture bindings.
+      if (mBinding == GL_TEXTURE_3D)
+         glTextureSubImage3D(mHandle, mipLevel, mLockedRectRect.point.x, mLockedRectRect.point.y, z,
+         mLockedRectRect.extent.x, mLockedRectRect.extent.y, z, GFXGLTextureFormat[mFormat], GFXGLTextureType[mFormat], NULL);
+      else if(mBinding == GL_TEXTURE_2D)
+         glTextureSubImage2D(mHandle, mipLevel, mLockedRectRect.point.x, mLockedRectRect.point.y, 
+         mLockedRectRect.extent.x, mLockedRectRect.extent.y, GFXGLTextureFormat[mFormat], GFXGLTextureType[mFormat], NULL);
+      else if(mBinding == GL_TEXTURE_1D)
+         glTextureSubImage1D(mHandle, mipLevel, (mLockedRectRect.point.x > 1 ? mLockedRectRect.point.x : mLockedRectRect.point.y), 
+         (mLockedRectRect.extent.x > 1 ? mLockedRectRect.extent.x : mLockedRectRect.extent.y), GFXGLTextureFormat[mFormat], GFXGLTextureType[mFormat], NULL);
+   }
+   else
+   {
+      PRESERVE_TEXTURE(mBinding);
+      glBindTexture(mBinding, mHandle);
+      if (mBinding == GL_TEXTURE_3D)
+         glTexSubImage3D(mBinding, mipLevel, mLockedRectRect.point.x, mLockedRectRect.point.y, z,
+         mLockedRectRect.extent.x, mLockedRectRect.extent.y, z, GFXGLTextureFormat[mFormat], GFXGLTextureType[mFormat], NULL);
+      else if(mBinding == GL_TEXTURE_2D)
+         glTexSubImage2D(mBinding, mipLevel, mLockedRectRect.point.x, mLockedRectRect.point.y, 
+           mLockedRectRect.extent.x, mLockedRectRect.extent.y, GFXGLTextureFormat[mFormat], GFXGLTextureType[mFormat], NULL);
+      else if(mBinding == GL_TEXTURE_1D)
+         glTexSubImage1D(mBinding, mipLevel, (mLockedRectRect.point.x > 1 ? mLockedRectRect.point.x : mLockedRectRect.point.y), 
+           (mLockedRectRect.extent.x > 1 ? mLockedRectRect.extent.x : mLockedRectRect.extent.y), GFXGLTextureFormat[mFormat], GFXGLTextureType[mFormat], NULL);
+   }
    
    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
@@ -127,6 +144,7 @@ void GFXGLTextureObject::unlock(U32 mipLevel)
 
 void GFXGLTextureObject::release()
 {
+   mGLDevice->getOpenglCache()->setCacheDeletedTex(mHandle);
    glDeleteTextures(1, &mHandle);
    glDeleteBuffers(1, &mBuffer);
    
@@ -216,6 +234,22 @@ void GFXGLTextureObject::initSamplerState(const GFXSamplerStateDesc &ssd)
 
 void GFXGLTextureObject::bind(U32 textureUnit)
 {
+   if(GFXGL->mCapabilities.samplerObjects)
+   {
+      // Sampler state lives in the sampler objects, so there is
+      // nothing left to do if we are already bound to the unit.
+      GFXGLStateCache* cache = GFXGL->getOpenglCache();
+      if(cache->getCacheBindedTex(textureUnit, mBinding) == mHandle)
+         return;
+
+      if(GFXGL->mCapabilities.directStateAccess)
+      {
+         glBindTextureUnit(textureUnit, mHandle);
+         cache->setCacheBindedTexUnit(textureUnit, mBinding, mHandle);
+         return;
+      }
+   }
+
    glActiveTexture(GL_TEXTURE0 + textureUnit);
    glBindTexture(mBinding, mHandle);
    GFXGL->getOpenglCache()->setCacheBindedTex(textureUnit, mBinding, mHandle);
@@ -0,0 +1,96 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "gfx/gl/gfxGLTimerQuery.h"
+#include "gfx/gl/tGL/tGL.h"
+
+GFXGLTimerQuery::GFXGLTimerQuery(GFXDevice* device) :
+   GFXTimerQuery(device), mQuery(0), mIssued(false)
+{
+}
+
+GFXGLTimerQuery::~GFXGLTimerQuery()
+{
+   if(mQuery)
+      glDeleteQueries(1, &mQuery);
+}
+
+void GFXGLTimerQuery::begin()
+{
+   if(!mQuery)
+      glGenQueries(1, &mQuery);
+
+   glBeginQuery(GL_TIME_ELAPSED, mQuery);
+}
+
+void GFXGLTimerQuery::end()
+{
+   glEndQuery(GL_TIME_ELAPSED);
+   mIssued = true;
+}
+
+GFXTimerQuery::TimerQueryStatus GFXGLTimerQuery::getStatus(bool block, U64* outNanoseconds)
+{
+   PROFILE_SCOPE(GFXGLTimerQuery_getStatus);
+
+   if(!mQuery || !mIssued)
+      return Unset;
+
+   GLint queryDone = false;
+
+   if (block)
+      queryDone = true;
+   else
+      glGetQueryObjectiv(mQuery, GL_QUERY_RESULT_AVAILABLE, &queryDone);
+
+   if (!queryDone)
+      return Waiting;
+
+   GLuint64 elapsed = 0;
+   glGetQueryObjectui64v(mQuery, GL_QUERY_RESULT, &elapsed);
+
+   if (outNanoseconds)
+      *outNanoseconds = elapsed;
+
+   mIssued = false;
+   return Ready;
+}
+
+void GFXGLTimerQuery::zombify()
+{
+   if(mQuery)
+      glDeleteQueries(1, &mQuery);
+   mQuery = 0;
+   mIssued = false;
+}
+
+void GFXGLTimerQuery::resurrect()
+{
+   // Created on next begin().
+}
+
+const String GFXGLTimerQuery::describeSelf() const
+{
+   // We've got nothing
+   return String();
+}
@@ -54,6 +54,13 @@ GFXGLVertexBuffer::GFXGLVertexBuffer(  GFXDevice *device,
    }
 
    // Generate a buffer
+   if( GFXGL->mCapabilities.directStateAccess )
+   {
+      glCreateBuffers(1, &mBuffer);
+      glNamedBufferData(mBuffer, numVerts * vertexSize, NULL, GFXGLBufferType[bufferType]);
+      return;
+   }
+
    glGenBuffers(1, &mBuffer);
 
    //and allocate the needed memory
@@ -66,7 +73,10 @@ GFXGLVertexBuffer::~GFXGLVertexBuffer()
 {
 	// While heavy handed, this does delete the buffer and frees the associated memory.
    if( mBufferType != GFXBufferTypeVolatile )
+   {
+      GFXGL->getOpenglCache()->setCacheDeletedBuffer(mBuffer);
       glDeleteBuffers(1, &mBuffer);
+   }
 
    if( mZombieCache )
       delete [] mZombieCache;
@@ -76,6 +86,8 @@ void GFXGLVertexBuffer::lock( U32 vertexStart, U32 vertexEnd, void **vertexPtr )
 {
    PROFILE_SCOPE(GFXGLVertexBuffer_lock);
 
+   mDevice->getDeviceStatistics()->mBufferLocks++;
+
    if( mBufferType == GFXBufferTypeVolatile )
    {
       AssertFatal(vertexStart == 0, "");
@@ -114,13 +126,23 @@ void GFXGLVertexBuffer::unlock()
       U32 offset = lockedVertexStart * mVertexSize;
       U32 length = (lockedVertexEnd - lockedVertexStart) * mVertexSize;
    
-      PRESERVE_VERTEX_BUFFER();
-      glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+      if( GFXGL->mCapabilities.directStateAccess )
+      {
+         if( !lockedVertexStart && lockedVertexEnd == mNumVerts)
+            glNamedBufferData(mBuffer, mNumVerts * mVertexSize, NULL, GFXGLBufferType[mBufferType]); // orphan the buffer
+
+         glNamedBufferSubData(mBuffer, offset, length, mFrameAllocator.getlockedPtr() + offset );
+      }
+      else
+      {
+         PRESERVE_VERTEX_BUFFER();
+         glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
    
-      if( !lockedVertexStart && lockedVertexEnd == mNumVerts)
-         glBufferData(GL_ARRAY_BUFFER, mNumVerts * mVertexSize, NULL, GFXGLBufferType[mBufferType]); // orphan the buffer
+         if( !lockedVertexStart && lockedVertexEnd == mNumVerts)
+            glBufferData(GL_ARRAY_BUFFER, mNumVerts * mVertexSize, NULL, GFXGLBufferType[mBufferType]); // orphan the buffer
 
-      glBufferSubData(GL_ARRAY_BUFFER, offset, length, mFrameAllocator.getlockedPtr() + offset );
+         glBufferSubData(GL_ARRAY_BUFFER, offset, length, mFrameAllocator.getlockedPtr() + offset );
+      }
 
       mFrameAllocator.unlock();
    }
@@ -139,6 +161,10 @@ void GFXGLVertexBuffer::prepare(U32 stream, U32 divisor)
 {
    if( GFXGL->mCapabilities.vertexAttributeBinding )
    {      
+      // Skip rebinding the same buffer, which is common for the shared volatile buffer.
+      if( !GFXGL->getOpenglCache()->setCacheVertexStream( stream, mBuffer, mBufferOffset, mVertexSize, divisor ) )
+         return;
+
       glBindVertexBuffer( stream, mBuffer, mBufferOffset, mVertexSize );
       glVertexBindingDivisor( stream, divisor );
       return;
@@ -162,9 +188,15 @@ void GFXGLVertexBuffer::zombify()
       return;
       
    mZombieCache = new U8[mNumVerts * mVertexSize];
-   glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
-   glGetBufferSubData(GL_ARRAY_BUFFER, 0, mNumVerts * mVertexSize, mZombieCache);
-   glBindBuffer(GL_ARRAY_BUFFER, 0);
+   if( GFXGL->mCapabilities.directStateAccess )
+      glGetNamedBufferSubData(mBuffer, 0, mNumVerts * mVertexSize, mZombieCache);
+   else
+   {
+      PRESERVE_VERTEX_BUFFER();
+      glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+      glGetBufferSubData(GL_ARRAY_BUFFER, 0, mNumVerts * mVertexSize, mZombieCache);
+   }
+   GFXGL->getOpenglCache()->setCacheDeletedBuffer(mBuffer);
    glDeleteBuffers(1, &mBuffer);
    mBuffer = 0;
 }
@@ -174,10 +206,18 @@ void GFXGLVertexBuffer::resurrect()
    if(!mZombieCache)
       return;
    
-   glGenBuffers(1, &mBuffer);
-   glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
-   glBufferData(GL_ARRAY_BUFFER, mNumVerts * mVertexSize, mZombieCache, GFXGLBufferType[mBufferType]);
-   glBindBuffer(GL_ARRAY_BUFFER, 0);
+   if( GFXGL->mCapabilities.directStateAccess )
+   {
+      glCreateBuffers(1, &mBuffer);
+      glNamedBufferData(mBuffer, mNumVerts * mVertexSize, mZombieCache, GFXGLBufferType[mBufferType]);
+   }
+   else
+   {
+      glGenBuffers(1, &mBuffer);
+      PRESERVE_VERTEX_BUFFER();
+      glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+      glBufferData(GL_ARRAY_BUFFER, mNumVerts * mVertexSize, mZombieCache, GFXGLBufferType[mBufferType]);
+   }
    
    delete[] mZombieCache;
    mZombieCache = NULL;
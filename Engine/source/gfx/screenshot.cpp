@@ -28,6 +28,7 @@
 #include "gui/core/guiCanvas.h"
 #include "gfx/bitmap/pngUtils.h"
 #include "console/engineAPI.h"
+#include "platform/threads/threadPool.h"
 
 
 // Note: This will be initialized by the device.
@@ -215,6 +216,37 @@ void ScreenShot::capture( GuiCanvas *canvas )
 }
 
 
+/// Compresses and writes a screenshot on the thread pool so taking it
+/// doesn't hitch the game.
+struct ScreenShotWriteWorkItem : public ThreadPool::WorkItem
+{
+   typedef ThreadPool::WorkItem Parent;
+
+   ScreenShotWriteWorkItem( GBitmap *bitmap, FileStream *stream, bool writeJPG )
+      : mBitmap( bitmap ),
+        mStream( stream ),
+        mWriteJPG( writeJPG )
+   {
+   }
+
+   ~ScreenShotWriteWorkItem()
+   {
+      delete mStream;
+      delete mBitmap;
+   }
+
+protected:
+   virtual void execute()
+   {
+      mBitmap->writeBitmap( mWriteJPG ? "jpg" : "png", *mStream );
+      mStream->close();
+   }
+
+   GBitmap *mBitmap;
+   FileStream *mStream;
+   bool mWriteJPG;
+};
+
 void ScreenShot::_singleCapture( GuiCanvas *canvas )
 {
    // Let the canvas render the scene.
@@ -235,22 +267,19 @@ void ScreenShot::_singleCapture( GuiCanvas *canvas )
    dSprintf( filename, 256, "%s.%s", mFilename, mWriteJPG ? "jpg" : "png" );
 
    // Open up the file on disk.
-   FileStream fs;
-   if ( !fs.open( filename, Torque::FS::File::Write ) )
-      Con::errorf( "ScreenShot::_singleCapture() - Failed to open output file '%s'!", filename );
-   else
+   FileStream *fs = new FileStream;
+   if ( !fs->open( filename, Torque::FS::File::Write ) )
    {
-      // Write it and close.
-      if ( mWriteJPG )
-         bitmap->writeBitmap( "jpg", fs );
-      else
-         bitmap->writeBitmap( "png", fs );
-
-      fs.close();
+      Con::errorf( "ScreenShot::_singleCapture() - Failed to open output file '%s'!", filename );
+      delete fs;
+      delete bitmap;
+      return;
    }
 
-   // Cleanup.
-   delete bitmap;
+   // Leave the encoding to the thread pool, which takes care of
+   // closing the file and deleting the bitmap.
+   ThreadSafeRef< ScreenShotWriteWorkItem > workItem( new ScreenShotWriteWorkItem( bitmap, fs, mWriteJPG ) );
+   ThreadPool::GLOBAL().queueWorkItem( workItem );
 }
 
 
@@ -0,0 +1,55 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "gfx/gfxStateBlock.h"
+#include <new>
+
+TEST(GFXStateBlockDesc, HashIgnoresPadding)
+{
+   // Build two equal descriptions over memory holding different
+   // garbage, so only the padding between members differs.
+   U32 bufferA[sizeof(GFXStateBlockDesc) / sizeof(U32) + 1];
+   U32 bufferB[sizeof(GFXStateBlockDesc) / sizeof(U32) + 1];
+   dMemset(bufferA, 0x00, sizeof(bufferA));
+   dMemset(bufferB, 0xCD, sizeof(bufferB));
+
+   GFXStateBlockDesc *a = new (bufferA) GFXStateBlockDesc;
+   GFXStateBlockDesc *b = new (bufferB) GFXStateBlockDesc;
+   a->setBlend(true);
+   b->setBlend(true);
+
+   EXPECT_TRUE(*a == *b);
+   EXPECT_EQ(a->getHashValue(), b->getHashValue());
+
+   b->setZReadWrite(true, false);
+   EXPECT_FALSE(*a == *b);
+   EXPECT_NE(a->getHashValue(), b->getHashValue());
+
+   a->~GFXStateBlockDesc();
+   b->~GFXStateBlockDesc();
+}
+
+#endif
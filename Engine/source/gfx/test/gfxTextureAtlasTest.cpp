@@ -0,0 +1,88 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "gfx/gfxTextureAtlas.h"
+
+TEST(GFXAtlasAllocator, Blocks)
+{
+   GFXAtlasAllocator allocator(64);
+
+   // Fill the page with mixed sizes and count the covered texels.
+   U8 used[64][64];
+   dMemset(used, 0, sizeof(used));
+
+   const U32 sizes[] = { 16, 32, 8, 16, 8, 8, 8, 16, 16, 16, 16, 16, 16, 16, 16, 16 };
+   U32 texels = 0;
+   for (U32 i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+   {
+      Point2I pos;
+      ASSERT_TRUE(allocator.allocate(sizes[i], &pos)) << "Block " << i << " should fit";
+      EXPECT_EQ(pos.x % sizes[i], 0) << "Blocks must be aligned to their size";
+      EXPECT_EQ(pos.y % sizes[i], 0) << "Blocks must be aligned to their size";
+
+      for (U32 y = 0; y < sizes[i]; y++)
+         for (U32 x = 0; x < sizes[i]; x++)
+         {
+            EXPECT_EQ(used[pos.y + y][pos.x + x], 0) << "Blocks must not overlap";
+            used[pos.y + y][pos.x + x] = 1;
+         }
+
+      texels += sizes[i] * sizes[i];
+   }
+
+   EXPECT_EQ(texels, 64 * 64);
+
+   Point2I pos;
+   EXPECT_FALSE(allocator.allocate(8, &pos)) << "The page should be full";
+
+   allocator.reset();
+   EXPECT_TRUE(allocator.allocate(64, &pos)) << "Reset should free the page";
+   EXPECT_TRUE(pos.isZero());
+};
+
+TEST(GFXAtlasEntry, Params)
+{
+   GFXAtlasEntry entry;
+   EXPECT_FALSE(entry.isValid());
+
+   entry.cell.set(3, 1);
+   entry.size = 128;
+   entry.pageSize = 1024;
+   EXPECT_TRUE(entry.isValid());
+
+   // Should match what a 8x8 Material::cellLayout grid
+   // of 128 pixel cells passes to the shader.
+   const Point4F params = entry.getAtlasParams();
+   EXPECT_EQ(params.x, 1.0f / 8.0f);
+   EXPECT_EQ(params.y, 1.0f / 8.0f);
+   EXPECT_EQ(params.z, 128.0f);
+   EXPECT_EQ(params.w, 7.0f);
+
+   const Point4F tile = entry.getTileParams();
+   EXPECT_EQ(tile.x, 3.0f);
+   EXPECT_EQ(tile.y, 1.0f);
+};
+
+#endif
@@ -134,7 +134,8 @@ S32 QSORT_CALLBACK cmpSortDistanceFieldSearchSpaceStruct(const void* p1, const v
 
 void GFXUtil::DistanceField::makeDistanceField( const U8 * sourceData, S32 sourceSizeX, S32 sourceSizeY, U8 * targetData, S32 targetSizeX, S32 targetSizeY, F32 radius )
 {
-   static Vector<DistanceFieldSearchSpaceStruct> searchSpace;
+   // Kept local so font glyph fields can be generated on worker threads.
+   Vector<DistanceFieldSearchSpaceStruct> searchSpace;
 
    S32 targetToSourceScalarX = sourceSizeX / targetSizeX;
    S32 targetToSourceScalarY = sourceSizeY / targetSizeY;
@@ -176,7 +177,7 @@ void GFXUtil::DistanceField::makeDistanceField( const U8 * sourceData, S32 sourc
 
          F32 closestDist = F32_MAX;
 
-         for(DistanceFieldSearchSpaceStruct * seachSpaceStructPtr = searchSpace.begin(); seachSpaceStructPtr <= searchSpace.end(); seachSpaceStructPtr++)
+         for(DistanceFieldSearchSpaceStruct * seachSpaceStructPtr = searchSpace.begin(); seachSpaceStructPtr < searchSpace.end(); seachSpaceStructPtr++)
          {
             DistanceFieldSearchSpaceStruct & searchSpaceStruct = *seachSpaceStructPtr;
             S32 cx = sourceX + searchSpaceStruct.xOffset;
@@ -201,6 +202,4 @@ void GFXUtil::DistanceField::makeDistanceField( const U8 * sourceData, S32 sourc
          targetData++;
       }
    }
-
-   searchSpace.clear();
 }
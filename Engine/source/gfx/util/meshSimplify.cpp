@@ -0,0 +1,398 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "gfx/util/meshSimplify.h"
+#include "core/util/tVector.h"
+#include "platform/profiler.h"
+#include "math/mMathFn.h"
+
+namespace MeshSimplify
+{
+
+namespace
+{
+   /// Sum of squared distances to a set of planes, each weighted by the area
+   /// of the triangle it came from.
+   struct Quadric
+   {
+      F64 a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+      F64 weight;
+
+      void zero()
+      {
+         a2 = ab = ac = ad = b2 = bc = bd = c2 = cd = d2 = weight = 0.0;
+      }
+
+      void addPlane(const Point3F &n, const F64 d, const F64 w)
+      {
+         a2 += w * n.x * n.x;  ab += w * n.x * n.y;  ac += w * n.x * n.z;  ad += w * n.x * d;
+         b2 += w * n.y * n.y;  bc += w * n.y * n.z;  bd += w * n.y * d;
+         c2 += w * n.z * n.z;  cd += w * n.z * d;
+         d2 += w * d * d;
+         weight += w;
+      }
+
+      void add(const Quadric &q)
+      {
+         a2 += q.a2;  ab += q.ab;  ac += q.ac;  ad += q.ad;
+         b2 += q.b2;  bc += q.bc;  bd += q.bd;
+         c2 += q.c2;  cd += q.cd;
+         d2 += q.d2;
+         weight += q.weight;
+      }
+
+      /// Area weighted mean of the squared distances from p to the planes
+      F64 eval(const Point3F &p) const
+      {
+         if(weight <= 0.0)
+            return 0.0;
+
+         const F64 x = p.x, y = p.y, z = p.z;
+         const F64 r = a2 * x * x + b2 * y * y + c2 * z * z + d2 +
+            2.0 * (ab * x * y + ac * x * z + bc * y * z + ad * x + bd * y + cd * z);
+         return mFabsD(r) / weight;
+      }
+   };
+
+   struct WeldSortData
+   {
+      Point3F pos;
+      U32 vert;
+   };
+
+   S32 QSORT_CALLBACK compareWeld(const void *a, const void *b)
+   {
+      const WeldSortData *wa = (const WeldSortData*)a;
+      const WeldSortData *wb = (const WeldSortData*)b;
+
+      for(U32 i = 0; i < 3; i++)
+      {
+         if(wa->pos[i] != wb->pos[i])
+            return wa->pos[i] < wb->pos[i] ? -1 : 1;
+      }
+      return S32(wa->vert) - S32(wb->vert);
+   }
+
+   S32 QSORT_CALLBACK compareEdges(const void *a, const void *b)
+   {
+      const U64 ea = *(const U64*)a;
+      const U64 eb = *(const U64*)b;
+      return (ea < eb) ? -1 : ((ea > eb) ? 1 : 0);
+   }
+
+   struct Collapse
+   {
+      U32 from;      ///< vertex being removed
+      U32 to;        ///< vertex replacing it
+      F64 cost;
+   };
+
+   S32 QSORT_CALLBACK compareCollapses(const void *a, const void *b)
+   {
+      const Collapse *ca = (const Collapse*)a;
+      const Collapse *cb = (const Collapse*)b;
+
+      // Cheapest first, ties keep the order of the triangle list
+      if(ca->cost != cb->cost)
+         return ca->cost < cb->cost ? -1 : 1;
+      if(ca->from != cb->from)
+         return S32(ca->from) - S32(cb->from);
+      return S32(ca->to) - S32(cb->to);
+   }
+
+   inline bool isLive(const U32 *tri, const U32 *weld)
+   {
+      return weld[tri[0]] != weld[tri[1]] && weld[tri[1]] != weld[tri[2]] && weld[tri[2]] != weld[tri[0]];
+   }
+}
+
+U32 SimplifyTriangles(const Point3F *positions, const dsize_t numVerts, const dsize_t numIndices, U32 *indices,
+                      const dsize_t targetIndices, const F32 maxError, F32 *outError)
+{
+   PROFILE_SCOPE(MeshSimplify_SimplifyTriangles);
+
+   if(outError)
+      *outError = 0.0f;
+
+   const U32 numTris = numIndices / 3;
+   if(numVerts == 0 || numTris == 0)
+      return numTris * 3;
+
+   // Weld vertices by position, so attribute seams do not look like borders.
+   // Each vertex maps to the first vertex at its position, and vertices
+   // shared by several positions (seams) are locked.
+   Vector<U32> weld;
+   Vector<bool> locked;
+   weld.setSize(numVerts);
+   locked.setSize(numVerts);
+   {
+      Vector<WeldSortData> sortData;
+      sortData.setSize(numVerts);
+      for(U32 v = 0; v < numVerts; v++)
+      {
+         sortData[v].pos = positions[v];
+         sortData[v].vert = v;
+         locked[v] = false;
+      }
+      dQsort(sortData.address(), sortData.size(), sizeof(WeldSortData), compareWeld);
+
+      for(U32 start = 0; start < numVerts; )
+      {
+         U32 end = start + 1;
+         while(end < numVerts && sortData[end].pos == sortData[start].pos)
+            end++;
+
+         for(U32 i = start; i < end; i++)
+            weld[sortData[i].vert] = sortData[start].vert;
+         if(end - start > 1)
+            locked[sortData[start].vert] = true;
+
+         start = end;
+      }
+   }
+
+   // Triangles that are already degenerate are removed up front
+   U32 liveIndices = 0;
+   for(U32 t = 0; t < numTris; t++)
+   {
+      U32 *tri = indices + t * 3;
+      if(isLive(tri, weld.address()))
+         liveIndices += 3;
+      else
+         tri[1] = tri[2] = tri[0];
+   }
+
+   // Lock the ends of every edge that is not shared by exactly two triangles
+   // (open borders and non-manifold edges)
+   {
+      Vector<U64> edges;
+      edges.reserve(liveIndices);
+      for(U32 t = 0; t < numTris; t++)
+      {
+         const U32 *tri = indices + t * 3;
+         if(tri[0] == tri[1])
+            continue;
+
+         for(U32 c = 0; c < 3; c++)
+         {
+            const U64 a = weld[tri[c]];
+            const U64 b = weld[tri[(c + 1) % 3]];
+            edges.push_back(a < b ? ((a << 32) | b) : ((b << 32) | a));
+         }
+      }
+      dQsort(edges.address(), edges.size(), sizeof(U64), compareEdges);
+
+      for(U32 start = 0; start < edges.size(); )
+      {
+         U32 end = start + 1;
+         while(end < edges.size() && edges[end] == edges[start])
+            end++;
+
+         if(end - start != 2)
+         {
+            locked[U32(edges[start] >> 32)] = true;
+            locked[U32(edges[start] & 0xFFFFFFFF)] = true;
+         }
+
+         start = end;
+      }
+   }
+
+   // Initial quadrics, one per welded vertex
+   Vector<Quadric> quadrics;
+   quadrics.setSize(numVerts);
+   for(U32 v = 0; v < numVerts; v++)
+      quadrics[v].zero();
+
+   for(U32 t = 0; t < numTris; t++)
+   {
+      const U32 *tri = indices + t * 3;
+      if(tri[0] == tri[1])
+         continue;
+
+      const Point3F &p0 = positions[tri[0]];
+      Point3F normal = mCross(positions[tri[1]] - p0, positions[tri[2]] - p0);
+      const F32 len = normal.len();
+      if(len <= 0.0f)
+         continue;
+
+      normal /= len;
+      const F64 d = -mDot(normal, p0);
+      for(U32 c = 0; c < 3; c++)
+         quadrics[weld[tri[c]]].addPlane(normal, d, 0.5 * len);
+   }
+
+   const F64 maxCost = F64(maxError) * F64(maxError);
+   F64 largestCost = 0.0;
+
+   Vector<U32> adjOffsets;
+   Vector<U32> adjTris;
+   Vector<Collapse> collapses;
+   Vector<bool> touched;
+
+   // Collapse in passes.  Each pass collapses the cheapest edges whose
+   // neighbourhoods do not overlap, so the costs and adjacency computed at the
+   // start of the pass stay valid for every collapse it performs.
+   while(liveIndices > targetIndices)
+   {
+      // Welded vertex to live triangle adjacency
+      adjOffsets.setSize(numVerts + 1);
+      dMemset(adjOffsets.address(), 0, adjOffsets.memSize());
+      for(U32 t = 0; t < numTris; t++)
+      {
+         const U32 *tri = indices + t * 3;
+         if(tri[0] == tri[1])
+            continue;
+         for(U32 c = 0; c < 3; c++)
+            adjOffsets[weld[tri[c]] + 1]++;
+      }
+      for(U32 v = 1; v <= numVerts; v++)
+         adjOffsets[v] += adjOffsets[v - 1];
+
+      adjTris.setSize(adjOffsets.last());
+      for(U32 t = 0; t < numTris; t++)
+      {
+         const U32 *tri = indices + t * 3;
+         if(tri[0] == tri[1])
+            continue;
+         for(U32 c = 0; c < 3; c++)
+            adjTris[adjOffsets[weld[tri[c]]]++] = t;
+      }
+      for(U32 v = numVerts; v > 0; v--)
+         adjOffsets[v] = adjOffsets[v - 1];
+      adjOffsets[0] = 0;
+
+      // Candidate collapses along every edge, in both directions.  Unlocked
+      // vertices are never welded to others, so they are their own weld.
+      collapses.clear();
+      for(U32 t = 0; t < numTris; t++)
+      {
+         const U32 *tri = indices + t * 3;
+         if(tri[0] == tri[1])
+            continue;
+
+         for(U32 c = 0; c < 3; c++)
+         {
+            const U32 a = tri[c];
+            const U32 b = tri[(c + 1) % 3];
+            for(U32 dir = 0; dir < 2; dir++)
+            {
+               const U32 from = dir ? b : a;
+               const U32 to = dir ? a : b;
+               if(locked[weld[from]])
+                  continue;
+
+               Quadric q = quadrics[from];
+               q.add(quadrics[weld[to]]);
+
+               collapses.increment();
+               Collapse &collapse = collapses.last();
+               collapse.from = from;
+               collapse.to = to;
+               collapse.cost = q.eval(positions[to]);
+            }
+         }
+      }
+
+      if(collapses.empty())
+         break;
+
+      dQsort(collapses.address(), collapses.size(), sizeof(Collapse), compareCollapses);
+
+      touched.setSize(numVerts);
+      for(U32 v = 0; v < numVerts; v++)
+         touched[v] = false;
+
+      U32 removed = 0;
+      for(U32 i = 0; i < collapses.size() && liveIndices - removed > targetIndices; i++)
+      {
+         const Collapse &collapse = collapses[i];
+         if(collapse.cost > maxCost)
+            break;
+
+         const U32 from = collapse.from;
+         const U32 to = weld[collapse.to];
+         if(touched[from] || touched[to])
+            continue;
+
+         // Reject the collapse if any remaining triangle around 'from' would
+         // flip or become degenerate
+         const Point3F &newPos = positions[collapse.to];
+         bool valid = true;
+         for(U32 a = adjOffsets[from]; a < adjOffsets[from + 1] && valid; a++)
+         {
+            const U32 *tri = indices + adjTris[a] * 3;
+            if(weld[tri[0]] == to || weld[tri[1]] == to || weld[tri[2]] == to)
+               continue;
+
+            const Point3F &p0 = positions[tri[0]];
+            const Point3F &p1 = positions[tri[1]];
+            const Point3F &p2 = positions[tri[2]];
+            const Point3F oldNormal = mCross(p1 - p0, p2 - p0);
+            const Point3F newNormal = mCross((tri[1] == from ? newPos : p1) - (tri[0] == from ? newPos : p0),
+                                             (tri[2] == from ? newPos : p2) - (tri[0] == from ? newPos : p0));
+            valid = mDot(oldNormal, newNormal) > 0.0f;
+         }
+         if(!valid)
+            continue;
+
+         // Apply it, and keep the rest of this pass away from the affected
+         // triangles
+         for(U32 a = adjOffsets[from]; a < adjOffsets[from + 1]; a++)
+         {
+            U32 *tri = indices + adjTris[a] * 3;
+            for(U32 c = 0; c < 3; c++)
+               touched[weld[tri[c]]] = true;
+
+            if(weld[tri[0]] == to || weld[tri[1]] == to || weld[tri[2]] == to)
+            {
+               tri[1] = tri[2] = tri[0];
+               removed += 3;
+            }
+            else
+            {
+               for(U32 c = 0; c < 3; c++)
+               {
+                  if(tri[c] == from)
+                     tri[c] = collapse.to;
+               }
+            }
+         }
+
+         quadrics[to].add(quadrics[from]);
+         largestCost = getMax(largestCost, collapse.cost);
+      }
+
+      if(removed == 0)
+         break;
+
+      liveIndices -= removed;
+   }
+
+   if(outError)
+      *outError = F32(mSqrtD(largestCost));
+
+   return liveIndices;
+}
+
+};
@@ -0,0 +1,58 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _MESH_SIMPLIFY_H_
+#define _MESH_SIMPLIFY_H_
+
+#include "math/mPoint3.h"
+
+namespace MeshSimplify
+{
+   /// This method reduces a triangle list by collapsing edges in order of
+   /// their quadric error, as described in Garland and Heckbert's paper:
+   /// "Surface Simplification Using Quadric Error Metrics"
+   ///
+   /// Collapses are half edge collapses, a vertex is only ever replaced by one
+   /// of its neighbours, so the remaining vertices keep their exact attributes
+   /// (and skin weights).  Vertices on open borders, non-manifold edges and
+   /// attribute seams (several vertices sharing a position) are never removed,
+   /// and collapses that would flip a triangle are skipped.
+   /// @param     positions Vertex positions, indexed by 'indices'
+   /// @param      numVerts Number of vertices indexed by 'indices'
+   /// @param    numIndices Number of elements in 'indices'
+   /// @param       indices Triangle list, simplified in place.  Removed
+   ///                      triangles are left in the list with all three
+   ///                      indices equal, so callers can rebuild their own
+   ///                      primitive ranges
+   /// @param targetIndices Stop once no more than this many indices remain
+   /// @param      maxError Stop before a collapse would move the surface
+   ///                      further than this distance
+   /// @param      outError If not NULL, receives the largest error (as a
+   ///                      distance) of the collapses performed
+   ///
+   /// @return The number of indices of the remaining triangles
+   U32 SimplifyTriangles(const Point3F *positions, const dsize_t numVerts, const dsize_t numIndices, U32 *indices,
+                         const dsize_t targetIndices, const F32 maxError = F32_MAX, F32 *outError = NULL);
+};
+
+#endif
@@ -21,7 +21,7 @@
 //-----------------------------------------------------------------------------
 
 #include "gfx/util/triListOpt.h"
-#include "core/frameAllocator.h"
+#include "core/util/tVector.h"
 #include "platform/profiler.h"
 #include "math/mMathFn.h"
 
@@ -44,8 +44,11 @@ void OptimizeTriangleOrdering(const dsize_t numVerts, const dsize_t numIndices,
    //
    // Step 1: Run through the data, and initialize
    //
-   FrameTemp<VertData> vertexData(numVerts);
-   FrameTemp<TriData> triangleData(NumPrimitives);
+   // Heap rather than FrameTemp so meshes can be optimized on worker threads
+   Vector<VertData> vertexData;
+   Vector<TriData> triangleData;
+   vertexData.setSize(numVerts);
+   triangleData.setSize(NumPrimitives);
 
    U32 curIdx = 0;
    for(S32 tri = 0; tri < NumPrimitives; tri++)
@@ -217,7 +220,206 @@ void OptimizeTriangleOrdering(const dsize_t numVerts, const dsize_t numIndices,
 #undef _CHECK_NEXT_NEXT_BEST
 #undef _VALIDATE_TRI_IDX
 
-   // FrameTemp will call destructInPlace to clean up vertex lists
+   // Vector will call destructInPlace to clean up vertex lists
+}
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+   /// Feeds a triangle to a FIFO vertex cache model in which a vertex is
+   /// cached if it missed less than 'cacheSize' misses ago.
+   /// @return The number of cache misses for the triangle
+   U32 simulateCache(const IndexType *tri, Vector<U32> &timestamps, U32 &time)
+   {
+      U32 misses = 0;
+      for(S32 c = 0; c < 3; c++)
+      {
+         if(time - timestamps[tri[c]] > OverdrawCacheSize)
+         {
+            timestamps[tri[c]] = time++;
+            misses++;
+         }
+      }
+      return misses;
+   }
+
+   struct ClusterSortData
+   {
+      U32 cluster;
+      F32 key;
+   };
+
+   S32 QSORT_CALLBACK compareClusters(const void *a, const void *b)
+   {
+      const ClusterSortData *ca = (const ClusterSortData*)a;
+      const ClusterSortData *cb = (const ClusterSortData*)b;
+
+      // Highest key first, ties keep the cache optimized order
+      if(ca->key != cb->key)
+         return ca->key > cb->key ? -1 : 1;
+      return S32(ca->cluster) - S32(cb->cluster);
+   }
+}
+
+void OptimizeOverdraw(const Point3F *positions, const dsize_t numVerts, const dsize_t numIndices, IndexType *indices, const F32 threshold)
+{
+   PROFILE_SCOPE(TriListOpt_OptimizeOverdraw);
+
+   const U32 NumPrimitives = numIndices / 3;
+   if(NumPrimitives < 2 || numVerts == 0)
+      return;
+
+   // Flushing the cache is done by advancing time past the cache size
+   Vector<U32> timestamps;
+   timestamps.setSize(numVerts);
+   dMemset(timestamps.address(), 0, timestamps.memSize());
+   U32 time = OverdrawCacheSize + 1;
+
+   //
+   // Step 1: Hard cluster boundaries, where a triangle misses all of its vertices
+   //
+   Vector<U32> hardClusters;
+   for(U32 tri = 0; tri < NumPrimitives; tri++)
+   {
+      if(simulateCache(indices + tri * 3, timestamps, time) == 3 || tri == 0)
+         hardClusters.push_back(tri);
+   }
+
+   //
+   // Step 2: Split the hard clusters wherever the triangles so far have a
+   // cache miss ratio within 'threshold' of the whole cluster
+   //
+   Vector<U32> clusters;
+   for(S32 i = 0; i < hardClusters.size(); i++)
+   {
+      const U32 start = hardClusters[i];
+      const U32 end = (i + 1 < hardClusters.size()) ? hardClusters[i + 1] : NumPrimitives;
+
+      time += OverdrawCacheSize + 1;
+      U32 misses = 0;
+      for(U32 tri = start; tri < end; tri++)
+         misses += simulateCache(indices + tri * 3, timestamps, time);
+
+      const F32 clusterThreshold = threshold * F32(misses) / F32(end - start);
+
+      clusters.push_back(start);
+      time += OverdrawCacheSize + 1;
+      misses = 0;
+      U32 clusterStart = start;
+      for(U32 tri = start; tri < end; tri++)
+      {
+         misses += simulateCache(indices + tri * 3, timestamps, time);
+
+         if(tri + 1 < end && misses <= clusterThreshold * (tri + 1 - clusterStart))
+         {
+            clusters.push_back(tri + 1);
+            clusterStart = tri + 1;
+            misses = 0;
+            time += OverdrawCacheSize + 1;
+         }
+      }
+   }
+
+   if(clusters.size() < 2)
+      return;
+
+   //
+   // Step 3: Area weighted centroid and normal of each cluster, and of the mesh
+   //
+   Vector<Point3F> clusterCentroids;
+   Vector<Point3F> clusterNormals;
+   clusterCentroids.setSize(clusters.size());
+   clusterNormals.setSize(clusters.size());
+
+   Point3F meshCentroid(Point3F::Zero);
+   F32 meshArea = 0.0f;
+
+   for(S32 i = 0; i < clusters.size(); i++)
+   {
+      const U32 end = (i + 1 < clusters.size()) ? clusters[i + 1] : NumPrimitives;
+
+      Point3F centroid(Point3F::Zero);
+      Point3F normal(Point3F::Zero);
+      F32 area = 0.0f;
+
+      for(U32 tri = clusters[i]; tri < end; tri++)
+      {
+         const Point3F &p0 = positions[indices[tri * 3 + 0]];
+         const Point3F &p1 = positions[indices[tri * 3 + 1]];
+         const Point3F &p2 = positions[indices[tri * 3 + 2]];
+
+         const Point3F triNormal = mCross(p1 - p0, p2 - p0);
+         const F32 triArea = triNormal.len();
+
+         centroid += (p0 + p1 + p2) * (triArea / 3.0f);
+         normal += triNormal;
+         area += triArea;
+      }
+
+      meshCentroid += centroid;
+      meshArea += area;
+
+      clusterCentroids[i] = (area > 0.0f) ? centroid / area : centroid;
+      clusterNormals[i] = normal;
+      clusterNormals[i].normalizeSafe();
+   }
+
+   if(meshArea > 0.0f)
+      meshCentroid /= meshArea;
+
+   //
+   // Step 4: Sort the clusters by how much they face away from the mesh center
+   //
+   Vector<ClusterSortData> sortData;
+   sortData.setSize(clusters.size());
+   for(S32 i = 0; i < clusters.size(); i++)
+   {
+      sortData[i].cluster = i;
+      sortData[i].key = mDot(clusterCentroids[i] - meshCentroid, clusterNormals[i]);
+   }
+   dQsort(sortData.address(), sortData.size(), sizeof(ClusterSortData), compareClusters);
+
+   Vector<IndexType> sorted;
+   sorted.reserve(NumPrimitives * 3);
+   for(S32 i = 0; i < sortData.size(); i++)
+   {
+      const U32 cluster = sortData[i].cluster;
+      const U32 start = clusters[cluster];
+      const U32 end = (cluster + 1 < clusters.size()) ? clusters[cluster + 1] : NumPrimitives;
+      for(U32 idx = start * 3; idx < end * 3; idx++)
+         sorted.push_back(indices[idx]);
+   }
+
+   dCopyArray(indices, sorted.address(), NumPrimitives * 3);
+}
+
+//------------------------------------------------------------------------------
+
+U32 OptimizeVertexFetch(const dsize_t numVerts, const dsize_t numIndices, const IndexType *indices, U32 *outRemap)
+{
+   PROFILE_SCOPE(TriListOpt_OptimizeVertexFetch);
+
+   for(U32 v = 0; v < numVerts; v++)
+      outRemap[v] = U32_MAX;
+
+   U32 nextVert = 0;
+   for(U32 i = 0; i < numIndices; i++)
+   {
+      const IndexType idx = indices[i];
+      AssertFatal(idx < numVerts, "Index out of range in index buffer");
+      if(outRemap[idx] == U32_MAX)
+         outRemap[idx] = nextVert++;
+   }
+
+   const U32 numReferenced = nextVert;
+   for(U32 v = 0; v < numVerts; v++)
+   {
+      if(outRemap[v] == U32_MAX)
+         outRemap[v] = nextVert++;
+   }
+
+   return numReferenced;
 }
 
 //------------------------------------------------------------------------------
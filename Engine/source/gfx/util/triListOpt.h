@@ -24,6 +24,7 @@
 #define _TRI_LIST_OPT_H_
 
 #include "core/util/tVector.h"
+#include "math/mPoint3.h"
 
 namespace TriListOpt
 {
@@ -86,6 +87,36 @@ namespace TriListOpt
    /// @note Both 'indices' and 'outIndices' can point to the same memory.
    void OptimizeTriangleOrdering(const dsize_t numVerts, const dsize_t numIndices, const U32 *indices, IndexType *outIndices);
 
+   /// Vertex cache size assumed by OptimizeOverdraw, that of a typical post
+   /// transform cache.
+   const U32 OverdrawCacheSize = 16;
+
+   /// This method reorders the triangles of a triangle list that has been run
+   /// through OptimizeTriangleOrdering to reduce overdraw.  The list is cut
+   /// into clusters wherever that costs little vertex cache efficiency, and the
+   /// clusters are sorted so that those facing away from the mesh center draw
+   /// first, as described in Sander, Nehab and Barczak's paper:
+   /// "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"
+   /// @param  positions Vertex positions, indexed by 'indices'
+   /// @param   numVerts Number of vertices indexed by 'indices'
+   /// @param numIndices Number of elements in 'indices'
+   /// @param    indices Index buffer, reordered in place
+   /// @param  threshold How much worse than the cache optimized order the
+   ///                   average cache miss ratio of a cluster may become
+   void OptimizeOverdraw(const Point3F *positions, const dsize_t numVerts, const dsize_t numIndices, IndexType *indices, const F32 threshold = 1.05f);
+
+   /// This method generates a vertex remap table that orders the vertices by
+   /// their first use in the index buffer, so that vertex fetches walk the
+   /// vertex buffer linearly.  Vertices which are not referenced are moved to
+   /// the end, in their original order.
+   /// @param   numVerts Number of vertices indexed by 'indices'
+   /// @param numIndices Number of elements in 'indices'
+   /// @param    indices Index buffer
+   /// @param   outRemap New index of each vertex, 'numVerts' elements
+   ///
+   /// @return The number of vertices referenced by 'indices'
+   U32 OptimizeVertexFetch(const dsize_t numVerts, const dsize_t numIndices, const IndexType *indices, U32 *outRemap);
+
    namespace FindVertexScore
    {
       const F32 CacheDecayPower = 1.5f;
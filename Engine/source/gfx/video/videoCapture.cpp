@@ -132,6 +132,16 @@ void VideoCapture::end()
    if (!mIsRecording)
       return;
 
+   // Encode the frames still being read back
+   if (mFrameGrabber && mEncoder)
+   {
+      mFrameGrabber->poll( true );
+
+      GBitmap *bitmap = NULL;
+      while ( (bitmap = mFrameGrabber->fetchBitmap()) != NULL )
+         mEncoder->pushFrame(bitmap);
+   }
+
    if (mEncoder && !mEncoder->end())
       Con::errorf("VideoCapture: an error has ocurred while closing the video stream");
 
@@ -178,6 +188,8 @@ void VideoCapture::capture()
    }
 
    // Fetch bitmaps from the framegrabber and encode them
+   mFrameGrabber->poll( false );
+
    GBitmap *bitmap = NULL;
    while ( (bitmap = mFrameGrabber->fetchBitmap()) != NULL )
    {     
@@ -84,6 +84,11 @@ protected:
    /// Depending on the VideoFrameGrabber implementation, this may not produce a bitmap right away.
    virtual void makeBitmap() = 0;
 
+   /// Turns captures the GPU has finished with into bitmaps for implementations
+   /// that read back asynchronously.  Called every captured frame.
+   /// @param wait If true, wait for all requested bitmaps.  Used when the capture ends.
+   virtual void poll( bool wait ) {}
+
    /// Releases internal textures
    virtual void releaseTextures() {};
 
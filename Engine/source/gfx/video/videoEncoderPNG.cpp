@@ -24,47 +24,114 @@
 #include "core/stream/fileStream.h"
 #include "console/console.h"
 #include "gfx/bitmap/gBitmap.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/semaphore.h"
 
 /// This is a very basic "encoder" that records the video as a series of numbered PNGs
 /// Good if you're having problems with container-based formats and need extra flexibility.
-class VideoEncoderPNG : public VideoEncoder
+///
+/// The PNGs are compressed and written on a thread of their own.
+class VideoEncoderPNG : public VideoEncoder, public Thread
 {
+   enum
+   {
+      /// Frames that can wait to be written before pushFrame() blocks.
+      MaxQueuedFrames = 4,
+   };
+
    U32 mCurrentFrame;
 
+   GBitmap* mLastFrame;
+
+   ThreadSafeDeque< GBitmap* > mFrameBitmapList; // List with unwritten frame bitmaps
+   Semaphore mQueued;      // Counts the queued frames for the writer thread
+   Semaphore mFreeSlots;   // Keeps the writer from falling too far behind
+
+   bool mErrorStatus; // False once writing a frame failed
+
+   /// Writes one frame
+   void writeFrame( GBitmap* bitmap )
+   {
+      PROFILE_SCOPE(VideoEncoderPNG_writeFrame);
+
+      FileStream fs;
+      String framePath = mPath + String::ToString("%.6u.png", mCurrentFrame);
+      if ( !fs.open( framePath, Torque::FS::File::Write ) )
+      {
+         Platform::outputDebugString( "VideoEncoderPNG::writeFrame() - Failed to open output file '%s'!", framePath.c_str() );
+         mErrorStatus = false;
+      }
+      else if ( !bitmap->writeBitmap("png", fs, 0) )
+         mErrorStatus = false;
+
+      //Increment
+      mCurrentFrame++;
+
+      // Repeated frames share the bitmap, so only give it back once a
+      // different one comes along
+      if (mLastFrame && mLastFrame != bitmap)
+         pushProcessedBitmap(mLastFrame);
+      mLastFrame = bitmap;
+
+      mFreeSlots.release();
+   }
+
 public:
+   VideoEncoderPNG() :
+      mCurrentFrame(0), mLastFrame(NULL), mQueued(0), mFreeSlots(MaxQueuedFrames), mErrorStatus(true)
+   {
+   }
+
+   virtual void run( void* arg )
+   {
+      _setName( "PNGEncoderThread" );
+      while (true)
+      {
+         mQueued.acquire();
+
+         GBitmap* bitmap = NULL;
+         if (mFrameBitmapList.tryPopFront(bitmap))
+            writeFrame(bitmap);
+         else if (checkForStop())
+            break;
+      }
+
+      if (mLastFrame)
+         pushProcessedBitmap(mLastFrame);
+      mLastFrame = NULL;
+   }
+
    /// Begins accepting frames for encoding
    bool begin()
    {
       mPath += "\\";
       mCurrentFrame = 0;
+      mErrorStatus = true;
 
+      start();
       return true;
    }
 
    /// Pushes a new frame into the video stream
    bool pushFrame( GBitmap * bitmap )
    {
-      FileStream fs;
-      String framePath = mPath + String::ToString("%.6u.png", mCurrentFrame);
-      if ( !fs.open( framePath, Torque::FS::File::Write ) )
-      {
-         Con::errorf( "VideoEncoderPNG::pushFrame() - Failed to open output file '%s'!", framePath.c_str() );
-         return false;
-      }
+      mFreeSlots.acquire();
 
-      //Increment
-      mCurrentFrame++;
+      mFrameBitmapList.pushBack( bitmap );
+      mQueued.release();
 
-      bool result = bitmap->writeBitmap("png", fs, 0);
-      pushProcessedBitmap(bitmap);
- 
-      return result;
+      return mErrorStatus;
    }
 
    /// Finishes the encoding and closes the video
    bool end()
    {
-      return true;
+      // Let the thread write out whatever is still queued
+      stop();
+      mQueued.release();
+      join();
+
+      return mErrorStatus;
    }
 
    void setResolution( Point2I* resolution ) 
@@ -33,6 +33,7 @@
 #include "platform/profiler.h"
 #include "gfx/gfxDevice.h"
 #include "gfx/gfxDrawUtil.h"
+#include "gfx/gfxGPUTimings.h"
 #include "gui/core/guiTypes.h"
 #include "gui/core/guiControl.h"
 #include "gui/editor/guiMenuBar.h"
@@ -150,6 +151,9 @@ GuiCanvas::GuiCanvas(): GuiControl(),
 #else
    mNumFences = 0;
 #endif
+
+   mPipelineFrames = Con::getBoolVariable( "$pref::Video::pipelineFrames", false );
+   mFenceBlockPending = false;
 }
 
 GuiCanvas::~GuiCanvas()
@@ -178,6 +182,10 @@ void GuiCanvas::initPersistFields()
 
    addGroup("Canvas Rendering");
    addProtectedField( "numFences", TypeS32, Offset( mNumFences, GuiCanvas ), &setProtectedNumFences, &defaultProtectedGetFn, "The number of GFX fences to use." );
+   addField( "pipelineFrames", TypeBool, Offset( mPipelineFrames, GuiCanvas ),
+      "If true, the wait on the GFX fences is moved from the end of a frame to the start of the next one.  "
+      "The simulation update in between then overlaps with the GPU still working on the previous frame, "
+      "bounding the frame time by the slower of the two rather than their sum.  Has no effect without fences." );
 
    addField("displayWindow", TypeBool, Offset(mDisplayWindow, GuiCanvas), "Controls if the canvas window is rendered or not." );
    endGroup("Canvas Rendering");
@@ -1695,6 +1703,7 @@ void GuiCanvas::setupFences()
 
    // Reset state
    mNextFenceIdx = 0;
+   mFenceBlockPending = false;
 }
 
 void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
@@ -1703,6 +1712,15 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
    if(!mPlatformWindow->isVisible() || !GFX->allowRender() || GFX->canCurrentlyRender())
       return;
 
+   // Catch up on the fence block deferred from the last frame now that the
+   // simulation has been updated for this one.
+   if( mFenceBlockPending )
+   {
+      PROFILE_SCOPE(CanvasFenceBlock);
+      mFences[mNextFenceIdx]->block();
+      mFenceBlockPending = false;
+   }
+
    PROFILE_START(CanvasPreRender);
 
    // Set our window as the current render target so we can see outputs.
@@ -1874,6 +1892,10 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
    buildUpdateUnion(&updateUnion);
    if (updateUnion.intersect(screenRect))
    {
+      // The scene and post effects rendered by the controls time
+      // themselves, so this is what the GUI alone costs.
+      GFXGPUTIMING_SCOPE( "GUI" );
+
       // Render active GUI Dialogs
       for(iterator i = begin(); i != end(); i++)
       {
@@ -1969,8 +1991,12 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
       if( mNextFenceIdx >= mNumFences )
          mNextFenceIdx = 0;
 
-      // Block on previous fence
-      mFences[mNextFenceIdx]->block();
+      // Block on previous fence or, when pipelining, leave that to the start
+      // of the next frame.
+      if( mPipelineFrames )
+         mFenceBlockPending = true;
+      else
+         mFences[mNextFenceIdx]->block();
    }
 
    PROFILE_START(GFXEndScene);
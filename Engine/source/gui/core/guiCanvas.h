@@ -190,6 +190,15 @@ protected:
    S32 mNextFenceIdx;
    S32 mNumFences;
 
+   /// If true, the block on the GFX fences at the end of a frame is deferred
+   /// to the start of the next frame so the simulation update in between runs
+   /// while the GPU is still working on the frame.
+   bool mPipelineFrames;
+
+   /// Whether the fence block of the last frame has been deferred and is
+   /// still outstanding.
+   bool mFenceBlockPending;
+
    static bool setProtectedNumFences( void *object, const char *index, const char *data );
    virtual void setupFences();
    
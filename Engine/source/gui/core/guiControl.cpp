@@ -39,6 +39,8 @@
 #include "gui/core/guiDefaultControlRender.h"
 #include "gui/editor/guiEditCtrl.h"
 #include "gfx/gfxDrawUtil.h"
+#include "gfx/gfxTextureManager.h"
+#include "platform/profiler.h"
 
 
 //#define DEBUG_SPEW
@@ -218,7 +220,9 @@ GuiControl::GuiControl() : mAddGroup( NULL ),
                            mLangTable(NULL),
                            mFirstResponder(NULL),
                            mHorizSizing(horizResizeRight),
-                           mVertSizing(vertResizeBottom)
+                           mVertSizing(vertResizeBottom),
+                           mRenderCache(false),
+                           mRenderCacheDirty(true)
 {
    mConsoleVariable     = StringTable->EmptyString();
    mAcceleratorKey      = StringTable->EmptyString();
@@ -292,6 +296,12 @@ void GuiControl::initPersistFields()
             "the global variable $ThisControl." );
       addField("accelerator",       TypeString,       Offset(mAcceleratorKey, GuiControl),
          "Key combination that triggers the control's primary action when the control is on the canvas." );
+      addField("renderCache",       TypeBool,         Offset(mRenderCache, GuiControl),
+         "If true, the control and its children are rendered into an offscreen texture which is then drawn with "
+         "a single quad until something in the control's hierarchy signals a change.\n\n"
+         "This cuts the cost of mostly static panels with many child controls down to a single draw call.  Only "
+         "use it for controls whose children update themselves through setUpdate(); use invalidateRenderCache() "
+         "to force a refresh otherwise." );
 
    endGroup( "Control" );	
    
@@ -582,7 +592,10 @@ void GuiControl::renderChildControls(Point2I offset, const RectI &updateRect)
          {
             GFX->setClipRect( childClip );
             GFX->setStateBlock(mDefaultGuiSB);
-            ctrl->onRender(childPosition, childClip);
+            if ( ctrl->mRenderCache && !smDesignTime )
+               ctrl->_renderCached(childPosition, childClip);
+            else
+               ctrl->onRender(childPosition, childClip);
          }
       }
    }
@@ -596,6 +609,8 @@ void GuiControl::renderChildControls(Point2I offset, const RectI &updateRect)
 
 void GuiControl::setUpdateRegion(Point2I pos, Point2I ext)
 {
+   invalidateRenderCache();
+
    Point2I upos = localToGlobalCoord(pos);
    GuiCanvas *root = getRoot();
    if (root)
@@ -613,6 +628,135 @@ void GuiControl::setUpdate()
 
 //-----------------------------------------------------------------------------
 
+void GuiControl::invalidateRenderCache()
+{
+   for ( GuiControl* ctrl = this; ctrl != NULL; ctrl = ctrl->getParent() )
+      if ( ctrl->mRenderCache )
+         ctrl->mRenderCacheDirty = true;
+}
+
+//-----------------------------------------------------------------------------
+
+void GuiControl::_renderCached( const Point2I &offset, const RectI &updateRect )
+{
+   const Point2I &extent = getExtent();
+   if ( extent.x <= 0 || extent.y <= 0 )
+      return;
+
+   if ( mRenderCacheTexture.isNull() || mRenderCacheTexture.getWidthHeight() != extent )
+   {
+      if ( mRenderCacheTexture.isNull() )
+         GFXTextureManager::addEventDelegate( this, &GuiControl::_onRenderCacheTextureEvent );
+
+      mRenderCacheTexture.set( extent.x, extent.y, GFXFormatR8G8B8A8, &GFXRenderTargetSRGBProfile,
+         avar( "%s() - (line %d)", __FUNCTION__, __LINE__ ), 1, 0 );
+      mRenderCacheDirty = true;
+
+      if ( mRenderCacheTexture.isNull() )
+      {
+         _releaseRenderCache();
+         onRender( offset, updateRect );
+         return;
+      }
+   }
+
+   if ( mRenderCacheDirty )
+   {
+      PROFILE_SCOPE( GuiControl_RecordRenderCache );
+
+      if ( mRenderCacheTarget.isNull() )
+         mRenderCacheTarget = GFX->allocRenderToTextureTarget();
+      mRenderCacheTarget->attachTexture( GFXTextureTarget::Color0, mRenderCacheTexture );
+
+      // Clear the flag up front so that children flagging themselves
+      // while rendering get picked up on the next frame.
+      mRenderCacheDirty = false;
+
+      GFX->pushActiveRenderTarget();
+      GFX->setActiveRenderTarget( mRenderCacheTarget );
+      GFX->clear( GFXClearTarget, LinearColorF( 0, 0, 0, 0 ), 1.0f, 0 );
+
+      const RectI cacheRect( Point2I::Zero, extent );
+      GFX->setClipRect( cacheRect );
+      GFX->setStateBlock( mDefaultGuiSB );
+      onRender( Point2I::Zero, cacheRect );
+
+      mRenderCacheTarget->resolve();
+      GFX->popActiveRenderTarget();
+      GFX->setClipRect( updateRect );
+   }
+
+   // Composite the cache.  Its color is premultiplied by the
+   // alpha it was rendered with.
+
+   if ( mRenderCacheSB.isNull() )
+   {
+      GFXStateBlockDesc desc;
+      desc.setCullMode( GFXCullNone );
+      desc.setZReadWrite( false );
+      desc.setBlend( true, GFXBlendOne, GFXBlendInvSrcAlpha );
+      desc.samplersDefined = true;
+      desc.samplers[ 0 ] = GFXSamplerStateDesc::getClampPoint();
+      mRenderCacheSB = GFX->createStateBlock( desc );
+   }
+
+   const Point3I &texSize = mRenderCacheTexture->mTextureSize;
+   const F32 texRight = F32( extent.x ) / F32( texSize.x );
+   const F32 texBottom = F32( extent.y ) / F32( texSize.y );
+
+   const F32 fillConv = GFX->getFillConventionOffset();
+   const F32 left = F32( offset.x ) - fillConv;
+   const F32 top = F32( offset.y ) - fillConv;
+   const F32 right = left + F32( extent.x );
+   const F32 bottom = top + F32( extent.y );
+
+   GFXVertexBufferHandle< GFXVertexPCT > verts( GFX, 4, GFXBufferTypeVolatile );
+   verts.lock();
+
+   verts[ 0 ].point.set( left, top, 0.f );
+   verts[ 1 ].point.set( right, top, 0.f );
+   verts[ 2 ].point.set( left, bottom, 0.f );
+   verts[ 3 ].point.set( right, bottom, 0.f );
+
+   verts[ 0 ].color = verts[ 1 ].color = verts[ 2 ].color = verts[ 3 ].color = ColorI::WHITE;
+
+   verts[ 0 ].texCoord.set( 0.f, 0.f );
+   verts[ 1 ].texCoord.set( texRight, 0.f );
+   verts[ 2 ].texCoord.set( 0.f, texBottom );
+   verts[ 3 ].texCoord.set( texRight, texBottom );
+
+   verts.unlock();
+
+   GFX->setVertexBuffer( verts );
+   GFX->setStateBlock( mRenderCacheSB );
+   GFX->setTexture( 0, mRenderCacheTexture );
+   GFX->setupGenericShaders( GFXDevice::GSModColorTexture );
+   GFX->drawPrimitive( GFXTriangleStrip, 0, 2 );
+}
+
+//-----------------------------------------------------------------------------
+
+void GuiControl::_releaseRenderCache()
+{
+   if ( mRenderCacheTexture.isValid() )
+      GFXTextureManager::removeEventDelegate( this, &GuiControl::_onRenderCacheTextureEvent );
+
+   mRenderCacheTexture = NULL;
+   mRenderCacheTarget = NULL;
+   mRenderCacheDirty = true;
+}
+
+//-----------------------------------------------------------------------------
+
+void GuiControl::_onRenderCacheTextureEvent( GFXTexCallbackCode code )
+{
+   // The cache contents don't survive a device reset.
+   if ( code == GFXZombify )
+      mRenderCacheDirty = true;
+}
+
+//-----------------------------------------------------------------------------
+
 void GuiControl::renderJustifiedText(Point2I offset, Point2I extent, const char *text)
 {
    GFont *font = mProfile->mFont;
@@ -871,6 +1015,8 @@ void GuiControl::onSleep()
    mProfile->decLoadCount();
    mTooltipProfile->decLoadCount();
 
+   _releaseRenderCache();
+
    // Set Flag
    mAwake = false;
 }
@@ -1261,6 +1407,11 @@ bool GuiControl::resize(const Point2I &newPosition, const Point2I &newExtent)
    if (!extentChanged && !positionChanged ) 
       return false;
 
+   // Cached parents need to record us at our new place.
+   GuiControl *cacheParent = getParent();
+   if ( cacheParent )
+      cacheParent->invalidateRenderCache();
+
    // Update Position
    if ( positionChanged )
       mBounds.point = newPosition;
@@ -1889,6 +2040,7 @@ void GuiControl::addObject(SimObject *object)
    AssertFatal( ctrl, "GuiControl::addObject() - cannot add non-GuiControl as child of GuiControl" );
 
 	Parent::addObject(object);
+   invalidateRenderCache();
 
    AssertFatal(!ctrl->isAwake(), "GuiControl::addObject: object is already awake before add");
    if( mAwake )
@@ -1911,6 +2063,7 @@ void GuiControl::removeObject(SimObject *object)
    onChildRemoved( ctrl );
 
    Parent::removeObject(object);
+   invalidateRenderCache();
 }
 
 //-----------------------------------------------------------------------------
@@ -2752,6 +2905,16 @@ DefineEngineMethod( GuiControl, setVisible, void, ( bool state ), ( true ),
 
 //-----------------------------------------------------------------------------
 
+DefineEngineMethod( GuiControl, invalidateRenderCache, void, (),,
+   "Force the render caches of the control and its parents to be recorded again on the next frame.\n"
+   "Use this for controls inside a control with #renderCache set that change their appearance without "
+   "flagging an update themselves." )
+{
+   object->invalidateRenderCache();
+}
+
+//-----------------------------------------------------------------------------
+
 DefineEngineMethod( GuiControl, isAwake, bool, (),,
    "Test whether the control is currently awake.\n"
    "If a control is awake it means that it is part of the GuiControl hierarchy of a GuiCanvas.\n"
@@ -49,6 +49,9 @@
 #ifndef _LANG_H_
 #include "i18n/lang.h"
 #endif
+#ifndef _GFXTARGET_H_
+#include "gfx/gfxTarget.h"
+#endif
 
 class GuiCanvas;
 class GuiEditCtrl;
@@ -252,6 +255,46 @@ class GuiControl : public SimGroup
       
       GFXStateBlockRef mDefaultGuiSB;
       
+      /// @name Render Cache
+      ///
+      /// With #mRenderCache set, the control records itself and its children into
+      /// an offscreen texture and from then on draws that texture with a single quad.
+      /// The texture is recorded again only when something in the subtree calls
+      /// setUpdate(), is resized or moved, or children are added or removed.  This
+      /// suits mostly static HUD panels; controls that change their appearance
+      /// without calling setUpdate() will appear frozen inside a cached control.
+      ///
+      /// @note Controls render into the cache with their usual blending, so
+      ///   translucent regions of the cache composite slightly lighter than
+      ///   they would if drawn directly.
+      /// @{
+      
+      /// If true, render through the cache.
+      bool mRenderCache;
+      
+      /// If true, the cache needs to be recorded again.
+      bool mRenderCacheDirty;
+      
+      /// Texture holding the recorded rendering of the control.
+      GFXTexHandle mRenderCacheTexture;
+      
+      /// Render target used to record into #mRenderCacheTexture.
+      GFXTextureTargetRef mRenderCacheTarget;
+      
+      /// State block for compositing the premultiplied cache texture.
+      GFXStateBlockRef mRenderCacheSB;
+      
+      /// Draw the control through its render cache, recording it first if needed.
+      void _renderCached( const Point2I &offset, const RectI &updateRect );
+      
+      /// Release the render cache texture and target.
+      void _releaseRenderCache();
+      
+      /// Drop the cache contents when textures get zombified.
+      void _onRenderCacheTextureEvent( GFXTexCallbackCode code );
+      
+      /// @}
+      
       /// @name Callbacks
       /// @{
       
@@ -509,6 +552,10 @@ class GuiControl : public SimGroup
       
       /// Sets the update area of the control to encompass the whole control
       virtual void setUpdate();
+      
+      /// Flag the render caches of this control and all its ancestors for
+      /// recording.
+      void invalidateRenderCache();
       /// @}
       
       //child hierarchy calls
@@ -293,6 +293,7 @@ class TerrainEditor : public EditTSCtrl
          
          virtual void undo();
          virtual void redo() { undo(); }
+         virtual U32 getMemoryUsage() const { return mSel ? mSel->memSize() : 0; }
       };
 
       void submitUndo( Selection *sel );
@@ -317,6 +318,7 @@ class TerrainEditor : public EditTSCtrl
 
          virtual void undo();
          virtual void redo();
+         virtual U32 getMemoryUsage() const { return mLayerMap.memSize() + mMaterials.memSize(); }
       };
 
       bool mIsDirty; // dirty flag for writing terrain.
@@ -113,6 +113,14 @@ void MECreateUndoAction::redo()
    Con::executef( this, "onRedone" );
 }
 
+U32 MECreateUndoAction::getMemoryUsage() const
+{
+   U32 usage = 0;
+   for ( S32 i = 0; i < mObjects.size(); i++ )
+      usage += mObjects[i].memento.getMemoryUsage();
+   return usage;
+}
+
 
 IMPLEMENT_CONOBJECT( MEDeleteUndoAction );
 
@@ -207,6 +215,14 @@ void MEDeleteUndoAction::redo()
    Con::executef( this, "onRedone" );
 }
 
+U32 MEDeleteUndoAction::getMemoryUsage() const
+{
+   U32 usage = 0;
+   for ( S32 i = 0; i < mObjects.size(); i++ )
+      usage += mObjects[i].memento.getMemoryUsage();
+   return usage;
+}
+
 IMPLEMENT_CONOBJECT( InspectorFieldUndoAction );
 
 ConsoleDocClass( InspectorFieldUndoAction,
@@ -69,6 +69,7 @@ public:
    // UndoAction
    virtual void undo();
    virtual void redo();
+   virtual U32 getMemoryUsage() const;
 };
 
 
@@ -108,6 +109,7 @@ public:
    // UndoAction
    virtual void undo();
    virtual void redo();
+   virtual U32 getMemoryUsage() const;
 };
 
 class InspectorFieldUndoAction : public UndoAction
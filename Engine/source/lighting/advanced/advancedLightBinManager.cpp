@@ -47,6 +47,7 @@ const String AdvancedLightBinManager::smBufferName( "lightinfo" );
 ShadowFilterMode AdvancedLightBinManager::smShadowFilterMode = ShadowFilterMode_SoftShadowHighQuality;
 bool AdvancedLightBinManager::smPSSMDebugRender = false;
 bool AdvancedLightBinManager::smUseSSAOMask = false;
+bool AdvancedLightBinManager::smBatchLightVolumes = true;
 
 ImplementEnumType( ShadowFilterMode,
    "The shadow filtering modes for Advanced Lighting shadows.\n"
@@ -168,6 +169,12 @@ void AdvancedLightBinManager::consoleInit()
    Con::addVariable( "$AL::PSSMDebugRender", TypeBool, &smPSSMDebugRender,
       "Enables debug rendering of the PSSM shadows.\n"
       "@ingroup AdvancedLighting\n" );
+
+   Con::addVariable( "$AL::BatchLightVolumes", TypeBool, &smBatchLightVolumes,
+      "If true, point and spot lights without shadows or cookies are drawn "
+      "grouped by material, setting up the material once per group instead "
+      "of once per light.\n"
+      "@ingroup AdvancedLighting\n" );
 }
 
 bool AdvancedLightBinManager::setTargetSize(const Point2I &newTargetSize)
@@ -207,6 +214,12 @@ void AdvancedLightBinManager::addLight( LightInfo *light )
    lEntry.dynamicShadowMap = dynamicShadowMap;
    lEntry.lightMaterial = _getLightMaterial( lightType, shadowType, lsp->hasCookieTex() );
 
+   // Lights represented in lightmaps take an extra material pass.
+   const LightMapParams *lmParams = light->getExtended<LightMapParams>();
+   lEntry.batchable =   shadowType == ShadowType_None && 
+                        !lsp->hasCookieTex() &&
+                        !( lmParams && lmParams->representedInLightmap );
+
    if( lightType == LightInfo::Spot )
       lEntry.vertBuffer = mLightManager->getConeMesh( lEntry.numPrims, lEntry.primBuffer );
    else
@@ -311,64 +324,172 @@ void AdvancedLightBinManager::render( SceneRenderState *state )
       }
    }
 
+   // Group the batchable lights by material so each group
+   // can share its material passes.
+   if ( smBatchLightVolumes )
+      dQsort( mLightBin.address(), mLightBin.size(), sizeof( LightBinEntry ), _lightBinSortFunc );
+
    // Blend the lights in the bin to the light buffer
-   for( LightBinIterator itr = mLightBin.begin(); itr != mLightBin.end(); itr++ )
+   for( U32 i = 0; i < mLightBin.size(); )
    {
-      LightBinEntry& curEntry = *itr;
-      LightInfo *curLightInfo = curEntry.lightInfo;
-      LightMaterialInfo *curLightMat = curEntry.lightMaterial;
-      const U32 numPrims = curEntry.numPrims;
-      const U32 numVerts = curEntry.vertBuffer->mNumVerts;
-
-      ShadowMapParams *lsp = curLightInfo->getExtended<ShadowMapParams>();
+      LightBinEntry& curEntry = mLightBin[i];
 
-      // Skip lights which won't affect the scene.
-      if ( !curLightMat || curLightInfo->getBrightness() <= 0.001f )
+      if ( !smBatchLightVolumes || !curEntry.batchable || !curEntry.lightMaterial )
+      {
+         _renderLight( state, sgData, curEntry );
+         i++;
          continue;
+      }
 
-      GFXDEBUGEVENT_SCOPE( AdvancedLightBinManager_Render_Light, ColorI::RED );
+      U32 end = i + 1;
+      while (  end < mLightBin.size() && 
+               mLightBin[end].batchable &&
+               mLightBin[end].lightMaterial == curEntry.lightMaterial )
+         end++;
 
-      setupSGData( sgData, state, curLightInfo );
-      curLightMat->setLightParameters( curLightInfo, state, worldToCameraXfm );
-      mShadowManager->setLightShadowMap( curEntry.shadowMap );
-      mShadowManager->setLightDynamicShadowMap( curEntry.dynamicShadowMap );
+      _renderLightBatch( state, sgData, i, end );
+      i = end;
+   }
 
-      // Set geometry
-      GFX->setVertexBuffer( curEntry.vertBuffer );
-      GFX->setPrimitiveBuffer( curEntry.primBuffer );
+   // Set NULL for active shadow map (so nothing gets confused)
+   mShadowManager->setLightShadowMap(NULL);
+   mShadowManager->setLightDynamicShadowMap(NULL);
+   GFX->setVertexBuffer( NULL );
+   GFX->setPrimitiveBuffer( NULL );
+
+   // Fire off a signal to let others know that light-bin rendering is ending now
+   getRenderSignal().trigger(state, this);
 
-      lsp->getOcclusionQuery()->begin();
+   // Finish up the rendering
+   _onPostRender();
+}
 
-      curLightMat->matInstance->mSpecialLight = false;
+void AdvancedLightBinManager::_renderLight( SceneRenderState *state, SceneData &sgData, LightBinEntry &curEntry )
+{
+   LightInfo *curLightInfo = curEntry.lightInfo;
+   LightMaterialInfo *curLightMat = curEntry.lightMaterial;
+   const U32 numPrims = curEntry.numPrims;
+   const U32 numVerts = curEntry.vertBuffer->mNumVerts;
 
-      // Render the material passes
-      while( curLightMat->matInstance->setupPass( state, sgData ) )
+   ShadowMapParams *lsp = curLightInfo->getExtended<ShadowMapParams>();
+
+   // Skip lights which won't affect the scene.
+   if ( !curLightMat || curLightInfo->getBrightness() <= 0.001f )
+      return;
+
+   GFXDEBUGEVENT_SCOPE( AdvancedLightBinManager_Render_Light, ColorI::RED );
+
+   MatrixSet &matrixSet = getRenderPass()->getMatrixSet();
+   const MatrixF &worldToCameraXfm = matrixSet.getWorldToCamera();
+
+   setupSGData( sgData, state, curLightInfo );
+   curLightMat->setLightParameters( curLightInfo, state, worldToCameraXfm );
+   mShadowManager->setLightShadowMap( curEntry.shadowMap );
+   mShadowManager->setLightDynamicShadowMap( curEntry.dynamicShadowMap );
+
+   // Set geometry
+   GFX->setVertexBuffer( curEntry.vertBuffer );
+   GFX->setPrimitiveBuffer( curEntry.primBuffer );
+
+   // Test the visibility of the light volume for the shadow pass.
+   GFXOcclusionQuery *query = lsp->getOcclusionQuery().getQuery();
+   if ( query )
+      query->begin();
+
+   curLightMat->matInstance->mSpecialLight = false;
+
+   // Render the material passes
+   while( curLightMat->matInstance->setupPass( state, sgData ) )
+   {
+      // Set transforms
+      matrixSet.setWorld(*sgData.objTrans);
+      curLightMat->matInstance->setTransforms(matrixSet, state);
+      curLightMat->matInstance->setSceneInfo(state, sgData);
+
+      if(curEntry.primBuffer)
+         GFX->drawIndexedPrimitive(GFXTriangleList, 0, 0, numVerts, 0, numPrims);
+      else
+         GFX->drawPrimitive(GFXTriangleList, 0, numPrims);
+   }
+
+   if ( query )
+      query->end();
+}
+
+void AdvancedLightBinManager::_renderLightBatch( SceneRenderState *state, SceneData &sgData, U32 start, U32 end )
+{
+   GFXDEBUGEVENT_SCOPE( AdvancedLightBinManager_Render_LightBatch, ColorI::RED );
+
+   LightMaterialInfo *lightMat = mLightBin[start].lightMaterial;
+   LightMatInstance *matInst = lightMat->matInstance;
+
+   MatrixSet &matrixSet = getRenderPass()->getMatrixSet();
+   const MatrixF &worldToCameraXfm = matrixSet.getWorldToCamera();
+
+   // The passes only depend on the material, so set them up
+   // once with the first light.  Only the constants and the
+   // volume change from light to light.
+   setupSGData( sgData, state, mLightBin[start].lightInfo );
+   matInst->mSpecialLight = false;
+
+   // The light volumes are only tested in the first pass.
+   bool firstPass = true;
+
+   while( matInst->setupPass( state, sgData ) )
+   {
+      for ( U32 i = start; i < end; i++ )
       {
-         // Set transforms
+         LightBinEntry &curEntry = mLightBin[i];
+         LightInfo *curLightInfo = curEntry.lightInfo;
+
+         // Skip lights which won't affect the scene.
+         if ( curLightInfo->getBrightness() <= 0.001f )
+            continue;
+
+         ShadowMapParams *lsp = curLightInfo->getExtended<ShadowMapParams>();
+
+         setupSGData( sgData, state, curLightInfo );
+         lightMat->setLightParameters( curLightInfo, state, worldToCameraXfm );
+         mShadowManager->setLightShadowMap( curEntry.shadowMap );
+         mShadowManager->setLightDynamicShadowMap( curEntry.dynamicShadowMap );
+
+         // Point and spot lights share materials but not volumes.
+         GFX->setVertexBuffer( curEntry.vertBuffer );
+         GFX->setPrimitiveBuffer( curEntry.primBuffer );
+
+         GFXOcclusionQuery *query = firstPass ? lsp->getOcclusionQuery().getQuery() : NULL;
+         if ( query )
+            query->begin();
+
          matrixSet.setWorld(*sgData.objTrans);
-         curLightMat->matInstance->setTransforms(matrixSet, state);
-         curLightMat->matInstance->setSceneInfo(state, sgData);
+         matInst->setTransforms(matrixSet, state);
+         matInst->setSceneInfo(state, sgData);
 
          if(curEntry.primBuffer)
-            GFX->drawIndexedPrimitive(GFXTriangleList, 0, 0, numVerts, 0, numPrims);
+            GFX->drawIndexedPrimitive(GFXTriangleList, 0, 0, curEntry.vertBuffer->mNumVerts, 0, curEntry.numPrims);
          else
-            GFX->drawPrimitive(GFXTriangleList, 0, numPrims);
+            GFX->drawPrimitive(GFXTriangleList, 0, curEntry.numPrims);
+
+         if ( query )
+            query->end();
       }
 
-      lsp->getOcclusionQuery()->end();
+      firstPass = false;
    }
+}
 
-   // Set NULL for active shadow map (so nothing gets confused)
-   mShadowManager->setLightShadowMap(NULL);
-   mShadowManager->setLightDynamicShadowMap(NULL);
-   GFX->setVertexBuffer( NULL );
-   GFX->setPrimitiveBuffer( NULL );
+S32 QSORT_CALLBACK AdvancedLightBinManager::_lightBinSortFunc( const void *p1, const void *p2 )
+{
+   const LightBinEntry *e1 = (const LightBinEntry*)p1;
+   const LightBinEntry *e2 = (const LightBinEntry*)p2;
 
-   // Fire off a signal to let others know that light-bin rendering is ending now
-   getRenderSignal().trigger(state, this);
+   if ( e1->batchable != e2->batchable )
+      return e1->batchable ? -1 : 1;
 
-   // Finish up the rendering
-   _onPostRender();
+   if ( e1->lightMaterial != e2->lightMaterial )
+      return e1->lightMaterial < e2->lightMaterial ? -1 : 1;
+
+   return 0;
 }
 
 AdvancedLightBinManager::LightMaterialInfo* AdvancedLightBinManager::_getLightMaterial(   LightInfo::Type lightType, 
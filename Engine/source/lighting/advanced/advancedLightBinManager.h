@@ -100,6 +100,10 @@ public:
    /// light to compile in the SSAO mask.
    static bool smUseSSAOMask;
 
+   /// If true, lights without shadows or cookies which share a
+   /// material are drawn within a single material pass.
+   static bool smBatchLightVolumes;
+
    // Used for console init
    AdvancedLightBinManager( AdvancedLightManager *lm = NULL, 
                             ShadowMapManager *sm = NULL,
@@ -194,6 +198,10 @@ protected:
       GFXPrimitiveBuffer* primBuffer;
       GFXVertexBuffer* vertBuffer;
       U32 numPrims;
+
+      /// True if the light uses no per-light textures or passes
+      /// and can share a material pass with other lights.
+      bool batchable;
    };
 
    Vector<LightBinEntry> mLightBin;
@@ -236,6 +244,15 @@ protected:
 
    void _setupPerFrameParameters( const SceneRenderState *state );
 
+   /// Draws the volume of a single light with its own material pass.
+   void _renderLight( SceneRenderState *state, SceneData &sgData, LightBinEntry &entry );
+
+   /// Draws the volumes of the batchable lights in [start, end), which
+   /// all share a light material, within one set of material passes.
+   void _renderLightBatch( SceneRenderState *state, SceneData &sgData, U32 start, U32 end );
+
+   static S32 QSORT_CALLBACK _lightBinSortFunc( const void *p1, const void *p2 );
+
    void setupSGData( SceneData &data, const SceneRenderState* state, LightInfo *light );
 };
 
@@ -43,6 +43,7 @@
 #include "math/mathIO.h"
 #include "materials/shaderData.h"
 #include "core/module.h"
+#include "T3D/objectTypes.h"
 
 // Used for creation in ShadowMapParams::getOrCreateShadowMap()
 #include "lighting/shadowMap/singleLightShadowMap.h"
@@ -61,6 +62,9 @@ const GFXFormat LightShadowMap::ShadowMapFormat = GFXFormatR32F; // GFXFormatR8G
 
 bool LightShadowMap::smDebugRenderFrustums;
 F32 LightShadowMap::smShadowTexScalar = 1.0f;
+bool LightShadowMap::smCacheStaticShadows = true;
+
+extern bool gEditingMission;
 
 Vector<LightShadowMap*> LightShadowMap::smUsedShadowMaps;
 Vector<LightShadowMap*> LightShadowMap::smShadowMaps;
@@ -91,7 +95,13 @@ LightShadowMap::LightShadowMap( LightInfo *light )
       mLastCull( 0 ),
       mLastScreenSize( 0.0f ),
       mLastPriority( 0.0f ),
-      mIsDynamic( false )
+      mIsDynamic( false ),
+      mStaticCacheDirty( true ),
+      mCachedLightTransform( true ),
+      mCachedRange( Point3F::Zero ),
+      mCachedConeAngle( 0.0f ),
+      mCachedTexSize( 0 ),
+      mCachedCameraTransform( true )
 {
    GFXTextureManager::addEventDelegate( this, &LightShadowMap::_onTextureEvent );
 
@@ -313,6 +323,14 @@ void LightShadowMap::render(RenderPassManager* renderPass,
       //  control how often shadow maps are refreshed
       if (!_dynamic && (mStaticRefreshTimer->getElapsedMs() < getLightInfo()->getStaticRefreshFreq()))
          return;
+
+      // Keep the static map if nothing it shows has changed.  The
+      // check runs at the refresh rate like the render it replaces.
+      if ( !_dynamic && _isStaticCacheValid( diffuseState ) )
+      {
+         mStaticRefreshTimer->reset();
+         return;
+      }
    }
     mStaticRefreshTimer->reset();
 
@@ -326,6 +344,9 @@ void LightShadowMap::render(RenderPassManager* renderPass,
    _render( renderPass, diffuseState );
    mDebugTarget.setTexture( mShadowMapTex );
 
+   if ( !_dynamic )
+      _updateStaticCache( diffuseState );
+
    // Add it to the used list unless we're been updated.
    if ( !mLastUpdate )
    {
@@ -336,19 +357,98 @@ void LightShadowMap::render(RenderPassManager* renderPass,
    mLastUpdate = Sim::getCurrentTime();
 }
 
-BaseMatInstance* LightShadowMap::getShadowMaterial( BaseMatInstance *inMat ) const
+void LightShadowMap::notifySceneObjectChanged( SceneObject *object )
+{
+   if ( !object->isClientObject() || !( object->getTypeMask() & SHADOW_TYPEMASK ) )
+      return;
+
+   const Box3F &box = object->getWorldBox();
+
+   for ( U32 i=0; i < smUsedShadowMaps.size(); i++ )
+   {
+      LightShadowMap *lsm = smUsedShadowMaps[i];
+      if ( lsm->isDynamic() || lsm->mStaticCacheDirty )
+         continue;
+
+      Box3F bounds;
+      if ( !lsm->_getCasterBounds( NULL, &bounds ) || bounds.isOverlapped( box ) )
+         lsm->mStaticCacheDirty = true;
+   }
+}
+
+bool LightShadowMap::_getCasterBounds( const SceneRenderState *diffuseState, Box3F *outBounds ) const
 {
-   // See if we have an existing material hook.
-   ShadowMaterialHook *hook = static_cast<ShadowMaterialHook*>( inMat->getHook( ShadowMaterialHook::Type ) );
-   if ( !hook )
+   // A view dependent map covers the shadow distance around
+   // the camera, but casters beyond it can still throw shadows
+   // into it.  Only bound it when asked with a view.
+   if ( isViewDependent() )
    {
-      // Create a hook and initialize it using the incoming material.
-      hook = new ShadowMaterialHook;
-      hook->init( inMat );
-      inMat->addHook( hook );
+      if ( !diffuseState )
+         return false;
+
+      const ShadowMapParams *params = mLight->getExtended<ShadowMapParams>();
+      const F32 dist = params->shadowDistance;
+      outBounds->set( Point3F( dist, dist, dist ) * 2.0f );
+      outBounds->setCenter( diffuseState->getCameraPosition() );
+      return true;
    }
 
-   return hook->getShadowMat( getShadowType() );
+   // Point and spot lights only see casters within their range.
+   const F32 range = mLight->getRange().x;
+   outBounds->set( Point3F( range, range, range ) * 2.0f );
+   outBounds->setCenter( mLight->getPosition() );
+   return true;
+}
+
+static void _findDynamicCasterCallback( SceneObject *object, void *key )
+{
+   *reinterpret_cast<bool*>( key ) = true;
+}
+
+bool LightShadowMap::_isStaticCacheValid( const SceneRenderState *diffuseState )
+{
+   PROFILE_SCOPE( LightShadowMap_IsStaticCacheValid );
+
+   // Editing changes the scene in ways we do not track.
+   if ( !smCacheStaticShadows || gEditingMission || !mLastUpdate || mStaticCacheDirty )
+      return false;
+
+   if (  dMemcmp( &mCachedLightTransform, &mLight->getTransform(), sizeof( MatrixF ) ) != 0 ||
+         mCachedRange != mLight->getRange() ||
+         mCachedConeAngle != mLight->getOuterConeAngle() ||
+         mCachedTexSize != getBestTexSize() )
+      return false;
+
+   // A view dependent map is only reused from the same view.
+   if (  isViewDependent() &&
+         dMemcmp( &mCachedCameraTransform, &diffuseState->getCameraTransform(), sizeof( MatrixF ) ) != 0 )
+      return false;
+
+   // Moving and animated shapes are not tracked, so any in
+   // reach keep the map refreshing at the normal rate.
+   Box3F bounds;
+   if ( !_getCasterBounds( diffuseState, &bounds ) )
+      return false;
+
+   bool foundDynamic = false;
+   diffuseState->getSceneManager()->getContainer()->findObjects( bounds, DynamicShapeObjectType, _findDynamicCasterCallback, &foundDynamic );
+
+   return !foundDynamic;
+}
+
+void LightShadowMap::_updateStaticCache( const SceneRenderState *diffuseState )
+{
+   mStaticCacheDirty = false;
+   mCachedLightTransform = mLight->getTransform();
+   mCachedRange = mLight->getRange();
+   mCachedConeAngle = mLight->getOuterConeAngle();
+   mCachedTexSize = getBestTexSize();
+   mCachedCameraTransform = diffuseState->getCameraTransform();
+}
+
+BaseMatInstance* LightShadowMap::getShadowMaterial( BaseMatInstance *inMat ) const
+{
+   return ShadowMaterialHook::findOrCreate( inMat )->getShadowMat( getShadowType() );
 }
 
 U32 LightShadowMap::getBestTexSize( U32 scale ) const
@@ -595,14 +695,12 @@ ShadowMapParams::ShadowMapParams( LightInfo *light )
    shadowSoftness = 0.15f;
    fadeStartDist = 0.0f;
    lastSplitTerrainOnly = false;
-   mQuery = GFX->createOcclusionQuery();
 
    _validate();
 }
 
 ShadowMapParams::~ShadowMapParams()
 {
-   SAFE_DELETE( mQuery );
    SAFE_DELETE( mShadowMap );
    SAFE_DELETE( mDynamicShadowMap );
 }
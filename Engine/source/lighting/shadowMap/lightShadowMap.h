@@ -57,6 +57,7 @@
 class ShadowMapManager;
 class SceneManager;
 class SceneRenderState;
+class SceneObject;
 class BaseMatInstance;
 class MaterialParameters;
 class SharedShadowMapObjects;
@@ -155,6 +156,15 @@ public:
    /// rendering enabled.
    static bool smDebugRenderFrustums;
 
+   /// If true, static shadow maps are only rendered again when the
+   /// light, the view or the casters around the light changed.
+   static bool smCacheStaticShadows;
+
+   /// Flags the static shadow maps which can see the object to be
+   /// rendered again.  Hooked to the scene object add and remove
+   /// signals by the ShadowMapPass.
+   static void notifySceneObjectChanged( SceneObject *object );
+
 public:
 
    LightShadowMap( LightInfo *light );
@@ -245,6 +255,29 @@ protected:
    /// be skipped if visible and within active range.
    bool mIsViewDependent;
 
+   /// @name Static Shadow Cache
+   /// What the static shadow map was last rendered with.
+   /// @{
+
+   bool mStaticCacheDirty;
+   MatrixF mCachedLightTransform;
+   Point3F mCachedRange;
+   F32 mCachedConeAngle;
+   U32 mCachedTexSize;
+   MatrixF mCachedCameraTransform;
+
+   /// Returns the world space bounds of the casters the map can
+   /// see, or false if they cannot be bounded.
+   bool _getCasterBounds( const SceneRenderState *diffuseState, Box3F *outBounds ) const;
+
+   /// Returns true if rendering the static map again would
+   /// produce the same result.
+   bool _isStaticCacheValid( const SceneRenderState *diffuseState );
+
+   void _updateStaticCache( const SceneRenderState *diffuseState );
+
+   /// @}
+
    /// The time this shadow was last updated.
    U32 mLastUpdate;
    PlatformTimer *mStaticRefreshTimer;
@@ -312,7 +345,8 @@ public:
 
    bool hasCookieTex() const { return cookie.isNotEmpty(); }
 
-   GFXOcclusionQuery* getOcclusionQuery() const { return mQuery; }
+   /// The query rendered with the light volume, see ShadowMapPass::render.
+   GFXOcclusionQueryHandle& getOcclusionQuery() { return mQuery; }
 
    GFXTextureObject* getCookieTex();
 
@@ -328,7 +362,7 @@ protected:
    ///
    LightShadowMap *mShadowMap;
    LightShadowMap *mDynamicShadowMap;
-   GFXOcclusionQuery* mQuery;
+   GFXOcclusionQueryHandle mQuery;
 
    LightInfo *mLight;
 
@@ -56,10 +56,17 @@ AFTER_MODULE_INIT( Sim )
       "Use this to force culling of small objects which contribute little to the final shadow.\n"
       "@see $pref::TS::smallestVisiblePixelSize\n"
       "@ingroup AdvancedLighting" );
+
+   Con::addVariable( "$pref::PSSM::shareSplitCasters", 
+      TypeBool, &PSSMLightShadowMap::smShareSplitCasters,
+      "@brief If true the PSSM splits pick their shadow casters from a single "
+      "container query over the whole light frustum instead of one query each.\n"
+      "@ingroup AdvancedLighting" );
 }
 
 F32 PSSMLightShadowMap::smDetailAdjustScale = 0.85f;
 F32 PSSMLightShadowMap::smSmallestVisiblePixelSize = 25.0f;
+bool PSSMLightShadowMap::smShareSplitCasters = true;
 
 
 PSSMLightShadowMap::PSSMLightShadowMap( LightInfo *light )
@@ -252,6 +259,26 @@ void PSSMLightShadowMap::_render(   RenderPassManager* renderPass,
    Vector< Vector<PlaneF> > _extraCull;
    _calcPlanesCullForShadowCasters( _extraCull, fullFrustum, mLight->getDirection() );
 
+   // Every split is a crop of the full light frustum, so gather
+   // the casters for all of them with one container query.  The
+   // box is padded for the extra unit the splits add to the far
+   // plane below.  Splits that still leave it do their own query.
+   SceneManager* sceneManager = diffuseState->getSceneManager();
+   if ( smShareSplitCasters )
+   {
+      Frustum lightFrustum( GFX->getFrustum() );
+      MatrixF lightCamera( lightMatrix );
+      lightCamera.inverse();
+      lightFrustum.setTransform( lightCamera );
+
+      Box3F gatherBox( lightFrustum.getBounds() );
+      gatherBox.minExtents -= Point3F::One;
+      gatherBox.maxExtents += Point3F::One;
+
+      sceneManager->gatherObjectCandidates( gatherBox, SHADOW_TYPEMASK, &mSplitCasters );
+      sceneManager->setObjectCandidates( &mSplitCasters );
+   }
+
    for (U32 i = 0; i < mNumSplits; i++)
    {
       GFXTransformSaver saver;
@@ -324,8 +351,6 @@ void PSSMLightShadowMap::_render(   RenderPassManager* renderPass,
       // Render into the quad of the shadow map we are using.
       GFX->setViewport(mViewports[i]);
 
-      SceneManager* sceneManager = diffuseState->getSceneManager();
-
       // The frustum is currently the  full size and has not had
       // cropping applied.
       //
@@ -383,6 +408,9 @@ void PSSMLightShadowMap::_render(   RenderPassManager* renderPass,
       _debugRender( &shadowRenderState );
    }
 
+   sceneManager->setObjectCandidates( NULL );
+   mSplitCasters.objects.clear();
+
    // Restore the original TS lod settings.
    TSShapeInstance::smSmallestVisiblePixelSize = savedSmallestVisible;
    TSShapeInstance::smDetailAdjust = savedDetailAdjust;
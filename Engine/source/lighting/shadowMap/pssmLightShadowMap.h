@@ -28,6 +28,9 @@
 #ifndef _MATHUTIL_FRUSTUM_H_
 #include "math/util/frustum.h"
 #endif
+#ifndef _SCENEMANAGER_H_
+#include "scene/sceneManager.h"
+#endif
 
 
 class PSSMLightShadowMap : public LightShadowMap
@@ -51,6 +54,10 @@ public:
    /// @see TSShapeInstance::smSmallestVisiblePixelSize
    static F32 smSmallestVisiblePixelSize;
 
+   /// If true the splits share one container query for their
+   /// shadow casters instead of running one each.
+   static bool smShareSplitCasters;
+
 protected:
 
    void _setNumSplits( U32 numSplits, U32 texSize );
@@ -67,6 +74,9 @@ protected:
    Point3F mOffsetProj[MAX_SPLITS];
    Point4F mFarPlaneScalePSSM;
    F32 mLogWeight;
+
+   /// The casters gathered for all the splits.
+   SceneManager::ObjectCandidates mSplitCasters;
 };
 
 #endif
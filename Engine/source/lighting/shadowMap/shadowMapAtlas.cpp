@@ -0,0 +1,180 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "lighting/shadowMap/shadowMapAtlas.h"
+
+#include "lighting/shadowMap/lightShadowMap.h"
+#include "gfx/gfxDevice.h"
+#include "gfx/gfxCardProfile.h"
+#include "math/mMathFn.h"
+
+
+U32 ShadowMapAtlas::smAtlasSize = 2048;
+
+ShadowMapAtlas::ShadowMapAtlas()
+   :  mSize( 0 ),
+      mNumLevels( 0 ),
+      mUsedTiles( 0 )
+{
+}
+
+ShadowMapAtlas::~ShadowMapAtlas()
+{
+   reset();
+}
+
+void ShadowMapAtlas::reset()
+{
+   AssertFatal( mUsedTiles == 0, "ShadowMapAtlas::reset - Tiles are still in use!" );
+
+   mTexture = NULL;
+   mSize = 0;
+   mNumLevels = 0;
+   mUsedTiles = 0;
+
+   for ( U32 i=0; i < MaxLevels; i++ )
+      mFreeTiles[i].clear();
+}
+
+U32 ShadowMapAtlas::_getLevel( U32 size ) const
+{
+   return getBinLog2( mSize ) - getBinLog2( size );
+}
+
+bool ShadowMapAtlas::_init()
+{
+   // The size can only change while nothing is
+   // allocated from the atlas.
+   if ( mUsedTiles == 0 )
+   {
+      U32 size = smAtlasSize;
+      if ( size )
+      {
+         const U32 maxTexSize = GFX->getCardProfiler()->queryProfile( "maxTextureSize", 2048 );
+         size = mClamp( getNextPow2( size ), (U32)MinTileSize, maxTexSize );
+      }
+
+      if ( size != mSize )
+      {
+         reset();
+
+         if ( size )
+         {
+            mSize = size;
+            mNumLevels = getMin( _getLevel( MinTileSize ) + 1, (U32)MaxLevels );
+            mFreeTiles[0].push_back( Point2I::Zero );
+         }
+      }
+   }
+
+   if ( !mSize )
+      return false;
+
+   if ( mTexture.isNull() )
+      mTexture.set(  mSize, mSize, 
+                     LightShadowMap::ShadowMapFormat, &ShadowMapProfile, 
+                     "ShadowMapAtlas" );
+
+   return mTexture.isValid();
+}
+
+bool ShadowMapAtlas::allocTile( U32 size, RectI *outRect )
+{
+   if ( !_init() || size > mSize || !isPow2( size ) )
+      return false;
+
+   const U32 level = _getLevel( getMax( size, (U32)MinTileSize ) );
+   if ( level >= mNumLevels )
+      return false;
+
+   // Find the smallest free tile that fits.
+   S32 found = level;
+   while ( found >= 0 && mFreeTiles[found].empty() )
+      found--;
+
+   if ( found < 0 )
+      return false;
+
+   Point2I pos = mFreeTiles[found].last();
+   mFreeTiles[found].pop_back();
+
+   // Split it down to the requested size keeping the
+   // first quarter and freeing the other three.
+   for ( U32 i = found + 1; i <= level; i++ )
+   {
+      const S32 half = mSize >> i;
+      mFreeTiles[i].push_back( Point2I( pos.x + half, pos.y ) );
+      mFreeTiles[i].push_back( Point2I( pos.x, pos.y + half ) );
+      mFreeTiles[i].push_back( Point2I( pos.x + half, pos.y + half ) );
+   }
+
+   const S32 tileSize = mSize >> level;
+   outRect->set( pos, Point2I( tileSize, tileSize ) );
+   mUsedTiles++;
+
+   return true;
+}
+
+void ShadowMapAtlas::freeTile( const RectI &rect )
+{
+   AssertFatal( mUsedTiles > 0, "ShadowMapAtlas::freeTile - No tiles are allocated!" );
+   mUsedTiles--;
+
+   Point2I pos = rect.point;
+   U32 level = _getLevel( rect.extent.x );
+
+   // Merge the tile with its three buddies for as
+   // long as they are all free.
+   while ( level > 0 )
+   {
+      const S32 size = mSize >> level;
+      const Point2I parent( pos.x & ~( size * 2 - 1 ), pos.y & ~( size * 2 - 1 ) );
+
+      Vector<Point2I> &freeTiles = mFreeTiles[level];
+      Point2I buddies[3];
+      U32 numBuddies = 0;
+      bool allFree = true;
+
+      for ( U32 i=0; i < 4 && allFree; i++ )
+      {
+         const Point2I buddy( parent.x + ( i & 1 ) * size, parent.y + ( i >> 1 ) * size );
+         if ( buddy == pos )
+            continue;
+
+         allFree = freeTiles.contains( buddy );
+         buddies[numBuddies++] = buddy;
+      }
+
+      if ( !allFree )
+         break;
+
+      for ( U32 i=0; i < 3; i++ )
+         freeTiles.remove( buddies[i] );
+
+      pos = parent;
+      level--;
+   }
+
+   mFreeTiles[level].push_back( pos );
+}
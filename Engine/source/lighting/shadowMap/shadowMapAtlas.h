@@ -0,0 +1,99 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SHADOWMAPATLAS_H_
+#define _SHADOWMAPATLAS_H_
+
+#ifndef _GFXTEXTUREHANDLE_H_
+#include "gfx/gfxTextureHandle.h"
+#endif
+#ifndef _MRECT_H_
+#include "math/mRect.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+
+/// A single large shadow texture shared by the local light shadow
+/// maps.  Square power of two tiles are handed out with a quadtree
+/// buddy allocator so that freed tiles merge back into bigger ones.
+class ShadowMapAtlas
+{
+public:
+
+   ShadowMapAtlas();
+   ~ShadowMapAtlas();
+
+   /// The size of the atlas texture in texels or zero
+   /// to disable the atlas.
+   static U32 smAtlasSize;
+
+   /// Allocates a tile of the requested size returning false
+   /// if the atlas is disabled or has no room left.
+   bool allocTile( U32 size, RectI *outRect );
+
+   /// Returns a tile from allocTile() to the atlas.
+   void freeTile( const RectI &rect );
+
+   /// Returns the atlas texture.
+   GFXTextureObject* getTexture() const { return mTexture; }
+
+   U32 getSize() const { return mSize; }
+
+   U32 getUsedTileCount() const { return mUsedTiles; }
+
+   /// Releases the texture.  All tiles must have been freed.
+   void reset();
+
+protected:
+
+   enum
+   {
+      /// The smallest tile handed out.
+      MinTileSize = 16,
+
+      MaxLevels = 16,
+   };
+
+   /// Returns the level of a tile size where level
+   /// zero is the entire atlas.
+   U32 _getLevel( U32 size ) const;
+
+   /// Sizes the atlas from smAtlasSize and creates
+   /// the texture if needed.
+   bool _init();
+
+   U32 mSize;
+
+   U32 mNumLevels;
+
+   U32 mUsedTiles;
+
+   GFXTexHandle mTexture;
+
+   /// The free tile origins at each level.
+   Vector<Point2I> mFreeTiles[MaxLevels];
+};
+
+#endif // _SHADOWMAPATLAS_H_
@@ -32,6 +32,8 @@
 #include "gfx/gfxTextureManager.h"
 #include "core/module.h"
 #include "console/consoleTypes.h"
+#include "lighting/shadowMap/shadowMatHook.h"
+#include "renderInstance/renderDeferredMgr.h"
 
 
 GFX_ImplementTextureProfile(ShadowMapTexProfile,
@@ -87,6 +89,21 @@ AFTER_MODULE_INIT( Sim )
       "Minimum distance moved per frame to determine that we are teleporting.\n");
    Con::addVariableNotify("$pref::Shadows::teleportDist", shadowCallback);
 
+   Con::addVariable( "$pref::Shadows::cacheStatic",
+      TypeBool, &LightShadowMap::smCacheStaticShadows,
+      "If true, static shadow maps are only rendered again when their light, "
+      "the view of a view dependent map, or the shadow casters around the light "
+      "change. Lights with moving shapes in range refresh as before.\n"
+      "@ingroup AdvancedLighting\n" );
+
+   Con::addVariable( "$pref::Shadows::atlasSize",
+      TypeS32, &ShadowMapAtlas::smAtlasSize,
+      "@brief The size of the texture shared by the spot light shadow maps.\n"
+      "Each light gets a tile sized by its screen size.  Lights that do not fit "
+      "fall back to their own texture.  Set to zero to disable the atlas.\n"
+      "@ingroup AdvancedLighting\n" );
+   Con::addVariableNotify( "$pref::Shadows::atlasSize", callabck );
+
    Con::addVariable("$pref::Shadows::turnRate",
       TypeF32, &ShadowMapPass::smShadowsTurnRate,
       "Minimum angle moved per frame to determine that we are turning quickly.\n");
@@ -106,6 +123,8 @@ ShadowMapManager::ShadowMapManager()
 
 ShadowMapManager::~ShadowMapManager()
 {
+   // Return any atlas tiles before the atlas goes away.
+   LightShadowMap::releaseAllTextures();
 }
 
 void ShadowMapManager::setLightShadowMapForLight( LightInfo *light )
@@ -137,12 +156,14 @@ void ShadowMapManager::activate()
 
    getSceneManager()->getPreRenderSignal().notify( this, &ShadowMapManager::_onPreRender, 0.01f );
    GFXTextureManager::addEventDelegate( this, &ShadowMapManager::_onTextureEvent );
+   MaterialManager::getWarmUpSignal().notify( this, &ShadowMapManager::_onMaterialWarmUp );
 
    mIsActive = true;
 }
 
 void ShadowMapManager::deactivate()
 {
+   MaterialManager::getWarmUpSignal().remove( this, &ShadowMapManager::_onMaterialWarmUp );
    GFXTextureManager::removeEventDelegate( this, &ShadowMapManager::_onTextureEvent );
    getSceneManager()->getPreRenderSignal().remove( this, &ShadowMapManager::_onPreRender );
 
@@ -151,6 +172,7 @@ void ShadowMapManager::deactivate()
 
    // Clean up our shadow texture memory.
    LightShadowMap::releaseAllTextures();
+   mShadowAtlas.reset();
    TEXMGR->cleanupPool();
 
    mIsActive = false;
@@ -164,6 +186,20 @@ void ShadowMapManager::_onPreRender( SceneManager *sg, const SceneRenderState *s
       mShadowMapPass->render( sg, state, (U32)-1 );
 }
 
+void ShadowMapManager::_onMaterialWarmUp( BaseMatInstance *mat )
+{
+   // Skip the materials the shadow and deferred
+   // hooks have created themselves.
+   if ( dynamic_cast<ShadowMatInstance*>( mat ) || dynamic_cast<DeferredMatInstance*>( mat ) )
+      return;
+
+   BaseMaterialDefinition *matDef = mat->getMaterial();
+   if ( !matDef || !matDef->castsShadows() )
+      return;
+
+   ShadowMaterialHook::findOrCreate( mat );
+}
+
 void ShadowMapManager::_onTextureEvent( GFXTexCallbackCode code )
 {
    if ( code == GFXZombify )
@@ -38,10 +38,14 @@
 #ifndef _MPOINT4_H_
 #include "math/mPoint4.h"
 #endif
+#ifndef _SHADOWMAPATLAS_H_
+#include "lighting/shadowMap/shadowMapAtlas.h"
+#endif
 
 class LightShadowMap;
 class ShadowMapPass;
 class LightInfo;
+class BaseMatInstance;
 
 class SceneManager;
 class SceneRenderState;
@@ -77,6 +81,9 @@ public:
 
    GFXTextureObject* getTapRotationTex();
 
+   /// Returns the atlas shared by the local light shadow maps.
+   ShadowMapAtlas* getShadowAtlas() { return &mShadowAtlas; }
+
    /// The shadow map deactivation signal.
    static Signal<void(void)> smShadowDeactivateSignal;
 
@@ -88,6 +95,9 @@ protected:
 
    void _onPreRender( SceneManager *sg, const SceneRenderState* state );
 
+   /// @see MaterialManager::getWarmUpSignal
+   void _onMaterialWarmUp( BaseMatInstance *mat );
+
    ShadowMapPass *mShadowMapPass;
    LightShadowMap *mCurrentShadowMap;
    LightShadowMap *mCurrentDynamicShadowMap;
@@ -95,6 +105,9 @@ protected:
    ///
    GFXTexHandle mTapRotationTex;
 
+   ///
+   ShadowMapAtlas mShadowAtlas;
+
    bool mIsActive;
 
 public:
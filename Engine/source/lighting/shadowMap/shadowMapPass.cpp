@@ -37,6 +37,7 @@
 #include "console/consoleTypes.h"
 #include "gfx/gfxTransformSaver.h"
 #include "gfx/gfxDebugEvent.h"
+#include "gfx/gfxGPUTimings.h"
 #include "platform/platformTimer.h"
 
 #include "T3D/gameBase/gameConnection.h"
@@ -88,6 +89,9 @@ ShadowMapPass::ShadowMapPass(LightManager* lightManager, ShadowMapManager* shado
    mDynamicShadowRPM->addManager( new RenderTerrainMgr( 0.5f, 0.5f )  );
    mDynamicShadowRPM->addManager( new RenderImposterMgr( 0.6f, 0.6f )  );
 
+   SceneObject::smSceneObjectAdd.notify( &LightShadowMap::notifySceneObjectChanged );
+   SceneObject::smSceneObjectRemove.notify( &LightShadowMap::notifySceneObjectChanged );
+
    mActiveLights = 0;
    mPrevCamPos = Point3F::Zero;
    mPrevCamRot = Point3F::Zero;
@@ -128,6 +132,9 @@ ShadowMapPass::ShadowMapPass(LightManager* lightManager, ShadowMapManager* shado
 
 ShadowMapPass::~ShadowMapPass()
 {
+   SceneObject::smSceneObjectAdd.remove( &LightShadowMap::notifySceneObjectChanged );
+   SceneObject::smSceneObjectRemove.remove( &LightShadowMap::notifySceneObjectChanged );
+
    SAFE_DELETE( mTimer );
 
    if ( mShadowRPM )
@@ -142,6 +149,7 @@ void ShadowMapPass::render(   SceneManager *sceneManager,
                               U32 objectMask )
 {
    PROFILE_SCOPE( ShadowMapPass_Render );
+   GFXGPUTIMING_SCOPE( "ShadowMaps" );
 
    // Prep some shadow rendering stats.
    smActiveShadowMaps = 0;
@@ -163,9 +171,11 @@ void ShadowMapPass::render(   SceneManager *sceneManager,
    const U32 currTime = Sim::getCurrentTime();
 
    // First do a loop thru the lights setting up the shadow
-   // info array for this pass.
+   // info array for this pass.  We only track the dynamic map
+   // of each light here and look up the static one from the
+   // light when rendering so that the pair sorts as one.
    Vector<LightShadowMap*> shadowMaps;
-   shadowMaps.reserve( mActiveLights * 2 );
+   shadowMaps.reserve( mActiveLights );
    for ( U32 i = 0; i < mActiveLights; i++ )
    {
       ShadowMapParams *params = mLights[i]->getExtended<ShadowMapParams>();
@@ -179,8 +189,11 @@ void ShadowMapPass::render(   SceneManager *sceneManager,
       LightShadowMap *dlsm = params->getOrCreateShadowMap(true);
 
       // First check the visiblity query... if it wasn't 
-      // visible skip it.
-      if(params->getOcclusionQuery()->getStatus(true) == GFXOcclusionQuery::Occluded)
+      // visible skip it.  The result is a frame or two old, but
+      // waiting on the GPU for the newest one would stall.
+      GFXOcclusionQuery::OcclusionQueryStatus status;
+      params->getOcclusionQuery().getLastStatus( &status );
+      if ( status == GFXOcclusionQuery::Occluded )
          continue;
 
       // Any shadow that is visible is counted as being 
@@ -190,8 +203,6 @@ void ShadowMapPass::render(   SceneManager *sceneManager,
       // Do a priority update for this shadow.
       lsm->updatePriority(diffuseState, currTime);
 
-      shadowMaps.push_back(lsm);
-
       // --- Dynamic Shadow Map ---
 
       // Any shadow that is visible is counted as being 
@@ -204,9 +215,10 @@ void ShadowMapPass::render(   SceneManager *sceneManager,
       shadowMaps.push_back( dlsm );
    }
 
-   // Now sort the shadow info by priority.
-   // andrewmac: tempoarily disabled until I find a better solution.
-   //shadowMaps.sort( LightShadowMap::cmpPriority );
+   // Now sort the shadow info by priority.  The priority grows
+   // with the time since the last update, so the lights we skip
+   // for being over budget move up until they get their turn.
+   shadowMaps.sort( LightShadowMap::cmpPriority );
 
    GFXDEBUGEVENT_SCOPE( ShadowMapPass_Render, ColorI::RED );
 
@@ -237,11 +249,11 @@ void ShadowMapPass::render(   SceneManager *sceneManager,
    mPrevCamPos = curCamMatrix.getPosition();
    mPrevCamFov = control->getCameraFov();
 
-   // 2 Shadow Maps per Light. This may fail.
-   for ( U32 i = 0; i < shadowMaps.size(); i += 2 )
+   // 2 Shadow Maps per Light.
+   for ( U32 i = 0; i < shadowMaps.size(); i++ )
    {
-	   LightShadowMap *lsm = shadowMaps[i];
-	   LightShadowMap *dlsm = shadowMaps[i + 1];
+      LightShadowMap *dlsm = shadowMaps[i];
+      LightShadowMap *lsm = dlsm->getLightInfo()->getExtended<ShadowMapParams>()->getShadowMap();
 
       {
          GFXDEBUGEVENT_SCOPE( ShadowMapPass_Render_Shadow, ColorI::RED );
@@ -309,6 +321,12 @@ void ShadowRenderPassManager::addInst( RenderInst *inst )
    Parent::addInst(inst);
 }
 
+void ShadowRenderPassManager::addInsts( RenderInst **insts, U32 count )
+{
+   for ( U32 i = 0; i < count; i++ )
+      addInst( insts[i] );
+}
+
 void DynamicShadowRenderPassManager::addInst( RenderInst *inst )
 {
    PROFILE_SCOPE(DynamicShadowRenderPassManager_addInst);
@@ -330,3 +348,9 @@ void DynamicShadowRenderPassManager::addInst( RenderInst *inst )
 
    Parent::addInst(inst);
 }
+
+void DynamicShadowRenderPassManager::addInsts( RenderInst **insts, U32 count )
+{
+   for ( U32 i = 0; i < count; i++ )
+      addInst( insts[i] );
+}
@@ -125,6 +125,9 @@ public:
 
    /// Add a RenderInstance to the list
    virtual void addInst( RenderInst *inst );
+
+   /// Filters every instance through addInst().
+   virtual void addInsts( RenderInst **insts, U32 count );
 };
 
 class DynamicShadowRenderPassManager : public RenderPassManager
@@ -135,6 +138,9 @@ public:
 
 	/// Add a RenderInstance to the list
 	virtual void addInst(RenderInst *inst);
+
+	/// Filters every instance through addInst().
+	virtual void addInsts(RenderInst **insts, U32 count);
 };
 
 #endif // _SHADOWMAPPASS_H_
@@ -158,6 +158,21 @@ void ShadowMaterialHook::init( BaseMatInstance *inMat )
    */
 }
 
+ShadowMaterialHook* ShadowMaterialHook::findOrCreate( BaseMatInstance *inMat )
+{
+   // See if we have an existing material hook.
+   ShadowMaterialHook *hook = static_cast<ShadowMaterialHook*>( inMat->getHook( Type ) );
+   if ( !hook )
+   {
+      // Create a hook and initialize it using the incoming material.
+      hook = new ShadowMaterialHook;
+      hook->init( inMat );
+      inMat->addHook( hook );
+   }
+
+   return hook;
+}
+
 BaseMatInstance* ShadowMaterialHook::getShadowMat( ShadowType type ) const
 { 
    AssertFatal( type < ShadowType_Count, "ShadowMaterialHook::getShadowMat() - Bad light type!" );
@@ -65,6 +65,10 @@ public:
 
    void init( BaseMatInstance *mat );
 
+   /// Returns the shadow hook of the material creating
+   /// it if it doesn't exist yet.
+   static ShadowMaterialHook* findOrCreate( BaseMatInstance *inMat );
+
 protected:
 
    static void _overrideFeatures(   ProcessedMaterial *mat,
@@ -29,12 +29,15 @@
 #include "scene/sceneRenderState.h"
 //#include "scene/sceneReflectPass.h"
 #include "gfx/gfxDevice.h"
+#include "gfx/gfxDrawUtil.h"
 #include "gfx/util/gfxFrustumSaver.h"
 #include "gfx/gfxTransformSaver.h"
 #include "renderInstance/renderPassManager.h"
 
 SingleLightShadowMap::SingleLightShadowMap(  LightInfo *light )
-   :  LightShadowMap( light )
+   :  LightShadowMap( light ),
+      mAtlas( NULL ),
+      mAtlasRect( 0, 0, 0, 0 )
 {
 }
 
@@ -55,17 +58,18 @@ void SingleLightShadowMap::_render( RenderPassManager* renderPass,
 
    if (  mShadowMapTex.isNull() ||
          mTexSize != texSize )
-   {
-      mTexSize = texSize;
-
-      mShadowMapTex.set(   mTexSize, mTexSize, 
-                           ShadowMapFormat, &ShadowMapProfile, 
-                           "SingleLightShadowMap" );
-   }
+      _allocTexture( texSize );
 
    GFXFrustumSaver frustSaver;
    GFXTransformSaver saver;
 
+   // Render the shadowmap!
+   GFX->pushActiveRenderTarget();
+   mTarget->attachTexture( GFXTextureTarget::Color0, mShadowMapTex );
+   mTarget->attachTexture( GFXTextureTarget::DepthStencil, 
+      _getDepthTarget( mShadowMapTex->getWidth(), mShadowMapTex->getHeight() ) );
+   GFX->setActiveRenderTarget(mTarget);
+
    MatrixF lightMatrix;
    calcLightMatrices( lightMatrix, diffuseState->getCameraFrustum() );
    lightMatrix.inverse();
@@ -74,13 +78,34 @@ void SingleLightShadowMap::_render( RenderPassManager* renderPass,
    const MatrixF& lightProj = GFX->getProjectionMatrix();
    mWorldToLightProj = lightProj * lightMatrix;
 
-   // Render the shadowmap!
-   GFX->pushActiveRenderTarget();
-   mTarget->attachTexture( GFXTextureTarget::Color0, mShadowMapTex );
-   mTarget->attachTexture( GFXTextureTarget::DepthStencil, 
-      _getDepthTarget( mShadowMapTex->getWidth(), mShadowMapTex->getHeight() ) );
-   GFX->setActiveRenderTarget(mTarget);
-   GFX->clear(GFXClearStencil | GFXClearZBuffer | GFXClearTarget, ColorI(255,255,255), 1.0f, 0);
+   if ( mAtlas )
+   {
+      // The other tiles must survive, so clear ours by hand and
+      // render inside a border that keeps the filter taps from
+      // reaching the neighboring tiles.
+      _clearAtlasTile();
+
+      const S32 border = getMax( mAtlasRect.extent.x / 32, 1 );
+      RectI viewport( mAtlasRect );
+      viewport.inset( border, border );
+      GFX->setViewport( viewport );
+
+      // Fold the viewport into the projection so the lighting
+      // shaders sample the tile without knowing about the atlas.
+      const F32 atlasSize = mShadowMapTex->getWidth();
+      const F32 scale = viewport.extent.x / atlasSize;
+      const F32 u = viewport.point.x / atlasSize;
+      const F32 v = viewport.point.y / atlasSize;
+
+      MatrixF tileMat( true );
+      tileMat( 0, 0 ) = scale;
+      tileMat( 0, 3 ) = scale + ( 2.0f * u ) - 1.0f;
+      tileMat( 1, 1 ) = scale;
+      tileMat( 1, 3 ) = 1.0f - scale - ( 2.0f * v );
+      mWorldToLightProj = tileMat * mWorldToLightProj;
+   }
+   else
+      GFX->clear(GFXClearStencil | GFXClearZBuffer | GFXClearTarget, ColorI(255,255,255), 1.0f, 0);
 
    SceneManager* sceneManager = diffuseState->getSceneManager();
    
@@ -106,6 +131,61 @@ void SingleLightShadowMap::_render( RenderPassManager* renderPass,
    GFX->popActiveRenderTarget();
 }
 
+void SingleLightShadowMap::_allocTexture( U32 texSize )
+{
+   releaseTextures();
+
+   mTexSize = texSize;
+
+   ShadowMapAtlas *atlas = SHADOWMGR->getShadowAtlas();
+   if ( atlas->allocTile( mTexSize, &mAtlasRect ) )
+   {
+      mAtlas = atlas;
+      mShadowMapTex = atlas->getTexture();
+      return;
+   }
+
+   mShadowMapTex.set(   mTexSize, mTexSize, 
+                        ShadowMapFormat, &ShadowMapProfile, 
+                        "SingleLightShadowMap" );
+}
+
+void SingleLightShadowMap::_clearAtlasTile()
+{
+   GFXTransformSaver saver;
+
+   GFX->setViewport( mAtlasRect );
+   GFX->setWorldMatrix( MatrixF::Identity );
+   GFX->setViewMatrix( MatrixF::Identity );
+   GFX->setProjectionMatrix( MatrixF::Identity );
+
+   GFXStateBlockDesc desc;
+   desc.setZReadWrite( true, true );
+   desc.zFunc = GFXCmpAlways;
+   desc.setCullMode( GFXCullNone );
+
+   const Point3F quad[4] =
+   {
+      Point3F( -1.0f, -1.0f, 1.0f ),
+      Point3F( 1.0f, -1.0f, 1.0f ),
+      Point3F( -1.0f, 1.0f, 1.0f ),
+      Point3F( 1.0f, 1.0f, 1.0f ),
+   };
+
+   GFX->getDrawUtil()->drawPolygon( desc, quad, 4, ColorI::WHITE );
+}
+
+void SingleLightShadowMap::releaseTextures()
+{
+   if ( mAtlas )
+   {
+      mAtlas->freeTile( mAtlasRect );
+      mAtlas = NULL;
+   }
+
+   Parent::releaseTextures();
+}
+
 void SingleLightShadowMap::setShaderParameters(GFXShaderConstBuffer* params, LightingShaderConstants* lsc)
 {
    if ( lsc->mTapRotationTexSC->isValid() )
@@ -123,6 +203,8 @@ void SingleLightShadowMap::setShaderParameters(GFXShaderConstBuffer* params, Lig
       params->set(lsc->mLightParamsSC, lightParams);
    }
 
-   // The softness is a factor of the texel size.
-   params->setSafe( lsc->mShadowSoftnessConst, p->shadowSoftness * ( 1.0f / mTexSize ) );
+   // The softness is a factor of the texel size which
+   // is in atlas texels when we're rendering to a tile.
+   const U32 texelSize = mAtlas ? mShadowMapTex->getWidth() : mTexSize;
+   params->setSafe( lsc->mShadowSoftnessConst, p->shadowSoftness * ( 1.0f / texelSize ) );
 }
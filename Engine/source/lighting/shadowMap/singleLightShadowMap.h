@@ -26,12 +26,16 @@
 #include "lighting/shadowMap/lightShadowMap.h"
 #endif
 
+class ShadowMapAtlas;
+
 //
 // SingleLightShadowMap, holds the shadow map and various other things for a light.
 //
 // This represents everything we need to render the shadowmap for one light.
 class SingleLightShadowMap : public LightShadowMap
 {
+   typedef LightShadowMap Parent;
+
 public:
    SingleLightShadowMap( LightInfo *light );
    ~SingleLightShadowMap();
@@ -40,6 +44,23 @@ public:
    virtual ShadowType getShadowType() const { return ShadowType_Spot; }
    virtual void _render( RenderPassManager* renderPass, const SceneRenderState *diffuseState );
    virtual void setShaderParameters(GFXShaderConstBuffer* params, LightingShaderConstants* lsc);
+   virtual void releaseTextures();
+
+protected:
+
+   /// Allocates the shadow texture either as a tile
+   /// in the shared atlas or as its own texture.
+   void _allocTexture( U32 texSize );
+
+   /// Clears the atlas tile to the far depth.
+   void _clearAtlasTile();
+
+   /// The atlas the tile was allocated from or
+   /// NULL if the map has its own texture.
+   ShadowMapAtlas *mAtlas;
+
+   /// The tile in the atlas texture.
+   RectI mAtlasRect;
 };
 
 
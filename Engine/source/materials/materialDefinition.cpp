@@ -172,6 +172,7 @@ Material::Material()
    dMemset(mCellLayout, 0, sizeof(mCellLayout));
    dMemset(mCellSize, 0, sizeof(mCellSize));
    dMemset(mNormalMapAtlas, 0, sizeof(mNormalMapAtlas));
+   dMemset(mAtlasDiffuseMap, 0, sizeof(mAtlasDiffuseMap));
    dMemset(mUseAnisotropic, 0, sizeof(mUseAnisotropic));
 
    // Deferred Shading : Metalness
@@ -368,6 +369,12 @@ void Material::initPersistFields()
          "@internal");
       addField("bumpAtlas", TypeBool, Offset(mNormalMapAtlas, Material), MAX_STAGES,
          "@internal");
+      addField("atlasDiffuseMap", TypeBool, Offset(mAtlasDiffuseMap, Material), MAX_STAGES,
+         "If true and the diffuse map is a small square power of two image, it is packed "
+         "into a texture atlas page shared with other such maps and its UVs are remapped "
+         "in the shader.  Materials sharing a page bind the same texture, which saves "
+         "texture changes when drawing many of them.  The UVs still wrap.\n"
+         "@see $pref::Video::textureAtlasMaxSize");
 
       // For backwards compatibility.  
       //
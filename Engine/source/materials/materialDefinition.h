@@ -37,6 +37,9 @@
 #ifndef _GFXCUBEMAP_H_
    #include "gfx/gfxCubemap.h"
 #endif
+#ifndef _GFXTEXTUREATLAS_H_
+   #include "gfx/gfxTextureAtlas.h"
+#endif
 #ifndef _DYNAMIC_CONSOLETYPES_H_
    #include "console/dynamicTypes.h"
 #endif
@@ -135,6 +138,9 @@ public:
       /// The cubemap for this stage.
       GFXCubemap *mCubemap;
 
+      /// The atlas block of the diffuse map if it is atlased.
+      GFXAtlasEntry mDiffuseAtlas;
+
    public:
 
       StageData()
@@ -192,6 +198,13 @@ public:
       /// Set the stage cubemap.
       void setCubemap( GFXCubemap *cubemap ) { mCubemap = cubemap; }
 
+      /// Returns where the diffuse map went in its atlas page.
+      /// @see Material::mAtlasDiffuseMap
+      const GFXAtlasEntry& getDiffuseAtlas() const { return mDiffuseAtlas; }
+
+      /// Set where the diffuse map went in its atlas page.
+      void setDiffuseAtlas( const GFXAtlasEntry &entry ) { mDiffuseAtlas = entry; }
+
    };
 
 public:
@@ -275,6 +288,10 @@ public:
    U32 mCellSize[MAX_STAGES];
    bool mNormalMapAtlas[MAX_STAGES];
 
+   /// Pack the diffuse map into a shared texture atlas page.
+   /// @see GFXTextureManager::createAtlasTexture
+   bool mAtlasDiffuseMap[MAX_STAGES];
+
    /// Special array of UVs for imposter rendering.
    /// @see TSLastDetail
    Vector<RectF> mImposterUVs;
@@ -31,6 +31,8 @@
 #include "core/module.h"
 #include "console/consoleTypes.h"
 #include "console/engineAPI.h"
+#include "platform/profiler.h"
+#include "gfx/gfxTextureManager.h"
 
 
 MODULE_BEGIN( MaterialManager )
@@ -90,6 +92,16 @@ MaterialManager::MaterialManager()
    Con::addVariableNotify( "$pref::Video::disableCubemapping", callabck2 );
    Con::setVariable( "$pref::Video::disableParallaxMapping", "false" );
    Con::addVariableNotify( "$pref::Video::disableParallaxMapping", callabck2 );
+
+   mUberShaders = false;
+   Con::addVariable( "$pref::Video::uberShaders", TypeBool, &mUberShaders,
+      "@brief Trades a little shader work for fewer shader permutations.\n\n"
+      "If true, material features that only depend on material constants, like the diffuse "
+      "color tint and texture animation, are enabled on every textured material and set to "
+      "neutral values where unused.  Materials which differ only by these properties then "
+      "share shaders, which cuts compile time and lets more meshes batch together.\n\n"
+      "@ingroup Materials");
+   Con::addVariableNotify( "$pref::Video::uberShaders", callabck2 );
 }
 
 MaterialManager::~MaterialManager()
@@ -327,6 +339,82 @@ void MaterialManager::flushAndReInitInstances()
       (*iter)->reInit();
 }
 
+MaterialManager::WarmUpSignal& MaterialManager::getWarmUpSignal()
+{
+   static WarmUpSignal theSignal;
+   return theSignal;
+}
+
+void MaterialManager::warmUpInstances()
+{
+   PROFILE_SCOPE( MaterialManager_WarmUpInstances );
+
+   // The listeners create new material instances which
+   // we don't want to warm up themselves, so work on a
+   // copy of the current list.
+   Vector<BaseMatInstance*> instances( mMatInstanceList );
+
+   const U32 startTime = Platform::getRealMilliseconds();
+
+   for ( U32 i = 0; i < instances.size(); i++ )
+   {
+      if ( instances[i]->isValid() )
+         getWarmUpSignal().trigger( instances[i] );
+   }
+
+   Con::printf( "MaterialManager::warmUpInstances - Warmed up %d instances in %dms.",
+      instances.size(), Platform::getRealMilliseconds() - startTime );
+}
+
+void MaterialManager::preloadTextures()
+{
+   PROFILE_SCOPE( MaterialManager_PreloadTextures );
+
+   SimSet *materials = getMaterialSet();
+   if ( !materials || !GFXDevice::devicePresent() || !TEXMGR )
+      return;
+
+   Vector<String> paths;
+   for ( SimSet::iterator iter = materials->begin(); iter != materials->end(); ++iter )
+   {
+      Material *mat = dynamic_cast<Material*>( *iter );
+      if ( !mat )
+         continue;
+
+      const FileName *maps[] =
+      {
+         mat->mDiffuseMapFilename,
+         mat->mOverlayMapFilename,
+         mat->mLightMapFilename,
+         mat->mToneMapFilename,
+         mat->mDetailMapFilename,
+         mat->mNormalMapFilename,
+         mat->mSpecularMapFilename,
+         mat->mDetailNormalMapFilename,
+      };
+
+      for ( U32 i = 0; i < sizeof( maps ) / sizeof( maps[0] ); i++ )
+      {
+         for ( U32 stage = 0; stage < Material::MAX_STAGES; stage++ )
+         {
+            const String &filename = maps[i][stage];
+
+            // Named targets like "#deferred" are no files.
+            if ( filename.isEmpty() || filename.startsWith( "#" ) )
+               continue;
+
+            // Same rule as ProcessedMaterial::_getTexturePath().
+            if ( filename.find( '/' ) != String::NPos )
+               paths.push_back( filename );
+            else
+               paths.push_back( mat->getPath() + filename );
+         }
+      }
+   }
+
+   TEXMGR->preloadBitmaps( paths );
+}
+
 // Used in the materialEditor. This flushes the material preview object so it can be reloaded easily.
 void MaterialManager::flushInstance( BaseMaterialDefinition *target )
 {
@@ -461,6 +549,25 @@ DefineConsoleFunction( reInitMaterials, void, (),,
    MATMGR->flushAndReInitInstances();
 }
 
+DefineConsoleFunction( warmUpMaterials, void, (),,
+   "@brief Builds the deferred and shadow materials of all active material instances.\n\n"
+   "Call this once a level has loaded to move the shader generation these materials "
+   "need from the first frames they are seen in to the loading phase.\n\n"
+   "@ingroup Materials")
+{
+   MATMGR->warmUpInstances();
+}
+
+DefineConsoleFunction( preloadMaterialTextures, void, (),,
+   "@brief Decodes the texture images of all materials on worker threads.\n\n"
+   "Call this before a level loads so the decoding happens in parallel rather "
+   "than one image at a time as materials are initialized.  The decoded images "
+   "are held until releasePreloadedTextures() is called.\n\n"
+   "@ingroup Materials")
+{
+   MATMGR->preloadTextures();
+}
+
 DefineConsoleFunction( addMaterialMapping, void, (const char * texName, const char * matName), , "(string texName, string matName)\n"
    "@brief Maps the given texture to the given material.\n\n"
    "Generates a console warning before overwriting.\n\n"
@@ -34,6 +34,9 @@
 #ifndef _TSINGLETON_H_
 #include "core/util/tSingleton.h"
 #endif
+#ifndef _TOPENHASHTABLE_H_
+#include "core/util/tOpenHashTable.h"
+#endif
 
 class SimSet;
 class MatInstance;
@@ -73,6 +76,10 @@ public:
    /// Get the default texture anisotropy.
    U32 getDefaultAnisotropy() const { return mDefaultAnisotropy; }
 
+   /// Returns true if cheap per-material features should always be
+   /// enabled and driven by shader constants to share more shaders.
+   bool useUberShaders() const { return mUberShaders; }
+
    /// Allocate and return an instance of special materials.  Caller is responsible for the memory.
    BaseMatInstance * createWarningMatInstance();
 
@@ -120,6 +127,27 @@ public:
    /// Re-initializes the material instances for a specific target material.   
    void reInitInstance( BaseMaterialDefinition *target );
 
+   /// Signal used to have systems build the materials they
+   /// derive from a material instance on first use.
+   typedef Signal<void(BaseMatInstance*)> WarmUpSignal;
+
+   /// Returns the signal triggered for every material
+   /// instance by warmUpInstances().
+   static WarmUpSignal& getWarmUpSignal();
+
+   /// Builds the deferred, shadow, and other derived materials of
+   /// all active material instances now instead of when they are
+   /// first rendered.  Meant to be called once a level is loaded
+   /// so that objects coming into view don't stall a frame on
+   /// shader generation.
+   void warmUpInstances();
+
+   /// Decodes the texture images of all material definitions on the
+   /// ThreadPool ahead of time.  Meant to be called before a level loads
+   /// so that the materials it creates only have to upload their textures.
+   /// @see GFXTextureManager::preloadBitmaps
+   void preloadTextures();
+
 protected:
 
    // MatInstance tracks it's instances here
@@ -150,7 +178,7 @@ protected:
    bool mFlushAndReInit;
 
    // material map
-   typedef Map<String, String> MaterialMap;
+   typedef Map<String, String, OpenHashTable<String, String> > MaterialMap;
    MaterialMap mMaterialMap;
 
    bool mUsingDeferred;
@@ -165,6 +193,11 @@ protected:
    /// The default max anisotropy used in texture filtering.
    S32 mDefaultAnisotropy;
 
+   /// If set ProcessedShaderMaterial folds features which only depend
+   /// on material constants into all shaders.
+   /// @see useUberShaders
+   bool mUberShaders;
+
    /// Called when $pref::Video::defaultAnisotropy is changed.
    void _updateDefaultAnisotropy();
 
@@ -172,7 +205,7 @@ protected:
    void _onDisableMaterialFeature() { mFlushAndReInit = true; }
 
 #ifndef TORQUE_SHIPPING
-   typedef Map<U32, BaseMatInstance *>  DebugMaterialMap;
+   typedef Map<U32, BaseMatInstance *, OpenHashTable<U32, BaseMatInstance *> >  DebugMaterialMap;
    DebugMaterialMap  mMeshDebugMaterialInsts;
 #endif
 
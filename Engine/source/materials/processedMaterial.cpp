@@ -169,8 +169,12 @@ String ProcessedMaterial::_getTexturePath(const String& filename)
    return mMaterial->getPath() + filename;
 }
 
-GFXTexHandle ProcessedMaterial::_createTexture( const char* filename, GFXTextureProfile *profile)
+GFXTexHandle ProcessedMaterial::_createTexture( const char* filename, GFXTextureProfile *profile, bool streaming )
 {
+   if ( streaming )
+      return GFXTexHandle( GFXTexHandle( TEXMGR->createStreamingTexture( _getTexturePath(filename), profile ) ),
+                           avar("%s() - NA (line %d)", __FUNCTION__, __LINE__) );
+
    return GFXTexHandle( _getTexturePath(filename), profile, avar("%s() - NA (line %d)", __FUNCTION__, __LINE__) );
 }
 
@@ -389,9 +393,16 @@ void ProcessedMaterial::_setStageData()
    for( i=0; i<Material::MAX_STAGES; i++ )
    {
       // DiffuseMap
-      if( mMaterial->mDiffuseMapFilename[i].isNotEmpty() )
+      if( mMaterial->mDiffuseMapFilename[i].isNotEmpty() && mMaterial->mAtlasDiffuseMap[i] && !mMaterial->mDiffuseMapFilename[i].startsWith("#") )
+      {
+         GFXAtlasEntry entry;
+         mStages[i].setTex( MFT_DiffuseMap, TEXMGR->createAtlasTexture( _getTexturePath(mMaterial->mDiffuseMapFilename[i]), &GFXStaticTextureSRGBAtlasProfile, &entry ) );
+         mStages[i].setDiffuseAtlas( entry );
+      }
+
+      if( mMaterial->mDiffuseMapFilename[i].isNotEmpty() && !mStages[i].getTex( MFT_DiffuseMap ) )
       {
-         mStages[i].setTex( MFT_DiffuseMap, _createTexture( mMaterial->mDiffuseMapFilename[i], &GFXStaticTextureSRGBProfile) );
+         mStages[i].setTex( MFT_DiffuseMap, _createTexture( mMaterial->mDiffuseMapFilename[i], &GFXStaticTextureSRGBProfile, true ) );
          if (!mStages[i].getTex( MFT_DiffuseMap ))
          {
             //If we start with a #, we're probably actually attempting to hit a named target and it may not get a hit on the first pass. So we'll
@@ -408,7 +419,7 @@ void ProcessedMaterial::_setStageData()
       // OverlayMap
       if( mMaterial->mOverlayMapFilename[i].isNotEmpty() )
       {
-         mStages[i].setTex( MFT_OverlayMap, _createTexture( mMaterial->mOverlayMapFilename[i], &GFXStaticTextureSRGBProfile ) );
+         mStages[i].setTex( MFT_OverlayMap, _createTexture( mMaterial->mOverlayMapFilename[i], &GFXStaticTextureSRGBProfile, true ) );
          if(!mStages[i].getTex( MFT_OverlayMap ))
             mMaterial->logError("Failed to load overlay map %s for stage %i", _getTexturePath(mMaterial->mOverlayMapFilename[i]).c_str(), i);
       }
@@ -432,7 +443,7 @@ void ProcessedMaterial::_setStageData()
       // DetailMap
       if( mMaterial->mDetailMapFilename[i].isNotEmpty() )
       {
-         mStages[i].setTex( MFT_DetailMap, _createTexture( mMaterial->mDetailMapFilename[i], &GFXStaticTextureProfile) );
+         mStages[i].setTex( MFT_DetailMap, _createTexture( mMaterial->mDetailMapFilename[i], &GFXStaticTextureProfile, true ) );
          if(!mStages[i].getTex( MFT_DetailMap ))
             mMaterial->logError("Failed to load detail map %s for stage %i", _getTexturePath(mMaterial->mDetailMapFilename[i]).c_str(), i);
       }
@@ -440,7 +451,7 @@ void ProcessedMaterial::_setStageData()
       // NormalMap
       if( mMaterial->mNormalMapFilename[i].isNotEmpty() )
       {
-         mStages[i].setTex( MFT_NormalMap, _createTexture( mMaterial->mNormalMapFilename[i], &GFXNormalMapProfile) );
+         mStages[i].setTex( MFT_NormalMap, _createTexture( mMaterial->mNormalMapFilename[i], &GFXNormalMapProfile, true ) );
          if(!mStages[i].getTex( MFT_NormalMap ))
             mMaterial->logError("Failed to load normal map %s for stage %i", _getTexturePath(mMaterial->mNormalMapFilename[i]).c_str(), i);
       }
@@ -448,7 +459,7 @@ void ProcessedMaterial::_setStageData()
       // Detail Normal Map
       if( mMaterial->mDetailNormalMapFilename[i].isNotEmpty() )
       {
-         mStages[i].setTex( MFT_DetailNormalMap, _createTexture( mMaterial->mDetailNormalMapFilename[i], &GFXNormalMapProfile) );
+         mStages[i].setTex( MFT_DetailNormalMap, _createTexture( mMaterial->mDetailNormalMapFilename[i], &GFXNormalMapProfile, true ) );
          if(!mStages[i].getTex( MFT_DetailNormalMap ))
             mMaterial->logError("Failed to load normal map %s for stage %i", _getTexturePath(mMaterial->mDetailNormalMapFilename[i]).c_str(), i);
       }
@@ -456,7 +467,7 @@ void ProcessedMaterial::_setStageData()
       // SpecularMap
       if( mMaterial->mSpecularMapFilename[i].isNotEmpty() )
       {
-         mStages[i].setTex( MFT_SpecularMap, _createTexture( mMaterial->mSpecularMapFilename[i], &GFXStaticTextureSRGBProfile) );
+         mStages[i].setTex( MFT_SpecularMap, _createTexture( mMaterial->mSpecularMapFilename[i], &GFXStaticTextureSRGBProfile, true ) );
          if(!mStages[i].getTex( MFT_SpecularMap ))
             mMaterial->logError("Failed to load specular map %s for stage %i", _getTexturePath(mMaterial->mSpecularMapFilename[i]).c_str(), i);
       }
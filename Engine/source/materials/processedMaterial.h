@@ -283,8 +283,9 @@ protected:
    /// Returns the path the material will attempt to load for a given texture filename.
    String _getTexturePath(const String& filename);
 
-   /// Loads the texture located at _getTexturePath(filename) and gives it the specified profile
-   GFXTexHandle _createTexture( const char *filename, GFXTextureProfile *profile );
+   /// Loads the texture located at _getTexturePath(filename) and gives it the specified profile.
+   /// If @a streaming is set the texture may be streamed in, see GFXTextureManager::createStreamingTexture().
+   GFXTexHandle _createTexture( const char *filename, GFXTextureProfile *profile, bool streaming = false );
 
    /// @name State blocks
    ///
@@ -40,6 +40,7 @@
 #include "materials/matTextureTarget.h"
 #include "gfx/util/screenspace.h"
 #include "math/util/matrixSet.h"
+#include "gfx/gfxTextureManager.h"
 
 // We need to include customMaterialDefinition for ShaderConstHandles::init
 #include "materials/customMaterialDefinition.h"
@@ -380,7 +381,9 @@ void ProcessedShaderMaterial::_determineFeatures(  U32 stageNum,
    if ( mMaterial->mSubSurface[stageNum] )
       fd.features.addFeature( MFT_SubSurface );
 
-   if ( !mMaterial->mCellLayout[stageNum].isZero() )
+   if ( mStages[stageNum].getDiffuseAtlas().isValid() )
+      fd.features.addFeature( MFT_DiffuseMapAtlas );
+   else if ( !mMaterial->mCellLayout[stageNum].isZero() )
    {
       fd.features.addFeature( MFT_DiffuseMapAtlas );
 
@@ -464,10 +467,18 @@ void ProcessedShaderMaterial::_determineFeatures(  U32 stageNum,
 
    // If we have a diffuse map and the alpha on the diffuse isn't
    // zero and the color isn't pure white then multiply the color.
-   else if (   mMaterial->mDiffuse[stageNum].alpha > 0.0f && 
-               mMaterial->mDiffuse[stageNum] != LinearColorF::WHITE )
+   //
+   // When sharing shaders we always multiply and pass white for
+   // the colors which would otherwise have skipped the feature.
+   else if (   MATMGR->useUberShaders() ||
+               (  mMaterial->mDiffuse[stageNum].alpha > 0.0f && 
+                  mMaterial->mDiffuse[stageNum] != LinearColorF::WHITE ) )
       fd.features.addFeature( MFT_DiffuseColor );
 
+   // An identity texture matrix is as good as no animation.
+   if ( MATMGR->useUberShaders() && fd.features[MFT_DiffuseMap] )
+      fd.features.addFeature( MFT_TexAnim );
+
    // If lightmaps or tonemaps are enabled or we 
    // don't have a second UV set then we cannot 
    // use the overlay texture.
@@ -789,6 +800,18 @@ bool ProcessedShaderMaterial::setupPass( SceneRenderState *state, const SceneDat
    return true;
 }
 
+/// Returns a rough guess of the on screen size in pixels of the
+/// textures on the object being rendered for texture streaming.
+static U32 _getStreamingDemand( SceneRenderState *state, const SceneData &sgData )
+{
+   // Shadow and other passes don't need the detail.
+   if ( !state || !sgData.objTrans || ( !state->isDiffusePass() && !state->isReflectPass() ) )
+      return 0;
+
+   const F32 dist = ( sgData.objTrans->getPosition() - state->getDiffuseCameraPosition() ).len();
+   return U32( getMax( state->projectRadius( dist, GFXTextureManager::getStreamingWorldSize() ), 1.0f ) );
+}
+
 void ProcessedShaderMaterial::setTextureStages( SceneRenderState *state, const SceneData &sgData, U32 pass )
 {
    PROFILE_SCOPE( ProcessedShaderMaterial_SetTextureStages );
@@ -805,6 +828,7 @@ void ProcessedShaderMaterial::setTextureStages( SceneRenderState *state, const S
    GFXShaderConstBuffer* shaderConsts = _getShaderConstBuffer(pass);
    NamedTexTarget *texTarget;
    GFXTextureObject *texObject; 
+   U32 streamingDemand = U32_MAX;
 
    for( U32 i=0; i<rpd->mNumTex; i++ )
    {
@@ -817,7 +841,14 @@ void ProcessedShaderMaterial::setTextureStages( SceneRenderState *state, const S
          // a regular texture to set... nothing special.
          case 0:
          default:
-            GFX->setTexture(i, rpd->mTexSlot[i].texObject);
+            texObject = rpd->mTexSlot[i].texObject;
+            if ( texObject && texObject->isStreaming() )
+            {
+               if ( streamingDemand == U32_MAX )
+                  streamingDemand = _getStreamingDemand( state, sgData );
+               texObject->requestStreamingSize( streamingDemand );
+            }
+            GFX->setTexture(i, texObject);
             break;
 
          case Material::NormalizeCube:
@@ -1138,11 +1169,24 @@ void ProcessedShaderMaterial::_setShaderConstants(SceneRenderState * state, cons
    shaderConsts->setSafe( handles->mImposterLimits, mMaterial->mImposterLimits );
 
    // Diffuse
-   shaderConsts->setSafe(handles->mDiffuseColorSC, mMaterial->mDiffuse[stageNum]);
+   if ( handles->mDiffuseColorSC->isValid() )
+   {
+      // A diffuse color without alpha is skipped over a diffuse
+      // map unless shaders are shared, so make the multiply a nop.
+      if (  mMaterial->mDiffuse[stageNum].alpha <= 0.0f &&
+            _getRPD( pass )->mFeatureData.features[MFT_DiffuseMap] )
+         shaderConsts->set( handles->mDiffuseColorSC, LinearColorF::WHITE );
+      else
+         shaderConsts->set( handles->mDiffuseColorSC, mMaterial->mDiffuse[stageNum] );
+   }
 
    shaderConsts->setSafe( handles->mAlphaTestValueSC, mClampF( (F32)mMaterial->mAlphaRef / 255.0f, 0.0f, 1.0f ) );      
 
-   if(handles->mDiffuseAtlasParamsSC)
+   const GFXAtlasEntry &diffuseAtlas = mStages[stageNum].getDiffuseAtlas();
+
+   if(handles->mDiffuseAtlasParamsSC && diffuseAtlas.isValid())
+      shaderConsts->setSafe(handles->mDiffuseAtlasParamsSC, diffuseAtlas.getAtlasParams());
+   else if(handles->mDiffuseAtlasParamsSC)
    {
       Point4F atlasParams(1.0f / mMaterial->mCellLayout[stageNum].x, // 1 / num_horizontal
          1.0f / mMaterial->mCellLayout[stageNum].y, // 1 / num_vertical
@@ -1160,7 +1204,9 @@ void ProcessedShaderMaterial::_setShaderConstants(SceneRenderState * state, cons
       shaderConsts->setSafe(handles->mBumpAtlasParamsSC, atlasParams);
    }
 
-   if(handles->mDiffuseAtlasTileSC)
+   if(handles->mDiffuseAtlasTileSC && diffuseAtlas.isValid())
+      shaderConsts->setSafe(handles->mDiffuseAtlasTileSC, diffuseAtlas.getTileParams());
+   else if(handles->mDiffuseAtlasTileSC)
    {
       // Sanity check the wrap flags
       //AssertWarn(mMaterial->mTextureAddressModeU == mMaterial->mTextureAddressModeV, "Addresing mode mismatch, texture atlasing will be confused");
@@ -71,6 +71,63 @@ extern void (*m_point3F_bulk_dot_indexed)(const F32* refVector,
                                           const U32* pointIndices,
                                           F32*       output);
 
+/// @name Bulk kernels
+/// These process whole arrays per call so that the SIMD versions can work on
+/// several elements at once.  Strides are in bytes.
+/// @{
+
+/// Transform numPoints points by the 4x4 matrix m.  result may alias points.
+extern void (*m_matF_x_point3F_bulk)(const F32* m,
+                                     const F32* points,
+                                     const U32  numPoints,
+                                     const U32  pointStride,
+                                     F32*       result,
+                                     const U32  resultStride);
+/// Transform numVectors vectors by the upper 3x3 of the matrix m.  result may
+/// alias vectors.
+extern void (*m_matF_x_vectorF_bulk)(const F32* m,
+                                     const F32* vectors,
+                                     const U32  numVectors,
+                                     const U32  vectorStride,
+                                     F32*       result,
+                                     const U32  resultStride);
+/// mresult[i] = a[i] * b[i] for count tightly packed matrices.
+extern void (*m_matF_x_matF_bulk)(const F32* a,
+                                  const F32* b,
+                                  const U32  count,
+                                  F32*       mresult);
+/// mresult[i] = a[aIndices[i]] * b[i] for count tightly packed matrices.
+extern void (*m_matF_x_matF_bulk_indexed)(const F32* a,
+                                          const S32* aIndices,
+                                          const F32* b,
+                                          const U32  count,
+                                          F32*       mresult);
+/// Normalized lerp of count quaternions along the shortest arc, matching
+/// TSTransform::interpolate().  result may alias from or to.
+extern void (*m_quatF_interpolate_bulk)(const F32* from,
+                                        const F32* to,
+                                        const F32  factor,
+                                        const U32  count,
+                                        F32*       result);
+/// Set culled[i] to 1 if the box at boxes[i] (min xyz followed by max xyz)
+/// lies entirely behind one of the planes (xyz normal followed by d), or to 0
+/// otherwise.  Matches PlaneSet::testPotentialIntersection() == GeometryOutside.
+extern void (*m_box3F_planes_cull_bulk)(const F32* planes,
+                                        const U32  numPlanes,
+                                        const F32* boxes,
+                                        const U32  numBoxes,
+                                        const U32  boxStride,
+                                        U8*        culled);
+/// Same test as m_box3F_planes_cull_bulk for boxes stored as six component
+/// arrays (min x, y, z followed by max x, y, z).  Sets bit i of visibleMask
+/// if box i is not culled; visibleMask must hold (numBoxes + 31) / 32 words.
+extern void (*m_box3F_planes_cull_soa)(const F32*       planes,
+                                       const U32        numPlanes,
+                                       const F32* const bounds[6],
+                                       const U32        numBoxes,
+                                       U32*             visibleMask);
+/// @}
+
 extern void (*m_quatF_set_matF)( F32 x, F32 y, F32 z, F32 w, F32* m );
 
 extern void (*m_matF_set_euler)(const F32 *e, F32 *result);
@@ -374,6 +374,259 @@ void SSE_MatrixF_x_MatrixF_Aligned(const F32 *matA, const F32 *matB, F32 *result
 
 #endif
 
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+#define ADD_SSE_BULK_FN
+#include <xmmintrin.h>
+
+extern void m_quatF_interpolate_bulk_C(const F32* from, const F32* to, const F32 factor, const U32 count, F32* result);
+extern void m_box3F_planes_cull_bulk_C(const F32* planes, const U32 numPlanes, const F32* boxes, const U32 numBoxes, const U32 boxStride, U8* culled);
+
+/// Store the xyz lanes of v.
+static inline void SSE_StorePoint3(F32* dst, const __m128 v)
+{
+   _mm_storel_pi((__m64*)dst, v);
+   _mm_store_ss(dst + 2, _mm_movehl_ps(v, v));
+}
+
+void SSE_MatrixF_x_Point3F_Bulk(const F32* m, const F32* points, const U32 numPoints, const U32 pointStride, F32* result, const U32 resultStride)
+{
+   // Keep the matrix columns in registers for the whole batch.
+   const __m128 c0 = _mm_setr_ps(m[0], m[4], m[8],  0.0f);
+   const __m128 c1 = _mm_setr_ps(m[1], m[5], m[9],  0.0f);
+   const __m128 c2 = _mm_setr_ps(m[2], m[6], m[10], 0.0f);
+   const __m128 c3 = _mm_setr_ps(m[3], m[7], m[11], 0.0f);
+
+   for (U32 i = 0; i < numPoints; i++)
+   {
+      const F32* p = (const F32*)(((const U8*)points) + (pointStride * i));
+      __m128 r = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p[0])), _mm_mul_ps(c1, _mm_set1_ps(p[1])));
+      r = _mm_add_ps(r, _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p[2])), c3));
+      SSE_StorePoint3((F32*)(((U8*)result) + (resultStride * i)), r);
+   }
+}
+
+void SSE_MatrixF_x_VectorF_Bulk(const F32* m, const F32* vectors, const U32 numVectors, const U32 vectorStride, F32* result, const U32 resultStride)
+{
+   const __m128 c0 = _mm_setr_ps(m[0], m[4], m[8],  0.0f);
+   const __m128 c1 = _mm_setr_ps(m[1], m[5], m[9],  0.0f);
+   const __m128 c2 = _mm_setr_ps(m[2], m[6], m[10], 0.0f);
+
+   for (U32 i = 0; i < numVectors; i++)
+   {
+      const F32* v = (const F32*)(((const U8*)vectors) + (vectorStride * i));
+      __m128 r = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(v[0])), _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+      r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+      SSE_StorePoint3((F32*)(((U8*)result) + (resultStride * i)), r);
+   }
+}
+
+static inline void SSE_MatrixF_x_MatrixF_Intrin(const F32* a, const F32* b, F32* mresult)
+{
+   const __m128 b0 = _mm_loadu_ps(b);
+   const __m128 b1 = _mm_loadu_ps(b + 4);
+   const __m128 b2 = _mm_loadu_ps(b + 8);
+   const __m128 b3 = _mm_loadu_ps(b + 12);
+
+   for (U32 row = 0; row < 4; row++, a += 4, mresult += 4)
+   {
+      __m128 r = _mm_mul_ps(_mm_set1_ps(a[0]), b0);
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[1]), b1));
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[2]), b2));
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[3]), b3));
+      _mm_storeu_ps(mresult, r);
+   }
+}
+
+void SSE_MatrixF_x_MatrixF_Bulk(const F32* a, const F32* b, const U32 count, F32* mresult)
+{
+   for (U32 i = 0; i < count; i++)
+      SSE_MatrixF_x_MatrixF_Intrin(a + 16 * i, b + 16 * i, mresult + 16 * i);
+}
+
+void SSE_MatrixF_x_MatrixF_Bulk_Indexed(const F32* a, const S32* aIndices, const F32* b, const U32 count, F32* mresult)
+{
+   for (U32 i = 0; i < count; i++)
+      SSE_MatrixF_x_MatrixF_Intrin(a + 16 * aIndices[i], b + 16 * i, mresult + 16 * i);
+}
+
+void SSE_QuatF_Interpolate_Bulk(const F32* from, const F32* to, const F32 factor, const U32 count, F32* result)
+{
+   const __m128 vt = _mm_set1_ps(factor);
+   const __m128 signBit = _mm_set1_ps(-0.0f);
+   const __m128 zero = _mm_setzero_ps();
+
+   // The two halves of the renormalization polynomial of TSTransform::interpolate().
+   const __m128 split = _mm_set1_ps(0.857f);
+   const __m128 a2 = _mm_set1_ps(0.699368f), a1 = _mm_set1_ps(-1.819985f), a0 = _mm_set1_ps(2.126369f);
+   const __m128 b2 = _mm_set1_ps(0.454012f), b1 = _mm_set1_ps(-1.403517f), b0 = _mm_set1_ps(1.949542f);
+
+   U32 i = 0;
+   for (; i + 4 <= count; i += 4)
+   {
+      // Four quaternions at a time, one component per register.
+      __m128 x1 = _mm_loadu_ps(from + 4 * i);
+      __m128 y1 = _mm_loadu_ps(from + 4 * i + 4);
+      __m128 z1 = _mm_loadu_ps(from + 4 * i + 8);
+      __m128 w1 = _mm_loadu_ps(from + 4 * i + 12);
+      _MM_TRANSPOSE4_PS(x1, y1, z1, w1);
+
+      __m128 x2 = _mm_loadu_ps(to + 4 * i);
+      __m128 y2 = _mm_loadu_ps(to + 4 * i + 4);
+      __m128 z2 = _mm_loadu_ps(to + 4 * i + 8);
+      __m128 w2 = _mm_loadu_ps(to + 4 * i + 12);
+      _MM_TRANSPOSE4_PS(x2, y2, z2, w2);
+
+      // Flip the first quaternion where the two are more than 90 degrees apart.
+      const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x1, x2), _mm_mul_ps(y1, y2)),
+                                    _mm_add_ps(_mm_mul_ps(z1, z2), _mm_mul_ps(w1, w2)));
+      const __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, zero), signBit);
+      x1 = _mm_xor_ps(x1, flip);
+      y1 = _mm_xor_ps(y1, flip);
+      z1 = _mm_xor_ps(z1, flip);
+      w1 = _mm_xor_ps(w1, flip);
+
+      __m128 x = _mm_add_ps(x1, _mm_mul_ps(vt, _mm_sub_ps(x2, x1)));
+      __m128 y = _mm_add_ps(y1, _mm_mul_ps(vt, _mm_sub_ps(y2, y1)));
+      __m128 z = _mm_add_ps(z1, _mm_mul_ps(vt, _mm_sub_ps(z2, z1)));
+      __m128 w = _mm_add_ps(w1, _mm_mul_ps(vt, _mm_sub_ps(w2, w1)));
+
+      // Renormalize.
+      const __m128 dist2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                                      _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+      const __m128 la = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(a2, dist2), a1), dist2), a0);
+      const __m128 lb = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(b2, dist2), b1), dist2), b0);
+      const __m128 useA = _mm_cmplt_ps(dist2, split);
+      const __m128 oneOverL = _mm_or_ps(_mm_and_ps(useA, la), _mm_andnot_ps(useA, lb));
+
+      x = _mm_mul_ps(x, oneOverL);
+      y = _mm_mul_ps(y, oneOverL);
+      z = _mm_mul_ps(z, oneOverL);
+      w = _mm_mul_ps(w, oneOverL);
+
+      _MM_TRANSPOSE4_PS(x, y, z, w);
+      _mm_storeu_ps(result + 4 * i,      x);
+      _mm_storeu_ps(result + 4 * i + 4,  y);
+      _mm_storeu_ps(result + 4 * i + 8,  z);
+      _mm_storeu_ps(result + 4 * i + 12, w);
+   }
+
+   if (i < count)
+      m_quatF_interpolate_bulk_C(from + 4 * i, to + 4 * i, factor, count - i, result + 4 * i);
+}
+
+void SSE_Box3F_Planes_Cull_Bulk(const F32* planes, const U32 numPlanes, const F32* boxes, const U32 numBoxes, const U32 boxStride, U8* culled)
+{
+   enum { MaxPlaneGroups = 8 };
+
+   const U32 numGroups = (numPlanes + 3) / 4;
+   if (numGroups > MaxPlaneGroups)
+   {
+      m_box3F_planes_cull_bulk_C(planes, numPlanes, boxes, numBoxes, boxStride, culled);
+      return;
+   }
+
+   // Transpose the planes into groups of four.  Unused lanes get a plane that
+   // never culls anything.
+   __m128 nx[MaxPlaneGroups], ny[MaxPlaneGroups], nz[MaxPlaneGroups], nd[MaxPlaneGroups];
+   __m128 posX[MaxPlaneGroups], posY[MaxPlaneGroups], posZ[MaxPlaneGroups];
+   for (U32 g = 0; g < numGroups; g++)
+   {
+      F32 lanes[4][4];
+      for (U32 k = 0; k < 4; k++)
+      {
+         const U32 j = g * 4 + k;
+         const F32* plane = planes + 4 * j;
+         lanes[0][k] = (j < numPlanes) ? plane[0] : 0.0f;
+         lanes[1][k] = (j < numPlanes) ? plane[1] : 0.0f;
+         lanes[2][k] = (j < numPlanes) ? plane[2] : 0.0f;
+         lanes[3][k] = (j < numPlanes) ? plane[3] : 1.0f;
+      }
+
+      nx[g] = _mm_loadu_ps(lanes[0]);
+      ny[g] = _mm_loadu_ps(lanes[1]);
+      nz[g] = _mm_loadu_ps(lanes[2]);
+      nd[g] = _mm_loadu_ps(lanes[3]);
+      posX[g] = _mm_cmpgt_ps(nx[g], _mm_setzero_ps());
+      posY[g] = _mm_cmpgt_ps(ny[g], _mm_setzero_ps());
+      posZ[g] = _mm_cmpgt_ps(nz[g], _mm_setzero_ps());
+   }
+
+   const __m128 epsilon = _mm_set1_ps(-0.005f);
+
+   for (U32 i = 0; i < numBoxes; i++)
+   {
+      const F32* box = (const F32*)(((const U8*)boxes) + (boxStride * i));
+      const __m128 minX = _mm_set1_ps(box[0]), minY = _mm_set1_ps(box[1]), minZ = _mm_set1_ps(box[2]);
+      const __m128 maxX = _mm_set1_ps(box[3]), maxY = _mm_set1_ps(box[4]), maxZ = _mm_set1_ps(box[5]);
+
+      U8 isCulled = 0;
+      for (U32 g = 0; g < numGroups && !isCulled; g++)
+      {
+         // Box corner furthest along each plane normal.
+         const __m128 px = _mm_or_ps(_mm_and_ps(posX[g], maxX), _mm_andnot_ps(posX[g], minX));
+         const __m128 py = _mm_or_ps(_mm_and_ps(posY[g], maxY), _mm_andnot_ps(posY[g], minY));
+         const __m128 pz = _mm_or_ps(_mm_and_ps(posZ[g], maxZ), _mm_andnot_ps(posZ[g], minZ));
+
+         __m128 dist = _mm_add_ps(_mm_mul_ps(nx[g], px), _mm_mul_ps(ny[g], py));
+         dist = _mm_add_ps(dist, _mm_add_ps(_mm_mul_ps(nz[g], pz), nd[g]));
+         isCulled = _mm_movemask_ps(_mm_cmple_ps(dist, epsilon)) != 0;
+      }
+
+      culled[i] = isCulled;
+   }
+}
+
+void SSE_Box3F_Planes_Cull_SoA(const F32* planes, const U32 numPlanes, const F32* const bounds[6], const U32 numBoxes, U32* visibleMask)
+{
+   for (U32 w = 0; w < (numBoxes + 31) / 32; w++)
+      visibleMask[w] = 0;
+
+   const __m128 epsilon = _mm_set1_ps(-0.005f);
+
+   // Four boxes at a time against one plane at a time.  The plane normal
+   // picks the same corner for all four boxes.
+   U32 i = 0;
+   for (; i + 4 <= numBoxes; i += 4)
+   {
+      const __m128 minX = _mm_loadu_ps(bounds[0] + i), minY = _mm_loadu_ps(bounds[1] + i), minZ = _mm_loadu_ps(bounds[2] + i);
+      const __m128 maxX = _mm_loadu_ps(bounds[3] + i), maxY = _mm_loadu_ps(bounds[4] + i), maxZ = _mm_loadu_ps(bounds[5] + i);
+
+      __m128 culled = _mm_setzero_ps();
+      for (U32 j = 0; j < numPlanes; j++)
+      {
+         const F32* plane = planes + 4 * j;
+         const __m128 px = (plane[0] > 0.0f) ? maxX : minX;
+         const __m128 py = (plane[1] > 0.0f) ? maxY : minY;
+         const __m128 pz = (plane[2] > 0.0f) ? maxZ : minZ;
+
+         __m128 dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane[0]), px), _mm_mul_ps(_mm_set1_ps(plane[1]), py));
+         dist = _mm_add_ps(dist, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane[2]), pz), _mm_set1_ps(plane[3])));
+         culled = _mm_or_ps(culled, _mm_cmple_ps(dist, epsilon));
+      }
+
+      // i is a multiple of four so the four bits never straddle two words.
+      visibleMask[i >> 5] |= (U32)(~_mm_movemask_ps(culled) & 0xF) << (i & 31);
+   }
+
+   for (; i < numBoxes; i++)
+   {
+      bool isCulled = false;
+      for (U32 j = 0; j < numPlanes && !isCulled; j++)
+      {
+         const F32* plane = planes + 4 * j;
+         const F32 px = (plane[0] > 0.0f) ? bounds[3][i] : bounds[0][i];
+         const F32 py = (plane[1] > 0.0f) ? bounds[4][i] : bounds[1][i];
+         const F32 pz = (plane[2] > 0.0f) ? bounds[5][i] : bounds[2][i];
+         isCulled = (plane[0]*px + plane[1]*py + plane[2]*pz + plane[3] <= -0.005f);
+      }
+
+      if (!isCulled)
+         visibleMask[i >> 5] |= 1 << (i & 31);
+   }
+}
+
+#endif
+
 void mInstall_Library_SSE()
 {
 #if defined(ADD_SSE_FN)
@@ -382,4 +635,14 @@ void mInstall_Library_SSE()
    // m_matF_x_point3F = Athlon_MatrixF_x_Point3F;
    // m_matF_x_vectorF = Athlon_MatrixF_x_VectorF;
 #endif
+
+#if defined(ADD_SSE_BULK_FN)
+   m_matF_x_point3F_bulk      = SSE_MatrixF_x_Point3F_Bulk;
+   m_matF_x_vectorF_bulk      = SSE_MatrixF_x_VectorF_Bulk;
+   m_matF_x_matF_bulk         = SSE_MatrixF_x_MatrixF_Bulk;
+   m_matF_x_matF_bulk_indexed = SSE_MatrixF_x_MatrixF_Bulk_Indexed;
+   m_quatF_interpolate_bulk   = SSE_QuatF_Interpolate_Bulk;
+   m_box3F_planes_cull_bulk   = SSE_Box3F_Planes_Cull_Bulk;
+   m_box3F_planes_cull_soa    = SSE_Box3F_Planes_Cull_SoA;
+#endif
 }
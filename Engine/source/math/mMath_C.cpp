@@ -850,6 +850,145 @@ void m_point3F_bulk_dot_indexed_C(const F32* refVector,
    }
 }
 
+//------------------------------------------------------------------------------
+// Bulk kernels
+
+void m_matF_x_point3F_bulk_C(const F32* m,
+                             const F32* points,
+                             const U32  numPoints,
+                             const U32  pointStride,
+                             F32*       result,
+                             const U32  resultStride)
+{
+   for (U32 i = 0; i < numPoints; i++)
+   {
+      const F32* p = (const F32*)(((const U8*)points) + (pointStride * i));
+      F32* r = (F32*)(((U8*)result) + (resultStride * i));
+      const F32 p0 = p[0], p1 = p[1], p2 = p[2];
+      r[0] = m[0]*p0 + m[1]*p1 + m[2]*p2  + m[3];
+      r[1] = m[4]*p0 + m[5]*p1 + m[6]*p2  + m[7];
+      r[2] = m[8]*p0 + m[9]*p1 + m[10]*p2 + m[11];
+   }
+}
+
+void m_matF_x_vectorF_bulk_C(const F32* m,
+                             const F32* vectors,
+                             const U32  numVectors,
+                             const U32  vectorStride,
+                             F32*       result,
+                             const U32  resultStride)
+{
+   for (U32 i = 0; i < numVectors; i++)
+   {
+      const F32* v = (const F32*)(((const U8*)vectors) + (vectorStride * i));
+      F32* r = (F32*)(((U8*)result) + (resultStride * i));
+      const F32 v0 = v[0], v1 = v[1], v2 = v[2];
+      r[0] = m[0]*v0 + m[1]*v1 + m[2]*v2;
+      r[1] = m[4]*v0 + m[5]*v1 + m[6]*v2;
+      r[2] = m[8]*v0 + m[9]*v1 + m[10]*v2;
+   }
+}
+
+void m_matF_x_matF_bulk_C(const F32* a, const F32* b, const U32 count, F32* mresult)
+{
+   for (U32 i = 0; i < count; i++)
+      default_matF_x_matF_C(a + 16 * i, b + 16 * i, mresult + 16 * i);
+}
+
+void m_matF_x_matF_bulk_indexed_C(const F32* a, const S32* aIndices, const F32* b, const U32 count, F32* mresult)
+{
+   for (U32 i = 0; i < count; i++)
+      default_matF_x_matF_C(a + 16 * aIndices[i], b + 16 * i, mresult + 16 * i);
+}
+
+void m_quatF_interpolate_bulk_C(const F32* from, const F32* to, const F32 factor, const U32 count, F32* result)
+{
+   for (U32 i = 0; i < count; i++, from += 4, to += 4, result += 4)
+   {
+      F32 x1 = from[0], y1 = from[1], z1 = from[2], w1 = from[3];
+      const F32 x2 = to[0], y2 = to[1], z2 = to[2], w2 = to[3];
+
+      // Flip the first quaternion if the two are more than 90 degrees apart.
+      if (x1*x2 + y1*y2 + z1*z2 + w1*w2 < 0.0f)
+      {
+         x1 = -x1;
+         y1 = -y1;
+         z1 = -z1;
+         w1 = -w1;
+      }
+
+      x1 += factor * (x2 - x1);
+      y1 += factor * (y2 - y1);
+      z1 += factor * (z2 - z1);
+      w1 += factor * (w2 - w1);
+
+      // Same polynomial 1/sqrt approximation as TSTransform::interpolate().
+      const F32 dist2 = x1*x1 + y1*y1 + z1*z1 + w1*w1;
+      const F32 oneOverL = (dist2 < 0.857f) ?
+         (((0.699368f)*dist2) + -1.819985f)*dist2 + 2.126369f :
+         (((0.454012f)*dist2) + -1.403517f)*dist2 + 1.949542f;
+
+      result[0] = x1 * oneOverL;
+      result[1] = y1 * oneOverL;
+      result[2] = z1 * oneOverL;
+      result[3] = w1 * oneOverL;
+   }
+}
+
+void m_box3F_planes_cull_bulk_C(const F32* planes,
+                                const U32  numPlanes,
+                                const F32* boxes,
+                                const U32  numBoxes,
+                                const U32  boxStride,
+                                U8*        culled)
+{
+   for (U32 i = 0; i < numBoxes; i++)
+   {
+      const F32* box = (const F32*)(((const U8*)boxes) + (boxStride * i));
+      culled[i] = 0;
+
+      for (U32 j = 0; j < numPlanes; j++)
+      {
+         // Only the box corner furthest along the plane normal needs testing.
+         const F32* plane = planes + 4 * j;
+         const F32 px = (plane[0] > 0.0f) ? box[3] : box[0];
+         const F32 py = (plane[1] > 0.0f) ? box[4] : box[1];
+         const F32 pz = (plane[2] > 0.0f) ? box[5] : box[2];
+         if (plane[0]*px + plane[1]*py + plane[2]*pz + plane[3] <= -0.005f)
+         {
+            culled[i] = 1;
+            break;
+         }
+      }
+   }
+}
+
+void m_box3F_planes_cull_soa_C(const F32*       planes,
+                               const U32        numPlanes,
+                               const F32* const bounds[6],
+                               const U32        numBoxes,
+                               U32*             visibleMask)
+{
+   for (U32 w = 0; w < (numBoxes + 31) / 32; w++)
+      visibleMask[w] = 0;
+
+   for (U32 i = 0; i < numBoxes; i++)
+   {
+      bool isCulled = false;
+      for (U32 j = 0; j < numPlanes && !isCulled; j++)
+      {
+         const F32* plane = planes + 4 * j;
+         const F32 px = (plane[0] > 0.0f) ? bounds[3][i] : bounds[0][i];
+         const F32 py = (plane[1] > 0.0f) ? bounds[4][i] : bounds[1][i];
+         const F32 pz = (plane[2] > 0.0f) ? bounds[5][i] : bounds[2][i];
+         isCulled = (plane[0]*px + plane[1]*py + plane[2]*pz + plane[3] <= -0.005f);
+      }
+
+      if (!isCulled)
+         visibleMask[i >> 5] |= 1 << (i & 31);
+   }
+}
+
 //------------------------------------------------------------------------------
 // Math function pointer declarations
 
@@ -885,6 +1024,33 @@ void (*m_point3F_bulk_dot_indexed)(const F32* refVector,
                                    const U32* pointIndices,
                                    F32*       output) = m_point3F_bulk_dot_indexed_C;
 
+void (*m_matF_x_point3F_bulk)(const F32* m,
+                              const F32* points,
+                              const U32  numPoints,
+                              const U32  pointStride,
+                              F32*       result,
+                              const U32  resultStride) = m_matF_x_point3F_bulk_C;
+void (*m_matF_x_vectorF_bulk)(const F32* m,
+                              const F32* vectors,
+                              const U32  numVectors,
+                              const U32  vectorStride,
+                              F32*       result,
+                              const U32  resultStride) = m_matF_x_vectorF_bulk_C;
+void (*m_matF_x_matF_bulk)(const F32* a, const F32* b, const U32 count, F32* mresult) = m_matF_x_matF_bulk_C;
+void (*m_matF_x_matF_bulk_indexed)(const F32* a, const S32* aIndices, const F32* b, const U32 count, F32* mresult) = m_matF_x_matF_bulk_indexed_C;
+void (*m_quatF_interpolate_bulk)(const F32* from, const F32* to, const F32 factor, const U32 count, F32* result) = m_quatF_interpolate_bulk_C;
+void (*m_box3F_planes_cull_bulk)(const F32* planes,
+                                 const U32  numPlanes,
+                                 const F32* boxes,
+                                 const U32  numBoxes,
+                                 const U32  boxStride,
+                                 U8*        culled) = m_box3F_planes_cull_bulk_C;
+void (*m_box3F_planes_cull_soa)(const F32*       planes,
+                                const U32        numPlanes,
+                                const F32* const bounds[6],
+                                const U32        numBoxes,
+                                U32*             visibleMask) = m_box3F_planes_cull_soa_C;
+
 void (*m_quatF_set_matF)( F32 x, F32 y, F32 z, F32 w, F32* m ) = m_quatF_set_matF_C;
 
 void (*m_matF_set_euler)(const F32 *e, F32 *result) = m_matF_set_euler_C;
@@ -930,6 +1096,14 @@ void mInstallLibrary_C()
    m_point3F_bulk_dot      = m_point3F_bulk_dot_C;
    m_point3F_bulk_dot_indexed = m_point3F_bulk_dot_indexed_C;
 
+   m_matF_x_point3F_bulk   = m_matF_x_point3F_bulk_C;
+   m_matF_x_vectorF_bulk   = m_matF_x_vectorF_bulk_C;
+   m_matF_x_matF_bulk      = m_matF_x_matF_bulk_C;
+   m_matF_x_matF_bulk_indexed = m_matF_x_matF_bulk_indexed_C;
+   m_quatF_interpolate_bulk = m_quatF_interpolate_bulk_C;
+   m_box3F_planes_cull_bulk = m_box3F_planes_cull_bulk_C;
+   m_box3F_planes_cull_soa  = m_box3F_planes_cull_soa_C;
+
    m_quatF_set_matF        = m_quatF_set_matF_C;
 
    m_matF_set_euler        = m_matF_set_euler_C;
@@ -31,6 +31,10 @@
 #include "core/tAlgorithm.h"
 #include "gfx/gfxDevice.h"
 
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+#include <emmintrin.h>
+#endif
+
 namespace MathUtils
 {
 
@@ -1916,4 +1920,92 @@ void mBuildHull2D(const Vector<Point2F> _inPoints, Vector<Point2F> &hullPoints)
    hullPoints.setSize( lowerHullIdx + upperHullIdx );
 }
 
+//-----------------------------------------------------------------------------
+
+S32 findSupportPoint( const VectorF& direction, const Point3F* points, U32 numPoints, U32 stride, F32* outDot )
+{
+   if( !numPoints )
+      return -1;
+
+   const U8* base = reinterpret_cast< const U8* >( points );
+   #define POINT( index ) ( *reinterpret_cast< const Point3F* >( base + stride * ( index ) ) )
+
+   S32 bestIndex = 0;
+   F32 bestDot = mDot( POINT( 0 ), direction );
+   U32 i = 1;
+
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+
+   // Four points at a time.  Every lane keeps the first index of its own
+   // maximum so that reducing the lanes yields the same point as the scalar
+   // loop below.  Dots are summed in the same order as mDot() for the same
+   // reason.
+
+   if( numPoints >= 9 )
+   {
+      const __m128 dx = _mm_set1_ps( direction.x );
+      const __m128 dy = _mm_set1_ps( direction.y );
+      const __m128 dz = _mm_set1_ps( direction.z );
+      const __m128i four = _mm_set1_epi32( 4 );
+
+      __m128 laneDot = _mm_set1_ps( bestDot );
+      __m128i laneIndex = _mm_setzero_si128();
+      __m128i index = _mm_setr_epi32( 1, 2, 3, 4 );
+
+      for( ; i + 4 <= numPoints; i += 4 )
+      {
+         const Point3F& p0 = POINT( i );
+         const Point3F& p1 = POINT( i + 1 );
+         const Point3F& p2 = POINT( i + 2 );
+         const Point3F& p3 = POINT( i + 3 );
+
+         const __m128 x = _mm_setr_ps( p0.x, p1.x, p2.x, p3.x );
+         const __m128 y = _mm_setr_ps( p0.y, p1.y, p2.y, p3.y );
+         const __m128 z = _mm_setr_ps( p0.z, p1.z, p2.z, p3.z );
+
+         const __m128 dot = _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, dx ), _mm_mul_ps( y, dy ) ), _mm_mul_ps( z, dz ) );
+         const __m128 greater = _mm_cmpgt_ps( dot, laneDot );
+
+         laneDot = _mm_or_ps( _mm_and_ps( greater, dot ), _mm_andnot_ps( greater, laneDot ) );
+
+         const __m128i greaterInt = _mm_castps_si128( greater );
+         laneIndex = _mm_or_si128( _mm_and_si128( greaterInt, index ), _mm_andnot_si128( greaterInt, laneIndex ) );
+         index = _mm_add_epi32( index, four );
+      }
+
+      F32 dots[ 4 ];
+      S32 indices[ 4 ];
+      _mm_storeu_ps( dots, laneDot );
+      _mm_storeu_si128( reinterpret_cast< __m128i* >( indices ), laneIndex );
+
+      for( U32 lane = 0; lane < 4; ++ lane )
+      {
+         if( dots[ lane ] > bestDot || ( dots[ lane ] == bestDot && indices[ lane ] < bestIndex ) )
+         {
+            bestDot = dots[ lane ];
+            bestIndex = indices[ lane ];
+         }
+      }
+   }
+
+#endif
+
+   for( ; i < numPoints; ++ i )
+   {
+      const F32 dot = mDot( POINT( i ), direction );
+      if( dot > bestDot )
+      {
+         bestDot = dot;
+         bestIndex = i;
+      }
+   }
+
+   #undef POINT
+
+   if( outDot )
+      *outDot = bestDot;
+
+   return bestIndex;
+}
+
 } // namespace MathUtils
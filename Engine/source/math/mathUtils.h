@@ -427,7 +427,20 @@ namespace MathUtils
                                      const Point3F& fromPoint,
                                      PlaneF* outPlanes );
 
-   //void findFarthestPoint( const Point3F* points, U32 numPoints, const Point3F& fromPoint, )
+   /// Find the point farthest along @a direction, i.e. the support point of the
+   /// point cloud.  This is the inner loop of support mapping for hull convexes
+   /// and is vectorized where available.
+   ///
+   /// @param direction Direction to search along.  Does not need to be normalized.
+   /// @param points First point of the cloud.
+   /// @param numPoints Number of points in the cloud.
+   /// @param stride Distance in bytes between consecutive points.
+   /// @param outDot If not NULL, receives the dot product of the support point
+   ///   with @a direction.
+   /// @return Index of the first point with the largest dot product or -1 if
+   ///   @a numPoints is zero.
+   S32 findSupportPoint( const VectorF& direction, const Point3F* points, U32 numPoints,
+                         U32 stride = sizeof( Point3F ), F32* outDot = NULL );
 
    /// Build a convex hull from a cloud of 2D points, first and last hull point are the same.
    void mBuildHull2D(const Vector<Point2F> inPoints, Vector<Point2F> &hullPoints);
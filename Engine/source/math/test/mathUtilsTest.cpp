@@ -0,0 +1,145 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "math/mathUtils.h"
+#include "math/mRandom.h"
+#include "console/console.h"
+
+/// Plain scalar support mapping as done by the convexes before
+/// MathUtils::findSupportPoint().
+static S32 referenceSupportPoint( const VectorF& direction, const Point3F* points, U32 numPoints, U32 stride )
+{
+   const U8* base = reinterpret_cast< const U8* >( points );
+
+   S32 bestIndex = 0;
+   F32 bestDot = mDot( *reinterpret_cast< const Point3F* >( base ), direction );
+   for( U32 i = 1; i < numPoints; ++ i )
+   {
+      const F32 dot = mDot( *reinterpret_cast< const Point3F* >( base + stride * i ), direction );
+      if( dot > bestDot )
+      {
+         bestDot = dot;
+         bestIndex = i;
+      }
+   }
+
+   return bestIndex;
+}
+
+static void fillPoints( MRandomLCG& random, Point3F* points, U32 numPoints )
+{
+   for( U32 i = 0; i < numPoints; ++ i )
+      points[ i ].set( random.randF( -10.0f, 10.0f ), random.randF( -10.0f, 10.0f ), random.randF( -10.0f, 10.0f ) );
+}
+
+TEST(MathUtils, FindSupportPointEmpty)
+{
+   Point3F point( 0.0f, 0.0f, 0.0f );
+   EXPECT_EQ( -1, MathUtils::findSupportPoint( VectorF( 1.0f, 0.0f, 0.0f ), &point, 0 ) );
+}
+
+TEST(MathUtils, FindSupportPointMatchesScalar)
+{
+   MRandomLCG random( 1234 );
+   Point3F points[ 64 ];
+
+   for( U32 numPoints = 1; numPoints <= 64; ++ numPoints )
+   {
+      fillPoints( random, points, numPoints );
+
+      for( U32 i = 0; i < 16; ++ i )
+      {
+         const VectorF direction( random.randF( -1.0f, 1.0f ), random.randF( -1.0f, 1.0f ), random.randF( -1.0f, 1.0f ) );
+
+         F32 dot;
+         const S32 index = MathUtils::findSupportPoint( direction, points, numPoints, sizeof( Point3F ), &dot );
+
+         EXPECT_EQ( referenceSupportPoint( direction, points, numPoints, sizeof( Point3F ) ), index )
+            << "Wrong support point for " << numPoints << " points";
+         EXPECT_EQ( mDot( points[ index ], direction ), dot );
+      }
+   }
+}
+
+TEST(MathUtils, FindSupportPointStrideAndTies)
+{
+   // Points interleaved with other vertex data like TSMesh vertices.
+   struct Vertex
+   {
+      Point3F point;
+      Point3F normal;
+   };
+
+   Vertex vertices[ 37 ];
+   for( U32 i = 0; i < 37; ++ i )
+   {
+      // Lots of duplicates so that the first of several equal points has
+      // to be picked across SIMD lanes.
+      const F32 x = F32( ( i * 7 ) % 5 );
+      vertices[ i ].point.set( x, 1.0f, -x );
+      vertices[ i ].normal.set( 100.0f, 100.0f, 100.0f );
+   }
+
+   const VectorF directions[] = { VectorF( 1.0f, 0.0f, 0.0f ), VectorF( -1.0f, 0.0f, 0.0f ),
+                                  VectorF( 0.0f, 1.0f, 0.0f ), VectorF( 1.0f, 1.0f, 1.0f ) };
+
+   for( U32 i = 0; i < sizeof( directions ) / sizeof( directions[ 0 ] ); ++ i )
+      EXPECT_EQ( referenceSupportPoint( directions[ i ], &vertices[ 0 ].point, 37, sizeof( Vertex ) ),
+                 MathUtils::findSupportPoint( directions[ i ], &vertices[ 0 ].point, 37, sizeof( Vertex ) ) );
+}
+
+// Not strictly a test; compares support mapping throughput on a hull the
+// size of a typical vehicle or rigid shape collision mesh.
+TEST(MathUtils, FindSupportPointThroughput)
+{
+   enum { NumPoints = 256, NumQueries = 200000 };
+
+   MRandomLCG random( 42 );
+   Point3F points[ NumPoints ];
+   fillPoints( random, points, NumPoints );
+
+   VectorF directions[ 64 ];
+   for( U32 i = 0; i < 64; ++ i )
+      directions[ i ].set( random.randF( -1.0f, 1.0f ), random.randF( -1.0f, 1.0f ), random.randF( -1.0f, 1.0f ) );
+
+   S32 checksum = 0;
+
+   U32 start = Platform::getRealMilliseconds();
+   for( U32 i = 0; i < NumQueries; ++ i )
+      checksum += referenceSupportPoint( directions[ i & 63 ], points, NumPoints, sizeof( Point3F ) );
+   const U32 scalarTime = Platform::getRealMilliseconds() - start;
+
+   start = Platform::getRealMilliseconds();
+   for( U32 i = 0; i < NumQueries; ++ i )
+      checksum -= MathUtils::findSupportPoint( directions[ i & 63 ], points, NumPoints );
+   const U32 simdTime = Platform::getRealMilliseconds() - start;
+
+   EXPECT_EQ( 0, checksum );
+
+   Con::printf( "findSupportPoint: %i queries on %i points in %ims (scalar: %ims)",
+      NumQueries, NumPoints, simdTime, scalarTime );
+}
+
+#endif
@@ -38,6 +38,14 @@
 #include "console/consoleTypes.h"
 #endif
 
+#ifndef _THREADPOOL_H_
+#include "platform/threads/threadPool.h"
+#endif
+
+#ifndef _FILEIO_H_
+#include "core/fileio.h"
+#endif
+
 // Script bindings.
 #include "moduleManager_ScriptBinding.h"
 
@@ -51,6 +59,50 @@ ModuleManager ModuleDatabase;
 
 //-----------------------------------------------------------------------------
 
+/// Reads a module's script and Taml files on a worker so that executing and
+/// scanning them on the main thread hits a warm file cache.
+class ModulePrefetchWorkItem : public ThreadPool::WorkItem
+{
+public:
+    ModulePrefetchWorkItem( const F32 priority ) :
+        mPriority( priority )
+    {
+    }
+
+    Vector<String> mFiles;
+
+protected:
+    virtual F32 getPriority() { return mPriority; }
+
+    virtual void execute()
+    {
+        U8 buffer[ 64 * 1024 ];
+
+        for( Vector<String>::iterator fileItr = mFiles.begin(); fileItr != mFiles.end(); ++fileItr )
+        {
+            // Finish if the manager no longer needs the files.
+            if ( isCancellationRequested() )
+                return;
+
+            File file;
+            if ( file.open( fileItr->c_str(), File::Read ) != File::Ok )
+                continue;
+
+            // Read the whole file, discarding the contents.
+            U32 bytesRead = 0;
+            while ( file.read( sizeof(buffer), (char*)buffer, &bytesRead ) == File::Ok && bytesRead == sizeof(buffer) )
+                ;
+
+            file.close();
+        }
+    }
+
+private:
+    const F32 mPriority;
+};
+
+//-----------------------------------------------------------------------------
+
 S32 QSORT_CALLBACK moduleDefinitionVersionIdSort( const void* a, const void* b )
 {
     // Fetch module definitions.
@@ -70,6 +122,7 @@ S32 QSORT_CALLBACK moduleDefinitionVersionIdSort( const void* a, const void* b )
 ModuleManager::ModuleManager() :
     mEnforceDependencies(true),
     mEchoInfo(true),
+    mPrefetchModules(true),
     mDatabaseLocks( 0 ),
     mIgnoreLoadedGroups(false)
 {
@@ -113,6 +166,7 @@ void ModuleManager::initPersistFields()
 
     addField( "EnforceDependencies", TypeBool, Offset(mEnforceDependencies, ModuleManager), "Whether the module manager enforces any dependencies on module definitions it discovers or not." );
     addField( "EchoInfo", TypeBool, Offset(mEchoInfo, ModuleManager), "Whether the module manager echos extra information to the console or not." );
+    addField( "PrefetchModules", TypeBool, Offset(mPrefetchModules, ModuleManager), "Whether the module manager reads module files on worker threads ahead of loading them or not." );
 }
 
 //-----------------------------------------------------------------------------
@@ -356,6 +410,9 @@ bool ModuleManager::loadModuleGroup( const char* pModuleGroup )
     // Add module group.
     mGroupsLoaded.push_back( moduleGroup );
 
+    // Read the module files ahead of loading them.
+    prefetchModules( moduleReadyQueue );
+
     // Reset modules loaded count.
     U32 modulesLoadedCount = 0;
 
@@ -734,6 +791,9 @@ bool ModuleManager::loadModuleExplicit( const char* pModuleId, const U32 version
         }
     }
 
+    // Read the module files ahead of loading them.
+    prefetchModules( moduleReadyQueue );
+
     // Reset modules loaded count.
     U32 modulesLoadedCount = 0;
 
@@ -2275,6 +2335,72 @@ bool ModuleManager::unregisterModule( const char* pModuleId, const U32 versionId
 
 //-----------------------------------------------------------------------------
 
+void ModuleManager::prefetchModules( typeModuleLoadEntryVector& moduleReadyQueue )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(ModuleManager_PrefetchModules);
+
+    // Finish if not prefetching.
+    if ( !mPrefetchModules )
+        return;
+
+    const U32 moduleCount = moduleReadyQueue.size();
+    U32 queuedCount = 0;
+
+    // Iterate the modules in load order.
+    for ( U32 index = 0; index < moduleCount; ++index )
+    {
+        // Fetch load ready module definition.
+        ModuleDefinition* pModuleDefinition = moduleReadyQueue[index].mpModuleDefinition;
+
+        // Skip if the module is already loaded.
+        if ( findModuleLoaded( pModuleDefinition->getModuleId() ) != NULL )
+            continue;
+
+        // Find the module files.  The file system is walked here as it interns paths into the string table.
+        Vector<Platform::FileInfo> files;
+        if ( !Platform::dumpPath( pModuleDefinition->getModulePath(), files, -1 ) )
+            continue;
+
+        // Earlier modules are loaded first so are read first.
+        ModulePrefetchWorkItem* pWorkItem = new ModulePrefetchWorkItem( F32(moduleCount - index) / F32(moduleCount) );
+
+        for ( Vector<Platform::FileInfo>::iterator fileItr = files.begin(); fileItr != files.end(); ++fileItr )
+        {
+            // Only read the files that loading the module executes or parses.
+            const char* pExtension = dStrrchr( fileItr->pFileName, '.' );
+            if ( pExtension == NULL )
+                continue;
+
+            if ( dStricmp( pExtension, ".cs" ) != 0 &&
+                 dStricmp( pExtension, ".dso" ) != 0 &&
+                 dStricmp( pExtension, ".gui" ) != 0 &&
+                 dStricmp( pExtension, ".taml" ) != 0 )
+                continue;
+
+            pWorkItem->mFiles.push_back( String::ToString( "%s/%s", fileItr->pFullPath, fileItr->pFileName ) );
+        }
+
+        // Skip if nothing to read.
+        if ( pWorkItem->mFiles.empty() )
+        {
+            delete pWorkItem;
+            continue;
+        }
+
+        ThreadPool::GLOBAL().queueWorkItem( pWorkItem );
+        queuedCount++;
+    }
+
+    // Info.
+    if ( mEchoInfo && queuedCount > 0 )
+    {
+        Con::printf( "Module Manager: Prefetching files for '%d' module(s).", queuedCount );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 void ModuleManager::raiseModulePreLoadNotifications( ModuleDefinition* pModuleDefinition )
 {
     // Raise notifications.
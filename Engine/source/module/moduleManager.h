@@ -116,6 +116,7 @@ private:
     /// Miscellaneous.
     bool                        mEnforceDependencies;
     bool                        mEchoInfo;
+    bool                        mPrefetchModules;
     S32                         mDatabaseLocks;
     char                        mModuleExtension[256];
     Taml                        mTaml;
@@ -199,6 +200,8 @@ private:
     void clearDatabase( void );
     bool removeModuleDefinition( ModuleDefinition* pModuleDefinition );
 
+    void prefetchModules( typeModuleLoadEntryVector& moduleReadyQueue );
+
     void raiseModulePreLoadNotifications( ModuleDefinition* pModuleDefinition );
     void raiseModulePostLoadNotifications( ModuleDefinition* pModuleDefinition );
     void raiseModulePreUnloadNotifications( ModuleDefinition* pModuleDefinition );
@@ -0,0 +1,337 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 Daniel Buckmaster
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "torqueRecast.h"
+#include "navCrowd.h"
+#include "navMesh.h"
+
+#include "scene/sceneObject.h"
+#include "T3D/gameBase/gameProcess.h"
+#include "platform/profiler.h"
+
+#include <DetourCrowd.h>
+#include <DetourCommon.h>
+
+/// Smallest number of agents a Detour crowd is created for.
+static const S32 MinCrowdAgents = 32;
+
+/// Agents further than this many radii from their object are re-added.
+static const F32 AgentResetRadii = 2.0f;
+
+NavCrowd::NavCrowd(NavMesh *mesh)
+{
+   mMesh = mesh;
+   mCrowd = NULL;
+   mQuery = dtAllocNavMeshQuery();
+   mNumAgents = 0;
+   mCapacity = 0;
+   mMaxAgentRadius = 0.0f;
+   mLastTick = U32_MAX;
+}
+
+NavCrowd::~NavCrowd()
+{
+   invalidate();
+   dtFreeNavMeshQuery(mQuery);
+   mQuery = NULL;
+}
+
+S32 NavCrowd::addAgent(SceneObject *object, const AgentParams &params)
+{
+   S32 handle = 0;
+   while(handle < mAgents.size() && mAgents[handle].object)
+      handle++;
+   if(handle == mAgents.size())
+      mAgents.increment();
+
+   Agent &agent = mAgents[handle];
+   agent = Agent();
+   agent.object = object;
+   agent.params = params;
+   mNumAgents++;
+
+   if(mCrowd)
+   {
+      // Recreate the crowd if it is too small for the new agent.
+      if(mNumAgents > mCapacity || params.radius > mMaxAgentRadius)
+         invalidate();
+      else
+         addToCrowd(agent);
+   }
+
+   return handle;
+}
+
+void NavCrowd::removeAgent(S32 handle)
+{
+   if(handle < 0 || handle >= mAgents.size() || !mAgents[handle].object)
+      return;
+
+   Agent &agent = mAgents[handle];
+   if(mCrowd && agent.index >= 0)
+      mCrowd->removeAgent(agent.index);
+   agent = Agent();
+   mNumAgents--;
+
+   while(mAgents.size() && !mAgents.last().object)
+      mAgents.pop_back();
+}
+
+static void buildAgentParams(const NavCrowd::AgentParams &params, U8 filterType, dtCrowdAgentParams &ap)
+{
+   dMemset(&ap, 0, sizeof(ap));
+   ap.radius = params.radius;
+   ap.height = params.height;
+   ap.maxAcceleration = params.maxAcceleration;
+   ap.maxSpeed = params.maxSpeed;
+   ap.collisionQueryRange = params.radius * 12.0f;
+   ap.pathOptimizationRange = params.radius * 30.0f;
+   ap.separationWeight = 2.0f;
+   ap.updateFlags = DT_CROWD_ANTICIPATE_TURNS | DT_CROWD_OBSTACLE_AVOIDANCE |
+      DT_CROWD_SEPARATION | DT_CROWD_OPTIMIZE_VIS | DT_CROWD_OPTIMIZE_TOPO;
+   ap.obstacleAvoidanceType = 0;
+   ap.queryFilterType = filterType;
+}
+
+void NavCrowd::setAgentParams(S32 handle, const AgentParams &params)
+{
+   if(handle < 0 || handle >= mAgents.size() || !mAgents[handle].object)
+      return;
+
+   Agent &agent = mAgents[handle];
+   if(agent.params == params)
+      return;
+   agent.params = params;
+
+   if(!mCrowd)
+      return;
+
+   if(params.radius > mMaxAgentRadius)
+      invalidate();
+   else if(agent.index >= 0)
+   {
+      dtCrowdAgentParams ap;
+      buildAgentParams(params, getFilterType(params.includeFlags), ap);
+      mCrowd->updateAgentParameters(agent.index, &ap);
+   }
+}
+
+void NavCrowd::setKinematic(S32 handle, bool kinematic)
+{
+   if(handle < 0 || handle >= mAgents.size())
+      return;
+   mAgents[handle].kinematic = kinematic;
+}
+
+void NavCrowd::setTarget(S32 handle, const Point3F &target)
+{
+   if(handle < 0 || handle >= mAgents.size() || !mAgents[handle].object)
+      return;
+
+   Agent &agent = mAgents[handle];
+   if(agent.hasTarget && agent.target == target)
+      return;
+   agent.hasTarget = true;
+   agent.target = target;
+   if(mCrowd && agent.index >= 0)
+      requestTarget(agent);
+}
+
+void NavCrowd::clearTarget(S32 handle)
+{
+   if(handle < 0 || handle >= mAgents.size() || !mAgents[handle].hasTarget)
+      return;
+
+   Agent &agent = mAgents[handle];
+   agent.hasTarget = false;
+   if(mCrowd && agent.index >= 0)
+      mCrowd->resetMoveTarget(agent.index);
+}
+
+void NavCrowd::update()
+{
+   const U32 tick = ServerProcessList::get()->getTotalTicks();
+   if(tick == mLastTick)
+      return;
+   mLastTick = tick;
+
+   if(!mNumAgents)
+      return;
+
+   PROFILE_SCOPE(NavCrowd_update);
+
+   if(!mCrowd && !init())
+      return;
+
+   // Agents moved by their own physics start from where they ended up.
+   for(U32 i = 0; i < mAgents.size(); i++)
+   {
+      Agent &agent = mAgents[i];
+      if(agent.object && agent.index >= 0 && !agent.kinematic)
+         syncAgent(agent);
+   }
+
+   mCrowd->update(TickSec, NULL);
+}
+
+bool NavCrowd::getVelocity(S32 handle, Point3F *vel) const
+{
+   if(!mCrowd || handle < 0 || handle >= mAgents.size() || mAgents[handle].index < 0)
+      return false;
+
+   const dtCrowdAgent *ag = mCrowd->getAgent(mAgents[handle].index);
+   if(!ag || !ag->active || ag->targetState != DT_CROWDAGENT_TARGET_VALID)
+      return false;
+
+   *vel = RCtoDTS(ag->vel);
+   return true;
+}
+
+bool NavCrowd::getPosition(S32 handle, Point3F *pos) const
+{
+   if(!mCrowd || handle < 0 || handle >= mAgents.size() || mAgents[handle].index < 0)
+      return false;
+
+   const dtCrowdAgent *ag = mCrowd->getAgent(mAgents[handle].index);
+   if(!ag || !ag->active || ag->state == DT_CROWDAGENT_STATE_INVALID)
+      return false;
+
+   *pos = RCtoDTS(ag->npos);
+   return true;
+}
+
+void NavCrowd::invalidate()
+{
+   if(mCrowd)
+   {
+      dtFreeCrowd(mCrowd);
+      mCrowd = NULL;
+   }
+   for(U32 i = 0; i < mAgents.size(); i++)
+      mAgents[i].index = -1;
+   mFilterFlags.clear();
+   mCapacity = 0;
+}
+
+bool NavCrowd::init()
+{
+   dtNavMesh *nm = mMesh->nm;
+   if(!nm || !nm->getMaxTiles())
+      return false;
+
+   S32 capacity = MinCrowdAgents;
+   while(capacity < mNumAgents)
+      capacity *= 2;
+
+   F32 radius = 0.0f;
+   for(U32 i = 0; i < mAgents.size(); i++)
+      if(mAgents[i].object)
+         radius = getMax(radius, mAgents[i].params.radius);
+
+   mCrowd = dtAllocCrowd();
+   if(!mCrowd || !mCrowd->init(capacity, radius, nm) ||
+      dtStatusFailed(mQuery->init(nm, 256)))
+   {
+      Con::errorf("Could not create crowd for NavMesh %s", mMesh->getIdString());
+      invalidate();
+      return false;
+   }
+
+   mCapacity = capacity;
+   mMaxAgentRadius = radius;
+
+   for(U32 i = 0; i < mAgents.size(); i++)
+      if(mAgents[i].object)
+         addToCrowd(mAgents[i]);
+
+   return true;
+}
+
+void NavCrowd::addToCrowd(Agent &agent)
+{
+   const Point3F &pos = agent.object->getPosition();
+   F32 p[] = {pos.x, pos.z, -pos.y};
+
+   dtCrowdAgentParams ap;
+   buildAgentParams(agent.params, getFilterType(agent.params.includeFlags), ap);
+   agent.index = mCrowd->addAgent(p, &ap);
+
+   if(agent.index >= 0 && agent.hasTarget)
+      requestTarget(agent);
+}
+
+void NavCrowd::syncAgent(Agent &agent)
+{
+   dtCrowdAgent *ag = mCrowd->getEditableAgent(agent.index);
+   if(!ag || !ag->active)
+      return;
+
+   // Leave agents on off-mesh links to the crowd.
+   if(ag->state == DT_CROWDAGENT_STATE_OFFMESH)
+      return;
+
+   const Point3F &pos = agent.object->getPosition();
+   F32 p[] = {pos.x, pos.z, -pos.y};
+
+   // The object got pushed, teleported or fell somewhere the corridor
+   // can't follow, so start over.
+   const F32 resetDist = agent.params.radius * AgentResetRadii;
+   if(ag->state == DT_CROWDAGENT_STATE_INVALID || dtVdist2DSqr(p, ag->npos) > resetDist * resetDist)
+   {
+      mCrowd->removeAgent(agent.index);
+      addToCrowd(agent);
+      return;
+   }
+
+   if(ag->corridor.movePosition(p, mQuery, mCrowd->getFilter(ag->params.queryFilterType)))
+      dtVcopy(ag->npos, ag->corridor.getPos());
+}
+
+void NavCrowd::requestTarget(Agent &agent)
+{
+   F32 to[] = {agent.target.x, agent.target.z, -agent.target.y};
+   F32 extx = mMesh->mWalkableRadius * 4.0f;
+   F32 extents[] = {extx, mMesh->mWalkableHeight, extx};
+
+   dtPolyRef ref;
+   F32 nearest[3];
+   const dtQueryFilter *filter = mCrowd->getFilter(getFilterType(agent.params.includeFlags));
+   if(dtStatusSucceed(mQuery->findNearestPoly(to, extents, filter, &ref, nearest)) && ref)
+      mCrowd->requestMoveTarget(agent.index, ref, nearest);
+   else
+      mCrowd->resetMoveTarget(agent.index);
+}
+
+U8 NavCrowd::getFilterType(U16 includeFlags)
+{
+   for(U32 i = 0; i < mFilterFlags.size(); i++)
+      if(mFilterFlags[i] == includeFlags)
+         return i;
+
+   // Share the first filter once we run out.
+   if(mFilterFlags.size() == DT_CROWD_MAX_QUERY_FILTER_TYPE)
+      return 0;
+
+   mFilterFlags.push_back(includeFlags);
+   mCrowd->getEditableFilter(mFilterFlags.size() - 1)->setIncludeFlags(includeFlags);
+   return mFilterFlags.size() - 1;
+}
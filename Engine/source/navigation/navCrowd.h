@@ -0,0 +1,163 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 Daniel Buckmaster
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _NAVCROWD_H_
+#define _NAVCROWD_H_
+
+#include "math/mPoint3.h"
+#include "core/util/tVector.h"
+
+class NavMesh;
+class SceneObject;
+class dtCrowd;
+class dtNavMeshQuery;
+
+/// Local steering and avoidance for the characters moving on a NavMesh.
+///
+/// A NavCrowd wraps a Detour crowd.  Characters register as agents and set
+/// the point they are heading for, usually the next node of their path.
+/// update() then steers all agents around each other and the navmesh edges
+/// in a single pass per tick, and each character reads back the velocity
+/// it should move at.
+///
+/// Agents are normally moved by their own physics, and the crowd takes
+/// their position at the start of every update.  Kinematic agents are
+/// instead moved along the navmesh by the crowd, which is much cheaper
+/// for characters nobody is looking at.
+class NavCrowd
+{
+public:
+   struct AgentParams {
+      /// Radius of the agent.
+      F32 radius;
+      /// Height of the agent.
+      F32 height;
+      /// Maximum speed of the agent.
+      F32 maxSpeed;
+      /// Maximum acceleration of the agent.
+      F32 maxAcceleration;
+      /// Polygon flags the agent is allowed to move on.
+      U16 includeFlags;
+      AgentParams() : radius(0.5f), height(2.0f), maxSpeed(1.0f), maxAcceleration(8.0f), includeFlags(0xffff) {}
+      bool operator==(const AgentParams &p) const
+      {
+         return radius == p.radius && height == p.height && maxSpeed == p.maxSpeed &&
+            maxAcceleration == p.maxAcceleration && includeFlags == p.includeFlags;
+      }
+      bool operator!=(const AgentParams &p) const { return !(*this == p); }
+   };
+
+   NavCrowd(NavMesh *mesh);
+   ~NavCrowd();
+
+   /// Add an agent for an object.  The object must remove its agent before
+   /// it is deleted.
+   /// @return The agent handle.
+   S32 addAgent(SceneObject *object, const AgentParams &params);
+
+   /// Remove an agent.
+   void removeAgent(S32 agent);
+
+   /// Change the parameters of an agent.
+   void setAgentParams(S32 agent, const AgentParams &params);
+
+   /// Set whether the crowd moves an agent instead of its own physics.
+   void setKinematic(S32 agent, bool kinematic);
+
+   /// Set the point an agent is heading for.
+   void setTarget(S32 agent, const Point3F &target);
+
+   /// Stop an agent.
+   void clearTarget(S32 agent);
+
+   /// Steer all agents.  Does nothing if the crowd has already been updated
+   /// this server tick.
+   void update();
+
+   /// Get the velocity the crowd wants an agent to move at.
+   /// @return False if the agent isn't in the crowd yet.
+   bool getVelocity(S32 agent, Point3F *vel) const;
+
+   /// Get the position of an agent on the navmesh.
+   /// @return False if the agent isn't in the crowd yet.
+   bool getPosition(S32 agent, Point3F *pos) const;
+
+   /// Drop the Detour crowd because the navmesh is being replaced.  It is
+   /// recreated with the same agents on the next update.
+   void invalidate();
+
+   /// Number of agents in the crowd.
+   S32 getNumAgents() const { return mNumAgents; }
+
+private:
+   struct Agent {
+      /// Object this agent belongs to, or NULL if the slot is unused.
+      SceneObject *object;
+      AgentParams params;
+      /// Index of the agent in the Detour crowd, or -1.
+      S32 index;
+      bool kinematic;
+      bool hasTarget;
+      Point3F target;
+      Agent() : object(NULL), index(-1), kinematic(false), hasTarget(false), target(0.0f, 0.0f, 0.0f) {}
+   };
+
+   NavMesh *mMesh;
+
+   dtCrowd *mCrowd;
+
+   /// Used to move agents to the position of their object.
+   dtNavMeshQuery *mQuery;
+
+   /// Agent slots, indexed by handle.
+   Vector<Agent> mAgents;
+   S32 mNumAgents;
+
+   /// Number of agents the crowd was created for.
+   S32 mCapacity;
+
+   /// Include flags of each crowd query filter type.
+   Vector<U16> mFilterFlags;
+
+   /// Largest agent radius the crowd was created for.
+   F32 mMaxAgentRadius;
+
+   /// Server tick of the last update.
+   U32 mLastTick;
+
+   /// Create the Detour crowd for the current agents.
+   bool init();
+
+   /// Add an agent to the Detour crowd.
+   void addToCrowd(Agent &agent);
+
+   /// Move an agent to the position of its object.
+   void syncAgent(Agent &agent);
+
+   /// Request a move to the target of an agent.
+   void requestTarget(Agent &agent);
+
+   /// Get the crowd query filter type for a set of include flags.
+   U8 getFilterType(U16 includeFlags);
+};
+
+#endif
@@ -40,6 +40,9 @@
 #include "math/mathIO.h"
 
 #include "core/fileio.h"
+#include "scene/sceneTracker.h"
+#include "platform/threads/threadPool.h"
+#include "platform/platformIntrinsics.h"
 
 extern bool gEditingMission;
 
@@ -47,6 +50,9 @@ IMPLEMENT_CO_NETOBJECT_V1(NavMesh);
 
 const U32 NavMesh::mMaxVertsPerPoly = 3;
 
+U32 NavMesh::smMaxTileJobs = 0;
+U32 NavMesh::smLiveUpdateDelay = 1000;
+
 SimObjectPtr<SimSet> NavMesh::smServerSet = NULL;
 
 ImplementEnumType(NavMeshWaterMethod,
@@ -95,6 +101,111 @@ EventManager *NavMesh::getEventManager()
    return smEventManager;
 }
 
+//-----------------------------------------------------------------------------
+
+/// Remembers the world box of a tracked object at the time
+/// NavMeshes were last notified about it.
+class NavMeshObjectLink : public SceneObjectLink
+{
+public:
+   typedef SceneObjectLink Parent;
+
+   NavMeshObjectLink(SceneTracker *tracker, SceneObject *object)
+      : Parent(tracker, object), mBox(object->getWorldBox()), mIndex(0)
+   {
+   }
+
+   Box3F mBox;
+
+   /// Index in NavMeshTracker::mLinks.
+   U32 mIndex;
+};
+
+/// Tells the server NavMeshes when objects which can add geometry
+/// to them move or get deleted.
+class NavMeshTracker : public SceneTracker
+{
+public:
+   typedef SceneTracker Parent;
+
+   /// Moves smaller than this are ignored.
+   static const F32 smTolerance;
+
+   NavMeshTracker()
+      : Parent(false, StaticObjectType | DynamicShapeObjectType | WaterObjectType)
+   {
+   }
+
+   ~NavMeshTracker()
+   {
+      for(U32 i = 0; i < mLinks.size(); i++)
+         delete mLinks[i];
+   }
+
+   virtual void registerObject(SceneObject *object)
+   {
+      if(!_isTrackableObject(object) || SceneObjectLink::getLinkForTracker(this, object))
+         return;
+      NavMeshObjectLink *link = new NavMeshObjectLink(this, object);
+      link->mIndex = mLinks.size();
+      mLinks.push_back(link);
+   }
+
+   virtual void unregisterObject(SceneObject *object)
+   {
+      NavMeshObjectLink *link = static_cast<NavMeshObjectLink*>(SceneObjectLink::getLinkForTracker(this, object));
+      if(!link)
+         return;
+      if(!object->mPathfindingIgnore)
+         notifyNavMeshes(link->mBox);
+      mLinks.last()->mIndex = link->mIndex;
+      mLinks.erase_fast(link->mIndex);
+      delete link;
+   }
+
+   virtual void updateObject(SceneObjectLink *object)
+   {
+      NavMeshObjectLink *link = static_cast<NavMeshObjectLink*>(object);
+      const Box3F &box = link->getObject()->getWorldBox();
+      if(box.minExtents.equal(link->mBox.minExtents, smTolerance) &&
+         box.maxExtents.equal(link->mBox.maxExtents, smTolerance))
+         return;
+      if(!link->getObject()->mPathfindingIgnore)
+      {
+         // The object has left its old place and blocks its new one.
+         notifyNavMeshes(link->mBox);
+         notifyNavMeshes(box);
+      }
+      link->mBox = box;
+   }
+
+protected:
+   Vector<NavMeshObjectLink*> mLinks;
+
+   virtual bool _isTrackableObject(SceneObject *object) const
+   {
+      // Characters move all the time and aren't part of the navmesh.
+      return Parent::_isTrackableObject(object) && !(object->getTypeMask() & PlayerObjectType);
+   }
+
+   void notifyNavMeshes(const Box3F &box)
+   {
+      SimSet *set = NavMesh::getServerSet();
+      for(U32 i = 0; i < set->size(); i++)
+      {
+         NavMesh *mesh = dynamic_cast<NavMesh*>(set->at(i));
+         if(mesh && mesh->getWorldBox().isOverlapped(box))
+            mesh->notifyGeometryChanged(box);
+      }
+   }
+};
+
+const F32 NavMeshTracker::smTolerance = 0.05f;
+
+/// Exists while there are server NavMeshes.
+static NavMeshTracker *sNavMeshTracker = NULL;
+static U32 sNavMeshTrackerRefs = 0;
+
 DefineConsoleFunction(getNavMeshEventManager, S32, (),,
    "@brief Get the EventManager object for all NavMesh updates.")
 {
@@ -218,11 +329,20 @@ NavMesh::NavMesh()
 
    mAlwaysRender = false;
 
+   mLiveUpdates = false;
+
    mBuilding = false;
+
+   mActiveQueries = 0;
+   mMeshGeneration = 0;
+
+   mCrowd = NULL;
 }
 
 NavMesh::~NavMesh()
 {
+   SAFE_DELETE(mCrowd);
+   beginMeshChange();
    dtFreeNavMesh(nm);
    nm = NULL;
    delete ctx;
@@ -298,6 +418,9 @@ void NavMesh::initPersistFields()
    addField("vehicles", TypeBool, Offset(mVehicles, NavMesh),
       "Is this NavMesh for characters driving vehicles?");
 
+   addField("liveUpdates", TypeBool, Offset(mLiveUpdates, NavMesh),
+      "Rebuild tiles automatically on the server when objects within them move or are deleted.");
+
    endGroup("NavMesh Options");
 
    addGroup("NavMesh Annotations");
@@ -345,6 +468,15 @@ void NavMesh::initPersistFields()
 
    endGroup("NavMesh Advanced Options");
 
+   Con::addVariable("$NavMesh::maxTileJobs", TypeS32, &smMaxTileJobs,
+      "@brief Maximum number of tiles each NavMesh builds concurrently on the thread pool.\n\n"
+      "If zero, which is the default, the number of thread pool threads is used.\n"
+      "@ingroup Navigation\n");
+   Con::addVariable("$NavMesh::liveUpdateDelay", TypeS32, &smLiveUpdateDelay,
+      "@brief Time in milliseconds objects have to stay in place before NavMesh tiles around them are rebuilt.\n\n"
+      "Only used by NavMeshes with liveUpdates set.  The default value is 1000.\n"
+      "@ingroup Navigation\n");
+
    Parent::initPersistFields();
 }
 
@@ -370,6 +502,11 @@ bool NavMesh::onAdd()
    {
       getServerSet()->addObject(this);
       ctx = new NavContext();
+      if(!sNavMeshTrackerRefs++)
+      {
+         sNavMeshTracker = new NavMeshTracker();
+         sNavMeshTracker->init();
+      }
       setProcessTick(true);
       if(getEventManager())
          getEventManager()->postEvent("NavMeshCreated", getIdString());
@@ -385,6 +522,14 @@ void NavMesh::onRemove()
    if(getEventManager())
       getEventManager()->postEvent("NavMeshRemoved", getIdString());
 
+   if(isServerObject())
+   {
+      cancelTileJobs();
+      getServerSet()->removeObject(this);
+      if(!--sNavMeshTrackerRefs)
+         SAFE_DELETE(sNavMeshTracker);
+   }
+
    removeFromScene();
 
    Parent::onRemove();
@@ -612,10 +757,16 @@ bool NavMesh::build(bool background, bool saveIntermediates)
          getEventManager()->postEvent("NavMeshStartUpdate", getIdString());
    }
 
+   // Results of tiles still being built refer to the old navmesh.
+   cancelTileJobs();
+
    mBuilding = true;
 
    ctx->startTimer(RC_TIMER_TOTAL);
 
+   beginMeshChange();
+   if(mCrowd)
+      mCrowd->invalidate();
    dtFreeNavMesh(nm);
    // Allocate a new navmesh.
    nm = dtAllocNavMesh();
@@ -659,8 +810,13 @@ bool NavMesh::build(bool background, bool saveIntermediates)
 
    if(!background)
    {
-      while(!mDirtyTiles.empty())
-         buildNextTile();
+      // Build all tiles on the thread pool and wait for them.
+      while(mDirtyTiles.size() || mTileJobs.size())
+      {
+         processTileJobs();
+         if(mTileJobs.size())
+            Platform::sleep(1);
+      }
    }
 
    return true;
@@ -675,6 +831,7 @@ DefineEngineMethod(NavMesh, build, bool, (bool background, bool save), (true, fa
 void NavMesh::cancelBuild()
 {
    mDirtyTiles.clear();
+   cancelTileJobs();
    ctx->stopTimer(RC_TIMER_TOTAL);
    mBuilding = false;
 }
@@ -746,6 +903,9 @@ void NavMesh::updateTiles(bool dirty)
    mTiles.clear();
    mTileData.clear();
    mDirtyTiles.clear();
+   mTileGeometry.clear();
+   mPendingTiles.clear();
+   mTileChangeTimes.clear();
 
    const Box3F &box = DTStoRC(getWorldBox());
    if(box.isEmpty())
@@ -779,73 +939,123 @@ void NavMesh::updateTiles(bool dirty)
                   tileBmin, tileBmax));
 
          if(dirty)
-            mDirtyTiles.push_back_unique(mTiles.size() - 1);
+            mDirtyTiles.push_back(mTiles.size() - 1);
 
          if(mSaveIntermediates)
             mTileData.increment();
+
+         mTileGeometry.increment();
+         mTileChangeTimes.push_back(0);
       }
    }
 }
 
 void NavMesh::processTick(const Move *move)
 {
-   buildNextTile();
+   // Queue tiles whose geometry has settled for rebuilding.
+   if(mPendingTiles.size())
+   {
+      const SimTime now = Sim::getCurrentTime();
+      for(S32 i = mPendingTiles.size() - 1; i >= 0; i--)
+      {
+         const U32 tile = mPendingTiles[i];
+         if(now - mTileChangeTimes[tile] < smLiveUpdateDelay)
+            continue;
+         if(mDirtyTiles.empty() && mTileJobs.empty())
+            ctx->startTimer(RC_TIMER_TOTAL);
+         mDirtyTiles.push_back_unique(tile);
+         mPendingTiles.erase_fast(i);
+      }
+   }
+
+   processTileJobs();
 }
 
-void NavMesh::buildNextTile()
+/// Runs a TileJob on a worker thread.
+class NavMeshTileWorkItem : public ThreadPool::WorkItem
 {
-   PROFILE_SCOPE(NavMesh_buildNextTile);
-   if(!mDirtyTiles.empty())
+public:
+   typedef ThreadPool::WorkItem Parent;
+
+   NavMeshTileWorkItem(NavMesh::TileJob *job) : mJob(job) {}
+
+protected:
+   ThreadSafeRef<NavMesh::TileJob> mJob;
+
+   virtual void execute()
    {
-      // Pop a single dirty tile and process it.
-      U32 i = mDirtyTiles.front();
-      mDirtyTiles.pop_front();
-      const Tile &tile = mTiles[i];
-      // Intermediate data for tile build.
-      TileData tempdata;
-      TileData &tdata = mSaveIntermediates ? mTileData[i] : tempdata;
-      
-      // Remove any previous data.
-      nm->removeTile(nm->getTileRefAt(tile.x, tile.y, 0), 0, 0);
+      NavMesh::TileJob &job = *mJob;
+      if(!job.cancelled)
+      {
+         job.navData = NavMesh::buildTileData(job);
+         if(!job.saveIntermediates)
+            job.data.freeAll();
+      }
+      // Full barrier; publishes the results to the main thread.
+      dFetchAndAdd(job.done, 1);
+   }
+
+   virtual bool isCancellationRequested()
+   {
+      return mJob->cancelled != 0;
+   }
+};
+
+NavMesh::TileJob::~TileJob()
+{
+   dtFree(navData);
+}
+
+void NavMesh::processTileJobs()
+{
+   PROFILE_SCOPE(NavMesh_processTileJobs);
 
-      // Generate navmesh for this tile.
-      U32 dataSize = 0;
-      unsigned char* data = buildTileData(tile, tdata, dataSize);
-      if(data)
+   bool finished = false;
+
+   // Add tiles finished by the worker threads to the navmesh.
+   for(U32 i = 0; i < mTileJobs.size();)
+   {
+      TileJob &job = *mTileJobs[i];
+      if(!dAtomicRead(job.done))
       {
-         // Add new data (navmesh owns and deletes the data).
-         dtStatus status = nm->addTile(data, dataSize, DT_TILE_FREE_DATA, 0, 0);
-         int success = 1;
-         if(dtStatusFailed(status))
-         {
-            success = 0;
-            dtFree(data);
-         }
-         if(getEventManager())
-         {
-            String str = String::ToString("%d %d %d (%d, %d) %d %.3f %s",
-               getId(),
-               i, mTiles.size(),
-               tile.x, tile.y,
-               success,
-               ctx->getAccumulatedTime(RC_TIMER_TOTAL) / 1000.0f,
-               castConsoleTypeToString(tile.box));
-            getEventManager()->postEvent("NavMeshTileUpdate", str.c_str());
-            setMaskBits(LoadFlag);
-         }
+         i++;
+         continue;
       }
-      // Did we just build the last tile?
-      if(mDirtyTiles.empty())
+      finishTileJob(job);
+      mTileJobs.erase(i);
+      finished = true;
+   }
+
+   // Start jobs for dirty tiles which aren't being built already.
+   U32 maxJobs = smMaxTileJobs ? smMaxTileJobs : ThreadPool::GLOBAL().getNumThreads();
+   maxJobs = getMax(maxJobs, U32(1));
+   for(U32 i = 0; i < mDirtyTiles.size() && mTileJobs.size() < maxJobs;)
+   {
+      const U32 tile = mDirtyTiles[i];
+      bool running = false;
+      for(U32 j = 0; j < mTileJobs.size() && !running; j++)
+         running = mTileJobs[j]->index == tile;
+      if(running)
       {
-         ctx->stopTimer(RC_TIMER_TOTAL);
-         if(getEventManager())
-         {
-            String str = String::ToString("%d", getId());
-            getEventManager()->postEvent("NavMeshUpdate", str.c_str());
-            setMaskBits(LoadFlag);
-         }
-         mBuilding = false;
+         i++;
+         continue;
+      }
+      mDirtyTiles.erase(i);
+      if(!startTileJob(tile))
+         finished = true;
+   }
+
+   // Did we just build the last tile?
+   if(finished && mDirtyTiles.empty() && mTileJobs.empty())
+   {
+      ctx->stopTimer(RC_TIMER_TOTAL);
+      if(getEventManager())
+      {
+         String str = String::ToString("%d", getId());
+         getEventManager()->postEvent("NavMeshUpdate", str.c_str());
+         setMaskBits(LoadFlag);
       }
+      mBuilding = false;
    }
 }
 
@@ -856,8 +1066,10 @@ static void buildCallback(SceneObject* object,void *key)
    object->buildPolyList(info->context,info->polyList,info->boundingBox,info->boundingSphere);
 }
 
-unsigned char *NavMesh::buildTileData(const Tile &tile, TileData &data, U32 &dataSize)
+NavMesh::TileGeometry *NavMesh::gatherTileGeometry(const Tile &tile)
 {
+   PROFILE_SCOPE(NavMesh_gatherTileGeometry);
+
    // Push out tile boundaries a bit.
    F32 tileBmin[3], tileBmax[3];
    rcVcopy(tileBmin, tile.bmin);
@@ -867,30 +1079,162 @@ unsigned char *NavMesh::buildTileData(const Tile &tile, TileData &data, U32 &dat
    tileBmax[0] += cfg.borderSize * cfg.cs;
    tileBmax[2] += cfg.borderSize * cfg.cs;
 
+   TileGeometry *geometry = new TileGeometry;
+
    // Parse objects from level into RC-compatible format.
    Box3F box = RCtoDTS(tileBmin, tileBmax);
    SceneContainer::CallbackInfo info;
    info.context = PLC_Navigation;
    info.boundingBox = box;
-   data.geom.clear();
-   info.polyList = &data.geom;
+   info.polyList = &geometry->geom;
    info.key = this;
    getContainer()->findObjects(box, StaticObjectType | DynamicShapeObjectType, buildCallback, &info);
 
    // Parse water objects into the same list, but remember how much geometry was /not/ water.
-   U32 nonWaterVertCount = data.geom.getVertCount();
-   U32 nonWaterTriCount = data.geom.getTriCount();
+   geometry->nonWaterVertCount = geometry->geom.getVertCount();
+   geometry->nonWaterTriCount = geometry->geom.getTriCount();
    if(mWaterMethod != Ignore)
    {
       getContainer()->findObjects(box, WaterObjectType, buildCallback, &info);
    }
 
+   return geometry;
+}
+
+bool NavMesh::startTileJob(U32 index)
+{
+   const Tile &tile = mTiles[index];
+
+   // Reuse the geometry from the last build if nothing has changed since.
+   if(!mTileGeometry[index])
+      mTileGeometry[index] = gatherTileGeometry(tile);
+
    // Check for no geometry.
-   if (!data.geom.getVertCount())
+   if(!mTileGeometry[index]->geom.getVertCount())
    {
-      data.geom.clear();
-      return NULL;
+      beginMeshChange();
+      nm->removeTile(nm->getTileRefAt(tile.x, tile.y, 0), 0, 0);
+      if(mSaveIntermediates)
+         mTileData[index].freeAll();
+      return false;
+   }
+
+   TileJobRef job = new TileJob;
+   job->index = index;
+   job->tile = tile;
+   job->cfg = cfg;
+   job->waterMethod = mWaterMethod;
+   job->walkableHeight = mWalkableHeight;
+   job->walkableRadius = mWalkableRadius;
+   job->walkableClimb = mWalkableClimb;
+   job->linkVerts = mLinkVerts;
+   job->linkRads = mLinkRads;
+   job->linkDirs = mLinkDirs;
+   job->linkAreas = mLinkAreas;
+   job->linkFlags = mLinkFlags;
+   job->linkIDs = mLinkIDs;
+   job->saveIntermediates = mSaveIntermediates;
+   job->meshId = getIdString();
+   job->data.geom = mTileGeometry[index];
+
+   mTileJobs.push_back(job);
+   ThreadPool::GLOBAL().queueWorkItem(new NavMeshTileWorkItem(job));
+
+   return true;
+}
+
+void NavMesh::finishTileJob(TileJob &job)
+{
+   PROFILE_SCOPE(NavMesh_finishTileJob);
+
+   const U32 i = job.index;
+   const Tile &tile = mTiles[i];
+
+   if(job.error.isNotEmpty())
+      Con::errorf("%s", job.error.c_str());
+
+   if(mSaveIntermediates)
+      mTileData[i].takeFrom(job.data);
+
+   // Remove any previous data.
+   beginMeshChange();
+   nm->removeTile(nm->getTileRefAt(tile.x, tile.y, 0), 0, 0);
+
+   unsigned char* data = job.navData;
+   job.navData = NULL;
+   if(data)
+   {
+      // Add new data (navmesh owns and deletes the data).
+      dtStatus status = nm->addTile(data, job.navDataSize, DT_TILE_FREE_DATA, 0, 0);
+      int success = 1;
+      if(dtStatusFailed(status))
+      {
+         success = 0;
+         dtFree(data);
+      }
+      if(getEventManager())
+      {
+         String str = String::ToString("%d %d %d (%d, %d) %d %.3f %s",
+            getId(),
+            i, mTiles.size(),
+            tile.x, tile.y,
+            success,
+            ctx->getAccumulatedTime(RC_TIMER_TOTAL) / 1000.0f,
+            castConsoleTypeToString(tile.box));
+         getEventManager()->postEvent("NavMeshTileUpdate", str.c_str());
+         setMaskBits(LoadFlag);
+      }
    }
+}
+
+void NavMesh::cancelTileJobs()
+{
+   // The work items keep their jobs alive until they have finished.
+   for(U32 i = 0; i < mTileJobs.size(); i++)
+      dFetchAndAdd(mTileJobs[i]->cancelled, 1);
+   mTileJobs.clear();
+}
+
+NavCrowd *NavMesh::getCrowd()
+{
+   if(!mCrowd)
+      mCrowd = new NavCrowd(this);
+   return mCrowd;
+}
+
+void NavMesh::beginMeshChange()
+{
+   PROFILE_SCOPE(NavMesh_beginMeshChange);
+
+   // Path queries are dispatched from the main thread, so no new ones can
+   // start while we wait here.
+   while(dAtomicRead(mActiveQueries))
+      Platform::sleep(0);
+
+   // Unique across all NavMeshes, since cached paths are keyed by the
+   // dtNavMesh address which may get reused.
+   static U32 sLastMeshGeneration = 0;
+   mMeshGeneration = ++sLastMeshGeneration;
+}
+
+unsigned char *NavMesh::buildTileData(TileJob &job)
+{
+   const rcConfig &cfg = job.cfg;
+   TileData &data = job.data;
+   const RecastPolyList &geom = data.geom->geom;
+
+   // Recast's timers and logging aren't thread safe, so don't use them.
+   rcContext context(false);
+   rcContext *ctx = &context;
+
+   // Push out tile boundaries a bit.
+   F32 tileBmin[3], tileBmax[3];
+   rcVcopy(tileBmin, job.tile.bmin);
+   rcVcopy(tileBmax, job.tile.bmax);
+   tileBmin[0] -= cfg.borderSize * cfg.cs;
+   tileBmin[2] -= cfg.borderSize * cfg.cs;
+   tileBmax[0] += cfg.borderSize * cfg.cs;
+   tileBmax[2] += cfg.borderSize * cfg.cs;
 
    // Figure out voxel dimensions of this tile.
    U32 width = 0, height = 0;
@@ -901,37 +1245,37 @@ unsigned char *NavMesh::buildTileData(const Tile &tile, TileData &data, U32 &dat
    data.hf = rcAllocHeightfield();
    if(!data.hf)
    {
-      Con::errorf("Out of memory (rcHeightField) for NavMesh %s", getIdString());
+      job.error = String::ToString("Out of memory (rcHeightField) for NavMesh %s", job.meshId.c_str());
       return NULL;
    }
    if(!rcCreateHeightfield(ctx, *data.hf, width, height, tileBmin, tileBmax, cfg.cs, cfg.ch))
    {
-      Con::errorf("Could not generate rcHeightField for NavMesh %s", getIdString());
+      job.error = String::ToString("Could not generate rcHeightField for NavMesh %s", job.meshId.c_str());
       return NULL;
    }
 
-   unsigned char *areas = new unsigned char[data.geom.getTriCount()];
+   unsigned char *areas = new unsigned char[geom.getTriCount()];
 
-   dMemset(areas, 0, data.geom.getTriCount() * sizeof(unsigned char));
+   dMemset(areas, 0, geom.getTriCount() * sizeof(unsigned char));
 
    // Mark walkable triangles with the appropriate area flags, and rasterize.
-   if(mWaterMethod == Solid)
+   if(job.waterMethod == Solid)
    {
       // Treat water as solid: i.e. mark areas as walkable based on angle.
       rcMarkWalkableTriangles(ctx, cfg.walkableSlopeAngle,
-         data.geom.getVerts(), data.geom.getVertCount(),
-         data.geom.getTris(), data.geom.getTriCount(), areas);
+         geom.getVerts(), geom.getVertCount(),
+         geom.getTris(), geom.getTriCount(), areas);
    }
    else
    {
       // Treat water as impassable: leave all area flags 0.
       rcMarkWalkableTriangles(ctx, cfg.walkableSlopeAngle,
-         data.geom.getVerts(), nonWaterVertCount,
-         data.geom.getTris(), nonWaterTriCount, areas);
+         geom.getVerts(), data.geom->nonWaterVertCount,
+         geom.getTris(), data.geom->nonWaterTriCount, areas);
    }
    rcRasterizeTriangles(ctx,
-      data.geom.getVerts(), data.geom.getVertCount(),
-      data.geom.getTris(), areas, data.geom.getTriCount(),
+      geom.getVerts(), geom.getVertCount(),
+      geom.getTris(), areas, geom.getTriCount(),
       *data.hf, cfg.walkableClimb);
 
    delete[] areas;
@@ -944,17 +1288,17 @@ unsigned char *NavMesh::buildTileData(const Tile &tile, TileData &data, U32 &dat
    data.chf = rcAllocCompactHeightfield();
    if(!data.chf)
    {
-      Con::errorf("Out of memory (rcCompactHeightField) for NavMesh %s", getIdString());
+      job.error = String::ToString("Out of memory (rcCompactHeightField) for NavMesh %s", job.meshId.c_str());
       return NULL;
    }
    if(!rcBuildCompactHeightfield(ctx, cfg.walkableHeight, cfg.walkableClimb, *data.hf, *data.chf))
    {
-      Con::errorf("Could not generate rcCompactHeightField for NavMesh %s", getIdString());
+      job.error = String::ToString("Could not generate rcCompactHeightField for NavMesh %s", job.meshId.c_str());
       return NULL;
    }
    if(!rcErodeWalkableArea(ctx, cfg.walkableRadius, *data.chf))
    {
-      Con::errorf("Could not erode walkable area for NavMesh %s", getIdString());
+      job.error = String::ToString("Could not erode walkable area for NavMesh %s", job.meshId.c_str());
       return NULL;
    }
 
@@ -969,7 +1313,7 @@ unsigned char *NavMesh::buildTileData(const Tile &tile, TileData &data, U32 &dat
    {
       if(!rcBuildRegionsMonotone(ctx, *data.chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
       {
-         Con::errorf("Could not build regions for NavMesh %s", getIdString());
+         job.error = String::ToString("Could not build regions for NavMesh %s", job.meshId.c_str());
          return NULL;
       }
    }
@@ -977,12 +1321,12 @@ unsigned char *NavMesh::buildTileData(const Tile &tile, TileData &data, U32 &dat
    {
       if(!rcBuildDistanceField(ctx, *data.chf))
       {
-         Con::errorf("Could not build distance field for NavMesh %s", getIdString());
+         job.error = String::ToString("Could not build distance field for NavMesh %s", job.meshId.c_str());
          return NULL;
       }
       if(!rcBuildRegions(ctx, *data.chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
       {
-         Con::errorf("Could not build regions for NavMesh %s", getIdString());
+         job.error = String::ToString("Could not build regions for NavMesh %s", job.meshId.c_str());
          return NULL;
       }
    }
@@ -990,47 +1334,47 @@ unsigned char *NavMesh::buildTileData(const Tile &tile, TileData &data, U32 &dat
    data.cs = rcAllocContourSet();
    if(!data.cs)
    {
-      Con::errorf("Out of memory (rcContourSet) for NavMesh %s", getIdString());
+      job.error = String::ToString("Out of memory (rcContourSet) for NavMesh %s", job.meshId.c_str());
       return NULL;
    }
    if(!rcBuildContours(ctx, *data.chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *data.cs))
    {
-      Con::errorf("Could not construct rcContourSet for NavMesh %s", getIdString());
+      job.error = String::ToString("Could not construct rcContourSet for NavMesh %s", job.meshId.c_str());
       return NULL;
    }
    if(data.cs->nconts <= 0)
    {
-      Con::errorf("No contours in rcContourSet for NavMesh %s", getIdString());
+      job.error = String::ToString("No contours in rcContourSet for NavMesh %s", job.meshId.c_str());
       return NULL;
    }
 
    data.pm = rcAllocPolyMesh();
    if(!data.pm)
    {
-      Con::errorf("Out of memory (rcPolyMesh) for NavMesh %s", getIdString());
+      job.error = String::ToString("Out of memory (rcPolyMesh) for NavMesh %s", job.meshId.c_str());
       return NULL;
    }
    if(!rcBuildPolyMesh(ctx, *data.cs, cfg.maxVertsPerPoly, *data.pm))
    {
-      Con::errorf("Could not construct rcPolyMesh for NavMesh %s", getIdString());
+      job.error = String::ToString("Could not construct rcPolyMesh for NavMesh %s", job.meshId.c_str());
       return NULL;
    }
 
    data.pmd = rcAllocPolyMeshDetail();
    if(!data.pmd)
    {
-      Con::errorf("Out of memory (rcPolyMeshDetail) for NavMesh %s", getIdString());
+      job.error = String::ToString("Out of memory (rcPolyMeshDetail) for NavMesh %s", job.meshId.c_str());
       return NULL;
    }
    if(!rcBuildPolyMeshDetail(ctx, *data.pm, *data.chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *data.pmd))
    {
-      Con::errorf("Could not construct rcPolyMeshDetail for NavMesh %s", getIdString());
+      job.error = String::ToString("Could not construct rcPolyMeshDetail for NavMesh %s", job.meshId.c_str());
       return NULL;
    }
 
    if(data.pm->nverts >= 0xffff)
    {
-      Con::errorf("Too many vertices in rcPolyMesh for NavMesh %s", getIdString());
+      job.error = String::ToString("Too many vertices in rcPolyMesh for NavMesh %s", job.meshId.c_str());
       return NULL;
    }
    for(U32 i = 0; i < data.pm->npolys; i++)
@@ -1064,19 +1408,19 @@ unsigned char *NavMesh::buildTileData(const Tile &tile, TileData &data, U32 &dat
    params.detailTris = data.pmd->tris;
    params.detailTriCount = data.pmd->ntris;
 
-   params.offMeshConVerts = mLinkVerts.address();
-   params.offMeshConRad = mLinkRads.address();
-   params.offMeshConDir = mLinkDirs.address();
-   params.offMeshConAreas = mLinkAreas.address();
-   params.offMeshConFlags = mLinkFlags.address();
-   params.offMeshConUserID = mLinkIDs.address();
-   params.offMeshConCount = mLinkIDs.size();
-
-   params.walkableHeight = mWalkableHeight;
-   params.walkableRadius = mWalkableRadius;
-   params.walkableClimb = mWalkableClimb;
-   params.tileX = tile.x;
-   params.tileY = tile.y;
+   params.offMeshConVerts = job.linkVerts.address();
+   params.offMeshConRad = job.linkRads.address();
+   params.offMeshConDir = job.linkDirs.address();
+   params.offMeshConAreas = job.linkAreas.address();
+   params.offMeshConFlags = job.linkFlags.address();
+   params.offMeshConUserID = job.linkIDs.address();
+   params.offMeshConCount = job.linkIDs.size();
+
+   params.walkableHeight = job.walkableHeight;
+   params.walkableRadius = job.walkableRadius;
+   params.walkableClimb = job.walkableClimb;
+   params.tileX = job.tile.x;
+   params.tileY = job.tile.y;
    params.tileLayer = 0;
    rcVcopy(params.bmin, data.pm->bmin);
    rcVcopy(params.bmax, data.pm->bmax);
@@ -1086,16 +1430,40 @@ unsigned char *NavMesh::buildTileData(const Tile &tile, TileData &data, U32 &dat
 
    if(!dtCreateNavMeshData(&params, &navData, &navDataSize))
    {
-      Con::errorf("Could not create dtNavMeshData for tile (%d, %d) of NavMesh %s",
-         tile.x, tile.y, getIdString());
+      job.error = String::ToString("Could not create dtNavMeshData for tile (%d, %d) of NavMesh %s",
+         job.tile.x, job.tile.y, job.meshId.c_str());
       return NULL;
    }
 
-   dataSize = navDataSize;
+   job.navDataSize = navDataSize;
 
    return navData;
 }
 
+void NavMesh::findTiles(const Box3F &box, Vector<U32> &tiles) const
+{
+   if(mTiles.empty())
+      return;
+
+   // Tiles gather geometry from their border as well.
+   const Box3F rcBox = DTStoRC(box);
+   const F32 tcs = cfg.tileSize * cfg.cs;
+   const F32 border = cfg.borderSize * cfg.cs;
+   if(rcBox.maxExtents.y < cfg.bmin[1] || rcBox.minExtents.y > cfg.bmax[1])
+      return;
+
+   const S32 tw = (cfg.width  + cfg.tileSize-1) / cfg.tileSize;
+   const S32 th = (cfg.height + cfg.tileSize-1) / cfg.tileSize;
+   const S32 minX = getMax((S32)mFloor((rcBox.minExtents.x - border - cfg.bmin[0]) / tcs), 0);
+   const S32 maxX = getMin((S32)mFloor((rcBox.maxExtents.x + border - cfg.bmin[0]) / tcs), tw - 1);
+   const S32 minY = getMax((S32)mFloor((rcBox.minExtents.z - border - cfg.bmin[2]) / tcs), 0);
+   const S32 maxY = getMin((S32)mFloor((rcBox.maxExtents.z + border - cfg.bmin[2]) / tcs), th - 1);
+
+   for(S32 y = minY; y <= maxY; y++)
+      for(S32 x = minX; x <= maxX; x++)
+         tiles.push_back(y * tw + x);
+}
+
 /// This method should never be called in a separate thread to the rendering
 /// or pathfinding logic. It directly replaces data in the dtNavMesh for
 /// this NavMesh object.
@@ -1105,18 +1473,33 @@ void NavMesh::buildTiles(const Box3F &box)
    // Make sure we've already built or loaded.
    if(!nm)
       return;
-   // Iterate over tiles.
-   for(U32 i = 0; i < mTiles.size(); i++)
+   Vector<U32> tiles;
+   findTiles(box, tiles);
+   if(tiles.size() && mDirtyTiles.empty() && mTileJobs.empty())
+      ctx->startTimer(RC_TIMER_TOTAL);
+   for(U32 i = 0; i < tiles.size(); i++)
    {
-      const Tile &tile = mTiles[i];
-      // Check tile box.
-      if(!tile.box.isOverlapped(box))
-         continue;
-      // Mark as dirty.
-      mDirtyTiles.push_back_unique(i);
+      // Mark as dirty and gather the geometry again.
+      mDirtyTiles.push_back_unique(tiles[i]);
+      mTileGeometry[tiles[i]] = NULL;
+      mPendingTiles.remove(tiles[i]);
+   }
+}
+
+void NavMesh::notifyGeometryChanged(const Box3F &box)
+{
+   Vector<U32> tiles;
+   findTiles(box, tiles);
+   const SimTime now = Sim::getCurrentTime();
+   for(U32 i = 0; i < tiles.size(); i++)
+   {
+      mTileGeometry[tiles[i]] = NULL;
+      if(mLiveUpdates && nm)
+      {
+         mTileChangeTimes[tiles[i]] = now;
+         mPendingTiles.push_back_unique(tiles[i]);
+      }
    }
-   if(mDirtyTiles.size())
-      ctx->startTimer(RC_TIMER_TOTAL);
 }
 
 DefineEngineMethod(NavMesh, buildTiles, void, (Box3F box),,
@@ -1130,8 +1513,10 @@ void NavMesh::buildTile(const U32 &tile)
    PROFILE_SCOPE(NavMesh_buildTile);
    if(tile < mTiles.size())
    {
+      if(mDirtyTiles.empty() && mTileJobs.empty())
+         ctx->startTimer(RC_TIMER_TOTAL);
       mDirtyTiles.push_back_unique(tile);
-      ctx->startTimer(RC_TIMER_TOTAL);
+      mTileGeometry[tile] = NULL;
    }
 }
 
@@ -1451,9 +1836,12 @@ void NavMesh::renderTileData(duDebugDrawTorque &dd, U32 tile)
       dd.beginGroup(0);
       if(mTileData[tile].chf) duDebugDrawCompactHeightfieldSolid(&dd, *mTileData[tile].chf);
 
+      if(!mTileData[tile].geom)
+         return;
+
       dd.beginGroup(1);
       int col = duRGBA(255, 0, 255, 255);
-      RecastPolyList &in = mTileData[tile].geom;
+      const RecastPolyList &in = mTileData[tile].geom->geom;
       dd.begin(DU_DRAW_LINES);
       const F32 *verts = in.getVerts();
       const S32 *tris = in.getTris();
@@ -1560,6 +1948,10 @@ bool NavMesh::load()
       return false;
    }
 
+   cancelTileJobs();
+   beginMeshChange();
+   if(mCrowd)
+      mCrowd->invalidate();
    if(nm)
       dtFreeNavMesh(nm);
    nm = dtAllocNavMesh();
@@ -33,6 +33,8 @@
 #include "torqueRecast.h"
 #include "duDebugDrawTorque.h"
 #include "coverPoint.h"
+#include "navCrowd.h"
+#include "platform/threads/threadSafeRefCount.h"
 
 #include <Recast.h>
 #include <DetourNavMesh.h>
@@ -47,6 +49,9 @@
 class NavMesh : public SceneObject {
    typedef SceneObject Parent;
    friend class NavPath;
+   friend class NavMeshTileWorkItem;
+   friend class NavPathService;
+   friend class NavCrowd;
 
 public:
    /// @name NavMesh build
@@ -67,9 +72,20 @@ public:
    /// Load a saved navmesh from a file.
    bool load();
 
-   /// Instantly rebuild the tiles in the navmesh that overlap the box.
+   /// Instantly rebuild the tiles in the navmesh whose geometry overlaps
+   /// the box, gathering their geometry again.
    void buildTiles(const Box3F &box);
 
+   /// Notify the navmesh that level geometry within the box has changed.
+   /// Drops the cached geometry of the affected tiles and, if #mLiveUpdates
+   /// is set, rebuilds them once the box has not changed for
+   /// #smLiveUpdateDelay milliseconds.
+   void notifyGeometryChanged(const Box3F &box);
+
+   /// Return the crowd steering the characters on this navmesh, creating it
+   /// if needed.  Server only.
+   NavCrowd *getCrowd();
+
    /// Instantly rebuild a specific tile.
    void buildTile(const U32 &tile);
 
@@ -115,6 +131,18 @@ public:
    WaterMethod mWaterMethod;
    /// @}
 
+   /// Rebuild tiles automatically when objects within them move or are
+   /// deleted on the server.
+   bool mLiveUpdates;
+
+   /// Maximum number of tiles built concurrently on the thread pool
+   /// by each navmesh.  0 uses the number of pool threads.
+   static U32 smMaxTileJobs;
+
+   /// Time in milliseconds level geometry has to stay unchanged before
+   /// tiles are rebuilt by #mLiveUpdates.
+   static U32 smLiveUpdateDelay;
+
    /// @}
 
    /// Return the index of the tile included by this point.
@@ -257,8 +285,9 @@ private:
    /// mesh. Returns true if successful. Stores the created mesh in tnm.
    bool generateMesh();
 
-   /// Builds the next tile in the dirty list.
-   void buildNextTile();
+   /// Adds tiles finished by worker threads to the navmesh and starts
+   /// building dirty tiles.
+   void processTileJobs();
 
    /// Save imtermediate navmesh creation data?
    bool mSaveIntermediates;
@@ -287,9 +316,20 @@ private:
       }
    };
 
+   /// Level geometry gathered for a tile.  Shared between the geometry
+   /// cache and the worker threads building the tile.
+   struct TileGeometry : public ThreadSafeRefCount<TileGeometry> {
+      RecastPolyList geom;
+      /// Number of vertices and triangles before water was added.
+      U32 nonWaterVertCount, nonWaterTriCount;
+      TileGeometry() : nonWaterVertCount(0), nonWaterTriCount(0) {}
+   };
+
+   typedef ThreadSafeRef<TileGeometry> TileGeometryRef;
+
    /// Intermediate data for tile creation.
    struct TileData {
-      RecastPolyList          geom;
+      TileGeometryRef       geom;
       rcHeightfield        *hf;
       rcCompactHeightfield *chf;
       rcContourSet         *cs;
@@ -305,12 +345,34 @@ private:
       }
       void freeAll()
       {
-         geom.clear();
+         geom = NULL;
          rcFreeHeightField(hf);
          rcFreeCompactHeightfield(chf);
          rcFreeContourSet(cs);
          rcFreePolyMesh(pm);
          rcFreePolyMeshDetail(pmd);
+         hf = NULL;
+         chf = NULL;
+         cs = NULL;
+         pm = NULL;
+         pmd = NULL;
+      }
+      /// Take over the data of another TileData.
+      void takeFrom(TileData &other)
+      {
+         freeAll();
+         geom = other.geom;
+         hf = other.hf;
+         chf = other.chf;
+         cs = other.cs;
+         pm = other.pm;
+         pmd = other.pmd;
+         other.geom = NULL;
+         other.hf = NULL;
+         other.chf = NULL;
+         other.cs = NULL;
+         other.pm = NULL;
+         other.pmd = NULL;
       }
       ~TileData()
       {
@@ -327,11 +389,82 @@ private:
    /// List of indices to the tile array which are dirty.
    Vector<U32> mDirtyTiles;
 
+   /// Cached level geometry of each tile.  NULL where the geometry
+   /// has to be gathered again.
+   Vector<TileGeometryRef> mTileGeometry;
+
+   /// Tiles waiting for level geometry to settle before #mLiveUpdates
+   /// rebuilds them.
+   Vector<U32> mPendingTiles;
+
+   /// Sim time of the last geometry change in each tile.
+   Vector<SimTime> mTileChangeTimes;
+
+   /// Everything needed to build a tile on a worker thread.
+   struct TileJob : public ThreadSafeRefCount<TileJob> {
+      /// Index of the tile in #mTiles.
+      U32 index;
+      Tile tile;
+      /// Copies of the build settings.
+      rcConfig cfg;
+      WaterMethod waterMethod;
+      F32 walkableHeight, walkableRadius, walkableClimb;
+      /// Copies of the off-mesh links.
+      Vector<F32> linkVerts;
+      Vector<F32> linkRads;
+      Vector<U8> linkDirs;
+      Vector<U8> linkAreas;
+      Vector<U16> linkFlags;
+      Vector<U32> linkIDs;
+      /// Keep the intermediate data after the build?
+      bool saveIntermediates;
+      /// Id of the NavMesh for error messages.
+      String meshId;
+      /// Input geometry and intermediate data.
+      TileData data;
+      /// Finished tile data or NULL.
+      unsigned char *navData;
+      U32 navDataSize;
+      /// Error that stopped the build; printed on the main thread.
+      String error;
+      /// Set once the worker thread is done.
+      volatile U32 done;
+      /// Set if the result isn't wanted anymore.
+      volatile U32 cancelled;
+      TileJob() : index(0), waterMethod(Ignore), walkableHeight(0.0f), walkableRadius(0.0f),
+         walkableClimb(0.0f), saveIntermediates(false), navData(NULL), navDataSize(0), done(0), cancelled(0)
+      {
+         dMemset(&cfg, 0, sizeof(cfg));
+      }
+      ~TileJob();
+   };
+
+   typedef ThreadSafeRef<TileJob> TileJobRef;
+
+   /// Tiles being built on the thread pool.
+   Vector<TileJobRef> mTileJobs;
+
    /// Update tile dimensions.
    void updateTiles(bool dirty = false);
 
-   /// Generates navmesh data for a single tile.
-   unsigned char *buildTileData(const Tile &tile, TileData &data, U32 &dataSize);
+   /// Return the indices of the tiles whose geometry overlaps the box.
+   void findTiles(const Box3F &box, Vector<U32> &tiles) const;
+
+   /// Gathers the level geometry for a tile.  Must run on the main thread.
+   TileGeometry *gatherTileGeometry(const Tile &tile);
+
+   /// Gathers geometry if needed and queues a tile for building.  Returns
+   /// false if the tile has no geometry and got removed right away.
+   bool startTileJob(U32 index);
+
+   /// Adds the result of a tile job to the navmesh.
+   void finishTileJob(TileJob &job);
+
+   /// Drops all queued and running tile jobs.
+   void cancelTileJobs();
+
+   /// Generates navmesh data for a single tile.  Runs on worker threads.
+   static unsigned char *buildTileData(TileJob &job);
 
    /// @}
 
@@ -404,6 +537,27 @@ private:
 
    /// @}
 
+   /// @name Path queries
+   /// NavPathService reads the navmesh from worker threads, so the main
+   /// thread has to wait for queries in flight before changing it.
+   /// @{
+
+   /// Number of path queries dispatched against this navmesh that have
+   /// not finished yet.
+   volatile U32 mActiveQueries;
+
+   /// Incremented every time the navmesh changes, to invalidate cached paths.
+   U32 mMeshGeneration;
+
+   /// Waits for path queries in flight and invalidates cached paths.  Must be
+   /// called before adding or removing tiles or replacing #nm.
+   void beginMeshChange();
+
+   /// @}
+
+   /// Local steering for characters on this navmesh.
+   NavCrowd *mCrowd;
+
    /// @name Rendering
    /// @{
 
@@ -62,6 +62,7 @@ NavPath::NavPath() :
    mIsLooping = false;
    mAutoUpdate = false;
    mIsSliced = false;
+   mIsAsync = false;
 
    mMaxIterations = 1;
 
@@ -207,6 +208,8 @@ void NavPath::initPersistFields()
       "Does this path loop?");
    addField("isSliced", TypeBool, Offset(mIsSliced, NavPath),
       "Plan this path over multiple updates instead of all at once.");
+   addField("async", TypeBool, Offset(mIsAsync, NavPath),
+      "Plan this path on a worker thread.  The previous path is kept until the new one is ready.");
    addFieldV("maxIterations", TypeS32, Offset(mMaxIterations, NavPath), &ValidIterations,
       "Maximum iterations of path planning this path does per tick.");
    addProtectedField("autoUpdate", TypeBool, Offset(mAutoUpdate, NavPath),
@@ -275,6 +278,8 @@ bool NavPath::onAdd()
 
 void NavPath::onRemove()
 {
+   cancelAsync();
+
    Parent::onRemove();
 
    removeFromScene();
@@ -302,6 +307,15 @@ bool NavPath::init()
    if(isServerObject())
       setMaskBits(PathMask);
 
+   gatherVisitPoints();
+
+   return true;
+}
+
+void NavPath::gatherVisitPoints()
+{
+   mVisitPoints.clear();
+
    // Add points we need to visit in reverse order.
    if(mWaypoints && mWaypoints->size())
    {
@@ -330,8 +344,6 @@ bool NavPath::init()
       mVisitPoints.push_back(mTo);
       mVisitPoints.push_back(mFrom);
    }
-
-   return true;
 }
 
 void NavPath::resize()
@@ -370,6 +382,12 @@ void NavPath::resize()
 bool NavPath::plan()
 {
    PROFILE_SCOPE(NavPath_plan);
+   if(mIsAsync)
+      return planAsync();
+
+   // A synchronous plan replaces any asynchronous one.
+   cancelAsync();
+
    // Initialise filter.
    mFilter.setIncludeFlags(mLinkTypes.getFlags());
 
@@ -393,6 +411,66 @@ bool NavPath::planSliced()
    return visited;
 }
 
+bool NavPath::planAsync()
+{
+   setProcessTick(false);
+   cancelAsync();
+
+   mStatus = DT_FAILURE;
+
+   // Check that all the right data is provided.
+   if(!mMesh || !mMesh->getNavMesh())
+      return false;
+   if(!(mFromSet && mToSet) && !(mWaypoints && mWaypoints->size()))
+      return false;
+
+   gatherVisitPoints();
+
+   mAsyncQuery = new NavPathService::Query;
+   mAsyncQuery->mesh = mMesh;
+   mAsyncQuery->includeFlags = mLinkTypes.getFlags();
+   for(S32 i = mVisitPoints.size() - 1; i >= 0; i--)
+      mAsyncQuery->points.push_back(mVisitPoints[i]);
+   mAsyncQuery->callback.bind(this, &NavPath::onQueryComplete);
+   NAVPATHSERVICE->submit(mAsyncQuery);
+
+   mVisitPoints.clear();
+   mStatus = DT_IN_PROGRESS;
+
+   return true;
+}
+
+void NavPath::cancelAsync()
+{
+   if(!mAsyncQuery)
+      return;
+
+   mAsyncQuery->callback.clear();
+   NavPathService *service = ManagedSingleton<NavPathService>::instanceOrNull();
+   if(service)
+      service->cancel(mAsyncQuery);
+   mAsyncQuery = NULL;
+}
+
+void NavPath::onQueryComplete(NavPathService::Query *query)
+{
+   PROFILE_SCOPE(NavPath_onQueryComplete);
+
+   mAsyncQuery = NULL;
+
+   mPoints = query->path;
+   mFlags = query->flags;
+   mLength = query->length;
+   mStatus = query->success ? DT_SUCCESS : DT_FAILURE;
+
+   if(isServerObject())
+      setMaskBits(PathMask);
+
+   resize();
+
+   mPlanSignal.trigger(this, success());
+}
+
 bool NavPath::planInstant()
 {
    setProcessTick(false);
@@ -533,7 +611,7 @@ void NavPath::processTick(const Move *move)
    if(!mMesh)
       if(Sim::findObject(mMeshName.c_str(), mMesh))
          plan();
-   if(dtStatusInProgress(mStatus))
+   if(dtStatusInProgress(mStatus) && !mAsyncQuery)
       update();
 }
 
@@ -26,6 +26,8 @@
 #include "scene/sceneObject.h"
 #include "scene/simPath.h"
 #include "navMesh.h"
+#include "navPathService.h"
+#include "core/util/tSignal.h"
 #include <DetourNavMeshQuery.h>
 
 class NavPath: public SceneObject {
@@ -48,6 +50,7 @@ public:
    bool mIsLooping;
    bool mAutoUpdate;
    bool mIsSliced;
+   bool mIsAsync;
 
    S32 mMaxIterations;
 
@@ -72,6 +75,16 @@ public:
    /// Did the path plan successfully?
    bool success() const { return dtStatusSucceed(mStatus); }
 
+   /// Is an asynchronous plan waiting for its result?  The previous path
+   /// stays available until the new one arrives.
+   bool isPlanning() const { return mAsyncQuery.ptr() != NULL; }
+
+   typedef Signal<void(NavPath*, bool)> PlanSignal;
+
+   /// Triggered when an asynchronous plan finishes, with whether it was
+   /// successful.
+   PlanSignal &getPlanSignal() { return mPlanSignal; }
+
    /// @}
 
    /// @name Path interface
@@ -143,6 +156,19 @@ private:
    /// @return True if the plan initialised successfully.
    bool planSliced();
 
+   /// Queue a plan with the NavPathService.
+   /// @return True if the plan was queued.
+   bool planAsync();
+
+   /// Drop the asynchronous plan in progress, if any.
+   void cancelAsync();
+
+   /// Called by the NavPathService when our plan has finished.
+   void onQueryComplete(NavPathService::Query *query);
+
+   /// Fill mVisitPoints with the points to visit, in reverse order.
+   void gatherVisitPoints();
+
    /// Add points of the path between the two specified points.
    //bool addPoints(Point3F from, Point3F to, Vector<Point3F> *points);
 
@@ -158,6 +184,9 @@ private:
    Vector<Point3F> mVisitPoints;
    F32 mLength;
 
+   NavPathService::QueryRef mAsyncQuery;
+   PlanSignal mPlanSignal;
+
    /// Resets our world transform and bounds to fit our point list.
    void resize();
 
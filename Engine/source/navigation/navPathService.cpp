@@ -0,0 +1,412 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 Daniel Buckmaster
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "torqueRecast.h"
+#include "navPathService.h"
+
+#include "console/consoleTypes.h"
+#include "core/module.h"
+#include "platform/platformTimer.h"
+#include "platform/platformIntrinsics.h"
+#include "platform/threads/threadPool.h"
+#include "platform/profiler.h"
+#include "scene/sceneContainer.h"
+#include "collision/collision.h"
+
+MODULE_BEGIN( NavPathService )
+
+   MODULE_INIT
+   {
+      ManagedSingleton< NavPathService >::createSingleton();
+      NavPathService::initConsole();
+   }
+
+   MODULE_SHUTDOWN
+   {
+      ManagedSingleton< NavPathService >::deleteSingleton();
+   }
+
+MODULE_END;
+
+U32 NavPathService::smTickBudget = 2;
+U32 NavPathService::smBatchSize = 8;
+U32 NavPathService::smCacheSize = 256;
+
+//-----------------------------------------------------------------------------
+
+/// Runs a batch of path queries on a worker thread.
+class NavPathBatchWorkItem : public ThreadPool::WorkItem
+{
+public:
+   typedef ThreadPool::WorkItem Parent;
+
+   NavPathBatchWorkItem(NavPathService *service, const Vector<NavPathService::QueryRef> &queries)
+      : mService(service), mQueries(queries)
+   {
+   }
+
+   /// NavMeshes wait for the queries in flight before they change, so run
+   /// ahead of long jobs like tile builds.
+   virtual F32 getPriority() { return F32_MAX; }
+
+protected:
+   virtual void execute()
+   {
+      PROFILE_SCOPE(NavPathBatchWorkItem_execute);
+
+      dtNavMeshQuery *navQuery = mService->allocNavQuery();
+      for(U32 i = 0; i < mQueries.size(); i++)
+      {
+         NavPathService::Query &query = *mQueries[i];
+         if(navQuery && !query.cancelled)
+            mService->runQuery(navQuery, query);
+         NavPathService::finishQuery(query);
+      }
+      mService->freeNavQuery(navQuery);
+   }
+
+   virtual void onCancelled()
+   {
+      for(U32 i = 0; i < mQueries.size(); i++)
+         NavPathService::finishQuery(*mQueries[i]);
+   }
+
+   NavPathService *mService;
+   Vector<NavPathService::QueryRef> mQueries;
+};
+
+//-----------------------------------------------------------------------------
+
+NavPathService::NavPathService()
+{
+   mTimer = PlatformTimer::create();
+   setProcessTicks(true);
+}
+
+NavPathService::~NavPathService()
+{
+   // Batches still running refer to us.
+   for(U32 i = 0; i < mRunning.size(); i++)
+   {
+      mRunning[i]->cancelled = true;
+      while(!dAtomicRead(mRunning[i]->done))
+         Platform::sleep(1);
+   }
+   mRunning.clear();
+   mQueue.clear();
+
+   for(U32 i = 0; i < mFreeNavQueries.size(); i++)
+      dtFreeNavMeshQuery(mFreeNavQueries[i]);
+   mFreeNavQueries.clear();
+
+   SAFE_DELETE(mTimer);
+}
+
+void NavPathService::initConsole()
+{
+   Con::addVariable("$NavPath::tickBudget", TypeS32, &smTickBudget,
+      "@brief Milliseconds per tick the main thread may spend dispatching path queries and invoking their callbacks.\n\n"
+      "At least one query is dispatched and one finished every tick.  The default value is 2.\n"
+      "@ingroup Navigation\n");
+   Con::addVariable("$NavPath::batchSize", TypeS32, &smBatchSize,
+      "@brief Maximum number of path queries planned by a single thread pool work item.\n\n"
+      "The default value is 8.\n"
+      "@ingroup Navigation\n");
+   Con::addVariable("$NavPath::cacheSize", TypeS32, &smCacheSize,
+      "@brief Number of polygon corridors cached by start and end polygon for asynchronous path queries.\n\n"
+      "Zero disables the cache.  The default value is 256.\n"
+      "@ingroup Navigation\n");
+}
+
+void NavPathService::submit(Query *query)
+{
+   AssertFatal(!query->navMesh, "NavPathService::submit - Query is still running!");
+
+   query->done = 0;
+   query->cancelled = false;
+   query->success = false;
+   mQueue.push_back(query);
+}
+
+void NavPathService::cancel(Query *query)
+{
+   // Queued queries are skipped on dispatch, running ones are dropped when
+   // they finish.
+   query->cancelled = true;
+}
+
+void NavPathService::processTick()
+{
+   if(mQueue.empty() && mRunning.empty())
+      return;
+
+   PROFILE_SCOPE(NavPathService_processTick);
+
+   mTimer->reset();
+
+   finishQueries();
+   dispatchQueries();
+}
+
+void NavPathService::finishQueries()
+{
+   for(U32 i = 0; i < mRunning.size();)
+   {
+      if(!dAtomicRead(mRunning[i]->done))
+      {
+         i++;
+         continue;
+      }
+
+      QueryRef query = mRunning[i];
+      mRunning.erase(i);
+
+      if(query->cancelled || query->callback.empty())
+         continue;
+
+      query->callback(query);
+
+      if(mTimer->getElapsedMs() >= smTickBudget)
+         break;
+   }
+}
+
+bool NavPathService::prepareQuery(Query &query)
+{
+   NavMesh *mesh = query.mesh;
+   if(!mesh || !mesh->getNavMesh() || query.points.size() < 2)
+      return false;
+
+   // Drop to height of statics.
+   const F32 drop = mesh->mWalkableHeight * 2.0f;
+   RayInfo info;
+   for(U32 i = 0; i < query.points.size(); i++)
+   {
+      Point3F &p = query.points[i];
+      if(mesh->getContainer()->castRay(p + Point3F(0, 0, 0.1f), p - Point3F(0, 0, drop), StaticObjectType, &info))
+         p = info.point;
+   }
+
+   query.navMesh = mesh;
+   query.dtMesh = mesh->getNavMesh();
+   query.generation = mesh->mMeshGeneration;
+   query.extents[0] = query.extents[2] = mesh->mWalkableRadius * 4.0f;
+   query.extents[1] = mesh->mWalkableHeight;
+
+   return true;
+}
+
+void NavPathService::dispatchQueries()
+{
+   const U32 batchSize = getMax(smBatchSize, U32(1));
+   const U32 maxRunning = getMax(ThreadPool::GLOBAL().getNumThreads(), U32(1)) * batchSize;
+
+   // cancel() doesn't remove queries and callbacks may only append new ones,
+   // so indices stay valid until we drop the dispatched queries at the end.
+   U32 next = 0;
+   bool overBudget = false;
+   while(next < mQueue.size() && mRunning.size() < maxRunning && !overBudget)
+   {
+      Vector<QueryRef> batch;
+      while(next < mQueue.size() && batch.size() < batchSize)
+      {
+         QueryRef query = mQueue[next++];
+         if(query->cancelled)
+            continue;
+
+         if(prepareQuery(*query))
+         {
+            dFetchAndAdd(query->navMesh->mActiveQueries, 1);
+            batch.push_back(query);
+            mRunning.push_back(query);
+         }
+         else
+         {
+            query->success = false;
+            query->path.clear();
+            query->flags.clear();
+            query->length = 0.0f;
+            if(!query->callback.empty())
+               query->callback(query);
+         }
+
+         if(mTimer->getElapsedMs() >= smTickBudget)
+         {
+            overBudget = true;
+            break;
+         }
+      }
+
+      if(batch.size())
+         ThreadPool::GLOBAL().queueWorkItem(new NavPathBatchWorkItem(this, batch));
+   }
+
+   mQueue.erase(0, next);
+}
+
+void NavPathService::runQuery(dtNavMeshQuery *navQuery, Query &query)
+{
+   PROFILE_SCOPE(NavPathService_runQuery);
+
+   query.path.clear();
+   query.flags.clear();
+   query.length = 0.0f;
+   query.success = false;
+
+   if(dtStatusFailed(navQuery->init(query.dtMesh, MaxPathLen)))
+      return;
+
+   dtQueryFilter filter;
+   filter.setIncludeFlags(query.includeFlags);
+
+   dtPolyRef corridor[MaxPathLen];
+   F32 straightPath[MaxPathLen * 3];
+   dtPolyRef straightPathPolys[MaxPathLen];
+   U8 straightPathFlags[MaxPathLen];
+
+   for(U32 leg = 1; leg < query.points.size(); leg++)
+   {
+      // Convert to Detour-friendly coordinates and data structures.
+      const Point3F &start = query.points[leg-1];
+      const Point3F &end = query.points[leg];
+      F32 from[] = {start.x, start.z, -start.y};
+      F32 to[] =   {end.x,   end.z,   -end.y};
+      dtPolyRef startRef, endRef;
+
+      if(dtStatusFailed(navQuery->findNearestPoly(from, query.extents, &filter, &startRef, NULL)) || !startRef)
+         return;
+      if(dtStatusFailed(navQuery->findNearestPoly(to, query.extents, &filter, &endRef, NULL)) || !endRef)
+         return;
+
+      S32 pathLen = findCachedCorridor(query, startRef, endRef, corridor);
+      if(!pathLen)
+      {
+         dtStatus status = navQuery->findPath(startRef, endRef, from, to, &filter, corridor, &pathLen, MaxPathLen);
+         if(dtStatusFailed(status) || !pathLen)
+            return;
+         // Partial results depend on where the search gave up.
+         if(!(status & DT_PARTIAL_RESULT))
+            cacheCorridor(query, startRef, endRef, corridor, pathLen);
+      }
+
+      S32 straightPathLen;
+      navQuery->findStraightPath(from, to, corridor, pathLen,
+         straightPath, straightPathFlags,
+         straightPathPolys, &straightPathLen, MaxPathLen);
+
+      const U32 s = query.path.size();
+      query.path.increment(straightPathLen);
+      query.flags.increment(straightPathLen);
+      for(U32 i = 0; i < straightPathLen; i++)
+      {
+         query.path[s + i] = RCtoDTS(straightPath + i * 3);
+         query.flags[s + i] = 0;
+         query.dtMesh->getPolyFlags(straightPathPolys[i], &query.flags[s + i]);
+         if(s > 0 || i > 0)
+            query.length += (query.path[s + i] - query.path[s + i - 1]).len();
+      }
+   }
+
+   query.success = true;
+}
+
+void NavPathService::finishQuery(Query &query)
+{
+   // The NavMesh may go away as soon as we stop reading it.
+   dFetchAndAdd(query.navMesh->mActiveQueries, U32(-1));
+   query.navMesh = NULL;
+   dFetchAndAdd(query.done, 1);
+}
+
+//-----------------------------------------------------------------------------
+
+dtNavMeshQuery *NavPathService::allocNavQuery()
+{
+   {
+      MutexHandle lock;
+      lock.lock(&mNavQueryMutex, true);
+      if(mFreeNavQueries.size())
+      {
+         dtNavMeshQuery *navQuery = mFreeNavQueries.last();
+         mFreeNavQueries.pop_back();
+         return navQuery;
+      }
+   }
+
+   return dtAllocNavMeshQuery();
+}
+
+void NavPathService::freeNavQuery(dtNavMeshQuery *navQuery)
+{
+   if(!navQuery)
+      return;
+
+   MutexHandle lock;
+   lock.lock(&mNavQueryMutex, true);
+   mFreeNavQueries.push_back(navQuery);
+}
+
+static inline U32 hashCorridor(dtPolyRef startRef, dtPolyRef endRef, U16 includeFlags)
+{
+   return U32(startRef) * 2654435761u ^ U32(endRef) * 40503u ^ includeFlags;
+}
+
+S32 NavPathService::findCachedCorridor(const Query &query, dtPolyRef startRef, dtPolyRef endRef, dtPolyRef *corridor)
+{
+   MutexHandle lock;
+   lock.lock(&mCacheMutex, true);
+
+   if(!mCache.size())
+      return 0;
+
+   const CacheEntry &entry = mCache[hashCorridor(startRef, endRef, query.includeFlags) % mCache.size()];
+   if(entry.dtMesh != query.dtMesh || entry.generation != query.generation ||
+      entry.includeFlags != query.includeFlags ||
+      entry.startRef != startRef || entry.endRef != endRef)
+      return 0;
+
+   dMemcpy(corridor, entry.corridor.address(), entry.corridor.size() * sizeof(dtPolyRef));
+   return entry.corridor.size();
+}
+
+void NavPathService::cacheCorridor(const Query &query, dtPolyRef startRef, dtPolyRef endRef, const dtPolyRef *corridor, S32 len)
+{
+   MutexHandle lock;
+   lock.lock(&mCacheMutex, true);
+
+   if(mCache.size() != smCacheSize)
+   {
+      mCache.clear();
+      mCache.setSize(smCacheSize);
+   }
+   if(!mCache.size())
+      return;
+
+   CacheEntry &entry = mCache[hashCorridor(startRef, endRef, query.includeFlags) % mCache.size()];
+   entry.dtMesh = query.dtMesh;
+   entry.generation = query.generation;
+   entry.includeFlags = query.includeFlags;
+   entry.startRef = startRef;
+   entry.endRef = endRef;
+   entry.corridor.setSize(len);
+   dMemcpy(entry.corridor.address(), corridor, len * sizeof(dtPolyRef));
+}
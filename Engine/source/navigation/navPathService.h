@@ -0,0 +1,207 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 Daniel Buckmaster
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _NAVPATHSERVICE_H_
+#define _NAVPATHSERVICE_H_
+
+#include "core/iTickable.h"
+#include "core/util/delegate.h"
+#include "core/util/tSingleton.h"
+#include "platform/threads/threadSafeRefCount.h"
+#include "platform/threads/mutex.h"
+#include "navMesh.h"
+#include <DetourNavMeshQuery.h>
+
+class PlatformTimer;
+
+/// Plans paths on the thread pool so that many AI characters can re-path
+/// without stalling the server tick.
+///
+/// Queries are queued on the main thread and dispatched in batches each tick.
+/// A batch runs on a worker thread with its own dtNavMeshQuery, and the
+/// callback of each query is invoked on the main thread on a later tick.
+/// Main thread work, such as snapping points to the ground and invoking
+/// callbacks, is limited to $NavPath::tickBudget milliseconds per tick.
+///
+/// Polygon corridors are cached by start and end polygon, so characters
+/// travelling between the same areas only need to straighten their path.
+/// The cache is invalidated whenever the navmesh changes.
+class NavPathService : public virtual ITickable
+{
+public:
+   /// Longest polygon corridor a query can return.
+   static const U32 MaxPathLen = 2048;
+
+   /// A path query.  The inputs must not be changed after it is submitted.
+   struct Query : public ThreadSafeRefCount<Query>
+   {
+      /// @name Inputs
+      /// @{
+
+      /// NavMesh to plan on.
+      SimObjectPtr<NavMesh> mesh;
+      /// Points to visit, in order.  Points are dropped onto static geometry
+      /// before planning.
+      Vector<Point3F> points;
+      /// Polygon flags we are allowed to move on.
+      U16 includeFlags;
+      /// Called on the main thread when the query has finished.
+      Delegate<void(Query*)> callback;
+
+      /// @}
+
+      /// @name Outputs
+      /// @{
+
+      /// Straight path through all visit points.
+      Vector<Point3F> path;
+      /// Polygon flags of each path point.
+      Vector<U16> flags;
+      /// Length of the path.
+      F32 length;
+      /// Did every leg of the path plan successfully?
+      bool success;
+
+      /// @}
+
+      Query() : mesh(NULL), includeFlags(0), length(0.0f), success(false),
+         navMesh(NULL), dtMesh(NULL), generation(0), done(0), cancelled(false)
+      {
+         dMemset(extents, 0, sizeof(extents));
+      }
+
+   private:
+      friend class NavPathService;
+      friend class NavPathBatchWorkItem;
+
+      /// @name Set on dispatch
+      /// @{
+      NavMesh *navMesh;
+      const dtNavMesh *dtMesh;
+      U32 generation;
+      F32 extents[3];
+      /// @}
+
+      /// Set by the worker thread when the outputs are ready.
+      volatile U32 done;
+      /// Set if the query was cancelled; its callback won't be invoked.
+      volatile bool cancelled;
+   };
+
+   typedef ThreadSafeRef<Query> QueryRef;
+
+   /// Queues a query.  Its callback will be invoked on a later tick, unless
+   /// it is cancelled first.
+   void submit(Query *query);
+
+   /// Drops a queued or running query without invoking its callback.
+   void cancel(Query *query);
+
+   /// Number of queries that are queued or running.
+   U32 getNumPending() const { return mQueue.size() + mRunning.size(); }
+
+   /// Main thread time budget per tick, in milliseconds.
+   static U32 smTickBudget;
+   /// Maximum number of queries run by a single work item.
+   static U32 smBatchSize;
+   /// Number of cached polygon corridors.  Zero disables the cache.
+   static U32 smCacheSize;
+
+   NavPathService();
+   virtual ~NavPathService();
+
+   static void initConsole();
+
+   // For ManagedSingleton.
+   static const char* getSingletonName() { return "NavPathService"; }
+
+protected:
+   friend class NavPathBatchWorkItem;
+
+   virtual void interpolateTick(F32 delta) {}
+   virtual void processTick();
+   virtual void advanceTime(F32 timeDelta) {}
+
+   /// Queries waiting to be dispatched.
+   Vector<QueryRef> mQueue;
+
+   /// Queries dispatched to the thread pool, in dispatch order.
+   Vector<QueryRef> mRunning;
+
+   /// Measures main thread time spent each tick.
+   PlatformTimer *mTimer;
+
+   /// Invokes the callbacks of finished queries.
+   void finishQueries();
+
+   /// Validates a query and fills in the fields set on dispatch.  Returns
+   /// false if the query can't be planned.
+   bool prepareQuery(Query &query);
+
+   /// Queues batches of prepared queries on the thread pool.
+   void dispatchQueries();
+
+   /// Plans a query.  Runs on worker threads.
+   void runQuery(dtNavMeshQuery *navQuery, Query &query);
+
+   /// Releases the query's NavMesh and marks it done.  Runs on worker threads.
+   static void finishQuery(Query &query);
+
+   /// @name dtNavMeshQuery pool
+   /// @{
+
+   Mutex mNavQueryMutex;
+   Vector<dtNavMeshQuery*> mFreeNavQueries;
+
+   dtNavMeshQuery *allocNavQuery();
+   void freeNavQuery(dtNavMeshQuery *navQuery);
+
+   /// @}
+
+   /// @name Corridor cache
+   /// @{
+
+   struct CacheEntry {
+      const dtNavMesh *dtMesh;
+      U32 generation;
+      U16 includeFlags;
+      dtPolyRef startRef, endRef;
+      Vector<dtPolyRef> corridor;
+      CacheEntry() : dtMesh(NULL), generation(0), includeFlags(0), startRef(0), endRef(0) {}
+   };
+
+   Mutex mCacheMutex;
+   /// Direct mapped cache, indexed by a hash of the start and end polygons.
+   Vector<CacheEntry> mCache;
+
+   /// Copies a cached corridor into the query's corridor buffer.  Returns
+   /// the corridor length, or zero on a miss.
+   S32 findCachedCorridor(const Query &query, dtPolyRef startRef, dtPolyRef endRef, dtPolyRef *corridor);
+   void cacheCorridor(const Query &query, dtPolyRef startRef, dtPolyRef endRef, const dtPolyRef *corridor, S32 len);
+
+   /// @}
+};
+
+/// Returns the NavPathService singleton.
+#define NAVPATHSERVICE ManagedSingleton<NavPathService>::instance()
+
+#endif
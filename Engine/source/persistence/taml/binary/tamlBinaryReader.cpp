@@ -31,7 +31,7 @@
 
 //-----------------------------------------------------------------------------
 
-SimObject* TamlBinaryReader::read( FileStream& stream )
+SimObject* TamlBinaryReader::read( Stream& stream )
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlBinaryReader_Read);
@@ -64,18 +64,23 @@ SimObject* TamlBinaryReader::read( FileStream& stream )
         ZipSubRStream zipStream;
         zipStream.attachStream( &stream );
 
-        // Parse element.
-        pSimObject = parseElement( zipStream, versionId );
+        // Parse string table then element.
+        if ( parseStringTable( zipStream, versionId ) )
+            pSimObject = parseElement( zipStream, versionId );
 
         // Detach zip stream.
         zipStream.detachStream();
     }
     else
     {
-        // No, so parse element.
-        pSimObject = parseElement( stream, versionId );
+        // No, so parse string table then element.
+        if ( parseStringTable( stream, versionId ) )
+            pSimObject = parseElement( stream, versionId );
     }
 
+    // Release string table.
+    mStringTable.clear();
+
     return pSimObject;
 }
 
@@ -92,6 +97,59 @@ void TamlBinaryReader::resetParse( void )
 
 //-----------------------------------------------------------------------------
 
+bool TamlBinaryReader::parseStringTable( Stream& stream, const U32 versionId )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryReader_ParseStringTable);
+
+    mStringTable.clear();
+
+    // Finish if the version predates the string table.
+    if ( versionId < 3 )
+        return true;
+
+    // Read string count.
+    U32 stringCount;
+    if ( !stream.read( &stringCount ) )
+    {
+        // Warn.
+        Con::warnf("Taml: Cannot read binary file as the string table is truncated." );
+        return false;
+    }
+
+    // Read strings, interning each exactly once.
+    mStringTable.setSize( stringCount );
+    for( U32 index = 0; index < stringCount; ++index )
+        mStringTable[index] = stream.readSTString();
+
+    return stream.getStatus() != Stream::IOError;
+}
+
+//-----------------------------------------------------------------------------
+
+StringTableEntry TamlBinaryReader::readName( Stream& stream, const U32 versionId )
+{
+    // Read inline string if the version predates the string table.
+    if ( versionId < 3 )
+        return stream.readSTString();
+
+    // Read string index.
+    U32 index = 0;
+    stream.read( &index );
+
+    // Is the index valid?
+    if ( index >= (U32)mStringTable.size() )
+    {
+        // No, so warn.
+        Con::warnf("Taml: Encountered an invalid string index '%d' in binary file.", index );
+        return StringTable->EmptyString();
+    }
+
+    return mStringTable[index];
+}
+
+//-----------------------------------------------------------------------------
+
 SimObject* TamlBinaryReader::parseElement( Stream& stream, const U32 versionId )
 {
     // Debug Profiling.
@@ -106,10 +164,10 @@ SimObject* TamlBinaryReader::parseElement( Stream& stream, const U32 versionId )
 #endif
 
     // Fetch element name.    
-    StringTableEntry typeName = stream.readSTString();
+    StringTableEntry typeName = readName( stream, versionId );
 
     // Fetch object name.
-    StringTableEntry objectName = stream.readSTString();
+    StringTableEntry objectName = readName( stream, versionId );
 
     // Read references.
     U32 tamlRefId;
@@ -234,7 +292,7 @@ void TamlBinaryReader::parseAttributes( Stream& stream, SimObject* pSimObject, c
     for ( U32 index = 0; index < attributeCount; ++index )
     {
         // Fetch attribute.
-        StringTableEntry attributeName = stream.readSTString();
+        StringTableEntry attributeName = readName( stream, versionId );
         stream.readLongString( 4096, valueBuffer );
 
         // We can assume this is a field for now.
@@ -338,7 +396,7 @@ void TamlBinaryReader::parseCustomElements( Stream& stream, TamlCallbacks* pCall
     for ( U32 nodeIndex = 0; nodeIndex < customNodeCount; ++nodeIndex )
     {
         //Read custom node name.
-        StringTableEntry nodeName = stream.readSTString();
+        StringTableEntry nodeName = readName( stream, versionId );
 
         // Add custom node.
         TamlCustomNode* pCustomNode = customNodes.addNode( nodeName );
@@ -380,7 +438,7 @@ void TamlBinaryReader::parseCustomNode( Stream& stream, TamlCustomNode* pCustomN
     }
 
     // No, so read custom node name.
-    StringTableEntry nodeName = stream.readSTString();
+    StringTableEntry nodeName = readName( stream, versionId );
 
     // Add child node.
     TamlCustomNode* pChildNode = pCustomNode->addNode( nodeName );
@@ -416,7 +474,7 @@ void TamlBinaryReader::parseCustomNode( Stream& stream, TamlCustomNode* pCustomN
         for( U32 childFieldIndex = 0; childFieldIndex < childFieldCount; ++childFieldIndex )
         {
             // Read field name.
-            StringTableEntry fieldName = stream.readSTString();
+            StringTableEntry fieldName = readName( stream, versionId );
 
             // Read field value.
             char valueBuffer[MAX_TAML_NODE_FIELDVALUE_LENGTH];
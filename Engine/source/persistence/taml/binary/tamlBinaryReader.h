@@ -46,7 +46,8 @@ public:
     virtual ~TamlBinaryReader() {}
 
     /// Read.
-    SimObject* read( FileStream& stream );
+    /// Any stream may be used, e.g. a MemStream over a memory-mapped file.
+    SimObject* read( Stream& stream );
 
 private:
     Taml* mpTaml;
@@ -55,9 +56,15 @@ private:
 
     typeObjectReferenceHash mObjectReferenceMap;
 
+    /// Names interned once per file (version 3 onwards).
+    Vector<StringTableEntry> mStringTable;
+
 private:
     void resetParse( void );
 
+    bool parseStringTable( Stream& stream, const U32 versionId );
+    StringTableEntry readName( Stream& stream, const U32 versionId );
+
     SimObject* parseElement( Stream& stream, const U32 versionId );
     void parseAttributes( Stream& stream, SimObject* pSimObject, const U32 versionId );
     void parseChildren( Stream& stream, TamlCallbacks* pCallbacks, SimObject* pSimObject, const U32 versionId );
@@ -45,6 +45,11 @@ bool TamlBinaryWriter::write( FileStream& stream, const TamlWriteNode* pTamlWrit
     // Write compressed flag.
     stream.write( compressed );
 
+    // Gather every name so each is written, and interned on read, only once.
+    mStringIndices.clear();
+    mStrings.clear();
+    collectStrings( pTamlWriteNode );
+
     // Are we compressed?
     if ( compressed )
     {
@@ -52,6 +57,9 @@ bool TamlBinaryWriter::write( FileStream& stream, const TamlWriteNode* pTamlWrit
         ZipSubWStream zipStream;
         zipStream.attachStream( &stream );
 
+        // Write string table.
+        writeStringTable( zipStream );
+
         // Write element.
         writeElement( zipStream, pTamlWriteNode );
 
@@ -60,7 +68,10 @@ bool TamlBinaryWriter::write( FileStream& stream, const TamlWriteNode* pTamlWrit
     }
     else
     {
-        // No, so write element.
+        // No, so write string table.
+        writeStringTable( stream );
+
+        // Write element.
         writeElement( stream, pTamlWriteNode );
     }
 
@@ -69,6 +80,114 @@ bool TamlBinaryWriter::write( FileStream& stream, const TamlWriteNode* pTamlWrit
 
 //-----------------------------------------------------------------------------
 
+void TamlBinaryWriter::collectStrings( const TamlWriteNode* pTamlWriteNode )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryWriter_CollectStrings);
+
+    // Element and object names.
+    addString( pTamlWriteNode->mpSimObject->getClassName() );
+    addString( pTamlWriteNode->mpObjectName != NULL ? pTamlWriteNode->mpObjectName : StringTable->EmptyString() );
+
+    // Finish if this is a reference to another node.
+    if ( pTamlWriteNode->mRefToNode != NULL )
+        return;
+
+    // Attribute names.
+    const Vector<TamlWriteNode::FieldValuePair*>& fields = pTamlWriteNode->mFields;
+    for( Vector<TamlWriteNode::FieldValuePair*>::const_iterator itr = fields.begin(); itr != fields.end(); ++itr )
+        addString( (*itr)->mName );
+
+    // Children.
+    Vector<TamlWriteNode*>* pChildren = pTamlWriteNode->mChildren;
+    if ( pChildren != NULL )
+    {
+        for( Vector<TamlWriteNode*>::iterator itr = pChildren->begin(); itr != pChildren->end(); ++itr )
+            collectStrings( (*itr) );
+    }
+
+    // Custom nodes.
+    const TamlCustomNodeVector& nodes = pTamlWriteNode->mCustomNodes.getNodes();
+    for( TamlCustomNodeVector::const_iterator customNodesItr = nodes.begin(); customNodesItr != nodes.end(); ++customNodesItr )
+    {
+        TamlCustomNode* pCustomNode = *customNodesItr;
+
+        addString( pCustomNode->getNodeName() );
+
+        const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
+        for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
+            collectCustomNodeStrings( *childNodeItr );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryWriter::collectCustomNodeStrings( const TamlCustomNode* pCustomNode )
+{
+    // Is the node a proxy object?
+    if ( pCustomNode->isProxyObject() )
+    {
+        // Yes, so collect the element.
+        collectStrings( pCustomNode->getProxyWriteNode() );
+        return;
+    }
+
+    addString( pCustomNode->getNodeName() );
+
+    const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
+    for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
+        collectCustomNodeStrings( *childNodeItr );
+
+    const TamlCustomFieldVector& fields = pCustomNode->getFields();
+    for ( TamlCustomFieldVector::const_iterator fieldItr = fields.begin(); fieldItr != fields.end(); ++fieldItr )
+        addString( (*fieldItr)->getFieldName() );
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryWriter::addString( const char* pString )
+{
+    StringTableEntry string = StringTable->insert( pString );
+
+    // Finish if we already have it.
+    if ( mStringIndices.find( string ) != mStringIndices.end() )
+        return;
+
+    mStringIndices.insert( string, (U32)mStrings.size() );
+    mStrings.push_back( string );
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryWriter::writeStringTable( Stream& stream )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryWriter_WriteStringTable);
+
+    // Write string count.
+    stream.write( (U32)mStrings.size() );
+
+    // Write strings.
+    for( Vector<StringTableEntry>::iterator itr = mStrings.begin(); itr != mStrings.end(); ++itr )
+        stream.writeString( *itr );
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryWriter::writeName( Stream& stream, const char* pName )
+{
+    // Fetch string index.
+    typeStringIndexHash::iterator itr = mStringIndices.find( StringTable->insert( pName ) );
+
+    // Sanity!
+    AssertFatal( itr != mStringIndices.end(), "Taml: Name was not collected into the string table." );
+
+    // Write string index.
+    stream.write( itr->value );
+}
+
+//-----------------------------------------------------------------------------
+
 void TamlBinaryWriter::writeElement( Stream& stream, const TamlWriteNode* pTamlWriteNode )
 {
     // Debug Profiling.
@@ -81,13 +200,13 @@ void TamlBinaryWriter::writeElement( Stream& stream, const TamlWriteNode* pTamlW
     const char* pElementName = pSimObject->getClassName();
 
     // Write element name.
-    stream.writeString( pElementName );
+    writeName( stream, pElementName );
 
     // Fetch object name.
     const char* pObjectName = pTamlWriteNode->mpObjectName;
 
     // Write object name.
-    stream.writeString( pObjectName != NULL ? pObjectName : StringTable->EmptyString() );
+    writeName( stream, pObjectName != NULL ? pObjectName : StringTable->EmptyString() );
 
     // Fetch reference Id.
     const U32 tamlRefId = pTamlWriteNode->mRefId;
@@ -148,7 +267,7 @@ void TamlBinaryWriter::writeAttributes( Stream& stream, const TamlWriteNode* pTa
         TamlWriteNode::FieldValuePair* pFieldValue = (*itr);
 
         // Write attribute.
-        stream.writeString( pFieldValue->mName );
+        writeName( stream, pFieldValue->mName );
         stream.writeLongString( 4096, pFieldValue->mpValue );
     }
 }
@@ -207,7 +326,7 @@ void TamlBinaryWriter::writeCustomElements( Stream& stream, const TamlWriteNode*
         TamlCustomNode* pCustomNode = *customNodesItr;
 
         // Write custom node name.
-        stream.writeString( pCustomNode->getNodeName() );
+        writeName( stream, pCustomNode->getNodeName() );
 
         // Fetch node children.
         const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
@@ -243,7 +362,7 @@ void TamlBinaryWriter::writeCustomNode( Stream& stream, const TamlCustomNode* pC
     stream.write( false );
 
     // Write custom node name.
-    stream.writeString( pCustomNode->getNodeName() );
+    writeName( stream, pCustomNode->getNodeName() );
 
     // Write custom node text.
     stream.writeLongString(MAX_TAML_NODE_FIELDVALUE_LENGTH, pCustomNode->getNodeTextField().getFieldValue());
@@ -290,7 +409,7 @@ void TamlBinaryWriter::writeCustomNode( Stream& stream, const TamlCustomNode* pC
             const TamlCustomField* pField = *fieldItr;
 
             // Write the node field.
-            stream.writeString( pField->getFieldName() );
+            writeName( stream, pField->getFieldName() );
             stream.writeLongString( MAX_TAML_NODE_FIELDVALUE_LENGTH, pField->getFieldValue() );
         }
     }
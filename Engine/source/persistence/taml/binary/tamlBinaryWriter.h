@@ -27,6 +27,10 @@
 #include "persistence/taml/taml.h"
 #endif
 
+#ifndef _TDICTIONARY_H_
+#include "core/util/tDictionary.h"
+#endif
+
 //-----------------------------------------------------------------------------
 
 /// @ingroup tamlGroup
@@ -36,7 +40,7 @@ class TamlBinaryWriter
 public:
     TamlBinaryWriter( Taml* pTaml ) :
         mpTaml( pTaml ),
-        mVersionId(2)
+        mVersionId(3)
     {
     }
     virtual ~TamlBinaryWriter() {}
@@ -48,7 +52,19 @@ private:
     Taml* mpTaml;
     const U32 mVersionId;
 
+    typedef HashMap<StringTableEntry, U32> typeStringIndexHash;
+
+    /// Names written once up-front and referenced by index.
+    typeStringIndexHash mStringIndices;
+    Vector<StringTableEntry> mStrings;
+
 private:
+    void collectStrings( const TamlWriteNode* pTamlWriteNode );
+    void collectCustomNodeStrings( const TamlCustomNode* pCustomNode );
+    void addString( const char* pString );
+    void writeStringTable( Stream& stream );
+    void writeName( Stream& stream, const char* pName );
+
     void writeElement( Stream& stream, const TamlWriteNode* pTamlWriteNode );
     void writeAttributes( Stream& stream, const TamlWriteNode* pTamlWriteNode );
     void writeChildren( Stream& stream, const TamlWriteNode* pTamlWriteNode );
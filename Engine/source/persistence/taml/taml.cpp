@@ -74,6 +74,10 @@
 #include "assets/assetBase.h"
 #endif
 
+#ifndef _MEMSTREAM_H_
+#include "core/stream/memStream.h"
+#endif
+
 // Script bindings.
 #include "taml_ScriptBinding.h"
 
@@ -255,27 +259,56 @@ ImplementEnumType(_TamlFormatMode,
       // Expand the file-name into the file-path buffer.
       Con::expandToolScriptFilename(mFilePathBuffer, sizeof(mFilePathBuffer), pFilename);
 
-      FileStream stream;
+      // Get the file auto-format mode.
+      const TamlFormatMode formatMode = getFileAutoFormatMode(mFilePathBuffer);
 
-      // File opened?
-      if (!stream.open(mFilePathBuffer, Torque::FS::File::Read))
+      SimObject* pSimObject = NULL;
+
+      // Binary files are parsed straight from a mapping of the file when the file system supports it.
+      Torque::FS::FileRef mappedFile;
+      U32 mappedSize = 0;
+      U8* pMappedData = NULL;
+      if (formatMode == BinaryFormat)
       {
-         // No, so warn.
-         Con::warnf("Taml::read() - Could not open filename '%s' for read.", mFilePathBuffer);
-         return NULL;
+         mappedFile = Torque::FS::OpenFile(mFilePathBuffer, Torque::FS::File::Read);
+         pMappedData = mappedFile != NULL ? mappedFile->map(mappedSize) : NULL;
       }
 
-      // Get the file auto-format mode.
-      const TamlFormatMode formatMode = getFileAutoFormatMode(mFilePathBuffer);
+      if (pMappedData != NULL)
+      {
+         MemStream stream(mappedSize, pMappedData, true, false);
 
-      // Reset the compilation.
-      resetCompilation();
+         // Reset the compilation.
+         resetCompilation();
 
-      // Write object.
-      SimObject* pSimObject = read(stream, formatMode);
+         // Read object.
+         TamlBinaryReader reader(this);
+         pSimObject = reader.read(stream);
 
-      // Close file.
-      stream.close();
+         // Release mapping.
+         mappedFile->unmap();
+      }
+      else
+      {
+         FileStream stream;
+
+         // File opened?
+         if (!stream.open(mFilePathBuffer, Torque::FS::File::Read))
+         {
+            // No, so warn.
+            Con::warnf("Taml::read() - Could not open filename '%s' for read.", mFilePathBuffer);
+            return NULL;
+         }
+
+         // Reset the compilation.
+         resetCompilation();
+
+         // Read object.
+         pSimObject = read(stream, formatMode);
+
+         // Close file.
+         stream.close();
+      }
 
       // Reset the compilation.
       resetCompilation();
@@ -296,6 +329,51 @@ ImplementEnumType(_TamlFormatMode,
 
    //-----------------------------------------------------------------------------
 
+   bool Taml::writeStream(FileStream& stream, SimObject* pSimObject)
+   {
+      // Debug Profiling.
+      PROFILE_SCOPE(Taml_WriteStream);
+
+      // Sanity!
+      AssertFatal(pSimObject != NULL, "Cannot write a NULL object.");
+
+      // Reset the compilation.
+      resetCompilation();
+
+      // Write object.
+      const bool status = write(stream, pSimObject, mFormatMode);
+
+      // Reset the compilation.
+      resetCompilation();
+
+      return status;
+   }
+
+   //-----------------------------------------------------------------------------
+
+   SimObject* Taml::readStream(FileStream& stream)
+   {
+      // Debug Profiling.
+      PROFILE_SCOPE(Taml_ReadStream);
+
+      // Reset the compilation.
+      resetCompilation();
+
+      // Read object.
+      SimObject* pSimObject = read(stream, mFormatMode);
+
+      // Reset the compilation.
+      resetCompilation();
+
+      // Did we generate an object?
+      if (pSimObject != NULL)
+         pSimObject->onPostAdd();
+
+      return pSimObject;
+   }
+
+   //-----------------------------------------------------------------------------
+
    bool Taml::write(FileStream& stream, SimObject* pSimObject, const TamlFormatMode formatMode)
    {
       // Sanity!
@@ -779,28 +857,27 @@ ImplementEnumType(_TamlFormatMode,
       Vector<SimFieldDictionary::Entry*> dynamicFieldList(__FILE__, __LINE__);
 
       // Ensure the dynamic field doesn't conflict with static field.
-      for (U32 hashIndex = 0; hashIndex < SimFieldDictionary::HashTableSize; ++hashIndex)
+      for (SimFieldDictionaryIterator itr(pFieldDictionary); *itr; ++itr)
       {
-         for (SimFieldDictionary::Entry* pEntry = pFieldDictionary->mHashTable[hashIndex]; pEntry; pEntry = pEntry->next)
+         SimFieldDictionary::Entry* pEntry = *itr;
+
+         // Iterate static fields.
+         U32 fieldIndex;
+         for (fieldIndex = 0; fieldIndex < fieldCount; ++fieldIndex)
          {
-            // Iterate static fields.
-            U32 fieldIndex;
-            for (fieldIndex = 0; fieldIndex < fieldCount; ++fieldIndex)
-            {
-               if (fieldList[fieldIndex].pFieldname == pEntry->slotName)
-                  break;
-            }
+            if (fieldList[fieldIndex].pFieldname == pEntry->slotName)
+               break;
+         }
 
-            // Skip if found.
-            if (fieldIndex != (U32)fieldList.size())
-               continue;
+         // Skip if found.
+         if (fieldIndex != (U32)fieldList.size())
+            continue;
 
-            // Skip if not writing field.
-            if (!pSimObject->writeField(pEntry->slotName, pEntry->value))
-               continue;
+         // Skip if not writing field.
+         if (!pSimObject->writeField(pEntry->slotName, pEntry->value))
+            continue;
 
-            dynamicFieldList.push_back(pEntry);
-         }
+         dynamicFieldList.push_back(pEntry);
       }
 
       // Sort Entries to prevent version control conflicts
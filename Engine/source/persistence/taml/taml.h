@@ -172,6 +172,10 @@ public:
     /// Write.
     bool write( SimObject* pSimObject, const char* pFilename );
 
+    /// Write to / read from an open stream at its current position using the current format mode.
+    bool writeStream( FileStream& stream, SimObject* pSimObject );
+    SimObject* readStream( FileStream& stream );
+
     /// Read.
     template<typename T> inline T* read( const char* pFilename )
     {
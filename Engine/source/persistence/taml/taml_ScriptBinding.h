@@ -300,6 +300,47 @@ DefineEngineFunction(TamlRead, const char*, (const char* filename, const char* f
 
 //-----------------------------------------------------------------------------
 
+DefineEngineFunction(TamlCook, bool, (const char* sourceFilename, const char* targetFilename, bool compressed), (true),    "(sourceFilename, targetFilename, [compressed]) - Cook a Taml file into the binary format.\n"
+                                                "The source format is chosen from its extension.  Cooked files are read faster as every name is interned once and the file is parsed in-place.\n"
+                                                "@param sourceFilename The Taml file to read from.\n"
+                                                "@param targetFilename The binary file to write to.\n"
+                                                "@param compressed Whether the binary file is compressed or not.  Optional: Defaults to true.\n"
+                                                "@return Whether the file was cooked or not.")
+{
+    // Read source object using the auto-format.
+    Taml sourceTaml;
+    SimObject* pSimObject = sourceTaml.read( sourceFilename );
+
+    // Did we find the object?
+    if ( pSimObject == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "TamlCook() - Could not read object from file '%s'.", sourceFilename );
+        return false;
+    }
+
+    // Write binary.
+    Taml targetTaml;
+    targetTaml.setFormatMode( Taml::BinaryFormat );
+    targetTaml.setBinaryCompression( compressed );
+    targetTaml.setAutoFormat( false );
+    const bool status = targetTaml.write( pSimObject, targetFilename );
+
+    // Remove the object.
+    pSimObject->deleteObject();
+
+    // Did we write the object?
+    if ( !status )
+    {
+        // No, so warn.
+        Con::warnf( "TamlCook() - Could not write object to file '%s'.", targetFilename );
+    }
+
+    return status;
+}
+
+//-----------------------------------------------------------------------------
+
 DefineEngineFunction(GenerateTamlSchema, bool, (), , "() - Generate a TAML schema file of all engine types.\n"
                                                 "The schema file is specified using the console variable '" TAML_SCHEMA_VARIABLE "'.\n"
                                                 "@return Whether the schema file was writtent or not." )
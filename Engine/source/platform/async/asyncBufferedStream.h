@@ -29,8 +29,8 @@
 #ifndef _THREADPOOL_H_
    #include "platform/threads/threadPool.h"
 #endif
-#ifndef _THREADSAFEDEQUE_H_
-   #include "platform/threads/threadSafeDeque.h"
+#ifndef _THREADSAFERINGBUFFER_H_
+   #include "platform/threads/threadSafeRingBuffer.h"
 #endif
 
 
@@ -82,9 +82,10 @@ class AsyncBufferedInputStream : public IInputStreamFilter< T, Stream >,
 
    protected:
 
-      /// Stream elements are kept on deques that can be concurrently
-      /// accessed by multiple threads.
-      typedef ThreadSafeDeque< ElementType > ElementList;
+      /// Stream elements are kept on ring buffers that can be concurrently
+      /// accessed by multiple threads.  The request chain never buffers
+      /// more than the lookahead, so a bounded queue suffices.
+      typedef ThreadSafeRingBuffer< ElementType > ElementList;
 
       /// If true, the stream will restart over from the beginning once
       /// it has been read in entirety.
@@ -170,6 +171,7 @@ AsyncBufferedInputStream< T, Stream >::AsyncBufferedInputStream
      mNumRemainingSourceElements( numSourceElementsToRead ),
      mNumBufferedElements( 0 ),
      mMaxBufferedElements( numReadAhead ),
+     mBufferedElements( numReadAhead + 1 ),
      mThreadPool( threadPool ),
      mThreadContext( threadContext )
 {
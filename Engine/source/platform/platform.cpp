@@ -23,6 +23,7 @@
 #include <limits>
 
 #include "platform/platform.h"
+#include "platform/platformTimer.h"
 #include "console/console.h"
 #include "console/consoleTypes.h"
 #include "platform/threads/mutex.h"
@@ -55,6 +56,12 @@ void Platform::initConsole()
 	   "@ingroup Platform\n");
    Con::addVariable("$platform::timeManagerProcessInterval", TypeS32, &sgTimeManagerProcessInterval, "Controls processor time usage when the game window is in focus.\n"
 	   "@ingroup Platform\n");
+   Con::addVariable("$platform::timeManagerSpinTail", TypeS32, &TimeManager::smSpinTailUs, "Microseconds at the end of each wait between time events that are spent spinning instead of sleeping. "
+      "Higher values give more even frame pacing at the cost of CPU time.\n"
+	   "@ingroup Platform\n");
+   Con::addVariable("$platform::journalRealTime", TypeBool, &TimeManager::smJournalRealTime, "If false, journal playback runs as fast as possible instead of waiting "
+      "between time events as long as the recording did.  Use this to replay recorded server sessions as benchmarks.\n"
+	   "@ingroup Platform\n");
 }
 
 S32 Platform::getBackgroundSleepTime()
@@ -192,6 +192,10 @@ namespace Platform
    /// @see PlatformTimer
    U32 getRealMilliseconds();
 
+   /// Returns the microseconds elapsed on a monotonic high resolution clock.
+   /// Only the difference between two values is meaningful.
+   U64 getRealMicroseconds();
+
    void advanceTime(U32 delta);
    S32 getBackgroundSleepTime();
 
@@ -208,6 +212,11 @@ namespace Platform
    
    // Process control
    void sleep(U32 ms);
+
+   /// Sleep for roughly @a us microseconds.  The granularity depends on the
+   /// OS scheduler, so callers that need a precise wakeup should sleep short
+   /// of the target and spin the rest.
+   void sleepMicroseconds(U32 us);
    bool excludeOtherInstances(const char *string);
    bool checkOtherInstances(const char *string);
    void restartInstance();
@@ -28,8 +28,12 @@
 #include "console/console.h"
 #include "platform/profiler.h"
 #include "platform/threads/mutex.h"
+#include "platform/platformIntrinsics.h"
+#include "platform/platformTLS.h"
 #include "core/module.h"
 
+#include <new>
+
 // If profile paths are enabled, disable profiling of the
 // memory manager as that would cause a cyclic dependency
 // through the string table's allocation stuff used by the
@@ -47,6 +51,10 @@
 #ifdef TORQUE_MULTITHREAD
 void * gMemMutex = NULL;
 #endif
+
+#if defined(TORQUE_MEMORY_TAGS) && !defined(TORQUE_DISABLE_MEMORY_MANAGER)
+#  error "TORQUE_MEMORY_TAGS requires TORQUE_DISABLE_MEMORY_MANAGER"
+#endif
    
 //-------------------------------------- Make sure we don't have the define set
 #ifdef new
@@ -1714,6 +1722,233 @@ void setMinimumAllocUnit(U32 allocUnit)
 
 //---------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------
+//    Memory tags.
+//---------------------------------------------------------------------------
+
+namespace Memory
+{
+
+struct TagCounters
+{
+   const char* name;
+   volatile U64 liveBytes;
+   volatile U64 peakBytes;
+   volatile U32 liveAllocs;
+   volatile U32 totalAllocs;
+};
+
+// Plain data only; allocations may well happen before static constructors run.
+static TagCounters gTags[ MaxTags ] = { { "Untagged", 0, 0, 0, 0 } };
+static volatile U32 gNumTags = 1;
+static volatile U32 gTagLock = 0;
+
+static U8 gTagStorageData[ sizeof( ThreadStorage ) ];
+
+static ThreadStorage& getTagStorage()
+{
+   static ThreadStorage* sStorage = ::new ( gTagStorageData ) ThreadStorage;
+   return *sStorage;
+}
+
+U32 registerTag( const char* name )
+{
+   while( !dCompareAndSwap( gTagLock, 0, 1 ) )
+      ;
+
+   U32 tag = 0;
+   for( ; tag < gNumTags; ++ tag )
+      if( dStrcmp( gTags[ tag ].name, name ) == 0 )
+         break;
+
+   if( tag == gNumTags )
+   {
+      if( gNumTags < MaxTags )
+      {
+         gTags[ tag ].name = name;
+         gNumTags ++;
+      }
+      else
+         tag = TAG_Untagged;
+   }
+
+   dCompareAndSwap( gTagLock, 1, 0 );
+   return tag;
+}
+
+U32 getCurrentTag()
+{
+   return U32( uintptr_t( getTagStorage().get() ) );
+}
+
+U32 setCurrentTag( U32 tag )
+{
+   AssertFatal( tag < MaxTags, "Memory::setCurrentTag - Invalid tag" );
+
+   ThreadStorage& storage = getTagStorage();
+   const U32 prevTag = U32( uintptr_t( storage.get() ) );
+   storage.set( reinterpret_cast< void* >( uintptr_t( tag ) ) );
+   return prevTag;
+}
+
+U32 getNumTags()
+{
+   return dAtomicRead( gNumTags );
+}
+
+void getTagStats( U32 tag, TagStats& outStats )
+{
+   AssertFatal( tag < getNumTags(), "Memory::getTagStats - Invalid tag" );
+
+   const TagCounters& counters = gTags[ tag ];
+   outStats.mName = counters.name;
+   outStats.mLiveBytes = dsize_t( counters.liveBytes );
+   outStats.mPeakBytes = dsize_t( counters.peakBytes );
+   outStats.mLiveAllocs = counters.liveAllocs;
+   outStats.mTotalAllocs = counters.totalAllocs;
+}
+
+void dumpTags()
+{
+   TagStats stats[ MaxTags ];
+   const U32 numTags = getNumTags();
+
+   // Insertion sort by live bytes, largest first.
+   for( U32 i = 0; i < numTags; ++ i )
+   {
+      TagStats tagStats;
+      getTagStats( i, tagStats );
+
+      U32 n = i;
+      for( ; n > 0 && stats[ n - 1 ].mLiveBytes < tagStats.mLiveBytes; -- n )
+         stats[ n ] = stats[ n - 1 ];
+      stats[ n ] = tagStats;
+   }
+
+   Con::printf( "%-24s %12s %12s %10s %12s", "Tag", "Live KB", "Peak KB", "Allocs", "Total Allocs" );
+   for( U32 i = 0; i < numTags; ++ i )
+      Con::printf( "%-24s %12d %12d %10d %12d", stats[ i ].mName,
+         U32( stats[ i ].mLiveBytes / 1024 ), U32( stats[ i ].mPeakBytes / 1024 ),
+         stats[ i ].mLiveAllocs, stats[ i ].mTotalAllocs );
+}
+
+#ifdef TORQUE_MEMORY_TAGS
+
+enum
+{
+   TagMagic = 0x4D544147 // 'MTAG'
+};
+
+/// Header in front of every tagged block.  16 bytes so the user pointer
+/// keeps the alignment of malloc.
+struct TagHeader
+{
+   U64 size;
+   U32 tag;
+   U32 magic;
+};
+
+static void chargeTag( U32 tag, dsize_t size )
+{
+   TagCounters& counters = gTags[ tag ];
+
+   dFetchAndAdd( counters.liveAllocs, 1 );
+   dFetchAndAdd( counters.totalAllocs, 1 );
+
+   U64 liveBytes;
+   do
+      liveBytes = counters.liveBytes;
+   while( !dCompareAndSwap( counters.liveBytes, liveBytes, liveBytes + size ) );
+   liveBytes += size;
+
+   U64 peakBytes;
+   while( ( peakBytes = counters.peakBytes ) < liveBytes )
+      if( dCompareAndSwap( counters.peakBytes, peakBytes, liveBytes ) )
+         break;
+}
+
+static void releaseTag( U32 tag, dsize_t size )
+{
+   TagCounters& counters = gTags[ tag ];
+
+   dFetchAndAdd( counters.liveAllocs, U32( -1 ) );
+
+   U64 liveBytes;
+   do
+      liveBytes = counters.liveBytes;
+   while( !dCompareAndSwap( counters.liveBytes, liveBytes, liveBytes - size ) );
+}
+
+static void* taggedAlloc( dsize_t size )
+{
+   TagHeader* header = ( TagHeader* ) malloc( sizeof( TagHeader ) + size );
+   if( !header )
+      return NULL;
+
+   header->size = size;
+   header->tag = getCurrentTag();
+   header->magic = TagMagic;
+
+   chargeTag( header->tag, size );
+   return header + 1;
+}
+
+static void taggedFree( void* mem )
+{
+   if( !mem )
+      return;
+
+   TagHeader* header = ( ( TagHeader* ) mem ) - 1;
+   AssertFatal( header->magic == TagMagic, "Memory::taggedFree - Block was not allocated through dMalloc or new" );
+
+   releaseTag( header->tag, dsize_t( header->size ) );
+   header->magic = 0;
+   free( header );
+}
+
+static void* taggedRealloc( void* mem, dsize_t size )
+{
+   if( !mem )
+      return taggedAlloc( size );
+
+   if( !size )
+   {
+      taggedFree( mem );
+      return NULL;
+   }
+
+   TagHeader* header = ( ( TagHeader* ) mem ) - 1;
+   AssertFatal( header->magic == TagMagic, "Memory::taggedRealloc - Block was not allocated through dMalloc or new" );
+
+   // Blocks stay charged to the tag they were first allocated under.
+   const U32 tag = header->tag;
+   const dsize_t oldSize = dsize_t( header->size );
+
+   TagHeader* newHeader = ( TagHeader* ) realloc( header, sizeof( TagHeader ) + size );
+   if( !newHeader )
+      return NULL;
+
+   newHeader->size = size;
+   releaseTag( tag, oldSize );
+   chargeTag( tag, size );
+
+   return newHeader + 1;
+}
+
+#endif // TORQUE_MEMORY_TAGS
+
+} // namespace Memory
+
+DefineEngineFunction( dumpMemoryTags, void, (),,
+   "@brief Print live bytes, peak bytes and allocation counts of all memory tags to the console.\n\n"
+   "@note Nothing is charged to tags unless the engine is built with TORQUE_MEMORY_TAGS defined.\n\n"
+   "@ingroup Debugging" )
+{
+   Memory::dumpTags();
+}
+
+//---------------------------------------------------------------------------
+
 #if !defined(TORQUE_DISABLE_MEMORY_MANAGER)
 
 // Manage our own memory, add overloaded memory operators and functions
@@ -1773,6 +2008,69 @@ AFTER_MODULE_INIT( Sim )
       "@ingroup Debugging" );
 }
 
+#elif defined(TORQUE_MEMORY_TAGS)
+
+// Use the system allocator but charge everything to memory tags
+
+void* FN_CDECL operator new(dsize_t size)
+{
+   void* mem = Memory::taggedAlloc(size);
+   AssertISV(mem, "operator new - Out of memory");
+   return mem;
+}
+
+void* FN_CDECL operator new[](dsize_t size)
+{
+   void* mem = Memory::taggedAlloc(size);
+   AssertISV(mem, "operator new - Out of memory");
+   return mem;
+}
+
+void* FN_CDECL operator new(dsize_t size, const std::nothrow_t&) throw()
+{
+   return Memory::taggedAlloc(size);
+}
+
+void* FN_CDECL operator new[](dsize_t size, const std::nothrow_t&) throw()
+{
+   return Memory::taggedAlloc(size);
+}
+
+void FN_CDECL operator delete(void* mem) throw()
+{
+   Memory::taggedFree(mem);
+}
+
+void FN_CDECL operator delete[](void* mem) throw()
+{
+   Memory::taggedFree(mem);
+}
+
+void FN_CDECL operator delete(void* mem, const std::nothrow_t&) throw()
+{
+   Memory::taggedFree(mem);
+}
+
+void FN_CDECL operator delete[](void* mem, const std::nothrow_t&) throw()
+{
+   Memory::taggedFree(mem);
+}
+
+void* dMalloc_r(dsize_t in_size, const char* fileName, const dsize_t line)
+{
+   return Memory::taggedAlloc(in_size);
+}
+
+void dFree(void* in_pFree)
+{
+   Memory::taggedFree(in_pFree);
+}
+
+void* dRealloc_r(void* in_pResize, dsize_t in_size, const char* fileName, const dsize_t line)
+{
+   return Memory::taggedRealloc(in_pResize, in_size);
+}
+
 #else
 
 // Don't manage our own memory
@@ -54,6 +54,80 @@ namespace Memory
    dsize_t     getMemoryAllocated();
    void        getMemoryInfo( void* ptr, Info& info );
    void        validate();
+
+   /// @name Memory Tags
+   ///
+   /// With TORQUE_MEMORY_TAGS defined, every dMalloc and operator new
+   /// allocation is charged to the memory tag that is current on the
+   /// allocating thread.  Live bytes, peak bytes and allocation counts are
+   /// kept per tag so memory can be budgeted per subsystem in running
+   /// builds.  Use MEMORY_TAG_SCOPE to make a tag current for a scope.
+   ///
+   /// Without the define, tags can still be registered but nothing is
+   /// ever charged to them.
+   /// @{
+
+   enum
+   {
+      /// Maximum number of distinct tags.  Registering more tags charges
+      /// allocations to TAG_Untagged.
+      MaxTags = 64,
+
+      /// Tag of allocations made outside of any tag scope.
+      TAG_Untagged = 0
+   };
+
+   struct TagStats
+   {
+      const char* mName;
+      dsize_t     mLiveBytes;
+      dsize_t     mPeakBytes;
+      U32         mLiveAllocs;
+      U32         mTotalAllocs;
+   };
+
+   /// Return the tag for @a name, registering it if it does not exist yet.
+   /// @a name must stay valid for the lifetime of the process.
+   U32         registerTag( const char* name );
+
+   /// Return the tag that allocations on the calling thread are charged to.
+   U32         getCurrentTag();
+
+   /// Make @a tag current on the calling thread and return the previous tag.
+   U32         setCurrentTag( U32 tag );
+
+   /// Return the number of registered tags including TAG_Untagged.
+   U32         getNumTags();
+
+   /// Fill in @a outStats for @a tag.
+   /// @note Only a snapshot when other threads are allocating.
+   void        getTagStats( U32 tag, TagStats& outStats );
+
+   /// Print all tags sorted by live bytes to the console.
+   void        dumpTags();
+
+   /// Makes a tag current for the lifetime of the object.
+   class TagScope
+   {
+      protected:
+         U32 mPrevTag;
+
+      public:
+         TagScope( U32 tag ) { mPrevTag = setCurrentTag( tag ); }
+         ~TagScope() { setCurrentTag( mPrevTag ); }
+   };
+
+   /// @}
 }
 
+#ifdef TORQUE_MEMORY_TAGS
+   /// Charge all allocations in the enclosing scope to the memory tag @a name.
+   /// Nested scopes take precedence over outer ones.
+   #define MEMORY_TAG_SCOPE( name ) \
+      static const U32 _memoryTag##name = Memory::registerTag( #name ); \
+      Memory::TagScope _memoryTagScope##name( _memoryTag##name )
+#else
+   #define MEMORY_TAG_SCOPE( name )
+#endif
+
 #endif // _TORQUE_PLATFORM_PLATFORMMEMORY_H_
@@ -93,6 +93,11 @@ typedef int SOCKET;
 
 #define closesocket close
 
+// recvmmsg()/sendmmsg() let us move a whole batch of datagrams per system call.
+#if defined( MSG_WAITFORONE )
+#define TORQUE_NET_BATCHED_IO
+#endif
+
 #endif
 
 #if defined(TORQUE_USE_WINSOCK)
@@ -130,6 +135,8 @@ static const char* strerror_wsa( S32 code )
 #include "console/console.h"
 #include "core/util/journal/process.h"
 #include "core/util/journal/journal.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/threadSafeRingBuffer.h"
 
 
 NetSocket NetSocket::INVALID = NetSocket::fromHandle(-1);
@@ -183,6 +190,12 @@ const SOCKET InvalidSocketHandle = -1;
 static void IPSocketToNetAddress(const struct sockaddr_in *sockAddr, NetAddress *address);
 static void IPSocket6ToNetAddress(const struct sockaddr_in6 *sockAddr, NetAddress *address);
 
+namespace PlatformNetState
+{
+   static void startReceiveThread();
+   static void stopReceiveThread();
+}
+
 namespace PlatformNetState
 {
    static S32 initCount = 0;
@@ -504,6 +517,12 @@ bool Net::smMulticastEnabled = true;
 bool Net::smIpv4Enabled = true;
 bool Net::smIpv6Enabled = false;
 //
+// Batched socket I/O
+bool Net::smBatchedIO = true;
+//
+// Receive thread
+bool Net::smThreadedIO = false;
+//
 
 // the Socket structure helps us keep track of the
 // above states
@@ -922,6 +941,8 @@ Net::Error Net::sendtoSocket(NetSocket handleFd, const U8 *buffer, S32  bufferSi
 
 bool Net::openPort(S32 port, bool doBind)
 {
+   PlatformNetState::stopReceiveThread();
+
    if (PlatformNetState::udpSocket != NetSocket::INVALID)
    {
       closeSocket(PlatformNetState::udpSocket);
@@ -937,6 +958,8 @@ bool Net::openPort(S32 port, bool doBind)
    Net::smMulticastEnabled = Con::getBoolVariable("pref::Net::Multicast6Enabled", true);
    Net::smIpv4Enabled = Con::getBoolVariable("pref::Net::IPV4Enabled", true);
    Net::smIpv6Enabled = Con::getBoolVariable("pref::Net::IPV6Enabled", false);
+   Net::smBatchedIO = Con::getBoolVariable("pref::Net::BatchedIO", true);
+   Net::smThreadedIO = Con::getBoolVariable("pref::Net::ThreadedIO", false);
 
    // we turn off VDP in non-release builds because VDP does not support broadcast packets
    // which are required for LAN queries (PC->Xbox connectivity).  The wire protocol still
@@ -1059,6 +1082,9 @@ bool Net::openPort(S32 port, bool doBind)
 
    PlatformNetState::netPort = port;
 
+   if (Net::smThreadedIO && !Journal::IsRecording() && !Journal::IsPlaying())
+      PlatformNetState::startReceiveThread();
+
    return PlatformNetState::udpSocket != NetSocket::INVALID || PlatformNetState::udp6Socket != NetSocket::INVALID;
 }
 
@@ -1069,12 +1095,112 @@ NetSocket Net::getPort()
 
 void Net::closePort()
 {
+   PlatformNetState::stopReceiveThread();
+   flushSends();
+
    if (PlatformNetState::udpSocket != NetSocket::INVALID)
       closeSocket(PlatformNetState::udpSocket);
    if (PlatformNetState::udp6Socket != NetSocket::INVALID)
       closeSocket(PlatformNetState::udp6Socket);
 }
 
+namespace PlatformNetState
+{
+#ifdef TORQUE_NET_BATCHED_IO
+   /// Number of datagrams moved per sendmmsg()/recvmmsg() call.
+   static const U32 BatchSize = 32;
+
+   struct QueuedPacket
+   {
+      SOCKET socketFd;
+      sockaddr_storage address;
+      socklen_t addressLen;
+      U32 size;
+      U8 data[Net::MaxPacketDataSize];
+   };
+
+   static QueuedPacket sendQueue[BatchSize];
+   static U32 sendQueueCount = 0;
+
+   static U8 receiveBuffers[BatchSize][Net::MaxPacketDataSize];
+#endif
+
+   /// Send a datagram or queue it for Net::flushSends().
+   static Net::Error sendPacket(SOCKET socketFd, const sockaddr *address, socklen_t addressLen, const U8 *buffer, S32 bufferSize)
+   {
+#ifdef TORQUE_NET_BATCHED_IO
+      if (Net::smBatchedIO && bufferSize <= Net::MaxPacketDataSize)
+      {
+         if (sendQueueCount == BatchSize)
+            Net::flushSends();
+
+         QueuedPacket &packet = sendQueue[sendQueueCount++];
+         packet.socketFd = socketFd;
+         dMemcpy(&packet.address, address, addressLen);
+         packet.addressLen = addressLen;
+         packet.size = bufferSize;
+         dMemcpy(packet.data, buffer, bufferSize);
+         return Net::NoError;
+      }
+#endif
+
+      if (::sendto(socketFd, (const char*)buffer, bufferSize, 0, address, addressLen) == SOCKET_ERROR)
+         return getLastError();
+      else
+         return Net::NoError;
+   }
+}
+
+void Net::flushSends()
+{
+#ifdef TORQUE_NET_BATCHED_IO
+   using namespace PlatformNetState;
+
+   mmsghdr messages[BatchSize];
+   iovec buffers[BatchSize];
+
+   // sendmmsg() takes a single socket, so send runs of packets for the same socket.
+   U32 start = 0;
+   while (start < sendQueueCount)
+   {
+      const SOCKET socketFd = sendQueue[start].socketFd;
+      U32 end = start;
+      for (; end < sendQueueCount && sendQueue[end].socketFd == socketFd; end++)
+      {
+         QueuedPacket &packet = sendQueue[end];
+         const U32 index = end - start;
+
+         buffers[index].iov_base = packet.data;
+         buffers[index].iov_len = packet.size;
+
+         dMemset(&messages[index], 0, sizeof(mmsghdr));
+         messages[index].msg_hdr.msg_name = &packet.address;
+         messages[index].msg_hdr.msg_namelen = packet.addressLen;
+         messages[index].msg_hdr.msg_iov = &buffers[index];
+         messages[index].msg_hdr.msg_iovlen = 1;
+      }
+
+      // A failing datagram stops the call; drop it like a failed sendto()
+      // would have and carry on with the rest.
+      U32 sent = 0;
+      while (sent < end - start)
+      {
+         S32 result = ::sendmmsg(socketFd, messages + sent, end - start - sent, 0);
+         if (result > 0)
+            sent += result;
+         else if (result < 0 && errno == EINTR)
+            continue;
+         else
+            sent++;
+      }
+
+      start = end;
+   }
+
+   sendQueueCount = 0;
+#endif
+}
+
 Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32  bufferSize)
 {
    if(Journal::IsPlaying())
@@ -1090,11 +1216,7 @@ Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32  bufferS
          sockaddr_in ipAddr;
          NetAddressToIPSocket(address, &ipAddr);
 
-         if (::sendto(socketFd, (const char*)buffer, bufferSize, 0,
-            (sockaddr *)&ipAddr, sizeof(sockaddr_in)) == SOCKET_ERROR)
-            return PlatformNetState::getLastError();
-         else
-            return NoError;
+         return PlatformNetState::sendPacket(socketFd, (sockaddr *)&ipAddr, sizeof(sockaddr_in), buffer, bufferSize);
       }
       else
       {
@@ -1109,11 +1231,8 @@ Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32  bufferS
       {
          sockaddr_in6 ipAddr;
          NetAddressToIPSocket6(address, &ipAddr);
-         if (::sendto(socketFd, (const char*)buffer, bufferSize, 0,
-          (struct sockaddr *) &ipAddr, sizeof(sockaddr_in6)) == SOCKET_ERROR)
-            return PlatformNetState::getLastError();
-         else
-            return NoError;
+
+         return PlatformNetState::sendPacket(socketFd, (sockaddr *)&ipAddr, sizeof(sockaddr_in6), buffer, bufferSize);
       }
       else
       {
@@ -1124,11 +1243,233 @@ Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32  bufferS
    return WrongProtocolType;
 }
 
+namespace PlatformNetState
+{
+   /// A packet read by the receive thread.
+   struct ReceivedPacket
+   {
+      NetAddress address;
+
+      /// Platform::getRealMilliseconds() when the packet was read.
+      U32 arrivalTime;
+
+      U32 size;
+      U8 data[Net::MaxPacketDataSize];
+   };
+
+   /// Reads the listen sockets as soon as packets arrive and queues them
+   /// for Net::process() so long frames on the main thread neither delay
+   /// reading nor let the socket buffers overflow.
+   ///
+   /// Packets live in a fixed pool; indices of free and filled pool entries
+   /// are passed between the threads through two single-producer,
+   /// single-consumer queues, so neither side ever takes a lock.
+   class ReceiveThread : public Thread
+   {
+   public:
+      enum
+      {
+         /// Number of packets that can be waiting for the main thread.
+         PoolSize = 1024,
+
+         /// Longest time in ms the thread waits for packets before
+         /// checking whether it should stop.
+         WaitTime = 10,
+      };
+
+   protected:
+      SOCKET mSockets[2];
+      ReceivedPacket *mPackets;
+
+      /// Pool entries the receive thread may fill.  Main thread produces.
+      ThreadSafeSPSCRingBuffer<U32> mFreePackets;
+
+      /// Filled pool entries.  Receive thread produces.
+      ThreadSafeSPSCRingBuffer<U32> mReceivedPackets;
+
+      /// Pool entry the receive thread reads into next or U32_MAX.
+      U32 mCurrentPacket;
+
+      /// Read all pending packets from @a socketFd.
+      /// @return False if the pool ran out.
+      bool receive(SOCKET socketFd);
+
+   public:
+      ReceiveThread(SOCKET udpFd, SOCKET udp6Fd);
+      ~ReceiveThread();
+
+      virtual void run(void *arg = 0);
+
+      /// Hand all queued packets to Net::smPacketReceive.  Main thread only.
+      void dispatchPackets();
+   };
+
+   static ReceiveThread *receiveThread = NULL;
+
+   /// Time the packet being dispatched spent waiting for the main thread.
+   static U32 packetAge = 0;
+
+   ReceiveThread::ReceiveThread(SOCKET udpFd, SOCKET udp6Fd)
+      : mFreePackets(PoolSize),
+        mReceivedPackets(PoolSize),
+        mCurrentPacket(U32_MAX)
+   {
+      mSockets[0] = udpFd;
+      mSockets[1] = udp6Fd;
+
+      mPackets = new ReceivedPacket[PoolSize];
+      for (U32 i = 0; i < PoolSize; i++)
+         mFreePackets.tryPushBack(i);
+   }
+
+   ReceiveThread::~ReceiveThread()
+   {
+      delete [] mPackets;
+   }
+
+   bool ReceiveThread::receive(SOCKET socketFd)
+   {
+      for (;;)
+      {
+         if (mCurrentPacket == U32_MAX && !mFreePackets.tryPopFront(mCurrentPacket))
+            return false;
+
+         ReceivedPacket &packet = mPackets[mCurrentPacket];
+
+         sockaddr_storage sa;
+         socklen_t addrLen = sizeof(sa);
+         S32 bytesRead = ::recvfrom(socketFd, (char *)packet.data, Net::MaxPacketDataSize, 0, (struct sockaddr*)&sa, &addrLen);
+
+         if (bytesRead == -1)
+            return true;
+
+         if (sa.ss_family == AF_INET)
+            IPSocketToNetAddress((sockaddr_in *)&sa, &packet.address);
+         else if (sa.ss_family == AF_INET6)
+            IPSocket6ToNetAddress((sockaddr_in6 *)&sa, &packet.address);
+         else
+            continue;
+
+         if (bytesRead <= 0)
+            continue;
+
+         if (packet.address.type == NetAddress::IPAddress &&
+            packet.address.address.ipv4.netNum[0] == 127 &&
+            packet.address.address.ipv4.netNum[1] == 0 &&
+            packet.address.address.ipv4.netNum[2] == 0 &&
+            packet.address.address.ipv4.netNum[3] == 1 &&
+            packet.address.port == netPort)
+            continue;
+
+         packet.arrivalTime = Platform::getRealMilliseconds();
+         packet.size = bytesRead;
+         mReceivedPackets.pushBack(mCurrentPacket);
+         mCurrentPacket = U32_MAX;
+      }
+   }
+
+   void ReceiveThread::run(void *arg)
+   {
+      _setName("NetReceiveThread");
+
+      while (!checkForStop())
+      {
+         fd_set readSet;
+         FD_ZERO(&readSet);
+
+         SOCKET maxFd = 0;
+         for (U32 i = 0; i < 2; i++)
+            if (mSockets[i] != InvalidSocketHandle)
+            {
+               FD_SET(mSockets[i], &readSet);
+               if (mSockets[i] > maxFd)
+                  maxFd = mSockets[i];
+            }
+
+         timeval timeout;
+         timeout.tv_sec = 0;
+         timeout.tv_usec = WaitTime * 1000;
+
+         if (::select(maxFd + 1, &readSet, NULL, NULL, &timeout) <= 0)
+            continue;
+
+         bool poolFull = false;
+         for (U32 i = 0; i < 2; i++)
+            if (mSockets[i] != InvalidSocketHandle && FD_ISSET(mSockets[i], &readSet))
+               poolFull |= !receive(mSockets[i]);
+
+         // Leave the rest in the socket buffer until the main thread catches up.
+         if (poolFull)
+            Platform::sleep(1);
+      }
+   }
+
+   void ReceiveThread::dispatchPackets()
+   {
+      const U32 now = Platform::getRealMilliseconds();
+
+      U32 index;
+      while (mReceivedPackets.tryPopFront(index))
+      {
+         ReceivedPacket &packet = mPackets[index];
+
+         packetAge = now - packet.arrivalTime;
+
+         RawData data((S8 *)packet.data, packet.size);
+         Net::smPacketReceive->trigger(packet.address, data);
+
+         mFreePackets.tryPushBack(index);
+      }
+
+      packetAge = 0;
+   }
+
+   static void startReceiveThread()
+   {
+      AssertFatal(!receiveThread, "PlatformNetState::startReceiveThread - Receive thread already running");
+
+      const SOCKET udpFd = udpSocket != NetSocket::INVALID ? smReservedSocketList.resolve(udpSocket) : InvalidSocketHandle;
+      const SOCKET udp6Fd = udp6Socket != NetSocket::INVALID ? smReservedSocketList.resolve(udp6Socket) : InvalidSocketHandle;
+      if (udpFd == InvalidSocketHandle && udp6Fd == InvalidSocketHandle)
+         return;
+
+      receiveThread = new ReceiveThread(udpFd, udp6Fd);
+      receiveThread->start();
+   }
+
+   static void stopReceiveThread()
+   {
+      if (!receiveThread)
+         return;
+
+      // Packets still queued are dropped like any that arrive after the
+      // port closes.
+      receiveThread->stop();
+      receiveThread->join();
+
+      delete receiveThread;
+      receiveThread = NULL;
+   }
+}
+
+U32 Net::getPacketAge()
+{
+   return PlatformNetState::packetAge;
+}
+
 void Net::process()
 {
    // Process listening sockets
-   processListenSocket(PlatformNetState::udpSocket);
-   processListenSocket(PlatformNetState::udp6Socket);
+   if (PlatformNetState::receiveThread)
+      PlatformNetState::receiveThread->dispatchPackets();
+   else
+   {
+      processListenSocket(PlatformNetState::udpSocket);
+      processListenSocket(PlatformNetState::udp6Socket);
+   }
+
+   // Send whatever the packets we just processed replied with.
+   flushSends();
 
    // process the polled sockets.  This blob of code performs functions
    // similar to WinsockProc in winNet.cc
@@ -1363,6 +1704,71 @@ void Net::process()
    }
 }
 
+#ifdef TORQUE_NET_BATCHED_IO
+
+/// Drain @ socketFd like Net::processListenSocket() but with recvmmsg().
+static void processListenSocketBatched(SOCKET socketFd)
+{
+   using namespace PlatformNetState;
+
+   mmsghdr messages[BatchSize];
+   iovec buffers[BatchSize];
+   sockaddr_storage addresses[BatchSize];
+   NetAddress srcAddress;
+
+   for (;;)
+   {
+      for (U32 i = 0; i < BatchSize; i++)
+      {
+         buffers[i].iov_base = receiveBuffers[i];
+         buffers[i].iov_len = Net::MaxPacketDataSize;
+
+         dMemset(&messages[i], 0, sizeof(mmsghdr));
+         messages[i].msg_hdr.msg_name = &addresses[i];
+         messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+         messages[i].msg_hdr.msg_iov = &buffers[i];
+         messages[i].msg_hdr.msg_iovlen = 1;
+      }
+
+      S32 count = ::recvmmsg(socketFd, messages, BatchSize, MSG_DONTWAIT, NULL);
+      if (count <= 0)
+         break;
+
+      for (S32 i = 0; i < count; i++)
+      {
+         const S32 bytesRead = messages[i].msg_len;
+         const sockaddr_storage &sa = addresses[i];
+
+         if (sa.ss_family == AF_INET)
+            IPSocketToNetAddress((sockaddr_in *)&sa, &srcAddress);
+         else if (sa.ss_family == AF_INET6)
+            IPSocket6ToNetAddress((sockaddr_in6 *)&sa, &srcAddress);
+         else
+            continue;
+
+         if (bytesRead <= 0)
+            continue;
+
+         if (srcAddress.type == NetAddress::IPAddress &&
+            srcAddress.address.ipv4.netNum[0] == 127 &&
+            srcAddress.address.ipv4.netNum[1] == 0 &&
+            srcAddress.address.ipv4.netNum[2] == 0 &&
+            srcAddress.address.ipv4.netNum[3] == 1 &&
+            srcAddress.port == PlatformNetState::netPort)
+            continue;
+
+         RawData packet((S8 *)receiveBuffers[i], bytesRead);
+         Net::smPacketReceive->trigger(srcAddress, packet);
+      }
+
+      // A short batch means the socket is drained.
+      if (count < (S32)BatchSize)
+         break;
+   }
+}
+
+#endif
+
 void Net::processListenSocket(NetSocket socketHandle)
 {
    if (socketHandle == NetSocket::INVALID)
@@ -1376,6 +1782,14 @@ void Net::processListenSocket(NetSocket socketHandle)
 
    SOCKET socketFd = PlatformNetState::smReservedSocketList.resolve(socketHandle);
 
+#ifdef TORQUE_NET_BATCHED_IO
+   if (smBatchedIO)
+   {
+      processListenSocketBatched(socketFd);
+      return;
+   }
+#endif
+
    for (;;)
    {
       socklen_t addrLen = sizeof(sa);
@@ -1411,6 +1825,7 @@ void Net::processListenSocket(NetSocket socketHandle)
    }
 }
 
+
 NetSocket Net::openSocket()
 {
    return PlatformNetState::smReservedSocketList.reserve();
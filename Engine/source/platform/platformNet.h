@@ -214,6 +214,16 @@ struct Net
    static bool smMulticastEnabled;
    static bool smIpv4Enabled;
    static bool smIpv6Enabled;
+
+   /// If true and the platform supports it, sendto() queues packets until
+   /// flushSends() and the listen sockets are drained several packets per
+   /// system call.  Read from $pref::Net::BatchedIO in openPort().
+   static bool smBatchedIO;
+
+   /// If true, the listen sockets are read on a dedicated thread as soon as
+   /// packets arrive and process() only dispatches what that thread queued.
+   /// Read from $pref::Net::ThreadedIO in openPort().
+   static bool smThreadedIO;
    
    static ConnectionNotifyEvent*   smConnectionNotify;
    static ConnectionAcceptedEvent* smConnectionAccept;
@@ -235,6 +245,16 @@ struct Net
    static void closePort();
    static Error sendto(const NetAddress *address, const U8 *buffer, S32 bufferSize);
 
+   /// Send all packets sendto() has queued.  Only needed with #smBatchedIO;
+   /// queued packets are also sent once the queue fills up and at the end
+   /// of process().
+   static void flushSends();
+
+   /// Return how many milliseconds the packet currently being dispatched
+   /// through the packet receive event waited after arriving before the
+   /// main thread got to it.  Always 0 without #smThreadedIO.
+   static U32 getPacketAge();
+
    // Reliable net functions (TCP)
    // all incoming messages come in on the Connected* events
    static NetSocket openListenPort(U16 port, NetAddress::Type = NetAddress::IPAddress);
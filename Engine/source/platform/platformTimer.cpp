@@ -22,22 +22,52 @@
 
 #include "platform/platformTimer.h"
 #include "core/util/journal/process.h"
+#include "core/util/journal/journal.h"
 #include "console/engineAPI.h"
 
+// Sleep() only gets within a ms or so on Windows even with the raised timer
+// resolution, nanosleep() is a lot tighter.
+#ifdef TORQUE_OS_WIN
+S32 TimeManager::smSpinTailUs = 1000;
+#else
+S32 TimeManager::smSpinTailUs = 200;
+#endif
+
+bool TimeManager::smJournalRealTime = true;
+
 void TimeManager::_updateTime()
 {
    // Calculate & filter time delta since last event.
 
-   // How long since last update?
-   S32 delta = mTimer->getElapsedMs();
+   S32 threshold = mBackground ? mBackgroundThreshold : mForegroundThreshold;
+   if(mNextEventDelay > 0)
+   {
+      threshold = mNextEventDelay;
+      mNextEventDelay = 0;
+   }
 
    // Now - we want to try to sleep until the time threshold will hit.
-   S32 msTillThresh = (mBackground ? mBackgroundThreshold : mForegroundThreshold) - delta;
+   const S64 thresholdUs = S64(threshold) * 1000;
+   S64 usTillThresh = thresholdUs - mTimer->getElapsedUs();
 
-   if(msTillThresh > 0)
+   if(usTillThresh > 0 && (smJournalRealTime || !Journal::IsPlaying()))
    {
-      // There's some time to go, so let's sleep.
-      Platform::sleep( msTillThresh );
+      if(mBackground)
+      {
+         // Nobody minds a late wakeup in the background.
+         Platform::sleep( U32((usTillThresh + 999) / 1000) );
+      }
+      else
+      {
+         // Sleep short of the threshold and spin the rest so the event
+         // fires on time instead of a scheduler quantum late.
+         const S64 spinTail = getMax(smSpinTailUs, 0);
+         if(usTillThresh > spinTail)
+            Platform::sleepMicroseconds( U32(usTillThresh - spinTail) );
+
+         while(mTimer->getElapsedUs() < thresholdUs)
+            ;
+      }
    }
 
    // Ok - let's grab the new elapsed and send that out.
@@ -50,6 +80,7 @@ void TimeManager::_updateTime()
 TimeManager::TimeManager()
 {
    mBackground = false;
+   mNextEventDelay = 0;
    mTimer = PlatformTimer::create();
    Process::notify(this, &TimeManager::_updateTime, PROCESS_TIME_ORDER);
    
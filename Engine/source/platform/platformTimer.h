@@ -40,6 +40,11 @@ public:
    /// Get the number of MS that have elapsed since creation or the last
    /// reset call.
    virtual const S32 getElapsedMs()=0;
+
+   /// Get the number of microseconds that have elapsed since creation or the
+   /// last reset call.  Unlike getElapsedMs() this does not change what
+   /// reset() rewinds to.
+   virtual const S64 getElapsedUs()=0;
    
    /// Reset elapsed ms back to zero.
    virtual void reset()=0;
@@ -64,12 +69,22 @@ class TimeManager
 {
    PlatformTimer *mTimer;
    S32 mForegroundThreshold, mBackgroundThreshold;
+   S32 mNextEventDelay;
    bool mBackground;
    
    void _updateTime();
 
 public:
 
+   /// Microseconds at the end of a foreground wait that are spent spinning
+   /// rather than sleeping, since the OS tends to oversleep.
+   static S32 smSpinTailUs;
+
+   /// If false, journal playback doesn't wait between time events so a
+   /// recorded session replays as fast as it can be processed.  The
+   /// recorded time deltas are used either way.
+   static bool smJournalRealTime;
+
    TimeManagerEvent timeEvent;
    
    TimeManager();   
@@ -81,6 +96,10 @@ public:
    void setBackgroundThreshold(const S32 msInterval);
    const S32 getBackgroundThreshold() const;
 
+   /// Wait @a msDelay instead of the current threshold before the next time
+   /// event only.
+   void setNextEventDelay(const S32 msDelay) { mNextEventDelay = msDelay; }
+
    void setBackground(const bool isBackground) { mBackground = isBackground; };
    const bool getBackground() const { return mBackground; };
 
@@ -88,23 +107,30 @@ public:
 
 class DefaultPlatformTimer : public PlatformTimer
 {
-   S32 mLastTime, mNextTime;
+   U64 mLastTime, mNextTime;
    
 public:
    DefaultPlatformTimer()
    {
-      mLastTime = mNextTime = Platform::getRealMilliseconds();
+      mLastTime = mNextTime = Platform::getRealMicroseconds();
    }
    
    const S32 getElapsedMs()
    {
-      mNextTime = Platform::getRealMilliseconds();
-      return (mNextTime - mLastTime);
+      mNextTime = Platform::getRealMicroseconds();
+      return S32((mNextTime - mLastTime) / 1000);
+   }
+
+   const S64 getElapsedUs()
+   {
+      return S64(Platform::getRealMicroseconds() - mLastTime);
    }
    
    void reset()
    {
-      mLastTime = mNextTime;
+      // Only rewind by the whole ms we reported so the remainder carries
+      // over into the next interval.
+      mLastTime += (mNextTime - mLastTime) / 1000 * 1000;
    }
 };
 
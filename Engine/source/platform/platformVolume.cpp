@@ -30,6 +30,7 @@
 
 #include "platform/platformVolume.h"
 #include "core/util/zip/zipVolume.h"
+#include "core/packVolume.h"
 
 using namespace Torque;
 using namespace Torque::FS;
@@ -50,7 +51,7 @@ bool  MountDefaults()
 
 #ifndef TORQUE_DISABLE_VIRTUAL_MOUNT_SYSTEM
    // Note that the VirtualMountSystem must be enabled in volume.cpp for zip support to work.
-   return MountZips("game");
+   return MountZips("game") && MountPacks("game");
 #else
    return true;
 #endif
@@ -80,6 +81,27 @@ bool MountZips(const String &root)
    return mounted == outList.size();
 }
 
+bool MountPacks(const String &root)
+{
+   Path basePath;
+   basePath.setRoot(root);
+   Vector<String> outList;
+
+   S32 num = FindByPattern(basePath, "*.tpk", true, outList);
+   if(num == 0)
+      return true; // not an error
+
+   S32 mounted = 0;
+   for(S32 i = 0;i < outList.size();++i)
+   {
+      FileSystemRef pack = new PackFileSystem(outList[i]);
+      if(static_cast<PackFileSystem*>(pack.getPointer())->isValid())
+         mounted += (S32)Mount(root, pack);
+   }
+
+   return mounted == outList.size();
+}
+
 //-----------------------------------------------------------------------------
 
 bool  Touch( const Path &path )
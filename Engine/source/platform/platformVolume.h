@@ -45,6 +45,10 @@ namespace FS
 
    bool MountDefaults();
    bool MountZips(const String &root);
+
+   /// Mount all Torque packs (.tpk) found under @a root on top of it.
+   /// @see Torque::FS::PackFileSystem
+   bool MountPacks(const String &root);
    
    bool Touch( const Path &path );
 
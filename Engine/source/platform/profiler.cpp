@@ -37,6 +37,17 @@
 
 #include "platform/profiler.h"
 #include "platform/threads/thread.h"
+#include "platform/threads/mutex.h"
+#include "platform/platformTLS.h"
+#include "platform/platformIntrinsics.h"
+
+#if defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 )
+   #ifdef TORQUE_COMPILER_VISUALC
+      #include <intrin.h>
+   #else
+      #include <x86intrin.h>
+   #endif
+#endif
 
 #include "console/engineAPI.h"
 
@@ -343,6 +354,8 @@ const char * Profiler::constructProfilePath(ProfilerData * pd)
 #endif
 void Profiler::hashPush(ProfilerRootData *root)
 {
+   ProfilerTrace::beginZone(root->mName);
+
 #ifdef TORQUE_MULTITHREAD
    // Ignore non-main-thread profiler activity.
    if( !ThreadManager::isMainThread() )
@@ -438,6 +451,8 @@ void Profiler::dumpToFile(const char* fileName)
 
 void Profiler::hashPop(ProfilerRootData *expected)
 {
+   ProfilerTrace::endZone();
+
 #ifdef TORQUE_MULTITHREAD
    // Ignore non-main-thread profiler activity.
    if( !ThreadManager::isMainThread() )
@@ -708,6 +723,403 @@ void Profiler::enableMarker(const char *marker, bool enable)
    }
 }
 
+//=============================================================================
+//    ProfilerTrace.
+//=============================================================================
+// MARK: ---- ProfilerTrace ----
+
+struct ProfilerTrace::ThreadBuffer
+{
+   Event* mEvents;
+   U32 mCapacity;
+
+   /// Number of recorded events.  Only written by the owning thread.
+   volatile U32 mNumEvents;
+
+   /// Capture the events belong to.
+   U32 mCaptureId;
+
+   U32 mThreadId;
+   bool mIsMainThread;
+
+   ThreadBuffer* mNext;
+};
+
+bool ProfilerTrace::smCapturing = false;
+U32 ProfilerTrace::smCaptureId = 0;
+U32 ProfilerTrace::smMaxEventsPerThread = 0;
+
+static ThreadStorage sgTraceThreadBuffer;
+
+/// All thread buffers ever created.  Only locked when a thread records its
+/// first event and when exporting.
+static ProfilerTrace::ThreadBuffer* sgTraceBuffers = NULL;
+static Mutex sgTraceMutex;
+
+/// Buffer for GPU zones.  Only written from the thread owning the GFXDevice.
+static ProfilerTrace::ThreadBuffer sgTraceGPUBuffer;
+
+/// Timestamps and wall clock times at the start and end of the capture for
+/// converting timestamps to microseconds.
+static U64 sgTraceStartTime;
+static U64 sgTraceEndTime;
+static U32 sgTraceStartMs;
+static U32 sgTraceEndMs;
+
+U64 ProfilerTrace::getTimestamp()
+{
+#if defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 )
+   return __rdtsc();
+#else
+   return U64( Platform::getRealMilliseconds() ) * 1000;
+#endif
+}
+
+static void traceResetBuffer( ProfilerTrace::ThreadBuffer* buffer, U32 capacity, U32 captureId )
+{
+   if( buffer->mCapacity != capacity )
+   {
+      dFree( buffer->mEvents );
+      buffer->mEvents = ( ProfilerTrace::Event* ) dMalloc( sizeof( ProfilerTrace::Event ) * capacity );
+      buffer->mCapacity = capacity;
+   }
+
+   buffer->mNumEvents = 0;
+   buffer->mCaptureId = captureId;
+}
+
+static void traceAppend( ProfilerTrace::ThreadBuffer* buffer, const ProfilerTrace::Event& event )
+{
+   const U32 index = buffer->mNumEvents;
+   if( index >= buffer->mCapacity )
+      return;
+
+   buffer->mEvents[ index ] = event;
+
+   // Full barrier; publishes the event to the exporting thread.
+   dFetchAndAdd( buffer->mNumEvents, 1 );
+}
+
+void ProfilerTrace::_record( U32 type, const char* name, U64 duration )
+{
+   ThreadBuffer* buffer = reinterpret_cast< ThreadBuffer* >( sgTraceThreadBuffer.get() );
+   if( !buffer )
+   {
+      buffer = new ThreadBuffer;
+      buffer->mEvents = NULL;
+      buffer->mCapacity = 0;
+      buffer->mNumEvents = 0;
+      buffer->mCaptureId = 0;
+      buffer->mThreadId = ThreadManager::getCurrentThreadId();
+      buffer->mIsMainThread = ThreadManager::isMainThread();
+
+      sgTraceThreadBuffer.set( buffer );
+
+      MutexHandle lock;
+      lock.lock( &sgTraceMutex, true );
+
+      buffer->mNext = sgTraceBuffers;
+      sgTraceBuffers = buffer;
+   }
+
+   // Buffers are reset lazily by their owners so that starting a capture
+   // doesn't race with threads that are recording.
+   if( buffer->mCaptureId != smCaptureId )
+      traceResetBuffer( buffer, smMaxEventsPerThread, smCaptureId );
+
+   Event event;
+   event.mTime = getTimestamp();
+   event.mDuration = duration;
+   event.mName = name;
+   event.mType = type;
+
+   traceAppend( buffer, event );
+}
+
+void ProfilerTrace::recordGPUZone( const char* name, U64 startTime, U64 durationNs )
+{
+   if( !smCapturing )
+      return;
+
+   if( sgTraceGPUBuffer.mCaptureId != smCaptureId )
+      traceResetBuffer( &sgTraceGPUBuffer, smMaxEventsPerThread, smCaptureId );
+
+   Event event;
+   event.mTime = startTime;
+   event.mDuration = durationNs;
+   event.mName = name;
+   event.mType = EventGPU;
+
+   traceAppend( &sgTraceGPUBuffer, event );
+}
+
+void ProfilerTrace::start( U32 maxEventsPerThread )
+{
+   smCapturing = false;
+
+   smMaxEventsPerThread = getMax( maxEventsPerThread, U32( 1 ) );
+   if( ++ smCaptureId == 0 )
+      smCaptureId ++;
+
+   sgTraceStartMs = Platform::getRealMilliseconds();
+   sgTraceStartTime = getTimestamp();
+
+   smCapturing = true;
+}
+
+void ProfilerTrace::stop()
+{
+   if( !smCapturing )
+      return;
+
+   smCapturing = false;
+
+   sgTraceEndMs = Platform::getRealMilliseconds();
+   sgTraceEndTime = getTimestamp();
+}
+
+static void traceWriteThreadName( FileStream& stream, U32 tid, const char* name, bool& first )
+{
+   char buffer[ 256 ];
+   dSprintf( buffer, sizeof( buffer ),
+      "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+      first ? "" : ",\n", tid, name );
+   stream.write( dStrlen( buffer ), buffer );
+   first = false;
+}
+
+static void traceWriteBuffer( FileStream& stream, const ProfilerTrace::ThreadBuffer* buffer, U32 tid, F64 ticksPerUs, bool& first )
+{
+   const U32 numEvents = dAtomicRead( const_cast< volatile U32& >( buffer->mNumEvents ) );
+   char line[ 256 ];
+
+   for( U32 i = 0; i < numEvents; ++ i )
+   {
+      const ProfilerTrace::Event& event = buffer->mEvents[ i ];
+      if( event.mTime < sgTraceStartTime )
+         continue;
+
+      const F64 ts = F64( event.mTime - sgTraceStartTime ) / ticksPerUs;
+      const char* separator = first ? "" : ",\n";
+
+      switch( event.mType )
+      {
+         case ProfilerTrace::EventBegin:
+            dSprintf( line, sizeof( line ), "%s{\"name\":\"%s\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+               separator, event.mName, ts, tid );
+            break;
+
+         case ProfilerTrace::EventEnd:
+            dSprintf( line, sizeof( line ), "%s{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+               separator, ts, tid );
+            break;
+
+         case ProfilerTrace::EventCounter:
+            dSprintf( line, sizeof( line ), "%s{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"value\":%.0f}}",
+               separator, event.mName, ts, tid, F64( event.mDuration ) );
+            break;
+
+         default:
+            dSprintf( line, sizeof( line ), "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+               separator, event.mName, ts, F64( event.mDuration ) / 1000.0, tid );
+            break;
+      }
+
+      stream.write( dStrlen( line ), line );
+      first = false;
+   }
+}
+
+bool ProfilerTrace::writeChromeTrace( const char* fileName )
+{
+   if( !smCaptureId )
+   {
+      Con::errorf( "ProfilerTrace::writeChromeTrace - Nothing has been captured" );
+      return false;
+   }
+
+   FileStream stream;
+   if( !stream.open( fileName, Torque::FS::File::Write ) )
+   {
+      Con::errorf( "ProfilerTrace::writeChromeTrace - Could not open '%s' for writing", fileName );
+      return false;
+   }
+
+   // Calibrate timestamps against the wall clock over the capture.
+
+   const U64 endTime = smCapturing ? getTimestamp() : sgTraceEndTime;
+   const U32 endMs = smCapturing ? Platform::getRealMilliseconds() : sgTraceEndMs;
+
+   F64 ticksPerUs = 1.0;
+   if( endMs > sgTraceStartMs && endTime > sgTraceStartTime )
+      ticksPerUs = F64( endTime - sgTraceStartTime ) / ( F64( endMs - sgTraceStartMs ) * 1000.0 );
+
+   const char* header = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+   stream.write( dStrlen( header ), header );
+
+   bool first = true;
+   U32 numDropped = 0;
+
+   {
+      MutexHandle lock;
+      lock.lock( &sgTraceMutex, true );
+
+      for( ThreadBuffer* buffer = sgTraceBuffers; buffer != NULL; buffer = buffer->mNext )
+      {
+         if( buffer->mCaptureId != smCaptureId )
+            continue;
+
+         char name[ 64 ];
+         if( buffer->mIsMainThread )
+            dStrcpy( name, "Main Thread" );
+         else
+            dSprintf( name, sizeof( name ), "Thread %u", buffer->mThreadId );
+
+         traceWriteThreadName( stream, buffer->mThreadId, name, first );
+         traceWriteBuffer( stream, buffer, buffer->mThreadId, ticksPerUs, first );
+
+         if( buffer->mNumEvents >= buffer->mCapacity )
+            numDropped ++;
+      }
+   }
+
+   if( sgTraceGPUBuffer.mCaptureId == smCaptureId )
+   {
+      traceWriteThreadName( stream, 0, "GPU", first );
+      traceWriteBuffer( stream, &sgTraceGPUBuffer, 0, ticksPerUs, first );
+   }
+
+   const char* footer = "\n]}\n";
+   stream.write( dStrlen( footer ), footer );
+   stream.close();
+
+   if( numDropped )
+      Con::warnf( "ProfilerTrace::writeChromeTrace - %i threads ran out of event space; increase maxEventsPerThread", numDropped );
+
+   return true;
+}
+
+//=============================================================================
+//    ProfilerFrameHistogram.
+//=============================================================================
+// MARK: ---- ProfilerFrameHistogram ----
+
+U32 ProfilerFrameHistogram::smBuckets[ NumBuckets ];
+U32 ProfilerFrameHistogram::smCount = 0;
+U64 ProfilerFrameHistogram::smTotalUs = 0;
+U32 ProfilerFrameHistogram::smMinUs = U32_MAX;
+U32 ProfilerFrameHistogram::smMaxUs = 0;
+U64 ProfilerFrameHistogram::smLastFrameStart = 0;
+
+//-----------------------------------------------------------------------------
+
+void ProfilerFrameHistogram::beginFrame()
+{
+   const U64 now = Platform::getRealMicroseconds();
+   if( smLastFrameStart )
+   {
+      const U64 frameUs = now - smLastFrameStart;
+      record( frameUs < U32_MAX ? U32( frameUs ) : U32_MAX );
+   }
+
+   smLastFrameStart = now;
+}
+
+//-----------------------------------------------------------------------------
+
+void ProfilerFrameHistogram::record( U32 frameUs )
+{
+   smBuckets[ getMin( frameUs / BucketUs, U32( NumBuckets - 1 ) ) ] ++;
+   smCount ++;
+   smTotalUs += frameUs;
+   smMinUs = getMin( smMinUs, frameUs );
+   smMaxUs = getMax( smMaxUs, frameUs );
+
+   ProfilerTrace::recordCounter( "FrameTimeUs", frameUs );
+}
+
+//-----------------------------------------------------------------------------
+
+void ProfilerFrameHistogram::reset()
+{
+   dMemset( smBuckets, 0, sizeof( smBuckets ) );
+   smCount = 0;
+   smTotalUs = 0;
+   smMinUs = U32_MAX;
+   smMaxUs = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 ProfilerFrameHistogram::getPercentile( F32 percentile )
+{
+   if( !smCount )
+      return 0;
+
+   const U32 target = getMax( U32( mCeil( smCount * mClampF( percentile, 0.0f, 100.0f ) / 100.0f ) ), U32( 1 ) );
+
+   U32 count = 0;
+   for( U32 i = 0; i < NumBuckets; ++ i )
+   {
+      count += smBuckets[ i ];
+      if( count >= target )
+         return getMin( ( i + 1 ) * BucketUs, smMaxUs );
+   }
+
+   return smMaxUs;
+}
+
+//-----------------------------------------------------------------------------
+
+void ProfilerFrameHistogram::dumpToConsole()
+{
+   if( !smCount )
+   {
+      Con::printf( "No frame times recorded." );
+      return;
+   }
+
+   Con::printf( "Frame times over %u frames (ms):", smCount );
+   Con::printf( "  min %.2f  avg %.2f  max %.2f",
+      smMinUs / 1000.0f, F32( F64( smTotalUs ) / smCount ) / 1000.0f, smMaxUs / 1000.0f );
+   Con::printf( "  p50 %.2f  p90 %.2f  p99 %.2f  p99.9 %.2f",
+      getPercentile( 50.0f ) / 1000.0f, getPercentile( 90.0f ) / 1000.0f,
+      getPercentile( 99.0f ) / 1000.0f, getPercentile( 99.9f ) / 1000.0f );
+
+   // Print whole milliseconds per row, skipping the empty ones.
+   const U32 bucketsPerRow = 1000 / BucketUs;
+   const U32 barWidth = 50;
+
+   U32 maxRow = 0;
+   for( U32 i = 0; i < NumBuckets; i += bucketsPerRow )
+   {
+      U32 row = 0;
+      for( U32 j = i; j < i + bucketsPerRow; ++ j )
+         row += smBuckets[ j ];
+      maxRow = getMax( maxRow, row );
+   }
+
+   char bar[ barWidth + 1 ];
+   for( U32 i = 0; i < NumBuckets; i += bucketsPerRow )
+   {
+      U32 row = 0;
+      for( U32 j = i; j < i + bucketsPerRow; ++ j )
+         row += smBuckets[ j ];
+      if( !row )
+         continue;
+
+      const U32 length = getMax( row * barWidth / maxRow, U32( 1 ) );
+      dMemset( bar, '#', length );
+      bar[ length ] = '\0';
+
+      const U32 ms = i * BucketUs / 1000;
+      if( i + bucketsPerRow >= NumBuckets )
+         Con::printf( "  >=%3u %7u %s", ms, row, bar );
+      else
+         Con::printf( "  %5u %7u %s", ms, row, bar );
+   }
+}
+
 //=============================================================================
 //    Console Functions.
 //=============================================================================
@@ -766,6 +1178,55 @@ DefineEngineFunction( profilerDumpToFile, void, ( const char* fileName ),,
       gProfiler->dumpToFile(fileName);
 }
 
+DefineEngineFunction( profilerTraceStart, void, ( S32 maxEventsPerThread ), ( 65536 ),
+            "@brief Start capturing a timeline of profiler zones on all threads.\n\n"
+            "Unlike the regular profiler, this records individual zone invocations, including the "
+            "ones on worker threads and the GPU, for finding hitches.\n\n"
+            "@param maxEventsPerThread Number of events each thread can record before dropping further events.\n"
+            "@see profilerTraceStop\n"
+            "@ingroup Debugging" )
+{
+   ProfilerTrace::start( getMax( maxEventsPerThread, 1 ) );
+}
+
+DefineEngineFunction( profilerTraceStop, bool, ( const char* fileName ), ( "" ),
+            "@brief Stop the capture started with profilerTraceStart().\n\n"
+            "@param fileName If not empty, the capture is written to this file in Chrome trace event "
+            "format for viewing in chrome://tracing or Perfetto.\n"
+            "@return False if writing the file failed.\n"
+            "@ingroup Debugging" )
+{
+   ProfilerTrace::stop();
+
+   if( fileName && fileName[ 0 ] )
+      return ProfilerTrace::writeChromeTrace( fileName );
+
+   return true;
+}
+
+DefineEngineFunction( profilerFrameTimesDump, void, (),,
+            "@brief Dumps the distribution of main loop frame times recorded since startup or the last "
+            "profilerFrameTimesReset() to the console.\n\n"
+            "@ingroup Debugging" )
+{
+   ProfilerFrameHistogram::dumpToConsole();
+}
+
+DefineEngineFunction( profilerFrameTimesGetPercentile, F32, ( F32 percentile ),,
+            "@brief Returns the frame time in milliseconds that the given percentage of recorded frames stayed under.\n\n"
+            "@param percentile Percentage of frames, e.g. 99 for the 99th percentile.\n"
+            "@ingroup Debugging" )
+{
+   return ProfilerFrameHistogram::getPercentile( percentile ) / 1000.0f;
+}
+
+DefineEngineFunction( profilerFrameTimesReset, void, (),,
+            "@brief Clears the recorded main loop frame times.\n\n"
+            "@ingroup Debugging" )
+{
+   ProfilerFrameHistogram::reset();
+}
+
 DefineEngineFunction( profilerReset, void, (),,
             "@brief Resets the profiler, clearing it of all its data.\n\n"
             "If the profiler is currently running, it will first be disabled. "
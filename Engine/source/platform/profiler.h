@@ -119,6 +119,149 @@ public:
 
 extern Profiler *gProfiler;
 
+/// Timeline capture of profiler zones on all threads.
+///
+/// The Profiler only aggregates main thread time into a call tree.  While a
+/// trace capture is running, every PROFILE_START, PROFILE_SCOPE and PROFILE_END
+/// on any thread additionally appends a timestamped event to a fixed-size
+/// buffer owned by the executing thread, so recording takes no locks.  GPU
+/// zones measured with GFXTimerQuery are captured on a timeline of their own.
+/// Values recorded with recordCounter() show up as counter tracks.
+///
+/// The capture is exported in the Chrome trace event format which can be
+/// viewed in chrome://tracing or Perfetto:
+///
+/// @code
+/// profilerTraceStart();
+/// // ... run into the hitch ...
+/// profilerTraceStop( "trace.json" );
+/// @endcode
+class ProfilerTrace
+{
+   public:
+
+      enum EventType
+      {
+         EventBegin,
+         EventEnd,
+
+         /// GPU zone with an explicit duration.
+         EventGPU,
+
+         /// Value of a counter track.
+         EventCounter,
+      };
+
+      struct Event
+      {
+         /// CPU timestamp as returned by getTimestamp().
+         U64 mTime;
+
+         /// Duration in nanoseconds for EventGPU or the
+         /// value for EventCounter.
+         U64 mDuration;
+
+         const char* mName;
+         U32 mType;
+      };
+
+      struct ThreadBuffer;
+
+   protected:
+
+      static bool smCapturing;
+      static U32 smCaptureId;
+      static U32 smMaxEventsPerThread;
+
+      static void _record( U32 type, const char* name, U64 duration = 0 );
+
+   public:
+
+      /// Return true if a capture is in progress.
+      static bool isCapturing() { return smCapturing; }
+
+      /// Start a new capture, discarding the previous one.
+      /// @param maxEventsPerThread Events each thread can record before further
+      ///   events are dropped.
+      static void start( U32 maxEventsPerThread = 65536 );
+
+      /// Stop capturing.  The capture stays around for writeChromeTrace().
+      static void stop();
+
+      /// Write the last capture to @a fileName in Chrome trace event format.
+      static bool writeChromeTrace( const char* fileName );
+
+      /// Return a high-resolution CPU timestamp.  On x86 this is the
+      /// time stamp counter.
+      static U64 getTimestamp();
+
+      /// Record the start of a zone on the current thread.
+      static void beginZone( const char* name ) { if( smCapturing ) _record( EventBegin, name ); }
+
+      /// Record the end of the innermost zone on the current thread.
+      static void endZone() { if( smCapturing ) _record( EventEnd, NULL ); }
+
+      /// Record a zone on the GPU timeline.
+      /// @param startTime CPU timestamp at which the GPU work was issued.
+      /// @param durationNs GPU time taken in nanoseconds.
+      static void recordGPUZone( const char* name, U64 startTime, U64 durationNs );
+
+      /// Record the current value of the counter track @a name on the current
+      /// thread.  @a name must stay valid until the capture has been written.
+      static void recordCounter( const char* name, U64 value ) { if( smCapturing ) _record( EventCounter, name, value ); }
+};
+
+/// Distribution of main loop frame times.
+///
+/// The main loop records the time between the starts of consecutive
+/// iterations.  Uneven pacing hides in averages; a steady 16ms and an
+/// alternating 8/24ms look alike in the profiler but not here.  While a trace
+/// capture is running every frame time also goes to the "FrameTimeUs"
+/// counter track.
+class ProfilerFrameHistogram
+{
+   public:
+
+      enum
+      {
+         /// Width of a bucket in microseconds.
+         BucketUs = 250,
+
+         /// Frames slower than NumBuckets * BucketUs all land in the last bucket.
+         NumBuckets = 400,
+      };
+
+   protected:
+
+      static U32 smBuckets[ NumBuckets ];
+      static U32 smCount;
+      static U64 smTotalUs;
+      static U32 smMinUs;
+      static U32 smMaxUs;
+      static U64 smLastFrameStart;
+
+   public:
+
+      /// Called by the main loop at the start of every iteration.
+      static void beginFrame();
+
+      /// Add a frame time to the histogram.
+      static void record( U32 frameUs );
+
+      /// Clear all recorded frame times.
+      static void reset();
+
+      /// Return the number of recorded frames.
+      static U32 getCount() { return smCount; }
+
+      /// Return the frame time in microseconds that @a percentile percent of
+      /// the recorded frames stayed under, at a resolution of BucketUs.
+      static U32 getPercentile( F32 percentile );
+
+      /// Print the statistics and histogram to the console.
+      static void dumpToConsole();
+};
+
 struct ProfilerRootData
 {
    const char *mName;
@@ -184,11 +327,14 @@ public:
    static ProfilerRootData pdata##name##obj (#name); \
    ScopedProfiler scopedProfiler##name##obj(&pdata##name##obj);
 
+#define PROFILE_FRAME_BEGIN() ProfilerFrameHistogram::beginFrame()
+
 #else
 #define PROFILE_START(x)
 #define PROFILE_END()
 #define PROFILE_SCOPE(x)
 #define PROFILE_END_NAMED(x)
+#define PROFILE_FRAME_BEGIN()
 #endif
 
 #endif
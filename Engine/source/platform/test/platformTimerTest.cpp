@@ -44,6 +44,17 @@ TEST(Platform, Sleep)
       << "We didn't sleep at least as long as we requested!";
 };
 
+TEST(Platform, SleepMicroseconds)
+{
+   U64 start = Platform::getRealMicroseconds();
+   Platform::sleepMicroseconds(20000);
+   U64 end = Platform::getRealMicroseconds();
+   EXPECT_GE(end, start)
+      << "The microsecond clock went backwards!";
+   EXPECT_GE(end - start, 20000-1000) // account for clock resolution
+      << "We didn't sleep at least as long as we requested!";
+};
+
 struct handle
 {
    S32 mElapsedTime;
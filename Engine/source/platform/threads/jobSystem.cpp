@@ -0,0 +1,483 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "platform/threads/jobSystem.h"
+#include "platform/threads/threadPool.h"
+#include "platform/threads/thread.h"
+#include "platform/profiler.h"
+
+
+//=============================================================================
+//    Atomics.
+//=============================================================================
+
+/// Atomically store @a value with full barrier semantics.
+static inline void atomicStore( volatile U32& ref, U32 value )
+{
+   U32 oldValue;
+   do
+   {
+      oldValue = ref;
+   }
+   while( !dCompareAndSwap( ref, oldValue, value ) );
+}
+
+/// Atomically decrement @a ref and return the new value.
+static inline U32 atomicDecrement( volatile U32& ref )
+{
+   U32 oldValue;
+   do
+   {
+      oldValue = ref;
+   }
+   while( !dCompareAndSwap( ref, oldValue, oldValue - 1 ) );
+   return oldValue - 1;
+}
+
+//=============================================================================
+//    JobSystem::WorkerQueue.
+//=============================================================================
+
+/// Per-thread job storage and Chase-Lev style work-stealing deque.
+///
+/// Only the owning thread calls push(), pop() and allocate().  Any thread
+/// may call steal().  Indices are free-running and compared by their
+/// signed difference so they can wrap.
+struct JobSystem::WorkerQueue
+{
+   enum
+   {
+      Capacity = JobsPerThread,
+      Mask = Capacity - 1,
+   };
+
+   Job* mJobs[ Capacity ];
+   volatile U32 mTop;
+   volatile U32 mBottom;
+
+   Job mJobPool[ JobsPerThread ];
+   U32 mNextJob;
+
+   /// State for picking steal victims.
+   U32 mRandom;
+
+   WorkerQueue( U32 seed )
+      : mTop( 0 ),
+        mBottom( 0 ),
+        mNextJob( 0 ),
+        mRandom( seed * 2654435761U + 1 )
+   {
+      dMemset( mJobs, 0, sizeof( mJobs ) );
+      dMemset( mJobPool, 0, sizeof( mJobPool ) );
+   }
+
+   Job* allocate()
+   {
+      Job* job = &mJobPool[ mNextJob & Mask ];
+      mNextJob ++;
+      return job;
+   }
+
+   bool push( Job* job )
+   {
+      const U32 bottom = mBottom;
+      const U32 top = dAtomicRead( mTop );
+      if( bottom - top >= U32( Capacity ) )
+         return false;
+
+      mJobs[ bottom & Mask ] = job;
+
+      // Full barrier; publishes the job before the new bottom.
+      atomicStore( mBottom, bottom + 1 );
+      return true;
+   }
+
+   Job* pop()
+   {
+      const U32 bottom = mBottom - 1;
+      atomicStore( mBottom, bottom );
+
+      const U32 top = dAtomicRead( mTop );
+      if( S32( bottom - top ) < 0 )
+      {
+         // Empty.
+         atomicStore( mBottom, top );
+         return NULL;
+      }
+
+      Job* job = mJobs[ bottom & Mask ];
+      if( bottom != top )
+         return job;
+
+      // Last job; we are racing thieves for it.
+      if( !dCompareAndSwap( mTop, top, top + 1 ) )
+         job = NULL;
+
+      atomicStore( mBottom, top + 1 );
+      return job;
+   }
+
+   Job* steal()
+   {
+      const U32 top = dAtomicRead( mTop );
+      const U32 bottom = dAtomicRead( mBottom );
+      if( S32( bottom - top ) <= 0 )
+         return NULL;
+
+      Job* job = mJobs[ top & Mask ];
+      if( !dCompareAndSwap( mTop, top, top + 1 ) )
+         return NULL;
+
+      return job;
+   }
+
+   U32 nextRandom()
+   {
+      // xorshift32
+      mRandom ^= mRandom << 13;
+      mRandom ^= mRandom >> 17;
+      mRandom ^= mRandom << 5;
+      return mRandom;
+   }
+};
+
+//=============================================================================
+//    JobSystem::HelperItem.
+//=============================================================================
+
+/// Work item that lends a thread pool thread to the job system for as long
+/// as there are jobs to execute.
+struct JobSystem::HelperItem : public ThreadPool::WorkItem
+{
+   typedef ThreadPool::WorkItem Parent;
+
+   JobSystem* mJobSystem;
+
+   HelperItem( JobSystem* jobSystem )
+      : mJobSystem( jobSystem ) {}
+
+protected:
+
+   virtual void execute()
+   {
+      WorkerQueue* queue = mJobSystem->_getThreadQueue();
+
+      // Spin for a little while after running dry so that bursts of
+      // jobs don't constantly create new helpers.
+      const U32 maxIdleSpins = 64;
+      U32 idleSpins = 0;
+
+      while( idleSpins < maxIdleSpins )
+      {
+         Job* job = mJobSystem->_findJob( queue );
+         if( job )
+         {
+            mJobSystem->_execute( job );
+            idleSpins = 0;
+         }
+         else
+            idleSpins ++;
+      }
+
+      dFetchAndAdd( mJobSystem->mNumHelpers, ( U32 ) -1 );
+   }
+};
+
+//=============================================================================
+//    JobSystem.
+//=============================================================================
+
+//--------------------------------------------------------------------------
+
+JobSystem::JobSystem( U32 maxHelpers )
+   : mNumQueues( 0 ),
+     mNumHelpers( 0 ),
+     mMaxHelpers( maxHelpers ),
+     mNextOverflowJob( 0 )
+{
+   dMemset( mQueues, 0, sizeof( mQueues ) );
+   dMemset( mOverflowJobs, 0, sizeof( mOverflowJobs ) );
+}
+
+//--------------------------------------------------------------------------
+
+JobSystem::~JobSystem()
+{
+   // Wait for any helpers to wind down before we pull the queues
+   // out from under them.
+   while( dAtomicRead( mNumHelpers ) )
+      Platform::sleep( 1 );
+
+   for( U32 i = 0; i < MaxThreads; ++ i )
+      delete mQueues[ i ];
+}
+
+//--------------------------------------------------------------------------
+
+JobSystem::WorkerQueue* JobSystem::_getThreadQueue()
+{
+   WorkerQueue* queue = reinterpret_cast< WorkerQueue* >( mThreadQueue.get() );
+   if( queue )
+      return queue;
+
+   // Claim a slot for this thread.
+
+   U32 index;
+   do
+   {
+      index = dAtomicRead( mNumQueues );
+      if( index >= MaxThreads )
+         return NULL;
+   }
+   while( !dCompareAndSwap( mNumQueues, index, index + 1 ) );
+
+   queue = new WorkerQueue( index );
+   mQueues[ index ] = queue;
+   mThreadQueue.set( queue );
+
+   return queue;
+}
+
+//--------------------------------------------------------------------------
+
+JobSystem::Job* JobSystem::_findJob( WorkerQueue* queue )
+{
+   if( queue )
+   {
+      Job* job = queue->pop();
+      if( job )
+         return job;
+   }
+
+   // Nothing on our own deque; try stealing, starting at a random victim.
+
+   const U32 numQueues = dAtomicRead( mNumQueues );
+   if( !numQueues )
+      return NULL;
+
+   const U32 start = queue ? ( queue->nextRandom() % numQueues ) : 0;
+   for( U32 i = 0; i < numQueues; ++ i )
+   {
+      WorkerQueue* victim = mQueues[ ( start + i ) % numQueues ];
+      if( !victim || victim == queue )
+         continue;
+
+      Job* job = victim->steal();
+      if( job )
+         return job;
+   }
+
+   return NULL;
+}
+
+//--------------------------------------------------------------------------
+
+void JobSystem::_execute( Job* job )
+{
+   job->mFunction( job, job->mData );
+   _finish( job );
+}
+
+//--------------------------------------------------------------------------
+
+void JobSystem::_finish( Job* job )
+{
+   while( job && atomicDecrement( job->mNumUnfinished ) == 0 )
+      job = job->mParent;
+}
+
+//--------------------------------------------------------------------------
+
+void JobSystem::_wakeHelpers()
+{
+   // With everything forced onto the main thread, wait() picks up all jobs.
+   if( ThreadPool::getForceAllMainThread() )
+      return;
+
+   // The global thread pool only accepts items from the main thread.
+   // Helpers themselves keep stealing so jobs spawned from within jobs
+   // still get spread out.
+   if( !ThreadManager::isMainThread() )
+      return;
+
+   const U32 maxHelpers = mMaxHelpers ? mMaxHelpers : ThreadPool::GLOBAL().getNumThreads();
+
+   U32 numHelpers = dAtomicRead( mNumHelpers );
+   while( numHelpers < maxHelpers )
+   {
+      if( dCompareAndSwap( mNumHelpers, numHelpers, numHelpers + 1 ) )
+      {
+         ThreadSafeRef< HelperItem > item( new HelperItem( this ) );
+         ThreadPool::GLOBAL().queueWorkItem( item );
+         return;
+      }
+
+      numHelpers = dAtomicRead( mNumHelpers );
+   }
+}
+
+//--------------------------------------------------------------------------
+
+JobSystem::Job* JobSystem::createJob( JobFunction function, void* data, Job* parent )
+{
+   AssertFatal( function != NULL, "JobSystem::createJob - No job function" );
+   AssertFatal( !parent || !parent->isFinished(), "JobSystem::createJob - Parent has already finished" );
+
+   Job* job;
+   WorkerQueue* queue = _getThreadQueue();
+   if( queue )
+      job = queue->allocate();
+   else
+   {
+      // Out of thread slots.  run() executes jobs of such threads right
+      // away but their storage must still outlive their children.
+      U32 index;
+      do
+      {
+         index = dAtomicRead( mNextOverflowJob );
+      }
+      while( !dCompareAndSwap( mNextOverflowJob, index, index + 1 ) );
+
+      job = &mOverflowJobs[ index & ( JobsPerThread - 1 ) ];
+   }
+
+   AssertFatal( job->mNumUnfinished == 0,
+      "JobSystem::createJob - Job storage exhausted; too many jobs in flight on this thread" );
+
+   job->mFunction = function;
+   job->mData = data;
+   job->mParent = parent;
+   job->mNumUnfinished = 1;
+   job->mRangeStart = 0;
+   job->mRangeEnd = 0;
+
+   if( parent )
+      dFetchAndAdd( parent->mNumUnfinished, 1 );
+
+   return job;
+}
+
+//--------------------------------------------------------------------------
+
+void JobSystem::run( Job* job )
+{
+   WorkerQueue* queue = _getThreadQueue();
+   if( !queue || !queue->push( job ) )
+   {
+      // No room; just do it ourselves.
+      _execute( job );
+      return;
+   }
+
+   _wakeHelpers();
+}
+
+//--------------------------------------------------------------------------
+
+void JobSystem::wait( Job* job )
+{
+   PROFILE_SCOPE( JobSystem_Wait );
+
+   WorkerQueue* queue = _getThreadQueue();
+   U32 idleSpins = 0;
+
+   while( !job->isFinished() )
+   {
+      Job* next = _findJob( queue );
+      if( next )
+      {
+         _execute( next );
+         idleSpins = 0;
+      }
+      else if( ++ idleSpins > 64 )
+      {
+         // Whatever is left is running on other threads.
+         Platform::sleep( 0 );
+         idleSpins = 0;
+      }
+   }
+}
+
+//--------------------------------------------------------------------------
+
+namespace {
+
+struct ParallelForData
+{
+   JobSystem* mJobSystem;
+   JobSystem::ParallelForFunction mFunction;
+   void* mData;
+   U32 mBatchSize;
+};
+
+} // namespace {}
+
+void JobSystem::_parallelForJob( Job* job, void* data )
+{
+   ParallelForData* info = reinterpret_cast< ParallelForData* >( data );
+
+   // Keep splitting the range in half and hand the upper half off so that
+   // other threads can steal large chunks of work early on.
+
+   U32 start = job->getRangeStart();
+   U32 end = job->getRangeEnd();
+
+   while( end - start > info->mBatchSize )
+   {
+      const U32 mid = start + ( end - start ) / 2;
+
+      Job* child = info->mJobSystem->createJob( _parallelForJob, info, job );
+      child->setRange( mid, end );
+      info->mJobSystem->run( child );
+
+      end = mid;
+   }
+
+   info->mFunction( info->mData, start, end );
+}
+
+void JobSystem::parallelFor( U32 count, U32 batchSize, ParallelForFunction function, void* data )
+{
+   PROFILE_SCOPE( JobSystem_ParallelFor );
+
+   if( !count )
+      return;
+
+   ParallelForData info;
+   info.mJobSystem = this;
+   info.mFunction = function;
+   info.mData = data;
+   info.mBatchSize = getMax( batchSize, U32( 1 ) );
+
+   // Don't bother with jobs if it would all fit into a single batch.
+   if( count <= info.mBatchSize )
+   {
+      function( data, 0, count );
+      return;
+   }
+
+   Job* root = createJob( _parallelForJob, &info );
+   root->setRange( 0, count );
+   run( root );
+   wait( root );
+}
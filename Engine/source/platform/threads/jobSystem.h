@@ -0,0 +1,226 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _JOBSYSTEM_H_
+#define _JOBSYSTEM_H_
+
+#ifndef _PLATFORMINTRINSICS_H_
+   #include "platform/platformIntrinsics.h"
+#endif
+#ifndef _PLATFORMTLS_H_
+   #include "platform/platformTLS.h"
+#endif
+#ifndef _TSINGLETON_H_
+   #include "core/util/tSingleton.h"
+#endif
+
+
+/// @file
+/// Work-stealing scheduler for fine-grained, per-frame parallel work.
+
+
+/// Work-stealing job scheduler.
+///
+/// ThreadPool is built for coarse, long-running asynchronous work (I/O,
+/// resource loading) and pays for refcounting, priority queueing and a
+/// shared lock on every item.  JobSystem is meant for the opposite case:
+/// thousands of tiny jobs per frame that are spawned and waited on within
+/// the same frame.
+///
+/// Each thread that submits or executes jobs owns a fixed-size, lock-free
+/// deque.  The owner pushes and pops at the bottom while idle threads steal
+/// from the top of other threads' deques, so threads only contend when the
+/// load is imbalanced.  Jobs are allocated from per-thread ring buffers and
+/// never touch the heap.
+///
+/// The job system does not own any threads.  When jobs are submitted and
+/// not all helpers are busy, it feeds helper work items to ThreadPool::GLOBAL()
+/// that keep executing and stealing jobs until they run out of work.  Threads
+/// waiting on a job also help out executing jobs, so waiting never idles a
+/// thread while work is still pending.
+///
+/// @note A job and all jobs it depends on must finish before the submitting
+///   thread has allocated another JobsPerThread jobs as the job storage is
+///   recycled in a ring.
+///
+/// @see ThreadPool
+class JobSystem
+{
+   public:
+
+      class Job;
+
+      /// Function executed by a job.
+      typedef void ( *JobFunction )( Job* job, void* data );
+
+      /// Function executed by parallelFor() for each batch of the range [start,end).
+      typedef void ( *ParallelForFunction )( void* data, U32 start, U32 end );
+
+      enum
+      {
+         /// Maximum number of threads that can own a job deque.  Threads
+         /// beyond this number execute their jobs inline.
+         MaxThreads = 64,
+
+         /// Number of jobs each thread can have in flight.  Must be a power of two.
+         JobsPerThread = 4096,
+      };
+
+      /// A unit of work.
+      ///
+      /// Jobs form a tree: a job is not finished until all the children
+      /// created for it have finished, so waiting on a parent waits on the
+      /// whole tree.
+      class Job
+      {
+         protected:
+
+            friend class JobSystem;
+
+            JobFunction mFunction;
+            void* mData;
+            Job* mParent;
+
+            /// Number of unfinished jobs in this job's tree including itself.
+            volatile U32 mNumUnfinished;
+
+            /// Free-form range for parallelFor-style jobs.
+            U32 mRangeStart;
+            U32 mRangeEnd;
+
+            /// Pad to a cache line to keep threads working on neighboring
+            /// jobs from false sharing.
+            U8 mPadding[ 64 - sizeof( JobFunction ) - 2 * sizeof( void* ) - 3 * sizeof( U32 ) ];
+
+         public:
+
+            /// Return the user data passed when the job was created.
+            void* getData() const { return mData; }
+
+            /// Return the parent of this job or NULL.
+            Job* getParent() const { return mParent; }
+
+            /// Return the range assigned by setRange().
+            U32 getRangeStart() const { return mRangeStart; }
+            U32 getRangeEnd() const { return mRangeEnd; }
+
+            /// Assign a range to the job.  Used by parallelFor() and free for
+            /// other job functions to use for the same purpose.
+            void setRange( U32 start, U32 end ) { mRangeStart = start; mRangeEnd = end; }
+
+            /// Return true if the job and all of its children have finished executing.
+            bool isFinished() const { return ( dAtomicRead( const_cast< volatile U32& >( mNumUnfinished ) ) == 0 ); }
+      };
+
+      struct GlobalJobSystem;
+
+   protected:
+
+      struct WorkerQueue;
+      struct HelperItem;
+
+      friend struct HelperItem;
+
+      /// Deques of all registered threads.
+      WorkerQueue* mQueues[ MaxThreads ];
+
+      /// Number of entries in #mQueues that are in use.
+      volatile U32 mNumQueues;
+
+      /// Number of helper work items currently queued or running on the thread pool.
+      volatile U32 mNumHelpers;
+
+      /// Maximum number of helper work items to have in flight.
+      U32 mMaxHelpers;
+
+      /// Per-thread pointer to the thread's WorkerQueue.
+      ThreadStorage mThreadQueue;
+
+      /// Shared job storage for threads that did not get a queue slot.
+      Job mOverflowJobs[ JobsPerThread ];
+
+      /// Next free entry in #mOverflowJobs.
+      volatile U32 mNextOverflowJob;
+
+      /// Return the WorkerQueue for the current thread, registering the thread if needed.
+      /// @return NULL if all queue slots have been taken.
+      WorkerQueue* _getThreadQueue();
+
+      /// Take a job off our own deque or steal one from another thread.
+      Job* _findJob( WorkerQueue* queue );
+
+      /// Run @a job and mark it as finished.
+      void _execute( Job* job );
+
+      /// Mark one unit of @a job's tree as finished and propagate to its parent.
+      void _finish( Job* job );
+
+      /// Make sure there are helpers on the thread pool to pick up new jobs.
+      void _wakeHelpers();
+
+      static void _parallelForJob( Job* job, void* data );
+
+   public:
+
+      /// @param maxHelpers Maximum number of thread pool threads to occupy
+      ///   with jobs at any time.  Zero uses all threads of ThreadPool::GLOBAL().
+      JobSystem( U32 maxHelpers = 0 );
+      ~JobSystem();
+
+      /// Create a new job.  The job does not start executing until passed to run().
+      ///
+      /// @param function Function to execute.
+      /// @param data User data to pass to @a function.
+      /// @param parent If not NULL, @a parent will not finish until the new job has.
+      ///   The parent must not have finished yet.
+      Job* createJob( JobFunction function, void* data = NULL, Job* parent = NULL );
+
+      /// Submit @a job for execution.
+      void run( Job* job );
+
+      /// Block until @a job and all of its children have finished.  The
+      /// calling thread executes pending jobs while waiting.
+      void wait( Job* job );
+
+      /// Split the range [0,count) into batches of at most @a batchSize indices,
+      /// execute @a function for each batch in parallel, and wait until all
+      /// batches have completed.
+      void parallelFor( U32 count, U32 batchSize, ParallelForFunction function, void* data = NULL );
+
+      /// Return the global job system singleton.
+      static JobSystem& GLOBAL();
+};
+
+struct JobSystem::GlobalJobSystem : public JobSystem, public ManagedSingleton< GlobalJobSystem >
+{
+   typedef JobSystem Parent;
+
+   // For ManagedSingleton.
+   static const char* getSingletonName() { return "GlobalJobSystem"; }
+};
+
+inline JobSystem& JobSystem::GLOBAL()
+{
+   return *( GlobalJobSystem::instance() );
+}
+
+#endif // !_JOBSYSTEM_H_
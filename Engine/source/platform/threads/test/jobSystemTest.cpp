@@ -0,0 +1,80 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/threads/jobSystem.h"
+#include "core/util/tVector.h"
+
+FIXTURE(JobSystem)
+{
+public:
+   // Fill each index of the range with itself.
+   static void fillRange(void* data, U32 start, U32 end)
+   {
+      Vector<U32>& results = *reinterpret_cast<Vector<U32>*>(data);
+      for (U32 i = start; i < end; i++)
+         results[i] = i;
+   }
+
+   // Bump a counter once per job.
+   static void countJob(JobSystem::Job* job, void* data)
+   {
+      dFetchAndAdd(*reinterpret_cast<volatile U32*>(data), 1);
+   }
+};
+
+TEST_FIX(JobSystem, ParallelFor)
+{
+   const U32 numItems = 10000;
+   Vector<U32> results(__FILE__, __LINE__);
+   results.setSize(numItems);
+   for (U32 i = 0; i < numItems; i++)
+      results[i] = U32(-1);
+
+   JobSystem::GLOBAL().parallelFor(numItems, 64, &fillRange, &results);
+
+   for (U32 i = 0; i < numItems; i++)
+      EXPECT_EQ(results[i], i)
+         << "parallelFor did not cover every index";
+}
+
+TEST_FIX(JobSystem, ParentWaitsForChildren)
+{
+   JobSystem& jobs = JobSystem::GLOBAL();
+
+   volatile U32 counter = 0;
+   const U32 numChildren = 500;
+
+   JobSystem::Job* root = jobs.createJob(&countJob, (void*)&counter);
+   for (U32 i = 0; i < numChildren; i++)
+      jobs.run(jobs.createJob(&countJob, (void*)&counter, root));
+
+   jobs.run(root);
+   jobs.wait(root);
+
+   EXPECT_TRUE(root->isFinished());
+   EXPECT_EQ(counter, numChildren + 1)
+      << "Parent finished before all of its children";
+}
+
+#endif
@@ -118,4 +118,31 @@ TEST_FIX(ThreadPool, Synchronous)
    EXPECT_EQ(true, item->hasExecuted());
 }
 
+TEST_FIX(ThreadPool, Configure)
+{
+   const U32 numItems = 100;
+   Vector<U32> results(__FILE__, __LINE__);
+   results.setSize(numItems);
+   for (U32 i = 0; i < numItems; i++)
+      results[i] = U32(-1);
+
+   ThreadPool pool("TEST", 1);
+
+   // Queue the first half before replacing the threads so
+   // we know queued items survive that.
+   for (U32 i = 0; i < numItems / 2; i++)
+      pool.queueWorkItem(new TestItem(i, results));
+
+   pool.configure(2, 0, ThreadPriorityLow);
+   EXPECT_EQ(2, pool.getNumThreads());
+
+   for (U32 i = numItems / 2; i < numItems; i++)
+      pool.queueWorkItem(new TestItem(i, results));
+
+   pool.waitForAllItems();
+
+   for (U32 i = 0; i < numItems; i++)
+      EXPECT_EQ(results[i], i) << "result mismatch";
+}
+
 #endif
\ No newline at end of file
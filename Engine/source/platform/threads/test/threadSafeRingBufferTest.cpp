@@ -0,0 +1,216 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+
+#include "platform/threads/threadSafeRingBuffer.h"
+#include "platform/threads/threadSafeDeque.h"
+#include "platform/threads/thread.h"
+#include "core/util/tVector.h"
+#include "console/console.h"
+
+FIXTURE(ThreadSafeRingBuffer)
+{
+public:
+   enum
+   {
+      NumProducers = 4,
+      NumValuesPerProducer = 20000,
+   };
+
+   // Values encode their producer in the upper bits so consumers can check
+   // that each producer's values come out in order.
+   static U32 makeValue(U32 producer, U32 index) { return (producer << 24) | (index + 1); }
+   static U32 getProducer(U32 value) { return value >> 24; }
+   static U32 getIndex(U32 value) { return (value & 0xFFFFFF) - 1; }
+
+   template<typename Queue>
+   struct ProducerThread : public Thread
+   {
+      Queue& mQueue;
+      U32 mProducer;
+      ProducerThread(Queue& queue, U32 producer)
+         : mQueue(queue), mProducer(producer) {}
+
+      virtual void run(void*)
+      {
+         for (U32 i = 0; i < NumValuesPerProducer; i++)
+            mQueue.pushBack(makeValue(mProducer, i));
+      }
+   };
+
+   template<typename Queue>
+   struct ConsumerThread : public Thread
+   {
+      Queue& mQueue;
+      volatile U32& mNumConsumed;
+      U32 mLastIndex[NumProducers];
+      bool mInOrder;
+
+      ConsumerThread(Queue& queue, volatile U32& numConsumed)
+         : mQueue(queue), mNumConsumed(numConsumed), mInOrder(true)
+      {
+         for (U32 i = 0; i < NumProducers; i++)
+            mLastIndex[i] = U32(-1);
+      }
+
+      virtual void run(void*)
+      {
+         const U32 total = NumProducers * NumValuesPerProducer;
+         while (dAtomicRead(mNumConsumed) < total)
+         {
+            U32 value;
+            if (!mQueue.tryPopFront(value))
+               continue;
+
+            const U32 producer = getProducer(value);
+            const U32 index = getIndex(value);
+            if (mLastIndex[producer] != U32(-1) && index <= mLastIndex[producer])
+               mInOrder = false;
+            mLastIndex[producer] = index;
+
+            dFetchAndAdd(mNumConsumed, 1);
+         }
+      }
+   };
+
+   /// Run NumProducers producers and as many consumers over @a queue and
+   /// return the time taken in milliseconds.
+   template<typename Queue>
+   static U32 runConcurrent(Queue& queue, bool& outInOrder)
+   {
+      volatile U32 numConsumed = 0;
+
+      Vector<ProducerThread<Queue>*> producers;
+      Vector<ConsumerThread<Queue>*> consumers;
+      for (U32 i = 0; i < NumProducers; i++)
+      {
+         producers.push_back(new ProducerThread<Queue>(queue, i));
+         consumers.push_back(new ConsumerThread<Queue>(queue, numConsumed));
+      }
+
+      const U32 startTime = Platform::getRealMilliseconds();
+
+      for (U32 i = 0; i < NumProducers; i++)
+      {
+         consumers[i]->start();
+         producers[i]->start();
+      }
+
+      outInOrder = true;
+      for (U32 i = 0; i < NumProducers; i++)
+      {
+         producers[i]->join();
+         consumers[i]->join();
+         outInOrder &= consumers[i]->mInOrder;
+
+         delete producers[i];
+         delete consumers[i];
+      }
+
+      EXPECT_EQ(numConsumed, U32(NumProducers * NumValuesPerProducer));
+
+      return Platform::getRealMilliseconds() - startTime;
+   }
+};
+
+TEST_FIX(ThreadSafeRingBuffer, Basics)
+{
+   ThreadSafeRingBuffer<U32> queue(5);
+   EXPECT_EQ(queue.getCapacity(), 8);
+   EXPECT_TRUE(queue.isEmpty());
+
+   for (U32 i = 0; i < 8; i++)
+      EXPECT_TRUE(queue.tryPushBack(i));
+   EXPECT_FALSE(queue.tryPushBack(8)) << "Push should fail on a full buffer";
+
+   // Wrap around a few times.
+   U32 value;
+   for (U32 i = 0; i < 100; i++)
+   {
+      EXPECT_TRUE(queue.tryPopFront(value));
+      EXPECT_EQ(value, i);
+      EXPECT_TRUE(queue.tryPushBack(i + 8));
+   }
+
+   for (U32 i = 0; i < 8; i++)
+      EXPECT_TRUE(queue.tryPopFront(value));
+   EXPECT_FALSE(queue.tryPopFront(value)) << "Pop should fail on an empty buffer";
+   EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST_FIX(ThreadSafeRingBuffer, SPSCBasics)
+{
+   ThreadSafeSPSCRingBuffer<U32> queue(4);
+   EXPECT_EQ(queue.getCapacity(), 4);
+
+   for (U32 i = 0; i < 4; i++)
+      EXPECT_TRUE(queue.tryPushBack(i));
+   EXPECT_FALSE(queue.tryPushBack(4));
+
+   U32 value;
+   for (U32 i = 0; i < 4; i++)
+   {
+      EXPECT_TRUE(queue.tryPopFront(value));
+      EXPECT_EQ(value, i);
+   }
+   EXPECT_FALSE(queue.tryPopFront(value));
+}
+
+TEST_FIX(ThreadSafeRingBuffer, SPSCConcurrent)
+{
+   ThreadSafeSPSCRingBuffer<U32> queue(64);
+   volatile U32 numConsumed = 0;
+
+   ProducerThread<ThreadSafeSPSCRingBuffer<U32> > producer(queue, 0);
+   ConsumerThread<ThreadSafeSPSCRingBuffer<U32> > consumer(queue, numConsumed);
+
+   // A single producer only pushes a fraction of what the consumer waits for.
+   numConsumed = (NumProducers - 1) * NumValuesPerProducer;
+
+   consumer.start();
+   producer.start();
+   producer.join();
+   consumer.join();
+
+   EXPECT_TRUE(consumer.mInOrder) << "Values came out of order";
+}
+
+// Not strictly a test; compares throughput against ThreadSafeDeque under
+// multi-producer, multi-consumer contention.
+TEST_FIX(ThreadSafeRingBuffer, CompareToDeque)
+{
+   bool inOrder;
+
+   ThreadSafeRingBuffer<U32> ringBuffer(1024);
+   const U32 ringBufferTime = runConcurrent(ringBuffer, inOrder);
+   EXPECT_TRUE(inOrder) << "ThreadSafeRingBuffer values came out of order";
+
+   ThreadSafeDeque<U32> deque;
+   const U32 dequeTime = runConcurrent(deque, inOrder);
+
+   Con::printf("ThreadSafeRingBuffer: %i values through %i producers/consumers in %ims (ThreadSafeDeque: %ims)",
+      NumProducers * NumValuesPerProducer, NumProducers, ringBufferTime, dequeTime);
+}
+
+#endif
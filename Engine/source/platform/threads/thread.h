@@ -44,6 +44,14 @@ class PlatformThreadData;
 // Typedefs
 typedef void (*ThreadRunFunction)(void *data);
 
+/// Scheduling priority of a thread relative to the others in the process.
+enum ThreadPriority
+{
+   ThreadPriorityLow,
+   ThreadPriorityNormal,
+   ThreadPriorityHigh,
+};
+
 class Thread
 {
 public:
@@ -56,6 +64,12 @@ protected:
    /// Threads set this flag to false in start()
    U32 shouldStop;
 
+   /// Logical processors the thread may run on or zero for any.
+   U64 mAffinityMask;
+
+   /// Scheduling priority the thread runs with.
+   ThreadPriority mPriority;
+
    /// Set the name of this thread for identification in debuggers.
    /// Maybe a NOP on platforms that do not support this.  Always a NOP
    /// in non-debug builds.
@@ -111,6 +125,17 @@ public:
 
    /// Returns the platform specific thread id for this thread.
    U32 getId();
+
+   /// Set the logical processors the thread may run on, one bit per
+   /// processor, or zero to let the OS decide.  Takes effect the next
+   /// time the thread is started.
+   void setAffinity( U64 mask ) { mAffinityMask = mask; }
+   U64 getAffinity() const { return mAffinityMask; }
+
+   /// Set the priority the thread runs with.  Takes effect the next
+   /// time the thread is started.
+   void setPriority( ThreadPriority priority ) { mPriority = priority; }
+   ThreadPriority getPriority() const { return mPriority; }
 };
 
 
@@ -167,6 +192,26 @@ public:
 
    /// Returns the platform specific thread id ot the main thread.
    static U32 getMainThreadId() { return smMainThreadId.get(); }
+
+   /// Restricts the calling thread to the given logical processors, one bit
+   /// per processor.  A mask of zero allows all of them again.  Returns false
+   /// if the platform doesn't support it or refused.
+   static bool setCurrentThreadAffinity( U64 mask );
+
+   /// Changes the scheduling priority of the calling thread.  Returns false if
+   /// the platform doesn't support it or refused, e.g. raising the priority
+   /// without the needed privileges.
+   static bool setCurrentThreadPriority( ThreadPriority priority );
+
+   /// Applies the affinity and priority set on a thread.  The platform code
+   /// calls this on the new thread before running it.
+   static void applyThreadSettings( Thread* thread )
+   {
+      if( thread->getAffinity() )
+         setCurrentThreadAffinity( thread->getAffinity() );
+      if( thread->getPriority() != ThreadPriorityNormal )
+         setCurrentThreadPriority( thread->getPriority() );
+   }
    
    /// Each thread should add itself to the thread pool the first time it runs.
    static void addThread(Thread* thread)
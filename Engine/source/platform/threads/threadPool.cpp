@@ -24,7 +24,9 @@
 #include "platform/threads/thread.h"
 #include "platform/platformCPUCount.h"
 #include "core/strings/stringFunctions.h"
+#include "core/strings/stringUnit.h"
 #include "core/util/tSingleton.h"
+#include "console/engineAPI.h"
 
 
 //#define DEBUG_SPEW
@@ -312,10 +314,20 @@ ThreadPool::ThreadPool( const char* name, U32 numThreads )
      mNumThreadsAwake( 0 ),
      mNumPendingItems( 0 ),
      mSemaphore( 0 ),
-     mThreads( 0 )
+     mThreads( 0 ),
+     mAffinityMask( 0 ),
+     mPriority( ThreadPriorityNormal )
+{
+   _startThreads( numThreads );
+}
+
+//--------------------------------------------------------------------------
+
+void ThreadPool::_startThreads( U32 numThreads )
 {
    // Number of worker threads to create.
 
+   mNumThreads = numThreads;
    if( !mNumThreads )
    {
       // Use platformCPUInfo directly as in the case of the global pool,
@@ -342,12 +354,26 @@ ThreadPool::ThreadPool( const char* name, U32 numThreads )
    for( U32 i = 0; i < mNumThreads; i ++ )
    {
       WorkerThread* thread = new WorkerThread( this, i );
+      thread->setAffinity( mAffinityMask );
+      thread->setPriority( mPriority );
       thread->start();
    }
 }
 
 //--------------------------------------------------------------------------
 
+void ThreadPool::configure( U32 numThreads, U64 affinityMask, ThreadPriority priority )
+{
+   shutdown();
+
+   mAffinityMask = affinityMask;
+   mPriority = priority;
+
+   _startThreads( numThreads );
+}
+
+//--------------------------------------------------------------------------
+
 ThreadPool::~ThreadPool()
 {
 	shutdown();
@@ -479,3 +505,89 @@ void ThreadPool::processMainThreadWorkItems()
    }
    while( Platform::getRealMilliseconds() < timeLimit );
 }
+
+//=============================================================================
+//    Console.
+//=============================================================================
+
+/// Parse a list of logical processor indices and ranges like "0 1 4-7"
+/// into an affinity mask.  An empty list allows all processors.
+static U64 _parseProcessorMask( const char* processors )
+{
+   U64 mask = 0;
+
+   const U32 count = StringUnit::getUnitCount( processors, " \t," );
+   for( U32 i = 0; i < count; ++ i )
+   {
+      const char* unit = StringUnit::getUnit( processors, i, " \t," );
+
+      U32 first = 0;
+      U32 last = 0;
+      if( dSscanf( unit, "%u-%u", &first, &last ) != 2 )
+         last = first = dAtoui( unit );
+
+      for( U32 n = first; n <= last && n < 64; ++ n )
+         mask |= U64( 1 ) << n;
+   }
+
+   return mask;
+}
+
+static ThreadPriority _parseThreadPriority( const char* priority )
+{
+   if( dStricmp( priority, "low" ) == 0 )
+      return ThreadPriorityLow;
+   else if( dStricmp( priority, "high" ) == 0 )
+      return ThreadPriorityHigh;
+
+   return ThreadPriorityNormal;
+}
+
+DefineEngineFunction( getProcessorTopology, String, (),,
+   "@brief Returns the processor topology as \"logical cores packages\".\n\n"
+   "The number of logical processors is larger than the number of cores when "
+   "SMT (hyper-threading) is enabled.  Use it to decide how many worker threads "
+   "to run and which processors to pin them to with configureWorkerThreads().\n\n"
+   "@ingroup Platform" )
+{
+   const Platform::SystemInfo_struct::Processor& info = Platform::SystemInfo.processor;
+   return String::ToString( "%d %d %d",
+      info.numLogicalProcessors, info.numAvailableCores, info.numPhysicalProcessors );
+}
+
+DefineEngineFunction( setMainThreadAffinity, bool, ( const char* processors ), ( "" ),
+   "@brief Restricts the main thread to a set of logical processors.\n\n"
+   "The main thread also does the rendering and the networking.\n\n"
+   "@param processors Space separated processor indices and ranges like \"0 2-3\" "
+   "or an empty string to allow all of them.\n"
+   "@return False if the platform doesn't support it or refused.\n"
+   "@ingroup Platform" )
+{
+   AssertFatal( ThreadManager::isMainThread(), "setMainThreadAffinity - Not on the main thread!" );
+   return ThreadManager::setCurrentThreadAffinity( _parseProcessorMask( processors ) );
+}
+
+DefineEngineFunction( setMainThreadPriority, bool, ( const char* priority ), ( "normal" ),
+   "@brief Changes the scheduling priority of the main thread.\n\n"
+   "@param priority \"low\", \"normal\" or \"high\".  Raising the priority "
+   "may need extra privileges.\n"
+   "@return False if the platform doesn't support it or refused.\n"
+   "@ingroup Platform" )
+{
+   AssertFatal( ThreadManager::isMainThread(), "setMainThreadPriority - Not on the main thread!" );
+   return ThreadManager::setCurrentThreadPriority( _parseThreadPriority( priority ) );
+}
+
+DefineEngineFunction( configureWorkerThreads, void, ( S32 count, const char* processors, const char* priority ), ( 0, "", "normal" ),
+   "@brief Replaces the worker threads of the global thread pool.\n\n"
+   "Waits for the work items that are running to finish.  Useful to keep "
+   "several instances on one host from competing for the same cores.\n\n"
+   "@param count The number of worker threads or 0 to use one per logical processor.\n"
+   "@param processors Space separated processor indices and ranges like \"0 2-3\" "
+   "the workers may run on or an empty string to allow all of them.\n"
+   "@param priority \"low\", \"normal\" or \"high\".\n"
+   "@ingroup Platform" )
+{
+   ThreadPool::GLOBAL().configure( getMax( count, 0 ),
+      _parseProcessorMask( processors ), _parseThreadPriority( priority ) );
+}
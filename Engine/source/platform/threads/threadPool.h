@@ -32,6 +32,9 @@
 #ifndef _PLATFORM_THREAD_SEMAPHORE_H_
    #include "platform/threads/semaphore.h"
 #endif
+#ifndef _PLATFORM_THREADS_THREAD_H_
+   #include "platform/threads/thread.h"
+#endif
 #ifndef _TSINGLETON_H_
    #include "core/util/tSingleton.h"
 #endif
@@ -277,6 +280,12 @@ class ThreadPool
       /// List of worker threads.
       WorkerThread* mThreads;
 
+      /// Logical processors the worker threads may run on or zero for any.
+      U64 mAffinityMask;
+
+      /// Scheduling priority of the worker threads.
+      ThreadPriority mPriority;
+
       /// Force all work items to execute on main thread;
       /// turns this into a single-threaded system.
       /// Primarily useful to find whether malfunctions are caused
@@ -290,6 +299,10 @@ class ThreadPool
       /// main thread that need processing that can only happen on main thread.
       static QueueType smMainThreadQueue;
 
+      /// Spawn the worker threads.  Zero picks the number of
+      /// threads based on the number of CPU cores available.
+      void _startThreads( U32 numThreads );
+
    public:
 
       /// Create a new thread pool with the given number of worker threads.
@@ -305,6 +318,17 @@ class ThreadPool
       /// Manually shutdown threads outside of static destructors.
       void shutdown();
 
+      /// Replace the worker threads with a new set.
+      ///
+      /// This waits for the running work items to finish.  Queued
+      /// items are kept and processed by the new threads.
+      ///
+      /// @param numThreads Number of threads to create or zero for default.
+      /// @param affinityMask Logical processors the threads may run on, one
+      ///   bit per processor, or zero for any.
+      /// @param priority Scheduling priority of the threads.
+      void configure( U32 numThreads, U64 affinityMask = 0, ThreadPriority priority = ThreadPriorityNormal );
+
       ///
       void queueWorkItem( WorkItem* item );
       
@@ -396,6 +420,12 @@ class ThreadPool
          return smForceAllMainThread;
       }
 
+      /// Return the number of worker threads in the pool.
+      U32 getNumThreads() const
+      {
+         return mNumThreads;
+      }
+
       /// Return the global thread pool singleton.
       static ThreadPool& GLOBAL();
 };
@@ -0,0 +1,300 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _THREADSAFERINGBUFFER_H_
+#define _THREADSAFERINGBUFFER_H_
+
+#ifndef _PLATFORM_H_
+#  include "platform/platform.h"
+#endif
+#ifndef _PLATFORMINTRINSICS_H_
+#  include "platform/platformIntrinsics.h"
+#endif
+
+
+/// @file
+/// Bounded lock-free FIFO queues.
+///
+/// Unlike ThreadSafeDeque, these never allocate once constructed and do not
+/// need any refcounting or freelist management, so each push and pop comes
+/// down to a single successful CAS (or none at all for the single-producer,
+/// single-consumer variant).  The price is a fixed capacity.
+///
+/// Head and tail live on separate cache lines so that producers and consumers
+/// don't invalidate each other's caches on every operation.
+
+
+enum
+{
+   /// Size to pad contended fields of the ring buffers to.
+   THREADSAFERINGBUFFER_CACHELINE_SIZE = 64
+};
+
+
+/// Bounded lock-free multi-producer, multi-consumer FIFO queue.
+///
+/// Every slot carries a sequence number that tells whether the slot is
+/// ready to be written or read in the current lap around the ring.  Threads
+/// claim slots by advancing the head or tail with a CAS and then publish
+/// them by bumping the slot's sequence number.
+///
+/// @param T Type of elements; must have a default constructor and be copyable.
+///   Popped slots are reset to T() so references held by elements are
+///   released right away.
+template< typename T >
+class ThreadSafeRingBuffer
+{
+   public:
+
+      typedef T ValueType;
+
+   protected:
+
+      struct Slot
+      {
+         volatile U32 mSequence;
+         ValueType mValue;
+      };
+
+      Slot* mSlots;
+      U32 mMask;
+
+      U8 mPad0[ THREADSAFERINGBUFFER_CACHELINE_SIZE - sizeof( Slot* ) - sizeof( U32 ) ];
+
+      /// Next slot to write to.
+      volatile U32 mTail;
+
+      U8 mPad1[ THREADSAFERINGBUFFER_CACHELINE_SIZE - sizeof( U32 ) ];
+
+      /// Next slot to read from.
+      volatile U32 mHead;
+
+      U8 mPad2[ THREADSAFERINGBUFFER_CACHELINE_SIZE - sizeof( U32 ) ];
+
+   public:
+
+      /// Construct a ring buffer that can hold at least @a capacity elements.
+      /// The capacity is rounded up to the next power of two.
+      ThreadSafeRingBuffer( U32 capacity )
+         : mTail( 0 ),
+           mHead( 0 )
+      {
+         capacity = getNextPow2( getMax( capacity, U32( 2 ) ) );
+
+         mSlots = new Slot[ capacity ];
+         mMask = capacity - 1;
+
+         for( U32 i = 0; i < capacity; ++ i )
+            mSlots[ i ].mSequence = i;
+      }
+
+      ~ThreadSafeRingBuffer()
+      {
+         delete [] mSlots;
+      }
+
+      /// Return the number of elements the buffer can hold.
+      U32 getCapacity() const { return mMask + 1; }
+
+      /// Return true if the buffer is empty.
+      /// @note Only a snapshot when other threads are accessing the buffer.
+      bool isEmpty() const
+      {
+         return ( mHead == mTail );
+      }
+
+      /// Append @a value to the end of the queue.
+      /// @return False if the buffer is full.
+      bool tryPushBack( const ValueType& value );
+
+      /// Append @a value to the end of the queue, yielding the thread for as
+      /// long as the buffer is full.
+      void pushBack( const ValueType& value )
+      {
+         while( !tryPushBack( value ) )
+            Platform::sleep( 0 );
+      }
+
+      /// Take the element at the front of the queue.
+      /// @return False if the buffer is empty.
+      bool tryPopFront( ValueType& outValue );
+};
+
+template< typename T >
+bool ThreadSafeRingBuffer< T >::tryPushBack( const ValueType& value )
+{
+   Slot* slot;
+   U32 pos;
+
+   while( 1 )
+   {
+      pos = dAtomicRead( mTail );
+      slot = &mSlots[ pos & mMask ];
+
+      const S32 diff = S32( dAtomicRead( slot->mSequence ) - pos );
+      if( diff == 0 )
+      {
+         if( dCompareAndSwap( mTail, pos, pos + 1 ) )
+            break;
+      }
+      else if( diff < 0 )
+         return false; // Slot still holds a value from the last lap; full.
+   }
+
+   slot->mValue = value;
+
+   // Publish.  Only we can touch the sequence while we hold the slot.
+   dFetchAndAdd( slot->mSequence, 1 );
+   return true;
+}
+
+template< typename T >
+bool ThreadSafeRingBuffer< T >::tryPopFront( ValueType& outValue )
+{
+   Slot* slot;
+   U32 pos;
+
+   while( 1 )
+   {
+      pos = dAtomicRead( mHead );
+      slot = &mSlots[ pos & mMask ];
+
+      const S32 diff = S32( dAtomicRead( slot->mSequence ) - ( pos + 1 ) );
+      if( diff == 0 )
+      {
+         if( dCompareAndSwap( mHead, pos, pos + 1 ) )
+            break;
+      }
+      else if( diff < 0 )
+         return false; // Slot not written yet; empty.
+   }
+
+   outValue = slot->mValue;
+   slot->mValue = ValueType();
+
+   // Hand the slot over to the writer of the next lap.
+   dFetchAndAdd( slot->mSequence, mMask );
+   return true;
+}
+
+
+/// Bounded lock-free single-producer, single-consumer FIFO queue.
+///
+/// Only one thread at a time may push and only one thread at a time may pop.
+/// In exchange, neither side ever has to retry.
+///
+/// @param T Type of elements; must have a default constructor and be copyable.
+template< typename T >
+class ThreadSafeSPSCRingBuffer
+{
+   public:
+
+      typedef T ValueType;
+
+   protected:
+
+      ValueType* mValues;
+      U32 mMask;
+
+      U8 mPad0[ THREADSAFERINGBUFFER_CACHELINE_SIZE - sizeof( ValueType* ) - sizeof( U32 ) ];
+
+      /// Next slot to write to.  Only modified by the producer.
+      volatile U32 mTail;
+
+      U8 mPad1[ THREADSAFERINGBUFFER_CACHELINE_SIZE - sizeof( U32 ) ];
+
+      /// Next slot to read from.  Only modified by the consumer.
+      volatile U32 mHead;
+
+      U8 mPad2[ THREADSAFERINGBUFFER_CACHELINE_SIZE - sizeof( U32 ) ];
+
+   public:
+
+      /// Construct a ring buffer that can hold at least @a capacity elements.
+      /// The capacity is rounded up to the next power of two.
+      ThreadSafeSPSCRingBuffer( U32 capacity )
+         : mTail( 0 ),
+           mHead( 0 )
+      {
+         capacity = getNextPow2( getMax( capacity, U32( 2 ) ) );
+
+         mValues = new ValueType[ capacity ];
+         mMask = capacity - 1;
+      }
+
+      ~ThreadSafeSPSCRingBuffer()
+      {
+         delete [] mValues;
+      }
+
+      /// Return the number of elements the buffer can hold.
+      U32 getCapacity() const { return mMask + 1; }
+
+      /// Return true if the buffer is empty.
+      /// @note Only a snapshot when other threads are accessing the buffer.
+      bool isEmpty() const
+      {
+         return ( mHead == mTail );
+      }
+
+      /// Append @a value to the end of the queue.  Producer only.
+      /// @return False if the buffer is full.
+      bool tryPushBack( const ValueType& value )
+      {
+         const U32 tail = mTail;
+         if( tail - dAtomicRead( mHead ) > mMask )
+            return false;
+
+         mValues[ tail & mMask ] = value;
+
+         // Full barrier; publishes the value before the new tail.
+         dFetchAndAdd( mTail, 1 );
+         return true;
+      }
+
+      /// Append @a value to the end of the queue, yielding the thread for as
+      /// long as the buffer is full.  Producer only.
+      void pushBack( const ValueType& value )
+      {
+         while( !tryPushBack( value ) )
+            Platform::sleep( 0 );
+      }
+
+      /// Take the element at the front of the queue.  Consumer only.
+      /// @return False if the buffer is empty.
+      bool tryPopFront( ValueType& outValue )
+      {
+         const U32 head = mHead;
+         if( head == dAtomicRead( mTail ) )
+            return false;
+
+         ValueType& value = mValues[ head & mMask ];
+         outValue = value;
+         value = ValueType();
+
+         // Full barrier; we are done with the slot before the producer sees it free.
+         dFetchAndAdd( mHead, 1 );
+         return true;
+      }
+};
+
+#endif // _THREADSAFERINGBUFFER_H_
@@ -20,14 +20,22 @@
 // IN THE SOFTWARE.
 //-----------------------------------------------------------------------------
 #include <unistd.h>
+#include <sys/mman.h>
 #include <stdlib.h>
 #include <errno.h>
 
+#ifdef TORQUE_OS_LINUX
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
 #include "core/crc.h"
 #include "core/frameAllocator.h"
 
 #include "core/util/str.h"
 #include "core/strings/stringFunctions.h"
+#include "console/console.h"
+#include "platform/threads/thread.h"
 
 #include "platform/platformVolume.h"
 #include "platformPOSIX/posixVolume.h"
@@ -138,11 +146,281 @@ static void copyStatAttributes(const struct stat& info, FileNode::Attributes* at
 }
 
 
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_OS_LINUX
+
+/// Watches directories with inotify.
+///
+/// A thread blocks on the inotify descriptor and records which directories
+/// saw changes.  Bursts of events on a directory (like an editor writing a
+/// file in several steps) are coalesced, and the directory is handed to
+/// internalNotifyDirChanged() on the main thread once it has been quiet for
+/// CoalesceTime.  Nothing is scanned unless the kernel reported a change.
+class PosixFileSystemChangeNotifier : public FileSystemChangeNotifier
+{
+public:
+   PosixFileSystemChangeNotifier( FileSystem *fs );
+   virtual ~PosixFileSystemChangeNotifier();
+
+private:
+   enum
+   {
+      /// Milliseconds a directory must be quiet before it is processed.
+      CoalesceTime = 100,
+
+      /// Milliseconds the watch thread waits before checking for stop.
+      PollTimeout = 250,
+   };
+
+   class WatchThread : public Thread
+   {
+   public:
+      WatchThread( PosixFileSystemChangeNotifier *notifier ) : mNotifier( notifier ) {}
+      virtual void run( void *arg );
+
+   private:
+      PosixFileSystemChangeNotifier *mNotifier;
+   };
+
+   struct Watch
+   {
+      int wd;
+      Path dir;
+   };
+
+   struct Change
+   {
+      Path dir;
+
+      /// Time of the last event on the directory.
+      U32 time;
+   };
+
+   virtual void   internalProcessOnce();
+
+   virtual bool   internalAddNotification( const Path &dir );
+   virtual bool   internalRemoveNotification( const Path &dir );
+
+   /// Reads all pending events from the inotify descriptor.
+   void _readEvents();
+
+   /// Records a change on @a dir.  Expects #mMutex to be locked.
+   void _addChange( const Path &dir, U32 time );
+
+   int mINotify;
+   WatchThread *mThread;
+
+   /// Guards #mWatches and #mChanges.
+   Mutex mMutex;
+
+   Vector<Watch> mWatches;
+   Vector<Change> mChanges;
+};
+
+PosixFileSystemChangeNotifier::PosixFileSystemChangeNotifier( FileSystem *fs )
+   :  FileSystemChangeNotifier( fs ),
+      mThread( NULL )
+{
+   VECTOR_SET_ASSOCIATION( mWatches );
+   VECTOR_SET_ASSOCIATION( mChanges );
+
+   mINotify = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+   if ( mINotify == -1 )
+      Con::errorf( "[PosixFileSystemChangeNotifier] : inotify_init1 failed [%d]", errno );
+}
+
+PosixFileSystemChangeNotifier::~PosixFileSystemChangeNotifier()
+{
+   if ( mThread )
+   {
+      mThread->stop();
+      mThread->join();
+      delete mThread;
+   }
+
+   if ( mINotify != -1 )
+      ::close( mINotify );
+}
+
+void PosixFileSystemChangeNotifier::WatchThread::run( void * )
+{
+   _setName( "FileSystemChangeNotifier" );
+
+   pollfd fd;
+   fd.fd = mNotifier->mINotify;
+   fd.events = POLLIN;
+
+   while ( !checkForStop() )
+   {
+      fd.revents = 0;
+      if ( poll( &fd, 1, PollTimeout ) > 0 && ( fd.revents & POLLIN ) )
+         mNotifier->_readEvents();
+   }
+}
+
+void PosixFileSystemChangeNotifier::_readEvents()
+{
+   char buffer[ 4096 ] __attribute__(( aligned( __alignof__( inotify_event ) ) ));
+
+   for ( ;; )
+   {
+      const ssize_t length = ::read( mINotify, buffer, sizeof( buffer ) );
+      if ( length <= 0 )
+         break;
+
+      const U32 time = Platform::getRealMilliseconds();
+
+      MutexHandle lock;
+      lock.lock( &mMutex, true );
+
+      for ( ssize_t offset = 0; offset < length; )
+      {
+         const inotify_event *event = reinterpret_cast< const inotify_event* >( buffer + offset );
+         offset += sizeof( inotify_event ) + event->len;
+
+         // If the queue overflowed events got lost, so check everything.
+         if ( event->mask & IN_Q_OVERFLOW )
+         {
+            for ( U32 i = 0; i < mWatches.size(); ++i )
+               _addChange( mWatches[i].dir, time );
+            continue;
+         }
+
+         for ( U32 i = 0; i < mWatches.size(); ++i )
+         {
+            if ( mWatches[i].wd == event->wd )
+            {
+               _addChange( mWatches[i].dir, time );
+               break;
+            }
+         }
+      }
+   }
+}
+
+void PosixFileSystemChangeNotifier::_addChange( const Path &dir, U32 time )
+{
+   for ( U32 i = 0; i < mChanges.size(); ++i )
+   {
+      if ( mChanges[i].dir == dir )
+      {
+         mChanges[i].time = time;
+         return;
+      }
+   }
+
+   Change change;
+   change.dir = dir;
+   change.time = time;
+   mChanges.push_back( change );
+}
+
+bool PosixFileSystemChangeNotifier::internalAddNotification( const Path &dir )
+{
+   if ( mINotify == -1 )
+      return false;
+
+   MutexHandle lock;
+   lock.lock( &mMutex, true );
+
+   for ( U32 i = 0; i < mWatches.size(); ++i )
+   {
+      if ( mWatches[i].dir == dir )
+         return false;
+   }
+
+   const String osPath = mFS->mapTo( dir ).getFullPath();
+
+   const int wd = inotify_add_watch( mINotify, osPath.c_str(),
+      IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO );
+
+   if ( wd == -1 )
+   {
+      Con::errorf( "[PosixFileSystemChangeNotifier::internalAddNotification] : failed on [%s] [%d]", osPath.c_str(), errno );
+      return false;
+   }
+
+   Watch watch;
+   watch.wd = wd;
+   watch.dir = dir;
+   mWatches.push_back( watch );
+
+   if ( !mThread )
+   {
+      mThread = new WatchThread( this );
+      mThread->start();
+   }
+
+   return true;
+}
+
+bool PosixFileSystemChangeNotifier::internalRemoveNotification( const Path &dir )
+{
+   MutexHandle lock;
+   lock.lock( &mMutex, true );
+
+   for ( U32 i = 0; i < mChanges.size(); ++i )
+   {
+      if ( mChanges[i].dir == dir )
+      {
+         mChanges.erase( i );
+         break;
+      }
+   }
+
+   for ( U32 i = 0; i < mWatches.size(); ++i )
+   {
+      if ( mWatches[i].dir != dir )
+         continue;
+
+      inotify_rm_watch( mINotify, mWatches[i].wd );
+      mWatches.erase( i );
+
+      return true;
+   }
+
+   return false;
+}
+
+void PosixFileSystemChangeNotifier::internalProcessOnce()
+{
+   Vector<Path> changedDirs;
+
+   {
+      MutexHandle lock;
+      lock.lock( &mMutex, true );
+
+      const U32 time = Platform::getRealMilliseconds();
+      for ( U32 i = 0; i < mChanges.size(); )
+      {
+         if ( time - mChanges[i].time >= CoalesceTime )
+         {
+            changedDirs.push_back( mChanges[i].dir );
+            mChanges.erase_fast( i );
+         }
+         else
+            ++i;
+      }
+   }
+
+   // Notify without the lock since the callbacks may
+   // add or remove notifications.
+   for ( U32 i = 0; i < changedDirs.size(); ++i )
+      internalNotifyDirChanged( changedDirs[i] );
+}
+
+#endif // TORQUE_OS_LINUX
+
+
 //-----------------------------------------------------------------------------
 
 PosixFileSystem::PosixFileSystem(String volume)
 {
    _volume = volume;
+#ifdef TORQUE_OS_LINUX
+   mChangeNotifier = new PosixFileSystemChangeNotifier( this );
+#endif
 }
 
 PosixFileSystem::~PosixFileSystem()
@@ -238,6 +516,8 @@ PosixFile::PosixFile(const Path& path,String name)
    _name = name;
    _status = Closed;
    _handle = 0;
+   _mapping = 0;
+   _mappingSize = 0;
 }
 
 PosixFile::~PosixFile()
@@ -343,6 +623,8 @@ bool PosixFile::open(AccessMode mode)
 
 bool PosixFile::close()
 {
+   unmap();
+
    if (_handle)
    {
       #ifdef DEBUG_SPEW
@@ -422,6 +704,40 @@ U32 PosixFile::write(const void* src, U32 size)
    return bytesWritten;
 }
 
+U8* PosixFile::map(U32 &outSize)
+{
+   outSize = _mappingSize;
+   if (_mapping)
+      return _mapping;
+
+   if (_status != Open && _status != EndOfFile)
+      return 0;
+
+   struct stat info;
+   if (fstat(fileno(_handle), &info) < 0 || info.st_size <= 0 || info.st_size > U32_MAX)
+      return 0;
+
+   void* mapping = mmap(0, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(_handle), 0);
+   if (mapping == MAP_FAILED)
+      return 0;
+
+   _mapping = (U8*)mapping;
+   _mappingSize = info.st_size;
+
+   outSize = _mappingSize;
+   return _mapping;
+}
+
+void PosixFile::unmap()
+{
+   if (_mapping)
+   {
+      munmap(_mapping, _mappingSize);
+      _mapping = 0;
+      _mappingSize = 0;
+   }
+}
+
 void PosixFile::_updateStatus()
 {
    switch (errno)
@@ -69,6 +69,8 @@ class PosixFile: public File
    String _name;
    FILE* _handle;
    NodeStatus _status;
+   U8* _mapping;
+   U32 _mappingSize;
 
    PosixFile(const Path& path,String name);
    bool _updateInfo();
@@ -90,6 +92,9 @@ public:
    U32 read(void* dst, U32 size);
    U32 write(const void* src, U32 size);
 
+   U8* map(U32 &outSize);
+   void unmap();
+
 private:
    U32 calculateChecksum();
 };
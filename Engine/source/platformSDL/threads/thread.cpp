@@ -26,6 +26,9 @@
 #include <stdlib.h>
 #include <SDL.h>
 #include <SDL_thread.h>
+#ifdef TORQUE_OS_LINUX
+#include <pthread.h>
+#endif
 
 class PlatformThreadData
 {
@@ -55,6 +58,7 @@ static int ThreadRunHandler(void * arg)
    mData->mThreadID = SDL_ThreadID();
    
    ThreadManager::addThread(thread);
+   ThreadManager::applyThreadSettings(thread);
    thread->run(mData->mRunArg);
    ThreadManager::removeThread(thread);
 
@@ -82,6 +86,8 @@ Thread::Thread(ThreadRunFunction func, void* arg, bool start_thread, bool autode
    mData->mThreadID = 0;
    mData->mDead = false;
    mData->mSdlThread = NULL;
+   mAffinityMask = 0;
+   mPriority = ThreadPriorityNormal;
    autoDelete = autodelete;
 }
 
@@ -153,3 +159,31 @@ bool ThreadManager::compare(U32 threadId_1, U32 threadId_2)
 {
    return (threadId_1 == threadId_2);
 }
+
+bool ThreadManager::setCurrentThreadAffinity(U64 mask)
+{
+   // SDL has no affinity API but its threads are pthreads on Linux.
+#ifdef TORQUE_OS_LINUX
+   cpu_set_t cpuSet;
+   CPU_ZERO(&cpuSet);
+   for(U32 i = 0; i < CPU_SETSIZE; i++)
+   {
+      if(!mask || (i < 64 && (mask & (U64(1) << i))))
+         CPU_SET(i, &cpuSet);
+   }
+   return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+   return false;
+#endif
+}
+
+bool ThreadManager::setCurrentThreadPriority(ThreadPriority priority)
+{
+   static const SDL_ThreadPriority sdlPriorities[] =
+   {
+      SDL_THREAD_PRIORITY_LOW,
+      SDL_THREAD_PRIORITY_NORMAL,
+      SDL_THREAD_PRIORITY_HIGH
+   };
+   return SDL_SetThreadPriority(sdlPriorities[priority]) == 0;
+}
@@ -75,6 +75,7 @@ static U32 __stdcall ThreadRunHandler(void * arg)
    mData->mThreadID = GetCurrentThreadId();
 
    ThreadManager::addThread(mData->mThread);
+   ThreadManager::applyThreadSettings(mData->mThread);
    mData->mThread->run(mData->mRunArg);
    ThreadManager::removeThread(mData->mThread);
 
@@ -104,6 +105,9 @@ Thread::Thread(ThreadRunFunction func /* = 0 */, void *arg /* = 0 */, bool start
    mData->mRunFunc = func;
    mData->mRunArg = arg;
    mData->mThread = this;
+
+   mAffinityMask = 0;
+   mPriority = ThreadPriorityNormal;
 }
 
 Thread::~Thread()
@@ -207,3 +211,28 @@ bool ThreadManager::compare(U32 threadId_1, U32 threadId_2)
 {
    return (threadId_1 == threadId_2);
 }
+
+bool ThreadManager::setCurrentThreadAffinity(U64 mask)
+{
+   DWORD_PTR threadMask = (DWORD_PTR)mask;
+   if( !threadMask )
+   {
+      // Allow everything the process may use.
+      DWORD_PTR systemMask;
+      if( !GetProcessAffinityMask( GetCurrentProcess(), &threadMask, &systemMask ) )
+         return false;
+   }
+
+   return SetThreadAffinityMask( GetCurrentThread(), threadMask ) != 0;
+}
+
+bool ThreadManager::setCurrentThreadPriority(ThreadPriority priority)
+{
+   static const S32 winPriorities[] =
+   {
+      THREAD_PRIORITY_BELOW_NORMAL,
+      THREAD_PRIORITY_NORMAL,
+      THREAD_PRIORITY_ABOVE_NORMAL
+   };
+   return SetThreadPriority( GetCurrentThread(), winPriorities[priority] ) != FALSE;
+}
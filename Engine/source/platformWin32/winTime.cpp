@@ -24,12 +24,24 @@
 #include "platformWin32/platformWin32.h"
 
 #include "time.h"
+#include <mmsystem.h>
+
+#pragma comment(lib, "winmm.lib")
 
 void Platform::sleep(U32 ms)
 {
    Sleep(ms);
 }
 
+void Platform::sleepMicroseconds(U32 us)
+{
+   // Sleep() is rounded up to the scheduler quantum, which is ~15.6ms unless
+   // the timer resolution is raised for the duration of the wait.
+   timeBeginPeriod(1);
+   Sleep(us / 1000);
+   timeEndPeriod(1);
+}
+
 //--------------------------------------
 void Platform::getLocalTime(LocalTime &lt)
 {
@@ -156,6 +168,21 @@ U32 Platform::getRealMilliseconds()
    return GetTickCount();
 }
 
+U64 Platform::getRealMicroseconds()
+{
+   static LARGE_INTEGER sFrequency = { 0 };
+   if(!sFrequency.QuadPart && !QueryPerformanceFrequency(&sFrequency))
+      return U64(GetTickCount()) * 1000;
+
+   LARGE_INTEGER count;
+   QueryPerformanceCounter(&count);
+
+   // Split the conversion so the multiply can't overflow on long uptimes.
+   const U64 ticks = count.QuadPart;
+   const U64 freq = sFrequency.QuadPart;
+   return (ticks / freq) * 1000000 + (ticks % freq) * 1000000 / freq;
+}
+
 U32 Platform::getVirtualMilliseconds()
 {
    return winState.currentTime;
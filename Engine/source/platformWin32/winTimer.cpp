@@ -77,6 +77,21 @@ public:
       }
    }
 
+   const S64 getElapsedUs()
+   {
+      if(mUsingPerfCounter)
+      {
+         S64 perfCount;
+         QueryPerformanceCounter( (LARGE_INTEGER *) &perfCount);
+         F64 elapsedF64 = (1000000.0 * F64(perfCount - mPerfCountCurrent) / F64(mFrequency));
+         return S64(elapsedF64 + mPerfCountRemainderCurrent * 1000.0);
+      }
+      else
+      {
+         return S64(GetTickCount() - mTickCountCurrent) * 1000;
+      }
+   }
+
    void reset()
    {
       // Do some simple copying to reset the timer to 0.
@@ -331,6 +331,9 @@ Win32File::Win32File(const Path& path,String name)
    mName = name;
    mStatus = Closed;
    mHandle = 0;
+   mMapping = 0;
+   mMappingView = 0;
+   mMappingSize = 0;
 }
 
 Win32File::~Win32File()
@@ -449,6 +452,8 @@ bool Win32File::open(AccessMode mode)
 
 bool Win32File::close()
 {
+   unmap();
+
    if (mHandle)
    {
       ::CloseHandle((HANDLE)mHandle);
@@ -517,6 +522,49 @@ U32 Win32File::write(const void* src, U32 size)
    return bytesWritten;
 }
 
+U8* Win32File::map(U32 &outSize)
+{
+   outSize = mMappingSize;
+   if (mMappingView)
+      return mMappingView;
+
+   if (mStatus != Open && mStatus != EndOfFile)
+      return 0;
+
+   DWORD high = 0;
+   const DWORD size = ::GetFileSize((HANDLE)mHandle, &high);
+   if (size == INVALID_FILE_SIZE || high || !size)
+      return 0;
+
+   mMapping = (void*)::CreateFileMappingW((HANDLE)mHandle, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+   if (!mMapping)
+      return 0;
+
+   mMappingView = (U8*)::MapViewOfFile((HANDLE)mMapping, FILE_MAP_COPY, 0, 0, 0);
+   if (!mMappingView)
+   {
+      ::CloseHandle((HANDLE)mMapping);
+      mMapping = 0;
+      return 0;
+   }
+
+   mMappingSize = size;
+   outSize = mMappingSize;
+   return mMappingView;
+}
+
+void Win32File::unmap()
+{
+   if (mMappingView)
+      ::UnmapViewOfFile(mMappingView);
+   if (mMapping)
+      ::CloseHandle((HANDLE)mMapping);
+
+   mMapping = 0;
+   mMappingView = 0;
+   mMappingSize = 0;
+}
+
 void Win32File::_updateStatus()
 {
    switch (::GetLastError())
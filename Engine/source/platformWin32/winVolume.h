@@ -79,6 +79,9 @@ public:
    U32 read(void* dst, U32 size);
    U32 write(const void* src, U32 size);
 
+   U8* map(U32 &outSize);
+   void unmap();
+
 private:
    friend class Win32FileSystem;
 
@@ -89,6 +92,10 @@ private:
    void     *mHandle;
    NodeStatus   mStatus;
 
+   void     *mMapping;
+   U8       *mMappingView;
+   U32      mMappingSize;
+
    Win32File(const Path &path, String name);
 
    bool _updateInfo();
@@ -25,6 +25,9 @@
 #include "platform/threads/semaphore.h"
 #include "platform/threads/mutex.h"
 #include <stdlib.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 
 class PlatformThreadData
 {
@@ -57,6 +60,7 @@ static void *ThreadRunHandler(void * arg)
    mData->mThreadID = pthread_self();
    
    ThreadManager::addThread(thread);
+   ThreadManager::applyThreadSettings(thread);
    thread->run(mData->mRunArg);
    ThreadManager::removeThread(thread);
 
@@ -85,6 +89,8 @@ Thread::Thread(ThreadRunFunction func, void* arg, bool start_thread, bool autode
    mData->mThread = this;
    mData->mThreadID = 0;
    mData->mDead = false;
+   mAffinityMask = 0;
+   mPriority = ThreadPriorityNormal;
    autoDelete = autodelete;
 }
 
@@ -157,3 +163,30 @@ bool ThreadManager::compare(U32 threadId_1, U32 threadId_2)
 {
    return pthread_equal((pthread_t)threadId_1, (pthread_t)threadId_2);
 }
+
+bool ThreadManager::setCurrentThreadAffinity(U64 mask)
+{
+#ifdef TORQUE_OS_LINUX
+   cpu_set_t cpuSet;
+   CPU_ZERO(&cpuSet);
+   for(U32 i = 0; i < CPU_SETSIZE; i++)
+   {
+      if(!mask || (i < 64 && (mask & (U64(1) << i))))
+         CPU_SET(i, &cpuSet);
+   }
+   return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+   return false;
+#endif
+}
+
+bool ThreadManager::setCurrentThreadPriority(ThreadPriority priority)
+{
+#ifdef TORQUE_OS_LINUX
+   // Linux applies the nice value to the calling thread only.
+   static const S32 niceValues[] = { 10, 0, -5 };
+   return setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), niceValues[priority]) == 0;
+#else
+   return false;
+#endif
+}
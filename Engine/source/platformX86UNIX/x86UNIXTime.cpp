@@ -85,6 +85,13 @@ U32 Platform::getRealMilliseconds()
    return x86UNIXGetTickCount();
 }
 
+U64 Platform::getRealMicroseconds()
+{
+   timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return U64(t.tv_sec) * 1000000 + U64(t.tv_nsec) / 1000;
+}
+
 U32 Platform::getVirtualMilliseconds()
 {
    return sgCurrentTime;
@@ -158,4 +165,15 @@ void Platform::sleep(U32 ms)
 	// note: this will overflow if you want to sleep for more than 49 days. just so ye know.
 	usleep( ms * 1000 );
 }
+
+void Platform::sleepMicroseconds(U32 us)
+{
+   timespec t;
+   t.tv_sec = us / 1000000;
+   t.tv_nsec = ( us % 1000000 ) * 1000;
+
+   // Keep sleeping for the remainder if a signal wakes us early.
+   while( nanosleep( &t, &t ) == -1 && errno == EINTR )
+      ;
+}
 	    
@@ -34,6 +34,7 @@
 #include "gfx/gfxStringEnumTranslate.h"
 #include "gfx/gfxTextureManager.h"
 #include "gfx/gfxDebugEvent.h"
+#include "gfx/gfxGPUTimings.h"
 #include "gfx/util/screenspace.h"
 #include "gfx/sim/gfxStateBlockData.h"
 #include "scene/sceneRenderState.h"
@@ -52,6 +53,11 @@ ConsoleDocClass( PostEffect,
 
    "@section PFXTextureIdentifiers\n\n"   
 
+   "A texture slot starting with # samples the named target of that name, $inTex samples the "
+   "output of the previous effect in the chain, $backBuffer samples a copy of the active "
+   "render target and $historyTex samples this effect's own output from the last frame when "
+   "temporalHistory is enabled.\n\n"
+
    "@ingroup Rendering\n"
 );
 
@@ -283,6 +289,7 @@ PostEffect::PostEffect()
       mTargetClearColor( LinearColorF::BLACK ),
       mOneFrameOnly( false ),
       mOnThisFrame( true ),
+      mTransientTarget( false ),
       mRTSizeSC( NULL ),
       mIsValid( false ),
       mShaderReloadKey( 0 ),
@@ -309,7 +316,12 @@ PostEffect::PostEffect()
       mCameraForwardSC( NULL ),
       mAccumTimeSC( NULL ),
       mDeltaTimeSC( NULL ),
-      mInvCameraMatSC( NULL )
+      mInvCameraMatSC( NULL ),
+      mResolutionScaleSC( NULL ),
+      mHistoryValidSC( NULL ),
+      mReducedResolution( false ),
+      mTemporalHistory( false ),
+      mHistoryActive( false )
 {
    dMemset( mTexSRGB, 0, sizeof(bool) * NumTextures);
    dMemset( mActiveTextures, 0, sizeof( GFXTextureObject* ) * NumTextures );
@@ -346,7 +358,15 @@ void PostEffect::initPersistFields()
        "If targetSize is zero this is used to set a relative size from the current target." );
        
    addField( "targetSize", TypePoint2I, Offset( mTargetSize, PostEffect ), 
-      "If non-zero this is used as the absolute target size." );   
+      "If non-zero this is used as the absolute target size." );
+
+   addField( "reducedResolution", TypeBool, Offset( mReducedResolution, PostEffect ),
+      "If true the relative target size is further scaled down by $pref::PostFX::resolutionReduction "
+      "so that expensive effects can render at half or quarter size and be upsampled by a later effect." );
+
+   addField( "temporalHistory", TypeBool, Offset( mTemporalHistory, PostEffect ),
+      "If true the target from the previous frame is kept and can be sampled with $historyTex for "
+      "temporal reprojection.  The $historyValid constant is zero when the history cannot be used." );   
       
    addField( "targetFormat", TypeGFXFormat, Offset( mTargetFormat, PostEffect ),
       "Format of the target texture, not applicable if writing to the backbuffer." );
@@ -389,6 +409,11 @@ void PostEffect::initPersistFields()
    addField( "oneFrameOnly", TypeBool, Offset( mOneFrameOnly, PostEffect ), 
       "Allows you to turn on a PostEffect for only a single frame." );
 
+   addField( "transientTarget", TypeBool, Offset( mTransientTarget, PostEffect ), 
+      "Release the named target once every later effect in the chain which reads it "
+      "has been processed so that its memory can be reused by the following effects.  "
+      "Only enable this when nothing outside of the chain samples the target." );
+
    addField( "skip", TypeBool, Offset( mSkip, PostEffect ), 
       "Skip processing of this PostEffect and its children even if its parent "
       "is enabled. Parent and sibling PostEffects in the chain are still processed." );
@@ -615,6 +640,9 @@ void PostEffect::_setupConstants( const SceneRenderState *state )
       mDeltaTimeSC = mShader->getShaderConstHandle( "$deltaTime" );
 
       mInvCameraMatSC = mShader->getShaderConstHandle( "$invCameraMat" );
+
+      mResolutionScaleSC = mShader->getShaderConstHandle( "$resolutionScale" );
+      mHistoryValidSC = mShader->getShaderConstHandle( "$historyValid" );
    }
 
    // Set up shader constants for source image size
@@ -752,6 +780,23 @@ void PostEffect::_setupConstants( const SceneRenderState *state )
    mShaderConsts->setSafe( mAccumTimeSC, MATMGR->getTotalTime() );
    mShaderConsts->setSafe( mDeltaTimeSC, MATMGR->getDeltaTime() );
 
+   // Lets upsampling shaders know how much smaller
+   // than the full size target they are.
+   if ( mResolutionScaleSC->isValid() )
+   {
+      const Point2F targetScale = _getTargetScale();
+      mShaderConsts->set( mResolutionScaleSC, targetScale.x );
+   }
+
+   // History is only usable if it matches our current target, else
+   // the shader must fall back to the current frame alone.
+   if ( mHistoryValidSC->isValid() )
+   {
+      const bool historyValid = mHistoryActive && mHistoryTex && mTargetTex &&
+                                 mHistoryTex.getWidthHeight() == mTargetTex.getWidthHeight();
+      mShaderConsts->set( mHistoryValidSC, historyValid ? 1.0f : 0.0f );
+   }
+
    // Now set all the constants that are dependent on the scene state.
    if ( state )
    {
@@ -910,6 +955,19 @@ void PostEffect::_setupConstants( const SceneRenderState *state )
       iter->value->setToBuffer( mShaderConsts );
 }
 
+bool PostEffect::readsNamedTarget( const String &name ) const
+{
+   for ( U32 i=0; i < NumTextures; i++ )
+   {
+      const String &texFilename = mTexFilename[i];
+      if (  texFilename.isNotEmpty() && texFilename[0] == '#' &&
+            name.equal( texFilename.c_str() + 1, String::NoCase ) )
+         return true;
+   }
+
+   return false;
+}
+
 void PostEffect::_setupTexture( U32 stage, GFXTexHandle &inputTex, const RectI *inTexViewport )
 {
    const String &texFilename = mTexFilename[ stage ];
@@ -932,6 +990,14 @@ void PostEffect::_setupTexture( U32 stage, GFXTexHandle &inputTex, const RectI *
          viewport.set( 0, 0, theTex->getWidth(), theTex->getHeight() );
       }
    }
+   else if ( texFilename.compare( "$historyTex", 0, String::NoCase ) == 0 )
+   {
+      if ( mHistoryActive )
+         theTex = mHistoryTex;
+
+      if ( theTex )
+         viewport.set( 0, 0, theTex->getWidth(), theTex->getHeight() );
+   }
    else if ( texFilename.compare( "$backBuffer", 0, String::NoCase ) == 0 )
    {
       theTex = PFXMGR->getBackBufferTex();
@@ -987,17 +1053,19 @@ void PostEffect::_setupTarget( const SceneRenderState *state, bool *outClearTarg
       else if ( mActiveTextures[ 0 ] )
       {
          const Point3I &texSize = mActiveTextures[ 0 ]->getSize();
+         const Point2F targetScale = _getTargetScale();
 
-         targetSize.set(   texSize.x * mTargetScale.x,
-                           texSize.y * mTargetScale.y );
+         targetSize.set(   texSize.x * targetScale.x,
+                           texSize.y * targetScale.y );
       }
       else
       {
          GFXTarget *oldTarget = GFX->getActiveRenderTarget();
          const Point2I &oldTargetSize = oldTarget->getSize();
+         const Point2F targetScale = _getTargetScale();
 
-         targetSize.set(   oldTargetSize.x * mTargetScale.x,
-                           oldTargetSize.y * mTargetScale.y );
+         targetSize.set(   oldTargetSize.x * targetScale.x,
+                           oldTargetSize.y * targetScale.y );
       }
 
       // Make sure its at least 1x1.
@@ -1060,17 +1128,19 @@ void PostEffect::_setupTarget( const SceneRenderState *state, bool *outClearTarg
       else if ( mActiveTextures[ 0 ] )
       {
          const Point3I &texSize = mActiveTextures[ 0 ]->getSize();
+         const Point2F targetScale = _getTargetScale();
 
-         targetSize.set(   texSize.x * mTargetScale.x,
-                           texSize.y * mTargetScale.y );
+         targetSize.set(   texSize.x * targetScale.x,
+                           texSize.y * targetScale.y );
       }
       else
       {
          GFXTarget *oldTarget = GFX->getActiveRenderTarget();
          const Point2I &oldTargetSize = oldTarget->getSize();
+         const Point2F targetScale = _getTargetScale();
 
-         targetSize.set(   oldTargetSize.x * mTargetScale.x,
-                           oldTargetSize.y * mTargetScale.y );
+         targetSize.set(   oldTargetSize.x * targetScale.x,
+                           oldTargetSize.y * targetScale.y );
       }
 
       // Make sure its at least 1x1.
@@ -1124,9 +1194,18 @@ void PostEffect::_setupTarget( const SceneRenderState *state, bool *outClearTarg
       mTarget = GFX->allocRenderToTextureTarget();
 }
 
+Point2F PostEffect::_getTargetScale() const
+{
+   if ( !mReducedResolution )
+      return mTargetScale;
+
+   return mTargetScale * PostEffectManager::getReducedResolutionScale();
+}
+
 void PostEffect::_cleanTargets( bool recurse )
 {
    mTargetTex = NULL;
+   mHistoryTex = NULL;
    mTargetDepthStencil = NULL;
    mTarget = NULL;
 
@@ -1172,11 +1251,16 @@ void PostEffect::process(  const SceneRenderState *state,
       return;
 
    GFXDEBUGEVENT_SCOPE_EX( PostEffect_Process, ColorI::GREEN, avar("PostEffect: %s", getName()) );
+   GFXGPUTIMING_SCOPE( getName() ? getName() : getClassName() );
 
    preProcess_callback();   
 
    GFXTransformSaver saver;
 
+   // Reflection passes see a different view so they
+   // neither read nor replace the history.
+   mHistoryActive = mTemporalHistory && !( state && state->isReflectPass() );
+
    // Set the textures.
    for ( U32 i = 0; i < NumTextures; i++ )
       _setupTexture( i, inOutTex, inTexViewport );
@@ -1285,11 +1369,23 @@ void PostEffect::process(  const SceneRenderState *state,
       PFXMGR->releaseBackBufferTex();
    }
 
+   // Keep this frame's output for the next frame.  Holding the
+   // reference keeps the pool from handing it back to us as the
+   // next target, so the two textures ping pong between frames.
+   if ( mHistoryActive )
+      mHistoryTex = mTargetTex;
+   else if ( !mTemporalHistory )
+      mHistoryTex = NULL;
+
    // Return and release our target texture.
    inOutTex = mTargetTex;
    if ( !mNamedTarget.isRegistered() )
       mTargetTex = NULL;
 
+   // Let the manager release any transient targets
+   // which we were the last reader of.
+   PFXMGR->_onEffectProcessed( this );
+
    // Restore the transforms before the children
    // are processed as it screws up the viewport.
    saver.restore();
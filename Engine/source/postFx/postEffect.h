@@ -142,6 +142,8 @@ protected:
    GFXShaderConstHandle *mAccumTimeSC;
    GFXShaderConstHandle *mDeltaTimeSC;
    GFXShaderConstHandle *mInvCameraMatSC;
+   GFXShaderConstHandle *mResolutionScaleSC;
+   GFXShaderConstHandle *mHistoryValidSC;
 
    bool mAllowReflectPass;
 
@@ -166,6 +168,21 @@ protected:
    /// @see mTargetScale
    Point2I mTargetSize;
 
+   /// If true the relative target size is further reduced
+   /// by the global $pref::PostFX::resolutionReduction.
+   bool mReducedResolution;
+
+   /// If true the output of the previous frame is kept
+   /// and can be sampled with the $historyTex identifier.
+   bool mTemporalHistory;
+
+   /// The target texture from the last non-reflection
+   /// pass when mTemporalHistory is enabled.
+   GFXTexHandle mHistoryTex;
+
+   /// Is the history texture bound during the current process.
+   bool mHistoryActive;
+
    GFXFormat mTargetFormat;
 
    /// The color to prefill the named target when
@@ -195,6 +212,12 @@ protected:
    bool mOneFrameOnly;
    bool mOnThisFrame;  
 
+   /// If true the named target texture is handed back to the
+   /// target pool as soon as the last effect in the chain which
+   /// reads it has been processed, letting later effects alias
+   /// its memory.
+   bool mTransientTarget;
+
    U32 mShaderReloadKey;
 
    class EffectConst
@@ -270,6 +293,10 @@ protected:
    ///
    void _cleanTargets( bool recurse = false );
 
+   /// Returns the relative target scale including the
+   /// global resolution reduction if it applies.
+   Point2F _getTargetScale() const;
+
    /// 
    void _checkRequirements();
 
@@ -351,6 +378,20 @@ public:
    void setOneFrameOnly( bool enabled ) { mOneFrameOnly = enabled; }
    bool isOneFrameOnly() { return mOneFrameOnly; }   
 
+   /// Returns true if the named target of this effect is
+   /// released after its last reader in the chain.
+   bool isTransientTarget() const { return mTransientTarget && mNamedTarget.isRegistered(); }
+
+   /// Returns the name of the target this effect renders to.
+   const String& getNamedTargetName() const { return mNamedTarget.getName(); }
+
+   /// Returns true if one of the texture slots samples
+   /// the named target.
+   bool readsNamedTarget( const String &name ) const;
+
+   /// Returns the named target texture to the pool.
+   void releaseTransientTarget() { mTargetTex = NULL; }
+
    F32 getAspectRatio() const;
    
 
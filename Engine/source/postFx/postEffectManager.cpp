@@ -50,6 +50,7 @@ MODULE_END;
 
 
 bool PostEffectManager::smRenderEffects = true;
+S32 PostEffectManager::smResolutionReduction = 0;
 
 PostEffectManager::PostEffectManager() : 
       mLastBackBufferTarget( NULL ),
@@ -62,6 +63,11 @@ PostEffectManager::PostEffectManager() :
    Con::addVariable("pref::enablePostEffects", TypeBool, &smRenderEffects, 
       "@brief If true, post effects will be eanbled.\n\n"
 	   "@ingroup Game");
+
+   Con::addVariable("pref::PostFX::resolutionReduction", TypeS32, &smResolutionReduction, 
+      "@brief Reduces the target size of post effects which set reducedResolution.  "
+      "0 renders them at full size, 1 at half size and 2 at quarter size.\n\n"
+	   "@ingroup Rendering");
 }
 
 PostEffectManager::~PostEffectManager()
@@ -286,6 +292,11 @@ void PostEffectManager::renderEffects( const SceneRenderState *state,
    // of one effect into the next effect.
    GFXTexHandle chainTex;
 
+   // Chains can be rendered from within another
+   // chain, so only release the targets we added.
+   const U32 firstTransient = mTransientTargets.size();
+   _planTransientTargets( *effects );
+
    // Process the effects.
    for ( U32 i = 0; i < effects->size(); i++ )
    {
@@ -293,6 +304,75 @@ void PostEffectManager::renderEffects( const SceneRenderState *state,
       AssertFatal( effect != NULL, "Somehow this happened" );
       effect->process( state, chainTex );
    }
+
+   _releaseTransientTargets( firstTransient );
+}
+
+F32 PostEffectManager::getReducedResolutionScale()
+{
+   return 1.0f / F32( 1 << mClamp( smResolutionReduction, 0, 2 ) );
+}
+
+void PostEffectManager::_flattenEffect( PostEffect *effect, EffectVector *outEffects )
+{
+   outEffects->push_back( effect );
+
+   for ( U32 i = 0; i < effect->size(); i++ )
+      _flattenEffect( static_cast<PostEffect*>( (*effect)[i] ), outEffects );
+}
+
+void PostEffectManager::_planTransientTargets( const EffectVector &effects )
+{
+   EffectVector order;
+   for ( U32 i = 0; i < effects.size(); i++ )
+      _flattenEffect( effects[i], &order );
+
+   for ( U32 i = 0; i < order.size(); i++ )
+   {
+      PostEffect *owner = order[i];
+      if ( !owner->isTransientTarget() )
+         continue;
+
+      TransientTarget entry;
+      entry.owner = owner;
+      entry.lastReader = owner;
+
+      const String &name = owner->getNamedTargetName();
+      for ( U32 j = i + 1; j < order.size(); j++ )
+      {
+         if ( order[j]->readsNamedTarget( name ) )
+            entry.lastReader = order[j];
+      }
+
+      // If nothing in the chain reads it then it is only ever
+      // passed along as the chain texture, so leave it for the
+      // end of the chain.
+      if ( entry.lastReader == owner )
+         entry.lastReader = NULL;
+
+      mTransientTargets.push_back( entry );
+   }
+}
+
+void PostEffectManager::_onEffectProcessed( PostEffect *effect )
+{
+   for ( S32 i = mTransientTargets.size() - 1; i >= 0; i-- )
+   {
+      if ( mTransientTargets[i].lastReader != effect )
+         continue;
+
+      mTransientTargets[i].owner->releaseTransientTarget();
+      mTransientTargets.erase( i );
+   }
+}
+
+void PostEffectManager::_releaseTransientTargets( U32 start )
+{
+   for ( U32 i = start; i < mTransientTargets.size(); i++ )
+      mTransientTargets[i].owner->releaseTransientTarget();
+
+   if ( start < mTransientTargets.size() )
+      mTransientTargets.setSize( start );
 }
 
 void PostEffectManager::setFrameMatrices( const MatrixF &worldToCamera, const MatrixF &cameraToScreen )
@@ -59,6 +59,11 @@ protected:
    /// is tied to the $pref::enablePostEffects preference.
    static bool smRenderEffects;
 
+   /// The power of two by which effects marked with reducedResolution
+   /// shrink their targets: 0 is full, 1 is half and 2 is quarter.
+   /// It is tied to the $pref::PostFX::resolutionReduction preference.
+   static S32 smResolutionReduction;
+
    EffectVector mEndOfFrameList;
    EffectVector mAfterDiffuseList;
    EffectMap mAfterBinMap;
@@ -97,6 +102,34 @@ protected:
 
    bool _removeEffect( PostEffect *effect );
 
+   /// A transient named target and the last effect
+   /// in the chain which samples it.
+   struct TransientTarget
+   {
+      PostEffect *owner;
+      PostEffect *lastReader;
+   };
+
+   /// The transient targets still alive in the chain
+   /// being rendered.
+   Vector<TransientTarget> mTransientTargets;
+
+   /// Appends the effect and its children to the list
+   /// in the order they are processed.
+   static void _flattenEffect( PostEffect *effect, EffectVector *outEffects );
+
+   /// Finds the last reader of each transient target
+   /// in the chain about to be rendered.
+   void _planTransientTargets( const EffectVector &effects );
+
+   /// Called by PostEffect::process to release the
+   /// transient targets the effect was the last reader of.
+   void _onEffectProcessed( PostEffect *effect );
+
+   /// Releases the remaining transient targets from
+   /// the start index onward.
+   void _releaseTransientTargets( U32 start );
+
 public:
 
    PostEffectManager();
@@ -116,6 +149,10 @@ public:
    /// new copy is made on the next request.
    void releaseBackBufferTex();
 
+   /// Returns the target scale applied to effects
+   /// which allow a reduced resolution.
+   static F32 getReducedResolutionScale();
+
    /*
    bool submitEffect( PostEffect *effect, const PFXRenderTime renderTime = PFXDefaultRenderTime, const GFXRenderBinTypes afterBin = GFXBin_DefaultPostProcessBin )
    {
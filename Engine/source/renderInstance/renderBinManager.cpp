@@ -40,6 +40,7 @@ RenderBinManager::RenderBinManager( const RenderInstType& ritype, F32 renderOrde
    mBasicOnly ( false )
 {
    VECTOR_SET_ASSOCIATION( mElementList );
+   VECTOR_SET_ASSOCIATION( mSortScratch );
    mElementList.reserve( 2048 );
 }
 
@@ -138,7 +139,61 @@ void RenderBinManager::clear()
 
 void RenderBinManager::sort()
 {
-   dQsort( mElementList.address(), mElementList.size(), sizeof(MainSortElem), cmpKeyFunc);
+   sortElements( mElementList );
+}
+
+void RenderBinManager::sortElements( Vector< MainSortElem > &list )
+{
+   const U32 count = list.size();
+   if ( count < RadixSortMinElements )
+   {
+      dQsort( list.address(), count, sizeof(MainSortElem), cmpKeyFunc );
+      return;
+   }
+
+   // Count the occurrences of each byte of the keys for all passes at once.
+   U32 histograms[ 8 ][ 256 ];
+   dMemset( histograms, 0, sizeof( histograms ) );
+
+   for ( U32 i = 0; i < count; i++ )
+   {
+      const U64 sortKey = getSortKey( list[i] );
+      for ( U32 pass = 0; pass < 8; pass++ )
+         histograms[ pass ][ ( sortKey >> ( pass * 8 ) ) & 0xFF ]++;
+   }
+
+   mSortScratch.setSize( count );
+   MainSortElem *src = list.address();
+   MainSortElem *dst = mSortScratch.address();
+
+   for ( U32 pass = 0; pass < 8; pass++ )
+   {
+      const U32 shift = pass * 8;
+      U32 *histogram = histograms[ pass ];
+
+      // Nothing to do if all keys have the same byte here.
+      if ( histogram[ ( getSortKey( src[0] ) >> shift ) & 0xFF ] == count )
+         continue;
+
+      // Turn the counts into the first index of each byte value.
+      U32 offset = 0;
+      for ( U32 i = 0; i < 256; i++ )
+      {
+         const U32 num = histogram[i];
+         histogram[i] = offset;
+         offset += num;
+      }
+
+      for ( U32 i = 0; i < count; i++ )
+         dst[ histogram[ ( getSortKey( src[i] ) >> shift ) & 0xFF ]++ ] = src[i];
+
+      MainSortElem *temp = src;
+      src = dst;
+      dst = temp;
+   }
+
+   if ( src != list.address() )
+      dMemcpy( list.address(), src, count * sizeof( MainSortElem ) );
 }
 
 S32 FN_CDECL RenderBinManager::cmpKeyFunc(const void* p1, const void* p2)
@@ -146,9 +201,15 @@ S32 FN_CDECL RenderBinManager::cmpKeyFunc(const void* p1, const void* p2)
    const MainSortElem* mse1 = (const MainSortElem*) p1;
    const MainSortElem* mse2 = (const MainSortElem*) p2;
 
-   S32 test1 = S32(mse2->key) - S32(mse1->key);
+   // Compare instead of subtracting; the keys use the full 32 bits and the
+   // difference would overflow and make the order inconsistent.
+   if ( mse1->key != mse2->key )
+      return ( mse1->key < mse2->key ) ? 1 : -1;
+
+   if ( mse1->key2 != mse2->key2 )
+      return ( mse1->key2 < mse2->key2 ) ? -1 : 1;
 
-   return ( test1 == 0 ) ? S32(mse1->key2) - S32(mse2->key2) : test1;
+   return 0;
 }
 
 void RenderBinManager::setupSGData( MeshRenderInst *ri, SceneData &data )
@@ -95,6 +95,24 @@ protected:
       U32 key2;
    };
 
+   enum
+   {
+      /// Lists shorter than this are sorted with dQsort() instead of a radix sort.
+      RadixSortMinElements = 64,
+   };
+
+   /// Returns a key that sorts @a elem in the same order as cmpKeyFunc()
+   /// when sorted ascending.
+   static U64 getSortKey( const MainSortElem &elem )
+   {
+      return ( U64( ~elem.key ) << 32 ) | elem.key2;
+   }
+
+   /// Sorts @a list in the order of cmpKeyFunc() with an LSD radix sort
+   /// over getSortKey().  Bytes all elements share are skipped, so lists
+   /// that only differ in a few bits of their keys take only a few passes.
+   void sortElements( Vector< MainSortElem > &list );
+
    void setRenderPass( RenderPassManager *rpm );
 
    /// Called from derived bins to add additional
@@ -102,6 +120,7 @@ protected:
    void notifyType( const RenderInstType &type );
 
    Vector< MainSortElem > mElementList; // List of our instances
+   Vector< MainSortElem > mSortScratch; // Temporary storage for sortElements()
    F32 mProcessAddOrder;   // Where in the list do we process RenderInstance additions?
    F32 mRenderOrder;       // Where in the list do we render?
 
@@ -105,10 +105,14 @@ RenderDeferredMgr::RenderDeferredMgr( bool gatherDepth,
    mClearGBufferShader = NULL;
 
    _registerFeatures();
+
+   MaterialManager::getWarmUpSignal().notify( this, &RenderDeferredMgr::_onMaterialWarmUp );
 }
 
 RenderDeferredMgr::~RenderDeferredMgr()
 {
+   MaterialManager::getWarmUpSignal().remove( this, &RenderDeferredMgr::_onMaterialWarmUp );
+
    GFXShader::removeGlobalMacro( "TORQUE_LINEAR_DEPTH" );
 
    mColorTarget.release();
@@ -226,6 +230,23 @@ void RenderDeferredMgr::_createDeferredMaterial()
    delete deferredMat;
 }
 
+void RenderDeferredMgr::_onMaterialWarmUp( BaseMatInstance *mat )
+{
+   // Skip our own materials and the ones that
+   // addElement() would never send to this bin.
+   if ( dynamic_cast<DeferredMatInstance*>( mat ) )
+      return;
+
+   BaseMaterialDefinition *matDef = mat->getMaterial();
+   if ( !matDef || matDef->isTranslucent() )
+      return;
+
+   if ( mat->isCustomMaterial() && static_cast<CustomMaterial*>( matDef )->mRefract )
+      return;
+
+   getDeferredMaterial( mat );
+}
+
 void RenderDeferredMgr::setDeferredMaterial( DeferredMatInstance *mat )
 {
    SAFE_DELETE(mDeferredMatInstance);
@@ -286,6 +307,17 @@ void RenderDeferredMgr::addElement( RenderInst *inst )
    // Store the original key... we might need it.
    U32 originalKey = elem.key;
 
+   if (isMeshInst && matInst && matInst->isInstanced())
+   {
+      // Instanced meshes can only be batched if all instances of a draw are
+      // next to each other, so sort them by material and draw instead of by
+      // distance.  The distance keys below never have the top bit set which
+      // puts instanced meshes first.
+      elem.key = BIT(31) | matInst->getStateHint();
+      elem.key2 = inst->defaultKey2;
+      return;
+   }
+
    // Sort front-to-back first to get the most fillrate savings.
    const F32 invSortDistSq = F32_MAX - inst->sortDistSq;
    elem.key = *((U32*)&invSortDistSq);
@@ -301,8 +333,8 @@ void RenderDeferredMgr::sort()
 {
    PROFILE_SCOPE( RenderDeferredMgr_sort );
    Parent::sort();
-   dQsort( mTerrainElementList.address(), mTerrainElementList.size(), sizeof(MainSortElem), cmpKeyFunc);
-   dQsort( mObjectElementList.address(), mObjectElementList.size(), sizeof(MainSortElem), cmpKeyFunc);
+   sortElements( mTerrainElementList );
+   sortElements( mObjectElementList );
 }
 
 void RenderDeferredMgr::clear()
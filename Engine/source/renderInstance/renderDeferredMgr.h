@@ -98,6 +98,9 @@ protected:
 
    bool _lightManagerActivate(bool active);
 
+   /// @see MaterialManager::getWarmUpSignal
+   void _onMaterialWarmUp( BaseMatInstance *mat );
+
    // Deferred Shading
    GFXVertexBufferHandle<GFXVertexPC>  mClearGBufferVerts;
    GFXShaderRef                        mClearGBufferShader;
@@ -34,6 +34,10 @@ extern ColorI gCanvasClearColor;
 
 IMPLEMENT_CONOBJECT(RenderFormatToken);
 
+bool RenderFormatToken::smDynamicResolution = false;
+F32 RenderFormatToken::smDynamicResolutionTargetMs = 16.0f;
+F32 RenderFormatToken::smDynamicResolutionMinScale = 0.5f;
+
 ConsoleDocClass( RenderFormatToken,
    "@brief Used to change the render target format when rendering in AL.\n\n"
 
@@ -70,6 +74,11 @@ ConsoleDocClass( RenderFormatToken,
    "};\n"
    "@endtsexample\n\n"
 
+   "When $pref::Video::dynamicResolution is enabled the scene is rendered to a "
+   "viewport scaled down whenever the GPU time of a frame exceeds "
+   "$pref::Video::dynamicResolutionTargetMs.  The resolveEffect receives that "
+   "viewport with $inTex and is responsible for upscaling it.\n\n"
+
    "@see RenderPassToken\n\n"
    "@see RenderPassStateBin\n"
    "@see game/core/scripts/client/renderManager.cs\n"
@@ -87,7 +96,8 @@ RenderFormatToken::RenderFormatToken()
       mTargetSize(Point2I::Zero),
       mTargetAALevel(GFXTextureManager::AA_MATCH_BACKBUFFER),
       mCopyPostEffect(NULL),
-      mResolvePostEffect(NULL)
+      mResolvePostEffect(NULL),
+      mResolutionScale(1.0f)
 {
    GFXDevice::getDeviceEventSignal().notify(this, &RenderFormatToken::_handleGFXEvent);
    GFXTextureManager::addEventDelegate(this, &RenderFormatToken::_onTextureEvent);
@@ -110,7 +120,16 @@ void RenderFormatToken::process(SceneRenderState *state, RenderPassStateBin *cal
          GFXDEBUGEVENT_SCOPE_EX(RFT_Waiting, ColorI::BLUE, avar("[%s Activate] (%s)", getName(), GFXStringTextureFormat[mColorFormat]));
          mFCState = FTSActive;
 
-         mTarget.setViewport( GFX->getViewport() );
+         // Render to the scaled down corner of the
+         // viewport when using dynamic resolution.
+         RectI viewport = GFX->getViewport();
+         if ( mResolutionScale < 1.0f )
+         {
+            viewport.extent.set( getMax( (S32)mFloor( viewport.extent.x * mResolutionScale ), 1 ),
+                                 getMax( (S32)mFloor( viewport.extent.y * mResolutionScale ), 1 ) );
+         }
+
+         mTarget.setViewport( viewport );
 
          // Update targets
          _updateTargets();
@@ -344,11 +363,55 @@ void RenderFormatToken::initPersistFields()
    Parent::initPersistFields();
 }
 
+void RenderFormatToken::consoleInit()
+{
+   Con::addVariable( "$pref::Video::dynamicResolution", TypeBool, &smDynamicResolution,
+      "If true RenderFormatTokens scale down the viewport the scene is rendered to "
+      "while the GPU time of a frame is over $pref::Video::dynamicResolutionTargetMs.\n"
+      "@ingroup GFX" );
+
+   Con::addVariable( "$pref::Video::dynamicResolutionTargetMs", TypeF32, &smDynamicResolutionTargetMs,
+      "The GPU time budget of a frame in milliseconds for dynamic resolution.\n"
+      "@ingroup GFX" );
+
+   Con::addVariable( "$pref::Video::dynamicResolutionMinScale", TypeF32, &smDynamicResolutionMinScale,
+      "The smallest viewport scale dynamic resolution will go down to.\n"
+      "@ingroup GFX" );
+}
+
+void RenderFormatToken::_updateResolutionScale()
+{
+   GFX->setTrackSceneGPUTime( smDynamicResolution );
+
+   if ( !smDynamicResolution || !isEnabled() )
+   {
+      mResolutionScale = 1.0f;
+      return;
+   }
+
+   const F32 gpuMs = GFX->getSceneGPUMs();
+   if ( gpuMs <= 0.0f )
+      return;
+
+   // The timing lags a few frames behind, so take small steps.  We
+   // shrink faster than we grow and leave some headroom before growing
+   // so that the scale doesn't flip back and forth.
+   if ( gpuMs > smDynamicResolutionTargetMs )
+      mResolutionScale -= 0.02f;
+   else if ( gpuMs < smDynamicResolutionTargetMs * 0.85f )
+      mResolutionScale += 0.01f;
+
+   const F32 minScale = mClampF( smDynamicResolutionMinScale, 0.25f, 1.0f );
+   mResolutionScale = mClampF( mResolutionScale, minScale, 1.0f );
+}
+
 
 bool RenderFormatToken::_handleGFXEvent(GFXDevice::GFXDeviceEventType event_)
 {
    if ( event_ == GFXDevice::deStartOfFrame )
    {
+      _updateResolutionScale();
+
       mTargetChainIdx++;
       if ( mTargetChainIdx >= TargetChainLength )
          mTargetChainIdx = 0;
@@ -67,6 +67,26 @@ protected:
    GFXTextureTargetRef mTargetChain[TargetChainLength];
 
    GFXTexHandle mStoredPassZTarget;
+
+   /// @name Dynamic Resolution
+   /// @{
+
+   /// If true the viewport the scene renders to is scaled
+   /// to keep the GPU time of a frame within budget.
+   static bool smDynamicResolution;
+
+   /// The GPU time budget for a frame in milliseconds.
+   static F32 smDynamicResolutionTargetMs;
+
+   /// The smallest viewport scale allowed.
+   static F32 smDynamicResolutionMinScale;
+
+   /// The current viewport scale.
+   F32 mResolutionScale;
+
+   void _updateResolutionScale();
+
+   /// @}
    
    void _updateTargets();
    void _teardownTargets();
@@ -84,6 +104,7 @@ public:
 
    DECLARE_CONOBJECT(RenderFormatToken);
    static void initPersistFields();
+   static void consoleInit();
    virtual bool onAdd();
    virtual void onRemove();
 
@@ -94,6 +115,10 @@ public:
    virtual void reset();
    virtual void enable(bool enabled = true);
    virtual bool isEnabled() const;
+
+   /// Returns the scale of the viewport the scene
+   /// is currently rendered to.
+   F32 getResolutionScale() const { return mResolutionScale; }
 };
 
 #endif // _RENDERFORMATCHANGER_H_
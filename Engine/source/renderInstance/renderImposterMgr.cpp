@@ -246,7 +246,10 @@ void RenderImposterMgr::_innerRender( const SceneRenderState *state, RenderDefer
             
             // NOTE: Its safe to compare matinstances here instead of
             // the state hint because imposters all share the same 
-            // material instances.... if this changes revise.            
+            // material instances.... if this changes revise.
+            //
+            // All the shapes on a TSImposterAtlas page share one
+            // material instance, so they end up in the same batch.
             if ( ri->mat != currMat )
                break;
 
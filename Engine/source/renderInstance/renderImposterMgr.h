@@ -53,7 +53,9 @@ GFXDeclareVertexFormat( ImposterCorner )
 /// This is a special render manager for processing single 
 /// billboard imposters typically generated by the tsLastDetail
 /// class.  It tries to render them in large batches with as 
-/// few state changes as possible.  For an example of use see 
+/// few state changes as possible.  Imposters of different shapes
+/// packed into the same TSImposterAtlas page share a material and
+/// are drawn together.  For an example of use see 
 /// TSLastDetail::render().
 class RenderImposterMgr : public RenderBinManager
 {
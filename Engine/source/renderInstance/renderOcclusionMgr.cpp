@@ -150,6 +150,60 @@ void RenderOcclusionMgr::init()
    mSphereBuff.unlock();
 }
 
+void RenderOcclusionMgr::_renderQueries( SceneRenderState *state, bool fullPixels )
+{
+   MatrixSet &matrixSet = getRenderPass()->getMatrixSet();
+
+   bool stateSet = false;
+   S32 lastSphere = -1;
+   U32 primCount = 0;
+
+   for( U32 i=0; i<mElementList.size(); i++ )
+   {
+      OccluderRenderInst *ri = static_cast<OccluderRenderInst*>(mElementList[i].inst);      
+      AssertFatal( ri->query != NULL, "RenderOcclusionMgr::render, OcclusionRenderInst has NULL GFXOcclusionQuery" );
+
+      GFXOcclusionQuery *query = fullPixels ? ri->query2 : ri->query;
+      if ( !query )
+         continue;
+
+      if ( !stateSet )
+      {
+         if ( fullPixels )
+            GFX->setStateBlock( mTestSB );
+         else if ( !smDebugRender )
+            GFX->setStateBlock( mRenderSB );
+         stateSet = true;
+      }
+
+      if ( (S32)ri->isSphere != lastSphere )
+      {
+         if ( ri->isSphere )
+         {
+            GFX->setVertexBuffer( mSphereBuff );
+            primCount = mSpherePrimCount;
+         }
+         else
+         {
+            GFX->setVertexBuffer( mBoxBuff );
+            primCount = 12;
+         }
+         lastSphere = ri->isSphere;
+      }
+
+      MatrixF xfm( *ri->orientation );
+      xfm.setPosition( ri->position );      
+      xfm.scale( ri->scale );
+
+      matrixSet.setWorld(xfm);
+      mMatInstance->setTransforms(matrixSet, state);
+
+      query->begin();      
+      GFX->drawPrimitive( GFXTriangleList, 0, primCount );
+      query->end();
+   }
+}
+
 void RenderOcclusionMgr::consoleInit()
 {
    Con::addVariable( "$RenderOcclusionMgr::debugRender", TypeBool, &RenderOcclusionMgr::smDebugRender,
@@ -191,46 +245,10 @@ void RenderOcclusionMgr::render( SceneRenderState *state )
    // The material is single pass... just setup once here.
    mMatInstance->setupPass( state, sgData );
 
-   U32 primCount;
-   for( U32 i=0; i<mElementList.size(); i++ )
-   {
-      OccluderRenderInst *ri = static_cast<OccluderRenderInst*>(mElementList[i].inst);      
-      AssertFatal( ri->query != NULL, "RenderOcclusionMgr::render, OcclusionRenderInst has NULL GFXOcclusionQuery" );
-
-     if ( ri->isSphere )
-     {
-        GFX->setVertexBuffer( mSphereBuff );
-        primCount = mSpherePrimCount;
-     }
-     else
-     {
-        GFX->setVertexBuffer( mBoxBuff );
-        primCount = 12;
-     }
-
-      MatrixF xfm( *ri->orientation );
-      xfm.setPosition( ri->position );      
-      xfm.scale( ri->scale );
-
-      matrixSet.setWorld(xfm);
-      mMatInstance->setTransforms(matrixSet, state);
-
-      if ( !smDebugRender )
-         GFX->setStateBlock( mRenderSB );   
-
-      ri->query->begin();      
-      GFX->drawPrimitive( GFXTriangleList, 0, primCount );
-      ri->query->end();
-
-      if ( ri->query2 )
-      {
-         GFX->setStateBlock( mTestSB );
-
-         ri->query2->begin();
-         GFX->drawPrimitive( GFXTriangleList, 0, primCount );
-         ri->query2->end();
-      }
-   }   
+   // Issue all the depth tested queries first and then all the full pixel
+   // queries, so the state only changes once instead of for every instance.
+   _renderQueries( state, false );
+   _renderQueries( state, true );
 
    // Call setup one more time to end the pass.
    mMatInstance->setupPass( state, sgData );
@@ -58,6 +58,10 @@ protected:
 
    static bool smDebugRender;
 
+   /// Draws the occluders for either the depth tested or the full pixel
+   /// queries under a single state block.
+   void _renderQueries( SceneRenderState *state, bool fullPixels );
+
    GFXVertexBufferHandle<GFXVertexP> mBoxBuff;
    GFXVertexBufferHandle<GFXVertexP> mSphereBuff;
    U32 mSpherePrimCount;
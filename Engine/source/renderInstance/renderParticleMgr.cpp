@@ -367,6 +367,22 @@ void RenderParticleMgr::_initGFXResources()
    d.stencilPassOp = GFXStencilOpZero;
 
    mStencilClearSB = GFX->createStateBlock(d);
+
+   // Quad indices for the shared stream
+   mBatchPrimBuff.set( GFX, MaxBatchParticles * 6, 0, GFXBufferTypeStatic );
+   U16 *indices;
+   mBatchPrimBuff.lock( &indices );
+   for ( U32 i = 0; i < MaxBatchParticles; i++, indices += 6 )
+   {
+      const U16 offset = i * 4;
+      indices[0] = offset + 0;
+      indices[1] = offset + 1;
+      indices[2] = offset + 3;
+      indices[3] = offset + 1;
+      indices[4] = offset + 3;
+      indices[5] = offset + 2;
+   }
+   mBatchPrimBuff.unlock();
 }
 
 void RenderParticleMgr::renderInstance(ParticleRenderInst *ri, SceneRenderState *state)
@@ -382,7 +398,8 @@ void RenderParticleMgr::renderInstance(ParticleRenderInst *ri, SceneRenderState
       {
          GFX->setStateBlock( _getOffscreenStateBlock(ri) );
          ri->systemState = PSS_AwaitingCompositeDraw;
-         mParticleShaderConsts.mShaderConsts->setSafe( mParticleShaderConsts.mModelViewProjSC, 
+         ShaderConsts &consts = _getShaderConsts( ri );
+         consts.mShaderConsts->setSafe( consts.mModelViewProjSC, 
             *ri->modelViewProj * mOffscreenSystems[ri->targetIndex].clipMatrix );
       }
       else
@@ -392,7 +409,8 @@ void RenderParticleMgr::renderInstance(ParticleRenderInst *ri, SceneRenderState
          else
             GFX->setStateBlock( _getHighResStateBlock( ri ) );
          ri->systemState = PSS_DrawComplete;
-         mParticleShaderConsts.mShaderConsts->setSafe( mParticleShaderConsts.mModelViewProjSC, *ri->modelViewProj );
+         ShaderConsts &consts = _getShaderConsts( ri );
+         consts.mShaderConsts->setSafe( consts.mModelViewProjSC, *ri->modelViewProj );
       }
 
       renderParticle(ri, state);
@@ -469,8 +487,98 @@ void RenderParticleMgr::renderInstance(ParticleRenderInst *ri, SceneRenderState
    }
 }
 
+bool RenderParticleMgr::canBatch( const ParticleRenderInst *ri, const ParticleRenderInst *next )
+{
+   return   ri->batchVerts && next->batchVerts &&
+            ri->systemState == PSS_AwaitingHighResDraw &&
+            next->systemState == PSS_AwaitingHighResDraw &&
+            ri->diffuseTex == next->diffuseTex &&
+            ri->blendStyle == next->blendStyle &&
+            ri->softnessDistance == next->softnessDistance &&
+            ( ri->modelViewProj == next->modelViewProj || 
+              dMemcmp( ri->modelViewProj, next->modelViewProj, sizeof( MatrixF ) ) == 0 );
+}
+
+void RenderParticleMgr::renderBatch( ParticleRenderInst **ris, U32 count, SceneRenderState *state )
+{
+   ParticleRenderInst *ri = ris[0];
+   if ( count == 1 )
+   {
+      renderInstance( ri, state );
+      return;
+   }
+
+   GFX->setStateBlock( _getHighResStateBlock( ri ) );
+   mParticleShaderConsts.mShaderConsts->setSafe( mParticleShaderConsts.mModelViewProjSC, *ri->modelViewProj );
+
+   for ( U32 i = 0; i < count; i++ )
+      ris[i]->systemState = PSS_DrawComplete;
+
+   if ( _setupParticleShader( ri, state ) )
+      _drawBatchVerts( ris, count );
+}
+
+void RenderParticleMgr::_drawBatchVerts( ParticleRenderInst **ris, U32 count )
+{
+   U32 start = 0;
+   while ( start < count )
+   {
+      // Take as many systems as fit in one draw.
+      U32 end = start;
+      U32 numParticles = 0;
+      while ( end < count && numParticles + ris[end]->count <= MaxBatchParticles )
+         numParticles += ris[end++]->count;
+
+      AssertFatal( end > start, "RenderParticleMgr::_drawBatchVerts - System too large to batch!" );
+      if ( end == start )
+         return;
+
+      mBatchVertBuff.set( GFX, numParticles * 4, GFXBufferTypeVolatile );
+      GFXVertexPCT *verts = mBatchVertBuff.lock();
+      for ( U32 i = start; i < end; i++ )
+      {
+         dMemcpy( verts, ris[i]->batchVerts, ris[i]->count * 4 * sizeof( GFXVertexPCT ) );
+         verts += ris[i]->count * 4;
+      }
+      mBatchVertBuff.unlock();
+
+      GFX->setPrimitiveBuffer( mBatchPrimBuff );
+      GFX->setVertexBuffer( mBatchVertBuff );
+      GFX->drawIndexedPrimitive( GFXTriangleList, 0, 0, numParticles * 4, 0, numParticles * 2 );
+
+      start = end;
+   }
+}
+
 void RenderParticleMgr::renderParticle(ParticleRenderInst* ri, SceneRenderState* state)
 {
+   if ( !_setupParticleShader( ri, state ) )
+      return;
+
+   if ( ri->gpuSystem )
+   {
+      GFX->setPrimitiveBuffer( *ri->primBuff );
+      GFX->setVertexBuffer( *ri->vertBuff );
+      ri->gpuSystem->draw();
+   }
+   else if ( ri->batchVerts )
+      _drawBatchVerts( &ri, 1 );
+   else
+   {
+      GFX->setPrimitiveBuffer( *ri->primBuff );
+      GFX->setVertexBuffer( *ri->vertBuff );
+      GFX->drawIndexedPrimitive( GFXTriangleList, 0, 0, ri->count * 4, 0, ri->count * 2 );
+   }
+}
+
+bool RenderParticleMgr::_setupParticleShader( ParticleRenderInst *ri, SceneRenderState *state )
+{
+   // GPU simulated particles need their own shader
+   if ( ri->gpuSystem && !mGPUParticleShader )
+      return false;
+
+   ShaderConsts &consts = _getShaderConsts( ri );
+
    // We want to turn everything into variation on a pre-multiplied alpha blend
    F32 alphaFactor = 0.0f, alphaScale = 1.0f;
    switch(ri->blendStyle)
@@ -493,42 +601,66 @@ void RenderParticleMgr::renderParticle(ParticleRenderInst* ri, SceneRenderState*
       break;
    }
 
-   mParticleShaderConsts.mShaderConsts->setSafe( mParticleShaderConsts.mAlphaFactorSC, alphaFactor );
-   mParticleShaderConsts.mShaderConsts->setSafe( mParticleShaderConsts.mAlphaScaleSC, alphaScale );
+   consts.mShaderConsts->setSafe( consts.mAlphaFactorSC, alphaFactor );
+   consts.mShaderConsts->setSafe( consts.mAlphaScaleSC, alphaScale );
 
-   mParticleShaderConsts.mShaderConsts->setSafe( mParticleShaderConsts.mFSModelViewProjSC, *ri->modelViewProj  );
-   mParticleShaderConsts.mShaderConsts->setSafe( mParticleShaderConsts.mOneOverFarSC, 1.0f / state->getFarPlane() );     
+   consts.mShaderConsts->setSafe( consts.mFSModelViewProjSC, *ri->modelViewProj  );
+   consts.mShaderConsts->setSafe( consts.mOneOverFarSC, 1.0f / state->getFarPlane() );     
 
-   if ( mParticleShaderConsts.mOneOverSoftnessSC->isValid() )
+   if ( consts.mOneOverSoftnessSC->isValid() )
    {
       F32 oneOverSoftness = 1.0f;
       if ( ri->softnessDistance > 0.0f )
          oneOverSoftness = 1.0f / ( ri->softnessDistance / state->getFarPlane() );
-      mParticleShaderConsts.mShaderConsts->set( mParticleShaderConsts.mOneOverSoftnessSC, oneOverSoftness );
+      consts.mShaderConsts->set( consts.mOneOverSoftnessSC, oneOverSoftness );
    }
 
-   GFX->setShader( mParticleShader );
-   GFX->setShaderConstBuffer( mParticleShaderConsts.mShaderConsts );
+   if ( ri->gpuSystem )
+   {
+      // The vertex shader billboards the particles with the camera axes.
+      const MatrixF &camXfm = state->getCameraTransform();
+      ri->gpuSystem->setShaderConsts( consts.mShaderConsts, mGPUSimConsts,
+                                      camXfm.getRightVector(), camXfm.getUpVector(),
+                                      state->getAmbientLightColor(), ri->ambientFactor );
+      GFX->setShader( mGPUParticleShader );
+   }
+   else
+      GFX->setShader( mParticleShader );
+   GFX->setShaderConstBuffer( consts.mShaderConsts );
 
-      GFX->setTexture( mParticleShaderConsts.mSamplerDiffuse->getSamplerRegister(), ri->diffuseTex );
+      GFX->setTexture( consts.mSamplerDiffuse->getSamplerRegister(), ri->diffuseTex );
 
    // Set up the deferred texture.
-   if ( mParticleShaderConsts.mDeferredTargetParamsSC->isValid() )
+   if ( consts.mDeferredTargetParamsSC->isValid() )
    {
       GFXTextureObject *texObject = mDeferredTarget ? mDeferredTarget->getTexture(0) : NULL;
-         GFX->setTexture( mParticleShaderConsts.mSamplerDeferredTex->getSamplerRegister(), texObject );
+         GFX->setTexture( consts.mSamplerDeferredTex->getSamplerRegister(), texObject );
 
       Point4F rtParams( 0.0f, 0.0f, 1.0f, 1.0f );
       if ( texObject )
          ScreenSpace::RenderTargetParameters(texObject->getSize(), mDeferredTarget->getViewport(), rtParams);
 
-      mParticleShaderConsts.mShaderConsts->set( mParticleShaderConsts.mDeferredTargetParamsSC, rtParams );
+      consts.mShaderConsts->set( consts.mDeferredTargetParamsSC, rtParams );
    }
 
-   GFX->setPrimitiveBuffer( *ri->primBuff );
-   GFX->setVertexBuffer( *ri->vertBuff );
+   return true;
+}
 
-   GFX->drawIndexedPrimitive( GFXTriangleList, 0, 0, ri->count * 4, 0, ri->count * 2 );
+void RenderParticleMgr::_initShaderConsts( GFXShader *shader, ShaderConsts &consts )
+{
+   consts.mShaderConsts = shader->allocConstBuffer();
+   consts.mModelViewProjSC = shader->getShaderConstHandle( "$modelViewProj" );
+   consts.mOneOverFarSC = shader->getShaderConstHandle( "$oneOverFar" );
+   consts.mOneOverSoftnessSC = shader->getShaderConstHandle( "$oneOverSoftness" );
+   consts.mAlphaFactorSC = shader->getShaderConstHandle( "$alphaFactor" );
+   consts.mAlphaScaleSC = shader->getShaderConstHandle( "$alphaScale" );
+   consts.mFSModelViewProjSC = shader->getShaderConstHandle( "$fsModelViewProj" );
+   consts.mDeferredTargetParamsSC = shader->getShaderConstHandle( "$deferredTargetParams" );
+
+   //samplers
+   consts.mSamplerDiffuse = shader->getShaderConstHandle("$diffuseMap");
+   consts.mSamplerDeferredTex = shader->getShaderConstHandle("$deferredTex");
+   consts.mSamplerParaboloidLightMap = shader->getShaderConstHandle("$paraboloidLightMap");
 }
 
 bool RenderParticleMgr::_initShader()
@@ -549,20 +681,19 @@ bool RenderParticleMgr::_initShader()
    ret &= (mParticleShader != NULL);
 
    if ( mParticleShader )
+      _initShaderConsts( mParticleShader, mParticleShaderConsts );
+
+   shaderData = NULL;
+
+   // The GPU particle shader is optional, emitters fall back
+   // to CPU simulation when it doesn't exist.
+   if ( Sim::findObject( GPUParticleSystem::smShaderDataName, shaderData ) && shaderData )
+      mGPUParticleShader = shaderData->getShader( macros );
+
+   if ( mGPUParticleShader )
    {
-      mParticleShaderConsts.mShaderConsts = mParticleShader->allocConstBuffer();
-      mParticleShaderConsts.mModelViewProjSC = mParticleShader->getShaderConstHandle( "$modelViewProj" );
-      mParticleShaderConsts.mOneOverFarSC = mParticleShader->getShaderConstHandle( "$oneOverFar" );
-      mParticleShaderConsts.mOneOverSoftnessSC = mParticleShader->getShaderConstHandle( "$oneOverSoftness" );
-      mParticleShaderConsts.mAlphaFactorSC = mParticleShader->getShaderConstHandle( "$alphaFactor" );
-      mParticleShaderConsts.mAlphaScaleSC = mParticleShader->getShaderConstHandle( "$alphaScale" );
-      mParticleShaderConsts.mFSModelViewProjSC = mParticleShader->getShaderConstHandle( "$fsModelViewProj" );
-      mParticleShaderConsts.mDeferredTargetParamsSC = mParticleShader->getShaderConstHandle( "$deferredTargetParams" );
-
-      //samplers
-      mParticleShaderConsts.mSamplerDiffuse = mParticleShader->getShaderConstHandle("$diffuseMap");
-      mParticleShaderConsts.mSamplerDeferredTex = mParticleShader->getShaderConstHandle("$deferredTex");
-      mParticleShaderConsts.mSamplerParaboloidLightMap = mParticleShader->getShaderConstHandle("$paraboloidLightMap");
+      _initShaderConsts( mGPUParticleShader, mGPUParticleShaderConsts );
+      mGPUSimConsts.init( mGPUParticleShader );
    }
 
    shaderData = NULL;
@@ -31,6 +31,10 @@
 #include "gfx/gfxPrimitiveBuffer.h"
 #endif
 
+#ifndef _GPUPARTICLESYSTEM_H_
+#include "T3D/fx/gpuParticleSystem.h"
+#endif
+
 GFXDeclareVertexFormat( CompositeQuadVert )
 {
    GFXVertexColor uvCoord;
@@ -62,6 +66,17 @@ public:
    const static U8 ParticleSystemStencilMask = 0x80; // We are using the top bit
    const static U32 OffscreenPoolSize = 5;
 
+   /// Most particles drawn from the shared stream at once,
+   /// which keeps the indices 16 bit.
+   const static U32 MaxBatchParticles = 16384;
+
+   /// Return true if @a next can be drawn in one batch after @a ri.
+   static bool canBatch( const ParticleRenderInst *ri, const ParticleRenderInst *next );
+
+   /// Draw high resolution systems which canBatch() with the first one,
+   /// in order, with as few draws as possible.
+   void renderBatch( ParticleRenderInst **ris, U32 count, SceneRenderState *state );
+
    virtual void setTargetChainLength(const U32 chainLength);
 
 protected:
@@ -80,6 +95,12 @@ protected:
 public:
    void renderParticle(ParticleRenderInst *ri, SceneRenderState *state);
 protected:
+   /// Set the shader, constants and textures to draw @a ri with.
+   bool _setupParticleShader( ParticleRenderInst *ri, SceneRenderState *state );
+
+   /// Copy the batchVerts of @a ris into the shared stream and draw them.
+   void _drawBatchVerts( ParticleRenderInst **ris, U32 count );
+
    bool mOffscreenRenderEnabled;
 
    /// The deferred render target used for the
@@ -89,6 +110,9 @@ protected:
    /// The shader used for particle rendering.
    GFXShaderRef mParticleShader;
 
+   /// The optional shader used for GPU simulated particles.
+   GFXShaderRef mGPUParticleShader;
+
    GFXShaderRef mParticleCompositeShader;
    NamedTexTargetRef mEdgeTarget;
 
@@ -116,7 +140,12 @@ protected:
       GFXShaderConstHandle *mSamplerDeferredTex;
       GFXShaderConstHandle *mSamplerParaboloidLightMap;
 
-   } mParticleShaderConsts;
+   } mParticleShaderConsts, mGPUParticleShaderConsts;
+
+   /// The simulation constants of mGPUParticleShader.
+   GPUParticleSystem::ShaderConsts mGPUSimConsts;
+
+   void _initShaderConsts( GFXShader *shader, ShaderConsts &consts );
 
    struct CompositeShaderConsts
    {
@@ -132,6 +161,10 @@ protected:
    GFXVertexBufferHandle<CompositeQuadVert> mScreenQuadVertBuff;
    GFXPrimitiveBufferHandle mScreenQuadPrimBuff;
 
+   /// The shared stream batched systems are drawn from.
+   GFXVertexBufferHandle<GFXVertexPCT> mBatchVertBuff;
+   GFXPrimitiveBufferHandle mBatchPrimBuff;
+
    GFXStateBlockRef mStencilClearSB;
    GFXStateBlockRef mHighResBlocks[ParticleRenderInst::BlendStyle_COUNT];
    GFXStateBlockRef mOffscreenBlocks[ParticleRenderInst::BlendStyle_COUNT];
@@ -143,7 +176,7 @@ public:
    GFXStateBlockRef _getMixedResStateBlock(ParticleRenderInst *ri);
    GFXStateBlockRef _getOffscreenStateBlock(ParticleRenderInst *ri);
    GFXStateBlockRef _getCompositeStateBlock(ParticleRenderInst *ri);
-   ShaderConsts &_getShaderConsts() { return mParticleShaderConsts; };
+   ShaderConsts &_getShaderConsts( ParticleRenderInst *ri = NULL ) { return ri && ri->gpuSystem ? mGPUParticleShaderConsts : mParticleShaderConsts; };
 };
 
 
@@ -30,7 +30,9 @@
 #include "scene/sceneManager.h"
 #include "scene/sceneObject.h"
 #include "gfx/primBuilder.h"
+#include "gfx/gfxGPUTimings.h"
 #include "platform/profiler.h"
+#include "platform/threads/jobSystem.h"
 #include "renderInstance/renderBinManager.h"
 #include "renderInstance/renderObjectMgr.h"
 #include "renderInstance/renderMeshMgr.h"
@@ -122,11 +124,25 @@ RenderPassManager::RenderBinEventSignal& RenderPassManager::getRenderBinSignal()
    return theSignal;
 }
 
+bool RenderPassManager::smParallelSort = false;
+U32 RenderPassManager::smParallelSortMinElements = 1024;
+
 void RenderPassManager::initPersistFields()
 {
    Parent::initPersistFields();
 }
 
+void RenderPassManager::consoleInit()
+{
+   Con::addVariable( "$RenderPassManager::parallelSort", TypeBool, &smParallelSort,
+      "If true, the render bins of a pass are sorted in parallel.\n"
+      "@ingroup RenderBin\n" );
+
+   Con::addVariable( "$RenderPassManager::parallelSortMinElements", TypeS32, &smParallelSortMinElements,
+      "Minimum number of render instances in a pass for its bins to be sorted in parallel.\n"
+      "@ingroup RenderBin\n" );
+}
+
 RenderPassManager::RenderPassManager()
 {   
    mSceneManager = NULL;
@@ -210,10 +226,60 @@ void RenderPassManager::addInst( RenderInst *inst )
    iter->value.trigger( inst );
 }
 
+void RenderPassManager::addInsts( RenderInst **insts, U32 count )
+{
+   PROFILE_SCOPE( RenderPassManager_addInsts );
+
+   U32 i = 0;
+   while ( i < count )
+   {
+      AssertFatal( insts[i] != NULL, "RenderPassManager::addInsts - Got null instance!" );
+
+      const RenderInstTypeHash type = insts[i]->type;
+      AddInstTable::Iterator iter = mAddInstSignals.find( type );
+
+      U32 end = i + 1;
+      while ( end < count && insts[end]->type == type )
+         end++;
+
+      if ( iter != mAddInstSignals.end() )
+      {
+         for ( ; i < end; i++ )
+            iter->value.trigger( insts[i] );
+      }
+
+      i = end;
+   }
+}
+
+void RenderPassManager::_sortBins( void* data, U32 start, U32 end )
+{
+   RenderPassManager* pass = reinterpret_cast< RenderPassManager* >( data );
+   for ( U32 i = start; i < end; i++ )
+      pass->mRenderBins[i]->sort();
+}
+
 void RenderPassManager::sort()
 {
    PROFILE_SCOPE( RenderPassManager_Sort );
 
+   if ( smParallelSort && mRenderBins.size() > 1 )
+   {
+      U32 numElements = 0;
+      for ( U32 i = 0; i < mRenderBins.size(); i++ )
+      {
+         AssertFatal(mRenderBins[i], "Render manager invalid!");
+         numElements += mRenderBins[i]->mElementList.size();
+      }
+
+      // One job per bin; the bins of a pass sort independent lists.
+      if ( numElements >= smParallelSortMinElements )
+      {
+         JobSystem::GLOBAL().parallelFor( mRenderBins.size(), 1, _sortBins, this );
+         return;
+      }
+   }
+
    for (Vector<RenderBinManager *>::iterator itr = mRenderBins.begin();
       itr != mRenderBins.end(); itr++)
    {
@@ -226,7 +292,8 @@ void RenderPassManager::clear()
 {
    PROFILE_SCOPE( RenderPassManager_Clear );
 
-   mChunker.clear();
+   // Keep the chunks for the next frame instead of going back to the heap.
+   mChunker.reset();
 
    for (Vector<RenderBinManager *>::iterator itr = mRenderBins.begin();
       itr != mRenderBins.end(); itr++)
@@ -243,6 +310,10 @@ void RenderPassManager::render(SceneRenderState * state)
    GFX->pushWorldMatrix();
    MatrixF proj = GFX->getProjectionMatrix();
 
+   // Only the bins of the main pass get their own GPU timing zones, the
+   // shadow passes are timed as a whole.
+   GFXGPUTimings *gpuTimings = GFX->getGPUTimings();
+   const bool timeBins = gpuTimings->isActive() && state->isDiffusePass();
    
    for (Vector<RenderBinManager *>::iterator itr = mRenderBins.begin();
       itr != mRenderBins.end(); itr++)
@@ -250,7 +321,18 @@ void RenderPassManager::render(SceneRenderState * state)
       RenderBinManager *curBin = *itr;
       AssertFatal(curBin, "Invalid render manager!");
       getRenderBinSignal().trigger(curBin, state, true);
+
+      if ( timeBins )
+      {
+         StringTableEntry name = curBin->getName();
+         gpuTimings->begin( name ? name : StringTable->insert( curBin->getClassName() ) );
+      }
+
       curBin->render(state);
+
+      if ( timeBins )
+         gpuTimings->end();
+
       getRenderBinSignal().trigger(curBin, state, false);
    }
 
@@ -48,6 +48,7 @@ class LightInfo;
 struct RenderInst;
 class MatrixSet;
 class GFXPrimitiveBufferHandle;
+class GPUParticleSystem;
 
 /// A RenderInstType hash value.
 typedef U32 RenderInstTypeHash;
@@ -160,12 +161,26 @@ public:
    /// Allocate a GFXPrimitive object which will remain valid 
    /// until the pass manager is cleared.
    GFXPrimitive* allocPrim() { return mChunker.alloc<GFXPrimitive>(); }
+
+   /// Allocate uninitialized space for @a count elements, valid until ::clear called.
+   /// Use this instead of heap allocating temporary arrays which have to live
+   /// as long as the render instances referencing them.
+   template <typename T>
+   T* allocArray(U32 count) { return mChunker.allocArray<T>(count); }
    /// @}
 
    /// Add a RenderInstance to the list
    virtual void addInst( RenderInst *inst );
+
+   /// Add @a count RenderInstances at once.  The bins for a type are only
+   /// looked up once per run of instances with that type, so keep
+   /// instances of the same type together.
+   virtual void addInsts( RenderInst **insts, U32 count );
    
    /// Sorts the list of RenderInst's per bin. (Normally, one should just call renderPass)
+   ///
+   /// With #smParallelSort set, bins are sorted in parallel on the JobSystem.
+   /// RenderBinManager::sort() must then only touch the bin's own lists.
    void sort();
 
    /// Renders the list of RenderInsts (Normally, one should just call renderPass)
@@ -239,10 +254,19 @@ public:
 
    // ConsoleObject interface
    static void initPersistFields();
+   static void consoleInit();
    DECLARE_CONOBJECT(RenderPassManager);
 
+   /// If true, the bins of a pass are sorted in parallel.
+   static bool smParallelSort;
+
+   /// Minimum number of instances in a pass for its bins to be sorted in parallel.
+   static U32 smParallelSortMinElements;
+
 protected:
 
+   static void _sortBins( void* data, U32 start, U32 end );
+
    MultiTypedChunker mChunker;
       
    Vector< RenderBinManager* > mRenderBins;
@@ -438,6 +462,17 @@ struct ParticleRenderInst : public RenderInst
    /// The particle texture.
    GFXTextureObject *diffuseTex;
 
+   /// If not NULL the particles are simulated on the GPU and
+   /// drawn by it with the GPUParticlesShaderData shader.
+   GPUParticleSystem *gpuSystem;
+
+   /// If not NULL the count * 4 vertices of the particles, which are
+   /// drawn from a stream shared with other systems instead of vertBuff.
+   const GFXVertexPCT *batchVerts;
+
+   /// How much the ambient light tints GPU simulated particles.
+   F32 ambientFactor;
+
    void clear();
 };
 
@@ -201,16 +201,30 @@ void RenderTranslucentMgr::render( SceneRenderState *state )
       {
          ParticleRenderInst *ri = static_cast<ParticleRenderInst*>(baseRI);
 
+         // Gather the following systems which can be drawn along with
+         // this one without breaking the sort order.
+         mParticleBatch.clear();
+         mParticleBatch.push_back( ri );
+         for ( U32 a = j + 1; a < binSize; a++ )
+         {
+            RenderInst *nextRI = mElementList[a].inst;
+            if (  nextRI->type != RenderPassManager::RIT_Particle ||
+                  !RenderParticleMgr::canBatch( ri, static_cast<ParticleRenderInst*>(nextRI) ) )
+               break;
+
+            mParticleBatch.push_back( static_cast<ParticleRenderInst*>(nextRI) );
+         }
+
          // Tell Particle RM to draw the system. (This allows the particle render manager
          // to manage drawing offscreen particle systems, and allows the systems
          // to be composited back into the scene with proper translucent
          // sorting order)
-         mParticleRenderMgr->renderInstance(ri, state);
+         mParticleRenderMgr->renderBatch( mParticleBatch.address(), mParticleBatch.size(), state );
 
          lastVB = NULL;    // no longer valid, null it
          lastPB = NULL;    // no longer valid, null it
 
-         j++;
+         j += mParticleBatch.size();
          continue;
       }
       else if ( baseRI->type == RenderPassManager::RIT_Translucent )
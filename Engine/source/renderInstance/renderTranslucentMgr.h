@@ -61,6 +61,9 @@ protected:
    
    GFXStateBlockRef _getStateBlock( U8 transFlag );
    RenderParticleMgr *mParticleRenderMgr;;
+
+   /// Particle systems drawn together by RenderParticleMgr::renderBatch().
+   Vector<ParticleRenderInst*> mParticleBatch;
 };
 
 
@@ -0,0 +1,72 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "renderInstance/renderBinManager.h"
+#include "math/mRandom.h"
+
+class RenderBinManagerSortTest : public RenderBinManager
+{
+public:
+
+   void run( U32 count, U32 keyMask, U32 key2Mask )
+   {
+      MRandomLCG random( count );
+
+      Vector< MainSortElem > list;
+      for ( U32 i = 0; i < count; i++ )
+      {
+         MainSortElem elem;
+         elem.inst = NULL;
+         elem.key = ( random.randI() ^ ( random.randI() << 16 ) ) & keyMask;
+         elem.key2 = ( random.randI() ^ ( random.randI() << 16 ) ) & key2Mask;
+         list.push_back( elem );
+      }
+
+      Vector< MainSortElem > expected = list;
+      dQsort( expected.address(), expected.size(), sizeof( MainSortElem ), cmpKeyFunc );
+
+      sortElements( list );
+
+      ASSERT_EQ( list.size(), expected.size() );
+      for ( U32 i = 0; i < list.size(); i++ )
+      {
+         EXPECT_EQ( list[i].key, expected[i].key );
+         EXPECT_EQ( list[i].key2, expected[i].key2 );
+      }
+   }
+};
+
+TEST(RenderBinManager, SortElements)
+{
+   RenderBinManagerSortTest bin;
+
+   // Short lists go through dQsort, longer ones through the radix sort.
+   bin.run( 10, 0xFFFFFFFF, 0xFFFFFFFF );
+   bin.run( 1000, 0xFFFFFFFF, 0xFFFFFFFF );
+   bin.run( 1000, 0x80000FF0, 0x0000FFFF );
+   bin.run( 1000, 0, 0xFFFFFFFF );
+   bin.run( 1000, 0, 0 );
+}
+
+#endif
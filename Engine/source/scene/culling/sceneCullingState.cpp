@@ -38,6 +38,7 @@ extern bool gEditingMission;
 
 bool SceneCullingState::smDisableTerrainOcclusion = false;
 bool SceneCullingState::smDisableZoneCulling = false;
+bool SceneCullingState::smUseTerrainOcclusionBuffer = true;
 U32 SceneCullingState::smMaxOccludersPerZone = 4;
 F32 SceneCullingState::smOccluderMinWidthPercentage = 0.1f;
 F32 SceneCullingState::smOccluderMinHeightPercentage = 0.1f;
@@ -50,7 +51,8 @@ SceneCullingState::SceneCullingState( SceneManager* sceneManager, const SceneCam
    : mSceneManager( sceneManager ),
      mCameraState( viewState ),
      mDisableTerrainOcclusion( smDisableTerrainOcclusion ),
-     mDisableZoneCulling( smDisableZoneCulling )
+     mDisableZoneCulling( smDisableZoneCulling ),
+     mTerrainOcclusionBufferReady( false )
 {
    AssertFatal( sceneManager->getZoneManager(), "SceneCullingState::SceneCullingState - SceneManager must have a zone manager!" );
 
@@ -719,6 +721,32 @@ U32 SceneCullingState::cullObjects( SceneObject** objects, U32 numObjects, U32 c
    const PlaneF& nearPlane = getCullingFrustum().getPlanes()[ Frustum::PlaneNear ];
    const PlaneF& farPlane = getCullingFrustum().getPlanes()[ Frustum::PlaneFar ];
 
+   // Test all the world boxes against the root frustum in one batch.  The
+   // culling volumes of every zone lie within the root frustum so whatever
+   // is outside of it can be rejected without looking at any zones.
+
+   const F32* bounds[ 6 ];
+   for( U32 c = 0; c < 6; ++ c )
+   {
+      mCullBounds[ c ].setSize( numObjects );
+      bounds[ c ] = mCullBounds[ c ].address();
+   }
+
+   for( U32 i = 0; i < numObjects; ++ i )
+   {
+      const Box3F& worldBox = objects[ i ]->getWorldBox();
+      mCullBounds[ 0 ][ i ] = worldBox.minExtents.x;
+      mCullBounds[ 1 ][ i ] = worldBox.minExtents.y;
+      mCullBounds[ 2 ][ i ] = worldBox.minExtents.z;
+      mCullBounds[ 3 ][ i ] = worldBox.maxExtents.x;
+      mCullBounds[ 4 ][ i ] = worldBox.maxExtents.y;
+      mCullBounds[ 5 ][ i ] = worldBox.maxExtents.z;
+   }
+
+   mCullVisibility.setSize( ( numObjects + 31 ) / 32 );
+   m_box3F_planes_cull_soa( &getCullingFrustum().getPlanes()[ 0 ].x, getCullingFrustum().getNumPlanes(),
+                            bounds, numObjects, mCullVisibility.address() );
+
    for( U32 i = 0; i < numObjects; ++ i )
    {
       SceneObject* object = objects[ i ];
@@ -750,6 +778,11 @@ U32 SceneCullingState::cullObjects( SceneObject** objects, U32 numObjects, U32 c
       else if( object->isGlobalBounds() )
          isCulled = false;
 
+      // Outside of the root frustum.
+
+      else if( !( mCullVisibility[ i >> 5 ] & ( 1 << ( i & 31 ) ) ) )
+         isCulled = true;
+
       // If terrain occlusion checks are enabled, run them now.
 
       else if( !mDisableTerrainOcclusion &&
@@ -761,13 +794,14 @@ U32 SceneCullingState::cullObjects( SceneObject** objects, U32 numObjects, U32 c
       }
 
       // If the object shouldn't be subjected to more fine-grained culling
-      // or if zone culling is disabled, just test against the root frustum.
+      // or if zone culling is disabled, the root frustum test above is all
+      // there is.
 
       else if( !( object->getTypeMask() & CULLING_INCLUDE_TYPEMASK ) ||
                ( object->getTypeMask() & CULLING_EXCLUDE_TYPEMASK ) ||
                disableZoneCulling() )
       {
-         isCulled = getCullingFrustum().isCulled( object->getWorldBox() );
+         isCulled = false;
       }
 
       // Go through the zones that the object is assigned to and
@@ -806,6 +840,14 @@ bool SceneCullingState::isOccludedByTerrain( SceneObject* object ) const
    if( object->isGlobalBounds() )
       return false;
 
+   if( smUseTerrainOcclusionBuffer && !getCullingFrustum().isOrtho() )
+   {
+      if( !mTerrainOcclusionBufferReady )
+         _buildTerrainOcclusionBuffer();
+
+      return mTerrainOcclusionBuffer.isOccluded( object->getWorldBox() );
+   }
+
    const Vector< SceneObject* >& terrains = getSceneManager()->getContainer()->getTerrains();
    const U32 numTerrains = terrains.size();
 
@@ -882,6 +924,36 @@ bool SceneCullingState::isOccludedByTerrain( SceneObject* object ) const
 
 //-----------------------------------------------------------------------------
 
+void SceneCullingState::_buildTerrainOcclusionBuffer() const
+{
+   PROFILE_SCOPE( SceneCullingState_buildTerrainOcclusionBuffer );
+
+   mTerrainOcclusionBufferReady = true;
+   mTerrainOcclusionBuffer.init( getCullingFrustum() );
+
+   const Vector< SceneObject* >& terrains = getSceneManager()->getContainer()->getTerrains();
+   for( U32 i = 0; i < terrains.size(); ++ i )
+   {
+      TerrainBlock* terrain = dynamic_cast< TerrainBlock* >( terrains[ i ] );
+      if( !terrain )
+         continue;
+
+      // Don't occlude if we're below the terrain.  This prevents problems when
+      // looking out from underground bases...
+
+      Point3F localCamPos = getCameraState().getViewPosition();
+      terrain->getWorldTransform().mulP( localCamPos );
+
+      F32 height;
+      if( terrain->getHeight( Point2F( localCamPos.x, localCamPos.y ), &height ) && height > localCamPos.z )
+         continue;
+
+      terrain->addToOcclusionBuffer( &mTerrainOcclusionBuffer );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneCullingState::debugRenderCullingVolumes() const
 {
    const ColorI occluderColor( 255, 0, 0, 255 );
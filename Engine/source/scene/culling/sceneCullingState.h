@@ -39,6 +39,10 @@
 #include "scene/sceneCameraState.h"
 #endif
 
+#ifndef _SCENEOCCLUSIONBUFFER_H_
+#include "scene/culling/sceneOcclusionBuffer.h"
+#endif
+
 #ifndef _DATACHUNKER_H_
 #include "core/dataChunker.h"
 #endif
@@ -64,6 +68,10 @@ class SceneCullingState
       /// Whether to force zone culling to off by default.
       static bool smDisableZoneCulling;
 
+      /// If true, terrain occlusion is tested against a software occlusion
+      /// buffer the terrains are rasterized into rather than by raycasting.
+      static bool smUseTerrainOcclusionBuffer;
+
       /// @name Occluder Restrictions
       /// Size restrictions on occlusion culling volumes.  Any occlusion volume
       /// that does not meet these minimum requirements is not accepted into the
@@ -120,6 +128,12 @@ class SceneCullingState
       /// ZoneState entries for all zones in the scene.
       Vector< SceneZoneCullingState > mZoneStates;
 
+      /// Scratch space for cullObjects(): the world boxes of the objects being
+      /// culled as min x/y/z and max x/y/z arrays, and one bit per object telling
+      /// whether it passed the root frustum test.
+      mutable Vector< F32 > mCullBounds[ 6 ];
+      mutable Vector< U32 > mCullVisibility;
+
       /// Allocator for culling data that can be freed in one go when
       /// the culling state is freed.
       DataChunker mDataChunker;
@@ -132,6 +146,16 @@ class SceneCullingState
       /// frustum.
       bool mDisableZoneCulling;
 
+      /// Depth buffer of the terrains in the scene.  Built on the
+      /// first terrain occlusion test.
+      mutable SceneOcclusionBuffer mTerrainOcclusionBuffer;
+
+      /// Whether #mTerrainOcclusionBuffer has been built.
+      mutable bool mTerrainOcclusionBufferReady;
+
+      /// Rasterize all terrains the camera is above into #mTerrainOcclusionBuffer.
+      void _buildTerrainOcclusionBuffer() const;
+
    public:
 
       ///
@@ -232,6 +256,9 @@ class SceneCullingState
       /// visible.
       bool isWithinVisibleZone( SceneObject* object ) const;
 
+      /// Return the occluders that have been added to this state with addOccluder().
+      const Vector< SceneObject* >& getAddedOccluderObjects() const { return mAddedOccluderObjects; }
+
       /// Return a bit vector with one bit for each zone in the scene.  If the bit is set,
       /// the zone has includer culling volumes attached to it and thus is visible.
       const BitVector& getZoneVisibilityFlags() const { return mZoneVisibilityFlags; }
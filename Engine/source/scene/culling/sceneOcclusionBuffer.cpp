@@ -0,0 +1,253 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "scene/culling/sceneOcclusionBuffer.h"
+
+#include "platform/profiler.h"
+
+
+//-----------------------------------------------------------------------------
+
+SceneOcclusionBuffer::SceneOcclusionBuffer()
+   : mWorldToCamera( true ),
+     mNearDist( 1.0f ),
+     mScale( 1.0f, 1.0f ),
+     mOffset( 0.0f, 0.0f ),
+     mHasOccluders( false )
+{
+   VECTOR_SET_ASSOCIATION( mInvDepth );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneOcclusionBuffer::init( const Frustum& frustum )
+{
+   AssertFatal( !frustum.isOrtho(), "SceneOcclusionBuffer::init - Orthographic frustums are not supported!" );
+
+   mWorldToCamera = frustum.getTransform();
+   mWorldToCamera.inverse();
+
+   mNearDist = frustum.getNearDist();
+
+   const F32 width = frustum.getNearRight() - frustum.getNearLeft();
+   const F32 height = frustum.getNearTop() - frustum.getNearBottom();
+
+   mScale.set( F32( Width ) / width, - F32( Height ) / height );
+   mOffset.set( - frustum.getNearLeft() * mScale.x, - frustum.getNearTop() * mScale.y );
+
+   mInvDepth.setSize( Width * Height );
+   dMemset( mInvDepth.address(), 0, mInvDepth.memSize() );
+
+   mHasOccluders = false;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneOcclusionBuffer::addTriangle( const Point3F& a, const Point3F& b, const Point3F& c )
+{
+   Point3F points[ 3 ];
+   mWorldToCamera.mulP( a, &points[ 0 ] );
+   mWorldToCamera.mulP( b, &points[ 1 ] );
+   mWorldToCamera.mulP( c, &points[ 2 ] );
+
+   // Clip the triangle against the near plane.  This
+   // leaves at most one more point than we started with.
+
+   Point3F clipped[ 4 ];
+   U32 numClipped = 0;
+
+   for( U32 i = 0; i < 3; ++ i )
+   {
+      const Point3F& p0 = points[ i ];
+      const Point3F& p1 = points[ ( i + 1 ) % 3 ];
+
+      const bool inside0 = ( p0.y >= mNearDist );
+      const bool inside1 = ( p1.y >= mNearDist );
+
+      if( inside0 )
+         clipped[ numClipped ++ ] = p0;
+
+      if( inside0 != inside1 )
+      {
+         const F32 t = ( mNearDist - p0.y ) / ( p1.y - p0.y );
+         clipped[ numClipped ] = p0 + ( p1 - p0 ) * t;
+         clipped[ numClipped ++ ].y = mNearDist;
+      }
+   }
+
+   if( numClipped < 3 )
+      return;
+
+   _rasterize( clipped[ 0 ], clipped[ 1 ], clipped[ 2 ] );
+   if( numClipped == 4 )
+      _rasterize( clipped[ 0 ], clipped[ 2 ], clipped[ 3 ] );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneOcclusionBuffer::_rasterize( const Point3F& a, const Point3F& b, const Point3F& c )
+{
+   Point2F v[ 3 ] = { _project( a ), _project( b ), _project( c ) };
+   F32 w[ 3 ] = { 1.0f / a.y, 1.0f / b.y, 1.0f / c.y };
+
+   // Make the winding consistent so that the
+   // edge functions are positive on the inside.
+
+   const F32 area = ( v[ 1 ].x - v[ 0 ].x ) * ( v[ 2 ].y - v[ 0 ].y ) - ( v[ 1 ].y - v[ 0 ].y ) * ( v[ 2 ].x - v[ 0 ].x );
+   if( area == 0.0f )
+      return;
+   if( area < 0.0f )
+   {
+      const Point2F temp = v[ 1 ];
+      v[ 1 ] = v[ 2 ];
+      v[ 2 ] = temp;
+
+      const F32 tempW = w[ 1 ];
+      w[ 1 ] = w[ 2 ];
+      w[ 2 ] = tempW;
+   }
+
+   const S32 minX = getMax( S32( mFloor( getMin( v[ 0 ].x, getMin( v[ 1 ].x, v[ 2 ].x ) ) ) ), 0 );
+   const S32 maxX = getMin( S32( mCeil( getMax( v[ 0 ].x, getMax( v[ 1 ].x, v[ 2 ].x ) ) ) ), S32( Width ) ) - 1;
+   const S32 minY = getMax( S32( mFloor( getMin( v[ 0 ].y, getMin( v[ 1 ].y, v[ 2 ].y ) ) ) ), 0 );
+   const S32 maxY = getMin( S32( mCeil( getMax( v[ 0 ].y, getMax( v[ 1 ].y, v[ 2 ].y ) ) ) ), S32( Height ) ) - 1;
+
+   if( minX > maxX || minY > maxY )
+      return;
+
+   // Inverse depth is linear in screen space.  Write the lowest value
+   // the triangle reaches within each pixel, so the occluder never
+   // appears closer than it is, but never less than at the farthest
+   // vertex.
+
+   const F32 invArea = 1.0f / mFabs( area );
+   const F32 dwdx = ( ( w[ 1 ] - w[ 0 ] ) * ( v[ 2 ].y - v[ 0 ].y ) - ( w[ 2 ] - w[ 0 ] ) * ( v[ 1 ].y - v[ 0 ].y ) ) * invArea;
+   const F32 dwdy = ( ( w[ 2 ] - w[ 0 ] ) * ( v[ 1 ].x - v[ 0 ].x ) - ( w[ 1 ] - w[ 0 ] ) * ( v[ 2 ].x - v[ 0 ].x ) ) * invArea;
+   const F32 minW = getMin( w[ 0 ], getMin( w[ 1 ], w[ 2 ] ) );
+   const F32 bias = 0.5f * ( mFabs( dwdx ) + mFabs( dwdy ) );
+
+   F32 rowW = w[ 0 ] + dwdx * ( minX + 0.5f - v[ 0 ].x ) + dwdy * ( minY + 0.5f - v[ 0 ].y ) - bias;
+
+   // Set up the edge functions at the center of the first pixel.
+
+   F32 stepX[ 3 ], stepY[ 3 ], rowStart[ 3 ];
+   for( U32 i = 0; i < 3; ++ i )
+   {
+      const Point2F& e0 = v[ i ];
+      const Point2F& e1 = v[ ( i + 1 ) % 3 ];
+
+      stepX[ i ] = -( e1.y - e0.y );
+      stepY[ i ] = e1.x - e0.x;
+
+      rowStart[ i ] = stepY[ i ] * ( minY + 0.5f - e0.y ) + stepX[ i ] * ( minX + 0.5f - e0.x );
+   }
+
+   for( S32 y = minY; y <= maxY; ++ y )
+   {
+      F32 e0 = rowStart[ 0 ];
+      F32 e1 = rowStart[ 1 ];
+      F32 e2 = rowStart[ 2 ];
+      F32 pixelW = rowW;
+
+      F32* row = &mInvDepth[ y * Width ];
+      for( S32 x = minX; x <= maxX; ++ x )
+      {
+         if( e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f )
+         {
+            const F32 value = getMax( pixelW, minW );
+            if( value > row[ x ] )
+            {
+               row[ x ] = value;
+               mHasOccluders = true;
+            }
+         }
+
+         e0 += stepX[ 0 ];
+         e1 += stepX[ 1 ];
+         e2 += stepX[ 2 ];
+         pixelW += dwdx;
+      }
+
+      rowStart[ 0 ] += stepY[ 0 ];
+      rowStart[ 1 ] += stepY[ 1 ];
+      rowStart[ 2 ] += stepY[ 2 ];
+      rowW += dwdy;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneOcclusionBuffer::isOccluded( const Box3F& box ) const
+{
+   if( !mHasOccluders )
+      return false;
+
+   // Find the screen rectangle and the nearest depth of the box.  Boxes
+   // crossing the near plane are never occluded.
+
+   Point2F minPoint( F32_MAX, F32_MAX );
+   Point2F maxPoint( -F32_MAX, -F32_MAX );
+   F32 minDepth = F32_MAX;
+
+   for( U32 i = 0; i < 8; ++ i )
+   {
+      Point3F point;
+      mWorldToCamera.mulP( box.computeVertex( i ), &point );
+
+      if( point.y < mNearDist )
+         return false;
+
+      minDepth = getMin( minDepth, point.y );
+
+      const Point2F screen = _project( point );
+      minPoint.setMin( screen );
+      maxPoint.setMax( screen );
+   }
+
+   S32 minX = S32( mFloor( minPoint.x ) );
+   S32 maxX = S32( mCeil( maxPoint.x ) ) - 1;
+   S32 minY = S32( mFloor( minPoint.y ) );
+   S32 maxY = S32( mCeil( maxPoint.y ) ) - 1;
+
+   // Leave boxes outside of the screen to frustum culling.
+
+   if( maxX < 0 || minX >= Width || maxY < 0 || minY >= Height )
+      return false;
+
+   minX = getMax( minX - 1, 0 );
+   maxX = getMin( maxX + 1, S32( Width ) - 1 );
+   minY = getMax( minY - 1, 0 );
+   maxY = getMin( maxY + 1, S32( Height ) - 1 );
+
+   const F32 boxW = 1.0f / minDepth;
+
+   for( S32 y = minY; y <= maxY; ++ y )
+   {
+      const F32* row = &mInvDepth[ y * Width ];
+      for( S32 x = minX; x <= maxX; ++ x )
+         if( row[ x ] <= boxW )
+            return false;
+   }
+
+   return true;
+}
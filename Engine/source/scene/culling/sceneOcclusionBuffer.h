@@ -0,0 +1,113 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENEOCCLUSIONBUFFER_H_
+#define _SCENEOCCLUSIONBUFFER_H_
+
+#ifndef _MATHUTIL_FRUSTUM_H_
+#include "math/util/frustum.h"
+#endif
+
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+
+/// A low resolution depth buffer that occluder geometry is rasterized into
+/// on the CPU so that object bounds can be tested against it.
+///
+/// The buffer stores inverse camera space depth, which can be interpolated
+/// linearly across triangles in screen space.  Each pixel gets the farthest
+/// depth the triangle has within it so occluders never appear closer than
+/// they are.  A box is only reported as occluded if every pixel its projection
+/// touches, plus a border of one pixel, holds a depth in front of the nearest
+/// point of the box.  The border makes up for triangles only covering part
+/// of the pixels along their edges.
+///
+/// @note Only perspective frustums are supported.
+class SceneOcclusionBuffer
+{
+   public:
+
+      enum
+      {
+         /// Resolution of the depth buffer.
+         Width = 128,
+         Height = 64,
+      };
+
+   protected:
+
+      /// Inverse depth of each pixel or 0 if no occluder covers it.
+      Vector< F32 > mInvDepth;
+
+      /// Transform from world space into the camera space of the frustum.
+      MatrixF mWorldToCamera;
+
+      F32 mNearDist;
+
+      /// Scale and offset to go from the near plane to pixel coordinates.
+      Point2F mScale;
+      Point2F mOffset;
+
+      /// Whether any pixels have been written since init().
+      bool mHasOccluders;
+
+      /// Project the camera space point @a point which must be
+      /// in front of the near plane into pixel coordinates.
+      Point2F _project( const Point3F& point ) const
+      {
+         const F32 invDepth = mNearDist / point.y;
+         return Point2F( point.x * invDepth * mScale.x + mOffset.x,
+                         point.z * invDepth * mScale.y + mOffset.y );
+      }
+
+      /// Rasterize the camera space triangle @a a, @a b, @a c
+      /// which lies entirely in front of the near plane.
+      void _rasterize( const Point3F& a, const Point3F& b, const Point3F& c );
+
+   public:
+
+      SceneOcclusionBuffer();
+
+      /// Clear the buffer and set it up for rendering from @a frustum.
+      void init( const Frustum& frustum );
+
+      /// Return true if nothing has been rasterized into the buffer yet.
+      bool isEmpty() const { return !mHasOccluders; }
+
+      /// Rasterize the world space triangle @a a, @a b, @a c.
+      void addTriangle( const Point3F& a, const Point3F& b, const Point3F& c );
+
+      /// Rasterize the world space quad @a a, @a b, @a c, @a d.
+      void addQuad( const Point3F& a, const Point3F& b, const Point3F& c, const Point3F& d )
+      {
+         addTriangle( a, b, c );
+         addTriangle( a, c, d );
+      }
+
+      /// Return true if the world space box @a box is entirely
+      /// hidden behind the occluders in the buffer.
+      bool isOccluded( const Box3F& box ) const;
+};
+
+#endif // !_SCENEOCCLUSIONBUFFER_H_
@@ -0,0 +1,64 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "scene/culling/sceneOcclusionBuffer.h"
+
+TEST(SceneOcclusionBuffer, Occlusion)
+{
+   // Camera at the origin looking down +Y.
+   Frustum frustum;
+   frustum.set( false, M_HALFPI_F, 2.0f, 0.1f, 1000.0f );
+
+   SceneOcclusionBuffer buffer;
+   buffer.init( frustum );
+   EXPECT_TRUE( buffer.isEmpty() );
+   EXPECT_FALSE( buffer.isOccluded( Box3F( Point3F( -1, 19, -1 ), Point3F( 1, 21, 1 ) ) ) )
+      << "Nothing should be occluded by an empty buffer";
+
+   // A wall 10 units in front of the camera.
+   buffer.addQuad( Point3F( -5, 10, -5 ), Point3F( 5, 10, -5 ), Point3F( 5, 10, 5 ), Point3F( -5, 10, 5 ) );
+   EXPECT_FALSE( buffer.isEmpty() );
+
+   EXPECT_TRUE( buffer.isOccluded( Box3F( Point3F( -1, 19, -1 ), Point3F( 1, 21, 1 ) ) ) )
+      << "Box behind the wall should be occluded";
+   EXPECT_FALSE( buffer.isOccluded( Box3F( Point3F( -1, 4, -1 ), Point3F( 1, 6, 1 ) ) ) )
+      << "Box in front of the wall should be visible";
+   EXPECT_FALSE( buffer.isOccluded( Box3F( Point3F( -1, 9, -1 ), Point3F( 1, 11, 1 ) ) ) )
+      << "Box intersecting the wall should be visible";
+   EXPECT_FALSE( buffer.isOccluded( Box3F( Point3F( 5, 19, -1 ), Point3F( 15, 21, 1 ) ) ) )
+      << "Box reaching past the edge of the wall should be visible";
+   EXPECT_FALSE( buffer.isOccluded( Box3F( Point3F( -1, -21, -1 ), Point3F( 1, -19, 1 ) ) ) )
+      << "Box behind the camera should not be occluded";
+
+   // A floor crossing the near plane gets clipped rather than dropped.
+   buffer.init( frustum );
+   buffer.addQuad( Point3F( -100, -10, -1 ), Point3F( 100, -10, -1 ), Point3F( 100, 100, -1 ), Point3F( -100, 100, -1 ) );
+   EXPECT_FALSE( buffer.isEmpty() );
+   EXPECT_TRUE( buffer.isOccluded( Box3F( Point3F( -1, 50, -15 ), Point3F( 1, 52, -10 ) ) ) )
+      << "Box below the floor should be occluded";
+   EXPECT_FALSE( buffer.isOccluded( Box3F( Point3F( -1, 50, -15 ), Point3F( 1, 52, 0 ) ) ) )
+      << "Box sticking out of the floor should be visible";
+};
+
+#endif
@@ -82,11 +82,15 @@ static S32 QSORT_CALLBACK compareReflectors( const void *a, const void *b )
 
 U32 ReflectionManager::smFrameReflectionMS = 10;
 F32 ReflectionManager::smRefractTexScale = 0.5f;
+bool ReflectionManager::smReduceOverBudget = true;
+bool ReflectionManager::smCubeFacePerUpdate = true;
 
 ReflectionManager::ReflectionManager() 
  : mReflectFormat( GFXFormatR8G8B8A8_SRGB ),
    mUpdateRefract( true ),
-   mLastUpdateMs( 0 )
+   mLastUpdateMs( 0 ),
+   mAvgUpdateMs( 0.0f ),
+   mOverBudget( false )
 {
    mTimer = PlatformTimer::create();
 
@@ -99,6 +103,11 @@ void ReflectionManager::initConsole()
       "@ingroup Rendering");
    Con::addVariable( "$pref::Reflect::frameLimitMS", TypeS32, &ReflectionManager::smFrameReflectionMS, "ReflectionManager tries not to spend more than this amount of time updating reflections per frame.\n"
       "@ingroup Rendering");
+   Con::addVariable( "$pref::Reflect::reduceOverBudget", TypeBool, &ReflectionManager::smReduceOverBudget, "If true planar reflections render at half resolution while reflection updates run over $pref::Reflect::frameLimitMS.\n"
+      "@ingroup Rendering");
+   Con::addVariable( "$pref::Reflect::cubeFacePerUpdate", TypeBool, &ReflectionManager::smCubeFacePerUpdate, "If true cubemap reflections are scheduled one face at a time instead of rendering all six faces at once.  "
+      "Takes effect when a reflector is registered.\n"
+      "@ingroup Rendering");
 }
 
 ReflectionManager::~ReflectionManager()
@@ -231,6 +240,16 @@ void ReflectionManager::update(  F32 timeSlice,
          break;
    }
 
+   // Track the update cost so planar reflections can drop
+   // their resolution while we keep running over budget.  The
+   // lower threshold for recovering keeps us from flipping
+   // between sizes every other frame.
+   mAvgUpdateMs = mLerp( mAvgUpdateMs, (F32)mTimer->getElapsedMs(), 0.1f );
+   if ( mAvgUpdateMs > smFrameReflectionMS )
+      mOverBudget = true;
+   else if ( mAvgUpdateMs < smFrameReflectionMS * 0.25f )
+      mOverBudget = false;
+
    // Set metric/debug related script variables...
 
    U32 numVisible = 0;
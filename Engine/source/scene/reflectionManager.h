@@ -107,6 +107,14 @@ public:
 
    const U32& getLastUpdateMs() const { return mLastUpdateMs; }
 
+   /// Returns true if recent updates have been running over the
+   /// frame budget and reflections should render at reduced size.
+   bool isOverBudget() const { return smReduceOverBudget && mOverBudget; }
+
+   /// If true cube reflectors are scheduled one face at a time
+   /// rather than rendering all six faces in a single update.
+   static bool smCubeFacePerUpdate;
+
 protected:
 
    bool _handleDeviceEvent( GFXDevice::GFXDeviceEventType evt );
@@ -121,6 +129,10 @@ protected:
    /// both x and y by this float.
    static F32 smRefractTexScale;
 
+   /// If true planar reflections drop to half resolution while
+   /// updates are running over smFrameReflectionMS.
+   static bool smReduceOverBudget;
+
    /// A timer used for tracking update time.
    PlatformTimer *mTimer;
 
@@ -141,6 +153,12 @@ protected:
 
    /// Platform time in milliseconds of the last update.
    U32 mLastUpdateMs;
+
+   /// A running average of the time spent per update.
+   F32 mAvgUpdateMs;
+
+   /// @see isOverBudget
+   bool mOverBudget;
    
 public:
    // For ManagedSingleton.
@@ -269,8 +269,15 @@ F32 ReflectorBase::calcScore( const ReflectParams &params )
 //-------------------------------------------------------------------------
 
 CubeReflector::CubeReflector()
- : mLastTexSize( 0 )
+ : mLastTexSize( 0 ),
+   mFacesRegistered( false ),
+   mOldVisibleDist( 0.0f )
 {
+   for ( U32 i = 0; i < 6; i++ )
+   {
+      mFaces[i].faceIdx = i;
+      mFaces[i].cube = this;
+   }
 }
 
 void CubeReflector::registerReflector( SceneObject *object, 
@@ -282,7 +289,24 @@ void CubeReflector::registerReflector( SceneObject *object,
    mEnabled = true;
    mObject = object;
    mDesc = desc;
-   REFLECTMGR->registerReflector( this );
+
+   // Let the manager schedule the faces one at a time so that
+   // the faces we're looking at update first and a cube never
+   // costs more than a single scene render per step.
+   mFacesRegistered = ReflectionManager::smCubeFacePerUpdate;
+   if ( mFacesRegistered )
+   {
+      for ( U32 i = 0; i < 6; i++ )
+      {
+         mFaces[i].mEnabled = true;
+         mFaces[i].mObject = object;
+         mFaces[i].mDesc = desc;
+         mFaces[i].lastUpdateMs = 0;
+         REFLECTMGR->registerReflector( &mFaces[i] );
+      }
+   }
+   else
+      REFLECTMGR->registerReflector( this );
 }
 
 void CubeReflector::unregisterReflector()
@@ -290,15 +314,55 @@ void CubeReflector::unregisterReflector()
    if ( !mEnabled )
       return;
 
-   REFLECTMGR->unregisterReflector( this );
+   if ( mFacesRegistered )
+   {
+      for ( U32 i = 0; i < 6; i++ )
+      {
+         REFLECTMGR->unregisterReflector( &mFaces[i] );
+         mFaces[i].mEnabled = false;
+      }
+   }
+   else
+      REFLECTMGR->unregisterReflector( this );
 
    mEnabled = false;
+   mFacesRegistered = false;
 }
 
 void CubeReflector::updateReflection( const ReflectParams &params )
 {
    GFXDEBUGEVENT_SCOPE( CubeReflector_UpdateReflection, ColorI::WHITE );
 
+   _beginUpdate( params );
+
+   for ( U32 i = 0; i < 6; i++ )
+      updateFace( params, i );
+
+   _endUpdate();
+}
+
+void CubeReflector::_updateScheduledFace( const ReflectParams &params, U32 faceidx )
+{
+   GFXDEBUGEVENT_SCOPE( CubeReflector_UpdateScheduledFace, ColorI::WHITE );
+
+   // A new cubemap has nothing in it, so fill all
+   // the faces before we go back to one at a time.
+   if ( _beginUpdate( params ) )
+   {
+      for ( U32 i = 0; i < 6; i++ )
+      {
+         updateFace( params, i );
+         mFaces[i].lastUpdateMs = params.startOfUpdateMs;
+      }
+   }
+   else
+      updateFace( params, faceidx );
+
+   _endUpdate();
+}
+
+bool CubeReflector::_beginUpdate( const ReflectParams &params )
+{
    mIsRendering = true;
 
    // Setup textures and targets...
@@ -314,9 +378,8 @@ void CubeReflector::updateReflection( const ReflectParams &params )
 
    const GFXFormat reflectFormat = REFLECTMGR->getReflectFormat();
 
-   if (  texResize || 
-         cubemap.isNull() ||
-         cubemap->getFormat() != reflectFormat )
+   const bool recreate = texResize || cubemap.isNull() || cubemap->getFormat() != reflectFormat;
+   if ( recreate )
    {
       cubemap = GFX->createCubemap();
       cubemap->initDynamic( texDim, reflectFormat );
@@ -331,20 +394,21 @@ void CubeReflector::updateReflection( const ReflectParams &params )
    renderTarget->attachTexture( GFXTextureTarget::DepthStencil, depthBuff );
 
   
-   F32 oldVisibleDist = gClientSceneGraph->getVisibleDistance();
+   mOldVisibleDist = gClientSceneGraph->getVisibleDistance();
    gClientSceneGraph->setVisibleDistance( mDesc->farDist );   
 
+   mLastTexSize = texDim;
 
-   for ( U32 i = 0; i < 6; i++ )
-      updateFace( params, i );
-   
+   return recreate;
+}
 
+void CubeReflector::_endUpdate()
+{
    GFX->popActiveRenderTarget();
 
-   gClientSceneGraph->setVisibleDistance(oldVisibleDist);
+   gClientSceneGraph->setVisibleDistance( mOldVisibleDist );
 
    mIsRendering = false;
-   mLastTexSize = texDim;
 }
 
 void CubeReflector::updateFace( const ReflectParams &params, U32 faceidx )
@@ -434,7 +498,14 @@ F32 CubeReflector::calcFaceScore( const ReflectParams &params, U32 faceidx )
 {
    if ( Parent::calcScore( params ) <= 0.0f )
       return score;
-   
+
+   score *= _getFaceViewFactor( params, faceidx );
+
+   return score;
+}
+
+F32 CubeReflector::_getFaceViewFactor( const ReflectParams &params, U32 faceidx ) const
+{
    VectorF vLookatPt(0.0f, 0.0f, 0.0f);
 
    switch( faceidx )
@@ -464,17 +535,27 @@ F32 CubeReflector::calcFaceScore( const ReflectParams &params, U32 faceidx )
 
    F32 dot = mDot( cameraDir, -vLookatPt );
 
-   dot = getMax( ( dot + 1.0f ) / 2.0f, 0.1f );
-
-   score *= dot;
-
-   return score;
+   return getMax( ( dot + 1.0f ) / 2.0f, 0.1f );
 }
 
 F32 CubeReflector::CubeFaceReflector::calcScore( const ReflectParams &params )
 {
-   score = cube->calcFaceScore( params, faceIdx );
+   // The cube owns the occlusion query, so let it decide
+   // if it is visible at all.
+   const F32 cubeScore = cube->calcScore( params );
    mOccluded = cube->isOccluded();
+
+   if ( cubeScore <= 0.0f || cubeScore >= 1000.0f )
+   {
+      score = cubeScore;
+      return score;
+   }
+
+   // Otherwise score by the time since this face
+   // was rendered and how visible it is.
+   if ( Parent::calcScore( params ) > 0.0f )
+      score *= cube->_getFaceViewFactor( params, faceIdx );
+
    return score;
 }
 
@@ -526,6 +607,12 @@ void PlaneReflector::updateReflection( const ReflectParams &params )
    mIsRendering = true;
 
    S32 texDim = mDesc->texSize;
+
+   // Drop to half resolution while the manager
+   // is running over its time budget.
+   if ( REFLECTMGR->isOverBudget() )
+      texDim /= 2;
+
    texDim = getMax( texDim, 32 );
 
    // Protect against the reflection texture being bigger
@@ -160,6 +160,25 @@ public:
 
 protected:
 
+   /// Sets up the cubemap and render target for rendering faces
+   /// and returns true if the cubemap was recreated.
+   bool _beginUpdate( const ReflectParams &params );
+
+   void _endUpdate();
+
+   /// Renders a single face scheduled by the ReflectionManager.
+   void _updateScheduledFace( const ReflectParams &params, U32 faceidx );
+
+   /// Returns the score scale for a face based on how
+   /// much the camera is looking towards it.
+   F32 _getFaceViewFactor( const ReflectParams &params, U32 faceidx ) const;
+
+   /// True if the faces are registered with the
+   /// ReflectionManager instead of the cube.
+   bool mFacesRegistered;
+
+   F32 mOldVisibleDist;
+
    GFXTexHandle depthBuff;
    GFXTextureTargetRef renderTarget;   
    GFXCubemapHandle  cubemap;
@@ -174,7 +193,7 @@ protected:
       U32 faceIdx;
       CubeReflector *cube;
 
-      virtual void updateReflection( const ReflectParams &params ) { cube->updateFace( params, faceIdx ); } 
+      virtual void updateReflection( const ReflectParams &params ) { cube->_updateScheduledFace( params, faceIdx ); } 
       virtual F32 calcScore( const ReflectParams &params );
    };
 
@@ -25,10 +25,19 @@
 
 #include "collision/extrudedPolyList.h"
 #include "collision/earlyOutPolyList.h"
+#include "collision/concretePolyList.h"
+#include "collision/staticCollisionTree.h"
+#include "collision/collisionStats.h"
 #include "scene/sceneObject.h"
 #include "platform/profiler.h"
+#include "platform/platformIntrinsics.h"
 #include "console/engineAPI.h"
 #include "math/util/frustum.h"
+#include "core/util/tSmallVector.h"
+
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+#include <xmmintrin.h>
+#endif
 
 
 // [rene, 02-Mar-11]
@@ -45,6 +54,8 @@ const U32 SceneContainer::csmNumBins = 16;
 const F32 SceneContainer::csmBinSize = 64;
 const F32 SceneContainer::csmTotalBinSize = SceneContainer::csmBinSize * SceneContainer::csmNumBins;
 const U32 SceneContainer::csmRefPoolBlockSize = 4096;
+const U32 SceneContainer::csmRayPacketSize = 32;
+const U32 SceneContainer::csmMaxLinearWaterAndZones = 32;
 
 // Statics used by buildPolyList methods
 static AbstractPolyList* sPolyList;
@@ -52,6 +63,291 @@ static SphereF sBoundingSphere;
 static Box3F sBoundingBox;
 
 
+//=============================================================================
+//    Octree query helpers.
+//=============================================================================
+
+namespace {
+
+/// Visit octree nodes overlapping a box.
+struct OctreeBoxTest
+{
+   const Box3F& mBox;
+
+   OctreeBoxTest( const Box3F& box ) : mBox( box ) {}
+   bool operator()( const Box3F& nodeBox ) const { return nodeBox.isOverlapped( mBox ); }
+};
+
+/// Visit octree nodes intersecting a frustum.
+struct OctreeFrustumTest
+{
+   const Frustum& mFrustum;
+
+   OctreeFrustumTest( const Frustum& frustum ) : mFrustum( frustum ) {}
+   bool operator()( const Box3F& nodeBox ) const { return !mFrustum.isCulled( nodeBox ); }
+};
+
+/// Pass objects matching a box (and optionally a frustum) on to a FindCallback.
+struct FindObjectsVisitor
+{
+   const Box3F& mBox;
+   U32 mMask;
+   SceneContainer::FindCallback mCallback;
+   void* mKey;
+   const Frustum* mFrustum;
+
+   FindObjectsVisitor( const Box3F& box, U32 mask, SceneContainer::FindCallback callback, void* key, const Frustum* frustum = NULL )
+      : mBox( box ), mMask( mask ), mCallback( callback ), mKey( key ), mFrustum( frustum ) {}
+
+   void operator()( SceneObject* object ) const
+   {
+      if ( ( object->getTypeMask() & mMask ) == 0 || !object->isCollisionEnabled() )
+         return;
+
+      const Box3F& worldBox = object->getWorldBox();
+      if ( !worldBox.isOverlapped( mBox ) )
+         return;
+
+      if ( mFrustum && mFrustum->isCulled( worldBox ) )
+         return;
+
+      ( *mCallback )( object, mKey );
+   }
+};
+
+/// Report water and physical zones overlapping a box.  Unlike
+/// FindObjectsVisitor this includes objects with collision disabled,
+/// matching what a scan of the special object vector finds.
+struct FindWaterAndZonesVisitor
+{
+   const Box3F& mBox;
+   U32 mMask;
+   SceneContainer::FindCallback mCallback;
+   void* mKey;
+
+   FindWaterAndZonesVisitor( const Box3F& box, U32 mask, SceneContainer::FindCallback callback, void* key )
+      : mBox( box ), mMask( mask ), mCallback( callback ), mKey( key ) {}
+
+   void operator()( SceneObject* object ) const
+   {
+      if ( ( object->getTypeMask() & mMask ) != 0 &&
+           ( object->isGlobalBounds() || object->getWorldBox().isOverlapped( mBox ) ) )
+         ( *mCallback )( object, mKey );
+   }
+};
+
+/// Collect objects matching a box into a vector.
+struct FindObjectListVisitor
+{
+   const Box3F& mBox;
+   U32 mMask;
+   Vector< SceneObject* >* mOutFound;
+
+   FindObjectListVisitor( const Box3F& box, U32 mask, Vector< SceneObject* >* outFound )
+      : mBox( box ), mMask( mask ), mOutFound( outFound ) {}
+
+   void operator()( SceneObject* object ) const
+   {
+      if ( ( object->getTypeMask() & mMask ) != 0 &&
+           object->isCollisionEnabled() &&
+           object->getWorldBox().isOverlapped( mBox ) )
+         mOutFound->push_back( object );
+   }
+};
+
+/// Rays of a castRayBatch() packet in SoA layout so that they can be
+/// culled against an object's world box four at a time.
+struct RayPacket
+{
+   enum { MaxRays = 32 };
+
+   F32 startX[ MaxRays ];
+   F32 startY[ MaxRays ];
+   F32 startZ[ MaxRays ];
+   F32 invDirX[ MaxRays ];
+   F32 invDirY[ MaxRays ];
+   F32 invDirZ[ MaxRays ];
+
+   /// Parametric distance up to which a ray still needs testing.  Shrinks
+   /// as closer hits are found.
+   F32 maxT[ MaxRays ];
+
+   /// Index of the ray in the batch.
+   U32 index[ MaxRays ];
+
+   U32 count;
+
+   static F32 _safeInverse( F32 d )
+   {
+      // Keep the slab test free of 0*inf NaNs for axis-aligned rays.
+      if ( mFabs( d ) < 1.0e-12f )
+         d = ( d < 0.0f ) ? -1.0e-12f : 1.0e-12f;
+      return 1.0f / d;
+   }
+
+   void clear() { count = 0; }
+
+   void add( U32 rayIndex, const Point3F& start, const Point3F& end )
+   {
+      AssertFatal( count < MaxRays, "RayPacket::add - Packet is full" );
+
+      startX[ count ] = start.x;
+      startY[ count ] = start.y;
+      startZ[ count ] = start.z;
+      invDirX[ count ] = _safeInverse( end.x - start.x );
+      invDirY[ count ] = _safeInverse( end.y - start.y );
+      invDirZ[ count ] = _safeInverse( end.z - start.z );
+      maxT[ count ] = 1.0f;
+      index[ count ] = rayIndex;
+      count ++;
+   }
+
+   /// Pad the packet to a multiple of four with rays that never hit anything.
+   void pad()
+   {
+      for ( U32 i = count; i < ( ( count + 3 ) & ~3 ); ++ i )
+      {
+         startX[ i ] = startY[ i ] = startZ[ i ] = 0.0f;
+         invDirX[ i ] = invDirY[ i ] = invDirZ[ i ] = 1.0f;
+         maxT[ i ] = -1.0f;
+         index[ i ] = U32( -1 );
+      }
+   }
+
+   /// Return a bitmask of the rays in the packet that intersect @a box.
+   U32 intersect( const Box3F& box ) const
+   {
+      U32 result = 0;
+
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+
+      const __m128 minX = _mm_set1_ps( box.minExtents.x );
+      const __m128 minY = _mm_set1_ps( box.minExtents.y );
+      const __m128 minZ = _mm_set1_ps( box.minExtents.z );
+      const __m128 maxX = _mm_set1_ps( box.maxExtents.x );
+      const __m128 maxY = _mm_set1_ps( box.maxExtents.y );
+      const __m128 maxZ = _mm_set1_ps( box.maxExtents.z );
+      const __m128 zero = _mm_setzero_ps();
+
+      for ( U32 i = 0; i < count; i += 4 )
+      {
+         __m128 sX = _mm_loadu_ps( &startX[ i ] );
+         __m128 sY = _mm_loadu_ps( &startY[ i ] );
+         __m128 sZ = _mm_loadu_ps( &startZ[ i ] );
+         __m128 iX = _mm_loadu_ps( &invDirX[ i ] );
+         __m128 iY = _mm_loadu_ps( &invDirY[ i ] );
+         __m128 iZ = _mm_loadu_ps( &invDirZ[ i ] );
+
+         __m128 t1 = _mm_mul_ps( _mm_sub_ps( minX, sX ), iX );
+         __m128 t2 = _mm_mul_ps( _mm_sub_ps( maxX, sX ), iX );
+         __m128 tMin = _mm_min_ps( t1, t2 );
+         __m128 tMax = _mm_max_ps( t1, t2 );
+
+         t1 = _mm_mul_ps( _mm_sub_ps( minY, sY ), iY );
+         t2 = _mm_mul_ps( _mm_sub_ps( maxY, sY ), iY );
+         tMin = _mm_max_ps( tMin, _mm_min_ps( t1, t2 ) );
+         tMax = _mm_min_ps( tMax, _mm_max_ps( t1, t2 ) );
+
+         t1 = _mm_mul_ps( _mm_sub_ps( minZ, sZ ), iZ );
+         t2 = _mm_mul_ps( _mm_sub_ps( maxZ, sZ ), iZ );
+         tMin = _mm_max_ps( tMin, _mm_min_ps( t1, t2 ) );
+         tMax = _mm_min_ps( tMax, _mm_max_ps( t1, t2 ) );
+
+         tMin = _mm_max_ps( tMin, zero );
+         tMax = _mm_min_ps( tMax, _mm_loadu_ps( &maxT[ i ] ) );
+
+         result |= U32( _mm_movemask_ps( _mm_cmple_ps( tMin, tMax ) ) ) << i;
+      }
+
+#else
+
+      for ( U32 i = 0; i < count; ++ i )
+      {
+         F32 t1 = ( box.minExtents.x - startX[ i ] ) * invDirX[ i ];
+         F32 t2 = ( box.maxExtents.x - startX[ i ] ) * invDirX[ i ];
+         F32 tMin = getMin( t1, t2 );
+         F32 tMax = getMax( t1, t2 );
+
+         t1 = ( box.minExtents.y - startY[ i ] ) * invDirY[ i ];
+         t2 = ( box.maxExtents.y - startY[ i ] ) * invDirY[ i ];
+         tMin = getMax( tMin, getMin( t1, t2 ) );
+         tMax = getMin( tMax, getMax( t1, t2 ) );
+
+         t1 = ( box.minExtents.z - startZ[ i ] ) * invDirZ[ i ];
+         t2 = ( box.maxExtents.z - startZ[ i ] ) * invDirZ[ i ];
+         tMin = getMax( tMin, getMin( t1, t2 ) );
+         tMax = getMin( tMax, getMax( t1, t2 ) );
+
+         if ( getMax( tMin, 0.0f ) <= getMin( tMax, maxT[ i ] ) )
+            result |= ( 1 << i );
+      }
+
+#endif
+
+      // Mask out padding.
+      if ( count < 32 )
+         result &= ( 1 << count ) - 1;
+
+      return result;
+   }
+};
+
+struct RaySortEntry
+{
+   U32 index;
+   S32 binX;
+   S32 binY;
+};
+
+static S32 QSORT_CALLBACK cmpRaySortEntry( const void* a, const void* b )
+{
+   const RaySortEntry* e1 = reinterpret_cast< const RaySortEntry* >( a );
+   const RaySortEntry* e2 = reinterpret_cast< const RaySortEntry* >( b );
+
+   if ( e1->binX != e2->binX )
+      return ( e1->binX < e2->binX ) ? -1 : 1;
+   if ( e1->binY != e2->binY )
+      return ( e1->binY < e2->binY ) ? -1 : 1;
+   return S32( e1->index ) - S32( e2->index );
+}
+
+} // namespace {}
+
+/// Cast a ray through the octree.  Nodes are culled against the part of
+/// the ray up to the closest hit found so far.
+struct SceneContainer::OctreeRayVisitor
+{
+   SceneContainer* mContainer;
+   U32 mType;
+   const Point3F& mStart;
+   const Point3F& mEnd;
+   U32 mMask;
+   RayInfo* mInfo;
+   CastRayCallback mCallback;
+   F32& mCurrentT;
+
+   OctreeRayVisitor( SceneContainer* container, U32 type, const Point3F& start, const Point3F& end,
+                     U32 mask, RayInfo* info, CastRayCallback callback, F32& currentT )
+      : mContainer( container ), mType( type ), mStart( start ), mEnd( end ), mMask( mask ),
+        mInfo( info ), mCallback( callback ), mCurrentT( currentT ) {}
+
+   bool operator()( const Box3F& nodeBox ) const
+   {
+      F32 t;
+      Point3F normal;
+      return nodeBox.collideLine( mStart, mEnd, &t, &normal ) && t <= mCurrentT;
+   }
+
+   void operator()( SceneObject* ptr ) const
+   {
+      if ( ( ptr->getTypeMask() & mMask ) != 0 &&
+           ptr->isCollisionEnabled() &&
+           ptr->getWorldBox().collideLine( mStart, mEnd ) )
+         mContainer->_castRayObject( mType, ptr, mStart, mEnd, mInfo, mCallback, mCurrentT );
+   }
+};
+
+
 //=============================================================================
 //    SceneContainer::Link.
 //=============================================================================
@@ -82,6 +378,62 @@ void SceneContainer::Link::linkAfter(SceneContainer::Link* ptr)
    prev->next = this;
 }
 
+//=============================================================================
+//    SceneContainer::QueryContext.
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+
+SceneContainer::QueryContext::QueryContext( SceneContainer* container )
+   : mContainer( container )
+{
+   while ( true )
+   {
+      const U32 usedSlots = dAtomicRead( container->mUsedQuerySlots );
+
+      if ( usedSlots != BIT( MaxQuerySlots ) - 1 )
+      {
+         U32 slot = 0;
+         while ( usedSlots & BIT( slot ) )
+            slot ++;
+
+         if ( dCompareAndSwap( container->mUsedQuerySlots, usedSlots, usedSlots | BIT( slot ) ) )
+         {
+            mSlot = slot;
+            break;
+         }
+      }
+      else
+         Platform::sleep( 0 );
+   }
+
+   // The slot is ours so nobody else touches its key.
+   mSeqKey = ++ container->mQuerySeqKeys[ mSlot ];
+}
+
+//-----------------------------------------------------------------------------
+
+SceneContainer::QueryContext::~QueryContext()
+{
+   while ( true )
+   {
+      const U32 usedSlots = dAtomicRead( mContainer->mUsedQuerySlots );
+      if ( dCompareAndSwap( mContainer->mUsedQuerySlots, usedSlots, usedSlots & ~BIT( mSlot ) ) )
+         break;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+inline bool SceneContainer::QueryContext::visit( SceneObject* object )
+{
+   if ( object->getContainerSeqKey( mSlot ) == mSeqKey )
+      return false;
+
+   object->setContainerSeqKey( mSlot, mSeqKey );
+   return true;
+}
+
 //=============================================================================
 //    SceneContainer.
 //=============================================================================
@@ -89,9 +441,15 @@ void SceneContainer::Link::linkAfter(SceneContainer::Link* ptr)
 //-----------------------------------------------------------------------------
 
 SceneContainer::SceneContainer()
+   : mOctree( csmBinSize / 4.0f, csmTotalBinSize )
 {
-   mSearchInProgress = false;
-   mCurrSeqKey = 0;
+   mUsedQuerySlots = 0;
+   dMemset( mQuerySeqKeys, 0, sizeof( mQuerySeqKeys ) );
+   mIndexType = GridIndex;
+   mChangeLogActive = false;
+   mChangeLogId = 0;
+   mStaticCollision = NULL;
+   mNumStaticCollisionObjects = 0;
 
    mEnd.next = mEnd.prev = &mStart;
    mStart.next = mStart.prev = &mEnd;
@@ -117,6 +475,10 @@ SceneContainer::SceneContainer()
    VECTOR_SET_ASSOCIATION( mSearchList );
    VECTOR_SET_ASSOCIATION( mWaterAndZones );
    VECTOR_SET_ASSOCIATION( mTerrains );
+   VECTOR_SET_ASSOCIATION( mStaticCollisionObjects );
+   VECTOR_SET_ASSOCIATION( mStaticCollisionMaterials );
+   VECTOR_SET_ASSOCIATION( mChangeLog );
+   VECTOR_SET_ASSOCIATION( mOctreeReordered );
 
    mFreeRefPool = NULL;
    addRefPoolBlock();
@@ -128,6 +490,8 @@ SceneContainer::SceneContainer()
 
 SceneContainer::~SceneContainer()
 {
+   SAFE_DELETE( mStaticCollision );
+
    delete[] mBinArray;
 
    for (U32 i = 0; i < mRefPoolBlocks.size(); i++)
@@ -163,6 +527,7 @@ bool SceneContainer::addObject(SceneObject* obj)
    obj->linkAfter(&mStart);
 
    insertIntoBins(obj);
+   mObjectBounds.insert(obj);
 
    // Also insert water and physical zone types into the special vector.
    if ( obj->getTypeMask() & ( WaterObjectType | PhysicalZoneObjectType ) )
@@ -170,6 +535,8 @@ bool SceneContainer::addObject(SceneObject* obj)
    if( obj->getTypeMask() & TerrainObjectType )
       mTerrains.push_back( obj );
 
+   logObjectChange( obj );
+
    return true;
 }
 
@@ -178,14 +545,20 @@ bool SceneContainer::addObject(SceneObject* obj)
 bool SceneContainer::removeObject(SceneObject* obj)
 {
    AssertFatal(obj->mContainer == this, "Trying to remove from wrong container.");
+   releaseStaticCollision(obj);
    removeFromBins(obj);
+   mObjectBounds.remove(obj);
 
    // Remove water and physical zone types from the special vector.
    if ( obj->getTypeMask() & ( WaterObjectType | PhysicalZoneObjectType ) )
    {
       Vector<SceneObject*>::iterator iter = find( mWaterAndZones.begin(), mWaterAndZones.end(), obj );
-      if( iter != mTerrains.end() )
+      if( iter != mWaterAndZones.end() )
+      {
          mWaterAndZones.erase_fast(iter);
+         if( mChangeLogActive && iter != mWaterAndZones.end() )
+            _logChange( *iter, ChangeLogEntry::Reordered );
+      }
    }
 
    // Remove terrain objects from special vector.
@@ -193,7 +566,21 @@ bool SceneContainer::removeObject(SceneObject* obj)
    {
       Vector< SceneObject* >::iterator iter = find( mTerrains.begin(), mTerrains.end(), obj );
       if( iter != mTerrains.end() )
+      {
          mTerrains.erase_fast(iter);
+         if( mChangeLogActive && iter != mTerrains.end() )
+            _logChange( *iter, ChangeLogEntry::Reordered );
+      }
+   }
+
+   // The object may be deleted once it is out, so earlier entries of it
+   // must no longer be looked at.
+   if( mChangeLogActive )
+   {
+      for( U32 i = 0; i < mChangeLog.size(); ++ i )
+         if( mChangeLog[ i ].object == obj )
+            mChangeLog[ i ].kind = ChangeLogEntry::Removed;
+      _logChange( obj, ChangeLogEntry::Removed );
    }
 
    obj->mContainer = 0;
@@ -203,6 +590,28 @@ bool SceneContainer::removeObject(SceneObject* obj)
 
 //-----------------------------------------------------------------------------
 
+void SceneContainer::setIndexType( IndexType type )
+{
+   if ( type == mIndexType )
+      return;
+
+   AssertFatal( !dAtomicRead( mUsedQuerySlots ), "SceneContainer::setIndexType - Cannot switch index while a query is in progress" );
+
+   // Take everything out of the current index, switch, and put
+   // everything back in.
+
+   for ( Link* itr = mStart.next; itr != &mEnd; itr = itr->next )
+      removeFromBins( static_cast< SceneObject* >( itr ) );
+
+   mIndexType = type;
+   mOctree.clear();
+
+   for ( Link* itr = mStart.next; itr != &mEnd; itr = itr->next )
+      insertIntoBins( static_cast< SceneObject* >( itr ) );
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneContainer::addRefPoolBlock()
 {
    mRefPoolBlocks.push_back(new SceneObjectRef[csmRefPoolBlockSize]);
@@ -228,6 +637,15 @@ void SceneContainer::insertIntoBins(SceneObject* obj)
    AssertFatal(obj != NULL, "No object?");
    AssertFatal(obj->mBinRefHead == NULL, "Error, already have a bin chain!");
 
+   if (mIndexType == LooseOctreeIndex)
+   {
+      // Objects with global bounds or that the tree can't deal with
+      // go into the overflow bin.
+      if (obj->isGlobalBounds() || !mOctree.insert(obj))
+         _insertIntoOverflowBin(obj);
+      return;
+   }
+
    // The first thing we do is find which bins are covered in x and y...
    const Box3F* pWBox = &obj->getWorldBox();
 
@@ -272,20 +690,27 @@ void SceneContainer::insertIntoBins(SceneObject* obj)
       }
    }
    else
-   {
-      SceneObjectRef* ref = allocateObjectRef();
+      _insertIntoOverflowBin(obj);
+}
 
-      ref->object    = obj;
-      ref->nextInBin = mOverflowBin.nextInBin;
-      ref->prevInBin = &mOverflowBin;
-      ref->nextInObj = NULL;
+//-----------------------------------------------------------------------------
 
-      if (mOverflowBin.nextInBin)
-         mOverflowBin.nextInBin->prevInBin = ref;
-      mOverflowBin.nextInBin = ref;
+void SceneContainer::_insertIntoOverflowBin(SceneObject* obj)
+{
+   AssertFatal(obj->mBinRefHead == NULL, "Error, already have a bin chain!");
 
-      obj->mBinRefHead = ref;
-   }
+   SceneObjectRef* ref = allocateObjectRef();
+
+   ref->object    = obj;
+   ref->nextInBin = mOverflowBin.nextInBin;
+   ref->prevInBin = &mOverflowBin;
+   ref->nextInObj = NULL;
+
+   if (mOverflowBin.nextInBin)
+      mOverflowBin.nextInBin->prevInBin = ref;
+   mOverflowBin.nextInBin = ref;
+
+   obj->mBinRefHead = ref;
 }
 
 //-----------------------------------------------------------------------------
@@ -336,19 +761,7 @@ void SceneContainer::insertIntoBins(SceneObject* obj,
       }
    }
    else
-   {
-      SceneObjectRef* ref = allocateObjectRef();
-
-      ref->object    = obj;
-      ref->nextInBin = mOverflowBin.nextInBin;
-      ref->prevInBin = &mOverflowBin;
-      ref->nextInObj = NULL;
-
-      if (mOverflowBin.nextInBin)
-         mOverflowBin.nextInBin->prevInBin = ref;
-      mOverflowBin.nextInBin = ref;
-      obj->mBinRefHead = ref;
-   }
+      _insertIntoOverflowBin(obj);
    PROFILE_END();
 }
 
@@ -359,6 +772,12 @@ void SceneContainer::removeFromBins(SceneObject* obj)
    PROFILE_START(RemoveFromBins);
    AssertFatal(obj != NULL, "No object?");
 
+   if (SceneContainerOctree::contains(obj))
+   {
+      mOctree.remove(obj);
+      _logOctreeReordered();
+   }
+
    SceneObjectRef* chain = obj->mBinRefHead;
    obj->mBinRefHead = NULL;
 
@@ -384,6 +803,40 @@ void SceneContainer::checkBins(SceneObject* obj)
    AssertFatal(obj != NULL, "No object?");
 
    PROFILE_START(CheckBins);
+
+   logObjectChange(obj);
+
+   // Baked geometry is in world space.
+   releaseStaticCollision(obj);
+
+   mObjectBounds.update(obj);
+
+   if (mIndexType == LooseOctreeIndex)
+   {
+      if (SceneContainerOctree::contains(obj))
+      {
+         if (obj->isGlobalBounds())
+         {
+            mOctree.remove(obj);
+            _insertIntoOverflowBin(obj);
+         }
+         else if (!mOctree.update(obj))
+            _insertIntoOverflowBin(obj);
+
+         _logOctreeReordered();
+      }
+      else if (obj->mBinRefHead == NULL || !obj->isGlobalBounds())
+      {
+         // Either not binned yet or in the overflow bin only because
+         // the tree previously couldn't take it.
+         removeFromBins(obj);
+         insertIntoBins(obj);
+      }
+
+      PROFILE_END();
+      return;
+   }
+
    if (obj->mBinRefHead == NULL)
    {
       insertIntoBins(obj);
@@ -411,6 +864,78 @@ void SceneContainer::checkBins(SceneObject* obj)
 
 //-----------------------------------------------------------------------------
 
+void SceneContainer::beginChangeLog()
+{
+   mChangeLog.clear();
+   mChangeLogActive = true;
+
+   if( ++ mChangeLogId == 0 )
+      mChangeLogId ++;
+
+   mOctree.setReorderLog( &mOctreeReordered );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainer::endChangeLog()
+{
+   mChangeLogActive = false;
+   mChangeLog.clear();
+   mOctreeReordered.clear();
+   mOctree.setReorderLog( NULL );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainer::_logChange( SceneObject* object, ChangeLogEntry::Kind kind )
+{
+   mChangeLog.increment();
+   mChangeLog.last().object = object;
+   mChangeLog.last().kind = kind;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainer::_logOctreeReordered()
+{
+   for( U32 i = 0; i < mOctreeReordered.size(); ++ i )
+      _logChange( mOctreeReordered[ i ], ChangeLogEntry::Reordered );
+   mOctreeReordered.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneContainer::isQueryUnchanged( U32 logId, U32 logSize, const Box3F& box, U32 mask,
+                                       const Vector< SceneObject* >& result, SceneObject* ignore ) const
+{
+   if( !mChangeLogActive || logId != mChangeLogId || logSize > mChangeLog.size() )
+      return false;
+
+   for( U32 i = logSize; i < mChangeLog.size(); ++ i )
+   {
+      const ChangeLogEntry& entry = mChangeLog[ i ];
+
+      // Whatever happened to an object in the result, it may no longer
+      // be found or be found in a different order.
+      if( find( result.begin(), result.end(), entry.object ) != result.end() )
+         return false;
+
+      if( entry.kind != ChangeLogEntry::Changed || entry.object == ignore )
+         continue;
+
+      // Otherwise only objects that match the query now make a difference.
+      const SceneObject* object = entry.object;
+      if( ( object->getTypeMask() & mask ) != 0 &&
+          object->isCollisionEnabled() &&
+          ( object->isGlobalBounds() || object->getWorldBox().isOverlapped( box ) ) )
+         return false;
+   }
+
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneContainer::findObjects(const Box3F& box, U32 mask, FindCallback callback, void *key)
 {
    PROFILE_SCOPE(ContainerFindObjects_Box);
@@ -421,7 +946,7 @@ void SceneContainer::findObjects(const Box3F& box, U32 mask, FindCallback callba
         mask == PhysicalZoneObjectType ||
         mask == (WaterObjectType|PhysicalZoneObjectType) )
    {
-      _findSpecialObjects( mWaterAndZones, box, mask, callback, key );
+      _findWaterAndZones( box, mask, callback, key );
       return;
    }
    else if( mask == TerrainObjectType )
@@ -430,48 +955,53 @@ void SceneContainer::findObjects(const Box3F& box, U32 mask, FindCallback callba
       return;
    }
 
-   AssertFatal( !mSearchInProgress, "SceneContainer::findObjects - Container queries are not re-entrant" );
-   mSearchInProgress = true;
+   QueryContext query( this );
 
-   U32 minX, maxX, minY, maxY;
-   getBinRange(box.minExtents.x, box.maxExtents.x, minX, maxX);
-   getBinRange(box.minExtents.y, box.maxExtents.y, minY, maxY);
-   mCurrSeqKey++;
-   for (U32 i = minY; i <= maxY; i++)
-   {
-      U32 insertY = i % csmNumBins;
-      U32 base    = insertY * csmNumBins;
-      for (U32 j = minX; j <= maxX; j++)
-      {
-         U32 insertX = j % csmNumBins;
 
-         SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
-         while (chain)
+   if (mIndexType == LooseOctreeIndex)
+   {
+      OctreeBoxTest nodeTest(box);
+      FindObjectsVisitor visitor(box, mask, callback, key);
+      mOctree.traverse(nodeTest, visitor);
+   }
+   else
+   {
+      U32 minX, maxX, minY, maxY;
+      getBinRange(box.minExtents.x, box.maxExtents.x, minX, maxX);
+      getBinRange(box.minExtents.y, box.maxExtents.y, minY, maxY);
+      for (U32 i = minY; i <= maxY; i++)
+      {
+         U32 insertY = i % csmNumBins;
+         U32 base    = insertY * csmNumBins;
+         for (U32 j = minX; j <= maxX; j++)
          {
-            if (chain->object->getContainerSeqKey() != mCurrSeqKey)
-            {
-               chain->object->setContainerSeqKey(mCurrSeqKey);
+            U32 insertX = j % csmNumBins;
 
-               if ((chain->object->getTypeMask() & mask) != 0 &&
-                   chain->object->isCollisionEnabled())
+            SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
+            while (chain)
+            {
+               if (query.visit(chain->object))
                {
-                  if (chain->object->getWorldBox().isOverlapped(box) || chain->object->isGlobalBounds())
+                  if ((chain->object->getTypeMask() & mask) != 0 &&
+                      chain->object->isCollisionEnabled())
                   {
-                     (*callback)(chain->object,key);
+                     if (chain->object->getWorldBox().isOverlapped(box) || chain->object->isGlobalBounds())
+                     {
+                        (*callback)(chain->object,key);
+                     }
                   }
                }
+               chain = chain->nextInBin;
             }
-            chain = chain->nextInBin;
          }
       }
    }
+
    SceneObjectRef* chain = mOverflowBin.nextInBin;
    while (chain)
    {
-      if (chain->object->getContainerSeqKey() != mCurrSeqKey)
+      if (query.visit(chain->object))
       {
-         chain->object->setContainerSeqKey(mCurrSeqKey);
-
          if ((chain->object->getTypeMask() & mask) != 0 &&
              chain->object->isCollisionEnabled())
          {
@@ -483,8 +1013,6 @@ void SceneContainer::findObjects(const Box3F& box, U32 mask, FindCallback callba
       }
       chain = chain->nextInBin;
    }
-
-   mSearchInProgress = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -499,7 +1027,7 @@ void SceneContainer::findObjects( const Frustum &frustum, U32 mask, FindCallback
          mask == PhysicalZoneObjectType ||
          mask == (WaterObjectType|PhysicalZoneObjectType) )
    {
-      _findSpecialObjects( mWaterAndZones, searchBox, mask, callback, key );
+      _findWaterAndZones( searchBox, mask, callback, key );
       return;
    }
    else if( mask == TerrainObjectType )
@@ -508,43 +1036,49 @@ void SceneContainer::findObjects( const Frustum &frustum, U32 mask, FindCallback
       return;
    }
 
-   AssertFatal( !mSearchInProgress, "SceneContainer::findObjects - Container queries are not re-entrant" );
-   mSearchInProgress = true;
+   QueryContext query( this );
 
-   U32 minX, maxX, minY, maxY;
-   getBinRange(searchBox.minExtents.x, searchBox.maxExtents.x, minX, maxX);
-   getBinRange(searchBox.minExtents.y, searchBox.maxExtents.y, minY, maxY);
-   mCurrSeqKey++;
 
-   for (U32 i = minY; i <= maxY; i++)
+   if (mIndexType == LooseOctreeIndex)
    {
-      U32 insertY = i % csmNumBins;
-      U32 base    = insertY * csmNumBins;
-      for (U32 j = minX; j <= maxX; j++)
-      {
-         U32 insertX = j % csmNumBins;
+      OctreeFrustumTest nodeTest(frustum);
+      FindObjectsVisitor visitor(searchBox, mask, callback, key, &frustum);
+      mOctree.traverse(nodeTest, visitor);
+   }
+   else
+   {
+      U32 minX, maxX, minY, maxY;
+      getBinRange(searchBox.minExtents.x, searchBox.maxExtents.x, minX, maxX);
+      getBinRange(searchBox.minExtents.y, searchBox.maxExtents.y, minY, maxY);
 
-         SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
-         while (chain)
+      for (U32 i = minY; i <= maxY; i++)
+      {
+         U32 insertY = i % csmNumBins;
+         U32 base    = insertY * csmNumBins;
+         for (U32 j = minX; j <= maxX; j++)
          {
-            SceneObject *object = chain->object;
+            U32 insertX = j % csmNumBins;
 
-            if (object->getContainerSeqKey() != mCurrSeqKey)
+            SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
+            while (chain)
             {
-               object->setContainerSeqKey(mCurrSeqKey);
+               SceneObject *object = chain->object;
 
-               if ((object->getTypeMask() & mask) != 0 &&
-                  object->isCollisionEnabled())
+               if (query.visit(object))
                {
-                  const Box3F &worldBox = object->getWorldBox();
-                  if ( object->isGlobalBounds() || worldBox.isOverlapped(searchBox) )
+                  if ((object->getTypeMask() & mask) != 0 &&
+                     object->isCollisionEnabled())
                   {
-                     if ( !frustum.isCulled( worldBox ) )
-                        (*callback)(chain->object,key);
+                     const Box3F &worldBox = object->getWorldBox();
+                     if ( object->isGlobalBounds() || worldBox.isOverlapped(searchBox) )
+                     {
+                        if ( !frustum.isCulled( worldBox ) )
+                           (*callback)(chain->object,key);
+                     }
                   }
                }
+               chain = chain->nextInBin;
             }
-            chain = chain->nextInBin;
          }
       }
    }
@@ -554,10 +1088,8 @@ void SceneContainer::findObjects( const Frustum &frustum, U32 mask, FindCallback
    {
       SceneObject *object = chain->object;
 
-      if (object->getContainerSeqKey() != mCurrSeqKey)
+      if (query.visit(object))
       {
-         object->setContainerSeqKey(mCurrSeqKey);
-
          if ((object->getTypeMask() & mask) != 0 &&
             object->isCollisionEnabled())
          {
@@ -572,8 +1104,6 @@ void SceneContainer::findObjects( const Frustum &frustum, U32 mask, FindCallback
       }
       chain = chain->nextInBin;
    }
-
-   mSearchInProgress = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -596,7 +1126,7 @@ void SceneContainer::polyhedronFindObjects(const Polyhedron& polyhedron, U32 mas
          mask == PhysicalZoneObjectType ||
          mask == (WaterObjectType|PhysicalZoneObjectType) )
    {
-      _findSpecialObjects( mWaterAndZones, box, mask, callback, key );
+      _findWaterAndZones( box, mask, callback, key );
       return;
    }
    else if( mask == TerrainObjectType )
@@ -605,48 +1135,53 @@ void SceneContainer::polyhedronFindObjects(const Polyhedron& polyhedron, U32 mas
       return;
    }
 
-   AssertFatal( !mSearchInProgress, "SceneContainer::polyhedronFindObjects - Container queries are not re-entrant" );
-   mSearchInProgress = true;
+   QueryContext query( this );
 
-   U32 minX, maxX, minY, maxY;
-   getBinRange(box.minExtents.x, box.maxExtents.x, minX, maxX);
-   getBinRange(box.minExtents.y, box.maxExtents.y, minY, maxY);
-   mCurrSeqKey++;
-   for (i = minY; i <= maxY; i++)
-   {
-      U32 insertY = i % csmNumBins;
-      U32 base    = insertY * csmNumBins;
-      for (U32 j = minX; j <= maxX; j++)
-      {
-         U32 insertX = j % csmNumBins;
 
-         SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
-         while (chain)
+   if (mIndexType == LooseOctreeIndex)
+   {
+      OctreeBoxTest nodeTest(box);
+      FindObjectsVisitor visitor(box, mask, callback, key);
+      mOctree.traverse(nodeTest, visitor);
+   }
+   else
+   {
+      U32 minX, maxX, minY, maxY;
+      getBinRange(box.minExtents.x, box.maxExtents.x, minX, maxX);
+      getBinRange(box.minExtents.y, box.maxExtents.y, minY, maxY);
+      for (i = minY; i <= maxY; i++)
+      {
+         U32 insertY = i % csmNumBins;
+         U32 base    = insertY * csmNumBins;
+         for (U32 j = minX; j <= maxX; j++)
          {
-            if (chain->object->getContainerSeqKey() != mCurrSeqKey)
-            {
-               chain->object->setContainerSeqKey(mCurrSeqKey);
+            U32 insertX = j % csmNumBins;
 
-               if ((chain->object->getTypeMask() & mask) != 0 &&
-                   chain->object->isCollisionEnabled())
+            SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
+            while (chain)
+            {
+               if (query.visit(chain->object))
                {
-                  if (chain->object->getWorldBox().isOverlapped(box) || chain->object->isGlobalBounds())
+                  if ((chain->object->getTypeMask() & mask) != 0 &&
+                      chain->object->isCollisionEnabled())
                   {
-                     (*callback)(chain->object,key);
+                     if (chain->object->getWorldBox().isOverlapped(box) || chain->object->isGlobalBounds())
+                     {
+                        (*callback)(chain->object,key);
+                     }
                   }
                }
+               chain = chain->nextInBin;
             }
-            chain = chain->nextInBin;
          }
       }
    }
+
    SceneObjectRef* chain = mOverflowBin.nextInBin;
    while (chain)
    {
-      if (chain->object->getContainerSeqKey() != mCurrSeqKey)
+      if (query.visit(chain->object))
       {
-         chain->object->setContainerSeqKey(mCurrSeqKey);
-
          if ((chain->object->getTypeMask() & mask) != 0 &&
              chain->object->isCollisionEnabled())
          {
@@ -658,8 +1193,6 @@ void SceneContainer::polyhedronFindObjects(const Polyhedron& polyhedron, U32 mas
       }
       chain = chain->nextInBin;
    }
-
-   mSearchInProgress = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -668,44 +1201,50 @@ void SceneContainer::findObjectList( const Box3F& searchBox, U32 mask, Vector<Sc
 {
    PROFILE_SCOPE( Container_FindObjectList_Box );
 
-   AssertFatal( !mSearchInProgress, "SceneContainer::findObjectList - Container queries are not re-entrant" );
-   mSearchInProgress = true;
+   QueryContext query( this );
 
    // TODO: Optimize for water and zones?
 
-   U32 minX, maxX, minY, maxY;
-   getBinRange(searchBox.minExtents.x, searchBox.maxExtents.x, minX, maxX);
-   getBinRange(searchBox.minExtents.y, searchBox.maxExtents.y, minY, maxY);
-   mCurrSeqKey++;
 
-   for (U32 i = minY; i <= maxY; i++)
+   if (mIndexType == LooseOctreeIndex)
    {
-      U32 insertY = i % csmNumBins;
-      U32 base    = insertY * csmNumBins;
-      for (U32 j = minX; j <= maxX; j++)
-      {
-         U32 insertX = j % csmNumBins;
+      OctreeBoxTest nodeTest(searchBox);
+      FindObjectListVisitor visitor(searchBox, mask, outFound);
+      mOctree.traverse(nodeTest, visitor);
+   }
+   else
+   {
+      U32 minX, maxX, minY, maxY;
+      getBinRange(searchBox.minExtents.x, searchBox.maxExtents.x, minX, maxX);
+      getBinRange(searchBox.minExtents.y, searchBox.maxExtents.y, minY, maxY);
 
-         SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
-         while (chain)
+      for (U32 i = minY; i <= maxY; i++)
+      {
+         U32 insertY = i % csmNumBins;
+         U32 base    = insertY * csmNumBins;
+         for (U32 j = minX; j <= maxX; j++)
          {
-            SceneObject *object = chain->object;
+            U32 insertX = j % csmNumBins;
 
-            if (object->getContainerSeqKey() != mCurrSeqKey)
+            SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
+            while (chain)
             {
-               object->setContainerSeqKey(mCurrSeqKey);
+               SceneObject *object = chain->object;
 
-               if ((object->getTypeMask() & mask) != 0 &&
-                  object->isCollisionEnabled())
+               if (query.visit(object))
                {
-                  const Box3F &worldBox = object->getWorldBox();
-                  if ( object->isGlobalBounds() || worldBox.isOverlapped( searchBox ) )
+                  if ((object->getTypeMask() & mask) != 0 &&
+                     object->isCollisionEnabled())
                   {
-                     outFound->push_back( object );
+                     const Box3F &worldBox = object->getWorldBox();
+                     if ( object->isGlobalBounds() || worldBox.isOverlapped( searchBox ) )
+                     {
+                        outFound->push_back( object );
+                     }
                   }
                }
+               chain = chain->nextInBin;
             }
-            chain = chain->nextInBin;
          }
       }
    }
@@ -715,10 +1254,8 @@ void SceneContainer::findObjectList( const Box3F& searchBox, U32 mask, Vector<Sc
    {
       SceneObject *object = chain->object;
 
-      if (object->getContainerSeqKey() != mCurrSeqKey)
+      if (query.visit(object))
       {
-         object->setContainerSeqKey(mCurrSeqKey);
-
          if ((object->getTypeMask() & mask) != 0 &&
             object->isCollisionEnabled())
          {
@@ -732,8 +1269,6 @@ void SceneContainer::findObjectList( const Box3F& searchBox, U32 mask, Vector<Sc
       }
       chain = chain->nextInBin;
    }
-
-   mSearchInProgress = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -742,17 +1277,38 @@ void SceneContainer::findObjectList( const Frustum &frustum, U32 mask, Vector<Sc
 {
    PROFILE_SCOPE( Container_FindObjectList_Frustum );
 
-   // Do a box find first.
-   findObjectList( frustum.getBounds(), mask, outFound );
+   // Test the packed world boxes of all objects against the frustum planes
+   // and the faces of the frustum's bounding box in a single pass.  Only the
+   // objects that pass get touched.
+
+   const Box3F& bounds = frustum.getBounds();
+
+   PlaneF planes[ Frustum::PlaneCount + 6 ];
+   U32 numPlanes = frustum.getNumPlanes();
+   dMemcpy( planes, frustum.getPlanes(), numPlanes * sizeof( PlaneF ) );
+
+   planes[ numPlanes++ ].set(  1.0f,  0.0f,  0.0f, -bounds.minExtents.x );
+   planes[ numPlanes++ ].set(  0.0f,  1.0f,  0.0f, -bounds.minExtents.y );
+   planes[ numPlanes++ ].set(  0.0f,  0.0f,  1.0f, -bounds.minExtents.z );
+   planes[ numPlanes++ ].set( -1.0f,  0.0f,  0.0f,  bounds.maxExtents.x );
+   planes[ numPlanes++ ].set(  0.0f, -1.0f,  0.0f,  bounds.maxExtents.y );
+   planes[ numPlanes++ ].set(  0.0f,  0.0f, -1.0f,  bounds.maxExtents.z );
 
-   // Now do the frustum testing.
-   for ( U32 i=0; i < outFound->size(); )
+   Vector< U32 > visible;
+   mObjectBounds.cull( planes, numPlanes, visible );
+
+   for ( U32 word = 0; word < visible.size(); word++ )
    {
-      const Box3F &worldBox = (*outFound)[i]->getWorldBox();
-      if ( frustum.isCulled( worldBox ) )
-         outFound->erase_fast( i );
-      else
-         i++;
+      U32 bits = visible[ word ];
+      for ( U32 i = word * 32; bits != 0; i++, bits >>= 1 )
+      {
+         if ( !( bits & 1 ) )
+            continue;
+
+         SceneObject* object = mObjectBounds.getObject( i );
+         if ( ( object->getTypeMask() & mask ) != 0 && object->isCollisionEnabled() )
+            outFound->push_back( object );
+      }
    }
 }
 
@@ -808,9 +1364,54 @@ void SceneContainer::_findSpecialObjects( const Vector< SceneObject* >& vector,
       if ( pObj->getTypeMask() & mask &&
            ( pObj->isGlobalBounds() || pObj->getWorldBox().isOverlapped(box) ) )
       {
-         callback( pObj, key );
+         callback( pObj, key );
+      }
+   }  
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainer::_findWaterAndZones( const Box3F& box, U32 mask, FindCallback callback, void* key )
+{
+   // A handful of them is cheaper to scan than to look up.
+   if ( mWaterAndZones.size() <= csmMaxLinearWaterAndZones )
+   {
+      _findSpecialObjects( mWaterAndZones, box, mask, callback, key );
+      return;
+   }
+
+   PROFILE_SCOPE( Container_findWaterAndZones );
+
+   // Every moving shape asks for its zones each tick, so with many zones
+   // in the level only visit those indexed near the box.
+   FindWaterAndZonesVisitor visitor( box, mask, callback, key );
+   QueryContext query( this );
+
+   if ( mIndexType == LooseOctreeIndex )
+   {
+      OctreeBoxTest nodeTest( box );
+      mOctree.traverse( nodeTest, visitor );
+   }
+   else
+   {
+      U32 minX, maxX, minY, maxY;
+      getBinRange( box.minExtents.x, box.maxExtents.x, minX, maxX );
+      getBinRange( box.minExtents.y, box.maxExtents.y, minY, maxY );
+      for ( U32 i = minY; i <= maxY; i++ )
+      {
+         U32 base = ( i % csmNumBins ) * csmNumBins;
+         for ( U32 j = minX; j <= maxX; j++ )
+         {
+            for ( SceneObjectRef* chain = mBinArray[ base + j % csmNumBins ].nextInBin; chain; chain = chain->nextInBin )
+               if ( query.visit( chain->object ) )
+                  visitor( chain->object );
+         }
       }
-   }  
+   }
+
+   for ( SceneObjectRef* chain = mOverflowBin.nextInBin; chain; chain = chain->nextInBin )
+      if ( query.visit( chain->object ) )
+         visitor( chain->object );
 }
 
 //-----------------------------------------------------------------------------
@@ -819,6 +1420,8 @@ bool SceneContainer::castRay( const Point3F& start, const Point3F& end, U32 mask
 {
    AssertFatal( info->userData == NULL, "SceneContainer::castRay - RayInfo->userData cannot be used here!" );
 
+   CollisionStats::count( CollisionStats::CastRay, this == &gServerContainer );
+
    PROFILE_START( SceneContainer_CastRay );
    bool result = _castRay( CollisionGeometry, start, end, mask, info, callback );
    PROFILE_END();
@@ -831,6 +1434,8 @@ bool SceneContainer::castRayRendered( const Point3F& start, const Point3F& end,
 {
    AssertFatal( info->userData == NULL, "SceneContainer::castRayRendered - RayInfo->userData cannot be used here!" );
 
+   CollisionStats::count( CollisionStats::CastRay, this == &gServerContainer );
+
    PROFILE_START( SceneContainer_CastRayRendered );
    bool result = _castRay( RenderedGeometry, start, end, mask, info, callback );
    PROFILE_END();
@@ -853,263 +1458,191 @@ bool SceneContainer::castRayRendered( const Point3F& start, const Point3F& end,
 
 bool SceneContainer::_castRay( U32 type, const Point3F& start, const Point3F& end, U32 mask, RayInfo* info, CastRayCallback callback )
 {
-   AssertFatal( !mSearchInProgress, "SceneContainer::_castRay - Container queries are not re-entrant" );
-   mSearchInProgress = true;
+   QueryContext query( this );
 
    F32 currentT = 2.0;
-   mCurrSeqKey++;
+
+   // Test the baked geometry first so that the closest static hit
+   // already limits the search below.
+   const bool useStaticCollision = _useStaticCollision( type, info );
+   if ( useStaticCollision )
+      _castRayStaticCollision( start, end, mask, NULL, info, callback, currentT );
 
    SceneObjectRef* chain = mOverflowBin.nextInBin;
    while (chain)
    {
       SceneObject* ptr = chain->object;
-      if (ptr->getContainerSeqKey() != mCurrSeqKey)
+      if (query.visit(ptr))
       {
-         ptr->setContainerSeqKey(mCurrSeqKey);
-
          // In the overflow bin, the world box is always going to intersect the line,
          //  so we can omit that test...
          if ((ptr->getTypeMask() & mask) != 0 &&
              ptr->isCollisionEnabled() == true)
-         {
-            Point3F xformedStart, xformedEnd;
-            ptr->mWorldToObj.mulP(start, &xformedStart);
-            ptr->mWorldToObj.mulP(end,   &xformedEnd);
-            xformedStart.convolveInverse(ptr->mObjScale);
-            xformedEnd.convolveInverse(ptr->mObjScale);
-
-            RayInfo ri;
-            ri.generateTexCoord  = info->generateTexCoord;
-            bool result = false;
-            if (type == CollisionGeometry)
-               result = ptr->castRay(xformedStart, xformedEnd, &ri);
-            else if (type == RenderedGeometry)
-               result = ptr->castRayRendered(xformedStart, xformedEnd, &ri);
-            if (result)
-            {
-               if( ri.t < currentT && ( !callback || callback( &ri ) ) )
-               {
-                  *info = ri;
-                  info->point.interpolate(start, end, info->t);
-                  currentT = ri.t;
-                  info->distance = (start - info->point).len();
-               }
-            }
-         }
+            _castRayObject(type, ptr, start, end, info, callback, currentT);
       }
       chain = chain->nextInBin;
    }
 
-   // These are just for rasterizing the line against the grid.  We want the x coord
-   //  of the start to be <= the x coord of the end
-   Point3F normalStart, normalEnd;
-   if (start.x <= end.x)
+   if (mIndexType == LooseOctreeIndex)
    {
-      normalStart = start;
-      normalEnd   = end;
+      OctreeRayVisitor visitor(this, type, start, end, mask, info, callback, currentT);
+      mOctree.traverse(visitor, visitor);
    }
    else
    {
-      normalStart = end;
-      normalEnd   = start;
-   }
-
-   // Ok, let's scan the grids.  The simplest way to do this will be to scan across in
-   //  x, finding the y range for each affected bin...
-   U32 minX, maxX;
-   U32 minY, maxY;
-//if (normalStart.x == normalEnd.x)
-//   Con::printf("X start = %g, end = %g", normalStart.x, normalEnd.x);
-
-   getBinRange(normalStart.x, normalEnd.x, minX, maxX);
-   getBinRange(getMin(normalStart.y, normalEnd.y),
-               getMax(normalStart.y, normalEnd.y), minY, maxY);
-
-//if (normalStart.x == normalEnd.x && minX != maxX)
-//   Con::printf("X min = %d, max = %d", minX, maxX);
-//if (normalStart.y == normalEnd.y && minY != maxY)
-//   Con::printf("Y min = %d, max = %d", minY, maxY);
-
-   // We'll optimize the case that the line is contained in one bin row or column, which
-   //  will be quite a few lines.  No sense doing more work than we have to...
-   //
-   if ((mFabs(normalStart.x - normalEnd.x) < csmTotalBinSize && minX == maxX) ||
-       (mFabs(normalStart.y - normalEnd.y) < csmTotalBinSize && minY == maxY))
-   {
-      U32 count;
-      U32 incX, incY;
-      if (minX == maxX)
+      // These are just for rasterizing the line against the grid.  We want the x coord
+      //  of the start to be <= the x coord of the end
+      Point3F normalStart, normalEnd;
+      if (start.x <= end.x)
       {
-         count = maxY - minY + 1;
-         incX  = 0;
-         incY  = 1;
+         normalStart = start;
+         normalEnd   = end;
       }
       else
       {
-         count = maxX - minX + 1;
-         incX  = 1;
-         incY  = 0;
+         normalStart = end;
+         normalEnd   = start;
       }
 
-      U32 x = minX;
-      U32 y = minY;
-      for (U32 i = 0; i < count; i++)
+      // Ok, let's scan the grids.  The simplest way to do this will be to scan across in
+      //  x, finding the y range for each affected bin...
+      U32 minX, maxX;
+      U32 minY, maxY;
+
+      getBinRange(normalStart.x, normalEnd.x, minX, maxX);
+      getBinRange(getMin(normalStart.y, normalEnd.y),
+                  getMax(normalStart.y, normalEnd.y), minY, maxY);
+
+      // We'll optimize the case that the line is contained in one bin row or column, which
+      //  will be quite a few lines.  No sense doing more work than we have to...
+      //
+      if ((mFabs(normalStart.x - normalEnd.x) < csmTotalBinSize && minX == maxX) ||
+          (mFabs(normalStart.y - normalEnd.y) < csmTotalBinSize && minY == maxY))
       {
-         U32 checkX = x % csmNumBins;
-         U32 checkY = y % csmNumBins;
+         U32 count;
+         U32 incX, incY;
+         if (minX == maxX)
+         {
+            count = maxY - minY + 1;
+            incX  = 0;
+            incY  = 1;
+         }
+         else
+         {
+            count = maxX - minX + 1;
+            incX  = 1;
+            incY  = 0;
+         }
 
-         SceneObjectRef* chain = mBinArray[(checkY * csmNumBins) + checkX].nextInBin;
-         while (chain)
+         U32 x = minX;
+         U32 y = minY;
+         for (U32 i = 0; i < count; i++)
          {
-            SceneObject* ptr = chain->object;
-            if (ptr->getContainerSeqKey() != mCurrSeqKey)
-            {
-               ptr->setContainerSeqKey(mCurrSeqKey);
+            U32 checkX = x % csmNumBins;
+            U32 checkY = y % csmNumBins;
 
-               if ((ptr->getTypeMask() & mask) != 0      &&
-                   ptr->isCollisionEnabled() == true)
+            SceneObjectRef* chain = mBinArray[(checkY * csmNumBins) + checkX].nextInBin;
+            while (chain)
+            {
+               SceneObject* ptr = chain->object;
+               if (query.visit(ptr))
                {
-                  if (ptr->getWorldBox().collideLine(start, end) || chain->object->isGlobalBounds())
+                  if ((ptr->getTypeMask() & mask) != 0      &&
+                      ptr->isCollisionEnabled() == true)
                   {
-                     Point3F xformedStart, xformedEnd;
-                     ptr->mWorldToObj.mulP(start, &xformedStart);
-                     ptr->mWorldToObj.mulP(end,   &xformedEnd);
-                     xformedStart.convolveInverse(ptr->mObjScale);
-                     xformedEnd.convolveInverse(ptr->mObjScale);
-
-                     RayInfo ri;
-                     ri.generateTexCoord  = info->generateTexCoord;
-                     bool result = false;
-                     if (type == CollisionGeometry)
-                        result = ptr->castRay(xformedStart, xformedEnd, &ri);
-                     else if (type == RenderedGeometry)
-                        result = ptr->castRayRendered(xformedStart, xformedEnd, &ri);
-                     if (result)
-                     {
-                        if( ri.t < currentT && ( !callback || callback( &ri ) ) )
-                        {
-                           *info = ri;
-                           info->point.interpolate(start, end, info->t);
-                           currentT = ri.t;
-                           info->distance = (start - info->point).len();
-                        }
-                     }
+                     if (ptr->getWorldBox().collideLine(start, end) || chain->object->isGlobalBounds())
+                        _castRayObject(type, ptr, start, end, info, callback, currentT);
                   }
                }
+               chain = chain->nextInBin;
             }
-            chain = chain->nextInBin;
-         }
-
-         x += incX;
-         y += incY;
-      }
-   }
-   else
-   {
-      // Oh well, let's earn our keep.  We know that after the above conditional, we're
-      //  going to cross at least one boundary, so that simplifies our job...
 
-      F32 currStartX = normalStart.x;
-
-      AssertFatal(currStartX != normalEnd.x, "This is going to cause problems in SceneContainer::castRay");
-      if(mIsNaN_F(currStartX))
-      {
-         PROFILE_END();
-         return false;
+            x += incX;
+            y += incY;
+         }
       }
-      while (currStartX != normalEnd.x)
+      else
       {
-         F32 currEndX   = getMin(currStartX + csmTotalBinSize, normalEnd.x);
+         // Oh well, let's earn our keep.  We know that after the above conditional, we're
+         //  going to cross at least one boundary, so that simplifies our job...
 
-         F32 currStartT = (currStartX - normalStart.x) / (normalEnd.x - normalStart.x);
-         F32 currEndT   = (currEndX   - normalStart.x) / (normalEnd.x - normalStart.x);
+         F32 currStartX = normalStart.x;
 
-         F32 y1 = normalStart.y + (normalEnd.y - normalStart.y) * currStartT;
-         F32 y2 = normalStart.y + (normalEnd.y - normalStart.y) * currEndT;
+         AssertFatal(currStartX != normalEnd.x, "This is going to cause problems in SceneContainer::castRay");
+         if(mIsNaN_F(currStartX))
+         {
+            PROFILE_END();
+            return false;
+         }
+         while (currStartX != normalEnd.x)
+         {
+            F32 currEndX   = getMin(currStartX + csmTotalBinSize, normalEnd.x);
 
-         U32 subMinX, subMaxX;
-         getBinRange(currStartX, currEndX, subMinX, subMaxX);
+            F32 currStartT = (currStartX - normalStart.x) / (normalEnd.x - normalStart.x);
+            F32 currEndT   = (currEndX   - normalStart.x) / (normalEnd.x - normalStart.x);
 
-         F32 subStartX = currStartX;
-         F32 subEndX   = currStartX;
+            F32 y1 = normalStart.y + (normalEnd.y - normalStart.y) * currStartT;
+            F32 y2 = normalStart.y + (normalEnd.y - normalStart.y) * currEndT;
 
-         if (currStartX < 0.0f)
-            subEndX -= mFmod(subEndX, csmBinSize);
-         else
-            subEndX += (csmBinSize - mFmod(subEndX, csmBinSize));
+            U32 subMinX, subMaxX;
+            getBinRange(currStartX, currEndX, subMinX, subMaxX);
 
-         for (U32 currXBin = subMinX; currXBin <= subMaxX; currXBin++)
-         {
-            U32 checkX = currXBin % csmNumBins;
+            F32 subStartX = currStartX;
+            F32 subEndX   = currStartX;
 
-            F32 subStartT = (subStartX - currStartX) / (currEndX - currStartX);
-            F32 subEndT   = getMin(F32((subEndX   - currStartX) / (currEndX - currStartX)), 1.f);
+            if (currStartX < 0.0f)
+               subEndX -= mFmod(subEndX, csmBinSize);
+            else
+               subEndX += (csmBinSize - mFmod(subEndX, csmBinSize));
 
-            F32 subY1 = y1 + (y2 - y1) * subStartT;
-            F32 subY2 = y1 + (y2 - y1) * subEndT;
+            for (U32 currXBin = subMinX; currXBin <= subMaxX; currXBin++)
+            {
+               U32 checkX = currXBin % csmNumBins;
 
-            U32 newMinY, newMaxY;
-            getBinRange(getMin(subY1, subY2), getMax(subY1, subY2), newMinY, newMaxY);
+               F32 subStartT = (subStartX - currStartX) / (currEndX - currStartX);
+               F32 subEndT   = getMin(F32((subEndX   - currStartX) / (currEndX - currStartX)), 1.f);
 
-            for (U32 i = newMinY; i <= newMaxY; i++)
-            {
-               U32 checkY = i % csmNumBins;
+               F32 subY1 = y1 + (y2 - y1) * subStartT;
+               F32 subY2 = y1 + (y2 - y1) * subEndT;
 
-               SceneObjectRef* chain = mBinArray[(checkY * csmNumBins) + checkX].nextInBin;
-               while (chain)
+               U32 newMinY, newMaxY;
+               getBinRange(getMin(subY1, subY2), getMax(subY1, subY2), newMinY, newMaxY);
+
+               for (U32 i = newMinY; i <= newMaxY; i++)
                {
-                  SceneObject* ptr = chain->object;
-                  if (ptr->getContainerSeqKey() != mCurrSeqKey)
-                  {
-                     ptr->setContainerSeqKey(mCurrSeqKey);
+                  U32 checkY = i % csmNumBins;
 
-                     if ((ptr->getTypeMask() & mask) != 0      &&
-                         ptr->isCollisionEnabled() == true)
+                  SceneObjectRef* chain = mBinArray[(checkY * csmNumBins) + checkX].nextInBin;
+                  while (chain)
+                  {
+                     SceneObject* ptr = chain->object;
+                     if (query.visit(ptr))
                      {
-                        if (ptr->getWorldBox().collideLine(start, end))
+                        if ((ptr->getTypeMask() & mask) != 0      &&
+                            ptr->isCollisionEnabled() == true)
                         {
-                           Point3F xformedStart, xformedEnd;
-                           ptr->mWorldToObj.mulP(start, &xformedStart);
-                           ptr->mWorldToObj.mulP(end,   &xformedEnd);
-                           xformedStart.convolveInverse(ptr->mObjScale);
-                           xformedEnd.convolveInverse(ptr->mObjScale);
-
-                           RayInfo ri;
-                           ri.generateTexCoord  = info->generateTexCoord;
-                           bool result = false;
-                           if (type == CollisionGeometry)
-                              result = ptr->castRay(xformedStart, xformedEnd, &ri);
-                           else if (type == RenderedGeometry)
-                              result = ptr->castRayRendered(xformedStart, xformedEnd, &ri);
-                           if (result)
-                           {
-                              if( ri.t < currentT && ( !callback || callback( &ri ) ) )
-                              {
-                                 *info = ri;
-                                 info->point.interpolate(start, end, info->t);
-                                 currentT = ri.t;
-                                 info->distance = (start - info->point).len();
-                              }
-                           }
+                           if (ptr->getWorldBox().collideLine(start, end))
+                              _castRayObject(type, ptr, start, end, info, callback, currentT);
                         }
                      }
+                     chain = chain->nextInBin;
                   }
-                  chain = chain->nextInBin;
                }
+
+               subStartX = subEndX;
+               subEndX   = getMin(subEndX + csmBinSize, currEndX);
             }
 
-            subStartX = subEndX;
-            subEndX   = getMin(subEndX + csmBinSize, currEndX);
+            currStartX = currEndX;
          }
-
-         currStartX = currEndX;
       }
    }
 
-   mSearchInProgress = false;
-
-   // Bump the normal into worldspace if appropriate.
-   if(currentT != 2)
+   // Bump the normal into worldspace if appropriate.  Normals
+   // of baked geometry are in world space already.
+   if(currentT != 2 && useStaticCollision && info->object->mStaticCollisionIndex != -1)
+      return true;
+   else if(currentT != 2)
    {
       PlaneF fakePlane;
       fakePlane.x = info->normal.x;
@@ -1132,11 +1665,373 @@ bool SceneContainer::_castRay( U32 type, const Point3F& start, const Point3F& en
 
 //-----------------------------------------------------------------------------
 
+void SceneContainer::_castRayObject( U32 type, SceneObject* ptr, const Point3F& start, const Point3F& end, RayInfo* info, CastRayCallback callback, F32& currentT )
+{
+   // Baked objects have been tested by _castRayStaticCollision() already.
+   if ( ptr->mStaticCollisionIndex != -1 && _useStaticCollision( type, info ) )
+      return;
+
+   CollisionStats::count( CollisionStats::ObjectCastRay, ptr );
+
+   Point3F xformedStart, xformedEnd;
+   ptr->mWorldToObj.mulP(start, &xformedStart);
+   ptr->mWorldToObj.mulP(end,   &xformedEnd);
+   xformedStart.convolveInverse(ptr->mObjScale);
+   xformedEnd.convolveInverse(ptr->mObjScale);
+
+   RayInfo ri;
+   ri.generateTexCoord  = info->generateTexCoord;
+   bool result = false;
+   if (type == CollisionGeometry)
+      result = ptr->castRay(xformedStart, xformedEnd, &ri);
+   else if (type == RenderedGeometry)
+      result = ptr->castRayRendered(xformedStart, xformedEnd, &ri);
+   if (result)
+   {
+      if( ri.t < currentT && ( !callback || callback( &ri ) ) )
+      {
+         *info = ri;
+         info->point.interpolate(start, end, info->t);
+         currentT = ri.t;
+         info->distance = (start - info->point).len();
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneContainer::castRayBatch( const RayQuery* queries, U32 count, RayInfo* outInfos, CastRayCallback callback )
+{
+   PROFILE_SCOPE( SceneContainer_CastRayBatch );
+
+   AssertFatal( csmRayPacketSize <= RayPacket::MaxRays, "SceneContainer::castRayBatch - Packet size too large" );
+
+   if ( !count )
+      return 0;
+
+   CollisionStats::count( CollisionStats::CastRay, this == &gServerContainer, count );
+
+   // Reset the results and sort the rays by the bin their midpoint falls
+   // into so that consecutive rays form spatially coherent packets.
+
+   Vector< RaySortEntry > order;
+   order.setSize( count );
+
+   Vector< F32 > currentT;
+   currentT.setSize( count );
+
+   for ( U32 i = 0; i < count; ++ i )
+   {
+      AssertFatal( outInfos[ i ].userData == NULL, "SceneContainer::castRayBatch - RayInfo->userData cannot be used here!" );
+
+      const bool generateTexCoord = outInfos[ i ].generateTexCoord;
+      outInfos[ i ] = RayInfo();
+      outInfos[ i ].generateTexCoord = generateTexCoord;
+
+      currentT[ i ] = 2.0f;
+
+      if ( _useStaticCollision( CollisionGeometry, &outInfos[ i ] ) )
+         _castRayStaticCollision( queries[ i ].start, queries[ i ].end, queries[ i ].mask, queries[ i ].ignore, &outInfos[ i ], callback, currentT[ i ] );
+
+      const Point3F mid = ( queries[ i ].start + queries[ i ].end ) * 0.5f;
+      order[ i ].index = i;
+      order[ i ].binX = S32( mFloor( mid.x / csmBinSize ) );
+      order[ i ].binY = S32( mFloor( mid.y / csmBinSize ) );
+   }
+
+   dQsort( order.address(), order.size(), sizeof( RaySortEntry ), cmpRaySortEntry );
+
+   Vector< SceneObject* > candidates;
+   RayPacket packet;
+
+   U32 next = 0;
+   while ( next < count )
+   {
+      // Gather the next packet.  Stop growing it when its bounds get
+      // too large for a container query to make sense.
+
+      packet.clear();
+
+      Box3F packetBox;
+      U32 packetMask = 0;
+
+      while ( next < count && packet.count < csmRayPacketSize )
+      {
+         const RayQuery& query = queries[ order[ next ].index ];
+
+         Box3F rayBox( query.start, query.end );
+         if ( packet.count )
+         {
+            Box3F grownBox = packetBox;
+            grownBox.intersect( rayBox );
+            if ( grownBox.len_x() > csmTotalBinSize || grownBox.len_y() > csmTotalBinSize )
+               break;
+            packetBox = grownBox;
+         }
+         else
+            packetBox = rayBox;
+
+         packetMask |= query.mask;
+         packet.add( order[ next ].index, query.start, query.end );
+         packet.maxT[ packet.count - 1 ] = getMin( currentT[ order[ next ].index ], 1.0f );
+         next ++;
+      }
+
+      packet.pad();
+
+      // Find everything the packet might hit and test each candidate
+      // object against all rays of the packet at once.
+
+      candidates.clear();
+      findObjectList( packetBox, packetMask, &candidates );
+
+      for ( U32 i = 0; i < candidates.size(); ++ i )
+      {
+         SceneObject* ptr = candidates[ i ];
+
+         const U32 hits = packet.intersect( ptr->getWorldBox() );
+         if ( !hits )
+            continue;
+
+         for ( U32 lane = 0; lane < packet.count; ++ lane )
+         {
+            if ( !( hits & ( 1 << lane ) ) )
+               continue;
+
+            const U32 ray = packet.index[ lane ];
+            const RayQuery& query = queries[ ray ];
+            if ( ( ptr->getTypeMask() & query.mask ) == 0 || ptr == query.ignore )
+               continue;
+
+            _castRayObject( CollisionGeometry, ptr, query.start, query.end, &outInfos[ ray ], callback, currentT[ ray ] );
+            packet.maxT[ lane ] = getMin( currentT[ ray ], 1.0f );
+         }
+      }
+   }
+
+   // Bump the normals into worldspace.
+
+   U32 numHits = 0;
+   for ( U32 i = 0; i < count; ++ i )
+   {
+      if ( currentT[ i ] == 2.0f )
+         continue;
+
+      RayInfo& info = outInfos[ i ];
+      numHits ++;
+
+      if ( info.object->mStaticCollisionIndex != -1 && _useStaticCollision( CollisionGeometry, &info ) )
+         continue;
+
+      PlaneF fakePlane;
+      fakePlane.x = info.normal.x;
+      fakePlane.y = info.normal.y;
+      fakePlane.z = info.normal.z;
+      fakePlane.d = 0;
+
+      PlaneF result;
+      mTransformPlane( info.object->getTransform(), info.object->getScale(), fakePlane, &result );
+      info.normal = result;
+   }
+
+   return numHits;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneContainer::bakeStaticCollision( const Vector< SceneObject* >& objects )
+{
+   PROFILE_SCOPE( SceneContainer_BakeStaticCollision );
+
+   clearStaticCollision();
+
+   StaticCollisionTree* tree = new StaticCollisionTree;
+   ConcretePolyList polyList;
+   SphereF dummySphere;
+
+   for ( U32 i = 0; i < objects.size(); ++ i )
+   {
+      SceneObject* object = objects[ i ];
+      AssertFatal( object->mContainer == this, "SceneContainer::bakeStaticCollision - Object is not in this container!" );
+
+      if ( object->mStaticCollisionIndex != -1 )
+         continue;
+
+      polyList.clear();
+      if ( !object->buildPolyList( PLC_RayCast, &polyList, object->getWorldBox(), dummySphere ) || polyList.isEmpty() )
+         continue;
+
+      const U32 objectIndex = mStaticCollisionObjects.size();
+      U32 materialIndex = 0;
+      BaseMatInstance* lastMaterial = NULL;
+
+      for ( U32 j = 0; j < polyList.mPolyList.size(); ++ j )
+      {
+         const ConcretePolyList::Poly& poly = polyList.mPolyList[ j ];
+         if ( poly.vertexCount < 3 )
+            continue;
+
+         // Consecutive polys mostly share their material.
+         if ( poly.material != lastMaterial || mStaticCollisionMaterials.empty() )
+         {
+            Vector< BaseMatInstance* >::iterator iter = find( mStaticCollisionMaterials.begin(), mStaticCollisionMaterials.end(), poly.material );
+            if ( iter == mStaticCollisionMaterials.end() )
+            {
+               materialIndex = mStaticCollisionMaterials.size();
+               mStaticCollisionMaterials.push_back( poly.material );
+            }
+            else
+               materialIndex = iter - mStaticCollisionMaterials.begin();
+
+            lastMaterial = poly.material;
+         }
+
+         // Polys are convex, so fan them out into triangles.
+         const Point3F normal( poly.plane.x, poly.plane.y, poly.plane.z );
+         const U32* indices = &polyList.mIndexList[ poly.vertexStart ];
+         const Point3F& v0 = polyList.mVertexList[ indices[ 0 ] ];
+         for ( U32 k = 2; k < poly.vertexCount; ++ k )
+            tree->addTriangle( v0, polyList.mVertexList[ indices[ k - 1 ] ], polyList.mVertexList[ indices[ k ] ], normal, objectIndex, materialIndex );
+      }
+
+      object->mStaticCollisionIndex = objectIndex;
+      mStaticCollisionObjects.push_back( object );
+      mNumStaticCollisionObjects ++;
+   }
+
+   if ( tree->isEmpty() )
+   {
+      delete tree;
+      clearStaticCollision();
+      return 0;
+   }
+
+   tree->build();
+   mStaticCollision = tree;
+
+   return tree->getTriangleCount();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainer::clearStaticCollision()
+{
+   for ( U32 i = 0; i < mStaticCollisionObjects.size(); ++ i )
+      if ( mStaticCollisionObjects[ i ] )
+         mStaticCollisionObjects[ i ]->mStaticCollisionIndex = -1;
+
+   mStaticCollisionObjects.clear();
+   mStaticCollisionMaterials.clear();
+   mNumStaticCollisionObjects = 0;
+   SAFE_DELETE( mStaticCollision );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainer::releaseStaticCollision( SceneObject* object )
+{
+   if ( object->mStaticCollisionIndex == -1 )
+      return;
+
+   AssertFatal( mStaticCollisionObjects[ object->mStaticCollisionIndex ] == object, "SceneContainer::releaseStaticCollision - Object index out of sync!" );
+
+   // The triangles stay in the tree but are filtered out
+   // by _castRayStaticCollision() from now on.
+   mStaticCollisionObjects[ object->mStaticCollisionIndex ] = NULL;
+   object->mStaticCollisionIndex = -1;
+
+   // Don't hold on to the tree once the level is gone.
+   if ( -- mNumStaticCollisionObjects == 0 )
+      clearStaticCollision();
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneContainer::_useStaticCollision( U32 type, const RayInfo* info ) const
+{
+   // The tree has no texture coordinates.
+   return mStaticCollision && type == CollisionGeometry && !info->generateTexCoord;
+}
+
+//-----------------------------------------------------------------------------
+
+/// State passed to the StaticCollisionTree hit filter.
+struct StaticCollisionFilter
+{
+   const Vector< SceneObject* >* objects;
+   const Vector< BaseMatInstance* >* materials;
+   U32 mask;
+   SceneObject* ignore;
+   SceneContainer::CastRayCallback callback;
+   const Point3F* start;
+   const Point3F* end;
+   RayInfo info;
+
+   /// Fill in #info from @a hit.
+   void setInfo( const StaticCollisionTree::RayHit& hit )
+   {
+      info = RayInfo();
+      info.t = hit.t;
+      info.object = ( *objects )[ hit.object ];
+      info.normal = hit.normal;
+      info.material = ( *materials )[ hit.material ];
+      info.point.interpolate( *start, *end, hit.t );
+      info.distance = ( *start - info.point ).len();
+   }
+
+   static bool accept( const StaticCollisionTree::RayHit& hit, void* userData )
+   {
+      StaticCollisionFilter* filter = reinterpret_cast< StaticCollisionFilter* >( userData );
+
+      // Objects are NULL once they changed and are tested individually.
+      SceneObject* object = ( *filter->objects )[ hit.object ];
+      if ( !object ||
+           object == filter->ignore ||
+           ( object->getTypeMask() & filter->mask ) == 0 ||
+           !object->isCollisionEnabled() )
+         return false;
+
+      if ( !filter->callback )
+         return true;
+
+      filter->setInfo( hit );
+      return filter->callback( &filter->info );
+   }
+};
+
+void SceneContainer::_castRayStaticCollision( const Point3F& start, const Point3F& end, U32 mask, SceneObject* ignore, RayInfo* info, CastRayCallback callback, F32& currentT )
+{
+   PROFILE_SCOPE( SceneContainer_CastRayStaticCollision );
+
+   StaticCollisionFilter filter;
+   filter.objects = &mStaticCollisionObjects;
+   filter.materials = &mStaticCollisionMaterials;
+   filter.mask = mask;
+   filter.ignore = ignore;
+   filter.callback = callback;
+   filter.start = &start;
+   filter.end = &end;
+
+   StaticCollisionTree::RayHit hit;
+   if ( !mStaticCollision->castRay( start, end, getMin( currentT, 1.0f ), &hit, &StaticCollisionFilter::accept, &filter ) )
+      return;
+
+   const bool generateTexCoord = info->generateTexCoord;
+   filter.setInfo( hit );
+   *info = filter.info;
+   info->generateTexCoord = generateTexCoord;
+   currentT = hit.t;
+}
+
+//-----------------------------------------------------------------------------
+
 // collide with the objects projected object box
 bool SceneContainer::collideBox(const Point3F &start, const Point3F &end, U32 mask, RayInfo * info)
 {
    AssertFatal( info->userData == NULL, "SceneContainer::collideBox - RayInfo->userData cannot be used here!" );
 
+   CollisionStats::count( CollisionStats::CastRay, this == &gServerContainer );
+
    F32 currentT = 2;
    for (Link* itr = mStart.next; itr != &mEnd; itr = itr->next)
    {
@@ -1149,6 +2044,8 @@ bool SceneContainer::collideBox(const Point3F &start, const Point3F &end, U32 ma
          xformedStart.convolveInverse(ptr->mObjScale);
          xformedEnd.convolveInverse(ptr->mObjScale);
 
+         CollisionStats::count( CollisionStats::ObjectCastRay, ptr );
+
          RayInfo ri;
          if(ptr->collideBox(xformedStart, xformedEnd, &ri))
          {
@@ -1169,11 +2066,14 @@ bool SceneContainer::collideBox(const Point3F &start, const Point3F &end, U32 ma
 static void buildCallback(SceneObject* object,void *key)
 {
    SceneContainer::CallbackInfo* info = reinterpret_cast<SceneContainer::CallbackInfo*>(key);
+   CollisionStats::count( CollisionStats::ObjectPolyList, object );
    object->buildPolyList(info->context,info->polyList,info->boundingBox,info->boundingSphere);
 }
 
 bool SceneContainer::buildPolyList(PolyListContext context, const Box3F &box, U32 mask, AbstractPolyList *polyList)
 {
+   CollisionStats::count( CollisionStats::PolyListQuery, this == &gServerContainer );
+
    CallbackInfo info;
    info.context = context;
    info.boundingBox = box;
@@ -1237,6 +2137,69 @@ static S32 QSORT_CALLBACK cmpSearchPointers(const void* inP1, const void* inP2)
       return 0;
 }
 
+namespace {
+
+struct RadiusSortEntry
+{
+   F32 dist;
+   SceneObject* object;
+};
+
+S32 QSORT_CALLBACK cmpRadiusSortEntry( const void* inP1, const void* inP2 )
+{
+   const F32 d1 = reinterpret_cast< const RadiusSortEntry* >( inP1 )->dist;
+   const F32 d2 = reinterpret_cast< const RadiusSortEntry* >( inP2 )->dist;
+
+   if ( d1 > d2 )
+      return 1;
+   else if ( d1 < d2 )
+      return -1;
+   else
+      return 0;
+}
+
+} // namespace {}
+
+void SceneContainer::findObjectsInRadius( const Point3F& point, F32 radius, U32 mask, Vector< SceneObject* >* outFound )
+{
+   PROFILE_SCOPE( SceneContainer_FindObjectsInRadius );
+
+   Box3F queryBox( point, point );
+   queryBox.minExtents -= Point3F( radius, radius, radius );
+   queryBox.maxExtents += Point3F( radius, radius, radius );
+
+   Vector< SceneObject* > candidates;
+   findObjectList( queryBox, mask, &candidates );
+
+   const F32 radiusSquared = radius * radius;
+
+   SmallVector< RadiusSortEntry, 32 > found;
+   found.reserve( candidates.size() );
+
+   for ( U32 i = 0; i < candidates.size(); ++ i )
+   {
+      SceneObject* object = candidates[ i ];
+      const Box3F& worldBox = object->getWorldBox();
+
+      if ( worldBox.getSqDistanceToPoint( point ) >= radiusSquared && !object->isGlobalBounds() )
+         continue;
+
+      RadiusSortEntry entry;
+      entry.dist = ( worldBox.getCenter() - point ).len();
+      entry.object = object;
+      found.push_back( entry );
+   }
+
+   if ( found.size() > 1 )
+      dQsort( found.address(), found.size(), sizeof( RadiusSortEntry ), cmpRadiusSortEntry );
+
+   outFound->reserve( outFound->size() + found.size() );
+   for ( U32 i = 0; i < found.size(); ++ i )
+      outFound->push_back( found[ i ].object );
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneContainer::initRadiusSearch(const Point3F& searchPoint,
                                  const F32      searchRadius,
                                  const U32      searchMask)
@@ -1245,41 +2208,13 @@ void SceneContainer::initRadiusSearch(const Point3F& searchPoint,
 
    mSearchReferencePoint = searchPoint;
 
-   Box3F queryBox(searchPoint, searchPoint);
-   queryBox.minExtents -= Point3F(searchRadius, searchRadius, searchRadius);
-   queryBox.maxExtents += Point3F(searchRadius, searchRadius, searchRadius);
-
-   SimpleQueryList queryList;
-   findObjects(queryBox, searchMask, SimpleQueryList::insertionCallback, &queryList);
-
-   F32 radiusSquared = searchRadius * searchRadius;
+   Vector< SceneObject* > found;
+   findObjectsInRadius( searchPoint, searchRadius, searchMask, &found );
 
-   const F32* pPoint = &searchPoint.x;
-   for (U32 i = 0; i < queryList.mList.size(); i++)
-   {
-      const F32* bMins;
-      const F32* bMaxs;
-      bMins = &queryList.mList[i]->getWorldBox().minExtents.x;
-      bMaxs = &queryList.mList[i]->getWorldBox().maxExtents.x;
-      F32 sum = 0;
-      for (U32 j = 0; j < 3; j++)
-      {
-         if (pPoint[j] < bMins[j])
-            sum += (pPoint[j] - bMins[j])*(pPoint[j] - bMins[j]);
-         else if (pPoint[j] > bMaxs[j])
-            sum += (pPoint[j] - bMaxs[j])*(pPoint[j] - bMaxs[j]);
-      }
-      if (sum < radiusSquared || queryList.mList[i]->isGlobalBounds())
-      {
-         mSearchList.push_back(new SimObjectPtr<SceneObject>);
-         *(mSearchList.last()) = queryList.mList[i];
-      }
-   }
-   if (mSearchList.size() != 0)
+   for (U32 i = 0; i < found.size(); i++)
    {
-      sgSortReferencePoint = mSearchReferencePoint;
-      dQsort(mSearchList.address(), mSearchList.size(),
-             sizeof(SimObjectPtr<SceneObject>*), cmpSearchPointers);
+      mSearchList.push_back(new SimObjectPtr<SceneObject>);
+      *(mSearchList.last()) = found[i];
    }
 }
 
@@ -1600,6 +2535,26 @@ DefineEngineFunction( containerSearchCurrRadiusDist, F32, ( bool useClientContai
 
 //-----------------------------------------------------------------------------
 
+DefineEngineFunction( setContainerIndexType, void, ( bool useOctree, bool useClientContainer ), ( false ),
+   "@brief Select the spatial index used by the scene container.\n\n"
+
+   "By default, the container uses a fixed, wrapping grid of bins.  For large worlds or "
+   "worlds with very uneven object density, a loose octree usually performs better.  "
+   "All objects currently in the container are rebinned.\n"
+
+   "@param useOctree If true, use a loose octree; otherwise use the bin grid.\n"
+   "@param useClientContainer Optionally indicates the client container should be "
+   "switched rather than the server container.\n"
+
+   "@ingroup Game")
+{
+   SceneContainer* pContainer = useClientContainer ? &gClientContainer : &gServerContainer;
+
+   pContainer->setIndexType( useOctree ? SceneContainer::LooseOctreeIndex : SceneContainer::GridIndex );
+}
+
+//-----------------------------------------------------------------------------
+
 //TODO: make RayInfo an API type
 DefineEngineFunction( containerRayCast, const char*,
    ( Point3F start, Point3F end, U32 mask, SceneObject *pExempt, bool useClientContainer ), ( nullAsType<SceneObject*>(), false ),
@@ -48,6 +48,14 @@
 #include "console/simObject.h"
 #endif
 
+#ifndef _SCENECONTAINEROCTREE_H_
+#include "scene/sceneContainerOctree.h"
+#endif
+
+#ifndef _SCENECONTAINERBOUNDS_H_
+#include "scene/sceneContainerBounds.h"
+#endif
+
 
 /// @file
 /// SceneObject database.
@@ -58,6 +66,8 @@ class AbstractPolyList;
 class OptimizedPolyList;
 class Frustum;
 class Point3F;
+class StaticCollisionTree;
+class BaseMatInstance;
 
 struct RayInfo;
 
@@ -109,7 +119,14 @@ enum PolyListContext
    /// A hint that the polyist will be used
    /// to export geometry and would like to have
    /// texture coords and materials.   
-   PLC_Export
+   PLC_Export,
+
+   /// A hint that the polylist is used to bake
+   /// the geometry that castRay() tests against.
+   /// Objects whose ray cast geometry cannot be
+   /// baked, e.g. because it is animated, should
+   /// return false.
+   PLC_RayCast
 };
 
 
@@ -138,7 +155,15 @@ class SimpleQueryList
 
 /// Database for SceneObjects.
 ///
-/// ScenceContainer implements a grid-based spatial subdivision for the contents of a scene.
+/// ScenceContainer implements a spatial subdivision for the contents of a scene.  By default,
+/// this is a wrapping grid of #csmNumBins x #csmNumBins bins.  This works well for small, evenly
+/// populated worlds but degrades to near-linear scans on large worlds where many objects hash
+/// into the same bins.  For these, the container can be switched to a loose octree (see
+/// setIndexType()) which makes query costs scale with local object density instead.
+///
+/// Queries (findObjects(), castRay() and friends) may run concurrently from any number of
+/// threads and may be nested, e.g. from within a query callback.  They must not, however,
+/// run concurrently with adding, removing or moving objects.
 class SceneContainer
 {
       enum CastRayType
@@ -147,8 +172,29 @@ class SceneContainer
          RenderedGeometry,
       };
 
+      struct OctreeRayVisitor;
+
    public:
 
+      enum
+      {
+         /// Number of queries that can run at the same time, whether
+         /// concurrently on different threads or nested from callbacks.
+         /// Every SceneObject stores one sequence key per slot.
+         MaxQuerySlots = 8
+      };
+
+      /// Spatial index used to store objects.
+      enum IndexType
+      {
+         /// Fixed-size wrapping grid with an overflow bin for large objects.
+         GridIndex,
+
+         /// Loose octree that grows with the world.  Objects with global bounds
+         /// still go into the overflow bin.
+         LooseOctreeIndex,
+      };
+
       struct Link
       {
          Link* next;
@@ -158,6 +204,51 @@ class SceneContainer
          void linkAfter(Link* ptr);
       };
 
+      /// A single ray cast by castRayBatch().
+      struct RayQuery
+      {
+         Point3F start;
+         Point3F end;
+
+         /// Object type mask (@see SimObjectTypes).
+         U32 mask;
+
+         /// Optional object this ray does not collide with.
+         SceneObject* ignore;
+
+         RayQuery()
+            :  mask( 0 ),
+               ignore( NULL )
+         {
+         }
+      };
+
+      /// Sequence key stamping for a single query.
+      ///
+      /// Queries that visit bins must make sure they only report objects once,
+      /// even if they are linked into several bins.  Each query claims one of
+      /// #MaxQuerySlots slots with its own sequence key and stamps the objects it
+      /// visits in that slot only, so queries do not interfere with each other
+      /// and need no global state.  If all slots are taken, the query yields
+      /// until one becomes free.
+      class QueryContext
+      {
+         protected:
+
+            SceneContainer* mContainer;
+            U32 mSlot;
+            U32 mSeqKey;
+
+         public:
+
+            QueryContext( SceneContainer* container );
+            ~QueryContext();
+
+            /// Return true if @a object has not been visited by this query
+            /// yet and mark it as visited.
+            inline bool visit( SceneObject* object );
+      };
+
       struct CallbackInfo 
       {
          PolyListContext context;
@@ -172,12 +263,12 @@ class SceneContainer
       Link mStart;
       Link mEnd;
 
-      /// Container queries based on #mCurrSeqKey are are not re-entrant;
-      /// this is used to detect when it happens.
-      bool mSearchInProgress;
+      /// Bitmask of sequence key slots currently held by a QueryContext.
+      volatile U32 mUsedQuerySlots;
 
-      /// Current sequence key.
-      U32 mCurrSeqKey;
+      /// Last sequence key handed out for each slot.  Only touched by the
+      /// query holding the slot.
+      U32 mQuerySeqKeys[ MaxQuerySlots ];
 
       SceneObjectRef* mFreeRefPool;
       Vector< SceneObjectRef* > mRefPoolBlocks;
@@ -192,10 +283,75 @@ class SceneContainer
       /// Vector that contains just the terrain objects in the container.
       Vector< SceneObject* > mTerrains;
 
+      /// Baked ray cast geometry of static objects or NULL.
+      StaticCollisionTree* mStaticCollision;
+
+      /// Objects referenced by the triangles in #mStaticCollision.  Entries
+      /// of objects that moved or changed since are NULL.
+      Vector< SceneObject* > mStaticCollisionObjects;
+
+      /// Materials referenced by the triangles in #mStaticCollision.
+      Vector< BaseMatInstance* > mStaticCollisionMaterials;
+
+      /// Number of non-NULL entries in #mStaticCollisionObjects.
+      U32 mNumStaticCollisionObjects;
+
+      /// Spatial index currently in use.
+      IndexType mIndexType;
+
+      /// Loose octree holding the objects when #mIndexType is LooseOctreeIndex.
+      SceneContainerOctree mOctree;
+
+      /// Packed world boxes of all objects in the container, independent
+      /// of the spatial index.
+      SceneContainerBounds mObjectBounds;
+
+      struct ChangeLogEntry
+      {
+         enum Kind
+         {
+            /// Object got added, moved or had its collision toggled.
+            Changed,
+
+            /// Object has been removed from the container since.  The
+            /// pointer must not be dereferenced.
+            Removed,
+
+            /// Only the position of the object within the spatial index
+            /// changed.  The pointer must not be dereferenced.
+            Reordered,
+         };
+
+         SceneObject* object;
+         Kind kind;
+      };
+
+      /// Whether changes are currently being recorded.
+      bool mChangeLogActive;
+
+      /// Id of the current change log.  Changes with every beginChangeLog().
+      U32 mChangeLogId;
+
+      /// Changes recorded while the change log is active.
+      Vector< ChangeLogEntry > mChangeLog;
+
+      /// Objects reordered by the octree during the last removal.
+      Vector< SceneObject* > mOctreeReordered;
+
+      void _logChange( SceneObject* object, ChangeLogEntry::Kind kind );
+
+      /// Move #mOctreeReordered into the change log.
+      void _logOctreeReordered();
+
       static const U32 csmNumBins;
       static const F32 csmBinSize;
       static const F32 csmTotalBinSize;
       static const U32 csmRefPoolBlockSize;
+      static const U32 csmRayPacketSize;
+
+      /// Water and physical zone searches scan #mWaterAndZones directly
+      /// while it holds no more than this many objects.
+      static const U32 csmMaxLinearWaterAndZones;
 
    public:
 
@@ -208,6 +364,16 @@ class SceneContainer
       /// Return a vector containing all terrain objects in this container.
       const Vector< SceneObject* >& getTerrains() const { return mTerrains; }
 
+      /// Return the spatial index currently used by the container.
+      IndexType getIndexType() const { return mIndexType; }
+
+      /// Switch the container to a different spatial index.  All objects
+      /// currently in the container are rebinned.
+      void setIndexType( IndexType type );
+
+      /// Return the packed world boxes of all objects in this container.
+      const SceneContainerBounds& getObjectBounds() const { return mObjectBounds; }
+
       /// @name Basic database operations
       /// @{
 
@@ -234,9 +400,17 @@ class SceneContainer
       ///
       void findObjectList( const Box3F& box, U32 mask, Vector< SceneObject* >* outFound );
 
-      ///
+      /// Find all objects of the given type(s) whose world box intersects
+      /// @a frustum and add them to the given vector.  This runs over the packed
+      /// world boxes of all objects rather than the spatial index.
       void findObjectList( const Frustum& frustum, U32 mask, Vector< SceneObject* >* outFound );
 
+      /// Find all objects of the given type(s) whose world box is within @a radius
+      /// of @a point and add them to the given vector, closest world box center first.
+      ///
+      /// Unlike initRadiusSearch(), this keeps no state in the container.
+      void findObjectsInRadius( const Point3F& point, F32 radius, U32 mask, Vector< SceneObject* >* outFound );
+
       /// @}
 
       /// @name Line intersection
@@ -252,6 +426,48 @@ class SceneContainer
 
       bool collideBox(const Point3F &start, const Point3F &end, U32 mask, RayInfo* info);
 
+      /// Test a batch of rays against collision geometry.
+      ///
+      /// Rays are sorted into spatially coherent packets that share a single container
+      /// query and every candidate object is culled against all rays of a packet at once.
+      /// This bounds the cost by the number of objects touched rather than the number of
+      /// rays issued, which pays off for large numbers of short, clustered rays such as
+      /// line-of-sight checks and weapon traces.
+      ///
+      /// @param queries Rays to cast.
+      /// @param count Number of entries in @a queries.
+      /// @param outInfos Receives one result per ray.  RayInfo::object is NULL for rays
+      ///   that did not hit anything.  RayInfo::generateTexCoord is honored on input.
+      /// @param callback Optional filter invoked for every candidate hit as with castRay().
+      /// @return The number of rays that hit something.
+      U32 castRayBatch( const RayQuery* queries, U32 count, RayInfo* outInfos, CastRayCallback callback = NULL );
+
+      /// @}
+
+      /// @name Static collision
+      ///
+      /// The ray cast geometry of static objects can be baked into a single
+      /// tree.  castRay() and castRayBatch() then test the tree once instead of
+      /// going through the bins and every object's own collision structures.
+      /// Objects that move or change their geometry afterwards drop out of the
+      /// tree and are tested individually again.
+      /// @{
+
+      /// Bake the ray cast geometry of @a objects, replacing any previously
+      /// baked geometry.  Objects are asked for it through buildPolyList() with
+      /// PLC_RayCast and are skipped if they return false.
+      /// @return The number of triangles baked.
+      U32 bakeStaticCollision( const Vector< SceneObject* >& objects );
+
+      /// Drop all baked geometry.
+      void clearStaticCollision();
+
+      /// Return true if there is baked geometry.
+      bool hasStaticCollision() const { return mStaticCollision != NULL; }
+
+      /// Stop using the baked geometry of @a object, e.g. because it changed.
+      void releaseStaticCollision( SceneObject* object );
+
       /// @}
 
       /// @name Poly list
@@ -285,6 +501,53 @@ class SceneContainer
       void checkBins( SceneObject* object );
       void insertIntoBins(SceneObject*, U32, U32, U32, U32);
 
+      /// @name Change Log
+      ///
+      /// While active, the change log records which objects got added,
+      /// removed, moved or had their collision toggled.  This allows checking
+      /// whether the result of a box query run ahead of time, e.g. from
+      /// ProcessObject::prepareTick(), still matches what the query would
+      /// return now.  Only to be used from the main thread.
+      /// @{
+
+      /// Clear the change log and start recording.
+      void beginChangeLog();
+
+      /// Stop recording changes.
+      void endChangeLog();
+
+      /// Return the id of the active change log or 0 if none is active.
+      U32 getChangeLogId() const { return mChangeLogActive ? mChangeLogId : 0; }
+
+      /// Return the number of changes recorded in the active change log.
+      U32 getChangeLogSize() const { return mChangeLog.size(); }
+
+      /// Record a change to @a object if the change log is active.
+      void logObjectChange( SceneObject* object )
+      {
+         if( mChangeLogActive )
+            _logChange( object, ChangeLogEntry::Changed );
+      }
+
+      /// Return true if findObjectList( @a box, @a mask ) would still give
+      /// @a result, in the same order.
+      ///
+      /// @param logId Id of the change log active when @a result was collected.
+      /// @param logSize Size of the change log when @a result was collected.
+      /// @param ignore Object whose collision will be disabled for the query or NULL.
+      ///   It must not be in @a result.
+      bool isQueryUnchanged( U32 logId, U32 logSize, const Box3F& box, U32 mask,
+                             const Vector< SceneObject* >& result, SceneObject* ignore = NULL ) const;
+
+      /// @}
+
+      /// @name Script Searches
+      ///
+      /// Stateful searches for the console.  These keep their results in the
+      /// container and must only be used from the main thread; use
+      /// findObjectsInRadius() and findObjectList() everywhere else.
+      /// @{
+
       void initRadiusSearch(const Point3F& searchPoint,
          const F32      searchRadius,
          const U32      searchMask);
@@ -294,6 +557,8 @@ class SceneContainer
       F32  containerSearchCurrDist();
       F32  containerSearchCurrRadiusDist();
 
+      /// @}
+
    private:
 
       Vector<SimObjectPtr<SceneObject>*>  mSearchList;///< Object searches to support console querying of the database.  ONLY WORKS ON SERVER
@@ -305,8 +570,27 @@ class SceneContainer
       /// Base cast ray code
       bool _castRay( U32 type, const Point3F &start, const Point3F &end, U32 mask, RayInfo* info, CastRayCallback callback );
 
+      /// Cast the ray against a single object and store the hit in @a info if
+      /// it is closer than @a currentT.
+      void _castRayObject( U32 type, SceneObject* ptr, const Point3F &start, const Point3F &end, RayInfo* info, CastRayCallback callback, F32& currentT );
+
+      /// Return true if a ray of the given type goes through the baked static
+      /// collision instead of testing the baked objects individually.
+      bool _useStaticCollision( U32 type, const RayInfo* info ) const;
+
+      /// Cast the ray against the baked static collision and store the hit in
+      /// @a info if it is closer than @a currentT.
+      void _castRayStaticCollision( const Point3F &start, const Point3F &end, U32 mask, SceneObject* ignore, RayInfo* info, CastRayCallback callback, F32& currentT );
+
+      /// Link @a object into the overflow bin.
+      void _insertIntoOverflowBin( SceneObject* object );
+
       void _findSpecialObjects( const Vector< SceneObject* >& vector, U32 mask, FindCallback, void *key = NULL );
-      void _findSpecialObjects( const Vector< SceneObject* >& vector, const Box3F &box, U32 mask, FindCallback callback, void *key = NULL );   
+      void _findSpecialObjects( const Vector< SceneObject* >& vector, const Box3F &box, U32 mask, FindCallback callback, void *key = NULL );
+
+      /// Find the water and physical zone objects overlapping @a box; uses the
+      /// spatial index once there are too many of them to scan.
+      void _findWaterAndZones( const Box3F& box, U32 mask, FindCallback callback, void* key );
 
       static void getBinRange( const F32 min, const F32 max, U32& minBin, U32& maxBin );
 public:
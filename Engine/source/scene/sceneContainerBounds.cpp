@@ -0,0 +1,126 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "scene/sceneContainerBounds.h"
+
+#include "scene/sceneObject.h"
+#include "math/mMathFn.h"
+
+
+//-----------------------------------------------------------------------------
+
+SceneContainerBounds::SceneContainerBounds()
+{
+   for( U32 i = 0; i < 6; ++ i )
+      VECTOR_SET_ASSOCIATION( mBounds[ i ] );
+   VECTOR_SET_ASSOCIATION( mObjects );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainerBounds::insert( SceneObject* object )
+{
+   AssertFatal( !contains( object ), "SceneContainerBounds::insert - Object already has an entry" );
+
+   const Box3F& box = object->getWorldBox();
+
+   object->mContainerBoundsIndex = mObjects.size();
+   mObjects.push_back( object );
+
+   mBounds[ 0 ].push_back( box.minExtents.x );
+   mBounds[ 1 ].push_back( box.minExtents.y );
+   mBounds[ 2 ].push_back( box.minExtents.z );
+   mBounds[ 3 ].push_back( box.maxExtents.x );
+   mBounds[ 4 ].push_back( box.maxExtents.y );
+   mBounds[ 5 ].push_back( box.maxExtents.z );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainerBounds::remove( SceneObject* object )
+{
+   const U32 index = object->mContainerBoundsIndex;
+   AssertFatal( index < mObjects.size() && mObjects[ index ] == object,
+      "SceneContainerBounds::remove - Object has no entry" );
+
+   // Move the last entry into the hole.
+
+   const U32 last = mObjects.size() - 1;
+   if( index != last )
+   {
+      mObjects[ index ] = mObjects[ last ];
+      mObjects[ index ]->mContainerBoundsIndex = index;
+
+      for( U32 i = 0; i < 6; ++ i )
+         mBounds[ i ][ index ] = mBounds[ i ][ last ];
+   }
+
+   mObjects.decrement();
+   for( U32 i = 0; i < 6; ++ i )
+      mBounds[ i ].decrement();
+
+   object->mContainerBoundsIndex = InvalidIndex;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainerBounds::update( SceneObject* object )
+{
+   const U32 index = object->mContainerBoundsIndex;
+   AssertFatal( index < mObjects.size() && mObjects[ index ] == object,
+      "SceneContainerBounds::update - Object has no entry" );
+
+   const Box3F& box = object->getWorldBox();
+
+   mBounds[ 0 ][ index ] = box.minExtents.x;
+   mBounds[ 1 ][ index ] = box.minExtents.y;
+   mBounds[ 2 ][ index ] = box.minExtents.z;
+   mBounds[ 3 ][ index ] = box.maxExtents.x;
+   mBounds[ 4 ][ index ] = box.maxExtents.y;
+   mBounds[ 5 ][ index ] = box.maxExtents.z;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneContainerBounds::contains( const SceneObject* object )
+{
+   return ( object->mContainerBoundsIndex != InvalidIndex );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainerBounds::cull( const PlaneF* planes, U32 numPlanes, Vector< U32 >& outVisible ) const
+{
+   const U32 numBoxes = mObjects.size();
+
+   outVisible.setSize( ( numBoxes + 31 ) / 32 );
+   if( !numBoxes )
+      return;
+
+   const F32* bounds[ 6 ];
+   for( U32 i = 0; i < 6; ++ i )
+      bounds[ i ] = mBounds[ i ].address();
+
+   m_box3F_planes_cull_soa( &planes[ 0 ].x, numPlanes, bounds, numBoxes, outVisible.address() );
+}
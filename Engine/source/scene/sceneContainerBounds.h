@@ -0,0 +1,120 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SCENECONTAINERBOUNDS_H_
+#define _SCENECONTAINERBOUNDS_H_
+
+#ifndef _MBOX_H_
+#include "math/mBox.h"
+#endif
+
+#ifndef _MPLANE_H_
+#include "math/mPlane.h"
+#endif
+
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+
+/// @file
+/// Packed world bounds of the objects in a SceneContainer.
+
+
+class SceneObject;
+
+
+/// Copies of the world boxes of all objects in a SceneContainer laid out
+/// as six component arrays (minimum x, y, z and maximum x, y, z) next to an
+/// array of the objects themselves.
+///
+/// Queries that have to look at every object can stream through these
+/// arrays and hand them as a whole to the bulk math kernels (see
+/// m_box3F_planes_cull_soa) instead of chasing object pointers and pulling
+/// each object's cache lines in just to read its box.
+///
+/// Every object stores its index into the arrays.  Removing an object moves
+/// the last entry into its place, so this changes the index of that one
+/// object only.  The container keeps the arrays in sync from its addObject(),
+/// removeObject() and checkBins() methods, i.e. whenever an object's
+/// transform or world box changes.
+class SceneContainerBounds
+{
+   public:
+
+      enum
+      {
+         /// Index used for objects that are not in the arrays.
+         InvalidIndex = 0xFFFFFFFF,
+      };
+
+   protected:
+
+      /// World box components of all objects.
+      Vector< F32 > mBounds[ 6 ];
+
+      /// Objects matching the entries in #mBounds.
+      Vector< SceneObject* > mObjects;
+
+   public:
+
+      SceneContainerBounds();
+
+      /// Append the world box of @a object.
+      void insert( SceneObject* object );
+
+      /// Remove the entry of @a object.
+      void remove( SceneObject* object );
+
+      /// Copy the current world box of @a object into its entry.
+      void update( SceneObject* object );
+
+      /// Return true if @a object has an entry.
+      static bool contains( const SceneObject* object );
+
+      /// Return the number of objects.
+      U32 size() const { return mObjects.size(); }
+
+      /// Return the object at @a index.
+      SceneObject* getObject( U32 index ) const { return mObjects[ index ]; }
+
+      /// Return the array of all objects.
+      SceneObject* const* getObjects() const { return mObjects.address(); }
+
+      /// Return the array holding component @a component of all world boxes
+      /// in the order min x, y, z, max x, y, z.
+      const F32* getBounds( U32 component ) const { return mBounds[ component ].address(); }
+
+      /// Return the world box stored at @a index.
+      Box3F getBox( U32 index ) const
+      {
+         return Box3F( mBounds[ 0 ][ index ], mBounds[ 1 ][ index ], mBounds[ 2 ][ index ],
+                       mBounds[ 3 ][ index ], mBounds[ 4 ][ index ], mBounds[ 5 ][ index ] );
+      }
+
+      /// Test all boxes against the given planes and set bit i of
+      /// @a outVisible for every box i that is not fully behind one of them.
+      void cull( const PlaneF* planes, U32 numPlanes, Vector< U32 >& outVisible ) const;
+};
+
+#endif // !_SCENECONTAINERBOUNDS_H_
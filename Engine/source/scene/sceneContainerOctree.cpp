@@ -0,0 +1,365 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "scene/sceneContainerOctree.h"
+
+#include "scene/sceneObject.h"
+#include "platform/profiler.h"
+
+
+//-----------------------------------------------------------------------------
+
+SceneContainerOctree::SceneContainerOctree( F32 minNodeSize, F32 initialRootSize )
+   : mRoot( InvalidIndex ),
+     mMinHalfSize( minNodeSize * 0.5f ),
+     mInitialHalfSize( getMax( initialRootSize, minNodeSize ) * 0.5f ),
+     mNumObjects( 0 ),
+     mReorderLog( NULL )
+{
+   AssertFatal( minNodeSize > 0.0f, "SceneContainerOctree - Invalid minimum node size" );
+
+   VECTOR_SET_ASSOCIATION( mNodes );
+   VECTOR_SET_ASSOCIATION( mFreeNodes );
+}
+
+//-----------------------------------------------------------------------------
+
+SceneContainerOctree::~SceneContainerOctree()
+{
+   clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainerOctree::clear()
+{
+   for( U32 i = 0; i < mNodes.size(); ++ i )
+   {
+      Node* node = mNodes[ i ];
+      if( !node )
+         continue;
+
+      for( U32 n = 0; n < node->objects.size(); ++ n )
+      {
+         node->objects[ n ]->mOctreeNode = InvalidIndex;
+         node->objects[ n ]->mOctreeSlot = InvalidIndex;
+      }
+
+      delete node;
+   }
+
+   mNodes.clear();
+   mFreeNodes.clear();
+   mRoot = InvalidIndex;
+   mNumObjects = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneContainerOctree::_allocNode( const Point3F& center, F32 halfSize, U32 parent )
+{
+   Node* node = new Node;
+   node->center = center;
+   node->halfSize = halfSize;
+   node->parent = parent;
+   node->numChildren = 0;
+   for( U32 i = 0; i < 8; ++ i )
+      node->children[ i ] = InvalidIndex;
+
+   U32 index;
+   if( !mFreeNodes.empty() )
+   {
+      index = mFreeNodes.last();
+      mFreeNodes.pop_back();
+      mNodes[ index ] = node;
+   }
+   else
+   {
+      index = mNodes.size();
+      mNodes.push_back( node );
+   }
+
+   return index;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainerOctree::_freeNode( U32 index )
+{
+   AssertFatal( mNodes[ index ] != NULL, "SceneContainerOctree::_freeNode - Node already freed" );
+   AssertFatal( mNodes[ index ]->objects.empty(), "SceneContainerOctree::_freeNode - Node still has objects" );
+
+   delete mNodes[ index ];
+   mNodes[ index ] = NULL;
+   mFreeNodes.push_back( index );
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneContainerOctree::_getOctant( const Node* node, const Point3F& point )
+{
+   U32 octant = 0;
+   if( point.x >= node->center.x )
+      octant |= 1;
+   if( point.y >= node->center.y )
+      octant |= 2;
+   if( point.z >= node->center.z )
+      octant |= 4;
+   return octant;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainerOctree::_getObjectExtents( const SceneObject* object, Point3F& outCenter, F32& outHalfExtent )
+{
+   const Box3F& box = object->getWorldBox();
+   box.getCenter( &outCenter );
+   outHalfExtent = getMax( getMax( box.len_x(), box.len_y() ), box.len_z() ) * 0.5f;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneContainerOctree::_growRoot( const Point3F& point, F32 halfExtent )
+{
+   const F32 maxHalfSize = mMinHalfSize * F32( 1 << ( MaxDepth - 1 ) );
+   if( halfExtent > maxHalfSize )
+      return false;
+
+   if( mRoot == InvalidIndex )
+   {
+      F32 halfSize = mInitialHalfSize;
+      while( halfSize < halfExtent )
+         halfSize *= 2.0f;
+
+      mRoot = _allocNode( Point3F::Zero, halfSize, InvalidIndex );
+   }
+
+   while( true )
+   {
+      Node* root = mNodes[ mRoot ];
+
+      if( halfExtent <= root->halfSize &&
+          mFabs( point.x - root->center.x ) <= root->halfSize &&
+          mFabs( point.y - root->center.y ) <= root->halfSize &&
+          mFabs( point.z - root->center.z ) <= root->halfSize )
+         return true;
+
+      if( root->halfSize * 2.0f > maxHalfSize )
+         return false;
+
+      // An empty root can simply be moved over to the point.
+
+      if( root->objects.empty() && !root->numChildren )
+      {
+         root->center = point;
+         while( root->halfSize < halfExtent )
+            root->halfSize *= 2.0f;
+         continue;
+      }
+
+      // Otherwise put a new root on top of the current one that extends
+      // the tree towards the point.
+
+      Point3F newCenter = root->center;
+      U32 oldRootOctant = 0;
+
+      if( point.x >= root->center.x )
+         newCenter.x += root->halfSize;
+      else
+      {
+         newCenter.x -= root->halfSize;
+         oldRootOctant |= 1;
+      }
+
+      if( point.y >= root->center.y )
+         newCenter.y += root->halfSize;
+      else
+      {
+         newCenter.y -= root->halfSize;
+         oldRootOctant |= 2;
+      }
+
+      if( point.z >= root->center.z )
+         newCenter.z += root->halfSize;
+      else
+      {
+         newCenter.z -= root->halfSize;
+         oldRootOctant |= 4;
+      }
+
+      const U32 newRoot = _allocNode( newCenter, root->halfSize * 2.0f, InvalidIndex );
+      mNodes[ newRoot ]->children[ oldRootOctant ] = mRoot;
+      mNodes[ newRoot ]->numChildren = 1;
+      root->parent = newRoot;
+      mRoot = newRoot;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneContainerOctree::_findInsertNode( const Point3F& center, F32 halfExtent )
+{
+   if( !_growRoot( center, halfExtent ) )
+      return InvalidIndex;
+
+   U32 index = mRoot;
+   while( true )
+   {
+      Node* node = mNodes[ index ];
+
+      const F32 childHalfSize = node->halfSize * 0.5f;
+      if( childHalfSize < halfExtent || childHalfSize < mMinHalfSize )
+         return index;
+
+      const U32 octant = _getOctant( node, center );
+      if( node->children[ octant ] == InvalidIndex )
+      {
+         Point3F childCenter = node->center;
+         childCenter.x += ( octant & 1 ) ? childHalfSize : -childHalfSize;
+         childCenter.y += ( octant & 2 ) ? childHalfSize : -childHalfSize;
+         childCenter.z += ( octant & 4 ) ? childHalfSize : -childHalfSize;
+
+         const U32 child = _allocNode( childCenter, childHalfSize, index );
+
+         // _allocNode may have reallocated mNodes but nodes themselves
+         // stay put so 'node' is still valid.
+         node->children[ octant ] = child;
+         node->numChildren ++;
+      }
+
+      index = node->children[ octant ];
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainerOctree::_pruneNode( U32 index )
+{
+   while( index != mRoot )
+   {
+      Node* node = mNodes[ index ];
+      if( !node->objects.empty() || node->numChildren )
+         return;
+
+      const U32 parent = node->parent;
+      Node* parentNode = mNodes[ parent ];
+
+      const U32 octant = _getOctant( parentNode, node->center );
+      AssertFatal( parentNode->children[ octant ] == index, "SceneContainerOctree::_pruneNode - Broken parent link" );
+
+      parentNode->children[ octant ] = InvalidIndex;
+      parentNode->numChildren --;
+
+      _freeNode( index );
+      index = parent;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneContainerOctree::contains( const SceneObject* object )
+{
+   return ( object->mOctreeNode != InvalidIndex );
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneContainerOctree::insert( SceneObject* object )
+{
+   AssertFatal( !contains( object ), "SceneContainerOctree::insert - Object already in tree" );
+
+   Point3F center;
+   F32 halfExtent;
+   _getObjectExtents( object, center, halfExtent );
+
+   if( mIsNaN_F( halfExtent ) || mIsNaN_F( center.x ) || mIsNaN_F( center.y ) || mIsNaN_F( center.z ) )
+      return false;
+
+   const U32 index = _findInsertNode( center, halfExtent );
+   if( index == InvalidIndex )
+      return false;
+
+   Node* node = mNodes[ index ];
+   object->mOctreeNode = index;
+   object->mOctreeSlot = node->objects.size();
+   node->objects.push_back( object );
+
+   mNumObjects ++;
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneContainerOctree::remove( SceneObject* object )
+{
+   AssertFatal( contains( object ), "SceneContainerOctree::remove - Object not in tree" );
+
+   const U32 index = object->mOctreeNode;
+   Node* node = mNodes[ index ];
+
+   const U32 slot = object->mOctreeSlot;
+   AssertFatal( slot < node->objects.size() && node->objects[ slot ] == object,
+      "SceneContainerOctree::remove - Object slot is out of date" );
+
+   node->objects.erase_fast( slot );
+   if( slot < node->objects.size() )
+   {
+      node->objects[ slot ]->mOctreeSlot = slot;
+      if( mReorderLog )
+         mReorderLog->push_back( node->objects[ slot ] );
+   }
+
+   object->mOctreeNode = InvalidIndex;
+   object->mOctreeSlot = InvalidIndex;
+   mNumObjects --;
+
+   _pruneNode( index );
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneContainerOctree::update( SceneObject* object )
+{
+   if( !contains( object ) )
+      return insert( object );
+
+   const Node* node = mNodes[ object->mOctreeNode ];
+
+   Point3F center;
+   F32 halfExtent;
+   _getObjectExtents( object, center, halfExtent );
+
+   // Stay put if we are still enclosed by the loose bounds of our node
+   // and have not become small enough to move further down the tree.
+
+   const F32 childHalfSize = node->halfSize * 0.5f;
+   const bool wouldDescend = ( childHalfSize >= halfExtent && childHalfSize >= mMinHalfSize );
+
+   if( !wouldDescend && node->getLooseBounds().isContained( object->getWorldBox() ) )
+      return true;
+
+   PROFILE_SCOPE( SceneContainerOctree_Rebin );
+
+   remove( object );
+   return insert( object );
+}
@@ -0,0 +1,227 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENECONTAINEROCTREE_H_
+#define _SCENECONTAINEROCTREE_H_
+
+#ifndef _MBOX_H_
+#include "math/mBox.h"
+#endif
+
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+
+/// @file
+/// Loose octree spatial index used by SceneContainer.
+
+
+class SceneObject;
+
+
+/// A loose octree over the world boxes of SceneObjects.
+///
+/// Every object is stored in exactly one node.  On insertion, this is the
+/// deepest node whose cell contains the center of the object's world box and
+/// whose half size is at least the largest half-extent of that box.  Since the
+/// bounds of a node are "loose" (twice the size of its cell), the object is
+/// then fully enclosed by the loose bounds of its node.  Moving objects stay
+/// in their node for as long as this still holds, which keeps small movements
+/// from constantly rebinning objects across cell boundaries.
+///
+/// The root grows on demand towards objects that are inserted outside of it,
+/// so the tree does not need to know the size of the world up front.  Nodes
+/// are created lazily on insertion and pruned again when they run empty.
+///
+/// Objects that are too large to fit into even the largest root the tree is
+/// allowed to grow to are rejected by insert() and must be handled by the
+/// caller (SceneContainer puts them in its overflow bin).
+class SceneContainerOctree
+{
+   public:
+
+      enum
+      {
+         /// Index used for objects that are not in the tree.
+         InvalidIndex = 0xFFFFFFFF,
+
+         /// Maximum number of levels the tree may have.  Bounds both the
+         /// size the root may grow to and the traversal stack.
+         MaxDepth = 24,
+      };
+
+      struct Node
+      {
+         /// Center of the node's cell.
+         Point3F center;
+
+         /// Half the size of the node's cell.  The loose bounds of the
+         /// node extend twice this far from #center.
+         F32 halfSize;
+
+         /// Index of the parent node or InvalidIndex for the root.
+         U32 parent;
+
+         /// Child node indices or InvalidIndex.  The octant of a child
+         /// is encoded as bit 0 = +x, bit 1 = +y, bit 2 = +z.
+         U32 children[ 8 ];
+
+         /// Number of non-empty children.
+         U32 numChildren;
+
+         /// Objects stored directly in this node.
+         Vector< SceneObject* > objects;
+
+         /// Loose bounds of the node.
+         Box3F getLooseBounds() const
+         {
+            const F32 looseHalf = halfSize * 2.0f;
+            return Box3F( center.x - looseHalf, center.y - looseHalf, center.z - looseHalf,
+                          center.x + looseHalf, center.y + looseHalf, center.z + looseHalf );
+         }
+      };
+
+   protected:
+
+      /// All nodes, including freed ones.  Nodes are heap-allocated
+      /// individually so that their addresses stay stable.
+      Vector< Node* > mNodes;
+
+      /// Indices of freed slots in #mNodes.
+      Vector< U32 > mFreeNodes;
+
+      /// Index of the current root node.
+      U32 mRoot;
+
+      /// Half size of the smallest cell we will subdivide down to.
+      F32 mMinHalfSize;
+
+      /// Half size of the root at construction time.
+      F32 mInitialHalfSize;
+
+      /// Number of objects in the tree.
+      U32 mNumObjects;
+
+      /// If set, objects that change position within their node because
+      /// another object got removed from it are appended here.
+      Vector< SceneObject* >* mReorderLog;
+
+      U32 _allocNode( const Point3F& center, F32 halfSize, U32 parent );
+      void _freeNode( U32 index );
+
+      /// Grow the root until its cell contains @a point and it is big enough
+      /// to hold an object with the given half-extent.
+      /// @return False if the tree would exceed MaxDepth.
+      bool _growRoot( const Point3F& point, F32 halfExtent );
+
+      /// Find (creating as needed) the node an object with the given
+      /// center and half-extent belongs into.
+      U32 _findInsertNode( const Point3F& center, F32 halfExtent );
+
+      /// Release @a index and all empty parents.
+      void _pruneNode( U32 index );
+
+      static U32 _getOctant( const Node* node, const Point3F& point );
+      static void _getObjectExtents( const SceneObject* object, Point3F& outCenter, F32& outHalfExtent );
+
+   public:
+
+      /// @param minNodeSize Size of the smallest cell the tree will subdivide to.
+      /// @param initialRootSize Size of the initial root cell centered on the origin.
+      SceneContainerOctree( F32 minNodeSize = 16.0f, F32 initialRootSize = 1024.0f );
+      ~SceneContainerOctree();
+
+      /// Insert @a object into the tree.
+      /// @return False if the object cannot be represented by the tree.
+      bool insert( SceneObject* object );
+
+      /// Remove @a object from the tree.
+      void remove( SceneObject* object );
+
+      /// Move @a object to the node matching its current world box.  Does
+      /// nothing if the object still belongs into the node it is in.
+      /// @return False if the object no longer fits the tree in which case it
+      ///   has been removed from it.
+      bool update( SceneObject* object );
+
+      /// Return true if @a object is currently stored in the tree.
+      static bool contains( const SceneObject* object );
+
+      /// Remove all objects and nodes.
+      void clear();
+
+      /// Return the number of objects in the tree.
+      U32 getNumObjects() const { return mNumObjects; }
+
+      /// Set the vector that objects are appended to when their order within
+      /// a node changes, or NULL to stop recording.
+      void setReorderLog( Vector< SceneObject* >* log ) { mReorderLog = log; }
+
+      /// Return the number of nodes currently allocated.
+      U32 getNumNodes() const { return mNodes.size() - mFreeNodes.size(); }
+
+      /// Walk the tree and invoke @a visitor for every object in every node
+      /// whose loose bounds pass @a nodeTest.
+      ///
+      /// @param nodeTest Functor with a "bool operator()( const Box3F& )" that
+      ///   decides whether a node should be visited based on its loose bounds.
+      /// @param visitor Functor with a "void operator()( SceneObject* )".
+      template< typename NodeTest, typename Visitor >
+      void traverse( NodeTest& nodeTest, Visitor& visitor ) const;
+};
+
+//-----------------------------------------------------------------------------
+
+template< typename NodeTest, typename Visitor >
+void SceneContainerOctree::traverse( NodeTest& nodeTest, Visitor& visitor ) const
+{
+   if( mRoot == InvalidIndex )
+      return;
+
+   // Each level can at most push 8 children while we pop one.
+   U32 stack[ MaxDepth * 8 + 1 ];
+   U32 stackSize = 0;
+
+   stack[ stackSize ++ ] = mRoot;
+   while( stackSize )
+   {
+      const Node* node = mNodes[ stack[ -- stackSize ] ];
+      if( !nodeTest( node->getLooseBounds() ) )
+         continue;
+
+      for( U32 i = 0; i < node->objects.size(); ++ i )
+         visitor( node->objects[ i ] );
+
+      if( !node->numChildren )
+         continue;
+
+      for( U32 i = 0; i < 8; ++ i )
+         if( node->children[ i ] != InvalidIndex )
+         {
+            AssertFatal( stackSize < ( sizeof( stack ) / sizeof( stack[ 0 ] ) ), "SceneContainerOctree::traverse - Stack overflow" );
+            stack[ stackSize ++ ] = node->children[ i ];
+         }
+   }
+}
+
+#endif // !_SCENECONTAINEROCTREE_H_
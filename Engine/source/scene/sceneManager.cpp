@@ -24,6 +24,7 @@
 #include "scene/sceneManager.h"
 
 #include "scene/sceneObject.h"
+#include "scene/sceneScopeGrid.h"
 #include "scene/zones/sceneTraversalState.h"
 #include "scene/sceneRenderState.h"
 #include "scene/zones/sceneRootZone.h"
@@ -70,14 +71,39 @@ MODULE_BEGIN( Scene )
          "Used to disable the somewhat expensive terrain occlusion testing.\n"
          "@ingroup Rendering\n" );
 
+      Con::addVariable( "$Scene::useTerrainOcclusionBuffer", TypeBool, &SceneCullingState::smUseTerrainOcclusionBuffer,
+         "If true, terrain occlusion rasterizes a coarse version of the terrains into a small depth buffer on the CPU "
+         "and tests object bounds against it.  Otherwise objects are tested with raycasts against the terrain.\n\n"
+         "@ingroup Rendering\n" );
+
       Con::addVariable( "$Scene::disableZoneCulling", TypeBool, &SceneCullingState::smDisableZoneCulling,
          "If true, zone culling will be disabled and the scene contents will only be culled against the root frustum.\n\n"
          "@ingroup Rendering\n" );
 
+      Con::addVariable( "$Scene::cacheZoneTraversals", TypeBool, &SceneZoneSpaceManager::smCacheTraversals,
+         "If true, the results of zone and portal traversals are reused by passes and frames that render "
+         "from exactly the same viewpoint as long as no zone spaces or occluders have changed.\n\n"
+         "@ingroup Rendering\n" );
+
       Con::addVariable( "$Scene::renderBoundingBoxes", TypeBool, &SceneManager::smRenderBoundingBoxes,
          "If true, the bounding boxes of objects will be displayed.\n\n"
          "@ingroup Rendering" );
 
+      Con::addVariable( "$Scene::useScopeGrid", TypeBool, &SceneManager::smUseScopeGrid,
+         "If true, network scoping uses an interest grid over the server scene that is shared by all "
+         "connections instead of running a container query per connection.\n\n"
+         "@ingroup Networking" );
+
+      Con::addVariable( "$Scene::scopeGridCellSize", TypeF32, &SceneScopeGrid::smCellSize,
+         "Edge length in world units of the cells of the network scoping grid.\n\n"
+         "@ingroup Networking" );
+
+      Con::addVariable( "$Scene::scopeHysteresis", TypeF32, &SceneScopeGrid::smHysteresis,
+         "Fraction of the scope distance that objects already ghosted to a connection may move beyond it "
+         "before they go out of scope.  Keeps objects at the edge of the scope distance from being ghosted "
+         "and killed over and over.  Only used with $Scene::useScopeGrid.\n\n"
+         "@ingroup Networking" );
+
       Con::addVariable( "$Scene::maxOccludersPerZone", TypeS32, &SceneCullingState::smMaxOccludersPerZone,
          "Maximum number of occluders that will be concurrently allowed into the scene culling state of any given zone.\n\n"
          "@ingroup Rendering" );
@@ -101,6 +127,8 @@ MODULE_END;
 
 
 bool SceneManager::smRenderBoundingBoxes;
+bool SceneManager::smUseScopeGrid = true;
+SceneManager::AmbientLightQuery SceneManager::smAmbientLightQuery;
 bool SceneManager::smLockDiffuseFrustum = false;
 SceneCameraState SceneManager::smLockedDiffuseCamera = SceneCameraState( RectI(), Frustum(), MatrixF(), MatrixF() );
 
@@ -113,6 +141,7 @@ SceneManager* gServerSceneGraph = NULL;
 SceneManager::SceneManager( bool isClient )
    : mIsClient( isClient ),
      mZoneManager( NULL ),
+     mScopeGrid( NULL ),
      mUsePostEffectFog( true ),
      mDisplayTargetResolution( 0, 0 ),
      mCurrentRenderState( NULL ),
@@ -121,7 +150,8 @@ SceneManager::SceneManager( bool isClient )
      mNearClip( 0.1f ),
      mLightManager( NULL ),
      mAmbientLightColor( LinearColorF( 0.1f, 0.1f, 0.1f, 1.0f ) ),
-     mDefaultRenderPass( NULL )
+     mDefaultRenderPass( NULL ),
+     mObjectCandidates( NULL )
 {
    VECTOR_SET_ASSOCIATION( mBatchQueryList );
 
@@ -135,6 +165,8 @@ SceneManager::SceneManager( bool isClient )
 
       addObjectToScene( mZoneManager->getRootZone() );
    }
+   else
+      mScopeGrid = new SceneScopeGrid();
 }
 
 //-----------------------------------------------------------------------------
@@ -142,6 +174,7 @@ SceneManager::SceneManager( bool isClient )
 SceneManager::~SceneManager()
 {   
    SAFE_DELETE( mZoneManager );
+   SAFE_DELETE( mScopeGrid );
 
    if( mLightManager )
       mLightManager->deactivate();   
@@ -217,6 +250,9 @@ void SceneManager::renderScene( SceneRenderState* renderState, U32 objectMask, S
       LinearColorF zoneAmbient;
       if( baseObject && baseObject->getZoneAmbientLightColor( baseZone, zoneAmbient ) )
          mAmbientLightColor.setTargetValue( zoneAmbient );
+      else if( mIsClient && !smAmbientLightQuery.empty() &&
+               smAmbientLightQuery( renderState->getCameraPosition(), &zoneAmbient ) )
+         mAmbientLightColor.setTargetValue( zoneAmbient );
       else
       {
          const LightInfo* sunlight = LIGHTMGR->getSpecialLight( LightManager::slSunLightType );
@@ -384,16 +420,24 @@ void SceneManager::_renderScene( SceneRenderState* state, U32 objectMask, SceneZ
             AssertFatal( baseObject != NULL, "SceneManager::_renderScene - findZone() did not return an object" );
          }
 
-         // Traverse zones starting in base object.
+         // Traverse zones starting in base object unless an earlier pass
+         // or frame has already done so from the exact same viewpoint.
+
+         Box3F traversedArea;
+         if( !getZoneManager()->restoreTraversal( &state->getCullingState(), baseObject, baseZone, traversedArea ) )
+         {
+            SceneTraversalState traversalState( &state->getCullingState() );
+            PROFILE_START( Scene_traverseZones );
+            baseObject->traverseZones( &traversalState, baseZone );
+            PROFILE_END();
 
-         SceneTraversalState traversalState( &state->getCullingState() );
-         PROFILE_START( Scene_traverseZones );
-         baseObject->traverseZones( &traversalState, baseZone );
-         PROFILE_END();
+            traversedArea = traversalState.getTraversedArea();
+            getZoneManager()->storeTraversal( &state->getCullingState(), baseObject, baseZone, traversedArea );
+         }
 
          // Set the scene render box to the area we have traversed.
 
-         state->setRenderArea( traversalState.getTraversedArea() );
+         state->setRenderArea( traversedArea );
       }
    }
 
@@ -431,7 +475,23 @@ void SceneManager::_renderScene( SceneRenderState* state, U32 objectMask, SceneZ
    // Gather all objects that intersect the scene render box.
 
    mBatchQueryList.clear();
-   getContainer()->findObjectList( queryBox, objectMask, &mBatchQueryList );
+
+   if(   mObjectCandidates &&
+         ( objectMask & ~mObjectCandidates->typeMask ) == 0 &&
+         mObjectCandidates->bounds.isContained( queryBox ) )
+   {
+      // Filter the shared candidates rather than walking
+      // the container bins again.
+      const Vector< SceneObject* >& candidates = mObjectCandidates->objects;
+      for( U32 i = 0; i < candidates.size(); ++ i )
+      {
+         SceneObject* object = candidates[ i ];
+         if( ( object->getTypeMask() & objectMask ) && object->getWorldBox().isOverlapped( queryBox ) )
+            mBatchQueryList.push_back( object );
+      }
+   }
+   else
+      getContainer()->findObjectList( queryBox, objectMask, &mBatchQueryList );
 
    // Cull the list.
 
@@ -518,6 +578,18 @@ void SceneManager::_renderScene( SceneRenderState* state, U32 objectMask, SceneZ
 
 //-----------------------------------------------------------------------------
 
+void SceneManager::gatherObjectCandidates( const Box3F &bounds, U32 objectMask, ObjectCandidates *outCandidates )
+{
+   PROFILE_SCOPE( SceneManager_gatherObjectCandidates );
+
+   outCandidates->bounds = bounds;
+   outCandidates->typeMask = objectMask;
+   outCandidates->objects.clear();
+   getContainer()->findObjectList( bounds, objectMask, &outCandidates->objects );
+}
+
+//-----------------------------------------------------------------------------
+
 struct ScopingInfo
 {
    Point3F        scopePoint;
@@ -562,6 +634,12 @@ void SceneManager::scopeScene( CameraScopeQuery* query, NetConnection* netConnec
    //
    // So, we perform a simple box query on the area covered by the camera query
    // and then scope in everything that is in range.
+
+   if( smUseScopeGrid && mScopeGrid )
+   {
+      mScopeGrid->scopeObjects( getContainer(), query->pos, query->visibleDistance, netConnection );
+      return;
+   }
    
    // Set up scoping info.
 
@@ -590,6 +668,9 @@ bool SceneManager::addObjectToScene( SceneObject* object )
 
    object->mSceneManager = this;
 
+   if( mScopeGrid )
+      mScopeGrid->markDirty();
+
    // Register with managers except its the root zone.
 
    if( !dynamic_cast< SceneRootZone* >( object ) )
@@ -630,6 +711,9 @@ void SceneManager::removeObjectFromScene( SceneObject* obj )
    if( getZoneManager() )
       getZoneManager()->unregisterObject( obj );
 
+   if( mScopeGrid )
+      mScopeGrid->markDirty();
+
    // Clear out the reference to us.
 
    obj->mSceneManager = NULL;
@@ -644,6 +728,9 @@ void SceneManager::notifyObjectDirty( SceneObject* object )
    if( object->mContainer )
       object->mContainer->checkBins( object );
 
+   if( mScopeGrid )
+      mScopeGrid->markDirty();
+
    // Mark zoning state as dirty.
 
    if( getZoneManager() )
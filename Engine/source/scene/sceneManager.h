@@ -61,6 +61,7 @@
 
 
 class LightManager;
+class SceneScopeGrid;
 class SceneRootZone;
 class SceneRenderState;
 class SceneCameraState;
@@ -109,6 +110,14 @@ class SceneManager
       /// A signal used to notify of render passes.
       typedef Signal< void( SceneManager*, const SceneRenderState* ) > RenderSignal;
 
+      /// Looks up the ambient light color at a point for areas without
+      /// a zone specific ambient color.  Returns false if there is none.
+      typedef Delegate< bool( const Point3F &position, LinearColorF *outColor ) > AmbientLightQuery;
+
+      /// Set by systems providing baked ambient lighting.  It is queried
+      /// at the camera position of diffuse passes.
+      static AmbientLightQuery smAmbientLightQuery;
+
       /// If true use the last stored locked frustum for culling
       /// the diffuse render pass.
       /// @see smLockedDiffuseFrustum
@@ -117,10 +126,29 @@ class SceneManager
       /// If true, render the AABBs of objects for debugging.
       static bool smRenderBoundingBoxes;
 
+      /// If true, scopeScene() uses the shared SceneScopeGrid rather than
+      /// running a container query for every connection.
+      static bool smUseScopeGrid;
+
       //A cache list of objects that made it through culling, so we don't have to attempt to re-test
       //visibility of objects later.
       Vector< SceneObject* > mRenderedObjectsList;
 
+      /// Objects gathered with a single container query to be shared
+      /// by several renders within its bounds, like the splits of a
+      /// PSSM shadow.
+      /// @see gatherObjectCandidates
+      struct ObjectCandidates
+      {
+         /// The bounds the objects were gathered in.
+         Box3F bounds;
+
+         /// The type mask the objects were gathered with.
+         U32 typeMask;
+
+         Vector< SceneObject* > objects;
+      };
+
    protected:
 
       /// Whether this is the client-side scene.
@@ -129,6 +157,10 @@ class SceneManager
       /// Manager for the zones in this scene.
       SceneZoneSpaceManager* mZoneManager;
 
+      /// Interest grid shared by all connections scoping this scene.
+      /// @note Only server scenes have a scope grid.
+      SceneScopeGrid* mScopeGrid;
+
       // NonClipProjection is the projection matrix without oblique frustum clipping
       // applied to it (in reflections)
       MatrixF mNonClipProj;
@@ -181,6 +213,9 @@ class SceneManager
       ///
       Vector< SceneObject* > mBatchQueryList;
 
+      /// @see setObjectCandidates
+      const ObjectCandidates* mObjectCandidates;
+
       /// Render scene using the given state.
       ///
       /// @param state SceneManager render state.
@@ -250,6 +285,15 @@ class SceneManager
       /// Returns the currently active scene state or NULL if no state is currently active.
       SceneRenderState* getCurrentRenderState() const { return mCurrentRenderState; }
 
+      /// Runs a single container query for objects that will be
+      /// rendered by several passes within @a bounds.
+      void gatherObjectCandidates( const Box3F &bounds, U32 objectMask, ObjectCandidates *outCandidates );
+
+      /// While set, renders whose query box falls within the candidate
+      /// bounds pick their objects from the candidates instead of running
+      /// their own container query.  Pass NULL to clear.
+      void setObjectCandidates( const ObjectCandidates *candidates ) { mObjectCandidates = candidates; }
+
       static RenderSignal& getPreRenderSignal() 
       { 
          static RenderSignal theSignal;
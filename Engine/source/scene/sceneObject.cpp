@@ -120,7 +120,7 @@ SceneObject::SceneObject()
    mRenderWorldBox = Box3F(Point3F(0, 0, 0), Point3F(0, 0, 0));
    mRenderWorldSphere = SphereF(Point3F(0, 0, 0), 0);
 
-   mContainerSeqKey = 0;
+   dMemset( mContainerSeqKeys, 0, sizeof( mContainerSeqKeys ) );
 
    mBinRefHead = NULL;
 
@@ -129,11 +129,16 @@ SceneObject::SceneObject()
    mNumCurrZones = 0;
    mZoneRefHead = NULL;
    mZoneRefDirty = false;
+   mZonedWorldBox = Box3F::Invalid;
 
    mBinMinX = 0xFFFFFFFF;
    mBinMaxX = 0xFFFFFFFF;
    mBinMinY = 0xFFFFFFFF;
    mBinMaxY = 0xFFFFFFFF;
+   mOctreeNode = 0xFFFFFFFF;
+   mOctreeSlot = 0xFFFFFFFF;
+   mContainerBoundsIndex = 0xFFFFFFFF;
+   mStaticCollisionIndex = -1;
    mLightPlugin = NULL;
 
    mMount.object = NULL;
@@ -157,7 +162,8 @@ SceneObject::SceneObject()
 
 SceneObject::~SceneObject()
 {
-   AssertFatal( mZoneRefHead == NULL && mBinRefHead == NULL,
+   AssertFatal( mZoneRefHead == NULL && mBinRefHead == NULL && mOctreeNode == 0xFFFFFFFF &&
+                mContainerBoundsIndex == 0xFFFFFFFF,
       "SceneObject::~SceneObject - Object still linked in reference lists!");
    AssertFatal( !mSceneObjectLinks,
       "SceneObject::~SceneObject() - object is still linked to SceneTrackers" );
@@ -279,7 +285,8 @@ bool SceneObject::collideBox(const Point3F &start, const Point3F &end, RayInfo *
 
 void SceneObject::disableCollision()
 {
-   mCollisionCount++;
+   if( !mCollisionCount++ && mContainer )
+      mContainer->logObjectChange( this );
    AssertFatal(mCollisionCount < 50, "SceneObject::disableCollision called 50 times on the same object. Is this inside a circular loop?" );
 }
 
@@ -287,8 +294,8 @@ void SceneObject::disableCollision()
 
 void SceneObject::enableCollision()
 {
-   if (mCollisionCount)
-      --mCollisionCount;
+   if (mCollisionCount && !--mCollisionCount && mContainer)
+      mContainer->logObjectChange( this );
 }
 
 //-----------------------------------------------------------------------------
@@ -857,7 +864,7 @@ U32 SceneObject::packUpdate( NetConnection* conn, U32 mask, BitStream* stream )
          if ( stream->writeFlag( gIndex != -1 ) ) 
          {
             stream->writeFlag( true );
-            stream->writeInt( gIndex, NetConnection::GhostIdBitSize );
+            NetConnection::writeGhostIndex(stream, gIndex);
             if ( stream->writeFlag( mMount.node != -1 ) )
                stream->writeInt( mMount.node, NumMountPointBits );
             mathWrite( *stream, mMount.xfm );
@@ -892,7 +899,7 @@ void SceneObject::unpackUpdate( NetConnection* conn, BitStream* stream )
    {
       if ( stream->readFlag() ) 
       {
-         S32 gIndex = stream->readInt( NetConnection::GhostIdBitSize );
+         S32 gIndex = NetConnection::readGhostIndex(stream);
          SceneObject* obj = dynamic_cast<SceneObject*>( conn->resolveGhost( gIndex ) );
          S32 node = -1;
          if ( stream->readFlag() ) // node != -1
@@ -107,6 +107,8 @@ class SceneObject : public NetObject, private SceneContainer::Link, public Proce
 
       friend class SceneManager;
       friend class SceneContainer;
+      friend class SceneContainerOctree;
+      friend class SceneContainerBounds;
       friend class SceneZoneSpaceManager;
       friend class SceneCullingState; // _getZoneRefHead
       friend class SceneObjectLink; // mSceneObjectLinks
@@ -253,6 +255,10 @@ class SceneObject : public NetObject, private SceneContainer::Link, public Proce
       /// @note If #mZoneRefDirty is set, this might be outdated.
       mutable ZoneRef* mZoneRefHead;
 
+      /// World box the object had when it was last assigned to zones.  If an
+      /// object gets dirtied without its world box changing, rezoning is skipped.
+      mutable Box3F mZonedWorldBox;
+
       /// Refresh the zoning state of this object, if it isn't up-to-date anymore.
       void _updateZoningState() const;
 
@@ -343,8 +349,8 @@ class SceneObject : public NetObject, private SceneContainer::Link, public Proce
       /// Container database that the object is assigned to.
       SceneContainer* mContainer;
 
-      /// SceneContainer sequence key.
-      U32 mContainerSeqKey;
+      /// SceneContainer sequence keys, one per query slot.
+      U32 mContainerSeqKeys[ SceneContainer::MaxQuerySlots ];
 
       ///
       SceneObjectRef* mBinRefHead;
@@ -354,11 +360,23 @@ class SceneObject : public NetObject, private SceneContainer::Link, public Proce
       U32 mBinMinY;
       U32 mBinMaxY;
 
-      /// Returns the container sequence key.
-      U32 getContainerSeqKey() const { return mContainerSeqKey; }
+      /// Node and slot in the SceneContainerOctree of #mContainer when it
+      /// uses a loose octree index.
+      U32 mOctreeNode;
+      U32 mOctreeSlot;
+
+      /// Index of the object's entry in the SceneContainerBounds of #mContainer.
+      U32 mContainerBoundsIndex;
+
+      /// Index of the object in the static collision baked into #mContainer
+      /// or -1 if its geometry is not baked.
+      S32 mStaticCollisionIndex;
 
-      /// Sets the container sequence key.
-      void setContainerSeqKey( const U32 key ) { mContainerSeqKey = key;  }
+      /// Returns the container sequence key for the given query slot.
+      U32 getContainerSeqKey( const U32 slot ) const { return mContainerSeqKeys[ slot ]; }
+
+      /// Sets the container sequence key for the given query slot.
+      void setContainerSeqKey( const U32 slot, const U32 key ) { mContainerSeqKeys[ slot ] = key;  }
 
       /// @}
 
@@ -705,6 +723,13 @@ class SceneObject : public NetObject, private SceneContainer::Link, public Proce
       /// @param state Rendering state.
       virtual void prepRenderImage( SceneRenderState* state ) {}
 
+      /// Called on all objects of a render pass before any of them is asked
+      /// for its render instances.  Objects can queue their shape instances
+      /// here with TSShapeInstance::queueAnimate() to have them animated
+      /// in a single parallel batch.
+      /// @param state Rendering state.
+      virtual void prepAnimation( SceneRenderState* state ) {}
+
       /// @}
 
       /// @name Lighting
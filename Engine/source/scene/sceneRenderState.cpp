@@ -25,6 +25,7 @@
 
 #include "renderInstance/renderPassManager.h"
 #include "math/util/matrixSet.h"
+#include "ts/tsShapeInstance.h"
 
 #include "T3D/components/render/renderComponentInterface.h"
 #include "T3D/components/component.h"
@@ -97,6 +98,17 @@ const MatrixF& SceneRenderState::getProjectionMatrix() const
 
 void SceneRenderState::renderObjects( SceneObject** objects, U32 numObjects )
 {
+   // Animate the shapes of all objects in one go so the work can be
+   // spread across threads.
+
+   PROFILE_START( SceneRenderState_prepAnimations );
+   for( U32 i = 0; i < numObjects; ++ i )
+      objects[ i ]->prepAnimation( this );
+
+   TSShapeInstance::animateQueued();
+
+   PROFILE_END();
+
    // Let the objects batch their stuff.
 
    PROFILE_START( SceneRenderState_prepRenderImages );
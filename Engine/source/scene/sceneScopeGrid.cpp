@@ -0,0 +1,174 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "scene/sceneScopeGrid.h"
+
+#include "scene/sceneObject.h"
+#include "scene/sceneContainer.h"
+#include "sim/netConnection.h"
+#include "platform/profiler.h"
+
+
+F32 SceneScopeGrid::smCellSize = 64.0f;
+F32 SceneScopeGrid::smHysteresis = 0.1f;
+
+
+//-----------------------------------------------------------------------------
+
+SceneScopeGrid::SceneScopeGrid()
+   : mCellSize( smCellSize ),
+     mDirty( true )
+{
+   VECTOR_SET_ASSOCIATION( mEntries );
+   VECTOR_SET_ASSOCIATION( mLargeEntries );
+
+   dMemset( mBuckets, 0xFF, sizeof( mBuckets ) );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneScopeGrid::_insert( SceneObject* object, const Point3F& center, F32 radius )
+{
+   Entry entry;
+   entry.object = object;
+   entry.center = center;
+   entry.radius = radius;
+   entry.cellX = 0;
+   entry.cellY = 0;
+   entry.next = -1;
+
+   const S32 index = mEntries.size();
+
+   if( radius > mCellSize )
+      mLargeEntries.push_back( index );
+   else
+   {
+      entry.cellX = _getCell( center.x );
+      entry.cellY = _getCell( center.y );
+
+      S32& bucket = mBuckets[ _getBucket( entry.cellX, entry.cellY ) ];
+      entry.next = bucket;
+      bucket = index;
+   }
+
+   mEntries.push_back( entry );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneScopeGrid::_rebuild( SceneContainer* container )
+{
+   PROFILE_SCOPE( SceneScopeGrid_rebuild );
+
+   mCellSize = getMax( smCellSize, 1.0f );
+
+   mEntries.clear();
+   mLargeEntries.clear();
+   dMemset( mBuckets, 0xFF, sizeof( mBuckets ) );
+
+   // Derive the bounding spheres straight from the packed world boxes the
+   // same way SceneObject does so we don't have to visit every object.
+
+   const SceneContainerBounds& bounds = container->getObjectBounds();
+   const U32 numObjects = bounds.size();
+
+   const F32* minX = bounds.getBounds( 0 );
+   const F32* minY = bounds.getBounds( 1 );
+   const F32* minZ = bounds.getBounds( 2 );
+   const F32* maxX = bounds.getBounds( 3 );
+   const F32* maxY = bounds.getBounds( 4 );
+   const F32* maxZ = bounds.getBounds( 5 );
+
+   mEntries.reserve( numObjects );
+   for( U32 i = 0; i < numObjects; ++ i )
+   {
+      const Point3F center( ( minX[ i ] + maxX[ i ] ) * 0.5f,
+                            ( minY[ i ] + maxY[ i ] ) * 0.5f,
+                            ( minZ[ i ] + maxZ[ i ] ) * 0.5f );
+      const F32 radius = Point3F( maxX[ i ] - center.x, maxY[ i ] - center.y, maxZ[ i ] - center.z ).len();
+
+      _insert( bounds.getObject( i ), center, radius );
+   }
+
+   mDirty = false;
+}
+
+//-----------------------------------------------------------------------------
+
+inline void SceneScopeGrid::_scopeEntry( const Entry& entry, const Point3F& point, F32 scopeDist, F32 keepDist, NetConnection* connection ) const
+{
+   if( !entry.object->isScopeable() )
+      return;
+
+   const F32 dist = ( entry.center - point ).len() - entry.radius;
+
+   if( dist < scopeDist || ( dist < keepDist && connection->isObjectGhosted( entry.object ) ) )
+      connection->objectInScope( entry.object );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneScopeGrid::scopeObjects( SceneContainer* container, const Point3F& point, F32 scopeDist, NetConnection* connection )
+{
+   PROFILE_SCOPE( SceneScopeGrid_scopeObjects );
+
+   if( mDirty || mCellSize != getMax( smCellSize, 1.0f ) )
+      _rebuild( container );
+
+   const F32 keepDist = scopeDist * ( 1.0f + getMax( smHysteresis, 0.0f ) );
+
+   // Bucketed objects may stick out of their cell by up to a cell size.
+
+   const F32 extent = keepDist + mCellSize;
+   const S32 minX = _getCell( point.x - extent );
+   const S32 maxX = _getCell( point.x + extent );
+   const S32 minY = _getCell( point.y - extent );
+   const S32 maxY = _getCell( point.y + extent );
+
+   // If the query covers more cells than there are objects, just test them all.
+
+   if( F32( maxX - minX + 1 ) * F32( maxY - minY + 1 ) >= F32( mEntries.size() ) )
+   {
+      for( U32 i = 0; i < mEntries.size(); ++ i )
+         _scopeEntry( mEntries[ i ], point, scopeDist, keepDist, connection );
+      return;
+   }
+
+   for( S32 y = minY; y <= maxY; ++ y )
+      for( S32 x = minX; x <= maxX; ++ x )
+      {
+         for( S32 index = mBuckets[ _getBucket( x, y ) ]; index != -1; index = mEntries[ index ].next )
+         {
+            const Entry& entry = mEntries[ index ];
+
+            // Skip objects from other cells hashing to the same bucket.
+            if( entry.cellX != x || entry.cellY != y )
+               continue;
+
+            _scopeEntry( entry, point, scopeDist, keepDist, connection );
+         }
+      }
+
+   for( U32 i = 0; i < mLargeEntries.size(); ++ i )
+      _scopeEntry( mEntries[ mLargeEntries[ i ] ], point, scopeDist, keepDist, connection );
+}
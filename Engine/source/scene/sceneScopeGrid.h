@@ -0,0 +1,147 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENESCOPEGRID_H_
+#define _SCENESCOPEGRID_H_
+
+#ifndef _MPOINT3_H_
+#include "math/mPoint3.h"
+#endif
+
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+
+/// @file
+/// Shared interest grid for network scoping.
+
+
+class SceneObject;
+class SceneContainer;
+class NetConnection;
+
+
+/// A flat 2D grid over the bounding spheres of all scopeable objects in a
+/// scene that every connection can use to find the objects in its scope.
+///
+/// Rather than having each connection run its own container query, the grid
+/// is built once from the container and then shared by all connections that
+/// scope until objects are added, removed or moved again (at which point
+/// SceneManager marks it dirty).  Scoping all clients thus costs one pass
+/// over the objects plus a walk over the cells around each camera.
+///
+/// Each object goes into the one cell that contains the center of its
+/// bounding sphere.  Objects larger than a cell and objects with global
+/// bounds are kept in a separate list that is tested against every query.
+/// Cells are hashed into a fixed number of buckets so the grid does not
+/// need to know the extents of the world.
+///
+/// To keep objects near the edge of the scope distance from constantly
+/// being ghosted and killed again, objects that already have a ghost on a
+/// connection stay in scope until they are #smHysteresis times the scope
+/// distance farther out.
+class SceneScopeGrid
+{
+   public:
+
+      enum
+      {
+         /// Number of hash buckets for the grid cells.  Must be a power of two.
+         NumBuckets = 4096,
+      };
+
+      /// Edge length of the grid cells in world units.
+      static F32 smCellSize;
+
+      /// Fraction of the scope distance that objects already in scope may
+      /// move beyond it before going out of scope.
+      static F32 smHysteresis;
+
+   protected:
+
+      struct Entry
+      {
+         SceneObject* object;
+
+         /// Center of the object's bounding sphere when the grid was built.
+         Point3F center;
+
+         /// Radius of the object's bounding sphere when the grid was built.
+         F32 radius;
+
+         /// Grid cell containing #center.
+         S32 cellX;
+         S32 cellY;
+
+         /// Index of the next entry in the same bucket or -1.
+         S32 next;
+      };
+
+      /// Entries of all objects in the grid.
+      Vector< Entry > mEntries;
+
+      /// First entry of each bucket or -1.
+      S32 mBuckets[ NumBuckets ];
+
+      /// Indices of entries that are too large to be bucketed.
+      Vector< S32 > mLargeEntries;
+
+      /// Cell size the grid was built with.
+      F32 mCellSize;
+
+      /// Whether the grid has to be rebuilt before the next query.
+      bool mDirty;
+
+      static U32 _getBucket( S32 cellX, S32 cellY )
+      {
+         return ( U32( cellX ) * 73856093 ^ U32( cellY ) * 19349663 ) & ( NumBuckets - 1 );
+      }
+
+      S32 _getCell( F32 coord ) const
+      {
+         return S32( mFloor( coord / mCellSize ) );
+      }
+
+      /// Rebuild the grid from the packed world boxes of all objects in
+      /// @a container.
+      void _rebuild( SceneContainer* container );
+
+      /// Scope @a entry to @a connection if it is in range.
+      void _scopeEntry( const Entry& entry, const Point3F& point, F32 scopeDist, F32 keepDist, NetConnection* connection ) const;
+
+      /// Add an entry for @a object with the given bounding sphere.
+      void _insert( SceneObject* object, const Point3F& center, F32 radius );
+
+   public:
+
+      SceneScopeGrid();
+
+      /// Force a rebuild of the grid on the next call to scopeObjects().
+      void markDirty() { mDirty = true; }
+
+      /// Scope all objects in @a container whose bounding spheres are within
+      /// @a scopeDist of @a point to @a connection.
+      void scopeObjects( SceneContainer* container, const Point3F& point, F32 scopeDist, NetConnection* connection );
+};
+
+#endif // !_SCENESCOPEGRID_H_
@@ -0,0 +1,124 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/benchmark.h"
+#include "scene/sceneContainer.h"
+#include "scene/sceneObject.h"
+#include "math/mRandom.h"
+
+namespace {
+
+/// An unregistered object with a given box, only used to fill a container.
+class BenchmarkSceneObject : public SceneObject
+{
+public:
+   BenchmarkSceneObject( const Point3F& position, F32 size )
+   {
+      mTypeMask = StaticShapeObjectType;
+      mObjBox.set( Point3F( -size, -size, -size ), Point3F( size, size, size ) );
+
+      MatrixF transform( true );
+      transform.setPosition( position );
+      setTransform( transform );
+   }
+};
+
+/// A container filled with objects scattered over a 2km square.
+class BenchmarkScene
+{
+public:
+   enum { NumObjects = 4000 };
+
+   SceneContainer mContainer;
+   Vector< SceneObject* > mObjects;
+
+   BenchmarkScene()
+   {
+      MRandomLCG random( 1 );
+      for( U32 i = 0; i < NumObjects; ++ i )
+      {
+         const Point3F position( random.randF( -1000.0f, 1000.0f ), random.randF( -1000.0f, 1000.0f ), random.randF( 0.0f, 50.0f ) );
+         SceneObject* object = new BenchmarkSceneObject( position, random.randF( 0.5f, 5.0f ) );
+         mContainer.addObject( object );
+         mObjects.push_back( object );
+      }
+   }
+
+   ~BenchmarkScene()
+   {
+      for( U32 i = 0; i < mObjects.size(); ++ i )
+      {
+         mContainer.removeObject( mObjects[ i ] );
+         delete mObjects[ i ];
+      }
+   }
+};
+
+}
+
+BENCHMARK(SceneContainer, FindObjectsInBox)
+{
+   BenchmarkScene scene;
+   Vector< SceneObject* > found;
+   MRandomLCG random( 2 );
+
+   while( state.keepRunning() )
+   {
+      const Point3F center( random.randF( -1000.0f, 1000.0f ), random.randF( -1000.0f, 1000.0f ), 25.0f );
+      const Box3F box( center - Point3F( 50.0f, 50.0f, 50.0f ), center + Point3F( 50.0f, 50.0f, 50.0f ) );
+      found.clear();
+      scene.mContainer.findObjectList( box, StaticShapeObjectType, &found );
+   }
+}
+
+BENCHMARK(SceneContainer, FindObjectsInRadius)
+{
+   BenchmarkScene scene;
+   Vector< SceneObject* > found;
+   MRandomLCG random( 3 );
+
+   while( state.keepRunning() )
+   {
+      const Point3F center( random.randF( -1000.0f, 1000.0f ), random.randF( -1000.0f, 1000.0f ), 25.0f );
+      found.clear();
+      scene.mContainer.findObjectsInRadius( center, 40.0f, StaticShapeObjectType, &found );
+   }
+}
+
+BENCHMARK(SceneContainer, MoveObject)
+{
+   BenchmarkScene scene;
+   MRandomLCG random( 4 );
+
+   U32 index = 0;
+   while( state.keepRunning() )
+   {
+      SceneObject* object = scene.mObjects[ index ];
+      MatrixF transform = object->getTransform();
+      transform.setPosition( transform.getPosition() + Point3F( random.randF( -2.0f, 2.0f ), random.randF( -2.0f, 2.0f ), 0.0f ) );
+      object->setTransform( transform );
+      scene.mContainer.checkBins( object );
+      index = ( index + 1 ) % scene.mObjects.size();
+   }
+}
+
+#endif
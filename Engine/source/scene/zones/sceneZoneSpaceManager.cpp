@@ -28,6 +28,7 @@
 #include "scene/sceneContainer.h"
 #include "scene/zones/sceneRootZone.h"
 #include "scene/zones/sceneZoneSpace.h"
+#include "scene/culling/sceneCullingState.h"
 
 
 // Uncomment to enable verification code for debugging.  This slows the
@@ -39,6 +40,7 @@
 
 
 ClassChunker< SceneObject::ZoneRef > SceneZoneSpaceManager::smZoneRefChunker;
+bool SceneZoneSpaceManager::smCacheTraversals = true;
 
 
 //-----------------------------------------------------------------------------
@@ -48,7 +50,9 @@ SceneZoneSpaceManager::SceneZoneSpaceManager( SceneContainer* container )
      mContainer( container ),
      mNumTotalAllocatedZones( 0 ),
      mNumActiveZones( 0 ),
-     mDirtyArea( Box3F::Invalid )
+     mDirtyArea( Box3F::Invalid ),
+     mTraversalVersion( 1 ),
+     mTraversalStamp( 0 )
 {
    VECTOR_SET_ASSOCIATION( mZoneSpaces );
    VECTOR_SET_ASSOCIATION( mZoneLists );
@@ -74,6 +78,7 @@ void SceneZoneSpaceManager::registerZones( SceneZoneSpace* object, U32 numZones
 {
    AssertFatal( _getZoneSpaceIndex( object ) == -1, "SceneZoneSpaceManager::registerZones - Object already registered" );
    _compactZonesCheck();
+   _invalidateTraversals();
 
    const U32 zoneRangeStart = mNumTotalAllocatedZones;
 
@@ -135,6 +140,8 @@ void SceneZoneSpaceManager::unregisterZones( SceneZoneSpace* object )
    AssertFatal( zoneSpaceIndex != -1, "SceneZoneSpaceManager::unregisterZones - Object not registered as zone space" );
    AssertFatal( mNumActiveZones >= object->mNumZones, "SceneZoneSpaceManager::unregisterZones - Too many zones removed");
 
+   _invalidateTraversals();
+
    const U32 zoneRangeStart = object->getZoneRangeStart();
    const U32 numZones = object->getZoneRange();
 
@@ -384,12 +391,23 @@ U32 SceneZoneSpaceManager::findZones( const Box3F& area, Vector< U32 >& outZones
 
 //-----------------------------------------------------------------------------
 
-void SceneZoneSpaceManager::_rezoneObject( SceneObject* object )
+void SceneZoneSpaceManager::_rezoneObject( SceneObject* object, bool onlyIfMoved )
 {
    PROFILE_SCOPE( SceneZoneSpaceManager_rezoneObject );
 
    AssertFatal( !dynamic_cast< SceneRootZone* >( object ), "SceneZoneSpaceManager::_rezoneObject - Cannot rezone the SceneRootZone!" );
 
+   // Objects get dirtied on every transform update even if they end up
+   // covering the same space.  Skip the zone space query for those.
+
+   if( onlyIfMoved &&
+       object->mNumCurrZones &&
+       object->mZonedWorldBox == object->getWorldBox() )
+   {
+      object->mZoneRefDirty = false;
+      return;
+   }
+
    // If the object is not yet assigned to zones,
    // do so now and return.
 
@@ -407,6 +425,7 @@ void SceneZoneSpaceManager::_rezoneObject( SceneObject* object )
    if( mNumActiveZones == 1 || object->isGlobalBounds() || object->getTypeMask() & OUTDOOR_OBJECT_TYPEMASK )
    {
       object->mZoneRefDirty = false;
+      object->mZonedWorldBox = object->getWorldBox();
       return;
    }
 
@@ -426,6 +445,7 @@ void SceneZoneSpaceManager::_rezoneObject( SceneObject* object )
           object->mZoneRefHead->zone == RootZoneId )
       {
          object->mZoneRefDirty = false;
+         object->mZonedWorldBox = object->getWorldBox();
          return;
       }
    }
@@ -454,6 +474,11 @@ void SceneZoneSpaceManager::unregisterObject( SceneObject* object )
 
    mDirtyObjects.remove( object );
 
+   // Cached traversals may refer to the object.
+
+   if( object->getTypeMask() & ZoneObjectType || object->isVisualOccluder() )
+      _invalidateTraversals();
+
    // Remove from zone lists.
 
    _zoneRemove( object );
@@ -494,6 +519,11 @@ void SceneZoneSpaceManager::notifyObjectChanged( SceneObject* object )
    if( object->mZoneRefDirty )
       return;
 
+   // Zone spaces and occluders affect zone traversals.
+
+   if( object->getTypeMask() & ZoneObjectType || object->isVisualOccluder() )
+      _invalidateTraversals();
+
    // Put the object on the respective dirty list.
 
    if( object->getTypeMask() & ZoneObjectType )
@@ -585,7 +615,7 @@ void SceneZoneSpaceManager::updateZoningState()
       mDirtyObjects.decrement();
 
       if( object->mZoneRefDirty )
-         _rezoneObject( object );
+         _rezoneObject( object, true );
 
       AssertFatal( !object->mZoneRefDirty, "SceneZoneSpaceManager::updateZoningState - Object still dirty!" );
    }
@@ -673,6 +703,7 @@ void SceneZoneSpaceManager::_zoneInsert( SceneObject* object, bool queryListInit
    // Mark the zoning state of the object as current.
 
    object->mZoneRefDirty = false;
+   object->mZonedWorldBox = object->getWorldBox();
 }
 
 //-----------------------------------------------------------------------------
@@ -823,6 +854,132 @@ void SceneZoneSpaceManager::_addToOutdoorZone( SceneObject* object )
 
 //-----------------------------------------------------------------------------
 
+bool SceneZoneSpaceManager::_matchesTraversal( const CachedTraversal& entry, const SceneCullingState* state, SceneZoneSpace* baseObject, U32 baseZone ) const
+{
+   const Frustum& frustum = state->getCullingFrustum();
+   const SceneCameraState& cameraState = state->getCameraState();
+
+   return ( entry.mVersion == mTraversalVersion &&
+            entry.mBaseObject == baseObject &&
+            entry.mBaseZone == baseZone &&
+            entry.mIsOrtho == frustum.isOrtho() &&
+            entry.mViewPosition == cameraState.getViewPosition() &&
+            entry.mViewDirection == cameraState.getViewDirection() &&
+            dMemcmp( entry.mFrustumPlanes, frustum.getPlanes(), sizeof( entry.mFrustumPlanes ) ) == 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneZoneSpaceManager::restoreTraversal( SceneCullingState* state, SceneZoneSpace* baseObject, U32 baseZone, Box3F& outTraversedArea )
+{
+   if( !smCacheTraversals )
+      return false;
+
+   PROFILE_SCOPE( SceneZoneSpaceManager_restoreTraversal );
+
+   for( U32 i = 0; i < MaxCachedTraversals; ++ i )
+   {
+      CachedTraversal& entry = mCachedTraversals[ i ];
+      if( !_matchesTraversal( entry, state, baseObject, baseZone ) )
+         continue;
+
+      // Put the includer volumes back.  The plane data has to live
+      // on the culling state like that of any other volume.
+
+      const U32 numVolumes = entry.mVolumes.size();
+      for( U32 n = 0; n < numVolumes; ++ n )
+      {
+         const CachedTraversal::Volume& cached = entry.mVolumes[ n ];
+
+         PlaneF* planes = state->allocateData< PlaneF >( cached.mNumPlanes );
+         dMemcpy( planes, &entry.mPlanes[ cached.mFirstPlane ], cached.mNumPlanes * sizeof( PlaneF ) );
+
+         SceneCullingVolume volume( SceneCullingVolume::Includer, PlaneSetF( planes, cached.mNumPlanes ) );
+         volume.setSortPoint( cached.mSortPoint );
+
+         state->addCullingVolumeToZone( cached.mZoneId, volume );
+      }
+
+      // Let the occluders build their volumes against the restored state.
+
+      const U32 numOccluders = entry.mOccluders.size();
+      for( U32 n = 0; n < numOccluders; ++ n )
+         state->addOccluder( entry.mOccluders[ n ] );
+
+      entry.mLastUsed = ++ mTraversalStamp;
+      outTraversedArea = entry.mTraversedArea;
+      return true;
+   }
+
+   return false;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneZoneSpaceManager::storeTraversal( const SceneCullingState* state, SceneZoneSpace* baseObject, U32 baseZone, const Box3F& traversedArea )
+{
+   if( !smCacheTraversals )
+      return;
+
+   PROFILE_SCOPE( SceneZoneSpaceManager_storeTraversal );
+
+   // Replace the least recently used entry.
+
+   CachedTraversal* entry = &mCachedTraversals[ 0 ];
+   for( U32 i = 1; i < MaxCachedTraversals; ++ i )
+      if( mCachedTraversals[ i ].mLastUsed < entry->mLastUsed )
+         entry = &mCachedTraversals[ i ];
+
+   const Frustum& frustum = state->getCullingFrustum();
+   const SceneCameraState& cameraState = state->getCameraState();
+
+   entry->mVersion = mTraversalVersion;
+   entry->mLastUsed = ++ mTraversalStamp;
+   entry->mBaseObject = baseObject;
+   entry->mBaseZone = baseZone;
+   dMemcpy( entry->mFrustumPlanes, frustum.getPlanes(), sizeof( entry->mFrustumPlanes ) );
+   entry->mViewPosition = cameraState.getViewPosition();
+   entry->mViewDirection = cameraState.getViewDirection();
+   entry->mIsOrtho = frustum.isOrtho();
+   entry->mTraversedArea = traversedArea;
+
+   // Record the includer volumes of all visible zones.  Occluder volumes
+   // are rebuilt from the occluder objects instead.
+
+   entry->mVolumes.clear();
+   entry->mPlanes.clear();
+
+   const BitVector& visibleZones = state->getZoneVisibilityFlags();
+   const U32 numZones = getNumZones();
+   for( U32 zoneId = 0; zoneId < numZones; ++ zoneId )
+   {
+      if( !visibleZones.test( zoneId ) )
+         continue;
+
+      for( SceneZoneCullingState::CullingVolumeIterator iter( state->getZoneState( zoneId ) ); iter.isValid(); ++ iter )
+      {
+         if( !iter->isIncluder() )
+            continue;
+
+         const PlaneSetF& planes = iter->getPlanes();
+
+         CachedTraversal::Volume volume;
+         volume.mZoneId = zoneId;
+         volume.mSortPoint = iter->getSortPoint();
+         volume.mFirstPlane = entry->mPlanes.size();
+         volume.mNumPlanes = planes.getNumPlanes();
+         entry->mVolumes.push_back( volume );
+
+         for( U32 n = 0; n < planes.getNumPlanes(); ++ n )
+            entry->mPlanes.push_back( planes.getPlanes()[ n ] );
+      }
+   }
+
+   entry->mOccluders = state->getAddedOccluderObjects();
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneZoneSpaceManager::_queryZoneSpaces( const Box3F& area ) const
 {
    mZoneSpacesQueryList.clear();
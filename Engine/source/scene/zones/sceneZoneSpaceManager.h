@@ -39,9 +39,14 @@
 #include "core/dataChunker.h"
 #endif
 
+#ifndef _MATHUTIL_FRUSTUM_H_
+#include "math/util/frustum.h"
+#endif
+
 
 
 class SceneContainer;
+class SceneCullingState;
 class SceneRootZone;
 class SceneZoneSpace;
 
@@ -178,6 +183,75 @@ class SceneZoneSpaceManager
 
       /// @}
 
+      /// @name Traversal Cache
+      /// Zone traversals depend only on the viewpoint, the zone spaces and the
+      /// occluders in the scene.  Their results are remembered for a few viewpoints
+      /// so passes and frames rendering from the exact same view can skip the
+      /// portal traversal.
+      /// @{
+
+      /// A recorded zone traversal.
+      struct CachedTraversal
+      {
+         /// An includer culling volume that the traversal added to a zone.
+         struct Volume
+         {
+            U32 mZoneId;
+            F32 mSortPoint;
+            U32 mFirstPlane;
+            U32 mNumPlanes;
+         };
+
+         /// Value of #mTraversalVersion when the traversal was recorded.  The
+         /// entry is stale once the two differ.
+         U32 mVersion;
+
+         /// Value of #mTraversalStamp when the entry was last used.
+         U32 mLastUsed;
+
+         /// Zone the traversal started in.
+         SceneZoneSpace* mBaseObject;
+         U32 mBaseZone;
+
+         /// Viewpoint the traversal was done from.
+         PlaneF mFrustumPlanes[ Frustum::PlaneCount ];
+         Point3F mViewPosition;
+         Point3F mViewDirection;
+         bool mIsOrtho;
+
+         /// Area of the scene visited by the traversal.
+         Box3F mTraversedArea;
+
+         /// Includer volumes and their planes.
+         Vector< Volume > mVolumes;
+         Vector< PlaneF > mPlanes;
+
+         /// Occluders added during the traversal.  These are added again on
+         /// reuse so that their volumes reflect their current state.
+         Vector< SceneObject* > mOccluders;
+
+         CachedTraversal() : mVersion( 0 ), mLastUsed( 0 ), mBaseObject( NULL ), mBaseZone( 0 ), mIsOrtho( false ) {}
+      };
+
+      enum { MaxCachedTraversals = 4 };
+
+      /// Recently recorded traversals.
+      CachedTraversal mCachedTraversals[ MaxCachedTraversals ];
+
+      /// Incremented whenever zone spaces or occluders change.
+      U32 mTraversalVersion;
+
+      /// Incremented on every use of the cache.
+      U32 mTraversalStamp;
+
+      /// Drop all cached traversals.
+      void _invalidateTraversals() { mTraversalVersion ++; }
+
+      /// Return true if @a entry was recorded for the viewpoint of the given culling state.
+      bool _matchesTraversal( const CachedTraversal& entry, const SceneCullingState* state, SceneZoneSpace* baseObject, U32 baseZone ) const;
+
+      /// @}
+
       /// Check to see if we have accumulated a lot of unallocate zone IDs and if so,
       /// compact the zoning lists by reassigning IDs.
       ///
@@ -212,13 +286,18 @@ class SceneZoneSpaceManager
       void _rezoneObjects( const Box3F& area );
 
       /// Update the zoning state of the given object.
-      void _rezoneObject( SceneObject* object );
+      /// @param onlyIfMoved If true, the object is left alone if its world box has not
+      ///   changed since it was last zoned.
+      void _rezoneObject( SceneObject* object, bool onlyIfMoved = false );
 
       /// Fill #mZoneSpacesQueryList with all ZoneObjectType objects in the given area.
       void _queryZoneSpaces( const Box3F& area ) const;
 
    public:
 
+      /// If true, zone traversals are cached and reused for identical viewpoints.
+      static bool smCacheTraversals;
+
       SceneZoneSpaceManager( SceneContainer* container );
       ~SceneZoneSpaceManager();
 
@@ -305,6 +384,26 @@ class SceneZoneSpaceManager
       ///   manager fully contains @a area, the outdoor zone will not be added to the list).
       U32 findZones( const Box3F& area, Vector< U32 >& outZones ) const;
 
+      /// @name Traversal Cache
+      /// @{
+
+      /// Fill the given culling state with the result of a cached traversal from the
+      /// same viewpoint, if there is one.
+      ///
+      /// @param state Culling state to fill.
+      /// @param baseObject Zone space the traversal would start in.
+      /// @param baseZone Zone the traversal would start in.
+      /// @param outTraversedArea (out) Receives the area visited by the traversal.
+      ///
+      /// @return True if the culling state was filled, false if a traversal is needed.
+      bool restoreTraversal( SceneCullingState* state, SceneZoneSpace* baseObject, U32 baseZone, Box3F& outTraversedArea );
+
+      /// Record the result of a traversal that has just been done on the given culling
+      /// state so it can be restored by restoreTraversal().
+      void storeTraversal( const SceneCullingState* state, SceneZoneSpace* baseObject, U32 baseZone, const Box3F& traversedArea );
+
+      /// @}
+
       static ZoningChangedSignal& getZoningChangedSignal()
       {
          static ZoningChangedSignal sSignal;
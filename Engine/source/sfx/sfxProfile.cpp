@@ -34,6 +34,7 @@
 #include "sim/netConnection.h"
 #include "core/stream/bitStream.h"
 #include "core/resourceManager.h"
+#include "core/module.h"
 #include "console/engineAPI.h"
 
 using namespace Torque;
@@ -79,10 +80,29 @@ ConsoleDocClass( SFXProfile,
 );
 
 
+SFXProfile* SFXProfile::smCacheHead;
+SFXProfile* SFXProfile::smCacheTail;
+U32 SFXProfile::smCacheBytes;
+U32 SFXProfile::smBufferCacheSize = 32 * 1024 * 1024;
+
+AFTER_MODULE_INIT( SFX )
+{
+   Con::addVariable( "SFX::bufferCacheSize", TypeS32, &SFXProfile::smBufferCacheSize,
+      "@brief Memory budget in bytes for the decoded sound data of non-preloaded SFXProfiles.\n\n"
+      "Buffers of profiles that are not preloaded are loaded when first played and then kept "
+      "around for reuse.  Once their combined size exceeds this budget, the buffers of the "
+      "least recently played profiles are released.  Preloaded profiles are never affected.  "
+      "A value of 0 disables the budget.  The default value is 32 MB.\n"
+      "@ingroup SFX" );
+}
+
 //-----------------------------------------------------------------------------
 
 SFXProfile::SFXProfile()
-   : mPreload( false )
+   : mPreload( false ),
+     mCachePrev( NULL ),
+     mCacheNext( NULL ),
+     mCacheBytes( 0 )
 {
 }
 
@@ -91,7 +111,10 @@ SFXProfile::SFXProfile()
 SFXProfile::SFXProfile( SFXDescription* desc, const String& filename, bool preload )
    : Parent( desc ),
      mFilename( filename ),
-     mPreload( preload )
+     mPreload( preload ),
+     mCachePrev( NULL ),
+     mCacheNext( NULL ),
+     mCacheBytes( 0 )
 {
 }
 
@@ -130,8 +153,10 @@ bool SFXProfile::onAdd()
       return false;
          
    // If we're a streaming profile we don't preload
-   // or need device events.
-   if( SFX && !mDescription->mIsStreaming )
+   // or need device events.  Without a device (e.g. on
+   // a dedicated server) there's nothing to load into,
+   // so wait for the CreateDevice event instead.
+   if( SFX && SFX->_getDevice() && !mDescription->mIsStreaming )
    {
       // If preload is enabled we load the resource
       // and device buffer now to avoid a delay on
@@ -150,6 +175,7 @@ bool SFXProfile::onAdd()
 void SFXProfile::onRemove()
 {
    _unregisterSignals();
+   _unlinkCache();
 
    Parent::onRemove();
 }
@@ -255,6 +281,7 @@ void SFXProfile::_onResourceChanged( const Torque::Path& path )
             
    mResource = NULL;
    mBuffer = NULL;
+   _unlinkCache();
       
    // Load the new resource.
       
@@ -304,13 +331,111 @@ SFXBuffer* SFXProfile::getBuffer()
    }
 
    if ( mBuffer.isNull() )
-      _preloadBuffer();
+   {
+      // The buffer may have been taken down with the device
+      // so drop any stale accounting before loading it again.
+      _unlinkCache();
+      if ( !_preloadBuffer() )
+         return NULL;
+   }
+
+   if ( !mPreload )
+   {
+      _touchCache();
+      _trimCache( this );
+   }
 
    return mBuffer;
 }
 
 //-----------------------------------------------------------------------------
 
+void SFXProfile::_touchCache()
+{
+   if ( smCacheHead == this )
+      return;
+
+   if ( mCacheBytes == 0 )
+   {
+      // Not on the list yet.  Account for the decoded size of the
+      // sample data rather than what the device reports as not all
+      // devices track their buffer memory.
+
+      const SFXFormat& format = mBuffer->getFormat();
+      mCacheBytes = getMax( format.getDataLength( mBuffer->getDuration() ), 1U );
+      smCacheBytes += mCacheBytes;
+   }
+   else
+   {
+      // Unhook from the current position.
+
+      if ( mCachePrev )
+         mCachePrev->mCacheNext = mCacheNext;
+      if ( mCacheNext )
+         mCacheNext->mCachePrev = mCachePrev;
+      else
+         smCacheTail = mCachePrev;
+   }
+
+   mCachePrev = NULL;
+   mCacheNext = smCacheHead;
+   if ( smCacheHead )
+      smCacheHead->mCachePrev = this;
+   smCacheHead = this;
+   if ( !smCacheTail )
+      smCacheTail = this;
+}
+
+//-----------------------------------------------------------------------------
+
+void SFXProfile::_unlinkCache()
+{
+   if ( mCacheBytes == 0 )
+      return;
+
+   if ( mCachePrev )
+      mCachePrev->mCacheNext = mCacheNext;
+   else
+      smCacheHead = mCacheNext;
+
+   if ( mCacheNext )
+      mCacheNext->mCachePrev = mCachePrev;
+   else
+      smCacheTail = mCachePrev;
+
+   smCacheBytes -= mCacheBytes;
+
+   mCachePrev = NULL;
+   mCacheNext = NULL;
+   mCacheBytes = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void SFXProfile::_trimCache( SFXProfile* keep )
+{
+   if ( smBufferCacheSize == 0 )
+      return;
+
+   // Voices that are still playing hold their own references so
+   // releasing the profile's buffer never cuts off a sound.  The
+   // memory is returned once the last of them is done.
+
+   SFXProfile* profile = smCacheTail;
+   while ( profile && smCacheBytes > smBufferCacheSize )
+   {
+      SFXProfile* prev = profile->mCachePrev;
+      if ( profile != keep )
+      {
+         profile->mBuffer = NULL;
+         profile->_unlinkCache();
+      }
+      profile = prev;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
 SFXBuffer* SFXProfile::_createBuffer()
 {
    SFXBuffer* buffer = 0;
@@ -398,10 +523,15 @@ SFXProfile::SFXProfile(const SFXProfile& other, bool temp_clone) : SFXTrack(othe
    mPreload = other.mPreload;
    mBuffer = other.mBuffer; // -- AudioBuffer loaded using mFilename
    mChangedSignal = other.mChangedSignal;
+   mCachePrev = NULL;
+   mCacheNext = NULL;
+   mCacheBytes = 0;
 }
 
 SFXProfile::~SFXProfile()
 {
+  _unlinkCache();
+
   if (!isTempClone())
     return;
 
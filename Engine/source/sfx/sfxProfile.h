@@ -103,6 +103,45 @@ class SFXProfile : public SFXTrack
       /// The device specific data buffer.
       /// This is only used if for non-streaming sounds.
       StrongWeakRefPtr< SFXBuffer > mBuffer;
+
+      /// @name Buffer Cache
+      ///
+      /// Non-streaming buffers that are loaded on demand (i.e. not preloaded)
+      /// are kept on an LRU list so that the decoded sample data they hold can
+      /// be released again once the total exceeds #smBufferCacheSize.  Buffers
+      /// of preloaded profiles are never evicted.
+      /// @{
+
+      /// Previous (more recently used) profile on the buffer cache list.
+      SFXProfile* mCachePrev;
+
+      /// Next (less recently used) profile on the buffer cache list.
+      SFXProfile* mCacheNext;
+
+      /// Bytes of decoded sample data accounted to #mBuffer on the cache list.
+      U32 mCacheBytes;
+
+      /// Most recently used profile on the buffer cache list.
+      static SFXProfile* smCacheHead;
+
+      /// Least recently used profile on the buffer cache list.
+      static SFXProfile* smCacheTail;
+
+      /// Total bytes of decoded sample data held by buffers on the cache list.
+      static U32 smCacheBytes;
+
+      /// Move this profile to the front of the cache list, adding it if
+      /// it isn't on the list yet.
+      void _touchCache();
+
+      /// Take this profile off the cache list.
+      void _unlinkCache();
+
+      /// Release the buffers of the least recently used profiles until the
+      /// cache fits into #smBufferCacheSize again.  Never evicts @a keep.
+      static void _trimCache( SFXProfile* keep );
+
+      /// @}
       
       ///
       ChangedSignal mChangedSignal;
@@ -127,6 +166,10 @@ class SFXProfile : public SFXTrack
 
    public:
 
+      /// Memory budget in bytes for the decoded sample data of buffers
+      /// loaded on demand.  Zero disables eviction.
+      static U32 smBufferCacheSize;
+
       /// This is only here to allow DECLARE_CONOBJECT 
       /// to create us from script.  You shouldn't use
       /// this constructor from C++.
@@ -170,6 +213,10 @@ class SFXProfile : public SFXTrack
       /// sound.  If it hasn't been preloaded it will be loaded
       /// at this time.
       ///
+      /// This never blocks on the sound data: the buffer is returned
+      /// while its samples are still being decoded on the SFX thread
+      /// pool and voices bound to it stay blocked until it is ready.
+      ///
       /// If this is a streaming profile then the buffer
       /// returned must be deleted by the caller.
       SFXBuffer* getBuffer();
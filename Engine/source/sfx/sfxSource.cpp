@@ -29,6 +29,7 @@
 #include "console/engineAPI.h"
 #include "math/mRandom.h"
 #include "math/mEase.h"
+#include "core/module.h"
 
 
 
@@ -185,6 +186,22 @@ IMPLEMENT_CALLBACK( SFXSource, onParameterValueChange, void, ( SFXParameter* par
    "@note This is also triggered when the parameter is first attached to the source." );
 
 
+F32 SFXSource::smOccludedVolume = 0.35f;
+F32 SFXSource::smOcclusionFadeTime = 0.25f;
+
+AFTER_MODULE_INIT( SFX )
+{
+   Con::addVariable( "SFX::occludedVolume", TypeF32, &SFXSource::smOccludedVolume,
+      "@brief Volume scale factor applied to sources whose direct path to the listener is fully occluded.\n\n"
+      "The default value is 0.35.\n"
+      "@ingroup SFX" );
+   Con::addVariable( "SFX::occlusionFadeTime", TypeF32, &SFXSource::smOcclusionFadeTime,
+      "@brief Seconds it takes a source to fade between unoccluded and fully occluded volume.\n\n"
+      "The default value is 0.25.\n"
+      "@ingroup SFX" );
+}
+
+
 //-----------------------------------------------------------------------------
 
 SFXSource::SFXSource()
@@ -213,6 +230,11 @@ SFXSource::SFXSource()
      mConeOutsideVolume( 1 ),
      mDistToListener( 0.f ),
      mTransformScattered( false ),
+     mSkipUpdatesUntilTravel( 0.f ),
+     mNumSkippedUpdates( 0 ),
+     mOcclusion( 0.f ),
+     mTargetOcclusion( 0.f ),
+     mOcclusionTime( 0 ),
      mFadeInTime( 0.f ),
      mFadeOutTime( 0.f ),
      mFadeInPoint( -1.f ),
@@ -256,6 +278,11 @@ SFXSource::SFXSource( SFXTrack* track, SFXDescription* description )
      mConeOutsideVolume( 1 ),
      mDistToListener( 0.f ),
      mTransformScattered( false ),
+     mSkipUpdatesUntilTravel( 0.f ),
+     mNumSkippedUpdates( 0 ),
+     mOcclusion( 0.f ),
+     mTargetOcclusion( 0.f ),
+     mOcclusionTime( 0 ),
      mFadeInTime( 0.f ),
      mFadeOutTime( 0.f ),
      mFadeInPoint( -1.f ),
@@ -484,6 +511,7 @@ F32 SFXSource::getTotalPlayTime() const
 void SFXSource::play( F32 fadeInTime )
 {
    SFXStatus status = getStatus();
+   mSkipUpdatesUntilTravel = 0.f;
    
    // Return if the source is already playing.
    
@@ -644,6 +672,20 @@ void SFXSource::update()
 {
    if( !isPlaying() )
       return;
+
+   // Out-of-range sources can't have come into range before the
+   // listener has travelled the distance to it.
+
+   if( mSkipUpdatesUntilTravel > SFX->getListenerTravel()
+       && mOcclusion == mTargetOcclusion
+       && mNumSkippedUpdates < U32( SFXSystem::smMaxSkippedSourceUpdates ) )
+   {
+      ++ mNumSkippedUpdates;
+      return;
+   }
+
+   mSkipUpdatesUntilTravel = 0.f;
+   mNumSkippedUpdates = 0;
       
    _update();      
 
@@ -663,6 +705,12 @@ void SFXSource::update()
 
       iter = next;
    }
+
+   if(   is3d()
+      && mDistToListener > mMaxDistance
+      && mFadeSegmentType == FadeSegmentNone
+      && mModifiers.isEmpty() )
+      mSkipUpdatesUntilTravel = SFX->getListenerTravel() + mDistToListener - mMaxDistance;
 }
 
 //-----------------------------------------------------------------------------
@@ -881,11 +929,29 @@ void SFXSource::_updateVolume( const MatrixF& listener )
       }
    }
 
+   // Ease towards the last reported occlusion so that sounds
+   // don't pop when moving in and out of cover.
+
+   if( mOcclusion != mTargetOcclusion )
+   {
+      const U32 time = Platform::getRealMilliseconds();
+      const F32 step = smOcclusionFadeTime > 0.f
+         ? F32( time - mOcclusionTime ) / ( smOcclusionFadeTime * 1000.f )
+         : 1.f;
+
+      mOcclusionTime = time;
+      if( mOcclusion < mTargetOcclusion )
+         mOcclusion = getMin( mOcclusion + step, mTargetOcclusion );
+      else
+         mOcclusion = getMax( mOcclusion - step, mTargetOcclusion );
+   }
+
    // Compute the pre-attenuated volume.
    
    mPreAttenuatedVolume =
         mFadedVolume
-      * mModulativeVolume;
+      * mModulativeVolume
+      * ( 1.f - mOcclusion * ( 1.f - smOccludedVolume ) );
       
    SFXSource* group = getSourceGroup();
    if( group )
@@ -938,6 +1004,7 @@ void SFXSource::_updatePriority()
 void SFXSource::setTransform( const MatrixF& transform )
 {
    mTransform = transform;
+   mSkipUpdatesUntilTravel = 0.f;
 }
 
 //-----------------------------------------------------------------------------
@@ -984,6 +1051,7 @@ void SFXSource::_setupFadeOutSegment( FadeSegmentType type, F32 fadeOutTime )
 
    mFadeSegmentEase = &mDescription->mFadeOutEase;
    mFadeSegmentType = type;
+   mSkipUpdatesUntilTravel = 0.f;
 
    if( mDescription->mIsLooping && mDescription->mFadeLoops )
    {
@@ -1003,6 +1071,7 @@ void SFXSource::_setMinMaxDistance( F32 min, F32 max )
 {
    mMinDistance = getMax( 0.0f, min );
    mMaxDistance = getMax( mMinDistance, max );
+   mSkipUpdatesUntilTravel = 0.f;
 }
 
 //-----------------------------------------------------------------------------
@@ -1033,6 +1102,21 @@ void SFXSource::setModulativeVolume( F32 value )
 
 //-----------------------------------------------------------------------------
 
+void SFXSource::setOcclusion( F32 value )
+{
+   value = mClampF( value, 0.f, 1.f );
+   if( value == mTargetOcclusion )
+      return;
+
+   if( mOcclusion == mTargetOcclusion )
+      mOcclusionTime = Platform::getRealMilliseconds();
+
+   mTargetOcclusion = value;
+   mSkipUpdatesUntilTravel = 0.f;
+}
+
+//-----------------------------------------------------------------------------
+
 void SFXSource::_setPitch( F32 pitch )
 {
    mPitch = mClampF( pitch, 0.001f, 2.0f );
@@ -155,6 +155,17 @@ class SFXSource : public SimGroup
       /// Volume scale factor imposed on this source by controller.
       F32 mModulativeVolume;
 
+      /// Current occlusion of the direct path between the source and the
+      /// listener; 0 is unoccluded, 1 is fully occluded.  Eases towards
+      /// #mTargetOcclusion over #smOcclusionFadeTime.
+      F32 mOcclusion;
+
+      /// Occlusion last reported through setOcclusion().
+      F32 mTargetOcclusion;
+
+      /// Real time in milliseconds at which #mOcclusion was last eased.
+      U32 mOcclusionTime;
+
       /// Effective volume after fade and modulation but before distance attenuation.
       /// For non-3D sounds, this is the final effective volume.
       F32 mPreAttenuatedVolume;
@@ -250,6 +261,15 @@ class SFXSource : public SimGroup
       /// If true, the transform position has been randomized.
       bool mTransformScattered;
 
+      /// Beyond its max distance, a 3D source plays at constant attenuation
+      /// and needs no further updates until the listener has covered the
+      /// distance to the edge of its range.  This is the listener travel
+      /// (see SFXSystem::getListenerTravel) up to which updates are skipped.
+      F32 mSkipUpdatesUntilTravel;
+
+      /// Number of updates skipped in a row so far.
+      U32 mNumSkippedUpdates;
+
       /// Randomize transform based on scatter settings.
       void _scatterTransform();
 
@@ -511,6 +531,9 @@ class SFXSource : public SimGroup
       ///   are not left exclusively to the SFX device.
       F32 getDistToListener() const { return mDistToListener; }
 
+      /// Returns the distance at which distance-based attenuation stops.
+      F32 getMaxDistance() const { return mMaxDistance; }
+
       /// @}
       
       /// @name Volume
@@ -531,6 +554,21 @@ class SFXSource : public SimGroup
       
       /// Set the per-source volume scale factor.
       void setModulativeVolume( F32 value );
+
+      /// Volume scale factor applied to fully occluded sources.
+      static F32 smOccludedVolume;
+
+      /// Seconds it takes a source to go from unoccluded to fully occluded
+      /// and back.
+      static F32 smOcclusionFadeTime;
+
+      /// Return the current occlusion of the source.
+      F32 getOcclusion() const { return mOcclusion; }
+
+      /// Set the occlusion of the direct path between the source and the
+      /// listener (0=clear, 1=fully occluded).  The source eases towards the
+      /// new value rather than jumping to it.
+      void setOcclusion( F32 value );
       
       ///
       F32 getPreAttenuatedVolume() const { return mPreAttenuatedVolume; }
@@ -68,6 +68,32 @@ MODULE_END;
 
 
 SFXSystem* SFXSystem::smSingleton = NULL;
+S32 SFXSystem::smMaxVoices = 0;
+S32 SFXSystem::smVoiceHysteresis = 4;
+S32 SFXSystem::smMaxSkippedSourceUpdates = 16;
+
+AFTER_MODULE_INIT( SFX )
+{
+   Con::addVariable( "SFX::maxVoices", TypeS32, &SFXSystem::smMaxVoices,
+      "@brief Hard limit on the number of voices the sound system hands out.\n\n"
+      "Only the loudest and highest priority sounds up to this number get a voice on the device; "
+      "all other sounds play virtualized.  A value of 0 leaves the limit to the device.  Ignored "
+      "for devices that do their own voice management.  The default value is 0.\n"
+      "@ref SFXSound_virtualization\n\n"
+      "@ingroup SFX" );
+   Con::addVariable( "SFX::voiceHysteresis", TypeS32, &SFXSystem::smVoiceHysteresis,
+      "@brief Number of ranks a sound may drop below $SFX::maxVoices before losing its voice.\n\n"
+      "This keeps sounds hovering around the voice limit from repeatedly swapping between real "
+      "and virtualized playback.  The default value is 4.\n"
+      "@ingroup SFX" );
+   Con::addVariable( "SFX::maxSkippedSourceUpdates", TypeS32, &SFXSystem::smMaxSkippedSourceUpdates,
+      "@brief Maximum number of source updates an out-of-range 3D source may skip in a row.\n\n"
+      "Sources beyond their max distance play at constant attenuation and are only updated again "
+      "once the listener may have moved into range or this many updates have been skipped.  A "
+      "value of 0 updates all sources on every pass.  The default value is 16.\n"
+      "@ref SFX_updating\n\n"
+      "@ingroup SFX" );
+}
 
 
 // Excludes Null and Blocked as these are not passed out to the control layer.
@@ -202,7 +228,9 @@ SFXSystem::SFXSystem()
       mStatAmbientUpdateTime( 0 ),
       mDopplerFactor( 0.5 ),
       mRolloffFactor( 1.0 ),
-      mSoundscapeMgr( NULL )
+      mSoundscapeMgr( NULL ),
+      mListenerTravel( 0.f ),
+      mLastListenerPos( 0.f, 0.f, 0.f )
 {
    VECTOR_SET_ASSOCIATION( mSounds );
    VECTOR_SET_ASSOCIATION( mPlayOnceSources );
@@ -826,6 +854,13 @@ void SFXSystem::_updateSources()
    if( !sources )
       return;
 
+   // Accumulate how far the listener has moved so that out-of-range
+   // sources know when they need to be looked at again.
+
+   const Point3F listenerPos = getListener().getTransform().getPosition();
+   mListenerTravel += ( listenerPos - mLastListenerPos ).len();
+   mLastListenerPos = listenerPos;
+
    // Check the status of the sources here once.
    // 
    // NOTE: We do not use iterators in this loop because
@@ -918,6 +953,10 @@ void SFXSystem::_assignVoices()
    // listener, the ones at the top of the source list,
    // have a device buffer to play thru.
    
+   const U32 maxVoices = getMax( smMaxVoices, 0 );
+   const U32 hysteresis = getMax( smVoiceHysteresis, 0 );
+   U32 rank = 0;
+   
    mStatNumCulled = 0;
    for( SFXSoundVector::iterator iter = mSounds.begin(); iter != mSounds.end(); ++ iter )
    {
@@ -940,11 +979,36 @@ void SFXSystem::_assignVoices()
          continue;
       }
 
+      // Sounds ranked past the voice limit play virtualized.  Those
+      // that still have a voice keep it until they drop out of the
+      // hysteresis band or someone within the limit needs it.
+      
+      ++ rank;
+      if( maxVoices && rank > maxVoices )
+      {
+         if( sound->hasVoice() && rank > maxVoices + hysteresis )
+            sound->_releaseVoice();
+         if( !sound->hasVoice() )
+            ++ mStatNumCulled;
+         continue;
+      }
+
       // If the source has a voice then we can skip it.
       
       if( sound->hasVoice() )
          continue;
 
+      // If we are at the voice limit, take the voice of the lowest
+      // ranked sound.  As we are within the limit, that sound must
+      // be ranked outside of it.
+      
+      if( maxVoices && mDevice->getVoiceCount() >= maxVoices )
+      {
+         for( SFXSoundVector::iterator hijack = mSounds.end() - 1; hijack != iter; -- hijack )
+            if( ( *hijack )->hasVoice() && ( *hijack )->_releaseVoice() )
+               break;
+      }
+
       // Ok let the device try to assign a new voice for 
       // this source... this may fail if we're out of voices.
       
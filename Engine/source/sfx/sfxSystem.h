@@ -100,7 +100,7 @@ class SFXSystem
 {
       friend class SFXSound;           // _assignVoices
       friend class SFXSource;          // _onAddSource, _onRemoveSource.
-      friend class SFXProfile;         // _createBuffer.
+      friend class SFXProfile;         // _createBuffer, _getDevice.
 
    public:
    
@@ -167,6 +167,14 @@ class SFXSystem
       /// List of plugins currently linked to the SFX system.
       Vector< SFXSystemPlugin* > mPlugins;
 
+      /// Total distance the first listener has moved across all source
+      /// updates.  Out-of-range sources compare against this to find out
+      /// when they could have come into range again.
+      F32 mListenerTravel;
+
+      /// Position of the first listener at the last source update.
+      Point3F mLastListenerPos;
+
       /// @name Stats
       ///
       /// Stats reported back to the console for tracking performance.
@@ -223,6 +231,20 @@ class SFXSystem
 
    public:
 
+      /// Hard limit on the number of voices handed out to sounds.  Sounds
+      /// beyond the limit play virtualized.  Zero leaves the limit to the
+      /// device.  Only applies if the system is doing voice management.
+      static S32 smMaxVoices;
+
+      /// Number of ranks a sound may drop below #smMaxVoices before it is
+      /// forced to give up its voice.  Keeps sounds hovering around the
+      /// cut-off from swapping voices back and forth.
+      static S32 smVoiceHysteresis;
+
+      /// Maximum number of source updates that an out-of-range source
+      /// may skip in a row.
+      static S32 smMaxSkippedSourceUpdates;
+
       /// Returns the one an only instance of the SFXSystem 
       /// unless it hasn't been initialized or its been disabled
       /// in your build.
@@ -380,6 +402,10 @@ class SFXSystem
 
       /// Set the property of the given listener.
       const SFXListenerProperties& getListener( U32 index = 0 ) const { return mListeners[ index ]; }
+
+      /// Return the total distance the first listener has moved as seen
+      /// by the source updates.
+      F32 getListenerTravel() const { return mListenerTravel; }
       
       /// Set the 3D attributes of the given listener.
       void setListener( U32 index, const MatrixF& transform, const Point3F& velocity );
@@ -2716,6 +2716,7 @@ void ImposterVertFeatureHLSL::processVert(   Vector<ShaderComponent*> &component
    Var *inMiscParams = (Var*)LangElement::find( "tcImposterParams" );   
    Var *inUpVec = (Var*)LangElement::find( "tcImposterUpVec" );   
    Var *inRightVec = (Var*)LangElement::find( "tcImposterRightVec" );
+   Var *inAtlasRect = (Var*)LangElement::find( "tcImposterAtlasRect" );
 
    // Get the input shader constants.
    Var *imposterLimits  = new Var;
@@ -2789,6 +2790,11 @@ void ImposterVertFeatureHLSL::processVert(   Vector<ShaderComponent*> &component
                         outTexCoord,
                         outWorldToTangent ) );
 
+   // Imposters packed into an atlas page move
+   // their UVs into the slot of their images.
+   if ( inAtlasRect )
+      meta->addStatement( new GenOp( "   @ = @ * @.zw + @.xy;\r\n", outTexCoord, outTexCoord, inAtlasRect, inAtlasRect ) );
+
    // Copy the position to wsPosition for use in shaders 
    // down stream instead of looking for objTrans.
    Var *wsPosition = new Var;
@@ -51,6 +51,7 @@ FeatureMgr::FeatureMgr()
    : mNeedsSort( false )
 {
    VECTOR_SET_ASSOCIATION( mFeatures );
+   VECTOR_SET_ASSOCIATION( mFeaturesById );
 }
 
 FeatureMgr::~FeatureMgr()
@@ -68,6 +69,7 @@ void FeatureMgr::unregisterAll()
    }
 
    mFeatures.clear();
+   mFeaturesById.clear();
    mNeedsSort = false;
 }
 
@@ -86,14 +88,11 @@ const FeatureInfo& FeatureMgr::getAt( U32 index )
 
 ShaderFeature* FeatureMgr::getByType( const FeatureType &type )
 {
-   FeatureInfoVector::iterator iter = mFeatures.begin();
-   for ( ; iter != mFeatures.end(); iter++ )
-   {
-      if ( *iter->type == type )
-         return iter->feature;
-   }
+   const U32 id = type.getId();
+   if ( id >= mFeaturesById.size() )
+      return NULL;
 
-   return NULL;
+   return mFeaturesById[id];
 }
 
 void FeatureMgr::registerFeature(   const FeatureType &type, 
@@ -107,6 +106,16 @@ void FeatureMgr::registerFeature(   const FeatureType &type,
    mFeatures.last().type = &type;
    mFeatures.last().feature = feature;
 
+   const U32 id = type.getId();
+   if ( id >= mFeaturesById.size() )
+   {
+      const U32 oldSize = mFeaturesById.size();
+      mFeaturesById.setSize( id + 1 );
+      for ( U32 i = oldSize; i < mFeaturesById.size(); i++ )
+         mFeaturesById[i] = NULL;
+   }
+   mFeaturesById[id] = feature;
+
    // Make sure we resort the features.
    mNeedsSort = true;
 }
@@ -138,6 +147,7 @@ void FeatureMgr::unregisterFeature( const FeatureType &type )
 
       delete iter->feature;
       mFeatures.erase( iter );
+      mFeaturesById[ type.getId() ] = NULL;
       return;
    }
 }
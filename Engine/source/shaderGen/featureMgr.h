@@ -51,6 +51,10 @@ protected:
 
    FeatureInfoVector mFeatures;
 
+   /// Registered features indexed by FeatureType::getId() so
+   /// that getByType() doesn't need to search mFeatures.
+   Vector<ShaderFeature*> mFeaturesById;
+
    static S32 QSORT_CALLBACK _featureInfoCompare( const FeatureInfo *a, const FeatureInfo *b );
 
 public:
@@ -29,16 +29,19 @@
 // Language element
 //**************************************************************************
 Vector<LangElement*> LangElement::elementList( __FILE__, __LINE__ );
+LangElement::NameMap LangElement::smNameMap;
 
 //--------------------------------------------------------------------------
 // Constructor
 //--------------------------------------------------------------------------
 LangElement::LangElement()
 {
+   listIndex = elementList.size();
    elementList.push_back( this );
 
    static U32 tempNum = 0;
    dSprintf( (char*)name, sizeof(name), "tempName%d", tempNum++ );
+   _addToNameMap();
 }
 
 //--------------------------------------------------------------------------
@@ -46,15 +49,11 @@ LangElement::LangElement()
 //--------------------------------------------------------------------------
 LangElement * LangElement::find( const char *name )
 {
-   for( U32 i=0; i<elementList.size(); i++ )
-   {
-      if( !dStrcmp( (char*)elementList[i]->name, name ) )
-      {
-         return elementList[i];
-      }
-   }
-   
-   return NULL;
+   NameMap::Iterator iter = smNameMap.find( StringCase( name ) );
+   if ( iter == smNameMap.end() )
+      return NULL;
+
+   return iter->value;
 }
 
 //--------------------------------------------------------------------------
@@ -68,7 +67,7 @@ void LangElement::deleteElements()
    }
    
    elementList.setSize( 0 );
-
+   smNameMap.clear();
 }
 
 //--------------------------------------------------------------------------
@@ -76,8 +75,43 @@ void LangElement::deleteElements()
 //--------------------------------------------------------------------------
 void LangElement::setName(const char* newName )
 {
+   _removeFromNameMap();
+
    dStrncpy( ( char* ) name, newName, sizeof( name ) );
    name[ sizeof( name ) - 1 ] = '\0';
+
+   _addToNameMap();
+}
+
+//--------------------------------------------------------------------------
+// Name map
+//--------------------------------------------------------------------------
+void LangElement::_addToNameMap()
+{
+   NameMap::Iterator iter = smNameMap.findOrInsert( StringCase( String( (const char*)name ) ) );
+   if ( !iter->value || iter->value->listIndex > listIndex )
+      iter->value = this;
+}
+
+void LangElement::_removeFromNameMap()
+{
+   const StringCase key( String( (const char*)name ) );
+   NameMap::Iterator iter = smNameMap.find( key );
+   if ( iter == smNameMap.end() || iter->value != this )
+      return;
+
+   // Hand the name over to the next element using it, if any.
+   // Renaming an element is rare, so just walk the list.
+   for( U32 i=listIndex+1; i<elementList.size(); i++ )
+   {
+      if( !dStrcmp( (char*)elementList[i]->name, (char*)name ) )
+      {
+         iter->value = elementList[i];
+         return;
+      }
+   }
+
+   smNameMap.erase( iter );
 }
 
 //**************************************************************************
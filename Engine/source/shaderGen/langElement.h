@@ -30,6 +30,10 @@
 #include "core/stream/stream.h"
 #endif
 
+#ifndef _TDICTIONARY_H_
+#include "core/util/tDictionary.h"
+#endif
+
 #define WRITESTR( a ){ stream.write( dStrlen(a), a ); }
 
 
@@ -41,6 +45,10 @@
    When a shader needs to be written to disk, the elementList is
    traversed and print() is called on each LangElement and the shader
    is output.  elementList is cleared after each shader is printed out.
+
+   Elements are also indexed by name so that find() does not have to
+   walk the whole list; with the first element in elementList winning
+   when several share a name.
 */
 //**************************************************************************
 
@@ -55,12 +63,24 @@ struct LangElement
    static void deleteElements();
       
    U8    name[32];
+
+   /// Position of this element in elementList.
+   U32   listIndex;
    
    LangElement();
    virtual ~LangElement() {};
    virtual void print( Stream &stream ){};
    void setName(const char *newName );
 
+protected:
+
+   typedef HashTable<StringCase, LangElement*> NameMap;
+
+   /// Name to first element in elementList with that name.
+   static NameMap smNameMap;
+
+   void _addToNameMap();
+   void _removeFromNameMap();
 };
 
 enum ConstantSortPosition
@@ -24,6 +24,7 @@
 #include "core/dnet.h"
 #include "console/simBase.h"
 #include "sim/netConnection.h"
+#include "sim/netSnapshotHistory.h"
 #include "core/stream/bitStream.h"
 #include "core/stream/fileStream.h"
 #ifndef TORQUE_TGB_ONLY
@@ -217,6 +218,19 @@ static U32 gPacketUpdateDelayToServer = 32;
 static U32 gPacketRateToClient = 10;
 static U32 gPacketSize = 508;
 
+U32 NetConnection::smMaxGhostCount = NetConnection::MaxGhostCount;
+U32 NetConnection::smFileChunkWindow = 32;
+bool NetConnection::smCompressFileDownloads = true;
+bool NetConnection::smCongestionControl = true;
+U32 NetConnection::smCongestionTargetDelay = 100;
+F32 NetConnection::smMinSendRateScale = 0.1f;
+
+/// Length of the windows the base round trip is measured over in ms.
+static const U32 gBaseRoundTripWindow = 10000;
+
+/// Send rate scale change per acknowledged packet at full deviation from the target delay.
+static const F32 gSendRateGain = 0.01f;
+
 void NetConnection::consoleInit()
 {
    Con::addVariable("$pref::Net::PacketRateToServer", TypeS32, &gPacketRateToServer,
@@ -298,6 +312,82 @@ void NetConnection::consoleInit()
       "@brief The total number of ghosts added, removed, and/or updated on the client "
       "during the last packet process operation.\n\n"
 
+      "@ingroup Networking");
+
+   Con::addVariable("$Net::parallelGhostPriorities", TypeBool, &smParallelGhostPriorities,
+      "@brief If true, the server evaluates and sorts the ghost update priorities of "
+      "all connections that send in the same tick in parallel.\n\n"
+
+      "Scoping and packing updates still run on the main thread.  Only enable this when "
+      "the getUpdatePriority() overrides of all ghosted classes are thread-safe.  The "
+      "default value is false.\n\n"
+
+      "@ingroup Networking");
+
+   Con::addVariable("$Net::parallelGhostPrioritiesMinConnections", TypeS32, &smParallelGhostPrioritiesMinConnections,
+      "@brief Minimum number of connections sending in the same tick for "
+      "$Net::parallelGhostPriorities to take effect.  The default value is 4.\n\n"
+
+      "@ingroup Networking");
+
+   Con::addVariable("$Net::snapshotDeltas", TypeBool, &smSnapshotDeltas,
+      "@brief If true, the server delta-encodes ghost updates of players, vehicles and other objects "
+      "that support it against the last updates the client acknowledged.\n\n"
+
+      "This mostly helps on lossy connections where dropped updates would otherwise have to be "
+      "resent in full.  Clients always understand both encodings.  The default value is false.\n\n"
+
+      "@ingroup Networking");
+
+   Con::addVariable("$Net::maxGhostCount", TypeS32, &smMaxGhostCount,
+      "@brief The most objects a connection may ghost at once unless changed with "
+      "NetConnection::setGhostLimit().\n\n"
+
+      "Ghost tables start small and grow as objects come into scope, so memory per "
+      "connection follows the number of ghosts it actually has.  Values beyond 262144 "
+      "are clamped.  The default value is 262144.\n\n"
+
+      "@ingroup Networking");
+
+   Con::addVariable("$Net::fileChunkWindow", TypeS32, &smFileChunkWindow,
+      "@brief Number of file chunks the server keeps in transit while sending a missing file to a client.\n\n"
+
+      "Larger windows keep downloads going over connections with a long round trip time.  Clamped "
+      "to 1 - 96.  The default value is 32.\n\n"
+
+      "@ingroup Networking");
+
+   Con::addVariable("$Net::compressFileDownloads", TypeBool, &smCompressFileDownloads,
+      "@brief Whether the server zlib compresses files it sends to clients.\n\n"
+
+      "Files that do not get smaller are sent as they are.  The default value is true.\n\n"
+
+      "@ingroup Networking");
+
+   Con::addVariable("$Net::congestionControl", TypeBool, &smCongestionControl,
+      "@brief If true, each connection adapts its packet rate and size to the link.\n\n"
+
+      "The connection tracks the lowest round trip time it has seen recently.  When round "
+      "trips grow beyond it by more than $Net::congestionTargetDelay, packets are queuing up "
+      "somewhere along the route and the connection sends smaller packets less often.  Dropped "
+      "packets cut the rate as well.  While the link keeps up, the rate grows back to the one "
+      "negotiated from @$pref::Net::PacketRateToClient, @$pref::Net::PacketRateToServer and "
+      "@$pref::Net::PacketSize, which is never exceeded.  Local connections are not affected.  "
+      "The default value is true.\n\n"
+
+      "@see NetConnection::getSendRateScale()\n"
+      "@ingroup Networking");
+
+   Con::addVariable("$Net::congestionTargetDelay", TypeS32, &smCongestionTargetDelay,
+      "@brief Queuing delay in milliseconds above the lowest measured round trip that "
+      "$Net::congestionControl tolerates before lowering the send rate.  The default value is 100.\n\n"
+
+      "@ingroup Networking");
+
+   Con::addVariable("$Net::minSendRateScale", TypeF32, &smMinSendRateScale,
+      "@brief Lowest fraction of the negotiated send rate $Net::congestionControl may throttle "
+      "a connection to.  The default value is 0.1.\n\n"
+
       "@ingroup Networking");
 }
 
@@ -374,11 +464,16 @@ NetConnection::NetConnection()
    mLastUpdateTime = 0;
    mRoundTripTime = 0;
    mPacketLoss = 0;
+   resetTrafficStats();
+   mSendRateScale = 1.0f;
+   mSmoothedRoundTrip = 0;
+   mBaseRoundTrip[0] = mBaseRoundTrip[1] = U32_MAX;
+   mBaseRoundTripWindowStart = 0;
+   mLastSendRateCutTime = 0;
    mNextTableHash = NULL;
    mSendDelayCredit = 0;
    mConnectionState = NotConnected;
 
-   mCurrentDownloadingFile = NULL;
    mCurrentFileBuffer = NULL;
 
    mNextConnection = NULL;
@@ -415,9 +510,14 @@ NetConnection::NetConnection()
    mGhosting = false;
    mScoping = false;
    mGhostArray = NULL;
-   mGhostRefs = NULL;
+   mGhostUpdatesPrepared = false;
+   mGhostCapacity = 0;
+   mGhostLimit = 0;
    mGhostLookupTable = NULL;
+   mGhostLookupTableSize = 0;
    mLocalGhosts = NULL;
+   mLocalGhostCapacity = 0;
+   mLocalGhostSnapshots = NULL;
 
    mGhostsActive = 0;
 
@@ -429,10 +529,10 @@ NetConnection::NetConnection()
    mPingRetryCount = DefaultPingRetryCount;
    mLastPingSendTime = Platform::getVirtualMilliseconds();
 
-   mCurrentDownloadingFile = NULL;
    mCurrentFileBuffer = NULL;
    mCurrentFileBufferSize = 0;
    mCurrentFileBufferOffset = 0;
+   mCurrentFileCompressed = false;
    mNumDownloadedFiles = 0;
 
    // Disable starting a new journal recording or playback from here on
@@ -448,12 +548,20 @@ NetConnection::~NetConnection()
    netAddressTableRemove();
 
    dFree(mCurrentFileBuffer);
-   if(mCurrentDownloadingFile)
-      delete mCurrentDownloadingFile;
+
+   if(mLocalGhostSnapshots)
+   {
+      for(U32 i = 0; i < mLocalGhostCapacity; i++)
+         delete mLocalGhostSnapshots[i];
+      delete[] mLocalGhostSnapshots;
+   }
+   for(U32 i = 0; i < mGhostCapacity; i++)
+      delete getGhostRef(i)->snapshots;
+   for(U32 i = 0; i < mGhostRefChunks.size(); i++)
+      delete[] mGhostRefChunks[i];
 
    delete[] mLocalGhosts;
    delete[] mGhostLookupTable;
-   delete[] mGhostRefs;
    delete[] mGhostArray;
    delete mStringTable;
    if(mDemoWriteStream)
@@ -604,13 +712,56 @@ DefineEngineMethod( NetConnection, getPing, S32, (),,
 }
 
 DefineEngineMethod( NetConnection, getPacketLoss, S32, (),,
-   "@brief Returns the percentage of packets lost per tick.\n\n"
-
-   "@note This method is not yet hooked up.\n")
+   "@brief Returns the percentage of sent packets lost, averaged over roughly the last 32 packets.\n\n")
 {
    return( S32( 100 * object->getPacketLoss() ) );
 }
 
+DefineEngineMethod( NetConnection, getBytesSent, S32, (),,
+   "@brief Returns the number of bytes sent over the connection so far.\n\n")
+{
+   return object->getBytesSent();
+}
+
+DefineEngineMethod( NetConnection, getBytesReceived, S32, (),,
+   "@brief Returns the number of bytes received over the connection so far.\n\n")
+{
+   return object->getBytesReceived();
+}
+
+DefineEngineMethod( NetConnection, getSendRateScale, F32, (),,
+   "@brief Returns the fraction of the negotiated send rate the connection currently uses.\n\n"
+
+   "The value is 1 unless $Net::congestionControl has throttled the connection.\n\n"
+
+   "@see getSendDelay()\n"
+   "@see getSendPacketSize()\n")
+{
+   return object->getSendRateScale();
+}
+
+DefineEngineMethod( NetConnection, getSendDelay, S32, (),,
+   "@brief Returns the current delay between packets sent over the connection in ms.\n\n")
+{
+   return object->getSendDelay();
+}
+
+DefineEngineMethod( NetConnection, getSendPacketSize, S32, (),,
+   "@brief Returns the current maximum size of packets sent over the connection in bytes.\n\n")
+{
+   return object->getSendPacketSize();
+}
+
+DefineEngineMethod( NetConnection, getBaseRoundTripTime, S32, (),,
+   "@brief Returns the lowest round trip time (in ms) measured over the last 10 to 20 seconds "
+   "or -1 if no packet has been acknowledged yet.\n\n"
+
+   "Round trips beyond this are taken as packets queuing up along the route by $Net::congestionControl.\n")
+{
+   const U32 baseRoundTrip = object->getBaseRoundTripTime();
+   return ( baseRoundTrip == U32_MAX ? -1 : S32( baseRoundTrip ) );
+}
+
 DefineEngineMethod( NetConnection, checkMaxRate, void, (),,
    "@brief Ensures that all configured packet rates and sizes meet minimum requirements.\n\n"
 
@@ -708,13 +859,20 @@ void NetConnection::handleNotify(bool recvd)
 
    if(recvd) 
    {
-      // Running average of roundTrip time
+      // Running average of roundTrip time.  If the packet was read on the
+      // network thread, don't count the time it waited for us.
       U32 curTime = Platform::getVirtualMilliseconds();
-      mRoundTripTime = (mRoundTripTime + (curTime - note->sendTime)) * 0.5;
+      U32 roundTrip = curTime - note->sendTime;
+      roundTrip -= getMin(Net::getPacketAge(), roundTrip);
+      mRoundTripTime = (mRoundTripTime + roundTrip) * 0.5;
+      updateSendRate(true, roundTrip);
       packetReceived(note);
    }
    else
+   {
+      updateSendRate(false, 0);
       packetDropped(note);
+   }
 
    delete note;
 }
@@ -724,6 +882,9 @@ void NetConnection::processRawPacket(BitStream *bstream)
    if(mDemoWriteStream)
       recordBlock(BlockTypePacket, bstream->getReadByteSize(), bstream->getBuffer());
 
+   mBytesReceived += bstream->getReadByteSize();
+   mPacketsReceived++;
+
    ConnectionProtocol::processRawPacket(bstream);
 }
 
@@ -794,11 +955,95 @@ public:
    }
 };
 
-void NetConnection::checkPacketSend(bool force)
+void NetConnection::updateSendRate(bool recvd, U32 roundTrip)
 {
+   // Running average of packet loss over roughly the last 32 packets
+   mPacketLoss += ((recvd ? 0.0f : 1.0f) - mPacketLoss) * (1.0f / 32.0f);
+
+   if(!smCongestionControl || isLocalConnection())
+   {
+      mSendRateScale = 1.0f;
+      return;
+   }
+
    U32 curTime = Platform::getVirtualMilliseconds();
+   const F32 minScale = mClampF(smMinSendRateScale, 0.01f, 1.0f);
+
+   if(!recvd)
+   {
+      // Back off multiplicatively, but only once per round trip so a burst
+      // of drops from the same congestion event is only counted once.
+      if(curTime - mLastSendRateCutTime > getMax(U32(mSmoothedRoundTrip), U32(50)))
+      {
+         mSendRateScale = getMax(mSendRateScale * 0.75f, minScale);
+         mLastSendRateCutTime = curTime;
+      }
+      return;
+   }
+
+   // Track the lowest round trip over two overlapping windows so the base
+   // follows route changes without forgetting it every window.
+   if(curTime - mBaseRoundTripWindowStart > gBaseRoundTripWindow)
+   {
+      mBaseRoundTrip[1] = mBaseRoundTrip[0];
+      mBaseRoundTrip[0] = roundTrip;
+      mBaseRoundTripWindowStart = curTime;
+   }
+   else
+      mBaseRoundTrip[0] = getMin(mBaseRoundTrip[0], roundTrip);
+
+   if(mSmoothedRoundTrip == 0)
+      mSmoothedRoundTrip = F32(roundTrip);
+   else
+      mSmoothedRoundTrip += (F32(roundTrip) - mSmoothedRoundTrip) * 0.125f;
+
+   // Grow the rate while the queuing delay stays below the target and
+   // shrink it proportionally to how far it overshoots.
+   const F32 target = F32(getMax(smCongestionTargetDelay, U32(1)));
+   const F32 queuingDelay = getMax(mSmoothedRoundTrip - F32(getBaseRoundTripTime()), 0.0f);
+   const F32 offTarget = mClampF((target - queuingDelay) / target, -1.0f, 1.0f);
+
+   mSendRateScale = mClampF(mSendRateScale + gSendRateGain * offTarget, minScale, 1.0f);
+}
+
+U32 NetConnection::getSendDelay()
+{
    U32 delay = isConnectionToServer() ? gPacketUpdateDelayToServer : mCurRate.updateDelay;
 
+   // Split the slowdown evenly between the packet rate and the packet size.
+   if(mSendRateScale < 1.0f)
+      delay = U32(delay / mSqrt(mSendRateScale));
+
+   return delay;
+}
+
+S32 NetConnection::getSendPacketSize()
+{
+   S32 size = mCurRate.packetSize;
+
+   // Never go below half of the negotiated size so large updates still fit.
+   if(mSendRateScale < 1.0f)
+      size = getMax(S32(size * mSqrt(mSendRateScale)), size / 2);
+
+   return size;
+}
+
+bool NetConnection::isPacketSendDue()
+{
+   U32 curTime = Platform::getVirtualMilliseconds();
+   U32 delay = getSendDelay();
+
+   if(curTime < mLastUpdateTime + delay - mSendDelayCredit)
+      return false;
+
+   return !windowFull();
+}
+
+void NetConnection::checkPacketSend(bool force)
+{
+   U32 curTime = Platform::getVirtualMilliseconds();
+   U32 delay = getSendDelay();
+
    if(!force)
    {
       if(curTime < mLastUpdateTime + delay - mSendDelayCredit)
@@ -814,7 +1059,7 @@ void NetConnection::checkPacketSend(bool force)
    if(windowFull())
       return;
 
-   BitStream *stream = BitStream::getPacketStream(mCurRate.packetSize);
+   BitStream *stream = BitStream::getPacketStream(getSendPacketSize());
    buildSendPacketHeader(stream);
 
    mLastUpdateTime = curTime;
@@ -872,6 +1117,9 @@ Net::Error NetConnection::sendPacket(BitStream *stream)
 
    gNetBitsSent = stream->getPosition();
 
+   mBytesSent += stream->getPosition();
+   mPacketsSent++;
+
    if(isLocalConnection())
    {
       // short circuit connection to the other side.
@@ -1344,7 +1592,7 @@ DefineEngineMethod( NetConnection, resolveGhostID, S32, (S32 ghostID),,
    "@see @ref ghosting_scoping for a description of the ghosting system.\n\n")
 {
    // Safety check
-   if(ghostID < 0 || ghostID > NetConnection::MaxGhostCount) return 0;
+   if(ghostID < 0 || ghostID >= NetConnection::MaxGhostCount) return 0;
 
    NetObject *foo = object->resolveGhost(ghostID);
 
@@ -1371,7 +1619,7 @@ DefineEngineMethod( NetConnection, resolveObjectFromGhostIndex, S32, (S32 ghostI
    "@see @ref ghosting_scoping for a description of the ghosting system.\n\n")
 {
    // Safety check
-   if(ghostID < 0 || ghostID > NetConnection::MaxGhostCount) return 0;
+   if(ghostID < 0 || ghostID >= NetConnection::MaxGhostCount) return 0;
 
    NetObject *foo = object->resolveObjectFromGhostIndex(ghostID);
 
@@ -1405,6 +1653,27 @@ DefineEngineMethod( NetConnection, getGhostID, S32, (S32 realID),,
    }
 }
 
+DefineEngineMethod( NetConnection, setGhostLimit, void, (S32 limit),,
+   "@brief On the server, set the most objects this connection may ghost at once.\n\n"
+
+   "Objects coming into scope beyond the limit are not ghosted until other ghosts go out of scope.  "
+   "Lowering the limit does not drop ghosts that already exist.\n"
+
+   "@param limit Most ghosts for this connection.  Values beyond 262144 are clamped.\n\n"
+
+   "@see $Net::maxGhostCount\n\n")
+{
+   object->setGhostLimit(getMax(limit, 0));
+}
+
+DefineEngineMethod( NetConnection, getGhostLimit, S32, (),,
+   "@brief On the server, return the most objects this connection may ghost at once.\n\n"
+
+   "@see NetConnection::setGhostLimit()\n\n")
+{
+   return object->getGhostLimit();
+}
+
 DefineEngineMethod( NetConnection, connect, void, (const char* remoteAddress),,
    "@brief Connects to the remote address.\n\n"
 
@@ -54,6 +54,7 @@ class Point3F;
 
 struct GhostInfo;
 struct SubPacketRef; // defined in NetConnection subclass
+class NetSnapshotHistory;
 
 //#define DEBUG_NET
 
@@ -441,6 +442,7 @@ public:
       GhostInfo *ghost;          ///< Reference to the GhostInfo we're from.
       GhostRef *nextRef;         ///< Next GhostRef in this packet.
       GhostRef *nextUpdateChain; ///< Next update we sent for this ghost.
+      S32 snapshotSlot;          ///< NetSnapshotHistory slot the update was stored in or -1.
    };
 
    enum Constants
@@ -507,6 +509,42 @@ private:
    U32 mSimulatedPing;
    F32 mSimulatedPacketLoss;
 
+   /// Traffic through this connection since it was created or
+   /// resetTrafficStats() was last called.
+   U32 mBytesSent;
+   U32 mBytesReceived;
+   U32 mPacketsSent;
+   U32 mPacketsReceived;
+
+   /// @}
+
+   /// @name Congestion Control
+   ///
+   /// The send rate is scaled down from the negotiated rate whenever round
+   /// trips grow beyond the lowest recently measured round trip (i.e. packets
+   /// start queuing up somewhere along the route) or packets get dropped, and
+   /// scaled back up while the link keeps up.
+   /// @{
+
+   /// Factor between #smMinSendRateScale and 1 the negotiated send rate is scaled by.
+   F32 mSendRateScale;
+
+   /// Smoothed round trip time in milliseconds.
+   F32 mSmoothedRoundTrip;
+
+   /// Lowest round trip in the current and previous measurement windows.
+   U32 mBaseRoundTrip[2];
+
+   /// Start of the current base round trip measurement window.
+   U32 mBaseRoundTripWindowStart;
+
+   /// Last time the send rate was cut due to a dropped packet.
+   U32 mLastSendRateCutTime;
+
+   /// Update the send rate from the notify of a packet.  @a roundTrip is
+   /// only used if the packet was received.
+   void updateSendRate(bool recvd, U32 roundTrip);
+
    /// @}
 
    /// @name State
@@ -611,6 +649,13 @@ public:
    U32 getProtocolVersion()                     { return mProtocolVersion; }
    F32 getRoundTripTime()                       { return mRoundTripTime; }
    F32 getPacketLoss()                          { return( mPacketLoss ); }
+   F32 getSendRateScale()                       { return mSendRateScale; }
+   U32 getBaseRoundTripTime()                   { return getMin(mBaseRoundTrip[0], mBaseRoundTrip[1]); }
+   U32 getBytesSent() const                     { return mBytesSent; }
+   U32 getBytesReceived() const                 { return mBytesReceived; }
+   U32 getPacketsSent() const                   { return mPacketsSent; }
+   U32 getPacketsReceived() const               { return mPacketsReceived; }
+   void resetTrafficStats()                     { mBytesSent = mBytesReceived = mPacketsSent = mPacketsReceived = 0; }
 
    static String mErrorBuffer;
    static void setLastError(const char *fmt,...);
@@ -638,6 +683,15 @@ public:
 
    void checkPacketSend(bool force);
 
+   /// Return true if checkPacketSend(false) would send a packet right now.
+   bool isPacketSendDue();
+
+   /// Return the current delay between packets in milliseconds.
+   U32 getSendDelay();
+
+   /// Return the current maximum packet size in bytes.
+   S32 getSendPacketSize();
+
    bool missionPathsSent() const          { return mMissionPathsSent; }
    void setMissionPathsSent(const bool s) { mMissionPathsSent = s; }
 
@@ -802,8 +856,32 @@ protected:
                               ///
                               /// mLocalGhosts pointer is NULL if mGhostTo is false
 
-   GhostInfo *mGhostRefs;           ///< Allocated array of ghostInfos. Null if ghostFrom is false.
+   NetSnapshotHistory **mLocalGhostSnapshots; ///< Snapshot delta baselines of local ghosts.  Allocated on first use.
+
+   U32 mLocalGhostCapacity;   ///< Number of entries in mLocalGhosts and mLocalGhostSnapshots.
+
+   /// Allocated ghostInfos in chunks of GhostRefChunkSize.  Chunks never move,
+   /// so pointers to ghostInfos stay valid while the ghost array grows.
+   Vector<GhostInfo *> mGhostRefChunks;
+
+   U32 mGhostCapacity;              ///< Number of allocated ghostInfos and entries in mGhostArray.
+   U32 mGhostLimit;                 ///< Most ghosts this connection may ghost at once.
    GhostInfo **mGhostLookupTable;   ///< Table indexed by object id to GhostInfo. Null if ghostFrom is false.
+   U32 mGhostLookupTableSize;       ///< Number of buckets in mGhostLookupTable; a power of two.
+
+   /// Return the ghostInfo for ghost index @a index.
+   GhostInfo *getGhostRef(U32 index);
+
+   /// Return the lookup table bucket for @a obj.
+   GhostInfo **getGhostLookupBucket(NetObject *obj);
+
+   /// Double the number of ghostInfos, up to #mGhostLimit.
+   /// @return False if the limit has been reached.
+   bool growGhostArray();
+
+   /// Make sure @a index is a valid index into mLocalGhosts.
+   /// @return False if @a index is beyond MaxGhostCount.
+   bool reserveLocalGhost(U32 index);
 
    /// The object around which we are scoping this connection.
    ///
@@ -811,6 +889,13 @@ protected:
    /// that the player is driving.
    SimObjectPtr<NetObject> mScopeObject;
 
+   /// Camera information gathered by the last ghostScopeUpdates().
+   CameraScopeQuery mGhostCamInfo;
+
+   /// Set when NetInterface::prepareGhostUpdates() has already scoped and
+   /// prioritized the ghosts for the next ghostWritePacket().
+   bool mGhostUpdatesPrepared;
+
    void clearGhostInfo();
    bool validateGhostArray();
 
@@ -818,9 +903,33 @@ protected:
    void ghostPacketReceived(PacketNotify *notify);
 
    void ghostWritePacket(BitStream *bstream, PacketNotify *notify);
+
+   /// Find out which objects have come into and gone out of scope and drop
+   /// killed ghosts that were never sent.  Not thread-safe.
+   void ghostScopeUpdates();
+
+   /// Evaluate the update priorities of all ghosts with pending updates and
+   /// sort them by priority.  Only touches the ghost state of this connection
+   /// and NetObject::getUpdatePriority(), so it may run concurrently for
+   /// different connections.
+   void ghostPrioritizeUpdates();
    void ghostReadPacket(BitStream *bstream);
    void freeGhostInfo(GhostInfo *);
 
+   /// Pack an update for a ghost whose object uses snapshot deltas.
+   /// @see NetSnapshotHistory
+   U32 ghostPackSnapshotUpdate(GhostInfo *ghost, U32 updateMask, BitStream *bstream, GhostRef *ref);
+
+   /// Unpack an update written by ghostPackSnapshotUpdate().
+   void ghostUnpackSnapshotUpdate(U32 index, BitStream *bstream);
+
+   /// Return the snapshot delta baselines of the local ghost at @a index,
+   /// creating them if needed.
+   NetSnapshotHistory *getLocalGhostSnapshots(U32 index);
+
+   /// Discard the snapshot delta baselines of the local ghost at @a index.
+   void clearLocalGhostSnapshots(U32 index);
+
    void ghostWriteStartBlock(ResizeBitStream *stream);
    void ghostReadStartBlock(BitStream *stream);
 
@@ -837,10 +946,31 @@ public:
    {
       GhostIdBitSize = 18, //262,144 ghosts
       MaxGhostCount = 1 << GhostIdBitSize, //4096,
-      GhostLookupTableSize = 1 << GhostIdBitSize, //4096
-      GhostIndexBitSize = 4 // number of bits GhostIdBitSize-3 fits into
+      GhostIndexBitSize = 4, // number of bits GhostIdBitSize-3 fits into
+      GhostRefChunkSize = 256, ///< Ghost arrays grow in multiples of this.
+      SmallGhostIdBitSize = 10 ///< Bits writeGhostIndex() uses for small indices.
    };
 
+   /// Default for the most ghosts a connection may have at once, up to
+   /// MaxGhostCount.  Ghost arrays start small and grow up to this.
+   static U32 smMaxGhostCount;
+
+   /// Set the most ghosts this connection may have at once.  Does not drop
+   /// ghosts beyond the new limit.
+   void setGhostLimit(U32 limit) { mGhostLimit = getMin(limit, U32(MaxGhostCount)); }
+   U32 getGhostLimit() const { return mGhostLimit; }
+
+   /// Return the number of ghosts this connection currently has room for
+   /// without growing its ghost arrays.
+   U32 getGhostCapacity() const { return mGhostArray ? mGhostCapacity : mLocalGhostCapacity; }
+
+   /// Write a ghost index, taking SmallGhostIdBitSize + 1 bits for the
+   /// common small indices and GhostIdBitSize + 1 bits for the rest.
+   static void writeGhostIndex(BitStream *stream, U32 index);
+
+   /// Read a ghost index written by writeGhostIndex().
+   static S32 readGhostIndex(BitStream *stream);
+
    U32 getGhostsActive() { return mGhostsActive;};
 
    /// Are we ghosting to someone?
@@ -889,6 +1019,11 @@ public:
    /// meaningful on the server side.
    S32 getGhostIndex(NetObject *object);
 
+   /// Return true if the given NetObject has a ghost on this connection that
+   /// is not being killed, including ghosts that are still being sent.  This is
+   /// only meaningful on the server side.
+   bool isObjectGhosted(NetObject *object);
+
    /// Move a GhostInfo into the nonzero portion of the list (so that we know to update it).
    void ghostPushNonZero(GhostInfo *gi);
 
@@ -945,6 +1080,31 @@ public:
    /// before performing an operation.
    static Signal<void()> smGhostAlwaysDone;
 
+   /// If true, the server evaluates and sorts ghost update priorities of
+   /// different connections in parallel on the JobSystem.  Requires
+   /// NetObject::getUpdatePriority() of all ghosted classes to be thread-safe.
+   static bool smParallelGhostPriorities;
+
+   /// Minimum number of connections sending in the same tick for
+   /// #smParallelGhostPriorities to kick in.
+   static U32 smParallelGhostPrioritiesMinConnections;
+
+   /// If true, the server delta-encodes updates of ghosts that use snapshot
+   /// deltas against the last updates the client acknowledged.  Updates
+   /// to local clients are never delta-encoded.
+   /// @see NetObject::usesSnapshotDeltas
+   static bool smSnapshotDeltas;
+
+   /// If true, connections scale their send rate down when round trips grow
+   /// or packets are dropped.
+   static bool smCongestionControl;
+
+   /// Queuing delay in milliseconds the congestion control aims for.
+   static U32 smCongestionTargetDelay;
+
+   /// Lowest factor congestion control scales the send rate by.
+   static F32 smMinSendRateScale;
+
    /// @}
 public:
 //----------------------------------------------------------------
@@ -957,18 +1117,19 @@ protected:
    /// The currently downloading file is always first in the list (ie, [0]).
    Vector<char *> mMissingFileList;
 
-   /// Stream for currently uploading file (if any).
-   Stream *mCurrentDownloadingFile;
-
-   /// Storage for currently downloading file.
+   /// Storage for currently uploading or downloading file.
    void *mCurrentFileBuffer;
 
-   /// Size of currently downloading file in bytes.
+   /// Size of currently uploading or downloading file in bytes.
    U32 mCurrentFileBufferSize;
 
-   /// Our position in the currently downloading file in bytes.
+   /// Our position in the currently uploading or downloading file in bytes.
    U32 mCurrentFileBufferOffset;
 
+   /// Whether the currently downloading file is zlib compressed with its
+   /// uncompressed size in front.
+   bool mCurrentFileCompressed;
+
    /// Number of files we have downloaded.
    U32 mNumDownloadedFiles;
 
@@ -985,6 +1146,19 @@ protected:
    Vector<GhostSave> mGhostAlwaysSaveList;
 
 public:
+   enum
+   {
+      /// Most file chunks kept in transit; stays below the guaranteed
+      /// event window so other events can still get through.
+      MaxFileChunkWindow = 96,
+   };
+
+   /// Number of file chunks kept in transit while uploading a file.
+   static U32 smFileChunkWindow;
+
+   /// Whether to zlib compress uploaded files that get smaller by it.
+   static bool smCompressFileDownloads;
+
    /// Start sending the specified file over the link.
    bool startSendingFile(const char *fileName);
 
@@ -1086,6 +1260,8 @@ public:  // required for MSVC
 
    NetConnection::GhostRef *updateChain;  ///< List of references in NetConnections to us.
 
+   NetSnapshotHistory *snapshots;         ///< Snapshot delta baselines or NULL.
+
    GhostInfo *nextObjectRef;              ///< Next ghosted object.
    GhostInfo *prevObjectRef;              ///< Previous ghosted object.
    NetConnection *connection;             ///< Connection that we're ghosting over.
@@ -1112,6 +1288,17 @@ public:  // required for MSVC
    };
 };
 
+inline GhostInfo *NetConnection::getGhostRef(U32 index)
+{
+   AssertFatal(index < mGhostCapacity, "Out of range ghost index.");
+   return &mGhostRefChunks[index / GhostRefChunkSize][index % GhostRefChunkSize];
+}
+
+inline GhostInfo **NetConnection::getGhostLookupBucket(NetObject *obj)
+{
+   return &mGhostLookupTable[obj->getId() & (mGhostLookupTableSize - 1)];
+}
+
 inline void NetConnection::ghostPushNonZero(GhostInfo *info)
 {
    AssertFatal(info->arrayIndex >= mGhostZeroUpdateIndex && info->arrayIndex < mGhostFreeIndex, "Out of range arrayIndex.");
@@ -28,6 +28,8 @@
 #include "core/stream/bitStream.h"
 #include "core/stream/fileStream.h"
 #include "sim/netObject.h"
+#include "core/util/endian.h"
+#include "zlib/zlib.h"
 
 class FileDownloadRequestEvent : public NetEvent
 {
@@ -107,10 +109,11 @@ public:
    typedef NetEvent Parent;
    enum
    {
-      ChunkSize = 63,
+      MinChunkSize = 63,
+      MaxChunkSize = 255,
    };
 
-   U8 chunkData[ChunkSize];
+   U8 chunkData[MaxChunkSize];
    U32 chunkLen;
    
    FileChunkEvent(U8 *data = NULL, U32 len = 0)
@@ -122,19 +125,19 @@ public:
    
    virtual void pack(NetConnection *, BitStream *bstream)
    {
-      bstream->writeRangedU32(chunkLen, 0, ChunkSize);
+      bstream->writeRangedU32(chunkLen, 0, MaxChunkSize);
       bstream->write(chunkLen, chunkData);
    }
    
    virtual void write(NetConnection *, BitStream *bstream)
    {
-      bstream->writeRangedU32(chunkLen, 0, ChunkSize);
+      bstream->writeRangedU32(chunkLen, 0, MaxChunkSize);
       bstream->write(chunkLen, chunkData);
    }
    
    virtual void unpack(NetConnection *, BitStream *bstream)
    {
-      chunkLen = bstream->readRangedU32(0, ChunkSize);
+      chunkLen = bstream->readRangedU32(0, MaxChunkSize);
       bstream->read(chunkLen, chunkData);
    }
    
@@ -161,21 +164,23 @@ ConsoleDocClass( FileChunkEvent,
 
 void NetConnection::sendFileChunk()
 {
-   U8 buffer[FileChunkEvent::ChunkSize];
-   U32 len = FileChunkEvent::ChunkSize;
+   if(!mCurrentFileBuffer)
+      return;
+
+   // Use up to half a packet per chunk so ghosts and other events still fit.
+   U32 len = mClamp(getSendPacketSize() / 2, FileChunkEvent::MinChunkSize, FileChunkEvent::MaxChunkSize);
    if(len + mCurrentFileBufferOffset > mCurrentFileBufferSize)
       len = mCurrentFileBufferSize - mCurrentFileBufferOffset;
 
    if(!len)
    {
-      delete mCurrentDownloadingFile;
-      mCurrentDownloadingFile = NULL;
+      dFree(mCurrentFileBuffer);
+      mCurrentFileBuffer = NULL;
       return;
    }
 
+   postNetEvent(new FileChunkEvent(((U8 *) mCurrentFileBuffer) + mCurrentFileBufferOffset, len));
    mCurrentFileBufferOffset += len;
-   mCurrentDownloadingFile->read(len, buffer);
-   postNetEvent(new FileChunkEvent(buffer, len));
 }
 
 bool NetConnection::startSendingFile(const char *fileName)
@@ -186,8 +191,8 @@ bool NetConnection::startSendingFile(const char *fileName)
       return false;
    }
 
-   mCurrentDownloadingFile = FileStream::createAndOpen( fileName, Torque::FS::File::Read );
-   if(!mCurrentDownloadingFile)
+   FileStream *stream = FileStream::createAndOpen( fileName, Torque::FS::File::Read );
+   if(!stream)
    {
       // the server didn't have the file, so send a 0 byte chunk:
       Con::printf("No such file '%s'.", fileName);
@@ -196,12 +201,42 @@ bool NetConnection::startSendingFile(const char *fileName)
    }
 
    Con::printf("Sending file '%s'.", fileName);
-   mCurrentFileBufferSize = mCurrentDownloadingFile->getStreamSize();
+   const U32 fileSize = stream->getStreamSize();
+   U8 *fileData = (U8 *) dMalloc(fileSize);
+   stream->read(fileSize, fileData);
+   delete stream;
+
+   dFree(mCurrentFileBuffer);
+   mCurrentFileBuffer = fileData;
+   mCurrentFileBufferSize = fileSize;
    mCurrentFileBufferOffset = 0;
 
-   // always have 32 file chunks (64 bytes each) in transit
-   sendConnectionMessage(FileDownloadSizeMessage, mCurrentFileBufferSize);
-   for(U32 i = 0; i < 32; i++)
+   // Compressed files are sent with their uncompressed size in front; only
+   // bother if it actually saves something.
+   bool compressed = false;
+   if(smCompressFileDownloads && fileSize)
+   {
+      uLongf packedSize = compressBound(fileSize);
+      U8 *packed = (U8 *) dMalloc(packedSize + sizeof(U32));
+      if(compress2(packed + sizeof(U32), &packedSize, fileData, fileSize, Z_DEFAULT_COMPRESSION) == Z_OK &&
+         packedSize + sizeof(U32) < fileSize)
+      {
+         const U32 rawSize = convertHostToLEndian(fileSize);
+         dMemcpy(packed, &rawSize, sizeof(U32));
+
+         dFree(mCurrentFileBuffer);
+         mCurrentFileBuffer = packed;
+         mCurrentFileBufferSize = packedSize + sizeof(U32);
+         compressed = true;
+      }
+      else
+         dFree(packed);
+   }
+
+   // keep a window of file chunks in transit
+   sendConnectionMessage(FileDownloadSizeMessage, mCurrentFileBufferSize, compressed);
+   const U32 window = mClampU(smFileChunkWindow, 1, MaxFileChunkWindow);
+   for(U32 i = 0; i < window; i++)
       sendFileChunk();
    return true;
 }
@@ -247,6 +282,31 @@ void NetConnection::chunkReceived(U8 *chunkData, U32 chunkLen)
    if(mCurrentFileBufferOffset == mCurrentFileBufferSize)
    {
       // this file's done...
+      if(mCurrentFileCompressed)
+      {
+         U32 rawSize = 0;
+         if(mCurrentFileBufferSize >= sizeof(U32))
+         {
+            dMemcpy(&rawSize, mCurrentFileBuffer, sizeof(U32));
+            rawSize = convertLEndianToHost(rawSize);
+         }
+
+         uLongf unpackedSize = rawSize;
+         U8 *unpacked = (U8 *) dMalloc(getMax(rawSize, 1U));
+         if(rawSize == 0 || uncompress(unpacked, &unpackedSize, ((U8 *) mCurrentFileBuffer) + sizeof(U32), mCurrentFileBufferSize - sizeof(U32)) != Z_OK ||
+            unpackedSize != rawSize)
+         {
+            dFree(unpacked);
+            setLastError("Invalid compressed file from server.");
+            return;
+         }
+
+         dFree(mCurrentFileBuffer);
+         mCurrentFileBuffer = unpacked;
+         mCurrentFileBufferSize = rawSize;
+         mCurrentFileCompressed = false;
+      }
+
       // save it to disk:
       FileStream *stream;
 
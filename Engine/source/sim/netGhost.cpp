@@ -29,11 +29,16 @@
 //#include "core/resManager.h"
 #include "console/console.h"
 #include "console/consoleTypes.h"
+#include "platform/profiler.h"
+#include "sim/netSnapshotHistory.h"
 #include "console/engineAPI.h"
 
 #define DebugChecksum 0xF00DBAAD
 
 Signal<void()>    NetConnection::smGhostAlwaysDone;
+bool              NetConnection::smParallelGhostPriorities = false;
+U32               NetConnection::smParallelGhostPrioritiesMinConnections = 4;
+bool              NetConnection::smSnapshotDeltas = false;
 
 extern U32 gGhostUpdates;
 
@@ -65,7 +70,7 @@ public:
 
    void pack(NetConnection *ps, BitStream *bstream)
    {
-      bstream->writeInt(ghostIndex, NetConnection::GhostIdBitSize);
+      NetConnection::writeGhostIndex(bstream, ghostIndex);
 
       NetObject *obj = (NetObject *) Sim::findObject(objectId);
       if(bstream->writeFlag(obj != NULL))
@@ -85,7 +90,7 @@ public:
    }
    void write(NetConnection *ps, BitStream *bstream)
    {
-      bstream->writeInt(ghostIndex, NetConnection::GhostIdBitSize);
+      NetConnection::writeGhostIndex(bstream, ghostIndex);
       if(bstream->writeFlag(validObject))
       {
          S32 classId = object->getClassId(ps->getNetClassGroup());
@@ -102,7 +107,7 @@ public:
    }
    void unpack(NetConnection *ps, BitStream *bstream)
    {
-      ghostIndex = bstream->readInt(NetConnection::GhostIdBitSize);
+      ghostIndex = NetConnection::readGhostIndex(bstream);
 
       if(bstream->readFlag())
       {
@@ -167,11 +172,36 @@ void NetConnection::setGhostTo(bool ghostTo)
       return;
 
    if(ghostTo)
+      reserveLocalGhost(0);
+}
+
+bool NetConnection::reserveLocalGhost(U32 index)
+{
+   if(index >= MaxGhostCount)
+      return false;
+   if(mLocalGhosts && index < mLocalGhostCapacity)
+      return true;
+
+   U32 capacity = getMax(getNextPow2(index + 1), U32(GhostRefChunkSize));
+   capacity = getMin(capacity, U32(MaxGhostCount));
+
+   NetObject **localGhosts = new NetObject *[capacity];
+   for(U32 i = 0; i < capacity; i++)
+      localGhosts[i] = i < mLocalGhostCapacity ? mLocalGhosts[i] : NULL;
+   delete[] mLocalGhosts;
+   mLocalGhosts = localGhosts;
+
+   if(mLocalGhostSnapshots)
    {
-      mLocalGhosts = new NetObject *[MaxGhostCount];
-      for(S32 i = 0; i < MaxGhostCount; i++)
-         mLocalGhosts[i] = NULL;
+      NetSnapshotHistory **snapshots = new NetSnapshotHistory *[capacity];
+      for(U32 i = 0; i < capacity; i++)
+         snapshots[i] = i < mLocalGhostCapacity ? mLocalGhostSnapshots[i] : NULL;
+      delete[] mLocalGhostSnapshots;
+      mLocalGhostSnapshots = snapshots;
    }
+
+   mLocalGhostCapacity = capacity;
+   return true;
 }
 
 void NetConnection::setGhostFrom(bool ghostFrom)
@@ -182,19 +212,84 @@ void NetConnection::setGhostFrom(bool ghostFrom)
    if(ghostFrom)
    {
       mGhostFreeIndex = mGhostZeroUpdateIndex = 0;
-      mGhostArray = new GhostInfo *[MaxGhostCount];
-      mGhostRefs = new GhostInfo[MaxGhostCount];
-      S32 i;
-      for(i = 0; i < MaxGhostCount; i++)
+      setGhostLimit(smMaxGhostCount);
+      growGhostArray();
+   }
+}
+
+bool NetConnection::growGhostArray()
+{
+   const U32 limit = getMax(getMin(mGhostLimit, U32(MaxGhostCount)), U32(GhostRefChunkSize));
+   if(mGhostCapacity >= limit)
+      return false;
+
+   const U32 capacity = getMin(getMax(mGhostCapacity * 2, U32(GhostRefChunkSize)), limit);
+
+   // Add the new ghostInfos in chunks so the existing ones stay where they are.
+   U32 i;
+   for(i = mGhostRefChunks.size() * GhostRefChunkSize; i < capacity; i += GhostRefChunkSize)
+   {
+      GhostInfo *chunk = new GhostInfo[GhostRefChunkSize];
+      for(U32 j = 0; j < GhostRefChunkSize; j++)
       {
-         mGhostRefs[i].obj = NULL;
-         mGhostRefs[i].index = i;
-         mGhostRefs[i].updateMask = 0;
+         chunk[j].obj = NULL;
+         chunk[j].index = i + j;
+         chunk[j].updateMask = 0;
+         chunk[j].snapshots = NULL;
       }
-      mGhostLookupTable = new GhostInfo *[GhostLookupTableSize];
-      for(i = 0; i < GhostLookupTableSize; i++)
+      mGhostRefChunks.push_back(chunk);
+   }
+
+   const U32 oldCapacity = mGhostCapacity;
+   mGhostCapacity = capacity;
+
+   GhostInfo **ghostArray = new GhostInfo *[capacity];
+   for(i = 0; i < capacity; i++)
+   {
+      ghostArray[i] = i < oldCapacity ? mGhostArray[i] : getGhostRef(i);
+      ghostArray[i]->arrayIndex = i;
+   }
+   delete[] mGhostArray;
+   mGhostArray = ghostArray;
+
+   // Keep the lookup table about as large as the ghost array.
+   const U32 tableSize = getNextPow2(capacity);
+   if(tableSize != mGhostLookupTableSize)
+   {
+      delete[] mGhostLookupTable;
+      mGhostLookupTable = new GhostInfo *[tableSize];
+      mGhostLookupTableSize = tableSize;
+      for(i = 0; i < tableSize; i++)
          mGhostLookupTable[i] = 0;
+
+      // Detached ghosts wait for their kill to be acked without an object.
+      for(i = 0; i < mGhostFreeIndex; i++)
+      {
+         if(!mGhostArray[i]->obj)
+            continue;
+         GhostInfo **bucket = getGhostLookupBucket(mGhostArray[i]->obj);
+         mGhostArray[i]->nextLookupInfo = *bucket;
+         *bucket = mGhostArray[i];
+      }
    }
+
+   return true;
+}
+
+void NetConnection::writeGhostIndex(BitStream *stream, U32 index)
+{
+   AssertFatal(index < MaxGhostCount, "NetConnection::writeGhostIndex - invalid ghost index");
+   if(stream->writeFlag(index < (1 << SmallGhostIdBitSize)))
+      stream->writeInt(index, SmallGhostIdBitSize);
+   else
+      stream->writeInt(index, GhostIdBitSize);
+}
+
+S32 NetConnection::readGhostIndex(BitStream *stream)
+{
+   if(stream->readFlag())
+      return stream->readInt(SmallGhostIdBitSize);
+   return stream->readInt(GhostIdBitSize);
 }
 
 void NetConnection::ghostOnRemove()
@@ -242,6 +337,11 @@ void NetConnection::ghostPacketDropped(PacketNotify *notify)
             packRef->ghost->updateMask |= orFlags;
       }
 
+      // the client never got this update, so it can't be a baseline
+
+      if(packRef->snapshotSlot != -1 && packRef->ghost->snapshots)
+         packRef->ghost->snapshots->setEmpty(packRef->snapshotSlot);
+
       // if this packet was ghosting an object, set it
       // to re ghost at it's earliest convenience
 
@@ -286,6 +386,11 @@ void NetConnection::ghostPacketReceived(PacketNotify *notify)
 
       *walk = 0;
 
+      // the client has this update now, so we can delta against it
+
+      if(packRef->snapshotSlot != -1 && packRef->ghost->snapshots)
+         packRef->ghost->snapshots->setAcked(packRef->snapshotSlot);
+
       // if this object was ghosting , it is now ghosted
 
       if(packRef->ghostInfoFlags & GhostInfo::Ghosting)
@@ -319,32 +424,14 @@ static S32 QSORT_CALLBACK UQECompare(const void *a,const void *b)
    return (ret < 0) ? -1 : ((ret > 0) ? 1 : 0);
 }
 
-void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
+void NetConnection::ghostScopeUpdates()
 {
-#ifdef    TORQUE_DEBUG_NET
-   bstream->writeInt(DebugChecksum, 32);
-#endif
-
-   notify->ghostList = NULL;
-
-   if(!isGhostingFrom())
-      return;
-
-   if(!bstream->writeFlag(mGhosting))
-      return;
-
-   // fill a packet (or two) with ghosting data
-
-   // first step is to check all our polled ghosts:
+   PROFILE_SCOPE(NetConnection_GhostScopeUpdates);
 
    // 1. Scope query - find if any new objects have come into
    //    scope and if any have gone out.
-   // 2. call scoped objects' priority functions if the flag set is nonzero
-   //    A removed ghost is assumed to have a high priority
-   // 3. call updates based on sorted priority until the packet is
-   //    full.  set flags to zero for all updated objects
 
-   CameraScopeQuery camInfo;
+   CameraScopeQuery &camInfo = mGhostCamInfo;
 
    camInfo.camera = NULL;
    camInfo.pos.set(0,0,0);
@@ -357,7 +444,6 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
    GhostInfo *walk;
 
    // only need to worry about the ghosts that have update masks set...
-   S32 maxIndex = 0;
    S32 i;
    for(i = 0; i < mGhostZeroUpdateIndex; i++)
    {
@@ -384,36 +470,92 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
          detachObject(mGhostArray[i]);
    }
 
+   // clear out any kill objects that haven't been ghosted yet
    for(i = mGhostZeroUpdateIndex - 1; i >= 0; i--)
    {
       walk = mGhostArray[i];
-      if(walk->index > maxIndex)
-         maxIndex = walk->index;
-
-      // clear out any kill objects that haven't been ghosted yet
       if((walk->flags & GhostInfo::KillGhost) && (walk->flags & GhostInfo::NotYetGhosted))
-      {
          freeGhostInfo(walk);
-         continue;
-      }
+   }
+}
+
+void NetConnection::ghostPrioritizeUpdates()
+{
+   PROFILE_SCOPE(NetConnection_GhostPrioritizeUpdates);
+
+   // 2. call scoped objects' priority functions if the flag set is nonzero
+   //    A removed ghost is assumed to have a high priority
+
+   S32 i;
+   for(i = mGhostZeroUpdateIndex - 1; i >= 0; i--)
+   {
+      GhostInfo *walk = mGhostArray[i];
+
       // don't do any ghost processing on objects that are being killed
       // or in the process of ghosting
-      else if(!(walk->flags & (GhostInfo::KillingGhost | GhostInfo::Ghosting)))
+      if(!(walk->flags & (GhostInfo::KillingGhost | GhostInfo::Ghosting)))
       {
          if(walk->flags & GhostInfo::KillGhost)
             walk->priority = 10000;
          else
-            walk->priority = walk->obj->getUpdatePriority(&camInfo, walk->updateMask, walk->updateSkipCount);
+            walk->priority = walk->obj->getUpdatePriority(&mGhostCamInfo, walk->updateMask, walk->updateSkipCount);
       }
       else
          walk->priority = 0;
    }
-   GhostRef *updateList = NULL;
    dQsort(mGhostArray, mGhostZeroUpdateIndex, sizeof(GhostInfo *), UQECompare);
 
    // reset the array indices...
    for(i = mGhostZeroUpdateIndex - 1; i >= 0; i--)
       mGhostArray[i]->arrayIndex = i;
+}
+
+void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
+{
+#ifdef    TORQUE_DEBUG_NET
+   bstream->writeInt(DebugChecksum, 32);
+#endif
+
+   notify->ghostList = NULL;
+
+   const bool updatesPrepared = mGhostUpdatesPrepared;
+   mGhostUpdatesPrepared = false;
+
+   if(!isGhostingFrom())
+      return;
+
+   if(!bstream->writeFlag(mGhosting))
+      return;
+
+   // fill a packet (or two) with ghosting data
+
+   // first step is to check all our polled ghosts:
+
+   // 1. Scope query - find if any new objects have come into
+   //    scope and if any have gone out.
+   // 2. call scoped objects' priority functions if the flag set is nonzero
+   //    A removed ghost is assumed to have a high priority
+   // 3. call updates based on sorted priority until the packet is
+   //    full.  set flags to zero for all updated objects
+   //
+   // NetInterface::prepareGhostUpdates() may have done the first two
+   // steps for us already.
+
+   if(!updatesPrepared)
+   {
+      ghostScopeUpdates();
+      ghostPrioritizeUpdates();
+   }
+
+   GhostRef *updateList = NULL;
+
+   S32 maxIndex = 0;
+   S32 i;
+   for(i = mGhostZeroUpdateIndex - 1; i >= 0; i--)
+   {
+      if(mGhostArray[i]->index > maxIndex)
+         maxIndex = mGhostArray[i]->index;
+   }
 
    S32 sendSize = 1;
    while(maxIndex >>= 1)
@@ -446,6 +588,7 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
 
       upd->ghost = walk;
       upd->ghostInfoFlags = 0;
+      upd->snapshotSlot = -1;
 
       if(walk->flags & GhostInfo::KillGhost)
       {
@@ -463,7 +606,8 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
 #ifdef TORQUE_DEBUG_NET
          U32 startPos = bstream->getCurPos();
 #endif
-         if(walk->flags & GhostInfo::NotYetGhosted)
+         const bool newGhost = (walk->flags & GhostInfo::NotYetGhosted) != 0;
+         if(newGhost)
          {
             S32 classId = walk->obj->getClassId(getNetClassGroup());
             bstream->writeClassId(classId, NetClassTypeObject, getNetClassGroup());
@@ -485,9 +629,15 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
          // update the object
 #ifdef TORQUE_NET_STATS
          U32 beginSize = bstream->getBitPosition();
+         bstream->setNetStatCategoryBits(walk->obj->getClassRep()->mNetStatCategoryBits);
 #endif
-         U32 retMask = walk->obj->packUpdate(this, updateMask, bstream);
+         U32 retMask;
+         if(!newGhost && walk->obj->usesSnapshotDeltas())
+            retMask = ghostPackSnapshotUpdate(walk, updateMask, bstream, upd);
+         else
+            retMask = walk->obj->packUpdate(this, updateMask, bstream);
 #ifdef TORQUE_NET_STATS
+         bstream->setNetStatCategoryBits(NULL);
          walk->obj->getClassRep()->updateNetStatPack(updateMask, bstream->getBitPosition() - beginSize);
 #endif
          DEBUG_LOG(("PKLOG %d GHOST %d: %s", getId(), bstream->getBitPosition() - 16 - startPos, walk->obj->getClassName()));
@@ -516,6 +666,146 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
    notify->ghostList = updateList;
 }
 
+U32 NetConnection::ghostPackSnapshotUpdate(GhostInfo *walk, U32 updateMask, BitStream *bstream, GhostRef *upd)
+{
+   // Packets to a local client never leave the process, so saving bits
+   // isn't worth packing every update twice and keeping snapshot histories
+   // on both ends of the connection.
+   if(!bstream->writeFlag(smSnapshotDeltas && !isLocalConnection()))
+      return walk->obj->packUpdate(this, updateMask, bstream);
+
+   // Pack into a scratch stream first so we can compare against the baselines.
+   // The compression point is copied as the object may compress against it
+   // and any changes it makes to it must not leak into the packet.
+
+   static U8 sScratchBuffer[Net::MaxPacketDataSize];
+   BitStream scratch(sScratchBuffer, sizeof(sScratchBuffer));
+   scratch.setCompressionPoint(bstream->getCompressionPoint());
+
+#ifdef TORQUE_NET_STATS
+   // Break down the update before delta encoding; the encoded size still
+   // shows in the packUpdate totals.
+   scratch.setNetStatCategoryBits(bstream->getNetStatCategoryBits());
+   bstream->setNetStatCategoryBits(NULL);
+#endif
+
+   U32 retMask = walk->obj->packUpdate(this, updateMask, &scratch);
+   const U32 numBits = scratch.getCurPos();
+   AssertFatal(numBits <= NetSnapshotHistory::MaxUpdateBits, "NetConnection::ghostPackSnapshotUpdate - Update too large");
+
+   if(!walk->snapshots)
+      walk->snapshots = new NetSnapshotHistory;
+   NetSnapshotHistory *history = walk->snapshots;
+
+   const S32 baseSlot = history->findBaseline(updateMask);
+   const S32 slot = history->findFreeSlot(baseSlot);
+
+   if(bstream->writeFlag(slot != -1))
+      bstream->writeInt(slot, NetSnapshotHistory::SlotBits);
+
+   const bool useDelta = (baseSlot != -1 && history->getDeltaSize(baseSlot, sScratchBuffer, numBits) < numBits);
+   if(bstream->writeFlag(useDelta))
+   {
+      bstream->writeInt(baseSlot, NetSnapshotHistory::SlotBits);
+      history->writeDelta(bstream, baseSlot, sScratchBuffer, numBits);
+   }
+   else
+      bstream->writeBits(numBits, sScratchBuffer);
+
+   if(slot != -1)
+   {
+      history->store(slot, sScratchBuffer, numBits, updateMask, NetSnapshotHistory::SlotPending);
+      upd->snapshotSlot = slot;
+   }
+
+   return retMask;
+}
+
+void NetConnection::ghostUnpackSnapshotUpdate(U32 index, BitStream *bstream)
+{
+   NetObject *ghost = mLocalGhosts[index];
+
+   if(!bstream->readFlag())
+   {
+      ghost->unpackUpdate(this, bstream);
+      return;
+   }
+
+   S32 slot = -1;
+   if(bstream->readFlag())
+      slot = bstream->readInt(NetSnapshotHistory::SlotBits);
+
+   NetSnapshotHistory *history = getLocalGhostSnapshots(index);
+
+   static U8 sScratchBuffer[(NetSnapshotHistory::MaxUpdateBits + 7) >> 3];
+   U32 numBits;
+
+   if(bstream->readFlag())
+   {
+      const S32 baseSlot = bstream->readInt(NetSnapshotHistory::SlotBits);
+      if(!history->readDelta(bstream, baseSlot, sScratchBuffer, numBits))
+      {
+         setLastError("Invalid packet. (bad snapshot delta)");
+         return;
+      }
+
+      BitStream scratch(sScratchBuffer, (numBits + 7) >> 3);
+      scratch.setCompressionPoint(bstream->getCompressionPoint());
+      ghost->unpackUpdate(this, &scratch);
+
+      if(scratch.getCurPos() != numBits)
+      {
+         setLastError("Invalid packet. (snapshot delta size mismatch)");
+         return;
+      }
+   }
+   else
+   {
+      // The server packed this into a stream of its own, so don't let the
+      // object change the compression point of the packet.
+      const Point3F compressionPoint = bstream->getCompressionPoint();
+      const U32 startPos = bstream->getCurPos();
+
+      ghost->unpackUpdate(this, bstream);
+
+      bstream->setCompressionPoint(compressionPoint);
+      numBits = bstream->getCurPos() - startPos;
+
+      if(slot != -1)
+      {
+         if(numBits > NetSnapshotHistory::MaxUpdateBits)
+         {
+            setLastError("Invalid packet. (snapshot update too large)");
+            return;
+         }
+         bstream->setCurPos(startPos);
+         bstream->readBits(numBits, sScratchBuffer);
+      }
+   }
+
+   if(slot != -1)
+      history->store(slot, sScratchBuffer, numBits, 0, NetSnapshotHistory::SlotAcked);
+}
+
+NetSnapshotHistory *NetConnection::getLocalGhostSnapshots(U32 index)
+{
+   if(!mLocalGhostSnapshots)
+   {
+      mLocalGhostSnapshots = new NetSnapshotHistory *[mLocalGhostCapacity];
+      for(U32 i = 0; i < mLocalGhostCapacity; i++)
+         mLocalGhostSnapshots[i] = NULL;
+   }
+   if(!mLocalGhostSnapshots[index])
+      mLocalGhostSnapshots[index] = new NetSnapshotHistory;
+   return mLocalGhostSnapshots[index];
+}
+
+void NetConnection::clearLocalGhostSnapshots(U32 index)
+{
+   if(mLocalGhostSnapshots)
+      SAFE_DELETE(mLocalGhostSnapshots[index]);
+}
+
 void NetConnection::ghostReadPacket(BitStream *bstream)
 {
 #ifdef    TORQUE_DEBUG_NET
@@ -543,12 +833,18 @@ void NetConnection::ghostReadPacket(BitStream *bstream)
       U32 index;
       //S32 startPos = bstream->getCurPos();
       index = (U32) bstream->readInt(idSize);
+      if(!reserveLocalGhost(index))
+      {
+         setLastError("Invalid packet. (invalid ghost index)");
+         return;
+      }
       if(bstream->readFlag()) // is this ghost being deleted?
       {
 		 mGhostsActive--;
          AssertFatal(mLocalGhosts[index] != NULL, "Error, NULL ghost encountered.");
          mLocalGhosts[index]->deleteObject();
          mLocalGhosts[index] = NULL;
+         clearLocalGhostSnapshots(index);
       }
       else
       {
@@ -641,7 +937,10 @@ void NetConnection::ghostReadPacket(BitStream *bstream)
 #ifdef TORQUE_NET_STATS
             U32 beginSize = bstream->getBitPosition();
 #endif
-            mLocalGhosts[index]->unpackUpdate(this, bstream);
+            if(mLocalGhosts[index]->usesSnapshotDeltas())
+               ghostUnpackSnapshotUpdate(index, bstream);
+            else
+               mLocalGhosts[index]->unpackUpdate(this, bstream);
 #ifdef TORQUE_NET_STATS
             mLocalGhosts[index]->getClassRep()->updateNetStatUnpack(bstream->getBitPosition() - beginSize);
 #endif
@@ -695,7 +994,7 @@ void NetConnection::detachObject(GhostInfo *info)
 
       // remove it from the lookup table
       U32 id = info->obj->getId();
-      for(GhostInfo **walk = &mGhostLookupTable[id & (GhostLookupTableSize - 1)]; *walk; walk = &((*walk)->nextLookupInfo))
+      for(GhostInfo **walk = &mGhostLookupTable[id & (mGhostLookupTableSize - 1)]; *walk; walk = &((*walk)->nextLookupInfo))
       {
          GhostInfo *temp = *walk;
          if(temp == info)
@@ -729,7 +1028,7 @@ void NetConnection::objectLocalScopeAlways(NetObject *obj)
    if(!isGhostingFrom())
       return;
    objectInScope(obj);
-   for(GhostInfo *walk = mGhostLookupTable[obj->getId() & (GhostLookupTableSize - 1)]; walk; walk = walk->nextLookupInfo)
+   for(GhostInfo *walk = *getGhostLookupBucket(obj); walk; walk = walk->nextLookupInfo)
    {
       if(walk->obj != obj)
          continue;
@@ -742,7 +1041,7 @@ void NetConnection::objectLocalClearAlways(NetObject *obj)
 {
    if(!isGhostingFrom())
       return;
-   for(GhostInfo *walk = mGhostLookupTable[obj->getId() & (GhostLookupTableSize - 1)]; walk; walk = walk->nextLookupInfo)
+   for(GhostInfo *walk = *getGhostLookupBucket(obj); walk; walk = walk->nextLookupInfo)
    {
       if(walk->obj != obj)
          continue;
@@ -754,7 +1053,7 @@ void NetConnection::objectLocalClearAlways(NetObject *obj)
 bool NetConnection::validateGhostArray()
 {
    AssertFatal(mGhostZeroUpdateIndex >= 0 && mGhostZeroUpdateIndex <= mGhostFreeIndex, "Invalid update index range.");
-   AssertFatal(mGhostFreeIndex <= MaxGhostCount, "Invalid free index range.");
+   AssertFatal(mGhostFreeIndex <= mGhostCapacity, "Invalid free index range.");
    U32 i;
    for(i = 0; i < mGhostZeroUpdateIndex; i ++)
    {
@@ -766,7 +1065,7 @@ bool NetConnection::validateGhostArray()
       AssertFatal(mGhostArray[i]->arrayIndex == i, "Invalid array index.");
       AssertFatal(mGhostArray[i]->updateMask == 0, "Invalid ghost mask.");
    }
-   for(; i < MaxGhostCount; i++)
+   for(; i < mGhostCapacity; i++)
    {
       AssertFatal(mGhostArray[i]->arrayIndex == i, "Invalid array index.");
    }
@@ -780,7 +1079,7 @@ void NetConnection::objectInScope(NetObject *obj)
 	if (obj->isScopeLocal() && !isLocalConnection())
 		return;
 
-   S32 index = obj->getId() & (GhostLookupTableSize - 1);
+   S32 index = obj->getId() & (mGhostLookupTableSize - 1);
 
    // check if it's already in scope
    // the object may have been cleared out without the lookupTable being cleared
@@ -799,7 +1098,7 @@ void NetConnection::objectInScope(NetObject *obj)
       return;
    }
 
-   if (mGhostFreeIndex == MaxGhostCount)
+   if (mGhostFreeIndex >= mGhostLimit || (mGhostFreeIndex == mGhostCapacity && !growGhostArray()))
    {
       AssertWarn(0,"NetConnection::objectInScope: too many ghosts");
       return;
@@ -818,6 +1117,8 @@ void NetConnection::objectInScope(NetObject *obj)
    giptr->obj = obj;
    giptr->updateChain = NULL;
    giptr->updateSkipCount = 0;
+   if(giptr->snapshots)
+      giptr->snapshots->reset();
 
    giptr->connection = this;
 
@@ -879,13 +1180,14 @@ void NetConnection::handleConnectionMessage(U32 message, U32 sequence, U32 ghost
          onEndGhosting();
          // just delete all the local ghosts,
          // and delete all the ghosts in the current save list
-         for(i = 0; i < MaxGhostCount; i++)
+         for(i = 0; i < mLocalGhostCapacity; i++)
          {
             if(mLocalGhosts[i])
             {
                mLocalGhosts[i]->deleteObject();
                mLocalGhosts[i] = NULL;
             }
+            clearLocalGhostSnapshots(i);
          }
          while(mGhostAlwaysSaveList.size())
          {
@@ -903,6 +1205,7 @@ void NetConnection::handleConnectionMessage(U32 message, U32 sequence, U32 ghost
          mCurrentFileBufferSize = sequence;
          mCurrentFileBuffer = dRealloc(mCurrentFileBuffer, mCurrentFileBufferSize);
          mCurrentFileBufferOffset = 0;
+         mCurrentFileCompressed = ghostCount != 0;
          break;
    }
 }
@@ -926,16 +1229,26 @@ void NetConnection::activateGhosting()
    U32 sz = ghostAlwaysSet->size();
    S32 j;
 
+   // Ghost always objects go to the top of the ghost array, so make room for
+   // them and the first few scoped objects.
+   if(sz > mGhostLimit)
+   {
+      Con::warnf("NetConnection::activateGhosting - raising ghost limit to %d for ghost always objects", sz);
+      setGhostLimit(sz);
+   }
+   while(mGhostCapacity < sz + GhostRefChunkSize && growGhostArray())
+      ;
+
    for(j = 0; j < sz; j++)
    {
-      U32 idx = MaxGhostCount - sz + j;
-      mGhostArray[j] = mGhostRefs + idx;
+      U32 idx = mGhostCapacity - sz + j;
+      mGhostArray[j] = getGhostRef(idx);
       mGhostArray[j]->arrayIndex = j;
    }
-   for(j = sz; j < MaxGhostCount; j++)
+   for(j = sz; j < mGhostCapacity; j++)
    {
       U32 idx = j - sz;
-      mGhostArray[j] = mGhostRefs + idx;
+      mGhostArray[j] = getGhostRef(idx);
       mGhostArray[j]->arrayIndex = j;
    }
    mScoping = true; // so that objectInScope will work
@@ -1040,12 +1353,13 @@ void NetConnection::clearGhostInfo()
       ghostPacketReceived(walk);
       walk->ghostList = NULL;
    }
-   for(S32 i = 0; i < MaxGhostCount; i++)
+   for(U32 i = 0; i < mGhostCapacity; i++)
    {
-      if(mGhostRefs[i].arrayIndex < mGhostFreeIndex)
+      GhostInfo *ghost = getGhostRef(i);
+      if(ghost->arrayIndex < mGhostFreeIndex)
       {
-         detachObject(&mGhostRefs[i]);
-         freeGhostInfo(&mGhostRefs[i]);
+         detachObject(ghost);
+         freeGhostInfo(ghost);
       }
    }
    AssertFatal((mGhostFreeIndex == 0) && (mGhostZeroUpdateIndex == 0), "Invalid indices.");
@@ -1074,6 +1388,12 @@ void NetConnection::setGhostAlwaysObject(NetObject *object, U32 index)
       setLastError("Invalid packet. (unexpected ghostalways)");
       return;
    }
+   if(!reserveLocalGhost(index))
+   {
+      object->deleteObject();
+      setLastError("Invalid packet. (invalid ghost always index)");
+      return;
+   }
    object->mNetFlags = NetObject::IsGhost;
    object->mNetIndex = index;
 
@@ -1185,19 +1505,23 @@ void NetConnection::loadNextGhostAlwaysObject(bool hadNewFiles)
 
 NetObject *NetConnection::resolveGhost(S32 id)
 {
+   if(U32(id) >= mLocalGhostCapacity)
+      return NULL;
    return mLocalGhosts[id];
 }
 
 NetObject *NetConnection::resolveObjectFromGhostIndex(S32 id)
 {
-   return mGhostRefs[id].obj;
+   if(U32(id) >= mGhostCapacity)
+      return NULL;
+   return getGhostRef(id)->obj;
 }
 
 S32 NetConnection::getGhostIndex(NetObject *obj)
 {
    if(!isGhostingFrom())
       return obj->mNetIndex;
-   S32 index = obj->getId() & (GhostLookupTableSize - 1);
+   S32 index = obj->getId() & (mGhostLookupTableSize - 1);
 
    for(GhostInfo *gptr = mGhostLookupTable[index]; gptr; gptr = gptr->nextLookupInfo)
    {
@@ -1207,6 +1531,20 @@ S32 NetConnection::getGhostIndex(NetObject *obj)
    return -1;
 }
 
+bool NetConnection::isObjectGhosted(NetObject *obj)
+{
+   if(!isGhostingFrom())
+      return false;
+   S32 index = obj->getId() & (mGhostLookupTableSize - 1);
+
+   for(GhostInfo *gptr = mGhostLookupTable[index]; gptr; gptr = gptr->nextLookupInfo)
+   {
+      if(gptr->obj == obj)
+         return (gptr->flags & (GhostInfo::KillingGhost | GhostInfo::KillGhost)) == 0;
+   }
+   return false;
+}
+
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
@@ -1225,12 +1563,12 @@ void NetConnection::ghostWriteStartBlock(ResizeBitStream *stream)
    stream->write(mGhostingSequence);
 
    // first write out the indices and ids:
-   for(U32 i = 0; i < MaxGhostCount; i++)
+   for(U32 i = 0; i < mLocalGhostCapacity; i++)
    {
       if(mLocalGhosts[i])
       {
          stream->writeFlag(true);
-         stream->writeInt(i, GhostIdBitSize);
+         writeGhostIndex(stream, i);
          stream->writeClassId(mLocalGhosts[i]->getClassId(getNetClassGroup()), NetClassTypeObject, getNetClassGroup());
          stream->validate();
       }
@@ -1244,7 +1582,7 @@ void NetConnection::ghostWriteStartBlock(ResizeBitStream *stream)
    // then, for each ghost written into the start block, write the full pack update
    // into the start block.  For demos to work properly, packUpdate must
    // be callable from client objects.
-   for(U32 i = 0; i < MaxGhostCount; i++)
+   for(U32 i = 0; i < mLocalGhostCapacity; i++)
    {
       if(mLocalGhosts[i])
       {
@@ -1253,6 +1591,22 @@ void NetConnection::ghostWriteStartBlock(ResizeBitStream *stream)
          stream->validate();
       }
    }
+
+   // finally, the snapshot baselines so the recorded packets can be decoded.
+   if(mLocalGhostSnapshots)
+   {
+      for(U32 i = 0; i < mLocalGhostCapacity; i++)
+      {
+         if(mLocalGhostSnapshots[i])
+         {
+            stream->writeFlag(true);
+            writeGhostIndex(stream, i);
+            mLocalGhostSnapshots[i]->write(stream);
+            stream->validate();
+         }
+      }
+   }
+   stream->writeFlag(false);
 }
 
 void NetConnection::ghostReadStartBlock(BitStream *stream)
@@ -1264,7 +1618,12 @@ void NetConnection::ghostReadStartBlock(BitStream *stream)
 
    while(stream->readFlag())
    {
-      U32 index = stream->readInt(GhostIdBitSize);
+      U32 index = readGhostIndex(stream);
+      if(!reserveLocalGhost(index))
+      {
+         setLastError("Invalid packet. (invalid ghost index in demo block)");
+         return;
+      }
       S32 tag = stream->readClassId(NetClassTypeObject, getNetClassGroup());
       NetObject *obj = (NetObject *) ConsoleObject::create(getNetClassGroup(), NetClassTypeObject, tag);
       if(!obj)
@@ -1281,7 +1640,7 @@ void NetConnection::ghostReadStartBlock(BitStream *stream)
    // through all non-null mLocalGhosts, unpacking the objects
    // as we go:
 
-   for(U32 i = 0; i < MaxGhostCount; i++)
+   for(U32 i = 0; i < mLocalGhostCapacity; i++)
    {
       if(mLocalGhosts[i])
       {
@@ -1295,6 +1654,17 @@ void NetConnection::ghostReadStartBlock(BitStream *stream)
          addObject(mLocalGhosts[i]);
       }
    }
+
+   while(stream->readFlag())
+   {
+      U32 index = readGhostIndex(stream);
+      if(!reserveLocalGhost(index))
+      {
+         setLastError("Invalid packet. (invalid ghost index in demo block)");
+         return;
+      }
+      getLocalGhostSnapshots(index)->read(stream);
+   }
    // MARKF - TODO - looks like we could have memory leaks here
    // if there are errors.
 }
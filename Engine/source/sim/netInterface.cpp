@@ -27,6 +27,8 @@
 #include "math/mRandom.h"
 #include "core/util/journal/journal.h"
 #include "console/engineAPI.h"
+#include "platform/threads/jobSystem.h"
+#include "platform/profiler.h"
 
 #ifdef GGC_PLUGIN
 #include "GGCNatTunnel.h" 
@@ -429,17 +431,62 @@ void NetInterface::processClient()
       if(walk->isConnectionToServer() && (walk->isLocalConnection() || walk->isNetworkConnection()))
          walk->checkPacketSend(false);
    }
+   Net::flushSends();
 }
 
 void NetInterface::processServer()
 {
    NetObject::collapseDirtyList(); // collapse all the mask bits...
+   if(NetConnection::smParallelGhostPriorities)
+      prepareGhostUpdates();
+
    for(NetConnection *walk = NetConnection::getConnectionList();
       walk; walk = walk->getNext())
    {
       if(!walk->isConnectionToServer() && (walk->isLocalConnection() || walk->isNetworkConnection()))
          walk->checkPacketSend(false);
+
+      // Prepared updates are only good for this round of sends.
+      walk->mGhostUpdatesPrepared = false;
    }
+
+   // Hand all packets of this tick to the socket in as few calls as possible.
+   Net::flushSends();
+}
+
+void NetInterface::prepareGhostUpdates()
+{
+   PROFILE_SCOPE(NetInterface_PrepareGhostUpdates);
+
+   mGhostUpdateConnections.clear();
+   for(NetConnection *walk = NetConnection::getConnectionList();
+      walk; walk = walk->getNext())
+   {
+      if(!walk->isConnectionToServer() && (walk->isLocalConnection() || walk->isNetworkConnection()) &&
+         walk->isGhostingFrom() && walk->isGhosting() && walk->isPacketSendDue())
+         mGhostUpdateConnections.push_back(walk);
+   }
+
+   // Not worth the job overhead; let ghostWritePacket() do it inline.
+   if(mGhostUpdateConnections.size() < NetConnection::smParallelGhostPrioritiesMinConnections)
+      return;
+
+   // Scoping walks the scene graph and links ghost infos into lists that are
+   // shared between connections, so it has to stay serial.
+   for(U32 i = 0; i < mGhostUpdateConnections.size(); i++)
+      mGhostUpdateConnections[i]->ghostScopeUpdates();
+
+   JobSystem::GLOBAL().parallelFor(mGhostUpdateConnections.size(), 1, &_prioritizeGhostUpdatesJob, this);
+
+   for(U32 i = 0; i < mGhostUpdateConnections.size(); i++)
+      mGhostUpdateConnections[i]->mGhostUpdatesPrepared = true;
+}
+
+void NetInterface::_prioritizeGhostUpdatesJob(void *data, U32 start, U32 end)
+{
+   NetInterface *netInterface = reinterpret_cast<NetInterface *>(data);
+   for(U32 i = start; i < end; i++)
+      netInterface->mGhostUpdateConnections[i]->ghostPrioritizeUpdates();
 }
 
 void NetInterface::startConnection(NetConnection *conn)
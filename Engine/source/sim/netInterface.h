@@ -77,9 +77,22 @@ protected:
       TimeoutCheckInterval = 1500,  ///< Interval in milliseconds between checking for connection timeouts.
    };
 
+   /// Server connections whose ghost updates were prepared by prepareGhostUpdates().
+   Vector<NetConnection *> mGhostUpdateConnections;
+
    /// Initialize random data.
    void initRandomData();
 
+   /// Run the scope query and priority sort of all server connections that are
+   /// about to send a packet ahead of the send loop in processServer().  Scoping
+   /// runs serially, the priority evaluation and sorting of the different
+   /// connections runs in parallel on the JobSystem.
+   ///
+   /// @see NetConnection::smParallelGhostPriorities
+   void prepareGhostUpdates();
+
+   static void _prioritizeGhostUpdatesJob(void *data, U32 start, U32 end);
+
    /// @name Connection management
    /// Most of these are pretty self-explanatory.
    /// @{
@@ -331,6 +331,10 @@ public:
    /// In subclasses, this can be adjusted. For instance, ShapeBase provides priority
    /// based on proximity to the camera.
    ///
+   /// With NetConnection::smParallelGhostPriorities enabled, this is called
+   /// concurrently for different connections from worker threads, so overrides
+   /// must only read object state and must not call into script.
+   ///
    /// @param  focusObject    Information from a previous call to onCameraScopeQuery.
    /// @param  updateMask     Current update mask.
    /// @param  updateSkips    Number of ticks we haven't been updated for.
@@ -353,6 +357,16 @@ public:
    /// @param   stream  stream to read from
    virtual void unpackUpdate(NetConnection * conn, BitStream *stream);
 
+   /// Return true if updates of this object may be delta-encoded against
+   /// earlier updates the client has acknowledged.
+   ///
+   /// This pays off for objects that send similar updates at a high rate, like
+   /// players and vehicles.  The return value must be the same for all objects
+   /// of a class as the client asks its ghost to decide how to read an update.
+   ///
+   /// @see NetConnection::smSnapshotDeltas, NetSnapshotHistory
+   virtual bool usesSnapshotDeltas() const { return false; }
+
    /// Queries the object about information used to determine scope.
    ///
    /// Something that is 'in scope' is somehow interesting to the client.
@@ -0,0 +1,220 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "sim/netSnapshotHistory.h"
+
+#include "core/stream/bitStream.h"
+
+
+// Deltas are sent a byte at a time: one flag telling whether the byte
+// differs from the baseline followed by the XORed byte if it does.  The
+// last byte only carries the bits the update actually has.
+
+static inline U32 _getByteBits( U32 numBits, U32 byteIndex )
+{
+   const U32 remaining = numBits - byteIndex * 8;
+   return ( remaining < 8 ? remaining : 8 );
+}
+
+//-----------------------------------------------------------------------------
+
+NetSnapshotHistory::NetSnapshotHistory()
+{
+   reset();
+}
+
+//-----------------------------------------------------------------------------
+
+void NetSnapshotHistory::reset()
+{
+   for( U32 i = 0; i < NumSlots; ++ i )
+   {
+      mSlots[ i ].state = SlotEmpty;
+      mSlots[ i ].mask = 0;
+      mSlots[ i ].stamp = 0;
+      mSlots[ i ].numBits = 0;
+   }
+
+   mStamp = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+S32 NetSnapshotHistory::findBaseline( U32 mask ) const
+{
+   S32 newest = -1;
+   S32 newestWithMask = -1;
+
+   for( S32 i = 0; i < NumSlots; ++ i )
+   {
+      const Slot& slot = mSlots[ i ];
+      if( slot.state != SlotAcked )
+         continue;
+
+      if( newest == -1 || S32( slot.stamp - mSlots[ newest ].stamp ) > 0 )
+         newest = i;
+      if( slot.mask == mask && ( newestWithMask == -1 || S32( slot.stamp - mSlots[ newestWithMask ].stamp ) > 0 ) )
+         newestWithMask = i;
+   }
+
+   return ( newestWithMask != -1 ? newestWithMask : newest );
+}
+
+//-----------------------------------------------------------------------------
+
+S32 NetSnapshotHistory::findFreeSlot( S32 keepSlot ) const
+{
+   S32 oldestAcked = -1;
+
+   for( S32 i = 0; i < NumSlots; ++ i )
+   {
+      const Slot& slot = mSlots[ i ];
+      if( slot.state == SlotEmpty )
+         return i;
+
+      if( slot.state == SlotAcked && i != keepSlot &&
+          ( oldestAcked == -1 || S32( slot.stamp - mSlots[ oldestAcked ].stamp ) < 0 ) )
+         oldestAcked = i;
+   }
+
+   return oldestAcked;
+}
+
+//-----------------------------------------------------------------------------
+
+void NetSnapshotHistory::store( S32 slotIndex, const U8* data, U32 numBits, U32 mask, SlotState state )
+{
+   AssertFatal( slotIndex >= 0 && slotIndex < NumSlots, "NetSnapshotHistory::store - Invalid slot" );
+   AssertFatal( numBits <= MaxUpdateBits, "NetSnapshotHistory::store - Update too large" );
+
+   Slot& slot = mSlots[ slotIndex ];
+
+   const U32 numBytes = ( numBits + 7 ) >> 3;
+   slot.data.setSize( numBytes );
+   if( numBytes )
+   {
+      dMemcpy( slot.data.address(), data, numBytes );
+
+      // Clear the unused bits so both sides XOR against the same bytes.
+      const U32 lastBits = _getByteBits( numBits, numBytes - 1 );
+      slot.data[ numBytes - 1 ] &= U8( ( 1 << lastBits ) - 1 );
+   }
+
+   slot.state = state;
+   slot.mask = mask;
+   slot.stamp = ++ mStamp;
+   slot.numBits = numBits;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 NetSnapshotHistory::getDeltaSize( S32 baseSlot, const U8* data, U32 numBits ) const
+{
+   const Slot& base = mSlots[ baseSlot ];
+   const U32 numBytes = ( numBits + 7 ) >> 3;
+
+   U32 size = LengthBits + numBytes;
+   for( U32 i = 0; i < numBytes; ++ i )
+   {
+      const U32 byteBits = _getByteBits( numBits, i );
+      const U8 delta = ( data[ i ] ^ _getBaseByte( base, i ) ) & U8( ( 1 << byteBits ) - 1 );
+      if( delta )
+         size += byteBits;
+   }
+
+   return size;
+}
+
+//-----------------------------------------------------------------------------
+
+void NetSnapshotHistory::writeDelta( BitStream* stream, S32 baseSlot, const U8* data, U32 numBits ) const
+{
+   const Slot& base = mSlots[ baseSlot ];
+   const U32 numBytes = ( numBits + 7 ) >> 3;
+
+   stream->writeInt( numBits, LengthBits );
+   for( U32 i = 0; i < numBytes; ++ i )
+   {
+      const U32 byteBits = _getByteBits( numBits, i );
+      const U8 delta = ( data[ i ] ^ _getBaseByte( base, i ) ) & U8( ( 1 << byteBits ) - 1 );
+      if( stream->writeFlag( delta != 0 ) )
+         stream->writeInt( delta, byteBits );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+bool NetSnapshotHistory::readDelta( BitStream* stream, S32 baseSlot, U8* outData, U32& outNumBits ) const
+{
+   const Slot& base = mSlots[ baseSlot ];
+   if( base.state == SlotEmpty )
+      return false;
+
+   outNumBits = stream->readInt( LengthBits );
+
+   const U32 numBytes = ( outNumBits + 7 ) >> 3;
+   for( U32 i = 0; i < numBytes; ++ i )
+   {
+      U8 delta = 0;
+      if( stream->readFlag() )
+         delta = stream->readInt( _getByteBits( outNumBits, i ) );
+
+      outData[ i ] = _getBaseByte( base, i ) ^ delta;
+   }
+
+   return stream->isValid();
+}
+
+//-----------------------------------------------------------------------------
+
+void NetSnapshotHistory::write( BitStream* stream ) const
+{
+   for( U32 i = 0; i < NumSlots; ++ i )
+   {
+      const Slot& slot = mSlots[ i ];
+      if( stream->writeFlag( slot.state != SlotEmpty ) )
+      {
+         stream->writeInt( slot.numBits, LengthBits );
+         stream->writeBits( slot.numBits, slot.data.address() );
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void NetSnapshotHistory::read( BitStream* stream )
+{
+   U8 buffer[ ( MaxUpdateBits + 7 ) >> 3 ];
+
+   for( U32 i = 0; i < NumSlots; ++ i )
+   {
+      if( stream->readFlag() )
+      {
+         const U32 numBits = stream->readInt( LengthBits );
+         stream->readBits( numBits, buffer );
+         store( i, buffer, numBits, 0, SlotAcked );
+      }
+      else
+         setEmpty( i );
+   }
+}
@@ -0,0 +1,163 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _NETSNAPSHOTHISTORY_H_
+#define _NETSNAPSHOTHISTORY_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+
+class BitStream;
+
+
+/// A small ring of packed ghost updates that later updates of the same ghost
+/// can be delta-encoded against.
+///
+/// Both sides of a connection keep one history per ghost that uses snapshot
+/// deltas (see NetObject::usesSnapshotDeltas()).  The server stores every
+/// update it sends in a free slot and tells the client which slot that was.
+/// Once the packet carrying the update is acknowledged, the slot becomes a
+/// baseline the server may encode new updates against: the new packUpdate()
+/// output is XORed with the baseline bytes and only non-zero bytes are sent.
+/// Since the client stored the very same bits in the same slot when it
+/// received the update, it can undo the XOR.
+///
+/// Slots of updates that are still in flight are never reused and slots of
+/// dropped updates are discarded on the server, so the server only ever
+/// refers to data the client is known to have.
+class NetSnapshotHistory
+{
+   public:
+
+      enum Constants
+      {
+         /// Number of updates kept per ghost.
+         NumSlots = 8,
+
+         /// Bits needed to send a slot index.
+         SlotBits = 3,
+
+         /// Bits used to send the length of an update.
+         LengthBits = 14,
+
+         /// Largest update in bits that can be stored.
+         MaxUpdateBits = BIT( LengthBits ) - 1,
+      };
+
+      enum SlotState
+      {
+         SlotEmpty,
+
+         /// Sent, but not acknowledged yet.
+         SlotPending,
+
+         /// Acknowledged by the client; usable as a baseline.
+         SlotAcked,
+      };
+
+   protected:
+
+      struct Slot
+      {
+         U32 state;
+
+         /// Update mask the update was packed with.
+         U32 mask;
+
+         /// Value of #mStamp when the slot was written.
+         U32 stamp;
+
+         U32 numBits;
+         Vector< U8 > data;
+      };
+
+      Slot mSlots[ NumSlots ];
+
+      /// Counter to tell older from newer slots.
+      U32 mStamp;
+
+      /// Return byte @a index of @a slot's data or 0 beyond its end.
+      U8 _getBaseByte( const Slot& slot, U32 index ) const
+      {
+         return ( index < slot.data.size() ? slot.data[ index ] : 0 );
+      }
+
+   public:
+
+      NetSnapshotHistory();
+
+      /// Discard all slots.
+      void reset();
+
+      /// Return true if @a slot holds an update.
+      bool hasData( S32 slot ) const { return ( mSlots[ slot ].state != SlotEmpty ); }
+
+      /// @name Server Side
+      /// @{
+
+      /// Return the newest acknowledged slot, preferring slots packed with
+      /// @a mask, or -1 if there is none.
+      S32 findBaseline( U32 mask ) const;
+
+      /// Return a slot a new update may be stored in without touching
+      /// @a keepSlot or -1 if all slots are in use.
+      S32 findFreeSlot( S32 keepSlot ) const;
+
+      /// Mark the update in @a slot as received by the client.
+      void setAcked( S32 slot ) { mSlots[ slot ].state = SlotAcked; }
+
+      /// Discard the update in @a slot.
+      void setEmpty( S32 slot ) { mSlots[ slot ].state = SlotEmpty; }
+
+      /// Return the number of bits writeDelta() needs to encode @a numBits bits of
+      /// @a data against @a baseSlot.
+      U32 getDeltaSize( S32 baseSlot, const U8* data, U32 numBits ) const;
+
+      /// Write @a numBits bits of @a data encoded against @a baseSlot.
+      void writeDelta( BitStream* stream, S32 baseSlot, const U8* data, U32 numBits ) const;
+
+      /// @}
+
+      /// Store @a numBits bits of @a data packed with @a mask in @a slot.
+      void store( S32 slot, const U8* data, U32 numBits, U32 mask, SlotState state );
+
+      /// Decode an update written by writeDelta() into @a outData, which must
+      /// hold at least MaxUpdateBits bits.
+      /// @return False if @a baseSlot holds no data or the update is malformed.
+      bool readDelta( BitStream* stream, S32 baseSlot, U8* outData, U32& outNumBits ) const;
+
+      /// @name Demo Support
+      /// @{
+
+      void write( BitStream* stream ) const;
+      void read( BitStream* stream );
+
+      /// @}
+};
+
+#endif // _NETSNAPSHOTHISTORY_H_
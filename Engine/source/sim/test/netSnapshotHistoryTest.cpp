@@ -0,0 +1,98 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "sim/netSnapshotHistory.h"
+#include "core/stream/bitStream.h"
+
+TEST(NetSnapshotHistory, Slots)
+{
+   NetSnapshotHistory history;
+   U8 data[ 4 ] = { 1, 2, 3, 4 };
+
+   EXPECT_EQ(history.findBaseline(0), -1)
+      << "Empty history should have no baseline";
+
+   for (S32 i = 0; i < NetSnapshotHistory::NumSlots; i++)
+   {
+      const S32 slot = history.findFreeSlot(-1);
+      ASSERT_NE(slot, -1);
+      history.store(slot, data, 32, 0, NetSnapshotHistory::SlotPending);
+   }
+   EXPECT_EQ(history.findFreeSlot(-1), -1)
+      << "Pending slots must not be reused";
+   EXPECT_EQ(history.findBaseline(0), -1)
+      << "Pending slots are no baselines";
+
+   history.setAcked(2);
+   history.setAcked(5);
+   EXPECT_EQ(history.findBaseline(0), 5) << "Newest acked slot should win";
+   EXPECT_EQ(history.findFreeSlot(5), 2) << "Baseline slot should be kept";
+
+   history.store(2, data, 32, BIT(3), NetSnapshotHistory::SlotAcked);
+   EXPECT_EQ(history.findBaseline(BIT(3)), 2) << "Matching mask should win";
+   EXPECT_EQ(history.findBaseline(BIT(4)), 2);
+
+   history.setEmpty(2);
+   EXPECT_EQ(history.findBaseline(BIT(3)), 5);
+};
+
+TEST(NetSnapshotHistory, Delta)
+{
+   NetSnapshotHistory server, client;
+
+   U8 base[ 16 ], update[ 16 ];
+   for (U32 i = 0; i < sizeof(base); i++)
+      base[i] = update[i] = U8(i * 37 + 11);
+   update[3] ^= 0x10;
+   update[15] ^= 0x01;
+
+   const U32 numBits = 125;
+   server.store(1, base, numBits, 0, NetSnapshotHistory::SlotAcked);
+   client.store(1, base, numBits, 0, NetSnapshotHistory::SlotAcked);
+
+   EXPECT_LT(server.getDeltaSize(1, update, numBits), numBits)
+      << "Mostly unchanged updates should compress";
+
+   U8 buffer[ 64 ];
+   dMemset(buffer, 0, sizeof(buffer));
+   BitStream out(buffer, sizeof(buffer));
+   server.writeDelta(&out, 1, update, numBits);
+   EXPECT_EQ(U32(out.getCurPos()), server.getDeltaSize(1, update, numBits));
+
+   BitStream in(buffer, sizeof(buffer));
+   U8 decoded[ (NetSnapshotHistory::MaxUpdateBits + 7) >> 3 ];
+   U32 decodedBits;
+   ASSERT_TRUE(client.readDelta(&in, 1, decoded, decodedBits));
+   EXPECT_EQ(decodedBits, numBits);
+   for (U32 i = 0; i < 15; i++)
+      EXPECT_EQ(decoded[i], update[i]);
+   EXPECT_EQ(decoded[15] & 0x1F, update[15] & 0x1F)
+      << "Bits in the last byte should survive";
+
+   BitStream again(buffer, sizeof(buffer));
+   EXPECT_FALSE(client.readDelta(&again, 0, decoded, decodedBits))
+      << "Empty baselines must be rejected";
+};
+
+#endif
@@ -36,10 +36,114 @@
 #include "console/engineAPI.h"
 
 #include "console/consoleInternal.h"
+#include "console/simEvents.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/mutex.h"
+#include "platform/threads/semaphore.h"
 #include <cstdlib>
 
 IMPLEMENT_CONOBJECT(SQLiteObject);
 
+//-----------------------------------------------------------------------
+// Async query support.  Queries are run in the order they were queued on
+// a single worker thread, using the same (serialized) connection but its
+// own statement cache.  Results are handed back to the main thread as
+// SimEvents so the script callbacks run during normal event processing.
+
+class SQLiteAsyncQueryEvent : public SimEvent
+{
+public:
+	SQLiteAsyncQueryEvent(sqlite_asyncquery* pQuery) : m_pQuery(pQuery) {}
+
+	~SQLiteAsyncQueryEvent()
+	{
+		// Only left set if the object went away before the event was processed.
+		if (m_pQuery)
+		{
+			SQLiteObject::DeleteResultSet(m_pQuery->pResultSet);
+			delete m_pQuery;
+		}
+	}
+
+	void process(SimObject* object)
+	{
+		((SQLiteObject*)object)->CompleteAsyncQuery(m_pQuery);
+		m_pQuery = NULL;
+	}
+
+private:
+	sqlite_asyncquery* m_pQuery;
+};
+
+class SQLiteAsyncThread : public Thread
+{
+public:
+	SQLiteAsyncThread(SQLiteObject* pOwner, sqlite3* pDatabase)
+		: m_pOwner(pOwner),
+		  m_pDatabase(pDatabase),
+		  m_Semaphore(0),
+		  m_bStopping(false)
+	{
+	}
+
+	void Queue(sqlite_asyncquery* pQuery)
+	{
+		m_Mutex.lock();
+		m_vQueue.push_back(pQuery);
+		m_Mutex.unlock();
+
+		m_Semaphore.release();
+	}
+
+	// Finishes the queued queries, then exits.
+	void Shutdown()
+	{
+		m_bStopping = true;
+		m_Semaphore.release();
+		join();
+	}
+
+	void run(void* arg)
+	{
+		while (true)
+		{
+			m_Semaphore.acquire();
+
+			m_Mutex.lock();
+			if (m_vQueue.empty())
+			{
+				m_Mutex.unlock();
+				if (m_bStopping)
+					break;
+				continue;
+			}
+			sqlite_asyncquery* pQuery = m_vQueue.front();
+			m_vQueue.pop_front();
+			m_Mutex.unlock();
+
+			pQuery->pResultSet = SQLiteObject::RunStatement(m_pDatabase, m_StatementCache, pQuery->sql, pQuery->vArgs, pQuery->error);
+
+			// The owner joins this thread before it is unregistered, so it is safe to post to.
+			Sim::postEvent(m_pOwner, new SQLiteAsyncQueryEvent(pQuery), -1);
+
+			// Keep draining if more work was queued while stopping.
+			if (m_bStopping)
+				m_Semaphore.release();
+		}
+
+		SQLiteObject::FinalizeStatements(m_StatementCache);
+	}
+
+private:
+	SQLiteObject*                    m_pOwner;
+	sqlite3*                         m_pDatabase;
+	sqlite_statementcache            m_StatementCache;
+	Mutex                            m_Mutex;
+	Semaphore                        m_Semaphore;
+	Vector<sqlite_asyncquery*>       m_vQueue;
+	volatile bool                    m_bStopping;
+};
+
 
 SQLiteObject::SQLiteObject()
 {
@@ -47,6 +151,9 @@ SQLiteObject::SQLiteObject()
    m_szErrorString = NULL;
    m_iLastResultSet = 0;
    m_iNextResultSet = 1;
+   m_bInTransaction = false;
+   m_pAsyncThread = NULL;
+   m_iNextAsyncQuery = 1;
 }
 
 SQLiteObject::~SQLiteObject()
@@ -261,10 +368,293 @@ S32 SQLiteObject::ExecuteSQL(const char* sql)
 
 void SQLiteObject::CloseDatabase()
 {
+	// Let queued async queries finish, and release every compiled statement,
+	// as SQLite will not close a connection with live statements.
+	StopAsyncThread();
+	ClearStatementCache();
+
 	if (m_pDatabase)
+	{
+		if (m_bInTransaction)
+		{
+			Con::warnf("SQLiteObject Warning: Closing the database with an open transaction.  Rolling it back.");
+			sqlite3_exec(m_pDatabase, "ROLLBACK;", NULL, NULL, NULL);
+		}
+
 		sqlite3_close(m_pDatabase);
+	}
 
 	m_pDatabase = NULL;
+	m_bInTransaction = false;
+}
+
+//-----------------------------------------------------------------------
+// Prepared statements
+
+S32 SQLiteObject::AddResultSet(sqlite_resultset* pResultSet)
+{
+	pResultSet->iResultSet = m_iNextResultSet;
+	m_iLastResultSet = m_iNextResultSet;
+	m_iNextResultSet++;
+
+	SaveResultSet(pResultSet);
+	return pResultSet->iResultSet;
+}
+
+static void BindArgument(sqlite3_stmt* pStatement, S32 index, const String& arg)
+{
+	// Bind numbers as numbers so SQLite stores and compares them without
+	// string conversion; anything else is bound as text.
+	const char* pArg = arg.c_str();
+	char* pEnd = NULL;
+
+	if (pArg[0])
+	{
+		long long iValue = strtoll(pArg, &pEnd, 10);
+		if (*pEnd == 0)
+		{
+			sqlite3_bind_int64(pStatement, index, iValue);
+			return;
+		}
+
+		double fValue = strtod(pArg, &pEnd);
+		if (*pEnd == 0)
+		{
+			sqlite3_bind_double(pStatement, index, fValue);
+			return;
+		}
+	}
+
+	sqlite3_bind_text(pStatement, index, pArg, arg.length(), SQLITE_TRANSIENT);
+}
+
+sqlite_resultset* SQLiteObject::RunStatement(sqlite3* pDatabase, sqlite_statementcache& cache, const char* sql, const Vector<String>& args, String& error)
+{
+	if (!pDatabase)
+	{
+		error = "No database is open.";
+		return NULL;
+	}
+
+	// Fetch the compiled statement, compiling it on first use.
+	sqlite3_stmt* pStatement = NULL;
+	sqlite_statementcache::Iterator itr = cache.find(sql);
+	if (itr != cache.end())
+		pStatement = itr->value;
+	else
+	{
+		if (sqlite3_prepare_v2(pDatabase, sql, -1, &pStatement, NULL) != SQLITE_OK)
+		{
+			error = sqlite3_errmsg(pDatabase);
+			return NULL;
+		}
+		cache.insertUnique(sql, pStatement);
+	}
+
+	sqlite3_reset(pStatement);
+	sqlite3_clear_bindings(pStatement);
+
+	if (sqlite3_bind_parameter_count(pStatement) != args.size())
+	{
+		error = String::ToString("Statement expects %d arguments but %d were given.", sqlite3_bind_parameter_count(pStatement), args.size());
+		return NULL;
+	}
+
+	for (S32 i = 0; i < args.size(); i++)
+		BindArgument(pStatement, i + 1, args[i]);
+
+	sqlite_resultset* pResultSet = new sqlite_resultset;
+	pResultSet->bValid = false;
+	pResultSet->iCurrentColumn = 0;
+	pResultSet->iCurrentRow = 0;
+	pResultSet->iNumCols = sqlite3_column_count(pStatement);
+	pResultSet->iNumRows = 0;
+	pResultSet->iResultSet = 0;
+
+	S32 iResult;
+	while ((iResult = sqlite3_step(pStatement)) == SQLITE_ROW)
+	{
+		sqlite_resultrow* pRow = new sqlite_resultrow;
+		for (S32 i = 0; i < pResultSet->iNumCols; i++)
+		{
+			const char* columnName = sqlite3_column_name(pStatement, i);
+			char* name = new char[dStrlen(columnName) + 1];
+			dStrcpy(name, columnName);
+			pRow->vColumnNames.push_back(name);
+
+			const S32 type = sqlite3_column_type(pStatement, i);
+			pRow->vColumnTypes.push_back(type);
+			pRow->vColumnNumbers.push_back(type == SQLITE_INTEGER ? (F64)sqlite3_column_int64(pStatement, i) : sqlite3_column_double(pStatement, i));
+
+			const char* columnValue = type == SQLITE_NULL ? "NULL" : (const char*)sqlite3_column_text(pStatement, i);
+			char* value = new char[dStrlen(columnValue) + 1];
+			dStrcpy(value, columnValue);
+			pRow->vColumnValues.push_back(value);
+		}
+		pResultSet->iNumRows++;
+		pResultSet->vRows.push_back(pRow);
+	}
+
+	if (iResult != SQLITE_DONE)
+		error = sqlite3_errmsg(pDatabase);
+
+	// Resetting releases any locks the statement holds.
+	sqlite3_reset(pStatement);
+
+	if (iResult != SQLITE_DONE)
+	{
+		DeleteResultSet(pResultSet);
+		return NULL;
+	}
+
+	return pResultSet;
+}
+
+S32 SQLiteObject::ExecutePrepared(const char* sql, const Vector<String>& args)
+{
+	String error;
+	sqlite_resultset* pResultSet = RunStatement(m_pDatabase, m_StatementCache, sql, args, error);
+	if (!pResultSet)
+	{
+		Con::executef(this, "onQueryFailed", error.c_str());
+		Con::errorf("SQLite failed to execute prepared query, error %s", error.c_str());
+		return 0;
+	}
+
+	S32 iResultSet = AddResultSet(pResultSet);
+	Con::executef(this, "onQueryFinished");
+	return iResultSet;
+}
+
+void SQLiteObject::FinalizeStatements(sqlite_statementcache& cache)
+{
+	for (sqlite_statementcache::Iterator itr = cache.begin(); itr != cache.end(); ++itr)
+		sqlite3_finalize(itr->value);
+
+	cache.clear();
+}
+
+void SQLiteObject::ClearStatementCache()
+{
+	FinalizeStatements(m_StatementCache);
+}
+
+void SQLiteObject::DeleteResultSet(sqlite_resultset* pResultSet)
+{
+	if (!pResultSet)
+		return;
+
+	for (VectorPtr<sqlite_resultrow*>::iterator iRow = pResultSet->vRows.begin(); iRow != pResultSet->vRows.end(); iRow++)
+	{
+		for (VectorPtr<char*>::iterator i = (*iRow)->vColumnNames.begin(); i != (*iRow)->vColumnNames.end(); i++)
+			delete[](*i);
+		for (VectorPtr<char*>::iterator i = (*iRow)->vColumnValues.begin(); i != (*iRow)->vColumnValues.end(); i++)
+			delete[](*i);
+		delete (*iRow);
+	}
+
+	pResultSet->vRows.clear();
+	delete pResultSet;
+}
+
+//-----------------------------------------------------------------------
+// Transactions
+
+bool SQLiteObject::ExecuteTransactionSQL(const char* sql)
+{
+	char* szError = NULL;
+	if (sqlite3_exec(m_pDatabase, sql, NULL, NULL, &szError) != SQLITE_OK)
+	{
+		Con::errorf("SQLite failed to execute '%s', error %s", sql, szError ? szError : "");
+		sqlite3_free(szError);
+		return false;
+	}
+
+	return true;
+}
+
+bool SQLiteObject::BeginTransaction()
+{
+	if (!m_pDatabase || m_bInTransaction)
+		return false;
+
+	// IMMEDIATE takes the write lock now rather than failing part way through.
+	m_bInTransaction = ExecuteTransactionSQL("BEGIN IMMEDIATE;");
+	return m_bInTransaction;
+}
+
+bool SQLiteObject::CommitTransaction()
+{
+	if (!m_pDatabase || !m_bInTransaction)
+		return false;
+
+	if (!ExecuteTransactionSQL("COMMIT;"))
+		return false;
+
+	m_bInTransaction = false;
+	return true;
+}
+
+bool SQLiteObject::RollbackTransaction()
+{
+	if (!m_pDatabase || !m_bInTransaction)
+		return false;
+
+	m_bInTransaction = false;
+	return ExecuteTransactionSQL("ROLLBACK;");
+}
+
+//-----------------------------------------------------------------------
+// Async queries
+
+S32 SQLiteObject::QueueAsyncQuery(const char* sql, const Vector<String>& args)
+{
+	if (!m_pDatabase)
+	{
+		Con::errorf("SQLiteObject::queryAsync - No database is open.");
+		return 0;
+	}
+
+	if (!m_pAsyncThread)
+	{
+		m_pAsyncThread = new SQLiteAsyncThread(this, m_pDatabase);
+		m_pAsyncThread->start();
+	}
+
+	sqlite_asyncquery* pQuery = new sqlite_asyncquery;
+	pQuery->iQueryId = m_iNextAsyncQuery++;
+	pQuery->sql = sql;
+	pQuery->vArgs = args;
+	pQuery->pResultSet = NULL;
+
+	m_pAsyncThread->Queue(pQuery);
+	return pQuery->iQueryId;
+}
+
+void SQLiteObject::CompleteAsyncQuery(sqlite_asyncquery* pQuery)
+{
+	if (pQuery->pResultSet)
+	{
+		S32 iResultSet = AddResultSet(pQuery->pResultSet);
+		Con::executef(this, "onAsyncQueryFinished", pQuery->iQueryId, iResultSet);
+	}
+	else
+	{
+		Con::errorf("SQLite failed to execute async query, error %s", pQuery->error.c_str());
+		Con::executef(this, "onAsyncQueryFailed", pQuery->iQueryId, pQuery->error.c_str());
+	}
+
+	delete pQuery;
+}
+
+void SQLiteObject::StopAsyncThread()
+{
+	if (!m_pAsyncThread)
+		return;
+
+	m_pAsyncThread->Shutdown();
+	delete m_pAsyncThread;
+	m_pAsyncThread = NULL;
 }
 
 //(The following function is courtesy of sqlite.org, minus changes to use m_pDatabase instead of pInMemory.)
@@ -300,6 +690,9 @@ S32 SQLiteObject::loadOrSaveDb(const char *zFilename, bool isSave)
 
 	if (isSave == false)
 	{//If we're loading, have to create the memory database.
+		// Statements and the async worker belong to the connection being replaced.
+		StopAsyncThread();
+		ClearStatementCache();
 		if (!(SQLITE_OK == sqlite3_open(":memory:", &m_pDatabase)))
 		{
 			Con::printf("Unable to open a memory database!");
@@ -612,6 +1005,56 @@ ConsoleMethod(SQLiteObject, query, S32, 4, 0, "(const char* sql, S32 mode) Perfo
 	return 0;
 }
 
+ConsoleMethod(SQLiteObject, queryPrepared, S32, 3, 0, "(const char* sql, ...) Performs an SQL query using a cached prepared statement and returns an identifier to a valid result set. "
+	"Each argument after the query is bound to the next '?' parameter; numeric arguments are bound as numbers, everything else as text.")
+{
+	Vector<String> args;
+	for (S32 i = 3; i < argc; i++)
+		args.push_back((const char*)argv[i]);
+
+	return object->ExecutePrepared(argv[2], args);
+}
+
+ConsoleMethod(SQLiteObject, queryAsync, S32, 3, 0, "(const char* sql, ...) Queues an SQL query to run on a worker thread using a prepared statement, and returns a query identifier. "
+	"Async queries run in the order they were queued.  On completion onAsyncQueryFinished(queryId, resultSet) or onAsyncQueryFailed(queryId, error) is called on this object.")
+{
+	Vector<String> args;
+	for (S32 i = 3; i < argc; i++)
+		args.push_back((const char*)argv[i]);
+
+	return object->QueueAsyncQuery(argv[2], args);
+}
+
+DefineEngineMethod(SQLiteObject, beginTransaction, bool, (), ,
+	"Begins a transaction.  Statements, including async queries, are not committed until commitTransaction() is called. Returns true or false.")
+{
+	return object->BeginTransaction();
+}
+
+DefineEngineMethod(SQLiteObject, commitTransaction, bool, (), ,
+	"Commits the open transaction. Returns true or false.")
+{
+	return object->CommitTransaction();
+}
+
+DefineEngineMethod(SQLiteObject, rollbackTransaction, bool, (), ,
+	"Discards the open transaction. Returns true or false.")
+{
+	return object->RollbackTransaction();
+}
+
+DefineEngineMethod(SQLiteObject, isInTransaction, bool, (), ,
+	"Returns whether a transaction is open.")
+{
+	return object->IsInTransaction();
+}
+
+DefineEngineMethod(SQLiteObject, clearStatementCache, void, (), ,
+	"Releases the cached prepared statements.")
+{
+	object->ClearStatementCache();
+}
+
 ConsoleMethod(SQLiteObject, clearResult, void, 3, 3, "(S32 resultSet) Clears memory used by the specified result set, and deletes the result set.")
 {
 	object->ClearResultSet(dAtoi(argv[2]));
@@ -824,6 +1267,10 @@ ConsoleMethod(SQLiteObject, getColumnNumeric, F32, 4, 4, "(resultSet column) Ret
 		// 0 for error.  So now we need to drop it back down.
 		iColumn--;
 
+		// Rows from prepared statements carry the number already.
+		if (iColumn < pRow->vColumnNumbers.size())
+			return pRow->vColumnNumbers[iColumn];
+
 		// now we should have an index for our column data
 		if (pRow->vColumnValues[iColumn])
 			return dAtof(pRow->vColumnValues[iColumn]);
@@ -834,6 +1281,43 @@ ConsoleMethod(SQLiteObject, getColumnNumeric, F32, 4, 4, "(resultSet column) Ret
 		return -1;//"invalid_result_set";
 }
 
+ConsoleMethod(SQLiteObject, getColumnType, const char *, 4, 4, "(resultSet column) Returns the SQLite type of the specified column (by name or index) in the current row: integer, float, text, blob or null. "
+	"Only result sets from prepared or async queries carry types; others return text.")
+{
+	sqlite_resultset* pResultSet;
+	sqlite_resultrow* pRow;
+	S32 iColumn;
+
+	pResultSet = object->GetResultSet(dAtoi(argv[2]));
+	if (!pResultSet || pResultSet->vRows.size() == 0)
+		return "null";
+
+	pRow = pResultSet->vRows[pResultSet->iCurrentRow];
+	if (!pRow)
+		return "null";
+
+	iColumn = dAtoi(argv[3]);
+	if (iColumn == 0)
+	{
+		iColumn = object->GetColumnIndex(dAtoi(argv[2]), argv[3]);
+		if (iColumn == 0)
+			return "null";
+	}
+	iColumn--;
+
+	if (iColumn >= pRow->vColumnTypes.size())
+		return "text";
+
+	switch (pRow->vColumnTypes[iColumn])
+	{
+	case SQLITE_INTEGER:	return "integer";
+	case SQLITE_FLOAT:		return "float";
+	case SQLITE_BLOB:		return "blob";
+	case SQLITE_NULL:		return "null";
+	default:				return "text";
+	}
+}
+
 ConsoleMethod(SQLiteObject, escapeString, const char *, 3, 3, "(string) Escapes the given string, making it safer to pass into a query.")
 {
 	// essentially what we need to do here is scan the string for any occurrences of: ', ", and \
@@ -42,11 +42,18 @@
 
 #include "sqlite3.h"
 #include "core/util/tVector.h"
+#include "core/util/tDictionary.h"
+#include "core/util/str.h"
 
 struct sqlite_resultrow
 {
    VectorPtr<char*> vColumnNames;
    VectorPtr<char*> vColumnValues;
+
+   // Only filled by prepared statements, which read each column with its
+   // own SQLite type instead of parsing the text value.
+   Vector<S32>      vColumnTypes;
+   Vector<F64>      vColumnNumbers;
 };
 
 struct sqlite_resultset
@@ -60,6 +67,21 @@ struct sqlite_resultset
    VectorPtr<sqlite_resultrow*>  vRows;
 };
 
+// Compiled statements keyed by their SQL text.
+typedef HashTable<String, sqlite3_stmt*> sqlite_statementcache;
+
+// A query queued for the async worker thread.
+struct sqlite_asyncquery
+{
+   S32                           iQueryId;
+   String                        sql;
+   Vector<String>                vArgs;
+   sqlite_resultset*             pResultSet;
+   String                        error;
+};
+
+class SQLiteAsyncThread;
+
 
 class SQLiteObject : public SimObject
 {
@@ -107,11 +129,25 @@ class SQLiteObject : public SimObject
       S32 GetColumnIndex(S32 iResult, const char* columnName);
 	  S32 numResultSets();
 
-	  //Prepared Statements! We need a way to make them and extend them to script.
-	  //void prepareStatement(sqlite3_stmt*,);
-	  //void finalizeStatement();
-	  //void bindInteger();
-	  //...
+	  // Prepared statements.  Statements are compiled once per SQL string and
+	  // cached; arguments are bound to '?' parameters by type.
+	  S32 ExecutePrepared(const char* sql, const Vector<String>& args);
+	  void ClearStatementCache();
+	  static sqlite_resultset* RunStatement(sqlite3* pDatabase, sqlite_statementcache& cache, const char* sql, const Vector<String>& args, String& error);
+	  static void FinalizeStatements(sqlite_statementcache& cache);
+	  static void DeleteResultSet(sqlite_resultset* pResultSet);
+
+	  // Transactions.
+	  bool BeginTransaction();
+	  bool CommitTransaction();
+	  bool RollbackTransaction();
+	  bool IsInTransaction() const { return m_bInTransaction; }
+
+	  // Async queries run in order on a worker thread and complete through
+	  // the onAsyncQueryFinished() / onAsyncQueryFailed() callbacks.
+	  S32 QueueAsyncQuery(const char* sql, const Vector<String>& args);
+	  void CompleteAsyncQuery(sqlite_asyncquery* pQuery);
+	  void StopAsyncThread();
 
 	  sqlite3*                       m_pDatabase;
    private:
@@ -119,6 +155,13 @@ class SQLiteObject : public SimObject
       VectorPtr<sqlite_resultset*>  m_vResultSets;
       S32                           m_iLastResultSet;
       S32                           m_iNextResultSet;
+      sqlite_statementcache         m_StatementCache;
+      bool                          m_bInTransaction;
+      SQLiteAsyncThread*            m_pAsyncThread;
+      S32                           m_iNextAsyncQuery;
+
+      S32 AddResultSet(sqlite_resultset* pResultSet);
+      bool ExecuteTransactionSQL(const char* sql);
 	  
 
    // This macro ties us into the script engine, and MUST MUST MUST be declared
@@ -24,6 +24,7 @@
 #include "terrain/glsl/terrFeatureGLSL.h"
 
 #include "terrain/terrFeatureTypes.h"
+#include "terrain/terrClipMap.h"
 #include "materials/materialFeatureTypes.h"
 #include "materials/materialFeatureData.h"
 #include "materials/processedMaterial.h"
@@ -48,6 +49,7 @@ namespace
       FEATUREMGR->registerFeature( MFT_TerrainMacroMap, new TerrainMacroMapFeatGLSL );
       FEATUREMGR->registerFeature( MFT_TerrainLightMap, new TerrainLightMapFeatGLSL );
       FEATUREMGR->registerFeature( MFT_TerrainSideProject, new NamedFeatureGLSL( "Terrain Side Projection" ) );
+      FEATUREMGR->registerFeature( MFT_TerrainClipMap, new NamedFeatureGLSL( "Terrain Clipmap" ) );
       FEATUREMGR->registerFeature( MFT_TerrainAdditive, new TerrainAdditiveFeatGLSL );     
       FEATUREMGR->registerFeature( MFT_DeferredTerrainBaseMap, new TerrainBaseMapFeatGLSL );
       FEATUREMGR->registerFeature( MFT_DeferredTerrainMacroMap, new TerrainMacroMapFeatGLSL );
@@ -267,6 +269,29 @@ void TerrainBaseMapFeatGLSL::processPix(  Vector<ShaderComponent*> &componentLis
    baseColor->setName( "baseColor" );
    meta->addStatement( new GenOp( "   @ = tex2D( @, @.xy );\r\n", new DecOp( baseColor ), diffuseMap, texCoord ) );
 
+   // Blend the clipmap levels over the base texture from the
+   // coarsest to the finest, each one fading out at its edges.
+   if ( fd.features.hasFeature( MFT_TerrainClipMap ) )
+   {
+      for ( S32 i = TerrainClipMap::MaxLevels - 1; i >= 0; i-- )
+      {
+         Var *levelInfo = _getUniformVar( avar( "clipMapLevel%d", i ), "vec4", cspPass );
+
+         Var *levelMap = new Var;
+         levelMap->setType( "sampler2D" );
+         levelMap->setName( avar( "clipMap%d", i ) );
+         levelMap->uniform = true;
+         levelMap->sampler = true;
+         levelMap->constNum = Var::getTexUnitNum();
+
+         Var *levelCoord = new Var( avar( "clipMapCoord%d", i ), "vec2" );
+         meta->addStatement( new GenOp( "   @ = ( @.xy - @.xy ) * @.z;\r\n", 
+            new DecOp( levelCoord ), texCoord, levelInfo, levelInfo ) );
+         meta->addStatement( new GenOp( "   @ = mix( @, tex2D( @, @ + 0.5 ), saturate( ( 0.5 - max( abs( @.x ), abs( @.y ) ) ) * @.w ) );\r\n", 
+            baseColor, baseColor, levelMap, levelCoord, levelCoord, levelCoord, levelInfo ) );
+      }
+   }
+
   ShaderFeature::OutputTarget target = ShaderFeature::DefaultTarget;
 
    if(fd.features.hasFeature(MFT_isDeferred))
@@ -284,6 +309,9 @@ ShaderFeature::Resources TerrainBaseMapFeatGLSL::getResources( const MaterialFea
    res.numTexReg = 1;
       res.numTex = 1;
 
+   if ( fd.features.hasFeature( MFT_TerrainClipMap ) )
+      res.numTex += TerrainClipMap::MaxLevels;
+
    return res;
 }
 
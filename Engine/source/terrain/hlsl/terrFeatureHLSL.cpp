@@ -24,6 +24,7 @@
 #include "terrain/hlsl/terrFeatureHLSL.h"
 
 #include "terrain/terrFeatureTypes.h"
+#include "terrain/terrClipMap.h"
 #include "materials/materialFeatureTypes.h"
 #include "materials/materialFeatureData.h"
 #include "materials/processedMaterial.h"
@@ -48,6 +49,7 @@ namespace
       FEATUREMGR->registerFeature( MFT_TerrainMacroMap, new TerrainMacroMapFeatHLSL );
       FEATUREMGR->registerFeature( MFT_TerrainLightMap, new TerrainLightMapFeatHLSL );
       FEATUREMGR->registerFeature( MFT_TerrainSideProject, new NamedFeatureHLSL( "Terrain Side Projection" ) );
+      FEATUREMGR->registerFeature( MFT_TerrainClipMap, new NamedFeatureHLSL( "Terrain Clipmap" ) );
       FEATUREMGR->registerFeature( MFT_TerrainAdditive, new TerrainAdditiveFeatHLSL );     
       FEATUREMGR->registerFeature( MFT_DeferredTerrainBaseMap, new TerrainBaseMapFeatHLSL );
       FEATUREMGR->registerFeature( MFT_DeferredTerrainMacroMap, new TerrainMacroMapFeatHLSL );
@@ -273,6 +275,36 @@ void TerrainBaseMapFeatHLSL::processPix(  Vector<ShaderComponent*> &componentLis
    diffuseTex->constNum = diffuseMap->constNum;
    meta->addStatement(new GenOp("   @ = @.Sample( @, @.xy );\r\n", new DecOp(baseColor), diffuseTex, diffuseMap, texCoord));
 
+   // Blend the clipmap levels over the base texture from the
+   // coarsest to the finest, each one fading out at its edges.
+   if ( fd.features.hasFeature( MFT_TerrainClipMap ) )
+   {
+      for ( S32 i = TerrainClipMap::MaxLevels - 1; i >= 0; i-- )
+      {
+         Var *levelInfo = _getUniformVar( avar( "clipMapLevel%d", i ), "float4", cspPass );
+
+         Var *levelMap = new Var;
+         levelMap->setType( "SamplerState" );
+         levelMap->setName( avar( "clipMap%d", i ) );
+         levelMap->uniform = true;
+         levelMap->sampler = true;
+         levelMap->constNum = Var::getTexUnitNum();
+
+         Var *levelTex = new Var;
+         levelTex->setType( "Texture2D" );
+         levelTex->setName( avar( "clipMapTex%d", i ) );
+         levelTex->uniform = true;
+         levelTex->texture = true;
+         levelTex->constNum = levelMap->constNum;
+
+         Var *levelCoord = new Var( avar( "clipMapCoord%d", i ), "float2" );
+         meta->addStatement( new GenOp( "   @ = ( @.xy - @.xy ) * @.z;\r\n", 
+            new DecOp( levelCoord ), texCoord, levelInfo, levelInfo ) );
+         meta->addStatement( new GenOp( "   @ = lerp( @, @.Sample( @, @ + 0.5 ), saturate( ( 0.5 - max( abs( @.x ), abs( @.y ) ) ) * @.w ) );\r\n", 
+            baseColor, baseColor, levelTex, levelMap, levelCoord, levelCoord, levelCoord, levelInfo ) );
+      }
+   }
+
    ShaderFeature::OutputTarget target = ShaderFeature::DefaultTarget;
 
    if (fd.features.hasFeature(MFT_isDeferred))
@@ -290,6 +322,9 @@ ShaderFeature::Resources TerrainBaseMapFeatHLSL::getResources( const MaterialFea
    res.numTexReg = 1;
       res.numTex = 1;
 
+   if ( fd.features.hasFeature( MFT_TerrainClipMap ) )
+      res.numTex += TerrainClipMap::MaxLevels;
+
    return res;
 }
 
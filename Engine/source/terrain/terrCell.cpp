@@ -34,6 +34,7 @@
 #include "scene/sceneRenderState.h"
 #include "lighting/lightManager.h"
 #include "gfx/gfxDrawUtil.h"
+#include "platform/threads/jobSystem.h"
 
 
 GFXImplementVertexFormat( TerrVertex )
@@ -52,10 +53,15 @@ const U32 TerrCell::smPBSize        = ( TerrCell::smMinCellSize * TerrCell::smMi
                                       ( TerrCell::smMinCellSize * 4 * 6 ); // 101,376
 const U32 TerrCell::smTriCount      = TerrCell::smPBSize / 3;              // 33,792
 
+U32 TerrCell::smBufferTimeout = 0;
+bool TerrCell::smParallelCull = true;
+S32 TerrCell::smParallelCullMinCells = 128;
+
 
 TerrCell::TerrCell()
    :  mTriCount( 0 ),
       mHasEmpty( false ),
+      mLastRenderTime( 0 ),
       mMaterial( NULL ),
       mMaterials( 0 ),
       mIsInteriorOnly( false )
@@ -364,12 +370,16 @@ void TerrCell::updateGrid( const RectI &gridRect, bool opacityOnly )
 {
    PROFILE_SCOPE( TerrCell_UpdateGrid );
 
-   // If we have a VB... then update it.
-   if ( mVertexBuffer.isValid() && !opacityOnly )            
-      _updateVertexBuffer();
+   // If we have a VB... then update it.  Released buffers
+   // are rebuilt in full when the cell is next rendered.
+   if ( mVertexBuffer.isValid() )
+   {
+      if ( !opacityOnly )
+         _updateVertexBuffer( &gridRect );
 
-   // Update our PB, if any
-   _updatePrimitiveBuffer();
+      // Update our PB, if any
+      _updatePrimitiveBuffer();
+   }
 
    // If we don't have children... then we're
    // a leaf at the bottom of the cell quadtree
@@ -424,23 +434,43 @@ void TerrCell::updateGrid( const RectI &gridRect, bool opacityOnly )
       mMaterial->init( mTerrain, mMaterials );
 }
 
-void TerrCell::_updateVertexBuffer()
+void TerrCell::_updateVertexBuffer( const RectI *gridRect )
 {
    PROFILE_SCOPE( TerrCell_UpdateVertexBuffer );
 
-   // Start off with no empty squares
-   mHasEmpty = false;
-   mEmptyVertexList.clear();
-
-   mVertexBuffer.set( GFX, smVBSize, GFXBufferTypeStatic );
-
    const F32 squareSize = mTerrain->getSquareSize();
    const U32 blockSize = mTerrain->getBlockSize();
    const U32 stepSize = mSize / smMinCellSize;
 
-   U32 vbcounter = 0;
+   // If we already have a VB then only the rows touched by
+   // the grid change need to be rewritten.
+   U32 startRow = 0;
+   U32 endRow = smVBStride;
+   if ( gridRect && mVertexBuffer.isValid() )
+   {
+      // Grow the rect a little as the normals and tangents
+      // of the neighboring verts depend on the heights too.
+      const S32 top = gridRect->point.y - 2;
+      const S32 bottom = gridRect->point.y + getMin( gridRect->extent.y, (S32)blockSize ) + 2;
 
-   TerrVertex *vert = mVertexBuffer.lock();
+      startRow = mClamp( ( top - mPoint.y ) / (S32)stepSize, 0, (S32)smVBStride );
+      endRow = mClamp( ( bottom - mPoint.y ) / (S32)stepSize + 2, 0, (S32)smVBStride );
+
+      // Remove the empty verts we're about to test again.
+      for ( S32 i = mEmptyVertexList.size() - 1; i >= 0; i-- )
+      {
+         const U32 index = mEmptyVertexList[i];
+         if ( index >= startRow * smVBStride && index < endRow * smVBStride )
+            mEmptyVertexList.erase_fast( i );
+      }
+   }
+   else
+   {
+      mEmptyVertexList.clear();
+      mVertexBuffer.set( GFX, smVBSize, GFXBufferTypeStatic );
+   }
+
+   U32 vbcounter = startRow * smVBStride;
 
    Point2I gridPt;
    Point2F point;
@@ -449,7 +479,11 @@ void TerrCell::_updateVertexBuffer()
    
    const TerrainFile *file = mTerrain->getFile();
 
-   for ( U32 y = 0; y < smVBStride; y++ )
+   TerrVertex *vert = NULL;
+   if ( startRow < endRow )
+      vert = mVertexBuffer.lock( startRow * smVBStride, endRow * smVBStride );
+
+   for ( U32 y = startRow; y < endRow; y++ )
    {
       for ( U32 x = 0; x < smVBStride; x++ )
       {
@@ -476,16 +510,22 @@ void TerrCell::_updateVertexBuffer()
 
          // Test the empty state for this vert.
          if ( file->isEmptyAt( gridPt.x, gridPt.y ) )
-         {
-            mHasEmpty = true;
             mEmptyVertexList.push_back( vbcounter );
-         }
 
          vbcounter++;
          ++vert;
       }
    }
 
+   if ( vert )
+      mVertexBuffer.unlock();
+
+   mHasEmpty = !mEmptyVertexList.empty();
+
+   // The skirts are cheap, so always rewrite all of them.
+   vbcounter = smVBStride * smVBStride;
+   vert = mVertexBuffer.lock( vbcounter, smVBSize );
+
    // Add verts for 'skirts' around/beneath the edge verts of this cell.
    // This could probably be reduced to a loop...
    
@@ -959,64 +999,164 @@ void TerrCell::updateZoning( const SceneZoneSpaceManager *zoneManager )
    }
 }
 
-void TerrCell::cullCells(  const SceneRenderState *state,
-                           const Point3F &objLodPos,
-                           Vector<TerrCell*> *outCells  )
+namespace
 {
-   // If we have a VB and no children then just add 
-   // ourselves to the results and return.
-   if ( mVertexBuffer.isValid() && !mChildren[0]  )               
+   struct SelectLodJobData
    {
-      outCells->push_back( this );
-      return;
-   }
+      TerrCell *parent;
+      TerrCell **children;
+      const SceneRenderState *state;
+      const Point3F *objLodPos;
+      Vector<TerrCell::LodCell> results[4];
+   };
+
+   struct CullLodCellsJobData
+   {
+      const SceneRenderState *state;
+      const TerrCell::LodCell *lodCells;
+      bool *visible;
+   };
+}
 
-   const F32 screenError = mTerrain->getScreenError();
-   const BitVector &zoneState = state->getCullingState().getZoneVisibilityFlags();
+void TerrCell::_selectLodJob( void *data, U32 start, U32 end )
+{
+   SelectLodJobData *jobData = reinterpret_cast<SelectLodJobData*>( data );
+   for ( U32 i = start; i < end; i++ )
+      jobData->children[i]->_selectLod( jobData->parent, jobData->state, *jobData->objLodPos, &jobData->results[i] );
+}
 
-   for ( U32 i = 0; i < 4; i++ )
+void TerrCell::selectLodCells(  const SceneRenderState *state,
+                                const Point3F &objLodPos,
+                                Vector<LodCell> *outCells )
+{
+   if ( !mChildren[0] )
+      return;
+
+   // Walk the quadrants of the root in parallel, each
+   // into its own list to keep the order stable.
+   if ( smParallelCull && mLevel == 0 )
    {
-      TerrCell *cell = mChildren[i];
+      PROFILE_SCOPE( TerrCell_SelectLodCells_Parallel );
 
-      // Test cell visibility for interior zones.
-      
-      const bool visibleInside = !cell->getZoneOverlap().empty() ? zoneState.testAny( cell->getZoneOverlap() ) : false;
+      SelectLodJobData jobData;
+      jobData.parent = this;
+      jobData.children = mChildren;
+      jobData.state = state;
+      jobData.objLodPos = &objLodPos;
 
-      // Test cell visibility for outdoor zone, but only
-      // if we need to.
+      JobSystem::GLOBAL().parallelFor( 4, 1, &_selectLodJob, &jobData );
 
-      bool visibleOutside = false;
-      if( !mIsInteriorOnly && !visibleInside )
-      {         
-         U32 outdoorZone = SceneZoneSpaceManager::RootZoneId;
-         visibleOutside = !state->getCullingState().isCulled( cell->mOBB, &outdoorZone, 1 );
+      for ( U32 i = 0; i < 4; i++ )
+         outCells->merge( jobData.results[i] );
+
+      return;
+   }
+
+   for ( U32 i = 0; i < 4; i++ )
+      mChildren[i]->_selectLod( this, state, objLodPos, outCells );
+}
+
+void TerrCell::_selectLod( TerrCell *parent,
+                           const SceneRenderState *state,
+                           const Point3F &objLodPos,
+                           Vector<LodCell> *outCells )
+{
+   // Lod based on screen error...
+   // If far enough, just add this cells vb ( skipping its children ).
+   const F32 screenError = mTerrain->getScreenError();
+   F32 dist = getDistanceTo( objLodPos );
+   F32 errorMeters = ( mSize / smMinCellSize ) * mTerrain->getSquareSize();
+   U32 errorPixels = mCeil( state->projectRadius( dist, errorMeters ) );
+
+   // If we have a VB and no children then we
+   // can't go any further down anyway.
+   if (  errorPixels < screenError || 
+         ( _hasVertexBuffer() && !mChildren[0] ) )
+   {
+      if ( _hasVertexBuffer() )
+      {
+         LodCell lodCell = { this, parent };
+         outCells->push_back( lodCell );
       }
+   }
+   else
+      selectLodCells( state, objLodPos, outCells );
+}
 
-      // Skip cell if neither visible indoors nor outdoors.
+void TerrCell::_cullLodCellsJob( void *data, U32 start, U32 end )
+{
+   CullLodCellsJobData *jobData = reinterpret_cast<CullLodCellsJobData*>( data );
+   for ( U32 i = start; i < end; i++ )
+      jobData->visible[i] = _isLodCellVisible( jobData->state, jobData->lodCells[i] );
+}
 
-      if( !visibleInside && !visibleOutside )
-         continue;
+void TerrCell::cullLodCells(  const SceneRenderState *state,
+                              const Vector<LodCell> &lodCells,
+                              Vector<TerrCell*> *outCells )
+{
+   PROFILE_SCOPE( TerrCell_CullLodCells );
 
-      // Lod based on screen error...
-      // If far enough, just add this child cells vb ( skipping its children ).
-      F32 dist = cell->getDistanceTo( objLodPos );
-      F32 errorMeters = ( cell->mSize / smMinCellSize ) * mTerrain->getSquareSize();
-      U32 errorPixels = mCeil( state->projectRadius( dist, errorMeters ) );
+   const U32 count = lodCells.size();
 
-      if ( errorPixels < screenError )
+   if ( !smParallelCull || count < smParallelCullMinCells )
+   {
+      for ( U32 i = 0; i < count; i++ )
       {
-         if ( cell->mVertexBuffer.isValid() )
-            outCells->push_back( cell );       
+         if ( _isLodCellVisible( state, lodCells[i] ) )
+            outCells->push_back( lodCells[i].cell );
       }
-      else      
-         cell->cullCells( state, objLodPos, outCells );
+
+      return;
+   }
+
+   static Vector<bool> visible;
+   visible.setSize( count );
+
+   CullLodCellsJobData jobData;
+   jobData.state = state;
+   jobData.lodCells = lodCells.address();
+   jobData.visible = visible.address();
+
+   JobSystem::GLOBAL().parallelFor( count, 32, &_cullLodCellsJob, &jobData );
+
+   for ( U32 i = 0; i < count; i++ )
+   {
+      if ( visible[i] )
+         outCells->push_back( lodCells[i].cell );
    }
 }
 
+bool TerrCell::_isLodCellVisible( const SceneRenderState *state, const LodCell &lodCell )
+{
+   const TerrCell *cell = lodCell.cell;
+   const BitVector &zoneState = state->getCullingState().getZoneVisibilityFlags();
+
+   // Test cell visibility for interior zones.
+   if ( !cell->getZoneOverlap().empty() && zoneState.testAny( cell->getZoneOverlap() ) )
+      return true;
+
+   // Test cell visibility for outdoor zone, but only
+   // if we need to.
+   if ( lodCell.parent->mIsInteriorOnly )
+      return false;
+
+   U32 outdoorZone = SceneZoneSpaceManager::RootZoneId;
+   return !state->getCullingState().isCulled( cell->mOBB, &outdoorZone, 1 );
+}
+
 void TerrCell::getRenderPrimitive(  GFXPrimitive *prim,
                                     GFXVertexBufferHandleBase *vertBuff,
-                                    GFXPrimitiveBufferHandle  *primBuff ) const
+                                    GFXPrimitiveBufferHandle  *primBuff )
 {
+   // Rebuild the buffers if they were released.
+   if ( _hasVertexBuffer() && mVertexBuffer.isNull() )
+   {
+      _updateVertexBuffer();
+      _updatePrimitiveBuffer();
+   }
+
+   mLastRenderTime = Platform::getRealMilliseconds();
+
 	*vertBuff = mVertexBuffer;
 
    // Only supply a primitive buffer if we're using our own
@@ -1063,7 +1203,7 @@ void TerrCell::preloadMaterials()
    PROFILE_SCOPE( TerrCell_PreloadMaterials );
 
    // If we have a VB then we need a material.
-   if ( mVertexBuffer.isValid() )
+   if ( _hasVertexBuffer() )
    {
       TerrainCellMaterial *material = getMaterial();
       material->getReflectMat();
@@ -1089,6 +1229,19 @@ TerrainCellMaterial* TerrCell::getMaterial()
    return mMaterial;
 }
 
+void TerrCell::releaseUnusedBuffers( U32 time )
+{
+   if ( mVertexBuffer.isValid() && mLastRenderTime < time )
+   {
+      mVertexBuffer = NULL;
+      mPrimBuffer = NULL;
+   }
+
+   for ( U32 i = 0; i < 4; i++ )
+      if ( mChildren[i] ) 
+         mChildren[i]->releaseUnusedBuffers( time );
+}
+
 void TerrCell::deleteMaterials()
 {
    SAFE_DELETE( mMaterial );
@@ -75,6 +75,16 @@ GFXDeclareVertexFormat( TerrVertex )
 /// The TerrCell is a single quadrant of the terrain geometry quadtree.
 class TerrCell
 {
+public:
+
+   /// A cell chosen by the LOD and the parent whose 
+   /// zone state is used to test its visibility.
+   struct LodCell
+   {
+      TerrCell *cell;
+      TerrCell *parent;
+   };
+
 protected:
 
    /// The handle to the static vertex buffer which holds the 
@@ -108,6 +118,10 @@ protected:
    /// Indicates if this cell has any empty squares
    bool mHasEmpty;
 
+   /// The last time this cell was rendered.
+   /// @see releaseUnusedBuffers
+   U32 mLastRenderTime;
+
    /// A list of all empty vertices for this cell
    Vector<U32> mEmptyVertexList;
 
@@ -154,8 +168,13 @@ protected:
                U32 size,
                U32 level );
 
-   // 
-   void _updateVertexBuffer();
+   /// Builds the VB or, if a grid rect is passed and we 
+   /// already have one, updates only the rows it touches.
+   void _updateVertexBuffer( const RectI *gridRect = NULL );
+
+   /// Returns true if this cell renders from its own VB, which
+   /// may have been released and is then rebuilt on demand.
+   bool _hasVertexBuffer() const { return mLevel > 0; }
 
    //
    void _updatePrimitiveBuffer();
@@ -166,6 +185,19 @@ protected:
    //
    bool _isVertIndexEmpty( U32 index ) const;
 
+   /// Adds this cell or its children to the LOD selection.
+   /// @see selectLodCells
+   void _selectLod( TerrCell *parent,
+                    const SceneRenderState *state,
+                    const Point3F &objLodPos,
+                    Vector<LodCell> *outCells );
+
+   /// Returns true if the LOD cell is visible in the render state.
+   static bool _isLodCellVisible( const SceneRenderState *state, const LodCell &lodCell );
+
+   static void _selectLodJob( void *data, U32 start, U32 end );
+   static void _cullLodCellsJob( void *data, U32 start, U32 end );
+
 public:
 
    TerrCell();
@@ -175,7 +207,16 @@ public:
 
    void getRenderPrimitive(   GFXPrimitive *prim,
                               GFXVertexBufferHandleBase *vertBuff,
-                              GFXPrimitiveBufferHandle  *primBuff ) const;
+                              GFXPrimitiveBufferHandle  *primBuff );
+
+   /// Releases the buffers of this cell and all its children
+   /// which have not been rendered since the passed time.
+   void releaseUnusedBuffers( U32 time );
+
+   /// The time in milliseconds after which the buffers of cells
+   /// which are not rendered are released, zero keeps them all.
+   /// It is exposed to the console via $pref::Terrain::cellBufferTimeout.
+   static U32 smBufferTimeout;
 
    void updateGrid( const RectI &gridRect, bool opacityOnly = false );
 
@@ -185,9 +226,26 @@ public:
    ///
    void updateZoning( const SceneZoneSpaceManager *zoneManager );
 
-   void cullCells( const SceneRenderState *state,
-                   const Point3F &objLodPos,
-                   Vector<TerrCell*> *outCells );
+   /// Appends the child cells chosen by the screen error LOD for the
+   /// camera position.  No visibility culling is done, so the result
+   /// can be shared by all the passes using the same LOD camera.
+   /// @see cullLodCells
+   void selectLodCells( const SceneRenderState *state,
+                        const Point3F &objLodPos,
+                        Vector<LodCell> *outCells );
+
+   /// Appends the cells of the LOD selection which are visible
+   /// in the render state.
+   static void cullLodCells(  const SceneRenderState *state,
+                              const Vector<LodCell> &lodCells,
+                              Vector<TerrCell*> *outCells );
+
+   /// Enables selecting and culling the cells on the job system.
+   /// It is exposed to the console via $pref::Terrain::parallelCull.
+   static bool smParallelCull;
+
+   /// The minimum number of LOD cells to cull them in parallel.
+   static S32 smParallelCullMinCells;
 
    const Box3F& getBounds() const { return mBounds; }
 
@@ -55,6 +55,8 @@ Vector<String> _initSamplerNames()
    samplerNames.push_back("$macrolayerTex");   
    samplerNames.push_back("$lightMapTex");
    samplerNames.push_back("$lightInfoBuffer");
+   for(int i = 0; i < TerrainClipMap::MaxLevels; ++i)
+      samplerNames.push_back(avar("$clipMap%d",i));
    for(int i = 0; i < 3; ++i)
    {
       samplerNames.push_back(avar("$normalMap%d",i));
@@ -71,6 +73,7 @@ const Vector<String> TerrainCellMaterial::mSamplerNames = _initSamplerNames();
 TerrainCellMaterial::TerrainCellMaterial()
    :  mTerrain( NULL ),
       mCurrPass( 0 ),
+      mClipMap( false ),
       mDeferredMat( NULL ),
       mReflectMat( NULL )
 {
@@ -253,6 +256,10 @@ void TerrainCellMaterial::init(  TerrainBlock *block,
    mTerrain = block;
    mMaterials = activeMaterials;
 
+   // Only the base material blends in the clipmap, the
+   // reflections are fine with the base texture alone.
+   mClipMap = baseOnly && !reflectMat && TerrainClipMap::isEnabled();
+
    Vector<MaterialInfo*> materials;
 
    for ( U32 i = 0; i < 64; i++ )
@@ -378,6 +385,9 @@ bool TerrainCellMaterial::_createPass( Vector<MaterialInfo*> *materials,
       }
       features.addFeature(MFT_DeferredTerrainBlankInfoMap);
 
+      if ( mClipMap )
+         features.addFeature( MFT_TerrainClipMap );
+
       // Enable lightmaps and fogging if we're in BL.
       if ( reflectMat || useBLM )
       {
@@ -541,6 +551,12 @@ bool TerrainCellMaterial::_createPass( Vector<MaterialInfo*> *materials,
    pass->oneOverTerrainSize = pass->shader->getShaderConstHandle( "$oneOverTerrainSize" );
    pass->squareSize = pass->shader->getShaderConstHandle( "$squareSize" );
 
+   for ( U32 i=0; i < TerrainClipMap::MaxLevels; i++ )
+   {
+      pass->clipMapTexConst[i] = pass->shader->getShaderConstHandle( avar( "$clipMap%d", i ) );
+      pass->clipMapLevelConst[i] = pass->shader->getShaderConstHandle( avar( "$clipMapLevel%d", i ) );
+   }
+
    pass->lightParamsConst = pass->shader->getShaderConstHandle( "$rtParamslightInfoBuffer" );
 
    // Now prepare the basic stateblock.
@@ -580,6 +596,12 @@ bool TerrainCellMaterial::_createPass( Vector<MaterialInfo*> *materials,
    if ( pass->lightMapTexConst->isValid() )
       desc.samplers[pass->lightMapTexConst->getSamplerRegister()] = GFXSamplerStateDesc::getWrapLinear();
 
+   for ( U32 i=0; i < TerrainClipMap::MaxLevels; i++ )
+   {
+      if ( pass->clipMapTexConst[i]->isValid() )
+         desc.samplers[pass->clipMapTexConst[i]->getSamplerRegister()] = GFXSamplerStateDesc::getClampLinear();
+   }
+
    const U32 maxAnisotropy = MATMGR->getDefaultAnisotropy();
 
    // Finally setup the material specific shader 
@@ -785,6 +807,14 @@ bool TerrainCellMaterial::setupPass(   const SceneRenderState *state,
    if ( pass.lightMapTexConst->isValid() )
       GFX->setTexture( pass.lightMapTexConst->getSamplerRegister(), mTerrain->getLightMapTex() );
 
+   for ( U32 i=0; i < TerrainClipMap::MaxLevels; i++ )
+   {
+      if ( pass.clipMapTexConst[i]->isValid() )
+         GFX->setTexture( pass.clipMapTexConst[i]->getSamplerRegister(), mTerrain->mClipMap.getLevelTexture( i ) );
+
+      pass.consts->setSafe( pass.clipMapLevelConst[i], mTerrain->mClipMap.getLevelParams( i ) );
+   }
+
    if ( sceneData.wireframe )
       GFX->setStateBlock( pass.wireframeStateBlock );
    else if ( state->isReflectPass( ))
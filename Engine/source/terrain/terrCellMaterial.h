@@ -38,6 +38,9 @@
 #ifndef _GFXSTATEBLOCK_H_
 #include "gfx/gfxStateBlock.h"
 #endif
+#ifndef _TERRCLIPMAP_H_
+#include "terrain/terrClipMap.h"
+#endif
 
 
 class SceneRenderState;
@@ -128,6 +131,9 @@ protected:
       GFXShaderConstHandle *baseTexMapConst;
       GFXShaderConstHandle *layerTexConst;
 
+      GFXShaderConstHandle *clipMapTexConst[TerrainClipMap::MaxLevels];
+      GFXShaderConstHandle *clipMapLevelConst[TerrainClipMap::MaxLevels];
+
       GFXShaderConstHandle *lightMapTexConst;
 
       GFXShaderConstHandle *squareSize;
@@ -145,6 +151,9 @@ protected:
 
    U32 mCurrPass;
 
+   /// True if the passes blend in the terrain clipmap.
+   bool mClipMap;
+
    static const Vector<String> mSamplerNames;
 
    GFXTexHandle mBaseMapTexture;
@@ -188,6 +197,9 @@ public:
    /// Returns the reflection material from this material.
    TerrainCellMaterial* getReflectMat();
 
+   /// Returns true if this material blends in the terrain clipmap.
+   bool usesClipMap() const { return mClipMap; }
+
    void setTransformAndEye(   const MatrixF &modelXfm, 
                               const MatrixF &viewXfm,
                               const MatrixF &projectXfm,
@@ -0,0 +1,132 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "terrain/terrClipMap.h"
+
+#include "terrain/terrData.h"
+#include "gfx/gfxDevice.h"
+#include "gfx/gfxCardProfile.h"
+#include "platform/profiler.h"
+
+
+S32 TerrainClipMap::smNumLevels = 0;
+S32 TerrainClipMap::smTextureSize = 1024;
+F32 TerrainClipMap::smFinestSize = 64.0f;
+
+/// The edge blend scale fades a level out over
+/// the outer tenth of its half size.
+static const F32 sgClipMapEdgeBlend = 10.0f;
+
+TerrainClipMap::TerrainClipMap()
+{
+}
+
+void TerrainClipMap::invalidate()
+{
+   for ( U32 i=0; i < MaxLevels; i++ )
+      mLevels[i].dirty = true;
+}
+
+void TerrainClipMap::releaseTextures()
+{
+   for ( U32 i=0; i < MaxLevels; i++ )
+   {
+      Level &level = mLevels[i];
+      level.tex = NULL;
+      level.valid = false;
+      level.dirty = true;
+      level.params.set( 0, 0, 0, 0 );
+   }
+}
+
+void TerrainClipMap::update( TerrainBlock *terrain, const Point3F &objCamPos )
+{
+   PROFILE_SCOPE( TerrainClipMap_Update );
+
+   const U32 maxTextureSize = GFX->getCardProfiler()->queryProfile( "maxTextureSize", 1024 );
+   const U32 texSize = getMin( maxTextureSize, getNextPow2( getMax( smTextureSize, 64 ) ) );
+   const U32 numLevels = getMin( (U32)getMax( smNumLevels, 0 ), MaxLevels );
+
+   // The terrain shaders use the object space position
+   // over the block size as the base texture coord.
+   const F32 blockSize = terrain->getWorldBlockSize();
+   const Point2F camCoord( objCamPos.x / blockSize, objCamPos.y / blockSize );
+
+   bool updated = false;
+   F32 size = smFinestSize / blockSize;
+
+   for ( U32 i=0; i < MaxLevels; i++, size *= 2.0f )
+   {
+      Level &level = mLevels[i];
+
+      // Skip levels we don't want or which are larger than
+      // the terrain itself, where the base texture is enough.
+      if ( i >= numLevels || size <= 0.0f || size > 1.0f )
+      {
+         level.tex = NULL;
+         level.valid = false;
+         level.params.set( 0, 0, 0, 0 );
+         continue;
+      }
+
+      if ( level.tex.isNull() || level.tex->getWidth() != texSize )
+      {
+         level.tex.set( texSize, texSize, GFXFormatR8G8B8A8_SRGB, &GFXRenderTargetSRGBProfile, "TerrainClipMap" );
+         level.valid = false;
+      }
+
+      // Recenter once the camera gets a quarter of the
+      // level away from the center.
+      const bool needsUpdate = !level.valid ||
+                               level.dirty ||
+                               level.size != size ||
+                               mFabs( camCoord.x - level.center.x ) > size * 0.25f ||
+                               mFabs( camCoord.y - level.center.y ) > size * 0.25f;
+
+      if ( needsUpdate && !updated )
+      {
+         // Snap the center to an eighth of the level so that
+         // the texels stay put from one update to the next.
+         const F32 step = size / 8.0f;
+         const Point2F center( mFloor( camCoord.x / step + 0.5f ) * step,
+                               mFloor( camCoord.y / step + 0.5f ) * step );
+
+         const Point2F halfSize( size * 0.5f, size * 0.5f );
+         if ( terrain->_blendBaseLayers( level.tex, center - halfSize, center + halfSize ) )
+         {
+            level.center = center;
+            level.size = size;
+            level.valid = true;
+            level.dirty = false;
+         }
+
+         updated = true;
+      }
+
+      if ( level.valid )
+         level.params.set( level.center.x, level.center.y, 1.0f / level.size, sgClipMapEdgeBlend );
+      else
+         level.params.set( 0, 0, 0, 0 );
+   }
+}
@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _TERRCLIPMAP_H_
+#define _TERRCLIPMAP_H_
+
+#ifndef _MPOINT3_H_
+#include "math/mPoint3.h"
+#endif
+#ifndef _MPOINT4_H_
+#include "math/mPoint4.h"
+#endif
+#ifndef _GFXTEXTUREHANDLE_H_
+#include "gfx/gfxTextureHandle.h"
+#endif
+
+class TerrainBlock;
+
+
+/// A set of camera centered render target textures which
+/// hold the terrain layers already blended together.
+///
+/// Each level covers twice the area of the one before it
+/// at the same resolution.  The terrain base material blends
+/// them over the base texture, so the pixel shader samples
+/// the same few textures no matter how many layers the
+/// terrain has.
+///
+/// A level is re-blended as a whole when the camera strays
+/// too far from its center, but only one level is updated
+/// per frame to spread the cost out.
+///
+class TerrainClipMap
+{
+public:
+
+   /// The number of levels the terrain shaders are built for.
+   static const U32 MaxLevels = 4;
+
+   TerrainClipMap();
+
+   /// Returns true if the clipmap is enabled by the prefs.
+   static bool isEnabled() { return smNumLevels > 0; }
+
+   /// Recenters the levels around the camera position in
+   /// terrain object space, re-blending at most one level.
+   void update( TerrainBlock *terrain, const Point3F &objCamPos );
+
+   /// Marks all the levels to be re-blended, for example
+   /// after the layer texture has changed.
+   void invalidate();
+
+   /// Releases the level textures.
+   void releaseTextures();
+
+   /// Returns the texture for a level or NULL if unused.
+   GFXTextureObject* getLevelTexture( U32 level ) const { return mLevels[level].tex.getPointer(); }
+
+   /// Returns the shader parameters for a level: the center
+   /// of the level in base texture coords, the inverse size of
+   /// the level and the edge blend scale, which is zero when
+   /// the level is unused.
+   const Point4F& getLevelParams( U32 level ) const { return mLevels[level].params; }
+
+   /// The number of levels to use, zero disables the clipmap.
+   /// It is exposed to the console via $pref::Terrain::clipMapLevels.
+   static S32 smNumLevels;
+
+   /// The size of the level textures.
+   static S32 smTextureSize;
+
+   /// The size of the finest level in meters.
+   static F32 smFinestSize;
+
+protected:
+
+   struct Level
+   {
+      Level()
+         :  center( 0, 0 ),
+            size( 0 ),
+            params( 0, 0, 0, 0 ),
+            valid( false ),
+            dirty( true )
+      {
+      }
+
+      GFXTexHandle tex;
+
+      /// The center of the blended area in base texture coords.
+      Point2F center;
+
+      /// The size of the blended area in base texture coords.
+      F32 size;
+
+      Point4F params;
+
+      /// True if the texture holds blended layers.
+      bool valid;
+
+      /// True if the layers need to be blended again.
+      bool dirty;
+   };
+
+   Level mLevels[MaxLevels];
+};
+
+#endif // _TERRCLIPMAP_H_
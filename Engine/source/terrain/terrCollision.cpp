@@ -27,6 +27,10 @@
 #include "collision/abstractPolyList.h"
 #include "collision/collision.h"
 
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+#include <emmintrin.h>
+#endif
+
 
 const F32 TerrainThickness = 0.5f;
 static const U32 MaxExtent = 256;
@@ -339,6 +343,61 @@ void TerrainConvex::getPolyList(AbstractPolyList* list)
 
 //----------------------------------------------------------------------------
 
+/// Flags each of the count squares in a row of the finest grid
+/// level which overlaps the height range and isn't a hole.
+///
+/// This is the test which rejects most squares of a collision
+/// query, so it is done on two squares at a time with SSE2.
+static void _findRowSquares(  const TerrainSquare *row, 
+                              U32 count, 
+                              U16 heightMin, 
+                              U16 heightMax, 
+                              U8 *outHit )
+{
+   U32 i = 0;
+
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+
+   // A square is four U16s, so a register holds two of them.  The
+   // heights are unsigned, so flip the sign bit to compare them with
+   // the signed SSE2 compares.  The lanes which don't take part in a
+   // compare get a limit it can never pass.
+   const __m128i bias = _mm_set1_epi16( (S16)0x8000 );
+   const S16 hMax = (S16)heightMax;
+   const S16 hMin = (S16)heightMin;
+   const __m128i maxLimit = _mm_xor_si128( _mm_setr_epi16( hMax, -1, -1, -1, hMax, -1, -1, -1 ), bias );
+   const __m128i minLimit = _mm_xor_si128( _mm_setr_epi16( 0, hMin, 0, 0, 0, hMin, 0, 0 ), bias );
+   const __m128i emptyFlag = _mm_setr_epi16( 0, 0, 0, TerrainSquare::Empty, 0, 0, 0, TerrainSquare::Empty );
+   const __m128i zero = _mm_setzero_si128();
+
+   for ( ; i + 2 <= count; i += 2 )
+   {
+      const __m128i sq = _mm_loadu_si128( (const __m128i*)( row + i ) );
+      const __m128i biased = _mm_xor_si128( sq, bias );
+
+      // minHeight > heightMax or maxHeight < heightMin.
+      const __m128i outside = _mm_or_si128(  _mm_cmpgt_epi16( biased, maxLimit ), 
+                                             _mm_cmplt_epi16( biased, minLimit ) );
+
+      // All lanes but the flags of empty squares.
+      const __m128i solid = _mm_cmpeq_epi16( _mm_and_si128( sq, emptyFlag ), zero );
+
+      const U32 reject = U32( _mm_movemask_epi8( outside ) ) | ( ~U32( _mm_movemask_epi8( solid ) ) & 0xFFFF );
+      outHit[i] = ( reject & 0x00FF ) == 0;
+      outHit[i+1] = ( reject & 0xFF00 ) == 0;
+   }
+
+#endif
+
+   for ( ; i < count; i++ )
+   {
+      const TerrainSquare &sq = row[i];
+      outHit[i] = !( sq.flags & TerrainSquare::Empty ) &&
+                  sq.minHeight <= heightMax &&
+                  sq.maxHeight >= heightMin;
+   }
+}
+
 void TerrainBlock::buildConvex(const Box3F& box,Convex* convex)
 {
    PROFILE_SCOPE( TerrainBlock_buildConvex );
@@ -362,49 +421,64 @@ void TerrainBlock::buildConvex(const Box3F& box,Convex* convex)
    S32 xEnd   = (S32)mCeil ( osBox.maxExtents.x / mSquareSize );
    S32 yStart = (S32)mFloor( osBox.minExtents.y / mSquareSize );
    S32 yEnd   = (S32)mCeil ( osBox.maxExtents.y / mSquareSize );
-   S32 xExt = xEnd - xStart;
-   if (xExt > MaxExtent)
-      xExt = MaxExtent;
+
+   // Only the squares within the block collide.
+   xStart = getMax( xStart, 0 );
+   yStart = getMax( yStart, 0 );
+   xEnd = getMin( xEnd, (S32)mFile->mSize );
+   yEnd = getMin( yEnd, (S32)mFile->mSize );
+   if ( xStart >= xEnd || yStart >= yEnd )
+      return;
+
+   const S32 xExt = xEnd - xStart;
+   const S32 yExt = yEnd - yStart;
 
    U16 heightMax = floatToFixed(osBox.maxExtents.z);
    U16 heightMin = (osBox.minExtents.z < 0)? 0: floatToFixed(osBox.minExtents.z);
 
-   const U32 BlockMask = mFile->mSize - 1;
+   // Flag the squares which are already part of the working set.  The
+   // query box of a moving object mostly overlaps the previous one, so
+   // this way only the squares along its leading edge get created, 
+   // without searching the whole working list for every square.
+   static Vector<U8> sInWorkingSet;
+   sInWorkingSet.setSize( xExt * yExt );
+   dMemset( sInWorkingSet.address(), 0, sInWorkingSet.size() );
+
+   CollisionWorkingList& wl = convex->getWorkingList();
+   for (CollisionWorkingList* itr = wl.wLink.mNext; itr != &wl; itr = itr->wLink.mNext)
+   {
+      if (  itr->mConvex->getType() != TerrainConvexType ||
+            itr->mConvex->getObject() != this )
+         continue;
+
+      const U32 sid = static_cast<TerrainConvex*>(itr->mConvex)->squareId;
+      const S32 sx = ( sid >> 16 ) - xStart;
+      const S32 sy = ( sid & 0xFFFF ) - yStart;
+      if ( sx >= 0 && sx < xExt && sy >= 0 && sy < yExt )
+         sInWorkingSet[ sx + sy * xExt ] = 1;
+   }
+
+   static Vector<U8> sRowHits;
+   sRowHits.setSize( xExt );
 
    for ( S32 y = yStart; y < yEnd; y++ ) 
    {
-      S32 yi = y & BlockMask;
+      const S32 yi = y;
+
+      _findRowSquares( mFile->findSquare( 0, xStart, y ), xExt, heightMin, heightMax, sRowHits.address() );
+
+      const U8 *inWorkingSet = sInWorkingSet.address() + ( y - yStart ) * xExt;
 
       //
       for ( S32 x = xStart; x < xEnd; x++ ) 
       {
-         S32 xi = x & BlockMask;
-
-         const TerrainSquare *sq = mFile->findSquare( 0, xi, yi );
-
-         if ( x != xi || y != yi )
+         if ( !sRowHits[ x - xStart ] || inWorkingSet[ x - xStart ] )
             continue;
 
-         // holes only in the primary terrain block
-         if (  ( ( sq->flags & TerrainSquare::Empty ) && x == xi && y == yi ) ||
-               sq->minHeight > heightMax || 
-               sq->maxHeight < heightMin )
-            continue;
+         const S32 xi = x;
+         const TerrainSquare *sq = mFile->findSquare( 0, xi, yi );
 
          U32 sid = (x << 16) + (y & ((1 << 16) - 1));
-         Convex *cc = 0;
-
-         // See if the square already exists as part of the working set.
-         CollisionWorkingList& wl = convex->getWorkingList();
-         for (CollisionWorkingList* itr = wl.wLink.mNext; itr != &wl; itr = itr->wLink.mNext)
-            if (itr->mConvex->getType() == TerrainConvexType &&
-                static_cast<TerrainConvex*>(itr->mConvex)->squareId == sid) {
-               cc = itr->mConvex;
-               break;
-            }
-
-         if (cc)
-            continue;
 
          // Create a new convex.
          TerrainConvex* cp = new TerrainConvex;
@@ -523,6 +597,14 @@ bool TerrainBlock::buildPolyList(PolyListContext context, AbstractPolyList* poly
    clrbuf(vb[1],xExt + 1);
 
    const U32 BlockMask = mFile->mSize - 1;
+   const S32 xBlockEnd = getMin( xEnd, (S32)mFile->mSize );
+
+   U8 rowHits[MaxExtent];
+
+   // Points new to the current row.  They are added as one batch so that
+   // the polylist can transform and classify them together.
+   Point3F rowPoints[(MaxExtent + 1) * 2];
+   U32* rowSlots[(MaxExtent + 1) * 2];
 
    bool emitted = false;
    for (S32 y = yStart; y < yEnd; y++) 
@@ -538,31 +620,30 @@ bool TerrainBlock::buildPolyList(PolyListContext context, AbstractPolyList* poly
           (wy1 < osBox.minExtents.y && wy2 < osBox.minExtents.y)))
          continue;
 
-      //
-      for (S32 x = xStart; x < xEnd; x++) 
+      // Only the squares within the block collide.
+      if ( y != yi || xStart >= xBlockEnd )
+         continue;
+
+      _findRowSquares( mFile->findSquare( 0, xStart, yi ), xBlockEnd - xStart, heightMin, heightMax, rowHits );
+
+      // Gather the missing points of the squares we emit in the same order
+      // they used to be added one by one.  Their slots temporarily hold
+      // their position within the batch.
+      U32 numRowPoints = 0;
+      for (S32 x = xStart; x < xBlockEnd; x++) 
       {
-         S32 xi = x & BlockMask;
-         const TerrainSquare *sq = mFile->findSquare( 0, xi, yi );
+         if ( !rowHits[ x - xStart ] )
+            continue;
 
          F32 wx1 = x * mSquareSize, wx2 = (x + 1) * mSquareSize;
          if(context == PLC_Navigation &&
             ((wx1 > osBox.maxExtents.x && wx2 > osBox.maxExtents.x) ||
              (wx1 < osBox.minExtents.x && wx2 < osBox.minExtents.x)))
+         {
+            rowHits[ x - xStart ] = 0;
             continue;
+         }
 
-         if ( x != xi || y != yi )
-            continue;
-
-         // holes only in the primary terrain block
-         if (  ( ( sq->flags & TerrainSquare::Empty ) && x == xi && y == yi ) || 
-               sq->minHeight > heightMax || 
-               sq->maxHeight < heightMin )
-            continue;
-
-         emitted = true;
-
-         // Add the missing points
-         U32 vi[5];
          for (int i = 0; i < 4 ; i++) 
          {
             S32 dx = i >> 1;
@@ -570,13 +651,39 @@ bool TerrainBlock::buildPolyList(PolyListContext context, AbstractPolyList* poly
             U32* vp = &vb[dy][x - xStart + dx];
             if (*vp == U32_MAX) 
             {
-               Point3F pos;
+               Point3F& pos = rowPoints[numRowPoints];
                pos.x = (F32)((x + dx) * mSquareSize);
                pos.y = (F32)((y + dy) * mSquareSize);
-               pos.z = fixedToFloat( mFile->getHeight(xi + dx, yi + dy) );
-               *vp = polyList->addPoint(pos);
+               pos.z = fixedToFloat( mFile->getHeight(x + dx, yi + dy) );
+               rowSlots[numRowPoints] = vp;
+               *vp = numRowPoints++;
             }
-            vi[i] = *vp;
+         }
+      }
+
+      if ( numRowPoints )
+      {
+         const U32 base = polyList->addPoints( rowPoints, numRowPoints );
+         for ( U32 i = 0; i < numRowPoints; i++ )
+            *rowSlots[i] += base;
+      }
+
+      for (S32 x = xStart; x < xBlockEnd; x++) 
+      {
+         if ( !rowHits[ x - xStart ] )
+            continue;
+
+         S32 xi = x;
+         const TerrainSquare *sq = mFile->findSquare( 0, xi, yi );
+
+         emitted = true;
+
+         U32 vi[5];
+         for (int i = 0; i < 4 ; i++) 
+         {
+            S32 dx = i >> 1;
+            S32 dy = dx ^ (i & 1);
+            vi[i] = vb[dy][x - xStart + dx];
          }
 
          U32* vp = &vi[0];
@@ -33,6 +33,7 @@
 #include "terrain/terrRender.h"
 #include "terrain/terrMaterial.h"
 #include "terrain/terrCellMaterial.h"
+#include "scene/culling/sceneOcclusionBuffer.h"
 #include "gui/worldEditor/terrainEditor.h"
 #include "math/mathIO.h"
 #include "core/stream/fileStream.h"
@@ -200,6 +201,10 @@ TerrainBlock::TerrainBlock()
    mSquareSize( 1.0f ),
    mPhysicsRep( NULL ),
    mScreenError( 16 ),
+   mLodCellsPos( Point3F::Zero ),
+   mLodCellsScale( 0.0f ),
+   mLodCellsError( 0.0f ),
+   mLodCellsDirty( true ),
    mCastShadows( true ),
    mZoningDirty( false )
 {
@@ -238,6 +243,7 @@ void TerrainBlock::_onTextureEvent( GFXTexCallbackCode code )
 
       mLayerTex = NULL;
       mLightMapTex = NULL;
+      mClipMap.releaseTextures();
    }
 }
 
@@ -352,6 +358,23 @@ void TerrainBlock::setFile(const Resource<TerrainFile>& terr)
    mTerrFileName = terr.getPath();
 }
 
+void TerrainBlock::replaceFile( const Resource<TerrainFile> &file, F32 squareSize )
+{
+   AssertFatal( isServerObject(), "TerrainBlock::replaceFile - Only valid on the server!" );
+
+   setFile( file );
+   mSquareSize = squareSize;
+   mCRC = file.getChecksum();
+
+   if ( isProperlyAdded() )
+   {
+      _updateBounds();
+      _updatePhysics();
+   }
+
+   setMaskBits( FileMask | SizeMask | HeightMapChangeMask );
+}
+
 bool TerrainBlock::save(const char *filename)
 {
    return mFile->save(filename);
@@ -457,6 +480,7 @@ void TerrainBlock::updateGrid( const Point2I &minPt, const Point2I &maxPt, bool
       // Tell the terrain cell that the height changed.
       const RectI gridRect( minPt, maxPt - minPt );
       mCell->updateGrid( gridRect );
+      mLodCellsDirty = true;
 
       // Rebuild the physics representation.
       if ( mPhysicsRep )
@@ -547,6 +571,74 @@ bool TerrainBlock::getHeight( const Point2F &pos, F32 *height ) const
    return true;
 }
 
+void TerrainBlock::addToOcclusionBuffer( SceneOcclusionBuffer *buffer ) const
+{
+   PROFILE_SCOPE( TerrainBlock_addToOcclusionBuffer );
+
+   // Use a grid map level with at most 32x32 squares and
+   // render each square flat at its minimum height.  Where
+   // neighboring squares differ in height we add the wall
+   // between them, which is also below the surface as the
+   // squares share the heights along their edge.
+   const U32 gridLevels = mFile->mGridLevels;
+   const U32 level = gridLevels > 5 ? gridLevels - 5 : 0;
+   const S32 squareCount = 1 << ( gridLevels - level );
+   const F32 squareSize = mSquareSize * F32( 1 << level );
+   const TerrainSquare *squares = mFile->mGridMap[level];
+   const MatrixF &xfm = getTransform();
+
+   const U16 emptyFlags = TerrainSquare::Empty | TerrainSquare::HasEmpty;
+
+   for ( S32 y = 0; y < squareCount; y++ )
+   {
+      for ( S32 x = 0; x < squareCount; x++ )
+      {
+         const TerrainSquare &sq = squares[ x + y * squareCount ];
+         if ( sq.flags & emptyFlags )
+            continue;
+
+         const F32 height = fixedToFloat( sq.minHeight );
+         const F32 x0 = x * squareSize;
+         const F32 x1 = x0 + squareSize;
+         const F32 y0 = y * squareSize;
+         const F32 y1 = y0 + squareSize;
+
+         Point3F p0( x0, y0, height ), p1( x1, y0, height ), p2( x1, y1, height ), p3( x0, y1, height );
+         xfm.mulP( p0 );
+         xfm.mulP( p1 );
+         xfm.mulP( p2 );
+         xfm.mulP( p3 );
+         buffer->addQuad( p0, p1, p2, p3 );
+
+         if ( x + 1 < squareCount )
+         {
+            const TerrainSquare &next = squares[ x + 1 + y * squareCount ];
+            if ( !( next.flags & emptyFlags ) && next.minHeight != sq.minHeight )
+            {
+               const F32 nextHeight = fixedToFloat( next.minHeight );
+               Point3F w0( x1, y0, nextHeight ), w1( x1, y1, nextHeight );
+               xfm.mulP( w0 );
+               xfm.mulP( w1 );
+               buffer->addQuad( p1, p2, w1, w0 );
+            }
+         }
+
+         if ( y + 1 < squareCount )
+         {
+            const TerrainSquare &next = squares[ x + ( y + 1 ) * squareCount ];
+            if ( !( next.flags & emptyFlags ) && next.minHeight != sq.minHeight )
+            {
+               const F32 nextHeight = fixedToFloat( next.minHeight );
+               Point3F w0( x0, y1, nextHeight ), w1( x1, y1, nextHeight );
+               xfm.mulP( w0 );
+               xfm.mulP( w1 );
+               buffer->addQuad( p3, p2, w1, w0 );
+            }
+         }
+      }
+   }
+}
+
 bool TerrainBlock::getNormal( const Point2F &pos, Point3F *normal, bool normalize, bool skipEmpty ) const
 {
 	PROFILE_SCOPE( TerrainBlock_getNormal );
@@ -1011,6 +1103,7 @@ void TerrainBlock::_rebuildQuadtree()
 
    // Recursively build the cells.
    mCell = TerrCell::init( this );
+   mLodCellsDirty = true;
 
    // Build the shared PrimitiveBuffer.
    mCell->createPrimBuffer( &mPrimBuffer );
@@ -1172,6 +1265,29 @@ void TerrainBlock::initPersistFields()
 
    Con::addVariable( "$pref::Terrain::detailScale", TypeF32, &smDetailScale, "A global detail scale used to tweak the material detail distances.\n\n" 
 	   "@ingroup Terrain");
+
+   Con::addVariable( "$pref::Terrain::parallelCull", TypeBool, &TerrCell::smParallelCull, "Selects the terrain cell LOD and culls the cells "
+      "on the job system.\n\n"
+      "@ingroup Terrain");
+
+   Con::addVariable( "$pref::Terrain::parallelCullMinCells", TypeS32, &TerrCell::smParallelCullMinCells, "The minimum number of terrain "
+      "cells to cull them in parallel.\n\n"
+      "@ingroup Terrain");
+
+   Con::addVariable( "$pref::Terrain::cellBufferTimeout", TypeS32, &TerrCell::smBufferTimeout, "The time in milliseconds after which the vertex "
+      "buffers of terrain cells which are not rendered are released.  They are rebuilt when the cell is rendered again.  Zero "
+      "keeps all the buffers.\n\n"
+      "@ingroup Terrain");
+
+   Con::addVariable( "$pref::Terrain::clipMapLevels", TypeS32, &TerrainClipMap::smNumLevels, "The number of camera centered levels of blended "
+      "terrain layers used in place of per pixel layer blending.  Zero disables the clipmap.\n\n"
+      "@ingroup Terrain");
+
+   Con::addVariable( "$pref::Terrain::clipMapSize", TypeS32, &TerrainClipMap::smTextureSize, "The texture size of each terrain clipmap level.\n\n"
+      "@ingroup Terrain");
+
+   Con::addVariable( "$pref::Terrain::clipMapExtent", TypeF32, &TerrainClipMap::smFinestSize, "The size in meters of the finest terrain clipmap level.\n\n"
+      "@ingroup Terrain");
 }
 
 void TerrainBlock::inspectPostApply()
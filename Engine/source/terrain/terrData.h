@@ -49,6 +49,12 @@
 #ifndef _GFXPRIMITIVEBUFFER_H_
 #include "gfx/gfxPrimitiveBuffer.h"
 #endif
+#ifndef _TERRCLIPMAP_H_
+#include "terrain/terrClipMap.h"
+#endif
+#ifndef _TERRCELL_H_
+#include "terrain/terrCell.h"
+#endif
 
 
 
@@ -57,6 +63,7 @@ class TerrainBlock;
 class TerrCell;
 class PhysicsBody;
 class TerrainCellMaterial;
+class SceneOcclusionBuffer;
 
 class TerrainBlock : public SceneObject
 {
@@ -64,6 +71,7 @@ class TerrainBlock : public SceneObject
 
    friend class TerrainEditor;
    friend class TerrainCellMaterial;
+   friend class TerrainClipMap;
 
 protected:
 
@@ -150,6 +158,10 @@ protected:
    /// The base texture.
    GFXTexHandle mBaseTex;
 
+   /// The camera centered levels of blended layers
+   /// used in place of the base texture up close.
+   TerrainClipMap mClipMap;
+
    ///
    bool mDetailsDirty;
 
@@ -181,6 +193,21 @@ protected:
    /// The shared primitive buffer used in rendering.
    GFXPrimitiveBufferHandle mPrimBuffer;
 
+   /// The cells chosen by the LOD for the last LOD camera
+   /// which are shared by all the passes using it.
+   /// @see _cullCells
+   Vector<TerrCell::LodCell> mLodCells;
+
+   /// The LOD camera position, screen scale and error
+   /// the LOD cells were selected for.
+   Point3F mLodCellsPos;
+   F32 mLodCellsScale;
+   F32 mLodCellsError;
+
+   /// Set when the quadtree changes to force
+   /// the LOD cells to be selected again.
+   bool mLodCellsDirty;
+
    /// The cells used in the last render pass
    /// when doing debug rendering.
    /// @see _renderDebug
@@ -211,6 +238,10 @@ protected:
    void _updatePhysics();
 
    void _renderBlock( SceneRenderState *state );
+
+   /// Returns the cells to render in the state, reusing
+   /// the LOD selection of earlier passes when possible.
+   void _cullCells( const SceneRenderState *state, const Point3F &objLodPos, Vector<TerrCell*> *outCells );
    void _renderDebug( ObjectRenderInst *ri, SceneRenderState *state, BaseMatInstance *overrideMat );
 
    /// The callback used to get texture events.
@@ -228,6 +259,10 @@ protected:
    ///
    void _updateMaterials();
 
+   /// Blends the diffuse maps of all the layers into the target
+   /// for the area between the base texture coords uvMin and uvMax.
+   bool _blendBaseLayers( GFXTexHandle &target, const Point2F &uvMin, const Point2F &uvMax );
+
    /// 
    void _updateBaseTexture( bool writeToCache );
 
@@ -341,6 +376,10 @@ public:
 
    void getMinMaxHeight( F32 *minHeight, F32 *maxHeight ) const;
 
+   /// Rasterizes a coarse version of the terrain which lies
+   /// entirely below the real surface into the occlusion buffer.
+   void addToOcclusionBuffer( SceneOcclusionBuffer *buffer ) const;
+
    /// This returns true and the terrain normal for a 
    /// 2d position in the terrains object space.
    ///
@@ -418,6 +457,12 @@ public:
 
    void setFile(const Resource<TerrainFile>& file);
 
+   /// Swaps in a different file on a server terrain, for example
+   /// a more or less detailed version of the same streamed tile,
+   /// and sends it to the clients.
+   /// @see TerrainTileSet
+   void replaceFile( const Resource<TerrainFile> &file, F32 squareSize );
+
    bool save(const char* filename);
 
    F32 getSquareSize() const { return mSquareSize; }
@@ -34,6 +34,7 @@ ImplementFeatureType( MFT_TerrainMacroMap, MFG_Texture, 104.0f, false );
 ImplementFeatureType( MFT_TerrainLightMap, MFG_Texture, 105.0f, false );
 ImplementFeatureType( MFT_TerrainSideProject, MFG_Texture, 106.0f, false );
 ImplementFeatureType( MFT_TerrainAdditive, MFG_PostProcess, 999.0f, false );
+ImplementFeatureType( MFT_TerrainClipMap, MFG_Texture, 107.0f, false );
 //Deferred Shading
 ImplementFeatureType( MFT_DeferredTerrainBaseMap, MFG_Texture, 100.1f, false );
 ImplementFeatureType( MFT_DeferredTerrainDetailMap, MFG_Texture, 102.1f, false );
@@ -35,6 +35,7 @@ DeclareFeatureType( MFT_TerrainParallaxMap );
 DeclareFeatureType( MFT_TerrainLightMap );
 DeclareFeatureType( MFT_TerrainSideProject );
 DeclareFeatureType( MFT_TerrainAdditive );
+DeclareFeatureType( MFT_TerrainClipMap );
 //Deferred Shading
 DeclareFeatureType( MFT_DeferredTerrainBaseMap );
 DeclareFeatureType( MFT_DeferredTerrainDetailMap );
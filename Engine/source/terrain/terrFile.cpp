@@ -30,6 +30,7 @@
 #include "gfx/bitmap/gBitmap.h"
 #include "platform/profiler.h"
 #include "math/mPlane.h"
+#include "platform/threads/thread.h"
 
 
 template<>
@@ -43,11 +44,21 @@ template<> ResourceBase::Signature Resource<TerrainFile>::signature()
    return MakeFourCC('t','e','r','d');
 }
 
+/// Files loaded on a worker thread (see ResourceManager::loadAsync) defer
+/// the material lookup; finish it once the file is handed over.
+static void _onTerrainFileLoaded( Resource<TerrainFile> &resource )
+{
+   resource->resolvePendingMaterials();
+}
+
+static ResourceRegisterPostLoadSignal<TerrainFile> _registerTerrainFileLoadSignal( _onTerrainFileLoaded );
+
 
 TerrainFile::TerrainFile()
    : mSize( 256 ),
      mFileVersion( FILE_VERSION ),
-     mNeedsResaving( false )
+     mNeedsResaving( false ),
+     mMaterialsPending( false )
 {
    mLayerMap.setSize( mSize * mSize );
    dMemset( mLayerMap.address(), 0, mLayerMap.memSize() );
@@ -323,8 +334,10 @@ TerrainFile* TerrainFile::load( const Torque::Path &path )
    // Update the collision structures.
    ret->_buildGridMap();
    
-   // Do the material mapping.
-   ret->_initMaterialInstMapping();
+   // Do the material mapping... unless the materials
+   // are waiting on the main thread.
+   if ( !ret->mMaterialsPending )
+      ret->_initMaterialInstMapping();
    
    return ret;
 }
@@ -563,6 +576,15 @@ void TerrainFile::_resolveMaterials( const Vector<String> &materials )
 {
    mMaterials.clear();
 
+   // Material objects can only be found or created on the
+   // main thread, so stash the names until then.
+   if ( !ThreadManager::isMainThread() )
+   {
+      mPendingMaterials = materials;
+      mMaterialsPending = true;
+      return;
+   }
+
    for ( U32 i=0; i < materials.size(); i++ )
       mMaterials.push_back( TerrainMaterial::findOrCreate( materials[i] ) );
 
@@ -572,6 +594,20 @@ void TerrainFile::_resolveMaterials( const Vector<String> &materials )
       mMaterials.push_back( TerrainMaterial::getWarningMaterial() );
 }
 
+void TerrainFile::resolvePendingMaterials()
+{
+   if ( !mMaterialsPending )
+      return;
+
+   AssertFatal( ThreadManager::isMainThread(), "TerrainFile::resolvePendingMaterials - Must be called from the main thread!" );
+
+   mMaterialsPending = false;
+   _resolveMaterials( mPendingMaterials );
+   mPendingMaterials.clear();
+
+   _initMaterialInstMapping();
+}
+
 void TerrainFile::setSize( U32 newSize, bool clear )
 {
    // Make sure the resolution is a power of two.
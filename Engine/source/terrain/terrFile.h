@@ -111,6 +111,14 @@ protected:
    /// The full path and name of the TerrainFile
    Torque::Path mFilePath;
 
+   /// Material names read by a load off the main thread which
+   /// are resolved once the file is handed over.
+   /// @see resolvePendingMaterials
+   Vector<String> mPendingMaterials;
+
+   /// True while mPendingMaterials still needs resolving.
+   bool mMaterialsPending;
+
    /// The internal loading function.
    void _load( FileStream &stream );
 
@@ -148,6 +156,14 @@ public:
 
    bool save( const char *filename );
 
+   /// Resolves the materials of a file that was loaded on a worker
+   /// thread.  This must be called from the main thread and does
+   /// nothing if the materials are already resolved.
+   void resolvePendingMaterials();
+
+   /// Returns true if the materials still need resolving.
+   bool hasPendingMaterials() const { return mMaterialsPending; }
+
    ///
    void import(   const GBitmap &heightMap, 
                   F32 heightScale,
@@ -163,6 +179,9 @@ public:
 
    void setSize( U32 newResolution, bool clear );
 
+   /// Returns the dimensions of the layer and height maps.
+   U32 getSize() const { return mSize; }
+
    TerrainSquare* findSquare( U32 level, U32 x, U32 y ) const;
    
    BaseMatInstance* getMaterialMapping( U32 index ) const;
@@ -190,66 +190,87 @@ bool TerrainBlock::_initBaseShader()
    return true;
 }
 
-void TerrainBlock::_updateBaseTexture(bool writeToCache)
+bool TerrainBlock::_blendBaseLayers( GFXTexHandle &target, const Point2F &uvMin, const Point2F &uvMax )
 {
    if ( !mBaseShader && !_initBaseShader() )
-      return;
+      return false;
+
+   if ( mLayerTex.isNull() || target.isNull() )
+      return false;
 
    // This can sometimes occur outside a begin/end scene.
    const bool sceneBegun = GFX->canCurrentlyRender();
    if ( !sceneBegun )
       GFX->beginScene();
 
-   GFXDEBUGEVENT_SCOPE( TerrainBlock_UpdateBaseTexture, ColorI::GREEN );
+   GFXDEBUGEVENT_SCOPE( TerrainBlock_BlendBaseLayers, ColorI::GREEN );
 
-   PROFILE_SCOPE( TerrainBlock_UpdateBaseTexture );
+   PROFILE_SCOPE( TerrainBlock_BlendBaseLayers );
 
    GFXTransformSaver saver;
 
-   const U32 maxTextureSize = GFX->getCardProfiler()->queryProfile( "maxTextureSize", 1024 );
-
-   U32 baseTexSize = getNextPow2( mBaseTexSize );
-   baseTexSize = getMin( maxTextureSize, baseTexSize );
-   Point2I destSize( baseTexSize, baseTexSize );
+   const Point2I destSize( target.getWidth(), target.getHeight() );
+   const Point2F uvExtent = uvMax - uvMin;
 
    // Setup geometry
+   //
+   // The layer texture is clamped and not wrapped, so the
+   // area is split into one quad per whole repeat of the 
+   // base texture coords.
+   //
    GFXVertexBufferHandle<GFXVertexPT> vb;
+   U32 quadCount = 0;
    {
       F32 copyOffsetX = 2.0f * GFX->getFillConventionOffset() / (F32)destSize.x;
       F32 copyOffsetY = 2.0f * GFX->getFillConventionOffset() / (F32)destSize.y;
 
-      GFXVertexPT points[4];
-      points[0].point = Point3F(1.0 - copyOffsetX, -1.0 + copyOffsetY, 0.0);
-      points[0].texCoord = Point2F(1.0, 1.0f);
-      points[1].point = Point3F(1.0 - copyOffsetX, 1.0 + copyOffsetY, 0.0);
-      points[1].texCoord = Point2F(1.0, 0.0f);
-      points[2].point = Point3F(-1.0 - copyOffsetX, -1.0 + copyOffsetY, 0.0);
-      points[2].texCoord = Point2F(0.0, 1.0f);
-      points[3].point = Point3F(-1.0 - copyOffsetX, 1.0 + copyOffsetY, 0.0);
-      points[3].texCoord = Point2F(0.0, 0.0f);
-
-      vb.set( GFX, 4, GFXBufferTypeVolatile );
+      Vector<GFXVertexPT> points;
+
+      for ( F32 y0 = uvMin.y; y0 < uvMax.y; )
+      {
+         const F32 y1 = getMin( mFloor( y0 ) + 1.0f, uvMax.y );
+         const F32 ty0 = y0 - mFloor( y0 );
+         const F32 ty1 = ty0 + ( y1 - y0 );
+         const F32 top = 1.0f - 2.0f * ( y0 - uvMin.y ) / uvExtent.y + copyOffsetY;
+         const F32 bottom = 1.0f - 2.0f * ( y1 - uvMin.y ) / uvExtent.y + copyOffsetY;
+
+         for ( F32 x0 = uvMin.x; x0 < uvMax.x; )
+         {
+            const F32 x1 = getMin( mFloor( x0 ) + 1.0f, uvMax.x );
+            const F32 tx0 = x0 - mFloor( x0 );
+            const F32 tx1 = tx0 + ( x1 - x0 );
+            const F32 left = -1.0f + 2.0f * ( x0 - uvMin.x ) / uvExtent.x - copyOffsetX;
+            const F32 right = -1.0f + 2.0f * ( x1 - uvMin.x ) / uvExtent.x - copyOffsetX;
+
+            points.increment();
+            points.last().point = Point3F( right, bottom, 0.0f );
+            points.last().texCoord = Point2F( tx1, ty1 );
+            points.increment();
+            points.last().point = Point3F( right, top, 0.0f );
+            points.last().texCoord = Point2F( tx1, ty0 );
+            points.increment();
+            points.last().point = Point3F( left, bottom, 0.0f );
+            points.last().texCoord = Point2F( tx0, ty1 );
+            points.increment();
+            points.last().point = Point3F( left, top, 0.0f );
+            points.last().texCoord = Point2F( tx0, ty0 );
+
+            quadCount++;
+            x0 = x1;
+         }
+
+         y0 = y1;
+      }
+
+      vb.set( GFX, points.size(), GFXBufferTypeVolatile );
       GFXVertexPT *ptr = vb.lock();
       if(ptr)
       {
-         dMemcpy( ptr, points, sizeof(GFXVertexPT) * 4 );
+         dMemcpy( ptr, points.address(), sizeof(GFXVertexPT) * points.size() );
          vb.unlock();
       }
    }
 
-   GFXTexHandle blendTex;
-
-   // If the base texture is already a valid render target then 
-   // use it to render to else we create one.
-   if (  mBaseTex.isValid() && 
-         mBaseTex->isRenderTarget() &&
-         mBaseTex->getFormat() == GFXFormatR8G8B8A8_SRGB &&
-         mBaseTex->getWidth() == destSize.x &&
-         mBaseTex->getHeight() == destSize.y )
-      blendTex = mBaseTex;
-   else
-      blendTex.set( destSize.x, destSize.y, GFXFormatR8G8B8A8_SRGB, &GFXRenderTargetSRGBProfile, "" );
-
    GFX->pushActiveRenderTarget();   
 
    // Set our shader stuff
@@ -258,7 +279,7 @@ void TerrainBlock::_updateBaseTexture(bool writeToCache)
    GFX->setStateBlock( mBaseShaderSB );
    GFX->setVertexBuffer( vb );
 
-   mBaseTarget->attachTexture( GFXTextureTarget::Color0, blendTex );
+   mBaseTarget->attachTexture( GFXTextureTarget::Color0, target );
    GFX->setActiveRenderTarget( mBaseTarget );
 
    GFX->clear( GFXClearTarget, ColorI(0,0,0,255), 1.0f, 0 );
@@ -285,7 +306,8 @@ void TerrainBlock::_updateBaseTexture(bool writeToCache)
       mBaseShaderConsts->setSafe( mBaseTexScaleConst, Point2F( scale, -scale ) );
       mBaseShaderConsts->setSafe( mBaseTexIdConst, (F32)i );
 
-      GFX->drawPrimitive( GFXTriangleStrip, 0, 2 );
+      for ( U32 q=0; q < quadCount; q++ )
+         GFX->drawPrimitive( GFXTriangleStrip, q * 4, 2 );
    }
 
    mBaseTarget->resolve();
@@ -301,6 +323,36 @@ void TerrainBlock::_updateBaseTexture(bool writeToCache)
    if ( !sceneBegun )
       GFX->endScene();
 
+   return true;
+}
+
+void TerrainBlock::_updateBaseTexture(bool writeToCache)
+{
+   PROFILE_SCOPE( TerrainBlock_UpdateBaseTexture );
+
+   const U32 maxTextureSize = GFX->getCardProfiler()->queryProfile( "maxTextureSize", 1024 );
+
+   U32 baseTexSize = getNextPow2( mBaseTexSize );
+   baseTexSize = getMin( maxTextureSize, baseTexSize );
+   Point2I destSize( baseTexSize, baseTexSize );
+
+   GFXTexHandle blendTex;
+
+   // If the base texture is already a valid render target then 
+   // use it to render to else we create one.
+   if (  mBaseTex.isValid() && 
+         mBaseTex->isRenderTarget() &&
+         mBaseTex->getFormat() == GFXFormatR8G8B8A8_SRGB &&
+         mBaseTex->getWidth() == destSize.x &&
+         mBaseTex->getHeight() == destSize.y )
+      blendTex = mBaseTex;
+   else
+      blendTex.set( destSize.x, destSize.y, GFXFormatR8G8B8A8_SRGB, &GFXRenderTargetSRGBProfile, "" );
+
+   // The base texture covers the whole terrain once.
+   if ( !_blendBaseLayers( blendTex, Point2F( 0, 0 ), Point2F( 1, 1 ) ) )
+      return;
+
    /// Do we cache this sucker?
    if (mBaseTexFormat == NONE || !writeToCache)
    {
@@ -382,6 +434,12 @@ void TerrainBlock::_renderBlock( SceneRenderState *state )
    if ( !mDefaultMatInst )
       mDefaultMatInst = TerrainCellMaterial::getShadowMat();
 
+   // The clipmap decides the features of the base
+   // material, so rebuild it if the clipmap was toggled.
+   const bool useClipMap = TerrainClipMap::isEnabled();
+   if ( mBaseMaterial && mBaseMaterial->usesClipMap() != useClipMap )
+      SAFE_DELETE( mBaseMaterial );
+
    // Make sure we have a base material.
    if ( !mBaseMaterial )
    {
@@ -406,15 +464,20 @@ void TerrainBlock::_renderBlock( SceneRenderState *state )
    if ( mLayerTexDirty || mBaseTex.isNull() )
    {
       _updateBaseTexture( false );
+      mClipMap.invalidate();
       mLayerTexDirty = false;
    }   
 
+   // Keep the clipmap centered on the camera.
+   if ( useClipMap && state->isDiffusePass() )
+      mClipMap.update( this, objCamPos );
+   else if ( !useClipMap )
+      mClipMap.releaseTextures();
+
    static Vector<TerrCell*> renderCells;
    renderCells.clear();
 
-   mCell->cullCells( state,
-                     objCamPos,
-                     &renderCells );
+   _cullCells( state, objCamPos, &renderCells );
 
    RenderPassManager *renderPass = state->getRenderPass();
 
@@ -485,8 +548,10 @@ void TerrainBlock::_renderBlock( SceneRenderState *state )
 
          // If this cell is near enough to get detail textures then
          // use the full detail mapping material.  Else we use the
-         // simple base only material.
-         if ( !state->isReflectPass() && sqDist < radiusSq )
+         // simple base only material.  With the clipmap enabled
+         // the layers are already blended, so the base material
+         // is used everywhere.
+         if ( !state->isReflectPass() && !useClipMap && sqDist < radiusSq )
             inst->cellMat = cell->getMaterial();
          else if ( state->isReflectPass() )
             inst->cellMat = mBaseMaterial->getReflectMat();
@@ -503,6 +568,15 @@ void TerrainBlock::_renderBlock( SceneRenderState *state )
       renderPass->addInst( inst );
    }
 
+   // Release the buffers of cells we haven't rendered in a while
+   // so that the memory used follows the view and not the size
+   // of the terrain.
+   const U32 currTime = Platform::getRealMilliseconds();
+   if (  state->isDiffusePass() &&
+         TerrCell::smBufferTimeout > 0 && 
+         currTime > TerrCell::smBufferTimeout )
+      mCell->releaseUnusedBuffers( currTime - TerrCell::smBufferTimeout );
+
    // Trigger the debug rendering.
    if (  state->isDiffusePass() && 
          !renderCells.empty() && 
@@ -518,6 +592,35 @@ void TerrainBlock::_renderBlock( SceneRenderState *state )
    }
 }
 
+void TerrainBlock::_cullCells(  const SceneRenderState *state, 
+                                 const Point3F &objLodPos,
+                                 Vector<TerrCell*> *outCells )
+{
+   PROFILE_SCOPE( TerrainBlock_CullCells );
+
+   // The LOD only depends on the diffuse camera which the
+   // shadow passes share, so the selected cells are reused
+   // until the camera or the terrain changes.
+   const F32 screenScale = state->getWorldToScreenScale().y;
+   const F32 screenError = getScreenError();
+
+   if (  mLodCellsDirty ||
+         mLodCellsPos != objLodPos ||
+         mLodCellsScale != screenScale ||
+         mLodCellsError != screenError )
+   {
+      mLodCells.clear();
+      mCell->selectLodCells( state, objLodPos, &mLodCells );
+
+      mLodCellsPos = objLodPos;
+      mLodCellsScale = screenScale;
+      mLodCellsError = screenError;
+      mLodCellsDirty = false;
+   }
+
+   TerrCell::cullLodCells( state, mLodCells, outCells );
+}
+
 void TerrainBlock::_renderDebug( ObjectRenderInst *ri, 
                                  SceneRenderState *state, 
                                  BaseMatInstance *overrideMat )
@@ -0,0 +1,422 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "terrain/terrTileSet.h"
+
+#include "terrain/terrData.h"
+#include "T3D/gameBase/gameConnection.h"
+#include "console/consoleTypes.h"
+#include "console/engineAPI.h"
+#include "core/stream/bitStream.h"
+#include "math/mathIO.h"
+#include "math/mathTypes.h"
+#include "platform/profiler.h"
+
+
+IMPLEMENT_CO_NETOBJECT_V1( TerrainTileSet );
+
+ConsoleDocClass( TerrainTileSet,
+   "@brief Streams a large world in as a grid of terrain files around the cameras.\n\n"
+
+   "Every tile is a regular terrain file which is loaded in the background once a "
+   "camera comes within the loadRadius.  Tiles within the detailRadius use the full "
+   "detail file, tiles further out use the optional low resolution lodFile.  The file "
+   "patterns are formatted with the x and y index of the tile.\n\n"
+
+   "@tsexample\n"
+   "new TerrainTileSet()\n"
+   "{\n"
+   "   tileFile = \"art/terrains/world/tile_%d_%d.ter\";\n"
+   "   lodFile = \"art/terrains/world/tile_%d_%d_lod.ter\";\n"
+   "   origin = \"-8192 -8192 0\";\n"
+   "   tileCount = \"16 16\";\n"
+   "   tileSize = \"1024\";\n"
+   "   detailRadius = \"1500\";\n"
+   "   loadRadius = \"4000\";\n"
+   "};\n"
+   "@endtsexample\n\n"
+
+   "@ingroup Terrain"
+);
+
+U32 TerrainTileSet::smUpdateTicks = 8;
+U32 TerrainTileSet::smMaxAppliesPerUpdate = 1;
+
+
+TerrainTileSet::TerrainTileSet()
+   :  mOrigin( Point3F::Zero ),
+      mTileCount( 1, 1 ),
+      mTileSize( 1024.0f ),
+      mDetailRadius( 1024.0f ),
+      mLoadRadius( 4096.0f ),
+      mTicksToUpdate( 0 )
+{
+   mNetFlags.set( Ghostable | ScopeAlways );
+}
+
+TerrainTileSet::~TerrainTileSet()
+{
+}
+
+void TerrainTileSet::initPersistFields()
+{
+   addGroup( "Tiles" );
+
+      addField( "tileFile", TypeString, Offset( mTileFile, TerrainTileSet ),
+         "The file name pattern of the full detail tiles which is formatted with the x and y index of the tile." );
+
+      addField( "lodFile", TypeString, Offset( mLodFile, TerrainTileSet ),
+         "The optional file name pattern of the low resolution tiles used beyond the detailRadius." );
+
+      addField( "origin", TypePoint3F, Offset( mOrigin, TerrainTileSet ),
+         "The world space position of the corner of the first tile." );
+
+      addField( "tileCount", TypePoint2I, Offset( mTileCount, TerrainTileSet ),
+         "The number of tiles in x and y." );
+
+      addField( "tileSize", TypeF32, Offset( mTileSize, TerrainTileSet ),
+         "The world space size of a single tile." );
+
+   endGroup( "Tiles" );
+
+   addGroup( "Streaming" );
+
+      addField( "detailRadius", TypeF32, Offset( mDetailRadius, TerrainTileSet ),
+         "The distance from a camera up to which tiles are loaded at full detail." );
+
+      addField( "loadRadius", TypeF32, Offset( mLoadRadius, TerrainTileSet ),
+         "The distance from a camera up to which tiles are loaded at all." );
+
+   endGroup( "Streaming" );
+
+   Parent::initPersistFields();
+
+   Con::addVariable( "$pref::Terrain::tileUpdateTicks", TypeS32, &smUpdateTicks, "The number of ticks between two updates "
+      "of the streamed terrain tiles.\n\n"
+      "@ingroup Terrain");
+
+   Con::addVariable( "$pref::Terrain::tileAppliesPerUpdate", TypeS32, &smMaxAppliesPerUpdate, "The number of loaded terrain tiles "
+      "put in use per update.\n\n"
+      "@ingroup Terrain");
+}
+
+bool TerrainTileSet::onAdd()
+{
+   if ( !Parent::onAdd() )
+      return false;
+
+   _resetTiles();
+
+   return true;
+}
+
+void TerrainTileSet::onRemove()
+{
+   _clearTiles();
+
+   Parent::onRemove();
+}
+
+void TerrainTileSet::inspectPostApply()
+{
+   Parent::inspectPostApply();
+
+   // Start over with the new layout.
+   _resetTiles();
+
+   setMaskBits( UpdateMask );
+}
+
+U32 TerrainTileSet::packUpdate( NetConnection *conn, U32 mask, BitStream *stream )
+{
+   U32 retMask = Parent::packUpdate( conn, mask, stream );
+
+   if ( stream->writeFlag( mask & UpdateMask ) )
+   {
+      stream->write( mTileFile );
+      stream->write( mLodFile );
+      mathWrite( *stream, mOrigin );
+      stream->write( mTileCount.x );
+      stream->write( mTileCount.y );
+      stream->write( mTileSize );
+      stream->write( mDetailRadius );
+      stream->write( mLoadRadius );
+   }
+
+   return retMask;
+}
+
+void TerrainTileSet::unpackUpdate( NetConnection *conn, BitStream *stream )
+{
+   Parent::unpackUpdate( conn, stream );
+
+   if ( stream->readFlag() ) // UpdateMask
+   {
+      stream->read( &mTileFile );
+      stream->read( &mLodFile );
+      mathRead( *stream, &mOrigin );
+      stream->read( &mTileCount.x );
+      stream->read( &mTileCount.y );
+      stream->read( &mTileSize );
+      stream->read( &mDetailRadius );
+      stream->read( &mLoadRadius );
+
+      if ( isProperlyAdded() )
+      {
+         _resetTiles();
+      }
+   }
+}
+
+void TerrainTileSet::processTick()
+{
+   if ( !isProperlyAdded() || mTileFile.isEmpty() )
+      return;
+
+   if ( mTicksToUpdate > 0 )
+   {
+      mTicksToUpdate--;
+      return;
+   }
+
+   mTicksToUpdate = smUpdateTicks;
+   _updateTiles();
+}
+
+String TerrainTileSet::getTileFileName( const Point2I &coord, TileLevel level ) const
+{
+   const String &pattern = level == TileLod ? mLodFile : mTileFile;
+   return String::ToString( pattern.c_str(), coord.x, coord.y );
+}
+
+F32 TerrainTileSet::getTileDistance( const Point2I &coord, const Point3F &pos ) const
+{
+   const F32 minX = mOrigin.x + coord.x * mTileSize;
+   const F32 minY = mOrigin.y + coord.y * mTileSize;
+
+   const F32 dx = getMax( getMax( minX - pos.x, pos.x - ( minX + mTileSize ) ), 0.0f );
+   const F32 dy = getMax( getMax( minY - pos.y, pos.y - ( minY + mTileSize ) ), 0.0f );
+
+   return mSqrt( dx * dx + dy * dy );
+}
+
+void TerrainTileSet::_clearTiles()
+{
+   for ( U32 i = 0; i < mTiles.size(); i++ )
+      _unloadTile( i );
+
+   mTiles.clear();
+}
+
+void TerrainTileSet::_resetTiles()
+{
+   _clearTiles();
+
+   mTileCount.setMax( Point2I( 1, 1 ) );
+   mTileSize = getMax( mTileSize, 1.0f );
+   mTiles.setSize( mTileCount.x * mTileCount.y );
+   mTicksToUpdate = 0;
+}
+
+TerrainTileSet::TileLevel TerrainTileSet::_getDesiredLevel( const Tile &tile, F32 dist, F32 extraRadius ) const
+{
+   // Tiles keep their current level a little longer than
+   // they take to get it, so a camera moving along a tile
+   // border doesn't make them flip back and forth.
+   const F32 keep = mTileSize * 0.25f;
+
+   F32 detailRadius = mDetailRadius + extraRadius;
+   if ( tile.level == TileFull || tile.pending == TileFull )
+      detailRadius += keep;
+
+   if ( dist <= detailRadius )
+      return TileFull;
+
+   F32 loadRadius = mLoadRadius + extraRadius;
+   if ( tile.level != TileNone || tile.pending != TileNone )
+      loadRadius += keep;
+
+   if ( dist > loadRadius )
+      return TileNone;
+
+   // Without summaries the tiles load at full detail
+   // all the way out to the load radius.
+   return mLodFile.isEmpty() ? TileFull : TileLod;
+}
+
+void TerrainTileSet::_getCameraPositions( Vector<Point3F> *outPositions ) const
+{
+   if ( isServerObject() )
+   {
+      SimGroup *clientGroup = Sim::getClientGroup();
+      for ( SimGroup::iterator itr = clientGroup->begin(); itr != clientGroup->end(); itr++ )
+      {
+         GameConnection *con = dynamic_cast<GameConnection*>( *itr );
+         if ( !con )
+            continue;
+
+         GameBase *camera = con->getCameraObject();
+         if ( camera )
+            outPositions->push_back( camera->getPosition() );
+      }
+   }
+   else
+   {
+      GameConnection *con = GameConnection::getConnectionToServer();
+      MatrixF mat;
+      if ( con && con->getControlCameraTransform( 0.0f, &mat ) )
+         outPositions->push_back( mat.getPosition() );
+   }
+}
+
+void TerrainTileSet::_updateTiles()
+{
+   PROFILE_SCOPE( TerrainTileSet_UpdateTiles );
+
+   Vector<Point3F> cameras;
+   _getCameraPositions( &cameras );
+
+   // The client prefetches a bit further out than the
+   // server creates blocks, so that the ghosts find the
+   // files already loaded.
+   const F32 extraRadius = isClientObject() ? mTileSize * 0.5f : 0.0f;
+
+   U32 applied = 0;
+
+   for ( S32 y = 0; y < mTileCount.y; y++ )
+   {
+      for ( S32 x = 0; x < mTileCount.x; x++ )
+      {
+         const U32 index = x + y * mTileCount.x;
+         Tile &tile = mTiles[index];
+         const Point2I coord( x, y );
+
+         F32 dist = F32_MAX;
+         for ( U32 i = 0; i < cameras.size(); i++ )
+            dist = getMin( dist, getTileDistance( coord, cameras[i] ) );
+
+         const TileLevel desired = cameras.empty() ? tile.level : _getDesiredLevel( tile, dist, extraRadius );
+
+         // Drop loads which are no longer wanted.
+         if ( tile.pending != TileNone && tile.pending != desired )
+         {
+            tile.request->cancel();
+            tile.request = NULL;
+            tile.pending = TileNone;
+         }
+
+         if ( desired == TileNone )
+         {
+            if ( tile.level != TileNone )
+               _unloadTile( index );
+            continue;
+         }
+
+         // Closer tiles are loaded first.
+         const F32 priority = 1.0f / ( 1.0f + dist );
+
+         if ( tile.pending == TileNone && tile.level != desired )
+         {
+            tile.request = ResourceManager::get().loadAsync<TerrainFile>( getTileFileName( coord, desired ), priority );
+            tile.pending = desired;
+         }
+         else if ( tile.pending != TileNone )
+            tile.request->setPriority( priority );
+
+         if ( tile.pending == TileNone || !tile.request->isDone() || applied >= smMaxAppliesPerUpdate )
+            continue;
+
+         Resource<TerrainFile> file = tile.request->getResource();
+         const TileLevel level = tile.pending;
+         tile.request = NULL;
+         tile.pending = TileNone;
+
+         if ( !file )
+            continue;
+
+         tile.level = level;
+         _applyTile( index, file );
+         applied++;
+      }
+   }
+}
+
+void TerrainTileSet::_applyTile( U32 index, const Resource<TerrainFile> &file )
+{
+   Tile &tile = mTiles[index];
+
+   // The client only keeps the file loaded for the
+   // terrain block ghost to pick it up.
+   if ( isClientObject() )
+   {
+      tile.file = file;
+      return;
+   }
+
+   const F32 squareSize = mTileSize / (F32)file->getSize();
+
+   if ( tile.block )
+   {
+      tile.block->replaceFile( file, squareSize );
+      return;
+   }
+
+   const Point2I coord( index % mTileCount.x, index / mTileCount.x );
+
+   MatrixF mat( true );
+   mat.setPosition( mOrigin + Point3F( coord.x * mTileSize, coord.y * mTileSize, 0.0f ) );
+
+   TerrainBlock *block = new TerrainBlock();
+   block->replaceFile( file, squareSize );
+   block->setTransform( mat );
+   block->setCanSave( false );
+
+   if ( !block->registerObject() )
+   {
+      Con::errorf( "TerrainTileSet::_applyTile - Failed to register the terrain for '%s'!", file.getPath().getFullPath().c_str() );
+      delete block;
+      tile.level = TileNone;
+      return;
+   }
+
+   tile.block = block;
+}
+
+void TerrainTileSet::_unloadTile( U32 index )
+{
+   Tile &tile = mTiles[index];
+
+   if ( tile.request )
+      tile.request->cancel();
+
+   tile.request = NULL;
+   tile.pending = TileNone;
+   tile.level = TileNone;
+   tile.file = NULL;
+
+   if ( tile.block )
+      tile.block->deleteObject();
+
+   tile.block = NULL;
+}
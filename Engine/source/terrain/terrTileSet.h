@@ -0,0 +1,196 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _TERRTILESET_H_
+#define _TERRTILESET_H_
+
+#ifndef _NETOBJECT_H_
+#include "sim/netObject.h"
+#endif
+#ifndef _ITICKABLE_H_
+#include "core/iTickable.h"
+#endif
+#ifndef _RESOURCELOADREQUEST_H_
+#include "core/resourceLoadRequest.h"
+#endif
+#ifndef _TERRFILE_H_
+#include "terrain/terrFile.h"
+#endif
+#ifndef _MPOINT2_H_
+#include "math/mPoint2.h"
+#endif
+#ifndef _MPOINT3_H_
+#include "math/mPoint3.h"
+#endif
+
+class TerrainBlock;
+
+
+/// Streams a large world in as a grid of regular terrain files.
+///
+/// Each tile is an ordinary TerrainFile placed at its grid position.
+/// Tiles near a camera are loaded at full detail, tiles further
+/// away can use a small low resolution summary of the same tile and
+/// everything beyond that is not loaded at all.
+///
+/// The files are read on worker threads with ResourceManager::loadAsync.
+/// On the server a TerrainBlock is created, swapped to another file or
+/// deleted as a tile changes its level, which then ghosts to the clients
+/// like any other terrain.  The client side object prefetches the tiles
+/// around its own camera a little further out, so the ghosts find their
+/// files already loaded.
+///
+class TerrainTileSet : public NetObject, public virtual ITickable
+{
+   typedef NetObject Parent;
+
+public:
+
+   /// The detail a tile is loaded at.
+   enum TileLevel
+   {
+      TileNone,
+      TileLod,
+      TileFull,
+   };
+
+   TerrainTileSet();
+   virtual ~TerrainTileSet();
+
+   DECLARE_CONOBJECT( TerrainTileSet );
+
+   /// The number of ticks between two tile updates.
+   static U32 smUpdateTicks;
+
+   /// The number of loaded tiles applied per update, to keep
+   /// the cost of building blocks from causing hitches.
+   static U32 smMaxAppliesPerUpdate;
+
+   /// Returns the file name for a tile at the given level.
+   String getTileFileName( const Point2I &coord, TileLevel level ) const;
+
+   /// Returns the world space distance on the XY plane
+   /// from the point to the edge of the tile.
+   F32 getTileDistance( const Point2I &coord, const Point3F &pos ) const;
+
+   // SimObject
+   static void initPersistFields();
+   bool onAdd();
+   void onRemove();
+   void inspectPostApply();
+
+   // NetObject
+   U32 packUpdate( NetConnection *conn, U32 mask, BitStream *stream );
+   void unpackUpdate( NetConnection *conn, BitStream *stream );
+
+   // ITickable
+   virtual void interpolateTick( F32 delta ) {}
+   virtual void processTick();
+   virtual void advanceTime( F32 timeDelta ) {}
+
+protected:
+
+   enum NetMaskBits
+   {
+      UpdateMask = BIT(0)
+   };
+
+   typedef ThreadSafeRef< ResourceLoadRequest<TerrainFile> > LoadRequestRef;
+
+   struct Tile
+   {
+      Tile()
+         :  level( TileNone ),
+            pending( TileNone )
+      {
+      }
+
+      /// The level currently in use.
+      TileLevel level;
+
+      /// The level being loaded or TileNone.
+      TileLevel pending;
+
+      /// The load of the pending level.
+      LoadRequestRef request;
+
+      /// The file in use on the client.
+      Resource<TerrainFile> file;
+
+      /// The terrain block of this tile on the server.
+      SimObjectPtr<TerrainBlock> block;
+   };
+
+   /// The file name pattern of the full detail tiles which
+   /// is formatted with the tile x and y coordinate.
+   String mTileFile;
+
+   /// The optional file name pattern of the low
+   /// resolution summaries used for far tiles.
+   String mLodFile;
+
+   /// The world space position of the first tile.
+   Point3F mOrigin;
+
+   /// The number of tiles in x and y.
+   Point2I mTileCount;
+
+   /// The world space size of a single tile.
+   F32 mTileSize;
+
+   /// The distance up to which tiles are loaded at full detail.
+   F32 mDetailRadius;
+
+   /// The distance up to which tiles are loaded at all.
+   F32 mLoadRadius;
+
+   /// The tiles in rows of mTileCount.x.
+   Vector<Tile> mTiles;
+
+   /// The ticks left until the next update.
+   U32 mTicksToUpdate;
+
+   /// Drops all tiles and pending loads.
+   void _clearTiles();
+
+   /// Drops all tiles and sets them up for the current layout.
+   void _resetTiles();
+
+   /// Returns the level a tile should be loaded at for
+   /// the distance to the closest camera.
+   TileLevel _getDesiredLevel( const Tile &tile, F32 dist, F32 extraRadius ) const;
+
+   /// Collects the positions the tiles are streamed around.
+   void _getCameraPositions( Vector<Point3F> *outPositions ) const;
+
+   /// Updates the desired level and loads of all tiles.
+   void _updateTiles();
+
+   /// Puts a loaded tile file in use.
+   void _applyTile( U32 index, const Resource<TerrainFile> &file );
+
+   /// Releases the file or block of a tile.
+   void _unloadTile( U32 index );
+};
+
+#endif // _TERRTILESET_H_
@@ -0,0 +1,178 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+
+#include "testing/benchmark.h"
+#include "platform/platformTimer.h"
+#include "console/engineAPI.h"
+#include "core/stream/fileStream.h"
+#include "core/strings/findMatch.h"
+#include "core/util/tVector.h"
+#include "app/version.h"
+
+Benchmark* Benchmark::smFirst = NULL;
+
+Benchmark::Benchmark( const char* group, const char* name, Function function )
+   : mGroup( group ),
+     mName( name ),
+     mFunction( function ),
+     mNext( smFirst )
+{
+   smFirst = this;
+}
+
+BenchmarkState::BenchmarkState( U32 iterations, PlatformTimer* timer )
+   : mIterations( iterations ),
+     mIteration( 0 ),
+     mTimer( timer ),
+     mElapsedUs( 0 )
+{
+}
+
+void BenchmarkState::_start()
+{
+   mTimer->reset();
+}
+
+void BenchmarkState::_stop()
+{
+   mElapsedUs = mTimer->getElapsedUs();
+}
+
+//-----------------------------------------------------------------------------
+
+namespace {
+
+struct BenchmarkResult
+{
+   String name;
+   U32 iterations;
+   F64 bestNs;       ///< Fastest sample in nanoseconds per iteration
+   F64 medianNs;     ///< Median sample in nanoseconds per iteration
+};
+
+S32 QSORT_CALLBACK compareF64( const void* a, const void* b )
+{
+   const F64 fa = *( const F64* ) a;
+   const F64 fb = *( const F64* ) b;
+   return fa < fb ? -1 : ( fa > fb ? 1 : 0 );
+}
+
+/// Run @a benchmark once with @a iterations and return the time in
+/// microseconds.
+S64 runOnce( Benchmark* benchmark, U32 iterations, PlatformTimer* timer )
+{
+   BenchmarkState state( iterations, timer );
+   benchmark->getFunction()( state );
+   return state.getElapsedUs();
+}
+
+void runBenchmark( Benchmark* benchmark, S32 minTimeMs, S32 samples, PlatformTimer* timer, BenchmarkResult& result )
+{
+   // Double the iteration count until a run takes long enough
+   // for the timer resolution not to matter.
+   U32 iterations = 1;
+   while( iterations < ( 1 << 30 ) && runOnce( benchmark, iterations, timer ) < minTimeMs * 1000 )
+      iterations *= 2;
+
+   Vector< F64 > times;
+   for( S32 i = 0; i < samples; ++ i )
+      times.push_back( F64( runOnce( benchmark, iterations, timer ) ) * 1000.0 / iterations );
+   dQsort( times.address(), times.size(), sizeof( F64 ), compareF64 );
+
+   result.iterations = iterations;
+   result.bestNs = times.first();
+   result.medianNs = times[ times.size() / 2 ];
+}
+
+void writeResults( const Vector< BenchmarkResult >& results, const char* fileName )
+{
+   FileStream* stream = FileStream::createAndOpen( fileName, Torque::FS::File::Write );
+   if( !stream )
+   {
+      Con::errorf( "runBenchmarks - Could not open '%s' for writing", fileName );
+      return;
+   }
+
+   stream->writeText( String::ToString( "{\n   \"version\": \"%s\",\n   \"compiled\": \"%s\",\n   \"benchmarks\": [\n",
+      getVersionString(), getCompileTimeString() ) );
+
+   for( U32 i = 0; i < results.size(); ++ i )
+   {
+      const BenchmarkResult& result = results[ i ];
+      stream->writeText( String::ToString( "      { \"name\": \"%s\", \"iterations\": %u, \"bestNs\": %.2f, \"medianNs\": %.2f }%s\n",
+         result.name.c_str(), result.iterations, result.bestNs, result.medianNs,
+         i + 1 < results.size() ? "," : "" ) );
+   }
+
+   stream->writeText( "   ]\n}\n" );
+   delete stream;
+}
+
+}
+
+DefineConsoleFunction( runBenchmarks, S32, ( const char* filter, const char* outputFile ), ( "*", "" ),
+   "Runs the engine benchmarks whose Group.Name matches the given pattern and "
+   "prints the time per iteration for each.\n\n"
+   "Each benchmark is repeated with twice the iterations until a run takes "
+   "$Benchmark::minTimeMs (default 100), then timed $Benchmark::samples "
+   "times (default 5).  The fastest and the median sample are reported.\n\n"
+   "@param filter A wildcard pattern such as \"BitStream.*\".\n"
+   "@param outputFile If given, the results are also written to this file as JSON "
+   "so they can be compared across builds.\n"
+   "@return The number of benchmarks run.")
+{
+   const S32 minTimeMs = getMax( Con::getIntVariable( "$Benchmark::minTimeMs", 100 ), 1 );
+   const S32 samples = getMax( Con::getIntVariable( "$Benchmark::samples", 5 ), 1 );
+
+   PlatformTimer* timer = PlatformTimer::create();
+   Vector< BenchmarkResult > results;
+
+   Con::printf( "\nBenchmarks Starting...\n" );
+
+   for( Benchmark* benchmark = Benchmark::getFirst(); benchmark; benchmark = benchmark->getNext() )
+   {
+      String name = String::ToString( "%s.%s", benchmark->getGroup(), benchmark->getName() );
+      if( !FindMatch::isMatch( filter, name, false ) )
+         continue;
+
+      BenchmarkResult result;
+      result.name = name;
+      runBenchmark( benchmark, minTimeMs, samples, timer, result );
+      results.push_back( result );
+
+      Con::printf( "%-48s %12.2f ns (median %.2f ns, %u iterations)",
+         name.c_str(), result.bestNs, result.medianNs, result.iterations );
+   }
+
+   Con::printf( "... Benchmarks Ended.\n" );
+
+   delete timer;
+
+   if( outputFile && outputFile[ 0 ] )
+      writeResults( results, outputFile );
+
+   return results.size();
+}
+
+#endif // TORQUE_TESTS_ENABLED
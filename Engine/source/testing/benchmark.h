@@ -0,0 +1,133 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+#ifdef TORQUE_TESTS_ENABLED
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+class PlatformTimer;
+
+/// Passed to each benchmark to drive its timed loop.
+///
+/// A benchmark does its setup, then loops while keepRunning() returns true.
+/// Only the time spent in that loop is measured:
+///
+/// @code
+/// BENCHMARK(BitStream, WriteInts)
+/// {
+///    U8 buffer[ 1024 ];
+///    BitStream stream( buffer, sizeof( buffer ) );
+///    while( state.keepRunning() )
+///    {
+///       stream.setPosition( 0 );
+///       stream.writeInt( 5, 4 );
+///    }
+/// }
+/// @endcode
+class BenchmarkState
+{
+   U32 mIterations;
+   U32 mIteration;
+   PlatformTimer* mTimer;
+   S64 mElapsedUs;
+
+public:
+
+   BenchmarkState( U32 iterations, PlatformTimer* timer );
+
+   /// Returns true while the benchmark should run another iteration.
+   bool keepRunning()
+   {
+      if( mIteration == 0 )
+         _start();
+      if( mIteration < mIterations )
+      {
+         mIteration ++;
+         return true;
+      }
+      _stop();
+      return false;
+   }
+
+   /// Number of iterations of this run.
+   U32 getIterations() const { return mIterations; }
+
+   /// Microseconds spent in the timed loop.
+   S64 getElapsedUs() const { return mElapsedUs; }
+
+   /// Keep the compiler from optimizing away the computation of @a value.
+   template< typename T >
+   static void keep( const T& value )
+   {
+      static volatile U8 sink;
+      sink = *reinterpret_cast< const volatile U8* >( &value );
+   }
+
+private:
+
+   void _start();
+   void _stop();
+};
+
+/// A benchmark registered with BENCHMARK().  Benchmarks are run with the
+/// runBenchmarks() console function.
+class Benchmark
+{
+public:
+
+   typedef void ( *Function )( BenchmarkState& state );
+
+   Benchmark( const char* group, const char* name, Function function );
+
+   const char* getGroup() const { return mGroup; }
+   const char* getName() const { return mName; }
+   Function getFunction() const { return mFunction; }
+   Benchmark* getNext() const { return mNext; }
+
+   /// First registered benchmark.
+   static Benchmark* getFirst() { return smFirst; }
+
+protected:
+
+   const char* mGroup;
+   const char* mName;
+   Function mFunction;
+   Benchmark* mNext;
+
+   static Benchmark* smFirst;
+};
+
+/// Define a benchmark named group.name.  The body gets a BenchmarkState
+/// called @a state.
+#define BENCHMARK(group, name)\
+   static void group##_##name##_Benchmark( BenchmarkState& state );\
+   static Benchmark group##_##name##_BenchmarkInstance( #group, #name, group##_##name##_Benchmark );\
+   static void group##_##name##_Benchmark( BenchmarkState& state )
+
+#endif // TORQUE_TESTS_ENABLED
+
+#endif // _BENCHMARK_H_
@@ -0,0 +1,46 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _TSSEQUENCEKEYS_ARCH_H_
+#define _TSSEQUENCEKEYS_ARCH_H_
+
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 )) 
+# // x86 CPU family implementations
+extern void tsInterpolateRotationsSoA_SSE2( U32 count, const S16* const key1[ 4 ], const S16* const key2[ 4 ], F32 t, QuatF* out );
+extern void tsInterpolateTranslationsSoA_SSE2( U32 count, const F32* const key1[ 3 ], const F32* const key2[ 3 ], F32 t, Point3F* out );
+extern void tsInterpolateQuantizedTranslationsSoA_SSE2( U32 count, const U16* const key1[ 3 ], const U16* const key2[ 3 ],
+                                                        const F32* const origin[ 3 ], const F32* const scale[ 3 ],
+                                                        F32 t, Point3F* out );
+#
+#else
+# // Other CPU types go here...
+#endif
+
+// Default implementations, used for the tail of a batch.
+extern void tsInterpolateRotationsSoA_C( U32 count, const S16* const key1[ 4 ], const S16* const key2[ 4 ], F32 t, QuatF* out );
+extern void tsInterpolateTranslationsSoA_C( U32 count, const F32* const key1[ 3 ], const F32* const key2[ 3 ], F32 t, Point3F* out );
+extern void tsInterpolateQuantizedTranslationsSoA_C( U32 count, const U16* const key1[ 3 ], const U16* const key2[ 3 ],
+                                                     const F32* const origin[ 3 ], const F32* const scale[ 3 ],
+                                                     F32 t, Point3F* out );
+
+#endif // _TSSEQUENCEKEYS_ARCH_H_
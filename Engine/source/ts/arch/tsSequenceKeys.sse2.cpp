@@ -0,0 +1,181 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "ts/tsSequenceKeys.h"
+
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+#include "ts/arch/tsSequenceKeys.arch.h"
+#include <emmintrin.h>
+
+/// Load four S16 values and convert them to floats in [-1,1].
+static inline __m128 loadQuatComponent( const S16* src, const __m128 scale )
+{
+   __m128i v = _mm_loadl_epi64( (const __m128i*) src );
+   v = _mm_srai_epi32( _mm_unpacklo_epi16( v, v ), 16 );
+   return _mm_mul_ps( _mm_cvtepi32_ps( v ), scale );
+}
+
+/// Load four U16 values and convert them to floats.
+static inline __m128 loadQuantized( const U16* src )
+{
+   const __m128i v = _mm_loadl_epi64( (const __m128i*) src );
+   return _mm_cvtepi32_ps( _mm_unpacklo_epi16( v, _mm_setzero_si128() ) );
+}
+
+static inline __m128 lerp( const __m128 a, const __m128 b, const __m128 t )
+{
+   return _mm_add_ps( a, _mm_mul_ps( t, _mm_sub_ps( b, a ) ) );
+}
+
+/// Write three component vectors out as four Point3Fs.
+static inline void storePoints( const __m128 x, const __m128 y, const __m128 z, Point3F* out )
+{
+   F32 vx[4], vy[4], vz[4];
+   _mm_storeu_ps( vx, x );
+   _mm_storeu_ps( vy, y );
+   _mm_storeu_ps( vz, z );
+   for ( U32 i = 0; i < 4; i++ )
+      out[i].set( vx[i], vy[i], vz[i] );
+}
+
+void tsInterpolateRotationsSoA_SSE2( U32 count, const S16* const key1[ 4 ], const S16* const key2[ 4 ], F32 t, QuatF* out )
+{
+   AssertFatal( sizeof( QuatF ) == 4 * sizeof( F32 ), "tsInterpolateRotationsSoA_SSE2 - Unexpected QuatF layout" );
+
+   const __m128 scale = _mm_set1_ps( 1.0f / F32( Quat16::MAX_VAL ) );
+   const __m128 vt = _mm_set1_ps( t );
+   const __m128 signBit = _mm_set1_ps( -0.0f );
+   const __m128 zero = _mm_setzero_ps();
+
+   // The two halves of the renormalization polynomial of TSTransform::interpolate().
+   const __m128 split = _mm_set1_ps( 0.857f );
+   const __m128 a2 = _mm_set1_ps( 0.699368f ), a1 = _mm_set1_ps( -1.819985f ), a0 = _mm_set1_ps( 2.126369f );
+   const __m128 b2 = _mm_set1_ps( 0.454012f ), b1 = _mm_set1_ps( -1.403517f ), b0 = _mm_set1_ps( 1.949542f );
+
+   U32 i = 0;
+   for ( ; i + 4 <= count; i += 4 )
+   {
+      __m128 x1 = loadQuatComponent( key1[0] + i, scale );
+      __m128 y1 = loadQuatComponent( key1[1] + i, scale );
+      __m128 z1 = loadQuatComponent( key1[2] + i, scale );
+      __m128 w1 = loadQuatComponent( key1[3] + i, scale );
+      const __m128 x2 = loadQuatComponent( key2[0] + i, scale );
+      const __m128 y2 = loadQuatComponent( key2[1] + i, scale );
+      const __m128 z2 = loadQuatComponent( key2[2] + i, scale );
+      const __m128 w2 = loadQuatComponent( key2[3] + i, scale );
+
+      // Flip the first quaternion where the two are more than 90 degrees apart.
+      __m128 dot = _mm_add_ps( _mm_add_ps( _mm_mul_ps( x1, x2 ), _mm_mul_ps( y1, y2 ) ),
+                               _mm_add_ps( _mm_mul_ps( z1, z2 ), _mm_mul_ps( w1, w2 ) ) );
+      const __m128 flip = _mm_and_ps( _mm_cmplt_ps( dot, zero ), signBit );
+      x1 = _mm_xor_ps( x1, flip );
+      y1 = _mm_xor_ps( y1, flip );
+      z1 = _mm_xor_ps( z1, flip );
+      w1 = _mm_xor_ps( w1, flip );
+
+      __m128 x = lerp( x1, x2, vt );
+      __m128 y = lerp( y1, y2, vt );
+      __m128 z = lerp( z1, z2, vt );
+      __m128 w = lerp( w1, w2, vt );
+
+      // Renormalize.
+      const __m128 dist2 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) ),
+                                       _mm_add_ps( _mm_mul_ps( z, z ), _mm_mul_ps( w, w ) ) );
+      const __m128 la = _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( a2, dist2 ), a1 ), dist2 ), a0 );
+      const __m128 lb = _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( b2, dist2 ), b1 ), dist2 ), b0 );
+      const __m128 useA = _mm_cmplt_ps( dist2, split );
+      const __m128 oneOverL = _mm_or_ps( _mm_and_ps( useA, la ), _mm_andnot_ps( useA, lb ) );
+
+      x = _mm_mul_ps( x, oneOverL );
+      y = _mm_mul_ps( y, oneOverL );
+      z = _mm_mul_ps( z, oneOverL );
+      w = _mm_mul_ps( w, oneOverL );
+
+      // Back to one quaternion per register.
+      _MM_TRANSPOSE4_PS( x, y, z, w );
+      F32* dst = (F32*) &out[i];
+      _mm_storeu_ps( dst,      x );
+      _mm_storeu_ps( dst + 4,  y );
+      _mm_storeu_ps( dst + 8,  z );
+      _mm_storeu_ps( dst + 12, w );
+   }
+
+   if ( i < count )
+   {
+      const S16* tail1[4] = { key1[0] + i, key1[1] + i, key1[2] + i, key1[3] + i };
+      const S16* tail2[4] = { key2[0] + i, key2[1] + i, key2[2] + i, key2[3] + i };
+      tsInterpolateRotationsSoA_C( count - i, tail1, tail2, t, out + i );
+   }
+}
+
+void tsInterpolateTranslationsSoA_SSE2( U32 count, const F32* const key1[ 3 ], const F32* const key2[ 3 ], F32 t, Point3F* out )
+{
+   const __m128 vt = _mm_set1_ps( t );
+
+   U32 i = 0;
+   for ( ; i + 4 <= count; i += 4 )
+   {
+      const __m128 x = lerp( _mm_loadu_ps( key1[0] + i ), _mm_loadu_ps( key2[0] + i ), vt );
+      const __m128 y = lerp( _mm_loadu_ps( key1[1] + i ), _mm_loadu_ps( key2[1] + i ), vt );
+      const __m128 z = lerp( _mm_loadu_ps( key1[2] + i ), _mm_loadu_ps( key2[2] + i ), vt );
+      storePoints( x, y, z, out + i );
+   }
+
+   if ( i < count )
+   {
+      const F32* tail1[3] = { key1[0] + i, key1[1] + i, key1[2] + i };
+      const F32* tail2[3] = { key2[0] + i, key2[1] + i, key2[2] + i };
+      tsInterpolateTranslationsSoA_C( count - i, tail1, tail2, t, out + i );
+   }
+}
+
+void tsInterpolateQuantizedTranslationsSoA_SSE2( U32 count, const U16* const key1[ 3 ], const U16* const key2[ 3 ],
+                                                 const F32* const origin[ 3 ], const F32* const scale[ 3 ],
+                                                 F32 t, Point3F* out )
+{
+   const __m128 vt = _mm_set1_ps( t );
+
+   U32 i = 0;
+   for ( ; i + 4 <= count; i += 4 )
+   {
+      __m128 v[3];
+      for ( U32 c = 0; c < 3; c++ )
+      {
+         const __m128 q = lerp( loadQuantized( key1[c] + i ), loadQuantized( key2[c] + i ), vt );
+         v[c] = _mm_add_ps( _mm_loadu_ps( origin[c] + i ), _mm_mul_ps( _mm_loadu_ps( scale[c] + i ), q ) );
+      }
+      storePoints( v[0], v[1], v[2], out + i );
+   }
+
+   if ( i < count )
+   {
+      const U16* tail1[3] = { key1[0] + i, key1[1] + i, key1[2] + i };
+      const U16* tail2[3] = { key2[0] + i, key2[1] + i, key2[2] + i };
+      const F32* tailOrigin[3] = { origin[0] + i, origin[1] + i, origin[2] + i };
+      const F32* tailScale[3] = { scale[0] + i, scale[1] + i, scale[2] + i };
+      tsInterpolateQuantizedTranslationsSoA_C( count - i, tail1, tail2, tailOrigin, tailScale, t, out + i );
+   }
+}
+
+#endif // TORQUE_CPU_X86
@@ -185,11 +185,11 @@ void ColladaAppMaterial::resolveColor(const domCommon_color_or_texture_type* val
 }
 
 // Generate a new Material object
-Material *ColladaAppMaterial::createMaterial(const Torque::Path& path) const
+Material *ColladaAppMaterial::createMaterial(const Torque::Path& path, const String& shapeName) const
 {
    // The filename and material name are used as TorqueScript identifiers, so
    // clean them up first
-   String cleanFile = cleanString(TSShapeLoader::getShapePath().getFileName());
+   String cleanFile = cleanString(shapeName);
    String cleanName = cleanString(getName());
 
    // Prefix the material name with the filename (if not done already by TSShapeConstructor prefix)
@@ -83,7 +83,7 @@ public:
       }
    }
 
-   Material *createMaterial(const Torque::Path& path) const;
+   Material *createMaterial(const Torque::Path& path, const String& shapeName) const;
 };
 
 #endif // _COLLADA_APP_MATERIAL_H_
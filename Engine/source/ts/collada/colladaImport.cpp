@@ -157,6 +157,8 @@ DefineConsoleFunction( enumColladaForImport, bool, (const char * shapePath, cons
    bool isSketchup = ColladaShapeLoader::checkAndMountSketchup(path, mountPoint, daePath);
 
    // Load the Collada file into memory
+   MutexHandle importLock;
+   importLock.lock(&ColladaShapeLoader::smImportMutex, true);
    domCOLLADA* root = ColladaShapeLoader::getDomCOLLADA(daePath);
    if (!root)
    {
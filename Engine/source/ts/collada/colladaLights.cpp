@@ -194,6 +194,8 @@ DefineConsoleFunction( loadColladaLights, bool, (const char * filename, const ch
    }
 
    // Load the Collada file into memory
+   MutexHandle importLock;
+   importLock.lock(&ColladaShapeLoader::smImportMutex, true);
    domCOLLADA* root = ColladaShapeLoader::getDomCOLLADA(path);
    if (!root) {
       TSShapeLoader::updateProgress(TSShapeLoader::Load_Complete, "Load complete");
@@ -49,6 +49,8 @@
 #include "ts/tsShapeConstruct.h"
 #include "core/util/zip/zipVolume.h"
 #include "gfx/bitmap/gBitmap.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/threadPool.h"
 
 MODULE_BEGIN( ColladaShapeLoader )
    MODULE_INIT_AFTER( ShapeLoader )
@@ -64,6 +66,8 @@ static DAE sDAE;                 // Collada model database (holds the last loade
 static Torque::Path sLastPath;   // Path of the last loaded Collada file
 static FileTime sLastModTime;    // Modification time of the last loaded Collada file
 
+Mutex ColladaShapeLoader::smImportMutex;
+
 //-----------------------------------------------------------------------------
 // Custom warning/error message handler
 class myErrorHandler : public daeErrorHandler
@@ -454,10 +458,11 @@ void copySketchupTexture(const Torque::Path &path, String &textureFilename)
 
 //-----------------------------------------------------------------------------
 /// Add collada materials to materials.cs
-void updateMaterialsScript(const Torque::Path &path, bool copyTextures = false)
+void updateMaterialsScript(const Torque::Path &path, const String& shapeName, const Vector<AppMaterial*>& materials,
+                           bool forceUpdate, bool copyTextures = false)
 {
 #ifdef DAE2DTS_TOOL
-   if (!ColladaUtils::getOptions().forceUpdateMaterials)
+   if (!forceUpdate)
       return;
 #endif
 
@@ -467,22 +472,22 @@ void updateMaterialsScript(const Torque::Path &path, bool copyTextures = false)
 
    // First see what materials we need to update
    PersistenceManager persistMgr;
-   for ( U32 iMat = 0; iMat < AppMesh::appMaterials.size(); iMat++ )
+   for ( U32 iMat = 0; iMat < materials.size(); iMat++ )
    {
-      ColladaAppMaterial *mat = dynamic_cast<ColladaAppMaterial*>( AppMesh::appMaterials[iMat] );
+      ColladaAppMaterial *mat = dynamic_cast<ColladaAppMaterial*>( materials[iMat] );
       if ( mat )
       {
          Material *mappedMat;
          if ( Sim::findObject( MATMGR->getMapEntry( mat->getName() ), mappedMat ) )
          {
             // Only update existing materials if forced to
-            if ( ColladaUtils::getOptions().forceUpdateMaterials )
+            if ( forceUpdate )
                persistMgr.setDirty( mappedMat );
          }
          else
          {
             // Create a new material definition
-            persistMgr.setDirty( mat->createMaterial( scriptPath ), scriptPath.getFullPath() );
+            persistMgr.setDirty( mat->createMaterial( scriptPath, shapeName ), scriptPath.getFullPath() );
          }
       }
    }
@@ -506,6 +511,77 @@ void updateMaterialsScript(const Torque::Path &path, bool copyTextures = false)
    persistMgr.saveDirty();
 }
 
+#ifndef DAE2DTS_TOOL
+
+/// Updates materials.cs from the main thread for a shape imported on a worker
+/// thread.  Takes over the imported materials, which the loader would
+/// otherwise delete.
+class UpdateMaterialsScriptItem : public ThreadPool::WorkItem
+{
+   Torque::Path mPath;
+   String mShapeName;
+   Vector<AppMaterial*> mMaterials;
+   bool mForceUpdate;
+
+public:
+   UpdateMaterialsScriptItem(const Torque::Path& path, const String& shapeName, Vector<AppMaterial*>& materials, bool forceUpdate)
+      : mPath(path), mShapeName(shapeName), mMaterials(materials), mForceUpdate(forceUpdate)
+   {
+      materials.clear();
+   }
+
+   ~UpdateMaterialsScriptItem()
+   {
+      for (S32 iMat = 0; iMat < mMaterials.size(); iMat++)
+         delete mMaterials[iMat];
+   }
+
+   // Run ahead of the shape's own load completion so that the first instances
+   // of the shape find its materials.
+   virtual F32 getPriority() { return F32_MAX; }
+
+protected:
+   virtual void execute()
+   {
+      updateMaterialsScript(mPath, mShapeName, mMaterials, mForceUpdate);
+   }
+};
+
+/// Import settings that need the main thread to look up.
+struct ColladaImportSetup
+{
+   Torque::Path path;
+   bool useCachedDTS;
+   TSShapeConstructor* constructor;
+   ColladaUtils::ImportOptions options;
+};
+
+static void _setupImport(void* data)
+{
+   ColladaImportSetup* setup = (ColladaImportSetup*)data;
+   setup->useCachedDTS = ColladaShapeLoader::canLoadCachedDTS(setup->path);
+   setup->constructor = TSShapeConstructor::findShapeConstructor(setup->path.getFullPath());
+   if (setup->constructor)
+      setup->options = setup->constructor->mOptions;
+}
+
+TSShape* loadColladaShape(const Torque::Path &path);
+
+/// Imports a Sketchup file from the main thread.
+struct ColladaMainThreadImport
+{
+   Torque::Path path;
+   TSShape* shape;
+};
+
+static void _importOnMainThread(void* data)
+{
+   ColladaMainThreadImport* import = (ColladaMainThreadImport*)data;
+   import->shape = loadColladaShape(import->path);
+}
+
+#endif // DAE2DTS_TOOL
+
 //-----------------------------------------------------------------------------
 /// Check if an up-to-date cached DTS is available for this DAE file
 bool ColladaShapeLoader::canLoadCachedDTS(const Torque::Path& path)
@@ -646,21 +722,35 @@ domCOLLADA* ColladaShapeLoader::readColladaFile(const String& path)
 TSShape* loadColladaShape(const Torque::Path &path)
 {
 #ifndef DAE2DTS_TOOL
+   // Sketchup files mount a zip file system while they are imported, which
+   // has to happen on the main thread
+   if (!ThreadManager::isMainThread() && path.getExtension().equal("kmz", String::NoCase))
+   {
+      ColladaMainThreadImport import;
+      import.path = path;
+      import.shape = NULL;
+      TSShapeLoader::runOnMainThread(&_importOnMainThread, &import);
+      return import.shape;
+   }
+
+   // This may be a worker thread, so look up the cache state and any
+   // TSShapeConstructor from the main thread before starting
+   ColladaImportSetup setup;
+   setup.path = path;
+   TSShapeLoader::runOnMainThread(&_setupImport, &setup);
+
    // Generate the cached filename
    Torque::Path cachedPath(path);
    cachedPath.setExtension("cached.dts");
 
    // Check if an up-to-date cached DTS version of this file exists, and
    // if so, use that instead.
-   if (ColladaShapeLoader::canLoadCachedDTS(path))
+   if (setup.useCachedDTS)
    {
-      FileStream cachedStream;
-      cachedStream.open(cachedPath.getFullPath(), Torque::FS::File::Read);
-      if (cachedStream.getStatus() == Stream::Ok)
+      if (Torque::FS::IsFile(cachedPath))
       {
          TSShape *shape = new TSShape;
-         bool readSuccess = shape->read(&cachedStream);
-         cachedStream.close();
+         bool readSuccess = shape->readFile(cachedPath);
 
          if (readSuccess)
          {
@@ -683,23 +773,30 @@ TSShape* loadColladaShape(const Torque::Path &path)
       return NULL;
    }
 
+   // One import at a time, the DOM and the import options are shared
+   MutexHandle importLock;
+   importLock.lock(&ColladaShapeLoader::smImportMutex, true);
+
 #ifdef DAE2DTS_TOOL
    ColladaUtils::ImportOptions cmdLineOptions = ColladaUtils::getOptions();
 #endif
 
    // Allow TSShapeConstructor object to override properties
    ColladaUtils::getOptions().reset();
+#ifdef DAE2DTS_TOOL
    TSShapeConstructor* tscon = TSShapeConstructor::findShapeConstructor(path.getFullPath());
    if (tscon)
    {
       ColladaUtils::getOptions() = tscon->mOptions;
 
-#ifdef DAE2DTS_TOOL
       // Command line overrides certain options
       ColladaUtils::getOptions().forceUpdateMaterials = cmdLineOptions.forceUpdateMaterials;
       ColladaUtils::getOptions().useDiffuseNames = cmdLineOptions.useDiffuseNames;
-#endif
    }
+#else
+   if (setup.constructor)
+      ColladaUtils::getOptions() = setup.options;
+#endif
 
    // Check if this is a Sketchup file (.kmz) and if so, mount the zip filesystem
    // and get the path to the DAE file.
@@ -716,6 +813,30 @@ TSShape* loadColladaShape(const Torque::Path &path)
       tss = loader.generateShape(daePath);
       if (tss)
       {
+         // Generate simplified detail levels before the shape is cached
+         const ColladaUtils::ImportOptions& opts = ColladaUtils::getOptions();
+         if (opts.autoDetailCount > 0)
+         {
+            for (S32 iSS = 0; iSS < tss->subShapeFirstObject.size(); iSS++)
+            {
+               S32 smallest = -1;
+               for (S32 iDet = 0; iDet < tss->details.size(); iDet++)
+               {
+                  const TSShape::Detail& det = tss->details[iDet];
+                  if ((det.subShapeNum == iSS) && (det.size >= 0) &&
+                      ((smallest < 0) || (det.size < tss->details[smallest].size)))
+                     smallest = iDet;
+               }
+
+               if (smallest >= 0)
+                  tss->addSimplifiedDetails((S32)tss->details[smallest].size, opts.autoDetailCount,
+                                            opts.autoDetailReduction, opts.autoDetailPixelError);
+            }
+
+            tss->init();
+            tss->finalizeEditable();
+         }
+
 #ifndef DAE2DTS_TOOL
          // Cache the Collada model to a DTS file for faster loading next time.
          FileStream dtsStream;
@@ -733,7 +854,15 @@ TSShape* loadColladaShape(const Torque::Path &path)
 #endif // DAE2DTS_TOOL
 
          // Add collada materials to materials.cs
-         updateMaterialsScript(path, isSketchup);
+         const String shapeName = TSShapeLoader::getShapePath().getFileName();
+         const bool forceUpdate = ColladaUtils::getOptions().forceUpdateMaterials;
+#ifndef DAE2DTS_TOOL
+         if (!ThreadManager::isMainThread())
+            ThreadPool::GLOBAL().queueWorkItemOnMainThread(
+               new UpdateMaterialsScriptItem(path, shapeName, AppMesh::appMaterials, forceUpdate));
+         else
+#endif
+            updateMaterialsScript(path, shapeName, AppMesh::appMaterials, forceUpdate, isSketchup);
       }
    }
 
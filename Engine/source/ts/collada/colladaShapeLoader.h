@@ -26,6 +26,9 @@
 #ifndef _TSSHAPELOADER_H_
 #include "ts/loader/tsShapeLoader.h"
 #endif
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
 
 class domCOLLADA;
 class domAnimation;
@@ -52,6 +55,10 @@ public:
    bool ignoreMesh(const String& name);
    void computeBounds(Box3F& bounds);
 
+   /// Serializes use of the Collada DOM and the loader's static state.  Shapes
+   /// may be imported on worker threads, so hold this while using the DOM.
+   static Mutex smImportMutex;
+
    static bool canLoadCachedDTS(const Torque::Path& path);
    static bool checkAndMountSketchup(const Torque::Path& path, String& mountPoint, Torque::Path& daePath);
    static domCOLLADA* getDomCOLLADA(const Torque::Path& path);
@@ -90,6 +90,9 @@ namespace ColladaUtils
       bool           adjustFloor;      // Translate model so origin is at the bottom
       bool           forceUpdateMaterials;   // Force update of materials.cs
       bool           useDiffuseNames;  // Use diffuse texture as the material name
+      S32            autoDetailCount;  // Number of simplified detail levels to generate
+      F32            autoDetailReduction;    // Fraction of triangles kept by each simplified detail level
+      F32            autoDetailPixelError;   // Max on-screen error (in pixels) of a simplified detail level
 
       ImportOptions()
       {
@@ -112,6 +115,9 @@ namespace ColladaUtils
          adjustFloor = false;
          forceUpdateMaterials = false;
          useDiffuseNames = false;
+         autoDetailCount = 0;
+         autoDetailReduction = 0.5f;
+         autoDetailPixelError = 1.0f;
       }
    };
 
@@ -30,6 +30,10 @@
 #include "materials/materialManager.h"
 #include "ts/tsShapeInstance.h"
 #include "ts/tsMaterialList.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/threadPool.h"
+#include "platform/threads/jobSystem.h"
+#include "core/resourceLoadRequest.h"
 
 MODULE_BEGIN( ShapeLoader )
    MODULE_INIT_AFTER( GFX )
@@ -37,6 +41,10 @@ MODULE_BEGIN( ShapeLoader )
    {
       TSShapeLoader::addFormat("Torque DTS", "dts");
       TSShapeLoader::addFormat("Torque DSQ", "dsq");
+
+      Con::addVariable("$TSShapeLoader::optimizeMeshes", TypeBool, &TSShapeLoader::smOptimizeMeshes,
+         "Optimize the triangle and vertex order of imported meshes for the GPU.\n"
+         "@ingroup Rendering\n");
    }
 MODULE_END;
 
@@ -45,6 +53,7 @@ const F64 TSShapeLoader::MinFrameRate = 15.0f;
 const F64 TSShapeLoader::MaxFrameRate = 60.0f;
 const F64 TSShapeLoader::AppGroundFrameRate = 10.0f;
 Torque::Path TSShapeLoader::shapePath;
+bool TSShapeLoader::smOptimizeMeshes = true;
 
 Vector<TSShapeLoader::ShapeFormat> TSShapeLoader::smFormats;
 
@@ -113,19 +122,71 @@ void TSShapeLoader::generateNodeTransform(AppNode* node, F32 t, bool blend, F32
 
 //-----------------------------------------------------------------------------
 
+namespace {
+
+/// Forwards the progress of an import running on a worker thread to script.
+class ProgressItem : public ThreadPool::WorkItem
+{
+   F32 mProgress;
+   String mMsg;
+
+public:
+   ProgressItem(F32 progress, const String& msg)
+      : mProgress(progress), mMsg(msg) {}
+
+protected:
+   virtual void execute()
+   {
+      Con::executef("updateTSShapeLoadProgress", Con::getFloatArg(mProgress), mMsg.c_str());
+   }
+};
+
+/// Calls a function on the main thread for TSShapeLoader::runOnMainThread.
+class MainThreadCallItem : public ThreadPool::WorkItem
+{
+   void (*mFn)(void*);
+   void* mData;
+
+public:
+   MainThreadCallItem(void (*fn)(void*), void* data)
+      : mFn(fn), mData(data) {}
+
+protected:
+   virtual void execute() { mFn(mData); }
+};
+
+}
+
 void TSShapeLoader::updateProgress(S32 major, const char* msg, S32 numMinor, S32 minor)
 {
    // Calculate progress value
    F32 progress = (F32)major / NumLoadPhases;
-   const char *progressMsg = msg;
+   String progressMsg(msg);
 
    if (numMinor)
    {
       progress += (minor * (1.0f / NumLoadPhases) / numMinor);
-      progressMsg = avar("%s (%d of %d)", msg, minor + 1, numMinor);
+      progressMsg = String::ToString("%s (%d of %d)", msg, minor + 1, numMinor);
    }
 
-   Con::executef("updateTSShapeLoadProgress", Con::getFloatArg(progress), progressMsg);
+   if (ThreadManager::isMainThread())
+      Con::executef("updateTSShapeLoadProgress", Con::getFloatArg(progress), progressMsg.c_str());
+   else
+      ThreadPool::GLOBAL().queueWorkItemOnMainThread(new ProgressItem(progress, progressMsg));
+}
+
+void TSShapeLoader::runOnMainThread(void (*fn)(void*), void* data)
+{
+   if (ThreadManager::isMainThread())
+   {
+      fn(data);
+      return;
+   }
+
+   ThreadSafeRef<MainThreadCallItem> item(new MainThreadCallItem(fn, data));
+   ThreadPool::GLOBAL().queueWorkItemOnMainThread(item);
+   while (!item->hasExecuted())
+      Platform::sleep(1);
 }
 
 //-----------------------------------------------------------------------------
@@ -1149,6 +1210,22 @@ void TSShapeLoader::sortDetails()
    }
 }
 
+void TSShapeLoader::_constructMeshes(void* data, U32 start, U32 end)
+{
+   TSShapeLoader* loader = (TSShapeLoader*)data;
+   for (U32 m = start; m < end; m++)
+   {
+      AppMesh* appMesh = loader->appMeshes[m];
+      TSMesh* mesh = appMesh ? appMesh->constructTSMesh() : NULL;
+      if (mesh && smOptimizeMeshes)
+      {
+         mesh->optimizeTriangleOrder();
+         mesh->optimizeVertexOrder();
+      }
+      loader->shape->meshes[m] = mesh;
+   }
+}
+
 // Install into the TSShape, the shape is expected to be empty.
 // Data is not copied, the TSShape is modified to point to memory
 // managed by this object.  This object is also bound to the TSShape
@@ -1159,10 +1236,10 @@ void TSShapeLoader::install()
    // to be allocated beforehand.
    shape->subShapeFirstTranslucentObject.setSize(shape->subShapeFirstObject.size());
 
-   // Construct TS sub-meshes
+   // Construct and optimize TS sub-meshes.  Each mesh only reads its own
+   // AppMesh, so they are converted (and their tangents generated) in parallel.
    shape->meshes.setSize(appMeshes.size());
-   for (U32 m = 0; m < appMeshes.size(); m++)
-      shape->meshes[m] = appMeshes[m] ? appMeshes[m]->constructTSMesh() : NULL;
+   JobSystem::GLOBAL().parallelFor(appMeshes.size(), 1, &_constructMeshes, this);
 
    // Remove empty meshes and objects
    for (S32 iObj = shape->objects.size()-1; iObj >= 0; iObj--)
@@ -1338,3 +1415,38 @@ DefineConsoleFunction( getFormatFilters, const char*, ( ),,
 {
    return Con::getReturnBuffer(TSShapeLoader::getFormatFilters());
 }
+
+//-----------------------------------------------------------------------------
+// Background import
+
+typedef ThreadSafeRef< ResourceLoadRequest<TSShape> > TSShapeLoadRequestRef;
+static Vector<TSShapeLoadRequestRef> sgBackgroundImports;
+
+static void _onBackgroundImportDone(Resource<TSShape>&)
+{
+   for (S32 i = sgBackgroundImports.size() - 1; i >= 0; i--)
+   {
+      if (!sgBackgroundImports[i]->isDone())
+         continue;
+
+      TSShapeLoadRequestRef request = sgBackgroundImports[i];
+      sgBackgroundImports.erase(i);
+
+      if (Con::isFunction("onShapeImportComplete"))
+      {
+         TSShape* shape = request->getResource();
+         Con::executef("onShapeImportComplete", request->getPath().getFullPath().c_str(), shape ? "1" : "0");
+      }
+   }
+}
+
+DefineConsoleFunction( importShapeInBackground, void, ( const char* shapePath ),,
+  "Loads a shape on a worker thread, importing it and writing its cached DTS "
+  "if it is a COLLADA file without an up-to-date cache. Import progress is "
+  "reported through updateTSShapeLoadProgress() and onShapeImportComplete(%path, "
+  "%success) is called once done, if defined.")
+{
+   TSShapeLoadRequestRef request = ResourceManager::get().loadAsync<TSShape>(shapePath);
+   request->getCompletedSignal().notify(&_onBackgroundImportDone);
+   sgBackgroundImports.push_back(request);
+}
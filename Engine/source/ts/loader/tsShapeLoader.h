@@ -78,6 +78,16 @@ public:
 
    static void updateProgress(S32 major, const char* msg, S32 numMinor=0, S32 minor=0);
 
+   /// Optimize the triangle and vertex order of imported meshes for the
+   /// vertex cache, overdraw and vertex fetches.
+   static bool smOptimizeMeshes;
+
+   /// Run @a fn on the main thread and wait for it to return.  Imports may run
+   /// on a worker thread (see ResourceManager::loadAsync), and use this for the
+   /// steps that touch script, the sim or file system mounts.  The main thread
+   /// must keep processing its work item queue while the import is waiting.
+   static void runOnMainThread(void (*fn)(void*), void* data);
+
 protected:
    struct Subshape
    {
@@ -181,6 +191,7 @@ protected:
    // Shape construction
    void sortDetails();
    void install();
+   static void _constructMeshes(void* data, U32 start, U32 end);
 
 public:
    TSShapeLoader() : boundsNode(0) { }
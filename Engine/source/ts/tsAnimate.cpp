@@ -21,6 +21,8 @@
 //-----------------------------------------------------------------------------
 
 #include "ts/tsShapeInstance.h"
+#include "ts/tsSequenceKeys.h"
+#include "platform/threads/jobSystem.h"
 
 //----------------------------------------------------------------------------------
 // some utility functions
@@ -62,6 +64,8 @@ void TSShapeInstance::animateNodes(S32 ss)
 {
    PROFILE_SCOPE( TSShapeInstance_animateNodes );
 
+   NodeWorkspace& ws = getNodeWorkspace();
+
    if (!mShape->nodes.size())
       return;
 
@@ -69,11 +73,11 @@ void TSShapeInstance::animateNodes(S32 ss)
    mNodeTransforms.setSize(mShape->nodes.size());
 
    // temporary storage for node transforms
-   smNodeCurrentRotations.setSize(mShape->nodes.size());
-   smNodeCurrentTranslations.setSize(mShape->nodes.size());
-   smNodeLocalTransforms.setSize(mShape->nodes.size());
-   smRotationThreads.setSize(mShape->nodes.size());
-   smTranslationThreads.setSize(mShape->nodes.size());
+   ws.currentRotations.setSize(mShape->nodes.size());
+   ws.currentTranslations.setSize(mShape->nodes.size());
+   ws.localTransforms.setSize(mShape->nodes.size());
+   ws.rotationThreads.setSize(mShape->nodes.size());
+   ws.translationThreads.setSize(mShape->nodes.size());
 
    TSIntegerSet rotBeenSet;
    TSIntegerSet tranBeenSet;
@@ -81,7 +85,7 @@ void TSShapeInstance::animateNodes(S32 ss)
    rotBeenSet.setAll(mShape->nodes.size());
    tranBeenSet.setAll(mShape->nodes.size());
    scaleBeenSet.setAll(mShape->nodes.size());
-   smNodeLocalTransformDirty.clearAll();
+   ws.localTransformDirty.clearAll();
 
    S32 i,j,nodeIndex,a,b,start,end,firstBlend = mThreadList.size();
    for (i=0; i<mThreadList.size(); i++)
@@ -115,20 +119,36 @@ void TSShapeInstance::animateNodes(S32 ss)
    // can't add masked nodes since x, y, & z masked separately...
    // we'll set default regardless of mask status
 
-   // all the nodes marked above need to have the default transform
    a = mShape->subShapeFirstNode[ss];
    b = a + mShape->subShapeNumNodes[ss];
+
+   // small shapes leave their leaf nodes at the default transform
+   // and skip sampling them below
+   if (mAnimLODSkipLeaves)
+   {
+      TSIntegerSet leafNodes;
+      leafNodes.clearAll();
+      for (i=a; i<b; i++)
+         if (mShape->nodes[i].firstChild < 0)
+            leafNodes.set(i);
+      leafNodes.takeAway(mCallbackNodes);
+      leafNodes.takeAway(mHandsOffNodes);
+      rotBeenSet.overlap(leafNodes);
+      tranBeenSet.overlap(leafNodes);
+   }
+
+   // all the nodes marked above need to have the default transform
    for (i=a; i<b; i++)
    {
       if (rotBeenSet.test(i))
       {
-         mShape->defaultRotations[i].getQuatF(&smNodeCurrentRotations[i]);
-         smRotationThreads[i] = NULL;
+         mShape->defaultRotations[i].getQuatF(&ws.currentRotations[i]);
+         ws.rotationThreads[i] = NULL;
       }
       if (tranBeenSet.test(i))
       {
-         smNodeCurrentTranslations[i] = mShape->defaultTranslations[i];
-         smTranslationThreads[i] = NULL;
+         ws.currentTranslations[i] = mShape->defaultTranslations[i];
+         ws.translationThreads[i] = NULL;
       }
    }
 
@@ -148,6 +168,16 @@ void TSShapeInstance::animateNodes(S32 ss)
    {
       TSThread * th = mThreadList[i];
 
+      // sample every animated node of the sequence in one batch if we can
+      const TSSequenceKeys * keys = mShape->getSequenceKeys(*th->getSequence());
+      if (keys)
+      {
+         ws.sampledRotations.setSize(keys->getNumRotations());
+         ws.sampledTranslations.setSize(keys->getNumTranslations());
+         keys->interpolateRotations(th->keyNum1,th->keyNum2,th->keyPos,ws.sampledRotations.address());
+         keys->interpolateTranslations(th->keyNum1,th->keyNum2,th->keyPos,ws.sampledTranslations.address());
+      }
+
       j=0;
       start = th->getSequence()->rotationMatters.start();
       end   = b;
@@ -158,12 +188,17 @@ void TSShapeInstance::animateNodes(S32 ss)
             continue;
          if (!rotBeenSet.test(nodeIndex))
          {
-            QuatF q1,q2;
-            mShape->getRotation(*th->getSequence(),th->keyNum1,j,&q1);
-            mShape->getRotation(*th->getSequence(),th->keyNum2,j,&q2);
-            TSTransform::interpolate(q1,q2,th->keyPos,&smNodeCurrentRotations[nodeIndex]);
+            if (keys)
+               ws.currentRotations[nodeIndex] = ws.sampledRotations[j];
+            else
+            {
+               QuatF q1,q2;
+               mShape->getRotation(*th->getSequence(),th->keyNum1,j,&q1);
+               mShape->getRotation(*th->getSequence(),th->keyNum2,j,&q2);
+               TSTransform::interpolate(q1,q2,th->keyPos,&ws.currentRotations[nodeIndex]);
+            }
             rotBeenSet.set(nodeIndex);
-            smRotationThreads[nodeIndex] = th;
+            ws.rotationThreads[nodeIndex] = th;
          }
       }
 
@@ -180,10 +215,15 @@ void TSShapeInstance::animateNodes(S32 ss)
                handleMaskedPositionNode(th,nodeIndex,j);
             else
             {
-               const Point3F & p1 = mShape->getTranslation(*th->getSequence(),th->keyNum1,j);
-               const Point3F & p2 = mShape->getTranslation(*th->getSequence(),th->keyNum2,j);
-               TSTransform::interpolate(p1,p2,th->keyPos,&smNodeCurrentTranslations[nodeIndex]);
-               smTranslationThreads[nodeIndex] = th;
+               if (keys)
+                  ws.currentTranslations[nodeIndex] = ws.sampledTranslations[j];
+               else
+               {
+                  const Point3F & p1 = mShape->getTranslation(*th->getSequence(),th->keyNum1,j);
+                  const Point3F & p2 = mShape->getTranslation(*th->getSequence(),th->keyNum2,j);
+                  TSTransform::interpolate(p1,p2,th->keyPos,&ws.currentTranslations[nodeIndex]);
+               }
+               ws.translationThreads[nodeIndex] = th;
             }
             tranBeenSet.set(nodeIndex);
          }
@@ -197,9 +237,9 @@ void TSShapeInstance::animateNodes(S32 ss)
    for (i=a; i<b; i++)
    {
       if (!mHandsOffNodes.test(i))
-         TSTransform::setMatrix(smNodeCurrentRotations[i],smNodeCurrentTranslations[i],&smNodeLocalTransforms[i]);
+         TSTransform::setMatrix(ws.currentRotations[i],ws.currentTranslations[i],&ws.localTransforms[i]);
       else
-         smNodeLocalTransforms[i] = mNodeTransforms[i];     // in case mNodeTransform was changed externally
+         ws.localTransforms[i] = mNodeTransforms[i];     // in case mNodeTransform was changed externally
    }
 
    // add scale onto transforms
@@ -215,8 +255,8 @@ void TSShapeInstance::animateNodes(S32 ss)
       S32 nodeIndex = mNodeCallbacks[i].nodeIndex;
       if (nodeIndex>=start && nodeIndex<end)
       {
-         mNodeCallbacks[i].callback->setNodeTransform(this, nodeIndex, smNodeLocalTransforms[nodeIndex]);
-         smNodeLocalTransformDirty.set(nodeIndex);
+         mNodeCallbacks[i].callback->setNodeTransform(this, nodeIndex, ws.localTransforms[nodeIndex]);
+         ws.localTransformDirty.set(nodeIndex);
       }
    }
 
@@ -239,48 +279,50 @@ void TSShapeInstance::animateNodes(S32 ss)
    {
       S32 parentIdx = mShape->nodes[i].parentIndex;
       if (parentIdx < 0)
-         mNodeTransforms[i] = smNodeLocalTransforms[i];
+         mNodeTransforms[i] = ws.localTransforms[i];
       else
-         mNodeTransforms[i].mul(mNodeTransforms[parentIdx],smNodeLocalTransforms[i]);
+         mNodeTransforms[i].mul(mNodeTransforms[parentIdx],ws.localTransforms[i]);
    }
 }
 
 void TSShapeInstance::handleDefaultScale(S32 a, S32 b, TSIntegerSet & scaleBeenSet)
 {
+   NodeWorkspace& ws = getNodeWorkspace();
+
    // set default scale values (i.e., identity) and do any initialization
    // relating to animated scale (since scale normally not animated)
 
-   smScaleThreads.setSize(mShape->nodes.size());
+   ws.scaleThreads.setSize(mShape->nodes.size());
    scaleBeenSet.takeAway(mCallbackNodes);
    scaleBeenSet.takeAway(mHandsOffNodes);
    if (animatesUniformScale())
    {
-      smNodeCurrentUniformScales.setSize(mShape->nodes.size());
+      ws.currentUniformScales.setSize(mShape->nodes.size());
       for (S32 i=a; i<b; i++)
          if (scaleBeenSet.test(i))
          {
-            smNodeCurrentUniformScales[i] = 1.0f;
-            smScaleThreads[i] = NULL;
+            ws.currentUniformScales[i] = 1.0f;
+            ws.scaleThreads[i] = NULL;
          }
    }
    else if (animatesAlignedScale())
    {
-      smNodeCurrentAlignedScales.setSize(mShape->nodes.size());
+      ws.currentAlignedScales.setSize(mShape->nodes.size());
       for (S32 i=a; i<b; i++)
          if (scaleBeenSet.test(i))
          {
-            smNodeCurrentAlignedScales[i].set(1.0f,1.0f,1.0f);
-            smScaleThreads[i] = NULL;
+            ws.currentAlignedScales[i].set(1.0f,1.0f,1.0f);
+            ws.scaleThreads[i] = NULL;
          }
    }
    else
    {
-      smNodeCurrentArbitraryScales.setSize(mShape->nodes.size());
+      ws.currentArbitraryScales.setSize(mShape->nodes.size());
       for (S32 i=a; i<b; i++)
          if (scaleBeenSet.test(i))
          {
-            smNodeCurrentArbitraryScales[i].identity();
-            smScaleThreads[i] = NULL;
+            ws.currentArbitraryScales[i].identity();
+            ws.scaleThreads[i] = NULL;
          }
    }
 
@@ -290,6 +332,8 @@ void TSShapeInstance::handleDefaultScale(S32 a, S32 b, TSIntegerSet & scaleBeenS
 
 void TSShapeInstance::updateTransitionNodeTransforms(TSIntegerSet& transitionNodes)
 {
+   NodeWorkspace& ws = getNodeWorkspace();
+
    // handle transitions
    transitionNodes.clearAll();
    transitionNodes.overlap(mTransitionRotationNodes);
@@ -301,19 +345,19 @@ void TSShapeInstance::updateTransitionNodeTransforms(TSIntegerSet& transitionNod
    // for blended or scale-animated nodes, as all others are already up to date
    for (S32 i=transitionNodes.start(); i<MAX_TS_SET_SIZE; transitionNodes.next(i))
    {
-      if (smNodeLocalTransformDirty.test(i))
+      if (ws.localTransformDirty.test(i))
       {
          if (scaleCurrentlyAnimated())
          {
             // @todo:No support for scale yet => need to do proper affine decomposition here
-            smNodeCurrentTranslations[i] = smNodeLocalTransforms[i].getPosition();
-            smNodeCurrentRotations[i].set(smNodeLocalTransforms[i]);
+            ws.currentTranslations[i] = ws.localTransforms[i].getPosition();
+            ws.currentRotations[i].set(ws.localTransforms[i]);
          }
          else
          {
             // Scale is identity => can do a cheap decomposition
-            smNodeCurrentTranslations[i] = smNodeLocalTransforms[i].getPosition();
-            smNodeCurrentRotations[i].set(smNodeLocalTransforms[i]);
+            ws.currentTranslations[i] = ws.localTransforms[i].getPosition();
+            ws.currentRotations[i].set(ws.localTransforms[i]);
          }
       }
    }
@@ -321,6 +365,8 @@ void TSShapeInstance::updateTransitionNodeTransforms(TSIntegerSet& transitionNod
 
 void TSShapeInstance::handleTransitionNodes(S32 a, S32 b)
 {
+   NodeWorkspace& ws = getNodeWorkspace();
+
    TSIntegerSet transitionNodes;
    updateTransitionNodeTransforms(transitionNodes);
 
@@ -331,7 +377,7 @@ void TSShapeInstance::handleTransitionNodes(S32 a, S32 b)
    {
       if (nodeIndex<a)
          continue;
-      TSThread * thread = smRotationThreads[nodeIndex];
+      TSThread * thread = ws.rotationThreads[nodeIndex];
       thread = thread && thread->transitionData.inTransition ? thread : NULL;
       if (!thread)
       {
@@ -349,7 +395,7 @@ void TSShapeInstance::handleTransitionNodes(S32 a, S32 b)
          AssertFatal(thread!=NULL,"TSShapeInstance::handleRotTransitionNodes (rotation)");
       }
       QuatF tmpQ;
-      TSTransform::interpolate(mNodeReferenceRotations[nodeIndex].getQuatF(&tmpQ),smNodeCurrentRotations[nodeIndex],thread->transitionData.pos,&smNodeCurrentRotations[nodeIndex]);
+      TSTransform::interpolate(mNodeReferenceRotations[nodeIndex].getQuatF(&tmpQ),ws.currentRotations[nodeIndex],thread->transitionData.pos,&ws.currentRotations[nodeIndex]);
    }
 
    // then translation
@@ -357,7 +403,7 @@ void TSShapeInstance::handleTransitionNodes(S32 a, S32 b)
    end   = b;
    for (nodeIndex=start; nodeIndex<end; mTransitionTranslationNodes.next(nodeIndex))
    {
-      TSThread * thread = smTranslationThreads[nodeIndex];
+      TSThread * thread = ws.translationThreads[nodeIndex];
       thread = thread && thread->transitionData.inTransition ? thread : NULL;
       if (!thread)
       {
@@ -374,7 +420,7 @@ void TSShapeInstance::handleTransitionNodes(S32 a, S32 b)
          }
          AssertFatal(thread!=NULL,"TSShapeInstance::handleTransitionNodes (translation).");
       }
-      Point3F & p = smNodeCurrentTranslations[nodeIndex];
+      Point3F & p = ws.currentTranslations[nodeIndex];
       Point3F & p1 = mNodeReferenceTranslations[nodeIndex];
       Point3F & p2 = p;
       F32 k = thread->transitionData.pos;
@@ -390,7 +436,7 @@ void TSShapeInstance::handleTransitionNodes(S32 a, S32 b)
       end   = b;
       for (nodeIndex=start; nodeIndex<end; mTransitionScaleNodes.next(nodeIndex))
       {
-         TSThread * thread = smScaleThreads[nodeIndex];
+         TSThread * thread = ws.scaleThreads[nodeIndex];
          thread = thread && thread->transitionData.inTransition ? thread : NULL;
          if (!thread)
          {
@@ -408,14 +454,14 @@ void TSShapeInstance::handleTransitionNodes(S32 a, S32 b)
             AssertFatal(thread!=NULL,"TSShapeInstance::handleTransitionNodes (scale).");
          }
          if (animatesUniformScale())
-            smNodeCurrentUniformScales[nodeIndex] += thread->transitionData.pos * (mNodeReferenceUniformScales[nodeIndex]-smNodeCurrentUniformScales[nodeIndex]);
+            ws.currentUniformScales[nodeIndex] += thread->transitionData.pos * (mNodeReferenceUniformScales[nodeIndex]-ws.currentUniformScales[nodeIndex]);
          else if (animatesAlignedScale())
-            TSTransform::interpolate(mNodeReferenceScaleFactors[nodeIndex],smNodeCurrentAlignedScales[nodeIndex],thread->transitionData.pos,&smNodeCurrentAlignedScales[nodeIndex]);
+            TSTransform::interpolate(mNodeReferenceScaleFactors[nodeIndex],ws.currentAlignedScales[nodeIndex],thread->transitionData.pos,&ws.currentAlignedScales[nodeIndex]);
          else
          {
             QuatF q;
-            TSTransform::interpolate(mNodeReferenceScaleFactors[nodeIndex],smNodeCurrentArbitraryScales[nodeIndex].mScale,thread->transitionData.pos,&smNodeCurrentArbitraryScales[nodeIndex].mScale);
-            TSTransform::interpolate(mNodeReferenceArbitraryScaleRots[nodeIndex].getQuatF(&q),smNodeCurrentArbitraryScales[nodeIndex].mRotate,thread->transitionData.pos,&smNodeCurrentArbitraryScales[nodeIndex].mRotate);
+            TSTransform::interpolate(mNodeReferenceScaleFactors[nodeIndex],ws.currentArbitraryScales[nodeIndex].mScale,thread->transitionData.pos,&ws.currentArbitraryScales[nodeIndex].mScale);
+            TSTransform::interpolate(mNodeReferenceArbitraryScaleRots[nodeIndex].getQuatF(&q),ws.currentArbitraryScales[nodeIndex].mRotate,thread->transitionData.pos,&ws.currentArbitraryScales[nodeIndex].mRotate);
          }
       }
    }
@@ -425,47 +471,51 @@ void TSShapeInstance::handleTransitionNodes(S32 a, S32 b)
    end   = b;
    for (nodeIndex=start; nodeIndex<end; transitionNodes.next(nodeIndex))
    {
-      TSTransform::setMatrix(smNodeCurrentRotations[nodeIndex], smNodeCurrentTranslations[nodeIndex], &smNodeLocalTransforms[nodeIndex]);
+      TSTransform::setMatrix(ws.currentRotations[nodeIndex], ws.currentTranslations[nodeIndex], &ws.localTransforms[nodeIndex]);
       if (scaleCurrentlyAnimated())
       {
          if (animatesUniformScale())
-            TSTransform::applyScale(smNodeCurrentUniformScales[nodeIndex],&smNodeLocalTransforms[nodeIndex]);
+            TSTransform::applyScale(ws.currentUniformScales[nodeIndex],&ws.localTransforms[nodeIndex]);
          else if (animatesAlignedScale())
-               TSTransform::applyScale(smNodeCurrentAlignedScales[nodeIndex],&smNodeLocalTransforms[nodeIndex]);
+               TSTransform::applyScale(ws.currentAlignedScales[nodeIndex],&ws.localTransforms[nodeIndex]);
          else
-            TSTransform::applyScale(smNodeCurrentArbitraryScales[nodeIndex],&smNodeLocalTransforms[nodeIndex]);
+            TSTransform::applyScale(ws.currentArbitraryScales[nodeIndex],&ws.localTransforms[nodeIndex]);
       }
    }
 }
 
 void TSShapeInstance::handleNodeScale(S32 a, S32 b)
 {
+   NodeWorkspace& ws = getNodeWorkspace();
+
    if (animatesUniformScale())
    {
       for (S32 i=a; i<b; i++)
          if (!mHandsOffNodes.test(i))
-            TSTransform::applyScale(smNodeCurrentUniformScales[i],&smNodeLocalTransforms[i]);
+            TSTransform::applyScale(ws.currentUniformScales[i],&ws.localTransforms[i]);
    }
    else if (animatesAlignedScale())
    {
       for (S32 i=a; i<b; i++)
          if (!mHandsOffNodes.test(i))
-            TSTransform::applyScale(smNodeCurrentAlignedScales[i],&smNodeLocalTransforms[i]);
+            TSTransform::applyScale(ws.currentAlignedScales[i],&ws.localTransforms[i]);
    }
    else
    {
       for (S32 i=a; i<b; i++)
          if (!mHandsOffNodes.test(i))
-            TSTransform::applyScale(smNodeCurrentArbitraryScales[i],&smNodeLocalTransforms[i]);
+            TSTransform::applyScale(ws.currentArbitraryScales[i],&ws.localTransforms[i]);
    }
 
    TSIntegerSet scaledNodes;
    scaledNodes.difference(mHandsOffNodes);
-   smNodeLocalTransformDirty.overlap(scaledNodes);
+   ws.localTransformDirty.overlap(scaledNodes);
 }
 
 void TSShapeInstance::handleAnimatedScale(TSThread * thread, S32 a, S32 b, TSIntegerSet & scaleBeenSet)
 {
+   NodeWorkspace& ws = getNodeWorkspace();
+
    S32 j=0;
    S32 start = thread->getSequence()->scaleMatters.start();
    S32 end   = b;
@@ -529,28 +579,28 @@ void TSShapeInstance::handleAnimatedScale(TSThread * thread, S32 a, S32 b, TSInt
          {
             case 0:  // uniform -> uniform
             {
-               smNodeCurrentUniformScales[nodeIndex] = uniformScale;
+               ws.currentUniformScales[nodeIndex] = uniformScale;
                break;
             }
             case 4:  // uniform -> aligned
             case 5:  // aligned -> aligned
-               smNodeCurrentAlignedScales[nodeIndex] = alignedScale;
+               ws.currentAlignedScales[nodeIndex] = alignedScale;
                break;
             case 8:  // uniform -> arbitrary
             case 9:  // aligned -> arbitrary
             {
-               smNodeCurrentArbitraryScales[nodeIndex].identity();
-               smNodeCurrentArbitraryScales[nodeIndex].mScale = alignedScale;
+               ws.currentArbitraryScales[nodeIndex].identity();
+               ws.currentArbitraryScales[nodeIndex].mScale = alignedScale;
                break;
             }
             case 10: // arbitrary -> arbitary
             {
-               smNodeCurrentArbitraryScales[nodeIndex] = arbitraryScale;
+               ws.currentArbitraryScales[nodeIndex] = arbitraryScale;
                break;
             }
             default: AssertFatal(0,"TSShapeInstance::handleAnimatedScale"); break;
          }
-         smScaleThreads[nodeIndex] = thread;
+         ws.scaleThreads[nodeIndex] = thread;
          scaleBeenSet.set(nodeIndex);
       }
    }
@@ -558,23 +608,27 @@ void TSShapeInstance::handleAnimatedScale(TSThread * thread, S32 a, S32 b, TSInt
 
 void TSShapeInstance::handleMaskedPositionNode(TSThread * th, S32 nodeIndex, S32 offset)
 {
+   NodeWorkspace& ws = getNodeWorkspace();
+
    const Point3F & p1 = mShape->getTranslation(*th->getSequence(),th->keyNum1,offset);
    const Point3F & p2 = mShape->getTranslation(*th->getSequence(),th->keyNum2,offset);
    Point3F p;
    TSTransform::interpolate(p1,p2,th->keyPos,&p);
 
    if (!mMaskPosXNodes.test(nodeIndex))
-      smNodeCurrentTranslations[nodeIndex].x = p.x;
+      ws.currentTranslations[nodeIndex].x = p.x;
 
    if (!mMaskPosYNodes.test(nodeIndex))
-      smNodeCurrentTranslations[nodeIndex].y = p.y;
+      ws.currentTranslations[nodeIndex].y = p.y;
 
    if (!mMaskPosZNodes.test(nodeIndex))
-      smNodeCurrentTranslations[nodeIndex].z = p.z;
+      ws.currentTranslations[nodeIndex].z = p.z;
 }
 
 void TSShapeInstance::handleBlendSequence(TSThread * thread, S32 a, S32 b)
 {
+   NodeWorkspace& ws = getNodeWorkspace();
+
    S32 jrot=0;
    S32 jtrans=0;
    S32 jscale=0;
@@ -653,8 +707,8 @@ void TSShapeInstance::handleBlendSequence(TSThread * thread, S32 a, S32 b)
       }
 
       // apply blend transform
-      smNodeLocalTransforms[nodeIndex].mul(mat);
-      smNodeLocalTransformDirty.set(nodeIndex);
+      ws.localTransforms[nodeIndex].mul(mat);
+      ws.localTransformDirty.set(nodeIndex);
    }
 }
 
@@ -865,8 +919,9 @@ void TSShapeInstance::animate(S32 dl)
       sortThreads();
 
    // animate nodes?
-   if (dirtyFlags & TransformDirty)
-      animateNodes(ss);
+   U32 keepDirty = 0;
+   if ((dirtyFlags & TransformDirty) && !_animateNodesLOD(dl,ss))
+      keepDirty = TransformDirty;
 
    // animate objects?
    if (dirtyFlags & VisDirty)
@@ -878,7 +933,100 @@ void TSShapeInstance::animate(S32 dl)
    if (dirtyFlags & MatFrameDirty)
       animateMatFrame(ss);
 
-   mDirtyFlags[ss] = 0;
+   mDirtyFlags[ss] = keepDirty;
+}
+
+bool TSShapeInstance::_animateNodesLOD(S32 dl, S32 ss)
+{
+   mAnimLODHeld = false;
+
+   // Details too small to see the shape move keep the pose (and skin)
+   // they were last shown with.
+   const F32 detailSize = mShape->details[dl].size;
+   if (detailSize >= 0.0f && detailSize < smAnimLODFreezeDetailSize && mAnimLODLastSubShape == ss)
+   {
+      mAnimLODHeld = true;
+      mAnimLODInterpolating = false;
+      dFetchAndAdd(smAnimLODStats.frozen, 1);
+      return true;
+   }
+
+   // Small shapes are evaluated less often.
+   U32 interval = 0;
+   if (mAnimLODPixelSize < smAnimLODPixelSize)
+      interval = U32(smAnimLODMaxInterval * (1.0f - mAnimLODPixelSize / smAnimLODPixelSize));
+
+   const U32 now = Sim::getCurrentTime();
+   if (interval && mAnimLODLastSubShape == ss && now - mAnimLODLastTime < interval)
+   {
+      if (mAnimLODInterpolating)
+         _interpolateNodesLOD(ss, F32(now - mAnimLODLastTime) / F32(interval));
+      else
+         mAnimLODHeld = true;
+
+      dFetchAndAdd(smAnimLODStats.throttled, 1);
+      return false;
+   }
+
+   // Blending matrices only works without scale.
+   const bool interpolate = interval && smAnimLODInterpolate && !animatesScale() &&
+                            mAnimLODLastSubShape == ss;
+   if (interpolate)
+      mAnimLODFromTransforms = mNodeTransforms;
+
+   mAnimLODSkipLeaves = mAnimLODPixelSize < smAnimLODLeafPixelSize;
+   animateNodes(ss);
+   mAnimLODSkipLeaves = false;
+
+   mAnimLODLastTime = now;
+   mAnimLODLastSubShape = ss;
+   mAnimLODInterpolating = interpolate;
+
+   // Start out from the pose shown so far and blend towards the new one.
+   if (interpolate)
+   {
+      mAnimLODToTransforms = mNodeTransforms;
+      _interpolateNodesLOD(ss, 0.0f);
+   }
+
+   dFetchAndAdd(smAnimLODStats.animated, 1);
+   dFetchAndAdd(smAnimLODStats.nodes, mShape->subShapeNumNodes[ss]);
+   return true;
+}
+
+void TSShapeInstance::_interpolateNodesLOD(S32 ss, F32 t)
+{
+   PROFILE_SCOPE( TSShapeInstance_interpolateNodesLOD );
+
+   t = mClampF(t, 0.0f, 1.0f);
+
+   S32 a = mShape->subShapeFirstNode[ss];
+   S32 b = a + mShape->subShapeNumNodes[ss];
+   if (a >= b)
+      return;
+
+   // blend the rotations of the whole subshape in one batch
+   NodeWorkspace& ws = getNodeWorkspace();
+   ws.sampledRotations.setSize(b - a);
+   ws.currentRotations.setSize(b - a);
+   for (S32 i=a; i<b; i++)
+   {
+      ws.sampledRotations[i-a].set(mAnimLODFromTransforms[i]);
+      ws.currentRotations[i-a].set(mAnimLODToTransforms[i]);
+   }
+   m_quatF_interpolate_bulk(&ws.sampledRotations[0].x, &ws.currentRotations[0].x, t, b - a, &ws.sampledRotations[0].x);
+
+   for (S32 i=a; i<b; i++)
+   {
+      // hands off nodes are owned by someone else
+      if (mHandsOffNodes.test(i))
+         continue;
+
+      Point3F p;
+      TSTransform::interpolate(mAnimLODFromTransforms[i].getPosition(),mAnimLODToTransforms[i].getPosition(),t,&p);
+
+      TSTransform::setMatrix(ws.sampledRotations[i-a],p,&mNodeTransforms[i]);
+   }
 }
 
 void TSShapeInstance::animateNodeSubtrees(bool forceFull)
@@ -917,6 +1065,81 @@ void TSShapeInstance::animateSubtrees(bool forceFull)
    }
 }
 
+//-------------------------------------------------------------------------------------
+// Batched animation
+//-------------------------------------------------------------------------------------
+
+struct QueuedAnimate
+{
+   TSShapeInstance* instance;
+   S32 dl;
+};
+
+/// Instances waiting for animateQueued().  Only touched on the main thread.
+static Vector<QueuedAnimate> sgAnimateQueue( __FILE__, __LINE__ );
+
+void TSShapeInstance::queueAnimate(S32 dl)
+{
+   if (dl==-1 || mAnimateQueued)
+      return;
+
+   S32 ss = mShape->details[dl].subShapeNum;
+   if (ss<0 || !mDirtyFlags[ss])
+      // billboard detail or nothing changed since last animate
+      return;
+
+   if (mNodeCallbacks.size())
+   {
+      animate(dl);
+      return;
+   }
+
+   QueuedAnimate entry;
+   entry.instance = this;
+   entry.dl = dl;
+   sgAnimateQueue.push_back(entry);
+
+   mAnimateQueued = true;
+}
+
+void TSShapeInstance::_removeFromAnimateQueue()
+{
+   for (S32 i=0; i<sgAnimateQueue.size(); i++)
+   {
+      if (sgAnimateQueue[i].instance == this)
+      {
+         sgAnimateQueue.erase_fast(i);
+         break;
+      }
+   }
+   mAnimateQueued = false;
+}
+
+void TSShapeInstance::_animateQueuedJob( void* data, U32 start, U32 end )
+{
+   QueuedAnimate* queue = reinterpret_cast< QueuedAnimate* >( data );
+   for (U32 i=start; i<end; i++)
+      queue[i].instance->animate(queue[i].dl);
+}
+
+void TSShapeInstance::animateQueued()
+{
+   if (sgAnimateQueue.empty())
+      return;
+
+   PROFILE_SCOPE( TSShapeInstance_animateQueued );
+
+   const U32 count = sgAnimateQueue.size();
+   if (smParallelAnimate && count >= smParallelAnimateMinInstances)
+      JobSystem::GLOBAL().parallelFor(count, 4, &_animateQueuedJob, sgAnimateQueue.address());
+   else
+      _animateQueuedJob(sgAnimateQueue.address(), 0, count);
+
+   for (U32 i=0; i<count; i++)
+      sgAnimateQueue[i].instance->mAnimateQueued = false;
+   sgAnimateQueue.clear();
+}
+
 void TSShapeInstance::addPath(TSThread *gt, F32 start, F32 end, MatrixF *mat)
 {
    // never get here while in transition...
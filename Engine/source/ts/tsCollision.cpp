@@ -33,6 +33,8 @@
 #include "collision/concretePolyList.h"
 #include "collision/vertexPolyList.h"
 #include "platform/profiler.h"
+#include "platform/threads/mutex.h"
+#include "platform/threads/threadPool.h"
 
 #include "opcode/Opcode.h"
 #include "opcode/Ice/IceAABB.h"
@@ -42,6 +44,97 @@
 
 static bool gOpcodeInitialized = false;
 
+/// Guards building OPCODE trees, which happens on worker threads as well as
+/// on demand from queries.
+static Mutex sgOpcodeBuildMutex;
+
+S32 TSMesh::smNumOpcodeTrees = 0;
+S32 TSMesh::smOpcodeTreeBytes = 0;
+bool TSShape::smBuildCollisionAsync = true;
+
+//-----------------------------------------------------------------------------
+
+/// Builds the OPCODE trees of all meshes of a shape on a worker thread.
+class TSShapeCollisionBuild : public ThreadPool::WorkItem
+{
+public:
+
+   TSShapeCollisionBuild( TSShape *shape ) : mShape( shape ) {}
+
+   /// Stop the build, waiting for it to finish if it is running.
+   void detach()
+   {
+      MutexHandle lock;
+      lock.lock( &mMutex, true );
+      mShape = NULL;
+   }
+
+protected:
+
+   Mutex mMutex;
+   TSShape *mShape;
+
+   virtual void execute()
+   {
+      PROFILE_SCOPE( TSShapeCollisionBuild_execute );
+
+      MutexHandle lock;
+      lock.lock( &mMutex, true );
+
+      if ( !mShape )
+         return;
+
+      for ( S32 i = 0; i < mShape->meshes.size(); i++ )
+      {
+         if ( mShape->meshes[i] )
+            mShape->meshes[i]->prepOpcodeCollision();
+      }
+   }
+};
+
+void TSShape::prepCollision()
+{
+   if ( mCollisionBuild )
+      return;
+
+   if ( !smBuildCollisionAsync )
+   {
+      for ( S32 i = 0; i < meshes.size(); i++ )
+      {
+         if ( meshes[i] )
+            meshes[i]->prepOpcodeCollision();
+      }
+      return;
+   }
+
+   mCollisionBuild = new TSShapeCollisionBuild( this );
+   mCollisionBuild->addRef();
+   ThreadPool::GLOBAL().queueWorkItem( mCollisionBuild );
+}
+
+void TSShape::_stopCollisionBuild()
+{
+   if ( !mCollisionBuild )
+      return;
+
+   mCollisionBuild->detach();
+   mCollisionBuild->release();
+   mCollisionBuild = NULL;
+}
+
+U32 TSShape::getCollisionMemoryUsage() const
+{
+   U32 bytes = 0;
+   for ( S32 i = 0; i < meshes.size(); i++ )
+   {
+      if ( meshes[i] )
+         bytes += meshes[i]->getOpcodeMemoryUsage();
+   }
+   return bytes;
+}
+
+//-----------------------------------------------------------------------------
+
 //-------------------------------------------------------------------------------------
 // Collision methods
 //-------------------------------------------------------------------------------------
@@ -1183,6 +1276,8 @@ bool TSMesh::buildPolyListOpcode( const S32 od, AbstractPolyList *polyList, cons
 {
    PROFILE_SCOPE( TSMesh_buildPolyListOpcode );
 
+   prepOpcodeCollision();
+
    // This is small... there is no win for preallocating it.
    Opcode::AABBCollider opCollider;
    opCollider.SetPrimitiveTests( true );
@@ -1240,6 +1335,8 @@ bool TSMesh::buildConvexOpcode( const MatrixF &meshToObjectMat, const Box3F &nod
 {
    PROFILE_SCOPE( TSMesh_buildConvexOpcode );
 
+   prepOpcodeCollision();
+
    // This is small... there is no win for preallocating it.
    Opcode::AABBCollider opCollider;
    opCollider.SetPrimitiveTests( true );
@@ -1344,8 +1441,31 @@ bool TSMesh::buildConvexOpcode( const MatrixF &meshToObjectMat, const Box3F &nod
    return true;
 }
 
+U32 TSMesh::getOpcodeMemoryUsage() const
+{
+   if ( !mOptTree )
+      return 0;
+
+   return mOptTree->GetUsedBytes() +
+      mOpMeshInterface->GetNbTriangles() * sizeof( IceMaths::IndexedTriangle ) +
+      mOpMeshInterface->GetNbVertices() * sizeof( IceMaths::Point );
+}
+
 void TSMesh::prepOpcodeCollision()
 {
+   // Don't re init if we already have something...
+   if ( mOptTree )
+      return;
+
+   PROFILE_SCOPE( TSMesh_prepOpcodeCollision );
+
+   MutexHandle lock;
+   lock.lock( &sgOpcodeBuildMutex, true );
+
+   // Built by another thread while we waited
+   if ( mOptTree )
+      return;
+
    // Make sure opcode is loaded!
    if( !gOpcodeInitialized )
    {
@@ -1353,10 +1473,6 @@ void TSMesh::prepOpcodeCollision()
       gOpcodeInitialized = true;
    }
 
-   // Don't re init if we already have something...
-   if ( mOptTree )
-      return;
-
    // Ok, first set up a MeshInterface
    Opcode::MeshInterface *mi = new Opcode::MeshInterface();
    mOpMeshInterface = mi;
@@ -1474,7 +1590,7 @@ void TSMesh::prepOpcodeCollision()
    mi->SetPointers( its, pts );
 
    // Ok, we've got a mesh interface populated, now let's build a thingy to collide against.
-   mOptTree = new Opcode::Model();
+   Opcode::Model *tree = new Opcode::Model();
 
    Opcode::OPCODECREATE opcc;
 
@@ -1485,7 +1601,13 @@ void TSMesh::prepOpcodeCollision()
    opcc.mQuantized = false;
    opcc.mSettings.mLimit = 1;
 
-   mOptTree->Build( opcc );
+   tree->Build( opcc );
+
+   // Publish the tree only once it is complete, queries check it unlocked
+   mOptTree = tree;
+
+   dFetchAndAdd( smNumOpcodeTrees, 1 );
+   dFetchAndAdd( smOpcodeTreeBytes, (S32)getOpcodeMemoryUsage() );
 }
 
 static Point3F	texGenAxis[18] =
@@ -1501,6 +1623,8 @@ static Point3F	texGenAxis[18] =
 
 bool TSMesh::castRayOpcode( const Point3F &s, const Point3F &e, RayInfo *info, TSMaterialList *materials )
 {
+   prepOpcodeCollision();
+
    Opcode::RayCollider ray;
    Opcode::CollisionFaces cfs;
 
@@ -0,0 +1,382 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "ts/tsImposterAtlas.h"
+
+#include "ts/tsLastDetail.h"
+#include "gfx/gfxTextureManager.h"
+#include "gfx/bitmap/ddsFile.h"
+#include "gfx/bitmap/imageUtils.h"
+#include "materials/materialDefinition.h"
+#include "materials/baseMatInstance.h"
+#include "core/util/safeDelete.h"
+#include "platform/profiler.h"
+
+
+struct TSImposterAtlas::Page
+{
+   TSImposterAtlas *atlas;
+
+   /// The page contents with all the kept mips.
+   DDSFile *diffuse;
+   DDSFile *normal;
+
+   GFXTexHandle diffuseTex;
+   GFXTexHandle normalTex;
+
+   /// The names the textures are cached under, which
+   /// the material loads its maps by.
+   String diffuseName;
+   String normalName;
+
+   SimObjectPtr<Material> material;
+   BaseMatInstance *matInst;
+
+   /// True for the slots in use.
+   Vector<bool> used;
+   U32 usedCount;
+
+   /// True if the contents changed since the last upload.
+   bool dirty;
+
+   Page()
+      :  atlas( NULL ),
+         diffuse( NULL ),
+         normal( NULL ),
+         matInst( NULL ),
+         usedCount( 0 ),
+         dirty( false )
+   {
+   }
+
+   ~Page()
+   {
+      SAFE_DELETE( matInst );
+      if ( material )
+         material->deleteObject();
+
+      diffuseTex = NULL;
+      normalTex = NULL;
+      SAFE_DELETE( diffuse );
+      SAFE_DELETE( normal );
+   }
+};
+
+
+Vector<TSImposterAtlas*> TSImposterAtlas::smAtlases;
+
+
+bool TSImposterAtlas::Layout::operator ==( const Layout &layout ) const
+{
+   return   width == layout.width &&
+            height == layout.height &&
+            mipLevels == layout.mipLevels &&
+            dim == layout.dim &&
+            pageSize == layout.pageSize &&
+            diffuseFormat == layout.diffuseFormat &&
+            normalFormat == layout.normalFormat &&
+            limits == layout.limits;
+}
+
+TSImposterAtlas::TSImposterAtlas( const Layout &layout )
+   : mLayout( layout )
+{
+   mSlotsX = getMax( layout.pageSize / layout.width, (U32)1 );
+   mSlotsY = getMax( layout.pageSize / layout.height, (U32)1 );
+   mPageWidth = mSlotsX * layout.width;
+   mPageHeight = mSlotsY * layout.height;
+
+   // Keep the mips in which a slot is still made of whole
+   // blocks, the smaller ones would mix neighbouring slots.
+   const bool compressed = ImageUtil::isCompressedFormat( layout.diffuseFormat ) ||
+                           ImageUtil::isCompressedFormat( layout.normalFormat );
+   const U32 blockDim = compressed ? 4 : 1;
+
+   mPageMips = 0;
+   while (  mPageMips < layout.mipLevels &&
+            ( layout.width >> mPageMips ) >= blockDim &&
+            ( layout.height >> mPageMips ) >= blockDim )
+      mPageMips++;
+}
+
+TSImposterAtlas::~TSImposterAtlas()
+{
+   for ( U32 i=0; i < mPages.size(); i++ )
+      delete mPages[i];
+}
+
+bool TSImposterAtlas::_canAdd( const DDSFile *diffuse, const DDSFile *normal ) const
+{
+   if ( mPageMips == 0 )
+      return false;
+
+   const DDSFile *sheets[2] = { diffuse, normal };
+   for ( U32 i=0; i < 2; i++ )
+   {
+      const DDSFile *sheet = sheets[i];
+      if (  sheet->isCubemap() ||
+            sheet->mSurfaces.size() != 1 ||
+            sheet->getWidth() != mLayout.width ||
+            sheet->getHeight() != mLayout.height ||
+            sheet->getMipLevels() != mLayout.mipLevels ||
+            sheet->mSurfaces[0]->mMips.size() < mPageMips )
+         return false;
+   }
+
+   return   diffuse->getFormat() == mLayout.diffuseFormat &&
+            normal->getFormat() == mLayout.normalFormat;
+}
+
+TSImposterAtlas::Page* TSImposterAtlas::add(  const Layout &layout, 
+                                             const DDSFile *diffuse, 
+                                             const DDSFile *normal, 
+                                             U32 *outSlot, 
+                                             Point4F *outRect )
+{
+   if ( !isPow2( layout.width ) || !isPow2( layout.height ) )
+      return NULL;
+
+   PROFILE_SCOPE( TSImposterAtlas_add );
+
+   TSImposterAtlas *atlas = NULL;
+   for ( U32 i=0; i < smAtlases.size() && !atlas; i++ )
+   {
+      if ( smAtlases[i]->mLayout == layout )
+         atlas = smAtlases[i];
+   }
+
+   if ( !atlas )
+   {
+      atlas = new TSImposterAtlas( layout );
+      if ( !atlas->_canAdd( diffuse, normal ) )
+      {
+         delete atlas;
+         return NULL;
+      }
+
+      if ( smAtlases.empty() )
+         GFXDevice::getDeviceEventSignal().notify( &TSImposterAtlas::_onDeviceEvent );
+
+      smAtlases.push_back( atlas );
+   }
+   else if ( !atlas->_canAdd( diffuse, normal ) )
+      return NULL;
+
+   // Find a page with a free slot.
+   Page *page = NULL;
+   for ( U32 i=0; i < atlas->mPages.size() && !page; i++ )
+   {
+      if ( atlas->mPages[i]->usedCount < atlas->mPages[i]->used.size() )
+         page = atlas->mPages[i];
+   }
+
+   if ( !page )
+   {
+      page = atlas->_createPage( diffuse, normal );
+      atlas->mPages.push_back( page );
+   }
+
+   U32 slot = 0;
+   while ( page->used[slot] )
+      slot++;
+
+   page->used[slot] = true;
+   page->usedCount++;
+
+   atlas->_copyToPage( page->diffuse, diffuse, slot );
+   atlas->_copyToPage( page->normal, normal, slot );
+
+   // New pages are uploaded right away, so the material
+   // finds the textures.  Others wait for the next frame.
+   if ( page->diffuseTex.isNull() )
+   {
+      page->diffuseTex.set( page->diffuse, &GFXStaticTextureSRGBProfile, false, avar( "%s() - page (line %d)", __FUNCTION__, __LINE__ ) );
+      page->normalTex.set( page->normal, &GFXNormalMapProfile, false, avar( "%s() - page (line %d)", __FUNCTION__, __LINE__ ) );
+
+      Vector<RectF> imposterUVs;
+      TSLastDetail::getSheetUVs( layout.width, layout.height, layout.dim, &imposterUVs );
+
+      page->material = TSLastDetail::createMaterial( page->diffuseName, page->normalName, layout.limits, imposterUVs );
+      page->matInst = TSLastDetail::createMatInstance( page->material, getGFXVertexFormat<ImposterState>() );
+   }
+   else
+      page->dirty = true;
+
+   const U32 x = ( slot % atlas->mSlotsX ) * layout.width;
+   const U32 y = ( slot / atlas->mSlotsX ) * layout.height;
+
+   outRect->set(  (F32)x / (F32)atlas->mPageWidth, 
+                  (F32)y / (F32)atlas->mPageHeight,
+                  (F32)layout.width / (F32)atlas->mPageWidth,
+                  (F32)layout.height / (F32)atlas->mPageHeight );
+   *outSlot = slot;
+
+   return page;
+}
+
+void TSImposterAtlas::remove( Page *page, U32 slot )
+{
+   AssertFatal( page->used[slot], "TSImposterAtlas::remove - The slot is not in use!" );
+
+   page->used[slot] = false;
+   page->usedCount--;
+   if ( page->usedCount > 0 )
+      return;
+
+   TSImposterAtlas *atlas = page->atlas;
+   atlas->mPages.remove( page );
+   delete page;
+
+   if ( !atlas->mPages.empty() )
+      return;
+
+   smAtlases.remove( atlas );
+   delete atlas;
+
+   if ( smAtlases.empty() )
+      GFXDevice::getDeviceEventSignal().remove( &TSImposterAtlas::_onDeviceEvent );
+}
+
+BaseMatInstance* TSImposterAtlas::getMatInstance( const Page *page )
+{
+   return page->matInst;
+}
+
+TSImposterAtlas::Page* TSImposterAtlas::_createPage( const DDSFile *diffuse, const DDSFile *normal )
+{
+   static U32 sPageId = 0;
+
+   Page *page = new Page;
+   page->atlas = this;
+   page->diffuse = _createPageDDS( diffuse );
+   page->normal = _createPageDDS( normal );
+   page->used.setSize( mSlotsX * mSlotsY );
+   for ( U32 i=0; i < page->used.size(); i++ )
+      page->used[i] = false;
+
+   // The cache strings are what GFXTextureManager looks textures
+   // up by, so the material gets the page textures by these names.
+   page->diffuseName = String::ToString( "imposterAtlas/page%d", sPageId );
+   page->normalName = String::ToString( "imposterAtlas/page%d_normals", sPageId );
+   page->diffuse->mCacheString = page->diffuseName;
+   page->normal->mCacheString = page->normalName;
+   sPageId++;
+
+   return page;
+}
+
+DDSFile* TSImposterAtlas::_createPageDDS( const DDSFile *sheet ) const
+{
+   DDSFile *dds = new DDSFile;
+   dds->mFlags = sheet->mFlags;
+   dds->mWidth = mPageWidth;
+   dds->mHeight = mPageHeight;
+   dds->mDepth = sheet->mDepth;
+   dds->mFormat = sheet->mFormat;
+   dds->mBytesPerPixel = sheet->mBytesPerPixel;
+   dds->mFourCC = sheet->mFourCC;
+   dds->mHasTransparency = true;
+   dds->mMipMapCount = mPageMips;
+
+   if ( mPageMips > 1 )
+      dds->mFlags.set( DDSFile::MipMapsFlag );
+   else
+      dds->mFlags.clear( DDSFile::MipMapsFlag );
+
+   dds->mPitchOrLinearSize = dds->getSurfaceSize( 0 );
+
+   // Empty slots are cleared to transparent.
+   dds->mSurfaces.push_back( new DDSFile::SurfaceData() );
+   for ( U32 mip=0; mip < mPageMips; mip++ )
+   {
+      const U32 mipSize = dds->getSurfaceSize( mip );
+      U8 *bits = new U8[mipSize];
+      dMemset( bits, 0, mipSize );
+      dds->mSurfaces.last()->mMips.push_back( bits );
+   }
+
+   return dds;
+}
+
+void TSImposterAtlas::_copyToPage( DDSFile *page, const DDSFile *sheet, U32 slot ) const
+{
+   const U32 x = ( slot % mSlotsX ) * mLayout.width;
+   const U32 y = ( slot / mSlotsX ) * mLayout.height;
+
+   // Compressed formats are copied a row of 4x4 blocks at a time.
+   const U32 blockDim = ImageUtil::isCompressedFormat( sheet->getFormat() ) ? 4 : 1;
+
+   for ( U32 mip=0; mip < mPageMips; mip++ )
+   {
+      const U32 srcPitch = sheet->getSurfacePitch( mip );
+      const U32 dstPitch = page->getSurfacePitch( mip );
+      const U32 blockBytes = srcPitch / ( sheet->getWidth( mip ) / blockDim );
+      const U32 rows = sheet->getHeight( mip ) / blockDim;
+
+      const U8 *src = sheet->mSurfaces[0]->mMips[mip];
+      U8 *dst = page->mSurfaces[0]->mMips[mip] + 
+                  ( ( y >> mip ) / blockDim ) * dstPitch + 
+                  ( ( x >> mip ) / blockDim ) * blockBytes;
+
+      for ( U32 row=0; row < rows; row++ )
+         dMemcpy( dst + row * dstPitch, src + row * srcPitch, srcPitch );
+   }
+}
+
+void TSImposterAtlas::updatePages()
+{
+   for ( U32 i=0; i < smAtlases.size(); i++ )
+   {
+      TSImposterAtlas *atlas = smAtlases[i];
+      for ( U32 j=0; j < atlas->mPages.size(); j++ )
+      {
+         Page *page = atlas->mPages[j];
+         if ( !page->dirty )
+            continue;
+
+         PROFILE_SCOPE( TSImposterAtlas_updatePages );
+
+         TEXMGR->_loadTexture( page->diffuseTex, page->diffuse );
+         TEXMGR->_loadTexture( page->normalTex, page->normal );
+         page->dirty = false;
+      }
+   }
+}
+
+U32 TSImposterAtlas::getPageCount()
+{
+   U32 count = 0;
+   for ( U32 i=0; i < smAtlases.size(); i++ )
+      count += smAtlases[i]->mPages.size();
+
+   return count;
+}
+
+bool TSImposterAtlas::_onDeviceEvent( GFXDevice::GFXDeviceEventType evt )
+{
+   if ( evt == GFXDevice::deStartOfFrame )
+      updatePages();
+
+   return true;
+}
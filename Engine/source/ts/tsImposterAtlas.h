@@ -0,0 +1,156 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _TSIMPOSTERATLAS_H_
+#define _TSIMPOSTERATLAS_H_
+
+#ifndef _GFXDEVICE_H_
+#include "gfx/gfxDevice.h"
+#endif
+#ifndef _GFXTEXTUREHANDLE_H_
+#include "gfx/gfxTextureHandle.h"
+#endif
+#ifndef _MPOINT4_H_
+#include "math/mPoint4.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+
+struct DDSFile;
+class BaseMatInstance;
+
+
+/// Packs the imposter images of many TSLastDetails into shared texture
+/// pages, so that their imposters can be rendered in one batch.
+///
+/// TSLastDetail captures all the views of a shape into one sheet.  Sheets
+/// with the same layout need the same imposterUVs and imposterLimits, so
+/// they are copied into the slots of a regular grid over a page and all
+/// of them share the material of the page.  MFT_ImposterVert then remaps
+/// the UVs of each imposter into its slot with the offset and scale from
+/// the ImposterAtlasRect vertex element.
+///
+/// The compressed blocks of the sheets are copied as they are, so a page
+/// only keeps the mips in which a slot is still made of whole blocks.
+/// Changed pages are uploaded at the start of the next frame.
+///
+/// @see TSLastDetail
+/// @see RenderImposterMgr
+class TSImposterAtlas
+{
+public:
+
+   /// Everything that has to match for two sheets to share a page.
+   struct Layout
+   {
+      /// The size of the sheet in pixels.
+      U32 width;
+      U32 height;
+
+      /// The mip count of the sheet.
+      U32 mipLevels;
+
+      /// The edge length of one imposter image in the sheet.
+      U32 dim;
+
+      /// The largest edge length of a page.
+      U32 pageSize;
+
+      GFXFormat diffuseFormat;
+      GFXFormat normalFormat;
+
+      /// The imposterLimits of the material.
+      Point4F limits;
+
+      bool operator ==( const Layout &layout ) const;
+   };
+
+   struct Page;
+
+   /// Copies the sheets into a free slot of a page with the given layout.
+   ///
+   /// @param outSlot   Receives the slot for remove().
+   /// @param outRect   Receives the offset (xy) and scale (zw) of the
+   ///                  slot in the UV space of the page.
+   ///
+   /// @return The page or NULL if the sheets cannot be atlased.
+   static Page* add( const Layout &layout, 
+                     const DDSFile *diffuse, 
+                     const DDSFile *normal, 
+                     U32 *outSlot, 
+                     Point4F *outRect );
+
+   /// Frees the slot returned by add(), deleting the page
+   /// once it is empty.
+   static void remove( Page *page, U32 slot );
+
+   /// Returns the material instance shared by the imposters on the page.
+   static BaseMatInstance* getMatInstance( const Page *page );
+
+   /// Uploads the pages changed since the last call.
+   static void updatePages();
+
+   /// Returns the number of pages of all atlases.
+   static U32 getPageCount();
+
+protected:
+
+   TSImposterAtlas( const Layout &layout );
+   ~TSImposterAtlas();
+
+   Layout mLayout;
+
+   /// The size of the pages in pixels.
+   U32 mPageWidth;
+   U32 mPageHeight;
+
+   /// The mips kept in the pages.
+   U32 mPageMips;
+
+   /// The number of slots across and down a page.
+   U32 mSlotsX;
+   U32 mSlotsY;
+
+   Vector<Page*> mPages;
+
+   /// All the atlases... one per layout.
+   static Vector<TSImposterAtlas*> smAtlases;
+
+   /// Returns true if the sheets can be copied into a page of this layout.
+   bool _canAdd( const DDSFile *diffuse, const DDSFile *normal ) const;
+
+   /// Creates an empty page for sheets like the given ones.
+   Page* _createPage( const DDSFile *diffuse, const DDSFile *normal );
+
+   /// Creates the empty contents of a page in the format of the sheet.
+   DDSFile* _createPageDDS( const DDSFile *sheet ) const;
+
+   /// Copies the blocks of the sheet into the slot of a page.
+   void _copyToPage( DDSFile *page, const DDSFile *sheet, U32 slot ) const;
+
+   static bool _onDeviceEvent( GFXDevice::GFXDeviceEventType evt );
+};
+
+#endif // _TSIMPOSTERATLAS_H_
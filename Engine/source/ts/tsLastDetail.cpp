@@ -40,6 +40,7 @@
 #include "materials/materialFeatureTypes.h"
 #include "console/consoleTypes.h"
 #include "console/engineAPI.h"
+#include "platform/threads/thread.h"
 
 
 GFXImplementVertexFormat( ImposterState )
@@ -50,6 +51,8 @@ GFXImplementVertexFormat( ImposterState )
 
    addElement( "ImposterUpVec", GFXDeclType_Float3, 1 );
    addElement( "ImposterRightVec", GFXDeclType_Float3, 2 );
+
+   addElement( "ImposterAtlasRect", GFXDeclType_Float4, 3 );
 };
 
 
@@ -57,12 +60,33 @@ Vector<TSLastDetail*> TSLastDetail::smLastDetails;
 
 bool TSLastDetail::smCanShadow = true;
 
+bool TSLastDetail::smUseAtlas = true;
+
+
+/// Imposters are part of cooking a shape, so shapes which come with
+/// billboard details capture their imposters, or load them from the
+/// cache, as soon as they are loaded instead of when the first instance
+/// renders.  This runs after TSShapeConstructor applied its changes.
+static void _setupImpostersOnLoad( Resource<TSShape> &resource )
+{
+   if ( GFXDevice::devicePresent() && ThreadManager::isMainThread() )
+      resource->setupBillboardDetails( resource.getPath().getFullPath() );
+}
+
 
 AFTER_MODULE_INIT( Sim )
 {
    Con::addVariable( "$pref::imposter::canShadow", TypeBool, &TSLastDetail::smCanShadow,
       "User preference which toggles shadows from imposters.  Defaults to true.\n"
       "@ingroup Rendering\n" );
+
+   Con::addVariable( "$pref::imposter::useAtlas", TypeBool, &TSLastDetail::smUseAtlas,
+      "User preference which packs the imposter images of all shapes with the same "
+      "imposter settings into shared textures, so they render in a single batch.  "
+      "Takes effect when the imposters are next updated.  Defaults to true.\n"
+      "@ingroup Rendering\n" );
+
+   Resource<TSShape>::getPostLoadSignal().notify( &_setupImpostersOnLoad, 0.75f );
 }
 
 
@@ -90,15 +114,17 @@ TSLastDetail::TSLastDetail(   TSShape *shape,
    mMaterial = NULL;
    mMatInstance = NULL;
 
+   mAtlasPage = NULL;
+   mAtlasSlot = 0;
+   mAtlasRect.set( 0.0f, 0.0f, 1.0f, 1.0f );
+
    // Store this in the static list.
    smLastDetails.push_back( this );  
 }
 
 TSLastDetail::~TSLastDetail()
 {
-   SAFE_DELETE( mMatInstance );
-   if ( mMaterial )
-      mMaterial->deleteObject();
+   _clearMaterial();
 
    // Remove ourselves from the list.
    Vector<TSLastDetail*>::iterator iter = find( smLastDetails.begin(), smLastDetails.end(), this );
@@ -109,8 +135,7 @@ void TSLastDetail::render( const TSRenderState &rdata, F32 alpha )
 {
    // Early out if we have nothing to render.
    if (  alpha < 0.01f || 
-         !mMatInstance ||
-         mMaterial->mImposterUVs.size() == 0 )
+         !mMatInstance )
       return;
 
    const MatrixF &mat = GFX->getWorldMatrix();
@@ -143,10 +168,14 @@ void TSLastDetail::render( const TSRenderState &rdata, F32 alpha )
    // the center of the billboard quad.
    mat.mulP( mCenter, &ri->state.center );
 
+   // Where our images are in the texture.
+   ri->state.atlasRect = mAtlasRect;
+
    // We sort by the imposter type first so that RIT_Imposter and s
    // RIT_ImposterBatches do not get mixed together.
    //
-   // We then sort by material.
+   // We then sort by material, which all the imposters
+   // on the same atlas page share.
    //
    ri->defaultKey = 1;
    ri->defaultKey2 = ri->mat->getStateHint();
@@ -161,12 +190,7 @@ void TSLastDetail::update( bool forceUpdate )
    AssertFatal( GFXDevice::devicePresent(), "TSLastDetail::update() - Cannot update without a GFX device!" );
 
    // Clear the materialfirst.
-   SAFE_DELETE( mMatInstance );
-   if ( mMaterial )
-   {
-      mMaterial->deleteObject();
-      mMaterial = NULL;
-   }
+   _clearMaterial();
 
    // Make sure imposter textures have been flushed (and not just queued for deletion)
    TEXMGR->cleanupCache();
@@ -200,6 +224,13 @@ void TSLastDetail::update( bool forceUpdate )
       return;
    }
 
+   _validateDim();
+
+   // Share a texture and material with the imposters of
+   // other shapes with the same settings if we can.
+   if ( smUseAtlas && _addToAtlas() )
+      return;
+
    // Figure out what our vertex format will be.
    //
    // If we're on SM 3.0 we can do multiple vertex streams
@@ -215,59 +246,140 @@ void TSLastDetail::update( bool forceUpdate )
    mImposterVertDecl.clear();
    mImposterVertDecl.copy( *getGFXVertexFormat<ImposterState>() );
 
+   // Get the diffuse texture and from its size and
+   // the imposter dimensions we can generate the UVs.
+   GFXTexHandle diffuseTex( diffuseMapPath, &GFXStaticTextureSRGBProfile, String::EmptyString );
+   Point2I texSize( diffuseTex->getWidth(), diffuseTex->getHeight() );
+
+   S32 downscaledDim = mDim >> GFXTextureManager::getTextureDownscalePower(&GFXStaticTextureSRGBProfile);
+
+   Vector<RectF> imposterUVs;
+   getSheetUVs( texSize.x, texSize.y, downscaledDim, &imposterUVs );
+
+   AssertFatal( imposterUVs.size() != 0, "hey" );
+
    // Setup the material for this imposter.
-   mMaterial = MATMGR->allocateAndRegister( String::EmptyString );
-   mMaterial->mAutoGenerated = true;
-   mMaterial->mDiffuseMapFilename[0] = diffuseMapPath;
-   mMaterial->mNormalMapFilename[0] = _getNormalMapPath();
-   mMaterial->mImposterLimits.set( (mNumPolarSteps * 2) + 1, mNumEquatorSteps, mPolarAngle, mIncludePoles );
-   mMaterial->mTranslucent = true;
-   mMaterial->mTranslucentBlendOp = Material::None;
-   mMaterial->mTranslucentZWrite = true;
-   mMaterial->mDoubleSided = true;
-   mMaterial->mAlphaTest = true;
-   mMaterial->mAlphaRef = 84;
-
-   // Create the material instance.
-   FeatureSet features = MATMGR->getDefaultFeatures();
-   features.addFeature( MFT_ImposterVert );
-   mMatInstance = mMaterial->createMatInstance();
-   if ( !mMatInstance->init( features, &mImposterVertDecl ) )
+   mMaterial = createMaterial( diffuseMapPath, _getNormalMapPath(), _getImposterLimits(), imposterUVs );
+   mMatInstance = createMatInstance( mMaterial, &mImposterVertDecl );
+}
+
+void TSLastDetail::_clearMaterial()
+{
+   if ( mAtlasPage )
    {
-      delete mMatInstance;
+      // The page owns the material instance.
       mMatInstance = NULL;
+
+      TSImposterAtlas::remove( mAtlasPage, mAtlasSlot );
+      mAtlasPage = NULL;
    }
 
-   // Get the diffuse texture and from its size and
-   // the imposter dimensions we can generate the UVs.
-   GFXTexHandle diffuseTex( diffuseMapPath, &GFXStaticTextureSRGBProfile, String::EmptyString );
-   Point2I texSize( diffuseTex->getWidth(), diffuseTex->getHeight() );
+   SAFE_DELETE( mMatInstance );
+   if ( mMaterial )
+   {
+      mMaterial->deleteObject();
+      mMaterial = NULL;
+   }
 
-   _validateDim();
+   mAtlasRect.set( 0.0f, 0.0f, 1.0f, 1.0f );
+}
 
-   S32 downscaledDim = mDim >> GFXTextureManager::getTextureDownscalePower(&GFXStaticTextureSRGBProfile);
+bool TSLastDetail::_addToAtlas()
+{
+   PROFILE_SCOPE( TSLastDetail_addToAtlas );
+
+   // Drop the same top mips the texture manager would.
+   const U32 scalePower = GFXTextureManager::getTextureDownscalePower( &GFXStaticTextureSRGBProfile );
+
+   DDSFile *diffuse = DDSFile::loadUncached( _getDiffuseMapPath(), scalePower );
+   DDSFile *normal = DDSFile::loadUncached( _getNormalMapPath(), scalePower );
+
+   if ( diffuse && normal )
+   {
+      TSImposterAtlas::Layout layout;
+      layout.width = diffuse->getWidth();
+      layout.height = diffuse->getHeight();
+      layout.mipLevels = diffuse->getMipLevels();
+      layout.dim = getMax( mDim >> scalePower, 1 );
+      layout.pageSize = getMax( smMaxTexSize >> scalePower, (U32)1 );
+      layout.diffuseFormat = diffuse->getFormat();
+      layout.normalFormat = normal->getFormat();
+      layout.limits = _getImposterLimits();
+
+      mAtlasPage = TSImposterAtlas::add( layout, diffuse, normal, &mAtlasSlot, &mAtlasRect );
+   }
+
+   delete diffuse;
+   delete normal;
+
+   if ( !mAtlasPage )
+      return false;
+
+   mMatInstance = TSImposterAtlas::getMatInstance( mAtlasPage );
+   return true;
+}
+
+Point4F TSLastDetail::_getImposterLimits() const
+{
+   return Point4F( (F32)( (mNumPolarSteps * 2) + 1 ), (F32)mNumEquatorSteps, mPolarAngle, mIncludePoles ? 1.0f : 0.0f );
+}
+
+void TSLastDetail::getSheetUVs( U32 width, U32 height, U32 dim, Vector<RectF> *outUVs )
+{
+   outUVs->clear();
 
    // Ok... pack in bitmaps till we run out.
-   Vector<RectF> imposterUVs;
-   for ( S32 y=0; y+downscaledDim <= texSize.y; )
+   for ( U32 y=0; y+dim <= height; )
    {
-      for ( S32 x=0; x+downscaledDim <= texSize.x; )
+      for ( U32 x=0; x+dim <= width; )
       {
          // Store the uv for later lookup.
          RectF info;
-         info.point.set( (F32)x / (F32)texSize.x, (F32)y / (F32)texSize.y );
-         info.extent.set( (F32)downscaledDim / (F32)texSize.x, (F32)downscaledDim / (F32)texSize.y );
-         imposterUVs.push_back( info );
+         info.point.set( (F32)x / (F32)width, (F32)y / (F32)height );
+         info.extent.set( (F32)dim / (F32)width, (F32)dim / (F32)height );
+         outUVs->push_back( info );
          
-         x += downscaledDim;
+         x += dim;
       }
 
-      y += downscaledDim;
+      y += dim;
    }
+}
 
-   AssertFatal( imposterUVs.size() != 0, "hey" );
+Material* TSLastDetail::createMaterial(   const String &diffuseMap, 
+                                          const String &normalMap, 
+                                          const Point4F &limits, 
+                                          const Vector<RectF> &imposterUVs )
+{
+   Material *material = MATMGR->allocateAndRegister( String::EmptyString );
+   material->mAutoGenerated = true;
+   material->mDiffuseMapFilename[0] = diffuseMap;
+   material->mNormalMapFilename[0] = normalMap;
+   material->mImposterLimits = limits;
+   material->mImposterUVs = imposterUVs;
+   material->mTranslucent = true;
+   material->mTranslucentBlendOp = Material::None;
+   material->mTranslucentZWrite = true;
+   material->mDoubleSided = true;
+   material->mAlphaTest = true;
+   material->mAlphaRef = 84;
+
+   return material;
+}
+
+BaseMatInstance* TSLastDetail::createMatInstance( Material *material, const GFXVertexFormat *vertexFormat )
+{
+   FeatureSet features = MATMGR->getDefaultFeatures();
+   features.addFeature( MFT_ImposterVert );
 
-   mMaterial->mImposterUVs = imposterUVs;
+   BaseMatInstance *matInst = material->createMatInstance();
+   if ( !matInst->init( features, vertexFormat ) )
+   {
+      delete matInst;
+      matInst = NULL;
+   }
+
+   return matInst;
 }
 
 void TSLastDetail::_validateDim()
@@ -539,6 +651,8 @@ void TSLastDetail::updateImposterImages( bool forceUpdate )
    for ( ; iter != smLastDetails.end(); iter++ )
       (*iter)->update( forceUpdate );
 
+   TSImposterAtlas::updatePages();
+
    if ( !sceneBegun )
       GFX->endScene();
 }
@@ -29,6 +29,9 @@
 #ifndef _MPOINT3_H_
 #include "math/mPoint3.h"
 #endif
+#ifndef _MPOINT4_H_
+#include "math/mPoint4.h"
+#endif
 #ifndef _MMATRIX_H_
 #include "math/mMatrix.h"
 #endif
@@ -47,6 +50,9 @@
 #ifndef _SIM_H_
 #include "console/simObject.h"
 #endif
+#ifndef _TSIMPOSTERATLAS_H_
+#include "ts/tsImposterAtlas.h"
+#endif
 
 
 class TSShape;
@@ -54,6 +60,7 @@ class TSRenderState;
 class SceneRenderState;
 class Material;
 class BaseMatInstance;
+class RectF;
 
 
 /// The imposter state vertex format.
@@ -73,6 +80,10 @@ GFXDeclareVertexFormat( ImposterState )
    /// and right vectors... cross FTW.
    Point3F upVec;
    Point3F rightVec;
+
+   /// .xy = offset and .zw = scale of the imposter 
+   /// images in the texture... see TSImposterAtlas.
+   Point4F atlasRect;
 };
 
 
@@ -134,6 +145,17 @@ protected:
    /// The material instance used to render this imposter.
    BaseMatInstance *mMatInstance;
 
+   /// The atlas page holding the imposter images or NULL
+   /// if they are rendered from their own textures.
+   TSImposterAtlas::Page *mAtlasPage;
+
+   /// The slot of mAtlasPage the images are in.
+   U32 mAtlasSlot;
+
+   /// The offset (xy) and scale (zw) of the imposter
+   /// images in the texture.
+   Point4F mAtlasRect;
+
    /// This is a global list of all the TSLastDetail
    /// objects in the system.
    static Vector<TSLastDetail*> smLastDetails;
@@ -147,6 +169,16 @@ protected:
    ///
    void _validateDim();
 
+   /// Frees the material or the atlas slot.
+   void _clearMaterial();
+
+   /// Packs the cached imposter images into an atlas page.
+   /// @return False if the images need a material of their own.
+   bool _addToAtlas();
+
+   /// Returns the imposterLimits shader constant.
+   Point4F _getImposterLimits() const;
+
    /// Helper which returns the imposter diffuse map path.
    String _getDiffuseMapPath() const { return mCachePath + ".imposter.dds"; }
 
@@ -169,6 +201,26 @@ public:
    /// Global preference for rendering imposters to shadows.
    static bool smCanShadow;
 
+   /// Global preference for packing the imposter images into
+   /// shared atlas pages.
+   /// @see TSImposterAtlas
+   static bool smUseAtlas;
+
+   /// Returns the UVs of the images in an imposter sheet of the
+   /// given size for the imposterUVs shader constant.
+   static void getSheetUVs( U32 width, U32 height, U32 dim, Vector<RectF> *outUVs );
+
+   /// Creates the material for rendering imposters from 
+   /// the given diffuse and normal sheets.
+   static Material* createMaterial( const String &diffuseMap, 
+                                    const String &normalMap, 
+                                    const Point4F &limits, 
+                                    const Vector<RectF> &imposterUVs );
+
+   /// Returns a new instance of an imposter material or 
+   /// NULL if it failed to initialize.
+   static BaseMatInstance* createMatInstance( Material *material, const GFXVertexFormat *vertexFormat );
+
    /// Calls update on all TSLastDetail objects in the system.
    /// @see update()
    static void updateImposterImages( bool forceUpdate = false );
@@ -192,6 +244,10 @@ public:
    /// Returns the material instance used to render this imposter.
    BaseMatInstance* getMatInstance() const { return mMatInstance; }
 
+   /// Returns the offset (xy) and scale (zw) of the imposter
+   /// images in the texture of the material.
+   const Point4F& getAtlasRect() const { return mAtlasRect; }
+
    /// Helper function which deletes the cached imposter 
    /// texture files from disk.
    void deleteImposterCacheTextures();
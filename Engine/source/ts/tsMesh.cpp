@@ -41,6 +41,7 @@
 #include "collision/optimizedPolyList.h"
 #include "core/frameAllocator.h"
 #include "platform/profiler.h"
+#include "platform/platformIntrinsics.h"
 #include "materials/sceneData.h"
 #include "materials/materialManager.h"
 #include "scene/sceneManager.h"
@@ -50,6 +51,7 @@
 #include "renderInstance/renderPassManager.h"
 #include "materials/customMaterialDefinition.h"
 #include "gfx/util/triListOpt.h"
+#include "gfx/util/meshSimplify.h"
 #include "util/triRayCheck.h"
 
 #include "opcode/Opcode.h"
@@ -253,7 +255,8 @@ void TSMesh::innerRender( TSMaterialList *materials, const TSRenderState &rdata,
 #ifndef TORQUE_OS_MAC
 
       // Get the instancing material if this mesh qualifies.
-      if ( meshType != SkinMeshType && pb->mPrimitiveArray[i].numVertices < smMaxInstancingVerts )
+      if (  meshType != SkinMeshType && 
+            ( rdata.isForceInstancing() || pb->mPrimitiveArray[i].numVertices < smMaxInstancingVerts ) )
          if (matInst && !matInst->getFeatures().hasFeature(MFT_HardwareSkinning))
             matInst = InstancingMaterialHook::getInstancingMat( matInst );
 
@@ -277,6 +280,10 @@ void TSMesh::innerRender( TSMaterialList *materials, const TSRenderState &rdata,
       ri->defaultKey = matInst->getStateHint();
       ri->primBuffIndex = mPrimBufferOffset + i;
 
+      // All meshes of a shape share one vertex buffer, so sort by draw too
+      // to keep instances of the same draw together for instancing.
+      ri->defaultKey2 = coreRI->defaultKey2 + ri->primBuffIndex;
+
       // Translucent materials need the translucent type.
       if ( matInst->getMaterial()->isTranslucent() )
       {
@@ -335,11 +342,8 @@ bool TSMesh::buildPolyList( S32 frame, AbstractPolyList *polyList, U32 &surfaceK
          }
          else
          {
-            base = polyList->addPointAndNormal( mVertexData.getBase( firstVert ).vert(), mVertexData.getBase( firstVert ).normal() );
-            for ( i = 1; i < vertsPerFrame; i++ )
-            {
-               polyList->addPointAndNormal( mVertexData.getBase( i + firstVert ).vert(), mVertexData.getBase( i + firstVert ).normal() );
-            }
+            base = polyList->addPoints( &mVertexData.getBase( firstVert ).vert(), vertsPerFrame, mVertexData.vertSize(),
+                                        &mVertexData.getBase( firstVert ).normal(), mVertexData.vertSize() );
          }
       }
       else
@@ -363,9 +367,8 @@ bool TSMesh::buildPolyList( S32 frame, AbstractPolyList *polyList, U32 &surfaceK
          }
          else
          {
-            base = polyList->addPointAndNormal( verts[firstVert], norms[firstVert] );
-            for ( i = 1; i < vertsPerFrame; i++ )
-               polyList->addPointAndNormal( verts[ i + firstVert ], norms[ i + firstVert ] );
+            base = polyList->addPoints( &verts[firstVert], vertsPerFrame, sizeof( Point3F ),
+                                        &norms[firstVert], sizeof( Point3F ) );
          }
       }
    }
@@ -594,31 +597,16 @@ void TSMesh::support( S32 frame, const Point3F &v, F32 *currMaxDP, Point3F *curr
    if ( vertsPerFrame == 0 )
       return;
 
-   U32 waterMark = FrameAllocator::getWaterMark();
-   F32* pDots = (F32*)FrameAllocator::alloc( sizeof(F32) * vertsPerFrame );
-
    S32 firstVert = vertsPerFrame * frame;
-   m_point3F_bulk_dot( &v.x,
-                       &mVertexData.getBase(firstVert).vert().x,
-                       vertsPerFrame,
-                       mVertexData.vertSize(),
-                       pDots );
-
-   F32 localdp = *currMaxDP;
-   S32 index   = -1;
-
-   for ( S32 i = 0; i < vertsPerFrame; i++ )
-   {
-      if ( pDots[i] > localdp )
-      {
-         localdp = pDots[i];
-         index   = i;
-      }
-   }
 
-   FrameAllocator::setWaterMark(waterMark);
+   F32 localdp;
+   S32 index = MathUtils::findSupportPoint( v,
+                                            &mVertexData.getBase(firstVert).vert(),
+                                            vertsPerFrame,
+                                            mVertexData.vertSize(),
+                                            &localdp );
 
-   if ( index != -1 )
+   if ( index != -1 && localdp > *currMaxDP )
    {
       *currMaxDP   = localdp;
       *currSupport = mVertexData.getBase(index + firstVert).vert();
@@ -1190,6 +1178,12 @@ TSMesh::TSMesh() : meshType( StandardMeshType )
 
 TSMesh::~TSMesh()
 {
+   if ( mOptTree )
+   {
+      dFetchAndAdd( smNumOpcodeTrees, -1 );
+      dFetchAndAdd( smOpcodeTreeBytes, -(S32)getOpcodeMemoryUsage() );
+   }
+
    SAFE_DELETE( mOptTree );
    SAFE_DELETE( mOpMeshInterface );
    SAFE_DELETE_ARRAY( mOpTris );
@@ -1218,11 +1212,9 @@ void TSSkinMesh::updateSkinBuffer( const Vector<MatrixF> &transforms, U8* buffer
 
    // set up bone transforms
    PROFILE_START(TSSkinMesh_UpdateTransforms);
-   for (S32 i = 0; i < batchData.nodeIndex.size(); i++)
-   {
-      S32 node = batchData.nodeIndex[i];
-      sBoneTransforms[i].mul(transforms[node], batchData.initialTransforms[i]);
-   }
+   if (!batchData.nodeIndex.empty())
+      m_matF_x_matF_bulk_indexed(transforms[0], batchData.nodeIndex.address(),
+                                 batchData.initialTransforms[0], batchData.nodeIndex.size(), sBoneTransforms[0]);
 
    matrices = &sBoneTransforms[0];
    PROFILE_END();
@@ -2674,23 +2666,7 @@ void TSMesh::disassemble()
       }
    }
 
-   // optimize triangle draw order during disassemble
-   {
-      FrameTemp<TriListOpt::IndexType> tmpIdxs(indices.size());
-      for ( S32 i = 0; i < primitives.size(); i++ )
-      {
-         const TSDrawPrimitive& prim = primitives[i];
-
-         // only optimize triangle lists (strips and fans are assumed to be already optimized)
-         if ( (prim.matIndex & TSDrawPrimitive::TypeMask) == TSDrawPrimitive::Triangles )
-         {
-            TriListOpt::OptimizeTriangleOrdering(verts.size(), prim.numElements,
-               indices.address() + prim.start, tmpIdxs.address());
-            dCopyArray(indices.address() + prim.start, tmpIdxs.address(), 
-               prim.numElements);
-         }
-      }
-   }
+   // triangle draw order is optimized by TSShape::write() before disassembling
 
    if (TSShape::smVersion > 25)
    {
@@ -3171,6 +3147,267 @@ void TSSkinMesh::copySourceVertexDataFrom(const TSMesh* srcMesh)
    }
 }
 
+void TSMesh::optimizeTriangleOrder()
+{
+   PROFILE_SCOPE( TSMesh_optimizeTriangleOrder );
+
+   const U32 numVerts = getNumVerts();
+
+   // Positions for the overdraw pass
+   Vector<Point3F> positions;
+   if ( mVertexData.isReady() )
+   {
+      positions.setSize( numVerts );
+      for ( U32 i = 0; i < numVerts; i++ )
+         positions[i] = mVertexData.getBase(i).vert();
+   }
+   else
+      positions = verts;
+
+   Vector<TriListOpt::IndexType> tmpIdxs;
+   tmpIdxs.setSize(indices.size());
+   for ( S32 i = 0; i < primitives.size(); i++ )
+   {
+      const TSDrawPrimitive& prim = primitives[i];
+
+      // only optimize triangle lists (strips and fans are assumed to be already optimized)
+      if ( (prim.matIndex & TSDrawPrimitive::TypeMask) == TSDrawPrimitive::Triangles )
+      {
+         TriListOpt::OptimizeTriangleOrdering(numVerts, prim.numElements,
+            indices.address() + prim.start, tmpIdxs.address());
+         dCopyArray(indices.address() + prim.start, tmpIdxs.address(), 
+            prim.numElements);
+
+         if ( positions.size() >= numVerts )
+            TriListOpt::OptimizeOverdraw(positions.address(), numVerts, prim.numElements,
+               indices.address() + prim.start);
+      }
+   }
+
+   setFlags( OptimizedOrder );
+}
+
+/// Moves every element of an array to the index remap gives for it.  Empty
+/// arrays are left alone.
+template<class T>
+static void _remapVertexArray( Vector<T> &data, const Vector<U32> &remap )
+{
+   if ( data.empty() )
+      return;
+
+   AssertFatal( data.size() == remap.size(), "_remapVertexArray - vertex count mismatch" );
+
+   Vector<T> src( data );
+   for ( U32 i = 0; i < remap.size(); i++ )
+      data[remap[i]] = src[i];
+}
+
+void TSMesh::optimizeVertexOrder()
+{
+   PROFILE_SCOPE( TSMesh_optimizeVertexOrder );
+
+   // Other mesh types and morphing meshes keep their own per-vertex data
+   if ( (getMeshType() != StandardMeshType && getMeshType() != SkinMeshType) ||
+        mVertexData.isReady() || verts.empty() || numFrames > 1 || numMatFrames > 1 )
+      return;
+
+   const U32 numVerts = verts.size();
+   if ( norms.size() != numVerts ||
+        (!tverts.empty() && tverts.size() != numVerts) ||
+        (!tverts2.empty() && tverts2.size() != numVerts) ||
+        (!colors.empty() && colors.size() != numVerts) ||
+        (!tangents.empty() && tangents.size() != numVerts) ||
+        !encodedNorms.empty() )
+      return;
+
+   Vector<U32> remap;
+   remap.setSize( numVerts );
+   TriListOpt::OptimizeVertexFetch( numVerts, indices.size(), indices.address(), remap.address() );
+
+   remapVertices( remap );
+
+   for ( S32 i = 0; i < indices.size(); i++ )
+      indices[i] = remap[indices[i]];
+}
+
+void TSMesh::remapVertices( const Vector<U32> &remap )
+{
+   _remapVertexArray( verts, remap );
+   _remapVertexArray( norms, remap );
+   _remapVertexArray( tverts, remap );
+   _remapVertexArray( tverts2, remap );
+   _remapVertexArray( colors, remap );
+   _remapVertexArray( tangents, remap );
+}
+
+void TSSkinMesh::remapVertices( const Vector<U32> &remap )
+{
+   TSMesh::remapVertices( remap );
+
+   if ( batchData.initialVerts.size() == remap.size() )
+   {
+      _remapVertexArray( batchData.initialVerts, remap );
+      _remapVertexArray( batchData.initialNorms, remap );
+   }
+
+   // createSkinBatchData() expects the weights of a vertex to be next to each
+   // other, so sort them by their new vertex (keeping their order per vertex)
+   Vector<U32> firstWeight;
+   firstWeight.setSize( remap.size() + 1 );
+   dMemset( firstWeight.address(), 0, firstWeight.memSize() );
+
+   for ( S32 i = 0; i < vertexIndex.size(); i++ )
+   {
+      if ( vertexIndex[i] >= 0 )
+         firstWeight[remap[vertexIndex[i]] + 1]++;
+   }
+   for ( U32 v = 1; v < firstWeight.size(); v++ )
+      firstWeight[v] += firstWeight[v - 1];
+
+   const U32 numWeights = firstWeight.last();
+   Vector<F32> srcWeight( weight );
+   Vector<S32> srcBoneIndex( boneIndex );
+   Vector<S32> srcVertexIndex( vertexIndex );
+   weight.setSize( numWeights );
+   boneIndex.setSize( numWeights );
+   vertexIndex.setSize( numWeights );
+
+   for ( S32 i = 0; i < srcVertexIndex.size(); i++ )
+   {
+      if ( srcVertexIndex[i] < 0 )
+         continue;
+
+      const U32 vidx = remap[srcVertexIndex[i]];
+      const U32 dest = firstWeight[vidx]++;
+      weight[dest] = srcWeight[i];
+      boneIndex[dest] = srcBoneIndex[i];
+      vertexIndex[dest] = vidx;
+   }
+
+   batchData.initialized = false;
+}
+
+/// Drops the elements of an array from numVerts onwards.
+template<class T>
+static void _trimVertexArray( Vector<T> &data, U32 numVerts )
+{
+   if ( data.size() > numVerts )
+      data.setSize( numVerts );
+}
+
+void TSMesh::trimVertices( U32 numVerts )
+{
+   _trimVertexArray( verts, numVerts );
+   _trimVertexArray( norms, numVerts );
+   _trimVertexArray( tverts, numVerts );
+   _trimVertexArray( tverts2, numVerts );
+   _trimVertexArray( colors, numVerts );
+   _trimVertexArray( tangents, numVerts );
+
+   mNumVerts = vertsPerFrame = numVerts;
+}
+
+void TSSkinMesh::trimVertices( U32 numVerts )
+{
+   TSMesh::trimVertices( numVerts );
+
+   _trimVertexArray( batchData.initialVerts, numVerts );
+   _trimVertexArray( batchData.initialNorms, numVerts );
+
+   // Drop the weights of the removed vertices
+   U32 numWeights = 0;
+   for ( S32 i = 0; i < vertexIndex.size(); i++ )
+   {
+      if ( vertexIndex[i] < 0 || vertexIndex[i] >= (S32)numVerts )
+         continue;
+
+      weight[numWeights] = weight[i];
+      boneIndex[numWeights] = boneIndex[i];
+      vertexIndex[numWeights] = vertexIndex[i];
+      numWeights++;
+   }
+   weight.setSize( numWeights );
+   boneIndex.setSize( numWeights );
+   vertexIndex.setSize( numWeights );
+
+   batchData.initialized = false;
+}
+
+bool TSMesh::simplify( F32 ratio, F32 &outError )
+{
+   PROFILE_SCOPE( TSMesh_simplify );
+
+   outError = 0.0f;
+
+   // Vertices are dropped, so this has the same restrictions as
+   // optimizeVertexOrder()
+   if ( (getMeshType() != StandardMeshType && getMeshType() != SkinMeshType) ||
+        mVertexData.isReady() || verts.empty() || numFrames > 1 || numMatFrames > 1 )
+      return false;
+
+   const U32 numVerts = verts.size();
+   if ( norms.size() != numVerts ||
+        (!tverts.empty() && tverts.size() != numVerts) ||
+        (!tverts2.empty() && tverts2.size() != numVerts) ||
+        (!colors.empty() && colors.size() != numVerts) ||
+        (!tangents.empty() && tangents.size() != numVerts) ||
+        !encodedNorms.empty() )
+      return false;
+
+   for ( S32 i = 0; i < primitives.size(); i++ )
+   {
+      if ( (primitives[i].matIndex & TSDrawPrimitive::TypeMask) != TSDrawPrimitive::Triangles )
+         return false;
+   }
+
+   const U32 targetIndices = U32( mClampF( ratio, 0.0f, 1.0f ) * ( indices.size() / 3 ) ) * 3;
+   MeshSimplify::SimplifyTriangles( verts.address(), numVerts, indices.size(), indices.address(),
+      targetIndices, F32_MAX, &outError );
+
+   // Remove the collapsed triangles, and any primitives left empty
+   U32 numIndices = 0;
+   S32 numPrims = 0;
+   for ( S32 i = 0; i < primitives.size(); i++ )
+   {
+      TSDrawPrimitive prim = primitives[i];
+      const U32 start = numIndices;
+      for ( S32 j = prim.start; j < prim.start + prim.numElements; j += 3 )
+      {
+         if ( indices[j] == indices[j + 1] )
+            continue;
+
+         indices[numIndices++] = indices[j];
+         indices[numIndices++] = indices[j + 1];
+         indices[numIndices++] = indices[j + 2];
+      }
+
+      if ( numIndices > start )
+      {
+         prim.start = start;
+         prim.numElements = numIndices - start;
+         primitives[numPrims++] = prim;
+      }
+   }
+   indices.setSize( numIndices );
+   primitives.setSize( numPrims );
+
+   // Drop the vertices that are no longer referenced
+   Vector<U32> remap;
+   remap.setSize( numVerts );
+   const U32 numUsed = TriListOpt::OptimizeVertexFetch( numVerts, indices.size(), indices.address(), remap.address() );
+
+   remapVertices( remap );
+   trimVertices( numUsed );
+
+   for ( S32 i = 0; i < indices.size(); i++ )
+      indices[i] = remap[indices[i]];
+
+   computeBounds();
+   optimizeTriangleOrder();
+
+   return true;
+}
+
 U32 TSMesh::getNumVerts()
 {
    return mVertexData.isReady() ? mNumVerts : verts.size();
@@ -3244,6 +3481,9 @@ void TSMesh::makeEditable()
    mNumVerts = 0;
    mVertOffset = 0;
 
+   // Edits may change the triangles
+   clearFlags(OptimizedOrder);
+
    updateMeshFlags();
 }
 
@@ -3301,6 +3541,9 @@ void TSSkinMesh::makeEditable()
    mVertSize = 0;
    mNumVerts = 0;
 
+   // Edits may change the triangles
+   clearFlags(OptimizedOrder);
+
    updateMeshFlags();
    batchData.initialized = false;
 }
@@ -296,7 +296,8 @@ protected:
       Billboard = BIT(31), HasDetailTexture = BIT(30),
       BillboardZAxis = BIT(29), UseEncodedNormals = BIT(28),
       HasColor = BIT(27), HasTVert2 = BIT(26),
-      FlagMask = Billboard|BillboardZAxis|HasDetailTexture|UseEncodedNormals|HasColor|HasTVert2
+      OptimizedOrder = BIT(25), ///< triangle order already optimized, see optimizeTriangleOrder()
+      FlagMask = Billboard|BillboardZAxis|HasDetailTexture|UseEncodedNormals|HasColor|HasTVert2|OptimizedOrder
    };
 
    U32 getMeshType() const { return meshType & TypeMask; }
@@ -408,6 +409,30 @@ protected:
    static TSMesh* assembleMesh( U32 meshType, bool skip );
    virtual void disassemble();
 
+   /// Reorder the triangles of all triangle list primitives for the
+   /// post-transform vertex cache, then in clusters to reduce overdraw.
+   /// Sets the OptimizedOrder flag.  Safe to call from worker threads.
+   void optimizeTriangleOrder();
+
+   /// Reorder the vertices of an editable, single frame mesh by first use
+   /// in the index buffer for linear vertex fetches.  Must be done before
+   /// the mesh is converted to aligned vertex data.
+   void optimizeVertexOrder();
+
+   /// Move the vertex at index i to remap[i] in all per-vertex arrays.
+   virtual void remapVertices( const Vector<U32> &remap );
+
+   /// Drop every vertex from numVerts onwards from all per-vertex arrays.
+   virtual void trimVertices( U32 numVerts );
+
+   /// Reduce an editable, single frame triangle list mesh to about ratio of
+   /// its triangles (see MeshSimplify), then drop the vertices no longer in
+   /// use.  Remaining vertices keep their exact attributes and skin weights.
+   /// @param ratio     fraction of the triangles to keep
+   /// @param outError  receives the largest distance the surface moved
+   /// @return false if the mesh cannot be simplified
+   bool simplify( F32 ratio, F32 &outError );
+
    void createTangents(const Vector<Point3F> &_verts, const Vector<Point3F> &_norms);
    void findTangent( U32 index1, 
                      U32 index2, 
@@ -484,7 +509,18 @@ protected:
    IceMaths::IndexedTriangle* mOpTris;
    IceMaths::Point* mOpPoints;
 
+   /// Build the OPCODE tree used for collision queries unless it exists.
+   /// The tree belongs to the shape and is shared by all of its instances.
+   /// Safe to call from worker threads, queries call it on demand.
    void prepOpcodeCollision();
+
+   /// Memory used by the OPCODE tree and its triangle and point copies.
+   U32 getOpcodeMemoryUsage() const;
+
+   /// Number of OPCODE trees built over all meshes and their memory use.
+   static S32 smNumOpcodeTrees;
+   static S32 smOpcodeTreeBytes;
+
    bool buildConvexOpcode( const MatrixF &mat, const Box3F &bounds, Convex *c, Convex *list );
    bool buildPolyListOpcode( const S32 od, AbstractPolyList *polyList, const Box3F &nodeBox, TSMaterialList *materials );
    bool castRayOpcode( const Point3F &start, const Point3F &end, RayInfo *rayInfo, TSMaterialList *materials );
@@ -562,6 +598,8 @@ public:
    void addWeightsFromVertexBuffer();
 
    void makeEditable();
+   void remapVertices( const Vector<U32> &remap );
+   void trimVertices( U32 numVerts );
    void clearEditable();
 
 public:
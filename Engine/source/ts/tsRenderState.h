@@ -115,6 +115,10 @@ protected:
    /// Count of matrices in the mNodeTransforms list
    U32 mNodeTransformCount;
 
+   /// Use hardware instancing for all non-skinned meshes
+   /// and not just the ones smaller than TSMesh::smMaxInstancingVerts.
+   bool mForceInstancing;
+
 public:
 
    
@@ -169,6 +173,10 @@ public:
    void setNodeTransforms(MatrixF *list, U32 count) { mNodeTransforms = list; mNodeTransformCount = count; }
    void getNodeTransforms(MatrixF **list, U32 *count) const { *list = mNodeTransforms; *count = mNodeTransformCount; }
 
+   ///@see mForceInstancing
+   void setForceInstancing( bool enable ) { mForceInstancing = enable; }
+   bool isForceInstancing() const { return mForceInstancing; }
+
    /// @}
 };
 
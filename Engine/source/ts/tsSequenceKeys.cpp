@@ -0,0 +1,259 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "ts/tsSequenceKeys.h"
+#include "ts/arch/tsSequenceKeys.arch.h"
+
+#include "core/module.h"
+
+
+//------------------------------------------------------------------------------
+// Default C++ Implementations
+//------------------------------------------------------------------------------
+
+void tsInterpolateRotationsSoA_C( U32 count, const S16* const key1[ 4 ], const S16* const key2[ 4 ], F32 t, QuatF* out )
+{
+   for ( U32 i = 0; i < count; i++ )
+   {
+      QuatF q1( F32( key1[0][i] ) / F32( Quat16::MAX_VAL ),
+                F32( key1[1][i] ) / F32( Quat16::MAX_VAL ),
+                F32( key1[2][i] ) / F32( Quat16::MAX_VAL ),
+                F32( key1[3][i] ) / F32( Quat16::MAX_VAL ) );
+      QuatF q2( F32( key2[0][i] ) / F32( Quat16::MAX_VAL ),
+                F32( key2[1][i] ) / F32( Quat16::MAX_VAL ),
+                F32( key2[2][i] ) / F32( Quat16::MAX_VAL ),
+                F32( key2[3][i] ) / F32( Quat16::MAX_VAL ) );
+
+      TSTransform::interpolate( q1, q2, t, &out[i] );
+   }
+}
+
+void tsInterpolateTranslationsSoA_C( U32 count, const F32* const key1[ 3 ], const F32* const key2[ 3 ], F32 t, Point3F* out )
+{
+   for ( U32 i = 0; i < count; i++ )
+   {
+      out[i].x = key1[0][i] + t * ( key2[0][i] - key1[0][i] );
+      out[i].y = key1[1][i] + t * ( key2[1][i] - key1[1][i] );
+      out[i].z = key1[2][i] + t * ( key2[2][i] - key1[2][i] );
+   }
+}
+
+void tsInterpolateQuantizedTranslationsSoA_C( U32 count, const U16* const key1[ 3 ], const U16* const key2[ 3 ],
+                                              const F32* const origin[ 3 ], const F32* const scale[ 3 ],
+                                              F32 t, Point3F* out )
+{
+   for ( U32 i = 0; i < count; i++ )
+   {
+      F32 v[3];
+      for ( U32 c = 0; c < 3; c++ )
+      {
+         const F32 q1 = key1[c][i];
+         const F32 q2 = key2[c][i];
+         v[c] = origin[c][i] + scale[c][i] * ( q1 + t * ( q2 - q1 ) );
+      }
+      out[i].set( v[0], v[1], v[2] );
+   }
+}
+
+void (*tsInterpolateRotationsSoA)( U32 count, const S16* const key1[ 4 ], const S16* const key2[ 4 ], F32 t, QuatF* out ) = tsInterpolateRotationsSoA_C;
+void (*tsInterpolateTranslationsSoA)( U32 count, const F32* const key1[ 3 ], const F32* const key2[ 3 ], F32 t, Point3F* out ) = tsInterpolateTranslationsSoA_C;
+void (*tsInterpolateQuantizedTranslationsSoA)( U32 count, const U16* const key1[ 3 ], const U16* const key2[ 3 ],
+                                               const F32* const origin[ 3 ], const F32* const scale[ 3 ],
+                                               F32 t, Point3F* out ) = tsInterpolateQuantizedTranslationsSoA_C;
+
+//------------------------------------------------------------------------------
+// TSSequenceKeys
+//------------------------------------------------------------------------------
+
+TSSequenceKeys::TSSequenceKeys( const TSShape& shape, const TSShape::Sequence& seq, bool compress )
+{
+   mNumKeyframes = seq.numKeyframes;
+   mNumRotations = seq.rotationMatters.count();
+   mNumTranslations = seq.translationMatters.count();
+   mBaseRotation = seq.baseRotation;
+   mBaseTranslation = seq.baseTranslation;
+
+   // Rotations: transpose from node major to keyframe major.
+   for ( U32 c = 0; c < 4; c++ )
+      mRotations[c].setSize( mNumKeyframes * mNumRotations );
+
+   for ( S32 j = 0; j < mNumRotations; j++ )
+   {
+      const Quat16* src = &shape.nodeRotations[ seq.baseRotation + j * mNumKeyframes ];
+      for ( S32 k = 0; k < mNumKeyframes; k++ )
+      {
+         const U32 dst = k * mNumRotations + j;
+         mRotations[0][dst] = src[k].x;
+         mRotations[1][dst] = src[k].y;
+         mRotations[2][dst] = src[k].z;
+         mRotations[3][dst] = src[k].w;
+      }
+   }
+
+   if ( !compress )
+   {
+      for ( U32 c = 0; c < 3; c++ )
+         mTranslations[c].setSize( mNumKeyframes * mNumTranslations );
+
+      for ( S32 j = 0; j < mNumTranslations; j++ )
+      {
+         const Point3F* src = &shape.nodeTranslations[ seq.baseTranslation + j * mNumKeyframes ];
+         for ( S32 k = 0; k < mNumKeyframes; k++ )
+         {
+            const U32 dst = k * mNumTranslations + j;
+            mTranslations[0][dst] = src[k].x;
+            mTranslations[1][dst] = src[k].y;
+            mTranslations[2][dst] = src[k].z;
+         }
+      }
+      return;
+   }
+
+   // Quantize each node's translations over the box it moves in.  The error
+   // is at most half a step, (max - min) / 131070 per component.
+   for ( U32 c = 0; c < 3; c++ )
+   {
+      mQuantizedTranslations[c].setSize( mNumKeyframes * mNumTranslations );
+      mTranslationOrigin[c].setSize( mNumTranslations );
+      mTranslationScale[c].setSize( mNumTranslations );
+   }
+
+   for ( S32 j = 0; j < mNumTranslations; j++ )
+   {
+      const Point3F* src = &shape.nodeTranslations[ seq.baseTranslation + j * mNumKeyframes ];
+
+      Box3F bounds( src[0], src[0] );
+      for ( S32 k = 1; k < mNumKeyframes; k++ )
+         bounds.extend( src[k] );
+
+      for ( U32 c = 0; c < 3; c++ )
+      {
+         const F32 extent = bounds.maxExtents[c] - bounds.minExtents[c];
+         mTranslationOrigin[c][j] = bounds.minExtents[c];
+         mTranslationScale[c][j] = extent / 65535.0f;
+
+         const F32 invScale = extent > 0.0f ? 65535.0f / extent : 0.0f;
+         for ( S32 k = 0; k < mNumKeyframes; k++ )
+         {
+            const F32 q = ( src[k][c] - bounds.minExtents[c] ) * invScale;
+            mQuantizedTranslations[c][ k * mNumTranslations + j ] = (U16) mClampF( q + 0.5f, 0.0f, 65535.0f );
+         }
+      }
+   }
+}
+
+bool TSSequenceKeys::matches( const TSShape::Sequence& seq ) const
+{
+   return   mNumKeyframes == seq.numKeyframes &&
+            mBaseRotation == seq.baseRotation &&
+            mBaseTranslation == seq.baseTranslation &&
+            mNumRotations == seq.rotationMatters.count() &&
+            mNumTranslations == seq.translationMatters.count();
+}
+
+U32 TSSequenceKeys::getMemorySize() const
+{
+   U32 size = sizeof( *this );
+   for ( U32 c = 0; c < 4; c++ )
+      size += mRotations[c].memSize();
+   for ( U32 c = 0; c < 3; c++ )
+   {
+      size += mTranslations[c].memSize();
+      size += mQuantizedTranslations[c].memSize();
+      size += mTranslationOrigin[c].memSize();
+      size += mTranslationScale[c].memSize();
+   }
+   return size;
+}
+
+void TSSequenceKeys::interpolateRotations( S32 key1, S32 key2, F32 t, QuatF* out ) const
+{
+   const U32 offset1 = key1 * mNumRotations;
+   const U32 offset2 = key2 * mNumRotations;
+
+   const S16* planes1[4];
+   const S16* planes2[4];
+   for ( U32 c = 0; c < 4; c++ )
+   {
+      planes1[c] = mRotations[c].address() + offset1;
+      planes2[c] = mRotations[c].address() + offset2;
+   }
+
+   tsInterpolateRotationsSoA( mNumRotations, planes1, planes2, t, out );
+}
+
+void TSSequenceKeys::interpolateTranslations( S32 key1, S32 key2, F32 t, Point3F* out ) const
+{
+   const U32 offset1 = key1 * mNumTranslations;
+   const U32 offset2 = key2 * mNumTranslations;
+
+   if ( !isCompressed() )
+   {
+      const F32* planes1[3];
+      const F32* planes2[3];
+      for ( U32 c = 0; c < 3; c++ )
+      {
+         planes1[c] = mTranslations[c].address() + offset1;
+         planes2[c] = mTranslations[c].address() + offset2;
+      }
+
+      tsInterpolateTranslationsSoA( mNumTranslations, planes1, planes2, t, out );
+      return;
+   }
+
+   const U16* planes1[3];
+   const U16* planes2[3];
+   const F32* origin[3];
+   const F32* scale[3];
+   for ( U32 c = 0; c < 3; c++ )
+   {
+      planes1[c] = mQuantizedTranslations[c].address() + offset1;
+      planes2[c] = mQuantizedTranslations[c].address() + offset2;
+      origin[c] = mTranslationOrigin[c].address();
+      scale[c] = mTranslationScale[c].address();
+   }
+
+   tsInterpolateQuantizedTranslationsSoA( mNumTranslations, planes1, planes2, origin, scale, t, out );
+}
+
+//------------------------------------------------------------------------------
+// Initializer.
+//------------------------------------------------------------------------------
+
+MODULE_BEGIN( TSSequenceKeys )
+
+   MODULE_INIT
+   {
+      // Find the best implementation for the current CPU
+      if(Platform::SystemInfo.processor.properties & CPU_PROP_SSE2)
+      {
+         #if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 )) 
+            tsInterpolateRotationsSoA = tsInterpolateRotationsSoA_SSE2;
+            tsInterpolateTranslationsSoA = tsInterpolateTranslationsSoA_SSE2;
+            tsInterpolateQuantizedTranslationsSoA = tsInterpolateQuantizedTranslationsSoA_SSE2;
+         #endif
+      }
+   }
+
+MODULE_END;
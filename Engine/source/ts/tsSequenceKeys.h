@@ -0,0 +1,124 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _TSSEQUENCEKEYS_H_
+#define _TSSEQUENCEKEYS_H_
+
+#ifndef _TSSHAPE_H_
+#include "ts/tsShape.h"
+#endif
+
+
+/// Node keys of a sequence laid out for batch decoding.
+///
+/// TSShape stores the keys of a sequence node by node: all keyframes of the
+/// first animated node, then all keyframes of the next one.  Sampling a
+/// sequence touches one key per node and thus strides through memory.
+/// TSSequenceKeys stores the same keys keyframe by keyframe and splits them
+/// into one plane per component, so the keys of every node at a keyframe
+/// sit next to each other and can be decoded and interpolated four nodes
+/// at a time.
+///
+/// Rotations keep their 16 bit quantization.  Translations are stored as
+/// floats or, if compression was requested, as 16 bits per component
+/// relative to the bounds each node moves in over the sequence.
+///
+/// @see TSShape::getSequenceKeys()
+class TSSequenceKeys
+{
+   protected:
+
+      S32 mNumKeyframes;
+      S32 mNumRotations;
+      S32 mNumTranslations;
+
+      /// The sequence data this was built from; see matches().
+      S32 mBaseRotation;
+      S32 mBaseTranslation;
+
+      /// Rotation component planes (x, y, z, w), mNumRotations entries per keyframe.
+      Vector<S16> mRotations[ 4 ];
+
+      /// Translation component planes, mNumTranslations entries per keyframe.
+      /// Empty if the translations are compressed.
+      Vector<F32> mTranslations[ 3 ];
+
+      /// @name Compressed Translations
+      /// Component c of translation node j at keyframe k is
+      /// mTranslationOrigin[c][j] + mTranslationScale[c][j] * mQuantizedTranslations[c][k*mNumTranslations+j].
+      /// @{
+      Vector<U16> mQuantizedTranslations[ 3 ];
+      Vector<F32> mTranslationOrigin[ 3 ];
+      Vector<F32> mTranslationScale[ 3 ];
+      /// @}
+
+   public:
+
+      /// Copy the keys of @a seq out of @a shape.
+      /// @param compress If true, store translations with 16 bits per component.
+      TSSequenceKeys( const TSShape& shape, const TSShape::Sequence& seq, bool compress );
+
+      /// Return true if this was built for the current keys of @a seq.
+      bool matches( const TSShape::Sequence& seq ) const;
+
+      S32 getNumRotations() const { return mNumRotations; }
+      S32 getNumTranslations() const { return mNumTranslations; }
+      bool isCompressed() const { return mTranslations[ 0 ].empty() && mNumTranslations > 0; }
+
+      /// Return the number of bytes used for the keys.
+      U32 getMemorySize() const;
+
+      /// Interpolate the rotations of all animated nodes of the sequence
+      /// between keyframes @a key1 and @a key2.
+      /// @param out Receives getNumRotations() rotations, in the order of
+      ///   the sequence's rotationMatters set.
+      void interpolateRotations( S32 key1, S32 key2, F32 t, QuatF* out ) const;
+
+      /// Interpolate the translations of all animated nodes of the sequence
+      /// between keyframes @a key1 and @a key2.
+      /// @param out Receives getNumTranslations() translations, in the order
+      ///   of the sequence's translationMatters set.
+      void interpolateTranslations( S32 key1, S32 key2, F32 t, Point3F* out ) const;
+};
+
+
+/// @name Batch Key Interpolation
+/// Implementations are picked for the CPU at startup.
+/// @{
+
+/// Decode @a count rotations from the 16 bit component planes of two
+/// keyframes and interpolate them like TSTransform::interpolate().
+extern void (*tsInterpolateRotationsSoA)( U32 count, const S16* const key1[ 4 ], const S16* const key2[ 4 ], F32 t, QuatF* out );
+
+/// Interpolate @a count translations from the float component planes of two keyframes.
+extern void (*tsInterpolateTranslationsSoA)( U32 count, const F32* const key1[ 3 ], const F32* const key2[ 3 ], F32 t, Point3F* out );
+
+/// Interpolate @a count translations from the 16 bit component planes of two
+/// keyframes and dequantize them with per-node origin and scale.
+extern void (*tsInterpolateQuantizedTranslationsSoA)( U32 count, const U16* const key1[ 3 ], const U16* const key2[ 3 ],
+                                                      const F32* const origin[ 3 ], const F32* const scale[ 3 ],
+                                                      F32 t, Point3F* out );
+
+/// @}
+
+#endif // _TSSEQUENCEKEYS_H_
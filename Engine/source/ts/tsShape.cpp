@@ -33,16 +33,23 @@
 #include "materials/materialManager.h"
 #include "math/mathIO.h"
 #include "core/util/endian.h"
+#include "platform/platformMemory.h"
 #include "core/stream/fileStream.h"
+#include "core/stream/memStream.h"
 #include "console/compiler.h"
 #include "core/fileObject.h"
+#include "ts/tsSequenceKeys.h"
+#include "platform/threads/mutex.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/jobSystem.h"
+#include "ts/loader/tsShapeLoader.h"
 
 #ifdef TORQUE_COLLADA
 extern TSShape* loadColladaShape(const Torque::Path &path);
 #endif
 
 /// most recent version -- this is the version we write
-S32 TSShape::smVersion = 28;
+S32 TSShape::smVersion = 29;
 /// the version currently being read...valid only during a read
 S32 TSShape::smReadVersion = -1;
 const U32 TSShape::smMostRecentExporterVersion = DTS_EXPORTER_CURRENT_VERSION;
@@ -60,6 +67,12 @@ S32 TSShape::smNumSkipLoadDetails = 0;
 bool TSShape::smInitOnRead = true;
 bool TSShape::smUseHardwareSkinning = true;
 U32 TSShape::smMaxSkinBones = 70;
+bool TSShape::smUseSequenceKeys = true;
+bool TSShape::smCompressSequenceKeys = false;
+bool TSShape::smMapFiles = true;
+
+/// Guards building sequence keys from parallel animation jobs.
+static Mutex sgSequenceKeysMutex;
 
 
 TSShape::TSShape()
@@ -69,6 +82,8 @@ TSShape::TSShape()
    mSequencesConstructed = false;
    mShapeData = NULL;
    mShapeDataSize = 0;
+   mReadMappedData = NULL;
+   mCollisionBuild = NULL;
 
    mUseDetailFromScreenError = false;
    mNeedReinit = false;
@@ -111,6 +126,8 @@ TSShape::TSShape()
 
 TSShape::~TSShape()
 {
+   _stopCollisionBuild();
+
    delete materialList;
 
    S32 i;
@@ -152,10 +169,48 @@ TSShape::~TSShape()
    for (dca = 0; dca < detailCollisionAccelerators.size(); dca++)
       detailCollisionAccelerators[dca] = NULL;
 
+   clearSequenceKeys();
+
    if( mShapeData )
       delete[] mShapeData;
 }
 
+const TSSequenceKeys* TSShape::getSequenceKeys(const Sequence & seq) const
+{
+   if (!smUseSequenceKeys)
+      return NULL;
+
+   const S32 index = &seq - sequences.address();
+   if (index < 0 || index >= mSequenceKeys.size())
+      return NULL;
+
+   TSSequenceKeys* keys = mSequenceKeys[index];
+   if (!keys)
+   {
+      MutexHandle handle;
+      handle.lock(&sgSequenceKeysMutex, true);
+
+      keys = mSequenceKeys[index];
+      if (!keys)
+      {
+         keys = new TSSequenceKeys(*this, seq, smCompressSequenceKeys);
+         mSequenceKeys[index] = keys;
+      }
+   }
+
+   return keys->matches(seq) ? keys : NULL;
+}
+
+void TSShape::clearSequenceKeys()
+{
+   for (S32 i = 0; i < mSequenceKeys.size(); i++)
+      delete mSequenceKeys[i];
+
+   mSequenceKeys.setSize(sequences.size());
+   for (S32 i = 0; i < mSequenceKeys.size(); i++)
+      mSequenceKeys[i] = NULL;
+}
+
 const String& TSShape::getName( S32 nameIndex ) const
 {
    AssertFatal(nameIndex>=0 && nameIndex<names.size(),"TSShape::getName");
@@ -417,6 +472,7 @@ void TSShape::init()
    initObjects();
    initVertexFeatures();
    initMaterialList();
+   clearSequenceKeys();
    mNeedReinit = false;
 }
 
@@ -788,8 +844,12 @@ void TSShape::initVertexFeatures()
          }
       }
 
-      // Make sure VBO is init'd
-      initVertexBuffers();
+      // Make sure VBO is init'd.  Shapes loaded on a worker thread get
+      // theirs once they reach the main thread (see _onTSShapeLoaded).
+      // Without a device the shape is only used for collision, which
+      // works off mShapeVertexData, so skip the GFX buffers entirely.
+      if (ThreadManager::isMainThread() && GFXDevice::devicePresent())
+         initVertexBuffers();
       return;
    }
 
@@ -928,7 +988,8 @@ void TSShape::initVertexFeatures()
 
    mShapeVertexData.vertexDataReady = true;
 
-   initVertexBuffers();
+   if (ThreadManager::isMainThread() && GFXDevice::devicePresent())
+      initVertexBuffers();
 }
 
 void TSShape::setupBillboardDetails( const String &cachePath )
@@ -1443,13 +1504,23 @@ void TSShape::assembleShape()
       AssertFatal(mVertexSize == mBasicVertexFormat.vertexSize, "vertex size mismatch");
 
       vboSize = tsalloc.get32();
+      if (TSShape::smReadVersion >= 29)
+         tsalloc.align8(16);
       vboData = tsalloc.getPointer8(vboSize);
 
       if (tsalloc.getBuffer() && vboSize > 0)
       {
-         U8 *vertexData = (U8*)dMalloc_aligned(vboSize, 16);
-         dMemcpy(vertexData, vboData, vboSize);
-         mShapeVertexData.set(vertexData, vboSize);
+         if (mReadMappedData && ((uintptr_t)vboData & 15) == 0)
+         {
+            // The vertex data is aligned in the mapped file, so use it in place
+            mShapeVertexData.setExternal(vboData, vboSize);
+         }
+         else
+         {
+            U8 *vertexData = (U8*)dMalloc_aligned(vboSize, 16);
+            dMemcpy(vertexData, vboData, vboSize);
+            mShapeVertexData.set(vertexData, vboSize);
+         }
          mShapeVertexData.vertexDataReady = true;
       }
       else
@@ -1753,6 +1824,8 @@ void TSShape::disassembleShape()
       mBasicVertexFormat.writeAlloc(&tsalloc);
 
       tsalloc.set32(mShapeVertexData.size);
+      if (TSShape::smVersion >= 29)
+         tsalloc.align8(16);
       tsalloc.copyToBuffer8((S8*)mShapeVertexData.base, mShapeVertexData.size);
    }
 
@@ -1823,6 +1896,17 @@ bool TSShape::canWriteOldFormat() const
    return true;
 }
 
+void TSShape::_optimizeMeshes(void* data, U32 start, U32 end)
+{
+   TSShape* shape = (TSShape*)data;
+   for (U32 i = start; i < end; i++)
+   {
+      TSMesh* mesh = shape->meshes[i];
+      if (mesh && !mesh->getFlags(TSMesh::OptimizedOrder))
+         mesh->optimizeTriangleOrder();
+   }
+}
+
 void TSShape::write(Stream * s, bool saveOldFormat)
 {
    S32 currentVersion = smVersion;
@@ -1832,6 +1916,10 @@ void TSShape::write(Stream * s, bool saveOldFormat)
    // write version
    s->write(smVersion | (mExporterVersion<<16));
 
+   // Optimize the triangle draw order of every mesh up front, in parallel.
+   // Meshes from the importer are already done.
+   JobSystem::GLOBAL().parallelFor(meshes.size(), 1, &_optimizeMeshes, this);
+
    tsalloc.setWrite();
    disassembleShape();
 
@@ -1851,10 +1939,17 @@ void TSShape::write(Stream * s, bool saveOldFormat)
       size8 += 4;
    size8 >>= 2;
 
+   // from version 29 the 8-bit buffer starts 16 byte aligned in the file
+   // (after the 4 dword header) so its vertex data can be used in place
+   // when the file is mapped
+   S32 pad16 = 0;
+   if (smVersion >= 29)
+      pad16 = (4 - (size32 + size16) % 4) % 4;
+
    S32 sizeMemBuffer, start16, start8;
-   sizeMemBuffer = size32 + size16 + size8;
+   sizeMemBuffer = size32 + size16 + pad16 + size8;
    start16 = size32;
-   start8 = start16+size16;
+   start8 = start16+size16+pad16;
 
    // in dwords -- write will properly endian-flip.
    s->write(sizeMemBuffer);
@@ -1867,6 +1962,8 @@ void TSShape::write(Stream * s, bool saveOldFormat)
    // now write buffers
    s->write(size32*4,buffer32);
    s->write(size16*4,buffer16);
+   for (S32 i=0; i<pad16; i++)
+      s->write(S32(0));
    s->write(size8 *4,buffer8);
 
    // write sequences - write will properly endian-flip.
@@ -1929,11 +2026,24 @@ bool TSShape::read(Stream * s)
          return false;
       }
 
-      S32 * tmp = new S32[sizeMemBuffer];
-      s->read(sizeof(S32)*sizeMemBuffer,(U8*)tmp);
-      memBuffer32 = tmp;
-      memBuffer16 = (S16*)(tmp+startU16);
-      memBuffer8  = (S8*)(tmp+startU8);
+      // use the buffers straight from the mapped file if we can
+      const U32 bufferPos = s->getPosition();
+      if (mReadMappedData && ((uintptr_t)(mReadMappedData + bufferPos) & 3) == 0 &&
+          s->getStreamSize() - bufferPos >= sizeof(S32)*sizeMemBuffer)
+      {
+         memBuffer32 = (S32*)(mReadMappedData + bufferPos);
+         s->setPosition(bufferPos + sizeof(S32)*sizeMemBuffer);
+      }
+      else
+      {
+         // the vertex data can't be used from the mapping either
+         mReadMappedData = NULL;
+
+         memBuffer32 = new S32[sizeMemBuffer];
+         s->read(sizeof(S32)*sizeMemBuffer,(U8*)memBuffer32);
+      }
+      memBuffer16 = (S16*)(memBuffer32+startU16);
+      memBuffer8  = (S8*)(memBuffer32+startU8);
 
       count32 = startU16;
       count16 = startU8-startU16;
@@ -1970,7 +2080,8 @@ bool TSShape::read(Stream * s)
    assembleShape(); // copy to buffer
    AssertFatal(tsalloc.getSize()==mShapeDataSize,"TSShape::read: shape data buffer size mis-calculated");
 
-   delete [] memBuffer32;
+   if (!mReadMappedData)
+      delete [] memBuffer32;
 
    if (smInitOnRead)
    {
@@ -1980,6 +2091,40 @@ bool TSShape::read(Stream * s)
    return true;
 }
 
+bool TSShape::readFile(const Torque::Path &path)
+{
+   if (smMapFiles)
+   {
+      Torque::FS::FileRef file = Torque::FS::OpenFile(path, Torque::FS::File::Read);
+
+      U32 mappedSize = 0;
+      U8 *mappedData = file != NULL ? file->map(mappedSize) : NULL;
+      if (mappedData)
+      {
+         MemStream stream(mappedSize, mappedData, true, false);
+
+         mReadMappedData = mappedData;
+         bool readSuccess = read(&stream);
+         mReadMappedData = NULL;
+
+         // Keep the mapping only if the vertex data lives in it
+         if (readSuccess && mShapeVertexData.base && !mShapeVertexData.ownsBase)
+            mMappedFile = file;
+         else
+            file->unmap();
+
+         return readSuccess;
+      }
+   }
+
+   FileStream stream;
+   stream.open(path.getFullPath(), Torque::FS::File::Read);
+   if (stream.getStatus() != Stream::Ok)
+      return false;
+
+   return read(&stream);
+}
+
 void TSShape::createEmptyShape()
 {
    nodes.set(dMalloc(1 * sizeof(Node)), 1);
@@ -2097,10 +2242,10 @@ void TSShape::fixEndian(S32 * buff32, S16 * buff16, S8 *, S32 count32, S32 count
    }
 }
 
-template<> void *Resource<TSShape>::create(const Torque::Path &path)
+/// Executes the shape script if it exists.  Runs on the main thread.
+static void _execShapeScript(void* data)
 {
-   // Execute the shape script if it exists
-   Torque::Path scriptPath(path);
+   Torque::Path scriptPath(*(const Torque::Path*)data);
    scriptPath.setExtension("cs");
 
    // Don't execute the script if we're already doing so!
@@ -2120,6 +2265,24 @@ template<> void *Resource<TSShape>::create(const Torque::Path &path)
          Con::setVariable("InstantGroup", instantGroup.c_str());
       }
    }
+}
+
+/// Shapes loaded on a worker thread (see ResourceManager::loadAsync) skip the
+/// GFX buffers in TSShape::init; create them once the shape is handed over.
+static void _onTSShapeLoaded( Resource<TSShape>& resource )
+{
+   TSShape* shape = resource;
+   if ( shape->mShapeVertexData.vertexDataReady && shape->mShapeVertexBuffer.isNull() && GFXDevice::devicePresent() )
+      shape->initVertexBuffers();
+}
+
+static ResourceRegisterPostLoadSignal<TSShape> _registerTSShapeLoadSignal( _onTSShapeLoaded );
+
+template<> void *Resource<TSShape>::create(const Torque::Path &path)
+{
+   TSShapeLoader::runOnMainThread( &_execShapeScript, (void*)&path );
+
+   MEMORY_TAG_SCOPE( TSShapes );
 
    // Attempt to load the shape
    TSShape * ret = 0;
@@ -2128,16 +2291,14 @@ template<> void *Resource<TSShape>::create(const Torque::Path &path)
 
    if ( extension.equal( "dts", String::NoCase ) )
    {
-      FileStream stream;
-      stream.open( path.getFullPath(), Torque::FS::File::Read );
-      if ( stream.getStatus() != Stream::Ok )
+      if ( !Torque::FS::IsFile( path ) )
       {
          Con::errorf( "Resource<TSShape>::create - Could not open '%s'", path.getFullPath().c_str() );
          return NULL;
       }
 
       ret = new TSShape;
-      readSuccess = ret->read(&stream);
+      readSuccess = ret->readFile( path );
    }
    else if ( extension.equal( "dae", String::NoCase ) || extension.equal( "kmz", String::NoCase ) )
    {
@@ -2150,15 +2311,13 @@ template<> void *Resource<TSShape>::create(const Torque::Path &path)
       Torque::Path cachedPath = path;
       cachedPath.setExtension("cached.dts");
        
-      FileStream stream;
-      stream.open( cachedPath.getFullPath(), Torque::FS::File::Read );
-      if ( stream.getStatus() != Stream::Ok )
+      if ( !Torque::FS::IsFile( cachedPath ) )
       {
          Con::errorf( "Resource<TSShape>::create - Could not open '%s'", cachedPath.getFullPath().c_str() );
          return NULL;
       }
       ret = new TSShape;
-      readSuccess = ret->read(&stream);
+      readSuccess = ret->readFile( cachedPath );
 #endif
    }
    else
@@ -35,12 +35,17 @@
 #ifndef _TSSHAPEALLOC_H_
 #include "ts/tsShapeAlloc.h"
 #endif
+#ifndef _VOLUME_H_
+#include "core/volume.h"
+#endif
 
 
 #define DTS_EXPORTER_CURRENT_VERSION 124
 
 class TSMaterialList;
 class TSLastDetail;
+class TSSequenceKeys;
+class TSShapeCollisionBuild;
 class PhysicsCollision;
 
 //
@@ -57,15 +62,27 @@ struct TSShapeVertexArray
    U32 size;
    bool vertexDataReady;
 
-   TSShapeVertexArray() : base(NULL), size(0), vertexDataReady(false) {}
+   /// False if base points into memory owned by someone else, such as a
+   /// mapped shape file.
+   bool ownsBase;
+
+   TSShapeVertexArray() : base(NULL), size(0), vertexDataReady(false), ownsBase(true) {}
    virtual ~TSShapeVertexArray() { set(NULL, 0); }
 
    virtual void set(void *b, U32 s, bool autoFree = true)
    {
-      if (base && autoFree)
+      if (base && autoFree && ownsBase)
          dFree_aligned(base);
       base = reinterpret_cast<U8 *>(b);
       size = s;
+      ownsBase = true;
+   }
+
+   /// Use data that must not be freed, such as the vertex data in a mapped file.
+   void setExternal(void *b, U32 s)
+   {
+      set(b, s);
+      ownsBase = false;
    }
 };
 
@@ -415,6 +432,21 @@ class TSShape
    bool mSequencesConstructed;
    bool mNeedReinit;
 
+   /// The shape file if it was mapped into memory by readFile() and the
+   /// vertex data is used straight from the mapping.
+   Torque::FS::FileRef mMappedFile;
+
+   /// The mapped file contents while read() runs, else NULL.
+   U8* mReadMappedData;
+
+   /// Batch decoding layouts of the sequence keys, built on first use.
+   /// @see getSequenceKeys()
+   mutable Vector<TSSequenceKeys*> mSequenceKeys;
+
+   /// The worker thread build of the mesh collision trees, once started.
+   /// @see prepCollision()
+   TSShapeCollisionBuild* mCollisionBuild;
+
 
    // shape class has few methods --
    // just constructor/destructor, io, and lookup methods
@@ -459,6 +491,15 @@ class TSShape
    const Point3F & getAlignedScale(const Sequence & seq, S32 keyframeNum, S32 scaleNum) const;
    TSScale & getArbitraryScale(const Sequence & seq, S32 keyframeNum, S32 scaleNum, TSScale *) const;
    const ObjectState & getObjectState(const Sequence & seq, S32 keyframeNum, S32 objectNum) const;
+
+   /// Return the keys of @a seq laid out for batch decoding, building them
+   /// the first time they are asked for.  Returns NULL if batch decoding is
+   /// disabled or @a seq is not one of this shape's sequences.
+   /// @see smUseSequenceKeys
+   const TSSequenceKeys* getSequenceKeys(const Sequence & seq) const;
+
+   /// Drop the batch decoding layouts; called whenever sequence or node data changes.
+   void clearSequenceKeys();
    /// @}
 
    /// build LOS collision detail
@@ -475,6 +516,17 @@ class TSShape
    ///
    void findColDetails( bool useVisibleMesh, Vector<S32> *outDetails, Vector<S32> *outLOSDetails ) const;
 
+   /// Starts building the OPCODE collision trees of all meshes on a worker
+   /// thread, if not done yet.  The trees are shared by all instances of the
+   /// shape.  Queries that come first build the trees they need on the spot.
+   void prepCollision();
+
+   /// Memory used by the OPCODE collision trees of all meshes.
+   U32 getCollisionMemoryUsage() const;
+
+   /// Waits for a running collision tree build and forgets about it.
+   void _stopCollisionBuild();
+
    /// Builds a physics collision shape at the requested scale.
    ///
    /// If using the visible mesh one or more triangle meshes are created
@@ -587,6 +639,19 @@ class TSShape
    /// Determines maximum number of bones to use in hardware skinning shaders
    static U32 smMaxSkinBones;
 
+   /// Sample sequences from keys laid out for batch decoding.
+   static bool smUseSequenceKeys;
+
+   /// Store the translation keys used for batch decoding with 16 bits per component.
+   static bool smCompressSequenceKeys;
+
+   /// If true readFile() maps shape files into memory instead of reading
+   /// them into the heap.
+   static bool smMapFiles;
+
+   /// If true prepCollision() builds the collision trees on a worker thread.
+   static bool smBuildCollisionAsync;
+
    /// @name Version Info
    /// @{
 
@@ -603,7 +668,13 @@ class TSShape
 
    bool canWriteOldFormat() const;
    void write(Stream *, bool saveOldFormat=false);
+   static void _optimizeMeshes(void* data, U32 start, U32 end);
    bool read(Stream *);
+
+   /// Read the shape from a file, mapping it into memory when the file
+   /// system supports it.  Shapes written with version 29 or later keep
+   /// their vertex data aligned so it can be used in place from the mapping.
+   bool readFile(const Torque::Path &path);
    void readOldShape(Stream * s, S32 * &, S16 * &, S8 * &, S32 &, S32 &, S32 &);
    void writeName(Stream *, S32 nameIndex);
    S32  readName(Stream *, bool addName);
@@ -673,11 +744,13 @@ class TSShape
    TSMesh* copyMesh( const TSMesh* srcMesh ) const;
    bool addMesh(TSShape* srcShape, const String& srcMeshName, const String& meshName);
    bool addMesh(TSMesh* mesh, const String& meshName);
+   bool addMesh(TSMesh* mesh, const String& objName, S32 detailSize);
    bool setMeshSize(const String& meshName, S32 size);
    bool removeMesh(const String& meshName);
 
    S32 setDetailSize(S32 oldSize, S32 newSize);
    bool removeDetail(S32 size);
+   S32 addSimplifiedDetails(S32 size, S32 count, F32 reduction, F32 pixelError);
 
    bool addSequence(const Torque::Path& path, const String& fromSeq, const String& name, S32 startFrame, S32 endFrame, bool padRotKeys, bool padTransKeys);
    bool removeSequence(const String& name);
@@ -30,6 +30,7 @@ void TSShapeAlloc::setRead(S32 * memBuffer32, S16 * memBuffer16, S8 * memBuffer8
    mMemBuffer32 = memBuffer32;
    mMemBuffer16 = memBuffer16;
    mMemBuffer8  = memBuffer8 ;
+   mMemStart8   = memBuffer8 ;
 
    mMemGuard32  = 0;
    mMemGuard16  = 0;
@@ -54,6 +55,7 @@ void TSShapeAlloc::setWrite()
    mMemBuffer32 = 0;
    mMemBuffer16 = 0;
    mMemBuffer8  = 0;
+   mMemStart8   = 0;
 
    mSize32 = mFullSize32 = 0;
    mSize16 = mFullSize16 = 0;
@@ -83,6 +85,21 @@ void TSShapeAlloc::align32()
    allocShape8(aligned-mSize);
 }
 
+void TSShapeAlloc::align8(S32 alignment)
+{
+   if (mMode == TSShapeAlloc::ReadMode)
+   {
+      S32 offset = (mMemBuffer8 - mMemStart8) % alignment;
+      if (offset)
+         mMemBuffer8 += alignment - offset;
+   }
+   else
+   {
+      while (mSize8 % alignment)
+         set8(0);
+   }
+}
+
 #define IMPLEMENT_ALLOC(suffix,type)                          \
                                                               \
 type TSShapeAlloc::get##suffix()                              \
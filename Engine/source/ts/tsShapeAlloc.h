@@ -66,6 +66,9 @@ class TSShapeAlloc
    S16     * mMemBuffer16;
    S8      * mMemBuffer8;
 
+   /// reading only...start of the 8-bit input buffer
+   S8      * mMemStart8;
+
    /// for writing only...
    S32 mSize32;
    S32 mSize16;
@@ -100,6 +103,11 @@ class TSShapeAlloc
    // reading only...
    void doAlloc();
    void align32(); ///< align on dword boundary
+
+   // reading and writing...
+   /// Pad the 8-bit buffer so the next entry is aligned to @a alignment
+   /// bytes from the start of the buffer.
+   void align8(S32 alignment);
    S8 * getBuffer() { return mDest; }
    S32 getSize() { return mSize; }
    void setSkipMode(bool skip) { mMult = skip ? 0 : 1; }
@@ -270,6 +270,23 @@ void TSShapeConstructor::initPersistFields()
       "Forces update of the materials.cs file in the same folder as the COLLADA "
       "(.dae) file, even if Materials already exist. No effect for DTS files.\n"
       "Normally only Materials that are not already defined are written to materials.cs." );
+
+   addField( "autoDetailCount", TypeS32, Offset(mOptions.autoDetailCount, TSShapeConstructor),
+      "Number of simplified detail levels to generate below the smallest detail "
+      "of each subshape on import. No effect for DTS files.\n"
+      "The levels are generated before the model is cached to DTS, so this costs "
+      "nothing on later loads. Set to 0 (the default) to disable.\n"
+      "@see TSShapeConstructor::addSimplifiedDetails()" );
+
+   addField( "autoDetailReduction", TypeF32, Offset(mOptions.autoDetailReduction, TSShapeConstructor),
+      "Fraction of the triangles kept by each generated detail level (0-1). No "
+      "effect for DTS files.\n"
+      "@see autoDetailCount" );
+
+   addField( "autoDetailPixelError", TypeF32, Offset(mOptions.autoDetailPixelError, TSShapeConstructor),
+      "Maximum on-screen error, in pixels, of a generated detail level. Sets the "
+      "detail sizes of the generated levels. No effect for DTS files.\n"
+      "@see autoDetailCount" );
    endGroup( "Collada" );
 
    addGroup( "Sequences" );
@@ -1576,6 +1593,33 @@ DefineTSShapeConstructorMethod( setDetailLevelSize, S32, ( S32 index, S32 newSiz
    return dl;
 }}
 
+DefineTSShapeConstructorMethod( addSimplifiedDetails, S32, ( S32 size, S32 count, F32 reduction, F32 pixelError ), ( 3, 0.5f, 1.0f ),
+   ( size, count, reduction, pixelError ), 0,
+   "Generate lower detail levels by simplifying the meshes of a detail level.\n"
+   "Each new level keeps about reduction times the triangles of the level above "
+   "it.  Triangles are removed by collapsing edges onto existing vertices, so "
+   "texture coordinates and skin weights are preserved.  The geometric error of "
+   "each new level is stored with it, and the detail sizes are chosen so that a "
+   "level is only used once its error is smaller than pixelError pixels on "
+   "screen.  The source detail keeps the largest size; the smallest new level "
+   "takes over its old size.\n"
+   "@param size size of the source detail level, which must be the smallest "
+      "visible detail level of its subshape\n"
+   "@param count maximum number of detail levels to add\n"
+   "@param reduction fraction of the triangles each level keeps (0-1)\n"
+   "@param pixelError maximum on-screen error (in pixels) of a detail level\n"
+   "@return the number of detail levels added\n\n"
+   "@tsexample\n"
+   "%this.addSimplifiedDetails( 2 );\n"
+   "%this.addSimplifiedDetails( 2, 4, 0.4, 2 );\n"
+   "@endtsexample\n" )
+{
+   S32 numAdded = mShape->addSimplifiedDetails( size, count, reduction, pixelError );
+   if ( numAdded > 0 )
+      ADD_TO_CHANGE_SET();
+   return numAdded;
+}}
+
 DefineTSShapeConstructorMethod( getImposterDetailLevel, S32, (),, (), -1,
    "Get the index of the imposter (auto-billboard) detail level (if any).\n"
    "@return imposter detail level index, or -1 if the shape does not use "
@@ -2130,6 +2174,7 @@ TSShapeConstructor::ChangeSet::eCommandType TSShapeConstructor::ChangeSet::getCm
    else RETURN_IF_MATCH(AddImposter);
    else RETURN_IF_MATCH(RemoveImposter);
    else RETURN_IF_MATCH(AddCollisionDetail);
+   else RETURN_IF_MATCH(AddSimplifiedDetails);
 
    else RETURN_IF_MATCH(AddSequence);
    else RETURN_IF_MATCH(RemoveSequence);
@@ -78,6 +78,7 @@ public:
          CmdAddImposter,
          CmdRemoveImposter,
          CmdAddCollisionDetail,
+         CmdAddSimplifiedDetails,
 
          CmdAddSequence,
          CmdRemoveSequence,
@@ -295,6 +296,7 @@ public:
    S32 addImposter( S32 size, S32 equatorSteps, S32 polarSteps, S32 dl, S32 dim, bool includePoles, F32 polarAngle );
    bool removeImposter();
    bool addCollisionDetail( S32 size, const char* type, const char* target, S32 depth=4, F32 merge=30.0f, F32 concavity=30.0f, S32 maxVerts=32, F32 boxMaxError=0, F32 sphereMaxError=0, F32 capsuleMaxError=0 );
+   S32 addSimplifiedDetails( S32 size, S32 count=3, F32 reduction=0.5f, F32 pixelError=1.0f );
    ///@}
 
    /// @name Sequences
@@ -497,6 +497,7 @@ bool TSShape::addNode(const String& name, const String& parentName, const Point3
    }
 
    initObjects();
+   clearSequenceKeys();
 
    return true;
 }
@@ -632,6 +633,7 @@ bool TSShape::removeNode(const String& name)
    removeName(name);
 
    initObjects();
+   clearSequenceKeys();
 
    return true;
 }
@@ -958,16 +960,21 @@ TSMesh* TSShape::copyMesh( const TSMesh* srcMesh ) const
 
 bool TSShape::addMesh(TSMesh* mesh, const String& meshName)
 { 
+   // Determine the object name and detail size from the mesh name
+   S32 detailSize = 999;
+   String objName(String::GetTrailingNumber(meshName, detailSize));
+
+   return addMesh(mesh, objName, detailSize);
+}
+
+bool TSShape::addMesh(TSMesh* mesh, const String& objName, S32 detailSize)
+{
    // Ensure mesh is in editable state
    mesh->makeEditable();
 
    // Need to make everything editable since node indexes etc will change
    makeEditable();
 
-   // Determine the object name and detail size from the mesh name
-   S32 detailSize = 999;
-   String objName(String::GetTrailingNumber(meshName, detailSize));
-
    // Find the destination object (create one if it does not exist)
    S32 objIndex = findObject(objName);
    if (objIndex < 0)
@@ -1356,6 +1363,147 @@ bool TSShape::removeDetail( S32 size )
    return true;
 }
 
+S32 TSShape::addSimplifiedDetails( S32 size, S32 count, F32 reduction, F32 pixelError )
+{
+   // Largest size given to a generated detail level, for levels that are
+   // (almost) free of error
+   const S32 MaxSimplifiedSize = 1024;
+
+   S32 srcIndex = findDetailBySize( size );
+   if ( ( srcIndex < 0 ) || ( size < 0 ) || ( details[srcIndex].subShapeNum < 0 ) )
+   {
+      Con::errorf( "TSShape::addSimplifiedDetails: Invalid source detail (size %d)", size );
+      return 0;
+   }
+   if ( ( count <= 0 ) || ( reduction <= 0.0f ) || ( reduction >= 1.0f ) || ( pixelError <= 0.0f ) )
+   {
+      Con::errorf( "TSShape::addSimplifiedDetails: Invalid count (%d), reduction (%g) or pixel error (%g)",
+         count, reduction, pixelError );
+      return 0;
+   }
+
+   // The new levels are added below the source detail, so it must be the
+   // smallest visible detail of its subshape
+   const S32 subShapeIndex = details[srcIndex].subShapeNum;
+   for ( S32 i = 0; i < details.size(); i++ )
+   {
+      if ( ( details[i].subShapeNum == subShapeIndex ) &&
+           ( details[i].size >= 0 ) && ( details[i].size < size ) )
+      {
+         Con::errorf( "TSShape::addSimplifiedDetails: Detail %d is not the smallest "
+            "visible detail of its subshape", size );
+         return 0;
+      }
+   }
+
+   // Need to make everything editable since meshes are copied
+   makeEditable();
+
+   Vector<S32> srcObjects;
+   S32 srcPolys = 0;
+   const S32 srcDetailNum = details[srcIndex].objectDetailNum;
+   for ( S32 i = 0; i < subShapeNumObjects[subShapeIndex]; i++ )
+   {
+      const S32 objIndex = subShapeFirstObject[subShapeIndex] + i;
+      const TSShape::Object& obj = objects[objIndex];
+      if ( ( srcDetailNum < obj.numMeshes ) && meshes[obj.startMeshIndex + srcDetailNum] )
+      {
+         srcObjects.push_back( objIndex );
+         srcPolys += meshes[obj.startMeshIndex + srcDetailNum]->getNumPolys();
+      }
+   }
+
+   // Simplify the source meshes for each level.  Every level starts from the
+   // source meshes, so the reported errors are relative to the full detail.
+   Vector<TSMesh*> levelMeshes;
+   Vector<F32> levelErrors;
+   Vector<F32> levelAverageErrors;
+   S32 prevPolys = srcPolys;
+   F32 ratio = 1.0f;
+   for ( S32 level = 0; level < count; level++ )
+   {
+      ratio *= reduction;
+
+      F32 maxError = 0.0f;
+      F32 errorSum = 0.0f;
+      S32 polys = 0;
+      for ( S32 i = 0; i < srcObjects.size(); i++ )
+      {
+         const TSShape::Object& obj = objects[srcObjects[i]];
+         const TSMesh* srcMesh = meshes[obj.startMeshIndex + srcDetailNum];
+         TSMesh* mesh = copyMesh( srcMesh );
+
+         F32 error;
+         if ( mesh->simplify( ratio, error ) )
+         {
+            maxError = getMax( maxError, error );
+            errorSum += error * srcMesh->getNumPolys();
+         }
+
+         polys += mesh->getNumPolys();
+         levelMeshes.push_back( mesh );
+      }
+
+      // Stop once simplification no longer reduces the polygon count
+      if ( polys >= prevPolys )
+      {
+         for ( S32 i = 0; i < srcObjects.size(); i++ )
+         {
+            delete levelMeshes.last();
+            levelMeshes.pop_back();
+         }
+         break;
+      }
+
+      levelErrors.push_back( maxError );
+      levelAverageErrors.push_back( srcPolys ? errorSum / srcPolys : 0.0f );
+      prevPolys = polys;
+   }
+
+   const S32 numLevels = levelErrors.size();
+   if ( !numLevels )
+      return 0;
+
+   // A level is used once its error projects to less than pixelError pixels,
+   // ie. once the detail above it is no longer used.  Detail sizes are shape
+   // radii in pixels, so that happens at (pixelError * radius / error).  The
+   // smallest level takes over the size of the source detail, so the shape
+   // disappears at the same distance as before.
+   Vector<S32> sizes;
+   sizes.setSize( numLevels + 1 );
+   sizes[numLevels] = size;
+   for ( S32 level = numLevels - 1; level >= 0; level-- )
+   {
+      S32 levelSize = MaxSimplifiedSize;
+      if ( levelErrors[level] > 0.0f )
+         levelSize = (S32)mCeil( getMin( pixelError * radius / levelErrors[level], (F32)MaxSimplifiedSize ) );
+      sizes[level] = getMax( levelSize, sizes[level + 1] + 1 );
+   }
+
+   if ( sizes[0] != size )
+      setDetailSize( size, sizes[0] );
+
+   for ( S32 level = 0; level < numLevels; level++ )
+   {
+      const S32 levelSize = sizes[level + 1];
+      for ( S32 i = 0; i < srcObjects.size(); i++ )
+      {
+         const String objName( getName( objects[srcObjects[i]].nameIndex ) );
+         addMesh( levelMeshes[level * srcObjects.size() + i], objName, levelSize );
+      }
+
+      // Record the error of the new level
+      S32 dl = findDetailBySize( levelSize );
+      if ( dl >= 0 )
+      {
+         details[dl].averageError = levelAverageErrors[level];
+         details[dl].maxError = levelErrors[level];
+      }
+   }
+
+   return numLevels;
+}
+
 //-----------------------------------------------------------------------------
 bool TSShape::addSequence(const Torque::Path& path, const String& fromSeq,
                           const String& name, S32 startFrame, S32 endFrame,
@@ -1780,6 +1928,8 @@ bool TSShape::addSequence(const Torque::Path& path, const String& fromSeq,
    seq.sourceData.start = startFrame;
    seq.sourceData.end = endFrame;
 
+   clearSequenceKeys();
+
    return true;
 }
 
@@ -1838,6 +1988,8 @@ bool TSShape::removeSequence(const String& name)
    // Remove the sequence name if it is no longer in use
    removeName(name);
 
+   clearSequenceKeys();
+
    return true;
 }
 
@@ -2081,6 +2233,8 @@ bool TSShape::setSequenceBlend(const String& seqName, bool blend, const String&
    seq.sourceData.blendSeq = blendRefSeqName;
    seq.sourceData.blendFrame = blendRefFrame;
 
+   clearSequenceKeys();
+
    return true;
 }
 
@@ -2145,6 +2299,9 @@ bool TSShape::setSequenceGroundSpeed(const String& seqName, const Point3F& trans
 
 void TSShape::makeEditable()
 {
+   // Don't let the worker build collision trees of meshes being edited
+   _stopCollisionBuild();
+
    mNeedReinit = true;
    if (mShapeVertexData.base == NULL)
       return;
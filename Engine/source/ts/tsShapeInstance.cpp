@@ -38,6 +38,36 @@
 #include "gfx/primBuilder.h"
 #include "gfx/gfxDrawUtil.h"
 #include "core/module.h"
+#include "platform/platformTLS.h"
+#include "platform/threads/mutex.h"
+
+/// Per-thread node workspaces.  Workspaces live until shutdown since
+/// the threads animating shapes (main thread and ThreadPool threads)
+/// live that long too.
+static ThreadStorage sgNodeWorkspace;
+static Vector<TSShapeInstance::NodeWorkspace*> sgNodeWorkspaces( __FILE__, __LINE__ );
+static Mutex sgNodeWorkspaceMutex;
+
+/// Animation LOD counts of the last finished frame, exported to the console.
+static S32 sgAnimLODStatsAnimated = 0;
+static S32 sgAnimLODStatsThrottled = 0;
+static S32 sgAnimLODStatsFrozen = 0;
+static S32 sgAnimLODStatsNodes = 0;
+
+static bool _exportAnimLODStats( GFXDevice::GFXDeviceEventType type )
+{
+   if ( type != GFXDevice::deStartOfFrame )
+      return true;
+
+   TSShapeInstance::AnimLODStats &stats = TSShapeInstance::smAnimLODStats;
+   sgAnimLODStatsAnimated = stats.animated;
+   sgAnimLODStatsThrottled = stats.throttled;
+   sgAnimLODStatsFrozen = stats.frozen;
+   sgAnimLODStatsNodes = stats.nodes;
+   stats.animated = stats.throttled = stats.frozen = stats.nodes = 0;
+
+   return true;
+}
 
 MODULE_BEGIN( TSShapeInstance )
 
@@ -57,6 +87,12 @@ MODULE_BEGIN( TSShapeInstance )
          "@see $pref::TS::skipRenderDLs\n"
          "@ingroup Rendering\n" );
 
+      Con::addVariable("$pref::TS::mapShapeFiles", TypeBool, &TSShape::smMapFiles,
+         "@brief If true, shape files are mapped into memory instead of being read into the heap.\n"
+         "Shapes saved with DTS version 29 or later then use their vertex data straight from the mapping.  "
+         "The default value is true.\n"
+         "@ingroup Rendering\n" );
+
       Con::addVariable("$pref::TS::skipRenderDLs", TypeS32, &TSShapeInstance::smNumSkipRenderDetails,
          "@brief User perference which causes TSShapes to skip rendering higher lods.\n"
          "This will reduce the number of draw calls and triangles rendered and improve "
@@ -75,6 +111,96 @@ MODULE_BEGIN( TSShapeInstance )
          "@brief Enables mesh instancing on non-skin meshes that have less that this count of verts.\n"
          "The default value is 200.  Higher values can degrade performance.\n"
          "@ingroup Rendering\n" );
+
+      Con::addVariable("$pref::TS::useSequenceKeys", TypeBool, &TSShape::smUseSequenceKeys,
+         "@brief If true, sequences are sampled from keys laid out for batch decoding.\n"
+         "The keys are copied the first time a sequence is played.  The default value is true.\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$pref::TS::compressSequenceKeys", TypeBool, &TSShape::smCompressSequenceKeys,
+         "@brief If true, the translation keys used for batch decoding are stored with 16 bits per component.\n"
+         "This halves their memory at a small cost in precision.  Only affects sequences played after it is set.  "
+         "The default value is false.\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$TS::buildCollisionAsync", TypeBool, &TSShape::smBuildCollisionAsync,
+         "@brief If true, the collision trees of a shape are built on a worker thread when the first instance "
+         "needs collision.  Queries before that build the trees they need right away.\n"
+         "The default value is true.\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$TS::collisionTreeCount", TypeS32, &TSMesh::smNumOpcodeTrees,
+         "@brief Number of mesh collision trees currently built.  Read only.\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$TS::collisionTreeBytes", TypeS32, &TSMesh::smOpcodeTreeBytes,
+         "@brief Memory in bytes used by the mesh collision trees currently built.  Read only.\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$TS::parallelAnimate", TypeBool, &TSShapeInstance::smParallelAnimate,
+         "@brief If true, shapes queued for animation before rendering are animated in parallel.\n"
+         "The default value is true.\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$TS::parallelAnimateMinInstances", TypeS32, &TSShapeInstance::smParallelAnimateMinInstances,
+         "@brief Minimum number of shapes queued for animation before they are animated in parallel.\n"
+         "The default value is 8.\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$pref::TS::animLODPixelSize", TypeF32, &TSShapeInstance::smAnimLODPixelSize,
+         "@brief Shapes smaller than this pixel size on screen animate at a reduced rate.\n"
+         "The update interval grows towards $pref::TS::animLODMaxInterval as the size "
+         "approaches zero.  The default value is 0 which disables it.\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$pref::TS::animLODMaxInterval", TypeS32, &TSShapeInstance::smAnimLODMaxInterval,
+         "@brief Longest time in milliseconds between two animation updates of a small shape.\n"
+         "The default value is 100.\n"
+         "@see $pref::TS::animLODPixelSize\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$pref::TS::animLODInterpolate", TypeBool, &TSShapeInstance::smAnimLODInterpolate,
+         "@brief If true, shapes animating at a reduced rate blend between their last two poses.\n"
+         "Otherwise they hold their pose between updates.  The default value is true.\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$pref::TS::animLODLeafPixelSize", TypeF32, &TSShapeInstance::smAnimLODLeafPixelSize,
+         "@brief Shapes smaller than this pixel size on screen do not animate their leaf nodes.\n"
+         "The default value is 0 which disables it.\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$pref::TS::animLODFreezeDetailSize", TypeF32, &TSShapeInstance::smAnimLODFreezeDetailSize,
+         "@brief Detail levels with a size below this keep their last pose and skin.\n"
+         "The default value is 0 which disables it.\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$TS::animLODStats::animated", TypeS32, &sgAnimLODStatsAnimated,
+         "@brief Number of shapes that evaluated their animation last frame.\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$TS::animLODStats::throttled", TypeS32, &sgAnimLODStatsThrottled,
+         "@brief Number of shapes that kept or interpolated an earlier pose last frame.\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$TS::animLODStats::frozen", TypeS32, &sgAnimLODStatsFrozen,
+         "@brief Number of shapes on a frozen detail level last frame.\n"
+         "@ingroup Rendering\n" );
+
+      Con::addVariable("$TS::animLODStats::nodes", TypeS32, &sgAnimLODStatsNodes,
+         "@brief Number of nodes evaluated last frame.\n"
+         "@ingroup Rendering\n" );
+
+      GFXDevice::getDeviceEventSignal().notify( &_exportAnimLODStats );
+   }
+
+   MODULE_SHUTDOWN
+   {
+      GFXDevice::getDeviceEventSignal().remove( &_exportAnimLODStats );
+
+      sgNodeWorkspace.set( NULL );
+      for ( U32 i = 0; i < sgNodeWorkspaces.size(); i++ )
+         delete sgNodeWorkspaces[i];
+      sgNodeWorkspaces.clear();
    }
 
 MODULE_END;
@@ -88,17 +214,31 @@ F32                           TSShapeInstance::smLastScreenErrorTolerance = 0.0f
 F32                           TSShapeInstance::smLastScaledDistance = 0.0f;
 F32                           TSShapeInstance::smLastPixelSize = 0.0f;
 
-Vector<QuatF>                 TSShapeInstance::smNodeCurrentRotations(__FILE__, __LINE__);
-Vector<Point3F>               TSShapeInstance::smNodeCurrentTranslations(__FILE__, __LINE__);
-Vector<F32>                   TSShapeInstance::smNodeCurrentUniformScales(__FILE__, __LINE__);
-Vector<Point3F>               TSShapeInstance::smNodeCurrentAlignedScales(__FILE__, __LINE__);
-Vector<TSScale>               TSShapeInstance::smNodeCurrentArbitraryScales(__FILE__, __LINE__);
-Vector<MatrixF>               TSShapeInstance::smNodeLocalTransforms(__FILE__, __LINE__);
-TSIntegerSet                  TSShapeInstance::smNodeLocalTransformDirty;
+bool                          TSShapeInstance::smParallelAnimate = true;
+U32                           TSShapeInstance::smParallelAnimateMinInstances = 8;
 
-Vector<TSThread*>             TSShapeInstance::smRotationThreads(__FILE__, __LINE__);
-Vector<TSThread*>             TSShapeInstance::smTranslationThreads(__FILE__, __LINE__);
-Vector<TSThread*>             TSShapeInstance::smScaleThreads(__FILE__, __LINE__);
+F32                           TSShapeInstance::smAnimLODPixelSize = 0.0f;
+U32                           TSShapeInstance::smAnimLODMaxInterval = 100;
+bool                          TSShapeInstance::smAnimLODInterpolate = true;
+F32                           TSShapeInstance::smAnimLODLeafPixelSize = 0.0f;
+F32                           TSShapeInstance::smAnimLODFreezeDetailSize = 0.0f;
+TSShapeInstance::AnimLODStats TSShapeInstance::smAnimLODStats = { 0, 0, 0, 0 };
+
+TSShapeInstance::NodeWorkspace& TSShapeInstance::getNodeWorkspace()
+{
+   NodeWorkspace* workspace = reinterpret_cast< NodeWorkspace* >( sgNodeWorkspace.get() );
+   if( !workspace )
+   {
+      workspace = new NodeWorkspace;
+      sgNodeWorkspace.set( workspace );
+
+      MutexHandle mutex;
+      mutex.lock( &sgNodeWorkspaceMutex, true );
+      sgNodeWorkspaces.push_back( workspace );
+   }
+
+   return *workspace;
+}
 
 //-------------------------------------------------------------------------------------
 // constructors, destructors, initialization
@@ -115,6 +255,8 @@ TSShapeInstance::TSShapeInstance( const Resource<TSShape> &shape, bool loadMater
    VECTOR_SET_ASSOCIATION(mNodeReferenceArbitraryScaleRots);
    VECTOR_SET_ASSOCIATION(mThreadList);
    VECTOR_SET_ASSOCIATION(mTransitionThreads);
+   VECTOR_SET_ASSOCIATION(mAnimLODFromTransforms);
+   VECTOR_SET_ASSOCIATION(mAnimLODToTransforms);
 
    mShapeResource = shape;
    mShape = mShapeResource;
@@ -132,6 +274,8 @@ TSShapeInstance::TSShapeInstance( TSShape *shape, bool loadMaterials )
    VECTOR_SET_ASSOCIATION(mNodeReferenceArbitraryScaleRots);
    VECTOR_SET_ASSOCIATION(mThreadList);
    VECTOR_SET_ASSOCIATION(mTransitionThreads);
+   VECTOR_SET_ASSOCIATION(mAnimLODFromTransforms);
+   VECTOR_SET_ASSOCIATION(mAnimLODToTransforms);
 
    mShapeResource = NULL;
    mShape = shape;
@@ -140,6 +284,9 @@ TSShapeInstance::TSShapeInstance( TSShape *shape, bool loadMaterials )
 
 TSShapeInstance::~TSShapeInstance()
 {
+   if (mAnimateQueued)
+      _removeFromAnimateQueue();
+
    mMeshObjects.clear();
 
    while (mThreadList.size())
@@ -174,6 +321,14 @@ void TSShapeInstance::buildInstanceData(TSShape * _shape, bool loadMaterials)
    //
    mData = 0;
    mScaleCurrentlyAnimated = false;
+   mAnimateQueued = false;
+
+   mAnimLODPixelSize = F32_MAX;
+   mAnimLODLastTime = 0;
+   mAnimLODLastSubShape = -1;
+   mAnimLODHeld = false;
+   mAnimLODInterpolating = false;
+   mAnimLODSkipLeaves = false;
 
    if(loadMaterials)
       setMaterialList(mShape->materialList);
@@ -533,6 +688,9 @@ void TSShapeInstance::render( const TSRenderState &rdata, S32 dl, F32 intraDL )
    S32 end = rdata.isNoRenderTranslucent() ? mShape->subShapeFirstTranslucentObject[ss] : mShape->subShapeFirstObject[ss] + mShape->subShapeNumObjects[ss];
    TSVertexBufferHandle *realBuffer;
 
+   for (i = start; i < end; i++)
+      mMeshObjects[i].skinHeld = mAnimLODHeld;
+
    if (TSShape::smUseHardwareSkinning && !mUseOwnBuffer)
    {
       // For hardware skinning, just using the buffer associated with the shape will work fine
@@ -595,6 +753,9 @@ void TSShapeInstance::setCurrentDetail( S32 dl, F32 intraDL )
    mCurrentDetailLevel = mClamp( dl, -1, mShape->mSmallestVisibleDL );
    mCurrentIntraDetailLevel = intraDL > 1.0f ? 1.0f : (intraDL < 0.0f ? 0.0f : intraDL);
 
+   // An explicitly chosen detail animates at full rate.
+   mAnimLODPixelSize = F32_MAX;
+
    // Restrict the chosen detail level by cutoff value.
    if ( smNumSkipRenderDetails > 0 && mCurrentDetailLevel >= 0 )
    {
@@ -625,6 +786,8 @@ S32 TSShapeInstance::setDetailFromDistance( const SceneRenderState *state, F32 s
    // For debugging/metrics.
    smLastScaledDistance = scaledDistance;
 
+   mAnimLODPixelSize = F32_MAX;
+
    // Shortcut if the distance is really close or negative.
    if ( scaledDistance <= 0.0f )
    {
@@ -677,6 +840,8 @@ S32 TSShapeInstance::setDetailFromDistance( const SceneRenderState *state, F32 s
    // For debugging/metrics.
    smLastPixelSize = pixelSize;
 
+   mAnimLODPixelSize = pixelSize;
+
    // Clamp it to an acceptable range for the lookup table.
    U32 index = (U32)mClampF( pixelSize, 0, mShape->mDetailLevelLookup.size() - 1 );
 
@@ -810,8 +975,10 @@ void TSShapeInstance::MeshObjectInstance::render(  S32 objectDetail,
    // Pass a hint to the mesh that time has advanced and that the
    // skin is dirty and needs to be updated.  This should result
    // in the skin only updating once per frame in most cases.
+   // A held skin is only reused if it has been built for this detail.
    const U32 currTime = Sim::getCurrentTime();
-   bool isSkinDirty = (currTime != mLastTime) || (objectDetail != mLastObjectDetail);
+   bool isSkinDirty = (objectDetail != mLastObjectDetail) ||
+                      (currTime != mLastTime && (!skinHeld || mActiveTransforms.empty()));
 
    // Update active transform list for bones for GPU skinning
    if ( mesh->getMeshType() == TSMesh::SkinMeshType )
@@ -860,12 +1027,13 @@ bool TSShapeInstance::MeshObjectInstance::bufferNeedsUpdate( S32 objectDetail )
 {
    TSMesh *mesh = getMesh(objectDetail);
    const U32 currTime = Sim::getCurrentTime();
-   return mesh && mesh->getMeshType() == TSMesh::SkinMeshType && currTime != mLastTime;
+   return mesh && mesh->getMeshType() == TSMesh::SkinMeshType && currTime != mLastTime &&
+          ( !skinHeld || mLastTime == 0 || objectDetail != mLastObjectDetail );
 }
 
 TSShapeInstance::MeshObjectInstance::MeshObjectInstance()
 	: meshList(0), object(0), frame(0), matFrame(0),
-	visible(1.0f), forceHidden(false), mLastTime(0), mLastObjectDetail(0)
+	visible(1.0f), forceHidden(false), mLastTime(0), mLastObjectDetail(0), skinHeld(false)
 {
 }
 
@@ -873,12 +1041,8 @@ void TSShapeInstance::prepCollision()
 {
    PROFILE_SCOPE( TSShapeInstance_PrepCollision );
 
-   // Iterate over all our meshes and call prepCollision on them...
-   for(S32 i=0; i<mShape->meshes.size(); i++)
-   {
-      if(mShape->meshes[i])
-         mShape->meshes[i]->prepOpcodeCollision();
-   }
+   // The collision trees are built once per shape
+   mShape->prepCollision();
 }
 
 // Returns true is the shape contains any materials with accumulation enabled.
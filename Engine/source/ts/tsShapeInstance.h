@@ -171,6 +171,10 @@ class TSShapeInstance
       /// was last rendered.
       U32 mLastTime;
 
+      /// If true the skin keeps the pose it was last updated with.
+      /// Set while animation LOD holds the pose of the shape.
+      bool skinHeld;
+
       Vector<MatrixF> mActiveTransforms;
 
       MeshObjectInstance();
@@ -231,22 +235,32 @@ class TSShapeInstance
    /// @}
 
    /// @name Workspace for Node Transforms
+   /// Scratch space used while animating nodes.  Every thread that animates
+   /// shape instances gets its own workspace so that instances can be
+   /// animated in parallel (see animateQueued()).
    /// @{
-   static Vector<QuatF>   smNodeCurrentRotations;
-   static Vector<Point3F> smNodeCurrentTranslations;
-   static Vector<F32>     smNodeCurrentUniformScales;
-   static Vector<Point3F> smNodeCurrentAlignedScales;
-   static Vector<TSScale> smNodeCurrentArbitraryScales;
-   static Vector<MatrixF> smNodeLocalTransforms;
-   static TSIntegerSet    smNodeLocalTransformDirty;
-   /// @}
+   struct NodeWorkspace
+   {
+      Vector<QuatF>   currentRotations;
+      Vector<Point3F> currentTranslations;
+      Vector<F32>     currentUniformScales;
+      Vector<Point3F> currentAlignedScales;
+      Vector<TSScale> currentArbitraryScales;
+      Vector<MatrixF> localTransforms;
+      TSIntegerSet    localTransformDirty;
+
+      /// keep track of who controls what on currently animating shape
+      Vector<TSThread*> rotationThreads;
+      Vector<TSThread*> translationThreads;
+      Vector<TSThread*> scaleThreads;
+
+      /// batch sampled keys of the thread being applied
+      Vector<QuatF>   sampledRotations;
+      Vector<Point3F> sampledTranslations;
+   };
 
-   /// @name Threads
-   /// keep track of who controls what on currently animating shape
-   /// @{
-   static Vector<TSThread*> smRotationThreads;
-   static Vector<TSThread*> smTranslationThreads;
-   static Vector<TSThread*> smScaleThreads;
+   /// Return the node workspace of the calling thread.
+   static NodeWorkspace& getNodeWorkspace();
    /// @}
 	
 	TSMaterialList* mMaterialList;    ///< by default, points to hShape material list
@@ -264,6 +278,50 @@ protected:
 
    bool mScaleCurrentlyAnimated;
 
+   /// Set while the instance is waiting in the batched animation queue.
+   bool mAnimateQueued;
+
+   /// @name Animation LOD State
+   /// @{
+
+   /// Pixel size from the last setDetailFromDistance() or F32_MAX if
+   /// the detail was set some other way.
+   F32 mAnimLODPixelSize;
+
+   /// Sim time of the last full node evaluation.
+   U32 mAnimLODLastTime;
+
+   /// Subshape evaluated at mAnimLODLastTime or -1.
+   S32 mAnimLODLastSubShape;
+
+   /// True if the last animate() kept the previous pose.
+   bool mAnimLODHeld;
+
+   /// True while mNodeTransforms are blended from mAnimLODFromTransforms
+   /// to mAnimLODToTransforms between evaluations.
+   bool mAnimLODInterpolating;
+
+   /// Read by animateNodes(); leaf nodes keep their default transform.
+   bool mAnimLODSkipLeaves;
+
+   Vector<MatrixF> mAnimLODFromTransforms;
+   Vector<MatrixF> mAnimLODToTransforms;
+
+   /// Evaluate the nodes of subshape @a ss for detail @a dl, or keep or
+   /// interpolate the previous pose if animation LOD allows it.
+   /// @return False if the nodes still need to be evaluated later.
+   bool _animateNodesLOD(S32 dl, S32 ss);
+
+   /// Blend the nodes of @a ss between the last two evaluated poses.
+   void _interpolateNodesLOD(S32 ss, F32 t);
+
+   /// @}
+
+   /// Take the instance out of the batched animation queue.
+   void _removeFromAnimateQueue();
+
+   static void _animateQueuedJob( void* data, U32 start, U32 end );
+
    S32 mCurrentDetailLevel;
 
    /// 0-1, how far along from current to next (higher) detail level...
@@ -515,6 +573,71 @@ protected:
    void animateSubtrees(bool forceFull = true);
    void animateNodeSubtrees(bool forceFull = true);
 
+   /// @name Batched Animation
+   /// Instead of animating inside prepRenderImage(), objects can queue their
+   /// shape instances with queueAnimate().  The scene then animates every
+   /// queued instance at once with animateQueued(), spread across the
+   /// JobSystem, before it asks the objects for their render instances.
+   /// The later animate() calls of the objects find the instances clean and
+   /// return right away.
+   /// @{
+
+   /// If false, animateQueued() animates all queued instances on the calling thread.
+   static bool smParallelAnimate;
+
+   /// Minimum number of queued instances for animateQueued() to go parallel.
+   static U32 smParallelAnimateMinInstances;
+
+   /// Queue the instance to be animated at detail level @a dl by the next
+   /// animateQueued().  Instances with node callbacks call into code that
+   /// is not known to be thread-safe and are animated right away.
+   void queueAnimate() { queueAnimate( mCurrentDetailLevel ); }
+   void queueAnimate(S32 dl);
+
+   /// Animate all instances queued with queueAnimate() and wait for them to finish.
+   static void animateQueued();
+
+   /// @}
+
+   /// @name Animation LOD
+   /// Shapes that are small on screen can animate for less.  The size used
+   /// is the pixel size of the last setDetailFromDistance(); a detail set
+   /// with setCurrentDetail() animates at full rate.
+   /// @{
+
+   /// Below this pixel size nodes are evaluated less often, down to every
+   /// smAnimLODMaxInterval ms as the size approaches zero.  Zero disables it.
+   static F32 smAnimLODPixelSize;
+
+   /// Longest time in ms between two node evaluations.
+   static U32 smAnimLODMaxInterval;
+
+   /// If true, node transforms are blended between the last two evaluated
+   /// poses while updates are throttled instead of holding the pose.
+   static bool smAnimLODInterpolate;
+
+   /// Below this pixel size leaf nodes are not animated.
+   static F32 smAnimLODLeafPixelSize;
+
+   /// Details whose size is below this do not animate their nodes or update
+   /// their skin at all; they keep the last pose they were shown with.
+   static F32 smAnimLODFreezeDetailSize;
+
+   /// Animation work done in a frame.
+   struct AnimLODStats
+   {
+      volatile U32 animated;   ///< Instances with evaluated nodes.
+      volatile U32 throttled;  ///< Instances that kept or interpolated an earlier pose.
+      volatile U32 frozen;     ///< Instances on a frozen detail.
+      volatile U32 nodes;      ///< Nodes evaluated.
+   };
+
+   /// Counts of the frame in progress.  Exported to $TS::animLODStats::*
+   /// at the start of every frame.
+   static AnimLODStats smAnimLODStats;
+
+   /// @}
+
    /// Sets the 'forceHidden' state on the named mesh.
    /// @see MeshObjectInstance::forceHidden
    void setMeshForceHidden( const char *meshName, bool hidden );
@@ -656,6 +656,8 @@ void TSShapeInstance::updateTransitions()
    if (mTransitionThreads.empty())
       return;
 
+   NodeWorkspace& ws = getNodeWorkspace();
+
    TSIntegerSet transitionNodes;
    updateTransitionNodeTransforms(transitionNodes);
 
@@ -665,14 +667,14 @@ void TSShapeInstance::updateTransitions()
    for (i=0; i<mShape->nodes.size(); i++)
    {
       if (mTransitionRotationNodes.test(i))
-         mNodeReferenceRotations[i].set(smNodeCurrentRotations[i]);
+         mNodeReferenceRotations[i].set(ws.currentRotations[i]);
       if (mTransitionTranslationNodes.test(i))
-         mNodeReferenceTranslations[i] = smNodeCurrentTranslations[i];
+         mNodeReferenceTranslations[i] = ws.currentTranslations[i];
    }
 
    if (animatesScale())
    {
-      // Make sure smNodeXXXScale arrays have been resized
+      // Make sure the workspace scale arrays have been resized
       TSIntegerSet dummySet;
       handleDefaultScale(0, 0, dummySet);
 
@@ -682,7 +684,7 @@ void TSShapeInstance::updateTransitions()
          for (i=0; i<mShape->nodes.size(); i++)
          {
             if (mTransitionScaleNodes.test(i))
-               mNodeReferenceUniformScales[i] = smNodeCurrentUniformScales[i];
+               mNodeReferenceUniformScales[i] = ws.currentUniformScales[i];
          }
       }
       else if (animatesAlignedScale())
@@ -691,7 +693,7 @@ void TSShapeInstance::updateTransitions()
          for (i=0; i<mShape->nodes.size(); i++)
          {
             if (mTransitionScaleNodes.test(i))
-               mNodeReferenceScaleFactors[i] = smNodeCurrentAlignedScales[i];
+               mNodeReferenceScaleFactors[i] = ws.currentAlignedScales[i];
          }
       }
       else
@@ -702,8 +704,8 @@ void TSShapeInstance::updateTransitions()
          {
             if (mTransitionScaleNodes.test(i))
             {
-               mNodeReferenceScaleFactors[i] = smNodeCurrentArbitraryScales[i].mScale;
-               mNodeReferenceArbitraryScaleRots[i].set(smNodeCurrentArbitraryScales[i].mRotate);
+               mNodeReferenceScaleFactors[i] = ws.currentArbitraryScales[i].mScale;
+               mNodeReferenceArbitraryScaleRots[i].set(ws.currentArbitraryScales[i].mRotate);
             }
          }
       }
@@ -105,25 +105,11 @@ F32 CatmullRomBase::arcLength( F32 t1, F32 t2 )
       t2 = mTimes[mCount-1];
 
    // find segment and parameter
-   U32 seg1;
-   for ( seg1 = 0; seg1 < mCount-1; ++seg1 )
-   {
-      if ( t1 <= mTimes[seg1+1] )
-      {
-         break;
-      }
-   }
+   U32 seg1 = _findSegment( t1 );
    F32 u1 = (t1 - mTimes[seg1])/(mTimes[seg1+1] - mTimes[seg1]);
 
    // find segment and parameter
-   U32 seg2;
-   for ( seg2 = 0; seg2 < mCount-1; ++seg2 )
-   {
-      if ( t2 <= mTimes[seg2+1] )
-      {
-         break;
-      }
-   }
+   U32 seg2 = _findSegment( t2 );
    F32 u2 = (t2 - mTimes[seg2])/(mTimes[seg2+1] - mTimes[seg2]);
 
    F32 result;
@@ -155,18 +141,30 @@ U32 CatmullRomBase::getPrevNode( F32 t )
       return mCount-1;
 
    // find segment and parameter
-   U32 i;  // segment #
-   for ( i = 0; i < mCount-1; ++i )
-   {
-      if ( t <= mTimes[i+1] )
-         break;
-   }
+   U32 i = _findSegment( t );  // segment #
 
    AssertFatal( i >= 0 && i < mCount, "CatmullRomBase::getPrevNode - Got bad output index!" );
 
    return i;   
 }
 
+U32 CatmullRomBase::_findSegment( F32 t ) const
+{
+   // Find the first time in [1, mCount-1] which is >= t.
+   U32 lo = 1;
+   U32 hi = mCount;
+   while ( lo < hi )
+   {
+      const U32 mid = ( lo + hi ) / 2;
+      if ( mTimes[mid] < t )
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+
+   return lo - 1;
+}
+
 F32 CatmullRomBase::getTime( U32 idx )
 {
    AssertFatal( idx >= 0 && idx < mCount, "CatmullRomBase::getTime - Got bad index!" );
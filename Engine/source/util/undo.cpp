@@ -136,6 +136,14 @@ void CompoundUndoAction::redo()
       (*itr)->redo();   
 }
 
+U32 CompoundUndoAction::getMemoryUsage() const
+{
+   U32 usage = 0;
+   for( U32 i = 0; i < mChildren.size(); ++ i )
+      usage += mChildren[ i ]->getMemoryUsage();
+   return usage;
+}
+
 void CompoundUndoAction::onDeleteNotify( SimObject* object )
 {      
    for( U32 i = 0; i < mChildren.size(); ++ i )
@@ -169,6 +177,7 @@ UndoManager::UndoManager(U32 levels)
    VECTOR_SET_ASSOCIATION( mCompoundStack );
 
    mNumLevels = levels;
+   mMemoryLimit = kDefaultMemoryLimit;
    // levels can be arbitrarily high, so we don't really want to reserve(levels).
    mUndoStack.reserve(10);
    mRedoStack.reserve(10);
@@ -186,6 +195,9 @@ UndoManager::~UndoManager()
 void UndoManager::initPersistFields()
 {
    addField("numLevels", TypeS32, Offset(mNumLevels, UndoManager), "Number of undo & redo levels.");
+   addField("memoryLimit", TypeS32, Offset(mMemoryLimit, UndoManager), 
+      "Megabytes of captured object state each of the undo and redo stacks may hold "
+      "before the oldest actions are dropped.  Zero disables the limit.");
    // arrange for the default undo manager to exist.
 //   UndoManager &def = getDefaultManager();
 //   Con::printf("def = %s undo manager created", def.getName());
@@ -240,10 +252,20 @@ void UndoManager::clearStack(Vector<UndoAction*> &stack)
 //-----------------------------------------------------------------------------
 void UndoManager::clampStack(Vector<UndoAction*> &stack)
 {
-   while(stack.size() > mNumLevels)
+   U32 usage = 0;
+   if ( mMemoryLimit > 0 )
+   {
+      for ( U32 i = 0; i < stack.size(); i++ )
+         usage += stack[i]->getMemoryUsage();
+   }
+
+   const U32 limit = mMemoryLimit * 1024 * 1024;
+   while( stack.size() > mNumLevels ||
+          ( mMemoryLimit > 0 && usage > limit && stack.size() > 1 ) )
    {
       UndoAction *act = stack.front();
       stack.pop_front();
+      usage -= getMin( usage, act->getMemoryUsage() );
 
       // Call deleteObject() if the action was registered.
       if ( act->isProperlyAdded() )
@@ -313,8 +335,7 @@ void UndoManager::undo()
    
    // add it to the redo stack
    mRedoStack.push_back(act);
-   if(mRedoStack.size() > mNumLevels)
-      mRedoStack.pop_front();
+   clampStack(mRedoStack);
    
    Con::executef(this, "onUndo");
 
@@ -335,8 +356,7 @@ void UndoManager::redo()
    
    // add it to the undo stack
    mUndoStack.push_back(react);
-   if(mUndoStack.size() > mNumLevels)
-      mUndoStack.pop_front();
+   clampStack(mUndoStack);
    
    Con::executef(this, "onRedo");
    
@@ -466,8 +486,7 @@ void UndoManager::addAction(UndoAction* action)
 
    // push the incoming action onto the stack, move old data off the end if necessary.
    mUndoStack.push_back(action);
-   if(mUndoStack.size() > mNumLevels)
-      mUndoStack.pop_front();
+   clampStack(mUndoStack);
 
    Con::executef(this, "onAddUndo");
 }
@@ -65,6 +65,10 @@ public:
    /// Implement these methods to perform your specific undo & redo tasks. 
    virtual void undo() { };
    virtual void redo() { };
+
+   /// Returns the number of bytes of captured state this action holds
+   /// which the UndoManager counts against its memory limit.
+   virtual U32 getMemoryUsage() const { return 0; }
    
    /// Adds the action to the undo stack of the default UndoManager, or the provided manager.
    void addToManager(UndoManager* theMan = NULL);
@@ -93,6 +97,7 @@ public:
    virtual void redo();
    
    virtual void onDeleteNotify( SimObject* object );
+   virtual U32 getMemoryUsage() const;
    
    U32 getNumChildren() const { return mChildren.size(); }
 };
@@ -104,6 +109,9 @@ private:
    /// Default number of undo & redo levels.
    const static U32 kDefaultNumLevels = 100;
 
+   /// Default memory limit for each stack in megabytes.
+   const static U32 kDefaultMemoryLimit = 256;
+
    /// The stacks of undo & redo actions. They will be capped at size mNumLevels.
    Vector<UndoAction*> mUndoStack;
    Vector<UndoAction*> mRedoStack;
@@ -113,7 +121,8 @@ private:
    
    /// Deletes all the UndoActions in a stack, then clears it.
    void clearStack(Vector<UndoAction*> &stack);
-   /// Clamps a Vector to mNumLevels entries.
+   /// Clamps a Vector to mNumLevels entries and mMemoryLimit megabytes,
+   /// always keeping the newest action.
    void clampStack(Vector<UndoAction*> &stack);
 
    /// Run the removal logic on the action.
@@ -124,6 +133,9 @@ public:
    // not private because we're exposing it to the console.
    U32 mNumLevels;
 
+   /// Megabytes of captured state each stack may hold or 0 for no limit.
+   U32 mMemoryLimit;
+
    // Required in all ConsoleObject subclasses.
    typedef SimObject Parent;
    DECLARE_CONOBJECT(UndoManager);
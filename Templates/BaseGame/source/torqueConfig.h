@@ -54,6 +54,17 @@
 #define TORQUE_DISABLE_MEMORY_MANAGER
 #endif
 
+/// Define me to serve Vector storage and DataChunker blocks from the
+/// thread-caching SizeClassAllocator.  Keeps long-running servers from
+/// fragmenting the heap.
+//#define TORQUE_SIZECLASS_ALLOCATOR
+
+/// Define me to charge every dMalloc and new allocation to a memory tag
+/// (see MEMORY_TAG_SCOPE) and track live and peak bytes per tag.  Use
+/// dumpMemoryTags() to print the breakdown.  Requires
+/// TORQUE_DISABLE_MEMORY_MANAGER.
+//#define TORQUE_MEMORY_TAGS
+
 /// The improved SimDictionary uses C++11 and is designed for games where
 /// there are over 10000 simobjects active normally. To enable the new
 /// SimDictionary just uncomment the line below.